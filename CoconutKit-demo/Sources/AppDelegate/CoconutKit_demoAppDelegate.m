@@ -46,6 +46,9 @@ HLSEnableApplicationPreloading();
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions
 {    
+    // Cache suited for web content (used by the HLSWebViewController demo)
+    [[HLSWebContentCache sharedWebContentCache] install];
+    
     [self.window makeKeyAndVisible];
     
     self.application = [[[CoconutKit_demoApplication alloc] init] autorelease];
@@ -0,0 +1,39 @@
+//
+//  TransitionBenchmarkViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Play all available transitions (see +[HLSTransition availableTransitionNames]) one after the other between two
+ * reference view hierarchies of configurable complexity, and display a table with frame statistics (collected using
+ * HLSAnimationProfiler), the CPU time spent by the application process and an estimate of the number of layers
+ * requiring offscreen rendering passes, for each transition. The table is also logged with info level, so that
+ * results can be compared across devices and releases
+ *
+ * Designated initializer: -init
+ */
+@interface TransitionBenchmarkViewController : HLSViewController <HLSAnimationDelegate> {
+@private
+    UIView *m_containerView;
+    UISegmentedControl *m_complexitySegmentedControl;
+    UIButton *m_startButton;
+    UITextView *m_reportTextView;
+    NSArray *m_transitionNames;
+    NSUInteger m_transitionIndex;
+    HLSAnimation *m_animation;
+    NSMutableString *m_report;
+    NSTimeInterval m_cpuTimeAtStart;
+    BOOL m_profilerWasEnabled;
+}
+
+@property (nonatomic, retain) UIView *containerView;
+@property (nonatomic, retain) UISegmentedControl *complexitySegmentedControl;
+@property (nonatomic, retain) UIButton *startButton;
+@property (nonatomic, retain) UITextView *reportTextView;
+
+- (void)start:(id)sender;
+
+@end
@@ -0,0 +1,326 @@
+//
+//  TransitionBenchmarkViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "TransitionBenchmarkViewController.h"
+
+#import <sys/resource.h>
+
+// Number of subviews of the reference view hierarchies, for each complexity level
+static const NSUInteger kSubviewCounts[] = {10, 50, 200};
+
+// Return the CPU time (user and system) consumed by the process until now
+static NSTimeInterval TransitionBenchmarkProcessCPUTime(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.;
+    }
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+// Return the number of layers in a layer tree which are likely to require an offscreen rendering pass. Offscreen passes
+// cannot be counted using public APIs, this estimate is based on the layer properties known to trigger them
+static NSUInteger TransitionBenchmarkOffscreenLayerCount(CALayer *layer)
+{
+    NSUInteger count = 0;
+    if ((layer.masksToBounds && layer.cornerRadius > 0.f)
+            || (layer.shadowOpacity > 0.f && ! layer.shadowPath)
+            || layer.shouldRasterize
+            || layer.mask) {
+        ++count;
+    }
+    
+    for (CALayer *sublayer in layer.sublayers) {
+        count += TransitionBenchmarkOffscreenLayerCount(sublayer);
+    }
+    return count;
+}
+
+@interface TransitionBenchmarkViewController ()
+
+@property (nonatomic, retain) NSArray *transitionNames;
+@property (nonatomic, retain) HLSAnimation *animation;
+@property (nonatomic, retain) NSMutableString *report;
+
+- (UIView *)referenceViewWithColor:(UIColor *)color;
+
+- (void)playNextTransition;
+- (void)finish;
+
+@end
+
+@implementation TransitionBenchmarkViewController
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.transitionNames = nil;
+    self.report = nil;
+    
+    [super dealloc];
+}
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    self.containerView = nil;
+    self.complexitySegmentedControl = nil;
+    self.startButton = nil;
+    self.reportTextView = nil;
+    
+    // The animation is bound to views which are released
+    self.animation = nil;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize containerView = m_containerView;
+
+@synthesize complexitySegmentedControl = m_complexitySegmentedControl;
+
+@synthesize startButton = m_startButton;
+
+@synthesize reportTextView = m_reportTextView;
+
+@synthesize transitionNames = m_transitionNames;
+
+@synthesize animation = m_animation;
+
+- (void)setAnimation:(HLSAnimation *)animation
+{
+    if (m_animation == animation) {
+        return;
+    }
+    
+    m_animation.delegate = nil;
+    [m_animation cancel];
+    [m_animation release];
+    
+    m_animation = [animation retain];
+}
+
+@synthesize report = m_report;
+
+#pragma mark View lifecycle
+
+- (void)loadView
+{
+    UIView *view = [[[UIView alloc] initWithFrame:[[UIScreen mainScreen] applicationFrame]] autorelease];
+    view.backgroundColor = [UIColor blackColor];
+    view.autoresizingMask = HLSViewAutoresizingAll;
+    
+    CGFloat width = CGRectGetWidth(view.bounds);
+    CGFloat height = CGRectGetHeight(view.bounds);
+    
+    self.containerView = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, width, floorf(height / 2.f))] autorelease];
+    self.containerView.clipsToBounds = YES;
+    self.containerView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleBottomMargin;
+    [view addSubview:self.containerView];
+    
+    self.complexitySegmentedControl = [[[UISegmentedControl alloc] initWithItems:[NSArray arrayWithObjects:@"", @"", @"", nil]] autorelease];
+    self.complexitySegmentedControl.frame = CGRectMake(10.f, CGRectGetMaxY(self.containerView.frame) + 10.f, width - 120.f, 37.f);
+    self.complexitySegmentedControl.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleBottomMargin;
+    self.complexitySegmentedControl.selectedSegmentIndex = 1;
+    [view addSubview:self.complexitySegmentedControl];
+    
+    self.startButton = [UIButton buttonWithType:UIButtonTypeRoundedRect];
+    self.startButton.frame = CGRectMake(width - 100.f, CGRectGetMinY(self.complexitySegmentedControl.frame), 90.f, 37.f);
+    self.startButton.autoresizingMask = UIViewAutoresizingFlexibleLeftMargin | UIViewAutoresizingFlexibleBottomMargin;
+    [self.startButton addTarget:self action:@selector(start:) forControlEvents:UIControlEventTouchUpInside];
+    [view addSubview:self.startButton];
+    
+    CGFloat reportOriginY = CGRectGetMaxY(self.complexitySegmentedControl.frame) + 10.f;
+    self.reportTextView = [[[UITextView alloc] initWithFrame:CGRectMake(0.f, reportOriginY, width, height - reportOriginY)] autorelease];
+    self.reportTextView.editable = NO;
+    self.reportTextView.font = [UIFont fontWithName:@"Courier" size:9.f];
+    self.reportTextView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    [view addSubview:self.reportTextView];
+    
+    self.view = view;
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    
+    // Stop the benchmark if running
+    if (self.transitionNames) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(playNextTransition) object:nil];
+        self.animation = nil;
+        [self finish];
+    }
+}
+
+#pragma mark Orientation management
+
+- (BOOL)shouldAutorotateToInterfaceOrientation:(UIInterfaceOrientation)toInterfaceOrientation
+{
+    if (! [super shouldAutorotateToInterfaceOrientation:toInterfaceOrientation]) {
+        return NO;
+    }
+    
+    // Results would not be comparable if the orientation changes while the benchmark is running
+    return ! self.transitionNames;
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Transition benchmark", @"Transition benchmark");
+    
+    [self.complexitySegmentedControl setTitle:NSLocalizedString(@"Light", @"Light") forSegmentAtIndex:0];
+    [self.complexitySegmentedControl setTitle:NSLocalizedString(@"Medium", @"Medium") forSegmentAtIndex:1];
+    [self.complexitySegmentedControl setTitle:NSLocalizedString(@"Heavy", @"Heavy") forSegmentAtIndex:2];
+    [self.startButton setTitle:NSLocalizedString(@"Start", @"Start") forState:UIControlStateNormal];
+}
+
+#pragma mark Reference view hierarchies
+
+- (UIView *)referenceViewWithColor:(UIColor *)color
+{
+    UIView *referenceView = [[[UIView alloc] initWithFrame:self.containerView.bounds] autorelease];
+    referenceView.backgroundColor = color;
+    referenceView.autoresizingMask = HLSViewAutoresizingAll;
+    
+    // Tiles arranged in a grid. Some of them have rounded corners or shadows to exercise layer compositing
+    NSUInteger subviewCount = kSubviewCounts[self.complexitySegmentedControl.selectedSegmentIndex];
+    NSUInteger columnCount = ceilf(sqrtf(subviewCount));
+    NSUInteger rowCount = ceilf((CGFloat)subviewCount / columnCount);
+    CGFloat tileWidth = CGRectGetWidth(referenceView.bounds) / columnCount;
+    CGFloat tileHeight = CGRectGetHeight(referenceView.bounds) / rowCount;
+    for (NSUInteger i = 0; i < subviewCount; ++i) {
+        CGRect tileFrame = CGRectMake((i % columnCount) * tileWidth, (i / columnCount) * tileHeight, tileWidth, tileHeight);
+        UILabel *tileLabel = [[[UILabel alloc] initWithFrame:CGRectInset(tileFrame, 2.f, 2.f)] autorelease];
+        tileLabel.text = [NSString stringWithFormat:@"%d", i];
+        tileLabel.textAlignment = UITextAlignmentCenter;
+        tileLabel.font = [UIFont systemFontOfSize:10.f];
+        tileLabel.backgroundColor = [UIColor colorWithWhite:1.f alpha:0.5f];
+        if (i % 3 == 1) {
+            tileLabel.layer.cornerRadius = 5.f;
+            tileLabel.layer.masksToBounds = YES;
+        }
+        else if (i % 3 == 2) {
+            tileLabel.layer.shadowOpacity = 0.5f;
+            tileLabel.layer.shadowOffset = CGSizeMake(1.f, 1.f);
+        }
+        [referenceView addSubview:tileLabel];
+    }
+    
+    return referenceView;
+}
+
+#pragma mark Running the benchmark
+
+- (void)playNextTransition
+{
+    for (UIView *subview in [NSArray arrayWithArray:self.containerView.subviews]) {
+        [subview removeFromSuperview];
+    }
+    
+    if (m_transitionIndex == [self.transitionNames count]) {
+        self.animation = nil;
+        [self finish];
+        return;
+    }
+    
+    UIView *disappearingView = [self referenceViewWithColor:[UIColor blueColor]];
+    [self.containerView addSubview:disappearingView];
+    UIView *appearingView = [self referenceViewWithColor:[UIColor redColor]];
+    [self.containerView addSubview:appearingView];
+    
+    // The CPU time includes the time needed to create the animation
+    m_cpuTimeAtStart = TransitionBenchmarkProcessCPUTime();
+    
+    NSString *transitionName = [self.transitionNames objectAtIndex:m_transitionIndex];
+    Class transitionClass = [HLSTransition transitionClassForName:transitionName];
+    HLSAnimation *animation = [transitionClass animationWithAppearingView:appearingView
+                                                         disappearingView:disappearingView
+                                                                   inView:self.containerView
+                                                                 duration:kAnimationTransitionDefaultDuration];
+    animation.tag = transitionName;
+    animation.delegate = self;
+    self.animation = animation;
+    [animation playAnimated:YES];
+}
+
+- (void)finish
+{
+    self.transitionNames = nil;
+    
+    [HLSAnimationProfiler sharedAnimationProfiler].enabled = m_profilerWasEnabled;
+    
+    self.startButton.enabled = YES;
+    self.complexitySegmentedControl.enabled = YES;
+    
+    HLSLoggerInfo(@"Transition benchmark results:\n%@", self.report);
+}
+
+#pragma mark HLSAnimationDelegate protocol implementation
+
+- (void)animationDidStop:(HLSAnimation *)animation animated:(BOOL)animated
+{
+    NSTimeInterval cpuTime = TransitionBenchmarkProcessCPUTime() - m_cpuTimeAtStart;
+    NSDictionary *report = [[HLSAnimationProfiler sharedAnimationProfiler] reportForTag:animation.tag];
+    NSUInteger offscreenLayerCount = TransitionBenchmarkOffscreenLayerCount(self.containerView.layer);
+    
+    if (report) {
+        [self.report appendFormat:@"%-58s %6d %7d %8.1f %8.1f %8.1f %9d\n",
+         [animation.tag UTF8String],
+         [[report objectForKey:HLSAnimationProfilerFrameCountKey] unsignedIntegerValue],
+         [[report objectForKey:HLSAnimationProfilerDroppedFrameCountKey] unsignedIntegerValue],
+         [[report objectForKey:HLSAnimationProfilerLongestFrameDurationKey] doubleValue] * 1000.,
+         [[report objectForKey:HLSAnimationProfilerP95FrameDurationKey] doubleValue] * 1000.,
+         cpuTime * 1000.,
+         offscreenLayerCount];
+    }
+    // E.g. empty transitions, which do not display any frame
+    else {
+        [self.report appendFormat:@"%-58s %6s %7s %8s %8s %8.1f %9d\n", [animation.tag UTF8String], "-", "-", "-", "-", cpuTime * 1000.,
+         offscreenLayerCount];
+    }
+    self.reportTextView.text = self.report;
+    
+    ++m_transitionIndex;
+    
+    // Start the next transition once the current animation has been completely cleaned up
+    [self performSelector:@selector(playNextTransition) withObject:nil afterDelay:0.];
+}
+
+#pragma mark Event callbacks
+
+- (void)start:(id)sender
+{
+    self.startButton.enabled = NO;
+    self.complexitySegmentedControl.enabled = NO;
+    
+    HLSAnimationProfiler *animationProfiler = [HLSAnimationProfiler sharedAnimationProfiler];
+    m_profilerWasEnabled = animationProfiler.enabled;
+    [animationProfiler reset];
+    animationProfiler.enabled = YES;
+    
+    self.transitionNames = [HLSTransition availableTransitionNames];
+    m_transitionIndex = 0;
+    
+    self.report = [NSMutableString stringWithFormat:@"%@: %d subviews, %@ (%@)\n\n",
+                   [self.complexitySegmentedControl titleForSegmentAtIndex:self.complexitySegmentedControl.selectedSegmentIndex],
+                   kSubviewCounts[self.complexitySegmentedControl.selectedSegmentIndex],
+                   [[UIDevice currentDevice] model],
+                   [[UIDevice currentDevice] systemVersion]];
+    [self.report appendFormat:@"%-58s %6s %7s %8s %8s %8s %9s\n", "Transition", "Frames", "Dropped", "Max (ms)", "P95 (ms)", "CPU (ms)",
+     "Offscreen"];
+    self.reportTextView.text = self.report;
+    
+    [self playNextTransition];
+}
+
+@end
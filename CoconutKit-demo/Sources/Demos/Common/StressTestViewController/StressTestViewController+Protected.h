@@ -0,0 +1,50 @@
+//
+//  StressTestViewController+Protected.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Protected interface for use by subclasses of StressTestViewController in their implementation, and to be included
+ * from their implementation file
+ */
+@interface StressTestViewController (Protected)
+
+/**
+ * The name of the scenario, used in the trace, in the logs and as trace file name
+ * This method must be overridden
+ */
+- (NSString *)scenarioName;
+
+/**
+ * The number of iterations to run
+ * This method must be overridden
+ */
+- (NSUInteger)iterationCount;
+
+/**
+ * Called before the first iteration, outside the measurements. The default implementation does nothing
+ */
+- (void)prepareScenario;
+
+/**
+ * Run an iteration, and call -iterationDidFinish when done (either synchronously or later)
+ * This method must be overridden
+ */
+- (void)runIteration:(NSUInteger)iteration;
+
+/**
+ * Called when the scenario ends, either after the last iteration or because the view disappears. The default
+ * implementation does nothing
+ */
+- (void)cleanUpScenario;
+
+/**
+ * Call this method when the current iteration is done
+ * Not meant to be overridden
+ */
+- (void)iterationDidFinish;
+
+@end
@@ -0,0 +1,50 @@
+//
+//  StressTestViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Abstract base class for stress scenarios, which put a CoconutKit component under load for a fixed number of
+ * iterations. The view displays a content view (for use by subclasses), a start button and a report.
+ *
+ * While a scenario is running, HLSTrace is enabled, so that CoconutKit subsystems record what they are doing. Each
+ * iteration is recorded as an interval in the "Stress" category. Once the scenario ends, the report displays the
+ * iteration durations, the resident memory and the trace statistics per category. The report is logged with info
+ * level, followed by a single "HLSStress: {...}" JSON line which can be extracted from the logs for automatic checks,
+ * and the trace is written in the Chrome trace event format to Library/Caches/StressTraces/<scenarioName>.json (it
+ * can be opened with chrome://tracing)
+ *
+ * Subclasses implement the scenario using the interface declared in StressTestViewController+Protected.h. The next
+ * iteration is started once the current one has been fully processed by the run loop
+ *
+ * Designated initializer: -init
+ */
+@interface StressTestViewController : HLSViewController {
+@private
+    UIView *m_contentView;
+    UIButton *m_startButton;
+    UITextView *m_reportTextView;
+    NSUInteger m_iteration;
+    HLSTraceIdentifier m_iterationTraceIdentifier;
+    CFAbsoluteTime m_iterationStartTime;
+    NSMutableArray *m_iterationDurations;
+    NSUInteger m_initialResidentSize;
+    NSUInteger m_peakResidentSize;
+    BOOL m_traceWasEnabled;
+}
+
+@property (nonatomic, retain) UIView *contentView;
+@property (nonatomic, retain) UIButton *startButton;
+@property (nonatomic, retain) UITextView *reportTextView;
+
+/**
+ * YES while the scenario is running
+ */
+- (BOOL)isRunning;
+
+- (void)start:(id)sender;
+
+@end
@@ -0,0 +1,310 @@
+//
+//  StressTestViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+#import "StressTestViewController+Protected.h"
+
+#import <mach/mach.h>
+
+// Static functions
+static NSUInteger StressTestResidentSize(void);
+
+@interface StressTestViewController ()
+
+@property (nonatomic, retain) NSMutableArray *iterationDurations;
+
+- (void)runNextIteration;
+- (void)updatePeakResidentSize;
+- (void)finish;
+
+- (NSString *)traceFilePath;
+
+@end
+
+@implementation StressTestViewController
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.iterationDurations = nil;
+    
+    [super dealloc];
+}
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    self.contentView = nil;
+    self.startButton = nil;
+    self.reportTextView = nil;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize contentView = m_contentView;
+
+@synthesize startButton = m_startButton;
+
+@synthesize reportTextView = m_reportTextView;
+
+@synthesize iterationDurations = m_iterationDurations;
+
+- (BOOL)isRunning
+{
+    return self.iterationDurations != nil;
+}
+
+#pragma mark View lifecycle
+
+- (void)loadView
+{
+    UIView *view = [[[UIView alloc] initWithFrame:[[UIScreen mainScreen] applicationFrame]] autorelease];
+    view.backgroundColor = [UIColor blackColor];
+    view.autoresizingMask = HLSViewAutoresizingAll;
+    
+    CGFloat width = CGRectGetWidth(view.bounds);
+    CGFloat height = CGRectGetHeight(view.bounds);
+    
+    self.contentView = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, width, floorf(height / 2.f))] autorelease];
+    self.contentView.clipsToBounds = YES;
+    self.contentView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleBottomMargin;
+    [view addSubview:self.contentView];
+    
+    self.startButton = [UIButton buttonWithType:UIButtonTypeRoundedRect];
+    self.startButton.frame = CGRectMake(width - 100.f, CGRectGetMaxY(self.contentView.frame) + 10.f, 90.f, 37.f);
+    self.startButton.autoresizingMask = UIViewAutoresizingFlexibleLeftMargin | UIViewAutoresizingFlexibleBottomMargin;
+    [self.startButton addTarget:self action:@selector(start:) forControlEvents:UIControlEventTouchUpInside];
+    [view addSubview:self.startButton];
+    
+    CGFloat reportOriginY = CGRectGetMaxY(self.startButton.frame) + 10.f;
+    self.reportTextView = [[[UITextView alloc] initWithFrame:CGRectMake(0.f, reportOriginY, width, height - reportOriginY)] autorelease];
+    self.reportTextView.editable = NO;
+    self.reportTextView.font = [UIFont fontWithName:@"Courier" size:9.f];
+    self.reportTextView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+    [view addSubview:self.reportTextView];
+    
+    self.view = view;
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    
+    // Stop the scenario if running
+    if ([self isRunning]) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(runNextIteration) object:nil];
+        [self finish];
+    }
+}
+
+#pragma mark Orientation management
+
+- (BOOL)shouldAutorotateToInterfaceOrientation:(UIInterfaceOrientation)toInterfaceOrientation
+{
+    if (! [super shouldAutorotateToInterfaceOrientation:toInterfaceOrientation]) {
+        return NO;
+    }
+    
+    // Results would not be comparable if the orientation changes while the scenario is running
+    return ! [self isRunning];
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    [self.startButton setTitle:NSLocalizedString(@"Start", @"Start") forState:UIControlStateNormal];
+}
+
+#pragma mark Running the scenario
+
+- (void)runNextIteration
+{
+    if (m_iteration == [self iterationCount]) {
+        [self finish];
+        return;
+    }
+    
+    m_iterationTraceIdentifier = HLSTraceBegin(@"Stress", [NSString stringWithFormat:@"%@ #%d", [self scenarioName], m_iteration]);
+    m_iterationStartTime = CFAbsoluteTimeGetCurrent();
+    [self runIteration:m_iteration];
+}
+
+- (void)iterationDidFinish
+{
+    if (! [self isRunning]) {
+        return;
+    }
+    
+    HLSTraceEnd(m_iterationTraceIdentifier);
+    m_iterationTraceIdentifier = 0;
+    [self.iterationDurations addObject:[NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent() - m_iterationStartTime]];
+    [self updatePeakResidentSize];
+    
+    self.reportTextView.text = [NSString stringWithFormat:NSLocalizedString(@"Iteration %d / %d", @"Iteration %d / %d"),
+                                m_iteration + 1, [self iterationCount]];
+    
+    ++m_iteration;
+    
+    // Start the next iteration once the current one has been completely processed (e.g. animations cleaned up)
+    [self performSelector:@selector(runNextIteration) withObject:nil afterDelay:0.];
+}
+
+- (void)updatePeakResidentSize
+{
+    m_peakResidentSize = MAX(m_peakResidentSize, StressTestResidentSize());
+}
+
+- (void)finish
+{
+    // An iteration might be interrupted
+    HLSTraceEnd(m_iterationTraceIdentifier);
+    m_iterationTraceIdentifier = 0;
+    
+    // Stop running first, so that iterations ending during clean up are ignored
+    NSArray *iterationDurations = [self.iterationDurations sortedArrayUsingSelector:@selector(compare:)];
+    self.iterationDurations = nil;
+    
+    [self cleanUpScenario];
+    
+    [HLSTrace setEnabled:m_traceWasEnabled];
+    
+    NSTimeInterval medianDuration = 0.;
+    NSTimeInterval totalDuration = 0.;
+    if ([iterationDurations count] != 0) {
+        medianDuration = [[iterationDurations objectAtIndex:[iterationDurations count] / 2] doubleValue];
+        for (NSNumber *iterationDuration in iterationDurations) {
+            totalDuration += [iterationDuration doubleValue];
+        }
+    }
+    NSTimeInterval maxDuration = [[iterationDurations lastObject] doubleValue];
+    NSUInteger finalResidentSize = StressTestResidentSize();
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"%@: %d / %d iterations, %@ (%@)\n\n",
+                               [self scenarioName],
+                               [iterationDurations count],
+                               [self iterationCount],
+                               [[UIDevice currentDevice] model],
+                               [[UIDevice currentDevice] systemVersion]];
+    [report appendFormat:@"Iterations: median %.1f ms, max %.1f ms, total %.1f ms\n", medianDuration * 1000., maxDuration * 1000.,
+     totalDuration * 1000.];
+    [report appendFormat:@"Resident memory: start %.1f MB, peak %.1f MB, end %.1f MB\n\n", m_initialResidentSize / (1024. * 1024.),
+     m_peakResidentSize / (1024. * 1024.), finalResidentSize / (1024. * 1024.)];
+    
+    [report appendFormat:@"%-14s %9s %10s %9s %8s\n", "Category", "Intervals", "Total (ms)", "Max (ms)", "Instants"];
+    NSDictionary *categoryToStatisticsMap = [HLSTrace statisticsByCategory];
+    for (NSString *category in [[categoryToStatisticsMap allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+        NSDictionary *statistics = [categoryToStatisticsMap objectForKey:category];
+        [report appendFormat:@"%-14s %9d %10.1f %9.1f %8d\n",
+         [category UTF8String],
+         [[statistics objectForKey:HLSTraceIntervalCountKey] unsignedIntegerValue],
+         [[statistics objectForKey:HLSTraceTotalIntervalDurationKey] doubleValue] * 1000.,
+         [[statistics objectForKey:HLSTraceLongestIntervalDurationKey] doubleValue] * 1000.,
+         [[statistics objectForKey:HLSTraceInstantCountKey] unsignedIntegerValue]];
+    }
+    
+    NSString *traceFilePath = [self traceFilePath];
+    NSError *error = nil;
+    if ([HLSTrace writeChromeTraceToFile:traceFilePath error:&error]) {
+        [report appendFormat:@"\nTrace: %@\n", traceFilePath];
+    }
+    else {
+        HLSLoggerError(@"The trace could not be written to %@. Reason: %@", traceFilePath, error);
+        traceFilePath = nil;
+    }
+    
+    self.reportTextView.text = report;
+    HLSLoggerInfo(@"Stress scenario results:\n%@", report);
+    
+    // A single line, so that results can be easily extracted from the logs
+    HLSLoggerInfo(@"HLSStress: {\"scenario\": \"%@\", \"iterations\": %d, \"median_ms\": %.4f, \"max_ms\": %.4f, \"total_ms\": %.4f, "
+                  "\"peak_memory_mb\": %.1f, \"trace\": \"%@\"}",
+                  [self scenarioName],
+                  [iterationDurations count],
+                  medianDuration * 1000.,
+                  maxDuration * 1000.,
+                  totalDuration * 1000.,
+                  m_peakResidentSize / (1024. * 1024.),
+                  traceFilePath ? traceFilePath : @"");
+    
+    self.startButton.enabled = YES;
+}
+
+- (NSString *)traceFilePath
+{
+    NSString *cachesDirectoryPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    NSString *tracesDirectoryPath = [cachesDirectoryPath stringByAppendingPathComponent:@"StressTraces"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:tracesDirectoryPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    return [tracesDirectoryPath stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.json", [self scenarioName]]];
+}
+
+#pragma mark Subclass hooks
+
+- (NSString *)scenarioName
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+- (NSUInteger)iterationCount
+{
+    HLSMissingMethodImplementation();
+    return 0;
+}
+
+- (void)prepareScenario
+{}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    HLSMissingMethodImplementation();
+}
+
+- (void)cleanUpScenario
+{}
+
+#pragma mark Event callbacks
+
+- (void)start:(id)sender
+{
+    self.startButton.enabled = NO;
+    self.reportTextView.text = nil;
+    
+    // Setup is not measured, and does not appear in the trace
+    [self prepareScenario];
+    
+    m_traceWasEnabled = [HLSTrace isEnabled];
+    [HLSTrace clear];
+    [HLSTrace setEnabled:YES];
+    
+    self.iterationDurations = [NSMutableArray arrayWithCapacity:[self iterationCount]];
+    m_iteration = 0;
+    m_initialResidentSize = StressTestResidentSize();
+    m_peakResidentSize = m_initialResidentSize;
+    
+    [self runNextIteration];
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSUInteger StressTestResidentSize(void)
+{
+    struct task_basic_info info;
+    mach_msg_type_number_t count = TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+}
@@ -0,0 +1,28 @@
+//
+//  CursorStressViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+/**
+ * Stress scenario for HLSCursor: A cursor with hundreds of elements (in a scroll view) is reloaded, either completely
+ * or partially, and its pointer then moved to a distant element. Reloads are recorded as "Cursor reload" intervals
+ * in the "Stress" trace category
+ *
+ * Designated initializer: -init
+ */
+@interface CursorStressViewController : StressTestViewController <HLSCursorDataSource, HLSCursorDelegate> {
+@private
+    UIScrollView *m_scrollView;
+    HLSCursor *m_cursor;
+    NSUInteger m_generation;
+}
+
+@property (nonatomic, retain) UIScrollView *scrollView;
+@property (nonatomic, retain) HLSCursor *cursor;
+
+@end
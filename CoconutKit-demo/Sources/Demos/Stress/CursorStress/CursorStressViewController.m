@@ -0,0 +1,126 @@
+//
+//  CursorStressViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "CursorStressViewController.h"
+
+#import "StressTestViewController+Protected.h"
+
+static const NSUInteger kCursorStressElementCount = 500;
+static const CGFloat kCursorStressElementWidth = 50.f;
+static const NSUInteger kCursorStressReloadedElementCount = 20;
+static const NSUInteger kCursorStressIterationCount = 50;
+
+@implementation CursorStressViewController
+
+#pragma mark Object creation and destruction
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    self.scrollView = nil;
+    self.cursor = nil;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize scrollView = m_scrollView;
+
+@synthesize cursor = m_cursor;
+
+#pragma mark View lifecycle
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    self.scrollView = [[[UIScrollView alloc] initWithFrame:self.contentView.bounds] autorelease];
+    self.scrollView.autoresizingMask = HLSViewAutoresizingAll;
+    [self.contentView addSubview:self.scrollView];
+    
+    CGFloat cursorHeight = 60.f;
+    CGRect cursorFrame = CGRectMake(0.f, floorf((CGRectGetHeight(self.scrollView.bounds) - cursorHeight) / 2.f),
+                                    kCursorStressElementCount * kCursorStressElementWidth, cursorHeight);
+    self.cursor = [[[HLSCursor alloc] initWithFrame:cursorFrame] autorelease];
+    self.cursor.animationDuration = 0.2;
+    self.cursor.dataSource = self;
+    self.cursor.delegate = self;
+    [self.scrollView addSubview:self.cursor];
+    self.scrollView.contentSize = CGSizeMake(CGRectGetWidth(cursorFrame), CGRectGetHeight(self.scrollView.bounds));
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Cursor with many elements", @"Cursor with many elements");
+}
+
+#pragma mark Stress scenario
+
+- (NSString *)scenarioName
+{
+    return @"CursorManyElements";
+}
+
+- (NSUInteger)iterationCount
+{
+    return kCursorStressIterationCount;
+}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    // Titles change with each generation, so that reloads have actual work to do. Alternate between complete and
+    // partial reloads
+    ++m_generation;
+    
+    HLSTraceIdentifier reloadTraceIdentifier = HLSTraceBegin(@"Stress", @"Cursor reload");
+    if (iteration % 2 == 0) {
+        [self.cursor reloadData];
+    }
+    else {
+        NSUInteger location = arc4random() % (kCursorStressElementCount - kCursorStressReloadedElementCount);
+        [self.cursor reloadElementsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(location, kCursorStressReloadedElementCount)]];
+    }
+    [self.cursor layoutIfNeeded];
+    HLSTraceEnd(reloadTraceIdentifier);
+    
+    // Move to a distant element. The iteration ends when the pointer has reached it
+    NSUInteger targetIndex = ([self.cursor selectedIndex] + kCursorStressElementCount / 4 + arc4random() % (kCursorStressElementCount / 2))
+        % kCursorStressElementCount;
+    [self.scrollView scrollRectToVisible:CGRectMake(targetIndex * kCursorStressElementWidth, 0.f, kCursorStressElementWidth, 1.f) animated:NO];
+    [self.cursor setSelectedIndex:targetIndex animated:YES];
+}
+
+#pragma mark HLSCursorDataSource protocol implementation
+
+- (NSUInteger)numberOfElementsForCursor:(HLSCursor *)cursor
+{
+    return kCursorStressElementCount;
+}
+
+- (NSString *)cursor:(HLSCursor *)cursor titleAtIndex:(NSUInteger)index
+{
+    return [NSString stringWithFormat:@"%d.%d", index, m_generation % 10];
+}
+
+- (UIFont *)cursor:(HLSCursor *)cursor fontAtIndex:(NSUInteger)index selected:(BOOL)selected
+{
+    return [UIFont systemFontOfSize:12.f];
+}
+
+#pragma mark HLSCursorDelegate protocol implementation
+
+- (void)cursor:(HLSCursor *)cursor didMoveToIndex:(NSUInteger)index
+{
+    [self iterationDidFinish];
+}
+
+@end
@@ -0,0 +1,23 @@
+//
+//  LocalizationStressViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+/**
+ * Stress scenario for dynamic localization: Hundreds of labels localized using prefixes (see UILabel+HLSDynamicLocalization.h)
+ * are displayed, and each iteration switches the application to the next available localization. The localization
+ * which was active when the scenario started is restored at the end
+ *
+ * Designated initializer: -init
+ */
+@interface LocalizationStressViewController : StressTestViewController {
+@private
+    NSString *m_originalLocalization;
+}
+
+@end
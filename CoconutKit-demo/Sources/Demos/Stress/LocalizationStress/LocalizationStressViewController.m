@@ -0,0 +1,112 @@
+//
+//  LocalizationStressViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "LocalizationStressViewController.h"
+
+#import "StressTestViewController+Protected.h"
+
+static const NSUInteger kLocalizationStressLabelCount = 300;
+static const NSUInteger kLocalizationStressIterationCount = 20;
+
+// Keys available in all Localizable.strings files of the demo
+static NSString * const kLocalizationStressKeys[] = {@"Animation", @"Core", @"Tasks", @"Views", @"View controllers", @"Start",
+    @"Light", @"Medium", @"Heavy", @"Transition", @"Top", @"Visible", @"Week", @"Width", @"Year", @"Label"};
+
+@interface LocalizationStressViewController ()
+
+@property (nonatomic, retain) NSString *originalLocalization;
+
+@end
+
+@implementation LocalizationStressViewController
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.originalLocalization = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize originalLocalization = m_originalLocalization;
+
+#pragma mark View lifecycle
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    NSUInteger keyCount = sizeof(kLocalizationStressKeys) / sizeof(NSString *);
+    NSUInteger columnCount = 10;
+    NSUInteger rowCount = ceilf((CGFloat)kLocalizationStressLabelCount / columnCount);
+    CGFloat labelWidth = CGRectGetWidth(self.contentView.bounds) / columnCount;
+    CGFloat labelHeight = CGRectGetHeight(self.contentView.bounds) / rowCount;
+    for (NSUInteger i = 0; i < kLocalizationStressLabelCount; ++i) {
+        CGRect labelFrame = CGRectMake((i % columnCount) * labelWidth, (i / columnCount) * labelHeight, labelWidth, labelHeight);
+        UILabel *label = [[[UILabel alloc] initWithFrame:labelFrame] autorelease];
+        label.font = [UIFont systemFontOfSize:6.f];
+        label.textColor = [UIColor whiteColor];
+        label.backgroundColor = [UIColor clearColor];
+        label.textAlignment = UITextAlignmentCenter;
+        label.text = [NSString stringWithFormat:@"LS/%@", kLocalizationStressKeys[i % keyCount]];
+        [self.contentView addSubview:label];
+    }
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Language switching", @"Language switching");
+}
+
+#pragma mark Stress scenario
+
+- (NSString *)scenarioName
+{
+    return @"LocalizationSwitching";
+}
+
+- (NSUInteger)iterationCount
+{
+    return kLocalizationStressIterationCount;
+}
+
+- (void)prepareScenario
+{
+    self.originalLocalization = [NSBundle localization];
+}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    // Labels and view controllers are relocalized synchronously when the localization changes
+    NSArray *localizations = [[NSBundle mainBundle] localizations];
+    NSUInteger index = [localizations indexOfObject:[NSBundle localization]];
+    NSString *localization = nil;
+    if (index == NSNotFound) {
+        localization = [localizations objectAtIndex:0];
+    }
+    else {
+        localization = [localizations objectAtIndex:(index + 1) % [localizations count]];
+    }
+    [NSBundle setLocalization:localization];
+    
+    [self iterationDidFinish];
+}
+
+- (void)cleanUpScenario
+{
+    [NSBundle setLocalization:self.originalLocalization];
+}
+
+@end
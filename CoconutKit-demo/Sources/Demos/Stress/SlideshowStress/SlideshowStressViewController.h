@@ -0,0 +1,26 @@
+//
+//  SlideshowStressViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+/**
+ * Stress scenario for HLSSlideshow: A Ken Burns slideshow runs for a long time with short timings and large images
+ * (generated once and stored in the caches directory). Each iteration lasts until the next image has been displayed,
+ * so that stalls due to image loading and decoding show up in the iteration durations
+ *
+ * Designated initializer: -init
+ */
+@interface SlideshowStressViewController : StressTestViewController <HLSSlideshowDelegate> {
+@private
+    HLSSlideshow *m_slideshow;
+    NSArray *m_imagePaths;
+}
+
+@property (nonatomic, retain) HLSSlideshow *slideshow;
+
+@end
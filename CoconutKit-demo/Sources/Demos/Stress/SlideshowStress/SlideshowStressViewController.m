@@ -0,0 +1,172 @@
+//
+//  SlideshowStressViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "SlideshowStressViewController.h"
+
+#import "StressTestViewController+Protected.h"
+
+static const NSUInteger kSlideshowStressImageCount = 8;
+static const CGSize kSlideshowStressImageSize = {2048.f, 1536.f};
+static const NSUInteger kSlideshowStressIterationCount = 120;
+
+@interface SlideshowStressViewController ()
+
+@property (nonatomic, retain) NSArray *imagePaths;
+
+- (NSString *)generateImageAtIndex:(NSUInteger)index inDirectory:(NSString *)directoryPath;
+
+@end
+
+@implementation SlideshowStressViewController
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.imagePaths = nil;
+    
+    [super dealloc];
+}
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    self.slideshow = nil;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize slideshow = m_slideshow;
+
+- (void)setSlideshow:(HLSSlideshow *)slideshow
+{
+    if (m_slideshow == slideshow) {
+        return;
+    }
+    
+    m_slideshow.delegate = nil;
+    [m_slideshow stop];
+    [m_slideshow release];
+    
+    m_slideshow = [slideshow retain];
+}
+
+@synthesize imagePaths = m_imagePaths;
+
+#pragma mark View lifecycle
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    self.slideshow = [[[HLSSlideshow alloc] initWithFrame:self.contentView.bounds] autorelease];
+    self.slideshow.autoresizingMask = HLSViewAutoresizingAll;
+    self.slideshow.effect = HLSSlideshowEffectKenBurns;
+    self.slideshow.imageDuration = 0.5;
+    self.slideshow.transitionDuration = 0.5;
+    self.slideshow.delegate = self;
+    [self.contentView addSubview:self.slideshow];
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Long slideshow", @"Long slideshow");
+}
+
+#pragma mark Stress scenario
+
+- (NSString *)scenarioName
+{
+    return @"SlideshowLargeImages";
+}
+
+- (NSUInteger)iterationCount
+{
+    return kSlideshowStressIterationCount;
+}
+
+- (void)prepareScenario
+{
+    // Images are generated once, and kept between runs
+    if (! self.imagePaths) {
+        NSString *cachesDirectoryPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        NSString *imagesDirectoryPath = [cachesDirectoryPath stringByAppendingPathComponent:@"SlideshowStressImages"];
+        [[NSFileManager defaultManager] createDirectoryAtPath:imagesDirectoryPath withIntermediateDirectories:YES attributes:nil error:NULL];
+        
+        NSMutableArray *imagePaths = [NSMutableArray arrayWithCapacity:kSlideshowStressImageCount];
+        for (NSUInteger i = 0; i < kSlideshowStressImageCount; ++i) {
+            NSString *imagePath = [self generateImageAtIndex:i inDirectory:imagesDirectoryPath];
+            if (imagePath) {
+                [imagePaths addObject:imagePath];
+            }
+        }
+        self.imagePaths = [NSArray arrayWithArray:imagePaths];
+    }
+    
+    self.slideshow.imageNamesOrPaths = self.imagePaths;
+}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    // The slideshow runs on its own. Iterations end each time a new image has been displayed
+    if (! self.slideshow.running) {
+        [self.slideshow play];
+    }
+}
+
+- (void)cleanUpScenario
+{
+    [self.slideshow stop];
+}
+
+- (NSString *)generateImageAtIndex:(NSUInteger)index inDirectory:(NSString *)directoryPath
+{
+    NSString *imagePath = [directoryPath stringByAppendingPathComponent:[NSString stringWithFormat:@"image_%d.jpg", index]];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:imagePath]) {
+        return imagePath;
+    }
+    
+    // Random tiles, so that JPEG compression does not produce trivially small files
+    UIGraphicsBeginImageContextWithOptions(kSlideshowStressImageSize, YES, 1.f);
+    CGContextRef context = UIGraphicsGetCurrentContext();
+    CGFloat tileSide = kSlideshowStressImageSize.width / 32.f;
+    for (CGFloat y = 0.f; y < kSlideshowStressImageSize.height; y += tileSide) {
+        for (CGFloat x = 0.f; x < kSlideshowStressImageSize.width; x += tileSide) {
+            CGContextSetFillColorWithColor(context, [UIColor randomColor].CGColor);
+            CGContextFillRect(context, CGRectMake(x, y, tileSide, tileSide));
+        }
+    }
+    
+    [[UIColor whiteColor] set];
+    NSString *indexString = [NSString stringWithFormat:@"%d", index];
+    [indexString drawAtPoint:CGPointMake(tileSide, tileSide) withFont:[UIFont boldSystemFontOfSize:400.f]];
+    
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    NSError *error = nil;
+    if (! [UIImageJPEGRepresentation(image, 0.8f) writeToFile:imagePath options:NSDataWritingAtomic error:&error]) {
+        HLSLoggerError(@"The image could not be written to %@. Reason: %@", imagePath, error);
+        return nil;
+    }
+    return imagePath;
+}
+
+#pragma mark HLSSlideshowDelegate protocol implementation
+
+- (void)slideshow:(HLSSlideshow *)slideshow didShowImageWithNameOrPath:(NSString *)imageNameOrPath
+{
+    [self iterationDidFinish];
+}
+
+@end
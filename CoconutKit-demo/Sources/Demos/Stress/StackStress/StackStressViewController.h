@@ -0,0 +1,25 @@
+//
+//  StackStressViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+/**
+ * Stress scenario for HLSStackController: Each iteration pushes view controllers with a dense view hierarchy one
+ * after the other until the stack is deep, then pops them back to the root, using short transitions
+ *
+ * Designated initializer: -init
+ */
+@interface StackStressViewController : StressTestViewController <HLSStackControllerDelegate> {
+@private
+    HLSContainerStack *m_containerStack;
+    HLSStackController *m_stressedStackController;
+    BOOL m_pushing;
+    BOOL m_transitioning;
+}
+
+@end
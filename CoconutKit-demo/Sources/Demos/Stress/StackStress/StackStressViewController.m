@@ -0,0 +1,260 @@
+//
+//  StackStressViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StackStressViewController.h"
+
+#import "StressTestViewController+Protected.h"
+
+static const NSUInteger kStackStressDepth = 20;
+static const NSUInteger kStackStressIterationCount = 5;
+static const NSTimeInterval kStackStressTransitionDuration = 0.1;
+static const NSUInteger kStackStressSubviewCount = 100;
+
+/**
+ * A view controller with a dense view hierarchy, whose color depends on its level in the stack
+ */
+@interface StackStressChildViewController : HLSViewController {
+@private
+    NSUInteger m_level;
+}
+
+- (id)initWithLevel:(NSUInteger)level;
+
+@end
+
+@interface StackStressViewController ()
+
+@property (nonatomic, retain) HLSContainerStack *containerStack;
+@property (nonatomic, retain) HLSStackController *stressedStackController;
+
+- (void)pushNextViewController;
+- (void)popViewController;
+
+@end
+
+@implementation StackStressViewController
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.containerStack = [HLSContainerStack singleControllerContainerStackWithContainerViewController:self];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.containerStack = nil;
+    self.stressedStackController = nil;
+    
+    [super dealloc];
+}
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    [self.containerStack releaseViews];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize containerStack = m_containerStack;
+
+@synthesize stressedStackController = m_stressedStackController;
+
+- (void)setStressedStackController:(HLSStackController *)stressedStackController
+{
+    if (m_stressedStackController == stressedStackController) {
+        return;
+    }
+    
+    m_stressedStackController.delegate = nil;
+    [m_stressedStackController release];
+    
+    m_stressedStackController = [stressedStackController retain];
+    m_stressedStackController.delegate = self;
+}
+
+#pragma mark View lifecycle
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    self.containerStack.containerView = self.contentView;
+}
+
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+    
+    [self.containerStack viewWillAppear:animated];
+}
+
+- (void)viewDidAppear:(BOOL)animated
+{
+    [super viewDidAppear:animated];
+    
+    [self.containerStack viewDidAppear:animated];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    
+    [self.containerStack viewWillDisappear:animated];
+}
+
+- (void)viewDidDisappear:(BOOL)animated
+{
+    [super viewDidDisappear:animated];
+    
+    [self.containerStack viewDidDisappear:animated];
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Deep stack", @"Deep stack");
+}
+
+#pragma mark Stress scenario
+
+- (NSString *)scenarioName
+{
+    return @"StackPushPop";
+}
+
+- (NSUInteger)iterationCount
+{
+    return kStackStressIterationCount;
+}
+
+- (void)prepareScenario
+{
+    StackStressChildViewController *rootViewController = [[[StackStressChildViewController alloc] initWithLevel:0] autorelease];
+    self.stressedStackController = [[[HLSStackController alloc] initWithRootViewController:rootViewController] autorelease];
+    [self.containerStack pushViewController:self.stressedStackController
+                        withTransitionClass:[HLSTransitionNone class]
+                                   duration:0.
+                                   animated:NO];
+}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    m_pushing = YES;
+    [self pushNextViewController];
+}
+
+- (void)cleanUpScenario
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(pushNextViewController) object:nil];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(popViewController) object:nil];
+    
+    m_transitioning = NO;
+    [self.containerStack popAllViewControllersAnimated:NO];
+    self.stressedStackController = nil;
+}
+
+- (void)pushNextViewController
+{
+    NSUInteger level = [[self.stressedStackController viewControllers] count];
+    StackStressChildViewController *childViewController = [[[StackStressChildViewController alloc] initWithLevel:level] autorelease];
+    m_transitioning = YES;
+    [self.stressedStackController pushViewController:childViewController
+                                 withTransitionClass:[HLSTransitionPushFromRight class]
+                                            duration:kStackStressTransitionDuration
+                                            animated:YES];
+}
+
+- (void)popViewController
+{
+    m_transitioning = YES;
+    [self.stressedStackController popViewControllerAnimated:YES];
+}
+
+#pragma mark HLSStackControllerDelegate protocol implementation
+
+- (void)stackController:(HLSStackController *)stackController
+  didShowViewController:(UIViewController *)viewController
+               animated:(BOOL)animated
+{
+    // Only consider the transitions triggered by the scenario (e.g. not the initial display of the root view controller)
+    if (! [self isRunning] || ! m_transitioning) {
+        return;
+    }
+    m_transitioning = NO;
+    
+    // Chain transitions once the stack has finished processing the current one. Go back to the root once deep enough
+    NSUInteger count = [[stackController viewControllers] count];
+    if (m_pushing) {
+        if (count <= kStackStressDepth) {
+            [self performSelector:@selector(pushNextViewController) withObject:nil afterDelay:0.];
+        }
+        else {
+            m_pushing = NO;
+            [self performSelector:@selector(popViewController) withObject:nil afterDelay:0.];
+        }
+    }
+    else {
+        if (count > 1) {
+            [self performSelector:@selector(popViewController) withObject:nil afterDelay:0.];
+        }
+        else {
+            [self iterationDidFinish];
+        }
+    }
+}
+
+@end
+
+@implementation StackStressChildViewController
+
+#pragma mark Object creation and destruction
+
+- (id)initWithLevel:(NSUInteger)level
+{
+    if ((self = [super init])) {
+        m_level = level;
+    }
+    return self;
+}
+
+#pragma mark View lifecycle
+
+- (void)loadView
+{
+    UIView *view = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 240.f)] autorelease];
+    view.backgroundColor = [UIColor colorWithHue:(m_level % 10) / 10.f saturation:0.6f brightness:0.8f alpha:1.f];
+    view.autoresizingMask = HLSViewAutoresizingAll;
+    
+    NSUInteger columnCount = ceilf(sqrtf(kStackStressSubviewCount));
+    NSUInteger rowCount = ceilf((CGFloat)kStackStressSubviewCount / columnCount);
+    CGFloat tileWidth = CGRectGetWidth(view.bounds) / columnCount;
+    CGFloat tileHeight = CGRectGetHeight(view.bounds) / rowCount;
+    for (NSUInteger i = 0; i < kStackStressSubviewCount; ++i) {
+        CGRect tileFrame = CGRectMake((i % columnCount) * tileWidth, (i / columnCount) * tileHeight, tileWidth, tileHeight);
+        UILabel *tileLabel = [[[UILabel alloc] initWithFrame:CGRectInset(tileFrame, 1.f, 1.f)] autorelease];
+        tileLabel.text = [NSString stringWithFormat:@"%d.%d", m_level, i];
+        tileLabel.textAlignment = UITextAlignmentCenter;
+        tileLabel.font = [UIFont systemFontOfSize:8.f];
+        tileLabel.backgroundColor = [UIColor colorWithWhite:1.f alpha:0.5f];
+        tileLabel.autoresizingMask = HLSViewAutoresizingAll;
+        [view addSubview:tileLabel];
+    }
+    
+    self.view = view;
+}
+
+@end
@@ -0,0 +1,26 @@
+//
+//  TaskStressViewController.h
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "StressTestViewController.h"
+
+/**
+ * Stress scenario for HLSTaskManager: Each iteration submits hundreds of short tasks one by one to the default
+ * manager, and ends when all of them have been processed. The label displays the number of tasks processed, so that
+ * the cost of delivering results to the main thread is included
+ *
+ * Designated initializer: -init
+ */
+@interface TaskStressViewController : StressTestViewController <HLSTaskDelegate> {
+@private
+    UILabel *m_progressLabel;
+    NSUInteger m_nbrProcessedTasks;
+}
+
+@property (nonatomic, retain) UILabel *progressLabel;
+
+@end
@@ -0,0 +1,123 @@
+//
+//  TaskStressViewController.m
+//  CoconutKit-demo
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "TaskStressViewController.h"
+
+#import "SleepTask.h"
+#import "StressTestViewController+Protected.h"
+
+static const NSUInteger kTaskStressTaskCount = 500;
+static const NSUInteger kTaskStressIterationCount = 10;
+
+@interface TaskStressViewController ()
+
+- (void)taskDidEnd:(HLSTask *)task;
+
+@end
+
+@implementation TaskStressViewController
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    // Do not let a dying object listen to task events
+    [[HLSTaskManager defaultManager] cancelTasksWithDelegate:self];
+    
+    [super dealloc];
+}
+
+- (void)releaseViews
+{
+    [super releaseViews];
+    
+    self.progressLabel = nil;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize progressLabel = m_progressLabel;
+
+#pragma mark View lifecycle
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+    
+    self.progressLabel = [[[UILabel alloc] initWithFrame:self.contentView.bounds] autorelease];
+    self.progressLabel.autoresizingMask = HLSViewAutoresizingAll;
+    self.progressLabel.textAlignment = UITextAlignmentCenter;
+    self.progressLabel.textColor = [UIColor whiteColor];
+    self.progressLabel.backgroundColor = [UIColor clearColor];
+    self.progressLabel.font = [UIFont boldSystemFontOfSize:40.f];
+    [self.contentView addSubview:self.progressLabel];
+}
+
+#pragma mark Localization
+
+- (void)localize
+{
+    [super localize];
+    
+    self.title = NSLocalizedString(@"Bulk task submission", @"Bulk task submission");
+}
+
+#pragma mark Stress scenario
+
+- (NSString *)scenarioName
+{
+    return @"TaskBulkSubmission";
+}
+
+- (NSUInteger)iterationCount
+{
+    return kTaskStressIterationCount;
+}
+
+- (void)runIteration:(NSUInteger)iteration
+{
+    m_nbrProcessedTasks = 0;
+    
+    // Tasks are submitted one by one (not as a task group), as an application reacting to many events would do. A
+    // sleep task with no duration ends immediately, the manager overhead is therefore measured
+    HLSTaskManager *taskManager = [HLSTaskManager defaultManager];
+    for (NSUInteger i = 0; i < kTaskStressTaskCount; ++i) {
+        SleepTask *sleepTask = [[[SleepTask alloc] initWithSecondsToSleep:0] autorelease];
+        [taskManager registerDelegate:self forTask:sleepTask];
+        [taskManager submitTask:sleepTask];
+    }
+}
+
+- (void)cleanUpScenario
+{
+    [[HLSTaskManager defaultManager] cancelTasksWithDelegate:self];
+}
+
+- (void)taskDidEnd:(HLSTask *)task
+{
+    ++m_nbrProcessedTasks;
+    self.progressLabel.text = [NSString stringWithFormat:@"%d / %d", m_nbrProcessedTasks, kTaskStressTaskCount];
+    
+    if (m_nbrProcessedTasks == kTaskStressTaskCount) {
+        [self iterationDidFinish];
+    }
+}
+
+#pragma mark HLSTaskDelegate protocol implementation
+
+- (void)taskHasBeenProcessed:(HLSTask *)task
+{
+    [self taskDidEnd:task];
+}
+
+- (void)taskHasBeenCancelled:(HLSTask *)task
+{
+    [self taskDidEnd:task];
+}
+
+@end
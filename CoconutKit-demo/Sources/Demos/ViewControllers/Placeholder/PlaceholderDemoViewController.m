@@ -162,7 +162,7 @@ typedef enum {
     NSString *transitionName = [[HLSTransition availableTransitionNames] objectAtIndex:pickedIndex];
     
     @try {
-        [self setInsetViewController:insetViewController atIndex:index withTransitionClass:NSClassFromString(transitionName)];
+        [self setInsetViewController:insetViewController atIndex:index withTransitionClass:[HLSTransition transitionClassForName:transitionName]];
     }
     @catch (NSException *exception) {
         UIAlertView *alertView = [[[UIAlertView alloc] initWithTitle:NSLocalizedString(@"Error", @"Error")
@@ -259,7 +259,7 @@
     NSUInteger pickedIndex = [self.transitionPickerView selectedRowInComponent:0];
     NSString *transitionName = [[HLSTransition availableTransitionNames] objectAtIndex:pickedIndex];
     [self.stackController pushViewController:viewController
-                         withTransitionClass:NSClassFromString(transitionName)
+                         withTransitionClass:[HLSTransition transitionClassForName:transitionName]
                                     animated:self.animatedSwitch.on];
 }
 
@@ -254,7 +254,7 @@ typedef enum {
     @try {
         [stackController insertViewController:pushedViewController
                                       atIndex:[self insertionIndex]
-                          withTransitionClass:NSClassFromString(transitionName)
+                          withTransitionClass:[HLSTransition transitionClassForName:transitionName]
                                      duration:kAnimationTransitionDefaultDuration
                                      animated:self.animatedSwitch.on];
     }
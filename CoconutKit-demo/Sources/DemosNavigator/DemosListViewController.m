@@ -10,21 +10,27 @@
 
 #import "ActionSheetDemoViewController.h"
 #import "CursorDemoViewController.h"
+#import "CursorStressViewController.h"
 #import "DynamicLocalizationDemoViewController.h"
 #import "ExpandingSearchBarDemoViewController.h"
 #import "FixedSizeViewController.h"
 #import "LabelDemoViewController.h"
 #import "LayerPropertiesTestViewController.h"
+#import "LocalizationStressViewController.h"
 #import "ParallaxScrollingDemoViewController.h"
 #import "ParallelProcessingDemoViewController.h"
 #import "PlaceholderDemoViewController.h"
 #import "AnimationDemoViewController.h"
 #import "SkinningDemoViewController.h"
 #import "SlideshowDemoViewController.h"
+#import "SlideshowStressViewController.h"
 #import "StackDemoViewController.h"
+#import "StackStressViewController.h"
 #import "TableSearchDisplayDemoViewController.h"
 #import "TableViewCellsDemoViewController.h"
+#import "TaskStressViewController.h"
 #import "TextFieldsDemoViewController.h"
+#import "TransitionBenchmarkViewController.h"
 #import "WebViewDemoViewController.h"
 #import "WizardDemoViewController.h"
 
@@ -36,6 +42,7 @@ typedef enum {
     DemoCategoryIndexTask,
     DemoCategoryIndexView,
     DemoCategoryIndexViewControllers,
+    DemoCategoryIndexStress,
     DemoCategoryIndexEnumEnd,
     DemoCategoryIndexEnumSize = DemoCategoryIndexEnumEnd - DemoCategoryIndexEnumBegin
 } DemoCategoryIndex;
@@ -45,6 +52,7 @@ typedef enum {
     AnimationDemoIndexEnumBegin = 0,
     AnimationDemoIndexAnimation = AnimationDemoIndexEnumBegin,
     AnimationDemoIndexLayerPropertiesTest,
+    AnimationDemoIndexTransitionBenchmark,
     AnimationDemoIndexEnumEnd,
     AnimationDemoIndexEnumSize = AnimationDemoIndexEnumEnd - AnimationDemoIndexEnumBegin
 } AnimationDemoIndex;
@@ -95,6 +103,18 @@ typedef enum {
     ViewControllersDemoIndexEnumSize = ViewControllersDemoIndexEnumEnd - ViewControllersDemoIndexEnumBegin
 } ViewControllersDemoIndex;
 
+// Stress scenarios
+typedef enum {
+    StressDemoIndexEnumBegin = 0,
+    StressDemoIndexStack = StressDemoIndexEnumBegin,
+    StressDemoIndexSlideshow,
+    StressDemoIndexCursor,
+    StressDemoIndexTask,
+    StressDemoIndexLocalization,
+    StressDemoIndexEnumEnd,
+    StressDemoIndexEnumSize = StressDemoIndexEnumEnd - StressDemoIndexEnumBegin
+} StressDemoIndex;
+
 @interface DemosListViewController ()
 
 @property (nonatomic, retain) UITableView *tableView;
@@ -180,6 +200,11 @@ typedef enum {
             break;
         }
             
+        case DemoCategoryIndexStress: {
+            return NSLocalizedString(@"Stress tests", @"Stress tests");
+            break;
+        }
+            
         default: {
             return nil;
             break;
@@ -215,6 +240,11 @@ typedef enum {
             break;
         }   
             
+        case DemoCategoryIndexStress: {
+            return StressDemoIndexEnumSize;
+            break;
+        }
+            
         default: {
             return 0;
             break;
@@ -239,6 +269,11 @@ typedef enum {
                     break;
                 }
                     
+                case AnimationDemoIndexTransitionBenchmark: {
+                    cell.textLabel.text = NSLocalizedString(@"Transition benchmark", @"Transition benchmark");
+                    break;
+                }
+                    
                 default: {
                     return nil;
                     break;
@@ -396,6 +431,41 @@ typedef enum {
             break;
         }
             
+        case DemoCategoryIndexStress: {
+            switch (indexPath.row) {
+                case StressDemoIndexStack: {
+                    cell.textLabel.text = NSLocalizedString(@"Deep stack", @"Deep stack");
+                    break;
+                }
+                    
+                case StressDemoIndexSlideshow: {
+                    cell.textLabel.text = NSLocalizedString(@"Long slideshow", @"Long slideshow");
+                    break;
+                }
+                    
+                case StressDemoIndexCursor: {
+                    cell.textLabel.text = NSLocalizedString(@"Cursor with many elements", @"Cursor with many elements");
+                    break;
+                }
+                    
+                case StressDemoIndexTask: {
+                    cell.textLabel.text = NSLocalizedString(@"Bulk task submission", @"Bulk task submission");
+                    break;
+                }
+                    
+                case StressDemoIndexLocalization: {
+                    cell.textLabel.text = NSLocalizedString(@"Language switching", @"Language switching");
+                    break;
+                }
+                    
+                default: {
+                    return nil;
+                    break;
+                }
+            }
+            break;
+        }
+            
         default: {
             return nil;
             break;
@@ -422,6 +492,11 @@ typedef enum {
                     break;
                 }
                     
+                case AnimationDemoIndexTransitionBenchmark: {
+                    demoViewController = [[[TransitionBenchmarkViewController alloc] init] autorelease];
+                    break;
+                }
+                    
                 default: {
                     return;
                     break;
@@ -571,6 +646,41 @@ typedef enum {
             break;
         }
             
+        case DemoCategoryIndexStress: {
+            switch (indexPath.row) {
+                case StressDemoIndexStack: {
+                    demoViewController = [[[StackStressViewController alloc] init] autorelease];
+                    break;
+                }
+                    
+                case StressDemoIndexSlideshow: {
+                    demoViewController = [[[SlideshowStressViewController alloc] init] autorelease];
+                    break;
+                }
+                    
+                case StressDemoIndexCursor: {
+                    demoViewController = [[[CursorStressViewController alloc] init] autorelease];
+                    break;
+                }
+                    
+                case StressDemoIndexTask: {
+                    demoViewController = [[[TaskStressViewController alloc] init] autorelease];
+                    break;
+                }
+                    
+                case StressDemoIndexLocalization: {
+                    demoViewController = [[[LocalizationStressViewController alloc] init] autorelease];
+                    break;
+                }
+                    
+                default: {
+                    return;
+                    break;
+                }
+            }
+            break;
+        }
+            
         default: {
             return;
             break;
@@ -8,6 +8,14 @@
 
 #import "CustomTransitions.h"
 
+// Register custom transitions so that they are available along with built-in ones
+HLSRegisterTransition(CustomTransitionFallFromTop)
+HLSRegisterTransition(CustomTransitionRotateVerticallyCounterclockwise)
+HLSRegisterTransition(CustomTransitionRotateVerticallyClockwise)
+HLSRegisterTransition(CustomTransitionRotateHorizontallyCounterclockwise)
+HLSRegisterTransition(CustomTransitionRotateHorizontallyClockwise)
+HLSRegisterTransition(CustomTransitionFadeInBlur)
+
 @interface CustomTransition : NSObject
 
 + (NSArray *)rotateLayerAnimationStepsAroundVectorWithX:(CGFloat)x
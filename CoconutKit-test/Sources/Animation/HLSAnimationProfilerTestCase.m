@@ -0,0 +1,82 @@
+//
+//  HLSAnimationProfilerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAnimationProfilerTestCase.h"
+
+@implementation HLSAnimationProfilerTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // The profiler must be used from the main thread, whose run loop drives the display link
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testProfiling
+{
+    // Use a separate profiler, so that animations played meanwhile are not recorded
+    HLSAnimationProfiler *animationProfiler = [[[HLSAnimationProfiler alloc] init] autorelease];
+    animationProfiler.enabled = YES;
+    
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray array]];
+    animation.tag = @"profiled";
+    
+    // Two animations with the same tag are accumulated
+    for (NSUInteger i = 0; i < 2; ++i) {
+        [animationProfiler startProfilingAnimation:animation];
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+        [animationProfiler stopProfilingAnimation:animation discarding:NO];
+    }
+    
+    NSDictionary *report = [animationProfiler reportForTag:@"profiled"];
+    GHAssertEquals([[report objectForKey:HLSAnimationProfilerAnimationCountKey] unsignedIntegerValue], 2U, @"Animations");
+    GHAssertTrue([[report objectForKey:HLSAnimationProfilerFrameCountKey] unsignedIntegerValue] > 0, @"Frames");
+    
+    double longestFrameDuration = [[report objectForKey:HLSAnimationProfilerLongestFrameDurationKey] doubleValue];
+    double p95FrameDuration = [[report objectForKey:HLSAnimationProfilerP95FrameDurationKey] doubleValue];
+    GHAssertTrue(longestFrameDuration > 0., @"Longest frame");
+    GHAssertTrue(p95FrameDuration > 0. && p95FrameDuration <= longestFrameDuration, @"p95 frame");
+    
+    GHAssertNil([animationProfiler reportForTag:nil], @"No untagged animation");
+    GHAssertEqualObjects([[animationProfiler reports] allKeys], [NSArray arrayWithObject:@"profiled"], @"Reports");
+    
+    [animationProfiler reset];
+    GHAssertNil([animationProfiler reportForTag:@"profiled"], @"Reset");
+    GHAssertEquals([[animationProfiler reports] count], 0U, @"Reset");
+}
+
+- (void)testDiscardedAndDisabledProfiling
+{
+    HLSAnimationProfiler *animationProfiler = [[[HLSAnimationProfiler alloc] init] autorelease];
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray array]];
+    
+    // Not enabled
+    [animationProfiler startProfilingAnimation:animation];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    [animationProfiler stopProfilingAnimation:animation discarding:NO];
+    GHAssertNil([animationProfiler reportForTag:nil], @"Disabled");
+    
+    // Discarded (e.g. cancelled animation)
+    animationProfiler.enabled = YES;
+    [animationProfiler startProfilingAnimation:animation];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    [animationProfiler stopProfilingAnimation:animation discarding:YES];
+    GHAssertNil([animationProfiler reportForTag:nil], @"Discarded");
+    
+    // Untagged animations are reported under a dedicated key
+    [animationProfiler startProfilingAnimation:animation];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    [animationProfiler stopProfilingAnimation:animation discarding:NO];
+    GHAssertNotNil([animationProfiler reportForTag:nil], @"Untagged");
+    GHAssertNotNil([[animationProfiler reports] objectForKey:HLSAnimationProfilerUntaggedAnimationKey], @"Untagged");
+}
+
+@end
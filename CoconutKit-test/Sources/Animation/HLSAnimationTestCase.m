@@ -0,0 +1,161 @@
+//
+//  HLSAnimationTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAnimationTestCase.h"
+
+// Records the steps which have been played, as "<class> <tag> <duration>" strings
+@interface HLSAnimationTestDelegate : NSObject <HLSAnimationDelegate> {
+@private
+    NSMutableArray *m_finishedStepDescriptions;
+}
+
+@property (nonatomic, readonly, retain) NSArray *finishedStepDescriptions;
+
+@end
+
+// Static functions
+static void HLSAnimationTestPlay(HLSAnimation *animation);
+
+@implementation HLSAnimationTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Animations must be played from the main thread
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testArchivingRoundTrip
+{
+    UIView *view1 = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)] autorelease];
+    UIView *view2 = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)] autorelease];
+    CALayer *layer = [CALayer layer];
+    
+    HLSLayerAnimationStep *animationStep1 = [HLSLayerAnimationStep animationStep];
+    animationStep1.tag = @"step1";
+    animationStep1.duration = 0.4;
+    animationStep1.timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseIn];
+    HLSLayerAnimation *layerAnimation11 = [HLSLayerAnimation animation];
+    [layerAnimation11 translateByVectorWithX:10.f y:20.f];
+    [layerAnimation11 addToOpacity:-0.5f];
+    [animationStep1 addLayerAnimation:layerAnimation11 forView:view1];
+    HLSLayerAnimation *layerAnimation12 = [HLSLayerAnimation animation];
+    [layerAnimation12 addToOpacity:-0.25f];
+    [animationStep1 addLayerAnimation:layerAnimation12 forLayer:layer];
+    
+    HLSViewAnimationStep *animationStep2 = [HLSViewAnimationStep animationStep];
+    animationStep2.tag = @"step2";
+    animationStep2.duration = 0.2;
+    animationStep2.curve = UIViewAnimationCurveLinear;
+    HLSViewAnimation *viewAnimation21 = [HLSViewAnimation animation];
+    [viewAnimation21 addToAlpha:-0.5f];
+    [animationStep2 addViewAnimation:viewAnimation21 forView:view2];
+    
+    // The first view is animated by the second step as well. A view and its layer are a single target
+    HLSViewAnimation *viewAnimation22 = [HLSViewAnimation animation];
+    [viewAnimation22 addToAlpha:-0.25f];
+    [animationStep2 addViewAnimation:viewAnimation22 forView:view1];
+    
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithObjects:animationStep1, animationStep2, nil]];
+    animation.tag = @"archived";
+    animation.lockingUI = YES;
+    animation.userInfo = [NSDictionary dictionaryWithObject:@"value" forKey:@"key"];
+    
+    // Animations which have not been unarchived cannot be bound
+    GHAssertEquals([animation numberOfTargets], 0U, nil);
+    GHAssertNil([animation animationWithTargets:[NSArray arrayWithObjects:view1, layer, view2, nil]], nil);
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSAnimationTestCase.animation"];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    GHAssertTrue([animation writeToFile:path], nil);
+    
+    HLSAnimation *unarchivedAnimation = [HLSAnimation animationWithContentsOfFile:path];
+    GHAssertNotNil(unarchivedAnimation, nil);
+    GHAssertEqualStrings(unarchivedAnimation.tag, @"archived", nil);
+    GHAssertTrue(unarchivedAnimation.lockingUI, nil);
+    GHAssertNil(unarchivedAnimation.userInfo, nil);
+    GHAssertEqualsWithAccuracy(unarchivedAnimation.duration, 0.6, 1e-6, nil);
+    
+    // Targets are numbered in the order they first appear
+    GHAssertEquals([unarchivedAnimation numberOfTargets], 3U, nil);
+    GHAssertNil([unarchivedAnimation animationWithTargets:[NSArray arrayWithObject:view1]], nil);
+    
+    // Bind to fresh objects twice, and check that both bound animations animate their own targets
+    for (NSUInteger i = 0; i < 2; ++i) {
+        UIView *boundView1 = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)] autorelease];
+        CALayer *boundLayer = [CALayer layer];
+        UIView *boundView2 = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 100.f)] autorelease];
+        HLSAnimation *boundAnimation = [unarchivedAnimation animationWithTargets:[NSArray arrayWithObjects:boundView1, boundLayer, boundView2, nil]];
+        GHAssertNotNil(boundAnimation, nil);
+        GHAssertEqualStrings(boundAnimation.tag, @"archived", nil);
+        GHAssertEqualsWithAccuracy(boundAnimation.duration, 0.6, 1e-6, nil);
+        
+        HLSAnimationTestDelegate *delegate = [[[HLSAnimationTestDelegate alloc] init] autorelease];
+        boundAnimation.delegate = delegate;
+        HLSAnimationTestPlay(boundAnimation);
+        boundAnimation.delegate = nil;
+        
+        GHAssertEqualObjects(delegate.finishedStepDescriptions, ([NSArray arrayWithObjects:@"HLSLayerAnimationStep step1 0.4", 
+                                                                  @"HLSViewAnimationStep step2 0.2", nil]), nil);
+        
+        GHAssertEqualsWithAccuracy(boundView1.layer.transform.m41, 10.f, 1e-6f, nil);
+        GHAssertEqualsWithAccuracy(boundView1.layer.transform.m42, 20.f, 1e-6f, nil);
+        GHAssertEqualsWithAccuracy(boundView1.alpha, 0.25f, 1e-6f, nil);
+        GHAssertEqualsWithAccuracy(boundLayer.opacity, 0.75f, 1e-6f, nil);
+        GHAssertEqualsWithAccuracy(boundView2.alpha, 0.5f, 1e-6f, nil);
+    }
+    
+    // The original objects are left untouched
+    GHAssertEqualsWithAccuracy(view1.layer.opacity, 1.f, 1e-6f, nil);
+    GHAssertEqualsWithAccuracy(layer.opacity, 1.f, 1e-6f, nil);
+    GHAssertEqualsWithAccuracy(view2.alpha, 1.f, 1e-6f, nil);
+}
+
+@end
+
+@implementation HLSAnimationTestDelegate
+
+- (id)init
+{
+    if ((self = [super init])) {
+        m_finishedStepDescriptions = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_finishedStepDescriptions release];
+    
+    [super dealloc];
+}
+
+@synthesize finishedStepDescriptions = m_finishedStepDescriptions;
+
+- (void)animation:(HLSAnimation *)animation didFinishStep:(HLSAnimationStep *)animationStep animated:(BOOL)animated
+{
+    [m_finishedStepDescriptions addObject:[NSString stringWithFormat:@"%@ %@ %.1f", [animationStep class], animationStep.tag, animationStep.duration]];
+}
+
+@end
+
+#pragma mark Static functions
+
+// Play an animation without animation and wait until it is over
+static void HLSAnimationTestPlay(HLSAnimation *animation)
+{
+    [animation playAnimated:NO];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && animation.running) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+}
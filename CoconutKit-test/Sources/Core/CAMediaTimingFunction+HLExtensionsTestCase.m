@@ -32,4 +32,44 @@
     }
 }
 
+- (void)testEvaluation
+{
+    CAMediaTimingFunction *linearTimingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionLinear];
+    for (NSUInteger i = 0; i <= 10; ++i) {
+        float time = i / 10.f;
+        GHAssertEqualsWithAccuracy([linearTimingFunction valueForTime:time], time, 1e-5f, @"Linear");
+    }
+    
+    // Ease in ease out is symmetric
+    CAMediaTimingFunction *easeInEaseOutTimingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];
+    GHAssertEqualsWithAccuracy([easeInEaseOutTimingFunction valueForTime:0.5f], 0.5f, 1e-5f, @"Ease in ease out");
+    GHAssertEqualsWithAccuracy([easeInEaseOutTimingFunction valueForTime:0.2f], 1.f - [easeInEaseOutTimingFunction valueForTime:0.8f], 1e-5f, 
+                               @"Ease in ease out");
+    
+    // Clamped
+    GHAssertEquals([easeInEaseOutTimingFunction valueForTime:-1.f], 0.f, @"Clamped");
+    GHAssertEquals([easeInEaseOutTimingFunction valueForTime:2.f], 1.f, @"Clamped");
+    
+    // Ease in is below the diagonal
+    CAMediaTimingFunction *easeInTimingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseIn];
+    GHAssertTrue([easeInTimingFunction valueForTime:0.5f] < 0.5f, @"Ease in");
+    
+    // Batch evaluation, in place
+    static const size_t kCount = 101;
+    float times[kCount];
+    for (size_t i = 0; i < kCount; ++i) {
+        times[i] = i / (float)(kCount - 1);
+    }
+    float values[kCount];
+    [easeInTimingFunction getValues:values forTimes:times count:kCount];
+    [easeInTimingFunction getValues:times forTimes:times count:kCount];
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(values[i], times[i], @"Batch");
+        GHAssertEquals(values[i], [easeInTimingFunction valueForTime:i / (float)(kCount - 1)], @"Batch");
+        if (i != 0) {
+            GHAssertTrue(values[i] >= values[i - 1], @"Increasing");
+        }
+    }
+}
+
 @end
@@ -0,0 +1,59 @@
+//
+//  HLSAllocationTrackerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAllocationTrackerTestCase.h"
+
+#import "HLSAllocationTracker+Friend.h"
+
+@implementation HLSAllocationTrackerTestCase
+
+#pragma mark Test setup and tear down
+
+- (void)tearDown
+{
+    [HLSAllocationTracker setTrackingEnabled:NO];
+    [HLSAllocationTracker reset];
+}
+
+#pragma mark Tests
+
+- (void)testTracking
+{
+    [HLSAllocationTracker setTrackingEnabled:YES];
+    [HLSAllocationTracker reset];
+    
+    NSAutoreleasePool *outerPool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCore);
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [[[NSObject alloc] init] autorelease];
+    }
+    
+    // Objects are accounted to the innermost pool
+    NSAutoreleasePool *innerPool = HLSAutoreleasePoolPush(HLSAllocationSubsystemTask);
+    for (NSUInteger i = 0; i < 5; ++i) {
+        [[[NSObject alloc] init] autorelease];
+    }
+    HLSAutoreleasePoolPop(innerPool);
+    HLSAutoreleasePoolPop(outerPool);
+    
+    GHAssertTrue([HLSAllocationTracker allocationCountForSubsystem:HLSAllocationSubsystemCore] >= 10, @"Allocations");
+    GHAssertTrue([HLSAllocationTracker autoreleaseCountForSubsystem:HLSAllocationSubsystemCore] >= 10, @"Autoreleases");
+    GHAssertTrue([HLSAllocationTracker peakAutoreleasePoolSizeForSubsystem:HLSAllocationSubsystemCore] >= 10, @"Peak pool size");
+    GHAssertTrue([HLSAllocationTracker peakAutoreleasePoolSizeForSubsystem:HLSAllocationSubsystemCore] < 15, @"Inner pool not accounted");
+    GHAssertTrue([HLSAllocationTracker peakAutoreleasePoolSizeForSubsystem:HLSAllocationSubsystemTask] >= 5, @"Peak pool size");
+    GHAssertTrue([[HLSAllocationTracker report] rangeOfString:@"Task: "].length != 0, @"Report");
+    
+    // Nothing is counted when tracking is disabled
+    [HLSAllocationTracker setTrackingEnabled:NO];
+    [HLSAllocationTracker reset];
+    NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCore);
+    [[[NSObject alloc] init] autorelease];
+    HLSAutoreleasePoolPop(pool);
+    GHAssertEquals([HLSAllocationTracker autoreleaseCountForSubsystem:HLSAllocationSubsystemCore], (NSUInteger)0, @"Disabled");
+}
+
+@end
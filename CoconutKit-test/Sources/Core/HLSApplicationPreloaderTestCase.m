@@ -0,0 +1,99 @@
+//
+//  HLSApplicationPreloaderTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSApplicationPreloaderTestCase.h"
+
+#import "HLSApplicationPreloader+Friend.h"
+
+@implementation HLSApplicationPreloaderTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Stages are registered and run from the main thread, which must therefore run its run loop
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testBuiltInStages
+{
+    [HLSApplicationPreloader registerBuiltInStages];
+    [HLSApplicationPreloader startStages];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while ([timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        
+        NSDictionary *stageDurations = [HLSApplicationPreloader stageDurations];
+        if ([stageDurations objectForKey:HLSApplicationPreloadingStageLocalization]
+                && [stageDurations objectForKey:HLSApplicationPreloadingStageTransitions]) {
+            break;
+        }
+    }
+    
+    NSDictionary *stageDurations = [HLSApplicationPreloader stageDurations];
+    GHAssertNotNil([stageDurations objectForKey:HLSApplicationPreloadingStageLocalization], @"Localization stage");
+    GHAssertNotNil([stageDurations objectForKey:HLSApplicationPreloadingStageTransitions], @"Transitions stage");
+}
+
+- (void)testStageOrder
+{
+    // Stages are registered before they are started, or in the same run loop pass if they have already been started
+    NSMutableArray *mainThreadStageNames = [NSMutableArray array];
+    NSMutableArray *backgroundStageNames = [NSMutableArray array];
+    __block BOOL backgroundStagesOnMainThread = NO;
+    for (NSString *name in [NSArray arrayWithObjects:@"low", @"high", @"medium1", @"medium2", nil]) {
+        NSInteger priority = [name isEqualToString:@"low"] ? 1 : ([name isEqualToString:@"high"] ? 3 : 2);
+        NSString *mainThreadStageName = [NSString stringWithFormat:@"HLSApplicationPreloaderTestCase main thread %@", name];
+        [HLSApplicationPreloader registerStageWithName:mainThreadStageName priority:priority onMainThread:YES block:^{
+            [mainThreadStageNames addObject:name];
+        }];
+        
+        // Background stages run one after the other, the array is only accessed by one stage at a time
+        NSString *backgroundStageName = [NSString stringWithFormat:@"HLSApplicationPreloaderTestCase background %@", name];
+        [HLSApplicationPreloader registerStageWithName:backgroundStageName priority:priority onMainThread:NO block:^{
+            if ([NSThread isMainThread]) {
+                backgroundStagesOnMainThread = YES;
+            }
+            @synchronized(backgroundStageNames) {
+                [backgroundStageNames addObject:name];
+            }
+        }];
+    }
+    [HLSApplicationPreloader startStages];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while ([timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        
+        NSUInteger backgroundStageCount = 0;
+        @synchronized(backgroundStageNames) {
+            backgroundStageCount = [backgroundStageNames count];
+        }
+        if ([mainThreadStageNames count] == 4 && backgroundStageCount == 4) {
+            break;
+        }
+    }
+    
+    // By decreasing priority, then in registration order
+    NSArray *expectedStageNames = [NSArray arrayWithObjects:@"high", @"medium1", @"medium2", @"low", nil];
+    GHAssertEqualObjects(mainThreadStageNames, expectedStageNames, @"Main thread stages");
+    @synchronized(backgroundStageNames) {
+        GHAssertEqualObjects(backgroundStageNames, expectedStageNames, @"Background stages");
+    }
+    GHAssertFalse(backgroundStagesOnMainThread, @"Background stages");
+    
+    // Durations are recorded on the main thread when a background stage ends, the last one might still be missing
+    NSDictionary *stageDurations = [HLSApplicationPreloader stageDurations];
+    GHAssertNotNil([stageDurations objectForKey:@"HLSApplicationPreloaderTestCase main thread low"], @"Duration");
+    GHAssertNotNil([stageDurations objectForKey:@"HLSApplicationPreloaderTestCase background high"], @"Duration");
+}
+
+@end
@@ -0,0 +1,51 @@
+//
+//  HLSBlobStoreTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSBlobStoreTestCase.h"
+
+@implementation HLSBlobStoreTestCase
+
+#pragma mark Tests
+
+- (void)testPutGetRelease
+{
+    NSString *rootPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSBlobStoreTestCase"];
+    [[NSFileManager defaultManager] removeItemAtPath:rootPath error:NULL];
+    
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    HLSBlobStore *blobStore = [[[HLSBlobStore alloc] initWithFileManager:fileManager rootPath:rootPath] autorelease];
+    GHAssertNotNil(blobStore, @"Store");
+    
+    NSData *data = [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding];
+    NSString *digest = [blobStore putData:data error:NULL];
+    GHAssertEqualStrings(digest, [data sha256hash], @"Digest");
+    GHAssertTrue([blobStore containsDigest:digest], @"Stored");
+    GHAssertEqualObjects([blobStore dataForDigest:digest error:NULL], data, @"Data");
+    GHAssertEquals([blobStore referenceCountForDigest:digest], (NSUInteger)1, @"Reference count");
+    
+    // Sharded location
+    NSString *expectedPath = [[[rootPath stringByAppendingPathComponent:@"df"] stringByAppendingPathComponent:@"fd"] stringByAppendingPathComponent:digest];
+    GHAssertTrue([fileManager fileExistsAtPath:expectedPath], @"Sharded path");
+    
+    // Duplicates are stored once
+    GHAssertEqualStrings([blobStore putData:[[data mutableCopy] autorelease] error:NULL], digest, @"Same digest");
+    GHAssertEquals([blobStore referenceCountForDigest:digest], (NSUInteger)2, @"Reference count after duplicate");
+    
+    GHAssertTrue([blobStore releaseDigest:digest error:NULL], @"Release 1");
+    GHAssertTrue([blobStore containsDigest:digest], @"Still referenced");
+    GHAssertTrue([blobStore releaseDigest:digest error:NULL], @"Release 2");
+    GHAssertFalse([blobStore containsDigest:digest], @"Removed");
+    GHAssertEquals([blobStore referenceCountForDigest:digest], (NSUInteger)0, @"Reference count after removal");
+    GHAssertFalse([blobStore releaseDigest:digest error:NULL], @"Over-release");
+    
+    GHAssertFalse([blobStore containsDigest:@"../../etc"], @"Invalid digest");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:rootPath error:NULL];
+}
+
+@end
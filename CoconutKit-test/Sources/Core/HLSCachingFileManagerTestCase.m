@@ -0,0 +1,144 @@
+//
+//  HLSCachingFileManagerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSCachingFileManagerTestCase.h"
+
+#import <libkern/OSAtomic.h>
+
+/**
+ * Standard file manager counting the number of times files are read, and which can be made slow
+ */
+@interface CountingFileManager : HLSStandardFileManager {
+@private
+    volatile int32_t m_nbrReads;
+    NSTimeInterval m_readDuration;
+}
+
+@property (nonatomic, readonly, assign) NSUInteger nbrReads;
+@property (nonatomic, assign) NSTimeInterval readDuration;
+
+@end
+
+@implementation CountingFileManager
+
+@synthesize readDuration = m_readDuration;
+
+- (NSUInteger)nbrReads
+{
+    return (NSUInteger)m_nbrReads;
+}
+
+- (NSData *)contentsOfFileAtPath:(NSString *)path error:(NSError **)pError
+{
+    OSAtomicIncrement32(&m_nbrReads);
+    if (self.readDuration > 0.) {
+        [NSThread sleepForTimeInterval:self.readDuration];
+    }
+    return [super contentsOfFileAtPath:path error:pError];
+}
+
+@end
+
+@implementation HLSCachingFileManagerTestCase
+
+#pragma mark Tests
+
+- (void)testCaching
+{
+    CountingFileManager *countingFileManager = [[[CountingFileManager alloc] init] autorelease];
+    HLSCachingFileManager *fileManager = [[[HLSCachingFileManager alloc] initWithFileManager:countingFileManager capacity:10] autorelease];
+    
+    NSString *path1 = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSCachingFileManagerTestCase-1.txt"];
+    NSString *path2 = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSCachingFileManagerTestCase-2.txt"];
+    NSString *path3 = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSCachingFileManagerTestCase-3.txt"];
+    NSData *data = [@"abcd" dataUsingEncoding:NSUTF8StringEncoding];
+    GHAssertTrue([countingFileManager createFileAtPath:path1 contents:data error:NULL], @"Create 1");
+    GHAssertTrue([countingFileManager createFileAtPath:path2 contents:data error:NULL], @"Create 2");
+    GHAssertTrue([countingFileManager createFileAtPath:path3 contents:data error:NULL], @"Create 3");
+    
+    // Repeated reads are served by the cache
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path1 error:NULL], data, @"Read 1");
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path1 error:NULL], data, @"Read 1 again");
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)1, @"Reads");
+    GHAssertEquals(fileManager.cachedByteCount, (NSUInteger)4, @"Cached bytes");
+    
+    // Fill the cache, then evict the least recently used file (2, since 1 is read again)
+    [fileManager contentsOfFileAtPath:path2 error:NULL];
+    [fileManager contentsOfFileAtPath:path1 error:NULL];
+    [fileManager contentsOfFileAtPath:path3 error:NULL];
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)3, @"Reads after eviction");
+    GHAssertEquals(fileManager.cachedByteCount, (NSUInteger)8, @"Cached bytes after eviction");
+    [fileManager contentsOfFileAtPath:path1 error:NULL];
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)3, @"File 1 still cached");
+    [fileManager contentsOfFileAtPath:path2 error:NULL];
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)4, @"File 2 evicted");
+    
+    // Write-through
+    NSData *newData = [@"xyz" dataUsingEncoding:NSUTF8StringEncoding];
+    GHAssertTrue([fileManager createFileAtPath:path1 contents:newData error:NULL], @"Overwrite 1");
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path1 error:NULL], newData, @"Read new contents");
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path1 range:NSMakeRange(1, 5) error:NULL],
+                         [@"yz" dataUsingEncoding:NSUTF8StringEncoding],
+                         @"Ranged read from the cache");
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)4, @"Written contents cached");
+    
+    // Invalidation
+    GHAssertTrue([fileManager removeItemAtPath:path1 error:NULL], @"Remove 1");
+    GHAssertNil([fileManager contentsOfFileAtPath:path1 error:NULL], @"Removed file");
+    GHAssertTrue([fileManager moveItemAtPath:path2 toPath:path1 error:NULL], @"Move 2 to 1");
+    GHAssertNil([fileManager contentsOfFileAtPath:path2 error:NULL], @"Moved file");
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path1 error:NULL], data, @"Move destination");
+    
+    [fileManager removeAllCachedFiles];
+    GHAssertEquals(fileManager.cachedByteCount, (NSUInteger)0, @"Cache emptied");
+    
+    [countingFileManager removeItemAtPath:path1 error:NULL];
+    [countingFileManager removeItemAtPath:path3 error:NULL];
+}
+
+- (void)testConcurrentReadMisses
+{
+    CountingFileManager *countingFileManager = [[[CountingFileManager alloc] init] autorelease];
+    countingFileManager.readDuration = 0.2;
+    HLSCachingFileManager *fileManager = [[[HLSCachingFileManager alloc] initWithFileManager:countingFileManager capacity:1024] autorelease];
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSCachingFileManagerTestCase-concurrent.txt"];
+    NSData *data = [@"abcd" dataUsingEncoding:NSUTF8StringEncoding];
+    GHAssertTrue([countingFileManager createFileAtPath:path contents:data error:NULL], @"Create");
+    
+    // Only the first miss reads the file, the other ones wait for it to be cached
+    __block volatile int32_t nbrMatches = 0;
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        if ([[fileManager contentsOfFileAtPath:path error:NULL] isEqualToData:data]) {
+            OSAtomicIncrement32(&nbrMatches);
+        }
+    });
+    GHAssertEquals(nbrMatches, (int32_t)8, @"Contents");
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)1, @"Single read");
+    
+    [countingFileManager removeItemAtPath:path error:NULL];
+}
+
+- (void)testMaximumCachedFileSize
+{
+    CountingFileManager *countingFileManager = [[[CountingFileManager alloc] init] autorelease];
+    HLSCachingFileManager *fileManager = [[[HLSCachingFileManager alloc] initWithFileManager:countingFileManager capacity:1024] autorelease];
+    fileManager.maximumCachedFileSize = 2;
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSCachingFileManagerTestCase-large.txt"];
+    GHAssertTrue([countingFileManager createFileAtPath:path contents:[@"abcd" dataUsingEncoding:NSUTF8StringEncoding] error:NULL], @"Create");
+    
+    [fileManager contentsOfFileAtPath:path error:NULL];
+    [fileManager contentsOfFileAtPath:path error:NULL];
+    GHAssertEquals(countingFileManager.nbrReads, (NSUInteger)2, @"Reads");
+    GHAssertEquals(fileManager.cachedByteCount, (NSUInteger)0, @"Not cached");
+    
+    [countingFileManager removeItemAtPath:path error:NULL];
+}
+
+@end
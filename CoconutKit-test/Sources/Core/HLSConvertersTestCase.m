@@ -0,0 +1,180 @@
+//
+//  HLSConvertersTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSConvertersTestCase.h"
+
+#import "TestBenchmarks.h"
+
+static const NSUInteger kBenchmarkParseCount = 10000;
+static const NSUInteger kBenchmarkRunCount = 10;
+
+@interface HLSConvertersTestPerson : NSObject {
+@private
+    NSString *m_name;
+    NSNumber *m_identifier;
+    NSUInteger m_age;
+}
+
+@property (nonatomic, retain) NSString *name;
+@property (nonatomic, retain) NSNumber *identifier;
+@property (nonatomic, assign) NSUInteger age;
+
+@end
+
+@implementation HLSConvertersTestPerson
+
+- (void)dealloc
+{
+    self.name = nil;
+    self.identifier = nil;
+    
+    [super dealloc];
+}
+
+@synthesize name = m_name;
+
+@synthesize identifier = m_identifier;
+
+@synthesize age = m_age;
+
+@end
+
+@implementation HLSConvertersTestCase
+
+#pragma mark Tests
+
+- (void)testNumberConversions
+{
+    GHAssertEqualObjects(HLSUnsignedIntNumberFromString(@"0"), [NSNumber numberWithInt:0], @"Unsigned");
+    GHAssertEqualObjects(HLSUnsignedIntNumberFromString(@"4294967295"), [NSNumber numberWithUnsignedInt:4294967295U], @"Unsigned");
+    GHAssertEqualObjects(HLSUnsignedIntNumberFromString(@"18446744073709551615"), [NSNumber numberWithUnsignedLongLong:ULLONG_MAX], @"Unsigned");
+    GHAssertNil(HLSUnsignedIntNumberFromString(@"18446744073709551616"), @"Unsigned overflow");
+    GHAssertNil(HLSUnsignedIntNumberFromString(@"99999999999999999999999"), @"Unsigned overflow");
+    GHAssertNil(HLSUnsignedIntNumberFromString(@""), @"Unsigned");
+    GHAssertNil(HLSUnsignedIntNumberFromString(@"abc"), @"Unsigned");
+    GHAssertNil(HLSUnsignedIntNumberFromString(nil), @"Unsigned");
+    
+    GHAssertEqualObjects(HLSIntegerNumberFromString(@"-42"), [NSNumber numberWithInt:-42], @"Integer");
+    GHAssertEqualObjects(HLSIntegerNumberFromString(@"+42"), [NSNumber numberWithInt:42], @"Integer");
+    GHAssertEqualObjects(HLSIntegerNumberFromString(@"9223372036854775807"), [NSNumber numberWithLongLong:LLONG_MAX], @"Integer");
+    GHAssertEqualObjects(HLSIntegerNumberFromString(@"-9223372036854775808"), [NSNumber numberWithLongLong:LLONG_MIN], @"Integer");
+    GHAssertNil(HLSIntegerNumberFromString(@"9223372036854775808"), @"Integer overflow");
+    GHAssertNil(HLSIntegerNumberFromString(@"-9223372036854775809"), @"Integer overflow");
+    GHAssertNil(HLSIntegerNumberFromString(@"99999999999999999999999"), @"Integer overflow");
+    GHAssertNil(HLSIntegerNumberFromString(@"-"), @"Integer");
+    GHAssertNil(HLSIntegerNumberFromString(@" 1"), @"Integer");
+    GHAssertNil(HLSIntegerNumberFromString(@"1.5"), @"Integer");
+    
+    GHAssertEqualObjects(HLSDoubleNumberFromString(@"1.5"), [NSNumber numberWithDouble:1.5], @"Double");
+    GHAssertEqualObjects(HLSDoubleNumberFromString(@"-1.5e3"), [NSNumber numberWithDouble:-1500.], @"Double");
+    GHAssertEqualObjects(HLSDoubleNumberFromString(@".5"), [NSNumber numberWithDouble:0.5], @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@"1,5"), @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@"inf"), @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@"0x10"), @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@"1e"), @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@"."), @"Double");
+    GHAssertNil(HLSDoubleNumberFromString(@""), @"Double");
+    
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"YES"), [NSNumber numberWithBool:YES], @"Bool");
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"True"), [NSNumber numberWithBool:YES], @"Bool");
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"1"), [NSNumber numberWithBool:YES], @"Bool");
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"no"), [NSNumber numberWithBool:NO], @"Bool");
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"false"), [NSNumber numberWithBool:NO], @"Bool");
+    GHAssertEqualObjects(HLSBoolNumberFromString(@"0"), [NSNumber numberWithBool:NO], @"Bool");
+    GHAssertNil(HLSBoolNumberFromString(@"maybe"), @"Bool");
+}
+
+- (void)testNumberConversionBenchmark
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:1000];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [strings addObject:[NSString stringWithFormat:@"%u", arc4random()]];
+    }
+    
+    NSNumberFormatter *formatter = [[[NSNumberFormatter alloc] init] autorelease];
+    [formatter setNumberStyle:NSNumberFormatterDecimalStyle];
+    
+    // Reference: Number formatter, as previously used by HLSUnsignedIntNumberFromString
+    void (^formatterBlock)(void) = ^{
+        for (NSUInteger i = 0; i < kBenchmarkParseCount; ++i) {
+            [formatter numberFromString:[strings objectAtIndex:i % 1000]];
+        }
+    };
+    TestBenchmarkReportTimes(@"converters.number.formatter", kBenchmarkParseCount, TestBenchmarkMeasure(kBenchmarkRunCount, formatterBlock));
+    
+    void (^unsignedBlock)(void) = ^{
+        for (NSUInteger i = 0; i < kBenchmarkParseCount; ++i) {
+            HLSUnsignedIntNumberFromString([strings objectAtIndex:i % 1000]);
+        }
+    };
+    TestBenchmarkReportTimes(@"converters.number.unsigned", kBenchmarkParseCount, TestBenchmarkMeasure(kBenchmarkRunCount, unsignedBlock));
+    
+    void (^integerBlock)(void) = ^{
+        for (NSUInteger i = 0; i < kBenchmarkParseCount; ++i) {
+            HLSIntegerNumberFromString([strings objectAtIndex:i % 1000]);
+        }
+    };
+    TestBenchmarkReportTimes(@"converters.number.integer", kBenchmarkParseCount, TestBenchmarkMeasure(kBenchmarkRunCount, integerBlock));
+    
+    void (^doubleBlock)(void) = ^{
+        for (NSUInteger i = 0; i < kBenchmarkParseCount; ++i) {
+            HLSDoubleNumberFromString([strings objectAtIndex:i % 1000]);
+        }
+    };
+    TestBenchmarkReportTimes(@"converters.number.double", kBenchmarkParseCount, TestBenchmarkMeasure(kBenchmarkRunCount, doubleBlock));
+}
+
+- (void)testBatchConversion
+{
+    NSArray *sourceDictionaries = [NSArray arrayWithObjects:[NSDictionary dictionaryWithObjectsAndKeys:@"Alice", @"name",
+                                                             @"12", @"identifier",
+                                                             @"34", @"age", nil],
+                                   [NSDictionary dictionaryWithObjectsAndKeys:@"Bob", @"name",
+                                    @"not a number", @"identifier", nil],
+                                   [NSDictionary dictionaryWithObjectsAndKeys:@"Carol", @"name", 
+                                    @"56", @"identifier", nil], nil];
+    
+    HLSConvertersTestPerson *person1 = [[[HLSConvertersTestPerson alloc] init] autorelease];
+    HLSConvertersTestPerson *person2 = [[[HLSConvertersTestPerson alloc] init] autorelease];
+    person2.identifier = [NSNumber numberWithInt:78];
+    NSMutableDictionary *dictionary3 = [NSMutableDictionary dictionary];
+    NSArray *destObjects = [NSArray arrayWithObjects:person1, person2, dictionary3, nil];
+    
+    NSDictionary *keyToConverterBlockMap = [NSDictionary dictionaryWithObjectsAndKeys:[HLSConverters stringConverterBlock], @"name",
+                                            [HLSConverters unsignedIntConverterBlock], @"identifier",
+                                            [HLSConverters unsignedIntConverterBlock], @"age", nil];
+    [HLSConverters convertStringValuesOfDictionaries:sourceDictionaries 
+                                         intoObjects:destObjects
+                         usingKeyToConverterBlockMap:keyToConverterBlockMap];
+    
+    GHAssertEqualStrings(person1.name, @"Alice", @"Object setter");
+    GHAssertEqualObjects(person1.identifier, [NSNumber numberWithInt:12], @"Object setter");
+    GHAssertEquals(person1.age, (NSUInteger)34, @"Scalar setter");
+    
+    GHAssertEqualStrings(person2.name, @"Bob", @"Object setter");
+    GHAssertEqualObjects(person2.identifier, [NSNumber numberWithInt:78], @"Invalid value");
+    GHAssertEquals(person2.age, (NSUInteger)0, @"Missing value");
+    
+    GHAssertEqualStrings([dictionary3 objectForKey:@"name"], @"Carol", @"Dictionary");
+    GHAssertEqualObjects([dictionary3 objectForKey:@"identifier"], [NSNumber numberWithInt:56], @"Dictionary");
+    GHAssertNil([dictionary3 objectForKey:@"age"], @"Dictionary");
+}
+
+- (void)testDateConverterBlock
+{
+    HLSStringConverterBlock dateConverterBlock = [HLSConverters dateConverterBlockWithFormatString:@"yyyy-MM-dd"];
+    NSDate *expectedDate = [HLSConverters dateFromString:@"2012-01-01" usingFormatString:@"yyyy-MM-dd"];
+    GHAssertEqualObjects(dateConverterBlock(@"2012-01-01"), expectedDate, @"Date");
+    GHAssertNil(dateConverterBlock(@"invalid"), @"Invalid date");
+}
+
+@end
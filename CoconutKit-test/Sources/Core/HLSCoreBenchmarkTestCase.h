@@ -0,0 +1,18 @@
+//
+//  HLSCoreBenchmarkTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Microbenchmarks for the Core extensions (digests, calendar helpers, dictionary copy helpers, array rotation and
+ * sorting, validators and converters). The median and 99th percentile running times are printed on the standard
+ * output as a single JSON object line prefixed with "HLSBenchmark: ", together with their ratio to the reference
+ * medians stored in BenchmarkBaseline.plist (see TestBenchmarks.h). Figures are only meaningful when compared on the
+ * same device, with a release build
+ */
+@interface HLSCoreBenchmarkTestCase : GHTestCase
+
+@end
@@ -0,0 +1,225 @@
+//
+//  HLSCoreBenchmarkTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSCoreBenchmarkTestCase.h"
+
+#import "TestBenchmarks.h"
+
+#define kBenchmarkDigestSizeCount           5
+#define kBenchmarkCollectionSizeCount       4
+
+static const NSUInteger kBenchmarkDigestChunkLength = 1024 * 1024;
+static const NSUInteger kBenchmarkDigestSizes[kBenchmarkDigestSizeCount] = { 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 100 * 1024 * 1024 };
+static const NSUInteger kBenchmarkDigestRunCounts[kBenchmarkDigestSizeCount] = { 200, 100, 20, 5, 3 };
+static const NSUInteger kBenchmarkCollectionSizes[kBenchmarkCollectionSizeCount] = { 10, 100, 1000, 10000 };
+static const NSUInteger kBenchmarkDayCount = 365;
+static const NSUInteger kBenchmarkRunCount = 20;
+
+@implementation HLSCoreBenchmarkTestCase
+
+#pragma mark Benchmarks
+
+- (void)testDigests
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    // Large inputs are fed incrementally, as a file would be
+    NSMutableData *chunk = [NSMutableData dataWithLength:kBenchmarkDigestChunkLength];
+    unsigned char *bytes = [chunk mutableBytes];
+    for (NSUInteger i = 0; i < kBenchmarkDigestChunkLength; ++i) {
+        bytes[i] = (unsigned char)(i % 251);
+    }
+    
+    for (NSUInteger i = 0; i < kBenchmarkDigestSizeCount; ++i) {
+        NSUInteger size = kBenchmarkDigestSizes[i];
+        for (NSUInteger j = 0; j < 2; ++j) {
+            HLSDigestAlgorithm algorithm = (j == 0) ? HLSDigestAlgorithmMD5 : HLSDigestAlgorithmSHA256;
+            TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkDigestRunCounts[i], ^{
+                HLSDigest *digest = [[[HLSDigest alloc] initWithAlgorithm:algorithm] autorelease];
+                NSUInteger remainingLength = size;
+                while (remainingLength != 0) {
+                    NSUInteger length = MIN(remainingLength, kBenchmarkDigestChunkLength);
+                    [digest updateWithBytes:bytes length:length];
+                    remainingLength -= length;
+                }
+                [digest hexDigest];
+            });
+            TestBenchmarkReportTimes((j == 0) ? @"digest.md5" : @"digest.sha256", size, times);
+        }
+    }
+}
+
+- (void)testCalendarHelpers
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSTimeZone *timeZoneZurich = [NSTimeZone timeZoneWithName:@"Europe/Zurich"];
+    NSTimeZone *timeZoneTahiti = [NSTimeZone timeZoneWithName:@"Pacific/Tahiti"];
+    
+    // One date per day over a year, at a time of the day which is not the same day in both time zones
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceReferenceDate:(13. * 365. + 3.) * 24. * 60. * 60. + 7. * 60. * 60.];
+    NSMutableArray *dates = [NSMutableArray arrayWithCapacity:kBenchmarkDayCount];
+    for (NSUInteger i = 0; i < kBenchmarkDayCount; ++i) {
+        [dates addObject:[startDate dateByAddingTimeInterval:i * 24. * 60. * 60.]];
+    }
+    
+    TestBenchmarkTimes startOfMonthTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        for (NSDate *date in dates) {
+            [NSCalendar startDateOfUnit:NSMonthCalendarUnit containingDate:date inTimeZone:timeZoneZurich];
+        }
+    });
+    TestBenchmarkReportTimes(@"calendar.startDateOfUnit", kBenchmarkDayCount, startOfMonthTimes);
+    
+    TestBenchmarkTimes numberOfDaysTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        for (NSDate *date in dates) {
+            [NSCalendar numberOfDaysInUnit:NSMonthCalendarUnit containingDate:date inTimeZone:timeZoneZurich];
+        }
+    });
+    TestBenchmarkReportTimes(@"calendar.numberOfDaysInUnit", kBenchmarkDayCount, numberOfDaysTimes);
+    
+    TestBenchmarkTimes midnightTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        for (NSDate *date in dates) {
+            [NSCalendar dateAtMidnightTheSameDayAsDate:date inTimeZone:timeZoneTahiti];
+        }
+    });
+    TestBenchmarkReportTimes(@"calendar.dateAtMidnight", kBenchmarkDayCount, midnightTimes);
+    
+    TestBenchmarkTimes sameDayTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        NSDate *previousDate = [dates objectAtIndex:0];
+        for (NSDate *date in dates) {
+            [NSCalendar isDate:previousDate theSameDayAsDate:date inTimeZone:timeZoneTahiti];
+            previousDate = date;
+        }
+    });
+    TestBenchmarkReportTimes(@"calendar.isDateTheSameDay", kBenchmarkDayCount, sameDayTimes);
+}
+
+- (void)testDictionaryCopyHelpers
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    for (NSUInteger i = 0; i < kBenchmarkCollectionSizeCount; ++i) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        
+        NSUInteger size = kBenchmarkCollectionSizes[i];
+        NSMutableDictionary *mutableDictionary = [NSMutableDictionary dictionaryWithCapacity:size];
+        for (NSUInteger j = 0; j < size; ++j) {
+            [mutableDictionary setObject:[NSNumber numberWithUnsignedInteger:j] forKey:[NSString stringWithFormat:@"key%u", j]];
+        }
+        
+        // 100 successive updates, each one made on the result of the previous one
+        for (NSUInteger k = 0; k < 2; ++k) {
+            NSDictionary *dictionary = (k == 0) ? [NSDictionary dictionaryWithDictionary:mutableDictionary]
+                : [HLSPersistentDictionary dictionaryWithDictionary:mutableDictionary];
+            TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+                NSDictionary *updatedDictionary = dictionary;
+                for (NSUInteger l = 0; l < 100; ++l) {
+                    NSString *key = [NSString stringWithFormat:@"key%u", (l * 7) % size];
+                    updatedDictionary = [updatedDictionary dictionaryBySettingObject:@"value" forKey:key];
+                    updatedDictionary = [updatedDictionary dictionaryByRemovingObjectForKey:key];
+                }
+            });
+            TestBenchmarkReportTimes((k == 0) ? @"dictionary.copy" : @"dictionary.persistent", size, times);
+        }
+        
+        [pool drain];
+    }
+}
+
+- (void)testArrayRotationAndSorting
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    for (NSUInteger i = 0; i < kBenchmarkCollectionSizeCount; ++i) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        
+        NSUInteger size = kBenchmarkCollectionSizes[i];
+        NSMutableArray *array = [NSMutableArray arrayWithCapacity:size];
+        for (NSUInteger j = 0; j < size; ++j) {
+            // Deterministic shuffle
+            [array addObject:[NSNumber numberWithUnsignedInteger:(j * 7919) % size]];
+        }
+        
+        TestBenchmarkTimes rotationTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+            [array arrayByLeftRotatingNumberOfObjects:size / 3];
+            [array arrayByRightRotatingNumberOfObjects:size / 3];
+        });
+        TestBenchmarkReportTimes(@"array.rotation", size, rotationTimes);
+        
+        NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"self" ascending:YES];
+        TestBenchmarkTimes sortingTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+            [array sortedArrayUsingDescriptor:sortDescriptor];
+        });
+        TestBenchmarkReportTimes(@"array.sorting", size, sortingTimes);
+        
+        [pool drain];
+    }
+}
+
+- (void)testValidatorsAndConverters
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSArray *emailAddresses = [NSArray arrayWithObjects:@"name.lastname@domain.com", @".@", @"a@b", @"@bar.com", @"@@bar.com", nil];
+    TestBenchmarkTimes emailTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            [HLSValidators validateEmailAddress:[emailAddresses objectAtIndex:i % [emailAddresses count]]];
+        }
+    });
+    TestBenchmarkReportTimes(@"validators.email", 1000, emailTimes);
+    
+    TestBenchmarkTimes numberTimes = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            HLSUnsignedIntNumberFromString([NSString stringWithFormat:@"%u", i]);
+            HLSDoubleNumberFromString([NSString stringWithFormat:@"%u.5", i]);
+        }
+    });
+    TestBenchmarkReportTimes(@"converters.numbers", 1000, numberTimes);
+    
+    // Batch hydration of dictionaries, as made when parsing web service responses
+    for (NSUInteger i = 0; i < kBenchmarkCollectionSizeCount; ++i) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        
+        NSUInteger size = kBenchmarkCollectionSizes[i];
+        NSMutableArray *sourceDictionaries = [NSMutableArray arrayWithCapacity:size];
+        for (NSUInteger j = 0; j < size; ++j) {
+            NSDictionary *sourceDictionary = [NSDictionary dictionaryWithObjectsAndKeys:[NSString stringWithFormat:@"Name %u", j], @"name",
+                                              [NSString stringWithFormat:@"%u", j], @"identifier",
+                                              @"2012-03-01", @"date", nil];
+            [sourceDictionaries addObject:sourceDictionary];
+        }
+        
+        NSDictionary *keyToConverterBlockMap = [NSDictionary dictionaryWithObjectsAndKeys:[HLSConverters stringConverterBlock], @"name",
+                                                [HLSConverters unsignedIntConverterBlock], @"identifier",
+                                                [HLSConverters dateConverterBlockWithFormatString:@"yyyy-MM-dd"], @"date", nil];
+        TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+            NSMutableArray *destDictionaries = [NSMutableArray arrayWithCapacity:size];
+            for (NSUInteger j = 0; j < size; ++j) {
+                [destDictionaries addObject:[NSMutableDictionary dictionary]];
+            }
+            [HLSConverters convertStringValuesOfDictionaries:sourceDictionaries
+                                                 intoObjects:destDictionaries
+                                 usingKeyToConverterBlockMap:keyToConverterBlockMap];
+        });
+        TestBenchmarkReportTimes(@"converters.batch", size, times);
+        
+        [pool drain];
+    }
+}
+
+@end
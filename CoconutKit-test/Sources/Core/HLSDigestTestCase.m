@@ -0,0 +1,58 @@
+//
+//  HLSDigestTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSDigestTestCase.h"
+
+@implementation HLSDigestTestCase
+
+#pragma mark Tests
+
+- (void)testIncrementalDigest
+{
+    NSData *testData = [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    HLSDigest *digest = [[[HLSDigest alloc] initWithAlgorithm:HLSDigestAlgorithmSHA256] autorelease];
+    [digest updateWithBytes:[testData bytes] length:5];
+    [digest updateWithBytes:(const uint8_t *)[testData bytes] + 5 length:[testData length] - 5];
+    GHAssertEqualStrings([digest hexDigest], [testData sha256hash], @"sha256");
+    GHAssertEquals([[digest digest] length], (NSUInteger)32, @"Raw digest length");
+    
+    // Finalized digests cannot be updated anymore
+    [digest updateWithData:testData];
+    GHAssertEqualStrings([digest hexDigest], [testData sha256hash], @"sha256 after finalization");
+    
+    HLSDigest *emptyDigest = [[[HLSDigest alloc] initWithAlgorithm:HLSDigestAlgorithmMD5] autorelease];
+    GHAssertEqualStrings([emptyDigest hexDigest], @"d41d8cd98f00b204e9800998ecf8427e", @"Empty md5");
+}
+
+- (void)testFileDigest
+{
+    // Larger than the chunk size, and not a multiple of it
+    NSMutableData *data = [NSMutableData dataWithLength:200 * 1024 + 17];
+    uint8_t *bytes = [data mutableBytes];
+    for (NSUInteger i = 0; i < [data length]; ++i) {
+        bytes[i] = (uint8_t)(i * 31);
+    }
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSDigestTestCase.dat"];
+    GHAssertTrue([data writeToFile:path atomically:YES], @"Write");
+    
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSError *error = nil;
+    GHAssertEqualStrings([fileManager md5HashOfFileAtPath:path error:&error], [data md5hash], @"md5");
+    GHAssertEqualStrings([fileManager sha1HashOfFileAtPath:path error:&error], [data sha1hash], @"sha1");
+    GHAssertEqualStrings([fileManager sha256HashOfFileAtPath:path error:&error], [data sha256hash], @"sha256");
+    GHAssertNil(error, @"Error");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    
+    GHAssertNil([fileManager sha256HashOfFileAtPath:path error:&error], @"Missing file");
+    GHAssertNotNil(error, @"Missing file error");
+}
+
+@end
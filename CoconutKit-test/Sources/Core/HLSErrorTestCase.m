@@ -99,6 +99,25 @@
     GHAssertEquals([[self.error2 customUserInfo] count], 3U, @"Incorrect custom user information");
 }
 
+- (void)testUserInfo
+{
+    NSDictionary *userInfo2 = [self.error2 userInfo];
+    GHAssertEquals([userInfo2 count], 9U, @"Incorrect user information");
+    GHAssertEqualStrings([userInfo2 objectForKey:NSLocalizedDescriptionKey], @"Localized description", @"Incorrect description");
+    GHAssertEquals([userInfo2 objectForKey:NSUnderlyingErrorKey], self.error1, @"Incorrect underlying error");
+    GHAssertEqualStrings([userInfo2 objectForKey:@"AdditionalInfo1"], @"Additional information 1", @"Incorrect additional information");
+    
+    // The user information must reflect later changes
+    HLSError *error = [HLSError errorWithDomain:@"ch.hortis.CoconutKit-test" code:1014];
+    GHAssertEquals([[error userInfo] count], 0U, @"Incorrect user information");
+    [error setLocalizedFailureReason:@"Localized failure reason"];
+    [error setObject:@"Additional information" forKey:@"AdditionalInfo"];
+    GHAssertEquals([[error userInfo] count], 2U, @"Incorrect user information");
+    [error setObject:nil forKey:NSLocalizedFailureReasonErrorKey];
+    GHAssertNil([[error userInfo] objectForKey:NSLocalizedFailureReasonErrorKey], @"Incorrect failure reason");
+    GHAssertEquals([[error customUserInfo] count], 1U, @"Incorrect custom user information");
+}
+
 - (void)testCopy
 {
     NSError *error2Copy = [self.error2 copy];
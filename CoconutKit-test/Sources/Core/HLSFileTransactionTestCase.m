@@ -0,0 +1,76 @@
+//
+//  HLSFileTransactionTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileTransactionTestCase.h"
+
+@implementation HLSFileTransactionTestCase
+
+#pragma mark Tests
+
+- (void)testCommit
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSFileTransactionTestCase-commit"];
+    [fileManager removeItemAtPath:directoryPath error:NULL];
+    GHAssertTrue([fileManager createDirectoryAtPath:directoryPath withIntermediateDirectories:YES error:NULL], @"Directory");
+    
+    NSString *manifestPath = [directoryPath stringByAppendingPathComponent:@"manifest.txt"];
+    NSString *assetPath = [directoryPath stringByAppendingPathComponent:@"asset.txt"];
+    NSString *obsoletePath = [directoryPath stringByAppendingPathComponent:@"obsolete.txt"];
+    GHAssertTrue([fileManager createFileAtPath:manifestPath contents:[@"v1" dataUsingEncoding:NSUTF8StringEncoding] error:NULL], @"Manifest");
+    GHAssertTrue([fileManager createFileAtPath:obsoletePath contents:[@"obsolete" dataUsingEncoding:NSUTF8StringEncoding] error:NULL], @"Obsolete");
+    
+    HLSFileTransaction *transaction = [[[HLSFileTransaction alloc] initWithFileManager:fileManager] autorelease];
+    GHAssertTrue([transaction writeData:[@"v2" dataUsingEncoding:NSUTF8StringEncoding] toPath:manifestPath error:NULL], @"Manifest write");
+    GHAssertTrue([transaction writeData:[@"asset" dataUsingEncoding:NSUTF8StringEncoding] toPath:assetPath error:NULL], @"Asset write");
+    [transaction removeItemAtPath:obsoletePath];
+    
+    // Nothing visible before the commit
+    GHAssertEqualStrings([NSString stringWithContentsOfFile:manifestPath encoding:NSUTF8StringEncoding error:NULL], @"v1", @"Manifest before");
+    GHAssertFalse([fileManager fileExistsAtPath:assetPath], @"Asset before");
+    GHAssertTrue([fileManager fileExistsAtPath:obsoletePath], @"Obsolete before");
+    
+    GHAssertTrue([transaction commit:NULL], @"Commit");
+    GHAssertEqualStrings([NSString stringWithContentsOfFile:manifestPath encoding:NSUTF8StringEncoding error:NULL], @"v2", @"Manifest after");
+    GHAssertEqualStrings([NSString stringWithContentsOfFile:assetPath encoding:NSUTF8StringEncoding error:NULL], @"asset", @"Asset after");
+    GHAssertFalse([fileManager fileExistsAtPath:obsoletePath], @"Obsolete after");
+    
+    // No staged file left behind
+    GHAssertEquals([[fileManager contentsOfDirectoryAtPath:directoryPath error:NULL] count], (NSUInteger)2, @"Directory contents");
+    
+    GHAssertFalse([transaction commit:NULL], @"Second commit");
+    
+    [fileManager removeItemAtPath:directoryPath error:NULL];
+}
+
+- (void)testRollback
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSFileTransactionTestCase-rollback"];
+    [fileManager removeItemAtPath:directoryPath error:NULL];
+    GHAssertTrue([fileManager createDirectoryAtPath:directoryPath withIntermediateDirectories:YES error:NULL], @"Directory");
+    
+    NSString *path = [directoryPath stringByAppendingPathComponent:@"file.txt"];
+    
+    HLSFileTransaction *transaction = [[[HLSFileTransaction alloc] initWithFileManager:fileManager] autorelease];
+    GHAssertTrue([transaction writeData:[@"data" dataUsingEncoding:NSUTF8StringEncoding] toPath:path error:NULL], @"Write");
+    [transaction rollback];
+    GHAssertFalse([fileManager fileExistsAtPath:path], @"File");
+    GHAssertEquals([[fileManager contentsOfDirectoryAtPath:directoryPath error:NULL] count], (NSUInteger)0, @"Directory contents");
+    GHAssertFalse([transaction commit:NULL], @"Commit after rollback");
+    
+    // Implicit rollback when a transaction is discarded
+    HLSFileTransaction *discardedTransaction = [[HLSFileTransaction alloc] initWithFileManager:fileManager];
+    GHAssertTrue([discardedTransaction writeData:[@"data" dataUsingEncoding:NSUTF8StringEncoding] toPath:path error:NULL], @"Write");
+    [discardedTransaction release];
+    GHAssertEquals([[fileManager contentsOfDirectoryAtPath:directoryPath error:NULL] count], (NSUInteger)0, @"Directory contents");
+    
+    [fileManager removeItemAtPath:directoryPath error:NULL];
+}
+
+@end
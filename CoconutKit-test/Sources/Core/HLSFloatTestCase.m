@@ -63,4 +63,96 @@
     GHAssertEquals(doublemax(1., 2.), 2., @"doublemax");
 }
 
+- (void)testBatchComparisons
+{
+    // Pairs of values which are equal, a few ULPs apart, or far apart, with various signs (the count is not a multiple 
+    // of the vector sizes, so that remaining values are tested as well)
+    static const size_t kCount = 1003;
+    float *floatsX = malloc(kCount * sizeof(float));
+    float *floatsY = malloc(kCount * sizeof(float));
+    double *doublesX = malloc(kCount * sizeof(double));
+    double *doublesY = malloc(kCount * sizeof(double));
+    srandom(42);
+    for (size_t i = 0; i < kCount; ++i) {
+        float floatX = (float)(random() % 2000 - 1000) / (float)(random() % 100 + 1);
+        float floatY = floatX;
+        double doubleX = (double)(random() % 2000 - 1000) / (double)(random() % 100 + 1);
+        double doubleY = doubleX;
+        
+        // Move y by 0 to 9 ULPs
+        NSUInteger numberOfSteps = random() % 10;
+        for (NSUInteger j = 0; j < numberOfSteps; ++j) {
+            floatY = nextafterf(floatY, (i % 2 == 0) ? INFINITY : -INFINITY);
+            doubleY = nextafter(doubleY, (i % 2 == 0) ? INFINITY : -INFINITY);
+        }
+        
+        // Some far apart values and signed zeroes
+        if (i % 7 == 0) {
+            floatY = -floatY;
+            doubleY = -doubleY;
+        }
+        else if (i % 11 == 0) {
+            floatX = 0.f;
+            floatY = -0.f;
+            doubleX = 0.;
+            doubleY = -0.;
+        }
+        
+        floatsX[i] = floatX;
+        floatsY[i] = floatY;
+        doublesX[i] = doubleX;
+        doublesY[i] = doubleY;
+    }
+    
+    BOOL *results = malloc(kCount * sizeof(BOOL));
+    float *floatResults = malloc(kCount * sizeof(float));
+    double *doubleResults = malloc(kCount * sizeof(double));
+    
+    floateq_dist_batch(floatsX, floatsY, results, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(results[i], floateq_dist(floatsX[i], floatsY[i], HLSFloatDefaultMaxDist), @"floateq_dist_batch");
+    }
+    
+    doubleeq_dist_batch(doublesX, doublesY, results, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(results[i], doubleeq_dist(doublesX[i], doublesY[i], HLSFloatDefaultMaxDist), @"doubleeq_dist_batch");
+    }
+    
+    floatmin_dist_batch(floatsX, floatsY, floatResults, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(floatResults[i], floatmin_dist(floatsX[i], floatsY[i], HLSFloatDefaultMaxDist), @"floatmin_dist_batch");
+    }
+    
+    floatmax_dist_batch(floatsX, floatsY, floatResults, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(floatResults[i], floatmax_dist(floatsX[i], floatsY[i], HLSFloatDefaultMaxDist), @"floatmax_dist_batch");
+    }
+    
+    doublemin_dist_batch(doublesX, doublesY, doubleResults, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(doubleResults[i], doublemin_dist(doublesX[i], doublesY[i], HLSFloatDefaultMaxDist), @"doublemin_dist_batch");
+    }
+    
+    doublemax_dist_batch(doublesX, doublesY, doubleResults, kCount, HLSFloatDefaultMaxDist);
+    for (size_t i = 0; i < kCount; ++i) {
+        GHAssertEquals(doubleResults[i], doublemax_dist(doublesX[i], doublesY[i], HLSFloatDefaultMaxDist), @"doublemax_dist_batch");
+    }
+    
+    free(floatsX);
+    free(floatsY);
+    free(doublesX);
+    free(doublesY);
+    free(results);
+    free(floatResults);
+    free(doubleResults);
+}
+
+- (void)testDoubleComparisonsSymmetry
+{
+    double x = 1.;
+    double y = nextafter(x, INFINITY);
+    GHAssertTrue(doubleeq(x, y), @"doubleeq");
+    GHAssertTrue(doubleeq(y, x), @"doubleeq");
+}
+
 @end
@@ -0,0 +1,15 @@
+//
+//  HLSLocalizationBenchmarkTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Benchmarks for dynamic localization. Results are printed in the same format as HLSTaskBenchmarkTestCase results
+ * (see HLSTaskBenchmarkTestCase.h). Memory figures are resident size variations and therefore only approximate
+ */
+@interface HLSLocalizationBenchmarkTestCase : GHTestCase
+
+@end
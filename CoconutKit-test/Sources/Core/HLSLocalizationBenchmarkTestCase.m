@@ -0,0 +1,176 @@
+//
+//  HLSLocalizationBenchmarkTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSLocalizationBenchmarkTestCase.h"
+
+#import <mach/mach.h>
+#import "TestBenchmarks.h"
+#import "TestLocalizedBundles.h"
+
+static const NSUInteger kBenchmarkTableSize = 5000;
+static const NSUInteger kBenchmarkColdRunCount = 20;
+static const NSUInteger kBenchmarkWarmLookupCount = 10000;
+static const NSUInteger kBenchmarkWarmRunCount = 10;
+static const NSUInteger kBenchmarkLabelCounts[] = { 100, 1000 };
+static const NSUInteger kBenchmarkSwitchRunCount = 10;
+static const NSUInteger kBenchmarkMemoryTableSize = 20000;
+
+static NSDictionary *HLSBenchmarkStrings(NSUInteger count);
+static NSUInteger HLSBenchmarkResidentSize(void);
+static void HLSBenchmarkPurgeCaches(void);
+
+@implementation HLSLocalizationBenchmarkTestCase
+
+#pragma mark Test setup and tear down
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Labels are involved
+    return YES;
+}
+
+- (void)setUpClass
+{
+    [super setUpClass];
+    
+    // Dynamic localization is only enabled once a localization has been set
+    [NSBundle setLocalization:[NSBundle localization]];
+}
+
+#pragma mark Benchmarks
+
+- (void)testLookupThroughput
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSDictionary *strings = HLSBenchmarkStrings(kBenchmarkTableSize);
+    NSArray *keys = [strings allKeys];
+    
+    for (NSUInteger i = 0; i < 2; ++i) {
+        BOOL precompiled = (i == 1);
+        NSString *variant = precompiled ? @"precompiled" : @"strings";
+        NSBundle *bundle = TestLocalizedBundle([@"LocalizationBenchmarkLookup-" stringByAppendingString:variant],
+                                               [NSDictionary dictionaryWithObject:strings forKey:@"Localizable"],
+                                               precompiled);
+        
+        // Cold: The table is loaded again for each lookup
+        __block NSUInteger coldKeyIndex = 0;
+        void (^coldLookupBlock)(void) = ^{
+            HLSBenchmarkPurgeCaches();
+            [bundle localizedStringForKey:[keys objectAtIndex:coldKeyIndex++ % [keys count]] value:nil table:nil];
+        };
+        TestBenchmarkReportTimes([NSString stringWithFormat:@"localization.lookup.cold.%@", variant], kBenchmarkTableSize,
+                                 TestBenchmarkMeasure(kBenchmarkColdRunCount, coldLookupBlock));
+        
+        // Warm
+        void (^warmLookupBlock)(void) = ^{
+            for (NSUInteger j = 0; j < kBenchmarkWarmLookupCount; ++j) {
+                [bundle localizedStringForKey:[keys objectAtIndex:j % [keys count]] value:nil table:nil];
+            }
+        };
+        TestBenchmarkReportTimes([NSString stringWithFormat:@"localization.lookup.warm.%@", variant], kBenchmarkTableSize,
+                                 TestBenchmarkMeasure(kBenchmarkWarmRunCount, warmLookupBlock));
+        
+        TestRemoveLocalizedBundle(bundle);
+    }
+}
+
+- (void)testRelocalizationWithLiveLabels
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSString *localization = [NSBundle localization];
+    for (NSUInteger i = 0; i < sizeof(kBenchmarkLabelCounts) / sizeof(kBenchmarkLabelCounts[0]); ++i) {
+        NSUInteger labelCount = kBenchmarkLabelCounts[i];
+        
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        UIView *view = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)] autorelease];
+        for (NSUInteger j = 0; j < labelCount; ++j) {
+            UILabel *label = [[[UILabel alloc] initWithFrame:CGRectMake(0.f, 0.f, 100.f, 20.f)] autorelease];
+            label.text = [NSString stringWithFormat:@"LS/Key %d", j % 50];
+            [view addSubview:label];
+        }
+        
+        // Each run switches to another localization, relocalizing all labels
+        void (^switchBlock)(void) = ^{
+            [NSBundle setLocalization:[[NSBundle localization] isEqualToString:@"en"] ? @"fr" : @"en"];
+        };
+        TestBenchmarkReportTimes(@"localization.switch", labelCount, TestBenchmarkMeasure(kBenchmarkSwitchRunCount, switchBlock));
+        [pool drain];
+    }
+    
+    [NSBundle setLocalization:localization];
+}
+
+- (void)testTableCacheMemory
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    NSDictionary *strings = HLSBenchmarkStrings(kBenchmarkMemoryTableSize);
+    NSArray *keys = [strings allKeys];
+    
+    for (NSUInteger i = 0; i < 2; ++i) {
+        BOOL precompiled = (i == 1);
+        NSString *variant = precompiled ? @"precompiled" : @"strings";
+        NSBundle *bundle = TestLocalizedBundle([@"LocalizationBenchmarkMemory-" stringByAppendingString:variant],
+                                               [NSDictionary dictionaryWithObject:strings forKey:@"Localizable"],
+                                               precompiled);
+        HLSBenchmarkPurgeCaches();
+        
+        // Look up a few strings spread over the table, as a screen would
+        NSUInteger residentSizeBefore = HLSBenchmarkResidentSize();
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        for (NSUInteger j = 0; j < 50; ++j) {
+            [bundle localizedStringForKey:[keys objectAtIndex:(j * [keys count]) / 50] value:nil table:nil];
+        }
+        [pool drain];
+        NSUInteger residentSizeAfter = HLSBenchmarkResidentSize();
+        
+        TestBenchmarkReportValue([NSString stringWithFormat:@"localization.memory.%@", variant], kBenchmarkMemoryTableSize,
+                                 residentSizeAfter > residentSizeBefore ? (residentSizeAfter - residentSizeBefore) / 1024. : 0., @"KB");
+        
+        HLSBenchmarkPurgeCaches();
+        TestRemoveLocalizedBundle(bundle);
+    }
+}
+
+@end
+
+#pragma mark Helper functions
+
+static NSDictionary *HLSBenchmarkStrings(NSUInteger count)
+{
+    NSMutableDictionary *strings = [NSMutableDictionary dictionaryWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [strings setObject:[NSString stringWithFormat:@"Localized benchmark string number %d", i]
+                    forKey:[NSString stringWithFormat:@"benchmark.key.%d", i]];
+    }
+    return [NSDictionary dictionaryWithDictionary:strings];
+}
+
+static NSUInteger HLSBenchmarkResidentSize(void)
+{
+    struct task_basic_info info;
+    mach_msg_type_number_t count = TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+}
+
+// Strings tables are discarded on memory warnings
+static void HLSBenchmarkPurgeCaches(void)
+{
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+}
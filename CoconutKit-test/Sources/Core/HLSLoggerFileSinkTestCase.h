@@ -0,0 +1,14 @@
+//
+//  HLSLoggerFileSinkTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSLoggerFileSinkTestCase : GHTestCase {
+@private
+    
+}
+
+@end
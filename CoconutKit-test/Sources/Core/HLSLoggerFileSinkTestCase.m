@@ -0,0 +1,162 @@
+//
+//  HLSLoggerFileSinkTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSLoggerFileSinkTestCase.h"
+
+// Static functions
+static NSString *HLSLoggerFileSinkTestDirectoryPath(NSString *name);
+static NSString *HLSLoggerFileSinkTestLine(NSUInteger index);
+
+@implementation HLSLoggerFileSinkTestCase
+
+#pragma mark Tests
+
+- (void)testRotation
+{
+    NSString *directoryPath = HLSLoggerFileSinkTestDirectoryPath(@"rotation");
+    HLSLoggerFileSink *fileSink = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                        segmentSize:100
+                                                                maximumSegmentCount:3
+                                                                           tailSize:0] autorelease];
+    GHAssertNotNil(fileSink, @"Creation");
+    
+    // Lines are 30 bytes long (line break included), i.e. 3 lines fit in a segment. Flush after each line so that 
+    // lines are written one by one
+    for (NSUInteger i = 0; i < 20; ++i) {
+        [fileSink writeLine:HLSLoggerFileSinkTestLine(i)];
+        [fileSink flush];
+    }
+    
+    // Only the 3 most recent segments are kept, the current one first
+    NSArray *segmentPaths = [fileSink segmentPaths];
+    GHAssertEquals([segmentPaths count], 3U, @"Segment count");
+    
+    NSArray *expectedFirstLineIndexes = [NSArray arrayWithObjects:[NSNumber numberWithUnsignedInt:18], 
+                                         [NSNumber numberWithUnsignedInt:15], 
+                                         [NSNumber numberWithUnsignedInt:12], nil];
+    NSArray *expectedLineCounts = [NSArray arrayWithObjects:[NSNumber numberWithUnsignedInt:2], 
+                                   [NSNumber numberWithUnsignedInt:3], 
+                                   [NSNumber numberWithUnsignedInt:3], nil];
+    for (NSUInteger i = 0; i < [segmentPaths count]; ++i) {
+        NSString *segmentPath = [segmentPaths objectAtIndex:i];
+        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:segmentPath error:NULL];
+        GHAssertTrue([attributes fileSize] <= 100ULL, @"Segment size");
+        
+        NSMutableString *expectedContents = [NSMutableString string];
+        NSUInteger firstLineIndex = [[expectedFirstLineIndexes objectAtIndex:i] unsignedIntValue];
+        NSUInteger lineCount = [[expectedLineCounts objectAtIndex:i] unsignedIntValue];
+        for (NSUInteger j = firstLineIndex; j < firstLineIndex + lineCount; ++j) {
+            [expectedContents appendFormat:@"%@\n", HLSLoggerFileSinkTestLine(j)];
+        }
+        
+        NSString *contents = [NSString stringWithContentsOfFile:segmentPath encoding:NSUTF8StringEncoding error:NULL];
+        GHAssertEqualStrings(contents, expectedContents, @"Segment %d", i);
+    }
+}
+
+- (void)testExistingSegmentIsAppended
+{
+    NSString *directoryPath = HLSLoggerFileSinkTestDirectoryPath(@"append");
+    HLSLoggerFileSink *fileSink1 = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                         segmentSize:100
+                                                                 maximumSegmentCount:2
+                                                                            tailSize:0] autorelease];
+    [fileSink1 writeLine:HLSLoggerFileSinkTestLine(0)];
+    [fileSink1 writeLine:HLSLoggerFileSinkTestLine(1)];
+    [fileSink1 flush];
+    
+    // The size of the current segment is taken into account when a sink is created for an existing directory
+    HLSLoggerFileSink *fileSink2 = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                         segmentSize:100
+                                                                 maximumSegmentCount:2
+                                                                            tailSize:0] autorelease];
+    [fileSink2 writeLine:HLSLoggerFileSinkTestLine(2)];
+    [fileSink2 flush];
+    GHAssertEquals([[fileSink2 segmentPaths] count], 1U, @"No rotation");
+    
+    [fileSink2 writeLine:HLSLoggerFileSinkTestLine(3)];
+    [fileSink2 flush];
+    GHAssertEquals([[fileSink2 segmentPaths] count], 2U, @"Rotation");
+    
+    NSString *contents = [NSString stringWithContentsOfFile:[[fileSink2 segmentPaths] objectAtIndex:0] encoding:NSUTF8StringEncoding error:NULL];
+    GHAssertEqualStrings(contents, [HLSLoggerFileSinkTestLine(3) stringByAppendingString:@"\n"], @"Current segment");
+}
+
+- (void)testTail
+{
+    NSString *directoryPath = HLSLoggerFileSinkTestDirectoryPath(@"tail");
+    HLSLoggerFileSink *fileSink = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                        segmentSize:1024
+                                                                maximumSegmentCount:2
+                                                                           tailSize:64] autorelease];
+    GHAssertNil(fileSink.previousTail, @"No previous run");
+    GHAssertEqualStrings([fileSink tail], @"", @"Empty tail");
+    
+    [fileSink writeLine:@"first"];
+    GHAssertEqualStrings([fileSink tail], @"first\n", @"Tail before wrapping");
+    
+    // The tail is available before lines are written to the segment, and only keeps the last bytes
+    NSMutableString *allLines = [NSMutableString stringWithString:@"first\n"];
+    for (NSUInteger i = 0; i < 5; ++i) {
+        NSString *line = HLSLoggerFileSinkTestLine(i);
+        [fileSink writeLine:line];
+        [allLines appendFormat:@"%@\n", line];
+    }
+    GHAssertEqualStrings([fileSink tail], [allLines substringFromIndex:[allLines length] - 64], @"Tail after wrapping");
+    
+    // A line larger than the tail itself
+    NSString *longLine = [@"" stringByPaddingToLength:100 withString:@"0123456789" startingAtIndex:0];
+    [fileSink writeLine:longLine];
+    GHAssertEqualStrings([fileSink tail], [[longLine stringByAppendingString:@"\n"] substringFromIndex:101 - 64], @"Long line");
+}
+
+- (void)testTailRecovery
+{
+    NSString *directoryPath = HLSLoggerFileSinkTestDirectoryPath(@"recovery");
+    HLSLoggerFileSink *fileSink1 = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                         segmentSize:1024
+                                                                 maximumSegmentCount:2
+                                                                            tailSize:64] autorelease];
+    for (NSUInteger i = 0; i < 5; ++i) {
+        [fileSink1 writeLine:HLSLoggerFileSinkTestLine(i)];
+    }
+    NSString *tail = [fileSink1 tail];
+    
+    // Simulate a crash: The first sink is neither flushed nor deallocated before the next one reads the tail file
+    HLSLoggerFileSink *fileSink2 = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                         segmentSize:1024
+                                                                 maximumSegmentCount:2
+                                                                            tailSize:64] autorelease];
+    GHAssertEqualStrings(fileSink2.previousTail, tail, @"Recovered tail");
+    GHAssertEqualStrings([fileSink2 tail], @"", @"New tail");
+    
+    // The tail of a previous run cannot be recovered if the tail size changed
+    HLSLoggerFileSink *fileSink3 = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                         segmentSize:1024
+                                                                 maximumSegmentCount:2
+                                                                            tailSize:128] autorelease];
+    GHAssertNil(fileSink3.previousTail, @"Tail size changed");
+}
+
+@end
+
+#pragma mark Static functions
+
+// Return an empty directory for the test
+static NSString *HLSLoggerFileSinkTestDirectoryPath(NSString *name)
+{
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"HLSLoggerFileSinkTestCase-%@", name]];
+    [[NSFileManager defaultManager] removeItemAtPath:directoryPath error:NULL];
+    return directoryPath;
+}
+
+// Lines are 29 characters long
+static NSString *HLSLoggerFileSinkTestLine(NSUInteger index)
+{
+    return [[NSString stringWithFormat:@"Line %02u ", index] stringByPaddingToLength:29 withString:@"." startingAtIndex:0];
+}
@@ -0,0 +1,16 @@
+//
+//  HLSNotificationsTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSNotificationsTestCase : GHTestCase {
+@private
+    NSUInteger m_numberOfReceivedNotifications;
+    id m_lastNotificationObject;
+    id m_conversionSourceObject;                    // Conversions to remove when the test ends (not retained)
+}
+
+@end
@@ -0,0 +1,185 @@
+//
+//  HLSNotificationsTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSNotificationsTestCase.h"
+
+static NSString * const kSourceNotification = @"HLSNotificationsTestCaseSourceNotification";
+static NSString * const kTargetNotification = @"HLSNotificationsTestCaseTargetNotification";
+
+@interface HLSNotificationsTestCase ()
+
+- (void)targetNotification:(NSNotification *)notification;
+
+@end
+
+@implementation HLSNotificationsTestCase
+
+#pragma mark Test setup and tear down
+
+- (void)setUp
+{
+    [super setUp];
+    
+    m_numberOfReceivedNotifications = 0;
+    m_lastNotificationObject = nil;
+    m_conversionSourceObject = nil;
+    [[NSNotificationCenter defaultCenter] addObserver:self 
+                                             selector:@selector(targetNotification:) 
+                                                 name:kTargetNotification 
+                                               object:nil];
+}
+
+- (void)tearDown
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:kTargetNotification object:nil];
+    
+    // Restore the shared converter, even if a test failed (conversions are keyed by address, the source object is
+    // not messaged)
+    HLSNotificationConverter *converter = [HLSNotificationConverter sharedNotificationConverter];
+    [converter removeConversionsFromObject:m_conversionSourceObject];
+    converter.postingStyle = NSPostNow;
+    converter.modes = nil;
+    
+    [super tearDown];
+}
+
+#pragma mark Tests
+
+- (void)testConversion
+{
+    NSObject *objectFrom1 = [[[NSObject alloc] init] autorelease];
+    NSObject *objectFrom2 = [[[NSObject alloc] init] autorelease];
+    NSObject *objectTo1 = [[[NSObject alloc] init] autorelease];
+    NSObject *objectTo2 = [[[NSObject alloc] init] autorelease];
+    
+    HLSNotificationConverter *converter = [HLSNotificationConverter sharedNotificationConverter];
+    [converter convertNotificationWithName:kSourceNotification 
+                              sentByObject:objectFrom1 
+                  intoNotificationWithName:kTargetNotification 
+                              sentByObject:objectTo1];
+    [converter convertNotificationWithName:kSourceNotification 
+                              sentByObject:objectFrom2 
+                  intoNotificationWithName:kTargetNotification 
+                              sentByObject:objectTo2];
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom1];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)1, @"Converted notification");
+    GHAssertEquals(m_lastNotificationObject, (id)objectTo1, @"Converted notification sender");
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom2];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"Converted notification");
+    GHAssertEquals(m_lastNotificationObject, (id)objectTo2, @"Converted notification sender");
+    
+    // Removing the rules for one object must not affect the other one
+    [converter removeConversionsFromObject:objectFrom1];
+    [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom1];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"Removed conversion");
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom2];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"Remaining conversion");
+    
+    [converter removeConversionsFromObject:objectFrom2];
+    [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom2];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"Removed conversion");
+}
+
+- (void)testDeferredCoalescing
+{
+    NSObject *object = [[[NSObject alloc] init] autorelease];
+    
+    // Posted synchronously
+    [object postCoalescingNotificationWithName:kTargetNotification];
+    [object postCoalescingNotificationWithName:kTargetNotification];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"NSPostNow");
+    
+    // A burst is collapsed into a single notification, posted when the run loop runs
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [object postCoalescingNotificationWithName:kTargetNotification userInfo:nil postingStyle:NSPostASAP modes:nil];
+    }
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"Deferred");
+    
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"Coalesced");
+    GHAssertEquals(m_lastNotificationObject, (id)object, @"Sender");
+}
+
+- (void)testDeferredConversion
+{
+    NSObject *objectFrom = [[[NSObject alloc] init] autorelease];
+    NSObject *objectTo = [[[NSObject alloc] init] autorelease];
+    
+    HLSNotificationConverter *converter = [HLSNotificationConverter sharedNotificationConverter];
+    converter.postingStyle = NSPostASAP;
+    m_conversionSourceObject = objectFrom;
+    [converter convertNotificationWithName:kSourceNotification 
+                              sentByObject:objectFrom 
+                  intoNotificationWithName:kTargetNotification 
+                              sentByObject:objectTo];
+    
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:kSourceNotification object:objectFrom];
+    }
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)0, @"Deferred");
+    
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)1, @"Coalesced");
+    GHAssertEquals(m_lastNotificationObject, (id)objectTo, @"Converted notification sender");
+}
+
+- (void)testCollectionObservers
+{
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+    
+    NSMutableArray *objects = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [objects addObject:[[[NSObject alloc] init] autorelease]];
+    }
+    NSObject *otherObject = [[[NSObject alloc] init] autorelease];
+    
+    // Stop receiving all target notifications, only observe those sent by the collection objects
+    [notificationCenter removeObserver:self name:kTargetNotification object:nil];
+    [notificationCenter addObserver:self selector:@selector(targetNotification:) name:kTargetNotification objectsInCollection:objects];
+    
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:500]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)1, @"Object in collection");
+    GHAssertEquals(m_lastNotificationObject, [objects objectAtIndex:500], @"Sender");
+    
+    [notificationCenter postNotificationName:kTargetNotification object:otherObject];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)1, @"Object not in collection");
+    
+    // Registering twice does not lead to duplicate notifications
+    [notificationCenter addObserver:self selector:@selector(targetNotification:) name:kTargetNotification objectsInCollection:objects];
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:0]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"Single registration");
+    
+    [notificationCenter removeObserver:self name:kTargetNotification objectsInCollection:[objects subarrayWithRange:NSMakeRange(0, 500)]];
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:0]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)2, @"Removed");
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:999]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"Not removed");
+    
+    [notificationCenter removeObserver:self name:kTargetNotification objectsInCollection:objects];
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:999]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"Removed");
+    
+    // -removeObserver: drops all registrations as well (usually called by observers when they are deallocated)
+    [notificationCenter addObserver:self selector:@selector(targetNotification:) name:kTargetNotification objectsInCollection:objects];
+    [notificationCenter removeObserver:self];
+    [notificationCenter postNotificationName:kTargetNotification object:[objects objectAtIndex:999]];
+    GHAssertEquals(m_numberOfReceivedNotifications, (NSUInteger)3, @"All registrations removed");
+}
+
+#pragma mark Notification callbacks
+
+- (void)targetNotification:(NSNotification *)notification
+{
+    ++m_numberOfReceivedNotifications;
+    m_lastNotificationObject = notification.object;
+}
+
+@end
@@ -0,0 +1,18 @@
+//
+//  HLSPerformanceRegressionTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Performance regression tests for the operations whose cost we rely on: Task submission, transition setup, container
+ * push and pop, localization lookup and Core Data fetch helpers. Each test fails if the median running time of its
+ * operation exceeds the baseline recorded for the device class the tests run on (see TestBenchmarks.h). Tests without
+ * baseline for this device class only report their results, unless HLSBenchmarkBaselineRequired is set. Like all
+ * benchmarks, these tests are only run when the HLSBenchmarks environment variable is set
+ */
+@interface HLSPerformanceRegressionTestCase : GHTestCase
+
+@end
@@ -0,0 +1,243 @@
+//
+//  HLSPerformanceRegressionTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSPerformanceRegressionTestCase.h"
+
+#import "HLSTask+Friend.h"
+#import "Person.h"
+#import "TestBenchmarks.h"
+#import "TestLocalizedBundles.h"
+
+static const NSUInteger kRegressionRunCount = 50;
+static const NSUInteger kRegressionTaskCount = 1000;
+static const NSUInteger kRegressionTransitionCount = 100;
+static const NSUInteger kRegressionStackDepth = 10;
+static const NSUInteger kRegressionTableSize = 1000;
+static const NSUInteger kRegressionLookupCount = 10000;
+static const NSUInteger kRegressionObjectCount = 1000;
+
+@interface RegressionTask : HLSTask
+
+@end
+
+@interface RegressionTaskOperation : HLSTaskOperation
+
+@end
+
+@interface HLSPerformanceRegressionTestCase ()
+
+@property (nonatomic, retain) HLSModelManager *modelManager;
+
+@end
+
+@implementation HLSPerformanceRegressionTestCase
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.modelManager = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize modelManager = m_modelManager;
+
+#pragma mark Test setup and tear down
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Task operations notify the thread they were submitted from, and view controllers are involved
+    return YES;
+}
+
+- (void)tearDown
+{
+    // Restore the model manager stack even if a test failed
+    if (self.modelManager) {
+        [HLSModelManager popModelManager];
+        self.modelManager = nil;
+    }
+    
+    [super tearDown];
+}
+
+#pragma mark Tests
+
+- (void)testTaskSubmission
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    void (^block)(void) = ^{
+        NSMutableArray *tasks = [NSMutableArray arrayWithCapacity:kRegressionTaskCount];
+        for (NSUInteger i = 0; i < kRegressionTaskCount; ++i) {
+            [tasks addObject:[[[RegressionTask alloc] init] autorelease]];
+        }
+        [taskManager submitTasks:tasks];
+        [taskManager cancelTasks:tasks];
+    };
+    TestBenchmarkAssertNoRegression(@"regression.task.submit", kRegressionTaskCount, kRegressionRunCount, block);
+    
+    // Let cancelled operations finish before the manager is destroyed
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+}
+
+- (void)testTransitionSetup
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    UIView *view = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, 320.f, 480.f)] autorelease];
+    UIView *appearingView = [[[UIView alloc] initWithFrame:view.bounds] autorelease];
+    [view addSubview:appearingView];
+    UIView *disappearingView = [[[UIView alloc] initWithFrame:view.bounds] autorelease];
+    [view addSubview:disappearingView];
+    
+    // Cycle through all transitions
+    NSArray *transitionNames = [HLSTransition availableTransitionNames];
+    void (^block)(void) = ^{
+        for (NSUInteger i = 0; i < kRegressionTransitionCount; ++i) {
+            Class transitionClass = [HLSTransition transitionClassForName:[transitionNames objectAtIndex:i % [transitionNames count]]];
+            [transitionClass animationWithAppearingView:appearingView
+                                       disappearingView:disappearingView
+                                                 inView:view
+                                               duration:kAnimationTransitionDefaultDuration];
+            [transitionClass reverseAnimationWithAppearingView:disappearingView
+                                              disappearingView:appearingView
+                                                        inView:view
+                                                      duration:kAnimationTransitionDefaultDuration];
+        }
+    };
+    TestBenchmarkAssertNoRegression(@"regression.transition.setup", kRegressionTransitionCount, kRegressionRunCount, block);
+}
+
+- (void)testContainerPushAndPop
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    UIViewController *rootViewController = [[[UIViewController alloc] init] autorelease];
+    HLSStackController *stackController = [[[HLSStackController alloc] initWithRootViewController:rootViewController] autorelease];
+    
+    // Display the container so that views are actually loaded and transitions played
+    UIWindow *window = [[UIApplication sharedApplication] keyWindow];
+    stackController.view.frame = window.bounds;
+    [stackController viewWillAppear:NO];
+    [window addSubview:stackController.view];
+    [stackController viewDidAppear:NO];
+    
+    void (^block)(void) = ^{
+        for (NSUInteger i = 0; i < kRegressionStackDepth; ++i) {
+            [stackController pushViewController:[[[UIViewController alloc] init] autorelease]
+                            withTransitionClass:[HLSTransitionCoverFromBottom class]
+                                       animated:NO];
+        }
+        for (NSUInteger i = 0; i < kRegressionStackDepth; ++i) {
+            [stackController popViewControllerAnimated:NO];
+        }
+    };
+    TestBenchmarkAssertNoRegression(@"regression.container.pushpop", kRegressionStackDepth, kRegressionRunCount, block);
+    GHAssertEquals([stackController count], (NSUInteger)1, nil);
+    
+    [stackController viewWillDisappear:NO];
+    [stackController.view removeFromSuperview];
+    [stackController viewDidDisappear:NO];
+}
+
+- (void)testLocalizationLookup
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    // Dynamic localization is only enabled once a localization has been set
+    [NSBundle setLocalization:[NSBundle localization]];
+    
+    NSMutableDictionary *strings = [NSMutableDictionary dictionaryWithCapacity:kRegressionTableSize];
+    for (NSUInteger i = 0; i < kRegressionTableSize; ++i) {
+        [strings setObject:[NSString stringWithFormat:@"Localized string %u", i] forKey:[NSString stringWithFormat:@"key_%u", i]];
+    }
+    NSArray *keys = [strings allKeys];
+    NSBundle *bundle = TestLocalizedBundle(@"PerformanceRegressionLookup", [NSDictionary dictionaryWithObject:strings forKey:@"Localizable"], NO);
+    
+    void (^block)(void) = ^{
+        for (NSUInteger i = 0; i < kRegressionLookupCount; ++i) {
+            [bundle localizedStringForKey:[keys objectAtIndex:i % kRegressionTableSize] value:nil table:nil];
+        }
+    };
+    TestBenchmarkAssertNoRegression(@"regression.localization.lookup", kRegressionLookupCount, kRegressionRunCount, block);
+    
+    TestRemoveLocalizedBundle(bundle);
+}
+
+- (void)testCoreDataFetchHelpers
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    // Work in a separate store so that the data of other tests is left untouched
+    self.modelManager = [HLSModelManager inMemoryModelManagerWithModelFileName:@"CoconutKitTestData" 
+                                                                      inBundle:nil 
+                                                                 configuration:nil 
+                                                                       options:nil];
+    [HLSModelManager pushModelManager:self.modelManager];
+    
+    NSMutableArray *lastNames = [NSMutableArray arrayWithCapacity:kRegressionObjectCount];
+    for (NSUInteger i = 0; i < kRegressionObjectCount; ++i) {
+        Person *person = [Person insert];
+        person.firstName = (i % 2 == 0) ? @"Tony" : @"Carmela";
+        person.lastName = [NSString stringWithFormat:@"Slowprano %u", i];
+        [lastNames addObject:person.lastName];
+    }
+    GHAssertTrue([HLSModelManager saveCurrentModelContext:NULL], @"Failed to insert persons");
+    
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"firstName == %@", @"Tony"];
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"lastName" ascending:YES];
+    void (^fetchBlock)(void) = ^{
+        [Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptor:sortDescriptor];
+        [Person countOfObjectsUsingPredicate:predicate];
+    };
+    TestBenchmarkAssertNoRegression(@"regression.coredata.fetch", kRegressionObjectCount, kRegressionRunCount, fetchBlock);
+    
+    void (^cacheBlock)(void) = ^{
+        [Person clearObjectCache];
+        [Person cacheObjectsWithValues:lastNames forKey:@"lastName"];
+        for (NSString *lastName in lastNames) {
+            [Person cachedObjectWithValue:lastName forKey:@"lastName"];
+        }
+    };
+    TestBenchmarkAssertNoRegression(@"regression.coredata.cachedLookup", kRegressionObjectCount, kRegressionRunCount, cacheBlock);
+    
+    [Person clearObjectCache];
+}
+
+@end
+
+@implementation RegressionTask
+
+- (Class)operationClass
+{
+    return [RegressionTaskOperation class];
+}
+
+@end
+
+@implementation RegressionTaskOperation
+
+- (void)operationMain
+{}
+
+@end
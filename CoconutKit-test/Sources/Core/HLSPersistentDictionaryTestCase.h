@@ -0,0 +1,14 @@
+//
+//  HLSPersistentDictionaryTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSPersistentDictionaryTestCase : GHTestCase {
+@private
+    
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  HLSPersistentDictionaryTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSPersistentDictionaryTestCase.h"
+
+// Keys with a configurable hash, to test collisions
+@interface HLSPersistentDictionaryTestKey : NSObject <NSCopying> {
+@private
+    NSString *m_name;
+    NSUInteger m_hash;
+}
+
+- (id)initWithName:(NSString *)name hash:(NSUInteger)hash;
+
+@end
+
+@implementation HLSPersistentDictionaryTestKey
+
+- (id)initWithName:(NSString *)name hash:(NSUInteger)hash
+{
+    if ((self = [super init])) {
+        m_name = [name retain];
+        m_hash = hash;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_name release];
+    
+    [super dealloc];
+}
+
+- (NSUInteger)hash
+{
+    return m_hash;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (! [object isKindOfClass:[HLSPersistentDictionaryTestKey class]]) {
+        return NO;
+    }
+    return [m_name isEqualToString:((HLSPersistentDictionaryTestKey *)object)->m_name];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return [self retain];
+}
+
+@end
+
+@implementation HLSPersistentDictionaryTestCase
+
+#pragma mark Tests
+
+- (void)testCreationAndLookup
+{
+    HLSPersistentDictionary *dictionary = [HLSPersistentDictionary dictionaryWithObjectsAndKeys:@"obj1", @"key1", @"obj2", @"key2", nil];
+    GHAssertEquals([dictionary count], 2U, @"count");
+    GHAssertEqualStrings([dictionary objectForKey:@"key1"], @"obj1", @"lookup");
+    GHAssertEqualStrings([dictionary objectForKey:@"key2"], @"obj2", @"lookup");
+    GHAssertNil([dictionary objectForKey:@"key3"], @"lookup");
+    GHAssertEqualObjects(dictionary, [NSDictionary dictionaryWithObjectsAndKeys:@"obj1", @"key1", @"obj2", @"key2", nil], @"equality");
+    
+    HLSPersistentDictionary *emptyDictionary = [HLSPersistentDictionary dictionary];
+    GHAssertEquals([emptyDictionary count], 0U, @"empty");
+}
+
+- (void)testSnapshots
+{
+    HLSPersistentDictionary *dictionary = [HLSPersistentDictionary dictionary];
+    NSMutableArray *snapshots = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 2000; ++i) {
+        dictionary = [dictionary dictionaryBySettingObject:[NSNumber numberWithUnsignedInteger:i] 
+                                                    forKey:[NSString stringWithFormat:@"key%u", i]];
+        [snapshots addObject:dictionary];
+    }
+    
+    GHAssertTrue([dictionary isKindOfClass:[HLSPersistentDictionary class]], @"class");
+    GHAssertEquals([dictionary count], 2000U, @"count");
+    for (NSUInteger i = 0; i < 2000; ++i) {
+        GHAssertEqualObjects([dictionary objectForKey:[NSString stringWithFormat:@"key%u", i]], [NSNumber numberWithUnsignedInteger:i], @"lookup");
+    }
+    
+    // Earlier snapshots are not affected by later modifications
+    HLSPersistentDictionary *snapshot = [snapshots objectAtIndex:999];
+    GHAssertEquals([snapshot count], 1000U, @"snapshot");
+    GHAssertNotNil([snapshot objectForKey:@"key999"], @"snapshot");
+    GHAssertNil([snapshot objectForKey:@"key1000"], @"snapshot");
+    
+    // Replacement
+    HLSPersistentDictionary *replacedDictionary = [dictionary dictionaryBySettingObject:@"replaced" forKey:@"key42"];
+    GHAssertEquals([replacedDictionary count], 2000U, @"replace");
+    GHAssertEqualStrings([replacedDictionary objectForKey:@"key42"], @"replaced", @"replace");
+    GHAssertEqualObjects([dictionary objectForKey:@"key42"], [NSNumber numberWithUnsignedInteger:42], @"replace");
+    
+    // Removal
+    NSMutableArray *keys = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 2000; i += 2) {
+        [keys addObject:[NSString stringWithFormat:@"key%u", i]];
+    }
+    HLSPersistentDictionary *reducedDictionary = [dictionary dictionaryByRemovingObjectsForKeys:keys];
+    GHAssertEquals([reducedDictionary count], 1000U, @"remove");
+    GHAssertNil([reducedDictionary objectForKey:@"key0"], @"remove");
+    GHAssertNotNil([reducedDictionary objectForKey:@"key1"], @"remove");
+    GHAssertEquals([[reducedDictionary allKeys] count], 1000U, @"enumeration");
+    GHAssertEquals([dictionary count], 2000U, @"remove");
+    
+    GHAssertEquals([dictionary dictionaryByRemovingObjectForKey:@"missing"], dictionary, @"remove missing");
+    
+    for (NSString *key in [reducedDictionary allKeys]) {
+        reducedDictionary = [reducedDictionary dictionaryByRemovingObjectForKey:key];
+    }
+    GHAssertEquals([reducedDictionary count], 0U, @"remove all");
+    GHAssertEquals([[reducedDictionary allKeys] count], 0U, @"remove all");
+}
+
+- (void)testCollisions
+{
+    HLSPersistentDictionaryTestKey *key1 = [[[HLSPersistentDictionaryTestKey alloc] initWithName:@"key1" hash:17] autorelease];
+    HLSPersistentDictionaryTestKey *key2 = [[[HLSPersistentDictionaryTestKey alloc] initWithName:@"key2" hash:17] autorelease];
+    HLSPersistentDictionaryTestKey *key3 = [[[HLSPersistentDictionaryTestKey alloc] initWithName:@"key3" hash:17] autorelease];
+    
+    HLSPersistentDictionary *dictionary = [HLSPersistentDictionary dictionary];
+    dictionary = [dictionary dictionaryBySettingObject:@"obj1" forKey:key1];
+    dictionary = [dictionary dictionaryBySettingObject:@"obj2" forKey:key2];
+    dictionary = [dictionary dictionaryBySettingObject:@"obj3" forKey:key3];
+    GHAssertEquals([dictionary count], 3U, @"collisions");
+    GHAssertEqualStrings([dictionary objectForKey:key1], @"obj1", @"collisions");
+    GHAssertEqualStrings([dictionary objectForKey:key2], @"obj2", @"collisions");
+    GHAssertEqualStrings([dictionary objectForKey:key3], @"obj3", @"collisions");
+    GHAssertEquals([[dictionary allKeys] count], 3U, @"collisions");
+    
+    dictionary = [dictionary dictionaryByRemovingObjectForKey:key2];
+    dictionary = [dictionary dictionaryByRemovingObjectForKey:key3];
+    GHAssertEquals([dictionary count], 1U, @"collisions");
+    GHAssertEqualStrings([dictionary objectForKey:key1], @"obj1", @"collisions");
+    GHAssertNil([dictionary objectForKey:key2], @"collisions");
+}
+
+@end
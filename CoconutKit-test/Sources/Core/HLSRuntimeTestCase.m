@@ -0,0 +1,140 @@
+//
+//  HLSRuntimeTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSRuntimeTestCase.h"
+
+static NSInteger (*s_SwizzledClass__value_Imp)(id, SEL) = NULL;
+static NSInteger (*s_SwizzledClass__value_Imp2)(id, SEL) = NULL;
+
+static NSInteger swizzled_SwizzledClass__value_Imp(id self, SEL _cmd);
+static NSInteger swizzled_SwizzledClass__value_Imp2(id self, SEL _cmd);
+
+@interface SwizzledClass : NSObject
+
+- (NSInteger)value;
+
+@end
+
+@interface BaseClass : NSObject
+
+@end
+
+@interface ChildClass : BaseClass
+
+@end
+
+@interface GrandchildClass : ChildClass
+
+@end
+
+@implementation HLSRuntimeTestCase
+
+#pragma mark Tests
+
+- (void)testSwizzlingRegistry
+{
+    GHAssertNULL((void *)HLSOriginalSelectorImplementation([SwizzledClass class], @selector(value)), @"Not swizzled yet");
+    
+    IMP originalImplementation = class_getMethodImplementation([SwizzledClass class], @selector(value));
+    s_SwizzledClass__value_Imp = (NSInteger (*)(id, SEL))HLSSwizzleSelector([SwizzledClass class], 
+                                                                             @selector(value), 
+                                                                             (IMP)swizzled_SwizzledClass__value_Imp);
+    GHAssertEquals((IMP)s_SwizzledClass__value_Imp, originalImplementation, @"Original implementation");
+    GHAssertEquals(HLSOriginalSelectorImplementation([SwizzledClass class], @selector(value)), originalImplementation, 
+                   @"Registered original implementation");
+    
+    SwizzledClass *swizzledClass = [[[SwizzledClass alloc] init] autorelease];
+    GHAssertEquals([swizzledClass value], (NSInteger)2, @"Swizzled value");
+    
+    // Swizzling again with the same implementation must not make it call itself
+    IMP implementation = HLSSwizzleSelector([SwizzledClass class], @selector(value), (IMP)swizzled_SwizzledClass__value_Imp);
+    GHAssertEquals(implementation, originalImplementation, @"Double swizzle");
+    GHAssertEquals([swizzledClass value], (NSInteger)2, @"Swizzled value");
+    
+    // Same with another swizzle in between (A-B-A)
+    s_SwizzledClass__value_Imp2 = (NSInteger (*)(id, SEL))HLSSwizzleSelector([SwizzledClass class], 
+                                                                              @selector(value), 
+                                                                              (IMP)swizzled_SwizzledClass__value_Imp2);
+    GHAssertEquals((IMP)s_SwizzledClass__value_Imp2, (IMP)swizzled_SwizzledClass__value_Imp, @"Swizzled implementation");
+    GHAssertEquals([swizzledClass value], (NSInteger)12, @"Swizzled value");
+    
+    implementation = HLSSwizzleSelector([SwizzledClass class], @selector(value), (IMP)swizzled_SwizzledClass__value_Imp);
+    GHAssertEquals(implementation, originalImplementation, @"A-B-A swizzle");
+    GHAssertEquals([swizzledClass value], (NSInteger)12, @"Swizzled value");
+    
+    GHAssertTrue([HLSSwizzlingReport() rangeOfString:@"-[SwizzledClass value]"].location != NSNotFound, @"Report");
+}
+
+- (void)testSubclasses
+{
+    NSArray *subclasses = HLSSubclassesOfClass([BaseClass class]);
+    GHAssertEquals([subclasses count], (NSUInteger)2, @"Subclasses");
+    GHAssertTrue([subclasses containsObject:[ChildClass class]], @"Direct subclass");
+    GHAssertTrue([subclasses containsObject:[GrandchildClass class]], @"Indirect subclass");
+    
+    GHAssertEquals([HLSSubclassesOfClass([GrandchildClass class]) count], (NSUInteger)0, @"No subclass");
+    GHAssertTrue([HLSSubclassesOfClass([NSObject class]) containsObject:[GrandchildClass class]], @"Root class");
+    
+    // Cached
+    GHAssertEquals(HLSSubclassesOfClass([BaseClass class]), subclasses, @"Cached subclasses");
+}
+
+- (void)testMessageSendProfiler
+{
+    BaseClass *baseClass = [[[BaseClass alloc] init] autorelease];
+    
+    HLSMessageSendProfilerReset();
+    HLSMessageSendProfilerStart(@"Base", 1);
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        [baseClass hash];
+        [[NSObject class] hash];
+    }
+    HLSMessageSendProfilerStop();
+    
+    NSString *report = HLSMessageSendProfilerReport(10);
+    GHAssertTrue([report rangeOfString:@"-[BaseClass hash] (implemented by NSObject)"].location != NSNotFound, @"Report");
+    GHAssertTrue([report rangeOfString:@"[NSObject hash]"].location == NSNotFound, @"Out of scope");
+    
+    HLSMessageSendProfilerReset();
+    GHAssertTrue([HLSMessageSendProfilerReport(10) rangeOfString:@"BaseClass"].location == NSNotFound, @"Reset");
+}
+
+@end
+
+@implementation BaseClass
+
+@end
+
+@implementation ChildClass
+
+@end
+
+@implementation GrandchildClass
+
+@end
+
+@implementation SwizzledClass
+
+- (NSInteger)value
+{
+    return 1;
+}
+
+@end
+
+static NSInteger swizzled_SwizzledClass__value_Imp(id self, SEL _cmd)
+{
+    HLSProfileSwizzledSelector([SwizzledClass class], _cmd);
+    
+    return (*s_SwizzledClass__value_Imp)(self, _cmd) + 1;
+}
+
+static NSInteger swizzled_SwizzledClass__value_Imp2(id self, SEL _cmd)
+{
+    return (*s_SwizzledClass__value_Imp2)(self, _cmd) + 10;
+}
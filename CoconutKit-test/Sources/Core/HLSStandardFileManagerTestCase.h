@@ -0,0 +1,14 @@
+//
+//  HLSStandardFileManagerTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSStandardFileManagerTestCase : GHTestCase {
+@private
+    
+}
+
+@end
@@ -0,0 +1,227 @@
+//
+//  HLSStandardFileManagerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSStandardFileManagerTestCase.h"
+
+@implementation HLSStandardFileManagerTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Asynchronous operation completion blocks are called on the main thread, which must therefore run its run loop
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testStreams
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-streams.txt"];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    
+    const char *firstPart = "Hello, ";
+    NSOutputStream *outputStream = [fileManager outputStreamForFileAtPath:path append:NO];
+    [outputStream open];
+    GHAssertEquals([outputStream write:(const uint8_t *)firstPart maxLength:strlen(firstPart)], (NSInteger)strlen(firstPart), @"Write");
+    [outputStream close];
+    
+    const char *secondPart = "World!";
+    outputStream = [fileManager outputStreamForFileAtPath:path append:YES];
+    [outputStream open];
+    GHAssertEquals([outputStream write:(const uint8_t *)secondPart maxLength:strlen(secondPart)], (NSInteger)strlen(secondPart), @"Append");
+    [outputStream close];
+    
+    NSInputStream *inputStream = [fileManager inputStreamForFileAtPath:path];
+    [inputStream open];
+    uint8_t buffer[64];
+    NSInteger length = [inputStream read:buffer maxLength:sizeof(buffer)];
+    [inputStream close];
+    NSString *string = [[[NSString alloc] initWithBytes:buffer length:length encoding:NSUTF8StringEncoding] autorelease];
+    GHAssertEqualStrings(string, @"Hello, World!", @"Read");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testMappedReads
+{
+    HLSStandardFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-mapped.dat"];
+    NSMutableData *data = [NSMutableData dataWithLength:100 * 1024];
+    memset([data mutableBytes], 'a', [data length]);
+    GHAssertTrue([fileManager createFileAtPath:path contents:data error:NULL], @"Create");
+    
+    GHAssertEquals(fileManager.mappingThreshold, ULLONG_MAX, @"Mapping is opt-in");
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path error:NULL], data, @"Default");
+    
+    fileManager.mappingThreshold = 0;
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path error:NULL], data, @"Mapped");
+    
+    fileManager.mappingThreshold = ULLONG_MAX;
+    GHAssertEqualObjects([fileManager contentsOfFileAtPath:path error:NULL], data, @"Read");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    
+    NSError *error = nil;
+    GHAssertNil([fileManager contentsOfFileAtPath:path error:&error], @"Missing file");
+    GHAssertNotNil(error, @"Missing file error");
+}
+
+- (void)testRangedReads
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-ranges.txt"];
+    NSData *data = [@"0123456789" dataUsingEncoding:NSUTF8StringEncoding];
+    GHAssertTrue([fileManager createFileAtPath:path contents:data error:NULL], @"Create");
+    
+    NSError *error = nil;
+    NSData *rangeData = [fileManager contentsOfFileAtPath:path range:NSMakeRange(2, 3) error:&error];
+    GHAssertEqualObjects(rangeData, [@"234" dataUsingEncoding:NSUTF8StringEncoding], @"Range");
+    
+    rangeData = [fileManager contentsOfFileAtPath:path range:NSMakeRange(8, 10) error:&error];
+    GHAssertEqualObjects(rangeData, [@"89" dataUsingEncoding:NSUTF8StringEncoding], @"Range past the end of the file");
+    
+    rangeData = [fileManager contentsOfFileAtPath:path range:NSMakeRange(20, 5) error:&error];
+    GHAssertEquals([rangeData length], (NSUInteger)0, @"Range starting past the end of the file");
+    
+    // No buffer is allocated for the part of the range past the end of the file
+    rangeData = [fileManager contentsOfFileAtPath:path range:NSMakeRange(5, NSUIntegerMax - 5) error:&error];
+    GHAssertEqualObjects(rangeData, [@"56789" dataUsingEncoding:NSUTF8StringEncoding], @"Huge range");
+    GHAssertNil(error, @"Error");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    
+    GHAssertNil([fileManager contentsOfFileAtPath:path range:NSMakeRange(0, 1) error:&error], @"Missing file");
+    GHAssertNotNil(error, @"Missing file error");
+}
+
+- (void)testDirectoryEntries
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-entries"];
+    [[NSFileManager defaultManager] removeItemAtPath:directoryPath error:NULL];
+    GHAssertTrue([fileManager createDirectoryAtPath:[directoryPath stringByAppendingPathComponent:@"subdirectory"] withIntermediateDirectories:YES error:NULL], @"Directories");
+    GHAssertTrue([fileManager createFileAtPath:[directoryPath stringByAppendingPathComponent:@"file1.txt"]
+                                      contents:[@"1" dataUsingEncoding:NSUTF8StringEncoding]
+                                         error:NULL], @"File 1");
+    GHAssertTrue([fileManager createFileAtPath:[directoryPath stringByAppendingPathComponent:@"file2.txt"]
+                                      contents:[@"22" dataUsingEncoding:NSUTF8StringEncoding]
+                                         error:NULL], @"File 2");
+    
+    NSError *error = nil;
+    NSArray *entries = [fileManager entriesOfDirectoryAtPath:directoryPath passingTest:nil error:&error];
+    GHAssertEquals([entries count], (NSUInteger)3, @"Entries");
+    GHAssertNil(error, @"Error");
+    
+    NSArray *fileEntries = [fileManager entriesOfDirectoryAtPath:directoryPath passingTest:^(HLSFileEntry *entry) {
+        return (BOOL)! entry.directory;
+    } error:NULL];
+    GHAssertEquals([fileEntries count], (NSUInteger)2, @"File entries");
+    for (HLSFileEntry *entry in fileEntries) {
+        unsigned long long expectedSize = [entry.name isEqualToString:@"file1.txt"] ? 1 : 2;
+        GHAssertEquals(entry.size, expectedSize, @"Size");
+        GHAssertNotNil(entry.modificationDate, @"Modification date");
+    }
+    
+    __block NSUInteger nbrEnumeratedEntries = 0;
+    GHAssertTrue([fileManager enumerateContentsOfDirectoryAtPath:directoryPath usingBlock:^(HLSFileEntry *entry, BOOL *pStop) {
+        ++nbrEnumeratedEntries;
+        *pStop = YES;
+    } error:NULL], @"Enumeration");
+    GHAssertEquals(nbrEnumeratedEntries, (NSUInteger)1, @"Stopped enumeration");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:directoryPath error:NULL];
+    
+    GHAssertNil([fileManager entriesOfDirectoryAtPath:directoryPath passingTest:nil error:&error], @"Missing directory");
+    GHAssertNotNil(error, @"Missing directory error");
+}
+
+- (void)testAsynchronousOperations
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-asynchronous.txt"];
+    NSData *data = [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    __block NSUInteger nbrCompletions = 0;
+    __block BOOL created = NO;
+    __block NSData *readData1 = nil;
+    __block NSData *readData2 = nil;
+    __block BOOL removed = NO;
+    
+    // Operations with the same priority are executed in order
+    [fileManager createFileAtPath:path contents:data priority:HLSFileManagerPriorityNormal completionBlock:^(BOOL success, NSError *error) {
+        created = success;
+        ++nbrCompletions;
+    }];
+    [fileManager contentsOfFileAtPath:path priority:HLSFileManagerPriorityNormal completionBlock:^(NSData *data, NSError *error) {
+        readData1 = [data retain];
+        ++nbrCompletions;
+    }];
+    [fileManager contentsOfFileAtPath:path priority:HLSFileManagerPriorityNormal completionBlock:^(NSData *data, NSError *error) {
+        readData2 = [data retain];
+        ++nbrCompletions;
+    }];
+    [fileManager removeItemAtPath:path priority:HLSFileManagerPriorityNormal completionBlock:^(BOOL success, NSError *error) {
+        removed = success;
+        ++nbrCompletions;
+    }];
+    
+    // Completion blocks are called on the main thread
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.];
+    while (nbrCompletions != 4 && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    
+    GHAssertEquals(nbrCompletions, (NSUInteger)4, @"Completions");
+    GHAssertTrue(created, @"Created");
+    GHAssertEqualObjects(readData1, data, @"Read 1");
+    GHAssertEqualObjects(readData2, data, @"Read 2");
+    GHAssertTrue(removed, @"Removed");
+    GHAssertEquals(fileManager.pendingRequestCount, (NSUInteger)0, @"No pending requests");
+    
+    [readData1 release];
+    [readData2 release];
+}
+
+- (void)testAsynchronousOperationsWithPriorities
+{
+    HLSFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStandardFileManagerTestCase-priorities.txt"];
+    NSData *data = [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    __block NSUInteger nbrCompletions = 0;
+    __block NSData *readData = nil;
+    __block BOOL removed = NO;
+    
+    // Operations on the same path are executed in order, whatever their priorities
+    [fileManager createFileAtPath:path contents:data priority:HLSFileManagerPriorityLow completionBlock:^(BOOL success, NSError *error) {
+        ++nbrCompletions;
+    }];
+    [fileManager contentsOfFileAtPath:path priority:HLSFileManagerPriorityHigh completionBlock:^(NSData *data, NSError *error) {
+        readData = [data retain];
+        ++nbrCompletions;
+    }];
+    [fileManager removeItemAtPath:path priority:HLSFileManagerPriorityLow completionBlock:^(BOOL success, NSError *error) {
+        removed = success;
+        ++nbrCompletions;
+    }];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.];
+    while (nbrCompletions != 3 && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    
+    GHAssertEquals(nbrCompletions, (NSUInteger)3, @"Completions");
+    GHAssertEqualObjects(readData, data, @"Read after creation");
+    GHAssertTrue(removed, @"Removed after read");
+    
+    [readData release];
+}
+
+@end
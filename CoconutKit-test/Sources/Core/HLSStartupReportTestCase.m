@@ -0,0 +1,42 @@
+//
+//  HLSStartupReportTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSStartupReportTestCase.h"
+
+@implementation HLSStartupReportTestCase
+
+#pragma mark Tests
+
+- (void)testReport
+{
+    NSTimeInterval initialTotalDuration = [HLSStartupReport totalDuration];
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [NSThread sleepForTimeInterval:0.01];
+    HLSStartupReportRecord("HLSStartupReportTestCase", startTime);
+    
+    GHAssertTrue([HLSStartupReport totalDuration] - initialTotalDuration >= 0.01, @"Recorded duration");
+    
+    // Features set up at load time must have been recorded as well
+    NSString *report = [HLSStartupReport report];
+    GHAssertTrue([report rangeOfString:@"HLSStartupReportTestCase: "].length != 0, @"Recorded feature");
+    GHAssertTrue([report rangeOfString:@"UIViewController+HLSExtensions: "].length != 0, @"Feature set up at load time");
+}
+
+- (void)testAggregation
+{
+    NSString *featureName = [NSString stringWithFormat:@"HLSStartupReportTestCase %@", [NSDate date]];
+    HLSStartupReportRecordDuration([featureName UTF8String], CFAbsoluteTimeGetCurrent(), 0.001);
+    HLSStartupReportRecordDuration([featureName UTF8String], CFAbsoluteTimeGetCurrent(), 0.002);
+    
+    NSString *report = [HLSStartupReport report];
+    NSString *expectedLine = [NSString stringWithFormat:@"%@: 3.000 ms (2 times)", featureName];
+    GHAssertTrue([report rangeOfString:expectedLine].length != 0, @"Durations summed");
+}
+
+@end
@@ -0,0 +1,84 @@
+//
+//  HLSStringsTableTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSStringsTableTestCase.h"
+
+#import "HLSStringsTable.h"
+
+@implementation HLSStringsTableTestCase
+
+#pragma mark Tests
+
+- (void)testLookup
+{
+    NSString *longKey = [@"" stringByPaddingToLength:1000 withString:@"key" startingAtIndex:0];
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjectsAndKeys:@"Bonjour", @"Hello",
+                                @"Au revoir", @"Goodbye",
+                                @"Préférences", @"Préférences",
+                                @"", @"Empty",
+                                @"Long", longKey,
+                                @"H", @"H",
+                                @"Hello world", @"Hello world",
+                                nil];
+    NSData *data = [HLSStringsTable dataWithStringsDictionary:dictionary];
+    GHAssertNotNil(data, @"Data");
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStringsTableTestCase.hlsstrings"];
+    GHAssertTrue([data writeToFile:path atomically:YES], @"Write");
+    
+    HLSStringsTable *table = [[[HLSStringsTable alloc] initWithContentsOfFile:path] autorelease];
+    GHAssertNotNil(table, @"Table");
+    GHAssertEquals([table count], [dictionary count], @"Count");
+    for (NSString *key in [dictionary allKeys]) {
+        GHAssertEqualStrings([table objectForKey:key], [dictionary objectForKey:key], @"Value for key %@", key);
+    }
+    
+    GHAssertNil([table objectForKey:@"Missing"], @"Missing key");
+    GHAssertNil([table objectForKey:@"Hell"], @"Prefix of an existing key");
+    GHAssertNil([table objectForKey:@""], @"Empty key");
+    GHAssertNil([table objectForKey:nil], @"nil key");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testEmptyTable
+{
+    NSData *data = [HLSStringsTable dataWithStringsDictionary:[NSDictionary dictionary]];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStringsTableTestCase-empty.hlsstrings"];
+    GHAssertTrue([data writeToFile:path atomically:YES], @"Write");
+    
+    HLSStringsTable *table = [[[HLSStringsTable alloc] initWithContentsOfFile:path] autorelease];
+    GHAssertNotNil(table, @"Table");
+    GHAssertEquals([table count], (NSUInteger)0, @"Count");
+    GHAssertNil([table objectForKey:@"Hello"], @"Missing key");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testInvalidData
+{
+    GHAssertNil([HLSStringsTable dataWithStringsDictionary:[NSDictionary dictionaryWithObject:[NSNumber numberWithInt:1] forKey:@"Key"]], 
+                @"Non-string value");
+    
+    GHAssertNil([[[HLSStringsTable alloc] initWithContentsOfFile:nil] autorelease], @"nil path");
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSStringsTableTestCase-invalid.hlsstrings"];
+    GHAssertNil([[[HLSStringsTable alloc] initWithContentsOfFile:path] autorelease], @"Missing file");
+    
+    GHAssertTrue([[@"\"Hello\" = \"Bonjour\";" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:path atomically:YES], @"Write");
+    GHAssertNil([[[HLSStringsTable alloc] initWithContentsOfFile:path] autorelease], @"Strings file");
+    
+    // Truncated table
+    NSData *data = [HLSStringsTable dataWithStringsDictionary:[NSDictionary dictionaryWithObject:@"Bonjour" forKey:@"Hello"]];
+    GHAssertTrue([[data subdataWithRange:NSMakeRange(0, [data length] - 2)] writeToFile:path atomically:YES], @"Write");
+    GHAssertNil([[[HLSStringsTable alloc] initWithContentsOfFile:path] autorelease], @"Truncated table");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+@end
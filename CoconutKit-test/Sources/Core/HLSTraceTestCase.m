@@ -0,0 +1,91 @@
+//
+//  HLSTraceTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTraceTestCase.h"
+
+@implementation HLSTraceTestCase
+
+#pragma mark Test setup and tear down
+
+- (void)setUp
+{
+    [super setUp];
+    
+    [HLSTrace clear];
+}
+
+- (void)tearDown
+{
+    [super tearDown];
+    
+    [HLSTrace setEnabled:NO];
+    [HLSTrace clear];
+}
+
+#pragma mark Tests
+
+- (void)testDisabled
+{
+    HLSTraceIdentifier identifier = HLSTraceBegin(@"Test", @"Interval");
+    GHAssertEquals(identifier, (HLSTraceIdentifier)0, @"No interval when disabled");
+    HLSTraceEnd(identifier);
+    HLSTraceInstant(@"Test", @"Instant");
+    GHAssertEquals([HLSTrace count], (NSUInteger)0, @"Nothing recorded when disabled");
+}
+
+- (void)testRecording
+{
+    [HLSTrace setEnabled:YES];
+    
+    HLSTraceIdentifier identifier1 = HLSTraceBegin(@"Test", @"Interval \"1\"");
+    HLSTraceIdentifier identifier2 = HLSTraceBegin(@"Test", @"Interval 2");
+    GHAssertTrue(identifier1 != 0 && identifier2 != 0 && identifier1 != identifier2, @"Distinct identifiers");
+    HLSTraceInstant(@"Test", @"Instant");
+    HLSTraceEnd(identifier2);
+    HLSTraceEnd(identifier1);
+    GHAssertEquals([HLSTrace count], (NSUInteger)5, @"Recorded events");
+    
+    NSString *jsonString = [HLSTrace chromeTraceJSONString];
+    GHAssertTrue([jsonString rangeOfString:@"\"name\":\"Interval \\\"1\\\"\",\"cat\":\"Test\",\"ph\":\"e\""].length != 0, @"End event named after its begin event, escaped");
+    GHAssertTrue([jsonString rangeOfString:@"\"ph\":\"i\""].length != 0, @"Instant event");
+    
+    [HLSTrace clear];
+    GHAssertEquals([HLSTrace count], (NSUInteger)0, @"Cleared");
+}
+
+- (void)testStatistics
+{
+    [HLSTrace setEnabled:YES];
+    
+    HLSTraceIdentifier identifier1 = HLSTraceBegin(@"A", @"Interval 1");
+    [NSThread sleepForTimeInterval:0.05];
+    HLSTraceEnd(identifier1);
+    HLSTraceIdentifier identifier2 = HLSTraceBegin(@"A", @"Interval 2");
+    HLSTraceEnd(identifier2);
+    HLSTraceIdentifier identifier3 = HLSTraceBegin(@"A", @"Unterminated interval");
+    GHAssertTrue(identifier3 != 0, @"Unterminated interval begun");
+    HLSTraceInstant(@"B", @"Instant 1");
+    HLSTraceInstant(@"B", @"Instant 2");
+    
+    NSDictionary *categoryToStatisticsMap = [HLSTrace statisticsByCategory];
+    GHAssertEquals([categoryToStatisticsMap count], (NSUInteger)2, @"Two categories");
+    
+    NSDictionary *statisticsA = [categoryToStatisticsMap objectForKey:@"A"];
+    GHAssertEquals([[statisticsA objectForKey:HLSTraceIntervalCountKey] unsignedIntegerValue], (NSUInteger)2, @"Unterminated interval ignored");
+    GHAssertEquals([[statisticsA objectForKey:HLSTraceInstantCountKey] unsignedIntegerValue], (NSUInteger)0, @"No instants");
+    double longestDuration = [[statisticsA objectForKey:HLSTraceLongestIntervalDurationKey] doubleValue];
+    double totalDuration = [[statisticsA objectForKey:HLSTraceTotalIntervalDurationKey] doubleValue];
+    GHAssertTrue(longestDuration >= 0.05, @"Longest interval");
+    GHAssertTrue(totalDuration >= longestDuration, @"Total duration");
+    
+    NSDictionary *statisticsB = [categoryToStatisticsMap objectForKey:@"B"];
+    GHAssertEquals([[statisticsB objectForKey:HLSTraceIntervalCountKey] unsignedIntegerValue], (NSUInteger)0, @"No intervals");
+    GHAssertEquals([[statisticsB objectForKey:HLSTraceInstantCountKey] unsignedIntegerValue], (NSUInteger)2, @"Instants");
+}
+
+@end
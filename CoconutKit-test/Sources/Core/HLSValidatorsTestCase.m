@@ -57,6 +57,21 @@
     GHAssertFalse([HLSValidators validateEmailAddress:@"Test \\ Folding \\ Whitespace@example.com"], @"E-mail");            // inconsistency
     GHAssertFalse([HLSValidators validateEmailAddress:@"HM2Kinsists@(that comments are allowed)this.is.ok"], @"E-mail");    // inconsistency
     GHAssertTrue([HLSValidators validateEmailAddress:@"user%%uucp!path@somehost.edu"], @"E-mail");
+    
+    // Additional cases exercising the language of the regex
+    GHAssertFalse([HLSValidators validateEmailAddress:nil], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@""], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a..b@bar.com"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@".a@bar.com"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a.@bar.com"], @"E-mail");
+    GHAssertTrue([HLSValidators validateEmailAddress:@"a.b.c@bar.com"], @"E-mail");
+    GHAssertTrue([HLSValidators validateEmailAddress:@"a@b1.c2.com"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a@bar.c2"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a@bar.c-m"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a@b@bar.com"], @"E-mail");
+    GHAssertFalse([HLSValidators validateEmailAddress:@"a b@bar.com"], @"E-mail");
+    GHAssertTrue([HLSValidators validateEmailAddress:@"j\u00e9r\u00f4me@exemple.ch"], @"E-mail");
+    GHAssertTrue([HLSValidators validateEmailAddress:@"a@\u00e9cole.fran\u00e7ais"], @"E-mail");
 }
 
 @end
@@ -0,0 +1,14 @@
+//
+//  HLSVectorTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSVectorTestCase : GHTestCase {
+@private
+    
+}
+
+@end
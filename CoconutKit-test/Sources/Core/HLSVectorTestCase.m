@@ -0,0 +1,52 @@
+//
+//  HLSVectorTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSVectorTestCase.h"
+
+@implementation HLSVectorTestCase
+
+#pragma mark Tests
+
+- (void)testArithmetic
+{
+    HLSVector2 sum2 = HLSVector2Add(HLSVector2Make(1.f, 2.f), HLSVector2Make(3.f, -4.f));
+    GHAssertTrue(floateq(sum2.v1, 4.f) && floateq(sum2.v2, -2.f), @"Add");
+    
+    HLSVector3 difference3 = HLSVector3Subtract(HLSVector3Make(1.f, 2.f, 3.f), HLSVector3Make(3.f, 2.f, 1.f));
+    GHAssertTrue(floateq(difference3.v1, -2.f) && floateq(difference3.v2, 0.f) && floateq(difference3.v3, 2.f), @"Subtract");
+    
+    HLSVector4 scaled4 = HLSVector4Scale(HLSVector4Make(1.f, -2.f, 3.f, 0.f), -2.f);
+    GHAssertTrue(floateq(scaled4.v1, -2.f) && floateq(scaled4.v2, 4.f) && floateq(scaled4.v3, -6.f) && floateq(scaled4.v4, 0.f), @"Scale");
+    
+    HLSVector3 reciprocal3 = HLSVector3Reciprocal(HLSVector3Make(2.f, -4.f, 1.f));
+    GHAssertTrue(floateq(reciprocal3.v1, 0.5f) && floateq(reciprocal3.v2, -0.25f) && floateq(reciprocal3.v3, 1.f), @"Reciprocal");
+}
+
+- (void)testDotProduct
+{
+    GHAssertTrue(floateq(HLSVector2Dot(HLSVector2Make(1.f, 0.f), HLSVector2Make(0.f, 1.f)), 0.f), @"Orthogonal");
+    GHAssertTrue(floateq(HLSVector3Dot(HLSVector3Make(1.f, 2.f, 3.f), HLSVector3Make(4.f, 5.f, 6.f)), 32.f), @"Dot");
+    GHAssertTrue(floateq(HLSVector4Dot(HLSVector4Make(1.f, 1.f, 1.f, 1.f), HLSVector4Make(1.f, 2.f, 3.f, 4.f)), 10.f), @"Dot");
+}
+
+- (void)testLerp
+{
+    HLSVector2 from2 = HLSVector2Make(0.f, 10.f);
+    HLSVector2 to2 = HLSVector2Make(10.f, -10.f);
+    
+    HLSVector2 start2 = HLSVector2Lerp(from2, to2, 0.f);
+    GHAssertTrue(floateq(start2.v1, 0.f) && floateq(start2.v2, 10.f), @"Start");
+    
+    HLSVector2 middle2 = HLSVector2Lerp(from2, to2, 0.5f);
+    GHAssertTrue(floateq(middle2.v1, 5.f) && floateq(middle2.v2, 0.f), @"Middle");
+    
+    HLSVector2 end2 = HLSVector2Lerp(from2, to2, 1.f);
+    GHAssertTrue(floateq(end2.v1, 10.f) && floateq(end2.v2, -10.f), @"End");
+}
+
+@end
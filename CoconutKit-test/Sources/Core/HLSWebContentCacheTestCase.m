@@ -0,0 +1,155 @@
+//
+//  HLSWebContentCacheTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSWebContentCacheTestCase.h"
+
+static NSString * const kTestHost = @"hlswebcontentcache.test";
+
+static NSUInteger s_nbrServedRequests = 0;
+
+/**
+ * Serve cacheable pages for the test host, without any network access
+ */
+@interface WebContentCacheTestURLProtocol : NSURLProtocol
+
+@end
+
+@implementation HLSWebContentCacheTestCase
+
+#pragma mark Tests
+
+- (void)testHitsAndMisses
+{
+    HLSWebContentCache *cache = [[[HLSWebContentCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                       diskCapacity:0
+                                                                           diskPath:nil] autorelease];
+    
+    NSURL *URL = [NSURL URLWithString:@"http://www.hortis.ch/help.html"];
+    NSURLRequest *request = [NSURLRequest requestWithURL:URL];
+    GHAssertNil([cache cachedResponseForRequest:request], @"Not cached");
+    GHAssertEquals(cache.missCount, (NSUInteger)1, @"Miss");
+    
+    NSURLResponse *response = [[[NSURLResponse alloc] initWithURL:URL
+                                                         MIMEType:@"text/html"
+                                            expectedContentLength:4
+                                                 textEncodingName:@"utf-8"] autorelease];
+    NSData *data = [@"help" dataUsingEncoding:NSUTF8StringEncoding];
+    NSCachedURLResponse *cachedResponse = [[[NSCachedURLResponse alloc] initWithResponse:response
+                                                                                    data:data
+                                                                                userInfo:nil
+                                                                           storagePolicy:NSURLCacheStorageAllowedInMemoryOnly] autorelease];
+    [cache storeCachedResponse:cachedResponse forRequest:request];
+    GHAssertEqualObjects([[cache cachedResponseForRequest:request] data], data, @"Cached");
+    GHAssertEquals(cache.hitCount, (NSUInteger)1, @"Hit");
+    GHAssertEquals(cache.missCount, (NSUInteger)1, @"Miss");
+    
+    [cache resetStatistics];
+    GHAssertEquals(cache.hitCount, (NSUInteger)0, @"Reset");
+    GHAssertEquals(cache.missCount, (NSUInteger)0, @"Reset");
+}
+
+- (void)testOfflineRequest
+{
+    HLSWebContentCache *cache = [[[HLSWebContentCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                       diskCapacity:0
+                                                                           diskPath:nil] autorelease];
+    NSURL *URL = [NSURL URLWithString:@"http://www.hortis.ch/terms.html"];
+    GHAssertNil([HLSWebContentCache offlineRequestForURL:URL inURLCache:cache timeoutInterval:10.], @"Not cached");
+    GHAssertNil([HLSWebContentCache offlineRequestForURL:nil inURLCache:cache timeoutInterval:10.], @"No URL");
+    
+    // Stale responses are used as well when offline
+    NSDictionary *headerFields = [NSDictionary dictionaryWithObject:@"max-age=0" forKey:@"Cache-Control"];
+    NSHTTPURLResponse *response = [[[NSHTTPURLResponse alloc] initWithURL:URL
+                                                               statusCode:200
+                                                              HTTPVersion:@"HTTP/1.1"
+                                                             headerFields:headerFields] autorelease];
+    NSData *data = [@"terms" dataUsingEncoding:NSUTF8StringEncoding];
+    NSCachedURLResponse *cachedResponse = [[[NSCachedURLResponse alloc] initWithResponse:response
+                                                                                    data:data
+                                                                                userInfo:nil
+                                                                           storagePolicy:NSURLCacheStorageAllowedInMemoryOnly] autorelease];
+    [cache storeCachedResponse:cachedResponse forRequest:[NSURLRequest requestWithURL:URL]];
+    
+    NSURLRequest *offlineRequest = [HLSWebContentCache offlineRequestForURL:URL inURLCache:cache timeoutInterval:10.];
+    GHAssertNotNil(offlineRequest, @"Stale response");
+    GHAssertEquals(offlineRequest.cachePolicy, NSURLRequestReturnCacheDataDontLoad, @"Cache only");
+    GHAssertEqualObjects([[cache cachedResponseForRequest:offlineRequest] data], data, @"Cached data");
+}
+
+- (void)testPrefetch
+{
+    HLSWebContentCache *cache = [[[HLSWebContentCache alloc] initWithMemoryCapacity:1024 * 1024
+                                                                       diskCapacity:0
+                                                                           diskPath:nil] autorelease];
+    
+    // Prefetched responses are stored in the shared URL cache
+    NSURLCache *previousURLCache = [[[NSURLCache sharedURLCache] retain] autorelease];
+    [cache install];
+    GHAssertEquals([NSURLCache sharedURLCache], (NSURLCache *)cache, @"Installed");
+    
+    [NSURLProtocol registerClass:[WebContentCacheTestURLProtocol class]];
+    s_nbrServedRequests = 0;
+    
+    NSURL *URL1 = [NSURL URLWithString:[NSString stringWithFormat:@"http://%@/help.html", kTestHost]];
+    NSURL *URL2 = [NSURL URLWithString:[NSString stringWithFormat:@"http://%@/terms.html", kTestHost]];
+    [cache prefetchURLs:[NSArray arrayWithObjects:URL1, URL2, URL1, nil]];
+    
+    // Prefetching only occurs in the default run loop mode
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && s_nbrServedRequests != 2) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+    
+    // Duplicate URLs are prefetched once
+    GHAssertEquals(s_nbrServedRequests, (NSUInteger)2, @"Served requests");
+    GHAssertNotNil([cache cachedResponseForRequest:[NSURLRequest requestWithURL:URL1]], @"Prefetched");
+    GHAssertNotNil([cache cachedResponseForRequest:[NSURLRequest requestWithURL:URL2]], @"Prefetched");
+    
+    [cache cancelPrefetches];
+    [NSURLProtocol unregisterClass:[WebContentCacheTestURLProtocol class]];
+    [NSURLCache setSharedURLCache:previousURLCache];
+}
+
+@end
+
+@implementation WebContentCacheTestURLProtocol
+
+#pragma mark Class methods
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return [[[request URL] host] isEqualToString:kTestHost];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+#pragma mark Loading
+
+- (void)startLoading
+{
+    ++s_nbrServedRequests;
+    
+    NSDictionary *headerFields = [NSDictionary dictionaryWithObjectsAndKeys:@"text/html", @"Content-Type",
+                                  @"max-age=3600", @"Cache-Control", nil];
+    NSHTTPURLResponse *response = [[[NSHTTPURLResponse alloc] initWithURL:[self.request URL]
+                                                               statusCode:200
+                                                              HTTPVersion:@"HTTP/1.1"
+                                                             headerFields:headerFields] autorelease];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageAllowed];
+    [self.client URLProtocol:self didLoadData:[[[self.request URL] absoluteString] dataUsingEncoding:NSUTF8StringEncoding]];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading
+{}
+
+@end
@@ -12,6 +12,17 @@
 
 @end
 
+@interface ZeroingWeakRefOwner : NSObject {
+@private
+    HLSZeroingWeakRef *m_zeroingWeakRef;
+}
+
+@property (nonatomic, retain) HLSZeroingWeakRef *zeroingWeakRef;
+
+- (void)releaseZeroingWeakRef;
+
+@end
+
 @implementation HLSZeroingWeakRefTestCase
 
 #pragma mark Tests
@@ -25,6 +36,74 @@
     GHAssertNil(zeroingWeakRef.object, @"Zeroed object reference");
 }
 
+- (void)testMultipleReferences
+{
+    BasicClass *basicClass = [[BasicClass alloc] init];
+    HLSZeroingWeakRef *zeroingWeakRef1 = [[[HLSZeroingWeakRef alloc] initWithObject:basicClass] autorelease];
+    HLSZeroingWeakRef *zeroingWeakRef2 = [[HLSZeroingWeakRef alloc] initWithObject:basicClass];
+    HLSZeroingWeakRef *zeroingWeakRef3 = [[[HLSZeroingWeakRef alloc] initWithObject:basicClass] autorelease];
+    
+    // Releasing a reference does not affect the others
+    [zeroingWeakRef2 release];
+    GHAssertEquals(zeroingWeakRef1.object, basicClass, @"Non-zeroed object reference");
+    GHAssertEquals(zeroingWeakRef3.object, basicClass, @"Non-zeroed object reference");
+    
+    [basicClass release];
+    GHAssertNil(zeroingWeakRef1.object, @"Zeroed object reference");
+    GHAssertNil(zeroingWeakRef3.object, @"Zeroed object reference");
+}
+
+- (void)testManyReferences
+{
+    // More references than can be stored inline
+    BasicClass *basicClass = [[BasicClass alloc] init];
+    NSMutableArray *zeroingWeakRefs = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 20; ++i) {
+        HLSZeroingWeakRef *zeroingWeakRef = [[[HLSZeroingWeakRef alloc] initWithObject:basicClass] autorelease];
+        [zeroingWeakRefs addObject:zeroingWeakRef];
+    }
+    [zeroingWeakRefs removeObjectsInRange:NSMakeRange(0, 5)];
+    
+    [basicClass release];
+    for (HLSZeroingWeakRef *zeroingWeakRef in zeroingWeakRefs) {
+        GHAssertNil(zeroingWeakRef.object, @"Zeroed object reference");
+    }
+}
+
+- (void)testClassPreserved
+{
+    BasicClass *basicClass = [[BasicClass alloc] init];
+    HLSZeroingWeakRef *zeroingWeakRef = [[[HLSZeroingWeakRef alloc] initWithObject:basicClass] autorelease];
+    GHAssertEquals(object_getClass(basicClass), [BasicClass class], @"Real class");
+    GHAssertEquals([basicClass class], [BasicClass class], @"Class");
+    [basicClass release];
+    GHAssertNil(zeroingWeakRef.object, @"Zeroed object reference");
+    
+    // Instances of an already hooked class only zero their own references
+    BasicClass *otherBasicClass1 = [[BasicClass alloc] init];
+    BasicClass *otherBasicClass2 = [[BasicClass alloc] init];
+    HLSZeroingWeakRef *otherZeroingWeakRef = [[[HLSZeroingWeakRef alloc] initWithObject:otherBasicClass2] autorelease];
+    [otherBasicClass1 release];
+    GHAssertEquals(otherZeroingWeakRef.object, otherBasicClass2, @"Non-zeroed object reference");
+    [otherBasicClass2 release];
+    GHAssertNil(otherZeroingWeakRef.object, @"Zeroed object reference");
+}
+
+- (void)testCleanupActionReleasingReference
+{
+    BasicClass *basicClass = [[BasicClass alloc] init];
+    ZeroingWeakRefOwner *owner = [[[ZeroingWeakRefOwner alloc] init] autorelease];
+    
+    // The owner holds the only reference to the zeroing weak reference, and releases it when cleaning up
+    HLSZeroingWeakRef *zeroingWeakRef = [[HLSZeroingWeakRef alloc] initWithObject:basicClass];
+    [zeroingWeakRef addCleanupAction:@selector(releaseZeroingWeakRef) onTarget:owner];
+    owner.zeroingWeakRef = zeroingWeakRef;
+    [zeroingWeakRef release];
+    
+    [basicClass release];
+    GHAssertNil(owner.zeroingWeakRef, @"Zeroing weak reference released by the cleanup action");
+}
+
 - (void)testTollFreeBridgedObject
 {
     NSNumber *number = [[NSNumber alloc] initWithInt:1012];
@@ -37,3 +116,21 @@
 @implementation BasicClass
 
 @end
+
+@implementation ZeroingWeakRefOwner
+
+- (void)dealloc
+{
+    self.zeroingWeakRef = nil;
+    
+    [super dealloc];
+}
+
+@synthesize zeroingWeakRef = m_zeroingWeakRef;
+
+- (void)releaseZeroingWeakRef
+{
+    self.zeroingWeakRef = nil;
+}
+
+@end
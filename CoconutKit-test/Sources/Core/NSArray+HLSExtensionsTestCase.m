@@ -32,6 +32,85 @@
     NSArray *rightArray = [array arrayByRightRotatingNumberOfObjects:2];
     NSArray *expectedRightArray = [NSArray arrayWithObjects:@"2", @"3", @"1", nil];
     GHAssertTrue([rightArray isEqualToArray:expectedRightArray], @"right");
+    
+    // Rotated arrays can themselves be rotated
+    NSArray *leftRightArray = [leftArray arrayByRightRotatingNumberOfObjects:2];
+    GHAssertTrue([leftRightArray isEqualToArray:array], @"left then right");
+    NSArray *leftLeftArray = [leftArray arrayByLeftRotatingNumberOfObjects:4];
+    NSArray *expectedLeftLeftArray = [NSArray arrayWithObjects:@"1", @"2", @"3", nil];
+    GHAssertTrue([leftLeftArray isEqualToArray:expectedLeftLeftArray], @"left then left");
+    
+    // Fast enumeration
+    NSMutableArray *enumeratedObjects = [NSMutableArray array];
+    for (NSString *object in leftArray) {
+        [enumeratedObjects addObject:object];
+    }
+    GHAssertTrue([enumeratedObjects isEqualToArray:expectedLeftArray], @"enumeration");
+    
+    // Mutable arrays changed after rotation
+    NSMutableArray *mutableArray = [NSMutableArray arrayWithArray:array];
+    NSArray *leftMutableArray = [mutableArray arrayByLeftRotatingNumberOfObjects:1];
+    [mutableArray removeAllObjects];
+    GHAssertEquals([leftMutableArray count], 3U, @"mutable");
+    
+    // Materialization
+    NSArray *materializedArray = [leftArray arrayByMaterializingObjects];
+    GHAssertTrue([materializedArray isEqualToArray:expectedLeftArray], @"materialization");
+    
+    // Empty arrays
+    GHAssertEquals([[[NSArray array] arrayByLeftRotatingNumberOfObjects:2] count], 0U, @"empty");
+}
+
+- (void)testSortWithDescriptor
+{
+    // Large enough to be sorted in parallel, with duplicate keys to check stability
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10000; ++i) {
+        NSDictionary *object = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:arc4random() % 1000], @"value",
+                                [NSNumber numberWithUnsignedInteger:i], @"index", nil];
+        [array addObject:object];
+    }
+    
+    for (NSUInteger i = 0; i < 2; ++i) {
+        BOOL ascending = (i == 0);
+        NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"value" ascending:ascending];
+        NSArray *sortedArray = [array sortedArrayUsingDescriptor:sortDescriptor];
+        GHAssertEquals([sortedArray count], [array count], @"count");
+        
+        for (NSUInteger j = 1; j < [sortedArray count]; ++j) {
+            NSDictionary *previousObject = [sortedArray objectAtIndex:j - 1];
+            NSDictionary *object = [sortedArray objectAtIndex:j];
+            NSComparisonResult result = [[previousObject objectForKey:@"value"] compare:[object objectForKey:@"value"]];
+            GHAssertTrue(ascending ? result != NSOrderedDescending : result != NSOrderedAscending, @"order");
+            if (result == NSOrderedSame) {
+                GHAssertTrue([[previousObject objectForKey:@"index"] compare:[object objectForKey:@"index"]] == NSOrderedAscending, @"stability");
+            }
+        }
+    }
+    
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"value" ascending:YES];
+    NSArray *sortedArray = [[NSSet setWithArray:array] sortedArrayUsingDescriptor:sortDescriptor];
+    GHAssertEquals([sortedArray count], [array count], @"set");
+}
+
+- (void)testSortWithDescriptorAndNilValues
+{
+    // Large enough to be sorted in parallel. Every third object has no value
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10000; ++i) {
+        NSDictionary *object = (i % 3 == 0) ? [NSDictionary dictionary] 
+            : [NSDictionary dictionaryWithObject:[NSNumber numberWithUnsignedInteger:arc4random() % 1000] forKey:@"value"];
+        [array addObject:object];
+    }
+    
+    // As with NSSortDescriptor, nil values are sorted first in ascending order, last in descending order
+    for (NSUInteger i = 0; i < 2; ++i) {
+        BOOL ascending = (i == 0);
+        NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"value" ascending:ascending];
+        NSArray *sortedArray = [array sortedArrayUsingDescriptor:sortDescriptor];
+        NSArray *expectedArray = [array sortedArrayUsingDescriptors:[NSArray arrayWithObject:sortDescriptor]];
+        GHAssertEqualObjects([sortedArray valueForKey:@"value"], [expectedArray valueForKey:@"value"], @"nil values");
+    }
 }
 
 - (void)testSafeInsert
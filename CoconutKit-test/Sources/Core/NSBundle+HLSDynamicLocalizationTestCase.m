@@ -0,0 +1,120 @@
+//
+//  NSBundle+HLSDynamicLocalizationTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "NSBundle+HLSDynamicLocalizationTestCase.h"
+
+#import "TestLocalizedBundles.h"
+
+@implementation NSBundle_HLSDynamicLocalizationTestCase
+
+#pragma mark Test setup and tear down
+
+- (void)setUpClass
+{
+    [super setUpClass];
+    
+    // Dynamic localization is only enabled once a localization has been set
+    [NSBundle setLocalization:[NSBundle localization]];
+}
+
+#pragma mark Tests
+
+- (void)testLocalizedStrings
+{
+    NSDictionary *localizableStrings = [NSDictionary dictionaryWithObjectsAndKeys:@"Valeur", @"Key", nil];
+    NSDictionary *otherStrings = [NSDictionary dictionaryWithObjectsAndKeys:@"Autre valeur", @"Key", nil];
+    NSDictionary *tables = [NSDictionary dictionaryWithObjectsAndKeys:localizableStrings, @"Localizable",
+                            otherStrings, @"Other", nil];
+    
+    for (NSUInteger i = 0; i < 2; ++i) {
+        BOOL precompiled = (i == 1);
+        NSString *bundleName = precompiled ? @"DynamicLocalizationPrecompiled" : @"DynamicLocalizationStrings";
+        NSBundle *bundle = TestLocalizedBundle(bundleName, tables, precompiled);
+        GHAssertNotNil(bundle, @"Bundle");
+        
+        // Looked up twice, so that cached tables are tested as well
+        for (NSUInteger j = 0; j < 2; ++j) {
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:nil table:nil], @"Valeur", @"Default table");
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:nil table:@"Localizable"], @"Valeur", @"Explicit table");
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:nil table:@"Other"], @"Autre valeur", @"Other table");
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Missing" value:@"Default" table:nil], @"Default", @"Missing key with value");
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Missing" value:nil table:nil], @"Missing", @"Missing key without value");
+            GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:@"Default" table:@"Unknown"], @"Default", @"Missing table");
+            GHAssertNil([bundle localizedStringForKey:nil value:nil table:nil], @"nil key");
+        }
+        
+        TestRemoveLocalizedBundle(bundle);
+    }
+}
+
+- (void)testTablesSurviveMemoryWarnings
+{
+    NSDictionary *tables = [NSDictionary dictionaryWithObject:[NSDictionary dictionaryWithObject:@"Valeur" forKey:@"Key"]
+                                                       forKey:@"Localizable"];
+    NSBundle *bundle = TestLocalizedBundle(@"DynamicLocalizationMemoryWarning", tables, NO);
+    GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:nil table:nil], @"Valeur", nil);
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    GHAssertEqualStrings([bundle localizedStringForKey:@"Key" value:nil table:nil], @"Valeur", nil);
+    
+    TestRemoveLocalizedBundle(bundle);
+}
+
+- (void)testMissingLocalizationsReport
+{
+    NSDictionary *tables = [NSDictionary dictionaryWithObject:[NSDictionary dictionaryWithObject:@"Valeur" forKey:@"Key"]
+                                                       forKey:@"Localizable"];
+    NSBundle *bundle = TestLocalizedBundle(@"DynamicLocalizationMissing", tables, NO);
+    
+    NSUserDefaults *userDefaults = [NSUserDefaults standardUserDefaults];
+    BOOL showNonLocalizedStrings = [userDefaults boolForKey:@"NSShowNonLocalizedStrings"];
+    [userDefaults setBool:YES forKey:@"NSShowNonLocalizedStrings"];
+    [NSBundle resetMissingLocalizations];
+    
+    GHAssertEqualStrings([bundle localizedStringForKey:@"Missing" value:nil table:nil], @"MISSING", @"Missing strings are revealed");
+    [bundle localizedStringForKey:@"Missing" value:nil table:nil];
+    [bundle localizedStringForKey:@"Key" value:nil table:nil];
+    [bundle localizedStringForKey:@"Another" value:nil table:@"Localizable"];
+    GHAssertEqualStrings([NSBundle missingLocalizationsReport], 
+                         @"DynamicLocalizationMissing.bundle\tLocalizable\tAnother\nDynamicLocalizationMissing.bundle\tLocalizable\tMissing", 
+                         @"Each missing string reported once");
+    
+    [NSBundle resetMissingLocalizations];
+    GHAssertEqualStrings([NSBundle missingLocalizationsReport], @"", @"Reset");
+    
+    [userDefaults setBool:showNonLocalizedStrings forKey:@"NSShowNonLocalizedStrings"];
+    TestRemoveLocalizedBundle(bundle);
+}
+
+- (void)testConcurrentLookups
+{
+    NSMutableDictionary *strings = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        [strings setObject:[NSString stringWithFormat:@"Valeur %d", i] forKey:[NSString stringWithFormat:@"Key %d", i]];
+    }
+    NSBundle *bundle = TestLocalizedBundle(@"DynamicLocalizationConcurrent", [NSDictionary dictionaryWithObject:strings forKey:@"Localizable"], NO);
+    
+    __block NSUInteger nbrFailures = 0;
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            NSString *key = [NSString stringWithFormat:@"Key %d", i % 100];
+            if (! [[bundle localizedStringForKey:key value:nil table:nil] isEqualToString:[strings objectForKey:key]]) {
+                @synchronized(self) {
+                    ++nbrFailures;
+                }
+            }
+        }
+        [pool drain];
+    });
+    GHAssertEquals(nbrFailures, (NSUInteger)0, @"All concurrent lookups must succeed");
+    
+    TestRemoveLocalizedBundle(bundle);
+}
+
+@end
@@ -913,4 +913,34 @@
     GHAssertTrue([self.calendar compareDaysBetweenDate:self.date2 andDate:otherDateTahiti2 inTimeZone:self.timeZoneTahiti] == NSOrderedSame, @"Day");
 }
 
+- (void)testDayArithmeticAroundCurrentDate
+{
+    // Dates close to the current date are handled using time zone offset tables. Check results against calculations
+    // made using date components, every 5 hours over two years (DST transitions are crossed)
+    NSCalendar *gregorianCalendar = [[[NSCalendar alloc] initWithCalendarIdentifier:NSGregorianCalendar] autorelease];
+    NSUInteger unitFlags = NSYearCalendarUnit | NSMonthCalendarUnit | NSDayCalendarUnit;
+    NSArray *timeZones = [NSArray arrayWithObjects:self.timeZoneZurich, self.timeZoneTahiti, nil];
+    for (NSTimeZone *timeZone in timeZones) {
+        NSDate *referenceDate = [NSDate date];
+        NSDateComponents *referenceDateComponents = [gregorianCalendar components:unitFlags fromDate:referenceDate inTimeZone:timeZone];
+        for (NSInteger i = -24 * 365 / 5; i < 24 * 365 / 5; ++i) {
+            NSDate *date = [referenceDate dateByAddingTimeInterval:i * 5. * 60. * 60.];
+            NSDateComponents *dateComponents = [gregorianCalendar components:unitFlags fromDate:date inTimeZone:timeZone];
+            
+            [dateComponents setHour:12];
+            NSDate *expectedNoonDate = [gregorianCalendar dateFromComponents:dateComponents inTimeZone:timeZone];
+            GHAssertEqualObjects([gregorianCalendar dateAtNoonTheSameDayAsDate:date inTimeZone:timeZone], expectedNoonDate, 
+                                 @"Noon for %@ in %@", date, [timeZone name]);
+            
+            BOOL expectedSameDay = [dateComponents year] == [referenceDateComponents year]
+                && [dateComponents month] == [referenceDateComponents month]
+                && [dateComponents day] == [referenceDateComponents day];
+            GHAssertEquals([gregorianCalendar isDate:date theSameDayAsDate:referenceDate inTimeZone:timeZone], expectedSameDay, 
+                           @"Same day for %@ in %@", date, [timeZone name]);
+            GHAssertTrue([gregorianCalendar compareDaysBetweenDate:date andDate:expectedNoonDate inTimeZone:timeZone] == NSOrderedSame, 
+                         @"Same day as noon for %@ in %@", date, [timeZone name]);
+        }
+    }
+}
+
 @end
@@ -26,4 +26,17 @@
     GHAssertEqualStrings([testData sha512hash], @"374d794a95cdcfd8b35993185fef9ba368f160d8daf432d08ba9f1ed1e5abe6cc69291e0fa2fe0006a52570ef18c19def4e617c33ce52ef0a6e5fbe318cb0387", @"sha512");
 }
 
+- (void)testRawDigest
+{
+    NSData *testData = [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    NSData *digest = [testData digestWithAlgorithm:HLSDigestAlgorithmSHA1];
+    GHAssertEquals([digest length], (NSUInteger)20, @"sha1 length");
+    GHAssertEqualStrings(HLSHexadecimalStringFromBytes([digest bytes], [digest length]), [testData sha1hash], @"sha1");
+    
+    const unsigned char bytes[] = {0x00, 0x0f, 0xa5, 0xff};
+    GHAssertEqualStrings(HLSHexadecimalStringFromBytes(bytes, sizeof(bytes)), @"000fa5ff", @"Hexadecimal string");
+    GHAssertEqualStrings(HLSHexadecimalStringFromBytes(NULL, 0), @"", @"Empty hexadecimal string");
+}
+
 @end
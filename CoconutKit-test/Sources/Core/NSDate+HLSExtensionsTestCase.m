@@ -32,4 +32,24 @@
     GHAssertTrue([date1 isLaterThanOrEqualToDate:date1], @"Later date");
 }
 
+- (void)testDescription
+{
+    NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:100000.];
+    GHAssertTrue([[date description] hasPrefix:@"2001-01-02 03:46:40 +0000 (system time zone: "], nil);
+    
+    // Must match what a formatter yields for the default time zone
+    NSDateFormatter *dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
+    [dateFormatter setLocale:[[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"] autorelease]];
+    [dateFormatter setTimeZone:[NSTimeZone defaultTimeZone]];
+    [dateFormatter setDateFormat:@"yyyy'-'MM'-'dd' 'HH':'mm':'ss' 'ZZZ"];
+    NSString *expectedSuffix = [NSString stringWithFormat:@"(system time zone: %@)", [dateFormatter stringFromDate:date]];
+    GHAssertTrue([[date description] hasSuffix:expectedSuffix], nil);
+    
+    // Dates outside the range of a 32-bit time_t
+    NSDate *pastDate = [NSDate dateWithTimeIntervalSince1970:-2208988801.];
+    GHAssertTrue([[pastDate description] hasPrefix:@"1899-12-31 23:59:59 +0000 (system time zone: "], nil);
+    NSDate *futureDate = [NSDate dateWithTimeIntervalSince1970:4107542400.];
+    GHAssertTrue([[futureDate description] hasPrefix:@"2100-03-01 00:00:00 +0000 (system time zone: "], nil);
+}
+
 @end
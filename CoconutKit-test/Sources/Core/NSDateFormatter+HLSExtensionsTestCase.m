@@ -0,0 +1,48 @@
+//
+//  NSDateFormatter+HLSExtensionsTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "NSDateFormatter+HLSExtensionsTestCase.h"
+
+@implementation NSDateFormatter_HLSExtensionsTestCase
+
+#pragma mark Tests
+
+- (void)testDateFormatterPool
+{
+    NSLocale *locale = [[[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"] autorelease];
+    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"Europe/Zurich"];
+    NSDateFormatter *dateFormatter = [NSDateFormatter dateFormatterWithFormat:@"yyyy-MM-dd HH:mm" locale:locale timeZone:timeZone];
+    GHAssertEqualStrings([dateFormatter dateFormat], @"yyyy-MM-dd HH:mm", @"Format");
+    GHAssertEqualStrings([[dateFormatter timeZone] name], @"Europe/Zurich", @"Time zone");
+    
+    // 2012-01-01 08:23:00 in Zurich
+    NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:347181780.];
+    GHAssertEqualStrings([dateFormatter stringFromDate:date], @"2012-01-01 08:23", @"Formatting");
+    GHAssertEqualObjects([dateFormatter dateFromString:@"2012-01-01 08:23"], date, @"Parsing");
+    
+    // Same settings: Reused on the same thread
+    GHAssertEquals([NSDateFormatter dateFormatterWithFormat:@"yyyy-MM-dd HH:mm" locale:locale timeZone:timeZone], dateFormatter, 
+                   @"Reused");
+    GHAssertNotEquals([NSDateFormatter dateFormatterWithFormat:@"yyyy-MM-dd" locale:locale timeZone:timeZone], dateFormatter, 
+                      @"Different format");
+    GHAssertNotEquals([NSDateFormatter dateFormatterWithFormat:@"yyyy-MM-dd HH:mm" locale:locale timeZone:[NSTimeZone timeZoneWithName:@"Pacific/Tahiti"]], 
+                      dateFormatter, @"Different time zone");
+    
+    // Other threads get their own formatter
+    __block NSDateFormatter *otherThreadDateFormatter = nil;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        otherThreadDateFormatter = [NSDateFormatter dateFormatterWithFormat:@"yyyy-MM-dd HH:mm" locale:locale timeZone:timeZone];
+        dispatch_semaphore_signal(semaphore);
+    });
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    dispatch_release(semaphore);
+    GHAssertTrue(otherThreadDateFormatter != dateFormatter, @"Thread-local formatter");
+}
+
+@end
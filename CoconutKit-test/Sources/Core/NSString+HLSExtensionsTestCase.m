@@ -45,6 +45,30 @@
     GHAssertEqualStrings([@"1.0+test" friendlyVersionNumber], @"1.0+test", @"version number");
 }
 
+- (void)testFontSize
+{
+    NSString *text = @"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore";
+    UIFont *font = [UIFont systemFontOfSize:30.f];
+    
+    CGFloat fontSize = [text fontSizeWithFont:font constrainedToSize:CGSizeMake(200.f, 60.f) minFontSize:8.f numberOfLines:3];
+    GHAssertTrue(fontSize >= 8.f && fontSize < 30.f, @"Reduced font size");
+    
+    // The largest fitting font size is returned
+    UIFont *fittingFont = [UIFont fontWithName:font.fontName size:fontSize];
+    CGFloat height = [text sizeWithFont:fittingFont constrainedToSize:CGSizeMake(200.f, FLT_MAX) lineBreakMode:UILineBreakModeWordWrap].height;
+    GHAssertTrue(floatle(height, 60.f), @"Fits");
+    UIFont *largerFont = [UIFont fontWithName:font.fontName size:fontSize + 1.f];
+    CGFloat largerHeight = [text sizeWithFont:largerFont constrainedToSize:CGSizeMake(200.f, FLT_MAX) lineBreakMode:UILineBreakModeWordWrap].height;
+    GHAssertTrue(floatgt(largerHeight, 60.f) || largerHeight / [text sizeWithFont:largerFont].height > 3.f, @"Largest");
+    
+    // Cached
+    GHAssertEquals([text fontSizeWithFont:font constrainedToSize:CGSizeMake(200.f, 60.f) minFontSize:8.f numberOfLines:3], fontSize, @"Cached");
+    
+    // Fits without reduction, or does not fit at all
+    GHAssertEquals([@"A" fontSizeWithFont:font constrainedToSize:CGSizeMake(200.f, 60.f) minFontSize:8.f numberOfLines:1], 30.f, @"No reduction");
+    GHAssertEquals([text fontSizeWithFont:font constrainedToSize:CGSizeMake(20.f, 10.f) minFontSize:8.f numberOfLines:1], 8.f, @"Minimum");
+}
+
 - (void)testURLEncoding
 {
     NSMutableString *string = [NSMutableString string];
@@ -55,4 +79,24 @@
     GHAssertEqualStrings([string urlEncodedStringUsingEncoding:NSUTF8StringEncoding], encodedStringReference, @"urlEncodedStringUsingEncoding");
 }
 
+- (void)testURLEncodingWithoutEscaping
+{
+    NSString *string = @"abc-DEF_123.~";
+    GHAssertEqualStrings([string urlEncodedStringUsingEncoding:NSUTF8StringEncoding], string, @"Nothing to escape");
+    GHAssertEqualStrings([@"" urlEncodedStringUsingEncoding:NSUTF8StringEncoding], @"", @"Empty string");
+    GHAssertEqualStrings([@"é" urlEncodedStringUsingEncoding:NSISOLatin1StringEncoding], @"%E9", @"Latin-1");
+    GHAssertNil([@"€" urlEncodedStringUsingEncoding:NSASCIIStringEncoding], @"Not representable");
+}
+
+- (void)testURLEncodedQueryString
+{
+    NSDictionary *parameters = [NSDictionary dictionaryWithObjectsAndKeys:@"a b", @"query",
+                                [NSNumber numberWithInt:20], @"count",
+                                @"x&y=z", @"filter", nil];
+    GHAssertEqualStrings([NSString urlEncodedQueryStringWithParameters:parameters encoding:NSUTF8StringEncoding], 
+                         @"count=20&filter=x%26y%3Dz&query=a%20b", @"Query string");
+    GHAssertEqualStrings([NSString urlEncodedQueryStringWithParameters:[NSDictionary dictionary] encoding:NSUTF8StringEncoding], 
+                         @"", @"Empty query string");
+}
+
 @end
@@ -107,6 +107,20 @@
     GHAssertEquals([self.timeZoneZurich offsetFromTimeZone:self.timeZoneTahiti forDate:self.date5], 12. * 60. * 60., @"Incorrect offset");
 }
 
+- (void)testOffsetsOverLongPeriods
+{
+    // Dates spread over several decades, crossing the boundaries of the cached offset tables back and forth
+    for (NSInteger i = -200; i <= 200; ++i) {
+        NSDate *date = [self.date1 dateByAddingTimeInterval:i * 11. * 24. * 60. * 60. * 7.];
+        NSTimeInterval expectedOffset = [self.timeZoneZurich secondsFromGMTForDate:date] - [self.timeZoneTahiti secondsFromGMTForDate:date];
+        GHAssertEquals([self.timeZoneZurich offsetFromTimeZone:self.timeZoneTahiti forDate:date], expectedOffset, @"Incorrect offset");
+        
+        NSDate *otherDate = [self.date1 dateByAddingTimeInterval:-i * 13. * 24. * 60. * 60. * 5.];
+        NSTimeInterval expectedOtherOffset = [self.timeZoneTahiti secondsFromGMTForDate:otherDate] - [self.timeZoneZurich secondsFromGMTForDate:otherDate];
+        GHAssertEquals([self.timeZoneTahiti offsetFromTimeZone:self.timeZoneZurich forDate:otherDate], expectedOtherOffset, @"Incorrect offset");
+    }
+}
+
 - (void)testDateWithSameComponentsAsDatefromTimeZone
 {
     // To compare components, we cannot use CoconutKit methods (since they are ulitmately implemented using the methods we
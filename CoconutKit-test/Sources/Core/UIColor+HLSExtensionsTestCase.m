@@ -0,0 +1,56 @@
+//
+//  UIColor+HLSExtensionsTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "UIColor+HLSExtensionsTestCase.h"
+
+@implementation UIColor_HLSExtensionsTestCase
+
+#pragma mark Tests
+
+- (void)testComponents
+{
+    UIColor *color = [UIColor colorWithRed:1.f green:0.5f blue:0.f alpha:0.25f];
+    CGFloat red, green, blue, alpha;
+    GHAssertTrue([color getNormalizedRed:&red green:&green blue:&blue alpha:&alpha], @"RGB color");
+    GHAssertTrue(floateq(red, 1.f), @"Red");
+    GHAssertTrue(floateq(green, 0.5f), @"Green");
+    GHAssertTrue(floateq(blue, 0.f), @"Blue");
+    GHAssertTrue(floateq(alpha, 0.25f), @"Alpha");
+    GHAssertEquals([color redComponent], (NSUInteger)255, @"Red");
+    GHAssertEquals([color greenComponent], (NSUInteger)128, @"Green");
+    GHAssertEquals([color blueComponent], (NSUInteger)0, @"Blue");
+    
+    UIColor *grayColor = [UIColor colorWithWhite:0.5f alpha:1.f];
+    GHAssertTrue([grayColor getNormalizedRed:&red green:&green blue:NULL alpha:&alpha], @"Grayscale color");
+    GHAssertTrue(floateq(red, 0.5f), @"Red");
+    GHAssertTrue(floateq(green, 0.5f), @"Green");
+    GHAssertTrue(floateq(alpha, 1.f), @"Alpha");
+    GHAssertTrue(floateq([grayColor normalizedBlueComponent], 0.5f), @"Blue");
+    
+    UIColor *patternColor = [UIColor groupTableViewBackgroundColor];
+    GHAssertFalse([patternColor getNormalizedRed:&red green:&green blue:&blue alpha:&alpha], @"Pattern color");
+    GHAssertEquals([patternColor invertedColor], patternColor, @"Pattern color cannot be inverted");
+}
+
+- (void)testInvertedColor
+{
+    UIColor *color = [UIColor colorWithRed:1.f green:0.5f blue:0.f alpha:0.25f];
+    UIColor *invertedColor = [color invertedColor];
+    CGFloat red, green, blue, alpha;
+    GHAssertTrue([invertedColor getNormalizedRed:&red green:&green blue:&blue alpha:&alpha], @"RGB color");
+    GHAssertTrue(floateq(red, 0.f), @"Red");
+    GHAssertTrue(floateq(green, 0.5f), @"Green");
+    GHAssertTrue(floateq(blue, 1.f), @"Blue");
+    GHAssertTrue(floateq(alpha, 0.25f), @"Alpha");
+    GHAssertEquals([color invertedColor], invertedColor, @"Cached");
+    
+    UIColor *invertedBlackColor = [[UIColor blackColor] invertedColor];
+    GHAssertTrue(floateq([invertedBlackColor normalizedRedComponent], 1.f), @"Grayscale color");
+}
+
+@end
@@ -0,0 +1,14 @@
+//
+//  UIImage+HLSExtensionsTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface UIImage_HLSExtensionsTestCase : GHTestCase {
+@private
+    
+}
+
+@end
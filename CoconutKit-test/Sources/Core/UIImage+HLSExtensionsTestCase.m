@@ -0,0 +1,87 @@
+//
+//  UIImage+HLSExtensionsTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "UIImage+HLSExtensionsTestCase.h"
+
+// Static functions
+static NSData *HLSPNGDataWithPixelSize(CGSize pixelSize);
+
+@implementation UIImage_HLSExtensionsTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Completion blocks of asynchronous loads are called on the main thread
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testThumbnails
+{
+    NSData *data = HLSPNGDataWithPixelSize(CGSizeMake(400.f, 200.f));
+    CGFloat scale = [UIScreen mainScreen].scale;
+    
+    // The aspect ratio is preserved, the largest dimension being reduced to the maximum size
+    UIImage *thumbnailImage = [UIImage thumbnailImageWithData:data maxPixelSize:100.f];
+    GHAssertNotNil(thumbnailImage, @"Thumbnail");
+    GHAssertEquals(CGImageGetWidth(thumbnailImage.CGImage), (size_t)100, @"Width");
+    GHAssertEquals(CGImageGetHeight(thumbnailImage.CGImage), (size_t)50, @"Height");
+    GHAssertTrue(floateq(thumbnailImage.scale, scale), @"Scale");
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"thumbnail.png"];
+    GHAssertTrue([data writeToFile:path atomically:YES], @"Write");
+    UIImage *fileThumbnailImage = [UIImage thumbnailImageWithContentsOfFile:path maxPixelSize:80.f];
+    GHAssertEquals(CGImageGetWidth(fileThumbnailImage.CGImage), (size_t)80, @"Width");
+    GHAssertEquals(CGImageGetHeight(fileThumbnailImage.CGImage), (size_t)40, @"Height");
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    
+    GHAssertNil([UIImage thumbnailImageWithData:nil maxPixelSize:100.f], @"No data");
+    GHAssertNil([UIImage thumbnailImageWithData:[@"not an image" dataUsingEncoding:NSUTF8StringEncoding] maxPixelSize:100.f], @"Invalid data");
+    GHAssertNil([UIImage thumbnailImageWithContentsOfFile:path maxPixelSize:100.f], @"Missing file");
+}
+
+- (void)testAsynchronousThumbnails
+{
+    NSData *data = HLSPNGDataWithPixelSize(CGSizeMake(100.f, 300.f));
+    
+    __block UIImage *thumbnailImage = nil;
+    __block BOOL completed = NO;
+    __block BOOL completedOnMainThread = NO;
+    [UIImage loadThumbnailImageWithData:data maxPixelSize:60.f completionBlock:^(UIImage *image) {
+        completedOnMainThread = [NSThread isMainThread];
+        thumbnailImage = [image retain];
+        completed = YES;
+    }];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.];
+    while (! completed && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    GHAssertTrue(completed, @"Completion");
+    GHAssertTrue(completedOnMainThread, @"Main thread");
+    GHAssertEquals(CGImageGetWidth(thumbnailImage.CGImage), (size_t)20, @"Width");
+    GHAssertEquals(CGImageGetHeight(thumbnailImage.CGImage), (size_t)60, @"Height");
+    [thumbnailImage release];
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSData *HLSPNGDataWithPixelSize(CGSize pixelSize)
+{
+    UIGraphicsBeginImageContextWithOptions(pixelSize, YES, 1.f);
+    [[UIColor redColor] setFill];
+    UIRectFill(CGRectMake(0.f, 0.f, pixelSize.width, pixelSize.height));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return UIImagePNGRepresentation(image);
+}
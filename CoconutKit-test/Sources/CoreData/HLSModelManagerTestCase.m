@@ -0,0 +1,100 @@
+//
+//  HLSModelManagerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSModelManagerTestCase.h"
+
+#import "Person.h"
+
+@implementation HLSModelManagerTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Imports merge their changes into a context used on the main thread
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testBatchedImport
+{
+    HLSModelManager *modelManager = [HLSModelManager inMemoryModelManagerWithModelFileName:@"CoconutKitTestData"
+                                                                                  inBundle:nil
+                                                                             configuration:nil
+                                                                                   options:nil];
+    
+    NSMutableArray *names = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 25; ++i) {
+        [names addObject:[NSString stringWithFormat:@"Person %u", i]];
+    }
+    
+    // Count the batches saved by the import context, and the objects merged into the main context. Assertions cannot
+    // be made within blocks called outside the test method, record the results instead
+    __block NSUInteger nbrSaves = 0;
+    __block NSUInteger nbrMergedObjects = 0;
+    __block BOOL mergedOnMainThread = YES;
+    id saveObserver = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                        object:nil 
+                                                                         queue:nil 
+                                                                    usingBlock:^(NSNotification *notification) {
+                                                                        if ([notification object] != modelManager.managedObjectContext) {
+                                                                            ++nbrSaves;
+                                                                        }
+                                                                    }];
+    id changeObserver = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextObjectsDidChangeNotification
+                                                                          object:modelManager.managedObjectContext 
+                                                                           queue:nil 
+                                                                      usingBlock:^(NSNotification *notification) {
+                                                                          mergedOnMainThread = mergedOnMainThread && [NSThread isMainThread];
+                                                                          nbrMergedObjects += [[[notification userInfo] objectForKey:NSInsertedObjectsKey] count];
+                                                                      }];
+    
+    __block BOOL completed = NO;
+    __block BOOL completedOnMainThread = NO;
+    __block BOOL importedInCurrentContext = YES;
+    __block NSError *importError = nil;
+    [modelManager importObjects:names batchSize:10 importBlock:^(id object, NSManagedObjectContext *managedObjectContext) {
+        // The import model manager is the current one on the import thread
+        importedInCurrentContext = importedInCurrentContext && [HLSModelManager currentModelContext] == managedObjectContext;
+        
+        Person *person = [Person insert];
+        person.firstName = object;
+        person.lastName = @"Imported";
+    } completionBlock:^(NSError *error) {
+        completedOnMainThread = [NSThread isMainThread];
+        importError = [error retain];
+        completed = YES;
+    }];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10.];
+    while (! completed && [timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    [modelManager.managedObjectContext processPendingChanges];
+    [[NSNotificationCenter defaultCenter] removeObserver:saveObserver];
+    [[NSNotificationCenter defaultCenter] removeObserver:changeObserver];
+    
+    GHAssertTrue(completed, @"Completion");
+    GHAssertTrue(completedOnMainThread, @"Completion on the main thread");
+    GHAssertTrue(importedInCurrentContext, @"Current context");
+    GHAssertTrue(mergedOnMainThread, @"Merged on the main thread");
+    GHAssertNil(importError, @"No error");
+    [importError release];
+    
+    // Two full batches and a partial one
+    GHAssertEquals(nbrSaves, 3U, @"Batches");
+    GHAssertEquals(nbrMergedObjects, 25U, @"Merged objects");
+    
+    NSArray *persons = [Person allObjectsInManagedObjectContext:modelManager.managedObjectContext];
+    GHAssertEquals([persons count], 25U, @"Imported objects");
+    GHAssertEqualObjects([NSSet setWithArray:[persons valueForKey:@"firstName"]], [NSSet setWithArray:names], @"Names");
+}
+
+@end
@@ -0,0 +1,68 @@
+//
+//  HLSSQLiteStoreOptionsTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSSQLiteStoreOptionsTestCase.h"
+
+@implementation HLSSQLiteStoreOptionsTestCase
+
+#pragma mark Tests
+
+- (void)testDictionary
+{
+    HLSSQLiteStoreOptions *storeOptions = [[[HLSSQLiteStoreOptions alloc] init] autorelease];
+    NSDictionary *options = [storeOptions dictionary];
+    NSDictionary *pragmas = [options objectForKey:NSSQLitePragmasOption];
+    GHAssertEqualStrings([pragmas objectForKey:@"journal_mode"], @"WAL", nil);
+    GHAssertEqualStrings([pragmas objectForKey:@"synchronous"], @"NORMAL", nil);
+    GHAssertEqualStrings([pragmas objectForKey:@"cache_size"], @"4000", nil);
+    GHAssertTrue([[options objectForKey:NSMigratePersistentStoresAutomaticallyOption] boolValue], nil);
+    GHAssertTrue([[options objectForKey:NSInferMappingModelAutomaticallyOption] boolValue], nil);
+    
+    HLSSQLiteStoreOptions *defaultStoreOptions = [HLSSQLiteStoreOptions defaultStoreOptions];
+    GHAssertEquals([[defaultStoreOptions dictionary] count], (NSUInteger)0, nil);
+    
+    // Explicit settings override additional options
+    storeOptions.journalMode = HLSSQLiteJournalModeDefault;
+    storeOptions.synchronousLevel = HLSSQLiteSynchronousLevelFull;
+    storeOptions.cacheSize = 0;
+    storeOptions.migratingAutomatically = NO;
+    storeOptions.additionalOptions = [NSDictionary dictionaryWithObjectsAndKeys:[NSDictionary dictionaryWithObjectsAndKeys:@"OFF", @"synchronous", 
+                                                                                 @"DELETE", @"journal_mode", nil], NSSQLitePragmasOption,
+                                      [NSNumber numberWithBool:YES], NSReadOnlyPersistentStoreOption, nil];
+    options = [storeOptions dictionary];
+    pragmas = [options objectForKey:NSSQLitePragmasOption];
+    GHAssertEqualStrings([pragmas objectForKey:@"journal_mode"], @"DELETE", nil);
+    GHAssertEqualStrings([pragmas objectForKey:@"synchronous"], @"FULL", nil);
+    GHAssertNil([pragmas objectForKey:@"cache_size"], nil);
+    GHAssertNil([options objectForKey:NSMigratePersistentStoresAutomaticallyOption], nil);
+    GHAssertTrue([[options objectForKey:NSReadOnlyPersistentStoreOption] boolValue], nil);
+}
+
+- (void)testSQLiteManager
+{
+    NSString *storeDirectory = NSTemporaryDirectory();
+    NSString *storeFilePath = [HLSModelManager storeFilePathForModelFileName:@"CoconutKitTestData" storeDirectory:storeDirectory];
+    if (storeFilePath) {
+        NSError *error = nil;
+        if (! [[HLSFileManager defaultManager] removeItemAtPath:storeFilePath error:&error]) {
+            HLSLoggerWarn(@"Could not remove store at path %@", storeFilePath);
+        }
+    }
+    
+    HLSModelManager *modelManager = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                           inBundle:nil
+                                                                      configuration:nil 
+                                                                     storeDirectory:storeDirectory
+                                                                       storeOptions:nil];
+    GHAssertNotNil(modelManager, nil);
+    
+    NSPersistentStore *persistentStore = [[modelManager.persistentStoreCoordinator persistentStores] firstObject_hls];
+    GHAssertEqualStrings([[[persistentStore options] objectForKey:NSSQLitePragmasOption] objectForKey:@"synchronous"], @"NORMAL", nil);
+}
+
+@end
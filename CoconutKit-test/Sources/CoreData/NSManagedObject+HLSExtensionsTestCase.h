@@ -9,10 +9,11 @@
 // Forward declarations
 @class Person;
 
-@interface NSManagedObject_HLSExtensionsTestCase : GHTestCase {
+@interface NSManagedObject_HLSExtensionsTestCase : GHTestCase <HLSLiveQueryDelegate> {
 @private
     Person *m_person1;
     Person *m_person2;
+    NSMutableArray *m_reportedObjects;
 }
 
 @end
@@ -14,6 +14,7 @@
 
 @property (nonatomic, retain) Person *person1;
 @property (nonatomic, retain) Person *person2;
+@property (nonatomic, retain) NSMutableArray *reportedObjects;
 
 @end
 
@@ -25,6 +26,7 @@
 {
     self.person1 = nil;
     self.person2 = nil;
+    self.reportedObjects = nil;
     
     [super dealloc];
 }
@@ -35,6 +37,8 @@
 
 @synthesize person2 = m_person2;
 
+@synthesize reportedObjects = m_reportedObjects;
+
 #pragma mark Test setup and tear down
 
 - (void)setUpClass
@@ -88,8 +92,250 @@
     NSAssert([HLSModelManager saveCurrentModelContext:NULL], @"Failed to insert test data");
 }
 
+- (void)tearDown
+{
+    // Even if a test enabling sharing failed
+    [HLSModelManager setPersistentStoreCoordinatorSharingEnabled:NO];
+    
+    [super tearDown];
+}
+
 #pragma mark Tests
 
+- (void)testCountAndAggregates
+{
+    NSPredicate *personPredicate = [NSPredicate predicateWithFormat:@"firstName == %@", @"Carmela"];
+    GHAssertEquals([Person countOfObjectsUsingPredicate:personPredicate], (NSUInteger)1, @"Count");
+    GHAssertEquals([Person countOfObjectsUsingPredicate:nil], [[Person allObjects] count], @"Count");
+    
+    NSPredicate *accountPredicate = [NSPredicate predicateWithFormat:@"owner == %@", self.person1];
+    GHAssertEqualsWithAccuracy([[BankAccount sumOfValuesForKey:@"balance" usingPredicate:accountPredicate] doubleValue], 
+                               94790126.5, 1e-6, @"Sum");
+    GHAssertEqualsWithAccuracy([[BankAccount minimumValueForKey:@"balance" usingPredicate:accountPredicate] doubleValue], 
+                               15450039.5, 1e-6, @"Minimum");
+    GHAssertEqualsWithAccuracy([[BankAccount maximumValueForKey:@"balance" usingPredicate:accountPredicate] doubleValue], 
+                               79340087., 1e-6, @"Maximum");
+    
+    GHAssertNil([BankAccount sumOfValuesForKey:@"name" usingPredicate:nil], @"Non-numeric sum");
+    GHAssertNil([BankAccount sumOfValuesForKey:@"unknownKey" usingPredicate:nil], @"Unknown key");
+}
+
+- (void)testSharedPersistentStoreCoordinator
+{
+    NSString *storeDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"NSManagedObject+HLSExtensionsTestCase-sharing"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:storeDirectory withIntermediateDirectories:YES attributes:nil error:NULL];
+    
+    // Not shared by default
+    GHAssertFalse([HLSModelManager isPersistentStoreCoordinatorSharingEnabled], @"Disabled by default");
+    HLSModelManager *privateModelManager1 = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                                   inBundle:nil
+                                                                              configuration:nil
+                                                                             storeDirectory:storeDirectory
+                                                                                    options:HLSModelManagerLightweightMigrationOptions];
+    HLSModelManager *privateModelManager2 = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                                   inBundle:nil
+                                                                              configuration:nil
+                                                                             storeDirectory:storeDirectory
+                                                                                    options:HLSModelManagerLightweightMigrationOptions];
+    GHAssertTrue(privateModelManager1.persistentStoreCoordinator != privateModelManager2.persistentStoreCoordinator, @"Not shared");
+    
+    // Model managers for the same store share their coordinator, not their context
+    [HLSModelManager setPersistentStoreCoordinatorSharingEnabled:YES];
+    HLSModelManager *modelManager1 = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                            inBundle:nil
+                                                                       configuration:nil
+                                                                      storeDirectory:storeDirectory
+                                                                             options:HLSModelManagerLightweightMigrationOptions];
+    HLSModelManager *modelManager2 = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                            inBundle:nil
+                                                                       configuration:nil
+                                                                      storeDirectory:storeDirectory
+                                                                             options:HLSModelManagerLightweightMigrationOptions];
+    GHAssertEquals(modelManager1.persistentStoreCoordinator, modelManager2.persistentStoreCoordinator, @"Shared coordinator");
+    GHAssertEquals(modelManager1.managedObjectModel, modelManager2.managedObjectModel, @"Shared model");
+    GHAssertTrue(modelManager1.managedObjectContext != modelManager2.managedObjectContext, @"Separate contexts");
+    
+    // Data saved through one manager is seen by the other one
+    Person *person = [Person insertInManagedObjectContext:modelManager1.managedObjectContext];
+    person.firstName = @"Paulie";
+    person.lastName = @"Gualtieri";
+    GHAssertTrue([modelManager1.managedObjectContext save:NULL], @"Saved");
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Gualtieri"];
+    GHAssertEquals([[Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptors:nil inManagedObjectContext:modelManager2.managedObjectContext] count],
+                   (NSUInteger)1, @"Shared store");
+    
+    // Different options, different coordinators
+    HLSModelManager *otherOptionsModelManager = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                                       inBundle:nil
+                                                                                  configuration:nil
+                                                                                 storeDirectory:storeDirectory
+                                                                                        options:nil];
+    GHAssertTrue(otherOptionsModelManager.persistentStoreCoordinator != modelManager1.persistentStoreCoordinator, @"Options");
+    
+    // Coordinators are not reused once their store has been deleted
+    NSString *storeFilePath = [HLSModelManager storeFilePathForModelFileName:@"CoconutKitTestData" storeDirectory:storeDirectory];
+    GHAssertNotNil(storeFilePath, @"Store file");
+    [[NSFileManager defaultManager] removeItemAtPath:storeFilePath error:NULL];
+    HLSModelManager *modelManager3 = [HLSModelManager SQLiteManagerWithModelFileName:@"CoconutKitTestData"
+                                                                            inBundle:nil
+                                                                       configuration:nil
+                                                                      storeDirectory:storeDirectory
+                                                                             options:HLSModelManagerLightweightMigrationOptions];
+    GHAssertTrue(modelManager3.persistentStoreCoordinator != modelManager1.persistentStoreCoordinator, @"Deleted store");
+    GHAssertEquals([[Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptors:nil inManagedObjectContext:modelManager3.managedObjectContext] count],
+                   (NSUInteger)0, @"New store");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:storeDirectory error:NULL];
+}
+
+- (void)testCachedObjects
+{
+    [BankAccount cacheObjectsWithValues:[NSArray arrayWithObjects:@"Clean account", @"Dirty account", @"Swiss account", nil] 
+                                 forKey:@"name"];
+    GHAssertEqualStrings([[BankAccount cachedObjectWithValue:@"Clean account" forKey:@"name"] name], @"Clean account", @"Cached");
+    GHAssertNil([BankAccount cachedObjectWithValue:@"Swiss account" forKey:@"name"], @"Missing");
+    
+    // Inserted objects are found
+    BankAccount *bankAccount = [BankAccount insert];
+    bankAccount.name = @"Swiss account";
+    GHAssertEquals([BankAccount cachedObjectWithValue:@"Swiss account" forKey:@"name"], bankAccount, @"Inserted");
+    
+    // Deleted objects are not found anymore
+    [HLSModelManager deleteObjectFromCurrentModelContext:bankAccount];
+    GHAssertNil([BankAccount cachedObjectWithValue:@"Swiss account" forKey:@"name"], @"Deleted");
+    
+    // Read-through
+    [BankAccount clearObjectCache];
+    GHAssertEqualStrings([[BankAccount cachedObjectWithValue:@"Dirty account" forKey:@"name"] name], @"Dirty account", @"Read-through");
+    
+    [HLSModelManager rollbackCurrentModelContext];
+    [BankAccount clearObjectCache];
+}
+
+- (void)testLiveQuery
+{
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Slowprano"];
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES];
+    HLSLiveQuery *liveQuery = [[[HLSLiveQuery alloc] initWithEntityClass:[Person class]
+                                                               predicate:predicate
+                                                         sortDescriptors:[NSArray arrayWithObject:sortDescriptor]] autorelease];
+    NSUInteger count = [liveQuery.objects count];
+    GHAssertTrue([liveQuery.objects containsObject:self.person1], @"Initial results");
+    GHAssertTrue([liveQuery.objects indexOfObject:self.person2] < [liveQuery.objects indexOfObject:self.person1], @"Sorted");
+    
+    // Matching objects are inserted at their sorted position
+    Person *person = [Person insert];
+    person.firstName = @"Aaron";
+    person.lastName = @"Slowprano";
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEquals([liveQuery.objects count], count + 1, @"Inserted");
+    GHAssertEquals([liveQuery.objects indexOfObject:person], (NSUInteger)0, @"Inserted");
+    
+    // Objects are moved when their sort keys change
+    person.firstName = @"Zach";
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEquals([liveQuery.objects indexOfObject:person], count, @"Moved");
+    
+    // Objects not matching anymore are removed
+    person.lastName = @"Soprano";
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEquals([liveQuery.objects count], count, @"Not matching");
+    GHAssertFalse([liveQuery.objects containsObject:person], @"Not matching");
+    
+    person.lastName = @"Slowprano";
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEquals([liveQuery.objects count], count + 1, @"Matching again");
+    
+    // Deleted objects are removed
+    [HLSModelManager deleteObjectFromCurrentModelContext:person];
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEquals([liveQuery.objects count], count, @"Deleted");
+    GHAssertFalse([liveQuery.objects containsObject:person], @"Deleted");
+    
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
+- (void)testLiveQuerySeveralMoves
+{
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Gandolfini"];
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES];
+    HLSLiveQuery *liveQuery = [[[HLSLiveQuery alloc] initWithEntityClass:[Person class]
+                                                               predicate:predicate
+                                                         sortDescriptors:[NSArray arrayWithObject:sortDescriptor]] autorelease];
+    liveQuery.delegate = self;
+    
+    NSArray *firstNames = [NSArray arrayWithObjects:@"Ann", @"Bob", @"Cid", @"Dan", @"Eve", nil];
+    NSMutableArray *persons = [NSMutableArray array];
+    for (NSString *firstName in firstNames) {
+        Person *person = [Person insert];
+        person.firstName = firstName;
+        person.lastName = @"Gandolfini";
+        [persons addObject:person];
+    }
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    GHAssertEqualObjects(liveQuery.objects, persons, @"Inserted");
+    
+    // Several objects changing their sort keys within the same notification (results and reported changes must agree)
+    self.reportedObjects = [NSMutableArray arrayWithArray:liveQuery.objects];
+    ((Person *)[persons objectAtIndex:0]).firstName = @"Fay";
+    ((Person *)[persons objectAtIndex:1]).firstName = @"Abe";
+    ((Person *)[persons objectAtIndex:3]).firstName = @"Bea";
+    ((Person *)[persons objectAtIndex:4]).firstName = @"Ada";
+    [[HLSModelManager currentModelContext] processPendingChanges];
+    
+    NSArray *expectedFirstNames = [NSArray arrayWithObjects:@"Abe", @"Ada", @"Bea", @"Cid", @"Fay", nil];
+    GHAssertEqualObjects([liveQuery.objects valueForKey:@"firstName"], expectedFirstNames, @"Sorted");
+    GHAssertEqualObjects(self.reportedObjects, liveQuery.objects, @"Reported moves");
+    
+    liveQuery.delegate = nil;
+    self.reportedObjects = nil;
+    
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
+- (void)testStreamingMigration
+{
+    NSString *storeFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"NSManagedObject+HLSExtensionsTestCase-migration.sqlite"];
+    [[NSFileManager defaultManager] removeItemAtPath:storeFilePath error:NULL];
+    NSURL *storeURL = [NSURL fileURLWithPath:storeFilePath];
+    
+    // Batches of a single object, so that paging is exercised
+    HLSModelManager *modelManager = [HLSModelManager currentModelManager];
+    HLSTaskGroup *taskGroup = [modelManager migrationTaskGroupToURL:storeURL withStoreType:NSSQLiteStoreType batchSize:1];
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    [taskManager submitTaskGroup:taskGroup];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertTrue(taskGroup.finished, @"Finished");
+    GHAssertEquals(taskGroup.nbrFailures, (NSUInteger)0, @"Failures");
+    
+    NSPersistentStoreCoordinator *persistentStoreCoordinator = [[[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:modelManager.managedObjectModel] autorelease];
+    GHAssertNotNil([persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+                                                            configuration:nil
+                                                                      URL:storeURL
+                                                                  options:nil
+                                                                    error:NULL], @"Compatible store");
+    NSManagedObjectContext *managedObjectContext = [[[NSManagedObjectContext alloc] init] autorelease];
+    [managedObjectContext setPersistentStoreCoordinator:persistentStoreCoordinator];
+    
+    // Each object is copied once, with its relationships
+    GHAssertEquals([[Person filteredObjectsUsingPredicate:nil sortedUsingDescriptors:nil inManagedObjectContext:managedObjectContext] count],
+                   [[Person allObjects] count], @"Persons");
+    GHAssertEquals([[BankAccount filteredObjectsUsingPredicate:nil sortedUsingDescriptors:nil inManagedObjectContext:managedObjectContext] count],
+                   [[BankAccount allObjects] count], @"Accounts");
+    
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"firstName == %@ AND lastName == %@", @"Tony", @"Slowprano"];
+    Person *person1 = [[Person filteredObjectsUsingPredicate:predicate sortedUsingDescriptors:nil inManagedObjectContext:managedObjectContext] firstObject_hls];
+    GHAssertEquals([person1.accounts count], (NSUInteger)2, @"To-many relationship");
+    GHAssertEqualStrings([[person1.houses anyObject] name], @"Mafia blues", @"Many-to-many relationship");
+    GHAssertEquals([[[person1.houses anyObject] owners] count], (NSUInteger)2, @"Many-to-many relationship");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:storeFilePath error:NULL];
+}
+
 - (void)testDuplicate
 {
     Person *person1Duplicate = [self.person1 duplicate];
@@ -110,4 +356,155 @@
     GHAssertTrue([HLSModelManager saveCurrentModelContext:NULL], @"Invalid objects");
 }
 
+- (void)testBatchedDeletion
+{
+    // Work in a separate store so that the test data is left untouched
+    HLSModelManager *modelManager = [HLSModelManager inMemoryModelManagerWithModelFileName:@"CoconutKitTestData" 
+                                                                                  inBundle:nil 
+                                                                             configuration:nil 
+                                                                                   options:nil];
+    [HLSModelManager pushModelManager:modelManager];
+    
+    for (NSUInteger i = 0; i < 10; ++i) {
+        House *house = [House insert];
+        house.name = [NSString stringWithFormat:@"House %d", i];
+    }
+    GHAssertTrue([HLSModelManager saveCurrentModelContext:NULL], @"Failed to insert houses");
+    
+    NSError *error = nil;
+    GHAssertTrue([House deleteAllObjectsWithBatchSize:3 error:&error], @"Batched deletion");
+    GHAssertNil(error, @"Batched deletion");
+    GHAssertEquals([[House allObjects] count], (NSUInteger)0, @"Batched deletion");
+    
+    [HLSModelManager popModelManager];
+}
+
+- (void)testDuplicateGraph
+{
+    Person *person1Duplicate = [self.person1 duplicate];
+    
+    // Attributes copied at once
+    GHAssertEqualStrings(person1Duplicate.firstName, self.person1.firstName, @"First name");
+    GHAssertEqualStrings(person1Duplicate.lastName, self.person1.lastName, @"Last name");
+    
+    // Owned accounts are duplicated and point to the person copy
+    GHAssertEquals([person1Duplicate.accounts count], [self.person1.accounts count], @"Accounts");
+    for (BankAccount *bankAccount in person1Duplicate.accounts) {
+        GHAssertFalse([self.person1.accounts containsObject:bankAccount], @"Not a deep copy");
+        GHAssertEquals(bankAccount.owner, person1Duplicate, @"Owner");
+    }
+    
+    // Relationships are set once the whole graph has been duplicated. The original graph is left untouched
+    NSUInteger nbrAccounts = [self.person1.accounts count];
+    GHAssertTrue(nbrAccounts != 0, @"Accounts to duplicate");
+    for (BankAccount *bankAccount in self.person1.accounts) {
+        GHAssertEquals(bankAccount.owner, self.person1, @"Original owner");
+    }
+    
+    // Duplicating the same graph again yields a new independent copy
+    Person *person1SecondDuplicate = [self.person1 duplicate];
+    GHAssertFalse([person1SecondDuplicate.accounts intersectsSet:person1Duplicate.accounts], @"Shared copies");
+    
+    // Not testing insertion here. Rollback
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
+- (void)testFetchOptions
+{
+    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"firstName" ascending:YES];
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"lastName == %@", @"Slowprano"];
+    
+    NSDictionary *batchOptions = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:1], HLSFetchBatchSizeOption,
+                                  [NSArray arrayWithObject:@"accounts"], HLSFetchRelationshipKeyPathsForPrefetchingOption, nil];
+    NSArray *persons = [Person filteredObjectsUsingPredicate:predicate 
+                                      sortedUsingDescriptors:[NSArray arrayWithObject:sortDescriptor] 
+                                                     options:batchOptions];
+    GHAssertTrue([persons count] >= 2, @"Batched fetch");
+    GHAssertTrue([[persons objectAtIndex:0] isKindOfClass:[Person class]], @"Batched fetch");
+    
+    NSDictionary *dictionaryOptions = [NSDictionary dictionaryWithObjectsAndKeys:[NSArray arrayWithObject:@"firstName"], HLSFetchPropertiesToFetchOption,
+                                       [NSNumber numberWithUnsignedInteger:NSDictionaryResultType], HLSFetchResultTypeOption, nil];
+    NSArray *personDictionaries = [Person filteredObjectsUsingPredicate:predicate 
+                                                 sortedUsingDescriptors:[NSArray arrayWithObject:sortDescriptor] 
+                                                                options:dictionaryOptions];
+    GHAssertEquals([personDictionaries count], [persons count], @"Dictionary fetch");
+    NSDictionary *personDictionary = [personDictionaries objectAtIndex:0];
+    GHAssertTrue([personDictionary isKindOfClass:[NSDictionary class]], @"Dictionary fetch");
+    GHAssertEquals([[personDictionary allKeys] count], (NSUInteger)1, @"Properties to fetch");
+    GHAssertEqualStrings([personDictionary objectForKey:@"firstName"], [[persons objectAtIndex:0] firstName], @"Properties to fetch");
+}
+
+- (void)testPredicateTemplates
+{
+    [NSManagedObject registerPredicateTemplateWithFormat:@"firstName == $FIRST_NAME" name:@"personsWithFirstName"];
+    
+    NSArray *persons1 = [Person filteredObjectsUsingPredicateTemplateWithName:@"personsWithFirstName" 
+                                                        substitutionVariables:[NSDictionary dictionaryWithObject:@"Carmela" forKey:@"FIRST_NAME"] 
+                                                       sortedUsingDescriptors:nil];
+    GHAssertEquals([persons1 count], (NSUInteger)1, @"Template");
+    GHAssertEqualStrings([[persons1 lastObject] firstName], @"Carmela", @"Template");
+    
+    // Same template, different variables (cached fetch request)
+    NSArray *persons2 = [Person filteredObjectsUsingPredicateTemplateWithName:@"personsWithFirstName" 
+                                                        substitutionVariables:[NSDictionary dictionaryWithObject:@"Tony" forKey:@"FIRST_NAME"] 
+                                                       sortedUsingDescriptors:nil];
+    GHAssertEquals([persons2 count], (NSUInteger)1, @"Template");
+    GHAssertEqualStrings([[persons2 lastObject] firstName], @"Tony", @"Template");
+    
+    // Replaced template
+    [NSManagedObject registerPredicateTemplateWithFormat:@"lastName == $FIRST_NAME" name:@"personsWithFirstName"];
+    NSArray *persons3 = [Person filteredObjectsUsingPredicateTemplateWithName:@"personsWithFirstName" 
+                                                        substitutionVariables:[NSDictionary dictionaryWithObject:@"Tony" forKey:@"FIRST_NAME"] 
+                                                       sortedUsingDescriptors:nil];
+    GHAssertEquals([persons3 count], (NSUInteger)0, @"Replaced template");
+    
+    GHAssertNil([Person filteredObjectsUsingPredicateTemplateWithName:@"unknownTemplate" 
+                                                substitutionVariables:nil 
+                                               sortedUsingDescriptors:nil], @"Unknown template");
+}
+
+- (void)testInstrumentation
+{
+    [HLSModelManager resetInstrumentation];
+    [HLSModelManager setInstrumentationEnabled:YES];
+    
+    // Fetches only differing by their values are aggregated
+    [Person filteredObjectsUsingPredicate:[NSPredicate predicateWithFormat:@"firstName == %@", @"Tony"] 
+                   sortedUsingDescriptors:nil];
+    [Person filteredObjectsUsingPredicate:[NSPredicate predicateWithFormat:@"firstName == %@", @"Carmela"] 
+                   sortedUsingDescriptors:nil];
+    [Person countOfObjectsUsingPredicate:nil];
+    
+    [HLSModelManager setInstrumentationEnabled:NO];
+    [Person allObjects];
+    
+    NSString *report = [HLSModelManager instrumentationReport];
+    GHAssertTrue([report rangeOfString:@"(2 entries)"].location != NSNotFound, @"Entries");
+    GHAssertTrue([report rangeOfString:@"fetch Person [firstName == $value]"].location != NSNotFound, @"Fetch");
+    GHAssertTrue([report rangeOfString:@"2 calls"].location != NSNotFound, @"Fetch aggregation");
+    GHAssertTrue([report rangeOfString:@"count Person [all]"].location != NSNotFound, @"Count");
+    GHAssertTrue([report rangeOfString:@"testInstrumentation"].location != NSNotFound, @"Call site");
+    
+    [HLSModelManager resetInstrumentation];
+    GHAssertTrue([[HLSModelManager instrumentationReport] rangeOfString:@"(0 entries)"].location != NSNotFound, @"Reset");
+}
+
+#pragma mark HLSLiveQueryDelegate protocol implementation
+
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didInsertObject:(NSManagedObject *)object atIndex:(NSUInteger)index
+{
+    [self.reportedObjects insertObject:object atIndex:index];
+}
+
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didRemoveObject:(NSManagedObject *)object atIndex:(NSUInteger)index
+{
+    [self.reportedObjects removeObjectAtIndex:index];
+}
+
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didMoveObject:(NSManagedObject *)object fromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex
+{
+    [self.reportedObjects removeObjectAtIndex:fromIndex];
+    [self.reportedObjects insertObject:object atIndex:toIndex];
+}
+
 @end
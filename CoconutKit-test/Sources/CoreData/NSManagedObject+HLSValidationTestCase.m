@@ -280,6 +280,160 @@
     [HLSModelManager rollbackCurrentModelContext];
 }
 
+- (void)testCheckLookupsPerClass
+{
+    ConcreteClassD *dInstance = [ConcreteClassD insert];
+    dInstance.noValidationStringD = @"D";
+    
+    // Only the consistency check defined on ConcreteSubclassB fails
+    ConcreteSubclassB *bInstance = [ConcreteSubclassB insert];
+    bInstance.noValidationStringA = @"Consistency check";
+    bInstance.codeMandatoryNotEmptyStringA = @"Mandatory A";
+    bInstance.codeMandatoryNumberB = [NSNumber numberWithInteger:0];
+    bInstance.modelMandatoryBoundedNumberB = [NSNumber numberWithInteger:6];
+    bInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:3];
+    bInstance.codeMandatoryConcreteClassesD = [NSSet setWithObject:dInstance];
+    
+    // Only the consistency check defined on ConcreteSubclassC fails
+    ConcreteSubclassC *cInstance = [ConcreteSubclassC insert];
+    cInstance.noValidationStringA = @"Consistency check";
+    cInstance.codeMandatoryNotEmptyStringA = @"Mandatory A";
+    cInstance.codeMandatoryNumberB = [NSNumber numberWithInteger:0];
+    cInstance.modelMandatoryBoundedNumberB = [NSNumber numberWithInteger:6];
+    cInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:3];
+    cInstance.noValidationNumberB = [NSNumber numberWithInteger:-12];
+    cInstance.codeMandatoryStringC = @"Mandatory C";
+    cInstance.modelMandatoryBoundedPatternStringC = @"Hello, World!";
+    cInstance.codeMandatoryConcreteClassesD = [NSSet setWithObject:dInstance];
+    
+    // Check methods are looked up once and cached per class. Alternate between both classes so that results cached
+    // for one class cannot be used for the other one
+    for (NSUInteger i = 0; i < 3; ++i) {
+        NSError *errorA = nil;
+        GHAssertFalse([bInstance checkValue:@"      " forKey:@"codeMandatoryNotEmptyStringA" error:&errorA], @"Inherited check");
+        GHAssertTrue([errorA hasCode:TestValidationIncorrectValueError withinDomain:TestValidationErrorDomain], @"Incorrect error domain and code");
+        
+        errorA = nil;
+        GHAssertFalse([cInstance checkValue:@"      " forKey:@"codeMandatoryNotEmptyStringA" error:&errorA], @"Inherited check");
+        GHAssertTrue([errorA hasCode:TestValidationIncorrectValueError withinDomain:TestValidationErrorDomain], @"Incorrect error domain and code");
+        
+        NSError *errorB = nil;
+        GHAssertFalse([bInstance check:&errorB], @"Consistency check on ConcreteSubclassB");
+        GHAssertTrue([errorB hasCode:TestValidationInconsistencyError withinDomain:TestValidationErrorDomain], @"Single inconsistency error");
+        
+        NSError *errorC = nil;
+        GHAssertFalse([cInstance check:&errorC], @"Consistency check on ConcreteSubclassC");
+        GHAssertTrue([errorC hasCode:TestValidationInconsistencyError withinDomain:TestValidationErrorDomain], @"Single inconsistency error");
+    }
+    
+    bInstance.noValidationNumberB = [NSNumber numberWithInteger:7];
+    cInstance.noValidationNumberC = [NSNumber numberWithInteger:1012];
+    GHAssertTrue([bInstance check:NULL], @"Consistent ConcreteSubclassB instance");
+    GHAssertTrue([cInstance check:NULL], @"Consistent ConcreteSubclassC instance");
+    
+    // Not testing insertion here. Rollback
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
+- (void)testCheckWithFieldErrors
+{
+    ConcreteClassD *dInstance = [ConcreteClassD insert];
+    dInstance.noValidationStringD = @"D";
+    
+    // Same invalid instance as in -testCheck (4 individual errors for 3 fields, 3 consistency errors)
+    ConcreteSubclassC *cInstance = [ConcreteSubclassC insert];
+    cInstance.noValidationStringA = @"Unexpected string for consistency check";
+    cInstance.codeMandatoryNotEmptyStringA = nil;
+    cInstance.codeMandatoryNumberB = [NSNumber numberWithInteger:0];
+    cInstance.modelMandatoryBoundedNumberB = [NSNumber numberWithInteger:6];
+    cInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:0];
+    cInstance.codeMandatoryStringC = @"Mandatory C";
+    cInstance.modelMandatoryBoundedPatternStringC = @"This string is too long, and does not match the expected pattern";
+    cInstance.codeMandatoryConcreteClassesD = [NSSet setWithObject:dInstance];
+    
+    NSError *error = nil;
+    NSDictionary *fieldErrors = nil;
+    GHAssertFalse([cInstance check:&error fieldErrors:&fieldErrors], @"Incorrect result when performing global check");
+    NSArray *subErrors = [[error userInfo] objectForKey:NSDetailedErrorsKey];
+    GHAssertEquals([subErrors count], 7U, @"Incorrect number of sub-errors");
+    
+    GHAssertEquals([fieldErrors count], 3U, @"Incorrect number of invalid fields");
+    GHAssertNotNil([fieldErrors objectForKey:@"codeMandatoryNotEmptyStringA"], @"Missing field error");
+    GHAssertNotNil([fieldErrors objectForKey:@"modelMandatoryCodeNotZeroNumberB"], @"Missing field error");
+    NSError *patternStringError = [fieldErrors objectForKey:@"modelMandatoryBoundedPatternStringC"];
+    GHAssertTrue([patternStringError hasCode:NSValidationMultipleErrorsError withinDomain:NSCocoaErrorDomain], @"Incorrect error domain and code");
+    
+    // Fix the individual errors. Only consistency errors remain
+    cInstance.codeMandatoryNotEmptyStringA = @"Mandatory A";
+    cInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:3];
+    cInstance.modelMandatoryBoundedPatternStringC = @"Hello, World!";
+    
+    NSError *consistencyError = nil;
+    NSDictionary *noFieldErrors = nil;
+    GHAssertFalse([cInstance check:&consistencyError fieldErrors:&noFieldErrors], @"Incorrect result when performing global check");
+    GHAssertNotNil(consistencyError, @"Missing consistency error");
+    GHAssertEquals([noFieldErrors count], 0U, @"Field errors incorrectly returned");
+    
+    // Not testing insertion here. Rollback
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
+- (void)testCheckObjects
+{
+    ConcreteClassD *dInstance = [ConcreteClassD insert];
+    dInstance.noValidationStringD = @"D";
+    
+    // Many invalid ConcreteSubclassC instances (7 errors each, see -testCheck) and a valid one
+    NSMutableArray *cInstances = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 20; ++i) {
+        ConcreteSubclassC *cInstance = [ConcreteSubclassC insert];
+        cInstance.noValidationStringA = @"Unexpected string for consistency check";
+        cInstance.codeMandatoryNotEmptyStringA = nil;
+        cInstance.codeMandatoryNumberB = [NSNumber numberWithInteger:0];
+        cInstance.modelMandatoryBoundedNumberB = [NSNumber numberWithInteger:6];
+        cInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:0];
+        cInstance.codeMandatoryStringC = @"Mandatory C";
+        cInstance.modelMandatoryBoundedPatternStringC = @"This string is too long, and does not match the expected pattern";
+        cInstance.codeMandatoryConcreteClassesD = [NSSet setWithObject:dInstance];
+        [cInstances addObject:cInstance];
+    }
+    
+    ConcreteSubclassC *validCInstance = [ConcreteSubclassC insert];
+    validCInstance.noValidationStringA = @"Consistency check";
+    validCInstance.codeMandatoryNotEmptyStringA = @"Mandatory A";
+    validCInstance.codeMandatoryNumberB = [NSNumber numberWithInteger:0];
+    validCInstance.modelMandatoryBoundedNumberB = [NSNumber numberWithInteger:6];
+    validCInstance.modelMandatoryCodeNotZeroNumberB = [NSNumber numberWithInteger:3];
+    validCInstance.noValidationNumberB = [NSNumber numberWithInteger:-12];
+    validCInstance.codeMandatoryStringC = @"Mandatory C";
+    validCInstance.modelMandatoryBoundedPatternStringC = @"Hello, World!";
+    validCInstance.noValidationNumberC = [NSNumber numberWithInteger:1012];
+    validCInstance.codeMandatoryConcreteClassesD = [NSSet setWithObject:dInstance];
+    
+    NSError *validError = nil;
+    GHAssertTrue([NSManagedObject checkObjects:[NSArray arrayWithObjects:validCInstance, dInstance, nil] error:&validError], @"Valid objects");
+    GHAssertNil(validError, @"Error incorrectly returned");
+    
+    // Same errors as when checking objects one after the other
+    NSError *error = nil;
+    GHAssertFalse([NSManagedObject checkObjects:cInstances error:&error], @"Invalid objects");
+    GHAssertTrue([error hasCode:NSValidationMultipleErrorsError withinDomain:NSCocoaErrorDomain], @"Incorrect error domain and code");
+    NSArray *subErrors = [[error userInfo] objectForKey:NSDetailedErrorsKey];
+    GHAssertEquals([subErrors count], 20U * 7U, @"Incorrect number of sub-errors");
+    
+    NSError *firstObjectError = nil;
+    [[cInstances objectAtIndex:0] check:&firstObjectError];
+    NSArray *firstObjectSubErrors = [[firstObjectError userInfo] objectForKey:NSDetailedErrorsKey];
+    for (NSUInteger i = 0; i < [firstObjectSubErrors count]; ++i) {
+        NSError *subError = [subErrors objectAtIndex:i];
+        NSError *firstObjectSubError = [firstObjectSubErrors objectAtIndex:i];
+        GHAssertTrue([subError hasCode:[firstObjectSubError code] withinDomain:[firstObjectSubError domain]], @"Incorrect error order");
+    }
+    
+    // Not testing insertion here. Rollback
+    [HLSModelManager rollbackCurrentModelContext];
+}
+
 - (void)testDelete
 {    
     [HLSModelManager deleteObjectFromCurrentModelContext:self.lockedDInstance];
@@ -0,0 +1,98 @@
+//
+//  TestBenchmarks.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Maximum relative increase of a median running time over its baseline before TestBenchmarkAssertNoRegression() fails
+ */
+#define kTestBenchmarkRegressionTolerance       0.25
+
+/**
+ * Number of times a benchmark is measured before TestBenchmarkAssertNoRegression() reports a regression. Measuring
+ * again when a median exceeds the tolerance filters out occasional hiccups (e.g. background activity on the device)
+ */
+#define kTestBenchmarkRegressionAttemptCount    3
+
+/**
+ * Measure a block (see TestBenchmarkMeasure()) and report its result (see TestBenchmarkReportTimes()), then fail the
+ * current test if its median exceeds the baseline recorded for the same name, size and device class by more than 
+ * kTestBenchmarkRegressionTolerance. The block is measured again (at most kTestBenchmarkRegressionAttemptCount times
+ * overall) while the tolerance is exceeded, and the test only fails if no measurement stays within it.
+ *
+ * Benchmarks without baseline for the device class the tests run on cannot be checked. They are reported and fail
+ * only if the HLSBenchmarkBaselineRequired environment variable is set to YES (set it when running on reference devices,
+ * so that a missing baseline does not go unnoticed). Must be called from a GHTestCase method, with a block variable
+ */
+#define TestBenchmarkAssertNoRegression(name, size, runCount, block)                                                                \
+    do {                                                                                                                            \
+        double hls_ratio_ = TestBenchmarkMeasureRatioToBaseline((name), (size), (runCount), (block));                               \
+        if (hls_ratio_ == 0.) {                                                                                                     \
+            GHAssertFalse(TestBenchmarkBaselineRequired(), @"No %@ baseline for %@ (size %u)", TestBenchmarkDeviceClass(),         \
+                          (name), (size));                                                                                          \
+        }                                                                                                                           \
+        else {                                                                                                                      \
+            GHAssertTrue(hls_ratio_ <= 1. + kTestBenchmarkRegressionTolerance, @"%@ (size %u) regressed: Median is %.2f times "     \
+                         "the %@ baseline", (name), (size), hls_ratio_, TestBenchmarkDeviceClass());                                \
+        }                                                                                                                           \
+    } while (0)
+
+/**
+ * Return YES iff benchmarks must be run, i.e. if the HLSBenchmarks environment variable is set to YES (set it in the
+ * scheme used for benchmark runs). Benchmarks take long and are therefore skipped by regular test runs: Benchmark 
+ * test methods must return immediately when this function returns NO
+ */
+BOOL TestBenchmarksEnabled(void);
+
+/**
+ * Return YES iff benchmarks without baseline for the device class the tests run on must fail, i.e. if the 
+ * HLSBenchmarkBaselineRequired environment variable is set to YES
+ */
+BOOL TestBenchmarkBaselineRequired(void);
+
+/**
+ * Running time statistics (in seconds)
+ */
+typedef struct {
+    double median;
+    double p99;
+} TestBenchmarkTimes;
+
+/**
+ * Run the block once to warm up, then runCount times, and return the median and 99th percentile of its running time.
+ * An autorelease pool is drained after each run
+ */
+TestBenchmarkTimes TestBenchmarkMeasure(NSUInteger runCount, void (^block)(void));
+
+/**
+ * Print the result of a benchmark on a single line, so that results can be easily extracted from the logs. If the
+ * BenchmarkBaseline.plist resource contains a median for the same name, size and device class, the ratio to it is 
+ * printed as well (use Tools/Benchmarks/update_baseline.py to update the baseline from the logs of a reference run)
+ */
+void TestBenchmarkReportTimes(NSString *name, NSUInteger size, TestBenchmarkTimes times);
+
+/**
+ * Print a benchmark result which is not a running time (e.g. a memory footprint) on a single line, in the same format
+ * as TestBenchmarkReportTimes(). Such results have no baseline
+ */
+void TestBenchmarkReportValue(NSString *name, NSUInteger size, double value, NSString *unit);
+
+/**
+ * Return the class of the device the tests run on, which baselines are recorded for: The hardware model identifier
+ * (e.g. "iPhone3,1" or "iPad2,1"), or "Simulator"
+ */
+NSString *TestBenchmarkDeviceClass(void);
+
+/**
+ * Return the baseline median (in milliseconds) recorded for a name and size on the current device class, 0 if none
+ */
+double TestBenchmarkBaselineMedian(NSString *name, NSUInteger size);
+
+/**
+ * Measure a block and report its result like TestBenchmarkAssertNoRegression() does, and return the ratio of its median
+ * to the baseline median (the lowest ratio if the block had to be measured several times), 0 if there is no baseline
+ */
+double TestBenchmarkMeasureRatioToBaseline(NSString *name, NSUInteger size, NSUInteger runCount, void (^block)(void));
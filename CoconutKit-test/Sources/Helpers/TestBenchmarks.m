@@ -0,0 +1,165 @@
+//
+//  TestBenchmarks.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "TestBenchmarks.h"
+
+#import <sys/sysctl.h>
+
+// Static functions
+static NSDictionary *TestBenchmarkBaseline(void);
+static int TestBenchmarkCompareTimes(const void *time1, const void *time2);
+
+#pragma mark Functions
+
+BOOL TestBenchmarksEnabled(void)
+{
+    return [[[[NSProcessInfo processInfo] environment] objectForKey:@"HLSBenchmarks"] boolValue];
+}
+
+BOOL TestBenchmarkBaselineRequired(void)
+{
+    return [[[[NSProcessInfo processInfo] environment] objectForKey:@"HLSBenchmarkBaselineRequired"] boolValue];
+}
+
+TestBenchmarkTimes TestBenchmarkMeasure(NSUInteger runCount, void (^block)(void))
+{
+    TestBenchmarkTimes times;
+    times.median = 0.;
+    times.p99 = 0.;
+    
+    if (runCount == 0 || ! block) {
+        return times;
+    }
+    
+    NSAutoreleasePool *warmUpPool = [[NSAutoreleasePool alloc] init];
+    block();
+    [warmUpPool drain];
+    
+    double *runTimes = malloc(runCount * sizeof(double));
+    for (NSUInteger i = 0; i < runCount; ++i) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        block();
+        runTimes[i] = CFAbsoluteTimeGetCurrent() - startTime;
+        [pool drain];
+    }
+    
+    qsort(runTimes, runCount, sizeof(double), TestBenchmarkCompareTimes);
+    times.median = (runCount % 2 == 1) ? runTimes[runCount / 2] : (runTimes[runCount / 2 - 1] + runTimes[runCount / 2]) / 2.;
+    times.p99 = runTimes[MIN((NSUInteger)ceil(0.99 * runCount), runCount) - 1];
+    free(runTimes);
+    
+    return times;
+}
+
+void TestBenchmarkReportTimes(NSString *name, NSUInteger size, TestBenchmarkTimes times)
+{
+    double medianInMilliseconds = times.median * 1000.;
+    NSMutableString *line = [NSMutableString stringWithFormat:@"{\"name\": \"%@\", \"size\": %u, \"median\": %.4f, \"p99\": %.4f, \"unit\": \"ms\", \"device\": \"%@\"",
+                             name, size, medianInMilliseconds, times.p99 * 1000., TestBenchmarkDeviceClass()];
+    
+    double baselineMedian = TestBenchmarkBaselineMedian(name, size);
+    if (baselineMedian > 0.) {
+        [line appendFormat:@", \"baseline\": %.4f, \"ratio\": %.2f", baselineMedian, medianInMilliseconds / baselineMedian];
+    }
+    [line appendString:@"}"];
+    
+    // A single line each, so that results can be easily extracted from the logs
+    printf("HLSBenchmark: %s\n", [line UTF8String]);
+    fflush(stdout);
+}
+
+void TestBenchmarkReportValue(NSString *name, NSUInteger size, double value, NSString *unit)
+{
+    NSString *line = [NSString stringWithFormat:@"{\"name\": \"%@\", \"size\": %u, \"value\": %.4f, \"unit\": \"%@\", \"device\": \"%@\"}",
+                      name, size, value, unit, TestBenchmarkDeviceClass()];
+    printf("HLSBenchmark: %s\n", [line UTF8String]);
+    fflush(stdout);
+}
+
+NSString *TestBenchmarkDeviceClass(void)
+{
+#if TARGET_IPHONE_SIMULATOR
+    return @"Simulator";
+#else
+    static NSString *s_deviceClass = nil;
+    if (! s_deviceClass) {
+        char machine[64];
+        size_t length = sizeof(machine);
+        if (sysctlbyname("hw.machine", machine, &length, NULL, 0) == 0) {
+            s_deviceClass = [[NSString alloc] initWithUTF8String:machine];
+        }
+        else {
+            s_deviceClass = @"Unknown";
+        }
+    }
+    return s_deviceClass;
+#endif
+}
+
+double TestBenchmarkBaselineMedian(NSString *name, NSUInteger size)
+{
+    NSDictionary *deviceBaseline = [TestBenchmarkBaseline() objectForKey:TestBenchmarkDeviceClass()];
+    NSString *key = [NSString stringWithFormat:@"%@/%u", name, size];
+    return [[deviceBaseline objectForKey:key] doubleValue];
+}
+
+double TestBenchmarkMeasureRatioToBaseline(NSString *name, NSUInteger size, NSUInteger runCount, void (^block)(void))
+{
+    double baselineMedian = TestBenchmarkBaselineMedian(name, size);
+    double ratio = 0.;
+    for (NSUInteger i = 0; i < kTestBenchmarkRegressionAttemptCount; ++i) {
+        TestBenchmarkTimes times = TestBenchmarkMeasure(runCount, block);
+        TestBenchmarkReportTimes(name, size, times);
+        
+        // Without baseline there is nothing to compare with, measuring again is pointless
+        if (baselineMedian <= 0.) {
+            return 0.;
+        }
+        
+        double attemptRatio = times.median * 1000. / baselineMedian;
+        if (i == 0 || attemptRatio < ratio) {
+            ratio = attemptRatio;
+        }
+        if (ratio <= 1. + kTestBenchmarkRegressionTolerance) {
+            break;
+        }
+    }
+    return ratio;
+}
+
+#pragma mark Static functions
+
+// Maps device classes to dictionaries mapping "<name>/<size>" to the median in milliseconds
+static NSDictionary *TestBenchmarkBaseline(void)
+{
+    static NSDictionary *s_baseline = nil;
+    if (! s_baseline) {
+        NSString *baselineFilePath = [[NSBundle mainBundle] pathForResource:@"BenchmarkBaseline" ofType:@"plist"];
+        s_baseline = [[NSDictionary alloc] initWithContentsOfFile:baselineFilePath];
+        if (! s_baseline) {
+            s_baseline = [[NSDictionary alloc] init];
+        }
+    }
+    return s_baseline;
+}
+
+static int TestBenchmarkCompareTimes(const void *time1, const void *time2)
+{
+    double value1 = *(const double *)time1;
+    double value2 = *(const double *)time2;
+    if (value1 < value2) {
+        return -1;
+    }
+    else if (value1 > value2) {
+        return 1;
+    }
+    else {
+        return 0;
+    }
+}
@@ -0,0 +1,20 @@
+//
+//  TestLocalizedBundles.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Create a bundle in the temporary directory, containing strings tables for the current localization. The table
+ * dictionary maps table names to dictionaries of localized strings. If precompiled is set to YES, precompiled tables
+ * are written instead of strings files. Each bundle name must be used only once per test run, since bundles and
+ * their tables are cached
+ */
+NSBundle *TestLocalizedBundle(NSString *name, NSDictionary *tableNameToStringsMap, BOOL precompiled);
+
+/**
+ * Remove a bundle created with TestLocalizedBundle()
+ */
+void TestRemoveLocalizedBundle(NSBundle *bundle);
@@ -0,0 +1,43 @@
+//
+//  TestLocalizedBundles.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "TestLocalizedBundles.h"
+
+#import "HLSStringsTable.h"
+
+NSBundle *TestLocalizedBundle(NSString *name, NSDictionary *tableNameToStringsMap, BOOL precompiled)
+{
+    NSString *bundlePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"bundle"]];
+    NSString *lprojPath = [bundlePath stringByAppendingPathComponent:[[NSBundle localization] stringByAppendingPathExtension:@"lproj"]];
+    
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager removeItemAtPath:bundlePath error:NULL];
+    if (! [fileManager createDirectoryAtPath:lprojPath withIntermediateDirectories:YES attributes:nil error:NULL]) {
+        return nil;
+    }
+    
+    for (NSString *tableName in [tableNameToStringsMap allKeys]) {
+        NSDictionary *strings = [tableNameToStringsMap objectForKey:tableName];
+        if (precompiled) {
+            NSString *tablePath = [[lprojPath stringByAppendingPathComponent:tableName] stringByAppendingPathExtension:HLSStringsTableFileExtension];
+            [[HLSStringsTable dataWithStringsDictionary:strings] writeToFile:tablePath atomically:YES];
+        }
+        else {
+            // Property lists are valid strings files
+            NSString *tablePath = [[lprojPath stringByAppendingPathComponent:tableName] stringByAppendingPathExtension:@"strings"];
+            [strings writeToFile:tablePath atomically:YES];
+        }
+    }
+    
+    return [NSBundle bundleWithPath:bundlePath];
+}
+
+void TestRemoveLocalizedBundle(NSBundle *bundle)
+{
+    [[NSFileManager defaultManager] removeItemAtPath:[bundle bundlePath] error:NULL];
+}
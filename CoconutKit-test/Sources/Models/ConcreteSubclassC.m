@@ -4,6 +4,14 @@
 
 @implementation ConcreteSubclassC
 
+#pragma mark Concurrent validation
+
+// All individual checks only depend on the value they receive
++ (BOOL)allowsConcurrentFieldChecks
+{
+    return YES;
+}
+
 #pragma mark Individual validations
 
 // noValidationNumberC: No validation constraints, neither in the code, nor in the xcdatamodel
@@ -0,0 +1,18 @@
+//
+//  HLSTaskBenchmarkTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Benchmarks for the Task subsystem. Each result is printed on the standard output as a single JSON object line
+ * prefixed with "HLSBenchmark: ", e.g.
+ *   HLSBenchmark: {"name": "task.submit", "size": 5000, "value": 123456.789, "unit": "tasks/s"}
+ * so that results can be extracted from the test logs (grep) and compared between CoconutKit versions. Figures
+ * are only meaningful when compared on the same device, with a release build
+ */
+@interface HLSTaskBenchmarkTestCase : GHTestCase
+
+@end
@@ -0,0 +1,252 @@
+//
+//  HLSTaskBenchmarkTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskBenchmarkTestCase.h"
+
+#import "HLSTask+Friend.h"
+#import "HLSTaskGroup+Friend.h"
+#import "TestBenchmarks.h"
+
+#define kBenchmarkGroupSizeCount            3
+
+static const NSUInteger kBenchmarkTaskCount = 500;
+static const NSUInteger kBenchmarkGroupSizes[kBenchmarkGroupSizeCount] = { 10, 100, 1000 };
+static const NSUInteger kBenchmarkDependencyLayerCount = 10;
+static const NSUInteger kBenchmarkDependencyLayerWidth = 5;
+static const NSUInteger kBenchmarkRunCount = 5;
+static const NSUInteger kBenchmarkDeliveryRunCount = 100;
+
+@interface BenchmarkTask : HLSTask
+
+@end
+
+@interface BenchmarkTaskOperation : HLSTaskOperation
+
+@end
+
+@interface BenchmarkTaskDelegate : NSObject <HLSTaskDelegate> {
+@private
+    HLSTaskManager *m_taskManager;
+    NSUInteger m_nbrFinishedTasks;
+}
+
+- (id)initWithTaskManager:(HLSTaskManager *)taskManager;
+
+@property (nonatomic, readonly, assign) NSUInteger nbrFinishedTasks;
+
+@end
+
+// Static functions
+static void HLSBenchmarkWaitForFinishedTasks(BenchmarkTaskDelegate *delegate, NSUInteger nbrTasks);
+
+@implementation HLSTaskBenchmarkTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Task operations notify the thread they were submitted from, which must therefore run its run loop
+    return YES;
+}
+
+#pragma mark Benchmarks
+
+- (void)testSubmitAndCancel
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    BenchmarkTaskDelegate *delegate = [[BenchmarkTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    // Operations start running as soon as they are submitted, some tasks are therefore already processed when they
+    // are cancelled. Each task must nevertheless be reported exactly once, either as processed or as cancelled
+    __block NSUInteger nbrTasks = 0;
+    TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+        NSMutableArray *tasks = [NSMutableArray array];
+        for (NSUInteger i = 0; i < kBenchmarkTaskCount; ++i) {
+            [tasks addObject:[[[BenchmarkTask alloc] init] autorelease]];
+        }
+        [taskManager registerDelegate:delegate forTasks:tasks];
+        
+        [taskManager submitTasks:tasks];
+        [taskManager cancelTasks:tasks];
+        
+        nbrTasks += kBenchmarkTaskCount;
+        HLSBenchmarkWaitForFinishedTasks(delegate, nbrTasks);
+    });
+    GHAssertEquals(delegate.nbrFinishedTasks, nbrTasks, nil);
+    TestBenchmarkReportTimes(@"task.submitAndCancel", kBenchmarkTaskCount, times);
+    
+    // The delegate must die before the (autoreleased) manager
+    [delegate release];
+}
+
+- (void)testDelegateDelivery
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    BenchmarkTaskDelegate *delegate = [[BenchmarkTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    // Tasks are submitted one by one, so that the time needed to be notified is not dominated by the backlog
+    __block NSUInteger nbrTasks = 0;
+    TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkDeliveryRunCount, ^{
+        BenchmarkTask *task = [[[BenchmarkTask alloc] init] autorelease];
+        [taskManager registerDelegate:delegate forTask:task];
+        [taskManager submitTask:task];
+        
+        ++nbrTasks;
+        HLSBenchmarkWaitForFinishedTasks(delegate, nbrTasks);
+    });
+    GHAssertEquals(delegate.nbrFinishedTasks, nbrTasks, nil);
+    TestBenchmarkReportTimes(@"task.delegateDelivery", 1, times);
+    
+    [delegate release];
+}
+
+- (void)testGroupAggregationCost
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    for (NSUInteger i = 0; i < kBenchmarkGroupSizeCount; ++i) {
+        NSUInteger groupSize = kBenchmarkGroupSizes[i];
+        HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+        NSMutableArray *tasks = [NSMutableArray array];
+        for (NSUInteger j = 0; j < groupSize; ++j) {
+            BenchmarkTask *task = [[[BenchmarkTask alloc] init] autorelease];
+            [taskGroup addTask:task];
+            [tasks addObject:task];
+        }
+        
+        // Each task reports its progress once, the group status being refreshed after each update (as the manager does)
+        TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+            for (BenchmarkTask *task in tasks) {
+                task.progress = 0.5f;
+                [taskGroup updateStatus];
+            }
+        });
+        GHAssertTrue(floateq(taskGroup.progress, 0.5f), nil);
+        TestBenchmarkReportTimes(@"group.aggregation", groupSize, times);
+    }
+}
+
+- (void)testDependencyGraphSchedulingOverhead
+{
+    if (! TestBenchmarksEnabled()) {
+        return;
+    }
+    
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    
+    // The same number of tasks, first without dependencies, then as layers each depending on the previous one
+    for (NSUInteger k = 0; k < 2; ++k) {
+        BOOL withDependencies = (k == 1);
+        
+        TestBenchmarkTimes times = TestBenchmarkMeasure(kBenchmarkRunCount, ^{
+            HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+            NSArray *previousLayer = nil;
+            for (NSUInteger i = 0; i < kBenchmarkDependencyLayerCount; ++i) {
+                NSMutableArray *layer = [NSMutableArray array];
+                for (NSUInteger j = 0; j < kBenchmarkDependencyLayerWidth; ++j) {
+                    BenchmarkTask *task = [[[BenchmarkTask alloc] init] autorelease];
+                    [taskGroup addTask:task];
+                    if (withDependencies) {
+                        for (BenchmarkTask *dependency in previousLayer) {
+                            [taskGroup addDependencyForTask:task onTask:dependency strong:NO];
+                        }
+                    }
+                    [layer addObject:task];
+                }
+                previousLayer = layer;
+            }
+            
+            [taskManager submitTaskGroup:taskGroup];
+            
+            NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:60.];
+            while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+                [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+            }
+            GHAssertTrue(taskGroup.finished, nil);
+        });
+        TestBenchmarkReportTimes(withDependencies ? @"group.dependencies" : @"group.independent",
+                                 kBenchmarkDependencyLayerCount * kBenchmarkDependencyLayerWidth,
+                                 times);
+    }
+}
+
+@end
+
+@implementation BenchmarkTask
+
+- (Class)operationClass
+{
+    return [BenchmarkTaskOperation class];
+}
+
+@end
+
+@implementation BenchmarkTaskOperation
+
+- (void)operationMain
+{
+    // No work, so that only the cost of the task machinery is measured
+}
+
+@end
+
+@implementation BenchmarkTaskDelegate
+
+#pragma mark Object creation and destruction
+
+- (id)initWithTaskManager:(HLSTaskManager *)taskManager
+{
+    if ((self = [super init])) {
+        m_taskManager = taskManager;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_taskManager unregisterDelegate:self];
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize nbrFinishedTasks = m_nbrFinishedTasks;
+
+#pragma mark HLSTaskDelegate protocol implementation
+
+- (void)taskHasBeenProcessed:(HLSTask *)task
+{
+    ++m_nbrFinishedTasks;
+}
+
+- (void)taskHasBeenCancelled:(HLSTask *)task
+{
+    ++m_nbrFinishedTasks;
+}
+
+@end
+
+#pragma mark Static functions
+
+static void HLSBenchmarkWaitForFinishedTasks(BenchmarkTaskDelegate *delegate, NSUInteger nbrTasks)
+{
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:60.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && delegate.nbrFinishedTasks != nbrTasks) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+}
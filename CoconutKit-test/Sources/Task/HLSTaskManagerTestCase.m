@@ -0,0 +1,825 @@
+//
+//  HLSTaskManagerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskManagerTestCase.h"
+
+#import "HLSTask+Friend.h"
+#import "HLSTaskGroup+Friend.h"
+#import "HLSTaskManager+Friend.h"
+
+static const NSUInteger kStressTaskCount = 500;
+static const NSUInteger kStressDelegateCount = 50;
+
+static NSUInteger s_nbrExecutedOperations = 0;
+static volatile BOOL s_gateOpen = NO;
+
+@interface StressTask : HLSTask
+
+@end
+
+@interface StressTaskOperation : HLSTaskOperation
+
+@end
+
+@interface StressTaskDelegate : NSObject <HLSTaskDelegate, HLSTaskManagerDelegate> {
+@private
+    HLSTaskManager *m_taskManager;
+    NSUInteger m_nbrProcessedTasks;
+    NSUInteger m_nbrCancelledTasks;
+    NSUInteger m_nbrReachedLimits;
+    HLSTask *m_lastProcessedTask;
+}
+
+- (id)initWithTaskManager:(HLSTaskManager *)taskManager;
+
+@property (nonatomic, readonly, assign) NSUInteger nbrProcessedTasks;
+@property (nonatomic, readonly, assign) NSUInteger nbrCancelledTasks;
+@property (nonatomic, readonly, assign) NSUInteger nbrReachedLimits;
+@property (nonatomic, retain) HLSTask *lastProcessedTask;
+
+@end
+
+@implementation HLSTaskManagerTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // Task operations notify the thread they were submitted from, which must therefore run its run loop
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testDelegateRegistrationStress
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        [tasks addObject:[[[StressTask alloc] init] autorelease]];
+    }
+
+    NSMutableArray *delegates = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kStressDelegateCount; ++i) {
+        // Not autoreleased, so that delegates die as soon as they are removed from the array
+        StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+        [delegates addObject:delegate];
+        [delegate release];
+    }
+
+    // Round-robin registration, then re-registration with another delegate for every other task
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        [taskManager registerDelegate:[delegates objectAtIndex:i % kStressDelegateCount] forTask:[tasks objectAtIndex:i]];
+    }
+    for (NSUInteger i = 0; i < kStressTaskCount; i += 2) {
+        [taskManager registerDelegate:[delegates objectAtIndex:(i + 1) % kStressDelegateCount] forTask:[tasks objectAtIndex:i]];
+    }
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        NSUInteger delegateIndex = (i % 2 == 0) ? (i + 1) % kStressDelegateCount : i % kStressDelegateCount;
+        GHAssertEquals([taskManager delegateForTask:[tasks objectAtIndex:i]], [delegates objectAtIndex:delegateIndex], nil);
+    }
+
+    // Kill half of the delegates. They unregister themselves from their -dealloc method, which previously corrupted
+    // the delegate map since removing the last registration was enough to deallocate a delegate, re-entering the
+    // manager while it was being modified
+    for (NSUInteger i = 0; i < kStressDelegateCount; i += 2) {
+        [delegates replaceObjectAtIndex:i withObject:[NSNull null]];
+    }
+
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        NSUInteger delegateIndex = (i % 2 == 0) ? (i + 1) % kStressDelegateCount : i % kStressDelegateCount;
+        id delegate = [delegates objectAtIndex:delegateIndex];
+        if (delegate == [NSNull null]) {
+            GHAssertNil([taskManager delegateForTask:[tasks objectAtIndex:i]], nil);
+        }
+        else {
+            GHAssertEquals([taskManager delegateForTask:[tasks objectAtIndex:i]], delegate, nil);
+        }
+    }
+
+    // Explicit unregistration of all remaining tasks
+    for (HLSTask *task in tasks) {
+        [taskManager unregisterDelegateForTask:task];
+        GHAssertNil([taskManager delegateForTask:task], nil);
+    }
+    
+    // Delegates must die before the (autoreleased) manager
+    [delegates removeAllObjects];
+}
+
+- (void)testSubmissionBurst
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+
+    NSMutableArray *delegates = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kStressDelegateCount; ++i) {
+        StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+        [delegates addObject:delegate];
+        [delegate release];
+    }
+
+    // Submit many tasks while others are still being processed
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        StressTask *task = [[[StressTask alloc] init] autorelease];
+        [taskManager registerDelegate:[delegates objectAtIndex:i % kStressDelegateCount] forTask:task];
+        [taskManager submitTask:task];
+    }
+
+    // Wait until all tasks have been processed
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    NSUInteger nbrProcessedTasks = 0;
+    while ([timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+        nbrProcessedTasks = 0;
+        for (StressTaskDelegate *delegate in delegates) {
+            nbrProcessedTasks += delegate.nbrProcessedTasks;
+        }
+        if (nbrProcessedTasks == kStressTaskCount) {
+            break;
+        }
+    }
+    GHAssertEquals(nbrProcessedTasks, kStressTaskCount, nil);
+
+    for (StressTaskDelegate *delegate in delegates) {
+        GHAssertEquals(delegate.nbrProcessedTasks, kStressTaskCount / kStressDelegateCount, nil);
+    }
+    
+    [delegates removeAllObjects];
+}
+
+- (void)testBatchSubmission
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        [tasks addObject:[[[StressTask alloc] init] autorelease]];
+    }
+    
+    // Duplicates must be ignored
+    [taskManager registerDelegate:delegate forTasks:tasks];
+    [taskManager submitTasks:[tasks arrayByAddingObject:[tasks objectAtIndex:0]]];
+    [taskManager submitTasks:tasks];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && delegate.nbrProcessedTasks != kStressTaskCount) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertEquals(delegate.nbrProcessedTasks, kStressTaskCount, nil);
+    
+    // The delegate must die before the (autoreleased) manager
+    [delegate release];
+}
+
+- (void)testDeduplication
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    
+    NSMutableArray *delegates = [NSMutableArray array];
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 3; ++i) {
+        StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+        [delegates addObject:delegate];
+        [delegate release];
+        
+        StressTask *task = [[[StressTask alloc] init] autorelease];
+        task.deduplicationKey = @"key";
+        [tasks addObject:task];
+        [taskManager registerDelegate:delegate forTask:task];
+    }
+    
+    NSUInteger nbrExecutedOperations = 0;
+    @synchronized([StressTaskOperation class]) {
+        nbrExecutedOperations = s_nbrExecutedOperations;
+    }
+    
+    // Cancelling one of the tasks must not cancel the work needed by the other ones
+    [taskManager submitTask:[tasks objectAtIndex:0]];
+    [taskManager submitTasks:[tasks subarrayWithRange:NSMakeRange(1, 2)]];
+    [taskManager cancelTask:[tasks objectAtIndex:0]];
+    GHAssertTrue([[tasks objectAtIndex:0] isCancelled], nil);
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! ([[tasks objectAtIndex:1] isFinished] && [[tasks objectAtIndex:2] isFinished])) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertEquals([[delegates objectAtIndex:0] nbrProcessedTasks], (NSUInteger)0, nil);
+    GHAssertEquals([[delegates objectAtIndex:1] nbrProcessedTasks], (NSUInteger)1, nil);
+    GHAssertEquals([[delegates objectAtIndex:2] nbrProcessedTasks], (NSUInteger)1, nil);
+    GHAssertTrue(floateq([[tasks objectAtIndex:2] progress], 1.f), nil);
+    @synchronized([StressTaskOperation class]) {
+        GHAssertEquals(s_nbrExecutedOperations, nbrExecutedOperations + 1, nil);
+    }
+    
+    [delegates removeAllObjects];
+}
+
+- (void)testPendingTaskLimit
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    taskManager.delegate = delegate;
+    
+    // Occupy the lane so that no other task can start until the gate is opened
+    s_gateOpen = NO;
+    [taskManager setMaxConcurrentTaskCount:2];
+    for (NSUInteger i = 0; i < 2; ++i) {
+        [taskManager submitTask:[HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+            while (! s_gateOpen) {
+                [NSThread sleepForTimeInterval:0.01];
+            }
+            return (id)nil;
+        }]];
+    }
+    NSDate *gateTimeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([gateTimeoutDate timeIntervalSinceNow] > 0. && [taskManager pendingTaskCount] != 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertEquals([taskManager pendingTaskCount], (NSUInteger)0, nil);
+    taskManager.maxPendingTaskCount = 2;
+    
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 5; ++i) {
+        StressTask *task = [[[StressTask alloc] init] autorelease];
+        task.tag = @"tag";
+        [tasks addObject:task];
+    }
+    [taskManager registerDelegate:delegate forTasks:tasks];
+    
+    [taskManager submitTasks:[tasks subarrayWithRange:NSMakeRange(0, 3)]];
+    GHAssertEquals([taskManager pendingTaskCount], (NSUInteger)2, nil);
+    GHAssertEquals(delegate.nbrReachedLimits, (NSUInteger)1, nil);
+    GHAssertTrue([[tasks objectAtIndex:2] isCancelled], nil);
+    
+    // Make room by dropping the oldest task
+    taskManager.overflowPolicy = HLSTaskOverflowPolicyDropOldestWithSameTag;
+    [taskManager submitTask:[tasks objectAtIndex:3]];
+    GHAssertEquals([taskManager pendingTaskCount], (NSUInteger)2, nil);
+    GHAssertTrue([[tasks objectAtIndex:0] isCancelled], nil);
+    
+    // Wait until there is room
+    s_gateOpen = YES;
+    taskManager.overflowPolicy = HLSTaskOverflowPolicyBlock;
+    [taskManager submitTask:[tasks objectAtIndex:4]];
+    GHAssertFalse([[tasks objectAtIndex:4] isCancelled], nil);
+    GHAssertTrue([taskManager pendingTaskCount] <= 2, nil);
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && delegate.nbrProcessedTasks != 3) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertEquals(delegate.nbrProcessedTasks, (NSUInteger)3, nil);
+    GHAssertEquals(delegate.nbrCancelledTasks, (NSUInteger)2, nil);
+    GHAssertEquals(delegate.nbrReachedLimits, (NSUInteger)3, nil);
+    
+    // The delegate must die before the (autoreleased) manager
+    taskManager.delegate = nil;
+    [delegate release];
+}
+
+- (void)testCancellationToken
+{
+    HLSCancellationToken *cancellationToken = [[[HLSCancellationToken alloc] init] autorelease];
+    __block NSUInteger nbrCalls = 0;
+    [cancellationToken addCancellationHandler:^{
+        ++nbrCalls;
+    }];
+    id cancellationHandlerRegistration = [cancellationToken addCancellationHandler:^{
+        nbrCalls += 10;
+    }];
+    [cancellationToken removeCancellationHandler:cancellationHandlerRegistration];
+    
+    // Handlers are called once
+    [cancellationToken cancel];
+    [cancellationToken cancel];
+    GHAssertTrue([cancellationToken isCancelled], nil);
+    GHAssertEquals(nbrCalls, (NSUInteger)1, nil);
+    
+    // Called immediately if already cancelled
+    [cancellationToken addCancellationHandler:^{
+        ++nbrCalls;
+    }];
+    GHAssertEquals(nbrCalls, (NSUInteger)2, nil);
+    
+    // Cancelling a running task must directly call the handlers registered by its operation
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    __block volatile BOOL handlerRegistered = NO;
+    HLSBlockTask *task = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        __block volatile BOOL stopped = NO;
+        [operation.cancellationToken addCancellationHandler:^{
+            stopped = YES;
+        }];
+        handlerRegistered = YES;
+        while (! stopped) {
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        return (id)nil;
+    }];
+    [taskManager submitTask:task];
+    GHAssertNotNil(task.cancellationToken, nil);
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! (task.running && handlerRegistered)) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    [taskManager cancelTask:task];
+    GHAssertTrue([task.cancellationToken isCancelled], nil);
+    
+    timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! task.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertTrue(task.finished, nil);
+}
+
+- (void)testCancellationAfterMainEnded
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    __block volatile BOOL mainEnded = NO;
+    HLSBlockTask *task = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        mainEnded = YES;
+        return (id)nil;
+    }];
+    [taskManager registerDelegate:delegate forTask:task];
+    [taskManager submitTask:task];
+    
+    // Do not run the run loop, so that the end of the task stays queued when it is cancelled
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! mainEnded) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    [NSThread sleepForTimeInterval:0.1];
+    [taskManager cancelTask:task];
+    
+    // The queued end must be discarded
+    timeoutDate = [NSDate dateWithTimeIntervalSinceNow:0.5];
+    while ([timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertTrue(task.finished, nil);
+    GHAssertEquals(delegate.nbrCancelledTasks, (NSUInteger)1, nil);
+    GHAssertEquals(delegate.nbrProcessedTasks, (NSUInteger)0, nil);
+    
+    [delegate release];
+}
+
+- (void)testBlockTasks
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    HLSBlockTask *successfulTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        return [NSNumber numberWithInt:42];
+    }];
+    HLSBlockTask *failingTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        *pError = [NSError errorWithDomain:@"ch.hortis.CoconutKit-test" code:1 userInfo:nil];
+        return (id)nil;
+    }];
+    
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    [taskGroup addTask:successfulTask];
+    [taskGroup addTask:failingTask];
+    [taskManager registerDelegate:delegate forTasks:[NSArray arrayWithObjects:successfulTask, failingTask, nil]];
+    [taskManager submitTaskGroup:taskGroup];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    GHAssertEquals(delegate.nbrProcessedTasks, (NSUInteger)2, nil);
+    GHAssertEqualObjects(successfulTask.result, [NSNumber numberWithInt:42], nil);
+    GHAssertNil(failingTask.result, nil);
+    GHAssertNotNil(failingTask.error, nil);
+    GHAssertEquals(taskGroup.nbrFailures, (NSUInteger)1, nil);
+    
+    [delegate release];
+}
+
+- (void)testEventRecycling
+{
+    // Several rounds, so that the events recycled during a round are reused by the next one
+    for (NSUInteger round = 0; round < 3; ++round) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        
+        HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+        HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+        NSObject *sentinel = [[[NSObject alloc] init] autorelease];
+        NSMutableArray *tasks = [NSMutableArray array];
+        for (NSUInteger i = 0; i < 100; ++i) {
+            NSInteger code = round * 100 + i;
+            HLSBlockTask *task = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+                [operation updateProgressToValue:0.5f];
+                *pError = [NSError errorWithDomain:@"ch.hortis.CoconutKit-test" 
+                                              code:code 
+                                          userInfo:[NSDictionary dictionaryWithObject:sentinel forKey:@"sentinel"]];
+                return (id)nil;
+            }];
+            [taskGroup addTask:task];
+            [tasks addObject:task];
+        }
+        [taskManager submitTaskGroup:taskGroup];
+        
+        NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+        while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+            [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        }
+        GHAssertTrue(taskGroup.finished, nil);
+        
+        // Each task must have received its own error, not one delivered by a recycled event
+        for (NSUInteger i = 0; i < [tasks count]; ++i) {
+            HLSTask *task = [tasks objectAtIndex:i];
+            GHAssertEquals([task.error code], (NSInteger)(round * 100 + i), nil);
+        }
+        
+        HLSZeroingWeakRef *sentinelWeakRef = [[HLSZeroingWeakRef alloc] initWithObject:sentinel];
+        [pool drain];
+        
+        // Recycled events must not keep the objects they delivered alive. Operations might still be waiting to be
+        // released by pending drains
+        NSDate *releaseTimeoutDate = [NSDate dateWithTimeIntervalSinceNow:5.];
+        while ([releaseTimeoutDate timeIntervalSinceNow] > 0. && sentinelWeakRef.object) {
+            [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        }
+        GHAssertNil(sentinelWeakRef.object, nil);
+        [sentinelWeakRef release];
+    }
+}
+
+- (void)testOutputHandOff
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    
+    NSObject *output = [[[NSObject alloc] init] autorelease];
+    HLSBlockTask *producerTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        return (id)output;
+    }];
+    HLSBlockTask *consumerTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        return [operation outputOfTask:producerTask];
+    }];
+    
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    [taskGroup addTask:producerTask];
+    [taskGroup addTask:consumerTask];
+    [taskGroup addDependencyForTask:consumerTask onTask:producerTask strong:YES];
+    [taskManager submitTaskGroup:taskGroup];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    // The very same object must have been received, and released once not needed anymore
+    GHAssertTrue(consumerTask.result == output, nil);
+    GHAssertNil([taskGroup outputForTask:producerTask], nil);
+}
+
+- (void)testJournal
+{
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HLSTaskManagerTestCase.journal"];
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:NULL];
+    
+    // Records survive reopening the journal
+    HLSTaskJournal *journal = [[[HLSTaskJournal alloc] initWithFilePath:filePath] autorelease];
+    [journal recordCompletionForKey:@"first" returnInfo:[NSDictionary dictionaryWithObject:@"value" forKey:@"key"]];
+    journal = [[[HLSTaskJournal alloc] initWithFilePath:filePath] autorelease];
+    GHAssertTrue([journal containsEntryForKey:@"first"], nil);
+    GHAssertFalse([journal containsEntryForKey:@"second"], nil);
+    
+    // Tasks already recorded are not processed again
+    __block BOOL firstTaskExecuted = NO;
+    __block BOOL secondTaskExecuted = NO;
+    HLSBlockTask *firstTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        firstTaskExecuted = YES;
+        return (id)nil;
+    }];
+    firstTask.journalKey = @"first";
+    HLSBlockTask *secondTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        secondTaskExecuted = YES;
+        return (id)nil;
+    }];
+    secondTask.journalKey = @"second";
+    
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    taskGroup.journal = journal;
+    [taskGroup addTask:firstTask];
+    [taskGroup addTask:secondTask];
+    [taskGroup addDependencyForTask:secondTask onTask:firstTask strong:YES];
+    
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    [taskManager registerDelegate:delegate forTasks:[NSArray arrayWithObjects:firstTask, secondTask, nil]];
+    [taskManager submitTaskGroup:taskGroup];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! taskGroup.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    GHAssertFalse(firstTaskExecuted, nil);
+    GHAssertEqualObjects([firstTask.returnInfo objectForKey:@"key"], @"value", nil);
+    GHAssertTrue(secondTaskExecuted, nil);
+    
+    // Skipped tasks are reported as processed, and their delegates unregistered
+    GHAssertEquals(delegate.nbrProcessedTasks, (NSUInteger)2, nil);
+    GHAssertNil([taskManager delegateForTask:firstTask], nil);
+    GHAssertNil([taskManager delegateForTask:secondTask], nil);
+    
+    // Nothing to resume after a successful run
+    GHAssertEquals([journal count], (NSUInteger)0, nil);
+    
+    // Nothing to resume after a cancellation either (the end of the task cannot be delivered before the run loop runs)
+    [journal recordCompletionForKey:@"first" returnInfo:nil];
+    HLSTaskGroup *cancelledTaskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    cancelledTaskGroup.journal = journal;
+    [cancelledTaskGroup addTask:[[[StressTask alloc] init] autorelease]];
+    [taskManager submitTaskGroup:cancelledTaskGroup];
+    [taskManager cancelTaskGroup:cancelledTaskGroup];
+    GHAssertEquals([journal count], (NSUInteger)0, nil);
+    
+    timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! cancelledTaskGroup.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    // The delegate must die before the (autoreleased) manager
+    [delegate release];
+    
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:NULL];
+}
+
+- (void)testTrace
+{
+    HLSTaskTrace *trace = [[[HLSTaskTrace alloc] initWithCapacity:8] autorelease];
+    StressTask *task = [[[StressTask alloc] init] autorelease];
+    task.tag = @"\"quoted\"";
+    
+    // The ring buffer only keeps the most recent events
+    for (NSUInteger i = 0; i < 20; ++i) {
+        [trace recordEventWithType:HLSTaskTraceEventTypeProgressUpdated forTask:task progress:i / 20.f];
+    }
+    GHAssertEquals([trace count], (NSUInteger)8, nil);
+    
+    NSString *jsonString = [trace chromeTraceJSONString];
+    GHAssertTrue([jsonString hasPrefix:@"{\"traceEvents\":["], nil);
+    GHAssertTrue([jsonString rangeOfString:@"\\\"quoted\\\""].location != NSNotFound, nil);
+    
+    [trace clear];
+    GHAssertEquals([trace count], (NSUInteger)0, nil);
+    
+    // Tasks processed by a manager are traced
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    taskManager.trace = [[[HLSTaskTrace alloc] init] autorelease];
+    [taskManager submitTask:task];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! task.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    // Submitted, dequeued, main started, 10 progress updates, main ended, delegate delivered
+    GHAssertEquals([taskManager.trace count], (NSUInteger)15, nil);
+}
+
+- (void)testWatchdog
+{
+    HLSTaskWatchdog *watchdog = [[[HLSTaskWatchdog alloc] initWithThreshold:0.1] autorelease];
+    [watchdog recordCallbackOfDelegate:self withSelector:@selector(taskHasBeenProcessed:) duration:0.01];
+    [watchdog recordCallbackOfDelegate:self withSelector:@selector(taskHasBeenProcessed:) duration:0.5];
+    [watchdog recordCallbackOfDelegate:self withSelector:@selector(taskHasBeenProcessed:) duration:0.2];
+    GHAssertEquals([watchdog nbrCallbacks], (NSUInteger)3, nil);
+    GHAssertEquals([watchdog nbrStalls], (NSUInteger)2, nil);
+    
+    NSString *callback = [NSString stringWithFormat:@"-[%@ taskHasBeenProcessed:]", [self class]];
+    GHAssertEquals([[[watchdog stallCounts] objectForKey:callback] unsignedIntegerValue], (NSUInteger)2, nil);
+    GHAssertEqualsWithAccuracy([[[watchdog maxDurations] objectForKey:callback] doubleValue], 0.5, 1e-6, nil);
+    
+    [watchdog reset];
+    GHAssertEquals([watchdog nbrCallbacks], (NSUInteger)0, nil);
+    
+    // Callbacks received by the delegates of a manager are measured
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    taskManager.watchdog = watchdog;
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    
+    StressTask *task = [[[StressTask alloc] init] autorelease];
+    [taskManager registerDelegate:delegate forTask:task];
+    [taskManager submitTask:task];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! task.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    GHAssertTrue([watchdog nbrCallbacks] != 0, nil);
+    
+    [delegate release];
+}
+
+- (void)testQueueDelegateDelivery
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    StressTaskDelegate *delegate = [[StressTaskDelegate alloc] initWithTaskManager:taskManager];
+    dispatch_queue_t queue = dispatch_queue_create("ch.hortis.CoconutKit-test.delegate", NULL);
+    
+    StressTask *task = [[[StressTask alloc] init] autorelease];
+    task.tag = @"queued";
+    [taskManager registerDelegate:delegate forTask:task queue:queue];
+    [taskManager submitTask:task];
+    
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0. && ! task.finished) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    }
+    
+    // Let the queue drain before checking
+    dispatch_sync(queue, ^{});
+    GHAssertEquals(delegate.nbrProcessedTasks, (NSUInteger)1, nil);
+    
+    // The delegate receives a snapshot of the task status when it was processed
+    HLSTask *processedTask = delegate.lastProcessedTask;
+    GHAssertTrue(processedTask != task, nil);
+    GHAssertEqualObjects(processedTask.tag, @"queued", nil);
+    GHAssertTrue(processedTask.finished, nil);
+    
+    dispatch_release(queue);
+    [delegate release];
+}
+
+- (void)testDependencyCycles
+{
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    StressTask *task1 = [[[StressTask alloc] init] autorelease];
+    StressTask *task2 = [[[StressTask alloc] init] autorelease];
+    StressTask *task3 = [[[StressTask alloc] init] autorelease];
+    [taskGroup addTask:task1];
+    [taskGroup addTask:task2];
+    [taskGroup addTask:task3];
+    
+    // Chain: task3 -> task2 -> task1
+    [taskGroup addDependencyForTask:task3 onTask:task2 strong:NO];
+    [taskGroup addDependencyForTask:task2 onTask:task1 strong:YES];
+    GHAssertEquals([taskGroup criticalPathLengthForTask:task1], (NSUInteger)3, nil);
+    GHAssertEquals([taskGroup criticalPathLengthForTask:task2], (NSUInteger)2, nil);
+    GHAssertEquals([taskGroup criticalPathLengthForTask:task3], (NSUInteger)1, nil);
+    
+    // Closing the loop must be rejected
+    [taskGroup addDependencyForTask:task1 onTask:task3 strong:NO];
+    GHAssertEquals([[taskGroup dependenciesForTask:task1] count], (NSUInteger)0, nil);
+    [taskGroup addDependencyForTask:task1 onTask:task1 strong:NO];
+    GHAssertEquals([[taskGroup dependenciesForTask:task1] count], (NSUInteger)0, nil);
+}
+
+- (void)testTagLookup
+{
+    HLSTaskManager *taskManager = [[[HLSTaskManager alloc] init] autorelease];
+    
+    // Tags are captured at submission, the task run loop is not running yet so that no task can end meanwhile
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        StressTask *task = [[[StressTask alloc] init] autorelease];
+        task.tag = [NSString stringWithFormat:@"tag_%d", i % 5];
+        [taskManager submitTask:task];
+    }
+    GHAssertEquals([[taskManager tasksWithTag:@"tag_0"] count], kStressTaskCount / 5, nil);
+    GHAssertEquals([[taskManager tasksWithTag:@"tag_"] count], (NSUInteger)0, nil);
+    GHAssertEquals([[taskManager tasksWithTag:nil] count], (NSUInteger)0, nil);
+    
+    [taskManager cancelTasksWithTag:@"tag_1"];
+    
+    // Wait until all tasks have ended
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:30.];
+    while ([timeoutDate timeIntervalSinceNow] > 0.) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+        
+        NSUInteger nbrRemainingTasks = 0;
+        for (NSUInteger i = 0; i < 5; ++i) {
+            nbrRemainingTasks += [[taskManager tasksWithTag:[NSString stringWithFormat:@"tag_%d", i]] count];
+        }
+        if (nbrRemainingTasks == 0) {
+            break;
+        }
+    }
+    GHAssertEquals([[taskManager tasksWithTag:@"tag_0"] count], (NSUInteger)0, nil);
+    GHAssertEquals([[taskManager tasksWithTag:@"tag_1"] count], (NSUInteger)0, nil);
+}
+
+- (void)testTaskGroupStatusAggregation
+{
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    NSMutableArray *tasks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        StressTask *task = [[[StressTask alloc] init] autorelease];
+        [taskGroup addTask:task];
+        [tasks addObject:task];
+    }
+    [taskGroup reset];
+    
+    // Half of the tasks succeed, the other half fails halfway
+    for (NSUInteger i = 0; i < kStressTaskCount; ++i) {
+        HLSTask *task = [tasks objectAtIndex:i];
+        if (i % 2 == 0) {
+            task.progress = 1.f;
+        }
+        else {
+            task.progress = 0.5f;
+            task.error = [NSError errorWithDomain:@"ch.hortis.CoconutKit-test" code:i userInfo:nil];
+        }
+        task.finished = YES;
+        [taskGroup updateStatus];
+    }
+    GHAssertTrue(taskGroup.finished, nil);
+    GHAssertEquals(taskGroup.nbrFailures, kStressTaskCount / 2, nil);
+    GHAssertTrue(floateq(taskGroup.progress, 0.75f), nil);
+    
+    // Resetting a task must be reflected as well
+    [[tasks objectAtIndex:1] reset];
+    [taskGroup updateStatus];
+    GHAssertFalse(taskGroup.finished, nil);
+    GHAssertEquals(taskGroup.nbrFailures, kStressTaskCount / 2 - 1, nil);
+}
+
+@end
+
+@implementation StressTask
+
+- (Class)operationClass
+{
+    return [StressTaskOperation class];
+}
+
+@end
+
+@implementation StressTaskOperation
+
+- (void)operationMain
+{
+    @synchronized([StressTaskOperation class]) {
+        ++s_nbrExecutedOperations;
+    }
+    
+    for (NSUInteger i = 0; i < 10; ++i) {
+        [self updateProgressToValue:i / 10.f];
+    }
+}
+
+@end
+
+@implementation StressTaskDelegate
+
+#pragma mark Object creation and destruction
+
+- (id)initWithTaskManager:(HLSTaskManager *)taskManager
+{
+    if ((self = [super init])) {
+        m_taskManager = taskManager;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_taskManager unregisterDelegate:self];
+    self.lastProcessedTask = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize nbrProcessedTasks = m_nbrProcessedTasks;
+
+@synthesize nbrCancelledTasks = m_nbrCancelledTasks;
+
+@synthesize nbrReachedLimits = m_nbrReachedLimits;
+
+@synthesize lastProcessedTask = m_lastProcessedTask;
+
+#pragma mark HLSTaskDelegate protocol implementation
+
+- (void)taskHasBeenProcessed:(HLSTask *)task
+{
+    ++m_nbrProcessedTasks;
+    self.lastProcessedTask = task;
+}
+
+- (void)taskHasBeenCancelled:(HLSTask *)task
+{
+    ++m_nbrCancelledTasks;
+}
+
+#pragma mark HLSTaskManagerDelegate protocol implementation
+
+- (void)taskManagerHasReachedMaxPendingTaskCount:(HLSTaskManager *)taskManager
+{
+    ++m_nbrReachedLimits;
+}
+
+@end
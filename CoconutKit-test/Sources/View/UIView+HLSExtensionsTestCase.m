@@ -26,4 +26,55 @@
     GHAssertNotNil(segmentedControl.userInfo_hls, @"user info");
 }
 
+- (void)testViewWithTag
+{
+    UIView *view = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
+    view.tag_hls = @"root";
+    UIView *subview = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
+    [view addSubview:subview];
+    UIView *subsubview = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
+    subsubview.tag_hls = @"leaf";
+    [subview addSubview:subsubview];
+    
+    GHAssertEquals([view viewWithTag_hls:@"root"], view, nil);
+    GHAssertEquals([view viewWithTag_hls:@"leaf"], subsubview, nil);
+    GHAssertNil([subsubview viewWithTag_hls:@"root"], nil);
+    GHAssertNil([view viewWithTag_hls:@"missing"], nil);
+}
+
+- (void)testViewWithTagInIndexedWindow
+{
+    UIWindow *window = [[[UIWindow alloc] initWithFrame:CGRectZero] autorelease];
+    UIView *view1 = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
+    view1.tag_hls = @"view1";
+    [window addSubview:view1];
+    
+    window.tagIndexEnabled_hls = YES;
+    GHAssertTrue(window.tagIndexEnabled_hls, nil);
+    
+    // Indexed when the index is enabled
+    GHAssertEquals([window viewWithTag_hls:@"view1"], view1, nil);
+    
+    // Indexed when added to the window
+    UIView *view2 = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
+    view2.tag_hls = @"view2";
+    [view1 addSubview:view2];
+    GHAssertEquals([window viewWithTag_hls:@"view2"], view2, nil);
+    GHAssertEquals([view1 viewWithTag_hls:@"view2"], view2, nil);
+    GHAssertNil([view2 viewWithTag_hls:@"view1"], nil);
+    
+    // Tag changes
+    view2.tag_hls = @"renamed";
+    GHAssertNil([window viewWithTag_hls:@"view2"], nil);
+    GHAssertEquals([window viewWithTag_hls:@"renamed"], view2, nil);
+    
+    // Removal from the window
+    [view2 removeFromSuperview];
+    GHAssertNil([window viewWithTag_hls:@"renamed"], nil);
+    
+    window.tagIndexEnabled_hls = NO;
+    GHAssertFalse(window.tagIndexEnabled_hls, nil);
+    GHAssertEquals([window viewWithTag_hls:@"view1"], view1, nil);
+}
+
 @end
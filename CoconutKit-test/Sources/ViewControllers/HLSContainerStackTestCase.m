@@ -0,0 +1,102 @@
+//
+//  HLSContainerStackTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSContainerStackTestCase.h"
+
+// Static functions
+static UIViewController *HLSViewControllerWithImageOfSize(CGSize size);
+static NSUInteger HLSLocationOfString(NSString *string, NSString *searchedString);
+
+@implementation HLSContainerStackTestCase
+
+#pragma mark Tests
+
+- (void)testFootprintReport
+{
+    UIViewController *containerViewController = [[[UIViewController alloc] init] autorelease];
+    HLSContainerStack *containerStack = [[[HLSContainerStack alloc] initWithContainerViewController:containerViewController
+                                                                                           capacity:HLSContainerStackUnlimitedCapacity
+                                                                                           removing:NO
+                                                                            rootViewControllerFixed:NO] autorelease];
+    
+    UIViewController *smallViewController = HLSViewControllerWithImageOfSize(CGSizeMake(10.f, 10.f));
+    UIViewController *largeViewController = HLSViewControllerWithImageOfSize(CGSizeMake(100.f, 100.f));
+    UIViewController *unloadedViewController = [[[UIViewController alloc] init] autorelease];
+    [containerStack pushViewController:smallViewController withTransitionClass:[HLSTransitionNone class] duration:0. animated:NO];
+    [containerStack pushViewController:largeViewController withTransitionClass:[HLSTransitionNone class] duration:0. animated:NO];
+    [containerStack pushViewController:unloadedViewController withTransitionClass:[HLSTransitionNone class] duration:0. animated:NO];
+    
+    CGImageRef smallImage = (CGImageRef)smallViewController.view.layer.contents;
+    CGImageRef largeImage = (CGImageRef)largeViewController.view.layer.contents;
+    NSUInteger expectedFootprint = CGImageGetBytesPerRow(smallImage) * CGImageGetHeight(smallImage)
+        + CGImageGetBytesPerRow(largeImage) * CGImageGetHeight(largeImage);
+    GHAssertEquals([containerStack estimatedViewFootprint], expectedFootprint, nil);
+    
+    // The container is not displayed: Loaded views are offscreen. View controllers using the most memory come first
+    NSString *report = [containerStack footprintReport];
+    GHAssertTrue(HLSLocationOfString(report, @"estimated for 3 view controllers") != NSNotFound, nil);
+    NSUInteger largeLocation = HLSLocationOfString(report, [NSString stringWithFormat:@"(%p), depth 1: ", largeViewController]);
+    NSUInteger smallLocation = HLSLocationOfString(report, [NSString stringWithFormat:@"(%p), depth 2: ", smallViewController]);
+    NSUInteger unloadedLocation = HLSLocationOfString(report, [NSString stringWithFormat:@"(%p), depth 0: 0.0 KB, not loaded", unloadedViewController]);
+    GHAssertTrue(largeLocation != NSNotFound && smallLocation != NSNotFound && unloadedLocation != NSNotFound, nil);
+    GHAssertTrue(largeLocation < smallLocation && smallLocation < unloadedLocation, nil);
+    GHAssertTrue(HLSLocationOfString(report, @"offscreen") != NSNotFound, nil);
+}
+
+- (void)testGlobalFootprintReport
+{
+    UIViewController *containerViewController1 = [[[UIViewController alloc] init] autorelease];
+    HLSContainerStack *containerStack1 = [HLSContainerStack singleControllerContainerStackWithContainerViewController:containerViewController1];
+    [containerStack1 pushViewController:HLSViewControllerWithImageOfSize(CGSizeMake(10.f, 10.f))
+                    withTransitionClass:[HLSTransitionNone class]
+                               duration:0.
+                               animated:NO];
+    
+    UIViewController *containerViewController2 = [[[UIViewController alloc] init] autorelease];
+    HLSContainerStack *containerStack2 = [HLSContainerStack singleControllerContainerStackWithContainerViewController:containerViewController2];
+    [containerStack2 pushViewController:HLSViewControllerWithImageOfSize(CGSizeMake(100.f, 100.f))
+                    withTransitionClass:[HLSTransitionNone class]
+                               duration:0.
+                               animated:NO];
+    
+    // Stacks using the most memory come first
+    NSString *report = [HLSContainerStack globalFootprintReport];
+    NSUInteger location1 = HLSLocationOfString(report, [containerStack1 footprintReport]);
+    NSUInteger location2 = HLSLocationOfString(report, [containerStack2 footprintReport]);
+    GHAssertTrue(location1 != NSNotFound && location2 != NSNotFound, nil);
+    GHAssertTrue(location2 < location1, nil);
+    
+    // The report is made for memory warnings before any view is unloaded (the views of the stacks are offscreen since
+    // their containers are not displayed)
+    NSString *footprintReport2 = [containerStack2 footprintReport];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification 
+                                                        object:[UIApplication sharedApplication]];
+    NSString *memoryWarningReport = [HLSContainerStack lastMemoryWarningFootprintReport];
+    GHAssertTrue(HLSLocationOfString(memoryWarningReport, footprintReport2) != NSNotFound, nil);
+}
+
+@end
+
+#pragma mark Static functions
+
+static UIViewController *HLSViewControllerWithImageOfSize(CGSize size)
+{
+    UIGraphicsBeginImageContext(size);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    UIViewController *viewController = [[[UIViewController alloc] init] autorelease];
+    viewController.view = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, size.width, size.height)] autorelease];
+    viewController.view.layer.contents = (id)[image CGImage];
+    return viewController;
+}
+
+static NSUInteger HLSLocationOfString(NSString *string, NSString *searchedString)
+{
+    return [string rangeOfString:searchedString].location;
+}
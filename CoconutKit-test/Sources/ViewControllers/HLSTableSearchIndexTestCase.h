@@ -0,0 +1,14 @@
+//
+//  HLSTableSearchIndexTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSTableSearchIndexTestCase : GHTestCase {
+@private
+    
+}
+
+@end
@@ -0,0 +1,97 @@
+//
+//  HLSTableSearchIndexTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTableSearchIndexTestCase.h"
+
+#import "HLSTableSearchIndex.h"
+
+// Static functions
+static NSIndexSet *HLSIndexSetWithIndexes(NSUInteger firstIndex, ...);
+
+@implementation HLSTableSearchIndexTestCase
+
+#pragma mark Tests
+
+- (void)testWords
+{
+    GHAssertEqualObjects([HLSTableSearchIndex wordsInString:@"  Café, au-lait 42 "],
+                         ([NSArray arrayWithObjects:@"Café", @"au", @"lait", @"42", nil]), nil);
+    GHAssertEqualObjects([HLSTableSearchIndex wordsInString:@" ,;- "], [NSArray array], nil);
+    GHAssertEqualObjects([HLSTableSearchIndex wordsInString:nil], [NSArray array], nil);
+}
+
+- (void)testPrefixSearch
+{
+    NSArray *objects = [NSArray arrayWithObjects:@"Crème brûlée", @"Crumble", @"Apple pie", @"Apple crumble", @"Brûlot", nil];
+    HLSTableSearchIndex *searchIndex = [[[HLSTableSearchIndex alloc] init] autorelease];
+    [searchIndex buildWithObjects:objects tokensBlock:^(id object) {
+        return [HLSTableSearchIndex wordsInString:object];
+    }];
+    
+    // Prefixes match case- and diacritic-insensitively
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"cr"], 
+                         HLSIndexSetWithIndexes(0, 1, 3, NSNotFound), nil);
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"BRUL"], 
+                         HLSIndexSetWithIndexes(0, 4, NSNotFound), nil);
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"brûle"], 
+                         [NSIndexSet indexSetWithIndex:0], nil);
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"crumble"], 
+                         HLSIndexSetWithIndexes(1, 3, NSNotFound), nil);
+    
+    // Each word must match a token of the same object, in any order
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"crum app"], 
+                         [NSIndexSet indexSetWithIndex:3], nil);
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"pie crumble"], 
+                         [NSIndexSet indexSet], nil);
+    
+    // Tokens match as prefixes only
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"umble"], 
+                         [NSIndexSet indexSet], nil);
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"zzz"], 
+                         [NSIndexSet indexSet], nil);
+    
+    // A search text without words does not match anything
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@" "], 
+                         [NSIndexSet indexSet], nil);
+}
+
+- (void)testRebuild
+{
+    HLSTableSearchIndex *searchIndex = [[[HLSTableSearchIndex alloc] init] autorelease];
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"a"], [NSIndexSet indexSet], nil);
+    
+    [searchIndex buildWithObjects:[NSArray arrayWithObject:@"alpha"] tokensBlock:^(id object) {
+        return [NSArray arrayWithObject:object];
+    }];
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"a"], [NSIndexSet indexSetWithIndex:0], nil);
+    
+    // Previously indexed objects are discarded
+    [searchIndex buildWithObjects:[NSArray arrayWithObjects:@"beta", @"gamma", @"alpha", nil] tokensBlock:^(id object) {
+        return [NSArray arrayWithObject:object];
+    }];
+    GHAssertEqualObjects([searchIndex objectIndexesMatchingSearchText:@"a"], [NSIndexSet indexSetWithIndex:2], nil);
+}
+
+@end
+
+#pragma mark Static functions
+
+// Index set from a list of indexes terminated by NSNotFound
+static NSIndexSet *HLSIndexSetWithIndexes(NSUInteger firstIndex, ...)
+{
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+    
+    va_list args;
+    va_start(args, firstIndex);
+    for (NSUInteger index = firstIndex; index != NSNotFound; index = va_arg(args, NSUInteger)) {
+        [indexSet addIndex:index];
+    }
+    va_end(args);
+    
+    return [[indexSet copy] autorelease];
+}
@@ -0,0 +1,14 @@
+//
+//  HLSViewControllerLifeCycleProfilerTestCase.h
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface HLSViewControllerLifeCycleProfilerTestCase : GHTestCase {
+@private
+    
+}
+
+@end
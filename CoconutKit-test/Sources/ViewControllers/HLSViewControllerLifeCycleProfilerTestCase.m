@@ -0,0 +1,82 @@
+//
+//  HLSViewControllerLifeCycleProfilerTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSViewControllerLifeCycleProfilerTestCase.h"
+
+@implementation HLSViewControllerLifeCycleProfilerTestCase
+
+#pragma mark Test setup
+
+- (BOOL)shouldRunOnMainThread
+{
+    // The profiler must be used from the main thread
+    return YES;
+}
+
+#pragma mark Tests
+
+- (void)testFirstAppearanceAndReload
+{
+    // Use a separate profiler, so that view controllers displayed meanwhile are not recorded
+    HLSViewControllerLifeCycleProfiler *profiler = [[[HLSViewControllerLifeCycleProfiler alloc] init] autorelease];
+    profiler.enabled = YES;
+    
+    UIViewController *viewController = [[[UIViewController alloc] init] autorelease];
+    [profiler viewControllerDidInitialize:viewController];
+    usleep(20000);
+    [profiler viewControllerDidLoadView:viewController];
+    usleep(10000);
+    [profiler viewControllerDidAppear:viewController];
+    
+    // Only the first appearance is measured
+    [profiler viewControllerDidAppear:viewController];
+    
+    NSDictionary *report = [profiler reportForViewControllerClass:[UIViewController class]];
+    GHAssertEquals([[report objectForKey:HLSViewControllerLifeCycleProfilerAppearanceCountKey] unsignedIntegerValue], 1U, @"Appearances");
+    GHAssertTrue([[report objectForKey:HLSViewControllerLifeCycleProfilerLongestLoadDurationKey] doubleValue] >= 0.02, @"Load");
+    GHAssertTrue([[report objectForKey:HLSViewControllerLifeCycleProfilerLongestAppearanceDurationKey] doubleValue] >= 0.01, @"Appearance");
+    GHAssertTrue([[report objectForKey:HLSViewControllerLifeCycleProfilerLongestTotalDurationKey] doubleValue] >= 0.03, @"Total");
+    GHAssertEquals([[report objectForKey:HLSViewControllerLifeCycleProfilerReloadCountKey] unsignedIntegerValue], 0U, @"Reloads");
+    
+    // A reload is reported separately
+    [profiler viewControllerDidUnloadView:viewController];
+    [profiler viewControllerDidLoadView:viewController];
+    usleep(10000);
+    [profiler viewControllerDidAppear:viewController];
+    
+    report = [profiler reportForViewControllerClass:[UIViewController class]];
+    GHAssertEquals([[report objectForKey:HLSViewControllerLifeCycleProfilerAppearanceCountKey] unsignedIntegerValue], 1U, @"Appearances");
+    GHAssertEquals([[report objectForKey:HLSViewControllerLifeCycleProfilerReloadCountKey] unsignedIntegerValue], 1U, @"Reloads");
+    GHAssertTrue([[report objectForKey:HLSViewControllerLifeCycleProfilerAverageReloadDurationKey] doubleValue] >= 0.01, @"Reload");
+    
+    // Statistics are collected for the exact class
+    GHAssertNil([profiler reportForViewControllerClass:[UITableViewController class]], @"Other class");
+    GHAssertEqualObjects([[profiler reports] allKeys], [NSArray arrayWithObject:NSStringFromClass([UIViewController class])], @"Reports");
+    
+    [profiler reset];
+    GHAssertNil([profiler reportForViewControllerClass:[UIViewController class]], @"Reset");
+}
+
+- (void)testDisabledProfiling
+{
+    HLSViewControllerLifeCycleProfiler *profiler = [[[HLSViewControllerLifeCycleProfiler alloc] init] autorelease];
+    
+    UIViewController *viewController = [[[UIViewController alloc] init] autorelease];
+    [profiler viewControllerDidInitialize:viewController];
+    [profiler viewControllerDidLoadView:viewController];
+    [profiler viewControllerDidAppear:viewController];
+    GHAssertNil([profiler reportForViewControllerClass:[UIViewController class]], @"Disabled");
+    
+    // View controllers initialized while the profiler was disabled are not profiled
+    profiler.enabled = YES;
+    [profiler viewControllerDidLoadView:viewController];
+    [profiler viewControllerDidAppear:viewController];
+    GHAssertNil([profiler reportForViewControllerClass:[UIViewController class]], @"Initialized while disabled");
+}
+
+@end
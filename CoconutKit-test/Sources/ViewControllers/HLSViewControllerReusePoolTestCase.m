@@ -0,0 +1,155 @@
+//
+//  HLSViewControllerReusePoolTestCase.m
+//  CoconutKit-test
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSViewControllerReusePoolTestCase.h"
+
+@interface HLSReusableTestViewController : UIViewController <HLSReusableViewController> {
+@private
+    NSUInteger m_prepareForReuseCount;
+}
+
+@property (nonatomic, readonly, assign) NSUInteger prepareForReuseCount;
+
+@end
+
+@interface HLSOtherReusableTestViewController : HLSReusableTestViewController
+
+@end
+
+// Static functions
+static id HLSViewControllerOfClassWithImageOfSize(Class viewControllerClass, CGSize size);
+
+@implementation HLSViewControllerReusePoolTestCase
+
+#pragma mark Tests
+
+- (void)testEnqueueAndDequeue
+{
+    HLSViewControllerReusePool *reusePool = [[[HLSViewControllerReusePool alloc] init] autorelease];
+    
+    // Only view controllers conforming to HLSReusableViewController are accepted, and only once
+    GHAssertFalse([reusePool enqueueViewController:[[[UIViewController alloc] init] autorelease]], nil);
+    
+    HLSReusableTestViewController *viewController1 = [[[HLSReusableTestViewController alloc] init] autorelease];
+    HLSReusableTestViewController *viewController2 = [[[HLSReusableTestViewController alloc] init] autorelease];
+    GHAssertTrue([reusePool enqueueViewController:viewController1], nil);
+    GHAssertTrue([reusePool enqueueViewController:viewController2], nil);
+    GHAssertFalse([reusePool enqueueViewController:viewController2], nil);
+    GHAssertEquals([reusePool count], (NSUInteger)2, nil);
+    
+    // Dequeued by exact class, most recently enqueued first, and prepared for reuse
+    GHAssertNil([reusePool dequeueViewControllerOfClass:[HLSOtherReusableTestViewController class]], nil);
+    GHAssertEquals([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], viewController2, nil);
+    GHAssertEquals([viewController2 prepareForReuseCount], (NSUInteger)1, nil);
+    GHAssertEquals([viewController1 prepareForReuseCount], (NSUInteger)0, nil);
+    GHAssertEquals([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], viewController1, nil);
+    GHAssertEquals([viewController1 prepareForReuseCount], (NSUInteger)1, nil);
+    GHAssertNil([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], nil);
+    GHAssertEquals([reusePool count], (NSUInteger)0, nil);
+}
+
+- (void)testMaximumCountPerClass
+{
+    HLSViewControllerReusePool *reusePool = [[[HLSViewControllerReusePool alloc] init] autorelease];
+    reusePool.maximumCountPerClass = 2;
+    
+    HLSReusableTestViewController *viewController1 = [[[HLSReusableTestViewController alloc] init] autorelease];
+    HLSReusableTestViewController *viewController2 = [[[HLSReusableTestViewController alloc] init] autorelease];
+    HLSReusableTestViewController *viewController3 = [[[HLSReusableTestViewController alloc] init] autorelease];
+    HLSOtherReusableTestViewController *otherViewController = [[[HLSOtherReusableTestViewController alloc] init] autorelease];
+    [reusePool enqueueViewController:viewController1];
+    [reusePool enqueueViewController:otherViewController];
+    [reusePool enqueueViewController:viewController2];
+    [reusePool enqueueViewController:viewController3];
+    
+    // The oldest view controller of the class has been discarded, other classes are not affected
+    GHAssertEquals([reusePool count], (NSUInteger)3, nil);
+    GHAssertEquals([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], viewController3, nil);
+    GHAssertEquals([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], viewController2, nil);
+    GHAssertNil([reusePool dequeueViewControllerOfClass:[HLSReusableTestViewController class]], nil);
+    GHAssertEquals([reusePool dequeueViewControllerOfClass:[HLSOtherReusableTestViewController class]], otherViewController, nil);
+    
+    // Nothing is kept when the maximum is 0
+    reusePool.maximumCountPerClass = 0;
+    GHAssertFalse([reusePool enqueueViewController:viewController1], nil);
+    GHAssertEquals([reusePool count], (NSUInteger)0, nil);
+}
+
+- (void)testViewFootprintBudget
+{
+    HLSViewControllerReusePool *reusePool = [[[HLSViewControllerReusePool alloc] init] autorelease];
+    
+    HLSReusableTestViewController *viewController1 = HLSViewControllerOfClassWithImageOfSize([HLSReusableTestViewController class], 
+                                                                                             CGSizeMake(100.f, 100.f));
+    HLSOtherReusableTestViewController *viewController2 = HLSViewControllerOfClassWithImageOfSize([HLSOtherReusableTestViewController class], 
+                                                                                                  CGSizeMake(100.f, 100.f));
+    [reusePool enqueueViewController:viewController1];
+    NSUInteger footprint = [reusePool estimatedViewFootprint];
+    GHAssertTrue(footprint != 0, nil);
+    
+    // The views of the oldest view controllers are unloaded first to meet the budget. View controllers are kept
+    reusePool.viewFootprintBudget = footprint;
+    [reusePool enqueueViewController:viewController2];
+    GHAssertEquals([reusePool count], (NSUInteger)2, nil);
+    GHAssertFalse([viewController1 isViewLoaded], nil);
+    GHAssertTrue([viewController2 isViewLoaded], nil);
+    GHAssertEquals([reusePool estimatedViewFootprint], footprint, nil);
+    
+    // Lowering the budget applies immediately
+    reusePool.viewFootprintBudget = 0;
+    GHAssertFalse([viewController2 isViewLoaded], nil);
+    GHAssertEquals([reusePool estimatedViewFootprint], (NSUInteger)0, nil);
+    GHAssertEquals([reusePool count], (NSUInteger)2, nil);
+}
+
+- (void)testMemoryWarning
+{
+    HLSViewControllerReusePool *reusePool = [[[HLSViewControllerReusePool alloc] init] autorelease];
+    [reusePool enqueueViewController:[[[HLSReusableTestViewController alloc] init] autorelease]];
+    [reusePool enqueueViewController:[[[HLSOtherReusableTestViewController alloc] init] autorelease]];
+    GHAssertEquals([reusePool count], (NSUInteger)2, nil);
+    
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidReceiveMemoryWarningNotification 
+                                                        object:[UIApplication sharedApplication]];
+    GHAssertEquals([reusePool count], (NSUInteger)0, nil);
+}
+
+@end
+
+@implementation HLSReusableTestViewController
+
+#pragma mark Accessors and mutators
+
+@synthesize prepareForReuseCount = m_prepareForReuseCount;
+
+#pragma mark HLSReusableViewController protocol implementation
+
+- (void)prepareForReuse
+{
+    ++m_prepareForReuseCount;
+}
+
+@end
+
+@implementation HLSOtherReusableTestViewController
+
+@end
+
+#pragma mark Static functions
+
+static id HLSViewControllerOfClassWithImageOfSize(Class viewControllerClass, CGSize size)
+{
+    UIGraphicsBeginImageContext(size);
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    UIViewController *viewController = [[[viewControllerClass alloc] init] autorelease];
+    viewController.view = [[[UIView alloc] initWithFrame:CGRectMake(0.f, 0.f, size.width, size.height)] autorelease];
+    viewController.view.layer.contents = (id)[image CGImage];
+    return viewController;
+}
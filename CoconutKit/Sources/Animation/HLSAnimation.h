@@ -7,6 +7,7 @@
 //
 
 #import "HLSAnimationStep.h"
+#import "HLSTrace.h"
 
 // Forward declarations
 @class HLSZeroingWeakRef;
@@ -57,7 +58,7 @@
  *
  * Designated initializer: -initWithAnimationSteps:
  */
-@interface HLSAnimation : NSObject <NSCopying> {
+@interface HLSAnimation : NSObject <NSCopying, NSCoding> {
 @private
     NSArray *m_animationSteps;                                      // a copy of the HLSAnimationSteps passed at initialization time
     NSArray *m_animationStepCopies;                                 // another copy made temporarily during animation
@@ -66,6 +67,9 @@
     NSString *m_tag;
     NSDictionary *m_userInfo;
     BOOL m_lockingUI;
+    BOOL m_rasterizingLayers;
+    NSArray *m_rasterizedLayers;                                    // the layers rasterized during the animation
+    NSArray *m_rasterizedLayerScales;                               // their original rasterization scales (NSNumber)
     BOOL m_animated;
     NSUInteger m_repeatCount;
     NSUInteger m_currentRepeatCount;
@@ -79,6 +83,29 @@
     BOOL m_cancelling;
     BOOL m_terminating;
     HLSZeroingWeakRef *m_delegateZeroingWeakRef;
+    struct {
+        unsigned int willStart:1;
+        unsigned int didFinishStep:1;
+        unsigned int didStop:1;
+    } m_delegateFlags;                                              // optional delegate methods implemented (set with the delegate)
+    BOOL m_frozen;
+    NSArray *m_reverseAnimationSteps;                               // cached reverse animation steps (frozen animations only)
+    NSArray *m_loopAnimationSteps;                                  // cached loop animation steps (frozen animations only)
+    NSMutableDictionary *m_durationToAnimationStepsMap;             // cached animation steps for each NSNumber duration (frozen animations only)
+    NSArray *m_scrubbingLayers;                                     // the layers involved while scrubbing
+    NSArray *m_scrubbingLayerTimings;                               // their timing properties before scrubbing began
+    float m_progress;
+    BOOL m_scrubbing;
+    BOOL m_settling;                                                // YES while settling after scrubbing
+    BOOL m_settlingToEnd;
+    NSArray *m_loopingLayers;                                       // the layers involved in a native loop
+    NSArray *m_loopingLayerTimings;                                 // their timing properties before the loop started
+    BOOL m_loopingNatively;
+    BOOL m_autoreversing;
+    BOOL m_loopPaused;
+    NSArray *m_targetIndexes;                                       // target index of each object animation (unarchived animations only)
+    HLSTraceIdentifier m_traceIdentifier;                           // interval while running (see HLSTrace)
+    HLSTraceIdentifier m_stepTraceIdentifier;                       // interval of the step being played
 }
 
 /**
@@ -88,6 +115,19 @@
 + (HLSAnimation *)animationWithAnimationSteps:(NSArray *)animationSteps;
 + (HLSAnimation *)animationWithAnimationStep:(HLSAnimationStep *)animationStep;
 
+/**
+ * Create an animation playing several animations (tracks) at the same time, each one with its own timing. Tracks must
+ * be made of layer animation steps (HLSLayerAnimationStep) only. Tracks are merged into as few steps as possible, 
+ * and thus as few Core Animation transactions as possible: A step boundary is only introduced where no step of any 
+ * track is running. Successive steps of a track can animate the same layer, but within a merged step each layer must 
+ * be animated by a single track step, otherwise the tracks cannot be merged and nil is returned. This is the case if
+ * two tracks animate the same layer at the same time, or if a step of another track runs across the boundary between
+ * two successive steps animating the same layer
+ *
+ * The resulting animation has no tag, and the steps of the tracks are not notified individually
+ */
++ (HLSAnimation *)animationWithParallelAnimations:(NSArray *)animations;
+
 /**
  * Create an animation using HLSAnimationStep objects. Those steps will be chained together when the animation
  * is played. If nil is provided, an empty animation is created (such animations still fire -animationWillStart:animated:
@@ -116,6 +156,20 @@
  */
 @property (nonatomic, assign) BOOL lockingUI;
 
+/**
+ * If set to YES, layers with many sublayers which are animated by layer animation steps are rasterized while the animation 
+ * is played animated (or scrubbed), so that their content is not rendered again for each frame. Their original state
+ * is restored when the animation ends. The rasterization scale is chosen to match the screen scale multiplied by the
+ * largest scale factor the layer reaches during the animation, so that layers look sharp without being rendered at an
+ * unnecessarily high resolution.
+ *
+ * Layers which are already rasterized, or whose rasterization settings or sublayer transforms are changed by the animation 
+ * itself, are left untouched. Layers animated by view animation steps are never rasterized
+ *
+ * Default is NO
+ */
+@property (nonatomic, assign) BOOL rasterizingLayers;
+
 /**
  * The animation delegate. Note that the animation is automatically cancelled if a delegate has been set
  * and gets deallocated while the animation is runnning
@@ -155,6 +209,20 @@
  */
 - (void)playWithRepeatCount:(NSUInteger)repeatCount afterDelay:(NSTimeInterval)delay;
 
+/**
+ * Play the animation forever, animated, delegating the repetition to Core Animation. Unlike -playWithRepeatCount:animated:
+ * with repeatCount = NSUIntegerMax, the animation steps are not chained using delegate callbacks and nothing is 
+ * allocated once the animation has been set up, making this method perfect for spinners or attract-mode loops. If
+ * autoreverses is set to YES, the animation is played backwards after each forward pass, yielding the same result 
+ * as playing its -loopAnimation forever.
+ *
+ * The -animationWillStart:animated: event is received when the animation starts. No step events are received. The 
+ * animation can be paused, resumed, cancelled or terminated as usual (with autoreverses = YES, the animation stops
+ * at its beginning, otherwise at its end). Only animations made of layer animation steps (HLSLayerAnimationStep) and 
+ * with a non-zero duration can be played this way. Return YES iff the animation could be played
+ */
+- (BOOL)playIndefinitelyAutoreversing:(BOOL)autoreverses;
+
 /**
  * Play part of an animation, starting at startTime (if 0, the animation starts at the beginning), with
  * animated = YES. The delegate events which would have been triggered prior to startTime are not received
@@ -263,6 +331,102 @@
  */
 - (HLSAnimation *)loopAnimation;
 
+/**
+ * Prepare the animation for being driven interactively (e.g. by a gesture recognizer), starting at its beginning. Once
+ * scrubbing has begun, the progress property can be freely set to any value between 0 and 1 to display the animation in
+ * the corresponding state, which is cheap enough to be done for each frame. Scrubbing ends when -finishScrubbing or 
+ * -cancelScrubbing is called: The animation then settles to its end, respectively its beginning, and the delegate 
+ * receives the -animationDidStop:animated: event. The -animationWillStart:animated: event is received when scrubbing
+ * begins, no step event is received.
+ *
+ * Only animations made of layer animation steps (HLSLayerAnimationStep) and with a non-zero duration can be scrubbed. 
+ * The layers involved must not be sublayers of each other, and their speed must not be altered while scrubbing (their
+ * original speed, time offset and begin time are restored once the animation has settled). The user interface is 
+ * never locked while scrubbing. Return YES iff scrubbing could begin
+ */
+- (BOOL)beginScrubbing;
+
+/**
+ * Settle the animation at its end, animated from its current progress value
+ */
+- (void)finishScrubbing;
+
+/**
+ * Settle the animation at its beginning, animated from its current progress value
+ */
+- (void)cancelScrubbing;
+
+/**
+ * Return YES while the animation is being scrubbed (from the call to -beginScrubbing until it has settled)
+ */
+@property (nonatomic, readonly, assign, getter=isScrubbing) BOOL scrubbing;
+
+/**
+ * The progress of the animation while it is scrubbed, between 0 (beginning) and 1 (end). Setting it has no effect if the
+ * animation is not being scrubbed or while it is settling
+ */
+@property (nonatomic, assign) float progress;
+
+/**
+ * Freeze the animation. Variants of an animation (see -animationWithDuration:, -reverseAnimation and -loopAnimation) are 
+ * usually rebuilt from scratch each time they are requested, which involves a deep copy of all animation steps. For a
+ * frozen animation, the animation steps of each variant are generated once and cached. Variants then share them instead 
+ * of copying them, and are frozen as well. Freeze animations whose variants are requested over and over (e.g. a 
+ * transition played in both directions)
+ *
+ * Only the animation steps are shared: Tag, user information, delegate and UI locking settings can still be set
+ * independently for each variant
+ */
+- (void)freeze;
+
+/**
+ * Return YES iff the animation has been frozen
+ */
+@property (nonatomic, readonly, assign, getter=isFrozen) BOOL frozen;
+
+/**
+ * Animations can be archived (e.g. to create them once and load them from a file stored in the application bundle). 
+ * Since the views and layers an animation is applied to cannot be archived, they are replaced by target numbers,
+ * assigned in the order in which targets first appear in the animation steps. The tag, UI locking and rasterization 
+ * settings are archived, the delegate and user information (as well as the user information of animation steps) 
+ * are not.
+ *
+ * An unarchived animation does not animate anything until its targets have been bound by calling -animationWithTargets:,
+ * which is cheap and can be called as many times as needed with different targets
+ */
+
+/**
+ * Load an animation from a file written using -writeToFile:. Return nil on failure
+ */
++ (HLSAnimation *)animationWithContentsOfFile:(NSString *)path;
+
+/**
+ * Archive the animation to a file (binary property list). Return YES iff successful
+ */
+- (BOOL)writeToFile:(NSString *)path;
+
+/**
+ * The number of targets of an unarchived animation (0 for animations which have not been unarchived)
+ */
+- (NSUInteger)numberOfTargets;
+
+/**
+ * Return a new animation with the same settings as an unarchived animation, applied to the specified targets. The 
+ * number of targets must be equal to -numberOfTargets. For layer animation steps, views can be provided instead of 
+ * layers (their layer is then animated). Return nil if the animation has not been unarchived or if the number of 
+ * targets does not match
+ */
+- (HLSAnimation *)animationWithTargets:(NSArray *)targets;
+
+/**
+ * Return a new animation with the same settings, in which the objects animated in targets have been replaced with the 
+ * objects at the same positions in replacementTargets (objects not in targets are left untouched). This makes it possible 
+ * to build an animation once for placeholder objects and to reuse it for other ones. As for -animationWithTargets:, 
+ * views can be provided instead of layers for layer animation steps. Return nil if both arrays do not have the same 
+ * number of elements
+ */
+- (HLSAnimation *)animationReplacingTargets:(NSArray *)targets withTargets:(NSArray *)replacementTargets;
+
 @end
 
 @protocol HLSAnimationDelegate <NSObject>
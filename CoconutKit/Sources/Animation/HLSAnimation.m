@@ -8,11 +8,14 @@
 
 #import "HLSAnimation.h"
 
+#import "HLSAnimationProfiler.h"
 #import "HLSAnimationStep+Friend.h"
+#import "HLSAnimationStep+Protected.h"
 #import "HLSAssert.h"
 #import "HLSConverters.h"
 #import "HLSFloat.h"
 #import "HLSLayerAnimationStep.h"
+#import "HLSLayerAnimationStep+Friend.h"
 #import "HLSLogger.h"
 #import "HLSUserInterfaceLock.h"
 #import "HLSZeroingWeakRef.h"
@@ -27,6 +30,26 @@
  */
 
 static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
+static NSString * const kScrubbingAnimationKeyPrefix = @"HLSScrubbingAnimation_";
+static NSString * const kLoopAnimationKey = @"HLSLoopAnimation";
+
+// Layers with fewer sublayers (counted recursively) are cheap to render and never rasterized automatically
+static const NSUInteger kRasterizationMinimumSublayerCount = 8;
+
+// Animations with a begin time of 0 would begin when they are added. The scrubbing timeline therefore starts a bit later
+static const CFTimeInterval kScrubbingBeginTime = 1.;
+
+// Return YES iff the layer has at least minimumCount sublayers (counted recursively, stopping as soon as the count is reached)
+static BOOL HLSLayerHasSublayerCount(CALayer *layer, NSUInteger *pCount, NSUInteger minimumCount)
+{
+    for (CALayer *sublayer in layer.sublayers) {
+        ++(*pCount);
+        if (*pCount >= minimumCount || HLSLayerHasSublayerCount(sublayer, pCount, minimumCount)) {
+            return YES;
+        }
+    }
+    return NO;
+}
 
 @interface HLSAnimation () <HLSAnimationStepDelegate>
 
@@ -42,6 +65,21 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 @property (nonatomic, assign, getter=isCancelling) BOOL cancelling;
 @property (nonatomic, assign, getter=isTerminating) BOOL terminating;
 @property (nonatomic, retain) HLSZeroingWeakRef *delegateZeroingWeakRef;
+@property (nonatomic, retain) NSArray *reverseAnimationSteps;
+@property (nonatomic, retain) NSArray *loopAnimationSteps;
+@property (nonatomic, retain) NSMutableDictionary *durationToAnimationStepsMap;
+@property (nonatomic, retain) NSArray *scrubbingLayers;
+@property (nonatomic, retain) NSArray *scrubbingLayerTimings;
+@property (nonatomic, retain) NSArray *rasterizedLayers;
+@property (nonatomic, retain) NSArray *rasterizedLayerScales;
+@property (nonatomic, retain) NSArray *targetIndexes;
+@property (nonatomic, retain) NSArray *loopingLayers;
+@property (nonatomic, retain) NSArray *loopingLayerTimings;
+@property (nonatomic, assign, getter=isScrubbing) BOOL scrubbing;
+
++ (HLSLayerAnimationStep *)mergedAnimationStepWithEntries:(NSArray *)entries beginTime:(NSTimeInterval)beginTime endTime:(NSTimeInterval)endTime;
+
+- (id)initWithFrozenAnimationSteps:(NSArray *)animationSteps;
 
 - (void)playWithStartTime:(NSTimeInterval)startTime
               repeatCount:(NSUInteger)repeatCount
@@ -52,7 +90,19 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 - (void)playAnimationStep:(HLSAnimationStep *)animationStep animated:(BOOL)animated;
 - (void)playNextAnimationStepAnimated:(BOOL)animated;
 
-- (NSArray *)reverseAnimationSteps;
+- (NSArray *)generateReverseAnimationSteps;
+- (HLSAnimation *)frozenVariantWithAnimationSteps:(NSArray *)animationSteps tag:(NSString *)tag;
+
+- (BOOL)isMadeOfLayerAnimationSteps;
+
+- (void)stopLoopingNativelyNotifying:(BOOL)notifying;
+
+- (void)rasterizeLayers;
+- (void)restoreRasterizedLayers;
+
+- (void)settleScrubbingToEnd:(BOOL)toEnd;
+- (void)scrubbingDidSettle;
+- (void)removeScrubbingAnimations;
 
 - (void)applicationDidEnterBackground:(NSNotification *)notification;
 - (void)applicationWillEnterForeground:(NSNotification *)notification;
@@ -77,6 +127,165 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     return [HLSAnimation animationWithAnimationSteps:animationSteps];
 }
 
++ (HLSAnimation *)animationWithParallelAnimations:(NSArray *)animations
+{
+    HLSAssertObjectsInEnumerationAreKindOfClass(animations, HLSAnimation);
+    
+    // Place all steps of all tracks on a common timeline. Each entry contains the step, its begin and end times, as well
+    // as its rank among the steps lasting 0 located at the same time within its track
+    NSMutableArray *entries = [NSMutableArray array];
+    NSMutableArray *boundaries = [NSMutableArray arrayWithObject:[NSNumber numberWithDouble:0.]];
+    for (HLSAnimation *animation in animations) {
+        if (! [animation isMadeOfLayerAnimationSteps]) {
+            HLSLoggerError(@"Only animations made of layer animation steps can be played in parallel");
+            return nil;
+        }
+        
+        NSTimeInterval time = 0.;
+        NSUInteger instantRank = 0;
+        for (HLSLayerAnimationStep *animationStep in animation.animationSteps) {
+            [entries addObject:[NSArray arrayWithObjects:animationStep, [NSNumber numberWithDouble:time], 
+                                [NSNumber numberWithDouble:time + animationStep.duration], 
+                                [NSNumber numberWithUnsignedInteger:instantRank], nil]];
+            instantRank = doubleeq(animationStep.duration, 0.) ? instantRank + 1 : 0;
+            time += animationStep.duration;
+            [boundaries addObject:[NSNumber numberWithDouble:time]];
+        }
+    }
+    
+    // Only keep the boundaries no step runs across
+    NSMutableArray *cuts = [NSMutableArray array];
+    for (NSNumber *boundary in [boundaries sortedArrayUsingSelector:@selector(compare:)]) {
+        NSTimeInterval cut = [boundary doubleValue];
+        if ([cuts count] != 0 && doubleeq([[cuts lastObject] doubleValue], cut)) {
+            continue;
+        }
+        
+        BOOL clean = YES;
+        for (NSArray *entry in entries) {
+            if (doublelt([[entry objectAtIndex:1] doubleValue], cut) && doublegt([[entry objectAtIndex:2] doubleValue], cut)) {
+                clean = NO;
+                break;
+            }
+        }
+        if (clean) {
+            [cuts addObject:boundary];
+        }
+    }
+    
+    // Create the steps in timeline order. At each cut, the track steps lasting 0 located there are played first, in their
+    // order within their track, so that successive track steps animating the same layer never end up in the same step. 
+    // The track steps lying between the cut and the next one are then gathered in a single step
+    NSMutableArray *animationSteps = [NSMutableArray array];
+    for (NSUInteger i = 0; i < [cuts count]; ++i) {
+        NSTimeInterval cut = [[cuts objectAtIndex:i] doubleValue];
+        
+        for (NSUInteger instantRank = 0; ; ++instantRank) {
+            NSMutableArray *instantEntries = [NSMutableArray array];
+            for (NSArray *entry in entries) {
+                if (doubleeq([[entry objectAtIndex:1] doubleValue], cut) && doubleeq([[entry objectAtIndex:2] doubleValue], cut)
+                        && [[entry objectAtIndex:3] unsignedIntegerValue] == instantRank) {
+                    [instantEntries addObject:entry];
+                }
+            }
+            if ([instantEntries count] == 0) {
+                break;
+            }
+            
+            HLSLayerAnimationStep *mergedAnimationStep = [self mergedAnimationStepWithEntries:instantEntries beginTime:cut endTime:cut];
+            if (! mergedAnimationStep) {
+                return nil;
+            }
+            [animationSteps addObject:mergedAnimationStep];
+        }
+        
+        if (i + 1 == [cuts count]) {
+            break;
+        }
+        
+        NSTimeInterval nextCut = [[cuts objectAtIndex:i + 1] doubleValue];
+        NSMutableArray *windowEntries = [NSMutableArray array];
+        for (NSArray *entry in entries) {
+            NSTimeInterval entryBeginTime = [[entry objectAtIndex:1] doubleValue];
+            NSTimeInterval entryEndTime = [[entry objectAtIndex:2] doubleValue];
+            if (doublelt(entryBeginTime, cut) || doublegt(entryEndTime, nextCut)) {
+                continue;
+            }
+            
+            // Track steps lasting 0 located at a cut have their own steps
+            if (doubleeq(entryBeginTime, entryEndTime) && (doubleeq(entryBeginTime, cut) || doubleeq(entryBeginTime, nextCut))) {
+                continue;
+            }
+            [windowEntries addObject:entry];
+        }
+        
+        HLSLayerAnimationStep *mergedAnimationStep = [self mergedAnimationStepWithEntries:windowEntries beginTime:cut endTime:nextCut];
+        if (! mergedAnimationStep) {
+            return nil;
+        }
+        [animationSteps addObject:mergedAnimationStep];
+    }
+    
+    return [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
+}
+
+// Gather timeline entries (see +animationWithParallelAnimations:) into a single step lasting from beginTime to endTime.
+// A step animates a layer at most once. Return nil if several entries animate the same layer
++ (HLSLayerAnimationStep *)mergedAnimationStepWithEntries:(NSArray *)entries beginTime:(NSTimeInterval)beginTime endTime:(NSTimeInterval)endTime
+{
+    NSTimeInterval duration = endTime - beginTime;
+    
+    HLSLayerAnimationStep *mergedAnimationStep = [HLSLayerAnimationStep animationStep];
+    mergedAnimationStep.duration = duration;
+    
+    NSMutableDictionary *layerKeyToEntryMap = [NSMutableDictionary dictionary];
+    for (NSArray *entry in entries) {
+        NSTimeInterval entryBeginTime = [[entry objectAtIndex:1] doubleValue];
+        NSTimeInterval entryEndTime = [[entry objectAtIndex:2] doubleValue];
+        
+        HLSLayerAnimationStep *animationStep = [entry objectAtIndex:0];
+        for (CALayer *layer in [animationStep layers]) {
+            NSValue *layerKey = [NSValue valueWithPointer:layer];
+            NSArray *otherEntry = [layerKeyToEntryMap objectForKey:layerKey];
+            if (otherEntry) {
+                NSTimeInterval otherEntryBeginTime = [[otherEntry objectAtIndex:1] doubleValue];
+                NSTimeInterval otherEntryEndTime = [[otherEntry objectAtIndex:2] doubleValue];
+                if ((doublelt(entryBeginTime, otherEntryEndTime) && doublelt(otherEntryBeginTime, entryEndTime))
+                        || (doubleeq(entryBeginTime, otherEntryBeginTime) && doubleeq(entryEndTime, otherEntryEndTime))) {
+                    HLSLoggerError(@"The layer %@ is animated by several tracks at the same time. The animations cannot be merged", layer);
+                }
+                else {
+                    HLSLoggerError(@"The layer %@ is animated by successive steps, between which a step of another track is running. "
+                                   "The animations cannot be merged", layer);
+                }
+                return nil;
+            }
+            [layerKeyToEntryMap setObject:entry forKey:layerKey];
+            
+            // Convert the timing within the track step into a timing within the merged step
+            CGFloat beginFraction = 0.f;
+            CGFloat endFraction = 0.f;
+            CAMediaTimingFunction *timingFunction = nil;
+            [animationStep getTimingForLayer:layer beginFraction:&beginFraction endFraction:&endFraction timingFunction:&timingFunction];
+            if (! doubleeq(duration, 0.)) {
+                beginFraction = (entryBeginTime + beginFraction * animationStep.duration - beginTime) / duration;
+                endFraction = (entryBeginTime + endFraction * animationStep.duration - beginTime) / duration;
+            }
+            else {
+                beginFraction = 0.f;
+                endFraction = 1.f;
+            }
+            
+            [mergedAnimationStep addLayerAnimation:(HLSLayerAnimation *)[animationStep objectAnimationForObject:layer]
+                                          forLayer:layer
+                                       beginningAt:floatmax(floatmin(beginFraction, 1.f), 0.f)
+                                          endingAt:floatmax(floatmin(endFraction, 1.f), 0.f)
+                                    timingFunction:timingFunction];
+        }
+    }
+    return mergedAnimationStep;
+}
+
 + (NSArray *)duplicateAnimationSteps:(NSArray *)animationSteps
 {
     NSMutableArray *animationStepCopies = [NSMutableArray array];
@@ -111,6 +320,16 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     return self;
 }
 
+// Frozen animation steps are never altered, they can therefore be shared without being copied
+- (id)initWithFrozenAnimationSteps:(NSArray *)animationSteps
+{
+    if ((self = [self initWithAnimationSteps:nil])) {
+        self.animationSteps = animationSteps;
+        m_frozen = YES;
+    }
+    return self;
+}
+
 - (id)init
 {
     HLSForbiddenInheritedMethod();
@@ -126,7 +345,14 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
                                                     name:UIApplicationWillEnterForegroundNotification
                                                   object:nil];
     
+    // Never leave layers frozen
+    if (self.scrubbing) {
+        [self removeScrubbingAnimations];
+    }
+    
     [self cancel];
+    [self restoreRasterizedLayers];
+    [[HLSAnimationProfiler sharedAnimationProfiler] stopProfilingAnimation:self discarding:YES];
     
     self.animationSteps = nil;
     self.animationStepCopies = nil;
@@ -135,6 +361,16 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     self.tag = nil;
     self.userInfo = nil;
     self.delegateZeroingWeakRef = nil;
+    self.reverseAnimationSteps = nil;
+    self.loopAnimationSteps = nil;
+    self.durationToAnimationStepsMap = nil;
+    self.scrubbingLayers = nil;
+    self.scrubbingLayerTimings = nil;
+    self.rasterizedLayers = nil;
+    self.rasterizedLayerScales = nil;
+    self.targetIndexes = nil;
+    self.loopingLayers = nil;
+    self.loopingLayerTimings = nil;
     
     [super dealloc];
 }
@@ -155,6 +391,18 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 @synthesize lockingUI = m_lockingUI;
 
+@synthesize rasterizingLayers = m_rasterizingLayers;
+
+@synthesize rasterizedLayers = m_rasterizedLayers;
+
+@synthesize rasterizedLayerScales = m_rasterizedLayerScales;
+
+@synthesize targetIndexes = m_targetIndexes;
+
+@synthesize loopingLayers = m_loopingLayers;
+
+@synthesize loopingLayerTimings = m_loopingLayerTimings;
+
 @synthesize running = m_running;
 
 @synthesize playing = m_playing;
@@ -163,6 +411,9 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (BOOL)isPaused
 {
+    if (m_loopingNatively) {
+        return m_loopPaused;
+    }
     return [self.currentAnimationStep isPaused];
 }
 
@@ -181,6 +432,49 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 {
     self.delegateZeroingWeakRef = [[[HLSZeroingWeakRef alloc] initWithObject:delegate] autorelease];
     [self.delegateZeroingWeakRef addCleanupAction:@selector(cancel) onTarget:self];
+    
+    // Optional methods are looked up once, not each time an event occurs
+    m_delegateFlags.willStart = [delegate respondsToSelector:@selector(animationWillStart:animated:)];
+    m_delegateFlags.didFinishStep = [delegate respondsToSelector:@selector(animation:didFinishStep:animated:)];
+    m_delegateFlags.didStop = [delegate respondsToSelector:@selector(animationDidStop:animated:)];
+}
+
+@synthesize frozen = m_frozen;
+
+@synthesize reverseAnimationSteps = m_reverseAnimationSteps;
+
+@synthesize loopAnimationSteps = m_loopAnimationSteps;
+
+@synthesize durationToAnimationStepsMap = m_durationToAnimationStepsMap;
+
+@synthesize scrubbingLayers = m_scrubbingLayers;
+
+@synthesize scrubbingLayerTimings = m_scrubbingLayerTimings;
+
+@synthesize scrubbing = m_scrubbing;
+
+@synthesize progress = m_progress;
+
+- (void)setProgress:(float)progress
+{
+    if (! self.scrubbing || m_settling) {
+        HLSLoggerDebug(@"The animation is not being scrubbed");
+        return;
+    }
+    
+    if (floatlt(progress, 0.f)) {
+        progress = 0.f;
+    }
+    else if (floatgt(progress, 1.f)) {
+        progress = 1.f;
+    }
+    m_progress = progress;
+    
+    // Called for each frame, nothing must be allocated here
+    CFTimeInterval timeOffset = kScrubbingBeginTime + progress * [self duration];
+    for (CALayer *layer in self.scrubbingLayers) {
+        layer.timeOffset = timeOffset;
+    }
 }
 
 - (NSTimeInterval)duration
@@ -271,11 +565,19 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
                 
         self.running = YES;
         self.playing = YES;
+        
+        m_traceIdentifier = HLSTraceBegin(@"Animation", self.tag ? self.tag : NSStringFromClass([self class]));
     
         // Lock the UI during the animation
         if (self.lockingUI) {
             [[HLSUserInterfaceLock sharedUserInterfaceLock] lock];
         }
+        
+        // Rasterization and profiling only make sense when frames are actually rendered
+        if (animated) {
+            [self rasterizeLayers];
+            [[HLSAnimationProfiler sharedAnimationProfiler] startProfilingAnimation:self];
+        }
     }
     
     // Animation steps carry state information. To avoid issues when playing the same animation step several times (most
@@ -310,6 +612,9 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (void)playAnimationStep:(HLSAnimationStep *)animationStep animated:(BOOL)animated
 {
+    m_stepTraceIdentifier = HLSTraceBegin(@"Animation", [NSString stringWithFormat:@"Step %@", 
+                                                         animationStep.tag ? animationStep.tag : NSStringFromClass([animationStep class])]);
+    
     // Instantaneously play all animation steps which complete before the start time. The value of m_remainingTimeBeforeStart
     // is updated before the animation is played (so that it can be used as a criterium to guess whether we are playing
     // animation steps instantaneously to reach the start time)
@@ -341,7 +646,7 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     else {
         // Empty animations (without animation steps) must still call the animationWillStart:animated delegate method
         if (m_currentRepeatCount == 0 && [self.animationStepCopies count] == 0) {
-            if ([self.delegate respondsToSelector:@selector(animationWillStart:animated:)]) {
+            if (m_delegateFlags.willStart) {
                 [self.delegate animationWillStart:self animated:animated];
             }
             
@@ -361,16 +666,23 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
                 [[HLSUserInterfaceLock sharedUserInterfaceLock] unlock];
             }
             
+            [self restoreRasterizedLayers];
+            [[HLSAnimationProfiler sharedAnimationProfiler] stopProfilingAnimation:self 
+                                                                        discarding:self.cancelling || self.terminating];
+            
             self.started = NO;
             self.playing = NO;
             
             if (! self.cancelling) {
-                if ([self.delegate respondsToSelector:@selector(animationDidStop:animated:)]) {
+                if (m_delegateFlags.didStop) {
                     [self.delegate animationDidStop:self animated:self.terminating ? NO : animated];
                 }
             }
             
             // End of the animation
+            HLSTraceEnd(m_traceIdentifier);
+            m_traceIdentifier = 0;
+            
             self.running = NO;
             self.cancelling = NO;
             self.terminating = NO;
@@ -388,6 +700,11 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (void)pause
 {
+    if (self.scrubbing) {
+        HLSLoggerDebug(@"The animation is being scrubbed, nothing to pause");
+        return;
+    }
+    
     if (! self.running) {
         HLSLoggerDebug(@"The animation is not running, nothing to pause");
         return;
@@ -403,6 +720,17 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (m_loopingNatively) {
+        // Freeze the layers at their current time
+        for (CALayer *layer in self.loopingLayers) {
+            CFTimeInterval pauseTime = [layer convertTime:CACurrentMediaTime() fromLayer:nil];
+            layer.speed = 0.f;
+            layer.timeOffset = pauseTime;
+        }
+        m_loopPaused = YES;
+        return;
+    }
+    
     [self.currentAnimationStep pause];
 }
 
@@ -413,6 +741,21 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (m_loopingNatively) {
+        // Resume where the layers were frozen, at their original speed
+        NSUInteger i = 0;
+        for (CALayer *layer in self.loopingLayers) {
+            CFTimeInterval pauseTime = layer.timeOffset;
+            layer.speed = [[[self.loopingLayerTimings objectAtIndex:i] objectForKey:@"speed"] floatValue];
+            ++i;
+            layer.timeOffset = 0.;
+            layer.beginTime = 0.;
+            layer.beginTime = [layer convertTime:CACurrentMediaTime() fromLayer:nil] - pauseTime;
+        }
+        m_loopPaused = NO;
+        return;
+    }
+    
     [self.currentAnimationStep resume];
 }
 
@@ -423,11 +766,23 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (self.scrubbing) {
+        HLSLoggerDebug(@"The animation is being scrubbed. Call -cancelScrubbing instead");
+        return;
+    }
+    
     if (self.cancelling || self.terminating) {
         HLSLoggerDebug(@"The animation is already being cancelled or terminated");
         return;
     }
     
+    HLSTraceInstant(@"Animation", [NSString stringWithFormat:@"Cancel %@", self.tag ? self.tag : NSStringFromClass([self class])]);
+    
+    if (m_loopingNatively) {
+        [self stopLoopingNativelyNotifying:NO];
+        return;
+    }
+    
     self.cancelling = YES;
     
     // Cancel all animations
@@ -441,17 +796,410 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return;
     }
     
+    if (self.scrubbing) {
+        HLSLoggerDebug(@"The animation is being scrubbed. Call -finishScrubbing instead");
+        return;
+    }
+    
     if (self.cancelling || self.terminating) {
         HLSLoggerDebug(@"The animation is already being cancelled or terminated");
         return;
     }
     
+    HLSTraceInstant(@"Animation", [NSString stringWithFormat:@"Terminate %@", self.tag ? self.tag : NSStringFromClass([self class])]);
+    
+    if (m_loopingNatively) {
+        [self stopLoopingNativelyNotifying:YES];
+        return;
+    }
+    
     self.terminating = YES;
     
     // Cancel all animations
     [self.currentAnimationStep terminate];
 }
 
+#pragma mark Native looping
+
+- (BOOL)isMadeOfLayerAnimationSteps
+{
+    for (HLSAnimationStep *animationStep in self.animationSteps) {
+        if (! [animationStep isKindOfClass:[HLSLayerAnimationStep class]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+// Remark: All steps of a layer are gathered into a single parent animation group repeated forever by Core Animation (the
+//         same approach as for scrubbing, see below)
+- (BOOL)playIndefinitelyAutoreversing:(BOOL)autoreverses
+{
+    if (self.running) {
+        HLSLoggerDebug(@"The animation is already running");
+        return NO;
+    }
+    
+    if (! [self isMadeOfLayerAnimationSteps]) {
+        HLSLoggerError(@"Only animations made of layer animation steps can be looped natively");
+        return NO;
+    }
+    
+    NSTimeInterval duration = [self duration];
+    if (doubleeq(duration, 0.)) {
+        HLSLoggerError(@"Animations with no duration cannot be looped natively");
+        return NO;
+    }
+    
+    self.running = YES;
+    self.playing = YES;
+    m_loopingNatively = YES;
+    m_autoreversing = autoreverses;
+    m_loopPaused = NO;
+    
+    if (self.lockingUI) {
+        [[HLSUserInterfaceLock sharedUserInterfaceLock] lock];
+    }
+    
+    [self rasterizeLayers];
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    NSMutableDictionary *layerAnimationGroupsMap = [NSMutableDictionary dictionary];
+    CFTimeInterval beginTime = 0.;
+    for (HLSLayerAnimationStep *animationStep in self.animationSteps) {
+        [animationStep addAnimationGroupsWithBeginTime:beginTime toLayerAnimationGroupsMap:layerAnimationGroupsMap];
+        beginTime += animationStep.duration;
+    }
+    
+    NSMutableArray *loopingLayers = [NSMutableArray array];
+    NSMutableArray *loopingLayerTimings = [NSMutableArray array];
+    NSArray *timingKeys = [NSArray arrayWithObjects:@"speed", @"timeOffset", @"beginTime", nil];
+    for (NSValue *layerKey in [layerAnimationGroupsMap allKeys]) {
+        CALayer *layer = [layerKey pointerValue];
+        
+        CAAnimationGroup *loopAnimationGroup = [CAAnimationGroup animation];
+        loopAnimationGroup.animations = [layerAnimationGroupsMap objectForKey:layerKey];
+        loopAnimationGroup.duration = duration;
+        loopAnimationGroup.repeatCount = HUGE_VALF;
+        loopAnimationGroup.autoreverses = autoreverses;
+        loopAnimationGroup.removedOnCompletion = NO;
+        [layer addAnimation:loopAnimationGroup forKey:kLoopAnimationKey];
+        
+        [loopingLayers addObject:layer];
+        
+        // Pausing and resuming alter the layer timing, which must be restored when the loop is stopped
+        [loopingLayerTimings addObject:[layer dictionaryWithValuesForKeys:timingKeys]];
+    }
+    
+    [CATransaction commit];
+    
+    self.loopingLayers = [NSArray arrayWithArray:loopingLayers];
+    self.loopingLayerTimings = [NSArray arrayWithArray:loopingLayerTimings];
+    
+    if (m_delegateFlags.willStart) {
+        [self.delegate animationWillStart:self animated:YES];
+    }
+    self.started = YES;
+    
+    return YES;
+}
+
+- (void)stopLoopingNativelyNotifying:(BOOL)notifying
+{
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    // Restore the layer timing altered by pausing and resuming, even if the loop is not paused anymore
+    NSUInteger i = 0;
+    for (CALayer *layer in self.loopingLayers) {
+        [layer removeAnimationForKey:kLoopAnimationKey];
+        [layer setValuesForKeysWithDictionary:[self.loopingLayerTimings objectAtIndex:i]];
+        ++i;
+    }
+    self.loopingLayers = nil;
+    self.loopingLayerTimings = nil;
+    
+    // Layers are left in their final state. An autoreversing loop always ends at its beginning
+    if (m_autoreversing) {
+        HLSAnimation *reverseAnimation = [self reverseAnimation];
+        reverseAnimation.delegate = nil;
+        reverseAnimation.lockingUI = NO;
+        reverseAnimation.rasterizingLayers = NO;
+        [reverseAnimation playAnimated:NO];
+    }
+    
+    [self restoreRasterizedLayers];
+    
+    [CATransaction commit];
+    
+    if (self.lockingUI) {
+        [[HLSUserInterfaceLock sharedUserInterfaceLock] unlock];
+    }
+    
+    m_loopingNatively = NO;
+    m_autoreversing = NO;
+    m_loopPaused = NO;
+    self.started = NO;
+    self.playing = NO;
+    
+    if (notifying) {
+        if (m_delegateFlags.didStop) {
+            [self.delegate animationDidStop:self animated:NO];
+        }
+    }
+    
+    self.running = NO;
+}
+
+#pragma mark Rasterization
+
+- (void)rasterizeLayers
+{
+    if (! self.rasterizingLayers) {
+        return;
+    }
+    
+    // Find the largest scale factor reached by each layer during the animation (scale factors of successive steps are cumulative)
+    CFMutableDictionaryRef layerToScaleFactorsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    NSMutableArray *layers = [NSMutableArray array];
+    NSMutableArray *excludedLayers = [NSMutableArray array];
+    for (HLSAnimationStep *animationStep in self.animationSteps) {
+        if (! [animationStep isKindOfClass:[HLSLayerAnimationStep class]]) {
+            continue;
+        }
+        
+        HLSLayerAnimationStep *layerAnimationStep = (HLSLayerAnimationStep *)animationStep;
+        for (CALayer *layer in [layerAnimationStep layers]) {
+            // A rasterized layer is rendered flat, which would discard the perspective of sublayers transformed in 3D
+            if ([layerAnimationStep isChangingRasterizationOfLayer:layer]
+                    || [layerAnimationStep isChangingSublayerTransformOfLayer:layer]) {
+                [excludedLayers addObject:layer];
+                continue;
+            }
+            
+            CGFloat *scaleFactors = (CGFloat *)CFDictionaryGetValue(layerToScaleFactorsMap, layer);
+            if (! scaleFactors) {
+                // Current and largest scale factors
+                scaleFactors = malloc(2 * sizeof(CGFloat));
+                scaleFactors[0] = 1.f;
+                scaleFactors[1] = 1.f;
+                CFDictionarySetValue(layerToScaleFactorsMap, layer, scaleFactors);
+                [layers addObject:layer];
+            }
+            scaleFactors[0] *= [layerAnimationStep scaleFactorForLayer:layer];
+            scaleFactors[1] = MAX(scaleFactors[0], scaleFactors[1]);
+        }
+    }
+    
+    NSMutableArray *rasterizedLayers = [NSMutableArray array];
+    NSMutableArray *rasterizedLayerScales = [NSMutableArray array];
+    CGFloat screenScale = [UIScreen mainScreen].scale;
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    for (CALayer *layer in layers) {
+        CGFloat *scaleFactors = (CGFloat *)CFDictionaryGetValue(layerToScaleFactorsMap, layer);
+        NSUInteger count = 0;
+        if (! layer.shouldRasterize 
+                && ! [excludedLayers containsObject:layer]
+                && HLSLayerHasSublayerCount(layer, &count, kRasterizationMinimumSublayerCount)) {
+            [rasterizedLayers addObject:layer];
+            [rasterizedLayerScales addObject:[NSNumber numberWithFloat:layer.rasterizationScale]];
+            
+            layer.shouldRasterize = YES;
+            layer.rasterizationScale = screenScale * scaleFactors[1];
+        }
+        free(scaleFactors);
+    }
+    
+    [CATransaction commit];
+    
+    CFRelease(layerToScaleFactorsMap);
+    
+    self.rasterizedLayers = [NSArray arrayWithArray:rasterizedLayers];
+    self.rasterizedLayerScales = [NSArray arrayWithArray:rasterizedLayerScales];
+}
+
+- (void)restoreRasterizedLayers
+{
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    NSUInteger i = 0;
+    for (CALayer *layer in self.rasterizedLayers) {
+        layer.shouldRasterize = NO;
+        layer.rasterizationScale = [[self.rasterizedLayerScales objectAtIndex:i] floatValue];
+        ++i;
+    }
+    
+    [CATransaction commit];
+    
+    self.rasterizedLayers = nil;
+    self.rasterizedLayerScales = nil;
+}
+
+#pragma mark Scrubbing
+
+// Remark: All steps are attached at once to the layers they animate, each one beginning where the previous one ends. Layers are 
+//         then frozen (speed = 0), their timeOffset selecting the time to display. To settle, layers are simply unfrozen, 
+//         playing at normal speed forwards or backwards from their current time
+- (BOOL)beginScrubbing
+{
+    if (self.running) {
+        HLSLoggerError(@"The animation is already running");
+        return NO;
+    }
+    
+    if (! [self isMadeOfLayerAnimationSteps]) {
+        HLSLoggerError(@"Only animations made of layer animation steps can be scrubbed");
+        return NO;
+    }
+    
+    if (doubleeq([self duration], 0.)) {
+        HLSLoggerError(@"Animations with no duration cannot be scrubbed");
+        return NO;
+    }
+    
+    self.running = YES;
+    self.playing = YES;
+    self.scrubbing = YES;
+    m_progress = 0.f;
+    
+    [self rasterizeLayers];
+    
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    NSMutableSet *scrubbingLayers = [NSMutableSet set];
+    CFTimeInterval beginTime = kScrubbingBeginTime;
+    NSUInteger index = 0;
+    for (HLSLayerAnimationStep *animationStep in self.animationSteps) {
+        [animationStep addScrubbingAnimationsWithBeginTime:beginTime
+                                                    forKey:[NSString stringWithFormat:@"%@%d", kScrubbingAnimationKeyPrefix, index]
+                                            animatedLayers:scrubbingLayers];
+        beginTime += animationStep.duration;
+        ++index;
+    }
+    
+    // Scrubbing and settling alter the layer timing, which must be restored when scrubbing ends
+    NSMutableArray *scrubbingLayerTimings = [NSMutableArray array];
+    NSArray *timingKeys = [NSArray arrayWithObjects:@"speed", @"timeOffset", @"beginTime", nil];
+    self.scrubbingLayers = [scrubbingLayers allObjects];
+    for (CALayer *layer in self.scrubbingLayers) {
+        [scrubbingLayerTimings addObject:[layer dictionaryWithValuesForKeys:timingKeys]];
+        
+        layer.speed = 0.f;
+        layer.timeOffset = kScrubbingBeginTime;
+    }
+    self.scrubbingLayerTimings = [NSArray arrayWithArray:scrubbingLayerTimings];
+    
+    [CATransaction commit];
+    
+    if (m_delegateFlags.willStart) {
+        [self.delegate animationWillStart:self animated:YES];
+    }
+    self.started = YES;
+    
+    return YES;
+}
+
+- (void)finishScrubbing
+{
+    [self settleScrubbingToEnd:YES];
+}
+
+- (void)cancelScrubbing
+{
+    [self settleScrubbingToEnd:NO];
+}
+
+- (void)settleScrubbingToEnd:(BOOL)toEnd
+{
+    if (! self.scrubbing) {
+        HLSLoggerDebug(@"The animation is not being scrubbed");
+        return;
+    }
+    
+    if (m_settling) {
+        HLSLoggerDebug(@"The animation is already settling");
+        return;
+    }
+    
+    m_settling = YES;
+    m_settlingToEnd = toEnd;
+    
+    // Let the layers play from their current time, forwards or backwards
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    CFTimeInterval timeOffset = kScrubbingBeginTime + m_progress * [self duration];
+    for (CALayer *layer in self.scrubbingLayers) {
+        CFTimeInterval parentTime = layer.superlayer ? [layer.superlayer convertTime:CACurrentMediaTime() fromLayer:nil] : CACurrentMediaTime();
+        layer.speed = toEnd ? 1.f : -1.f;
+        layer.timeOffset = timeOffset;
+        layer.beginTime = parentTime;
+    }
+    
+    [CATransaction commit];
+    
+    // Also performed while tracking, since settling usually occurs at the end of a gesture
+    NSTimeInterval remainingDuration = (toEnd ? 1.f - m_progress : m_progress) * [self duration];
+    [self performSelector:@selector(scrubbingDidSettle) 
+               withObject:nil 
+               afterDelay:remainingDuration 
+                  inModes:[NSArray arrayWithObject:NSRunLoopCommonModes]];
+}
+
+- (void)scrubbingDidSettle
+{
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
+    [self removeScrubbingAnimations];
+    
+    // Layers have already reached their final values. Restore the initial ones if scrubbing was cancelled
+    if (! m_settlingToEnd) {
+        HLSAnimation *reverseAnimation = [self reverseAnimation];
+        reverseAnimation.delegate = nil;
+        reverseAnimation.lockingUI = NO;
+        [reverseAnimation playAnimated:NO];
+    }
+    
+    [self restoreRasterizedLayers];
+    
+    [CATransaction commit];
+    
+    m_progress = m_settlingToEnd ? 1.f : 0.f;
+    m_settling = NO;
+    self.scrubbing = NO;
+    self.started = NO;
+    self.playing = NO;
+    
+    if (m_delegateFlags.didStop) {
+        [self.delegate animationDidStop:self animated:YES];
+    }
+    
+    self.running = NO;
+}
+
+- (void)removeScrubbingAnimations
+{
+    NSUInteger count = [self.animationSteps count];
+    NSUInteger i = 0;
+    for (CALayer *layer in self.scrubbingLayers) {
+        for (NSUInteger j = 0; j < count; ++j) {
+            [layer removeAnimationForKey:[NSString stringWithFormat:@"%@%d", kScrubbingAnimationKeyPrefix, j]];
+        }
+        [layer setValuesForKeysWithDictionary:[self.scrubbingLayerTimings objectAtIndex:i]];
+        ++i;
+    }
+    self.scrubbingLayers = nil;
+    self.scrubbingLayerTimings = nil;
+}
+
 #pragma mark Creating animations variants from an existing animation
 
 - (HLSAnimation *)animationWithDuration:(NSTimeInterval)duration
@@ -461,12 +1209,29 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
         return nil;
     }
     
-    HLSAnimation *animation = [[self copy] autorelease];
-    
     // Find out which factor must be applied to each animation step to preserve the animation appearance for the
     // specified duration
     double factor = duration / [self duration];
     
+    if (self.frozen) {
+        NSNumber *durationKey = [NSNumber numberWithDouble:duration];
+        NSArray *animationSteps = [self.durationToAnimationStepsMap objectForKey:durationKey];
+        if (! animationSteps) {
+            animationSteps = [HLSAnimation duplicateAnimationSteps:self.animationSteps];
+            for (HLSAnimationStep *animationStep in animationSteps) {
+                animationStep.duration *= factor;
+            }
+            
+            if (! self.durationToAnimationStepsMap) {
+                self.durationToAnimationStepsMap = [NSMutableDictionary dictionary];
+            }
+            [self.durationToAnimationStepsMap setObject:animationSteps forKey:durationKey];
+        }
+        return [self frozenVariantWithAnimationSteps:animationSteps tag:self.tag];
+    }
+    
+    HLSAnimation *animation = [[self copy] autorelease];
+    
     // Distribute the total duration evenly among animation steps
     for (HLSAnimationStep *animationStep in animation.animationSteps) {
         animationStep.duration *= factor;
@@ -475,7 +1240,7 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     return animation;
 }
 
-- (NSArray *)reverseAnimationSteps
+- (NSArray *)generateReverseAnimationSteps
 {
     NSMutableArray *reverseAnimationSteps = [NSMutableArray array];
     for (HLSAnimationStep *animationStep in [self.animationSteps reverseObjectEnumerator]) {
@@ -486,9 +1251,18 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (HLSAnimation *)reverseAnimation
 {
-    HLSAnimation *reverseAnimation = [HLSAnimation animationWithAnimationSteps:[self reverseAnimationSteps]];
-    reverseAnimation.tag = [self.tag isFilled] ? [NSString stringWithFormat:@"reverse_%@", self.tag] : nil;
+    NSString *reverseTag = [self.tag isFilled] ? [NSString stringWithFormat:@"reverse_%@", self.tag] : nil;
+    if (self.frozen) {
+        if (! self.reverseAnimationSteps) {
+            self.reverseAnimationSteps = [self generateReverseAnimationSteps];
+        }
+        return [self frozenVariantWithAnimationSteps:self.reverseAnimationSteps tag:reverseTag];
+    }
+    
+    HLSAnimation *reverseAnimation = [HLSAnimation animationWithAnimationSteps:[self generateReverseAnimationSteps]];
+    reverseAnimation.tag = reverseTag;
     reverseAnimation.lockingUI = self.lockingUI;
+    reverseAnimation.rasterizingLayers = self.rasterizingLayers;
     reverseAnimation.delegate = self.delegate;
     reverseAnimation.userInfo = self.userInfo;
     
@@ -497,8 +1271,22 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (HLSAnimation *)loopAnimation
 {
+    NSString *loopTag = [self.tag isFilled] ? [NSString stringWithFormat:@"loop_%@", self.tag] : nil;
+    if (self.frozen) {
+        if (! self.loopAnimationSteps) {
+            // The animation steps of the receiver must not be altered, work on copies
+            NSMutableArray *loopAnimationSteps = [NSMutableArray arrayWithArray:[HLSAnimation duplicateAnimationSteps:self.animationSteps]];
+            [loopAnimationSteps addObjectsFromArray:[self generateReverseAnimationSteps]];
+            for (HLSAnimationStep *animationStep in loopAnimationSteps) {
+                animationStep.tag = [animationStep.tag isFilled] ? [NSString stringWithFormat:@"loop_%@", animationStep.tag] : nil;
+            }
+            self.loopAnimationSteps = [NSArray arrayWithArray:loopAnimationSteps];
+        }
+        return [self frozenVariantWithAnimationSteps:self.loopAnimationSteps tag:loopTag];
+    }
+    
     NSMutableArray *animationSteps = [NSMutableArray arrayWithArray:self.animationSteps];
-    [animationSteps addObjectsFromArray:[self reverseAnimationSteps]];
+    [animationSteps addObjectsFromArray:[self generateReverseAnimationSteps]];
     
     // Add a loop_ prefix to all animation step tags
     for (HLSAnimationStep *animationStep in animationSteps) {
@@ -506,18 +1294,160 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     }
     
     HLSAnimation *loopAnimation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
-    loopAnimation.tag = [self.tag isFilled] ? [NSString stringWithFormat:@"loop_%@", self.tag] : nil;
+    loopAnimation.tag = loopTag;
     loopAnimation.lockingUI = self.lockingUI;
+    loopAnimation.rasterizingLayers = self.rasterizingLayers;
     loopAnimation.delegate = self.delegate;
     loopAnimation.userInfo = self.userInfo;
     
     return loopAnimation;
 }
 
+- (HLSAnimation *)frozenVariantWithAnimationSteps:(NSArray *)animationSteps tag:(NSString *)tag
+{
+    HLSAnimation *animation = [[[HLSAnimation alloc] initWithFrozenAnimationSteps:animationSteps] autorelease];
+    animation.tag = tag;
+    animation.lockingUI = self.lockingUI;
+    animation.rasterizingLayers = self.rasterizingLayers;
+    animation.delegate = self.delegate;
+    animation.userInfo = self.userInfo;
+    return animation;
+}
+
+#pragma mark Freezing
+
+- (void)freeze
+{
+    m_frozen = YES;
+}
+
+#pragma mark Archiving
+
++ (HLSAnimation *)animationWithContentsOfFile:(NSString *)path
+{
+    id animation = nil;
+    @try {
+        animation = [NSKeyedUnarchiver unarchiveObjectWithFile:path];
+    }
+    @catch (NSException *exception) {
+        HLSLoggerError(@"The file %@ could not be read. Reason: %@", path, [exception reason]);
+        return nil;
+    }
+    
+    if (! [animation isKindOfClass:[HLSAnimation class]]) {
+        HLSLoggerError(@"The file %@ does not contain an animation", path);
+        return nil;
+    }
+    return animation;
+}
+
+- (BOOL)writeToFile:(NSString *)path
+{
+    return [NSKeyedArchiver archiveRootObject:self toFile:path];
+}
+
+- (NSUInteger)numberOfTargets
+{
+    NSUInteger numberOfTargets = 0;
+    for (NSArray *indexes in self.targetIndexes) {
+        for (NSNumber *index in indexes) {
+            numberOfTargets = MAX(numberOfTargets, [index unsignedIntegerValue] + 1);
+        }
+    }
+    return numberOfTargets;
+}
+
+- (HLSAnimation *)animationWithTargets:(NSArray *)targets
+{
+    if (! self.targetIndexes) {
+        HLSLoggerError(@"Only unarchived animations can be bound to targets");
+        return nil;
+    }
+    
+    if ([targets count] != [self numberOfTargets]) {
+        HLSLoggerError(@"%d targets expected, %d received", [self numberOfTargets], [targets count]);
+        return nil;
+    }
+    
+    NSMutableArray *animationSteps = [NSMutableArray array];
+    NSUInteger i = 0;
+    for (HLSAnimationStep *animationStep in self.animationSteps) {
+        BOOL layerAnimationStep = [animationStep isKindOfClass:[HLSLayerAnimationStep class]];
+        NSMutableArray *objects = [NSMutableArray array];
+        for (NSNumber *index in [self.targetIndexes objectAtIndex:i]) {
+            id target = [targets objectAtIndex:[index unsignedIntegerValue]];
+            if (layerAnimationStep && [target isKindOfClass:[UIView class]]) {
+                target = [target layer];
+            }
+            [objects addObject:target];
+        }
+        
+        HLSAnimationStep *boundAnimationStep = [animationStep animationStepBindingObjects:objects];
+        if (! boundAnimationStep) {
+            return nil;
+        }
+        [animationSteps addObject:boundAnimationStep];
+        ++i;
+    }
+    
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
+    animation.tag = self.tag;
+    animation.lockingUI = self.lockingUI;
+    animation.rasterizingLayers = self.rasterizingLayers;
+    return animation;
+}
+
+- (HLSAnimation *)animationReplacingTargets:(NSArray *)targets withTargets:(NSArray *)replacementTargets
+{
+    if ([targets count] != [replacementTargets count]) {
+        HLSLoggerError(@"%d replacement targets expected, %d received", [targets count], [replacementTargets count]);
+        return nil;
+    }
+    
+    NSMutableArray *animationSteps = [NSMutableArray array];
+    for (HLSAnimationStep *animationStep in self.animationSteps) {
+        BOOL layerAnimationStep = [animationStep isKindOfClass:[HLSLayerAnimationStep class]];
+        NSMutableArray *objects = [NSMutableArray array];
+        for (id object in [animationStep objects]) {
+            NSUInteger i = 0;
+            for (id target in targets) {
+                if (layerAnimationStep && [target isKindOfClass:[UIView class]]) {
+                    target = [target layer];
+                }
+                
+                if (target == object) {
+                    object = [replacementTargets objectAtIndex:i];
+                    if (layerAnimationStep && [object isKindOfClass:[UIView class]]) {
+                        object = [object layer];
+                    }
+                    break;
+                }
+                ++i;
+            }
+            [objects addObject:object];
+        }
+        
+        HLSAnimationStep *boundAnimationStep = [animationStep animationStepBindingObjects:objects];
+        if (! boundAnimationStep) {
+            return nil;
+        }
+        [animationSteps addObject:boundAnimationStep];
+    }
+    
+    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithArray:animationSteps]];
+    animation.tag = self.tag;
+    animation.lockingUI = self.lockingUI;
+    animation.rasterizingLayers = self.rasterizingLayers;
+    return animation;
+}
+
 #pragma mark HLSAnimationStepDelegate protocol implementation
 
 - (void)animationStepDidStop:(HLSAnimationStep *)animationStep animated:(BOOL)animated finished:(BOOL)finished
 {
+    HLSTraceEnd(m_stepTraceIdentifier);
+    m_stepTraceIdentifier = 0;
+    
     // Still send all delegate notifications if terminating and if not playing animation steps instantaneously
     // when a start time has been set
     if (! self.cancelling && doubleeq(m_remainingTimeBeforeStart, 0.)) {
@@ -528,7 +1458,7 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
             // Note that if a delay has been set, this event is not fired until the delay period is over, as for UIView
             // animation blocks)
             if (m_currentRepeatCount == 0) {
-                if ([self.delegate respondsToSelector:@selector(animationWillStart:animated:)]) {
+                if (m_delegateFlags.willStart) {
                     [self.delegate animationWillStart:self animated:animated];
                 }
                 
@@ -536,7 +1466,7 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
             }
         }
         else {
-            if ([self.delegate respondsToSelector:@selector(animation:didFinishStep:animated:)]) {
+            if (m_delegateFlags.didFinishStep) {
                 [self.delegate animation:self didFinishStep:animationStep animated:animated];
             }
         }
@@ -558,7 +1488,10 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 - (id)copyWithZone:(NSZone *)zone
 {
     HLSAnimation *animationCopy = nil;
-    if (self.animationSteps) {
+    if (self.frozen) {
+        animationCopy = [[HLSAnimation allocWithZone:zone] initWithFrozenAnimationSteps:self.animationSteps];
+    }
+    else if (self.animationSteps) {
         NSMutableArray *animationStepCopies = [NSMutableArray array];
         for (HLSAnimationStep *animationStep in self.animationSteps) {
             HLSAnimationStep *animationStepCopy = [[animationStep copyWithZone:zone] autorelease];
@@ -572,16 +1505,73 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
     
     animationCopy.tag = self.tag;
     animationCopy.lockingUI = self.lockingUI;
+    animationCopy.rasterizingLayers = self.rasterizingLayers;
     animationCopy.delegate = self.delegate;
     animationCopy.userInfo = self.userInfo;
+    animationCopy.targetIndexes = self.targetIndexes;
     
     return animationCopy;
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [self initWithAnimationSteps:[aDecoder decodeObjectForKey:@"animationSteps"]])) {
+        self.targetIndexes = [aDecoder decodeObjectForKey:@"targetIndexes"];
+        self.tag = [aDecoder decodeObjectForKey:@"tag"];
+        self.lockingUI = [aDecoder decodeBoolForKey:@"lockingUI"];
+        self.rasterizingLayers = [aDecoder decodeBoolForKey:@"rasterizingLayers"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    // Replace objects with target numbers, assigned in the order objects first appear. For each step, store the target
+    // number of each of its object animations
+    NSArray *targetIndexes = self.targetIndexes;
+    if (! targetIndexes) {
+        NSMutableArray *targets = [NSMutableArray array];
+        NSMutableArray *stepTargetIndexes = [NSMutableArray array];
+        for (HLSAnimationStep *animationStep in self.animationSteps) {
+            NSMutableArray *indexes = [NSMutableArray array];
+            for (id object in [animationStep objects]) {
+                // Layers of views are identified with their view, so that a view animated by view and layer animation steps 
+                // is a single target
+                if ([object isKindOfClass:[CALayer class]] && [[object delegate] isKindOfClass:[UIView class]]
+                        && [[object delegate] layer] == object) {
+                    object = [object delegate];
+                }
+                
+                NSUInteger index = [targets indexOfObjectIdenticalTo:object];
+                if (index == NSNotFound) {
+                    index = [targets count];
+                    [targets addObject:object];
+                }
+                [indexes addObject:[NSNumber numberWithUnsignedInteger:index]];
+            }
+            [stepTargetIndexes addObject:[NSArray arrayWithArray:indexes]];
+        }
+        targetIndexes = [NSArray arrayWithArray:stepTargetIndexes];
+    }
+    
+    [aCoder encodeObject:self.animationSteps forKey:@"animationSteps"];
+    [aCoder encodeObject:targetIndexes forKey:@"targetIndexes"];
+    [aCoder encodeObject:self.tag forKey:@"tag"];
+    [aCoder encodeBool:self.lockingUI forKey:@"lockingUI"];
+    [aCoder encodeBool:self.rasterizingLayers forKey:@"rasterizingLayers"];
+}
+
 #pragma mark Notification callbacks
 
 - (void)applicationDidEnterBackground:(NSNotification *)notification
 {
+    // Scrubbing and native loop animations are left as is, they are namely not removed when the application enters background
+    if (self.scrubbing || m_loopingNatively) {
+        return;
+    }
+    
     m_runningBeforeEnteringBackground = self.running;
     
     if (m_runningBeforeEnteringBackground) {
@@ -620,12 +1610,13 @@ static NSString * const kDelayLayerAnimationTag = @"HLSDelayLayerAnimationStep";
 
 - (NSString *)description
 {
-    return [NSString stringWithFormat:@"<%@: %p; animationSteps: %@; tag: %@; lockingUI: %@; delegate: %p>",
+    return [NSString stringWithFormat:@"<%@: %p; animationSteps: %@; tag: %@; lockingUI: %@; frozen: %@; delegate: %p>",
             [self class],
             self,
             self.animationSteps,
             self.tag,
             HLSStringFromBool(self.lockingUI),
+            HLSStringFromBool(self.frozen),
             self.delegate];
 }
 
@@ -0,0 +1,82 @@
+//
+//  HLSAnimationProfiler.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+// Forward declarations
+@class HLSAnimation;
+
+/**
+ * Keys of the report dictionaries returned by HLSAnimationProfiler (values are NSNumber objects)
+ */
+extern NSString * const HLSAnimationProfilerAnimationCountKey;              // number of animations played until the end
+extern NSString * const HLSAnimationProfilerFrameCountKey;                  // number of frames displayed
+extern NSString * const HLSAnimationProfilerDroppedFrameCountKey;           // number of frames which were not displayed in time
+extern NSString * const HLSAnimationProfilerLongestFrameDurationKey;        // longest frame duration (in seconds)
+extern NSString * const HLSAnimationProfilerP95FrameDurationKey;            // 95th percentile of frame durations (in seconds, 1 ms accuracy)
+
+/**
+ * Key under which untagged animations are reported
+ */
+extern NSString * const HLSAnimationProfilerUntaggedAnimationKey;
+
+/**
+ * The animation profiler measures the frame rate at which animations (HLSAnimation) are displayed. When enabled, a 
+ * display link is attached while animations are played animated, and the time elapsed between successive frames is 
+ * recorded until the animation ends. Statistics are then logged (with info level) and accumulated per animation tag, 
+ * so that animations which stutter can easily be spotted, even in the field.
+ *
+ * Animations which are played non-animated, scrubbed, cancelled or terminated are not profiled.
+ *
+ * This class is not thread-safe and must only be used from the main thread.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSAnimationProfiler : NSObject {
+@private
+    BOOL m_enabled;
+    CADisplayLink *m_displayLink;
+    NSMutableArray *m_sessions;
+    NSMutableDictionary *m_tagToStatisticsMap;
+}
+
+/**
+ * The profiler used by all animations
+ */
++ (HLSAnimationProfiler *)sharedAnimationProfiler;
+
+/**
+ * Set to YES to enable profiling. Animations already being played are not profiled
+ *
+ * Default value is NO
+ */
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ * Start and stop profiling an animation. These methods are called by HLSAnimation, you should not need to call them 
+ * yourself. The frames measured for an animation are discarded if discarding is set to YES
+ */
+- (void)startProfilingAnimation:(HLSAnimation *)animation;
+- (void)stopProfilingAnimation:(HLSAnimation *)animation discarding:(BOOL)discarding;
+
+/**
+ * Return the report for animations with a given tag (nil if none), or for untagged animations if tag is nil. Reports 
+ * are dictionaries whose keys are listed at the top of this file
+ */
+- (NSDictionary *)reportForTag:(NSString *)tag;
+
+/**
+ * Return the reports for all animations profiled so far, with animation tags (or HLSAnimationProfilerUntaggedAnimationKey) 
+ * as keys
+ */
+- (NSDictionary *)reports;
+
+/**
+ * Discard all statistics collected so far
+ */
+- (void)reset;
+
+@end
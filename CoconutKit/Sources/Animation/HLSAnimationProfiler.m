@@ -0,0 +1,357 @@
+//
+//  HLSAnimationProfiler.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAnimationProfiler.h"
+
+#import "HLSAnimation.h"
+#import "HLSLogger.h"
+
+NSString * const HLSAnimationProfilerAnimationCountKey = @"HLSAnimationProfilerAnimationCount";
+NSString * const HLSAnimationProfilerFrameCountKey = @"HLSAnimationProfilerFrameCount";
+NSString * const HLSAnimationProfilerDroppedFrameCountKey = @"HLSAnimationProfilerDroppedFrameCount";
+NSString * const HLSAnimationProfilerLongestFrameDurationKey = @"HLSAnimationProfilerLongestFrameDuration";
+NSString * const HLSAnimationProfilerP95FrameDurationKey = @"HLSAnimationProfilerP95FrameDuration";
+
+NSString * const HLSAnimationProfilerUntaggedAnimationKey = @"HLSAnimationProfilerUntaggedAnimation";
+
+// Frame durations are accumulated into an histogram with 1 ms buckets, so that percentiles can be computed without
+// storing all frame durations. The last bucket collects all frames longer than the histogram range
+#define HLSAnimationProfilerBucketCount     250
+
+static const CFTimeInterval kDefaultFrameDuration = 1. / 60.;
+
+/**
+ * Private class collecting frame statistics
+ */
+@interface HLSAnimationFrameStatistics : NSObject {
+@private
+    NSUInteger m_nbrAnimations;
+    NSUInteger m_nbrFrames;
+    NSUInteger m_nbrDroppedFrames;
+    CFTimeInterval m_longestFrameDuration;
+    NSUInteger m_buckets[HLSAnimationProfilerBucketCount];
+}
+
+- (void)recordFrameDuration:(CFTimeInterval)frameDuration nominalFrameDuration:(CFTimeInterval)nominalFrameDuration;
+- (void)addStatistics:(HLSAnimationFrameStatistics *)statistics;
+
+@property (nonatomic, assign) NSUInteger nbrAnimations;
+@property (nonatomic, readonly, assign) NSUInteger nbrFrames;
+@property (nonatomic, readonly, assign) NSUInteger nbrDroppedFrames;
+@property (nonatomic, readonly, assign) CFTimeInterval longestFrameDuration;
+
+- (CFTimeInterval)p95FrameDuration;
+- (NSDictionary *)report;
+
+@end
+
+/**
+ * Private class storing the information related to an animation being profiled
+ */
+@interface HLSAnimationProfilingSession : NSObject {
+@private
+    HLSAnimation *m_animation;
+    CFTimeInterval m_lastTimestamp;
+    HLSAnimationFrameStatistics *m_statistics;
+}
+
+@property (nonatomic, assign) HLSAnimation *animation;          // not retained, sessions are stopped before animations die
+@property (nonatomic, assign) CFTimeInterval lastTimestamp;
+@property (nonatomic, retain) HLSAnimationFrameStatistics *statistics;
+
+@end
+
+@interface HLSAnimationProfiler ()
+
+@property (nonatomic, retain) CADisplayLink *displayLink;
+@property (nonatomic, retain) NSMutableArray *sessions;
+@property (nonatomic, retain) NSMutableDictionary *tagToStatisticsMap;
+
+- (void)tick:(CADisplayLink *)displayLink;
+
+@end
+
+@implementation HLSAnimationProfiler
+
+#pragma mark Class methods
+
++ (HLSAnimationProfiler *)sharedAnimationProfiler
+{
+    static HLSAnimationProfiler *s_instance = nil;
+    
+    if (! s_instance) {
+        s_instance = [[HLSAnimationProfiler alloc] init];
+    }
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.sessions = [NSMutableArray array];
+        self.tagToStatisticsMap = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // The display link retains its target. This only happens when no session is left
+    [self.displayLink invalidate];
+    
+    self.displayLink = nil;
+    self.sessions = nil;
+    self.tagToStatisticsMap = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize enabled = m_enabled;
+
+@synthesize displayLink = m_displayLink;
+
+@synthesize sessions = m_sessions;
+
+@synthesize tagToStatisticsMap = m_tagToStatisticsMap;
+
+#pragma mark Profiling
+
+- (void)startProfilingAnimation:(HLSAnimation *)animation
+{
+    if (! self.enabled) {
+        return;
+    }
+    
+    for (HLSAnimationProfilingSession *session in self.sessions) {
+        if (session.animation == animation) {
+            HLSLoggerDebug(@"The animation %@ is already being profiled", animation);
+            return;
+        }
+    }
+    
+    HLSAnimationProfilingSession *session = [[[HLSAnimationProfilingSession alloc] init] autorelease];
+    session.animation = animation;
+    [self.sessions addObject:session];
+    
+    // A single display link is shared by all animations being profiled
+    if (! self.displayLink) {
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(tick:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+}
+
+- (void)stopProfilingAnimation:(HLSAnimation *)animation discarding:(BOOL)discarding
+{
+    HLSAnimationProfilingSession *session = nil;
+    for (HLSAnimationProfilingSession *aSession in self.sessions) {
+        if (aSession.animation == animation) {
+            session = aSession;
+            break;
+        }
+    }
+    
+    if (! session) {
+        return;
+    }
+    
+    // Keep the session alive while it is removed
+    [[session retain] autorelease];
+    [self.sessions removeObject:session];
+    
+    if ([self.sessions count] == 0) {
+        [self.displayLink invalidate];
+        self.displayLink = nil;
+    }
+    
+    if (discarding) {
+        return;
+    }
+    
+    HLSAnimationFrameStatistics *statistics = session.statistics;
+    statistics.nbrAnimations = 1;
+    HLSLoggerInfo(@"Animation %@: %d frames, %d dropped, longest frame %.1f ms, p95 frame %.1f ms", 
+                  animation.tag, 
+                  statistics.nbrFrames, 
+                  statistics.nbrDroppedFrames, 
+                  statistics.longestFrameDuration * 1000., 
+                  [statistics p95FrameDuration] * 1000.);
+    
+    NSString *key = animation.tag ? animation.tag : HLSAnimationProfilerUntaggedAnimationKey;
+    HLSAnimationFrameStatistics *tagStatistics = [self.tagToStatisticsMap objectForKey:key];
+    if (! tagStatistics) {
+        tagStatistics = [[[HLSAnimationFrameStatistics alloc] init] autorelease];
+        [self.tagToStatisticsMap setObject:tagStatistics forKey:key];
+    }
+    [tagStatistics addStatistics:statistics];
+}
+
+#pragma mark Reports
+
+- (NSDictionary *)reportForTag:(NSString *)tag
+{
+    HLSAnimationFrameStatistics *statistics = [self.tagToStatisticsMap objectForKey:tag ? tag : HLSAnimationProfilerUntaggedAnimationKey];
+    return [statistics report];
+}
+
+- (NSDictionary *)reports
+{
+    NSMutableDictionary *reports = [NSMutableDictionary dictionary];
+    for (NSString *key in [self.tagToStatisticsMap allKeys]) {
+        HLSAnimationFrameStatistics *statistics = [self.tagToStatisticsMap objectForKey:key];
+        [reports setObject:[statistics report] forKey:key];
+    }
+    return [NSDictionary dictionaryWithDictionary:reports];
+}
+
+- (void)reset
+{
+    [self.tagToStatisticsMap removeAllObjects];
+}
+
+#pragma mark Display link callback
+
+- (void)tick:(CADisplayLink *)displayLink
+{
+    // The display link duration is only available after the first frame
+    CFTimeInterval nominalFrameDuration = displayLink.duration > 0. ? displayLink.duration * displayLink.frameInterval : kDefaultFrameDuration;
+    for (HLSAnimationProfilingSession *session in self.sessions) {
+        // The first frame of a session only provides a reference timestamp
+        if (session.lastTimestamp > 0.) {
+            [session.statistics recordFrameDuration:displayLink.timestamp - session.lastTimestamp
+                               nominalFrameDuration:nominalFrameDuration];
+        }
+        session.lastTimestamp = displayLink.timestamp;
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; enabled: %@; sessions: %d; reports: %@>",
+            [self class],
+            self,
+            self.enabled ? @"YES" : @"NO",
+            [self.sessions count],
+            [self reports]];
+}
+
+@end
+
+@implementation HLSAnimationFrameStatistics
+
+#pragma mark Accessors and mutators
+
+@synthesize nbrAnimations = m_nbrAnimations;
+
+@synthesize nbrFrames = m_nbrFrames;
+
+@synthesize nbrDroppedFrames = m_nbrDroppedFrames;
+
+@synthesize longestFrameDuration = m_longestFrameDuration;
+
+#pragma mark Recording
+
+- (void)recordFrameDuration:(CFTimeInterval)frameDuration nominalFrameDuration:(CFTimeInterval)nominalFrameDuration
+{
+    ++m_nbrFrames;
+    
+    // Frames which should have been displayed in the meantime have been dropped
+    long nbrMissedFrames = lround(frameDuration / nominalFrameDuration) - 1;
+    if (nbrMissedFrames > 0) {
+        m_nbrDroppedFrames += nbrMissedFrames;
+    }
+    
+    if (frameDuration > m_longestFrameDuration) {
+        m_longestFrameDuration = frameDuration;
+    }
+    
+    NSUInteger bucket = (NSUInteger)(frameDuration * 1000.);
+    if (bucket >= HLSAnimationProfilerBucketCount) {
+        bucket = HLSAnimationProfilerBucketCount - 1;
+    }
+    ++m_buckets[bucket];
+}
+
+- (void)addStatistics:(HLSAnimationFrameStatistics *)statistics
+{
+    m_nbrAnimations += statistics->m_nbrAnimations;
+    m_nbrFrames += statistics->m_nbrFrames;
+    m_nbrDroppedFrames += statistics->m_nbrDroppedFrames;
+    if (statistics->m_longestFrameDuration > m_longestFrameDuration) {
+        m_longestFrameDuration = statistics->m_longestFrameDuration;
+    }
+    for (NSUInteger i = 0; i < HLSAnimationProfilerBucketCount; ++i) {
+        m_buckets[i] += statistics->m_buckets[i];
+    }
+}
+
+#pragma mark Statistics
+
+- (CFTimeInterval)p95FrameDuration
+{
+    if (m_nbrFrames == 0) {
+        return 0.;
+    }
+    
+    // Smallest bucket upper bound below which at least 95% of all frames lie
+    NSUInteger threshold = (NSUInteger)ceil(0.95 * m_nbrFrames);
+    NSUInteger nbrFrames = 0;
+    for (NSUInteger i = 0; i < HLSAnimationProfilerBucketCount - 1; ++i) {
+        nbrFrames += m_buckets[i];
+        if (nbrFrames >= threshold) {
+            return MIN((i + 1) / 1000., m_longestFrameDuration);
+        }
+    }
+    return m_longestFrameDuration;
+}
+
+- (NSDictionary *)report
+{
+    return [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:m_nbrAnimations], HLSAnimationProfilerAnimationCountKey,
+            [NSNumber numberWithUnsignedInteger:m_nbrFrames], HLSAnimationProfilerFrameCountKey,
+            [NSNumber numberWithUnsignedInteger:m_nbrDroppedFrames], HLSAnimationProfilerDroppedFrameCountKey,
+            [NSNumber numberWithDouble:m_longestFrameDuration], HLSAnimationProfilerLongestFrameDurationKey,
+            [NSNumber numberWithDouble:[self p95FrameDuration]], HLSAnimationProfilerP95FrameDurationKey,
+            nil];
+}
+
+@end
+
+@implementation HLSAnimationProfilingSession
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.statistics = [[[HLSAnimationFrameStatistics alloc] init] autorelease];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.statistics = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize animation = m_animation;
+
+@synthesize lastTimestamp = m_lastTimestamp;
+
+@synthesize statistics = m_statistics;
+
+@end
@@ -47,6 +47,18 @@
  */
 - (id)reverseAnimationStep;
 
+/**
+ * The object animations of the step, in the order the objects were added to it. For unarchived steps, return the object
+ * animations which have not been bound to any object yet
+ */
+- (NSArray *)objectAnimations;
+
+/**
+ * Return a copy of an unarchived animation step, whose object animations (in the order returned by -objectAnimations)
+ * are bound to the specified objects. Return nil if the number of objects does not match
+ */
+- (id)animationStepBindingObjects:(NSArray *)objects;
+
 /**
  * Return YES iff the animation has been paused
  */
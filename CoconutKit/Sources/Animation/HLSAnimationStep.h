@@ -12,12 +12,17 @@
 /**
  * Abstract base class for animation steps. Do not instantiate directly
  *
+ * Animation steps can be archived. Since the objects they animate cannot be archived, the object animations of an
+ * unarchived animation step are not bound to any object. Binding happens at the HLSAnimation level (see the
+ * -animationWithTargets: method). The userInfo dictionary is not archived
+ *
  * Designated initializer: -init
  */
-@interface HLSAnimationStep : NSObject <NSCopying> {
+@interface HLSAnimationStep : NSObject <NSCopying, NSCoding> {
 @private
     NSMutableArray *m_objectKeys;
     NSMutableDictionary *m_objectToObjectAnimationMap;
+    NSArray *m_unboundObjectAnimations;                         // object animations of an unarchived step
     NSString *m_tag;
     NSDictionary *m_userInfo;
     NSTimeInterval m_duration;
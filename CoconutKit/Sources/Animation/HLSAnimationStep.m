@@ -20,6 +20,7 @@
 
 @property (nonatomic, retain) NSMutableArray *objectKeys;
 @property (nonatomic, retain) NSMutableDictionary *objectToObjectAnimationMap;
+@property (nonatomic, retain) NSArray *unboundObjectAnimations;
 @property (nonatomic, retain) id<HLSAnimationStepDelegate> delegate;        // Set during animated animations to retain the delegate
 @property (nonatomic, assign, getter=isCancelling) BOOL terminating;
 
@@ -52,6 +53,7 @@
 {    
     self.objectKeys = nil;
     self.objectToObjectAnimationMap = nil;
+    self.unboundObjectAnimations = nil;
     self.tag = nil;
     self.userInfo = nil;
     self.delegate = nil;
@@ -65,6 +67,8 @@
 
 @synthesize objectToObjectAnimationMap = m_objectToObjectAnimationMap;
 
+@synthesize unboundObjectAnimations = m_unboundObjectAnimations;
+
 @synthesize tag = m_tag;
 
 @synthesize userInfo = m_userInfo;
@@ -131,6 +135,40 @@
     return [self.objectToObjectAnimationMap objectForKey:objectKey];
 }
 
+- (NSArray *)objectAnimations
+{
+    if (self.unboundObjectAnimations) {
+        return self.unboundObjectAnimations;
+    }
+    
+    NSMutableArray *objectAnimations = [NSMutableArray array];
+    for (NSValue *objectKey in self.objectKeys) {
+        [objectAnimations addObject:[self.objectToObjectAnimationMap objectForKey:objectKey]];
+    }
+    return [NSArray arrayWithArray:objectAnimations];
+}
+
+- (id)animationStepBindingObjects:(NSArray *)objects
+{
+    NSArray *objectAnimations = [self objectAnimations];
+    if ([objects count] != [objectAnimations count]) {
+        HLSLoggerError(@"%d objects expected, %d received", [objectAnimations count], [objects count]);
+        return nil;
+    }
+    
+    HLSAnimationStep *animationStep = [[self copy] autorelease];
+    animationStep.unboundObjectAnimations = nil;
+    [animationStep.objectKeys removeAllObjects];
+    [animationStep.objectToObjectAnimationMap removeAllObjects];
+    
+    NSUInteger i = 0;
+    for (HLSObjectAnimation *objectAnimation in objectAnimations) {
+        [animationStep addObjectAnimation:objectAnimation forObject:[objects objectAtIndex:i]];
+        ++i;
+    }
+    return animationStep;
+}
+
 #pragma mark Managing the animation
 
 - (void)playWithDelegate:(id<HLSAnimationStepDelegate>)delegate startTime:(NSTimeInterval)startTime animated:(BOOL)animated
@@ -274,12 +312,32 @@
         HLSObjectAnimation *objectAnimationCopy = [[objectAnimation copyWithZone:zone] autorelease];
         [animationStepCopy addObjectAnimation:objectAnimationCopy forObject:object];
     }
+    animationStepCopy.unboundObjectAnimations = self.unboundObjectAnimations;
     animationStepCopy.tag = self.tag;
     animationStepCopy.userInfo = self.userInfo;
     animationStepCopy.duration = self.duration;
     return animationStepCopy;
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [self init])) {
+        self.unboundObjectAnimations = [aDecoder decodeObjectForKey:@"objectAnimations"];
+        self.tag = [aDecoder decodeObjectForKey:@"tag"];
+        self.duration = [aDecoder decodeDoubleForKey:@"duration"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:[self objectAnimations] forKey:@"objectAnimations"];
+    [aCoder encodeObject:self.tag forKey:@"tag"];
+    [aCoder encodeDouble:self.duration forKey:@"duration"];
+}
+
 #pragma mark Description
 
 - (NSString *)objectAnimationsDescriptionString
@@ -42,4 +42,9 @@
  */
 @property (nonatomic, readonly, assign) CGFloat rasterizationScaleIncrement;
 
+/**
+ * The largest (absolute) scale factor applied to the layer in its plane
+ */
+@property (nonatomic, readonly, assign) CGFloat planarScaleFactor;
+
 @end
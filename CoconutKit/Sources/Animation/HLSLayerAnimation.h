@@ -43,6 +43,10 @@
     CGFloat m_opacityIncrement;
     BOOL m_togglingShouldRasterize;
     CGFloat m_rasterizationScaleIncrement;
+    CATransform3D m_transform;                              // cached transform
+    CATransform3D m_sublayerTransform;                      // cached sublayer transform
+    BOOL m_transformValid;
+    BOOL m_sublayerTransformValid;
 }
 
 /**
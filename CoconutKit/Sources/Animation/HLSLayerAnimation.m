@@ -82,18 +82,54 @@
 
 @synthesize rotationParameters = m_rotationParameters;
 
+- (void)setRotationParameters:(HLSVector4)rotationParameters
+{
+    m_rotationParameters = rotationParameters;
+    m_transformValid = NO;
+}
+
 @synthesize scaleParameters = m_scaleParameters;
 
+- (void)setScaleParameters:(HLSVector3)scaleParameters
+{
+    m_scaleParameters = scaleParameters;
+    m_transformValid = NO;
+}
+
 @synthesize translationParameters = m_translationParameters;
 
+- (void)setTranslationParameters:(HLSVector3)translationParameters
+{
+    m_translationParameters = translationParameters;
+    m_transformValid = NO;
+}
+
 @synthesize anchorPointTranslationParameters = m_anchorPointTranslationParameters;
 
 @synthesize sublayerRotationParameters = m_sublayerRotationParameters;
 
+- (void)setSublayerRotationParameters:(HLSVector4)sublayerRotationParameters
+{
+    m_sublayerRotationParameters = sublayerRotationParameters;
+    m_sublayerTransformValid = NO;
+}
+
 @synthesize sublayerScaleParameters = m_sublayerScaleParameters;
 
+- (void)setSublayerScaleParameters:(HLSVector3)sublayerScaleParameters
+{
+    m_sublayerScaleParameters = sublayerScaleParameters;
+    m_sublayerTransformValid = NO;
+}
+
 @synthesize sublayerTranslationParameters = m_sublayerTranslationParameters;
 
+- (void)setSublayerTranslationParameters:(HLSVector3)sublayerTranslationParameters
+{
+    m_sublayerTranslationParameters = sublayerTranslationParameters;
+    m_sublayerTransformValid = NO;
+}
+
 @synthesize sublayerCameraTranslationZ = m_sublayerCameraTranslationZ;
 
 @synthesize opacityIncrement = m_opacityIncrement;
@@ -102,11 +138,16 @@
 
 @synthesize rasterizationScaleIncrement = m_rasterizationScaleIncrement;
 
+// Transforms are composed lazily and cached until one of the parameters they depend on changes
 - (CATransform3D)transform
 {
-    CATransform3D transform = [self rotationTransform];
-    transform = CATransform3DConcat(transform, [self scaleTransform]);
-    return CATransform3DConcat(transform, [self translationTransform]);
+    if (! m_transformValid) {
+        CATransform3D transform = [self rotationTransform];
+        transform = CATransform3DConcat(transform, [self scaleTransform]);
+        m_transform = CATransform3DConcat(transform, [self translationTransform]);
+        m_transformValid = YES;
+    }
+    return m_transform;
 }
 
 - (CATransform3D)rotationTransform
@@ -124,6 +165,11 @@
                                   self.scaleParameters.v3);
 }
 
+- (CGFloat)planarScaleFactor
+{
+    return MAX(fabsf(self.scaleParameters.v1), fabsf(self.scaleParameters.v2));
+}
+
 - (CATransform3D)translationTransform
 {
     return CATransform3DMakeTranslation(self.translationParameters.v1,
@@ -133,10 +179,13 @@
 
 - (CATransform3D)sublayerTransform
 {
-    CATransform3D sublayerTransform = [self sublayerRotationTransform];
-    sublayerTransform = CATransform3DConcat(sublayerTransform, [self sublayerScaleTransform]);
-    sublayerTransform = CATransform3DConcat(sublayerTransform, [self sublayerTranslationTransform]);
-    return sublayerTransform;
+    if (! m_sublayerTransformValid) {
+        CATransform3D sublayerTransform = [self sublayerRotationTransform];
+        sublayerTransform = CATransform3DConcat(sublayerTransform, [self sublayerScaleTransform]);
+        m_sublayerTransform = CATransform3DConcat(sublayerTransform, [self sublayerTranslationTransform]);
+        m_sublayerTransformValid = YES;
+    }
+    return m_sublayerTransform;
 }
 
 - (CATransform3D)sublayerRotationTransform;
@@ -283,26 +332,16 @@
                         aboutVectorWithX:self.rotationParameters.v2
                                        y:self.rotationParameters.v3
                                        z:self.rotationParameters.v4];
-    [reverseLayerAnimation scaleWithXFactor:1.f / self.scaleParameters.v1
-                                    yFactor:1.f / self.scaleParameters.v2
-                                    zFactor:1.f / self.scaleParameters.v3];
-    [reverseLayerAnimation translateByVectorWithX:-self.translationParameters.v1
-                                                y:-self.translationParameters.v2
-                                                z:-self.translationParameters.v3];
-    [reverseLayerAnimation translateAnchorPointByVectorWithX:-self.anchorPointTranslationParameters.v1
-                                                           y:-self.anchorPointTranslationParameters.v2
-                                                           z:-self.anchorPointTranslationParameters.v3];
+    reverseLayerAnimation.scaleParameters = HLSVector3Reciprocal(self.scaleParameters);
+    reverseLayerAnimation.translationParameters = HLSVector3Scale(self.translationParameters, -1.f);
+    reverseLayerAnimation.anchorPointTranslationParameters = HLSVector3Scale(self.anchorPointTranslationParameters, -1.f);
     
     [reverseLayerAnimation rotateSublayersByAngle:-self.sublayerRotationParameters.v1
                                  aboutVectorWithX:self.sublayerRotationParameters.v2
                                                 y:self.sublayerRotationParameters.v3
                                                 z:self.sublayerRotationParameters.v4];
-    [reverseLayerAnimation scaleSublayersWithXFactor:1.f / self.sublayerScaleParameters.v1
-                                             yFactor:1.f / self.sublayerScaleParameters.v2
-                                             zFactor:1.f / self.sublayerScaleParameters.v3];
-    [reverseLayerAnimation translateSublayersByVectorWithX:-self.sublayerTranslationParameters.v1
-                                                         y:-self.sublayerTranslationParameters.v2
-                                                         z:-self.sublayerTranslationParameters.v3];
+    reverseLayerAnimation.sublayerScaleParameters = HLSVector3Reciprocal(self.sublayerScaleParameters);
+    reverseLayerAnimation.sublayerTranslationParameters = HLSVector3Scale(self.sublayerTranslationParameters, -1.f);
     [reverseLayerAnimation translateSublayerCameraByVectorWithZ:-self.sublayerCameraTranslationZ];
     
     reverseLayerAnimation.opacityIncrement = -self.opacityIncrement;
@@ -311,6 +350,47 @@
     return reverseLayerAnimation;
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [super initWithCoder:aDecoder])) {
+        self.rotationParameters = HLSVector4FromArray([aDecoder decodeObjectForKey:@"rotationParameters"]);
+        self.scaleParameters = HLSVector3FromArray([aDecoder decodeObjectForKey:@"scaleParameters"]);
+        self.translationParameters = HLSVector3FromArray([aDecoder decodeObjectForKey:@"translationParameters"]);
+        self.anchorPointTranslationParameters = HLSVector3FromArray([aDecoder decodeObjectForKey:@"anchorPointTranslationParameters"]);
+        
+        self.sublayerRotationParameters = HLSVector4FromArray([aDecoder decodeObjectForKey:@"sublayerRotationParameters"]);
+        self.sublayerScaleParameters = HLSVector3FromArray([aDecoder decodeObjectForKey:@"sublayerScaleParameters"]);
+        self.sublayerTranslationParameters = HLSVector3FromArray([aDecoder decodeObjectForKey:@"sublayerTranslationParameters"]);
+        self.sublayerCameraTranslationZ = [aDecoder decodeFloatForKey:@"sublayerCameraTranslationZ"];
+        
+        self.opacityIncrement = [aDecoder decodeFloatForKey:@"opacityIncrement"];
+        self.togglingShouldRasterize = [aDecoder decodeBoolForKey:@"togglingShouldRasterize"];
+        self.rasterizationScaleIncrement = [aDecoder decodeFloatForKey:@"rasterizationScaleIncrement"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    
+    [aCoder encodeObject:HLSArrayFromVector4(self.rotationParameters) forKey:@"rotationParameters"];
+    [aCoder encodeObject:HLSArrayFromVector3(self.scaleParameters) forKey:@"scaleParameters"];
+    [aCoder encodeObject:HLSArrayFromVector3(self.translationParameters) forKey:@"translationParameters"];
+    [aCoder encodeObject:HLSArrayFromVector3(self.anchorPointTranslationParameters) forKey:@"anchorPointTranslationParameters"];
+    
+    [aCoder encodeObject:HLSArrayFromVector4(self.sublayerRotationParameters) forKey:@"sublayerRotationParameters"];
+    [aCoder encodeObject:HLSArrayFromVector3(self.sublayerScaleParameters) forKey:@"sublayerScaleParameters"];
+    [aCoder encodeObject:HLSArrayFromVector3(self.sublayerTranslationParameters) forKey:@"sublayerTranslationParameters"];
+    [aCoder encodeFloat:self.sublayerCameraTranslationZ forKey:@"sublayerCameraTranslationZ"];
+    
+    [aCoder encodeFloat:self.opacityIncrement forKey:@"opacityIncrement"];
+    [aCoder encodeBool:self.togglingShouldRasterize forKey:@"togglingShouldRasterize"];
+    [aCoder encodeFloat:self.rasterizationScaleIncrement forKey:@"rasterizationScaleIncrement"];
+}
+
 #pragma mark NSCopying protocol implementation
 
 - (id)copyWithZone:(NSZone *)zone
@@ -330,6 +410,12 @@
     layerAnimationCopy.opacityIncrement = self.opacityIncrement;
     layerAnimationCopy.togglingShouldRasterize = self.togglingShouldRasterize;
     layerAnimationCopy.rasterizationScaleIncrement = self.rasterizationScaleIncrement;
+    
+    // Animation steps are deeply copied each time they are played. Share the transforms already computed
+    layerAnimationCopy->m_transform = m_transform;
+    layerAnimationCopy->m_transformValid = m_transformValid;
+    layerAnimationCopy->m_sublayerTransform = m_sublayerTransform;
+    layerAnimationCopy->m_sublayerTransformValid = m_sublayerTransformValid;
     return layerAnimationCopy;
 }
 
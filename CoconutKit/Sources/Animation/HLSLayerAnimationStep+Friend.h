@@ -0,0 +1,59 @@
+//
+//  HLSLayerAnimationStep+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Interface meant to be used by friend classes of HLSLayerAnimationStep (= classes which must have access to private implementation
+ * details)
+ */
+@interface HLSLayerAnimationStep (Friend)
+
+/**
+ * Apply the step to all layers it involves, attaching the corresponding animations at the specified begin time (in the layer
+ * time space) and under the specified key. Animations are never removed on completion, so that the whole animation can be
+ * scrubbed back and forth. The animatedLayers set contains the layers animated by previous steps, those animated by the 
+ * receiver are added to it
+ */
+- (void)addScrubbingAnimationsWithBeginTime:(CFTimeInterval)beginTime forKey:(NSString *)key animatedLayers:(NSMutableSet *)animatedLayers;
+
+/**
+ * Apply the step to all layers it involves, collecting the corresponding animation groups (beginning at the specified
+ * time) into a dictionary mapping layers (as NSValue pointers) to mutable arrays of animation groups. Groups are never
+ * removed on completion, and are meant to be played within a common parent animation group
+ */
+- (void)addAnimationGroupsWithBeginTime:(CFTimeInterval)beginTime toLayerAnimationGroupsMap:(NSMutableDictionary *)layerAnimationGroupsMap;
+
+/**
+ * Return the timing of the animation of a layer within the step: Begin and end fractions of the step duration, and 
+ * timing function (never nil)
+ */
+- (void)getTimingForLayer:(CALayer *)layer 
+            beginFraction:(CGFloat *)pBeginFraction 
+              endFraction:(CGFloat *)pEndFraction 
+           timingFunction:(CAMediaTimingFunction **)pTimingFunction;
+
+/**
+ * All layers animated by the step, in the order they were added to it
+ */
+- (NSArray *)layers;
+
+/**
+ * The largest scale factor applied to a layer in its plane by the step (1 if the layer is not animated by the step)
+ */
+- (CGFloat)scaleFactorForLayer:(CALayer *)layer;
+
+/**
+ * Return YES iff the step explicitly alters the rasterization settings of a layer
+ */
+- (BOOL)isChangingRasterizationOfLayer:(CALayer *)layer;
+
+/**
+ * Return YES iff the step alters the sublayer transform of a layer (including its sublayer camera)
+ */
+- (BOOL)isChangingSublayerTransformOfLayer:(CALayer *)layer;
+
+@end
@@ -23,7 +23,9 @@
 @interface HLSLayerAnimationStep : HLSAnimationStep {
 @private
     CAMediaTimingFunction *m_timingFunction;
-    UIView *m_dummyView;
+    CALayer *m_timingLayer;
+    NSMutableDictionary *m_layerKeyToTimingMap;
+    NSArray *m_unboundTimings;
     NSUInteger m_numberOfLayerAnimations;
     BOOL m_numberOfStartedLayerAnimations;
     NSUInteger m_numberOfFinishedLayerAnimations;
@@ -45,6 +47,21 @@
  */
 - (void)addLayerAnimation:(HLSLayerAnimation *)layerAnimation forView:(UIView *)view;
 
+/**
+ * Same as -addLayerAnimation:forLayer:, but with the layer animation having its own timing within the step, so that
+ * several effects with different durations can be played concurrently in a single step. The layer animation begins
+ * and ends at the specified fractions of the step duration (0 <= beginFraction <= endFraction <= 1). If timingFunction 
+ * is nil, the timing function of the step is used
+ *
+ * Timings are expressed relative to the step duration, and are therefore preserved when the duration of an animation
+ * is changed (see -[HLSAnimation animationWithDuration:])
+ */
+- (void)addLayerAnimation:(HLSLayerAnimation *)layerAnimation 
+                 forLayer:(CALayer *)layer 
+              beginningAt:(CGFloat)beginFraction 
+                 endingAt:(CGFloat)endFraction 
+           timingFunction:(CAMediaTimingFunction *)timingFunction;
+
 /**
  * The animation timing function to use
  *
@@ -10,9 +10,11 @@
 
 #import "CALayer+HLSExtensions.h"
 #import "CAMediaTimingFunction+HLSExtensions.h"
+#import "HLSAnimationStep+Friend.h"
 #import "HLSAnimationStep+Protected.h"
 #import "HLSFloat.h"
 #import "HLSLayerAnimation+Friend.h"
+#import "HLSLayerAnimationStep+Friend.h"
 #import "HLSLogger.h"
 
 #if TARGET_IPHONE_SIMULATOR
@@ -20,7 +22,7 @@
 #endif
 
 static NSString * const kLayerAnimationGroupKey = @"HLSLayerAnimationGroup";
-static NSString * const kDummyViewLayerAnimationKey = @"HLSDummyViewLayerAnimation";
+static NSString * const kTimingLayerAnimationKey = @"HLSTimingLayerAnimation";
 
 static NSString * const kLayerNonProjectedSublayerTransformKey = @"HLSNonProjectedSublayerTransform";
 static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZPositionForSublayers";
@@ -29,9 +31,44 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 //         to be consistent with UIView block-based animations we do not override the default
 //         duration received from HLSAnimationStep (0.2) and set an ease-in ease-out function
 
+// Remark: Layer properties are set with implicit animations disabled, and each layer only receives a single explicit
+//         animation group carrying its own duration. Previously, the transaction duration was used instead, and layers
+//         not backed by a view additionally received implicit animations for every property being set. The start and end
+//         of a step were moreover detected by animating a dummy view added to the key window, which triggered a view 
+//         hierarchy change for each step. A bare layer is now used for this purpose
+
+/**
+ * Private class describing the timing of a layer animation within a step
+ */
+@interface HLSLayerAnimationTiming : NSObject <NSCoding> {
+@private
+    CGFloat m_beginFraction;
+    CGFloat m_endFraction;
+    CAMediaTimingFunction *m_timingFunction;
+}
+
+@property (nonatomic, assign) CGFloat beginFraction;
+@property (nonatomic, assign) CGFloat endFraction;
+@property (nonatomic, retain) CAMediaTimingFunction *timingFunction;         // nil if the one of the step is used
+
+- (HLSLayerAnimationTiming *)reverseTiming;
+
+@end
+
 @interface HLSLayerAnimationStep ()
 
-@property (nonatomic, retain) UIView *dummyView;
+@property (nonatomic, retain) CALayer *timingLayer;
+@property (nonatomic, retain) NSMutableDictionary *layerKeyToTimingMap;
+@property (nonatomic, retain) NSArray *unboundTimings;
+
+- (NSArray *)orderedTimings;
+
+- (NSArray *)applyToLayer:(CALayer *)layer createAnimations:(BOOL)createAnimations;
+- (NSArray *)configureAnimations:(NSArray *)animations 
+                        forLayer:(CALayer *)layer 
+                    withDuration:(NSTimeInterval)duration 
+                       startTime:(NSTimeInterval)startTime;
+- (CAAnimationGroup *)animationGroupForLayer:(CALayer *)layer beginTime:(CFTimeInterval)beginTime initial:(BOOL)initial;
 
 - (void)animationDidStart:(CAAnimation *)animation;
 - (void)animationDidStop:(CAAnimation *)animation finished:(BOOL)finished;
@@ -46,6 +83,7 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 {
     if ((self = [super init])) {
         self.timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut];        
+        self.layerKeyToTimingMap = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -53,7 +91,9 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 - (void)dealloc
 {
     self.timingFunction = nil;
-    self.dummyView = nil;
+    self.timingLayer = nil;
+    self.layerKeyToTimingMap = nil;
+    self.unboundTimings = nil;
     
     [super dealloc];
 }
@@ -62,7 +102,26 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 
 @synthesize timingFunction = m_timingFunction;
 
-@synthesize dummyView = m_dummyView;
+@synthesize timingLayer = m_timingLayer;
+
+@synthesize layerKeyToTimingMap = m_layerKeyToTimingMap;
+
+@synthesize unboundTimings = m_unboundTimings;
+
+// Timings in the order of -objectAnimations (NSNull if none)
+- (NSArray *)orderedTimings
+{
+    if (self.unboundTimings) {
+        return self.unboundTimings;
+    }
+    
+    NSMutableArray *timings = [NSMutableArray array];
+    for (CALayer *layer in [self objects]) {
+        HLSLayerAnimationTiming *timing = [self.layerKeyToTimingMap objectForKey:[NSValue valueWithPointer:layer]];
+        [timings addObject:timing ? (id)timing : (id)[NSNull null]];
+    }
+    return [NSArray arrayWithArray:timings];
+}
 
 #pragma mark Managing the animation
 
@@ -71,6 +130,31 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     [self addObjectAnimation:layerAnimation forObject:layer];
 }
 
+- (void)addLayerAnimation:(HLSLayerAnimation *)layerAnimation 
+                 forLayer:(CALayer *)layer 
+              beginningAt:(CGFloat)beginFraction 
+                 endingAt:(CGFloat)endFraction 
+           timingFunction:(CAMediaTimingFunction *)timingFunction
+{
+    if (floatlt(beginFraction, 0.f) || floatgt(endFraction, 1.f) || floatgt(beginFraction, endFraction)) {
+        HLSLoggerError(@"Invalid timing. Fractions must satisfy 0 <= beginFraction <= endFraction <= 1");
+        return;
+    }
+    
+    if (! layerAnimation || ! layer) {
+        HLSLoggerDebug(@"Missing layer or layer animation");
+        return;
+    }
+    
+    [self addLayerAnimation:layerAnimation forLayer:layer];
+    
+    HLSLayerAnimationTiming *timing = [[[HLSLayerAnimationTiming alloc] init] autorelease];
+    timing.beginFraction = beginFraction;
+    timing.endFraction = endFraction;
+    timing.timingFunction = timingFunction;
+    [self.layerKeyToTimingMap setObject:timing forKey:[NSValue valueWithPointer:layer]];
+}
+
 - (void)addLayerAnimation:(HLSLayerAnimation *)layerAnimation forView:(UIView *)view
 {
     [self addLayerAnimation:layerAnimation forLayer:view.layer];
@@ -81,15 +165,17 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     NSAssert(doublele(startTime, self.duration), @"The start time of a step cannot be greater than its duration");
     
     NSTimeInterval duration = self.duration;
+    
+    // Final values are set without triggering implicit animations. When animated, only the explicit animations created 
+    // below are played
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    
     if (animated) {
-        // This dummy view is always animated. There is no way to set a start callback for a CATransaction.
-        // Therefore, we always ensure the transaction is never empty by animating a dummy view, and we set
-        // animation callbacks for its associated animation (which, since it is part of the transaction,
-        // will be triggered when the transaction begins / ends animating)
-        self.dummyView = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
-        [[UIApplication sharedApplication].keyWindow addSubview:self.dummyView];
-        
-        [CATransaction begin];
+        // The timing layer is always animated, even if the step does not animate any layer (e.g. for delays). Its animation
+        // callbacks are used to detect when the step begins / ends animating
+        self.timingLayer = [CALayer layer];
+        [[UIApplication sharedApplication].keyWindow.layer addSublayer:self.timingLayer];
         
         // For tests within the iOS simulator only: Slow down Core Animations as UIView block-based animations (when
         // quickly pressing the shift key three times)
@@ -113,175 +199,42 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
             startTime *= s_UIAnimationDragCoefficient();
         }
 #endif
-        // If we want to play an animation from somewhere in its middle, we need to reduce the duration of the enclosing
-        // group or transaction accordingly, while letting the duration of the individual animations unchanged (see the
-        // CAAnimationGroup creation below). The child animation is not scaled, rather cut at its end (see the CAAnimationGroup
-        // class documentation), yielding the desired effect. For the same reason, the timing function must be applied on
-        // the animation, not on the transaction
+        
+        // Animations are explicitly given their duration below. The transaction duration is only set so that those lasting 0 
+        // (which would otherwise receive the default duration of the transaction) stay instantaneous
         [CATransaction setAnimationDuration:duration - startTime];
     }
     
     // Animate all layers involved in the animation step
-    for (CALayer *layer in [self objects]) {        
-        HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
-        NSAssert(layerAnimation != nil, @"Missing layer animation; data consistency failure");
-                
-        // Remark: For each property we animate, we still must set the final value manually (CoreAnimations animate properties
-        // but do not set them). Since we do not need to support delays (which are implemented at the HLSAnimation level), we
-        // can do it right here, eliminating potentially flickering animations (for more information, see HLSAnimation.m)
-        NSMutableArray *animations = [NSMutableArray array];
-        
-        // Opacity animation (opacity must always lie between 0.f and 1.f)
-        CGFloat opacity = layer.opacity + layerAnimation.opacityIncrement;
-        if (floatlt(opacity, -1.f)) {
-            HLSLoggerWarn(@"Layer animations adding to an opacity value larger than -1 for layer %@. Fixed to -1, but your animation is incorrect", layer);
-            opacity = -1.f;
-        }
-        else if (floatgt(opacity, 1.f)) {
-            HLSLoggerWarn(@"Layer animations adding to an opacity value larger than 1 for layer %@. Fixed to 1, but your animation is incorrect", layer);
-            opacity = 1.f;
-        }
-        
-        if (animated) {
-            CABasicAnimation *opacityAnimation = [CABasicAnimation animationWithKeyPath:@"opacity"];
-            [opacityAnimation setFromValue:[NSNumber numberWithFloat:layer.opacity]];
-            [opacityAnimation setToValue:[NSNumber numberWithFloat:opacity]];
-            [animations addObject:opacityAnimation];
-        }
-        layer.opacity = opacity;
-        
-        // Animate the transform. The transform has to be applied on the layer center. This requires a conversion in the coordinate system
-        // centered on the layer
-        CATransform3D translationTransform = CATransform3DMakeTranslation(-layer.transform.m41, -layer.transform.m42, 0.f);
-        CATransform3D convTransform = CATransform3DConcat(CATransform3DConcat(translationTransform, layerAnimation.transform),
-                                                          CATransform3DInvert(translationTransform));
-        CATransform3D transform = CATransform3DConcat(layer.transform, convTransform);
-        
-        if (animated) {
-            CABasicAnimation *transformAnimation = [CABasicAnimation animationWithKeyPath:@"transform"];
-            [transformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.transform]];
-            [transformAnimation setToValue:[NSValue valueWithCATransform3D:transform]];
-            [animations addObject:transformAnimation];
-        }
-        layer.transform = transform;
-        
-        // Animate the anchor point
-        CGPoint anchorPoint = CGPointMake(layer.anchorPoint.x + layerAnimation.anchorPointTranslationParameters.v1,
-                                          layer.anchorPoint.y + layerAnimation.anchorPointTranslationParameters.v2);
-        CGFloat anchorPointZ = layer.anchorPointZ + layerAnimation.anchorPointTranslationParameters.v3;
-        
-        if (animated) {
-            CABasicAnimation *anchorPointAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPoint"];
-            [anchorPointAnimation setFromValue:[NSValue valueWithCGPoint:layer.anchorPoint]];
-            [anchorPointAnimation setToValue:[NSValue valueWithCGPoint:anchorPoint]];
-            [animations addObject:anchorPointAnimation];
-            
-            CABasicAnimation *anchorPointZAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPointZ"];
-            [anchorPointZAnimation setFromValue:[NSNumber numberWithFloat:layer.anchorPointZ]];
-            [anchorPointZAnimation setToValue:[NSNumber numberWithFloat:anchorPointZ]];
-            [animations addObject:anchorPointZAnimation];
-        }
-        layer.anchorPoint = anchorPoint;
-        layer.anchorPointZ = anchorPointZ;
-        
-        // Rasterization
-        if (layerAnimation.togglingShouldRasterize) {
-            BOOL shouldRasterize = ! layer.shouldRasterize;
-            if (animated) {
-                CABasicAnimation *shouldRasterizeAnimation = [CABasicAnimation animationWithKeyPath:@"shouldRasterize"];
-                [shouldRasterizeAnimation setFromValue:[NSNumber numberWithBool:layer.shouldRasterize]];
-                [shouldRasterizeAnimation setToValue:[NSNumber numberWithBool:shouldRasterize]];
-                [animations addObject:shouldRasterizeAnimation];
-            }
-            layer.shouldRasterize = shouldRasterize;
-        }
-        
-        // Rasterization scale
-        CGFloat rasterizationScale = layer.rasterizationScale + layerAnimation.rasterizationScaleIncrement;
-        if (animated) {
-            CABasicAnimation *rasterizationScaleAnimation = [CABasicAnimation animationWithKeyPath:@"rasterizationScale"];
-            [rasterizationScaleAnimation setFromValue:[NSNumber numberWithFloat:layer.rasterizationScale]];
-            [rasterizationScaleAnimation setToValue:[NSNumber numberWithFloat:rasterizationScale]];
-            [animations addObject:rasterizationScaleAnimation];
-        }
-        layer.rasterizationScale = rasterizationScale;
-        
-        // Get the sublayer transform without its perspective component (saved as additional layer information)
-        NSValue *nonProjectedSublayerTransformValue = [layer valueForKey:kLayerNonProjectedSublayerTransformKey];
-        CATransform3D nonProjectedSublayerTransform = CATransform3DIdentity;
-        if (nonProjectedSublayerTransformValue) {
-            nonProjectedSublayerTransform = [nonProjectedSublayerTransformValue CATransform3DValue];
-        }
-        else {
-            nonProjectedSublayerTransform = layer.sublayerTransform;
-        }
-        
-        // Get the current camera position (saved as additional layer information)
-        NSNumber *sublayerCameraZPositionNumber = [layer valueForKey:kLayerCameraZPositionForSublayersKey];
-        CGFloat sublayerCameraZPosition = 0.f;
-        if (sublayerCameraZPositionNumber) {
-            sublayerCameraZPosition = [sublayerCameraZPositionNumber floatValue];
-        }
-        else {
-            sublayerCameraZPosition = floateq(layer.sublayerTransform.m34, 0.f) ? 0.f : 1.f / layer.sublayerTransform.m34;
-        }
-        
-        // Calculate the sublayer transform (without perspective component)
-        CATransform3D sublayerTranslationTransform = CATransform3DMakeTranslation(-nonProjectedSublayerTransform.m41, -nonProjectedSublayerTransform.m42, 0.f);
-        CATransform3D sublayerConvTransform = CATransform3DConcat(CATransform3DConcat(sublayerTranslationTransform, layerAnimation.sublayerTransform),
-                                                                  CATransform3DInvert(sublayerTranslationTransform));
-        CATransform3D sublayerTransform = CATransform3DConcat(nonProjectedSublayerTransform, sublayerConvTransform);
-        
-        // Calculate the new z-position of the camera
-        sublayerCameraZPosition += layerAnimation.sublayerCameraTranslationZ;
-        
-        // Save the information relative / not relative to the perspective separately
-        [layer setValue:[NSNumber numberWithFloat:sublayerCameraZPosition] forKey:kLayerCameraZPositionForSublayersKey];
-        [layer setValue:[NSValue valueWithCATransform3D:sublayerTransform] forKey:kLayerNonProjectedSublayerTransformKey];
-        
-        // Create the perspective matrix (see http://en.wikipedia.org/wiki/3D_projection#Perspective_projection)
-        CATransform3D perspectiveProjectionTransform = CATransform3DIdentity;
-        if (! floateq(sublayerCameraZPosition, 0.f)) {
-            perspectiveProjectionTransform.m34 = -1.f / sublayerCameraZPosition;
-        }
-        
-        // Apply the perspective
-        sublayerTransform = CATransform3DConcat(sublayerTransform, perspectiveProjectionTransform);
-        
-        if (animated) {
-            CABasicAnimation *sublayerTransformAnimation = [CABasicAnimation animationWithKeyPath:@"sublayerTransform"];
-            [sublayerTransformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.sublayerTransform]];
-            [sublayerTransformAnimation setToValue:[NSValue valueWithCATransform3D:sublayerTransform]];
-            [animations addObject:sublayerTransformAnimation];
-        }
-        layer.sublayerTransform = sublayerTransform;
+    for (CALayer *layer in [self objects]) {
+        NSArray *animations = [self applyToLayer:layer createAnimations:animated];
         
         // Create the animation group and attach it to the layer
         if (animated) {
             // All animations must have the expected duration, but must be offset according to the start time
             // when played from somewhere in their middle. The timing function must also be attached to each
             // animation
-            for (CAAnimation *animation in animations) {
-                animation.duration = duration;
-                animation.timeOffset = startTime;
-                animation.timingFunction = self.timingFunction;
-            }
+            animations = [self configureAnimations:animations forLayer:layer withDuration:duration startTime:startTime];
             
+            // If we want to play an animation from somewhere in its middle, we need to reduce the duration of the group 
+            // accordingly, while letting the duration of the individual animations unchanged. The child animations are 
+            // not scaled, rather cut at their end (see the CAAnimationGroup class documentation), yielding the desired effect
             CAAnimationGroup *animationGroup = [CAAnimationGroup animation];
             animationGroup.animations = [NSArray arrayWithArray:animations];
+            animationGroup.duration = duration - startTime;
             animationGroup.delegate = self;
             [layer addAnimation:animationGroup forKey:kLayerAnimationGroupKey];
         }
     }
     
-    // Animate the dummy view. It is also used to set a delegate (one for all animations in the transaction)
-    // which will receive the start / end animation events
+    // Animate the timing layer, whose animation lasts as long as the step
     if (animated) {
-        CABasicAnimation *dummyViewOpacityAnimation = [CABasicAnimation animationWithKeyPath:@"opacity"];
-        dummyViewOpacityAnimation.fromValue = [NSNumber numberWithFloat:self.dummyView.layer.opacity];
-        dummyViewOpacityAnimation.toValue = [NSNumber numberWithFloat:1.f - self.dummyView.layer.opacity];
-        dummyViewOpacityAnimation.delegate = self;
-        [self.dummyView.layer addAnimation:dummyViewOpacityAnimation forKey:kDummyViewLayerAnimationKey];
+        CABasicAnimation *timingLayerOpacityAnimation = [CABasicAnimation animationWithKeyPath:@"opacity"];
+        timingLayerOpacityAnimation.fromValue = [NSNumber numberWithFloat:self.timingLayer.opacity];
+        timingLayerOpacityAnimation.toValue = [NSNumber numberWithFloat:1.f - self.timingLayer.opacity];
+        timingLayerOpacityAnimation.duration = duration - startTime;
+        timingLayerOpacityAnimation.delegate = self;
+        [self.timingLayer addAnimation:timingLayerOpacityAnimation forKey:kTimingLayerAnimationKey];
     }
         
     // Animated
@@ -296,14 +249,289 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
         // layers are dead when the end callback is called (which can happen if the layer they are on is
         // destroyed while the animation was running), we cannot compare to self.objects anymore (otherwise
         // the application will crash). We therefore keep track of how animations are expected, but in a safe way
-        // (+ 1 for the dummy view animation)
+        // (+ 1 for the timing layer animation)
         m_numberOfLayerAnimations = [self.objects count] + 1;
         
         // When a start time has been defined, the animation must look like it started earlier
         m_startTime = CACurrentMediaTime() - startTime;
+    }
+    
+    [CATransaction commit];
+}
+
+#pragma mark Applying the step to layers
+
+// Set the final values of all properties altered by the step for a layer, and return the corresponding animations (without
+// duration nor timing function) if requested (nil otherwise)
+- (NSArray *)applyToLayer:(CALayer *)layer createAnimations:(BOOL)createAnimations
+{
+    HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
+    NSAssert(layerAnimation != nil, @"Missing layer animation; data consistency failure");
+            
+    // Remark: For each property we animate, we still must set the final value manually (CoreAnimations animate properties
+    // but do not set them). Since we do not need to support delays (which are implemented at the HLSAnimation level), we
+    // can do it right here, eliminating potentially flickering animations (for more information, see HLSAnimation.m)
+    NSMutableArray *animations = createAnimations ? [NSMutableArray array] : nil;
+    
+    // Opacity animation (opacity must always lie between 0.f and 1.f)
+    CGFloat opacity = layer.opacity + layerAnimation.opacityIncrement;
+    if (floatlt(opacity, -1.f)) {
+        HLSLoggerWarn(@"Layer animations adding to an opacity value larger than -1 for layer %@. Fixed to -1, but your animation is incorrect", layer);
+        opacity = -1.f;
+    }
+    else if (floatgt(opacity, 1.f)) {
+        HLSLoggerWarn(@"Layer animations adding to an opacity value larger than 1 for layer %@. Fixed to 1, but your animation is incorrect", layer);
+        opacity = 1.f;
+    }
+    
+    if (createAnimations) {
+        CABasicAnimation *opacityAnimation = [CABasicAnimation animationWithKeyPath:@"opacity"];
+        [opacityAnimation setFromValue:[NSNumber numberWithFloat:layer.opacity]];
+        [opacityAnimation setToValue:[NSNumber numberWithFloat:opacity]];
+        [animations addObject:opacityAnimation];
+    }
+    layer.opacity = opacity;
+    
+    // Animate the transform. The transform has to be applied on the layer center. This requires a conversion in the coordinate system
+    // centered on the layer
+    CATransform3D translationTransform = CATransform3DMakeTranslation(-layer.transform.m41, -layer.transform.m42, 0.f);
+    CATransform3D convTransform = CATransform3DConcat(CATransform3DConcat(translationTransform, layerAnimation.transform),
+                                                      CATransform3DInvert(translationTransform));
+    CATransform3D transform = CATransform3DConcat(layer.transform, convTransform);
+    
+    if (createAnimations) {
+        CABasicAnimation *transformAnimation = [CABasicAnimation animationWithKeyPath:@"transform"];
+        [transformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.transform]];
+        [transformAnimation setToValue:[NSValue valueWithCATransform3D:transform]];
+        [animations addObject:transformAnimation];
+    }
+    layer.transform = transform;
+    
+    // Animate the anchor point
+    CGPoint anchorPoint = CGPointMake(layer.anchorPoint.x + layerAnimation.anchorPointTranslationParameters.v1,
+                                      layer.anchorPoint.y + layerAnimation.anchorPointTranslationParameters.v2);
+    CGFloat anchorPointZ = layer.anchorPointZ + layerAnimation.anchorPointTranslationParameters.v3;
+    
+    if (createAnimations) {
+        CABasicAnimation *anchorPointAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPoint"];
+        [anchorPointAnimation setFromValue:[NSValue valueWithCGPoint:layer.anchorPoint]];
+        [anchorPointAnimation setToValue:[NSValue valueWithCGPoint:anchorPoint]];
+        [animations addObject:anchorPointAnimation];
+        
+        CABasicAnimation *anchorPointZAnimation = [CABasicAnimation animationWithKeyPath:@"anchorPointZ"];
+        [anchorPointZAnimation setFromValue:[NSNumber numberWithFloat:layer.anchorPointZ]];
+        [anchorPointZAnimation setToValue:[NSNumber numberWithFloat:anchorPointZ]];
+        [animations addObject:anchorPointZAnimation];
+    }
+    layer.anchorPoint = anchorPoint;
+    layer.anchorPointZ = anchorPointZ;
+    
+    // Rasterization
+    if (layerAnimation.togglingShouldRasterize) {
+        BOOL shouldRasterize = ! layer.shouldRasterize;
+        if (createAnimations) {
+            CABasicAnimation *shouldRasterizeAnimation = [CABasicAnimation animationWithKeyPath:@"shouldRasterize"];
+            [shouldRasterizeAnimation setFromValue:[NSNumber numberWithBool:layer.shouldRasterize]];
+            [shouldRasterizeAnimation setToValue:[NSNumber numberWithBool:shouldRasterize]];
+            [animations addObject:shouldRasterizeAnimation];
+        }
+        layer.shouldRasterize = shouldRasterize;
+    }
+    
+    // Rasterization scale
+    CGFloat rasterizationScale = layer.rasterizationScale + layerAnimation.rasterizationScaleIncrement;
+    if (createAnimations) {
+        CABasicAnimation *rasterizationScaleAnimation = [CABasicAnimation animationWithKeyPath:@"rasterizationScale"];
+        [rasterizationScaleAnimation setFromValue:[NSNumber numberWithFloat:layer.rasterizationScale]];
+        [rasterizationScaleAnimation setToValue:[NSNumber numberWithFloat:rasterizationScale]];
+        [animations addObject:rasterizationScaleAnimation];
+    }
+    layer.rasterizationScale = rasterizationScale;
+    
+    // Get the sublayer transform without its perspective component (saved as additional layer information)
+    NSValue *nonProjectedSublayerTransformValue = [layer valueForKey:kLayerNonProjectedSublayerTransformKey];
+    CATransform3D nonProjectedSublayerTransform = CATransform3DIdentity;
+    if (nonProjectedSublayerTransformValue) {
+        nonProjectedSublayerTransform = [nonProjectedSublayerTransformValue CATransform3DValue];
+    }
+    else {
+        nonProjectedSublayerTransform = layer.sublayerTransform;
+    }
+    
+    // Get the current camera position (saved as additional layer information)
+    NSNumber *sublayerCameraZPositionNumber = [layer valueForKey:kLayerCameraZPositionForSublayersKey];
+    CGFloat sublayerCameraZPosition = 0.f;
+    if (sublayerCameraZPositionNumber) {
+        sublayerCameraZPosition = [sublayerCameraZPositionNumber floatValue];
+    }
+    else {
+        sublayerCameraZPosition = floateq(layer.sublayerTransform.m34, 0.f) ? 0.f : 1.f / layer.sublayerTransform.m34;
+    }
+    
+    // Calculate the sublayer transform (without perspective component)
+    CATransform3D sublayerTranslationTransform = CATransform3DMakeTranslation(-nonProjectedSublayerTransform.m41, -nonProjectedSublayerTransform.m42, 0.f);
+    CATransform3D sublayerConvTransform = CATransform3DConcat(CATransform3DConcat(sublayerTranslationTransform, layerAnimation.sublayerTransform),
+                                                              CATransform3DInvert(sublayerTranslationTransform));
+    CATransform3D sublayerTransform = CATransform3DConcat(nonProjectedSublayerTransform, sublayerConvTransform);
+    
+    // Calculate the new z-position of the camera
+    sublayerCameraZPosition += layerAnimation.sublayerCameraTranslationZ;
+    
+    // Save the information relative / not relative to the perspective separately
+    [layer setValue:[NSNumber numberWithFloat:sublayerCameraZPosition] forKey:kLayerCameraZPositionForSublayersKey];
+    [layer setValue:[NSValue valueWithCATransform3D:sublayerTransform] forKey:kLayerNonProjectedSublayerTransformKey];
+    
+    // Create the perspective matrix (see http://en.wikipedia.org/wiki/3D_projection#Perspective_projection)
+    CATransform3D perspectiveProjectionTransform = CATransform3DIdentity;
+    if (! floateq(sublayerCameraZPosition, 0.f)) {
+        perspectiveProjectionTransform.m34 = -1.f / sublayerCameraZPosition;
+    }
+    
+    // Apply the perspective
+    sublayerTransform = CATransform3DConcat(sublayerTransform, perspectiveProjectionTransform);
+    
+    if (createAnimations) {
+        CABasicAnimation *sublayerTransformAnimation = [CABasicAnimation animationWithKeyPath:@"sublayerTransform"];
+        [sublayerTransformAnimation setFromValue:[NSValue valueWithCATransform3D:layer.sublayerTransform]];
+        [sublayerTransformAnimation setToValue:[NSValue valueWithCATransform3D:sublayerTransform]];
+        [animations addObject:sublayerTransformAnimation];
+    }
+    layer.sublayerTransform = sublayerTransform;
+    
+    return animations;
+}
+
+// Set the timing of the animations created for a layer, played within a group lasting as long as the step and starting
+// at startTime. Return the animations to be attached to the group
+- (NSArray *)configureAnimations:(NSArray *)animations 
+                        forLayer:(CALayer *)layer 
+                    withDuration:(NSTimeInterval)duration 
+                       startTime:(NSTimeInterval)startTime
+{
+    HLSLayerAnimationTiming *timing = [self.layerKeyToTimingMap objectForKey:[NSValue valueWithPointer:layer]];
+    if (! timing) {
+        for (CAAnimation *animation in animations) {
+            animation.duration = duration;
+            animation.timeOffset = startTime;
+            animation.timingFunction = self.timingFunction;
+        }
+        return animations;
+    }
+    
+    // Already over. The final values have already been set
+    NSTimeInterval beginTime = timing.beginFraction * duration;
+    NSTimeInterval endTime = timing.endFraction * duration;
+    if (doublele(endTime, startTime)) {
+        return [NSArray array];
+    }
+    
+    for (CAAnimation *animation in animations) {
+        animation.duration = endTime - beginTime;
+        animation.beginTime = MAX(beginTime - startTime, 0.);
+        animation.timeOffset = MAX(startTime - beginTime, 0.);
+        animation.timingFunction = timing.timingFunction ? timing.timingFunction : self.timingFunction;
+        
+        // Display the initial values until the animation begins, and the final ones after it has ended
+        animation.fillMode = kCAFillModeBoth;
+    }
+    return animations;
+}
+
+#pragma mark Scrubbing
+
+- (CAAnimationGroup *)animationGroupForLayer:(CALayer *)layer beginTime:(CFTimeInterval)beginTime initial:(BOOL)initial
+{
+    NSArray *animations = [self applyToLayer:layer createAnimations:YES];
+    animations = [self configureAnimations:animations forLayer:layer withDuration:self.duration startTime:0.];
+    
+    CAAnimationGroup *animationGroup = [CAAnimationGroup animation];
+    animationGroup.animations = animations;
+    animationGroup.beginTime = beginTime;
+    animationGroup.duration = self.duration;
+    animationGroup.removedOnCompletion = NO;
+    
+    // The first animation of a layer also provides its state before the animation begins. Later animations are added 
+    // over the previous ones and therefore hide them while they are active
+    animationGroup.fillMode = initial ? kCAFillModeBoth : kCAFillModeForwards;
+    return animationGroup;
+}
+
+- (void)addScrubbingAnimationsWithBeginTime:(CFTimeInterval)beginTime forKey:(NSString *)key animatedLayers:(NSMutableSet *)animatedLayers
+{
+    for (CALayer *layer in [self objects]) {
+        CAAnimationGroup *animationGroup = [self animationGroupForLayer:layer 
+                                                              beginTime:beginTime 
+                                                                initial:! [animatedLayers containsObject:layer]];
+        [layer addAnimation:animationGroup forKey:key];
         
-        [CATransaction commit];
+        [animatedLayers addObject:layer];
+    }
+}
+
+#pragma mark Native looping
+
+- (void)addAnimationGroupsWithBeginTime:(CFTimeInterval)beginTime toLayerAnimationGroupsMap:(NSMutableDictionary *)layerAnimationGroupsMap
+{
+    for (CALayer *layer in [self objects]) {
+        NSValue *layerKey = [NSValue valueWithPointer:layer];
+        NSMutableArray *animationGroups = [layerAnimationGroupsMap objectForKey:layerKey];
+        BOOL initial = (animationGroups == nil);
+        if (initial) {
+            animationGroups = [NSMutableArray array];
+            [layerAnimationGroupsMap setObject:animationGroups forKey:layerKey];
+        }
+        [animationGroups addObject:[self animationGroupForLayer:layer beginTime:beginTime initial:initial]];
+    }
+}
+
+#pragma mark Timing information
+
+- (void)getTimingForLayer:(CALayer *)layer 
+            beginFraction:(CGFloat *)pBeginFraction 
+              endFraction:(CGFloat *)pEndFraction 
+           timingFunction:(CAMediaTimingFunction **)pTimingFunction
+{
+    HLSLayerAnimationTiming *timing = [self.layerKeyToTimingMap objectForKey:[NSValue valueWithPointer:layer]];
+    if (pBeginFraction) {
+        *pBeginFraction = timing ? timing.beginFraction : 0.f;
+    }
+    if (pEndFraction) {
+        *pEndFraction = timing ? timing.endFraction : 1.f;
+    }
+    if (pTimingFunction) {
+        *pTimingFunction = timing.timingFunction ? timing.timingFunction : self.timingFunction;
+    }
+}
+
+#pragma mark Rasterization information
+
+- (NSArray *)layers
+{
+    return [self objects];
+}
+
+- (CGFloat)scaleFactorForLayer:(CALayer *)layer
+{
+    HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
+    if (! layerAnimation) {
+        return 1.f;
+    }
+    return layerAnimation.planarScaleFactor;
+}
+
+- (BOOL)isChangingRasterizationOfLayer:(CALayer *)layer
+{
+    HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
+    return layerAnimation.togglingShouldRasterize || ! floateq(layerAnimation.rasterizationScaleIncrement, 0.f);
+}
+
+- (BOOL)isChangingSublayerTransformOfLayer:(CALayer *)layer
+{
+    HLSLayerAnimation *layerAnimation = (HLSLayerAnimation *)[self objectAnimationForObject:layer];
+    if (! layerAnimation) {
+        return NO;
     }
+    return ! CATransform3DIsIdentity(layerAnimation.sublayerTransform) || ! floateq(layerAnimation.sublayerCameraTranslationZ, 0.f);
 }
 
 - (void)pauseAnimation
@@ -311,7 +539,7 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     for (CALayer *layer in [self objects]) {
         [layer pauseAllAnimations];
     }
-    [self.dummyView.layer pauseAllAnimations];
+    [self.timingLayer pauseAllAnimations];
     
     m_pauseTime = CACurrentMediaTime();
 }
@@ -321,7 +549,7 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     for (CALayer *layer in [self objects]) {
         [layer resumeAllAnimations];
     }
-    [self.dummyView.layer resumeAllAnimations];
+    [self.timingLayer resumeAllAnimations];
     
     m_previousPauseDuration += CACurrentMediaTime() - m_pauseTime;
     m_pauseTime = 0.;
@@ -329,7 +557,7 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 
 - (BOOL)isAnimationPaused
 {
-    return [self.dummyView.layer isPaused];
+    return [self.timingLayer isPaused];
 }
 
 - (void)terminateAnimation
@@ -340,7 +568,7 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
     for (CALayer *layer in [self objects]) {
         [layer removeAllAnimationsRecursively];
     }
-    [self.dummyView.layer removeAllAnimationsRecursively];
+    [self.timingLayer removeAllAnimationsRecursively];
 }
 
 - (NSTimeInterval)elapsedTime
@@ -359,6 +587,10 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 {
     HLSLayerAnimationStep *reverseAnimationStep = [super reverseAnimationStep];
     reverseAnimationStep.timingFunction = [self.timingFunction inverseFunction];
+    for (NSValue *layerKey in [self.layerKeyToTimingMap allKeys]) {
+        HLSLayerAnimationTiming *timing = [self.layerKeyToTimingMap objectForKey:layerKey];
+        [reverseAnimationStep.layerKeyToTimingMap setObject:[timing reverseTiming] forKey:layerKey];
+    }
     return reverseAnimationStep;
 }
 
@@ -368,9 +600,52 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 {
     HLSLayerAnimationStep *animationStepCopy = [super copyWithZone:zone];
     animationStepCopy.timingFunction = self.timingFunction;
+    animationStepCopy.layerKeyToTimingMap = [NSMutableDictionary dictionaryWithDictionary:self.layerKeyToTimingMap];
+    animationStepCopy.unboundTimings = self.unboundTimings;
     return animationStepCopy;
 }
 
+#pragma mark Binding
+
+- (id)animationStepBindingObjects:(NSArray *)objects
+{
+    HLSLayerAnimationStep *animationStep = [super animationStepBindingObjects:objects];
+    if (! animationStep) {
+        return nil;
+    }
+    
+    NSArray *timings = [self orderedTimings];
+    [animationStep.layerKeyToTimingMap removeAllObjects];
+    animationStep.unboundTimings = nil;
+    
+    NSUInteger i = 0;
+    for (id timing in timings) {
+        if (timing != [NSNull null]) {
+            [animationStep.layerKeyToTimingMap setObject:timing forKey:[NSValue valueWithPointer:[objects objectAtIndex:i]]];
+        }
+        ++i;
+    }
+    return animationStep;
+}
+
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [super initWithCoder:aDecoder])) {
+        self.timingFunction = [aDecoder decodeObjectForKey:@"timingFunction"];
+        self.unboundTimings = [aDecoder decodeObjectForKey:@"timings"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:self.timingFunction forKey:@"timingFunction"];
+    [aCoder encodeObject:[self orderedTimings] forKey:@"timings"];
+}
+
 #pragma mark Animation callbacks
 
 - (void)animationDidStart:(CAAnimation *)animation
@@ -386,8 +661,8 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
         NSAssert(m_numberOfStartedLayerAnimations == m_numberOfFinishedLayerAnimations,
                  @"The number of started and finished animations must be the same");
         
-        [self.dummyView removeFromSuperview];
-        self.dummyView = nil;
+        [self.timingLayer removeFromSuperlayer];
+        self.timingLayer = nil;
         
         [self notifyAsynchronousAnimationStepDidStopFinished:finished];
     }
@@ -395,3 +670,54 @@ static NSString * const kLayerCameraZPositionForSublayersKey = @"HLSLayerCameraZ
 
 @end
 
+
+@implementation HLSLayerAnimationTiming
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.timingFunction = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize beginFraction = m_beginFraction;
+
+@synthesize endFraction = m_endFraction;
+
+@synthesize timingFunction = m_timingFunction;
+
+#pragma mark Reverse timing
+
+- (HLSLayerAnimationTiming *)reverseTiming
+{
+    HLSLayerAnimationTiming *reverseTiming = [[[HLSLayerAnimationTiming alloc] init] autorelease];
+    reverseTiming.beginFraction = 1.f - self.endFraction;
+    reverseTiming.endFraction = 1.f - self.beginFraction;
+    reverseTiming.timingFunction = [self.timingFunction inverseFunction];
+    return reverseTiming;
+}
+
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [super init])) {
+        self.beginFraction = [aDecoder decodeFloatForKey:@"beginFraction"];
+        self.endFraction = [aDecoder decodeFloatForKey:@"endFraction"];
+        self.timingFunction = [aDecoder decodeObjectForKey:@"timingFunction"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeFloat:self.beginFraction forKey:@"beginFraction"];
+    [aCoder encodeFloat:self.endFraction forKey:@"endFraction"];
+    [aCoder encodeObject:self.timingFunction forKey:@"timingFunction"];
+}
+
+@end
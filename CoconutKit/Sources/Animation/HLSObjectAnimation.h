@@ -7,9 +7,10 @@
 //
 
 /**
- * Common abstract class for animations
+ * Common abstract class for animations. Object animations can be archived, since they do not depend on the object
+ * they are applied to
  */
-@interface HLSObjectAnimation : NSObject <NSCopying>
+@interface HLSObjectAnimation : NSObject <NSCopying, NSCoding>
 
 /**
  * Identity animation
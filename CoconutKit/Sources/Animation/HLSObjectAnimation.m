@@ -26,6 +26,16 @@
     return [[[self class] allocWithZone:zone] init];
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    return [self init];
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{}
+
 #pragma mark Reverse animation
 
 - (id)reverseObjectAnimation
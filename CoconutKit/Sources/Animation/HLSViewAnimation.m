@@ -107,14 +107,33 @@
 {
     // See remarks at the beginning
     HLSViewAnimation *reverseViewAnimation = [super reverseObjectAnimation];
-    [reverseViewAnimation scaleWithXFactor:1.f / self.scaleParameters.v1
-                                   yFactor:1.f / self.scaleParameters.v2];
-    [reverseViewAnimation translateByVectorWithX:-self.translationParameters.v1
-                                               y:-self.translationParameters.v2];
+    reverseViewAnimation.scaleParameters = HLSVector2Reciprocal(self.scaleParameters);
+    reverseViewAnimation.translationParameters = HLSVector2Scale(self.translationParameters, -1.f);
     reverseViewAnimation.alphaIncrement = -self.alphaIncrement;
     return reverseViewAnimation;
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [super initWithCoder:aDecoder])) {
+        self.scaleParameters = HLSVector2FromArray([aDecoder decodeObjectForKey:@"scaleParameters"]);
+        self.translationParameters = HLSVector2FromArray([aDecoder decodeObjectForKey:@"translationParameters"]);
+        self.alphaIncrement = [aDecoder decodeFloatForKey:@"alphaIncrement"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    
+    [aCoder encodeObject:HLSArrayFromVector2(self.scaleParameters) forKey:@"scaleParameters"];
+    [aCoder encodeObject:HLSArrayFromVector2(self.translationParameters) forKey:@"translationParameters"];
+    [aCoder encodeFloat:self.alphaIncrement forKey:@"alphaIncrement"];
+}
+
 #pragma mark NSCopying protocol implementation
 
 - (id)copyWithZone:(NSZone *)zone
@@ -24,6 +24,7 @@
 @private
     UIViewAnimationCurve m_curve;
     UIView *m_dummyView;
+    BOOL m_allowingUserInteraction;
 }
 
 /**
@@ -41,4 +42,13 @@
  */
 @property (nonatomic, assign) UIViewAnimationCurve curve;
 
+/**
+ * If set to YES, the animated views still receive touches while the animation step is running. Only enable when your 
+ * views can safely be interacted with before they reach their final state (this is unrelated to the lockingUI property
+ * of HLSAnimation, which locks the whole user interface)
+ *
+ * Default value is NO
+ */
+@property (nonatomic, assign) BOOL allowingUserInteraction;
+
 @end
@@ -19,7 +19,7 @@
 
 @property (nonatomic, retain) UIView *dummyView;
 
-- (void)animationStepDidStop:(NSString *)animationID finished:(NSNumber *)finished context:(void *)context;
+- (void)animationStepDidStopFinished:(BOOL)finished;
 
 @end
 
@@ -48,6 +48,8 @@
 
 @synthesize dummyView = m_dummyView;
 
+@synthesize allowingUserInteraction = m_allowingUserInteraction;
+
 #pragma mark Managing the animation
 
 - (void)addViewAnimation:(HLSViewAnimation *)viewAnimation forView:(UIView *)view
@@ -68,53 +70,65 @@
         // reduced to 0
         self.dummyView = [[[UIView alloc] initWithFrame:CGRectZero] autorelease];
         [[UIApplication sharedApplication].keyWindow addSubview:self.dummyView];
-        
-        [UIView beginAnimations:nil context:NULL];
-        
-        [UIView setAnimationDuration:self.duration];
-        [UIView setAnimationCurve:self.curve];
-        
-        // Remark: The selector names animationWillStart:context: and animationDidStop:finished:context:, though appearing
-        //         in the UIKit UIView header documentation, are reserved by Apple. Using them might lead to app rejection!
-        [UIView setAnimationDidStopSelector:@selector(animationStepDidStop:finished:context:)];
-        [UIView setAnimationDelegate:self];
     }
     
-    for (UIView *view in [self objects]) {
-        HLSViewAnimation *viewAnimation = (HLSViewAnimation *)[self objectAnimationForObject:view];
-        NSAssert(viewAnimation != nil, @"Missing view animation; data consistency failure");
+    void (^animations)(void) = ^{
+        for (UIView *view in [self objects]) {
+            HLSViewAnimation *viewAnimation = (HLSViewAnimation *)[self objectAnimationForObject:view];
+            NSAssert(viewAnimation != nil, @"Missing view animation; data consistency failure");
+            
+            // Alpha animation (alpha must always lie between 0.f and 1.f)
+            CGFloat alpha = view.alpha + viewAnimation.alphaIncrement;
+            if (floatlt(alpha, -1.f)) {
+                HLSLoggerWarn(@"View animations adding to an alpha value larger than -1 for view %@. Fixed to -1, but your animation is incorrect", view);
+                alpha = -1.f;
+            }
+            else if (floatgt(alpha, 1.f)) {
+                HLSLoggerWarn(@"View animations adding to an alpha value larger than 1 for view %@. Fixed to 1, but your animation is incorrect", view);
+                alpha = 1.f;
+            }
+            
+            view.alpha = alpha;
+            
+            // Animate the frame. The transform has to be applied on the view center. This requires a conversion in the coordinate system
+            // centered on the view
+            CGAffineTransform translationTransform = CGAffineTransformMakeTranslation(-view.center.x, -view.center.y);
+            CGAffineTransform convTransform = CGAffineTransformConcat(CGAffineTransformConcat(translationTransform, viewAnimation.transform),
+                                                                      CGAffineTransformInvert(translationTransform));
+            CGSize previousSize = view.bounds.size;
+            view.frame = CGRectApplyAffineTransform(view.frame, convTransform);
+            
+            // Ensure better subview resizing in some cases (e.g. UISearchBar). Only needed when the bounds change, translations
+            // do not require the view to be laid out (and possibly redrawn) again
+            if (! CGSizeEqualToSize(previousSize, view.bounds.size)) {
+                [view layoutIfNeeded];
+            }
+        }
         
-        // Alpha animation (alpha must always lie between 0.f and 1.f)
-        CGFloat alpha = view.alpha + viewAnimation.alphaIncrement;
-        if (floatlt(alpha, -1.f)) {
-            HLSLoggerWarn(@"View animations adding to an alpha value larger than -1 for view %@. Fixed to -1, but your animation is incorrect", view);
-            alpha = -1.f;
+        if (animated) {
+            // Animate the dummy view
+            self.dummyView.alpha = 1.f - self.dummyView.alpha;
         }
-        else if (floatgt(alpha, 1.f)) {
-            HLSLoggerWarn(@"View animations adding to an alpha value larger than 1 for view %@. Fixed to 1, but your animation is incorrect", view);
-            alpha = 1.f;
+    };
+    
+    if (animated) {
+        // Curve values map to the corresponding animation options
+        UIViewAnimationOptions options = (self.curve << 16) | UIViewAnimationOptionBeginFromCurrentState;
+        if (self.allowingUserInteraction) {
+            options |= UIViewAnimationOptionAllowUserInteraction;
         }
         
-        view.alpha = alpha;
-        
-        // Animate the frame. The transform has to be applied on the view center. This requires a conversion in the coordinate system
-        // centered on the view
-        CGAffineTransform translationTransform = CGAffineTransformMakeTranslation(-view.center.x, -view.center.y);
-        CGAffineTransform convTransform = CGAffineTransformConcat(CGAffineTransformConcat(translationTransform, viewAnimation.transform),
-                                                                  CGAffineTransformInvert(translationTransform));
-        view.frame = CGRectApplyAffineTransform(view.frame, convTransform);
-        
-        // Ensure better subview resizing in some cases (e.g. UISearchBar)
-        [view layoutIfNeeded];
+        // The block retains the step until the animation ends
+        [UIView animateWithDuration:self.duration
+                              delay:0.
+                            options:options
+                         animations:animations
+                         completion:^(BOOL finished) {
+                             [self animationStepDidStopFinished:finished];
+                         }];
     }
-        
-    if (animated) {
-        // Animate the dummy view
-        self.dummyView.alpha = 1.f - self.dummyView.alpha;
-        
-        [UIView commitAnimations];
-        
-        // The code will resume in the animationDidStop:finished:context: method
+    else {
+        animations();
     }
 }
 
@@ -163,6 +177,7 @@
 - (id)reverseAnimationStep
 {
     HLSViewAnimationStep *reverseAnimationStep = [super reverseAnimationStep];
+    reverseAnimationStep.allowingUserInteraction = self.allowingUserInteraction;
     switch (self.curve) {
         case UIViewAnimationCurveEaseIn:
             reverseAnimationStep.curve = UIViewAnimationCurveEaseOut;
@@ -187,17 +202,36 @@
 {
     HLSViewAnimationStep *animationStepCopy = [super copyWithZone:zone];
     animationStepCopy.curve = self.curve;
+    animationStepCopy.allowingUserInteraction = self.allowingUserInteraction;
     return animationStepCopy;
 }
 
+#pragma mark NSCoding protocol implementation
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if ((self = [super initWithCoder:aDecoder])) {
+        self.curve = [aDecoder decodeIntegerForKey:@"curve"];
+        self.allowingUserInteraction = [aDecoder decodeBoolForKey:@"allowingUserInteraction"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeInteger:self.curve forKey:@"curve"];
+    [aCoder encodeBool:self.allowingUserInteraction forKey:@"allowingUserInteraction"];
+}
+
 #pragma mark Animation delegate methods
 
-- (void)animationStepDidStop:(NSString *)animationID finished:(NSNumber *)finished context:(void *)context
+- (void)animationStepDidStopFinished:(BOOL)finished
 {
     [self.dummyView removeFromSuperview];
     self.dummyView = nil;
     
-    [self notifyAsynchronousAnimationStepDidStopFinished:[finished boolValue]];
+    [self notifyAsynchronousAnimationStepDidStopFinished:finished];
 }
 
 @end
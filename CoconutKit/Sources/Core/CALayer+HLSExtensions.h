@@ -6,6 +6,8 @@
 //  Copyright (c) 2012 Hortis. All rights reserved.
 //
 
+#import "UIImage+HLSExtensions.h"
+
 @interface CALayer (HLSExtensions)
 
 /**
@@ -34,4 +36,34 @@
  */
 - (UIImage *)flattenedImage;
 
+/**
+ * Same as -flattenedImage, but the layer is rendered in its own coordinate system, i.e. its frame and transform are
+ * ignored. The image has the size of the layer bounds and can be used as a snapshot of the layer contents
+ */
+- (UIImage *)flattenedContentImage;
+
+/**
+ * Same as -flattenedImage, but with the specified scale factor (0 to use the device scale factor). Use a scale smaller
+ * than the device scale to get a smaller snapshot of a large layer
+ */
+- (UIImage *)flattenedImageWithScale:(CGFloat)scale;
+
+/**
+ * Render the layer contents (as -flattenedContentImage) incrementally and return the image to the completion block.
+ * Instead of rendering the whole layer at once, which can stall the main thread for a long time for large layers 
+ * (e.g. scroll view contents), the layer is rendered in horizontal strips, one per main run loop iteration. The
+ * resulting bitmap is then turned into an image on a background queue. The completion block is called on the main 
+ * thread, with nil if the layer is empty
+ *
+ * The scale factor has the same meaning as for -flattenedImageWithScale:. If the bitmap would require more than
+ * maximumBytes, the scale factor is reduced so that it fits into this budget (use 0 for no limit). No other large 
+ * buffer is allocated
+ *
+ * This method must be called from the main thread. Strips reflect the state of the layer when they are rendered,
+ * the layer should therefore not be altered until the completion block has been called
+ */
+- (void)loadFlattenedContentImageWithScale:(CGFloat)scale 
+                              maximumBytes:(size_t)maximumBytes
+                           completionBlock:(HLSImageCompletionBlock)completionBlock;
+
 @end
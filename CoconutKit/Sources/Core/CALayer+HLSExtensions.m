@@ -12,9 +12,42 @@
 
 static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
 
+// Height (in pixels) of the strips rendered in each run loop iteration by -loadFlattenedContentImageWithScale:...
+static const size_t kLayerFlattenerStripHeight = 256;
+
+/**
+ * Incrementally renders a layer into a bitmap context, one strip per main run loop iteration
+ */
+@interface HLSLayerFlattener : NSObject {
+@private
+    CALayer *m_layer;
+    CGContextRef m_context;
+    CGFloat m_scale;
+    size_t m_pixelHeight;
+    size_t m_renderedPixelHeight;
+    HLSImageCompletionBlock m_completionBlock;
+}
+
+- (id)initWithLayer:(CALayer *)layer 
+              scale:(CGFloat)scale 
+       maximumBytes:(size_t)maximumBytes 
+    completionBlock:(HLSImageCompletionBlock)completionBlock;
+
+- (void)start;
+
+@end
+
+@interface HLSLayerFlattener ()
+
+- (void)renderNextStrip;
+- (void)finishWithImage:(UIImage *)image;
+
+@end
+
 @interface CALayer (HLSExtensionsPrivate)
 
 - (void)resetAnimations;
+- (UIImage *)flattenedImageApplyingGeometry:(BOOL)applyingGeometry scale:(CGFloat)scale;
 
 @end
 
@@ -83,12 +116,55 @@ static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
     return [self valueForKey:kLayerSpeedBeforePauseKey] != nil;
 }
 
-// See http://developer.apple.com/library/ios/#qa/qa1703/_index.html
 - (UIImage *)flattenedImage
 {
-    // >= iOS 4: Take the scale into account
+    return [self flattenedImageApplyingGeometry:YES scale:0.f];
+}
+
+- (UIImage *)flattenedContentImage
+{
+    return [self flattenedImageApplyingGeometry:NO scale:0.f];
+}
+
+- (UIImage *)flattenedImageWithScale:(CGFloat)scale
+{
+    return [self flattenedImageApplyingGeometry:YES scale:scale];
+}
+
+- (void)loadFlattenedContentImageWithScale:(CGFloat)scale 
+                              maximumBytes:(size_t)maximumBytes
+                           completionBlock:(HLSImageCompletionBlock)completionBlock
+{
+    HLSLayerFlattener *flattener = [[[HLSLayerFlattener alloc] initWithLayer:self 
+                                                                       scale:scale 
+                                                                maximumBytes:maximumBytes 
+                                                             completionBlock:completionBlock] autorelease];
+    [flattener start];
+}
+
+@end
+
+@implementation CALayer (HLSExtensionsPrivate)
+
+- (void)resetAnimations
+{
+    // If layer animations had been paused, reset the layer status
+    NSNumber *speedBeforePauseNumber = [self valueForKey:kLayerSpeedBeforePauseKey];
+    if (speedBeforePauseNumber) {
+        self.speed = [speedBeforePauseNumber floatValue];
+        [self setValue:nil forKey:kLayerSpeedBeforePauseKey];
+    }
+    
+    self.timeOffset = 0.;
+    self.beginTime = 0.;
+}
+
+// See http://developer.apple.com/library/ios/#qa/qa1703/_index.html
+- (UIImage *)flattenedImageApplyingGeometry:(BOOL)applyingGeometry scale:(CGFloat)scale
+{
+    // >= iOS 4: Take the scale into account (0 means the device scale factor)
     if (UIGraphicsBeginImageContextWithOptions) {
-        UIGraphicsBeginImageContextWithOptions(self.bounds.size, self.opaque, 0.f /* use the device scale factor */);
+        UIGraphicsBeginImageContextWithOptions(self.bounds.size, self.opaque, scale);
     }
     // < iOS 4
     else {
@@ -96,15 +172,17 @@ static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
     }
     
     // -renderInContext: renders in the layer coordinate space, i.e. the origin of the layer is ignored. This has
-    // to be fixed before creating the image
+    // to be fixed before creating the image if the layer geometry must be taken into account
     CGContextRef context = UIGraphicsGetCurrentContext();
     CGContextSaveGState(context);
     
-    CGContextTranslateCTM(context, CGRectGetMidX(self.frame), CGRectGetMidY(self.frame));
-    CGContextConcatCTM(context, CATransform3DGetAffineTransform(self.transform));
-    CGContextTranslateCTM(context,
-                          -CGRectGetWidth(self.bounds) * self.anchorPoint.x,
-                          -CGRectGetHeight(self.bounds) * self.anchorPoint.y);
+    if (applyingGeometry) {
+        CGContextTranslateCTM(context, CGRectGetMidX(self.frame), CGRectGetMidY(self.frame));
+        CGContextConcatCTM(context, CATransform3DGetAffineTransform(self.transform));
+        CGContextTranslateCTM(context,
+                              -CGRectGetWidth(self.bounds) * self.anchorPoint.x,
+                              -CGRectGetHeight(self.bounds) * self.anchorPoint.y);
+    }
     [self renderInContext:context];
     
     CGContextRestoreGState(context);
@@ -117,19 +195,118 @@ static NSString * const kLayerSpeedBeforePauseKey = @"HLSLayerSpeedBeforePause";
 
 @end
 
-@implementation CALayer (HLSExtensionsPrivate)
+@implementation HLSLayerFlattener
 
-- (void)resetAnimations
+#pragma mark Object creation and destruction
+
+- (id)initWithLayer:(CALayer *)layer 
+              scale:(CGFloat)scale 
+       maximumBytes:(size_t)maximumBytes 
+    completionBlock:(HLSImageCompletionBlock)completionBlock
 {
-    // If layer animations had been paused, reset the layer status
-    NSNumber *speedBeforePauseNumber = [self valueForKey:kLayerSpeedBeforePauseKey];
-    if (speedBeforePauseNumber) {
-        self.speed = [speedBeforePauseNumber floatValue];
-        [self setValue:nil forKey:kLayerSpeedBeforePauseKey];
+    if ((self = [super init])) {
+        m_layer = [layer retain];
+        m_completionBlock = [completionBlock copy];
+        
+        if (scale <= 0.f) {
+            scale = [[UIScreen mainScreen] scale];
+        }
+        
+        // Reduce the scale so that the bitmap fits into the memory budget (4 bytes per pixel)
+        CGSize size = layer.bounds.size;
+        double bytes = 4. * ceil(size.width * scale) * ceil(size.height * scale);
+        if (maximumBytes != 0 && bytes > maximumBytes) {
+            scale *= sqrt(maximumBytes / bytes);
+        }
+        m_scale = scale;
+        
+        size_t pixelWidth = (size_t)floor(size.width * scale);
+        m_pixelHeight = (size_t)floor(size.height * scale);
+        if (pixelWidth != 0 && m_pixelHeight != 0) {
+            CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+            CGBitmapInfo bitmapInfo = kCGBitmapByteOrder32Little | (layer.opaque ? kCGImageAlphaNoneSkipFirst : kCGImageAlphaPremultipliedFirst);
+            m_context = CGBitmapContextCreate(NULL, pixelWidth, m_pixelHeight, 8, 0, colorSpace, bitmapInfo);
+            CGColorSpaceRelease(colorSpace);
+            
+            // Same coordinate system as UIKit image contexts (origin at the top left, in points)
+            if (m_context) {
+                CGContextTranslateCTM(m_context, 0.f, m_pixelHeight);
+                CGContextScaleCTM(m_context, scale, -scale);
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_layer release];
+    m_layer = nil;
+    
+    if (m_context) {
+        CGContextRelease(m_context);
+        m_context = NULL;
     }
     
-    self.timeOffset = 0.;
-    self.beginTime = 0.;
+    [m_completionBlock release];
+    m_completionBlock = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Rendering
+
+- (void)start
+{
+    if (! m_context) {
+        HLSLoggerDebug(@"Nothing to render");
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishWithImage:nil];
+        });
+        return;
+    }
+    
+    [self renderNextStrip];
+}
+
+- (void)renderNextStrip
+{
+    // Only render the current strip (clipping lets Core Animation skip the rest of the layer tree cheaply)
+    size_t stripHeight = MIN(kLayerFlattenerStripHeight, m_pixelHeight - m_renderedPixelHeight);
+    CGRect stripRect = CGRectMake(0.f, m_renderedPixelHeight / m_scale, CGRectGetWidth(m_layer.bounds), stripHeight / m_scale);
+    
+    CGContextSaveGState(m_context);
+    CGContextClipToRect(m_context, stripRect);
+    [m_layer renderInContext:m_context];
+    CGContextRestoreGState(m_context);
+    
+    m_renderedPixelHeight += stripHeight;
+    
+    // Give the main run loop a chance to process events between strips (the block retains self)
+    if (m_renderedPixelHeight < m_pixelHeight) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self renderNextStrip];
+        });
+    }
+    // Copying the bitmap can be done in the background
+    else {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            CGImageRef imageRef = CGBitmapContextCreateImage(m_context);
+            UIImage *image = imageRef ? [UIImage imageWithCGImage:imageRef scale:m_scale orientation:UIImageOrientationUp] : nil;
+            CGImageRelease(imageRef);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self finishWithImage:image];
+            });
+        });
+    }
+}
+
+- (void)finishWithImage:(UIImage *)image
+{
+    if (m_completionBlock) {
+        m_completionBlock(image);
+    }
 }
 
 @end
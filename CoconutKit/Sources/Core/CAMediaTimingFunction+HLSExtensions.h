@@ -13,6 +13,21 @@
  */
 - (CAMediaTimingFunction *)inverseFunction;
 
+/**
+ * Return the value (animation progress) of the timing function at a given time. Times are clamped to [0, 1]
+ */
+- (float)valueForTime:(float)time;
+
+/**
+ * Evaluate the timing function at count times and store the results into values (which can be the same buffer as
+ * times). Much faster than calling -valueForTime: repeatedly, and therefore well suited for sampling a timing function
+ * (e.g. when building keyframe animations)
+ *
+ * The curve coefficients and a lookup table used as a starting point when solving for the curve parameter are 
+ * computed once per timing function and cached
+ */
+- (void)getValues:(float *)values forTimes:(const float *)times count:(size_t)count;
+
 /**
  * Return the control points as a human-readable string
  */
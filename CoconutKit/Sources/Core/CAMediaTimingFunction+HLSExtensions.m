@@ -8,6 +8,36 @@
 
 #import "CAMediaTimingFunction+HLSExtensions.h"
 
+#import <objc/runtime.h>
+
+// Number of samples of the lookup table used to find a starting point when solving for the curve parameter
+#define kTimingFunctionSampleCount          11
+
+// Associated object keys
+static void *s_evaluatorKey = &s_evaluatorKey;
+
+/**
+ * Precomputed data for evaluating a timing function. The timing function is a cubic Bezier curve with end points
+ * (0, 0) and (1, 1). Its coordinates are polynomials in the curve parameter t:
+ *   x(t) = ((ax * t + bx) * t + cx) * t
+ *   y(t) = ((ay * t + by) * t + cy) * t
+ * Evaluating the function at a time x means solving x(t) = x for t, and then computing y(t)
+ */
+typedef struct {
+    float ax, bx, cx;
+    float ay, by, cy;
+    float samples[kTimingFunctionSampleCount];          // x(t) for t = i / (kTimingFunctionSampleCount - 1)
+} HLSTimingFunctionEvaluator;
+
+// Static functions
+static float HLSTimingFunctionEvaluatorValueForTime(const HLSTimingFunctionEvaluator *evaluator, float time);
+
+@interface CAMediaTimingFunction (HLSExtensionsPrivate)
+
+- (const HLSTimingFunctionEvaluator *)evaluator;
+
+@end
+
 @implementation CAMediaTimingFunction (HLSExtensions)
 
 - (CAMediaTimingFunction *)inverseFunction
@@ -25,6 +55,19 @@
     return [CAMediaTimingFunction functionWithControlPoints:1.f - values2[0] :values1[1] :1.f - values1[0] :values2[1]];
 }
 
+- (float)valueForTime:(float)time
+{
+    return HLSTimingFunctionEvaluatorValueForTime([self evaluator], time);
+}
+
+- (void)getValues:(float *)values forTimes:(const float *)times count:(size_t)count
+{
+    const HLSTimingFunctionEvaluator *evaluator = [self evaluator];
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = HLSTimingFunctionEvaluatorValueForTime(evaluator, times[i]);
+    }
+}
+
 - (NSString *)controlPointsString
 {
     NSMutableString *controlPointsString = [NSMutableString stringWithString:@"["];
@@ -45,3 +88,104 @@
 }
 
 @end
+
+@implementation CAMediaTimingFunction (HLSExtensionsPrivate)
+
+- (const HLSTimingFunctionEvaluator *)evaluator
+{
+    // Timing functions are immutable. The evaluator can be computed once and kept with the function
+    NSData *evaluatorData = objc_getAssociatedObject(self, s_evaluatorKey);
+    if (! evaluatorData) {
+        float values1[2];
+        memset(values1, 0, sizeof(values1));
+        [self getControlPointAtIndex:1 values:values1];
+        
+        float values2[2];
+        memset(values2, 0, sizeof(values2));
+        [self getControlPointAtIndex:2 values:values2];
+        
+        HLSTimingFunctionEvaluator evaluator;
+        evaluator.cx = 3.f * values1[0];
+        evaluator.bx = 3.f * (values2[0] - values1[0]) - evaluator.cx;
+        evaluator.ax = 1.f - evaluator.cx - evaluator.bx;
+        evaluator.cy = 3.f * values1[1];
+        evaluator.by = 3.f * (values2[1] - values1[1]) - evaluator.cy;
+        evaluator.ay = 1.f - evaluator.cy - evaluator.by;
+        
+        for (size_t i = 0; i < kTimingFunctionSampleCount; ++i) {
+            float t = (float)i / (kTimingFunctionSampleCount - 1);
+            evaluator.samples[i] = ((evaluator.ax * t + evaluator.bx) * t + evaluator.cx) * t;
+        }
+        
+        evaluatorData = [NSData dataWithBytes:&evaluator length:sizeof(HLSTimingFunctionEvaluator)];
+        objc_setAssociatedObject(self, s_evaluatorKey, evaluatorData, OBJC_ASSOCIATION_RETAIN);
+    }
+    return [evaluatorData bytes];
+}
+
+@end
+
+static float HLSTimingFunctionEvaluatorValueForTime(const HLSTimingFunctionEvaluator *evaluator, float time)
+{
+    static const float kEpsilon = 1e-6f;
+    static const NSUInteger kNewtonIterations = 4;
+    static const NSUInteger kBisectionIterations = 20;
+    
+    if (time <= 0.f) {
+        return 0.f;
+    }
+    else if (time >= 1.f) {
+        return 1.f;
+    }
+    
+    // x(t) is increasing on [0, 1]. Find the lookup table interval containing time, and interpolate linearly to get
+    // a good starting point
+    static const float kSampleStep = 1.f / (kTimingFunctionSampleCount - 1);
+    size_t index = 1;
+    while (index < kTimingFunctionSampleCount - 1 && evaluator->samples[index] <= time) {
+        ++index;
+    }
+    float intervalStart = evaluator->samples[index - 1];
+    float intervalLength = evaluator->samples[index] - intervalStart;
+    float tStart = (index - 1) * kSampleStep;
+    float t = tStart + ((intervalLength > kEpsilon) ? (time - intervalStart) / intervalLength * kSampleStep : 0.f);
+    
+    // Newton iterations, which converge quickly from this starting point unless the slope is too small
+    BOOL converged = NO;
+    for (NSUInteger i = 0; i < kNewtonIterations; ++i) {
+        float x = ((evaluator->ax * t + evaluator->bx) * t + evaluator->cx) * t - time;
+        if (fabsf(x) < kEpsilon) {
+            converged = YES;
+            break;
+        }
+        
+        float slope = (3.f * evaluator->ax * t + 2.f * evaluator->bx) * t + evaluator->cx;
+        if (fabsf(slope) < kEpsilon) {
+            break;
+        }
+        t -= x / slope;
+    }
+    
+    // Bisection fallback on the lookup table interval
+    if (! converged || t < tStart || t > tStart + kSampleStep) {
+        float tLow = tStart;
+        float tHigh = tStart + kSampleStep;
+        t = (tLow + tHigh) / 2.f;
+        for (NSUInteger i = 0; i < kBisectionIterations; ++i) {
+            float x = ((evaluator->ax * t + evaluator->bx) * t + evaluator->cx) * t;
+            if (fabsf(x - time) < kEpsilon) {
+                break;
+            }
+            
+            if (x < time) {
+                tLow = t;
+            }
+            else {
+                tHigh = t;
+            }
+            t = (tLow + tHigh) / 2.f;
+        }
+    }
+    
+    return ((evaluator->ay * t + evaluator->by) * t + evaluator->cy) * t;
+}
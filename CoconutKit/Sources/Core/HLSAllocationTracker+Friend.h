@@ -0,0 +1,22 @@
+//
+//  HLSAllocationTracker+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAllocationTracker.h"
+
+/**
+ * Interface meant to be used by friend classes of HLSAllocationTracker (= classes which must have access to private
+ * implementation details)
+ */
+
+/**
+ * Create an autorelease pool for a CoconutKit internal loop, and drain it. When tracking is enabled, objects allocated
+ * and autoreleased in between are counted for the specified subsystem. When tracking is disabled, these functions
+ * simply create and drain the pool. Pools must be drained in the reverse order of their creation
+ */
+NSAutoreleasePool *HLSAutoreleasePoolPush(HLSAllocationSubsystem subsystem);
+void HLSAutoreleasePoolPop(NSAutoreleasePool *pool);
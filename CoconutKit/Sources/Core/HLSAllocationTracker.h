@@ -0,0 +1,70 @@
+//
+//  HLSAllocationTracker.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * CoconutKit subsystems whose allocations can be tracked
+ */
+typedef enum {
+    HLSAllocationSubsystemEnumBegin = 0,
+    HLSAllocationSubsystemAnimation = HLSAllocationSubsystemEnumBegin,
+    HLSAllocationSubsystemCore,
+    HLSAllocationSubsystemCoreData,
+    HLSAllocationSubsystemLocalization,
+    HLSAllocationSubsystemTask,
+    HLSAllocationSubsystemView,
+    HLSAllocationSubsystemViewControllers,
+    HLSAllocationSubsystemEnumEnd,
+    HLSAllocationSubsystemEnumSize = HLSAllocationSubsystemEnumEnd - HLSAllocationSubsystemEnumBegin
+} HLSAllocationSubsystem;
+
+/**
+ * CoconutKit uses manual reference counting and autoreleases many temporary objects. Loops processing many items
+ * (validation of many objects, bulk deletion, task group submission, localization passes, etc.) therefore drain
+ * an autorelease pool after each item or batch, so that peak memory stays bounded.
+ *
+ * When tracking is enabled, the Objective-C objects allocated and autoreleased while these internal pools are in
+ * use are counted, per subsystem. The report lists for each subsystem the number of pools drained, the number of
+ * allocations and autoreleases, and the largest number of objects a single pool had to release (peak pool size).
+ * A large peak pool size hints at a loop which should drain its pool more often.
+ *
+ * Tracking works by swizzling +[NSObject allocWithZone:] and -[NSObject autorelease] the first time it is enabled,
+ * and is therefore meant for debugging and profiling purposes only. Objects created outside CoconutKit internal
+ * pools, or using Core Foundation functions, are not counted. Measurements are kept until tracking is reset, and
+ * can be made from any thread
+ */
+@interface HLSAllocationTracker : NSObject
+
+/**
+ * Enable or disable tracking (disabled by default)
+ */
++ (void)setTrackingEnabled:(BOOL)trackingEnabled;
++ (BOOL)isTrackingEnabled;
+
+/**
+ * Measurements for a subsystem
+ */
++ (NSUInteger)allocationCountForSubsystem:(HLSAllocationSubsystem)subsystem;
++ (NSUInteger)autoreleaseCountForSubsystem:(HLSAllocationSubsystem)subsystem;
++ (NSUInteger)peakAutoreleasePoolSizeForSubsystem:(HLSAllocationSubsystem)subsystem;
+
+/**
+ * Return the report, listing the measurements of all subsystems
+ */
++ (NSString *)report;
+
+/**
+ * Log the report (info level)
+ */
++ (void)logReport;
+
+/**
+ * Discard all measurements
+ */
++ (void)reset;
+
+@end
@@ -0,0 +1,242 @@
+//
+//  HLSAllocationTracker.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSAllocationTracker.h"
+
+#import <libkern/OSAtomic.h>
+#import <objc/runtime.h>
+#import <pthread.h>
+#import "HLSAllocationTracker+Friend.h"
+#import "HLSLogger.h"
+#import "HLSRuntime.h"
+
+#define kAllocationTrackerMaximumDepth      32
+
+typedef struct {
+    volatile int64_t allocationCount;
+    volatile int64_t autoreleaseCount;
+    NSUInteger poolCount;                   // protected by s_statisticsMutex
+    NSUInteger peakPoolSize;                // protected by s_statisticsMutex
+} HLSAllocationTrackerStatistics;
+
+// Tracked pools of a thread, innermost last
+typedef struct {
+    NSAutoreleasePool *pools[kAllocationTrackerMaximumDepth];
+    HLSAllocationSubsystem subsystems[kAllocationTrackerMaximumDepth];
+    NSUInteger autoreleaseCounts[kAllocationTrackerMaximumDepth];
+    NSUInteger depth;
+} HLSAllocationTrackerThreadState;
+
+static NSString * const s_subsystemNames[HLSAllocationSubsystemEnumSize] = {
+    @"Animation",
+    @"Core",
+    @"Core Data",
+    @"Localization",
+    @"Task",
+    @"View",
+    @"View controllers"
+};
+
+// Variables with internal linkage
+static BOOL s_injected = NO;
+static BOOL s_trackingEnabled = NO;
+static HLSAllocationTrackerStatistics s_statistics[HLSAllocationSubsystemEnumSize];
+static pthread_mutex_t s_statisticsMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t s_threadStateKey;
+static pthread_once_t s_threadStateKeyOnce = PTHREAD_ONCE_INIT;
+
+// Original implementation of the methods we swizzle
+static id (*s_NSObject__allocWithZone_Imp)(id, SEL, NSZone *) = NULL;
+static id (*s_NSObject__autorelease_Imp)(id, SEL) = NULL;
+
+// Swizzled method implementations
+static id swizzled_NSObject__allocWithZone_Imp(id self, SEL _cmd, NSZone *zone);
+static id swizzled_NSObject__autorelease_Imp(id self, SEL _cmd);
+
+// Static functions
+static void HLSAllocationTrackerCreateThreadStateKey(void);
+static HLSAllocationTrackerThreadState *HLSAllocationTrackerCurrentThreadState(BOOL create);
+
+@implementation HLSAllocationTracker
+
+#pragma mark Class methods
+
++ (void)setTrackingEnabled:(BOOL)trackingEnabled
+{
+    @synchronized(self) {
+        // Only swizzled when first enabled, so that applications which do not track allocations do not pay for it. The
+        // original implementations must be available before the swizzled ones can be called
+        if (trackingEnabled && ! s_injected) {
+            s_NSObject__allocWithZone_Imp = (id (*)(id, SEL, NSZone *))method_getImplementation(class_getClassMethod([NSObject class], @selector(allocWithZone:)));
+            s_NSObject__autorelease_Imp = (id (*)(id, SEL))method_getImplementation(class_getInstanceMethod([NSObject class], @selector(autorelease)));
+            OSMemoryBarrier();
+            
+            s_NSObject__allocWithZone_Imp = (id (*)(id, SEL, NSZone *))HLSSwizzleClassSelector([NSObject class], @selector(allocWithZone:), (IMP)swizzled_NSObject__allocWithZone_Imp);
+            s_NSObject__autorelease_Imp = (id (*)(id, SEL))HLSSwizzleSelector([NSObject class], @selector(autorelease), (IMP)swizzled_NSObject__autorelease_Imp);
+            s_injected = YES;
+        }
+        
+        s_trackingEnabled = trackingEnabled;
+    }
+}
+
++ (BOOL)isTrackingEnabled
+{
+    return s_trackingEnabled;
+}
+
++ (NSUInteger)allocationCountForSubsystem:(HLSAllocationSubsystem)subsystem
+{
+    NSAssert(subsystem < HLSAllocationSubsystemEnumEnd, @"Invalid subsystem");
+    return (NSUInteger)s_statistics[subsystem].allocationCount;
+}
+
++ (NSUInteger)autoreleaseCountForSubsystem:(HLSAllocationSubsystem)subsystem
+{
+    NSAssert(subsystem < HLSAllocationSubsystemEnumEnd, @"Invalid subsystem");
+    return (NSUInteger)s_statistics[subsystem].autoreleaseCount;
+}
+
++ (NSUInteger)peakAutoreleasePoolSizeForSubsystem:(HLSAllocationSubsystem)subsystem
+{
+    NSAssert(subsystem < HLSAllocationSubsystemEnumEnd, @"Invalid subsystem");
+    
+    pthread_mutex_lock(&s_statisticsMutex);
+    NSUInteger peakPoolSize = s_statistics[subsystem].peakPoolSize;
+    pthread_mutex_unlock(&s_statisticsMutex);
+    return peakPoolSize;
+}
+
++ (NSString *)report
+{
+    HLSAllocationTrackerStatistics statistics[HLSAllocationSubsystemEnumSize];
+    
+    pthread_mutex_lock(&s_statisticsMutex);
+    memcpy(statistics, s_statistics, sizeof(s_statistics));
+    pthread_mutex_unlock(&s_statisticsMutex);
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"CoconutKit allocation report (tracking %@)",
+                               s_trackingEnabled ? @"enabled" : @"disabled"];
+    for (NSUInteger i = HLSAllocationSubsystemEnumBegin; i < HLSAllocationSubsystemEnumEnd; ++i) {
+        [report appendFormat:@"\n  %@: %u pools, %lld allocations, %lld autoreleases, peak pool size: %u",
+         s_subsystemNames[i],
+         statistics[i].poolCount,
+         statistics[i].allocationCount,
+         statistics[i].autoreleaseCount,
+         statistics[i].peakPoolSize];
+    }
+    return [NSString stringWithString:report];
+}
+
++ (void)logReport
+{
+    HLSLoggerInfo(@"%@", [self report]);
+}
+
++ (void)reset
+{
+    pthread_mutex_lock(&s_statisticsMutex);
+    memset(s_statistics, 0, sizeof(s_statistics));
+    pthread_mutex_unlock(&s_statisticsMutex);
+}
+
+@end
+
+#pragma mark Friend functions
+
+NSAutoreleasePool *HLSAutoreleasePoolPush(HLSAllocationSubsystem subsystem)
+{
+    NSCAssert(subsystem < HLSAllocationSubsystemEnumEnd, @"Invalid subsystem");
+    
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    if (! s_trackingEnabled) {
+        return pool;
+    }
+    
+    // Pools nested too deeply are not tracked (objects are then accounted to the enclosing pool)
+    HLSAllocationTrackerThreadState *threadState = HLSAllocationTrackerCurrentThreadState(YES);
+    if (! threadState || threadState->depth == kAllocationTrackerMaximumDepth) {
+        return pool;
+    }
+    
+    NSUInteger depth = threadState->depth;
+    threadState->pools[depth] = pool;
+    threadState->subsystems[depth] = subsystem;
+    threadState->autoreleaseCounts[depth] = 0;
+    threadState->depth = depth + 1;
+    return pool;
+}
+
+void HLSAutoreleasePoolPop(NSAutoreleasePool *pool)
+{
+    // Tracking might have been disabled since the pool was pushed. Check whether it is tracked
+    HLSAllocationTrackerThreadState *threadState = s_injected ? HLSAllocationTrackerCurrentThreadState(NO) : NULL;
+    if (threadState && threadState->depth != 0 && threadState->pools[threadState->depth - 1] == pool) {
+        NSUInteger index = --threadState->depth;
+        HLSAllocationSubsystem subsystem = threadState->subsystems[index];
+        NSUInteger poolSize = threadState->autoreleaseCounts[index];
+        
+        pthread_mutex_lock(&s_statisticsMutex);
+        ++s_statistics[subsystem].poolCount;
+        if (poolSize > s_statistics[subsystem].peakPoolSize) {
+            s_statistics[subsystem].peakPoolSize = poolSize;
+        }
+        pthread_mutex_unlock(&s_statisticsMutex);
+    }
+    
+    [pool drain];
+}
+
+#pragma mark Swizzled method implementations
+
+// Must not allocate or autorelease any object (this would call the swizzled implementations again)
+static id swizzled_NSObject__allocWithZone_Imp(id self, SEL _cmd, NSZone *zone)
+{
+    if (s_trackingEnabled) {
+        HLSAllocationTrackerThreadState *threadState = HLSAllocationTrackerCurrentThreadState(NO);
+        if (threadState && threadState->depth != 0) {
+            OSAtomicIncrement64(&s_statistics[threadState->subsystems[threadState->depth - 1]].allocationCount);
+        }
+    }
+    
+    return (*s_NSObject__allocWithZone_Imp)(self, _cmd, zone);
+}
+
+static id swizzled_NSObject__autorelease_Imp(id self, SEL _cmd)
+{
+    if (s_trackingEnabled) {
+        HLSAllocationTrackerThreadState *threadState = HLSAllocationTrackerCurrentThreadState(NO);
+        if (threadState && threadState->depth != 0) {
+            NSUInteger index = threadState->depth - 1;
+            ++threadState->autoreleaseCounts[index];
+            OSAtomicIncrement64(&s_statistics[threadState->subsystems[index]].autoreleaseCount);
+        }
+    }
+    
+    return (*s_NSObject__autorelease_Imp)(self, _cmd);
+}
+
+#pragma mark Static functions
+
+static void HLSAllocationTrackerCreateThreadStateKey(void)
+{
+    pthread_key_create(&s_threadStateKey, free);
+}
+
+// Thread states are plain C structures, so that they can be used without allocating any object
+static HLSAllocationTrackerThreadState *HLSAllocationTrackerCurrentThreadState(BOOL create)
+{
+    pthread_once(&s_threadStateKeyOnce, HLSAllocationTrackerCreateThreadStateKey);
+    
+    HLSAllocationTrackerThreadState *threadState = pthread_getspecific(s_threadStateKey);
+    if (! threadState && create) {
+        threadState = calloc(1, sizeof(HLSAllocationTrackerThreadState));
+        pthread_setspecific(s_threadStateKey, threadState);
+    }
+    return threadState;
+}
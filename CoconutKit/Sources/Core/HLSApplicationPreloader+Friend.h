@@ -0,0 +1,26 @@
+//
+//  HLSApplicationPreloader+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Interface meant to be used by friend classes of HLSApplicationPreloader (= classes which must have access to private 
+ * implementation details)
+ */
+@interface HLSApplicationPreloader (Friend)
+
+/**
+ * Register the stages CoconutKit provides. Called when preloading is enabled
+ */
++ (void)registerBuiltInStages;
+
+/**
+ * Start running the registered stages (and those registered afterwards). Called once the application has finished
+ * launching, subsequent calls do nothing
+ */
++ (void)startStages;
+
+@end
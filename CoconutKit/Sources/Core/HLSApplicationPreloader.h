@@ -6,10 +6,32 @@
 //  Copyright (c) 2012 Hortis. All rights reserved.
 //
 
+/**
+ * Names of the built-in preloading stages
+ */
+extern NSString * const HLSApplicationPreloadingStageLocalization;         // Loads the strings tables of the current localization
+extern NSString * const HLSApplicationPreloadingStageTransitions;          // Registers the available transition classes
+
+/**
+ * Priority of the built-in preloading stages
+ */
+extern const NSInteger HLSApplicationPreloadingBuiltInStagePriority;
+
 /**
  * Collects the code which can be executed right after an application has started so that perceived performance can be
- * increased. For the moment only UIWebView is preloaded so that the time usually required when instantiating the first
- * web view is reduced
+ * increased. UIWebView is always preloaded so that the time usually required when instantiating the first web view is 
+ * reduced. Once done, the web view pool is filled (see HLSWebViewPool.h)
+ *
+ * Other preloading stages can be registered (e.g. registering fonts, caching nibs using UINib+HLSExtensions, decoding 
+ * images, opening Core Data stores, loading localization tables). Once -application:didFinishLaunchingWithOptions: has 
+ * returned, stages are run by decreasing priority, so that launch itself is not slowed down:
+ *   - stages which must run on the main thread are run one at a time, each one during an idle run loop pass (not while
+ *     the user is interacting with the interface, e.g. scrolling)
+ *   - other stages are run one after the other on a low-priority background queue
+ * The time spent in each stage is logged (with info level) and can be retrieved using +stageDurations
+ *
+ * CoconutKit registers built-in stages (see the stage names above) with HLSApplicationPreloadingBuiltInStagePriority. 
+ * Use a higher priority for stages which must run before them
  */
 @interface HLSApplicationPreloader : NSObject <UIWebViewDelegate> {
 @private
@@ -22,4 +44,19 @@
  */
 + (void)enable;
 
+/**
+ * Register a preloading stage. Stages can be registered at any time, even if preloading is not enabled (in which case
+ * they are never run). Stages registered after launch are run as soon as possible. The name is used for logging and
+ * timing purposes and should be unique
+ */
++ (void)registerStageWithName:(NSString *)name
+                     priority:(NSInteger)priority
+                 onMainThread:(BOOL)onMainThread
+                        block:(void (^)(void))block;
+
+/**
+ * Return the duration of the stages run so far (NSNumber objects, in seconds), with stage names as keys
+ */
++ (NSDictionary *)stageDurations;
+
 @end
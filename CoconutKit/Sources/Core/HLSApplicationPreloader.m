@@ -8,9 +8,14 @@
 
 #import "HLSApplicationPreloader.h"
 
+#import "HLSApplicationPreloader+Friend.h"
 #import "HLSAssert.h"
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
+#import "HLSTransition.h"
+#import "HLSWebViewPool.h"
+#import "NSBundle+HLSDynamicLocalization.h"
 
 // Keys for associated objects
 static void *s_applicationPreloaderKey = &s_applicationPreloaderKey;
@@ -20,13 +25,47 @@ static void *s_applicationPreloaderKey = &s_applicationPreloaderKey;
 // between class names and swizzled implementations
 NSDictionary *s_classNameToSwizzledApplicationDidFinishLaunchingWithOptionsImpMap = nil;
 
+// Preloading stages waiting to be run (sorted by decreasing priority), and durations of the stages run so far
+static NSMutableArray *s_mainThreadStages = nil;
+static NSMutableArray *s_backgroundStages = nil;
+static NSMutableDictionary *s_stageNameToDurationMap = nil;
+static BOOL s_stagesStarted = NO;
+static dispatch_queue_t s_backgroundStageQueue = NULL;
+
+NSString * const HLSApplicationPreloadingStageLocalization = @"Localization";
+NSString * const HLSApplicationPreloadingStageTransitions = @"Transitions";
+
+const NSInteger HLSApplicationPreloadingBuiltInStagePriority = 0;
+
 // Swizzled method implementations
 static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOptions(id self, SEL _cmd, UIApplication *application, NSDictionary *launchOptions);
 
+/**
+ * Private class describing a preloading stage
+ */
+@interface HLSApplicationPreloadingStage : NSObject {
+@private
+    NSString *_name;
+    NSInteger _priority;
+    void (^_block)(void);
+}
+
+@property (nonatomic, retain) NSString *name;
+@property (nonatomic, assign) NSInteger priority;
+@property (nonatomic, copy) void (^block)(void);
+
+@end
+
 @interface HLSApplicationPreloader ()
 
 @property (nonatomic, assign) UIApplication *application;           // weak ref since retained by the application
 
++ (void)insertStage:(HLSApplicationPreloadingStage *)stage intoStages:(NSMutableArray *)stages;
++ (void)scheduleNextMainThreadStage;
++ (void)runNextMainThreadStage;
++ (void)runNextBackgroundStage;
++ (void)recordDuration:(NSTimeInterval)duration startTime:(CFAbsoluteTime)startTime forStageWithName:(NSString *)name;
+
 @end
 
 @interface HLSApplicationPreloader ()
@@ -49,6 +88,8 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
         return;
     }
     
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     NSMutableDictionary *classNameToSwizzledApplicationDidFinishLaunchingWithOptionsImpMap = [NSMutableDictionary dictionary];
     
     // Loop over all classes. Find the ones which implement the UIApplicationDelegate protocol and swizzle their application:didFinishLaunchingWithOptions: method
@@ -80,9 +121,166 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
     
     s_classNameToSwizzledApplicationDidFinishLaunchingWithOptionsImpMap = [[NSDictionary dictionaryWithDictionary:classNameToSwizzledApplicationDidFinishLaunchingWithOptionsImpMap] retain];
     
+    [self registerBuiltInStages];
+    
+    HLSStartupReportRecord("HLSApplicationPreloader", startTime);
     s_enabled = YES;
 }
 
++ (void)registerStageWithName:(NSString *)name
+                     priority:(NSInteger)priority
+                 onMainThread:(BOOL)onMainThread
+                        block:(void (^)(void))block
+{
+    if (! block) {
+        HLSLoggerError(@"Missing preloading stage block");
+        return;
+    }
+    
+    if (! s_mainThreadStages) {
+        s_mainThreadStages = [[NSMutableArray array] retain];
+        s_backgroundStages = [[NSMutableArray array] retain];
+        s_stageNameToDurationMap = [[NSMutableDictionary dictionary] retain];
+    }
+    
+    HLSApplicationPreloadingStage *stage = [[[HLSApplicationPreloadingStage alloc] init] autorelease];
+    stage.name = name;
+    stage.priority = priority;
+    stage.block = block;
+    
+    if (onMainThread) {
+        [self insertStage:stage intoStages:s_mainThreadStages];
+        if (s_stagesStarted) {
+            [self scheduleNextMainThreadStage];
+        }
+    }
+    else {
+        // Background stages are only accessed from the main thread, the queue only runs their blocks
+        BOOL wasIdle = ([s_backgroundStages count] == 0);
+        [self insertStage:stage intoStages:s_backgroundStages];
+        if (s_stagesStarted && wasIdle) {
+            [self runNextBackgroundStage];
+        }
+    }
+}
+
++ (NSDictionary *)stageDurations
+{
+    return [NSDictionary dictionaryWithDictionary:s_stageNameToDurationMap];
+}
+
++ (void)registerBuiltInStages
+{
+    // Load the strings tables of the current localization, so that the first screens localizing strings do not have to
+    [self registerStageWithName:HLSApplicationPreloadingStageLocalization
+                       priority:HLSApplicationPreloadingBuiltInStagePriority
+                   onMainThread:NO
+                          block:^{
+                              [NSBundle preloadLocalization:[NSBundle localization]];
+                          }];
+    
+    // Registering transitions requires walking through all runtime classes. Registration must occur on the main thread
+    [self registerStageWithName:HLSApplicationPreloadingStageTransitions
+                       priority:HLSApplicationPreloadingBuiltInStagePriority
+                   onMainThread:YES
+                          block:^{
+                              [HLSTransition availableTransitionNames];
+                          }];
+}
+
++ (void)insertStage:(HLSApplicationPreloadingStage *)stage intoStages:(NSMutableArray *)stages
+{
+    // Keep stages sorted by decreasing priority. Stages with the same priority are run in registration order
+    NSUInteger index = 0;
+    for (HLSApplicationPreloadingStage *existingStage in stages) {
+        if (existingStage.priority < stage.priority) {
+            break;
+        }
+        ++index;
+    }
+    [stages insertObject:stage atIndex:index];
+}
+
++ (void)startStages
+{
+    if (s_stagesStarted) {
+        return;
+    }
+    s_stagesStarted = YES;
+    
+    [self scheduleNextMainThreadStage];
+    [self runNextBackgroundStage];
+}
+
++ (void)scheduleNextMainThreadStage
+{
+    if ([s_mainThreadStages count] == 0) {
+        return;
+    }
+    
+    // Only performed in the default run loop mode, i.e. not while the user is interacting with the interface
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(runNextMainThreadStage) object:nil];
+    [self performSelector:@selector(runNextMainThreadStage)
+               withObject:nil
+               afterDelay:0.
+                  inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
++ (void)runNextMainThreadStage
+{
+    if ([s_mainThreadStages count] == 0) {
+        return;
+    }
+    
+    HLSApplicationPreloadingStage *stage = [[[s_mainThreadStages objectAtIndex:0] retain] autorelease];
+    [s_mainThreadStages removeObjectAtIndex:0];
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    stage.block();
+    [self recordDuration:CFAbsoluteTimeGetCurrent() - startTime startTime:startTime forStageWithName:stage.name];
+    
+    [self scheduleNextMainThreadStage];
+}
+
++ (void)runNextBackgroundStage
+{
+    if ([s_backgroundStages count] == 0) {
+        return;
+    }
+    
+    if (! s_backgroundStageQueue) {
+        s_backgroundStageQueue = dispatch_queue_create("ch.hortis.CoconutKit.HLSApplicationPreloader", NULL);
+        dispatch_set_target_queue(s_backgroundStageQueue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+    }
+    
+    // The stage is removed when it is done, so that the list is not empty while a stage runs
+    HLSApplicationPreloadingStage *stage = [s_backgroundStages objectAtIndex:0];
+    dispatch_async(s_backgroundStageQueue, ^{
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        stage.block();
+        NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+        [pool drain];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self recordDuration:duration startTime:startTime forStageWithName:stage.name];
+            [s_backgroundStages removeObject:stage];
+            [self runNextBackgroundStage];
+        });
+    });
+}
+
++ (void)recordDuration:(NSTimeInterval)duration startTime:(CFAbsoluteTime)startTime forStageWithName:(NSString *)name
+{
+    HLSLoggerInfo(@"Preloading stage %@ took %.1f ms", name, duration * 1000.);
+    if (name) {
+        [s_stageNameToDurationMap setObject:[NSNumber numberWithDouble:duration] forKey:name];
+    }
+    
+    NSString *featureName = [NSString stringWithFormat:@"HLSApplicationPreloader (%@)", name ? name : @"unnamed stage"];
+    HLSStartupReportRecordDuration([featureName UTF8String], startTime, duration);
+}
+
 #pragma mark Object creation and destruction
 
 - (id)initWithApplication:(UIApplication *)application
@@ -114,6 +312,8 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
 
 - (void)preload
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     // To avoid the delay which occurs when loading a UIWebView for the first time, we display one as soon as possible
     // (out of screen bounds). It seems that loading a large web view (here with the application frame size) is more 
     // effective
@@ -135,7 +335,9 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
         HLSLoggerWarn(@"No key window found. Cannot preload UIWebView. To fix this issue, your application delegate must "
                       "implement the -application:didFinishLaunchingWithOptions: method to set the key window, either by "
                       "calling -makeKeyAndVisible or -makeKeyWindow");
-    }    
+    }
+    
+    HLSStartupReportRecord("HLSApplicationPreloader (UIWebView)", startTime);
 }
 
 #pragma mark UIWebViewDelegate protocol implementation
@@ -145,6 +347,9 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
     // The web view is not needed anymore
     [webView removeFromSuperview];
     [webView release];
+    
+    // The web engine is now ready. Prepare web views for later use
+    [[HLSWebViewPool sharedWebViewPool] fill];
 }
 
 @end
@@ -168,5 +373,30 @@ static BOOL swizzled_UIApplicationDelegate__application_didFinishLaunchingWithOp
     objc_setAssociatedObject(self, s_applicationPreloaderKey, applicationPreloader, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
     [applicationPreloader preload];
     
+    // Now that launch is over, run the registered stages
+    [HLSApplicationPreloader startStages];
+    
     return YES;
 }
+
+@implementation HLSApplicationPreloadingStage
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.name = nil;
+    self.block = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize name = _name;
+
+@synthesize priority = _priority;
+
+@synthesize block = _block;
+
+@end
@@ -0,0 +1,65 @@
+//
+//  HLSBlobStore.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileManager.h"
+
+/**
+ * A content-addressed store for binary payloads (e.g. downloaded data), built on top of a file manager. Each payload
+ * is identified by its SHA-256 digest (lowercase hexadecimal), and stored only once, however many times it is added.
+ * Payloads are reference-counted: each -putData:error: call must be balanced by a -releaseDigest:error: call, the
+ * payload being deleted when its reference count drops to zero.
+ *
+ * Payloads are stored in sharded directories derived from their digest (rootPath/ab/cd/abcd...), so that lookups never
+ * require a directory scan, and directories never grow too large. Each payload is fully written to a temporary file
+ * first, then renamed, so that a payload is either completely available or missing, even after a crash.
+ *
+ * This class is thread-safe, provided the store directory is accessed through a single store instance.
+ *
+ * Designated initializer: -initWithFileManager:rootPath:
+ */
+@interface HLSBlobStore : NSObject {
+@private
+    HLSFileManager *m_fileManager;
+    NSString *m_rootPath;
+}
+
+/**
+ * Create a store within the specified directory (created if it does not exist yet), using the given file manager
+ */
+- (id)initWithFileManager:(HLSFileManager *)fileManager rootPath:(NSString *)rootPath;
+
+@property (nonatomic, readonly, retain) HLSFileManager *fileManager;
+@property (nonatomic, readonly, retain) NSString *rootPath;
+
+/**
+ * Add a payload to the store (or increment its reference count if it is already stored), and return its digest. Return
+ * nil on failure
+ */
+- (NSString *)putData:(NSData *)data error:(NSError **)pError;
+
+/**
+ * Return the payload corresponding to a digest, nil if none
+ */
+- (NSData *)dataForDigest:(NSString *)digest error:(NSError **)pError;
+
+/**
+ * Return YES iff a payload is stored for the specified digest
+ */
+- (BOOL)containsDigest:(NSString *)digest;
+
+/**
+ * Decrement the reference count of a payload, and delete it if it is not referenced anymore. Return YES iff successful
+ */
+- (BOOL)releaseDigest:(NSString *)digest error:(NSError **)pError;
+
+/**
+ * The reference count of a payload, 0 if none
+ */
+- (NSUInteger)referenceCountForDigest:(NSString *)digest;
+
+@end
@@ -0,0 +1,231 @@
+//
+//  HLSBlobStore.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSBlobStore.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+#import "NSData+HLSExtensions.h"
+
+static NSString * const kTemporaryDirectoryName = @"tmp";
+static NSString * const kReferenceCountFileExtension = @"refs";
+
+@interface HLSBlobStore ()
+
+@property (nonatomic, retain) HLSFileManager *fileManager;
+@property (nonatomic, retain) NSString *rootPath;
+
+- (BOOL)isValidDigest:(NSString *)digest;
+- (NSString *)pathForDigest:(NSString *)digest;
+- (NSString *)referenceCountPathForDigest:(NSString *)digest;
+
+- (BOOL)setReferenceCount:(NSUInteger)referenceCount forDigest:(NSString *)digest error:(NSError **)pError;
+
+@end
+
+@implementation HLSBlobStore
+
+#pragma mark Object creation and destruction
+
+- (id)initWithFileManager:(HLSFileManager *)fileManager rootPath:(NSString *)rootPath
+{
+    if ((self = [super init])) {
+        if (! fileManager || ! rootPath) {
+            HLSLoggerError(@"A file manager and a root path are mandatory");
+            [self release];
+            return nil;
+        }
+        
+        NSError *error = nil;
+        NSString *temporaryDirectoryPath = [rootPath stringByAppendingPathComponent:kTemporaryDirectoryName];
+        if (! [fileManager createDirectoryAtPath:temporaryDirectoryPath withIntermediateDirectories:YES error:&error]) {
+            HLSLoggerError(@"Could not create the store directory %@. Reason: %@", rootPath, error);
+            [self release];
+            return nil;
+        }
+        
+        self.fileManager = fileManager;
+        self.rootPath = rootPath;
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    self.fileManager = nil;
+    self.rootPath = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize fileManager = m_fileManager;
+
+@synthesize rootPath = m_rootPath;
+
+#pragma mark Paths
+
+- (BOOL)isValidDigest:(NSString *)digest
+{
+    static NSCharacterSet *s_nonHexadecimalCharacterSet = nil;
+    if (! s_nonHexadecimalCharacterSet) {
+        s_nonHexadecimalCharacterSet = [[[NSCharacterSet characterSetWithCharactersInString:@"0123456789abcdef"] invertedSet] retain];
+    }
+    
+    // SHA-256 digests
+    return [digest length] == 64 && [digest rangeOfCharacterFromSet:s_nonHexadecimalCharacterSet].location == NSNotFound;
+}
+
+- (NSString *)pathForDigest:(NSString *)digest
+{
+    NSString *shardPath = [[self.rootPath stringByAppendingPathComponent:[digest substringWithRange:NSMakeRange(0, 2)]]
+                           stringByAppendingPathComponent:[digest substringWithRange:NSMakeRange(2, 2)]];
+    return [shardPath stringByAppendingPathComponent:digest];
+}
+
+- (NSString *)referenceCountPathForDigest:(NSString *)digest
+{
+    return [[self pathForDigest:digest] stringByAppendingPathExtension:kReferenceCountFileExtension];
+}
+
+#pragma mark Reference counts
+
+- (NSUInteger)referenceCountForDigest:(NSString *)digest
+{
+    if (! [self isValidDigest:digest]) {
+        return 0;
+    }
+    
+    @synchronized(self) {
+        NSData *referenceCountData = [self.fileManager contentsOfFileAtPath:[self referenceCountPathForDigest:digest] error:NULL];
+        if (! referenceCountData) {
+            // A payload whose reference count file could not be written is referenced once
+            return [self.fileManager fileExistsAtPath:[self pathForDigest:digest]] ? 1 : 0;
+        }
+        
+        NSString *referenceCountString = [[[NSString alloc] initWithData:referenceCountData encoding:NSUTF8StringEncoding] autorelease];
+        return (NSUInteger)[referenceCountString integerValue];
+    }
+}
+
+// Must be called with the lock held
+- (BOOL)setReferenceCount:(NSUInteger)referenceCount forDigest:(NSString *)digest error:(NSError **)pError
+{
+    NSData *referenceCountData = [[NSString stringWithFormat:@"%u", referenceCount] dataUsingEncoding:NSUTF8StringEncoding];
+    return [self.fileManager createFileAtPath:[self referenceCountPathForDigest:digest] contents:referenceCountData error:pError];
+}
+
+#pragma mark Storage
+
+- (NSString *)putData:(NSData *)data error:(NSError **)pError
+{
+    if (! data) {
+        HLSLoggerError(@"Missing data");
+        return nil;
+    }
+    
+    NSString *digest = [data sha256hash];
+    NSString *path = [self pathForDigest:digest];
+    
+    @synchronized(self) {
+        // Already stored: Only add a reference
+        if ([self.fileManager fileExistsAtPath:path]) {
+            NSUInteger referenceCount = [self referenceCountForDigest:digest];
+            if (! [self setReferenceCount:referenceCount + 1 forDigest:digest error:pError]) {
+                return nil;
+            }
+            return digest;
+        }
+        
+        if (! [self.fileManager createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES error:pError]) {
+            return nil;
+        }
+        
+        // Write then rename, so that a payload is never partially available
+        NSString *temporaryPath = [[self.rootPath stringByAppendingPathComponent:kTemporaryDirectoryName] stringByAppendingPathComponent:digest];
+        if (! [self.fileManager createFileAtPath:temporaryPath contents:data error:pError]) {
+            return nil;
+        }
+        if (! [self.fileManager moveItemAtPath:temporaryPath toPath:path error:pError]) {
+            [self.fileManager removeItemAtPath:temporaryPath error:NULL];
+            return nil;
+        }
+        
+        if (! [self setReferenceCount:1 forDigest:digest error:pError]) {
+            return nil;
+        }
+    }
+    
+    return digest;
+}
+
+- (NSData *)dataForDigest:(NSString *)digest error:(NSError **)pError
+{
+    if (! [self isValidDigest:digest]) {
+        HLSLoggerError(@"Invalid digest %@", digest);
+        return nil;
+    }
+    
+    return [self.fileManager contentsOfFileAtPath:[self pathForDigest:digest] error:pError];
+}
+
+- (BOOL)containsDigest:(NSString *)digest
+{
+    if (! [self isValidDigest:digest]) {
+        return NO;
+    }
+    
+    return [self.fileManager fileExistsAtPath:[self pathForDigest:digest]];
+}
+
+- (BOOL)releaseDigest:(NSString *)digest error:(NSError **)pError
+{
+    if (! [self isValidDigest:digest]) {
+        HLSLoggerError(@"Invalid digest %@", digest);
+        return NO;
+    }
+    
+    @synchronized(self) {
+        NSUInteger referenceCount = [self referenceCountForDigest:digest];
+        if (referenceCount == 0) {
+            HLSLoggerWarn(@"No payload stored for digest %@", digest);
+            return NO;
+        }
+        
+        if (referenceCount > 1) {
+            return [self setReferenceCount:referenceCount - 1 forDigest:digest error:pError];
+        }
+        
+        // Remove the payload first. If this fails, the reference count is left unchanged
+        if (! [self.fileManager removeItemAtPath:[self pathForDigest:digest] error:pError]) {
+            return NO;
+        }
+        [self.fileManager removeItemAtPath:[self referenceCountPathForDigest:digest] error:NULL];
+        return YES;
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; fileManager: %@; rootPath: %@>",
+            [self class],
+            self,
+            self.fileManager,
+            self.rootPath];
+}
+
+@end
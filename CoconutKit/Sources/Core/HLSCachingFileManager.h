@@ -0,0 +1,69 @@
+//
+//  HLSCachingFileManager.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileManager.h"
+
+@class HLSCachingFileManagerEntry;
+
+/**
+ * A file manager decorating another file manager, and keeping the contents of recently read small files in memory, so
+ * that files read repeatedly (e.g. configuration or JSON files) are not read from the underlying storage each time.
+ *
+ * Cached files are discarded in least recently used order when the total size of the cache exceeds its capacity.
+ * Files larger than maximumCachedFileSize are never cached. All operations modifying files are performed by the
+ * underlying file manager first, then the corresponding cache entries are updated or invalidated (for directories,
+ * all files they contain are invalidated). Files must therefore only be modified through the caching file manager
+ * itself, otherwise stale data might be returned. The cache is emptied when a memory warning is received.
+ *
+ * When several threads read the same file which is not cached, only the first one reads it from the underlying file
+ * manager, the other ones waiting for the file to be cached.
+ *
+ * This class is thread-safe.
+ *
+ * Designated initializer: -initWithFileManager:capacity:
+ */
+@interface HLSCachingFileManager : HLSFileManager {
+@private
+    HLSFileManager *m_fileManager;
+    NSUInteger m_capacity;
+    NSUInteger m_maximumCachedFileSize;
+    NSMutableDictionary *m_pathToEntryMap;
+    NSCondition *m_pendingReadsCondition;
+    NSMutableSet *m_pendingReadPaths;
+    NSMutableSet *m_invalidatedPendingReadPaths;
+    HLSCachingFileManagerEntry *m_mostRecentlyUsedEntry;
+    HLSCachingFileManagerEntry *m_leastRecentlyUsedEntry;
+    NSUInteger m_cachedByteCount;
+}
+
+/**
+ * Create a caching file manager on top of the specified file manager, with a given capacity (in bytes)
+ */
+- (id)initWithFileManager:(HLSFileManager *)fileManager capacity:(NSUInteger)capacity;
+
+@property (nonatomic, readonly, retain) HLSFileManager *fileManager;
+@property (nonatomic, readonly, assign) NSUInteger capacity;
+
+/**
+ * Files larger than this value (in bytes) are not cached
+ *
+ * Default value is 64 KB
+ */
+@property (assign) NSUInteger maximumCachedFileSize;
+
+/**
+ * The total size of the files currently cached
+ */
+@property (readonly, assign) NSUInteger cachedByteCount;
+
+/**
+ * Discard all cached files
+ */
+- (void)removeAllCachedFiles;
+
+@end
@@ -0,0 +1,508 @@
+//
+//  HLSCachingFileManager.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSCachingFileManager.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+static const NSUInteger kDefaultMaximumCachedFileSize = 64 * 1024;
+
+/**
+ * Private class for cache entries, which form a doubly-linked list in most recently used order. Entries are owned by
+ * the path to entry map, list links are therefore not retained
+ */
+@interface HLSCachingFileManagerEntry : NSObject {
+@private
+    NSString *m_path;
+    NSData *m_data;
+    HLSCachingFileManagerEntry *m_previousEntry;
+    HLSCachingFileManagerEntry *m_nextEntry;
+}
+
+- (id)initWithPath:(NSString *)path data:(NSData *)data;
+
+@property (nonatomic, readonly, retain) NSString *path;
+@property (nonatomic, readonly, retain) NSData *data;
+@property (nonatomic, assign) HLSCachingFileManagerEntry *previousEntry;        // More recently used
+@property (nonatomic, assign) HLSCachingFileManagerEntry *nextEntry;            // Less recently used
+
+@end
+
+@interface HLSCachingFileManager ()
+
+@property (nonatomic, retain) HLSFileManager *fileManager;
+@property (nonatomic, retain) NSMutableDictionary *pathToEntryMap;
+@property (nonatomic, retain) NSCondition *pendingReadsCondition;
+@property (nonatomic, retain) NSMutableSet *pendingReadPaths;
+@property (nonatomic, retain) NSMutableSet *invalidatedPendingReadPaths;
+
+- (NSData *)cachedDataForPath:(NSString *)path;
+- (void)cacheData:(NSData *)data forPath:(NSString *)path;
+- (void)invalidatePath:(NSString *)path;
+
+- (void)unlinkEntry:(HLSCachingFileManagerEntry *)entry;
+- (void)linkEntryAsMostRecentlyUsed:(HLSCachingFileManagerEntry *)entry;
+- (void)removeEntry:(HLSCachingFileManagerEntry *)entry;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation HLSCachingFileManager
+
+#pragma mark Object creation and destruction
+
+- (id)initWithFileManager:(HLSFileManager *)fileManager capacity:(NSUInteger)capacity
+{
+    if ((self = [super init])) {
+        if (! fileManager) {
+            HLSLoggerError(@"An underlying file manager is mandatory");
+            [self release];
+            return nil;
+        }
+        
+        self.fileManager = fileManager;
+        m_capacity = capacity;
+        m_maximumCachedFileSize = kDefaultMaximumCachedFileSize;
+        self.pathToEntryMap = [NSMutableDictionary dictionary];
+        self.pendingReadsCondition = [[[NSCondition alloc] init] autorelease];
+        self.pendingReadPaths = [NSMutableSet set];
+        self.invalidatedPendingReadPaths = [NSMutableSet set];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidReceiveMemoryWarningNotification
+                                                  object:nil];
+    
+    self.fileManager = nil;
+    self.pathToEntryMap = nil;
+    self.pendingReadsCondition = nil;
+    self.pendingReadPaths = nil;
+    self.invalidatedPendingReadPaths = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize fileManager = m_fileManager;
+
+@synthesize capacity = m_capacity;
+
+@synthesize maximumCachedFileSize = m_maximumCachedFileSize;
+
+@synthesize pathToEntryMap = m_pathToEntryMap;
+
+@synthesize pendingReadsCondition = m_pendingReadsCondition;
+
+@synthesize pendingReadPaths = m_pendingReadPaths;
+
+@synthesize invalidatedPendingReadPaths = m_invalidatedPendingReadPaths;
+
+- (NSUInteger)cachedByteCount
+{
+    @synchronized(self) {
+        return m_cachedByteCount;
+    }
+}
+
+#pragma mark HLSFileManagerAbstract protocol implementation
+
+- (NSData *)contentsOfFileAtPath:(NSString *)path error:(NSError **)pError
+{
+    NSData *data = [self cachedDataForPath:path];
+    if (data) {
+        return data;
+    }
+    
+    if (! path) {
+        return [self.fileManager contentsOfFileAtPath:path error:pError];
+    }
+    
+    // Reserve the entry, so that concurrent misses for the same file wait for it to be cached instead of reading it
+    // as well. If the read fails or the file cannot be cached, waiting threads read the file themselves
+    NSString *standardizedPath = [path stringByStandardizingPath];
+    [self.pendingReadsCondition lock];
+    while ([self.pendingReadPaths containsObject:standardizedPath]) {
+        [self.pendingReadsCondition wait];
+    }
+    data = [self cachedDataForPath:path];
+    if (data) {
+        [self.pendingReadsCondition unlock];
+        return data;
+    }
+    [self.pendingReadPaths addObject:standardizedPath];
+    [self.pendingReadsCondition unlock];
+    
+    data = [self.fileManager contentsOfFileAtPath:path error:pError];
+    
+    // Do not cache data which has been invalidated while being read
+    [self.pendingReadsCondition lock];
+    if (data && ! [self.invalidatedPendingReadPaths containsObject:standardizedPath]) {
+        [self cacheData:data forPath:path];
+    }
+    [self.invalidatedPendingReadPaths removeObject:standardizedPath];
+    [self.pendingReadPaths removeObject:standardizedPath];
+    [self.pendingReadsCondition broadcast];
+    [self.pendingReadsCondition unlock];
+    
+    return data;
+}
+
+- (NSData *)contentsOfFileAtPath:(NSString *)path range:(NSRange)range error:(NSError **)pError
+{
+    // Same behavior as the standard file manager for ranges extending past the end of the file
+    NSData *data = [self cachedDataForPath:path];
+    if (! data && ! [self.fileManager respondsToSelector:@selector(contentsOfFileAtPath:range:error:)]) {
+        data = [self contentsOfFileAtPath:path error:pError];
+        if (! data) {
+            return nil;
+        }
+    }
+    
+    if (data) {
+        NSUInteger location = MIN(range.location, [data length]);
+        NSUInteger length = MIN(range.length, [data length] - location);
+        return [data subdataWithRange:NSMakeRange(location, length)];
+    }
+    else {
+        return [self.fileManager contentsOfFileAtPath:path range:range error:pError];
+    }
+}
+
+- (NSInputStream *)inputStreamForFileAtPath:(NSString *)path
+{
+    NSData *data = [self cachedDataForPath:path];
+    if (! data && ! [self.fileManager respondsToSelector:@selector(inputStreamForFileAtPath:)]) {
+        data = [self contentsOfFileAtPath:path error:NULL];
+        if (! data) {
+            return nil;
+        }
+    }
+    
+    if (data) {
+        return [NSInputStream inputStreamWithData:data];
+    }
+    else {
+        return [self.fileManager inputStreamForFileAtPath:path];
+    }
+}
+
+- (NSOutputStream *)outputStreamForFileAtPath:(NSString *)path append:(BOOL)append
+{
+    if (! [self.fileManager respondsToSelector:@selector(outputStreamForFileAtPath:append:)]) {
+        return nil;
+    }
+    
+    // The file cannot be cached again before it has been written (the stream is not opened yet)
+    [self invalidatePath:path];
+    return [self.fileManager outputStreamForFileAtPath:path append:append];
+}
+
+- (BOOL)createFileAtPath:(NSString *)path contents:(NSData *)contents error:(NSError **)pError
+{
+    [self invalidatePath:path];
+    if (! [self.fileManager createFileAtPath:path contents:contents error:pError]) {
+        return NO;
+    }
+    
+    // Write-through. Copy mutable data so that the cached contents cannot be altered afterwards
+    [self cacheData:[[contents copy] autorelease] forPath:path];
+    return YES;
+}
+
+- (BOOL)createDirectoryAtPath:(NSString *)path withIntermediateDirectories:(BOOL)withIntermediateDirectories error:(NSError **)pError
+{
+    return [self.fileManager createDirectoryAtPath:path withIntermediateDirectories:withIntermediateDirectories error:pError];
+}
+
+- (NSArray *)contentsOfDirectoryAtPath:(NSString *)path error:(NSError **)pError
+{
+    return [self.fileManager contentsOfDirectoryAtPath:path error:pError];
+}
+
+- (BOOL)enumerateContentsOfDirectoryAtPath:(NSString *)path
+                                usingBlock:(void (^)(HLSFileEntry *entry, BOOL *pStop))block
+                                     error:(NSError **)pError
+{
+    if ([self.fileManager respondsToSelector:@selector(enumerateContentsOfDirectoryAtPath:usingBlock:error:)]) {
+        return [self.fileManager enumerateContentsOfDirectoryAtPath:path usingBlock:block error:pError];
+    }
+    
+    NSArray *entries = [self.fileManager entriesOfDirectoryAtPath:path passingTest:nil error:pError];
+    if (! entries) {
+        return NO;
+    }
+    
+    BOOL stop = NO;
+    for (HLSFileEntry *entry in entries) {
+        block(entry, &stop);
+        if (stop) {
+            break;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)fileExistsAtPath:(NSString *)path isDirectory:(BOOL *)pIsDirectory
+{
+    return [self.fileManager fileExistsAtPath:path isDirectory:pIsDirectory];
+}
+
+- (BOOL)copyItemAtPath:(NSString *)sourcePath toPath:(NSString *)destinationPath error:(NSError **)pError
+{
+    BOOL copied = [self.fileManager copyItemAtPath:sourcePath toPath:destinationPath error:pError];
+    [self invalidatePath:destinationPath];
+    return copied;
+}
+
+- (BOOL)moveItemAtPath:(NSString *)sourcePath toPath:(NSString *)destinationPath error:(NSError **)pError
+{
+    BOOL moved = [self.fileManager moveItemAtPath:sourcePath toPath:destinationPath error:pError];
+    [self invalidatePath:sourcePath];
+    [self invalidatePath:destinationPath];
+    return moved;
+}
+
+- (BOOL)removeItemAtPath:(NSString *)path error:(NSError **)pError
+{
+    BOOL removed = [self.fileManager removeItemAtPath:path error:pError];
+    [self invalidatePath:path];
+    return removed;
+}
+
+- (BOOL)replaceItemAtPath:(NSString *)path withItemAtPath:(NSString *)replacementPath error:(NSError **)pError
+{
+    BOOL replaced = NO;
+    if ([self.fileManager respondsToSelector:@selector(replaceItemAtPath:withItemAtPath:error:)]) {
+        replaced = [self.fileManager replaceItemAtPath:path withItemAtPath:replacementPath error:pError];
+    }
+    else {
+        [self.fileManager removeItemAtPath:path error:NULL];
+        replaced = [self.fileManager moveItemAtPath:replacementPath toPath:path error:pError];
+    }
+    [self invalidatePath:path];
+    [self invalidatePath:replacementPath];
+    return replaced;
+}
+
+- (BOOL)synchronizeItemAtPath:(NSString *)path error:(NSError **)pError
+{
+    if (! [self.fileManager respondsToSelector:@selector(synchronizeItemAtPath:error:)]) {
+        return YES;
+    }
+    
+    return [self.fileManager synchronizeItemAtPath:path error:pError];
+}
+
+#pragma mark Cache management
+
+- (NSData *)cachedDataForPath:(NSString *)path
+{
+    if (! path) {
+        return nil;
+    }
+    
+    @synchronized(self) {
+        HLSCachingFileManagerEntry *entry = [self.pathToEntryMap objectForKey:[path stringByStandardizingPath]];
+        if (! entry) {
+            return nil;
+        }
+        
+        [self unlinkEntry:entry];
+        [self linkEntryAsMostRecentlyUsed:entry];
+        return [[entry.data retain] autorelease];
+    }
+}
+
+- (void)cacheData:(NSData *)data forPath:(NSString *)path
+{
+    if (! path || ! data) {
+        return;
+    }
+    
+    @synchronized(self) {
+        if ([data length] > m_maximumCachedFileSize || [data length] > m_capacity) {
+            return;
+        }
+        
+        NSString *standardizedPath = [path stringByStandardizingPath];
+        HLSCachingFileManagerEntry *previousEntry = [self.pathToEntryMap objectForKey:standardizedPath];
+        if (previousEntry) {
+            [self removeEntry:previousEntry];
+        }
+        
+        // Make room
+        while (m_leastRecentlyUsedEntry && m_cachedByteCount + [data length] > m_capacity) {
+            [self removeEntry:m_leastRecentlyUsedEntry];
+        }
+        
+        HLSCachingFileManagerEntry *entry = [[[HLSCachingFileManagerEntry alloc] initWithPath:standardizedPath data:data] autorelease];
+        [self.pathToEntryMap setObject:entry forKey:standardizedPath];
+        [self linkEntryAsMostRecentlyUsed:entry];
+        m_cachedByteCount += [data length];
+    }
+}
+
+// Invalidate the file at the given path, or all files within it if it is a directory
+- (void)invalidatePath:(NSString *)path
+{
+    if (! path) {
+        return;
+    }
+    
+    NSString *standardizedPath = [path stringByStandardizingPath];
+    NSString *directoryPrefix = [standardizedPath hasSuffix:@"/"] ? standardizedPath : [standardizedPath stringByAppendingString:@"/"];
+    
+    // Files being read must not be cached when their read ends. The pending reads lock is always acquired first
+    [self.pendingReadsCondition lock];
+    for (NSString *pendingReadPath in self.pendingReadPaths) {
+        if ([pendingReadPath isEqualToString:standardizedPath] || [pendingReadPath hasPrefix:directoryPrefix]) {
+            [self.invalidatedPendingReadPaths addObject:pendingReadPath];
+        }
+    }
+    
+    @synchronized(self) {
+        HLSCachingFileManagerEntry *entry = [self.pathToEntryMap objectForKey:standardizedPath];
+        if (entry) {
+            [self removeEntry:entry];
+        }
+        
+        for (NSString *cachedPath in [self.pathToEntryMap allKeys]) {
+            if ([cachedPath hasPrefix:directoryPrefix]) {
+                [self removeEntry:[self.pathToEntryMap objectForKey:cachedPath]];
+            }
+        }
+    }
+    [self.pendingReadsCondition unlock];
+}
+
+- (void)removeAllCachedFiles
+{
+    @synchronized(self) {
+        [self.pathToEntryMap removeAllObjects];
+        m_mostRecentlyUsedEntry = nil;
+        m_leastRecentlyUsedEntry = nil;
+        m_cachedByteCount = 0;
+    }
+}
+
+// The following methods must be called with the lock held
+
+- (void)unlinkEntry:(HLSCachingFileManagerEntry *)entry
+{
+    if (entry.previousEntry) {
+        entry.previousEntry.nextEntry = entry.nextEntry;
+    }
+    else {
+        m_mostRecentlyUsedEntry = entry.nextEntry;
+    }
+    
+    if (entry.nextEntry) {
+        entry.nextEntry.previousEntry = entry.previousEntry;
+    }
+    else {
+        m_leastRecentlyUsedEntry = entry.previousEntry;
+    }
+    
+    entry.previousEntry = nil;
+    entry.nextEntry = nil;
+}
+
+- (void)linkEntryAsMostRecentlyUsed:(HLSCachingFileManagerEntry *)entry
+{
+    entry.nextEntry = m_mostRecentlyUsedEntry;
+    m_mostRecentlyUsedEntry.previousEntry = entry;
+    m_mostRecentlyUsedEntry = entry;
+    if (! m_leastRecentlyUsedEntry) {
+        m_leastRecentlyUsedEntry = entry;
+    }
+}
+
+- (void)removeEntry:(HLSCachingFileManagerEntry *)entry
+{
+    // The map owns the entry and its path, which is used as key
+    [[entry retain] autorelease];
+    
+    [self unlinkEntry:entry];
+    m_cachedByteCount -= [entry.data length];
+    [self.pathToEntryMap removeObjectForKey:entry.path];
+}
+
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [self removeAllCachedFiles];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; fileManager: %@; capacity: %d; cachedByteCount: %d>",
+            [self class],
+            self,
+            self.fileManager,
+            self.capacity,
+            self.cachedByteCount];
+}
+
+@end
+
+@implementation HLSCachingFileManagerEntry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithPath:(NSString *)path data:(NSData *)data
+{
+    if ((self = [super init])) {
+        m_path = [path retain];
+        m_data = [data retain];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_path release];
+    m_path = nil;
+    
+    [m_data release];
+    m_data = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize path = m_path;
+
+@synthesize data = m_data;
+
+@synthesize previousEntry = m_previousEntry;
+
+@synthesize nextEntry = m_nextEntry;
+
+@end
@@ -15,9 +15,29 @@ NSString *HLSStringFromDeviceOrientation(UIDeviceOrientation deviceOrientation);
 NSString *HLSStringFromCATransform3D(CATransform3D transform);
 
 /**
- * Conversions to numbers
+ * Conversions to numbers. Return nil if the string cannot be converted
+ *
+ * HLSUnsignedIntNumberFromString parses strings made of ASCII digits directly, and returns nil if they do not fit 
+ * in an unsigned long long. Other strings are parsed using a decimal number formatter for the current locale
+ *
+ * The other functions only accept the following strings, without leading or trailing whitespace, and do not
+ * depend on the current locale:
+ *   - HLSIntegerNumberFromString: ASCII digits with an optional sign, fitting in a long long
+ *   - HLSDoubleNumberFromString: A decimal floating-point number with an optional sign and exponent (e.g. -1.5e3)
+ *   - HLSBoolNumberFromString: YES, NO, true, false, 1 or 0 (case-insensitive)
+ *
+ * Those functions work on the string characters and create no intermediate objects. They are therefore suited
+ * for parsing large amounts of data
  */
 NSNumber *HLSUnsignedIntNumberFromString(NSString *string);
+NSNumber *HLSIntegerNumberFromString(NSString *string);
+NSNumber *HLSDoubleNumberFromString(NSString *string);
+NSNumber *HLSBoolNumberFromString(NSString *string);
+
+/**
+ * Block converting a string into an object. Return nil if the string cannot be converted
+ */
+typedef id (^HLSStringConverterBlock)(NSString *string);
 
 /**
  * Conversions requiring several arguments. As methods since method signatures more explicit
@@ -47,4 +67,27 @@ NSNumber *HLSUnsignedIntNumberFromString(NSString *string);
                     ofDictionary:(NSMutableDictionary *)destDictionary
                usingFormatString:(NSString *)formatString;
 
+/**
+ * Converter blocks performing the same conversions as the methods above. Blocks are meant to be created once and 
+ * reused for a large number of conversions (the date converter block uses the formatters cached per thread by
+ * +[NSDateFormatter dateFormatterWithFormat:locale:timeZone:]). They can be called from any thread
+ */
++ (HLSStringConverterBlock)stringConverterBlock;
++ (HLSStringConverterBlock)unsignedIntConverterBlock;
++ (HLSStringConverterBlock)dateConverterBlockWithFormatString:(NSString *)formatString;
+
+/**
+ * Batch conversion, meant for model object hydration: For each index i, the string values of sourceDictionaries[i] 
+ * for the keys of keyToConverterBlockMap are converted using the associated converter blocks (HLSStringConverterBlock), 
+ * and the results are set for the same keys on destObjects[i]. Both arrays must have the same number of elements. 
+ * Destination objects can either be mutable dictionaries or objects with KVC-compliant properties. As for the methods 
+ * above, values which are missing or which cannot be converted are left untouched
+ *
+ * Setters are resolved once per destination object class and key, and object setters are then called directly, which 
+ * is much faster than calling the methods above for each object and key
+ */
++ (void)convertStringValuesOfDictionaries:(NSArray *)sourceDictionaries
+                              intoObjects:(NSArray *)destObjects
+              usingKeyToConverterBlockMap:(NSDictionary *)keyToConverterBlockMap;
+
 @end
@@ -8,8 +8,31 @@
 
 #import "HLSConverters.h"
 
+#import <objc/runtime.h>
+#import <xlocale.h>
 #import "HLSAssert.h"
 #import "HLSLogger.h"
+#import "NSDateFormatter+HLSExtensions.h"
+
+// A setter resolved for a destination object class and key. If implementation is NULL, the value is set using KVC
+typedef struct {
+    SEL selector;
+    IMP implementation;
+} HLSConverterSetter;
+
+// Maximum length of the strings parsed as doubles using a buffer on the stack
+#define kConverterDoubleBufferLength 64
+
+// Results of integer scanning
+typedef enum {
+    HLSConverterScanResultInvalid = 0,
+    HLSConverterScanResultOverflow,
+    HLSConverterScanResultSuccess
+} HLSConverterScanResult;
+
+// Static functions
+static HLSConverterScanResult HLSConverterScanInteger(NSString *string, BOOL signAllowed, BOOL *pNegative, unsigned long long *pMagnitude);
+static NSData *HLSConverterSettersForClass(Class class, NSArray *keys);
 
 NSString *HLSStringFromBool(BOOL yesOrNo)
 {
@@ -94,15 +117,134 @@ NSString *HLSStringFromCATransform3D(CATransform3D transform)
 
 NSNumber *HLSUnsignedIntNumberFromString(NSString *string)
 {
+    static NSString * const HLSConvertersNumberFormatterThreadLocalStorageKey = @"HLSConvertersNumberFormatterThreadLocalStorageKey";
+    
     if (! string) {
         return nil;
     }
     
-    NSNumberFormatter *formatter = [[[NSNumberFormatter alloc] init] autorelease];
-    [formatter setNumberStyle:NSNumberFormatterDecimalStyle];
+    // Fast path for plain digits. Numbers too large to fit are not left to the number formatter, which would silently
+    // return an approximate value
+    BOOL negative = NO;
+    unsigned long long magnitude = 0;
+    HLSConverterScanResult result = HLSConverterScanInteger(string, NO, &negative, &magnitude);
+    if (result == HLSConverterScanResultSuccess) {
+        return [NSNumber numberWithUnsignedLongLong:magnitude];
+    }
+    else if (result == HLSConverterScanResultOverflow) {
+        return nil;
+    }
+    
+    // Other strings (e.g. with grouping separators) are left to a number formatter. Formatters are not thread-safe, 
+    // we therefore keep one per thread
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSNumberFormatter *formatter = [threadDictionary objectForKey:HLSConvertersNumberFormatterThreadLocalStorageKey];
+    if (! formatter) {
+        formatter = [[[NSNumberFormatter alloc] init] autorelease];
+        [formatter setNumberStyle:NSNumberFormatterDecimalStyle];
+        [threadDictionary setObject:formatter forKey:HLSConvertersNumberFormatterThreadLocalStorageKey];
+    }
     return [formatter numberFromString:string];
 }
 
+NSNumber *HLSIntegerNumberFromString(NSString *string)
+{
+    if (! string) {
+        return nil;
+    }
+    
+    BOOL negative = NO;
+    unsigned long long magnitude = 0;
+    if (HLSConverterScanInteger(string, YES, &negative, &magnitude) != HLSConverterScanResultSuccess) {
+        return nil;
+    }
+    
+    if (negative) {
+        if (magnitude > (unsigned long long)LLONG_MAX + 1) {
+            return nil;
+        }
+        return [NSNumber numberWithLongLong:(long long)(0 - magnitude)];
+    }
+    else {
+        if (magnitude > LLONG_MAX) {
+            return nil;
+        }
+        return [NSNumber numberWithLongLong:(long long)magnitude];
+    }
+}
+
+NSNumber *HLSDoubleNumberFromString(NSString *string)
+{
+    if (! string) {
+        return nil;
+    }
+    
+    CFStringRef cfString = (CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    if (length == 0) {
+        return nil;
+    }
+    
+    // Only ASCII strings can be valid
+    char buffer[kConverterDoubleBufferLength];
+    const char *cString = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (! cString) {
+        if (length < kConverterDoubleBufferLength) {
+            if (! CFStringGetCString(cfString, buffer, kConverterDoubleBufferLength, kCFStringEncodingASCII)) {
+                return nil;
+            }
+            cString = buffer;
+        }
+        else {
+            cString = [string cStringUsingEncoding:NSASCIIStringEncoding];
+            if (! cString) {
+                return nil;
+            }
+        }
+    }
+    
+    // strtod also accepts leading whitespace, hexadecimal numbers, infinities and NaN, which we do not want
+    BOOL hasDigit = NO;
+    for (const char *character = cString; *character; ++character) {
+        if (*character >= '0' && *character <= '9') {
+            hasDigit = YES;
+        }
+        else if (! strchr("+-.eE", *character)) {
+            return nil;
+        }
+    }
+    if (! hasDigit) {
+        return nil;
+    }
+    
+    // Parse in the C locale, so that the decimal separator is always a dot
+    char *end = NULL;
+    double value = strtod_l(cString, &end, NULL);
+    if (end == cString || *end != '\0') {
+        return nil;
+    }
+    return [NSNumber numberWithDouble:value];
+}
+
+NSNumber *HLSBoolNumberFromString(NSString *string)
+{
+    if (! string) {
+        return nil;
+    }
+    
+    static const CFStringRef trueStrings[] = { CFSTR("YES"), CFSTR("true"), CFSTR("1") };
+    static const CFStringRef falseStrings[] = { CFSTR("NO"), CFSTR("false"), CFSTR("0") };
+    for (NSUInteger i = 0; i < sizeof(trueStrings) / sizeof(CFStringRef); ++i) {
+        if (CFStringCompare((CFStringRef)string, trueStrings[i], kCFCompareCaseInsensitive) == kCFCompareEqualTo) {
+            return [NSNumber numberWithBool:YES];
+        }
+        if (CFStringCompare((CFStringRef)string, falseStrings[i], kCFCompareCaseInsensitive) == kCFCompareEqualTo) {
+            return [NSNumber numberWithBool:NO];
+        }
+    }
+    return nil;
+}
+
 @implementation HLSConverters
 
 #pragma mark Class methods
@@ -113,9 +255,7 @@ NSNumber *HLSUnsignedIntNumberFromString(NSString *string)
         return nil;
     }
     
-    NSDateFormatter *formatter = [[[NSDateFormatter alloc] init] autorelease];
-    [formatter setFormatterBehavior:NSDateFormatterBehavior10_4];
-    [formatter setDateFormat:formatString];
+    NSDateFormatter *formatter = [NSDateFormatter dateFormatterWithFormat:formatString locale:nil timeZone:nil];
     return [formatter dateFromString:string];
 }
 
@@ -159,6 +299,96 @@ NSNumber *HLSUnsignedIntNumberFromString(NSString *string)
     }
 }
 
++ (HLSStringConverterBlock)stringConverterBlock
+{
+    return [[^id (NSString *string) {
+        return string;
+    } copy] autorelease];
+}
+
++ (HLSStringConverterBlock)unsignedIntConverterBlock
+{
+    return [[^id (NSString *string) {
+        return HLSUnsignedIntNumberFromString(string);
+    } copy] autorelease];
+}
+
++ (HLSStringConverterBlock)dateConverterBlockWithFormatString:(NSString *)formatString
+{
+    // The block can be called from any thread. Use the formatter cached for the calling thread, so that conversions
+    // on several threads do not have to be serialized
+    NSString *format = [[formatString copy] autorelease];
+    return [[^id (NSString *string) {
+        return [HLSConverters dateFromString:string usingFormatString:format];
+    } copy] autorelease];
+}
+
++ (void)convertStringValuesOfDictionaries:(NSArray *)sourceDictionaries
+                              intoObjects:(NSArray *)destObjects
+              usingKeyToConverterBlockMap:(NSDictionary *)keyToConverterBlockMap
+{
+    if ([sourceDictionaries count] != [destObjects count]) {
+        HLSLoggerError(@"The source dictionary and destination object arrays must have the same number of elements");
+        return;
+    }
+    
+    NSArray *keys = [keyToConverterBlockMap allKeys];
+    NSUInteger numberOfKeys = [keys count];
+    if (numberOfKeys == 0) {
+        return;
+    }
+    
+    HLSStringConverterBlock converterBlocks[numberOfKeys];
+    for (NSUInteger i = 0; i < numberOfKeys; ++i) {
+        converterBlocks[i] = [keyToConverterBlockMap objectForKey:[keys objectAtIndex:i]];
+    }
+    
+    // Setters are resolved once per class
+    NSMutableDictionary *classToSettersMap = [NSMutableDictionary dictionary];
+    
+    NSUInteger index = 0;
+    for (id destObject in destObjects) {
+        NSDictionary *sourceDictionary = [sourceDictionaries objectAtIndex:index];
+        ++index;
+        
+        BOOL isDictionary = [destObject isKindOfClass:[NSMutableDictionary class]];
+        const HLSConverterSetter *setters = NULL;
+        if (! isDictionary) {
+            Class class = [destObject class];
+            NSValue *classValue = [NSValue valueWithPointer:class];
+            NSData *settersData = [classToSettersMap objectForKey:classValue];
+            if (! settersData) {
+                settersData = HLSConverterSettersForClass(class, keys);
+                [classToSettersMap setObject:settersData forKey:classValue];
+            }
+            setters = [settersData bytes];
+        }
+        
+        for (NSUInteger i = 0; i < numberOfKeys; ++i) {
+            NSString *key = [keys objectAtIndex:i];
+            NSString *stringValue = [sourceDictionary objectForKey:key];
+            if (! [stringValue isKindOfClass:[NSString class]]) {
+                continue;
+            }
+            
+            id value = converterBlocks[i](stringValue);
+            if (! value) {
+                continue;
+            }
+            
+            if (isDictionary) {
+                [destObject setObject:value forKey:key];
+            }
+            else if (setters[i].implementation) {
+                ((void (*)(id, SEL, id))setters[i].implementation)(destObject, setters[i].selector, value);
+            }
+            else {
+                [destObject setValue:value forKey:key];
+            }
+        }
+    }
+}
+
 #pragma mark Object creation and destruction
 
 - (id)init
@@ -168,3 +398,81 @@ NSNumber *HLSUnsignedIntNumberFromString(NSString *string)
 }
 
 @end
+
+static HLSConverterScanResult HLSConverterScanInteger(NSString *string, BOOL signAllowed, BOOL *pNegative, unsigned long long *pMagnitude)
+{
+    CFStringRef cfString = (CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(cfString, &buffer, CFRangeMake(0, length));
+    
+    CFIndex i = 0;
+    BOOL negative = NO;
+    if (signAllowed && length != 0) {
+        UniChar character = CFStringGetCharacterFromInlineBuffer(&buffer, 0);
+        if (character == '-' || character == '+') {
+            negative = (character == '-');
+            ++i;
+        }
+    }
+    
+    if (i == length) {
+        return HLSConverterScanResultInvalid;
+    }
+    
+    unsigned long long magnitude = 0;
+    BOOL overflow = NO;
+    for (; i < length; ++i) {
+        UniChar character = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+        if (character < '0' || character > '9') {
+            return HLSConverterScanResultInvalid;
+        }
+        
+        unsigned int digit = character - '0';
+        if (magnitude > (ULLONG_MAX - digit) / 10) {
+            overflow = YES;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+    
+    if (overflow) {
+        return HLSConverterScanResultOverflow;
+    }
+    
+    if (pNegative) {
+        *pNegative = negative;
+    }
+    if (pMagnitude) {
+        *pMagnitude = magnitude;
+    }
+    return HLSConverterScanResultSuccess;
+}
+
+static NSData *HLSConverterSettersForClass(Class class, NSArray *keys)
+{
+    NSMutableData *settersData = [NSMutableData dataWithLength:[keys count] * sizeof(HLSConverterSetter)];
+    HLSConverterSetter *setters = [settersData mutableBytes];
+    
+    NSUInteger i = 0;
+    for (NSString *key in keys) {
+        if ([key length] != 0) {
+            NSString *setterName = [NSString stringWithFormat:@"set%@%@:", [[key substringToIndex:1] uppercaseString], 
+                                    [key substringFromIndex:1]];
+            SEL selector = NSSelectorFromString(setterName);
+            Method method = class_getInstanceMethod(class, selector);
+            
+            // Only object setters can be called directly. Other ones (e.g. for scalar properties) are left to KVC, which
+            // takes care of unboxing values
+            if (method) {
+                char *argumentType = method_copyArgumentType(method, 2);
+                if (argumentType && argumentType[0] == _C_ID) {
+                    setters[i].selector = selector;
+                    setters[i].implementation = method_getImplementation(method);
+                }
+                free(argumentType);
+            }
+        }
+        ++i;
+    }
+    return settersData;
+}
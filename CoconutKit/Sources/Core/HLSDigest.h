@@ -0,0 +1,76 @@
+//
+//  HLSDigest.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Digest algorithms
+ */
+typedef enum {
+    HLSDigestAlgorithmEnumBegin = 0,
+    HLSDigestAlgorithmMD2 = HLSDigestAlgorithmEnumBegin,
+    HLSDigestAlgorithmMD4,
+    HLSDigestAlgorithmMD5,
+    HLSDigestAlgorithmSHA1,
+    HLSDigestAlgorithmSHA224,
+    HLSDigestAlgorithmSHA256,
+    HLSDigestAlgorithmSHA384,
+    HLSDigestAlgorithmSHA512,
+    HLSDigestAlgorithmEnumEnd,
+    HLSDigestAlgorithmEnumSize = HLSDigestAlgorithmEnumEnd - HLSDigestAlgorithmEnumBegin
+} HLSDigestAlgorithm;
+
+/**
+ * Return the length (in bytes) of the digests calculated with the specified algorithm
+ */
+NSUInteger HLSDigestLength(HLSDigestAlgorithm algorithm);
+
+/**
+ * Calculate the digest of a buffer in a single pass. The md buffer must be at least HLSDigestLength(algorithm) bytes
+ * long
+ */
+void HLSDigestCalculate(HLSDigestAlgorithm algorithm, const void *bytes, NSUInteger length, unsigned char *md);
+
+/**
+ * Return the lowercase hexadecimal representation of a buffer
+ */
+NSString *HLSHexadecimalStringFromBytes(const void *bytes, NSUInteger length);
+
+/**
+ * An incremental digest, to which data can be fed in several chunks. This makes it possible to calculate the digest of
+ * large payloads (e.g. files, see HLSFileManager) using a constant amount of memory
+ *
+ * The digest is finalized when its value is first requested. No data can be added afterwards.
+ *
+ * Designated initializer: -initWithAlgorithm:
+ */
+@interface HLSDigest : NSObject {
+@private
+    HLSDigestAlgorithm m_algorithm;
+    void *m_context;
+    NSData *m_digest;
+}
+
+/**
+ * Create a digest using the specified algorithm
+ */
+- (id)initWithAlgorithm:(HLSDigestAlgorithm)algorithm;
+
+@property (nonatomic, readonly, assign) HLSDigestAlgorithm algorithm;
+
+/**
+ * Add data to the digest. Must not be called once the digest has been finalized
+ */
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length;
+- (void)updateWithData:(NSData *)data;
+
+/**
+ * Finalize the digest and return its value, either as raw bytes or as a lowercase hexadecimal string
+ */
+- (NSData *)digest;
+- (NSString *)hexDigest;
+
+@end
@@ -0,0 +1,189 @@
+//
+//  HLSDigest.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSDigest.h"
+
+#import <CommonCrypto/CommonDigest.h>
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+typedef struct {
+    size_t contextSize;
+    int (*init)(void *context);
+    int (*update)(void *context, const void *data, CC_LONG length);
+    int (*final)(unsigned char *md, void *context);
+    unsigned char *(*digest)(const void *data, CC_LONG length, unsigned char *md);
+    CC_LONG digestLength;
+} HLSDigestFunctions;
+
+// Indexed by HLSDigestAlgorithm values
+static const HLSDigestFunctions kDigestFunctions[] = {
+    {sizeof(CC_MD2_CTX), (void *)CC_MD2_Init, (void *)CC_MD2_Update, (void *)CC_MD2_Final, CC_MD2, CC_MD2_DIGEST_LENGTH},
+    {sizeof(CC_MD4_CTX), (void *)CC_MD4_Init, (void *)CC_MD4_Update, (void *)CC_MD4_Final, CC_MD4, CC_MD4_DIGEST_LENGTH},
+    {sizeof(CC_MD5_CTX), (void *)CC_MD5_Init, (void *)CC_MD5_Update, (void *)CC_MD5_Final, CC_MD5, CC_MD5_DIGEST_LENGTH},
+    {sizeof(CC_SHA1_CTX), (void *)CC_SHA1_Init, (void *)CC_SHA1_Update, (void *)CC_SHA1_Final, CC_SHA1, CC_SHA1_DIGEST_LENGTH},
+    {sizeof(CC_SHA256_CTX), (void *)CC_SHA224_Init, (void *)CC_SHA224_Update, (void *)CC_SHA224_Final, CC_SHA224, CC_SHA224_DIGEST_LENGTH},
+    {sizeof(CC_SHA256_CTX), (void *)CC_SHA256_Init, (void *)CC_SHA256_Update, (void *)CC_SHA256_Final, CC_SHA256, CC_SHA256_DIGEST_LENGTH},
+    {sizeof(CC_SHA512_CTX), (void *)CC_SHA384_Init, (void *)CC_SHA384_Update, (void *)CC_SHA384_Final, CC_SHA384, CC_SHA384_DIGEST_LENGTH},
+    {sizeof(CC_SHA512_CTX), (void *)CC_SHA512_Init, (void *)CC_SHA512_Update, (void *)CC_SHA512_Final, CC_SHA512, CC_SHA512_DIGEST_LENGTH}
+};
+
+// Lowercase hexadecimal digits, indexed by nibble value
+static const char kHexadecimalDigits[] = "0123456789abcdef";
+
+@interface HLSDigest ()
+
+@property (nonatomic, retain) NSData *digest;
+
+@end
+
+@implementation HLSDigest
+
+#pragma mark Object creation and destruction
+
+- (id)initWithAlgorithm:(HLSDigestAlgorithm)algorithm
+{
+    if ((self = [super init])) {
+        if (algorithm >= HLSDigestAlgorithmEnumEnd) {
+            HLSLoggerError(@"Unknown digest algorithm");
+            [self release];
+            return nil;
+        }
+        
+        m_algorithm = algorithm;
+        m_context = malloc(kDigestFunctions[algorithm].contextSize);
+        kDigestFunctions[algorithm].init(m_context);
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    free(m_context);
+    m_context = NULL;
+    self.digest = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize algorithm = m_algorithm;
+
+@synthesize digest = m_digest;
+
+- (NSData *)digest
+{
+    if (! m_digest) {
+        const HLSDigestFunctions *functions = &kDigestFunctions[m_algorithm];
+        unsigned char md[functions->digestLength];     // C99
+        functions->final(md, m_context);
+        self.digest = [NSData dataWithBytes:md length:sizeof(md)];
+    }
+    return m_digest;
+}
+
+- (NSString *)hexDigest
+{
+    NSData *digest = [self digest];
+    return HLSHexadecimalStringFromBytes([digest bytes], [digest length]);
+}
+
+#pragma mark Updating the digest
+
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length
+{
+    if (m_digest) {
+        HLSLoggerError(@"The digest has already been finalized");
+        return;
+    }
+    
+    // CC_LONG is a 32-bit integer
+    const uint8_t *currentBytes = bytes;
+    while (length != 0) {
+        CC_LONG chunkLength = (CC_LONG)MIN(length, (NSUInteger)UINT32_MAX);
+        kDigestFunctions[m_algorithm].update(m_context, currentBytes, chunkLength);
+        currentBytes += chunkLength;
+        length -= chunkLength;
+    }
+}
+
+- (void)updateWithData:(NSData *)data
+{
+    [self updateWithBytes:[data bytes] length:[data length]];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; algorithm: %d; finalized: %@>",
+            [self class],
+            self,
+            self.algorithm,
+            m_digest ? @"YES" : @"NO"];
+}
+
+@end
+
+#pragma mark Functions
+
+NSUInteger HLSDigestLength(HLSDigestAlgorithm algorithm)
+{
+    if (algorithm >= HLSDigestAlgorithmEnumEnd) {
+        HLSLoggerError(@"Unknown digest algorithm");
+        return 0;
+    }
+    
+    return kDigestFunctions[algorithm].digestLength;
+}
+
+void HLSDigestCalculate(HLSDigestAlgorithm algorithm, const void *bytes, NSUInteger length, unsigned char *md)
+{
+    if (algorithm >= HLSDigestAlgorithmEnumEnd) {
+        HLSLoggerError(@"Unknown digest algorithm");
+        return;
+    }
+    
+    // One-shot functions only accept 32-bit lengths
+    if (length <= UINT32_MAX) {
+        kDigestFunctions[algorithm].digest(bytes, (CC_LONG)length, md);
+    }
+    else {
+        HLSDigest *digest = [[HLSDigest alloc] initWithAlgorithm:algorithm];
+        [digest updateWithBytes:bytes length:length];
+        NSData *digestData = [digest digest];
+        memcpy(md, [digestData bytes], [digestData length]);
+        [digest release];
+    }
+}
+
+NSString *HLSHexadecimalStringFromBytes(const void *bytes, NSUInteger length)
+{
+    // Digests fit into the stack buffer, larger buffers are allocated on the heap
+    char stackCharacters[2 * CC_SHA512_DIGEST_LENGTH];
+    char *characters = (length <= CC_SHA512_DIGEST_LENGTH) ? stackCharacters : malloc(2 * length);
+    
+    const unsigned char *currentByte = bytes;
+    for (NSUInteger i = 0; i < length; ++i) {
+        characters[2 * i] = kHexadecimalDigits[currentByte[i] >> 4];
+        characters[2 * i + 1] = kHexadecimalDigits[currentByte[i] & 0x0F];
+    }
+    
+    NSString *string = [[[NSString alloc] initWithBytes:characters length:2 * length encoding:NSASCIIStringEncoding] autorelease];
+    if (characters != stackCharacters) {
+        free(characters);
+    }
+    return string;
+}
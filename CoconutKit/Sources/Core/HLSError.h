@@ -14,11 +14,22 @@
  * required, as explained in the documentation:
  *   http://developer.apple.com/library/ios/#documentation/Cocoa/Conceptual/ErrorHandlingCocoa/ErrorHandling/ErrorHandling.html
  *
+ * The information is stored as is, and the userInfo dictionary is only built when it is accessed. Errors which are
+ * created and discarded without their userInfo being read (e.g. during validation) are therefore cheap
+ *
  * Designated initializer: -initWithDomain:Code:
  */
 @interface HLSError : NSError {
 @private
-    NSDictionary *m_internalUserInfo;
+    NSString *m_localizedDescription;
+    NSString *m_localizedFailureReason;
+    NSString *m_localizedRecoverySuggestion;
+    NSArray *m_localizedRecoveryOptions;
+    id m_recoveryAttempter;
+    NSString *m_helpAnchor;
+    NSError *m_underlyingError;
+    NSMutableDictionary *m_customUserInfo;
+    NSDictionary *m_cachedUserInfo;
 }
 
 /**
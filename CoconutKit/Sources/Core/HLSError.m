@@ -10,15 +10,22 @@
 
 #import "HLSAssert.h"
 #import "HLSLogger.h"
-#import "NSDictionary+HLSExtensions.h"
-
-@interface HLSError ()
 
 /**
  * We do not use the NSError userInfo dictionary since it is set at NSError creation time and cannot be updated afterwards.
- * Instead, we use our own internal dictionary
+ * Instead, we store the information ourselves and build the dictionary when it is accessed
  */
-@property (nonatomic, retain) NSDictionary *internalUserInfo;
+@interface HLSError ()
+
+@property (nonatomic, retain) NSString *localizedDescriptionInternal;
+@property (nonatomic, retain) NSString *localizedFailureReasonInternal;
+@property (nonatomic, retain) NSString *localizedRecoverySuggestionInternal;
+@property (nonatomic, retain) NSArray *localizedRecoveryOptionsInternal;
+@property (nonatomic, retain) id recoveryAttempterInternal;
+@property (nonatomic, retain) NSString *helpAnchorInternal;
+@property (nonatomic, retain) NSError *underlyingErrorInternal;
+@property (nonatomic, retain) NSMutableDictionary *customUserInfoInternal;
+@property (nonatomic, retain) NSDictionary *cachedUserInfo;
 
 @end
 
@@ -42,63 +49,192 @@
 
 - (id)initWithDomain:(NSString *)domain code:(NSInteger)code
 {
-    if ((self = [super initWithDomain:domain code:code userInfo:nil /* not used */])) {
-        self.internalUserInfo = [NSDictionary dictionary];
-    }
-    return self;
+    return [super initWithDomain:domain code:code userInfo:nil /* not used */];
 }
 
 - (void)dealloc
 {
-    self.internalUserInfo = nil;
+    self.localizedDescriptionInternal = nil;
+    self.localizedFailureReasonInternal = nil;
+    self.localizedRecoverySuggestionInternal = nil;
+    self.localizedRecoveryOptionsInternal = nil;
+    self.recoveryAttempterInternal = nil;
+    self.helpAnchorInternal = nil;
+    self.underlyingErrorInternal = nil;
+    self.customUserInfoInternal = nil;
+    self.cachedUserInfo = nil;
     
     [super dealloc];
 }
 
 #pragma mark Accessors and mutators
 
-@synthesize internalUserInfo = m_internalUserInfo;
+@synthesize localizedDescriptionInternal = m_localizedDescription;
+
+@synthesize localizedFailureReasonInternal = m_localizedFailureReason;
+
+@synthesize localizedRecoverySuggestionInternal = m_localizedRecoverySuggestion;
+
+@synthesize localizedRecoveryOptionsInternal = m_localizedRecoveryOptions;
+
+@synthesize recoveryAttempterInternal = m_recoveryAttempter;
+
+@synthesize helpAnchorInternal = m_helpAnchor;
+
+@synthesize underlyingErrorInternal = m_underlyingError;
+
+@synthesize customUserInfoInternal = m_customUserInfo;
+
+@synthesize cachedUserInfo = m_cachedUserInfo;
 
 - (NSDictionary *)userInfo
 {
-    return self.internalUserInfo;
+    @synchronized(self) {
+        if (! self.cachedUserInfo) {
+            NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithDictionary:self.customUserInfoInternal];
+            if (self.localizedDescriptionInternal) {
+                [userInfo setObject:self.localizedDescriptionInternal forKey:NSLocalizedDescriptionKey];
+            }
+            if (self.localizedFailureReasonInternal) {
+                [userInfo setObject:self.localizedFailureReasonInternal forKey:NSLocalizedFailureReasonErrorKey];
+            }
+            if (self.localizedRecoverySuggestionInternal) {
+                [userInfo setObject:self.localizedRecoverySuggestionInternal forKey:NSLocalizedRecoverySuggestionErrorKey];
+            }
+            if (self.localizedRecoveryOptionsInternal) {
+                [userInfo setObject:self.localizedRecoveryOptionsInternal forKey:NSLocalizedRecoveryOptionsErrorKey];
+            }
+            if (self.recoveryAttempterInternal) {
+                [userInfo setObject:self.recoveryAttempterInternal forKey:NSRecoveryAttempterErrorKey];
+            }
+            if (self.helpAnchorInternal) {
+                [userInfo setObject:self.helpAnchorInternal forKey:NSHelpAnchorErrorKey];
+            }
+            if (self.underlyingErrorInternal) {
+                [userInfo setObject:self.underlyingErrorInternal forKey:NSUnderlyingErrorKey];
+            }
+            self.cachedUserInfo = [NSDictionary dictionaryWithDictionary:userInfo];
+        }
+        return [[self.cachedUserInfo retain] autorelease];
+    }
+}
+
+- (NSString *)localizedDescription
+{
+    // Let NSError generate a default description if none has been set
+    if (self.localizedDescriptionInternal) {
+        return self.localizedDescriptionInternal;
+    }
+    else {
+        return [super localizedDescription];
+    }
 }
 
 - (void)setLocalizedDescription:(NSString *)localizedDescription
 {
-    [self setObject:localizedDescription forKey:NSLocalizedDescriptionKey];
+    self.localizedDescriptionInternal = localizedDescription;
+    self.cachedUserInfo = nil;
+}
+
+- (NSString *)localizedFailureReason
+{
+    return self.localizedFailureReasonInternal;
 }
 
 - (void)setLocalizedFailureReason:(NSString *)localizedFailureReason
 {
-    [self setObject:localizedFailureReason forKey:NSLocalizedFailureReasonErrorKey];
+    self.localizedFailureReasonInternal = localizedFailureReason;
+    self.cachedUserInfo = nil;
+}
+
+- (NSString *)localizedRecoverySuggestion
+{
+    return self.localizedRecoverySuggestionInternal;
 }
 
 - (void)setLocalizedRecoverySuggestion:(NSString *)localizedRecoverySuggestion
 {
-    [self setObject:localizedRecoverySuggestion forKey:NSLocalizedRecoverySuggestionErrorKey];
+    self.localizedRecoverySuggestionInternal = localizedRecoverySuggestion;
+    self.cachedUserInfo = nil;
+}
+
+- (NSArray *)localizedRecoveryOptions
+{
+    return self.localizedRecoveryOptionsInternal;
 }
 
 - (void)setLocalizedRecoveryOptions:(NSArray *)localizedRecoveryOptions
 {
     HLSAssertObjectsInEnumerationAreKindOfClass(localizedRecoveryOptions, NSString);
     
-    [self setObject:localizedRecoveryOptions forKey:NSLocalizedRecoveryOptionsErrorKey];
+    self.localizedRecoveryOptionsInternal = localizedRecoveryOptions;
+    self.cachedUserInfo = nil;
+}
+
+- (id)recoveryAttempter
+{
+    return self.recoveryAttempterInternal;
 }
 
 - (void)setRecoveryAttempter:(id)recoveryAttempter
 {
-    [self setObject:recoveryAttempter forKey:NSRecoveryAttempterErrorKey];
+    self.recoveryAttempterInternal = recoveryAttempter;
+    self.cachedUserInfo = nil;
+}
+
+- (NSString *)helpAnchor
+{
+    return self.helpAnchorInternal;
 }
 
 - (void)setHelpAnchor:(NSString *)helpAnchor
 {
-    [self setObject:helpAnchor forKey:NSHelpAnchorErrorKey];
+    self.helpAnchorInternal = helpAnchor;
+    self.cachedUserInfo = nil;
+}
+
+- (NSError *)underlyingError
+{
+    return self.underlyingErrorInternal;
 }
 
 - (void)setUnderlyingError:(NSError *)underlyingError
 {
-    [self setObject:underlyingError forKey:NSUnderlyingErrorKey];
+    self.underlyingErrorInternal = underlyingError;
+    self.cachedUserInfo = nil;
+}
+
+- (id)objectForKey:(NSString *)key
+{
+    if (! key) {
+        HLSLoggerError(@"Missing key");
+        return nil;
+    }
+    
+    if ([key isEqualToString:NSLocalizedDescriptionKey]) {
+        return self.localizedDescriptionInternal;
+    }
+    else if ([key isEqualToString:NSLocalizedFailureReasonErrorKey]) {
+        return self.localizedFailureReasonInternal;
+    }
+    else if ([key isEqualToString:NSLocalizedRecoverySuggestionErrorKey]) {
+        return self.localizedRecoverySuggestionInternal;
+    }
+    else if ([key isEqualToString:NSLocalizedRecoveryOptionsErrorKey]) {
+        return self.localizedRecoveryOptionsInternal;
+    }
+    else if ([key isEqualToString:NSRecoveryAttempterErrorKey]) {
+        return self.recoveryAttempterInternal;
+    }
+    else if ([key isEqualToString:NSHelpAnchorErrorKey]) {
+        return self.helpAnchorInternal;
+    }
+    else if ([key isEqualToString:NSUnderlyingErrorKey]) {
+        return self.underlyingErrorInternal;
+    }
+    else {
+        return [self.customUserInfoInternal objectForKey:key];
+    }
 }
 
 - (void)setObject:(id)object forKey:(NSString *)key
@@ -108,21 +244,63 @@
         return;
     }
     
-    if (object) {
-        self.internalUserInfo = [self.internalUserInfo dictionaryBySettingObject:object forKey:key];
+    // Reserved keys are stored separately
+    if ([key isEqualToString:NSLocalizedDescriptionKey]) {
+        [self setLocalizedDescription:object];
+    }
+    else if ([key isEqualToString:NSLocalizedFailureReasonErrorKey]) {
+        [self setLocalizedFailureReason:object];
+    }
+    else if ([key isEqualToString:NSLocalizedRecoverySuggestionErrorKey]) {
+        [self setLocalizedRecoverySuggestion:object];
+    }
+    else if ([key isEqualToString:NSLocalizedRecoveryOptionsErrorKey]) {
+        [self setLocalizedRecoveryOptions:object];
+    }
+    else if ([key isEqualToString:NSRecoveryAttempterErrorKey]) {
+        [self setRecoveryAttempter:object];
+    }
+    else if ([key isEqualToString:NSHelpAnchorErrorKey]) {
+        [self setHelpAnchor:object];
+    }
+    else if ([key isEqualToString:NSUnderlyingErrorKey]) {
+        [self setUnderlyingError:object];
     }
     else {
-        self.internalUserInfo = [self.internalUserInfo dictionaryByRemovingObjectForKey:key];
+        if (object) {
+            if (! self.customUserInfoInternal) {
+                self.customUserInfoInternal = [NSMutableDictionary dictionary];
+            }
+            [self.customUserInfoInternal setObject:object forKey:key];
+        }
+        else {
+            [self.customUserInfoInternal removeObjectForKey:key];
+        }
+        self.cachedUserInfo = nil;
     }
 }
 
+- (NSDictionary *)customUserInfo
+{
+    return [NSDictionary dictionaryWithDictionary:self.customUserInfoInternal];
+}
+
 #pragma mark NSCopying protocol implementation
 
 - (id)copyWithZone:(NSZone *)zone
 {
-    // Unlike a conventional NSError, the userInfo dictionary is here mutable. A deep copy must therefore be made
-    HLSError *errorCopy = [super copyWithZone:zone];
-    errorCopy.internalUserInfo = [NSMutableDictionary dictionaryWithDictionary:self.internalUserInfo];
+    // Unlike a conventional NSError, the information is here mutable. A copy must therefore be made
+    HLSError *errorCopy = [[[self class] allocWithZone:zone] initWithDomain:[self domain] code:[self code]];
+    errorCopy.localizedDescriptionInternal = self.localizedDescriptionInternal;
+    errorCopy.localizedFailureReasonInternal = self.localizedFailureReasonInternal;
+    errorCopy.localizedRecoverySuggestionInternal = self.localizedRecoverySuggestionInternal;
+    errorCopy.localizedRecoveryOptionsInternal = self.localizedRecoveryOptionsInternal;
+    errorCopy.recoveryAttempterInternal = self.recoveryAttempterInternal;
+    errorCopy.helpAnchorInternal = self.helpAnchorInternal;
+    errorCopy.underlyingErrorInternal = self.underlyingErrorInternal;
+    if (self.customUserInfoInternal) {
+        errorCopy.customUserInfoInternal = [NSMutableDictionary dictionaryWithDictionary:self.customUserInfoInternal];
+    }
     return errorCopy;
 }
 
@@ -0,0 +1,40 @@
+//
+//  HLSFileEntry.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * An entry of a directory, as returned by HLSFileManager directory enumeration methods, with its main attributes
+ * (retrieved while enumerating the directory, so that no additional file system access is needed)
+ *
+ * This class is immutable and therefore thread-safe.
+ *
+ * Designated initializer: -initWithName:directory:size:modificationDate:
+ */
+@interface HLSFileEntry : NSObject {
+@private
+    NSString *m_name;
+    BOOL m_directory;
+    unsigned long long m_size;
+    NSDate *m_modificationDate;
+}
+
+- (id)initWithName:(NSString *)name directory:(BOOL)directory size:(unsigned long long)size modificationDate:(NSDate *)modificationDate;
+
+/**
+ * The entry name (last path component)
+ */
+@property (nonatomic, readonly, retain) NSString *name;
+
+@property (nonatomic, readonly, assign, getter=isDirectory) BOOL directory;
+
+/**
+ * The size in bytes (0 for directories), and the modification date (nil if not available)
+ */
+@property (nonatomic, readonly, assign) unsigned long long size;
+@property (nonatomic, readonly, retain) NSDate *modificationDate;
+
+@end
@@ -0,0 +1,68 @@
+//
+//  HLSFileEntry.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileEntry.h"
+
+#import "HLSAssert.h"
+
+@implementation HLSFileEntry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithName:(NSString *)name directory:(BOOL)directory size:(unsigned long long)size modificationDate:(NSDate *)modificationDate
+{
+    if ((self = [super init])) {
+        m_name = [name copy];
+        m_directory = directory;
+        m_size = directory ? 0 : size;
+        m_modificationDate = [modificationDate retain];
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    [m_name release];
+    m_name = nil;
+    
+    [m_modificationDate release];
+    m_modificationDate = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize name = m_name;
+
+@synthesize directory = m_directory;
+
+@synthesize size = m_size;
+
+@synthesize modificationDate = m_modificationDate;
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; name: %@; directory: %@; size: %llu; modificationDate: %@>",
+            [self class],
+            self,
+            self.name,
+            self.directory ? @"YES" : @"NO",
+            self.size,
+            self.modificationDate];
+}
+
+@end
@@ -6,6 +6,9 @@
 //  Copyright (c) 2012 Hortis. All rights reserved.
 //
 
+#import "HLSDigest.h"
+#import "HLSFileEntry.h"
+
 /**
  * Concrete subclasses of HLSFileManager must implement the set of methods declared by the following protocol
  */
@@ -17,6 +20,26 @@
  */
 - (NSData *)contentsOfFileAtPath:(NSString *)path error:(NSError **)pError;
 
+/**
+ * Return the bytes of the file at the given location within the specified range. If the range extends past the end of
+ * the file, only the available bytes are returned (an empty data object if the range starts past the end of the file).
+ * Only the requested bytes should be read
+ */
+- (NSData *)contentsOfFileAtPath:(NSString *)path range:(NSRange)range error:(NSError **)pError;
+
+/**
+ * Return an (unopened) stream to read the file at the given location, nil if the file cannot be read. Used to read
+ * large files in chunks (e.g. when calculating digests). If it is not implemented, -contentsOfFileAtPath:error: is
+ * used instead
+ */
+- (NSInputStream *)inputStreamForFileAtPath:(NSString *)path;
+
+/**
+ * Return an (unopened) stream to write the file at the given location, either from scratch or by appending data to
+ * an existing file. Return nil if the file cannot be written
+ */
+- (NSOutputStream *)outputStreamForFileAtPath:(NSString *)path append:(BOOL)append;
+
 /**
  * Create a file with the specified content at the given location
  *
@@ -37,6 +60,15 @@
  */
 - (NSArray *)contentsOfDirectoryAtPath:(NSString *)path error:(NSError **)pError;
 
+/**
+ * Enumerate the entries of the specified directory in a single pass, together with their attributes. Set *pStop to YES
+ * to stop the enumeration. Return YES iff the directory could be enumerated. Implementing this method is recommended,
+ * otherwise -entriesOfDirectoryAtPath:passingTest:error: needs one additional access per entry
+ */
+- (BOOL)enumerateContentsOfDirectoryAtPath:(NSString *)path
+                                usingBlock:(void (^)(HLSFileEntry *entry, BOOL *pStop))block
+                                     error:(NSError **)pError;
+
 /**
  * Return YES iff the file or folder exists at the specified path (and whether it is a directory or not; you can pass NULL if you do not
  * need this information)
@@ -64,8 +96,37 @@
  */
 - (BOOL)removeItemAtPath:(NSString *)path error:(NSError **)pError;
 
+/**
+ * Atomically replace the item at the specified path (if any) with the item at another path, which is removed. Both
+ * paths must be located within the same directory. Used to commit transactions (see HLSFileTransaction). If not
+ * implemented, the item is removed, then the new item moved, which is not atomic
+ *
+ * Return YES iff successful
+ */
+- (BOOL)replaceItemAtPath:(NSString *)path withItemAtPath:(NSString *)replacementPath error:(NSError **)pError;
+
+/**
+ * Flush the file or directory at the specified path to permanent storage. Used to commit transactions (see
+ * HLSFileTransaction). If not implemented, transactions are not explicitly flushed
+ *
+ * Return YES iff successful
+ */
+- (BOOL)synchronizeItemAtPath:(NSString *)path error:(NSError **)pError;
+
 @end
 
+/**
+ * Priorities of asynchronous file operations
+ */
+typedef enum {
+    HLSFileManagerPriorityEnumBegin = 0,
+    HLSFileManagerPriorityLow = HLSFileManagerPriorityEnumBegin,
+    HLSFileManagerPriorityNormal,
+    HLSFileManagerPriorityHigh,
+    HLSFileManagerPriorityEnumEnd,
+    HLSFileManagerPriorityEnumSize = HLSFileManagerPriorityEnumEnd - HLSFileManagerPriorityEnumBegin
+} HLSFileManagerPriority;
+
 /**
  * Abstract class for file operations. Subclass and implement methods from the HLSFileManagerAbstract protocol to create
  * your own concrete file management classes. Subclasses should be implemented in a thread-safe manner.
@@ -81,9 +142,24 @@
  * For all methods, paths represent locations relative to the managed storage, and should be given using the standard
  * notation /path/to/some/file.txt. The / at the beginning represents the storage root
  *
+ * All operations are also available asynchronously, so that callers (most notably the main thread) never block on disk
+ * I/O. Asynchronous operations are executed one at a time on a background serial queue owned by the file manager,
+ * highest priority first (FIFO for operations with the same priority). Operations involving the same path (or a path
+ * within the same directory hierarchy) are never reordered if one of them modifies it, whatever their priorities:
+ * Priorities only reorder operations on unrelated paths. Completion blocks are called on the main thread. Reads (file
+ * and directory contents) of the same path waiting to be executed are coalesced, i.e. performed once, all completion
+ * blocks receiving the same result. Reads are never coalesced across a pending operation modifying the same path
+ *
  * Designated initializer: -init
  */
-@interface HLSFileManager : NSObject <HLSFileManagerAbstract>
+@interface HLSFileManager : NSObject <HLSFileManagerAbstract> {
+@private
+    dispatch_queue_t m_queue;
+    NSArray *m_pendingRequestLists;                     // One mutable array per priority
+    NSMutableDictionary *m_coalescingKeyToRequestMap;
+    NSUInteger m_nbrCoalescedRequests;
+    NSUInteger m_nbrEnqueuedRequests;
+}
 
 /**
  * Set the default file manager. The previously installed one is returned
@@ -100,4 +176,62 @@
  */
 - (BOOL)fileExistsAtPath:(NSString *)path;
 
+/**
+ * Return the entries (HLSFileEntry objects) of the specified directory for which the predicate returns YES (all entries
+ * if the predicate is nil), nil on failure. Entries are retrieved in a single pass through the directory. If the file
+ * manager does not implement -enumerateContentsOfDirectoryAtPath:usingBlock:error:, only entry names and types are
+ * available
+ */
+- (NSArray *)entriesOfDirectoryAtPath:(NSString *)path passingTest:(BOOL (^)(HLSFileEntry *entry))predicate error:(NSError **)pError;
+
+/**
+ * Calculate the digest of the file at the specified path using the given algorithm. The file is read in fixed-size
+ * chunks, so that memory use does not depend on the file size. Return nil on failure
+ */
+- (HLSDigest *)digestOfFileAtPath:(NSString *)path algorithm:(HLSDigestAlgorithm)algorithm error:(NSError **)pError;
+
+/**
+ * Convenience methods returning the lowercase hexadecimal digest of a file (same format as the NSData+HLSExtensions
+ * hash methods), nil on failure
+ */
+- (NSString *)md5HashOfFileAtPath:(NSString *)path error:(NSError **)pError;
+- (NSString *)sha1HashOfFileAtPath:(NSString *)path error:(NSError **)pError;
+- (NSString *)sha256HashOfFileAtPath:(NSString *)path error:(NSError **)pError;
+
+/**
+ * Asynchronous versions of the HLSFileManagerAbstract methods (see class documentation). Completion blocks can be nil
+ */
+- (void)contentsOfFileAtPath:(NSString *)path
+                    priority:(HLSFileManagerPriority)priority
+             completionBlock:(void (^)(NSData *data, NSError *error))completionBlock;
+- (void)createFileAtPath:(NSString *)path
+                contents:(NSData *)contents
+                priority:(HLSFileManagerPriority)priority
+         completionBlock:(void (^)(BOOL success, NSError *error))completionBlock;
+- (void)createDirectoryAtPath:(NSString *)path
+  withIntermediateDirectories:(BOOL)withIntermediateDirectories
+                     priority:(HLSFileManagerPriority)priority
+              completionBlock:(void (^)(BOOL success, NSError *error))completionBlock;
+- (void)contentsOfDirectoryAtPath:(NSString *)path
+                         priority:(HLSFileManagerPriority)priority
+                  completionBlock:(void (^)(NSArray *contents, NSError *error))completionBlock;
+- (void)copyItemAtPath:(NSString *)sourcePath
+                toPath:(NSString *)destinationPath
+              priority:(HLSFileManagerPriority)priority
+       completionBlock:(void (^)(BOOL success, NSError *error))completionBlock;
+- (void)moveItemAtPath:(NSString *)sourcePath
+                toPath:(NSString *)destinationPath
+              priority:(HLSFileManagerPriority)priority
+       completionBlock:(void (^)(BOOL success, NSError *error))completionBlock;
+- (void)removeItemAtPath:(NSString *)path
+                priority:(HLSFileManagerPriority)priority
+         completionBlock:(void (^)(BOOL success, NSError *error))completionBlock;
+
+/**
+ * The number of asynchronous operations waiting to be executed, and the total number of read requests which have
+ * been coalesced with another one
+ */
+@property (readonly, assign) NSUInteger pendingRequestCount;
+@property (readonly, assign) NSUInteger coalescedRequestCount;
+
 @end
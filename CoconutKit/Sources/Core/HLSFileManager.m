@@ -8,11 +8,60 @@
 
 #import "HLSFileManager.h"
 
+#import "HLSLogger.h"
+
 // TODO: When available in CoconutKit (feature/url-connection branch), check protocol conformance (all methods from the
 //       abstract protocol must be implemented, though they have been made optional to avoid compilation warnings)
 
+static const NSUInteger kDigestChunkSize = 64 * 1024;
+
 static HLSFileManager *s_defaultManager = nil;
 
+typedef id (^HLSFileManagerWorkBlock)(NSError **pError);
+typedef void (^HLSFileManagerRequestCompletionBlock)(id result, NSError *error);
+
+// Static functions
+static BOOL HLSFileManagerPathsOverlap(NSArray *paths1, NSArray *paths2);
+
+/**
+ * Private class describing an asynchronous operation
+ */
+@interface HLSFileManagerRequest : NSObject {
+@private
+    NSArray *m_paths;
+    BOOL m_modifying;
+    NSString *m_coalescingKey;
+    NSUInteger m_sequenceNumber;
+    HLSFileManagerWorkBlock m_workBlock;
+    NSMutableArray *m_completionBlocks;
+}
+
+- (id)initWithPaths:(NSArray *)paths
+          modifying:(BOOL)modifying
+      coalescingKey:(NSString *)coalescingKey
+          workBlock:(HLSFileManagerWorkBlock)workBlock;
+
+@property (nonatomic, readonly, retain) NSArray *paths;                 // Paths involved
+@property (nonatomic, readonly, assign, getter=isModifying) BOOL modifying;
+@property (nonatomic, readonly, retain) NSString *coalescingKey;        // nil if the request cannot be coalesced
+@property (nonatomic, assign) NSUInteger sequenceNumber;                // Enqueuing order
+@property (nonatomic, readonly, copy) HLSFileManagerWorkBlock workBlock;
+@property (nonatomic, readonly, retain) NSMutableArray *completionBlocks;
+
+@end
+
+@interface HLSFileManager ()
+
+- (void)enqueueRequestWithPaths:(NSArray *)paths
+                      modifying:(BOOL)modifying
+                  coalescingKey:(NSString *)coalescingKey
+                       priority:(HLSFileManagerPriority)priority
+                      workBlock:(HLSFileManagerWorkBlock)workBlock
+                completionBlock:(HLSFileManagerRequestCompletionBlock)completionBlock;
+- (void)executeNextRequest;
+
+@end
+
 @implementation HLSFileManager
 
 #pragma mark Class methods
@@ -33,6 +82,37 @@ static HLSFileManager *s_defaultManager = nil;
     }
 }
 
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        m_queue = dispatch_queue_create("ch.hortis.CoconutKit.HLSFileManager", NULL);
+        
+        NSMutableArray *pendingRequestLists = [NSMutableArray array];
+        for (NSUInteger i = 0; i < HLSFileManagerPriorityEnumSize; ++i) {
+            [pendingRequestLists addObject:[NSMutableArray array]];
+        }
+        m_pendingRequestLists = [[NSArray alloc] initWithArray:pendingRequestLists];
+        m_coalescingKeyToRequestMap = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // Pending requests retain the file manager, the queue is therefore empty at this point
+    dispatch_release(m_queue);
+    
+    [m_pendingRequestLists release];
+    m_pendingRequestLists = nil;
+    
+    [m_coalescingKeyToRequestMap release];
+    m_coalescingKeyToRequestMap = nil;
+    
+    [super dealloc];
+}
+
 #pragma mark Convenience methods
 
 - (BOOL)fileExistsAtPath:(NSString *)path
@@ -40,4 +120,416 @@ static HLSFileManager *s_defaultManager = nil;
     return [self fileExistsAtPath:path isDirectory:NULL];
 }
 
+#pragma mark Directory entries
+
+- (NSArray *)entriesOfDirectoryAtPath:(NSString *)path passingTest:(BOOL (^)(HLSFileEntry *entry))predicate error:(NSError **)pError
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    
+    if ([self respondsToSelector:@selector(enumerateContentsOfDirectoryAtPath:usingBlock:error:)]) {
+        BOOL enumerated = [self enumerateContentsOfDirectoryAtPath:path usingBlock:^(HLSFileEntry *entry, BOOL *pStop) {
+            if (! predicate || predicate(entry)) {
+                [entries addObject:entry];
+            }
+        } error:pError];
+        return enumerated ? [NSArray arrayWithArray:entries] : nil;
+    }
+    
+    // Fallback: One additional access per entry to get its type
+    NSArray *names = [self contentsOfDirectoryAtPath:path error:pError];
+    if (! names) {
+        return nil;
+    }
+    
+    for (NSString *name in names) {
+        BOOL isDirectory = NO;
+        [self fileExistsAtPath:[path stringByAppendingPathComponent:name] isDirectory:&isDirectory];
+        HLSFileEntry *entry = [[[HLSFileEntry alloc] initWithName:name directory:isDirectory size:0 modificationDate:nil] autorelease];
+        if (! predicate || predicate(entry)) {
+            [entries addObject:entry];
+        }
+    }
+    return [NSArray arrayWithArray:entries];
+}
+
+#pragma mark Digests
+
+- (HLSDigest *)digestOfFileAtPath:(NSString *)path algorithm:(HLSDigestAlgorithm)algorithm error:(NSError **)pError
+{
+    HLSDigest *digest = [[[HLSDigest alloc] initWithAlgorithm:algorithm] autorelease];
+    if (! digest) {
+        return nil;
+    }
+    
+    // Fallback for file managers which do not provide streams. Large files should be mapped, in which case pages
+    // are read on demand and can be discarded as the digest progresses
+    if (! [self respondsToSelector:@selector(inputStreamForFileAtPath:)]) {
+        NSData *data = [self contentsOfFileAtPath:path error:pError];
+        if (! data) {
+            return nil;
+        }
+        
+        for (NSUInteger location = 0; location < [data length]; location += kDigestChunkSize) {
+            NSUInteger length = MIN(kDigestChunkSize, [data length] - location);
+            [digest updateWithBytes:(const uint8_t *)[data bytes] + location length:length];
+        }
+        [digest digest];
+        return digest;
+    }
+    
+    NSInputStream *inputStream = [self inputStreamForFileAtPath:path];
+    [inputStream open];
+    
+    NSInteger length = -1;
+    if (inputStream && [inputStream streamStatus] != NSStreamStatusError) {
+        uint8_t *buffer = malloc(kDigestChunkSize);
+        while ((length = [inputStream read:buffer maxLength:kDigestChunkSize]) > 0) {
+            [digest updateWithBytes:buffer length:length];
+        }
+        free(buffer);
+    }
+    
+    if (length < 0) {
+        if (pError) {
+            NSError *error = [inputStream streamError];
+            if (! error) {
+                error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                            code:NSFileReadUnknownError
+                                        userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+            }
+            *pError = error;
+        }
+        [inputStream close];
+        return nil;
+    }
+    
+    [inputStream close];
+    
+    [digest digest];
+    return digest;
+}
+
+- (NSString *)md5HashOfFileAtPath:(NSString *)path error:(NSError **)pError
+{
+    return [[self digestOfFileAtPath:path algorithm:HLSDigestAlgorithmMD5 error:pError] hexDigest];
+}
+
+- (NSString *)sha1HashOfFileAtPath:(NSString *)path error:(NSError **)pError
+{
+    return [[self digestOfFileAtPath:path algorithm:HLSDigestAlgorithmSHA1 error:pError] hexDigest];
+}
+
+- (NSString *)sha256HashOfFileAtPath:(NSString *)path error:(NSError **)pError
+{
+    return [[self digestOfFileAtPath:path algorithm:HLSDigestAlgorithmSHA256 error:pError] hexDigest];
+}
+
+#pragma mark Asynchronous operations
+
+- (void)contentsOfFileAtPath:(NSString *)path
+                    priority:(HLSFileManagerPriority)priority
+             completionBlock:(void (^)(NSData *data, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObject:path] modifying:NO coalescingKey:[@"contentsOfFile:" stringByAppendingString:path] priority:priority workBlock:^(NSError **pError) {
+        return (id)[self contentsOfFileAtPath:path error:pError];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock(result, error);
+        }
+    }];
+}
+
+- (void)createFileAtPath:(NSString *)path
+                contents:(NSData *)contents
+                priority:(HLSFileManagerPriority)priority
+         completionBlock:(void (^)(BOOL success, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObject:path] modifying:YES coalescingKey:nil priority:priority workBlock:^(NSError **pError) {
+        return (id)[NSNumber numberWithBool:[self createFileAtPath:path contents:contents error:pError]];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock([result boolValue], error);
+        }
+    }];
+}
+
+- (void)createDirectoryAtPath:(NSString *)path
+  withIntermediateDirectories:(BOOL)withIntermediateDirectories
+                     priority:(HLSFileManagerPriority)priority
+              completionBlock:(void (^)(BOOL success, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObject:path] modifying:YES coalescingKey:nil priority:priority workBlock:^(NSError **pError) {
+        return (id)[NSNumber numberWithBool:[self createDirectoryAtPath:path withIntermediateDirectories:withIntermediateDirectories error:pError]];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock([result boolValue], error);
+        }
+    }];
+}
+
+- (void)contentsOfDirectoryAtPath:(NSString *)path
+                         priority:(HLSFileManagerPriority)priority
+                  completionBlock:(void (^)(NSArray *contents, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObject:path] modifying:NO coalescingKey:[@"contentsOfDirectory:" stringByAppendingString:path] priority:priority workBlock:^(NSError **pError) {
+        return (id)[self contentsOfDirectoryAtPath:path error:pError];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock(result, error);
+        }
+    }];
+}
+
+- (void)copyItemAtPath:(NSString *)sourcePath
+                toPath:(NSString *)destinationPath
+              priority:(HLSFileManagerPriority)priority
+       completionBlock:(void (^)(BOOL success, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObjects:sourcePath, destinationPath, nil] modifying:YES coalescingKey:nil priority:priority workBlock:^(NSError **pError) {
+        return (id)[NSNumber numberWithBool:[self copyItemAtPath:sourcePath toPath:destinationPath error:pError]];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock([result boolValue], error);
+        }
+    }];
+}
+
+- (void)moveItemAtPath:(NSString *)sourcePath
+                toPath:(NSString *)destinationPath
+              priority:(HLSFileManagerPriority)priority
+       completionBlock:(void (^)(BOOL success, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObjects:sourcePath, destinationPath, nil] modifying:YES coalescingKey:nil priority:priority workBlock:^(NSError **pError) {
+        return (id)[NSNumber numberWithBool:[self moveItemAtPath:sourcePath toPath:destinationPath error:pError]];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock([result boolValue], error);
+        }
+    }];
+}
+
+- (void)removeItemAtPath:(NSString *)path
+                priority:(HLSFileManagerPriority)priority
+         completionBlock:(void (^)(BOOL success, NSError *error))completionBlock
+{
+    [self enqueueRequestWithPaths:[NSArray arrayWithObject:path] modifying:YES coalescingKey:nil priority:priority workBlock:^(NSError **pError) {
+        return (id)[NSNumber numberWithBool:[self removeItemAtPath:path error:pError]];
+    } completionBlock:^(id result, NSError *error) {
+        if (completionBlock) {
+            completionBlock([result boolValue], error);
+        }
+    }];
+}
+
+- (NSUInteger)pendingRequestCount
+{
+    @synchronized(m_pendingRequestLists) {
+        NSUInteger pendingRequestCount = 0;
+        for (NSArray *pendingRequests in m_pendingRequestLists) {
+            pendingRequestCount += [pendingRequests count];
+        }
+        return pendingRequestCount;
+    }
+}
+
+- (NSUInteger)coalescedRequestCount
+{
+    @synchronized(m_pendingRequestLists) {
+        return m_nbrCoalescedRequests;
+    }
+}
+
+- (void)enqueueRequestWithPaths:(NSArray *)paths
+                      modifying:(BOOL)modifying
+                  coalescingKey:(NSString *)coalescingKey
+                       priority:(HLSFileManagerPriority)priority
+                      workBlock:(HLSFileManagerWorkBlock)workBlock
+                completionBlock:(HLSFileManagerRequestCompletionBlock)completionBlock
+{
+    if (priority >= HLSFileManagerPriorityEnumEnd) {
+        HLSLoggerError(@"Invalid priority");
+        return;
+    }
+    
+    @synchronized(m_pendingRequestLists) {
+        if (coalescingKey) {
+            HLSFileManagerRequest *pendingRequest = [m_coalescingKeyToRequestMap objectForKey:coalescingKey];
+            if (pendingRequest) {
+                [pendingRequest.completionBlocks addObject:[[completionBlock copy] autorelease]];
+                ++m_nbrCoalescedRequests;
+                return;
+            }
+        }
+        
+        // Reads enqueued before a modification must not be coalesced with reads enqueued after it. Modifications also
+        // affect the parent directory contents, as well as all files within a directory
+        if (modifying) {
+            for (NSString *pendingCoalescingKey in [m_coalescingKeyToRequestMap allKeys]) {
+                HLSFileManagerRequest *pendingRequest = [m_coalescingKeyToRequestMap objectForKey:pendingCoalescingKey];
+                NSString *pendingPath = [pendingRequest.paths objectAtIndex:0];
+                for (NSString *path in paths) {
+                    if ([pendingPath isEqualToString:path]
+                            || [pendingPath isEqualToString:[path stringByDeletingLastPathComponent]]
+                            || [pendingPath hasPrefix:[path stringByAppendingString:@"/"]]) {
+                        [m_coalescingKeyToRequestMap removeObjectForKey:pendingCoalescingKey];
+                        break;
+                    }
+                }
+            }
+        }
+        
+        HLSFileManagerRequest *request = [[[HLSFileManagerRequest alloc] initWithPaths:paths
+                                                                              modifying:modifying
+                                                                          coalescingKey:coalescingKey
+                                                                              workBlock:workBlock] autorelease];
+        request.sequenceNumber = m_nbrEnqueuedRequests++;
+        [request.completionBlocks addObject:[[completionBlock copy] autorelease]];
+        [[m_pendingRequestLists objectAtIndex:priority] addObject:request];
+        if (coalescingKey) {
+            [m_coalescingKeyToRequestMap setObject:request forKey:coalescingKey];
+        }
+    }
+    
+    // One execution per request. The request executed is the one with highest priority at that time
+    dispatch_async(m_queue, ^{
+        [self executeNextRequest];
+    });
+}
+
+- (void)executeNextRequest
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    
+    HLSFileManagerRequest *request = nil;
+    @synchronized(m_pendingRequestLists) {
+        // Requests are only reordered by priority if they do not involve the same paths. A request must wait for all
+        // requests enqueued before it and conflicting with it. The oldest pending request can always be executed
+        for (NSMutableArray *pendingRequests in [m_pendingRequestLists reverseObjectEnumerator]) {
+            for (HLSFileManagerRequest *pendingRequest in pendingRequests) {
+                BOOL blocked = NO;
+                for (NSArray *otherPendingRequests in m_pendingRequestLists) {
+                    for (HLSFileManagerRequest *otherPendingRequest in otherPendingRequests) {
+                        // Within a list, requests are sorted by sequence number
+                        if (otherPendingRequest.sequenceNumber >= pendingRequest.sequenceNumber) {
+                            break;
+                        }
+                        
+                        if ((pendingRequest.modifying || otherPendingRequest.modifying)
+                                && HLSFileManagerPathsOverlap(pendingRequest.paths, otherPendingRequest.paths)) {
+                            blocked = YES;
+                            break;
+                        }
+                    }
+                    
+                    if (blocked) {
+                        break;
+                    }
+                }
+                
+                if (! blocked) {
+                    request = pendingRequest;
+                    break;
+                }
+            }
+            
+            if (request) {
+                [[request retain] autorelease];
+                [pendingRequests removeObjectIdenticalTo:request];
+                break;
+            }
+        }
+        
+        // No more coalescing once the request has started
+        if (request.coalescingKey && [m_coalescingKeyToRequestMap objectForKey:request.coalescingKey] == request) {
+            [m_coalescingKeyToRequestMap removeObjectForKey:request.coalescingKey];
+        }
+    }
+    
+    if (request) {
+        NSError *error = nil;
+        id result = request.workBlock(&error);
+        
+        // Requests cannot be coalesced anymore, the completion block list cannot change
+        for (HLSFileManagerRequestCompletionBlock completionBlock in request.completionBlocks) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completionBlock(result, error);
+            });
+        }
+    }
+    
+    [pool drain];
+}
+
 @end
+
+@implementation HLSFileManagerRequest
+
+#pragma mark Object creation and destruction
+
+- (id)initWithPaths:(NSArray *)paths
+          modifying:(BOOL)modifying
+      coalescingKey:(NSString *)coalescingKey
+          workBlock:(HLSFileManagerWorkBlock)workBlock
+{
+    if ((self = [super init])) {
+        m_paths = [paths retain];
+        m_modifying = modifying;
+        m_coalescingKey = [coalescingKey retain];
+        m_workBlock = [workBlock copy];
+        m_completionBlocks = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_paths release];
+    m_paths = nil;
+    
+    [m_coalescingKey release];
+    m_coalescingKey = nil;
+    
+    [m_workBlock release];
+    m_workBlock = nil;
+    
+    [m_completionBlocks release];
+    m_completionBlocks = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize paths = m_paths;
+
+@synthesize modifying = m_modifying;
+
+@synthesize coalescingKey = m_coalescingKey;
+
+@synthesize sequenceNumber = m_sequenceNumber;
+
+@synthesize workBlock = m_workBlock;
+
+@synthesize completionBlocks = m_completionBlocks;
+
+@end
+
+#pragma mark Static functions
+
+// Return YES iff some path of the first list is identical to, contained in, or the parent directory of some path of
+// the second list (modifications also affect the parent directory contents)
+static BOOL HLSFileManagerPathsOverlap(NSArray *paths1, NSArray *paths2)
+{
+    for (NSString *path1 in paths1) {
+        for (NSString *path2 in paths2) {
+            if ([path1 isEqualToString:path2]
+                    || [path1 isEqualToString:[path2 stringByDeletingLastPathComponent]]
+                    || [path2 isEqualToString:[path1 stringByDeletingLastPathComponent]]
+                    || [path1 hasPrefix:[path2 stringByAppendingString:@"/"]]
+                    || [path2 hasPrefix:[path1 stringByAppendingString:@"/"]]) {
+                return YES;
+            }
+        }
+    }
+    return NO;
+}
@@ -0,0 +1,66 @@
+//
+//  HLSFileTransaction.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileManager.h"
+
+/**
+ * A transaction groups writes and removals of related files (e.g. a manifest and its assets), so that they are applied
+ * together when the transaction is committed.
+ *
+ * Written files are staged right away next to their final location (as hidden temporary files), so that committing
+ * the transaction mostly consists of atomic renames. When committing, all staged files are flushed to permanent
+ * storage, then renamed, then removals are performed, and finally each affected directory is flushed once. This
+ * guarantees that a file is never partially written, and avoids one expensive synchronization per file. Remark that
+ * if a rename fails during a commit, changes already applied are kept (the commit stops and reports the error), and
+ * remaining staged files are discarded.
+ *
+ * A transaction which is deallocated without having been committed is rolled back.
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -initWithFileManager:
+ */
+@interface HLSFileTransaction : NSObject {
+@private
+    HLSFileManager *m_fileManager;
+    NSString *m_identifier;
+    NSMutableArray *m_writtenPaths;
+    NSMutableDictionary *m_pathToStagedPathMap;
+    NSMutableArray *m_removedPaths;
+    BOOL m_finished;
+}
+
+/**
+ * Create a transaction applying changes using the specified file manager
+ */
+- (id)initWithFileManager:(HLSFileManager *)fileManager;
+
+@property (nonatomic, readonly, retain) HLSFileManager *fileManager;
+
+/**
+ * Stage a file to be written at the specified path when the transaction is committed. The parent directory must exist.
+ * Return YES iff the file could be staged
+ */
+- (BOOL)writeData:(NSData *)data toPath:(NSString *)path error:(NSError **)pError;
+
+/**
+ * Remove the item at the specified path when the transaction is committed (does nothing if there is none by then)
+ */
+- (void)removeItemAtPath:(NSString *)path;
+
+/**
+ * Apply all changes. Return YES iff successful. A transaction can only be committed or rolled back once
+ */
+- (BOOL)commit:(NSError **)pError;
+
+/**
+ * Discard all changes
+ */
+- (void)rollback;
+
+@end
@@ -0,0 +1,241 @@
+//
+//  HLSFileTransaction.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSFileTransaction.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+@interface HLSFileTransaction ()
+
+@property (nonatomic, retain) HLSFileManager *fileManager;
+@property (nonatomic, retain) NSString *identifier;
+
+- (NSString *)stagedPathForPath:(NSString *)path;
+- (void)discardStagedFiles;
+
+@end
+
+@implementation HLSFileTransaction
+
+#pragma mark Object creation and destruction
+
+- (id)initWithFileManager:(HLSFileManager *)fileManager
+{
+    if ((self = [super init])) {
+        if (! fileManager) {
+            HLSLoggerError(@"A file manager is mandatory");
+            [self release];
+            return nil;
+        }
+        
+        self.fileManager = fileManager;
+        
+        CFUUIDRef uuid = CFUUIDCreate(kCFAllocatorDefault);
+        self.identifier = [(NSString *)CFUUIDCreateString(kCFAllocatorDefault, uuid) autorelease];
+        CFRelease(uuid);
+        
+        m_writtenPaths = [[NSMutableArray alloc] init];
+        m_pathToStagedPathMap = [[NSMutableDictionary alloc] init];
+        m_removedPaths = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    if (! m_finished) {
+        [self rollback];
+    }
+    
+    self.fileManager = nil;
+    self.identifier = nil;
+    
+    [m_writtenPaths release];
+    m_writtenPaths = nil;
+    
+    [m_pathToStagedPathMap release];
+    m_pathToStagedPathMap = nil;
+    
+    [m_removedPaths release];
+    m_removedPaths = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize fileManager = m_fileManager;
+
+@synthesize identifier = m_identifier;
+
+#pragma mark Staging changes
+
+// Staged files are located in the same directory as their final location, so that they can be atomically renamed
+- (NSString *)stagedPathForPath:(NSString *)path
+{
+    NSString *stagedFileName = [NSString stringWithFormat:@".%@.%@.tmp", [path lastPathComponent], self.identifier];
+    return [[path stringByDeletingLastPathComponent] stringByAppendingPathComponent:stagedFileName];
+}
+
+- (BOOL)writeData:(NSData *)data toPath:(NSString *)path error:(NSError **)pError
+{
+    if (m_finished) {
+        HLSLoggerError(@"The transaction has already been committed or rolled back");
+        return NO;
+    }
+    
+    NSString *stagedPath = [self stagedPathForPath:path];
+    if (! [self.fileManager createFileAtPath:stagedPath contents:data error:pError]) {
+        return NO;
+    }
+    
+    // The last write to a path wins
+    if (! [m_pathToStagedPathMap objectForKey:path]) {
+        [m_writtenPaths addObject:path];
+    }
+    [m_pathToStagedPathMap setObject:stagedPath forKey:path];
+    
+    // A write cancels a previous removal
+    [m_removedPaths removeObject:path];
+    return YES;
+}
+
+- (void)removeItemAtPath:(NSString *)path
+{
+    if (m_finished) {
+        HLSLoggerError(@"The transaction has already been committed or rolled back");
+        return;
+    }
+    
+    // A removal cancels a previous write
+    NSString *stagedPath = [m_pathToStagedPathMap objectForKey:path];
+    if (stagedPath) {
+        [self.fileManager removeItemAtPath:stagedPath error:NULL];
+        [m_pathToStagedPathMap removeObjectForKey:path];
+        [m_writtenPaths removeObject:path];
+    }
+    
+    if (! [m_removedPaths containsObject:path]) {
+        [m_removedPaths addObject:path];
+    }
+}
+
+#pragma mark Committing or rolling back
+
+- (BOOL)commit:(NSError **)pError
+{
+    if (m_finished) {
+        HLSLoggerError(@"The transaction has already been committed or rolled back");
+        return NO;
+    }
+    m_finished = YES;
+    
+    BOOL synchronizing = [self.fileManager respondsToSelector:@selector(synchronizeItemAtPath:error:)];
+    BOOL replacing = [self.fileManager respondsToSelector:@selector(replaceItemAtPath:withItemAtPath:error:)];
+    
+    // Staged contents must be on permanent storage before they become visible
+    if (synchronizing) {
+        for (NSString *path in m_writtenPaths) {
+            if (! [self.fileManager synchronizeItemAtPath:[m_pathToStagedPathMap objectForKey:path] error:pError]) {
+                [self discardStagedFiles];
+                return NO;
+            }
+        }
+    }
+    
+    NSMutableSet *directoryPaths = [NSMutableSet set];
+    while ([m_writtenPaths count] != 0) {
+        NSString *path = [m_writtenPaths objectAtIndex:0];
+        NSString *stagedPath = [m_pathToStagedPathMap objectForKey:path];
+        
+        BOOL replaced = NO;
+        if (replacing) {
+            replaced = [self.fileManager replaceItemAtPath:path withItemAtPath:stagedPath error:pError];
+        }
+        else {
+            if ([self.fileManager fileExistsAtPath:path]) {
+                [self.fileManager removeItemAtPath:path error:NULL];
+            }
+            replaced = [self.fileManager moveItemAtPath:stagedPath toPath:path error:pError];
+        }
+        
+        if (! replaced) {
+            [self discardStagedFiles];
+            return NO;
+        }
+        
+        [directoryPaths addObject:[path stringByDeletingLastPathComponent]];
+        [m_pathToStagedPathMap removeObjectForKey:path];
+        [m_writtenPaths removeObjectAtIndex:0];
+    }
+    
+    for (NSString *path in m_removedPaths) {
+        if (! [self.fileManager fileExistsAtPath:path]) {
+            continue;
+        }
+        
+        if (! [self.fileManager removeItemAtPath:path error:pError]) {
+            return NO;
+        }
+        [directoryPaths addObject:[path stringByDeletingLastPathComponent]];
+    }
+    [m_removedPaths removeAllObjects];
+    
+    // One synchronization per affected directory, so that renames and removals are on permanent storage
+    if (synchronizing) {
+        for (NSString *directoryPath in directoryPaths) {
+            if (! [self.fileManager synchronizeItemAtPath:directoryPath error:pError]) {
+                return NO;
+            }
+        }
+    }
+    
+    return YES;
+}
+
+- (void)rollback
+{
+    if (m_finished) {
+        HLSLoggerError(@"The transaction has already been committed or rolled back");
+        return;
+    }
+    m_finished = YES;
+    
+    [self discardStagedFiles];
+    [m_removedPaths removeAllObjects];
+}
+
+- (void)discardStagedFiles
+{
+    for (NSString *stagedPath in [m_pathToStagedPathMap allValues]) {
+        [self.fileManager removeItemAtPath:stagedPath error:NULL];
+    }
+    [m_pathToStagedPathMap removeAllObjects];
+    [m_writtenPaths removeAllObjects];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; fileManager: %@; writtenPaths: %@; removedPaths: %@>",
+            [self class],
+            self,
+            self.fileManager,
+            m_writtenPaths,
+            m_removedPaths];
+}
+
+@end
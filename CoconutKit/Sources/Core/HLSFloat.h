@@ -55,3 +55,20 @@ float floatmin_dist(float x, float y, uint32_t maxDist);
 float floatmax_dist(float x, float y, uint32_t maxDist);
 double doublemin_dist(double x, double y, uint64_t maxDist);
 double doublemax_dist(double x, double y, uint64_t maxDist);
+
+/**
+ * Batch versions of the above functions, applied to count pairs of values (x[i], y[i]) and storing the result into
+ * results[i]. The results are identical to those of the corresponding functions applied to each pair, but are
+ * computed several values at a time using NEON instructions when available (float functions on all ARM devices, 
+ * double functions on 64-bit ARM devices only)
+ *
+ * Input and result buffers must not overlap, except that results can be the same buffer as x or y for the min / max
+ * functions
+ */
+void floateq_dist_batch(const float *x, const float *y, BOOL *results, size_t count, uint32_t maxDist);
+void doubleeq_dist_batch(const double *x, const double *y, BOOL *results, size_t count, uint64_t maxDist);
+
+void floatmin_dist_batch(const float *x, const float *y, float *results, size_t count, uint32_t maxDist);
+void floatmax_dist_batch(const float *x, const float *y, float *results, size_t count, uint32_t maxDist);
+void doublemin_dist_batch(const double *x, const double *y, double *results, size_t count, uint64_t maxDist);
+void doublemax_dist_batch(const double *x, const double *y, double *results, size_t count, uint64_t maxDist);
@@ -10,6 +10,15 @@
 
 #import "HLSAssert.h"
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#import <arm_neon.h>
+#define HLS_FLOAT_NEON
+#endif
+
+#if defined(HLS_FLOAT_NEON) && defined(__aarch64__)
+#define HLS_DOUBLE_NEON
+#endif
+
 /**
  * For a discussion of float comparison functions, see
  *   http://www.cygnus-software.com/papers/comparingfloats/comparingfloats.htm
@@ -48,7 +57,7 @@ BOOL doubleeq_dist(double x, double y, uint64_t maxDist)
     int64_t i_y = *(int64_t *)&y;
     i_y = (i_y < 0) ? 0x8000000000000000LL - i_y : i_y;
     
-    uint64_t dist = (i_x - i_y) ? i_x - i_y : i_y - i_x;
+    uint64_t dist = (i_x > i_y) ? i_x - i_y : i_y - i_x;
     return(dist <= maxDist);
 }
 
@@ -71,3 +80,157 @@ double doublemax_dist(double x, double y, uint64_t maxDist)
 {
     return doublelt_dist(x, y, maxDist) ? y : x;
 }
+
+#ifdef HLS_FLOAT_NEON
+
+/**
+ * Return a mask whose lanes are all ones when the corresponding float values are equal within maxDist. Same 
+ * computation as floateq_dist
+ */
+static inline uint32x4_t floateq_dist_neon(float32x4_t x, float32x4_t y, uint32x4_t maxDist)
+{
+    int32x4_t signBit = vdupq_n_s32((int32_t)0x80000000);
+    
+    int32x4_t i_x = vreinterpretq_s32_f32(x);
+    i_x = vbslq_s32(vcltq_s32(i_x, vdupq_n_s32(0)), vsubq_s32(signBit, i_x), i_x);
+    
+    int32x4_t i_y = vreinterpretq_s32_f32(y);
+    i_y = vbslq_s32(vcltq_s32(i_y, vdupq_n_s32(0)), vsubq_s32(signBit, i_y), i_y);
+    
+    uint32x4_t dist = vreinterpretq_u32_s32(vabdq_s32(i_x, i_y));
+    return vcleq_u32(dist, maxDist);
+}
+
+/**
+ * Return a mask whose lanes are all ones when floatlt_dist is true for the corresponding values
+ */
+static inline uint32x4_t floatlt_dist_neon(float32x4_t x, float32x4_t y, uint32x4_t maxDist)
+{
+    return vmvnq_u32(vorrq_u32(vcgtq_f32(x, y), floateq_dist_neon(x, y, maxDist)));
+}
+
+#endif
+
+#ifdef HLS_DOUBLE_NEON
+
+static inline uint64x2_t doubleeq_dist_neon(float64x2_t x, float64x2_t y, uint64x2_t maxDist)
+{
+    int64x2_t signBit = vdupq_n_s64((int64_t)0x8000000000000000ULL);
+    
+    int64x2_t i_x = vreinterpretq_s64_f64(x);
+    i_x = vbslq_s64(vcltzq_s64(i_x), vsubq_s64(signBit, i_x), i_x);
+    
+    int64x2_t i_y = vreinterpretq_s64_f64(y);
+    i_y = vbslq_s64(vcltzq_s64(i_y), vsubq_s64(signBit, i_y), i_y);
+    
+    // No absolute difference instruction for 64-bit lanes
+    uint64x2_t dist = vreinterpretq_u64_s64(vbslq_s64(vcgtq_s64(i_x, i_y), vsubq_s64(i_x, i_y), vsubq_s64(i_y, i_x)));
+    return vcleq_u64(dist, maxDist);
+}
+
+static inline uint64x2_t doublelt_dist_neon(float64x2_t x, float64x2_t y, uint64x2_t maxDist)
+{
+    uint64x2_t mask = vorrq_u64(vcgtq_f64(x, y), doubleeq_dist_neon(x, y, maxDist));
+    return veorq_u64(mask, vdupq_n_u64(UINT64_MAX));
+}
+
+#endif
+
+void floateq_dist_batch(const float *x, const float *y, BOOL *results, size_t count, uint32_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_FLOAT_NEON
+    uint32x4_t maxDistVector = vdupq_n_u32(maxDist);
+    for (; i + 8 <= count; i += 8) {
+        uint32x4_t mask1 = floateq_dist_neon(vld1q_f32(x + i), vld1q_f32(y + i), maxDistVector);
+        uint32x4_t mask2 = floateq_dist_neon(vld1q_f32(x + i + 4), vld1q_f32(y + i + 4), maxDistVector);
+        
+        // Narrow the masks to one byte per result, and turn them into YES / NO values
+        uint8x8_t mask = vmovn_u16(vcombine_u16(vmovn_u32(mask1), vmovn_u32(mask2)));
+        vst1_u8((uint8_t *)(results + i), vand_u8(mask, vdup_n_u8(1)));
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = floateq_dist(x[i], y[i], maxDist);
+    }
+}
+
+void doubleeq_dist_batch(const double *x, const double *y, BOOL *results, size_t count, uint64_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_DOUBLE_NEON
+    uint64x2_t maxDistVector = vdupq_n_u64(maxDist);
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t mask = doubleeq_dist_neon(vld1q_f64(x + i), vld1q_f64(y + i), maxDistVector);
+        results[i] = vgetq_lane_u64(mask, 0) ? YES : NO;
+        results[i + 1] = vgetq_lane_u64(mask, 1) ? YES : NO;
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = doubleeq_dist(x[i], y[i], maxDist);
+    }
+}
+
+void floatmin_dist_batch(const float *x, const float *y, float *results, size_t count, uint32_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_FLOAT_NEON
+    uint32x4_t maxDistVector = vdupq_n_u32(maxDist);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t xVector = vld1q_f32(x + i);
+        float32x4_t yVector = vld1q_f32(y + i);
+        vst1q_f32(results + i, vbslq_f32(floatlt_dist_neon(xVector, yVector, maxDistVector), xVector, yVector));
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = floatmin_dist(x[i], y[i], maxDist);
+    }
+}
+
+void floatmax_dist_batch(const float *x, const float *y, float *results, size_t count, uint32_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_FLOAT_NEON
+    uint32x4_t maxDistVector = vdupq_n_u32(maxDist);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t xVector = vld1q_f32(x + i);
+        float32x4_t yVector = vld1q_f32(y + i);
+        vst1q_f32(results + i, vbslq_f32(floatlt_dist_neon(xVector, yVector, maxDistVector), yVector, xVector));
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = floatmax_dist(x[i], y[i], maxDist);
+    }
+}
+
+void doublemin_dist_batch(const double *x, const double *y, double *results, size_t count, uint64_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_DOUBLE_NEON
+    uint64x2_t maxDistVector = vdupq_n_u64(maxDist);
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t xVector = vld1q_f64(x + i);
+        float64x2_t yVector = vld1q_f64(y + i);
+        vst1q_f64(results + i, vbslq_f64(doublelt_dist_neon(xVector, yVector, maxDistVector), xVector, yVector));
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = doublemin_dist(x[i], y[i], maxDist);
+    }
+}
+
+void doublemax_dist_batch(const double *x, const double *y, double *results, size_t count, uint64_t maxDist)
+{
+    size_t i = 0;
+#ifdef HLS_DOUBLE_NEON
+    uint64x2_t maxDistVector = vdupq_n_u64(maxDist);
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t xVector = vld1q_f64(x + i);
+        float64x2_t yVector = vld1q_f64(y + i);
+        vst1q_f64(results + i, vbslq_f64(doublelt_dist_neon(xVector, yVector, maxDistVector), yVector, xVector));
+    }
+#endif
+    for (; i < count; ++i) {
+        results[i] = doublemax_dist(x[i], y[i], maxDist);
+    }
+}
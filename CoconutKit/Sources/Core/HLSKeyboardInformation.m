@@ -10,6 +10,7 @@
 
 #import "HLSAssert.h"
 #import "HLSLogger.h"
+#import "HLSStartupReport.h"
 
 @interface HLSKeyboardInformation ()
 
@@ -31,6 +32,8 @@ static HLSKeyboardInformation *s_instance = nil;
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     // Register for keyboard notifications. Note that when the keyboard is visible and the device is rotated,
     // we get a hide and a show notifications (keyboard with first orientation is dismissed, keyboard with
     // new orientation is displayed again)
@@ -42,6 +45,8 @@ static HLSKeyboardInformation *s_instance = nil;
                                              selector:@selector(keyboardWillHide:) 
                                                  name:UIKeyboardWillHideNotification 
                                                object:nil];
+    
+    HLSStartupReportRecord("HLSKeyboardInformation", startTime);
 }
 
 + (HLSKeyboardInformation *)keyboardInformation
@@ -94,6 +99,9 @@ static HLSKeyboardInformation *s_instance = nil;
 + (void)keyboardWillShow:(NSNotification *)notification
 {
     HLSLoggerDebug(@"Keyboard shown");
+    
+    // Show notifications can be received several times in a row (e.g. when the input view changes)
+    [s_instance release];
     s_instance = [[HLSKeyboardInformation alloc] initWithUserInfo:[notification userInfo]];
 }
 
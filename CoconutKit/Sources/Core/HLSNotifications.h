@@ -24,13 +24,13 @@
 /**
  * Manages application-wide notification mechanisms
  *
- * This class is not thread-safe
+ * The network activity methods can be called from any thread. Other methods must be called from the main thread
  *
  * Designated initializer: -init
  */
 @interface HLSNotificationManager : NSObject {
 @private
-    NSUInteger m_networkActivityCount;
+    volatile int32_t m_networkActivityCount;
 }
 
 /**
@@ -41,14 +41,17 @@
 /**
  * Call this method to notify that a network task has started. This method can be called several times if several
  * tasks are running simultaneously (an activity indicator is displayed in the status bar when at least one task 
- * is running)
+ * is running). It can be called from any thread
+ *
+ * The indicator is updated on the main thread. It is hidden only after no task has been running for a short delay, 
+ * so that the indicator does not flicker when tasks quickly follow each other
  */
 - (void)notifyBeginNetworkActivity;
 
 /**
  * Call this method to notify that a network task has ended. This method can be called several times if several
  * tasks are running simultaneously (an activity indicator is displayed in the status bar when at least one task 
- * is running)
+ * is running). It can be called from any thread
  */
 - (void)notifyEndNetworkActivity;
 
@@ -66,14 +69,28 @@
 @private
     // To be able to add conversion rules for an (object, notification name), and to be able to remove all rules defined
     // for an object, we introduce two dictionary levels:
-    //   - 1st dictionary: maps objects to a notification map
+    //   - 1st dictionary: maps objects (keyed by pointer, not retained) to a notification map
     //   - 2nd dictionary (notification map): maps notification name to the (object, notification name) pair to
     //                                        convert to
-    NSMutableDictionary *m_objectToNotificationMap;
+    CFMutableDictionaryRef m_objectToNotificationMap;
+    NSPostingStyle m_postingStyle;
+    NSArray *m_modes;
 }
 
 + (HLSNotificationConverter *)sharedNotificationConverter;
 
+/**
+ * The posting style used to emit converted notifications (default is NSPostNow). Converted notifications are coalesced
+ * on name and sender, see NSObject (HLSNotificationExtensions) for more information about deferred posting styles
+ */
+@property (nonatomic, assign) NSPostingStyle postingStyle;
+
+/**
+ * The run loop modes in which converted notifications can be posted when using a deferred posting style (default is 
+ * nil, i.e. NSDefaultRunLoopMode)
+ */
+@property (nonatomic, retain) NSArray *modes;
+
 /**
  * Add a conversion rule. The objectFrom and objectTo objects are NOT retained, as for NSNotificationManager. This is 
  * not needed (and not desirable) since:
@@ -115,6 +132,26 @@
  */
 @interface NSObject (HLSNotificationExtensions)
 
+/**
+ * Post a notification from the receiver using the default notification queue of the current thread, coalescing it with 
+ * notifications having the same name and sender
+ *
+ * With NSPostNow, the notification is posted synchronously, and only coalesced with identical notifications already 
+ * waiting in the queue. To collapse bursts of notifications (e.g. model changes) into a single delivery, use a deferred
+ * posting style: NSPostASAP posts at the end of the current run loop iteration, NSPostWhenIdle when the run loop
+ * is waiting for input. Notifications are then only posted when the run loop of the current thread runs in one of
+ * the specified modes (nil means NSDefaultRunLoopMode; add UITrackingRunLoopMode if notifications must be delivered
+ * while scrolling, or use NSRunLoopCommonModes). When notifications are coalesced, only the first one is posted, 
+ * the user information dictionaries of the following ones are lost
+ */
+- (void)postCoalescingNotificationWithName:(NSString *)name 
+                                  userInfo:(NSDictionary *)userInfo 
+                              postingStyle:(NSPostingStyle)postingStyle 
+                                     modes:(NSArray *)modes;
+
+/**
+ * Same as -postCoalescingNotificationWithName:userInfo:postingStyle:modes:, with NSPostNow
+ */
 - (void)postCoalescingNotificationWithName:(NSString *)name userInfo:(NSDictionary *)userInfo;
 - (void)postCoalescingNotificationWithName:(NSString *)name;
 
@@ -122,6 +159,17 @@
 
 @interface NSNotificationCenter (HLSNotificationExtensions)
 
+/**
+ * Register / unregister an observer for notifications with a given name sent by any object of a collection. Instead of
+ * registering the observer once per object, a single registration is made per notification name, and the observers
+ * of the sending object are found using a hash lookup. The cost of registration and delivery therefore does not 
+ * depend on the number of objects observed
+ *
+ * As for NSNotificationCenter, observers are not retained. Observers registered using these methods are removed
+ * using -removeObserver:name:objectsInCollection:, or all at once using -removeObserver: (which must therefore be
+ * called before an observer is deallocated, as usual). -removeObserver:name:object: has no effect on them. If name
+ * is nil, observers are registered once per object with the notification center
+ */
 - (void)addObserver:(id)observer selector:(SEL)selector name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection;
 - (void)removeObserver:(id)observer name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection;
 
@@ -9,6 +9,22 @@
 #import "HLSNotifications.h"
 
 #import "HLSLogger.h"
+#import "HLSRuntime.h"
+#import "HLSStartupReport.h"
+#import <libkern/OSAtomic.h>
+#import <objc/runtime.h>
+
+// Delay after which the network activity indicator is hidden when no more network activity is running
+static const NSTimeInterval kNetworkActivityIndicatorHideDelay = 0.3;
+
+// Associated object keys
+static void *s_collectionObserverDispatcherKey = &s_collectionObserverDispatcherKey;
+
+// Original implementation of the methods we swizzle
+static void (*s_NSNotificationCenter__removeObserver_Imp)(id, SEL, id) = NULL;
+
+// Swizzled method implementations
+static void swizzled_NSNotificationCenter__removeObserver_Imp(NSNotificationCenter *self, SEL _cmd, id observer);
 
 #pragma mark -
 #pragma mark NotificationSender class interface
@@ -32,16 +48,82 @@
 
 @end
 
+#pragma mark -
+#pragma mark CollectionObserverEntry class interface
+
+/**
+ * An (observer, selector) pair registered with a CollectionObserverDispatcher. The observer is not retained, as for
+ * NSNotificationCenter
+ *
+ * Designated initializer: -initWithObserver:selector:
+ */
+@interface CollectionObserverEntry : NSObject {
+@private
+    id m_observer;
+    SEL m_selector;
+}
+
+- (id)initWithObserver:(id)observer selector:(SEL)selector;
+
+@property (nonatomic, readonly, assign) id observer;
+@property (nonatomic, readonly, assign) SEL selector;
+
+@end
+
+#pragma mark -
+#pragma mark CollectionObserverDispatcher class interface
+
+/**
+ * Observes notifications sent by the objects of collections on behalf of observers. Instead of registering an observer
+ * once per object with the notification center (each post then has to walk all those registrations), the dispatcher
+ * registers itself once per notification name, and locates the observers of the sending object using a hash lookup
+ *
+ * This class is thread-safe
+ *
+ * Designated initializer: -initWithNotificationCenter:
+ */
+@interface CollectionObserverDispatcher : NSObject {
+@private
+    NSNotificationCenter *m_notificationCenter;                 // Not retained (the center owns the dispatcher)
+    NSMutableDictionary *m_nameToObjectMap;                     // Maps names to objects (keyed by pointer, not retained)
+                                                                // to NSMutableArray of CollectionObserverEntry
+    CFMutableBagRef m_observers;                                // Observers (not retained), once per registration
+}
+
+- (id)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter;
+
+- (void)addObserver:(id)observer selector:(SEL)selector name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection;
+- (void)removeObserver:(id)observer name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection;
+- (void)removeObserver:(id)observer;
+
+- (void)dispatchNotification:(NSNotification *)notification;
+
+@end
+
+#pragma mark -
+#pragma mark NSNotificationCenter private extensions interface
+
+@interface NSNotificationCenter (HLSNotificationExtensionsPrivate)
+
+- (CollectionObserverDispatcher *)collectionObserverDispatcher;
+
+@end
+
 #pragma mark -
 #pragma mark HLSNotificationConverter class interface extension
 
 @interface HLSNotificationConverter ()
 
-@property (nonatomic, retain) NSMutableDictionary *objectToNotificationMap;
+- (void)convertNotification:(NSNotification *)notification;
+
+@end
 
-- (NSString *)buildIdentifierForObject:(id)object;
+#pragma mark -
+#pragma mark HLSNotificationManager class interface extension
 
-- (void)convertNotification:(NSNotification *)notification;
+@interface HLSNotificationManager ()
+
+- (void)updateNetworkActivityIndicator;
 
 @end
 
@@ -55,10 +137,12 @@
 + (HLSNotificationManager *)sharedNotificationManager
 {
     static HLSNotificationManager *s_instance = nil;
+    static dispatch_once_t s_onceToken;
     
-    if (! s_instance) {
+    // Can be accessed from any thread
+    dispatch_once(&s_onceToken, ^{
         s_instance = [[HLSNotificationManager alloc] init];
-    }
+    });
     return s_instance;
 }
 
@@ -76,28 +160,44 @@
 
 - (void)notifyBeginNetworkActivity
 {
-    ++m_networkActivityCount;
+    int32_t networkActivityCount = OSAtomicIncrement32Barrier(&m_networkActivityCount);
     
-    HLSLoggerDebug(@"Network activity counter is now %d", m_networkActivityCount);
+    HLSLoggerDebug(@"Network activity counter is now %d", networkActivityCount);
     
-    if (m_networkActivityCount == 1) {
-        [UIApplication sharedApplication].networkActivityIndicatorVisible = YES;
+    if (networkActivityCount == 1) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self updateNetworkActivityIndicator];
+        });
     }
 }
 
 - (void)notifyEndNetworkActivity
 {
-    if (m_networkActivityCount == 0) {
-        HLSLoggerWarn(@"Warning: Notifying the end of a network activity which has not been started");
-        return;
-    }
+    // Never decrement below zero
+    int32_t networkActivityCount;
+    do {
+        networkActivityCount = m_networkActivityCount;
+        if (networkActivityCount == 0) {
+            HLSLoggerWarn(@"Warning: Notifying the end of a network activity which has not been started");
+            return;
+        }
+    } while (! OSAtomicCompareAndSwap32Barrier(networkActivityCount, networkActivityCount - 1, &m_networkActivityCount));
     
-    --m_networkActivityCount;
+    HLSLoggerDebug(@"Network activity counter is now %d", networkActivityCount - 1);
     
-    HLSLoggerDebug(@"Network activity counter is now %d", m_networkActivityCount);
-    
-    if (m_networkActivityCount == 0) {
-        [UIApplication sharedApplication].networkActivityIndicatorVisible = NO;        
+    // Hide the indicator after a delay, and only if no other activity has begun in the meantime
+    if (networkActivityCount == 1) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kNetworkActivityIndicatorHideDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [self updateNetworkActivityIndicator];
+        });
+    }
+}
+
+- (void)updateNetworkActivityIndicator
+{
+    BOOL visible = (m_networkActivityCount != 0);
+    if ([UIApplication sharedApplication].networkActivityIndicatorVisible != visible) {
+        [UIApplication sharedApplication].networkActivityIndicatorVisible = visible;
     }
 }
 
@@ -156,20 +256,29 @@
 - (id)init
 {
     if ((self = [super init])) {
-        self.objectToNotificationMap = [NSMutableDictionary dictionary];
+        // Objects are keyed by pointer (and not retained, see -convertNotificationWithName:...), so that looking up
+        // the rules for a notification is a plain hash lookup
+        m_objectToNotificationMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        self.postingStyle = NSPostNow;
     }
     return self;
 }
 
 - (void)dealloc
 {
-    self.objectToNotificationMap = nil;
+    if (m_objectToNotificationMap) {
+        CFRelease(m_objectToNotificationMap);
+        m_objectToNotificationMap = NULL;
+    }
+    self.modes = nil;
     [super dealloc];
 }
 
 #pragma mark Accessors and mutators
 
-@synthesize objectToNotificationMap = m_objectToNotificationMap;
+@synthesize postingStyle = m_postingStyle;
+
+@synthesize modes = m_modes;
 
 #pragma mark (Un)registering conversion rules
 
@@ -183,14 +292,11 @@
         return;
     }
     
-    // Build the emitter identifier
-    NSString *fromIdentifier = [self buildIdentifierForObject:objectFrom];
-    
     // Get the associated notification map, or create it if it does not exist
-    NSMutableDictionary *notificationMap = [self.objectToNotificationMap objectForKey:fromIdentifier];
+    NSMutableDictionary *notificationMap = (NSMutableDictionary *)CFDictionaryGetValue(m_objectToNotificationMap, objectFrom);
     if (! notificationMap) {
         notificationMap = [[[NSMutableDictionary alloc] initWithCapacity:1] autorelease];
-        [self.objectToNotificationMap setObject:notificationMap forKey:fromIdentifier];
+        CFDictionarySetValue(m_objectToNotificationMap, objectFrom, notificationMap);
     }
     
     // If the rule already exists, nothing to do
@@ -239,11 +345,8 @@
         return;
     }
     
-    // Build the emitter identifier
-    NSString *fromIdentifier = [self buildIdentifierForObject:objectFrom];
-    
     // Get all associated rules
-    NSMutableDictionary *notificationMap = [self.objectToNotificationMap objectForKey:fromIdentifier];
+    NSMutableDictionary *notificationMap = (NSMutableDictionary *)CFDictionaryGetValue(m_objectToNotificationMap, objectFrom);
     
     // If no rules, nothing to do
     if (! notificationMap) {
@@ -257,7 +360,7 @@
     }
     
     // Remove all rules
-    [self.objectToNotificationMap removeObjectForKey:fromIdentifier];
+    CFDictionaryRemoveValue(m_objectToNotificationMap, objectFrom);
     
     HLSLoggerDebug(@"Removed all conversions for object %p", objectFrom);
 }
@@ -269,29 +372,18 @@
     } 
 }
 
-#pragma mark Creating a unique string identifier for indexing the dictionary
-
-- (NSString *)buildIdentifierForObject:(id)object
-{
-    // Since a pointer is unique, this is guaranteed to be unique
-    return [NSString stringWithFormat:@"%p", object];
-}
-
 #pragma mark Notification conversion callback
 
 - (void)convertNotification:(NSNotification *)notification
 {
-    // Build the emitter identifier
-    NSString *fromIdentifier = [self buildIdentifierForObject:notification.object];
-    
     // Locate the conversion rule to apply
-    NotificationSender *sender = [[self.objectToNotificationMap objectForKey:fromIdentifier] 
-                                  objectForKey:notification.name];
+    NSDictionary *notificationMap = notification.object ? (NSDictionary *)CFDictionaryGetValue(m_objectToNotificationMap, notification.object) : nil;
+    NotificationSender *sender = [notificationMap objectForKey:notification.name];
     
     // We should never be trapped here if no conversion rule exists; but stay defensive anyway
     if (! sender) {
-        HLSLoggerWarn(@"Notification conversion remains registered with NSNotificationCenter for object %@ "
-                      "and notification %@, but should not be", fromIdentifier, notification.name);
+        HLSLoggerWarn(@"Notification conversion remains registered with NSNotificationCenter for object %p "
+                      "and notification %@, but should not be", notification.object, notification.name);
         return;
     }
     
@@ -300,9 +392,199 @@
                                                                     object:sender.object
                                                                   userInfo:notification.userInfo];
     [[NSNotificationQueue defaultQueue] enqueueNotification:newNotification
-                                               postingStyle:NSPostNow
+                                               postingStyle:self.postingStyle
                                                coalesceMask:NSNotificationCoalescingOnName | NSNotificationCoalescingOnSender
-                                                   forModes:nil];
+                                                   forModes:self.modes];
+}
+
+@end
+
+#pragma mark -
+#pragma mark CollectionObserverEntry class implementation
+
+@implementation CollectionObserverEntry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithObserver:(id)observer selector:(SEL)selector
+{
+    if ((self = [super init])) {
+        m_observer = observer;
+        m_selector = selector;
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize observer = m_observer;
+
+@synthesize selector = m_selector;
+
+@end
+
+#pragma mark -
+#pragma mark CollectionObserverDispatcher class implementation
+
+@implementation CollectionObserverDispatcher
+
+#pragma mark Object creation and destruction
+
+- (id)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+{
+    if ((self = [super init])) {
+        m_notificationCenter = notificationCenter;
+        m_nameToObjectMap = [[NSMutableDictionary alloc] init];
+        m_observers = CFBagCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_notificationCenter removeObserver:self];
+    m_notificationCenter = nil;
+    
+    [m_nameToObjectMap release];
+    m_nameToObjectMap = nil;
+    
+    CFRelease(m_observers);
+    m_observers = NULL;
+    
+    [super dealloc];
+}
+
+#pragma mark Registering observers
+
+- (void)addObserver:(id)observer selector:(SEL)selector name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection
+{
+    @synchronized(self) {
+        CFMutableDictionaryRef objectToEntriesMap = (CFMutableDictionaryRef)[m_nameToObjectMap objectForKey:name];
+        if (! objectToEntriesMap) {
+            objectToEntriesMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+            [m_nameToObjectMap setObject:(id)objectToEntriesMap forKey:name];
+            CFRelease(objectToEntriesMap);
+            
+            // A single registration per name, whatever the number of objects
+            [m_notificationCenter addObserver:self selector:@selector(dispatchNotification:) name:name object:nil];
+        }
+        
+        for (id object in collection) {
+            NSMutableArray *entries = (NSMutableArray *)CFDictionaryGetValue(objectToEntriesMap, object);
+            if (! entries) {
+                entries = [NSMutableArray arrayWithCapacity:1];
+                CFDictionarySetValue(objectToEntriesMap, object, entries);
+            }
+            
+            // Same observer and selector: Already registered
+            BOOL registered = NO;
+            for (CollectionObserverEntry *entry in entries) {
+                if (entry.observer == observer && entry.selector == selector) {
+                    registered = YES;
+                    break;
+                }
+            }
+            if (registered) {
+                continue;
+            }
+            
+            CollectionObserverEntry *entry = [[[CollectionObserverEntry alloc] initWithObserver:observer selector:selector] autorelease];
+            [entries addObject:entry];
+            CFBagAddValue(m_observers, observer);
+        }
+    }
+}
+
+- (void)removeObserver:(id)observer name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection
+{
+    @synchronized(self) {
+        CFMutableDictionaryRef objectToEntriesMap = (CFMutableDictionaryRef)[m_nameToObjectMap objectForKey:name];
+        if (! objectToEntriesMap) {
+            return;
+        }
+        
+        for (id object in collection) {
+            NSMutableArray *entries = (NSMutableArray *)CFDictionaryGetValue(objectToEntriesMap, object);
+            if (! entries) {
+                continue;
+            }
+            
+            for (NSInteger i = [entries count] - 1; i >= 0; --i) {
+                CollectionObserverEntry *entry = [entries objectAtIndex:i];
+                if (entry.observer == observer) {
+                    [entries removeObjectAtIndex:i];
+                    CFBagRemoveValue(m_observers, observer);
+                }
+            }
+            if ([entries count] == 0) {
+                CFDictionaryRemoveValue(objectToEntriesMap, object);
+            }
+        }
+        
+        // No more objects observed for this name
+        if (CFDictionaryGetCount(objectToEntriesMap) == 0) {
+            [m_notificationCenter removeObserver:self name:name object:nil];
+            [m_nameToObjectMap removeObjectForKey:name];
+        }
+    }
+}
+
+- (void)removeObserver:(id)observer
+{
+    @synchronized(self) {
+        // Called each time an object is removed as observer from the notification center. Most of them are not
+        // registered with the dispatcher, in which case there is nothing to scan
+        if (! CFBagContainsValue(m_observers, observer)) {
+            return;
+        }
+        
+        for (NSString *name in [m_nameToObjectMap allKeys]) {
+            CFMutableDictionaryRef objectToEntriesMap = (CFMutableDictionaryRef)[m_nameToObjectMap objectForKey:name];
+            
+            // Objects cannot be removed while enumerating the map. Collect them first
+            CFIndex count = CFDictionaryGetCount(objectToEntriesMap);
+            const void **objects = malloc(count * sizeof(const void *));
+            CFDictionaryGetKeysAndValues(objectToEntriesMap, objects, NULL);
+            for (CFIndex i = 0; i < count; ++i) {
+                NSMutableArray *entries = (NSMutableArray *)CFDictionaryGetValue(objectToEntriesMap, objects[i]);
+                for (NSInteger j = [entries count] - 1; j >= 0; --j) {
+                    CollectionObserverEntry *entry = [entries objectAtIndex:j];
+                    if (entry.observer == observer) {
+                        [entries removeObjectAtIndex:j];
+                        CFBagRemoveValue(m_observers, observer);
+                    }
+                }
+                if ([entries count] == 0) {
+                    CFDictionaryRemoveValue(objectToEntriesMap, objects[i]);
+                }
+            }
+            free(objects);
+            
+            if (CFDictionaryGetCount(objectToEntriesMap) == 0) {
+                [m_notificationCenter removeObserver:self name:name object:nil];
+                [m_nameToObjectMap removeObjectForKey:name];
+            }
+        }
+    }
+}
+
+#pragma mark Notification callback
+
+- (void)dispatchNotification:(NSNotification *)notification
+{
+    // Observers can be removed during delivery. Work on a copy, and call observers outside the lock
+    NSArray *entries = nil;
+    @synchronized(self) {
+        CFDictionaryRef objectToEntriesMap = (CFDictionaryRef)[m_nameToObjectMap objectForKey:notification.name];
+        if (! objectToEntriesMap || ! notification.object) {
+            return;
+        }
+        entries = [[(NSArray *)CFDictionaryGetValue(objectToEntriesMap, notification.object) copy] autorelease];
+    }
+    
+    for (CollectionObserverEntry *entry in entries) {
+        [entry.observer performSelector:entry.selector withObject:notification];
+    }
 }
 
 @end
@@ -312,15 +594,23 @@
 
 @implementation NSObject (HLSNotificationExtensions)
 
-- (void)postCoalescingNotificationWithName:(NSString *)name userInfo:(NSDictionary *)userInfo
+- (void)postCoalescingNotificationWithName:(NSString *)name 
+                                  userInfo:(NSDictionary *)userInfo 
+                              postingStyle:(NSPostingStyle)postingStyle 
+                                     modes:(NSArray *)modes
 {
     NSNotification *notification = [NSNotification notificationWithName:name 
                                                                  object:self
                                                                userInfo:userInfo];
     [[NSNotificationQueue defaultQueue] enqueueNotification:notification
-                                               postingStyle:NSPostNow
+                                               postingStyle:postingStyle
                                                coalesceMask:NSNotificationCoalescingOnName | NSNotificationCoalescingOnSender
-                                                   forModes:nil];
+                                                   forModes:modes];
+}
+
+- (void)postCoalescingNotificationWithName:(NSString *)name userInfo:(NSDictionary *)userInfo
+{
+    [self postCoalescingNotificationWithName:name userInfo:userInfo postingStyle:NSPostNow modes:nil];
 }
 
 - (void)postCoalescingNotificationWithName:(NSString *)name
@@ -335,20 +625,77 @@
 
 @implementation NSNotificationCenter (HLSNotificationExtensions)
 
++ (void)load
+{
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
+    s_NSNotificationCenter__removeObserver_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self,
+                                                                                           @selector(removeObserver:),
+                                                                                           (IMP)swizzled_NSNotificationCenter__removeObserver_Imp);
+    
+    HLSStartupReportRecord("HLSNotifications", startTime);
+}
+
 - (void)addObserver:(id)observer selector:(SEL)selector name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection
 {
-    for (id object in collection) {
-        [self addObserver:observer selector:selector name:name object:object];
+    // Observing all notifications: Cannot be dispatched by name
+    if (! name) {
+        for (id object in collection) {
+            [self addObserver:observer selector:selector name:name object:object];
+        }
+        return;
     }
+    
+    [[self collectionObserverDispatcher] addObserver:observer selector:selector name:name objectsInCollection:collection];
 }
 
 // TODO: Warning! Does not work correctly for dictionaries (should iterate over the values, not the keys, which is the default
 //       for each behavior for dictionaries)
 - (void)removeObserver:(id)observer name:(NSString *)name objectsInCollection:(id<NSFastEnumeration>)collection
 {
-    for (id object in collection) {
-        [self removeObserver:observer name:name object:object];
+    if (! name) {
+        for (id object in collection) {
+            [self removeObserver:observer name:name object:object];
+        }
+        return;
+    }
+    
+    [[self collectionObserverDispatcher] removeObserver:observer name:name objectsInCollection:collection];
+}
+
+@end
+
+#pragma mark -
+#pragma mark NSNotificationCenter private extensions implementation
+
+@implementation NSNotificationCenter (HLSNotificationExtensionsPrivate)
+
+- (CollectionObserverDispatcher *)collectionObserverDispatcher
+{
+    @synchronized(self) {
+        CollectionObserverDispatcher *dispatcher = objc_getAssociatedObject(self, s_collectionObserverDispatcherKey);
+        if (! dispatcher) {
+            dispatcher = [[[CollectionObserverDispatcher alloc] initWithNotificationCenter:self] autorelease];
+            objc_setAssociatedObject(self, s_collectionObserverDispatcherKey, dispatcher, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        return dispatcher;
     }
 }
 
 @end
+
+#pragma mark Swizzled method implementations
+
+// Observers registered for objects in collections are also removed, so that they are not messaged once deallocated
+static void swizzled_NSNotificationCenter__removeObserver_Imp(NSNotificationCenter *self, SEL _cmd, id observer)
+{
+    (*s_NSNotificationCenter__removeObserver_Imp)(self, _cmd, observer);
+    
+    // The dispatcher itself unregisters when deallocated, and is not created if it does not exist yet
+    if ([observer isKindOfClass:[CollectionObserverDispatcher class]]) {
+        return;
+    }
+    
+    CollectionObserverDispatcher *dispatcher = objc_getAssociatedObject(self, s_collectionObserverDispatcherKey);
+    [dispatcher removeObserver:observer];
+}
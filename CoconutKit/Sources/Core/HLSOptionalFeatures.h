@@ -13,6 +13,7 @@
  */
 
 #import "HLSApplicationPreloader.h"
+#import "HLSStartupReport.h"
 #import "NSManagedObject+HLSValidation.h"
 #import "UIControl+HLSExclusiveTouch.h"
 
@@ -78,3 +79,23 @@
         [UIControl enable];                                                                              \
     }
 #endif
+
+/**
+ * Log a report of the time spent setting up CoconutKit features when the first view controller appears (see 
+ * HLSStartupReport.h). Useful to measure what CoconutKit adds to your application launch time
+ */
+#if !__has_feature(objc_arc)
+#define HLSEnableLaunchProfiling()                                                                       \
+    __attribute__ ((constructor)) void HLSEnableLaunchProfilingConstructor(void)                         \
+    {                                                                                                    \
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];                                      \
+        [HLSStartupReport enableLaunchProfiling];                                                        \
+        [pool drain];                                                                                    \
+    }
+#else
+#define HLSEnableLaunchProfiling()                                                                       \
+    __attribute__ ((constructor)) void HLSEnableLaunchProfilingConstructor(void)                         \
+    {                                                                                                    \
+        [HLSStartupReport enableLaunchProfiling];                                                        \
+    }
+#endif
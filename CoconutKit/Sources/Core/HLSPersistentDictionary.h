@@ -0,0 +1,31 @@
+//
+//  HLSPersistentDictionary.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * An immutable dictionary implemented as a hash array mapped trie (HAMT), suited for keeping successive snapshots of
+ * some state. The -dictionaryBySettingObject:forKey:, -dictionaryByRemovingObjectForKey: and
+ * -dictionaryByRemovingObjectsForKeys: methods of NSDictionary+HLSExtensions copy the whole receiver and therefore
+ * cost O(n). When called on a persistent dictionary, they return a new persistent dictionary sharing all its structure
+ * with the receiver except for the O(log n) trie nodes along the path to the modified key. Successive snapshots
+ * therefore only cost the memory of their differences. Lookups cost O(log n) as well (the trie has 32 branches per
+ * level, and is therefore very shallow in practice)
+ *
+ * A persistent dictionary is an NSDictionary and can be used wherever one is expected. Create one using the usual
+ * NSDictionary class methods (e.g. +dictionaryWithDictionary:), or start from an empty dictionary and add objects
+ * using -dictionaryBySettingObject:forKey:. As for NSDictionary, keys are copied and objects are retained. Keys must
+ * implement -hash and -isEqual: consistently
+ *
+ * Persistent dictionaries are immutable and can therefore be shared between threads
+ */
+@interface HLSPersistentDictionary : NSDictionary {
+@private
+    id m_rootNode;
+    NSUInteger m_count;
+}
+
+@end
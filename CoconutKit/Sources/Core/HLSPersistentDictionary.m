@@ -0,0 +1,785 @@
+//
+//  HLSPersistentDictionary.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSPersistentDictionary.h"
+
+#import "HLSAssert.h"
+#import "NSDictionary+HLSExtensions.h"
+
+// Each trie level consumes kHashBitsPerLevel bits of the key hash. When all bits have been consumed, colliding
+// entries are stored in a collision node
+#define kHashBitsPerLevel           5
+#define kHashLevelMask              ((1 << kHashBitsPerLevel) - 1)
+#define kHashBits                   (sizeof(NSUInteger) * 8)
+
+// Maximum trie depth, including the collision node level
+#define kMaxDepth                   ((kHashBits + kHashBitsPerLevel - 1) / kHashBitsPerLevel + 1)
+
+/**
+ * Abstract trie node. Nodes are immutable: modifications return new nodes sharing unchanged subnodes with the
+ * original one (or the original node itself if nothing changed). A node stores entries (key-object pairs) and
+ * subnodes
+ */
+@interface HLSPersistentDictionaryNode : NSObject
+
+- (NSUInteger)numberOfEntries;
+- (id)keyAtIndex:(NSUInteger)index;
+- (id)objectAtIndex:(NSUInteger)index;
+
+- (NSUInteger)numberOfSubnodes;
+- (HLSPersistentDictionaryNode *)subnodeAtIndex:(NSUInteger)index;
+
+- (id)objectForKey:(id)key hash:(NSUInteger)hash shift:(NSUInteger)shift;
+- (HLSPersistentDictionaryNode *)nodeBySettingObject:(id)object
+                                              forKey:(id)key
+                                                hash:(NSUInteger)hash
+                                               shift:(NSUInteger)shift
+                                               added:(BOOL *)pAdded;
+- (HLSPersistentDictionaryNode *)nodeByRemovingObjectForKey:(id)key
+                                                       hash:(NSUInteger)hash
+                                                      shift:(NSUInteger)shift
+                                                    removed:(BOOL *)pRemoved;
+
+@end
+
+/**
+ * Node storing its entries and subnodes in compact arrays, indexed by bitmaps of the 32 possible hash fragments
+ * at its level (a fragment is either used by an entry, by a subnode, or unused)
+ */
+@interface HLSPersistentDictionaryBitmapNode : HLSPersistentDictionaryNode {
+@private
+    uint32_t m_dataMap;
+    uint32_t m_nodeMap;
+    id *m_keysAndObjects;
+    HLSPersistentDictionaryNode **m_subnodes;
+}
+
+- (id)initWithDataMap:(uint32_t)dataMap
+              nodeMap:(uint32_t)nodeMap
+       keysAndObjects:(id *)keysAndObjects
+             subnodes:(HLSPersistentDictionaryNode **)subnodes;
+
+@end
+
+/**
+ * Node storing the entries whose keys have the same full hash
+ */
+@interface HLSPersistentDictionaryCollisionNode : HLSPersistentDictionaryNode {
+@private
+    NSUInteger m_count;
+    id *m_keysAndObjects;
+}
+
+- (id)initWithCount:(NSUInteger)count keysAndObjects:(id *)keysAndObjects;
+
+@end
+
+/**
+ * Depth-first enumerator over the keys of a trie
+ */
+@interface HLSPersistentDictionaryKeyEnumerator : NSEnumerator {
+@private
+    HLSPersistentDictionary *m_dictionary;
+    HLSPersistentDictionaryNode *m_nodes[kMaxDepth];
+    NSUInteger m_positions[kMaxDepth];
+    NSInteger m_depth;
+}
+
+- (id)initWithDictionary:(HLSPersistentDictionary *)dictionary rootNode:(HLSPersistentDictionaryNode *)rootNode;
+
+@end
+
+@interface HLSPersistentDictionary ()
+
+- (id)initWithRootNode:(HLSPersistentDictionaryNode *)rootNode count:(NSUInteger)count;
+
+@end
+
+// Static functions
+static NSUInteger HLSPersistentDictionaryFragment(NSUInteger hash, NSUInteger shift);
+static BOOL HLSPersistentDictionaryKeysEqual(id key1, id key2);
+static HLSPersistentDictionaryNode *HLSPersistentDictionaryNodeMerge(id key1, id object1, NSUInteger hash1,
+                                                                     id key2, id object2, NSUInteger hash2,
+                                                                     NSUInteger shift);
+
+@implementation HLSPersistentDictionary
+
+#pragma mark Object creation and destruction
+
+- (id)initWithRootNode:(HLSPersistentDictionaryNode *)rootNode count:(NSUInteger)count
+{
+    if ((self = [super init])) {
+        m_rootNode = [rootNode retain];
+        m_count = count;
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSPersistentDictionaryNode *rootNode = [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:0
+                                                                                                nodeMap:0
+                                                                                         keysAndObjects:NULL
+                                                                                               subnodes:NULL] autorelease];
+    return [self initWithRootNode:rootNode count:0];
+}
+
+- (id)initWithObjects:(const id [])objects forKeys:(const id [])keys count:(NSUInteger)count
+{
+    if ((self = [self init])) {
+        for (NSUInteger i = 0; i < count; ++i) {
+            if (! objects[i] || ! keys[i]) {
+                [self release];
+                @throw [NSException exceptionWithName:NSInvalidArgumentException
+                                               reason:@"Persistent dictionaries cannot contain nil keys or objects"
+                                             userInfo:nil];
+            }
+            
+            BOOL added = NO;
+            id key = [[keys[i] copyWithZone:nil] autorelease];
+            HLSPersistentDictionaryNode *rootNode = [m_rootNode nodeBySettingObject:objects[i]
+                                                                             forKey:key
+                                                                               hash:[key hash]
+                                                                              shift:0
+                                                                              added:&added];
+            if (rootNode != m_rootNode) {
+                [m_rootNode release];
+                m_rootNode = [rootNode retain];
+            }
+            if (added) {
+                ++m_count;
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_rootNode release];
+    
+    [super dealloc];
+}
+
+#pragma mark NSDictionary primitive methods
+
+- (NSUInteger)count
+{
+    return m_count;
+}
+
+- (id)objectForKey:(id)key
+{
+    if (! key) {
+        return nil;
+    }
+    
+    return [m_rootNode objectForKey:key hash:[key hash] shift:0];
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+    return [[[HLSPersistentDictionaryKeyEnumerator alloc] initWithDictionary:self rootNode:m_rootNode] autorelease];
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return [self retain];
+}
+
+#pragma mark Structural sharing (overrides of the NSDictionary+HLSExtensions methods)
+
+- (id)dictionaryBySettingObject:(id)object forKey:(id)key
+{
+    if (! object || ! key) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException
+                                       reason:@"Persistent dictionaries cannot contain nil keys or objects"
+                                     userInfo:nil];
+    }
+    
+    BOOL added = NO;
+    key = [[key copyWithZone:nil] autorelease];
+    HLSPersistentDictionaryNode *rootNode = [m_rootNode nodeBySettingObject:object forKey:key hash:[key hash] shift:0 added:&added];
+    if (rootNode == m_rootNode) {
+        return self;
+    }
+    return [[[HLSPersistentDictionary alloc] initWithRootNode:rootNode count:added ? m_count + 1 : m_count] autorelease];
+}
+
+- (id)dictionaryByRemovingObjectForKey:(id)key
+{
+    if (! key) {
+        return self;
+    }
+    
+    BOOL removed = NO;
+    HLSPersistentDictionaryNode *rootNode = [m_rootNode nodeByRemovingObjectForKey:key hash:[key hash] shift:0 removed:&removed];
+    if (! removed) {
+        return self;
+    }
+    return [[[HLSPersistentDictionary alloc] initWithRootNode:rootNode count:m_count - 1] autorelease];
+}
+
+- (id)dictionaryByRemovingObjectsForKeys:(NSArray *)keyArray
+{
+    HLSPersistentDictionaryNode *rootNode = m_rootNode;
+    NSUInteger count = m_count;
+    for (id key in keyArray) {
+        BOOL removed = NO;
+        rootNode = [rootNode nodeByRemovingObjectForKey:key hash:[key hash] shift:0 removed:&removed];
+        if (removed) {
+            --count;
+        }
+    }
+    
+    if (rootNode == m_rootNode) {
+        return self;
+    }
+    return [[[HLSPersistentDictionary alloc] initWithRootNode:rootNode count:count] autorelease];
+}
+
+@end
+
+@implementation HLSPersistentDictionaryNode
+
+#pragma mark Accessors and mutators
+
+- (NSUInteger)numberOfEntries
+{
+    HLSMissingMethodImplementation();
+    return 0;
+}
+
+- (id)keyAtIndex:(NSUInteger)index
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+- (NSUInteger)numberOfSubnodes
+{
+    HLSMissingMethodImplementation();
+    return 0;
+}
+
+- (HLSPersistentDictionaryNode *)subnodeAtIndex:(NSUInteger)index
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+#pragma mark Lookup and modification
+
+- (id)objectForKey:(id)key hash:(NSUInteger)hash shift:(NSUInteger)shift
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+- (HLSPersistentDictionaryNode *)nodeBySettingObject:(id)object
+                                              forKey:(id)key
+                                                hash:(NSUInteger)hash
+                                               shift:(NSUInteger)shift
+                                               added:(BOOL *)pAdded
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+- (HLSPersistentDictionaryNode *)nodeByRemovingObjectForKey:(id)key
+                                                       hash:(NSUInteger)hash
+                                                      shift:(NSUInteger)shift
+                                                    removed:(BOOL *)pRemoved
+{
+    HLSMissingMethodImplementation();
+    return nil;
+}
+
+@end
+
+@implementation HLSPersistentDictionaryBitmapNode
+
+#pragma mark Object creation and destruction
+
+- (id)initWithDataMap:(uint32_t)dataMap
+              nodeMap:(uint32_t)nodeMap
+       keysAndObjects:(id *)keysAndObjects
+             subnodes:(HLSPersistentDictionaryNode **)subnodes
+{
+    if ((self = [super init])) {
+        m_dataMap = dataMap;
+        m_nodeMap = nodeMap;
+        
+        NSUInteger numberOfKeysAndObjects = 2 * __builtin_popcount(dataMap);
+        if (numberOfKeysAndObjects != 0) {
+            m_keysAndObjects = malloc(numberOfKeysAndObjects * sizeof(id));
+            for (NSUInteger i = 0; i < numberOfKeysAndObjects; ++i) {
+                m_keysAndObjects[i] = [keysAndObjects[i] retain];
+            }
+        }
+        
+        NSUInteger numberOfSubnodes = __builtin_popcount(nodeMap);
+        if (numberOfSubnodes != 0) {
+            m_subnodes = malloc(numberOfSubnodes * sizeof(HLSPersistentDictionaryNode *));
+            for (NSUInteger i = 0; i < numberOfSubnodes; ++i) {
+                m_subnodes[i] = [subnodes[i] retain];
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    NSUInteger numberOfKeysAndObjects = 2 * __builtin_popcount(m_dataMap);
+    for (NSUInteger i = 0; i < numberOfKeysAndObjects; ++i) {
+        [m_keysAndObjects[i] release];
+    }
+    free(m_keysAndObjects);
+    
+    NSUInteger numberOfSubnodes = __builtin_popcount(m_nodeMap);
+    for (NSUInteger i = 0; i < numberOfSubnodes; ++i) {
+        [m_subnodes[i] release];
+    }
+    free(m_subnodes);
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+- (NSUInteger)numberOfEntries
+{
+    return __builtin_popcount(m_dataMap);
+}
+
+- (id)keyAtIndex:(NSUInteger)index
+{
+    return m_keysAndObjects[2 * index];
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    return m_keysAndObjects[2 * index + 1];
+}
+
+- (NSUInteger)numberOfSubnodes
+{
+    return __builtin_popcount(m_nodeMap);
+}
+
+- (HLSPersistentDictionaryNode *)subnodeAtIndex:(NSUInteger)index
+{
+    return m_subnodes[index];
+}
+
+#pragma mark Lookup and modification
+
+- (id)objectForKey:(id)key hash:(NSUInteger)hash shift:(NSUInteger)shift
+{
+    uint32_t bit = 1U << HLSPersistentDictionaryFragment(hash, shift);
+    if (m_dataMap & bit) {
+        NSUInteger index = __builtin_popcount(m_dataMap & (bit - 1));
+        return HLSPersistentDictionaryKeysEqual(m_keysAndObjects[2 * index], key) ? m_keysAndObjects[2 * index + 1] : nil;
+    }
+    else if (m_nodeMap & bit) {
+        NSUInteger index = __builtin_popcount(m_nodeMap & (bit - 1));
+        return [m_subnodes[index] objectForKey:key hash:hash shift:shift + kHashBitsPerLevel];
+    }
+    else {
+        return nil;
+    }
+}
+
+- (HLSPersistentDictionaryNode *)nodeBySettingObject:(id)object
+                                              forKey:(id)key
+                                                hash:(NSUInteger)hash
+                                               shift:(NSUInteger)shift
+                                               added:(BOOL *)pAdded
+{
+    NSUInteger numberOfEntries = __builtin_popcount(m_dataMap);
+    NSUInteger numberOfSubnodes = __builtin_popcount(m_nodeMap);
+    
+    uint32_t bit = 1U << HLSPersistentDictionaryFragment(hash, shift);
+    NSUInteger dataIndex = __builtin_popcount(m_dataMap & (bit - 1));
+    NSUInteger nodeIndex = __builtin_popcount(m_nodeMap & (bit - 1));
+    if (m_dataMap & bit) {
+        id existingKey = m_keysAndObjects[2 * dataIndex];
+        id existingObject = m_keysAndObjects[2 * dataIndex + 1];
+        
+        // Replace the object
+        if (HLSPersistentDictionaryKeysEqual(existingKey, key)) {
+            if (existingObject == object) {
+                return self;
+            }
+            
+            id keysAndObjects[2 * numberOfEntries];
+            memcpy(keysAndObjects, m_keysAndObjects, 2 * numberOfEntries * sizeof(id));
+            keysAndObjects[2 * dataIndex + 1] = object;
+            return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap
+                                                                       nodeMap:m_nodeMap
+                                                                keysAndObjects:keysAndObjects
+                                                                      subnodes:m_subnodes] autorelease];
+        }
+        // Move the existing entry and the new one into a subnode
+        else {
+            *pAdded = YES;
+            HLSPersistentDictionaryNode *subnode = HLSPersistentDictionaryNodeMerge(existingKey, existingObject, [existingKey hash],
+                                                                                    key, object, hash,
+                                                                                    shift + kHashBitsPerLevel);
+            
+            id keysAndObjects[2 * numberOfEntries];
+            memcpy(keysAndObjects, m_keysAndObjects, 2 * dataIndex * sizeof(id));
+            memcpy(&keysAndObjects[2 * dataIndex], &m_keysAndObjects[2 * (dataIndex + 1)], 2 * (numberOfEntries - dataIndex - 1) * sizeof(id));
+            
+            HLSPersistentDictionaryNode *subnodes[numberOfSubnodes + 1];
+            memcpy(subnodes, m_subnodes, nodeIndex * sizeof(HLSPersistentDictionaryNode *));
+            subnodes[nodeIndex] = subnode;
+            memcpy(&subnodes[nodeIndex + 1], &m_subnodes[nodeIndex], (numberOfSubnodes - nodeIndex) * sizeof(HLSPersistentDictionaryNode *));
+            
+            return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap & ~bit
+                                                                       nodeMap:m_nodeMap | bit
+                                                                keysAndObjects:keysAndObjects
+                                                                      subnodes:subnodes] autorelease];
+        }
+    }
+    else if (m_nodeMap & bit) {
+        HLSPersistentDictionaryNode *subnode = m_subnodes[nodeIndex];
+        HLSPersistentDictionaryNode *updatedSubnode = [subnode nodeBySettingObject:object
+                                                                            forKey:key
+                                                                              hash:hash
+                                                                             shift:shift + kHashBitsPerLevel
+                                                                             added:pAdded];
+        if (updatedSubnode == subnode) {
+            return self;
+        }
+        
+        HLSPersistentDictionaryNode *subnodes[numberOfSubnodes];
+        memcpy(subnodes, m_subnodes, numberOfSubnodes * sizeof(HLSPersistentDictionaryNode *));
+        subnodes[nodeIndex] = updatedSubnode;
+        return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap
+                                                                   nodeMap:m_nodeMap
+                                                            keysAndObjects:m_keysAndObjects
+                                                                  subnodes:subnodes] autorelease];
+    }
+    else {
+        *pAdded = YES;
+        
+        id keysAndObjects[2 * (numberOfEntries + 1)];
+        memcpy(keysAndObjects, m_keysAndObjects, 2 * dataIndex * sizeof(id));
+        keysAndObjects[2 * dataIndex] = key;
+        keysAndObjects[2 * dataIndex + 1] = object;
+        memcpy(&keysAndObjects[2 * (dataIndex + 1)], &m_keysAndObjects[2 * dataIndex], 2 * (numberOfEntries - dataIndex) * sizeof(id));
+        return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap | bit
+                                                                   nodeMap:m_nodeMap
+                                                            keysAndObjects:keysAndObjects
+                                                                  subnodes:m_subnodes] autorelease];
+    }
+}
+
+- (HLSPersistentDictionaryNode *)nodeByRemovingObjectForKey:(id)key
+                                                       hash:(NSUInteger)hash
+                                                      shift:(NSUInteger)shift
+                                                    removed:(BOOL *)pRemoved
+{
+    NSUInteger numberOfEntries = __builtin_popcount(m_dataMap);
+    NSUInteger numberOfSubnodes = __builtin_popcount(m_nodeMap);
+    
+    uint32_t bit = 1U << HLSPersistentDictionaryFragment(hash, shift);
+    NSUInteger dataIndex = __builtin_popcount(m_dataMap & (bit - 1));
+    NSUInteger nodeIndex = __builtin_popcount(m_nodeMap & (bit - 1));
+    if (m_dataMap & bit) {
+        if (! HLSPersistentDictionaryKeysEqual(m_keysAndObjects[2 * dataIndex], key)) {
+            return self;
+        }
+        
+        *pRemoved = YES;
+        
+        id keysAndObjects[2 * numberOfEntries];
+        memcpy(keysAndObjects, m_keysAndObjects, 2 * dataIndex * sizeof(id));
+        memcpy(&keysAndObjects[2 * dataIndex], &m_keysAndObjects[2 * (dataIndex + 1)], 2 * (numberOfEntries - dataIndex - 1) * sizeof(id));
+        return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap & ~bit
+                                                                   nodeMap:m_nodeMap
+                                                            keysAndObjects:keysAndObjects
+                                                                  subnodes:m_subnodes] autorelease];
+    }
+    else if (m_nodeMap & bit) {
+        HLSPersistentDictionaryNode *subnode = m_subnodes[nodeIndex];
+        HLSPersistentDictionaryNode *updatedSubnode = [subnode nodeByRemovingObjectForKey:key
+                                                                                     hash:hash
+                                                                                    shift:shift + kHashBitsPerLevel
+                                                                                  removed:pRemoved];
+        if (updatedSubnode == subnode) {
+            return self;
+        }
+        
+        // A subnode left with a single entry is merged into this node, so that the trie stays as shallow as possible
+        if ([updatedSubnode numberOfSubnodes] == 0 && [updatedSubnode numberOfEntries] <= 1) {
+            HLSPersistentDictionaryNode *subnodes[numberOfSubnodes];
+            memcpy(subnodes, m_subnodes, nodeIndex * sizeof(HLSPersistentDictionaryNode *));
+            memcpy(&subnodes[nodeIndex], &m_subnodes[nodeIndex + 1], (numberOfSubnodes - nodeIndex - 1) * sizeof(HLSPersistentDictionaryNode *));
+            
+            if ([updatedSubnode numberOfEntries] == 0) {
+                return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap
+                                                                           nodeMap:m_nodeMap & ~bit
+                                                                    keysAndObjects:m_keysAndObjects
+                                                                          subnodes:subnodes] autorelease];
+            }
+            
+            id keysAndObjects[2 * (numberOfEntries + 1)];
+            memcpy(keysAndObjects, m_keysAndObjects, 2 * dataIndex * sizeof(id));
+            keysAndObjects[2 * dataIndex] = [updatedSubnode keyAtIndex:0];
+            keysAndObjects[2 * dataIndex + 1] = [updatedSubnode objectAtIndex:0];
+            memcpy(&keysAndObjects[2 * (dataIndex + 1)], &m_keysAndObjects[2 * dataIndex], 2 * (numberOfEntries - dataIndex) * sizeof(id));
+            return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap | bit
+                                                                       nodeMap:m_nodeMap & ~bit
+                                                                keysAndObjects:keysAndObjects
+                                                                      subnodes:subnodes] autorelease];
+        }
+        else {
+            HLSPersistentDictionaryNode *subnodes[numberOfSubnodes];
+            memcpy(subnodes, m_subnodes, numberOfSubnodes * sizeof(HLSPersistentDictionaryNode *));
+            subnodes[nodeIndex] = updatedSubnode;
+            return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:m_dataMap
+                                                                       nodeMap:m_nodeMap
+                                                                keysAndObjects:m_keysAndObjects
+                                                                      subnodes:subnodes] autorelease];
+        }
+    }
+    else {
+        return self;
+    }
+}
+
+@end
+
+@implementation HLSPersistentDictionaryCollisionNode
+
+#pragma mark Object creation and destruction
+
+- (id)initWithCount:(NSUInteger)count keysAndObjects:(id *)keysAndObjects
+{
+    if ((self = [super init])) {
+        m_count = count;
+        m_keysAndObjects = malloc(2 * count * sizeof(id));
+        for (NSUInteger i = 0; i < 2 * count; ++i) {
+            m_keysAndObjects[i] = [keysAndObjects[i] retain];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSUInteger i = 0; i < 2 * m_count; ++i) {
+        [m_keysAndObjects[i] release];
+    }
+    free(m_keysAndObjects);
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+- (NSUInteger)numberOfEntries
+{
+    return m_count;
+}
+
+- (id)keyAtIndex:(NSUInteger)index
+{
+    return m_keysAndObjects[2 * index];
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    return m_keysAndObjects[2 * index + 1];
+}
+
+- (NSUInteger)numberOfSubnodes
+{
+    return 0;
+}
+
+- (HLSPersistentDictionaryNode *)subnodeAtIndex:(NSUInteger)index
+{
+    return nil;
+}
+
+#pragma mark Lookup and modification
+
+// All keys reaching a collision node have the same hash, which therefore needs not be checked
+
+- (id)objectForKey:(id)key hash:(NSUInteger)hash shift:(NSUInteger)shift
+{
+    for (NSUInteger i = 0; i < m_count; ++i) {
+        if (HLSPersistentDictionaryKeysEqual(m_keysAndObjects[2 * i], key)) {
+            return m_keysAndObjects[2 * i + 1];
+        }
+    }
+    return nil;
+}
+
+- (HLSPersistentDictionaryNode *)nodeBySettingObject:(id)object
+                                              forKey:(id)key
+                                                hash:(NSUInteger)hash
+                                               shift:(NSUInteger)shift
+                                               added:(BOOL *)pAdded
+{
+    id keysAndObjects[2 * (m_count + 1)];
+    memcpy(keysAndObjects, m_keysAndObjects, 2 * m_count * sizeof(id));
+    
+    for (NSUInteger i = 0; i < m_count; ++i) {
+        if (HLSPersistentDictionaryKeysEqual(m_keysAndObjects[2 * i], key)) {
+            if (m_keysAndObjects[2 * i + 1] == object) {
+                return self;
+            }
+            
+            keysAndObjects[2 * i + 1] = object;
+            return [[[HLSPersistentDictionaryCollisionNode alloc] initWithCount:m_count keysAndObjects:keysAndObjects] autorelease];
+        }
+    }
+    
+    *pAdded = YES;
+    keysAndObjects[2 * m_count] = key;
+    keysAndObjects[2 * m_count + 1] = object;
+    return [[[HLSPersistentDictionaryCollisionNode alloc] initWithCount:m_count + 1 keysAndObjects:keysAndObjects] autorelease];
+}
+
+- (HLSPersistentDictionaryNode *)nodeByRemovingObjectForKey:(id)key
+                                                       hash:(NSUInteger)hash
+                                                      shift:(NSUInteger)shift
+                                                    removed:(BOOL *)pRemoved
+{
+    for (NSUInteger i = 0; i < m_count; ++i) {
+        if (HLSPersistentDictionaryKeysEqual(m_keysAndObjects[2 * i], key)) {
+            *pRemoved = YES;
+            
+            // A collision node left with a single entry is merged into its parent
+            id keysAndObjects[2 * m_count];
+            memcpy(keysAndObjects, m_keysAndObjects, 2 * i * sizeof(id));
+            memcpy(&keysAndObjects[2 * i], &m_keysAndObjects[2 * (i + 1)], 2 * (m_count - i - 1) * sizeof(id));
+            return [[[HLSPersistentDictionaryCollisionNode alloc] initWithCount:m_count - 1 keysAndObjects:keysAndObjects] autorelease];
+        }
+    }
+    return self;
+}
+
+@end
+
+@implementation HLSPersistentDictionaryKeyEnumerator
+
+#pragma mark Object creation and destruction
+
+- (id)initWithDictionary:(HLSPersistentDictionary *)dictionary rootNode:(HLSPersistentDictionaryNode *)rootNode
+{
+    if ((self = [super init])) {
+        // Keeps the nodes alive
+        m_dictionary = [dictionary retain];
+        m_nodes[0] = rootNode;
+        m_positions[0] = 0;
+        m_depth = 0;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_dictionary release];
+    
+    [super dealloc];
+}
+
+#pragma mark NSEnumerator methods
+
+- (id)nextObject
+{
+    while (m_depth >= 0) {
+        HLSPersistentDictionaryNode *node = m_nodes[m_depth];
+        NSUInteger position = m_positions[m_depth];
+        NSUInteger numberOfEntries = [node numberOfEntries];
+        
+        // Entries first, then subnodes
+        if (position < numberOfEntries) {
+            ++m_positions[m_depth];
+            return [node keyAtIndex:position];
+        }
+        else if (position - numberOfEntries < [node numberOfSubnodes]) {
+            ++m_positions[m_depth];
+            ++m_depth;
+            m_nodes[m_depth] = [node subnodeAtIndex:position - numberOfEntries];
+            m_positions[m_depth] = 0;
+        }
+        else {
+            --m_depth;
+        }
+    }
+    return nil;
+}
+
+@end
+
+static NSUInteger HLSPersistentDictionaryFragment(NSUInteger hash, NSUInteger shift)
+{
+    return (hash >> shift) & kHashLevelMask;
+}
+
+static BOOL HLSPersistentDictionaryKeysEqual(id key1, id key2)
+{
+    return key1 == key2 || [key1 isEqual:key2];
+}
+
+static HLSPersistentDictionaryNode *HLSPersistentDictionaryNodeMerge(id key1, id object1, NSUInteger hash1,
+                                                                     id key2, id object2, NSUInteger hash2,
+                                                                     NSUInteger shift)
+{
+    // All hash bits consumed
+    if (shift >= kHashBits) {
+        id keysAndObjects[4] = { key1, object1, key2, object2 };
+        return [[[HLSPersistentDictionaryCollisionNode alloc] initWithCount:2 keysAndObjects:keysAndObjects] autorelease];
+    }
+    
+    NSUInteger fragment1 = HLSPersistentDictionaryFragment(hash1, shift);
+    NSUInteger fragment2 = HLSPersistentDictionaryFragment(hash2, shift);
+    if (fragment1 != fragment2) {
+        id keysAndObjects[4];
+        if (fragment1 < fragment2) {
+            keysAndObjects[0] = key1;
+            keysAndObjects[1] = object1;
+            keysAndObjects[2] = key2;
+            keysAndObjects[3] = object2;
+        }
+        else {
+            keysAndObjects[0] = key2;
+            keysAndObjects[1] = object2;
+            keysAndObjects[2] = key1;
+            keysAndObjects[3] = object1;
+        }
+        return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:(1U << fragment1) | (1U << fragment2)
+                                                                   nodeMap:0
+                                                            keysAndObjects:keysAndObjects
+                                                                  subnodes:NULL] autorelease];
+    }
+    else {
+        HLSPersistentDictionaryNode *subnode = HLSPersistentDictionaryNodeMerge(key1, object1, hash1, key2, object2, hash2,
+                                                                                shift + kHashBitsPerLevel);
+        return [[[HLSPersistentDictionaryBitmapNode alloc] initWithDataMap:0
+                                                                   nodeMap:1U << fragment1
+                                                            keysAndObjects:NULL
+                                                                  subnodes:&subnode] autorelease];
+    }
+}
@@ -20,12 +20,105 @@
  */
 void instrumentObjcMessageSends(BOOL start);
 
+/**
+ * In-memory message send profiler, much cheaper than instrumentObjcMessageSends since nothing is written to disk.
+ * Start it before the code region to profile and stop it afterwards. While the profiler is running, one message out
+ * of samplingInterval (1 to count all messages) is counted per (receiver class, selector) pair, for receiver classes
+ * whose name starts with classNamePrefix (nil to profile all classes). Profiling results are accumulated over 
+ * successive runs until they are reset.
+ *
+ * HLSMessageSendProfilerReport() returns the maximumCount most frequent messages, with counts extrapolated from the
+ * sampling interval, most frequent first. If several threads send messages while the profiler is running, all of
+ * them are counted.
+ *
+ * Remarks:
+ *   - the profiler relies on the same (private) Objective-C runtime mechanism as instrumentObjcMessageSends. Once
+ *     the profiler has been started, instrumentObjcMessageSends does not log messages to disk anymore
+ *   - while the profiler is running, methods of the profiled classes are not cached, i.e. messaging them is much 
+ *     slower than usual. Use profiling results to compare message counts, not durations. Other classes are looked up
+ *     once and cached as usual. Prefer a class name prefix to profiling all classes, which slows down the whole
+ *     process
+ */
+void HLSMessageSendProfilerStart(NSString *classNamePrefix, NSUInteger samplingInterval);
+void HLSMessageSendProfilerStop(void);
+void HLSMessageSendProfilerReset(void);
+NSString *HLSMessageSendProfilerReport(NSUInteger maximumCount);
+
 /**
  * Replace the implementation of a class method, given its selector. Return the original implementation
+ *
+ * All swizzles are recorded in a registry (see HLSSwizzlingReport()). Installing the same implementation twice
+ * for a class and selector, even with other swizzles in between, is an error, reported in the logs: The method is not
+ * swizzled again, and the original implementation recorded the first time is returned (so that the implementation
+ * does not end up calling itself).
+ * Swizzling a method already swizzled with another implementation is reported as a warning
  */
 IMP HLSSwizzleClassSelector(Class clazz, SEL selector, IMP newImplementation);
 
 /**
  * Replace the implementation of an instance method, given its selector. Return the original implementation
+ *
+ * Swizzles are recorded and checked as for HLSSwizzleClassSelector
  */
 IMP HLSSwizzleSelector(Class clazz, SEL selector, IMP newImplementation);
+
+/**
+ * Return the implementation which was replaced when a method was last swizzled using HLSSwizzleClassSelector or
+ * HLSSwizzleSelector, NULL if the method has not been swizzled
+ */
+IMP HLSOriginalClassSelectorImplementation(Class clazz, SEL selector);
+IMP HLSOriginalSelectorImplementation(Class clazz, SEL selector);
+
+/**
+ * Return all classes inheriting (directly or not) from a class, the class itself excluded, in no specific order.
+ *
+ * The list of classes is only retrieved from the runtime once, and results are cached for each class, so that
+ * repeated queries are cheap. Cached information is discarded when new images (e.g. bundles) are loaded
+ */
+NSArray *HLSSubclassesOfClass(Class clazz);
+
+/**
+ * Return a description of all swizzles performed so far, the function which installed them (if symbols are available),
+ * and the corresponding profiling information (see below)
+ */
+NSString *HLSSwizzlingReport(void);
+
+/**
+ * Swizzled implementations can be profiled by adding HLSProfileSwizzledSelector (respectively HLSProfileSwizzledClassSelector
+ * for class methods) at the beginning of their body, with the class and selector which were swizzled. If HLS_SWIZZLING_PROFILING is added to your configuration preprocessor
+ * flags (-DHLS_SWIZZLING_PROFILING), the number of calls and the total time spent in the implementation are recorded
+ * and can be displayed using HLSSwizzlingReport(). Otherwise the macro does nothing
+ */
+#ifdef HLS_SWIZZLING_PROFILING
+
+typedef struct {
+    volatile int64_t callCount;
+    volatile int64_t totalTime;             // In mach_absolute_time units
+} HLSSwizzlingProfile;
+
+typedef struct {
+    HLSSwizzlingProfile *profile;
+    uint64_t startTime;
+} HLSSwizzlingProfileScope;
+
+HLSSwizzlingProfile *HLSSwizzlingProfileForSelector(Class clazz, SEL selector, BOOL classMethod);
+HLSSwizzlingProfileScope HLSSwizzlingProfileScopeBegin(HLSSwizzlingProfile *profile);
+void HLSSwizzlingProfileScopeEnd(HLSSwizzlingProfileScope *pScope);
+
+// The profile is looked up once per call site. The scope is closed when the implementation returns
+#define HLSSwizzlingProfileImplementation(clazz, selector, classMethod)                                                 \
+    static HLSSwizzlingProfile *__HLSSwizzlingProfile = NULL;                                                           \
+    if (! __HLSSwizzlingProfile) {                                                                                      \
+        __HLSSwizzlingProfile = HLSSwizzlingProfileForSelector(clazz, selector, classMethod);                           \
+    }                                                                                                                   \
+    HLSSwizzlingProfileScope __HLSSwizzlingProfileScope __attribute__((cleanup(HLSSwizzlingProfileScopeEnd)))           \
+        = HLSSwizzlingProfileScopeBegin(__HLSSwizzlingProfile)
+
+#else
+
+#define HLSSwizzlingProfileImplementation(clazz, selector, classMethod)
+
+#endif
+
+#define HLSProfileSwizzledClassSelector(clazz, selector)        HLSSwizzlingProfileImplementation(clazz, selector, YES)
+#define HLSProfileSwizzledSelector(clazz, selector)             HLSSwizzlingProfileImplementation(clazz, selector, NO)
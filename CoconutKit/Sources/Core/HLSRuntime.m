@@ -8,29 +8,505 @@
 
 #import "HLSRuntime.h"
 
+#import <dlfcn.h>
+#import <libkern/OSAtomic.h>
+#import <mach-o/dyld.h>
+#import <mach/mach_time.h>
+#import <pthread.h>
+#import "HLSLogger.h"
+
+// Information about a swizzle. Records are kept for the whole application lifetime
+typedef struct HLSSwizzlingRecord {
+    CFStringRef name;                                   // -[Class selector] or +[Class selector]
+    IMP originalImplementation;
+    IMP implementation;
+    const void *installationAddress;                    // Address of the code which requested the swizzle
+    struct HLSSwizzlingRecord *previousRecord;          // Previous swizzle of the same method, if any
+#ifdef HLS_SWIZZLING_PROFILING
+    HLSSwizzlingProfile profile;
+#endif
+} HLSSwizzlingRecord;
+
+// Registry of all swizzles, by name (most recent swizzle for a method) and in installation order
+static CFMutableDictionaryRef s_nameToSwizzlingRecordMap = NULL;
+static CFMutableArrayRef s_swizzlingRecords = NULL;
+static pthread_mutex_t s_swizzlingRegistryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Subclass cache. The direct subclass map is built from a single scan of the class list, the subclass map is filled
+// lazily when subclasses of a class are requested. Both are discarded when the image generation changes
+static CFMutableDictionaryRef s_classToDirectSubclassesMap = NULL;
+static CFMutableDictionaryRef s_classToSubclassesMap = NULL;
+static int32_t s_subclassCacheGeneration = 0;
+static volatile int32_t s_imageGeneration = 0;
+static pthread_mutex_t s_subclassCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Private Objective-C runtime function, used by instrumentObjcMessageSends. The log function is called for each message
+// whose implementation is looked up (i.e. not found in method caches). It returns whether the implementation can be
+// cached
+typedef BOOL (*HLSObjCLogProc)(BOOL isClassMethod, const char *objectsClass, const char *implementingClass, SEL selector);
+void logObjcMessageSends(HLSObjCLogProc logProc);
+
+// Message send profiler entries (open addressing hash table). Must be plain C since no messages can be sent when
+// counting messages. Class names returned by the runtime are never freed and can be compared by address
+#define kMessageSendProfilerCapacity 16384
+
+typedef struct {
+    const char *className;                          // NULL if unused
+    const char *implementingClassName;
+    SEL selector;
+    BOOL classMethod;
+    uint64_t count;
+} HLSMessageSendProfilerEntry;
+
+static HLSMessageSendProfilerEntry *s_messageSendProfilerEntries = NULL;
+static uint64_t s_messageSendProfilerDroppedCount = 0;
+static NSUInteger s_messageSendProfilerSamplingInterval = 1;
+static char *s_messageSendProfilerClassNamePrefix = NULL;          // NULL to profile all classes
+static size_t s_messageSendProfilerClassNamePrefixLength = 0;
+static volatile int32_t s_messageSendProfilerSampleCounter = 0;
+static volatile BOOL s_messageSendProfilerRunning = NO;
+static OSSpinLock s_messageSendProfilerLock = OS_SPINLOCK_INIT;
+
+// Static functions
+static BOOL HLSMessageSendProfilerLog(BOOL isClassMethod, const char *objectsClass, const char *implementingClass, SEL selector);
+static int HLSMessageSendProfilerEntryCompare(const void *entry1, const void *entry2);
+static void HLSRuntimeImageAdded(const struct mach_header *header, intptr_t slide);
+static void HLSAddSubclasses(Class clazz, CFMutableArrayRef subclasses);
+static IMP HLSSwizzleMethod(Class clazz, SEL selector, IMP newImplementation, BOOL classMethod, const void *installationAddress);
+static CFStringRef HLSSwizzlingRecordNameCreate(Class clazz, SEL selector, BOOL classMethod);
+static HLSSwizzlingRecord *HLSSwizzlingRecordLookup(Class clazz, SEL selector, BOOL classMethod);
+static NSString *HLSInstallationSiteDescription(const void *address);
+
+void HLSMessageSendProfilerStart(NSString *classNamePrefix, NSUInteger samplingInterval)
+{
+    if (s_messageSendProfilerRunning) {
+        HLSLoggerWarn(@"The message send profiler is already running");
+        return;
+    }
+    
+    OSSpinLockLock(&s_messageSendProfilerLock);
+    if (! s_messageSendProfilerEntries) {
+        s_messageSendProfilerEntries = calloc(kMessageSendProfilerCapacity, sizeof(HLSMessageSendProfilerEntry));
+    }
+    s_messageSendProfilerSamplingInterval = samplingInterval;
+    if (s_messageSendProfilerSamplingInterval == 0) {
+        s_messageSendProfilerSamplingInterval = 1;
+    }
+    OSSpinLockUnlock(&s_messageSendProfilerLock);
+    
+    // Only read by the log function while the profiler is running
+    free(s_messageSendProfilerClassNamePrefix);
+    if ([classNamePrefix length] != 0) {
+        s_messageSendProfilerClassNamePrefix = strdup([classNamePrefix UTF8String]);
+        s_messageSendProfilerClassNamePrefixLength = strlen(s_messageSendProfilerClassNamePrefix);
+    }
+    else {
+        s_messageSendProfilerClassNamePrefix = NULL;
+        s_messageSendProfilerClassNamePrefixLength = 0;
+    }
+    
+    // Installing the log function enables logging. Enabling it again flushes method caches, so that all messages
+    // are seen
+    s_messageSendProfilerRunning = YES;
+    logObjcMessageSends(HLSMessageSendProfilerLog);
+    instrumentObjcMessageSends(YES);
+}
+
+void HLSMessageSendProfilerStop(void)
+{
+    if (! s_messageSendProfilerRunning) {
+        return;
+    }
+    
+    // The log function stays installed (the runtime default one cannot be restored)
+    instrumentObjcMessageSends(NO);
+    s_messageSendProfilerRunning = NO;
+}
+
+void HLSMessageSendProfilerReset(void)
+{
+    OSSpinLockLock(&s_messageSendProfilerLock);
+    if (s_messageSendProfilerEntries) {
+        memset(s_messageSendProfilerEntries, 0, kMessageSendProfilerCapacity * sizeof(HLSMessageSendProfilerEntry));
+    }
+    s_messageSendProfilerDroppedCount = 0;
+    OSSpinLockUnlock(&s_messageSendProfilerLock);
+}
+
+NSString *HLSMessageSendProfilerReport(NSUInteger maximumCount)
+{
+    // Copy the entries so that no message is sent with the lock held (the profiler might be running)
+    HLSMessageSendProfilerEntry *entries = calloc(kMessageSendProfilerCapacity, sizeof(HLSMessageSendProfilerEntry));
+    uint64_t samplingInterval = 0;
+    uint64_t droppedCount = 0;
+    OSSpinLockLock(&s_messageSendProfilerLock);
+    if (s_messageSendProfilerEntries) {
+        memcpy(entries, s_messageSendProfilerEntries, kMessageSendProfilerCapacity * sizeof(HLSMessageSendProfilerEntry));
+    }
+    samplingInterval = s_messageSendProfilerSamplingInterval;
+    droppedCount = s_messageSendProfilerDroppedCount;
+    OSSpinLockUnlock(&s_messageSendProfilerLock);
+    
+    qsort(entries, kMessageSendProfilerCapacity, sizeof(HLSMessageSendProfilerEntry), HLSMessageSendProfilerEntryCompare);
+    
+    uint64_t totalCount = 0;
+    for (NSUInteger i = 0; i < kMessageSendProfilerCapacity && entries[i].className; ++i) {
+        totalCount += entries[i].count;
+    }
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"%llu messages sampled (1 out of %llu)", totalCount, samplingInterval];
+    if (droppedCount != 0) {
+        [report appendFormat:@", %llu dropped (too many distinct messages)", droppedCount];
+    }
+    [report appendString:@"\n"];
+    
+    for (NSUInteger i = 0; i < maximumCount && i < kMessageSendProfilerCapacity && entries[i].className; ++i) {
+        HLSMessageSendProfilerEntry *entry = &entries[i];
+        [report appendFormat:@"%10llu  %c[%s %s]", entry->count * samplingInterval, entry->classMethod ? '+' : '-', 
+         entry->className, sel_getName(entry->selector)];
+        if (strcmp(entry->className, entry->implementingClassName) != 0) {
+            [report appendFormat:@" (implemented by %s)", entry->implementingClassName];
+        }
+        [report appendString:@"\n"];
+    }
+    free(entries);
+    
+    return [NSString stringWithString:report];
+}
+
 IMP HLSSwizzleClassSelector(Class clazz, SEL selector, IMP newImplementation)
 {
-    // Get the original implementation we are replacing
-    Class metaClass = objc_getMetaClass(class_getName(clazz));
-    Method method = class_getClassMethod(metaClass, selector);
-    IMP origImp = method_getImplementation(method);
-    if (! origImp) {
+    return HLSSwizzleMethod(clazz, selector, newImplementation, YES, __builtin_return_address(0));
+}
+
+IMP HLSSwizzleSelector(Class clazz, SEL selector, IMP newImplementation)
+{
+    return HLSSwizzleMethod(clazz, selector, newImplementation, NO, __builtin_return_address(0));
+}
+
+IMP HLSOriginalClassSelectorImplementation(Class clazz, SEL selector)
+{
+    HLSSwizzlingRecord *record = HLSSwizzlingRecordLookup(clazz, selector, YES);
+    return record ? record->originalImplementation : NULL;
+}
+
+IMP HLSOriginalSelectorImplementation(Class clazz, SEL selector)
+{
+    HLSSwizzlingRecord *record = HLSSwizzlingRecordLookup(clazz, selector, NO);
+    return record ? record->originalImplementation : NULL;
+}
+
+NSArray *HLSSubclassesOfClass(Class clazz)
+{
+    if (! clazz) {
+        return nil;
+    }
+    
+    // Called for all images already loaded, and then each time a new one is loaded
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        _dyld_register_func_for_add_image(HLSRuntimeImageAdded);
+    });
+    
+    pthread_mutex_lock(&s_subclassCacheMutex);
+    
+    int32_t imageGeneration = s_imageGeneration;
+    if (! s_classToDirectSubclassesMap || s_subclassCacheGeneration != imageGeneration) {
+        if (s_classToDirectSubclassesMap) {
+            CFRelease(s_classToDirectSubclassesMap);
+            CFRelease(s_classToSubclassesMap);
+        }
+        s_classToDirectSubclassesMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        s_classToSubclassesMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        s_subclassCacheGeneration = imageGeneration;
+        
+        // Messages must not be sent to the classes returned (some of them do not behave like NSObject subclasses)
+        unsigned int numberOfClasses = 0;
+        Class *classes = objc_copyClassList(&numberOfClasses);
+        for (unsigned int i = 0; i < numberOfClasses; ++i) {
+            Class superclass = class_getSuperclass(classes[i]);
+            if (! superclass) {
+                continue;
+            }
+            
+            CFMutableArrayRef directSubclasses = (CFMutableArrayRef)CFDictionaryGetValue(s_classToDirectSubclassesMap, superclass);
+            if (! directSubclasses) {
+                directSubclasses = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+                CFDictionarySetValue(s_classToDirectSubclassesMap, superclass, directSubclasses);
+                CFRelease(directSubclasses);
+            }
+            CFArrayAppendValue(directSubclasses, classes[i]);
+        }
+        free(classes);
+    }
+    
+    NSArray *subclasses = (NSArray *)CFDictionaryGetValue(s_classToSubclassesMap, clazz);
+    if (! subclasses) {
+        CFMutableArrayRef allSubclasses = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+        HLSAddSubclasses(clazz, allSubclasses);
+        CFDictionarySetValue(s_classToSubclassesMap, clazz, allSubclasses);
+        CFRelease(allSubclasses);
+        subclasses = (NSArray *)allSubclasses;
+    }
+    
+    // The cache might be discarded on another thread
+    [[subclasses retain] autorelease];
+    
+    pthread_mutex_unlock(&s_subclassCacheMutex);
+    
+    return subclasses;
+}
+
+NSString *HLSSwizzlingReport(void)
+{
+#ifdef HLS_SWIZZLING_PROFILING
+    mach_timebase_info_data_t timebaseInfo;
+    mach_timebase_info(&timebaseInfo);
+#endif
+    
+    NSMutableString *report = [NSMutableString string];
+    
+    pthread_mutex_lock(&s_swizzlingRegistryMutex);
+    CFIndex count = s_swizzlingRecords ? CFArrayGetCount(s_swizzlingRecords) : 0;
+    for (CFIndex i = 0; i < count; ++i) {
+        HLSSwizzlingRecord *record = (HLSSwizzlingRecord *)CFArrayGetValueAtIndex(s_swizzlingRecords, i);
+        [report appendFormat:@"%@ installed by %@ (original implementation: %p)", 
+         (NSString *)record->name, 
+         HLSInstallationSiteDescription(record->installationAddress),
+         record->originalImplementation];
+#ifdef HLS_SWIZZLING_PROFILING
+        double totalTime = (double)record->profile.totalTime * timebaseInfo.numer / timebaseInfo.denom / 1e6;
+        [report appendFormat:@"; calls: %lld; total time: %.3f ms", record->profile.callCount, totalTime];
+#endif
+        [report appendString:@"\n"];
+    }
+    pthread_mutex_unlock(&s_swizzlingRegistryMutex);
+    
+    return [NSString stringWithString:report];
+}
+
+#ifdef HLS_SWIZZLING_PROFILING
+
+HLSSwizzlingProfile *HLSSwizzlingProfileForSelector(Class clazz, SEL selector, BOOL classMethod)
+{
+    HLSSwizzlingRecord *record = HLSSwizzlingRecordLookup(clazz, selector, classMethod);
+    if (! record) {
+        HLSLoggerWarn(@"%c[%s %s] has not been swizzled and cannot be profiled", classMethod ? '+' : '-', class_getName(clazz), 
+                      sel_getName(selector));
         return NULL;
     }
+    return &record->profile;
+}
+
+HLSSwizzlingProfileScope HLSSwizzlingProfileScopeBegin(HLSSwizzlingProfile *profile)
+{
+    HLSSwizzlingProfileScope scope;
+    scope.profile = profile;
+    scope.startTime = profile ? mach_absolute_time() : 0;
+    return scope;
+}
+
+void HLSSwizzlingProfileScopeEnd(HLSSwizzlingProfileScope *pScope)
+{
+    if (! pScope->profile) {
+        return;
+    }
     
-    class_replaceMethod(metaClass, selector, newImplementation, method_getTypeEncoding(method));
-    return origImp;
+    OSAtomicIncrement64(&pScope->profile->callCount);
+    OSAtomicAdd64((int64_t)(mach_absolute_time() - pScope->startTime), &pScope->profile->totalTime);
 }
 
-IMP HLSSwizzleSelector(Class clazz, SEL selector, IMP newImplementation)
+#endif
+
+// Called by the Objective-C runtime from within objc_msgSend. Must not send any message
+static BOOL HLSMessageSendProfilerLog(BOOL isClassMethod, const char *objectsClass, const char *implementingClass, SEL selector)
+{
+    // Stopped. Let the runtime cache implementations again
+    if (! s_messageSendProfilerRunning) {
+        return YES;
+    }
+    
+    // Out of scope. Let the runtime cache the implementation so that messaging stays fast for other classes
+    if (s_messageSendProfilerClassNamePrefix 
+            && strncmp(objectsClass, s_messageSendProfilerClassNamePrefix, s_messageSendProfilerClassNamePrefixLength) != 0) {
+        return YES;
+    }
+    
+    if (s_messageSendProfilerSamplingInterval != 1 
+            && OSAtomicIncrement32(&s_messageSendProfilerSampleCounter) % s_messageSendProfilerSamplingInterval != 0) {
+        return NO;
+    }
+    
+    uintptr_t hash = ((uintptr_t)objectsClass >> 3) ^ ((uintptr_t)selector >> 2) ^ (uintptr_t)isClassMethod;
+    
+    OSSpinLockLock(&s_messageSendProfilerLock);
+    NSUInteger index = hash % kMessageSendProfilerCapacity;
+    for (NSUInteger i = 0; i < kMessageSendProfilerCapacity; ++i) {
+        HLSMessageSendProfilerEntry *entry = &s_messageSendProfilerEntries[index];
+        if (! entry->className) {
+            entry->className = objectsClass;
+            entry->implementingClassName = implementingClass;
+            entry->selector = selector;
+            entry->classMethod = isClassMethod;
+            entry->count = 1;
+            break;
+        }
+        else if (entry->className == objectsClass && entry->selector == selector && entry->classMethod == isClassMethod) {
+            ++entry->count;
+            break;
+        }
+        
+        index = (index + 1) % kMessageSendProfilerCapacity;
+        
+        // Table full
+        if (i == kMessageSendProfilerCapacity - 1) {
+            ++s_messageSendProfilerDroppedCount;
+        }
+    }
+    OSSpinLockUnlock(&s_messageSendProfilerLock);
+    
+    // Do not cache the implementation, otherwise further messages would not be seen
+    return NO;
+}
+
+// Most frequent first, unused entries last
+static int HLSMessageSendProfilerEntryCompare(const void *entry1, const void *entry2)
+{
+    uint64_t count1 = ((const HLSMessageSendProfilerEntry *)entry1)->count;
+    uint64_t count2 = ((const HLSMessageSendProfilerEntry *)entry2)->count;
+    if (count1 > count2) {
+        return -1;
+    }
+    else if (count1 < count2) {
+        return 1;
+    }
+    else {
+        return 0;
+    }
+}
+
+// Called by dyld, possibly with its lock held. Do not take any lock here
+static void HLSRuntimeImageAdded(const struct mach_header *header, intptr_t slide)
+{
+    OSAtomicIncrement32Barrier(&s_imageGeneration);
+}
+
+// Classes are collected without being retained, which would send them +initialize
+static void HLSAddSubclasses(Class clazz, CFMutableArrayRef subclasses)
+{
+    CFArrayRef directSubclasses = CFDictionaryGetValue(s_classToDirectSubclassesMap, clazz);
+    if (! directSubclasses) {
+        return;
+    }
+    
+    CFIndex count = CFArrayGetCount(directSubclasses);
+    for (CFIndex i = 0; i < count; ++i) {
+        Class subclass = (Class)CFArrayGetValueAtIndex(directSubclasses, i);
+        CFArrayAppendValue(subclasses, subclass);
+        HLSAddSubclasses(subclass, subclasses);
+    }
+}
+
+static IMP HLSSwizzleMethod(Class clazz, SEL selector, IMP newImplementation, BOOL classMethod, const void *installationAddress)
 {
     // Get the original implementation we are replacing
-    Method method = class_getInstanceMethod(clazz, selector);
+    Class targetClass = Nil;
+    Method method = NULL;
+    if (classMethod) {
+        targetClass = objc_getMetaClass(class_getName(clazz));
+        method = class_getClassMethod(targetClass, selector);
+    }
+    else {
+        targetClass = clazz;
+        method = class_getInstanceMethod(clazz, selector);
+    }
+    
     IMP origImp = method_getImplementation(method);
     if (! origImp) {
         return NULL;
     }
     
-    class_replaceMethod(clazz, selector, newImplementation, method_getTypeEncoding(method));
+    pthread_mutex_lock(&s_swizzlingRegistryMutex);
+    
+    if (! s_nameToSwizzlingRecordMap) {
+        s_nameToSwizzlingRecordMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+        s_swizzlingRecords = CFArrayCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    
+    CFStringRef name = HLSSwizzlingRecordNameCreate(clazz, selector, classMethod);
+    HLSSwizzlingRecord *previousRecord = (HLSSwizzlingRecord *)CFDictionaryGetValue(s_nameToSwizzlingRecordMap, name);
+    
+    // Double swizzle (e.g. a +load method called twice), possibly with other swizzles in between (A-B-A). Swizzling
+    // again would make the implementation call itself, directly or through the implementations installed meanwhile
+    HLSSwizzlingRecord *sameImplementationRecord = previousRecord;
+    while (sameImplementationRecord && sameImplementationRecord->implementation != newImplementation) {
+        sameImplementationRecord = sameImplementationRecord->previousRecord;
+    }
+    if (sameImplementationRecord) {
+        pthread_mutex_unlock(&s_swizzlingRegistryMutex);
+        
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        HLSLoggerError(@"%@ has already been swizzled with the same implementation by %@. Swizzle requested by %@ ignored", 
+                       (NSString *)name, HLSInstallationSiteDescription(sameImplementationRecord->installationAddress), 
+                       HLSInstallationSiteDescription(installationAddress));
+        [pool drain];
+        
+        CFRelease(name);
+        return sameImplementationRecord->originalImplementation;
+    }
+    
+    class_replaceMethod(targetClass, selector, newImplementation, method_getTypeEncoding(method));
+    
+    HLSSwizzlingRecord *record = calloc(1, sizeof(HLSSwizzlingRecord));
+    record->name = name;
+    record->originalImplementation = origImp;
+    record->implementation = newImplementation;
+    record->installationAddress = installationAddress;
+    record->previousRecord = previousRecord;
+    CFDictionarySetValue(s_nameToSwizzlingRecordMap, name, record);
+    CFArrayAppendValue(s_swizzlingRecords, record);
+    
+    pthread_mutex_unlock(&s_swizzlingRegistryMutex);
+    
+    if (previousRecord) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        HLSLoggerWarn(@"%@ swizzled by %@ has been swizzled again by %@", (NSString *)name, 
+                      HLSInstallationSiteDescription(previousRecord->installationAddress), 
+                      HLSInstallationSiteDescription(installationAddress));
+        [pool drain];
+    }
+    
     return origImp;
 }
+
+static CFStringRef HLSSwizzlingRecordNameCreate(Class clazz, SEL selector, BOOL classMethod)
+{
+    return CFStringCreateWithFormat(kCFAllocatorDefault, NULL, CFSTR("%c[%s %s]"), classMethod ? '+' : '-', 
+                                    class_getName(clazz), sel_getName(selector));
+}
+
+static HLSSwizzlingRecord *HLSSwizzlingRecordLookup(Class clazz, SEL selector, BOOL classMethod)
+{
+    CFStringRef name = HLSSwizzlingRecordNameCreate(clazz, selector, classMethod);
+    
+    pthread_mutex_lock(&s_swizzlingRegistryMutex);
+    HLSSwizzlingRecord *record = NULL;
+    if (s_nameToSwizzlingRecordMap) {
+        record = (HLSSwizzlingRecord *)CFDictionaryGetValue(s_nameToSwizzlingRecordMap, name);
+    }
+    pthread_mutex_unlock(&s_swizzlingRegistryMutex);
+    
+    CFRelease(name);
+    return record;
+}
+
+static NSString *HLSInstallationSiteDescription(const void *address)
+{
+    Dl_info info;
+    if (dladdr(address, &info) != 0 && info.dli_sname) {
+        return [NSString stringWithUTF8String:info.dli_sname];
+    }
+    else {
+        return [NSString stringWithFormat:@"%p", address];
+    }
+}
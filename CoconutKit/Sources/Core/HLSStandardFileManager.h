@@ -10,7 +10,26 @@
 
 /**
  * A standard NSFileManager-based file manager
+ *
+ * By default, files are read using -contentsOfFileAtPath:error: with NSDataReadingMappedIfSafe, i.e. Foundation decides
+ * whether they are memory-mapped. When a mapping threshold is set, files whose size is at least mappingThreshold are
+ * always memory-mapped (read-only), so that their pages are loaded on demand and can be reclaimed by the system under
+ * memory pressure, instead of increasing the resident heap. This is especially useful for large read-only assets (e.g.
+ * map tiles or bundled databases). Remark that a mapped file must not be modified while its data is in use, which is
+ * why mapping is opt-in
  */
-@interface HLSStandardFileManager : HLSFileManager
+@interface HLSStandardFileManager : HLSFileManager {
+@private
+    unsigned long long m_mappingThreshold;
+}
+
+/**
+ * Minimum size (in bytes) of files to be always memory-mapped when read. Set to 0 to map all files. A value of 64 KB 
+ * is a good choice for large assets, smaller files being better read into memory (mapping them would waste most of 
+ * a page and a mapping entry)
+ *
+ * Default value is ULLONG_MAX (Foundation decides)
+ */
+@property (nonatomic, assign) unsigned long long mappingThreshold;
 
 @end
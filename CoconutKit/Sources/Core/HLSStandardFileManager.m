@@ -8,6 +8,11 @@
 
 #import "HLSStandardFileManager.h"
 
+#import <dirent.h>
+#import <fcntl.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
 __attribute__ ((constructor)) static void HLSStandardFileManagerInstall(void)
 {
     HLSStandardFileManager *fileManager = [[[HLSStandardFileManager alloc] init] autorelease];
@@ -16,11 +21,105 @@ __attribute__ ((constructor)) static void HLSStandardFileManagerInstall(void)
 
 @implementation HLSStandardFileManager
 
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        // Mapping is opt-in
+        m_mappingThreshold = ULLONG_MAX;
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize mappingThreshold = m_mappingThreshold;
+
 #pragma mark DMSFileManagerAbstract protocol implementation
 
 - (NSData *)contentsOfFileAtPath:(NSString *)path error:(NSError **)pError
 {
-    return [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:pError];
+    // Unless a threshold has been set, let Foundation decide (NSDataReadingMappedIfSafe). If the size cannot be
+    // obtained, let the read below report the error
+    struct stat fileStat;
+    if (self.mappingThreshold != ULLONG_MAX && stat([path fileSystemRepresentation], &fileStat) == 0 
+            && (unsigned long long)fileStat.st_size >= self.mappingThreshold) {
+        return [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:pError];
+    }
+    else {
+        return [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:pError];
+    }
+}
+
+- (NSData *)contentsOfFileAtPath:(NSString *)path range:(NSRange)range error:(NSError **)pError
+{
+    int fileDescriptor = open([path fileSystemRepresentation], O_RDONLY);
+    if (fileDescriptor < 0) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:errno
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        return nil;
+    }
+    
+    // Clamp the range to the file length first, so that no buffer larger than the file is allocated
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:errno
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        close(fileDescriptor);
+        return nil;
+    }
+    
+    unsigned long long fileLength = (unsigned long long)fileStat.st_size;
+    NSUInteger length = 0;
+    if (range.location < fileLength) {
+        length = (NSUInteger)MIN((unsigned long long)range.length, fileLength - range.location);
+    }
+    
+    // Read only the requested bytes (pread does not move the file offset, and stops at the end of the file if it
+    // has been truncated meanwhile)
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    NSUInteger readLength = 0;
+    while (readLength < length) {
+        ssize_t result = pread(fileDescriptor, (uint8_t *)[data mutableBytes] + readLength, length - readLength, range.location + readLength);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            
+            if (pError) {
+                *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                              code:errno
+                                          userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+            }
+            close(fileDescriptor);
+            return nil;
+        }
+        else if (result == 0) {
+            break;
+        }
+        readLength += result;
+    }
+    close(fileDescriptor);
+    
+    [data setLength:readLength];
+    return data;
+}
+
+- (NSInputStream *)inputStreamForFileAtPath:(NSString *)path
+{
+    return [NSInputStream inputStreamWithFileAtPath:path];
+}
+
+- (NSOutputStream *)outputStreamForFileAtPath:(NSString *)path append:(BOOL)append
+{
+    return [NSOutputStream outputStreamToFileAtPath:path append:append];
 }
 
 - (BOOL)createFileAtPath:(NSString *)path contents:(NSData *)contents error:(NSError **)pError
@@ -38,6 +137,70 @@ __attribute__ ((constructor)) static void HLSStandardFileManagerInstall(void)
     return [[NSFileManager defaultManager] contentsOfDirectoryAtPath:path error:pError];
 }
 
+- (BOOL)enumerateContentsOfDirectoryAtPath:(NSString *)path
+                                usingBlock:(void (^)(HLSFileEntry *entry, BOOL *pStop))block
+                                     error:(NSError **)pError
+{
+    DIR *directory = opendir([path fileSystemRepresentation]);
+    if (! directory) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:errno
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        return NO;
+    }
+    
+    // Entry paths are built in a single buffer. Symbolic links are followed, as for -fileExistsAtPath:isDirectory:
+    char entryPath[PATH_MAX];
+    int directoryPathLength = snprintf(entryPath, sizeof(entryPath), "%s/", [path fileSystemRepresentation]);
+    if (directoryPathLength >= (int)sizeof(entryPath)) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:ENAMETOOLONG
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        closedir(directory);
+        return NO;
+    }
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    
+    BOOL stop = NO;
+    NSUInteger nbrEntries = 0;
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    struct dirent *directoryEntry = NULL;
+    while (! stop && (directoryEntry = readdir(directory))) {
+        if (strcmp(directoryEntry->d_name, ".") == 0 || strcmp(directoryEntry->d_name, "..") == 0) {
+            continue;
+        }
+        
+        strlcpy(entryPath + directoryPathLength, directoryEntry->d_name, sizeof(entryPath) - directoryPathLength);
+        struct stat entryStat;
+        if (stat(entryPath, &entryStat) != 0) {
+            // E.g. broken symbolic link, or entry removed in the meantime
+            continue;
+        }
+        
+        NSString *name = [fileManager stringWithFileSystemRepresentation:directoryEntry->d_name length:strlen(directoryEntry->d_name)];
+        NSDate *modificationDate = [NSDate dateWithTimeIntervalSince1970:entryStat.st_mtimespec.tv_sec + entryStat.st_mtimespec.tv_nsec / 1e9];
+        HLSFileEntry *entry = [[[HLSFileEntry alloc] initWithName:name
+                                                        directory:S_ISDIR(entryStat.st_mode)
+                                                             size:entryStat.st_size
+                                                 modificationDate:modificationDate] autorelease];
+        block(entry, &stop);
+        
+        // Large directories
+        if (++nbrEntries % 256 == 0) {
+            [pool drain];
+            pool = [[NSAutoreleasePool alloc] init];
+        }
+    }
+    [pool drain];
+    
+    closedir(directory);
+    return YES;
+}
+
 - (BOOL)fileExistsAtPath:(NSString *)path isDirectory:(BOOL *)pIsDirectory
 {
     return [[NSFileManager defaultManager] fileExistsAtPath:path isDirectory:pIsDirectory];
@@ -58,4 +221,38 @@ __attribute__ ((constructor)) static void HLSStandardFileManagerInstall(void)
     return [[NSFileManager defaultManager] removeItemAtPath:path error:pError];
 }
 
+- (BOOL)replaceItemAtPath:(NSString *)path withItemAtPath:(NSString *)replacementPath error:(NSError **)pError
+{
+    // rename(2) atomically replaces the destination
+    if (rename([replacementPath fileSystemRepresentation], [path fileSystemRepresentation]) != 0) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:errno
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)synchronizeItemAtPath:(NSString *)path error:(NSError **)pError
+{
+    // Directories can be opened read-only as well, which is sufficient to synchronize them
+    int fileDescriptor = open([path fileSystemRepresentation], O_RDONLY);
+    if (fileDescriptor < 0 || fsync(fileDescriptor) != 0) {
+        if (pError) {
+            *pError = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                          code:errno
+                                      userInfo:[NSDictionary dictionaryWithObject:path forKey:NSFilePathErrorKey]];
+        }
+        if (fileDescriptor >= 0) {
+            close(fileDescriptor);
+        }
+        return NO;
+    }
+    
+    close(fileDescriptor);
+    return YES;
+}
+
 @end
@@ -0,0 +1,17 @@
+//
+//  HLSStartupReport+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Interface meant to be used by friend classes of HLSStartupReport (= classes which must have access to private 
+ * implementation details)
+ */
+
+/**
+ * Must be called each time a view controller appears. Only the first call has an effect (cheap afterwards)
+ */
+void HLSStartupReportViewControllerDidAppear(void);
@@ -0,0 +1,63 @@
+//
+//  HLSStartupReport.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Record the time spent setting up a CoconutKit feature (most notably a category swizzling methods), from startTime
+ * to now. If a feature is set up several times, durations are summed. This function does not need an autorelease 
+ * pool and can therefore be called from +load methods
+ */
+void HLSStartupReportRecord(const char *featureName, CFAbsoluteTime startTime);
+
+/**
+ * Same as HLSStartupReportRecord, but with an explicit duration (e.g. for work which is not performed on the thread
+ * recording it)
+ */
+void HLSStartupReportRecordDuration(const char *featureName, CFAbsoluteTime startTime, CFTimeInterval duration);
+
+/**
+ * Categories setting up their features in +load do so before main() is called, and therefore add to the application
+ * launch time even if those features are never used. Most CoconutKit features are therefore set up when first used
+ * or when explicitly enabled (see HLSOptionalFeatures.h). Only those the rest of CoconutKit depends on (e.g. view
+ * controller lifecycle tracking) are still set up in +load.
+ *
+ * The time spent setting up each feature is recorded, whether at load time, when enabled or when first used. This
+ * includes +load swizzling, logger configuration, transition registration, application preloading, dynamic 
+ * localization and Core Data store opening. This class lets you display a report listing the cost of each feature, 
+ * e.g. to check what CoconutKit adds to your application launch time.
+ *
+ * When launch profiling is enabled (see HLSEnableLaunchProfiling in HLSOptionalFeatures.h), the report is automatically
+ * logged when the first view controller appears, i.e. when the application is ready to be used.
+ *
+ * This class is thread-safe
+ */
+@interface HLSStartupReport : NSObject
+
+/**
+ * Log the report when the first view controller appears. Call this method as soon as possible. For simplicity you should
+ * use the HLSEnableLaunchProfiling convenience macro instead (see HLSOptionalFeatures.h)
+ */
++ (void)enableLaunchProfiling;
+
+/**
+ * The total time spent setting up CoconutKit features
+ */
++ (NSTimeInterval)totalDuration;
+
+/**
+ * Return the report, listing the features which have been set up (most expensive first), with the time spent setting 
+ * them up and when this happened (relative to the process start time). If the first view controller has already
+ * appeared, the time at which it did is reported as well
+ */
++ (NSString *)report;
+
+/**
+ * Log the report (info level)
+ */
++ (void)logReport;
+
+@end
@@ -0,0 +1,196 @@
+//
+//  HLSStartupReport.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSStartupReport.h"
+
+#import <pthread.h>
+#import <sys/sysctl.h>
+#import "HLSLogger.h"
+#import "HLSStartupReport+Friend.h"
+
+#define kStartupReportCapacity      64
+#define kFeatureNameMaxLength       64
+
+typedef struct {
+    char featureName[kFeatureNameMaxLength];
+    CFAbsoluteTime startTime;           // first time the feature was set up
+    CFTimeInterval duration;            // total
+    NSUInteger count;
+} HLSStartupReportEntry;
+
+// Variables with internal linkage. Entries are stored in a static array, no allocation is needed
+static HLSStartupReportEntry s_entries[kStartupReportCapacity];
+static NSUInteger s_numberOfEntries = 0;
+static NSUInteger s_numberOfDroppedEntries = 0;
+static pthread_mutex_t s_entriesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static BOOL s_launchProfilingEnabled = NO;
+static CFAbsoluteTime s_firstViewControllerAppearanceTime = 0.;      // 0 if no view controller has appeared yet
+
+// Static functions
+static CFAbsoluteTime HLSProcessStartTime(void);
+static int HLSStartupReportEntryCompare(const void *entry1, const void *entry2);
+
+@implementation HLSStartupReport
+
+#pragma mark Class methods
+
++ (void)enableLaunchProfiling
+{
+    s_launchProfilingEnabled = YES;
+}
+
++ (NSTimeInterval)totalDuration
+{
+    NSTimeInterval totalDuration = 0.;
+    pthread_mutex_lock(&s_entriesMutex);
+    for (NSUInteger i = 0; i < s_numberOfEntries; ++i) {
+        totalDuration += s_entries[i].duration;
+    }
+    pthread_mutex_unlock(&s_entriesMutex);
+    return totalDuration;
+}
+
++ (NSString *)report
+{
+    HLSStartupReportEntry entries[kStartupReportCapacity];
+    
+    pthread_mutex_lock(&s_entriesMutex);
+    NSUInteger numberOfEntries = s_numberOfEntries;
+    NSUInteger numberOfDroppedEntries = s_numberOfDroppedEntries;
+    memcpy(entries, s_entries, numberOfEntries * sizeof(HLSStartupReportEntry));
+    CFAbsoluteTime firstViewControllerAppearanceTime = s_firstViewControllerAppearanceTime;
+    pthread_mutex_unlock(&s_entriesMutex);
+    
+    qsort(entries, numberOfEntries, sizeof(HLSStartupReportEntry), HLSStartupReportEntryCompare);
+    
+    NSTimeInterval totalDuration = 0.;
+    for (NSUInteger i = 0; i < numberOfEntries; ++i) {
+        totalDuration += entries[i].duration;
+    }
+    
+    CFAbsoluteTime processStartTime = HLSProcessStartTime();
+    NSMutableString *report = [NSMutableString stringWithFormat:@"CoconutKit feature setup (total: %.3f ms)", totalDuration * 1000.];
+    if (firstViewControllerAppearanceTime != 0. && processStartTime != 0.) {
+        [report appendFormat:@"\n  First view controller appeared %.1f ms after process start", 
+         (firstViewControllerAppearanceTime - processStartTime) * 1000.];
+    }
+    for (NSUInteger i = 0; i < numberOfEntries; ++i) {
+        HLSStartupReportEntry *entry = &entries[i];
+        [report appendFormat:@"\n  %s: %.3f ms", entry->featureName, entry->duration * 1000.];
+        if (entry->count > 1) {
+            [report appendFormat:@" (%u times)", entry->count];
+        }
+        if (processStartTime != 0.) {
+            [report appendFormat:@" (%.1f ms after process start)", (entry->startTime - processStartTime) * 1000.];
+        }
+    }
+    if (numberOfDroppedEntries != 0) {
+        [report appendFormat:@"\n  (%u more features not recorded)", numberOfDroppedEntries];
+    }
+    return [NSString stringWithString:report];
+}
+
++ (void)logReport
+{
+    HLSLoggerInfo(@"%@", [self report]);
+}
+
+@end
+
+#pragma mark Functions
+
+void HLSStartupReportRecord(const char *featureName, CFAbsoluteTime startTime)
+{
+    HLSStartupReportRecordDuration(featureName, startTime, CFAbsoluteTimeGetCurrent() - startTime);
+}
+
+void HLSStartupReportRecordDuration(const char *featureName, CFAbsoluteTime startTime, CFTimeInterval duration)
+{
+    if (! featureName) {
+        return;
+    }
+    
+    pthread_mutex_lock(&s_entriesMutex);
+    
+    // Few entries are expected, a linear search suffices
+    HLSStartupReportEntry *entry = NULL;
+    for (NSUInteger i = 0; i < s_numberOfEntries; ++i) {
+        if (strncmp(s_entries[i].featureName, featureName, kFeatureNameMaxLength - 1) == 0) {
+            entry = &s_entries[i];
+            break;
+        }
+    }
+    
+    if (! entry && s_numberOfEntries < kStartupReportCapacity) {
+        entry = &s_entries[s_numberOfEntries];
+        strlcpy(entry->featureName, featureName, kFeatureNameMaxLength);
+        entry->startTime = startTime;
+        entry->duration = 0.;
+        entry->count = 0;
+        ++s_numberOfEntries;
+    }
+    
+    if (entry) {
+        entry->duration += duration;
+        ++entry->count;
+    }
+    else {
+        ++s_numberOfDroppedEntries;
+    }
+    
+    pthread_mutex_unlock(&s_entriesMutex);
+}
+
+void HLSStartupReportViewControllerDidAppear(void)
+{
+    // Written on the main thread only
+    if (s_firstViewControllerAppearanceTime != 0.) {
+        return;
+    }
+    
+    pthread_mutex_lock(&s_entriesMutex);
+    s_firstViewControllerAppearanceTime = CFAbsoluteTimeGetCurrent();
+    pthread_mutex_unlock(&s_entriesMutex);
+    
+    if (s_launchProfilingEnabled) {
+        [HLSStartupReport logReport];
+    }
+}
+
+#pragma mark Static functions
+
+// Return 0 if the start time of the process cannot be retrieved
+static CFAbsoluteTime HLSProcessStartTime(void)
+{
+    int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+    struct kinfo_proc processInfo;
+    size_t size = sizeof(processInfo);
+    if (sysctl(mib, 4, &processInfo, &size, NULL, 0) != 0) {
+        return 0.;
+    }
+    
+    struct timeval startTime = processInfo.kp_proc.p_starttime;
+    return startTime.tv_sec + startTime.tv_usec / 1e6 - kCFAbsoluteTimeIntervalSince1970;
+}
+
+// Most expensive first
+static int HLSStartupReportEntryCompare(const void *entry1, const void *entry2)
+{
+    CFTimeInterval duration1 = ((const HLSStartupReportEntry *)entry1)->duration;
+    CFTimeInterval duration2 = ((const HLSStartupReportEntry *)entry2)->duration;
+    if (duration1 > duration2) {
+        return -1;
+    }
+    else if (duration1 < duration2) {
+        return 1;
+    }
+    else {
+        return 0;
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  HLSStringsTable.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * File extension of precompiled strings tables
+ */
+extern NSString * const HLSStringsTableFileExtension;
+
+/**
+ * Private class giving access to a precompiled binary strings table. Such tables are generated at build time from
+ * .strings files (see Tools/Localization/compile_strings_tables.py) and stored next to them, with the same name
+ * but the .hlsstrings extension. When available, they are used by NSBundle+HLSDynamicLocalization instead of the
+ * corresponding plist .strings files.
+ *
+ * The file is memory-mapped and never parsed as a whole. Lookups are binary searches performed directly on the
+ * mapped data, and only the localized string found is copied into the heap.
+ *
+ * File format (all integers are 32-bit little-endian unsigned integers):
+ *   - header: magic number ('HLST'), format version (1), number of entries
+ *   - index: for each entry, sorted by key (UTF-16 code unit order, shorter keys first if one key is a prefix of the
+ *            other), the key offset, key length, value offset and value length. Offsets are in bytes from the
+ *            beginning of the file, lengths in UTF-16 code units
+ *   - payload: keys and values as UTF-16 little-endian strings (without terminating null characters)
+ *
+ * This class is immutable and therefore thread-safe.
+ *
+ * Designated initializer: -initWithContentsOfFile:
+ */
+@interface HLSStringsTable : NSObject {
+@private
+    NSData *m_data;
+    uint32_t m_count;
+}
+
+/**
+ * Return the binary representation of a dictionary of strings (keys and values must be NSString objects, otherwise
+ * nil is returned)
+ */
++ (NSData *)dataWithStringsDictionary:(NSDictionary *)dictionary;
+
+/**
+ * Map the table stored in the specified file. Return nil if the file does not exist or is not a valid table
+ */
+- (id)initWithContentsOfFile:(NSString *)path;
+
+/**
+ * Return the string for a given key, nil if none. Same name as the NSDictionary method so that both kinds of
+ * tables can be used interchangeably
+ */
+- (NSString *)objectForKey:(NSString *)key;
+
+/**
+ * The number of entries in the table
+ */
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+@end
@@ -0,0 +1,291 @@
+//
+//  HLSStringsTable.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSStringsTable.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+NSString * const HLSStringsTableFileExtension = @"hlsstrings";
+
+static const uint32_t kStringsTableMagic = 0x54534C48;              // 'HLST' when read as little-endian bytes
+static const uint32_t kStringsTableVersion = 1;
+static const NSUInteger kStringsTableHeaderSize = 3 * sizeof(uint32_t);
+static const NSUInteger kStringsTableEntrySize = 4 * sizeof(uint32_t);
+
+// Helper functions
+static uint32_t HLSStringsTableReadInteger(const uint8_t *bytes, NSUInteger offset);
+static NSComparisonResult HLSStringsTableCompareCharacters(const uint8_t *characters1, NSUInteger length1,
+                                                           const unichar *characters2, NSUInteger length2);
+static NSInteger HLSStringsTableCompareKeys(id key1, id key2, void *context);
+
+@interface HLSStringsTable ()
+
+- (BOOL)isValid;
+
+@end
+
+@implementation HLSStringsTable
+
+#pragma mark Class methods
+
++ (NSData *)dataWithStringsDictionary:(NSDictionary *)dictionary
+{
+    for (id key in [dictionary allKeys]) {
+        if (! [key isKindOfClass:[NSString class]] || ! [[dictionary objectForKey:key] isKindOfClass:[NSString class]]) {
+            HLSLoggerError(@"Strings tables can only contain strings");
+            return nil;
+        }
+    }
+
+    NSArray *sortedKeys = [[dictionary allKeys] sortedArrayUsingFunction:HLSStringsTableCompareKeys context:NULL];
+    uint32_t count = (uint32_t)[sortedKeys count];
+
+    NSMutableData *indexData = [NSMutableData dataWithCapacity:kStringsTableEntrySize * count];
+    NSMutableData *payloadData = [NSMutableData data];
+    uint32_t payloadOffset = (uint32_t)(kStringsTableHeaderSize + kStringsTableEntrySize * count);
+    for (NSString *key in sortedKeys) {
+        NSString *value = [dictionary objectForKey:key];
+
+        NSData *keyData = [key dataUsingEncoding:NSUTF16LittleEndianStringEncoding];
+        NSData *valueData = [value dataUsingEncoding:NSUTF16LittleEndianStringEncoding];
+
+        uint32_t entry[4];
+        entry[0] = CFSwapInt32HostToLittle(payloadOffset + (uint32_t)[payloadData length]);
+        entry[1] = CFSwapInt32HostToLittle((uint32_t)[key length]);
+        entry[2] = CFSwapInt32HostToLittle(payloadOffset + (uint32_t)([payloadData length] + [keyData length]));
+        entry[3] = CFSwapInt32HostToLittle((uint32_t)[value length]);
+        [indexData appendBytes:entry length:sizeof(entry)];
+
+        [payloadData appendData:keyData];
+        [payloadData appendData:valueData];
+    }
+
+    uint32_t header[3];
+    header[0] = CFSwapInt32HostToLittle(kStringsTableMagic);
+    header[1] = CFSwapInt32HostToLittle(kStringsTableVersion);
+    header[2] = CFSwapInt32HostToLittle(count);
+
+    NSMutableData *data = [NSMutableData dataWithBytes:header length:sizeof(header)];
+    [data appendData:indexData];
+    [data appendData:payloadData];
+    return [NSData dataWithData:data];
+}
+
+#pragma mark Object creation and destruction
+
+- (id)initWithContentsOfFile:(NSString *)path
+{
+    if ((self = [super init])) {
+        if (! path) {
+            [self release];
+            return nil;
+        }
+
+        // Mapped, not read. Pages are only loaded when accessed by lookups
+        NSError *error = nil;
+        m_data = [[NSData dataWithContentsOfFile:path options:NSDataReadingMapped error:&error] retain];
+        if (! m_data) {
+            HLSLoggerError(@"Could not map strings table %@. Reason: %@", path, error);
+            [self release];
+            return nil;
+        }
+
+        if (! [self isValid]) {
+            HLSLoggerError(@"The file %@ is not a valid strings table", path);
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    [m_data release];
+    m_data = nil;
+
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+- (NSUInteger)count
+{
+    return m_count;
+}
+
+#pragma mark Validation
+
+// Checking all entries once makes lookups safe without any additional bound checks. Only the index is read
+- (BOOL)isValid
+{
+    const uint8_t *bytes = [m_data bytes];
+    NSUInteger length = [m_data length];
+
+    if (length < kStringsTableHeaderSize) {
+        return NO;
+    }
+
+    if (HLSStringsTableReadInteger(bytes, 0) != kStringsTableMagic) {
+        return NO;
+    }
+
+    uint32_t version = HLSStringsTableReadInteger(bytes, sizeof(uint32_t));
+    if (version != kStringsTableVersion) {
+        HLSLoggerError(@"Unsupported strings table version %u", version);
+        return NO;
+    }
+
+    uint32_t count = HLSStringsTableReadInteger(bytes, 2 * sizeof(uint32_t));
+    if ((length - kStringsTableHeaderSize) / kStringsTableEntrySize < count) {
+        return NO;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        NSUInteger entryOffset = kStringsTableHeaderSize + kStringsTableEntrySize * i;
+        for (NSUInteger j = 0; j < 2; ++j) {
+            uint64_t stringOffset = HLSStringsTableReadInteger(bytes, entryOffset + 2 * j * sizeof(uint32_t));
+            uint64_t stringLength = HLSStringsTableReadInteger(bytes, entryOffset + (2 * j + 1) * sizeof(uint32_t));
+            if (stringOffset % sizeof(unichar) != 0 || stringOffset + stringLength * sizeof(unichar) > length) {
+                return NO;
+            }
+        }
+    }
+
+    m_count = count;
+    return YES;
+}
+
+#pragma mark Lookup
+
+- (NSString *)objectForKey:(NSString *)key
+{
+    if (! key || m_count == 0) {
+        return nil;
+    }
+
+    // Access the key characters directly when possible, otherwise copy them into a buffer (allocated on the stack
+    // for usual key lengths)
+    NSUInteger keyLength = [key length];
+    unichar keyBuffer[256];
+    unichar *allocatedKeyBuffer = NULL;
+    const unichar *keyCharacters = CFStringGetCharactersPtr((CFStringRef)key);
+    if (! keyCharacters) {
+        if (keyLength <= sizeof(keyBuffer) / sizeof(unichar)) {
+            [key getCharacters:keyBuffer range:NSMakeRange(0, keyLength)];
+            keyCharacters = keyBuffer;
+        }
+        else {
+            allocatedKeyBuffer = malloc(keyLength * sizeof(unichar));
+            [key getCharacters:allocatedKeyBuffer range:NSMakeRange(0, keyLength)];
+            keyCharacters = allocatedKeyBuffer;
+        }
+    }
+
+    const uint8_t *bytes = [m_data bytes];
+    NSString *value = nil;
+
+    NSUInteger lowerIndex = 0;
+    NSUInteger upperIndex = m_count;
+    while (lowerIndex < upperIndex) {
+        NSUInteger index = lowerIndex + (upperIndex - lowerIndex) / 2;
+        NSUInteger entryOffset = kStringsTableHeaderSize + kStringsTableEntrySize * index;
+
+        uint32_t entryKeyOffset = HLSStringsTableReadInteger(bytes, entryOffset);
+        uint32_t entryKeyLength = HLSStringsTableReadInteger(bytes, entryOffset + sizeof(uint32_t));
+        NSComparisonResult result = HLSStringsTableCompareCharacters(bytes + entryKeyOffset, entryKeyLength, keyCharacters, keyLength);
+        if (result == NSOrderedAscending) {
+            lowerIndex = index + 1;
+        }
+        else if (result == NSOrderedDescending) {
+            upperIndex = index;
+        }
+        else {
+            uint32_t valueOffset = HLSStringsTableReadInteger(bytes, entryOffset + 2 * sizeof(uint32_t));
+            uint32_t valueLength = HLSStringsTableReadInteger(bytes, entryOffset + 3 * sizeof(uint32_t));
+            value = [[[NSString alloc] initWithBytes:bytes + valueOffset
+                                              length:valueLength * sizeof(unichar)
+                                            encoding:NSUTF16LittleEndianStringEncoding] autorelease];
+            break;
+        }
+    }
+
+    free(allocatedKeyBuffer);
+    return value;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %d>",
+            [self class],
+            self,
+            [self count]];
+}
+
+@end
+
+#pragma mark Helper functions
+
+static uint32_t HLSStringsTableReadInteger(const uint8_t *bytes, NSUInteger offset)
+{
+    uint32_t value;
+    memcpy(&value, bytes + offset, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
+// The first string is stored in the table (little-endian UTF-16), the second one is in host byte order
+static NSComparisonResult HLSStringsTableCompareCharacters(const uint8_t *characters1, NSUInteger length1,
+                                                           const unichar *characters2, NSUInteger length2)
+{
+    NSUInteger length = MIN(length1, length2);
+    for (NSUInteger i = 0; i < length; ++i) {
+        uint16_t character1;
+        memcpy(&character1, characters1 + i * sizeof(uint16_t), sizeof(character1));
+        character1 = CFSwapInt16LittleToHost(character1);
+
+        if (character1 < characters2[i]) {
+            return NSOrderedAscending;
+        }
+        else if (character1 > characters2[i]) {
+            return NSOrderedDescending;
+        }
+    }
+
+    if (length1 < length2) {
+        return NSOrderedAscending;
+    }
+    else if (length1 > length2) {
+        return NSOrderedDescending;
+    }
+    else {
+        return NSOrderedSame;
+    }
+}
+
+// Same order as the one used for lookups
+static NSInteger HLSStringsTableCompareKeys(id key1, id key2, void *context)
+{
+    NSData *keyData1 = [key1 dataUsingEncoding:NSUTF16LittleEndianStringEncoding];
+
+    NSUInteger length2 = [key2 length];
+    unichar *characters2 = malloc(length2 * sizeof(unichar));
+    [key2 getCharacters:characters2 range:NSMakeRange(0, length2)];
+
+    NSComparisonResult result = HLSStringsTableCompareCharacters([keyData1 bytes], [key1 length], characters2, length2);
+    free(characters2);
+    return result;
+}
@@ -0,0 +1,33 @@
+//
+//  HLSTimeZoneOffsetTable.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Period during which the offsets of a time zone do not change
+ */
+typedef struct {
+    CFAbsoluteTime startTime;
+    NSInteger secondsFromGMT;
+    NSTimeInterval daylightSavingTimeOffset;
+} HLSTimeZonePeriod;
+
+/**
+ * Private functions giving fast access to time zone offsets. The offsets of a time zone are computed once for fixed
+ * windows of ten years, stored as a sorted list of periods between transitions, and found using binary search without
+ * having to query the time zone database. Tables are cached per time zone name (the local time zone proxy namely
+ * changes its behavior and its name when the system time zone changes). A few windows are kept per time zone, the
+ * least recently used one being discarded when a new window is needed, so that dates alternating between distant
+ * periods do not rebuild tables over and over.
+ *
+ * These functions are thread-safe. Tables are built outside the lock protecting the cache
+ */
+
+/**
+ * Fill the period containing a time for a time zone. Return NO if offsets cannot be computed (DST transitions can only
+ * be enumerated on iOS 4 and above)
+ */
+BOOL HLSTimeZoneGetPeriod(NSTimeZone *timeZone, CFAbsoluteTime time, HLSTimeZonePeriod *pPeriod);
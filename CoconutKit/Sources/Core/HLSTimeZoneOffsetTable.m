@@ -0,0 +1,192 @@
+//
+//  HLSTimeZoneOffsetTable.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTimeZoneOffsetTable.h"
+
+#import <pthread.h>
+
+// Length of the window covered by a table. Windows are aligned on multiples of this length (years approximated, the
+// window only needs to be large enough)
+static const CFTimeInterval kTimeZoneOffsetTableWindowLength = 10. * 365. * 24. * 60. * 60.;
+
+// Maximum number of windows kept per time zone
+#define kTimeZoneOffsetTablesPerTimeZone        4
+
+// Offsets of a time zone over a window, as a sorted list of the periods between transitions (periods[0].startTime
+// == startTime)
+typedef struct {
+    CFAbsoluteTime startTime;
+    CFAbsoluteTime endTime;
+    NSUInteger count;
+    HLSTimeZonePeriod *periods;
+} HLSTimeZoneOffsetTable;
+
+// Windows cached for a time zone
+typedef struct {
+    HLSTimeZoneOffsetTable *tables[kTimeZoneOffsetTablesPerTimeZone];          // Most recently used first
+    NSUInteger count;
+} HLSTimeZoneOffsetTables;
+
+// Variables with internal linkage. Tables are only accessed with the mutex held, so that discarded tables can be freed
+static CFMutableDictionaryRef s_timeZoneNameToOffsetTablesMap = NULL;
+static pthread_mutex_t s_timeZoneOffsetTablesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Static functions
+static HLSTimeZoneOffsetTable *HLSTimeZoneOffsetTableCreate(NSTimeZone *timeZone, CFAbsoluteTime startTime);
+static void HLSTimeZoneOffsetTableFree(HLSTimeZoneOffsetTable *table);
+static HLSTimeZonePeriod HLSTimeZoneOffsetTableGetPeriod(HLSTimeZoneOffsetTable *table, CFAbsoluteTime time);
+static HLSTimeZoneOffsetTables *HLSTimeZoneOffsetTablesForTimeZoneName(NSString *timeZoneName);
+static BOOL HLSTimeZoneOffsetTablesGetPeriod(HLSTimeZoneOffsetTables *tables, CFAbsoluteTime time, HLSTimeZonePeriod *pPeriod);
+static void HLSTimeZoneOffsetTablesAddTable(HLSTimeZoneOffsetTables *tables, HLSTimeZoneOffsetTable *table);
+
+#pragma mark Friend functions
+
+BOOL HLSTimeZoneGetPeriod(NSTimeZone *timeZone, CFAbsoluteTime time, HLSTimeZonePeriod *pPeriod)
+{
+    // TODO: When iOS 4 and above required: Can remove respondsToSelector test
+    if (! [timeZone respondsToSelector:@selector(nextDaylightSavingTimeTransitionAfterDate:)]) {
+        return NO;
+    }
+    
+    NSString *timeZoneName = [timeZone name];
+    
+    pthread_mutex_lock(&s_timeZoneOffsetTablesMutex);
+    BOOL found = HLSTimeZoneOffsetTablesGetPeriod(HLSTimeZoneOffsetTablesForTimeZoneName(timeZoneName), time, pPeriod);
+    pthread_mutex_unlock(&s_timeZoneOffsetTablesMutex);
+    
+    if (found) {
+        return YES;
+    }
+    
+    // Querying the time zone database is slow. Build the table outside the critical section
+    CFAbsoluteTime startTime = floor(time / kTimeZoneOffsetTableWindowLength) * kTimeZoneOffsetTableWindowLength;
+    HLSTimeZoneOffsetTable *table = HLSTimeZoneOffsetTableCreate(timeZone, startTime);
+    
+    // Another thread might have built the same table meanwhile. Keep the first one
+    pthread_mutex_lock(&s_timeZoneOffsetTablesMutex);
+    HLSTimeZoneOffsetTables *tables = HLSTimeZoneOffsetTablesForTimeZoneName(timeZoneName);
+    if (! HLSTimeZoneOffsetTablesGetPeriod(tables, time, pPeriod)) {
+        HLSTimeZoneOffsetTablesAddTable(tables, table);
+        *pPeriod = HLSTimeZoneOffsetTableGetPeriod(table, time);
+        table = NULL;
+    }
+    pthread_mutex_unlock(&s_timeZoneOffsetTablesMutex);
+    
+    if (table) {
+        HLSTimeZoneOffsetTableFree(table);
+    }
+    return YES;
+}
+
+#pragma mark Static functions
+
+static HLSTimeZoneOffsetTable *HLSTimeZoneOffsetTableCreate(NSTimeZone *timeZone, CFAbsoluteTime startTime)
+{
+    HLSTimeZoneOffsetTable *table = calloc(1, sizeof(HLSTimeZoneOffsetTable));
+    table->startTime = startTime;
+    table->endTime = startTime + kTimeZoneOffsetTableWindowLength;
+    
+    // Walk through the transitions within the window (usually two per year at most)
+    NSUInteger capacity = 32;
+    table->periods = malloc(capacity * sizeof(HLSTimeZonePeriod));
+    
+    NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:startTime];
+    while (date) {
+        if (table->count == capacity) {
+            capacity *= 2;
+            table->periods = realloc(table->periods, capacity * sizeof(HLSTimeZonePeriod));
+        }
+        
+        HLSTimeZonePeriod period;
+        period.startTime = [date timeIntervalSinceReferenceDate];
+        period.secondsFromGMT = [timeZone secondsFromGMTForDate:date];
+        period.daylightSavingTimeOffset = [timeZone daylightSavingTimeOffsetForDate:date];
+        table->periods[table->count] = period;
+        ++table->count;
+        
+        NSDate *nextDate = [timeZone nextDaylightSavingTimeTransitionAfterDate:date];
+        if (! nextDate
+                || [nextDate timeIntervalSinceReferenceDate] >= table->endTime
+                || [nextDate timeIntervalSinceReferenceDate] <= period.startTime) {
+            break;
+        }
+        date = nextDate;
+    }
+    return table;
+}
+
+static void HLSTimeZoneOffsetTableFree(HLSTimeZoneOffsetTable *table)
+{
+    free(table->periods);
+    free(table);
+}
+
+// The time must be covered by the table
+static HLSTimeZonePeriod HLSTimeZoneOffsetTableGetPeriod(HLSTimeZoneOffsetTable *table, CFAbsoluteTime time)
+{
+    // Binary search for the last period starting before the time
+    NSUInteger low = 0;
+    NSUInteger high = table->count - 1;
+    while (low < high) {
+        NSUInteger middle = (low + high + 1) / 2;
+        if (table->periods[middle].startTime <= time) {
+            low = middle;
+        }
+        else {
+            high = middle - 1;
+        }
+    }
+    return table->periods[low];
+}
+
+// Must be called with the mutex held. Entries are never destroyed once created
+static HLSTimeZoneOffsetTables *HLSTimeZoneOffsetTablesForTimeZoneName(NSString *timeZoneName)
+{
+    if (! s_timeZoneNameToOffsetTablesMap) {
+        s_timeZoneNameToOffsetTablesMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    }
+    
+    HLSTimeZoneOffsetTables *tables = (HLSTimeZoneOffsetTables *)CFDictionaryGetValue(s_timeZoneNameToOffsetTablesMap, timeZoneName);
+    if (! tables) {
+        tables = calloc(1, sizeof(HLSTimeZoneOffsetTables));
+        CFDictionarySetValue(s_timeZoneNameToOffsetTablesMap, timeZoneName, tables);
+    }
+    return tables;
+}
+
+// Must be called with the mutex held. Return NO if no table covers the time
+static BOOL HLSTimeZoneOffsetTablesGetPeriod(HLSTimeZoneOffsetTables *tables, CFAbsoluteTime time, HLSTimeZonePeriod *pPeriod)
+{
+    for (NSUInteger i = 0; i < tables->count; ++i) {
+        HLSTimeZoneOffsetTable *table = tables->tables[i];
+        if (time < table->startTime || time >= table->endTime) {
+            continue;
+        }
+        
+        // Move the table to the front
+        memmove(&tables->tables[1], &tables->tables[0], i * sizeof(HLSTimeZoneOffsetTable *));
+        tables->tables[0] = table;
+        
+        *pPeriod = HLSTimeZoneOffsetTableGetPeriod(table, time);
+        return YES;
+    }
+    return NO;
+}
+
+// Must be called with the mutex held. The least recently used table is discarded if needed
+static void HLSTimeZoneOffsetTablesAddTable(HLSTimeZoneOffsetTables *tables, HLSTimeZoneOffsetTable *table)
+{
+    if (tables->count == kTimeZoneOffsetTablesPerTimeZone) {
+        HLSTimeZoneOffsetTableFree(tables->tables[kTimeZoneOffsetTablesPerTimeZone - 1]);
+        --tables->count;
+    }
+    
+    memmove(&tables->tables[1], &tables->tables[0], tables->count * sizeof(HLSTimeZoneOffsetTable *));
+    tables->tables[0] = table;
+    ++tables->count;
+}
@@ -14,6 +14,11 @@
 @interface HLSUserInterfaceLock : NSObject {
 @private
     NSUInteger m_useCount;
+    BOOL m_coalescing;
+    BOOL m_interactionLocked;
+    NSTimeInterval m_lockStartTimeInterval;
+    NSTimeInterval m_totalLockDuration;
+    NSUInteger m_numberOfLocks;
 }
 
 + (HLSUserInterfaceLock *)sharedUserInterfaceLock;
@@ -25,4 +30,33 @@
 - (void)lock;
 - (void)unlock;
 
+/**
+ * When set to YES, interaction events are not ignored or restored immediately when the counter changes. The UI is 
+ * only locked if the counter stays different from zero until the next run loop pass, and only unlocked one frame
+ * after the counter has reached zero (provided it has not been incremented in the meantime). Quick lock / unlock 
+ * sequences (e.g. around short animations) therefore do not repeatedly lock and unlock the UI. Note that the UI 
+ * is not locked immediately after -lock returns in this mode
+ *
+ * Default is NO
+ */
+@property (nonatomic, assign, getter=isCoalescing) BOOL coalescing;
+
+/**
+ * Return YES iff interaction events are currently ignored because of the lock
+ */
+@property (nonatomic, readonly, assign, getter=isInteractionLocked) BOOL interactionLocked;
+
+/**
+ * Statistics about how the UI was locked since the lock was created or since the statistics were last reset: The
+ * total time during which interaction events were ignored (including the current lock, if any), and the number of
+ * times the UI was actually locked
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval totalLockDuration;
+@property (nonatomic, readonly, assign) NSUInteger numberOfLocks;
+
+/**
+ * Reset the statistics
+ */
+- (void)resetStatistics;
+
 @end
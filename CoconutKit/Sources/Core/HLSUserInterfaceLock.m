@@ -10,6 +10,16 @@
 
 #import "HLSLogger.h"
 
+// Delay after which the UI is unlocked in coalescing mode (one frame)
+static const NSTimeInterval kUserInterfaceLockUnlockDelay = 1. / 60.;
+
+@interface HLSUserInterfaceLock ()
+
+- (void)updateInteractionLock;
+- (void)scheduleInteractionLockUpdateAfterDelay:(NSTimeInterval)delay;
+
+@end
+
 @implementation HLSUserInterfaceLock
 
 #pragma mark Class methods
@@ -34,6 +44,46 @@
     return self;
 }
 
+- (void)dealloc
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize coalescing = m_coalescing;
+
+- (void)setCoalescing:(BOOL)coalescing
+{
+    if (m_coalescing == coalescing) {
+        return;
+    }
+    
+    m_coalescing = coalescing;
+    
+    // Apply any pending change immediately
+    if (! coalescing) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateInteractionLock) object:nil];
+        [self updateInteractionLock];
+    }
+}
+
+@synthesize interactionLocked = m_interactionLocked;
+
+- (NSTimeInterval)totalLockDuration
+{
+    if (m_interactionLocked) {
+        return m_totalLockDuration + [NSDate timeIntervalSinceReferenceDate] - m_lockStartTimeInterval;
+    }
+    else {
+        return m_totalLockDuration;
+    }
+}
+
+@synthesize numberOfLocks = m_numberOfLocks;
+
 #pragma mark Locking and unlocking user interaction
 
 - (void)lock
@@ -42,7 +92,13 @@
     HLSLoggerDebug(@"Acquire UI lock");
     
     if (m_useCount == 1) {
-        [[UIApplication sharedApplication] beginIgnoringInteractionEvents];
+        if (self.coalescing) {
+            // Only lock if the UI is still locked during the next run loop pass
+            [self scheduleInteractionLockUpdateAfterDelay:0.];
+        }
+        else {
+            [self updateInteractionLock];
+        }
     }
 }
 
@@ -58,7 +114,46 @@
     HLSLoggerDebug(@"Release UI lock");
     
     if (m_useCount == 0) {
+        if (self.coalescing) {
+            [self scheduleInteractionLockUpdateAfterDelay:kUserInterfaceLockUnlockDelay];
+        }
+        else {
+            [self updateInteractionLock];
+        }
+    }
+}
+
+// Lock or unlock the UI so that it matches the use count
+- (void)updateInteractionLock
+{
+    if (m_useCount != 0 && ! m_interactionLocked) {
+        [[UIApplication sharedApplication] beginIgnoringInteractionEvents];
+        m_interactionLocked = YES;
+        m_lockStartTimeInterval = [NSDate timeIntervalSinceReferenceDate];
+        ++m_numberOfLocks;
+    }
+    else if (m_useCount == 0 && m_interactionLocked) {
         [[UIApplication sharedApplication] endIgnoringInteractionEvents];
+        m_interactionLocked = NO;
+        m_totalLockDuration += [NSDate timeIntervalSinceReferenceDate] - m_lockStartTimeInterval;
+    }
+}
+
+// Only the most recent update request is kept
+- (void)scheduleInteractionLockUpdateAfterDelay:(NSTimeInterval)delay
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateInteractionLock) object:nil];
+    [self performSelector:@selector(updateInteractionLock) withObject:nil afterDelay:delay];
+}
+
+#pragma mark Statistics
+
+- (void)resetStatistics
+{
+    m_totalLockDuration = 0.;
+    m_numberOfLocks = 0;
+    if (m_interactionLocked) {
+        m_lockStartTimeInterval = [NSDate timeIntervalSinceReferenceDate];
     }
 }
 
@@ -10,18 +10,109 @@
 
 #import "HLSAssert.h"
 
+// Character classes used by the e-mail address validator
+typedef enum {
+    HLSEmailCharacterClassNone = 0,
+    HLSEmailCharacterClassLocal = 1 << 0,           // Allowed in the local part
+    HLSEmailCharacterClassDomain = 1 << 1,          // Allowed in a domain label
+    HLSEmailCharacterClassAlpha = 1 << 2            // Allowed in a top-level domain label
+} HLSEmailCharacterClass;
+
+// Validator states
+typedef enum {
+    HLSEmailValidatorStateLocalStart = 0,           // Start of the local part, or after a dot in it
+    HLSEmailValidatorStateLocal,                    // Within the local part
+    HLSEmailValidatorStateLabelStart,               // Start of a domain label
+    HLSEmailValidatorStateLabel                     // Within a domain label
+} HLSEmailValidatorState;
+
+// Static functions
+static HLSEmailCharacterClass HLSEmailCharacterClassForCharacter(UTF32Char character);
+
 @implementation HLSValidators
 
 + (BOOL)validateEmailAddress:(NSString *)emailAddress
 {
-    // For some obscure reason, escaping the % in the directly in the format string (using %%) does not work and crashes at runtime! But creating the
-    // regex outside and inserting it into the control string works. Are control strings in Objective-C really standard? 
-    // The following regex is the one used by Apple, e.g. in iOS mail. Thanks to Cédric Lüthi (0xced) for its extraction
-    // (method -[NSString(NSEmailAddressString) mf_isLegalEmailAddress] in /System/Library/PrivateFrameworks/MIME.framework)
-    NSString *emailRegex = @"^[[:alnum:]!#$%&'*+/=?^_`{|}~-]+((\\.?)[[:alnum:]!#$%&'*+/=?^_`{|}~-]+)*@[[:alnum:]-]+(\\.[[:alnum:]-]+)*(\\.[[:alpha:]]+)+$";
+    // The accepted language is the one of the following regex, used by Apple, e.g. in iOS mail. Thanks to Cédric Lüthi (0xced)
+    // for its extraction (method -[NSString(NSEmailAddressString) mf_isLegalEmailAddress] in /System/Library/PrivateFrameworks/MIME.framework):
+    //
+    //   ^[[:alnum:]!#$%&'*+/=?^_`{|}~-]+((\.?)[[:alnum:]!#$%&'*+/=?^_`{|}~-]+)*@[[:alnum:]-]+(\.[[:alnum:]-]+)*(\.[[:alpha:]]+)+$
+    //
+    // i.e. a local part made of dot-separated non-empty words, and a domain made of at least two dot-separated non-empty 
+    // labels, the last of which only contains letters. Matching it with NSPredicate compiles the regex again for each 
+    // evaluation, we therefore scan the string once instead
+    if (! emailAddress) {
+        return NO;
+    }
+    
+    CFStringRef string = (CFStringRef)emailAddress;
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    
+    HLSEmailValidatorState state = HLSEmailValidatorStateLocalStart;
+    NSUInteger numberOfLabels = 0;
+    BOOL alphaLabel = NO;
+    for (CFIndex i = 0; i < length; ++i) {
+        UTF32Char character = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+        if (CFStringIsSurrogateHighCharacter(character) && i + 1 < length) {
+            UniChar lowCharacter = CFStringGetCharacterFromInlineBuffer(&buffer, i + 1);
+            if (CFStringIsSurrogateLowCharacter(lowCharacter)) {
+                character = CFStringGetLongCharacterForSurrogatePair(character, lowCharacter);
+                ++i;
+            }
+        }
+        
+        switch (state) {
+            case HLSEmailValidatorStateLocalStart:
+            case HLSEmailValidatorStateLocal: {
+                if (character == '.' || character == '@') {
+                    if (state == HLSEmailValidatorStateLocalStart) {
+                        return NO;
+                    }
+                    state = (character == '.') ? HLSEmailValidatorStateLocalStart : HLSEmailValidatorStateLabelStart;
+                }
+                else if (HLSEmailCharacterClassForCharacter(character) & HLSEmailCharacterClassLocal) {
+                    state = HLSEmailValidatorStateLocal;
+                }
+                else {
+                    return NO;
+                }
+                break;
+            }
+                
+            case HLSEmailValidatorStateLabelStart:
+            case HLSEmailValidatorStateLabel: {
+                if (character == '.') {
+                    if (state == HLSEmailValidatorStateLabelStart) {
+                        return NO;
+                    }
+                    state = HLSEmailValidatorStateLabelStart;
+                }
+                else {
+                    HLSEmailCharacterClass characterClass = HLSEmailCharacterClassForCharacter(character);
+                    if (! (characterClass & HLSEmailCharacterClassDomain)) {
+                        return NO;
+                    }
+                    
+                    if (state == HLSEmailValidatorStateLabelStart) {
+                        ++numberOfLabels;
+                        alphaLabel = YES;
+                        state = HLSEmailValidatorStateLabel;
+                    }
+                    alphaLabel = alphaLabel && (characterClass & HLSEmailCharacterClassAlpha);
+                }
+                break;
+            }
+                
+            default: {
+                return NO;
+                break;
+            }
+        }
+    }
     
-    NSPredicate *emailPredicate = [NSPredicate predicateWithFormat:@"SELF MATCHES %@", emailRegex]; 
-    return [emailPredicate evaluateWithObject:emailAddress];
+    return state == HLSEmailValidatorStateLabel && numberOfLabels >= 2 && alphaLabel;
 }
 
 #pragma mark Object creation and destruction
@@ -33,3 +124,45 @@
 }
 
 @end
+
+static HLSEmailCharacterClass HLSEmailCharacterClassForCharacter(UTF32Char character)
+{
+    // ASCII characters are looked up in a table. Other characters are matched against the Unicode alphanumeric 
+    // and letter sets, as [[:alnum:]] and [[:alpha:]] do
+    static HLSEmailCharacterClass s_asciiCharacterClasses[128];
+    static NSCharacterSet *s_alphanumericCharacterSet = nil;
+    static NSCharacterSet *s_letterCharacterSet = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        for (UTF32Char c = 0; c < 128; ++c) {
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+                s_asciiCharacterClasses[c] = HLSEmailCharacterClassLocal | HLSEmailCharacterClassDomain | HLSEmailCharacterClassAlpha;
+            }
+            else if (c >= '0' && c <= '9') {
+                s_asciiCharacterClasses[c] = HLSEmailCharacterClassLocal | HLSEmailCharacterClassDomain;
+            }
+        }
+        
+        const char *localSymbols = "!#$%&'*+/=?^_`{|}~-";
+        for (const char *symbol = localSymbols; *symbol; ++symbol) {
+            s_asciiCharacterClasses[(unsigned char)*symbol] |= HLSEmailCharacterClassLocal;
+        }
+        s_asciiCharacterClasses['-'] |= HLSEmailCharacterClassDomain;
+        
+        s_alphanumericCharacterSet = [[NSCharacterSet alphanumericCharacterSet] retain];
+        s_letterCharacterSet = [[NSCharacterSet letterCharacterSet] retain];
+    });
+    
+    if (character < 128) {
+        return s_asciiCharacterClasses[character];
+    }
+    else if ([s_letterCharacterSet longCharacterIsMember:character]) {
+        return HLSEmailCharacterClassLocal | HLSEmailCharacterClassDomain | HLSEmailCharacterClassAlpha;
+    }
+    else if ([s_alphanumericCharacterSet longCharacterIsMember:character]) {
+        return HLSEmailCharacterClassLocal | HLSEmailCharacterClassDomain;
+    }
+    else {
+        return HLSEmailCharacterClassNone;
+    }
+}
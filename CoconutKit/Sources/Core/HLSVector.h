@@ -32,7 +32,45 @@ HLSVector2 HLSVector2Make(CGFloat v1, CGFloat v2);
 HLSVector3 HLSVector3Make(CGFloat v1, CGFloat v2, CGFloat v3);
 HLSVector4 HLSVector4Make(CGFloat v1, CGFloat v2, CGFloat v3, CGFloat v4);
 
+// Component-wise sum and difference
+HLSVector2 HLSVector2Add(HLSVector2 vector2, HLSVector2 otherVector2);
+HLSVector3 HLSVector3Add(HLSVector3 vector3, HLSVector3 otherVector3);
+HLSVector4 HLSVector4Add(HLSVector4 vector4, HLSVector4 otherVector4);
+
+HLSVector2 HLSVector2Subtract(HLSVector2 vector2, HLSVector2 otherVector2);
+HLSVector3 HLSVector3Subtract(HLSVector3 vector3, HLSVector3 otherVector3);
+HLSVector4 HLSVector4Subtract(HLSVector4 vector4, HLSVector4 otherVector4);
+
+// Multiplication of all components by a factor
+HLSVector2 HLSVector2Scale(HLSVector2 vector2, CGFloat factor);
+HLSVector3 HLSVector3Scale(HLSVector3 vector3, CGFloat factor);
+HLSVector4 HLSVector4Scale(HLSVector4 vector4, CGFloat factor);
+
+// Component-wise reciprocal (components must not vanish)
+HLSVector2 HLSVector2Reciprocal(HLSVector2 vector2);
+HLSVector3 HLSVector3Reciprocal(HLSVector3 vector3);
+HLSVector4 HLSVector4Reciprocal(HLSVector4 vector4);
+
+// Dot product
+CGFloat HLSVector2Dot(HLSVector2 vector2, HLSVector2 otherVector2);
+CGFloat HLSVector3Dot(HLSVector3 vector3, HLSVector3 otherVector3);
+CGFloat HLSVector4Dot(HLSVector4 vector4, HLSVector4 otherVector4);
+
+// Linear interpolation between two vectors (fraction = 0 yields the first vector, fraction = 1 the second one)
+HLSVector2 HLSVector2Lerp(HLSVector2 vector2, HLSVector2 otherVector2, CGFloat fraction);
+HLSVector3 HLSVector3Lerp(HLSVector3 vector3, HLSVector3 otherVector3, CGFloat fraction);
+HLSVector4 HLSVector4Lerp(HLSVector4 vector4, HLSVector4 otherVector4, CGFloat fraction);
+
 // Return a string representation of a vector
 NSString *HLSStringFromVector2(HLSVector2 vector2);
 NSString *HLSStringFromVector3(HLSVector3 vector3);
 NSString *HLSStringFromVector4(HLSVector4 vector4);
+
+// Conversion from and to arrays of NSNumber components (e.g. for archiving). Missing components are set to 0
+NSArray *HLSArrayFromVector2(HLSVector2 vector2);
+NSArray *HLSArrayFromVector3(HLSVector3 vector3);
+NSArray *HLSArrayFromVector4(HLSVector4 vector4);
+
+HLSVector2 HLSVector2FromArray(NSArray *array);
+HLSVector3 HLSVector3FromArray(NSArray *array);
+HLSVector4 HLSVector4FromArray(NSArray *array);
@@ -8,6 +8,11 @@
 
 #import "HLSVector.h"
 
+static CGFloat HLSComponentAtIndex(NSArray *array, NSUInteger index)
+{
+    return index < [array count] ? [[array objectAtIndex:index] floatValue] : 0.f;
+}
+
 HLSVector2 HLSVector2Make(CGFloat v1, CGFloat v2)
 {
     HLSVector2 vector;
@@ -38,6 +43,96 @@ HLSVector4 HLSVector4Make(CGFloat v1, CGFloat v2, CGFloat v3, CGFloat v4)
     return vector;
 }
 
+HLSVector2 HLSVector2Add(HLSVector2 vector2, HLSVector2 otherVector2)
+{
+    return HLSVector2Make(vector2.v1 + otherVector2.v1, vector2.v2 + otherVector2.v2);
+}
+
+HLSVector3 HLSVector3Add(HLSVector3 vector3, HLSVector3 otherVector3)
+{
+    return HLSVector3Make(vector3.v1 + otherVector3.v1, vector3.v2 + otherVector3.v2, vector3.v3 + otherVector3.v3);
+}
+
+HLSVector4 HLSVector4Add(HLSVector4 vector4, HLSVector4 otherVector4)
+{
+    return HLSVector4Make(vector4.v1 + otherVector4.v1, vector4.v2 + otherVector4.v2, vector4.v3 + otherVector4.v3, vector4.v4 + otherVector4.v4);
+}
+
+HLSVector2 HLSVector2Subtract(HLSVector2 vector2, HLSVector2 otherVector2)
+{
+    return HLSVector2Make(vector2.v1 - otherVector2.v1, vector2.v2 - otherVector2.v2);
+}
+
+HLSVector3 HLSVector3Subtract(HLSVector3 vector3, HLSVector3 otherVector3)
+{
+    return HLSVector3Make(vector3.v1 - otherVector3.v1, vector3.v2 - otherVector3.v2, vector3.v3 - otherVector3.v3);
+}
+
+HLSVector4 HLSVector4Subtract(HLSVector4 vector4, HLSVector4 otherVector4)
+{
+    return HLSVector4Make(vector4.v1 - otherVector4.v1, vector4.v2 - otherVector4.v2, vector4.v3 - otherVector4.v3, vector4.v4 - otherVector4.v4);
+}
+
+HLSVector2 HLSVector2Scale(HLSVector2 vector2, CGFloat factor)
+{
+    return HLSVector2Make(factor * vector2.v1, factor * vector2.v2);
+}
+
+HLSVector3 HLSVector3Scale(HLSVector3 vector3, CGFloat factor)
+{
+    return HLSVector3Make(factor * vector3.v1, factor * vector3.v2, factor * vector3.v3);
+}
+
+HLSVector4 HLSVector4Scale(HLSVector4 vector4, CGFloat factor)
+{
+    return HLSVector4Make(factor * vector4.v1, factor * vector4.v2, factor * vector4.v3, factor * vector4.v4);
+}
+
+HLSVector2 HLSVector2Reciprocal(HLSVector2 vector2)
+{
+    return HLSVector2Make(1.f / vector2.v1, 1.f / vector2.v2);
+}
+
+HLSVector3 HLSVector3Reciprocal(HLSVector3 vector3)
+{
+    return HLSVector3Make(1.f / vector3.v1, 1.f / vector3.v2, 1.f / vector3.v3);
+}
+
+HLSVector4 HLSVector4Reciprocal(HLSVector4 vector4)
+{
+    return HLSVector4Make(1.f / vector4.v1, 1.f / vector4.v2, 1.f / vector4.v3, 1.f / vector4.v4);
+}
+
+CGFloat HLSVector2Dot(HLSVector2 vector2, HLSVector2 otherVector2)
+{
+    return vector2.v1 * otherVector2.v1 + vector2.v2 * otherVector2.v2;
+}
+
+CGFloat HLSVector3Dot(HLSVector3 vector3, HLSVector3 otherVector3)
+{
+    return vector3.v1 * otherVector3.v1 + vector3.v2 * otherVector3.v2 + vector3.v3 * otherVector3.v3;
+}
+
+CGFloat HLSVector4Dot(HLSVector4 vector4, HLSVector4 otherVector4)
+{
+    return vector4.v1 * otherVector4.v1 + vector4.v2 * otherVector4.v2 + vector4.v3 * otherVector4.v3 + vector4.v4 * otherVector4.v4;
+}
+
+HLSVector2 HLSVector2Lerp(HLSVector2 vector2, HLSVector2 otherVector2, CGFloat fraction)
+{
+    return HLSVector2Add(vector2, HLSVector2Scale(HLSVector2Subtract(otherVector2, vector2), fraction));
+}
+
+HLSVector3 HLSVector3Lerp(HLSVector3 vector3, HLSVector3 otherVector3, CGFloat fraction)
+{
+    return HLSVector3Add(vector3, HLSVector3Scale(HLSVector3Subtract(otherVector3, vector3), fraction));
+}
+
+HLSVector4 HLSVector4Lerp(HLSVector4 vector4, HLSVector4 otherVector4, CGFloat fraction)
+{
+    return HLSVector4Add(vector4, HLSVector4Scale(HLSVector4Subtract(otherVector4, vector4), fraction));
+}
+
 NSString *HLSStringFromVector2(HLSVector2 vector2)
 {
     return [NSString stringWithFormat:@"[%.2f, %.2f]", vector2.v1, vector2.v2];
@@ -52,3 +147,36 @@ NSString *HLSStringFromVector4(HLSVector4 vector4)
 {
     return [NSString stringWithFormat:@"[%.2f, %.2f, %.2f, %.2f]", vector4.v1, vector4.v2, vector4.v3, vector4.v4];
 }
+
+NSArray *HLSArrayFromVector2(HLSVector2 vector2)
+{
+    return [NSArray arrayWithObjects:[NSNumber numberWithFloat:vector2.v1], [NSNumber numberWithFloat:vector2.v2], nil];
+}
+
+NSArray *HLSArrayFromVector3(HLSVector3 vector3)
+{
+    return [NSArray arrayWithObjects:[NSNumber numberWithFloat:vector3.v1], [NSNumber numberWithFloat:vector3.v2], 
+            [NSNumber numberWithFloat:vector3.v3], nil];
+}
+
+NSArray *HLSArrayFromVector4(HLSVector4 vector4)
+{
+    return [NSArray arrayWithObjects:[NSNumber numberWithFloat:vector4.v1], [NSNumber numberWithFloat:vector4.v2], 
+            [NSNumber numberWithFloat:vector4.v3], [NSNumber numberWithFloat:vector4.v4], nil];
+}
+
+HLSVector2 HLSVector2FromArray(NSArray *array)
+{
+    return HLSVector2Make(HLSComponentAtIndex(array, 0), HLSComponentAtIndex(array, 1));
+}
+
+HLSVector3 HLSVector3FromArray(NSArray *array)
+{
+    return HLSVector3Make(HLSComponentAtIndex(array, 0), HLSComponentAtIndex(array, 1), HLSComponentAtIndex(array, 2));
+}
+
+HLSVector4 HLSVector4FromArray(NSArray *array)
+{
+    return HLSVector4Make(HLSComponentAtIndex(array, 0), HLSComponentAtIndex(array, 1), HLSComponentAtIndex(array, 2), 
+                          HLSComponentAtIndex(array, 3));
+}
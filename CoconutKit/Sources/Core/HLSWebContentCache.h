@@ -0,0 +1,82 @@
+//
+//  HLSWebContentCache.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * UIWebView can only use the shared URL cache, whose default budgets are small, so that pages displayed by web views
+ * (most notably HLSWebViewController) are often downloaded again when they are opened anew. HLSWebContentCache is
+ * a URL cache with budgets suited for web content, which can be installed as shared URL cache:
+ *   - responses are stored in memory and on disk, within the budgets given when the cache is created. The memory
+ *     cache is emptied when a memory warning is received (the disk cache is kept)
+ *   - standard HTTP caching rules apply. Fresh responses are returned from the cache, stale responses having
+ *     validators (ETag or Last-Modified headers) are revalidated with a conditional request, which only downloads
+ *     the content again if it has changed
+ *   - URLs which will likely be opened (e.g. help or terms pages) can be prefetched during idle time
+ *   - cache lookups are counted, so that you can check whether pages are served from the cache
+ *
+ * The cache is never installed automatically, since the shared URL cache is used by all URL loading made by the
+ * application. Call -install explicitly, usually when the application starts:
+ *
+ *   [[HLSWebContentCache sharedWebContentCache] install];
+ *
+ * When the device is offline, HLSWebViewController displays pages from the shared URL cache (whichever it is), even
+ * if they are stale.
+ *
+ * Lookups can be made from any thread. Other methods must be called from the main thread.
+ *
+ * Designated initializer: -initWithMemoryCapacity:diskCapacity:diskPath:
+ */
+@interface HLSWebContentCache : NSURLCache {
+@private
+    NSUInteger m_hitCount;
+    NSUInteger m_missCount;
+    NSMutableArray *m_prefetchURLs;
+    NSURLConnection *m_prefetchConnection;
+}
+
+/**
+ * Return a request loading the specified URL from the given cache only, even if the cached response is stale, or nil
+ * if no response is available for this URL. Used to display pages when the device is offline
+ */
++ (NSURLRequest *)offlineRequestForURL:(NSURL *)URL inURLCache:(NSURLCache *)URLCache timeoutInterval:(NSTimeInterval)timeoutInterval;
+
+/**
+ * The cache used by CoconutKit, with a 4 MB memory budget and a 20 MB disk budget. Those can be changed using the
+ * memoryCapacity and diskCapacity properties
+ */
++ (HLSWebContentCache *)sharedWebContentCache;
+
+/**
+ * Install the receiver as shared URL cache (this affects all URL loading made by the application, not only web views)
+ */
+- (void)install;
+
+/**
+ * Load the specified URLs (an array of NSURL objects) so that they are cached when they are later opened. URLs are
+ * loaded one after the other, only when the application is idle (not while the user is interacting with it, e.g.
+ * scrolling). URLs which are already cached are revalidated if stale. Responses are stored by the URL loading system
+ * in the shared URL cache: Prefetching is therefore pointless if the receiver has not been installed
+ */
+- (void)prefetchURLs:(NSArray *)URLs;
+
+/**
+ * Cancel pending prefetches
+ */
+- (void)cancelPrefetches;
+
+/**
+ * The number of lookups answered from the cache, respectively not found in it
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitCount;
+@property (nonatomic, readonly, assign) NSUInteger missCount;
+
+/**
+ * Reset the hit and miss counters
+ */
+- (void)resetStatistics;
+
+@end
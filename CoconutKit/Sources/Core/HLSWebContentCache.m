@@ -0,0 +1,246 @@
+//
+//  HLSWebContentCache.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSWebContentCache.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+static const NSUInteger kWebContentCacheDefaultMemoryCapacity = 4 * 1024 * 1024;
+static const NSUInteger kWebContentCacheDefaultDiskCapacity = 20 * 1024 * 1024;
+
+@interface HLSWebContentCache ()
+
+@property (nonatomic, retain) NSMutableArray *prefetchURLs;
+@property (nonatomic, retain) NSURLConnection *prefetchConnection;
+
+- (void)schedulePrefetch;
+- (void)prefetchNextURL;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation HLSWebContentCache
+
+#pragma mark Class methods
+
++ (HLSWebContentCache *)sharedWebContentCache
+{
+    static HLSWebContentCache *s_instance = nil;
+    
+    if (! s_instance) {
+        s_instance = [[HLSWebContentCache alloc] initWithMemoryCapacity:kWebContentCacheDefaultMemoryCapacity
+                                                           diskCapacity:kWebContentCacheDefaultDiskCapacity
+                                                               diskPath:@"HLSWebContentCache"];
+    }
+    return s_instance;
+}
+
++ (NSURLRequest *)offlineRequestForURL:(NSURL *)URL inURLCache:(NSURLCache *)URLCache timeoutInterval:(NSTimeInterval)timeoutInterval
+{
+    if (! URL) {
+        return nil;
+    }
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:URL
+                                             cachePolicy:NSURLRequestReturnCacheDataDontLoad
+                                         timeoutInterval:timeoutInterval];
+    return [URLCache cachedResponseForRequest:request] ? request : nil;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)initWithMemoryCapacity:(NSUInteger)memoryCapacity diskCapacity:(NSUInteger)diskCapacity diskPath:(NSString *)path
+{
+    if ((self = [super initWithMemoryCapacity:memoryCapacity diskCapacity:diskCapacity diskPath:path])) {
+        self.prefetchURLs = [NSMutableArray array];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prefetchNextURL) object:nil];
+    
+    [self.prefetchConnection cancel];
+    self.prefetchConnection = nil;
+    self.prefetchURLs = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize prefetchURLs = m_prefetchURLs;
+
+@synthesize prefetchConnection = m_prefetchConnection;
+
+- (NSUInteger)hitCount
+{
+    @synchronized(self) {
+        return m_hitCount;
+    }
+}
+
+- (NSUInteger)missCount
+{
+    @synchronized(self) {
+        return m_missCount;
+    }
+}
+
+#pragma mark Installation
+
+- (void)install
+{
+    if ([NSURLCache sharedURLCache] == self) {
+        return;
+    }
+    
+    [NSURLCache setSharedURLCache:self];
+    HLSLoggerDebug(@"Installed %@ as shared URL cache", self);
+}
+
+#pragma mark Lookup
+
+- (NSCachedURLResponse *)cachedResponseForRequest:(NSURLRequest *)request
+{
+    // Called by the URL loading system, possibly from a background thread
+    NSCachedURLResponse *cachedResponse = [super cachedResponseForRequest:request];
+    @synchronized(self) {
+        if (cachedResponse) {
+            ++m_hitCount;
+        }
+        else {
+            ++m_missCount;
+        }
+    }
+    return cachedResponse;
+}
+
+- (void)resetStatistics
+{
+    @synchronized(self) {
+        m_hitCount = 0;
+        m_missCount = 0;
+    }
+}
+
+#pragma mark Prefetching
+
+- (void)prefetchURLs:(NSArray *)URLs
+{
+    HLSAssertObjectsInEnumerationAreKindOfClass(URLs, NSURL);
+    
+    // Responses are stored by the URL loading system in the shared cache
+    if ([NSURLCache sharedURLCache] != self) {
+        HLSLoggerWarn(@"The cache %@ has not been installed. Prefetched responses will not be stored into it", self);
+    }
+    
+    for (NSURL *URL in URLs) {
+        if ([self.prefetchURLs containsObject:URL]) {
+            continue;
+        }
+        [self.prefetchURLs addObject:URL];
+    }
+    
+    [self schedulePrefetch];
+}
+
+- (void)cancelPrefetches
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prefetchNextURL) object:nil];
+    
+    [self.prefetchURLs removeAllObjects];
+    [self.prefetchConnection cancel];
+    self.prefetchConnection = nil;
+}
+
+- (void)schedulePrefetch
+{
+    if (self.prefetchConnection || [self.prefetchURLs count] == 0) {
+        return;
+    }
+    
+    // Only performed in the default run loop mode, i.e. not while the user is interacting with the interface
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prefetchNextURL) object:nil];
+    [self performSelector:@selector(prefetchNextURL)
+               withObject:nil
+               afterDelay:0.
+                  inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
+- (void)prefetchNextURL
+{
+    if (self.prefetchConnection || [self.prefetchURLs count] == 0) {
+        return;
+    }
+    
+    NSURL *URL = [[[self.prefetchURLs objectAtIndex:0] retain] autorelease];
+    [self.prefetchURLs removeObjectAtIndex:0];
+    
+    // The protocol cache policy lets the URL loading system revalidate stale responses instead of downloading them again
+    NSURLRequest *request = [NSURLRequest requestWithURL:URL];
+    self.prefetchConnection = [NSURLConnection connectionWithRequest:request delegate:self];
+    HLSLoggerDebug(@"Prefetching %@", URL);
+}
+
+#pragma mark NSURLConnection delegate methods
+
+- (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data
+{
+    // Nothing to do, the response is cached by the URL loading system
+}
+
+- (void)connectionDidFinishLoading:(NSURLConnection *)connection
+{
+    self.prefetchConnection = nil;
+    [self schedulePrefetch];
+}
+
+- (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error
+{
+    HLSLoggerDebug(@"Prefetching failed. Reason: %@", error);
+    
+    self.prefetchConnection = nil;
+    [self schedulePrefetch];
+}
+
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    // Empty the memory cache, keep its budget
+    NSUInteger memoryCapacity = self.memoryCapacity;
+    self.memoryCapacity = 0;
+    self.memoryCapacity = memoryCapacity;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; memoryUsage: %d / %d; diskUsage: %d / %d; hitCount: %d; missCount: %d>",
+            [self class],
+            self,
+            [self currentMemoryUsage],
+            [self memoryCapacity],
+            [self currentDiskUsage],
+            [self diskCapacity],
+            [self hitCount],
+            [self missCount]];
+}
+
+@end
@@ -0,0 +1,60 @@
+//
+//  HLSWebViewPool.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * A small pool of web views created in advance, so that screens displaying web content (most notably HLSWebViewController)
+ * do not have to pay for web view creation when they are loaded. The pool is filled when the application is idle (not
+ * while the user is interacting with it, e.g. scrolling), and refilled in the same way each time a web view is taken
+ * from it. If application preloading is enabled (see HLSApplicationPreloader.h), the pool is automatically filled once 
+ * the web engine has been warmed up.
+ *
+ * Web views are not returned to the pool after use: UIWebView offers no way to clear its back / forward list, and
+ * reusing a web view would let users navigate back to pages opened elsewhere (even if it had been cleaned by loading 
+ * about:blank). Web views taken from the pool are therefore always fresh, and used ones are simply discarded.
+ *
+ * The pool is emptied when a memory warning is received.
+ *
+ * This class is not thread-safe and must only be used from the main thread.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSWebViewPool : NSObject {
+@private
+    NSMutableArray *m_webViews;
+    NSUInteger m_capacity;
+}
+
+/**
+ * The pool used by CoconutKit
+ */
++ (HLSWebViewPool *)sharedWebViewPool;
+
+/**
+ * The number of web views kept ready. Set to 0 to disable pooling
+ *
+ * Default value is 1
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
+/**
+ * Fill the pool during the next idle run loop passes
+ */
+- (void)fill;
+
+/**
+ * Return a web view with the specified frame, from the pool if one is available, otherwise created on the fly. The
+ * pool is then refilled when the application is idle
+ */
+- (UIWebView *)webViewWithFrame:(CGRect)frame;
+
+/**
+ * Discard all web views currently in the pool
+ */
+- (void)purge;
+
+@end
@@ -0,0 +1,148 @@
+//
+//  HLSWebViewPool.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSWebViewPool.h"
+
+#import "HLSLogger.h"
+
+@interface HLSWebViewPool ()
+
+@property (nonatomic, retain) NSMutableArray *webViews;
+
+- (void)fillOneWebView;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation HLSWebViewPool
+
+#pragma mark Class methods
+
++ (HLSWebViewPool *)sharedWebViewPool
+{
+    static HLSWebViewPool *s_instance = nil;
+    
+    if (! s_instance) {
+        s_instance = [[HLSWebViewPool alloc] init];
+    }
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.webViews = [NSMutableArray array];
+        self.capacity = 1;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(fillOneWebView) object:nil];
+    
+    self.webViews = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize webViews = m_webViews;
+
+@synthesize capacity = m_capacity;
+
+- (void)setCapacity:(NSUInteger)capacity
+{
+    m_capacity = capacity;
+    
+    while ([self.webViews count] > capacity) {
+        [self.webViews removeLastObject];
+    }
+}
+
+#pragma mark Pool management
+
+- (void)fill
+{
+    if ([self.webViews count] >= self.capacity) {
+        return;
+    }
+    
+    // Only performed in the default run loop mode, i.e. not while the user is interacting with the interface
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(fillOneWebView) object:nil];
+    [self performSelector:@selector(fillOneWebView)
+               withObject:nil
+               afterDelay:0.
+                  inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
+- (void)fillOneWebView
+{
+    if ([self.webViews count] >= self.capacity) {
+        return;
+    }
+    
+    // One web view at a time so that the main thread is never blocked for long
+    CGRect applicationFrame = [UIScreen mainScreen].applicationFrame;
+    UIWebView *webView = [[[UIWebView alloc] initWithFrame:applicationFrame] autorelease];
+    [self.webViews addObject:webView];
+    HLSLoggerDebug(@"Web view added to the pool (%d / %d)", [self.webViews count], self.capacity);
+    
+    [self fill];
+}
+
+- (UIWebView *)webViewWithFrame:(CGRect)frame
+{
+    UIWebView *webView = [[[self.webViews lastObject] retain] autorelease];
+    if (webView) {
+        [self.webViews removeLastObject];
+        webView.frame = frame;
+    }
+    else {
+        webView = [[[UIWebView alloc] initWithFrame:frame] autorelease];
+    }
+    
+    [self fill];
+    return webView;
+}
+
+- (void)purge
+{
+    [self.webViews removeAllObjects];
+}
+
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(fillOneWebView) object:nil];
+    [self purge];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; webViews: %d; capacity: %d>",
+            [self class],
+            self,
+            [self.webViews count],
+            self.capacity];
+}
+
+@end
@@ -15,15 +15,25 @@
  *
  * HLSZeroingWeakRef instances must be retained by the objects which store them.
  *
- * The current implementation of HLSZeroingWeakRef is fairly basic:
+ * Zeroing weak references are stored in a global side table indexed by object address, and the -dealloc
+ * method of each class whose instances are referenced is hooked the first time a zeroing weak reference
+ * to one of its instances is created. Objects keep their class (no dynamic subclass is created), so that
+ * -class, KVO and other isa-based mechanisms are not affected. The side table is split into stripes, each
+ * protected by its own lock, so that creating, accessing or releasing zeroing weak references is safe from
+ * several threads without much contention.
+ *
+ * Remarks:
  *   - zeroing weak references to toll-free bridged objects (NSString, NSURL, NSNumber, etc.) are not 
  *     supported. Attempting to initialize a zeroing weak with a toll-free bridged object results in 
  *     an exception being thrown
- *   - thread-safety issues have been ignored
+ *   - cleanup invocations are performed with a side table lock held, and therefore must not wait on
+ *     other threads using zeroing weak references
+ *   - an object returned by the object property is not retained. Thread-safety does not extend to an
+ *     object released on one thread while it is accessed on another one
  *
  * This implementation should suffice in most cases (weak pointers to instances of custom Objective-C 
- * classes, accessed from a single thread). In other cases, consider using Mike Ash implementation
- * found at https://github.com/mikeash/MAZeroingWeakRef or ARC zeroing weak references.
+ * classes). In other cases, consider using Mike Ash implementation found at 
+ * https://github.com/mikeash/MAZeroingWeakRef or ARC zeroing weak references.
  */
 @interface HLSZeroingWeakRef : NSObject {
 @private
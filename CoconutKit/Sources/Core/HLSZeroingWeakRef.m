@@ -9,14 +9,50 @@
 #import "HLSZeroingWeakRef.h"
 
 #import <objc/runtime.h>
+#import <pthread.h>
+#import "HLSRuntime.h"
 #import "NSObject+HLSExtensions.h"
 
-// Associated object keys
-static void *s_zeroingWeakRefListKey = &s_zeroingWeakRefListKey;
+// Number of stripes of the side table (power of 2)
+static const NSUInteger kSideTableStripeCount = 16;
 
-// Static methods
-static void subclass_dealloc(id object, SEL _cmd);
-static Class subclass_class(id object, SEL _cmd);
+// Number of zeroing weak references to an object which can be stored before switching to a hash set. Most objects
+// only have one or two zeroing weak references (e.g. delegates)
+#define kZeroingWeakRefListInlineCapacity 4
+
+// The zeroing weak references to an object. References are stored in a small inline array, or in a hash set when
+// there are more than kZeroingWeakRefListInlineCapacity of them (references are not retained)
+typedef struct {
+    NSUInteger inlineCount;
+    HLSZeroingWeakRef *inlineZeroingWeakRefs[kZeroingWeakRefListInlineCapacity];
+    CFMutableSetRef zeroingWeakRefs;                // NULL until the inline capacity has been exceeded
+    BOOL zeroing;                                   // YES while the object is being deallocated
+} HLSZeroingWeakRefList;
+
+// A side table stripe maps object addresses to the list of zeroing weak references pointing at them (neither
+// objects nor lists are retained)
+typedef struct {
+    pthread_mutex_t mutex;
+    CFMutableDictionaryRef objectToZeroingWeakRefsMap;
+} HLSZeroingWeakRefSideTableStripe;
+
+static HLSZeroingWeakRefSideTableStripe s_sideTableStripes[kSideTableStripeCount];
+
+// Classes whose -dealloc method has been hooked
+static CFMutableSetRef s_hookedClasses = NULL;
+static pthread_mutex_t s_hookedClassesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Static functions
+static HLSZeroingWeakRefList *HLSZeroingWeakRefListCreate(void);
+static void HLSZeroingWeakRefListDestroy(HLSZeroingWeakRefList *list);
+static NSUInteger HLSZeroingWeakRefListGetCount(HLSZeroingWeakRefList *list);
+static BOOL HLSZeroingWeakRefListContainsValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef);
+static void HLSZeroingWeakRefListAddValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef);
+static void HLSZeroingWeakRefListRemoveValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef);
+static void HLSZeroingWeakRefListGetValues(HLSZeroingWeakRefList *list, HLSZeroingWeakRef **values);
+static HLSZeroingWeakRefSideTableStripe *HLSZeroingWeakRefSideTableStripeForObject(id object);
+static void HLSZeroingWeakRefHookDeallocForClass(Class class);
+static void HLSZeroingWeakRefZeroReferencesToObject(id object);
 
 @interface HLSZeroingWeakRef ()
 
@@ -33,11 +69,8 @@ static Class subclass_class(id object, SEL _cmd);
 {
     if ((self = [super init])) {
         self.invocations = [NSMutableArray array];
-        self.object = object;
         
         if (object) {
-            static NSString * const kSubclassPrefix = @"HLSZeroingWeakRef_";
-            
             // Access the real class, do not use [self class] here since can be faked
             Class class = object_getClass(object);
             
@@ -50,39 +83,23 @@ static Class subclass_class(id object, SEL _cmd);
                                              userInfo:nil];
             }
             
-            // Dynamically subclass the object class to override -dealloc selectively, and use this class instead.
-            // Another approach would involve swizzling -dealloc at the NSObject level, but this solution would 
-            // incur an unacceptable overhead on all NSObjects
-            NSString *className = [NSString stringWithUTF8String:class_getName(class)];
-            if (! [className hasPrefix:kSubclassPrefix]) {
-                NSString *subclassName = [kSubclassPrefix stringByAppendingString:className];
-                Class subclass = NSClassFromString(subclassName);
-                if (! subclass) {
-                    subclass = objc_allocateClassPair(class, [subclassName UTF8String], 0);
-                    NSAssert(subclass != Nil, @"Could not register subclass");
-                    class_addMethod(subclass, 
-                                    @selector(dealloc), 
-                                    (IMP)subclass_dealloc, 
-                                    method_getTypeEncoding(class_getInstanceMethod(class, @selector(dealloc))));
-                    class_addMethod(subclass, 
-                                    @selector(class), 
-                                    (IMP)subclass_class, 
-                                    method_getTypeEncoding(class_getClassMethod(class, @selector(class))));
-                    objc_registerClassPair(subclass);
-                }
-                
-                // Changes the object class
-                object_setClass(object, subclass);    
+            // Classes created by KVO only exist while an object is observed. Hook the class the object returns to
+            // when observation stops (KVO -dealloc implementations call the parent implementation)
+            while ([NSStringFromClass(class) hasPrefix:@"NSKVONotifying_"]) {
+                class = class_getSuperclass(class);
             }
+            HLSZeroingWeakRefHookDeallocForClass(class);
             
-            // Attach to object a list storing all zeroing weak references pointing at it
-            NSMutableSet *zeroingWeakRefValues = objc_getAssociatedObject(object, s_zeroingWeakRefListKey);
-            if (! zeroingWeakRefValues) {
-                zeroingWeakRefValues = [NSMutableSet set];
-                objc_setAssociatedObject(object, s_zeroingWeakRefListKey, zeroingWeakRefValues, OBJC_ASSOCIATION_RETAIN);
+            HLSZeroingWeakRefSideTableStripe *stripe = HLSZeroingWeakRefSideTableStripeForObject(object);
+            pthread_mutex_lock(&stripe->mutex);
+            HLSZeroingWeakRefList *list = (HLSZeroingWeakRefList *)CFDictionaryGetValue(stripe->objectToZeroingWeakRefsMap, object);
+            if (! list) {
+                list = HLSZeroingWeakRefListCreate();
+                CFDictionarySetValue(stripe->objectToZeroingWeakRefsMap, object, list);
             }
-            NSValue *selfValue = [NSValue valueWithPointer:self];
-            [zeroingWeakRefValues addObject:selfValue];
+            HLSZeroingWeakRefListAddValue(list, self);
+            m_object = object;
+            pthread_mutex_unlock(&stripe->mutex);
         }        
     }
     return self;
@@ -90,17 +107,23 @@ static Class subclass_class(id object, SEL _cmd);
 
 - (void)dealloc
 {
-    NSMutableSet *zeroingWeakRefValues = objc_getAssociatedObject(self.object, s_zeroingWeakRefListKey);
-    NSValue *selfValue = [NSValue valueWithPointer:self];
-    [zeroingWeakRefValues removeObject:selfValue];
-    
-    // No weak ref anymore. Can remove the dynamic subclass
-    if ([zeroingWeakRefValues count] == 0) {
-        Class superclass = class_getSuperclass(object_getClass(self.object));
-        object_setClass(self.object, superclass);
+    // m_object can only be zeroed with the corresponding stripe lock held. Check again once acquired
+    id object = m_object;
+    if (object) {
+        HLSZeroingWeakRefSideTableStripe *stripe = HLSZeroingWeakRefSideTableStripeForObject(object);
+        pthread_mutex_lock(&stripe->mutex);
+        if (m_object) {
+            HLSZeroingWeakRefList *list = (HLSZeroingWeakRefList *)CFDictionaryGetValue(stripe->objectToZeroingWeakRefsMap, object);
+            HLSZeroingWeakRefListRemoveValue(list, self);
+            if (HLSZeroingWeakRefListGetCount(list) == 0 && ! list->zeroing) {
+                CFDictionaryRemoveValue(stripe->objectToZeroingWeakRefsMap, object);
+                HLSZeroingWeakRefListDestroy(list);
+            }
+            m_object = nil;
+        }
+        pthread_mutex_unlock(&stripe->mutex);
     }
     
-    self.object = nil;
     self.invocations = nil;
     
     [super dealloc];
@@ -110,6 +133,20 @@ static Class subclass_class(id object, SEL _cmd);
 
 @synthesize object = m_object;
 
+- (id)object
+{
+    id object = m_object;
+    if (! object) {
+        return nil;
+    }
+    
+    HLSZeroingWeakRefSideTableStripe *stripe = HLSZeroingWeakRefSideTableStripeForObject(object);
+    pthread_mutex_lock(&stripe->mutex);
+    object = m_object;
+    pthread_mutex_unlock(&stripe->mutex);
+    return object;
+}
+
 @synthesize invocations = m_invocations;
 
 #pragma mark Optional cleanup
@@ -130,32 +167,193 @@ static Class subclass_class(id object, SEL _cmd);
 
 @end
 
-static void subclass_dealloc(id object, SEL _cmd)
+static HLSZeroingWeakRefSideTableStripe *HLSZeroingWeakRefSideTableStripeForObject(id object)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        // Recursive locks, since cleanup invocations (performed with the lock held) might create or release
+        // zeroing weak references
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+        for (NSUInteger i = 0; i < kSideTableStripeCount; ++i) {
+            pthread_mutex_init(&s_sideTableStripes[i].mutex, &attributes);
+            s_sideTableStripes[i].objectToZeroingWeakRefsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        }
+        pthread_mutexattr_destroy(&attributes);
+    });
+    
+    // Objects are at least 16-byte aligned. Mix in higher bits so that consecutive allocations spread over stripes
+    uintptr_t address = (uintptr_t)object;
+    return &s_sideTableStripes[((address >> 4) ^ (address >> 10)) & (kSideTableStripeCount - 1)];
+}
+
+static void HLSZeroingWeakRefHookDeallocForClass(Class class)
+{
+    pthread_mutex_lock(&s_hookedClassesMutex);
+    if (! s_hookedClasses) {
+        s_hookedClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    
+    if (! CFSetContainsValue(s_hookedClasses, class)) {
+        // Hook -dealloc for this class only (it might be inherited, in which case an implementation is added to the
+        // class). Another approach would involve swizzling -dealloc at the NSObject level, but this would incur an
+        // unacceptable overhead on all NSObjects. The original implementation must be known before the hook is
+        // installed, since instances might be deallocated on another thread meanwhile
+        IMP originalImplementation = method_getImplementation(class_getInstanceMethod(class, @selector(dealloc)));
+        NSCAssert(originalImplementation != NULL, @"Could not locate original dealloc implementation");
+        void (^deallocBlock)(id) = ^(id object) {
+            HLSZeroingWeakRefZeroReferencesToObject(object);
+            (*(void (*)(id, SEL))originalImplementation)(object, @selector(dealloc));
+        };
+        HLSSwizzleSelector(class, @selector(dealloc), imp_implementationWithBlock((id)deallocBlock));
+        CFSetAddValue(s_hookedClasses, class);
+    }
+    pthread_mutex_unlock(&s_hookedClassesMutex);
+}
+
+static void HLSZeroingWeakRefZeroReferencesToObject(id object)
 {
-    // Set all weak references bound to object to nil
-    NSMutableSet *zeroingWeakRefValues = objc_getAssociatedObject(object, s_zeroingWeakRefListKey);
-    for (NSValue *zeroingWeakRefValue in zeroingWeakRefValues) {
-        HLSZeroingWeakRef *zeroingWeakRef = [zeroingWeakRefValue pointerValue];
+    HLSZeroingWeakRefSideTableStripe *stripe = HLSZeroingWeakRefSideTableStripeForObject(object);
+    pthread_mutex_lock(&stripe->mutex);
+    
+    // The list must stay alive while references are zeroed, since cleanup invocations might release references
+    // (which then remove themselves from the list) or create new ones
+    HLSZeroingWeakRefList *list = (HLSZeroingWeakRefList *)CFDictionaryGetValue(stripe->objectToZeroingWeakRefsMap, object);
+    if (list) {
+        list->zeroing = YES;
         
-        // Execute optional invocations
-        for (NSInvocation *invocation in zeroingWeakRef.invocations) {
-            [invocation invoke];
+        NSUInteger count = 0;
+        while ((count = HLSZeroingWeakRefListGetCount(list)) != 0) {
+            // Usually small enough for the stack
+            HLSZeroingWeakRef *inlineValues[kZeroingWeakRefListInlineCapacity];
+            HLSZeroingWeakRef **values = inlineValues;
+            if (count > kZeroingWeakRefListInlineCapacity) {
+                values = malloc(count * sizeof(HLSZeroingWeakRef *));
+            }
+            HLSZeroingWeakRefListGetValues(list, values);
+            
+            for (NSUInteger i = 0; i < count; ++i) {
+                HLSZeroingWeakRef *zeroingWeakRef = values[i];
+                if (! HLSZeroingWeakRefListContainsValue(list, zeroingWeakRef)) {
+                    continue;
+                }
+                HLSZeroingWeakRefListRemoveValue(list, zeroingWeakRef);
+                
+                // Invocations might release the last reference to the zeroing weak reference (e.g. an owner clearing
+                // it). Keep it alive until zeroed, and enumerate a copy of its invocations
+                [zeroingWeakRef retain];
+                
+                // Execute optional invocations
+                NSArray *invocations = [NSArray arrayWithArray:zeroingWeakRef.invocations];
+                for (NSInvocation *invocation in invocations) {
+                    [invocation invoke];
+                }
+                
+                // Zeroing
+                zeroingWeakRef.object = nil;
+                [zeroingWeakRef release];
+            }
+            
+            if (values != inlineValues) {
+                free(values);
+            }
         }
         
-        // Zeroing
-        zeroingWeakRef.object = nil;
+        CFDictionaryRemoveValue(stripe->objectToZeroingWeakRefsMap, object);
+        HLSZeroingWeakRefListDestroy(list);
     }
     
-    // Call parent implementation
-    Class superclass = class_getSuperclass(object_getClass(object));
-    void (*parent_dealloc_Imp)(id, SEL) = (void (*)(id, SEL))class_getMethodImplementation(superclass, @selector(dealloc));
-    NSCAssert(parent_dealloc_Imp != NULL, @"Could not locate parent dealloc implementation");
-    (*parent_dealloc_Imp)(object, _cmd);
+    pthread_mutex_unlock(&stripe->mutex);
 }
 
-static Class subclass_class(id object, SEL _cmd)
+static HLSZeroingWeakRefList *HLSZeroingWeakRefListCreate(void)
 {
-    // Lie about the dynamic subclass existence, as the KVO implementation does (the real class can still be seen
-    // using object_getClass)
-    return class_getSuperclass(object_getClass(object));
+    return calloc(1, sizeof(HLSZeroingWeakRefList));
+}
+
+static void HLSZeroingWeakRefListDestroy(HLSZeroingWeakRefList *list)
+{
+    if (list->zeroingWeakRefs) {
+        CFRelease(list->zeroingWeakRefs);
+    }
+    free(list);
+}
+
+static NSUInteger HLSZeroingWeakRefListGetCount(HLSZeroingWeakRefList *list)
+{
+    if (list->zeroingWeakRefs) {
+        return CFSetGetCount(list->zeroingWeakRefs);
+    }
+    else {
+        return list->inlineCount;
+    }
+}
+
+static BOOL HLSZeroingWeakRefListContainsValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef)
+{
+    if (list->zeroingWeakRefs) {
+        return CFSetContainsValue(list->zeroingWeakRefs, zeroingWeakRef);
+    }
+    
+    for (NSUInteger i = 0; i < list->inlineCount; ++i) {
+        if (list->inlineZeroingWeakRefs[i] == zeroingWeakRef) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static void HLSZeroingWeakRefListAddValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef)
+{
+    if (list->zeroingWeakRefs) {
+        CFSetAddValue(list->zeroingWeakRefs, zeroingWeakRef);
+        return;
+    }
+    
+    if (HLSZeroingWeakRefListContainsValue(list, zeroingWeakRef)) {
+        return;
+    }
+    
+    if (list->inlineCount < kZeroingWeakRefListInlineCapacity) {
+        list->inlineZeroingWeakRefs[list->inlineCount] = zeroingWeakRef;
+        ++list->inlineCount;
+    }
+    // Inline capacity exceeded. Switch to a hash set (for good)
+    else {
+        list->zeroingWeakRefs = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        for (NSUInteger i = 0; i < list->inlineCount; ++i) {
+            CFSetAddValue(list->zeroingWeakRefs, list->inlineZeroingWeakRefs[i]);
+        }
+        CFSetAddValue(list->zeroingWeakRefs, zeroingWeakRef);
+        list->inlineCount = 0;
+    }
+}
+
+static void HLSZeroingWeakRefListRemoveValue(HLSZeroingWeakRefList *list, HLSZeroingWeakRef *zeroingWeakRef)
+{
+    if (list->zeroingWeakRefs) {
+        CFSetRemoveValue(list->zeroingWeakRefs, zeroingWeakRef);
+        return;
+    }
+    
+    // Order does not matter. Replace with the last element
+    for (NSUInteger i = 0; i < list->inlineCount; ++i) {
+        if (list->inlineZeroingWeakRefs[i] == zeroingWeakRef) {
+            --list->inlineCount;
+            list->inlineZeroingWeakRefs[i] = list->inlineZeroingWeakRefs[list->inlineCount];
+            list->inlineZeroingWeakRefs[list->inlineCount] = nil;
+            return;
+        }
+    }
+}
+
+static void HLSZeroingWeakRefListGetValues(HLSZeroingWeakRefList *list, HLSZeroingWeakRef **values)
+{
+    if (list->zeroingWeakRefs) {
+        CFSetGetValues(list->zeroingWeakRefs, (const void **)values);
+    }
+    else {
+        memcpy(values, list->inlineZeroingWeakRefs, list->inlineCount * sizeof(HLSZeroingWeakRef *));
+    }
 }
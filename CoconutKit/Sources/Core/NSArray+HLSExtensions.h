@@ -17,12 +17,27 @@
 
 /**
  * Rotate array elements left or right (elements disappearing at an end are moved to the other end)
+ *
+ * The returned array is a lightweight view presenting the objects of (a copy of) the receiver in rotated order, 
+ * which is created in constant time and memory if the receiver is immutable. Rotating a rotated array does not
+ * stack views. Object access through the view is slightly slower than with a plain array, call -arrayByMaterializingObjects
+ * if you need a plain array
  */
 - (NSArray *)arrayByLeftRotatingNumberOfObjects:(NSUInteger)numberOfElements;
 - (NSArray *)arrayByRightRotatingNumberOfObjects:(NSUInteger)numberOfElements;
 
+/**
+ * Return a plain array containing the objects of the receiver (the receiver itself if it already is a plain 
+ * immutable array)
+ */
+- (NSArray *)arrayByMaterializingObjects;
+
 /**
  * Sort an array using a single descriptor
+ *
+ * For large arrays, sort key values are extracted once on the calling thread, and then sorted in parallel. The 
+ * comparison selector or comparator of the descriptor must therefore be thread-safe, as the usual -compare: methods
+ * are. Sorting is stable
  */
 - (NSArray *)sortedArrayUsingDescriptor:(NSSortDescriptor *)sortDescriptor;
 
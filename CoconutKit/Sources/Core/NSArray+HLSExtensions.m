@@ -8,6 +8,40 @@
 
 #import "NSArray+HLSExtensions.h"
 
+#import <objc/message.h>
+
+// Arrays with at least this number of objects are sorted by extracting their sort keys first, and in parallel
+static const NSUInteger kParallelSortThreshold = 4096;
+
+// Sort context shared by all sorting tasks
+typedef struct {
+    id *values;                             // Sort key values, indexed by object index
+    SEL selector;                           // Comparison selector (if no comparator)
+    NSComparator comparator;                // Comparison block (if any)
+    BOOL ascending;
+} HLSSortContext;
+
+// Static functions
+static NSArray *HLSSortedArrayUsingDescriptor(NSArray *array, NSSortDescriptor *sortDescriptor);
+static NSComparisonResult HLSSortContextCompare(const HLSSortContext *context, NSUInteger index1, NSUInteger index2);
+static void HLSSortContextMerge(const HLSSortContext *context, const NSUInteger *source, NSUInteger leftLength, 
+                                NSUInteger rightLength, NSUInteger *destination);
+static void HLSSortContextMergeSort(const HLSSortContext *context, NSUInteger *indices, NSUInteger *buffer, NSUInteger length);
+
+/**
+ * Immutable view presenting the objects of an array rotated by some offset: The object at index i is the one at 
+ * index (i + offset) % count in the underlying array
+ */
+@interface HLSRotatedArray : NSArray {
+@private
+    NSArray *m_array;
+    NSUInteger m_offset;
+}
+
+- (id)initWithBaseArray:(NSArray *)array offset:(NSUInteger)offset;
+
+@end
+
 @interface NSArray (HLSExtensionsPrivate)
 
 - (NSArray *)arrayByShiftingNumberOfObjects:(NSUInteger)numberOfElements;
@@ -27,7 +61,7 @@
 
 - (NSArray *)arrayByLeftRotatingNumberOfObjects:(NSUInteger)numberOfObjects
 {
-    if (numberOfObjects == 0) {
+    if (numberOfObjects == 0 || [self count] == 0) {
         return self;
     }
     
@@ -37,7 +71,7 @@
 
 - (NSArray *)arrayByRightRotatingNumberOfObjects:(NSUInteger)numberOfObjects
 {
-    if (numberOfObjects == 0) {
+    if (numberOfObjects == 0 || [self count] == 0) {
         return self;
     }
     
@@ -45,16 +79,262 @@
     return [self arrayByShiftingNumberOfObjects:[self count] - shift];
 }
 
+- (NSArray *)arrayByMaterializingObjects
+{
+    return [[self copy] autorelease];
+}
+
 - (NSArray *)arrayByShiftingNumberOfObjects:(NSUInteger)numberOfObjects
 {
-    return [[self subarrayWithRange:NSMakeRange(numberOfObjects, [self count] -  numberOfObjects)] 
-            arrayByAddingObjectsFromArray:[self subarrayWithRange:NSMakeRange(0, numberOfObjects)]];
+    return [[[HLSRotatedArray alloc] initWithBaseArray:self offset:numberOfObjects] autorelease];
 }
 
 - (NSArray *)sortedArrayUsingDescriptor:(NSSortDescriptor *)sortDescriptor
 {
+    if (sortDescriptor && [self count] >= kParallelSortThreshold) {
+        return HLSSortedArrayUsingDescriptor(self, sortDescriptor);
+    }
+    
     NSArray *sortDescriptors = sortDescriptor ? [NSArray arrayWithObject:sortDescriptor] : nil;
     return [self sortedArrayUsingDescriptors:sortDescriptors];
 }
 
 @end
+
+static NSArray *HLSSortedArrayUsingDescriptor(NSArray *array, NSSortDescriptor *sortDescriptor)
+{
+    NSUInteger count = [array count];
+    id *objects = malloc(count * sizeof(id));
+    [array getObjects:objects range:NSMakeRange(0, count)];
+    
+    // Extract all sort key values once on the calling thread (objects, e.g. managed objects, might not be thread-safe), 
+    // rather than for each comparison
+    HLSSortContext context;
+    context.values = malloc(count * sizeof(id));
+    context.selector = [sortDescriptor selector] ? [sortDescriptor selector] : @selector(compare:);
+    context.comparator = [sortDescriptor respondsToSelector:@selector(comparator)] ? [sortDescriptor comparator] : nil;
+    context.ascending = [sortDescriptor ascending];
+    NSString *key = [sortDescriptor key];
+    for (NSUInteger i = 0; i < count; ++i) {
+        context.values[i] = key ? [objects[i] valueForKeyPath:key] : objects[i];
+    }
+    
+    // Sort object indices by chunks, one per processor, then merge chunks pairwise until a single one remains. Merge 
+    // sort is stable, as NSSortDescriptor-based sorting
+    NSUInteger *indices = malloc(count * sizeof(NSUInteger));
+    NSUInteger *buffer = malloc(count * sizeof(NSUInteger));
+    for (NSUInteger i = 0; i < count; ++i) {
+        indices[i] = i;
+    }
+    
+    NSUInteger numberOfChunks = MAX([[NSProcessInfo processInfo] activeProcessorCount], 1);
+    NSUInteger chunkLength = (count + numberOfChunks - 1) / numberOfChunks;
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_apply(numberOfChunks, queue, ^(size_t chunk) {
+        NSUInteger location = MIN(chunk * chunkLength, count);
+        NSUInteger length = MIN(chunkLength, count - location);
+        HLSSortContextMergeSort(&context, indices + location, buffer + location, length);
+    });
+    
+    for (; chunkLength < count; chunkLength *= 2) {
+        NSUInteger numberOfMerges = (count + 2 * chunkLength - 1) / (2 * chunkLength);
+        NSUInteger *source = indices;
+        NSUInteger *destination = buffer;
+        dispatch_apply(numberOfMerges, queue, ^(size_t merge) {
+            NSUInteger location = merge * 2 * chunkLength;
+            NSUInteger leftLength = MIN(chunkLength, count - location);
+            NSUInteger rightLength = MIN(chunkLength, count - location - leftLength);
+            HLSSortContextMerge(&context, source + location, leftLength, rightLength, destination + location);
+        });
+        
+        indices = destination;
+        buffer = source;
+    }
+    
+    // Gather objects in sorted order
+    id *sortedObjects = malloc(count * sizeof(id));
+    for (NSUInteger i = 0; i < count; ++i) {
+        sortedObjects[i] = objects[indices[i]];
+    }
+    NSArray *sortedArray = [NSArray arrayWithObjects:sortedObjects count:count];
+    
+    free(sortedObjects);
+    free(buffer);
+    free(indices);
+    free(context.values);
+    free(objects);
+    
+    return sortedArray;
+}
+
+static NSComparisonResult HLSSortContextCompare(const HLSSortContext *context, NSUInteger index1, NSUInteger index2)
+{
+    id value1 = context->values[index1];
+    id value2 = context->values[index2];
+    
+    // As for NSSortDescriptor, nil values are smaller than any other value and are never passed to the comparison
+    NSComparisonResult result;
+    if (! value1 || ! value2) {
+        result = (value1 == value2) ? NSOrderedSame : (value1 ? NSOrderedDescending : NSOrderedAscending);
+    }
+    else {
+        result = context->comparator ? context->comparator(value1, value2) 
+            : ((NSComparisonResult (*)(id, SEL, id))objc_msgSend)(value1, context->selector, value2);
+    }
+    return context->ascending ? result : -result;
+}
+
+// Merge two adjacent sorted runs of source into destination. Ties are resolved in favor of the left run
+static void HLSSortContextMerge(const HLSSortContext *context, const NSUInteger *source, NSUInteger leftLength, 
+                                NSUInteger rightLength, NSUInteger *destination)
+{
+    const NSUInteger *left = source;
+    const NSUInteger *right = source + leftLength;
+    NSUInteger i = 0, j = 0, k = 0;
+    while (i < leftLength && j < rightLength) {
+        if (HLSSortContextCompare(context, right[j], left[i]) == NSOrderedAscending) {
+            destination[k++] = right[j++];
+        }
+        else {
+            destination[k++] = left[i++];
+        }
+    }
+    while (i < leftLength) {
+        destination[k++] = left[i++];
+    }
+    while (j < rightLength) {
+        destination[k++] = right[j++];
+    }
+}
+
+// Bottom-up merge sort of indices, using a buffer of the same length. Sorted indices are stored in indices
+static void HLSSortContextMergeSort(const HLSSortContext *context, NSUInteger *indices, NSUInteger *buffer, NSUInteger length)
+{
+    NSUInteger *source = indices;
+    NSUInteger *destination = buffer;
+    for (NSUInteger runLength = 1; runLength < length; runLength *= 2) {
+        for (NSUInteger location = 0; location < length; location += 2 * runLength) {
+            NSUInteger leftLength = MIN(runLength, length - location);
+            NSUInteger rightLength = MIN(runLength, length - location - leftLength);
+            HLSSortContextMerge(context, source + location, leftLength, rightLength, destination + location);
+        }
+        
+        NSUInteger *swap = source;
+        source = destination;
+        destination = swap;
+    }
+    
+    if (source != indices) {
+        memcpy(indices, source, length * sizeof(NSUInteger));
+    }
+}
+
+@implementation HLSRotatedArray
+
+#pragma mark Object creation and destruction
+
+- (id)initWithBaseArray:(NSArray *)array offset:(NSUInteger)offset
+{
+    if ((self = [super init])) {
+        // Rotate the underlying array of a rotated array instead of stacking views
+        if ([array isKindOfClass:[HLSRotatedArray class]]) {
+            HLSRotatedArray *rotatedArray = (HLSRotatedArray *)array;
+            offset = (rotatedArray->m_offset + offset) % [array count];
+            array = rotatedArray->m_array;
+        }
+        
+        // Free for immutable arrays, and protects against later changes of mutable ones
+        m_array = [array copy];
+        m_offset = offset;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_array release];
+    
+    [super dealloc];
+}
+
+#pragma mark NSArray primitive methods
+
+- (NSUInteger)count
+{
+    return [m_array count];
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    NSUInteger count = [m_array count];
+    if (index >= count) {
+        @throw [NSException exceptionWithName:NSRangeException
+                                       reason:[NSString stringWithFormat:@"Index %u beyond bounds [0 .. %d]", index, (NSInteger)count - 1]
+                                     userInfo:nil];
+    }
+    
+    NSUInteger baseIndex = index + m_offset;
+    if (baseIndex >= count) {
+        baseIndex -= count;
+    }
+    return [m_array objectAtIndex:baseIndex];
+}
+
+#pragma mark Overrides for efficiency
+
+- (void)getObjects:(id *)objects range:(NSRange)range
+{
+    // At most two contiguous ranges of the underlying array
+    NSUInteger count = [m_array count];
+    NSUInteger baseLocation = range.location + m_offset;
+    if (baseLocation >= count) {
+        baseLocation -= count;
+    }
+    NSUInteger firstLength = MIN(range.length, count - baseLocation);
+    [m_array getObjects:objects range:NSMakeRange(baseLocation, firstLength)];
+    if (firstLength < range.length) {
+        [m_array getObjects:objects + firstLength range:NSMakeRange(0, range.length - firstLength)];
+    }
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id *)stackbuf count:(NSUInteger)len
+{
+    // state->state is the number of objects enumerated so far. The receiver is immutable, mutationsPtr can point at
+    // any constant value
+    if (state->state == 0) {
+        state->mutationsPtr = &state->extra[0];
+    }
+    
+    NSUInteger count = [m_array count];
+    NSUInteger length = MIN(len, count - state->state);
+    if (length == 0) {
+        return 0;
+    }
+    
+    [self getObjects:stackbuf range:NSMakeRange(state->state, length)];
+    state->itemsPtr = stackbuf;
+    state->state += length;
+    return length;
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return [self retain];
+}
+
+#pragma mark Materialization
+
+- (NSArray *)arrayByMaterializingObjects
+{
+    NSUInteger count = [m_array count];
+    id *objects = malloc(count * sizeof(id));
+    [self getObjects:objects range:NSMakeRange(0, count)];
+    NSArray *array = [NSArray arrayWithObjects:objects count:count];
+    free(objects);
+    return array;
+}
+
+@end
@@ -8,6 +8,7 @@
 
 extern NSString * const HLSPreferredLocalizationDefaultsKey;
 extern NSString * const HLSCurrentLocalizationDidChangeNotification;
+extern NSString * const HLSDynamicLocalizationDisabledInfoKey;
 
 /**
  * Return the language for a localization
@@ -45,6 +46,20 @@ NSString *HLSLocalizedStringFromUIKit(NSString *key);
  *
  * It does not affect any class method of NSBundle.
  *
+ * Strings tables are parsed once and kept in memory until the localization changes or a memory warning is received.
+ * For large tables, you can avoid parsing altogether by adding a Run Script build phase to your application target,
+ * compiling the strings files of the application bundle into memory-mapped binary tables:
+ *   python "${SRCROOT}/path/to/CoconutKit/Tools/Localization/compile_strings_tables.py" "${TARGET_BUILD_DIR}/${UNLOCALIZED_RESOURCES_FOLDER_PATH}"
+ * Precompiled tables are then automatically used instead of the corresponding strings files.
+ *
+ * Dynamic localization is enabled by default: The localization set using +setLocalization: is restored at launch,
+ * and labels in nib files are localized (see UILabel+HLSDynamicLocalization.h). Applications which do not need those
+ * features can avoid their launch cost by setting the HLSDynamicLocalizationDisabled key (HLSDynamicLocalizationDisabledInfoKey)
+ * to YES in their Info.plist. A warning is then logged at launch, so that the change does not go unnoticed.
+ *
+ * Localized strings and resources can be looked up from any thread. The localization must be changed from the main
+ * thread.
+ *
  * To localize images, you cannot use the usual -[UIImage imageNamed:] method because of the cache it maintains
  * (there is no public API to flush it). Instead, find the path of your image using one of the above URL... or
  * path... methods, and call -[UIImage imageWithContentsOfFile:]. You of course lose the benefits of the cache,
@@ -67,4 +82,40 @@ NSString *HLSLocalizedStringFromUIKit(NSString *key);
  */
 + (void)setLocalization:(NSString *)localization;
 
+/**
+ * Set the localization stored under the HLSPreferredLocalizationDefaultsKey key (if any), so that a localization set
+ * using +setLocalization: is kept between application launches. This method is automatically called at launch, except
+ * if dynamic localization has been disabled in the Info.plist. In this case, call it as soon as possible (i.e. before
+ * any string is localized) if you need it
+ */
++ (void)restorePreferredLocalization;
+
+/**
+ * Load the strings tables of the main bundle for a localization (if valid), so that they do not have to be loaded 
+ * when strings are first localized. Can be called from any thread
+ */
++ (void)preloadLocalization:(NSString *)localization;
+
+/**
+ * Same as +setLocalization:, but first loading the strings tables of the main bundle for the new localization on
+ * a background thread, so that the screens relocalized after the change do not have to load them on the main thread.
+ * The localization is then changed on the main thread (the current localization remains unchanged until then), and
+ * the optional completion block is called afterwards, also on the main thread. Must be called from the main thread.
+ * If this method is called again before the preloading ends, only the most recent localization is set (the completion
+ * blocks of earlier calls are still called, without changing the localization)
+ */
++ (void)preloadAndSetLocalization:(NSString *)localization completionBlock:(void (^)(void))completionBlock;
+
+/**
+ * When the NSShowNonLocalizedStrings default setting is enabled, each missing localized string is logged once and
+ * recorded. Return the list of missing localized strings found so far, one per line (bundle name, table and key
+ * separated by tabs, sorted), or an empty string if none
+ */
++ (NSString *)missingLocalizationsReport;
+
+/**
+ * Forget the missing localized strings recorded so far (they will be logged again when next found missing)
+ */
++ (void)resetMissingLocalizations;
+
 @end
@@ -8,11 +8,18 @@
 
 #import "NSBundle+HLSDynamicLocalization.h"
 
+#import <libkern/OSAtomic.h>
 #import <objc/runtime.h>
+#import <pthread.h>
+#import "HLSAllocationTracker+Friend.h"
 #import "HLSLogger.h"
+#import "HLSStartupReport.h"
+#import "HLSStringsTable.h"
+#import "HLSTrace.h"
 
 NSString * const HLSPreferredLocalizationDefaultsKey = @"HLSPreferredLocalization";
 NSString * const HLSCurrentLocalizationDidChangeNotification = @"HLSCurrentLocalizationDidChangeNotification";
+NSString * const HLSDynamicLocalizationDisabledInfoKey = @"HLSDynamicLocalizationDisabled";
 
 NSString *HLSLanguageForLocalization(NSString *localization)
 {
@@ -44,25 +51,87 @@ NSString *HLSLocalizedStringFromUIKit(NSString *key)
     return localizedString;
 }
 
+@interface NSBundle (HLSDynamicLocalizationPrivate)
+
++ (void)stringsTablesCacheDidReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
 @implementation NSBundle (HLSDynamicLocalization)
 
-static NSString *currentLocalization = nil;
+// The current localization can be read from any thread without locking. Localization strings are interned and never
+// released (there are only a few of them), so that a reader which has loaded the pointer can safely use it even if
+// the localization is changed concurrently. Changes are published with a memory barrier
+static NSString * volatile currentLocalization = nil;
+static NSMutableSet *internedLocalizations = nil;
+static pthread_mutex_t internedLocalizationsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Guards the caches below. Lookups only take the read lock, so that background threads can localize strings
+// concurrently. Objects read from the caches are retained and autoreleased before the lock is released
+static pthread_rwlock_t cachesLock = PTHREAD_RWLOCK_INITIALIZER;
+
+// Strings tables, grouped by localization, then keyed by bundle path, localization name and table name. Either memory-
+// mapped precompiled tables (HLSStringsTable objects) or parsed strings files (NSDictionary objects), both answering
+// -objectForKey:. Tables are loaded once and kept until the localization changes (tables of the new localization,
+// which might have been preloaded, are kept) or a memory warning is received. Missing tables are cached as empty
+// dictionaries so that the file system is not probed again. Localized strings can be requested from any thread,
+// access is therefore synchronized (cachesLock)
+static NSMutableDictionary *stringsTablesCache = nil;
+
+// Name of the lproj directory matching a localization (without extension), keyed by bundle path and localization.
+// Directories which could not be found are recorded as NSNull so that the file system is probed only once. Guarded
+// by cachesLock
+static NSMutableDictionary *localizationNamesCache = nil;
 
+// Missing localizations found when NSShowNonLocalizedStrings is enabled, each stored once as a single string made of
+// the bundle name, table and key (separated by tabs, which is also the report format). Guarded by cachesLock
+static NSMutableSet *missingLocalizations = nil;
+
+// Incremented each time a localization is preloaded, so that only the most recent request sets its localization
+// (preloading runs concurrently, earlier requests might end last). Main thread only
+static NSUInteger preloadGeneration = 0;
+
+static void publishLocalization(NSString *localization);
 static void setDefaultLocalization(void);
+static void recordMissingLocalization(NSBundle *bundle, NSString *tableName, NSString *key);
+static NSString *localizationName(NSBundle *bundle, NSString *localization);
+static NSString *resourcesLocalization(NSBundle *bundle);
+static id stringsTable(NSBundle *bundle, NSString *localization, NSString *lprojName, NSString *tableName);
+static void preloadStringsTables(NSBundle *bundle, NSString *localization);
+static void purgeStringsTablesCache(NSString *keptLocalization);
 static void exchangeNSBundleInstanceMethod(SEL originalSelector);
 static void initialize(void);
 
-static void setDefaultLocalization(void)
+static void publishLocalization(NSString *localization)
 {
-    [currentLocalization release];
+    NSString *internedLocalization = nil;
+    if (localization) {
+        pthread_mutex_lock(&internedLocalizationsMutex);
+        if (!internedLocalizations) {
+            internedLocalizations = [[NSMutableSet alloc] init];
+        }
+        internedLocalization = [internedLocalizations member:localization];
+        if (!internedLocalization) {
+            internedLocalization = [[localization copy] autorelease];
+            [internedLocalizations addObject:internedLocalization];
+        }
+        pthread_mutex_unlock(&internedLocalizationsMutex);
+    }
     
+    // Make the string contents visible before the pointer itself
+    OSMemoryBarrier();
+    currentLocalization = internedLocalization;
+}
+
+static void setDefaultLocalization(void)
+{
     NSArray *mainBundleLocalizations = [[NSBundle mainBundle] localizations];
     NSArray *preferredLocalizations = [NSBundle preferredLocalizationsFromArray:mainBundleLocalizations];
     if ([preferredLocalizations count] > 0) {
-        currentLocalization = [[preferredLocalizations objectAtIndex:0] copy];
+        publishLocalization([preferredLocalizations objectAtIndex:0]);
     }
     else {
-        currentLocalization = [[[NSBundle mainBundle] developmentLocalization] copy];
+        publishLocalization([[NSBundle mainBundle] developmentLocalization]);
     }
 }
 
@@ -70,20 +139,38 @@ static void setDefaultLocalization(void)
 {
     NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
     
+    if ([[[NSBundle mainBundle] objectForInfoDictionaryKey:HLSDynamicLocalizationDisabledInfoKey] boolValue]) {
+        HLSLoggerWarn(@"Dynamic localization has been disabled in the Info.plist. The localization set using "
+                      "+[NSBundle setLocalization:] is not restored, and labels in nib files are not localized");
+    }
+    else {
+        [NSBundle restorePreferredLocalization];
+    }
+    
+    [pool drain];
+}
+
++ (void)restorePreferredLocalization
+{
+    // Setting the localization is recorded separately
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
     NSString *preferredLocalization = [[NSUserDefaults standardUserDefaults] stringForKey:HLSPreferredLocalizationDefaultsKey];
+    HLSStartupReportRecord("NSBundle+HLSDynamicLocalization (user defaults)", startTime);
+    
     if (preferredLocalization) {
         [NSBundle setLocalization:preferredLocalization];
     }
-    
-    [pool drain];
 }
 
 + (NSString *)localization
 {
-    if (!currentLocalization) {
+    // Several threads might compute the default localization at the same time. They will publish the same value
+    NSString *localization = currentLocalization;
+    if (!localization) {
         setDefaultLocalization();
+        localization = currentLocalization;
     }
-    return currentLocalization;
+    return localization;
 }
 
 + (void)setLocalization:(NSString *)localization
@@ -91,53 +178,82 @@ static void setDefaultLocalization(void)
     initialize();
     
     NSArray *mainBundleLocalizations = [[NSBundle mainBundle] localizations];
-    NSString *previousLocalization = [currentLocalization copy];
+    NSString *previousLocalization = currentLocalization;
     
     if (localization == nil || ![mainBundleLocalizations containsObject:localization]) {
         setDefaultLocalization();
     }
     else {
         if (currentLocalization == localization) {
-            [previousLocalization release];
             return;
         }
         
-        [currentLocalization release];
-        currentLocalization = [localization copy];
+        publishLocalization(localization);
     }
     
-    if (![currentLocalization isEqualToString:previousLocalization]) {
+    NSString *newLocalization = currentLocalization;
+    if (![newLocalization isEqualToString:previousLocalization]) {
+        purgeStringsTablesCache(newLocalization);
         [[NSNotificationCenter defaultCenter] postNotificationName:HLSCurrentLocalizationDidChangeNotification object:self];
     }
     
-    [[NSUserDefaults standardUserDefaults] setObject:currentLocalization forKey:HLSPreferredLocalizationDefaultsKey];
-    [previousLocalization release];
+    [[NSUserDefaults standardUserDefaults] setObject:newLocalization forKey:HLSPreferredLocalizationDefaultsKey];
 }
 
-// MARK: - Localized strings
++ (NSString *)missingLocalizationsReport
+{
+    pthread_rwlock_rdlock(&cachesLock);
+    NSArray *sortedMissingLocalizations = [[missingLocalizations allObjects] sortedArrayUsingSelector:@selector(compare:)];
+    pthread_rwlock_unlock(&cachesLock);
+    return [sortedMissingLocalizations componentsJoinedByString:@"\n"];
+}
 
-- (NSString *)dynamic_localizedStringForKey:(NSString *)key value:(NSString *)value table:(NSString *)tableName;
++ (void)resetMissingLocalizations
 {
-    NSString *localizationName = currentLocalization;
-    BOOL lprojFound = YES;
-    NSString *lprojPath = [[[self bundlePath] stringByAppendingPathComponent:currentLocalization] stringByAppendingPathExtension:@"lproj"];
-    if (![[NSFileManager defaultManager] fileExistsAtPath:lprojPath]) {
-        // Handle old style English.lproj / French.lproj / German.lproj ...
-        static NSLocale *enLocale = nil;
-        if (!enLocale) {
-            enLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en"];
-        }
-        NSString *displayLocalizationName = [enLocale displayNameForKey:NSLocaleLanguageCode value:currentLocalization];
-        lprojPath = [[[self bundlePath] stringByAppendingPathComponent:displayLocalizationName] stringByAppendingPathExtension:@"lproj"];
-        if ([[NSFileManager defaultManager] fileExistsAtPath:lprojPath]) {
-            localizationName = displayLocalizationName;
-        }
-        else {
-            lprojFound = NO;
-        }
+    pthread_rwlock_wrlock(&cachesLock);
+    [missingLocalizations removeAllObjects];
+    pthread_rwlock_unlock(&cachesLock);
+}
+
++ (void)preloadLocalization:(NSString *)localization
+{
+    if (!localization || ![[[NSBundle mainBundle] localizations] containsObject:localization]) {
+        return;
     }
     
-    if (!currentLocalization || !lprojFound) {
+    NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemLocalization);
+    preloadStringsTables([NSBundle mainBundle], localization);
+    HLSAutoreleasePoolPop(pool);
+}
+
++ (void)preloadAndSetLocalization:(NSString *)localization completionBlock:(void (^)(void))completionBlock
+{
+    localization = [[localization copy] autorelease];
+    NSUInteger generation = ++preloadGeneration;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        // Invalid localizations are replaced with the default one by +setLocalization:, nothing to preload
+        [NSBundle preloadLocalization:localization];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Superseded by a more recent request
+            if (generation == preloadGeneration) {
+                [NSBundle setLocalization:localization];
+            }
+            if (completionBlock) {
+                completionBlock();
+            }
+        });
+    });
+}
+
+// MARK: - Localized strings
+
+- (NSString *)dynamic_localizedStringForKey:(NSString *)key value:(NSString *)value table:(NSString *)tableName;
+{
+    // Read the current localization once, it might be changed by another thread in the meantime
+    NSString *localization = currentLocalization;
+    NSString *lprojName = localizationName(self, localization);
+    if (!lprojName) {
         return [self dynamic_localizedStringForKey:key value:value table:tableName];
     }
     
@@ -149,14 +265,16 @@ static void setDefaultLocalization(void)
         tableName = @"Localizable";
     }
     
-    NSString *tablePath = [self pathForResource:tableName ofType:@"strings" inDirectory:nil forLocalization:localizationName];
-    NSDictionary *table = [NSDictionary dictionaryWithContentsOfFile:tablePath];
+    // Covers the loading of the strings table the first time it is accessed
+    HLSTraceIdentifier traceIdentifier = HLSTraceBegin(@"Localization", [NSString stringWithFormat:@"%@ (%@.strings)", key, tableName]);
+    id table = stringsTable(self, localization, lprojName, tableName);
     
     NSString *localizedString = [table objectForKey:key];
+    HLSTraceEnd(traceIdentifier);
     
     if (!localizedString) {
         if ([[NSUserDefaults standardUserDefaults] boolForKey:@"NSShowNonLocalizedStrings"]) {
-            HLSLoggerWarn(@"Localizable string \"%@\" not found in strings table \"%@\" of bundle %@", key, tableName, self);
+            recordMissingLocalization(self, tableName, key);
             return [key uppercaseString];
         }
         return [value length] > 0 ? value : key;
@@ -165,11 +283,168 @@ static void setDefaultLocalization(void)
     return localizedString;
 }
 
+// Log each missing localization only once
+static void recordMissingLocalization(NSBundle *bundle, NSString *tableName, NSString *key)
+{
+    NSString *entry = [NSString stringWithFormat:@"%@\t%@\t%@", [[bundle bundlePath] lastPathComponent], tableName, key];
+    pthread_rwlock_rdlock(&cachesLock);
+    BOOL recorded = [missingLocalizations containsObject:entry];
+    pthread_rwlock_unlock(&cachesLock);
+    if (recorded) {
+        return;
+    }
+    
+    pthread_rwlock_wrlock(&cachesLock);
+    if (!missingLocalizations) {
+        missingLocalizations = [[NSMutableSet alloc] init];
+    }
+    recorded = [missingLocalizations containsObject:entry];
+    [missingLocalizations addObject:entry];
+    pthread_rwlock_unlock(&cachesLock);
+    if (recorded) {
+        return;
+    }
+    
+    HLSLoggerWarn(@"Localizable string \"%@\" not found in strings table \"%@\" of bundle %@", key, tableName, bundle);
+}
+
+static NSString *localizationName(NSBundle *bundle, NSString *localization)
+{
+    if (!localization) {
+        return nil;
+    }
+    
+    NSString *bundlePath = [bundle bundlePath];
+    NSString *key = [NSString stringWithFormat:@"%@|%@", bundlePath, localization];
+    pthread_rwlock_rdlock(&cachesLock);
+    id cachedName = [[[localizationNamesCache objectForKey:key] retain] autorelease];
+    pthread_rwlock_unlock(&cachesLock);
+    if (cachedName) {
+        return cachedName == [NSNull null] ? nil : cachedName;
+    }
+    
+    NSString *name = localization;
+    NSString *lprojPath = [[bundlePath stringByAppendingPathComponent:localization] stringByAppendingPathExtension:@"lproj"];
+    if (![[NSFileManager defaultManager] fileExistsAtPath:lprojPath]) {
+        // Handle old style English.lproj / French.lproj / German.lproj ...
+        NSLocale *enLocale = [[[NSLocale alloc] initWithLocaleIdentifier:@"en"] autorelease];
+        NSString *displayLocalizationName = [enLocale displayNameForKey:NSLocaleLanguageCode value:localization];
+        lprojPath = [[bundlePath stringByAppendingPathComponent:displayLocalizationName] stringByAppendingPathExtension:@"lproj"];
+        name = [[NSFileManager defaultManager] fileExistsAtPath:lprojPath] ? displayLocalizationName : nil;
+    }
+    
+    pthread_rwlock_wrlock(&cachesLock);
+    if (!localizationNamesCache) {
+        localizationNamesCache = [[NSMutableDictionary alloc] init];
+    }
+    [localizationNamesCache setObject:name ? (id)name : (id)[NSNull null] forKey:key];
+    pthread_rwlock_unlock(&cachesLock);
+    return name;
+}
+
+static id stringsTable(NSBundle *bundle, NSString *localization, NSString *lprojName, NSString *tableName)
+{
+    NSString *key = [NSString stringWithFormat:@"%@|%@|%@", [bundle bundlePath], lprojName, tableName];
+    pthread_rwlock_rdlock(&cachesLock);
+    id table = [[[[stringsTablesCache objectForKey:localization] objectForKey:key] retain] autorelease];
+    pthread_rwlock_unlock(&cachesLock);
+    if (table) {
+        return table;
+    }
+    
+    // Load outside the lock. If two threads load the same table concurrently, the last one wins, which is harmless.
+    // Precompiled tables are preferred, since they are mapped instead of being parsed into the heap
+    NSString *binaryTablePath = [bundle pathForResource:tableName ofType:HLSStringsTableFileExtension inDirectory:nil forLocalization:lprojName];
+    if (binaryTablePath) {
+        table = [[[HLSStringsTable alloc] initWithContentsOfFile:binaryTablePath] autorelease];
+    }
+    if (! table) {
+        NSString *tablePath = [bundle pathForResource:tableName ofType:@"strings" inDirectory:nil forLocalization:lprojName];
+        table = tablePath ? [NSDictionary dictionaryWithContentsOfFile:tablePath] : nil;
+    }
+    if (! table) {
+        table = [NSDictionary dictionary];
+    }
+    
+    pthread_rwlock_wrlock(&cachesLock);
+    // Created lazily, and purged on memory warnings for the whole application lifetime
+    BOOL observingMemoryWarnings = (stringsTablesCache != nil);
+    if (! stringsTablesCache) {
+        stringsTablesCache = [[NSMutableDictionary alloc] init];
+    }
+    NSMutableDictionary *localizationStringsTablesCache = [stringsTablesCache objectForKey:localization];
+    if (! localizationStringsTablesCache) {
+        localizationStringsTablesCache = [NSMutableDictionary dictionary];
+        [stringsTablesCache setObject:localizationStringsTablesCache forKey:localization];
+    }
+    [localizationStringsTablesCache setObject:table forKey:key];
+    pthread_rwlock_unlock(&cachesLock);
+    
+    // Registered outside the lock, since the notification center might call the purge method synchronously
+    if (! observingMemoryWarnings) {
+        [[NSNotificationCenter defaultCenter] addObserver:[NSBundle class]
+                                                 selector:@selector(stringsTablesCacheDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return table;
+}
+
+// Load all strings tables of a bundle for a given localization
+static void preloadStringsTables(NSBundle *bundle, NSString *localization)
+{
+    NSString *lprojName = localizationName(bundle, localization);
+    if (! lprojName) {
+        return;
+    }
+    
+    NSMutableSet *tableNames = [NSMutableSet set];
+    for (NSString *extension in [NSArray arrayWithObjects:@"strings", HLSStringsTableFileExtension, nil]) {
+        for (NSString *path in [bundle pathsForResourcesOfType:extension inDirectory:nil forLocalization:lprojName]) {
+            [tableNames addObject:[[path lastPathComponent] stringByDeletingPathExtension]];
+        }
+    }
+    
+    // Parsing a table creates many temporary objects, drain them after each table
+    for (NSString *tableName in tableNames) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemLocalization);
+        stringsTable(bundle, localization, lprojName, tableName);
+        HLSAutoreleasePoolPop(pool);
+    }
+}
+
+// Discard all tables, except those of the specified localization (if not nil)
+static void purgeStringsTablesCache(NSString *keptLocalization)
+{
+    pthread_rwlock_wrlock(&cachesLock);
+    id keptStringsTables = keptLocalization ? [[[stringsTablesCache objectForKey:keptLocalization] retain] autorelease] : nil;
+    [stringsTablesCache removeAllObjects];
+    if (keptStringsTables) {
+        [stringsTablesCache setObject:keptStringsTables forKey:keptLocalization];
+    }
+    pthread_rwlock_unlock(&cachesLock);
+}
+
++ (void)stringsTablesCacheDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    HLSLoggerDebug(@"Memory warning received, cached strings tables discarded");
+    purgeStringsTablesCache(nil);
+}
+
 // MARK: - URLs
 
+// Localization to use when looking up resources: The name of the lproj directory if one was found (which might be an old
+// style English.lproj / French.lproj / ... name), otherwise the current localization itself, letting NSBundle decide
+static NSString *resourcesLocalization(NSBundle *bundle)
+{
+    NSString *localization = currentLocalization;
+    NSString *lprojName = localizationName(bundle, localization);
+    return lprojName ? lprojName : localization;
+}
+
 - (NSURL *)dynamic_URLForResource:(NSString *)name withExtension:(NSString *)extension subdirectory:(NSString *)subpath
 {
-    return [self URLForResource:name withExtension:extension subdirectory:subpath localization:currentLocalization];
+    return [self URLForResource:name withExtension:extension subdirectory:subpath localization:resourcesLocalization(self)];
 }
 
 - (NSURL *)dynamic_URLForResource:(NSString *)name withExtension:(NSString *)extension
@@ -180,14 +455,14 @@ static void setDefaultLocalization(void)
 
 - (NSArray *)dynamic_URLsForResourcesWithExtension:(NSString *)extension subdirectory:(NSString *)subpath
 {
-    return [self URLsForResourcesWithExtension:extension subdirectory:subpath localization:currentLocalization];
+    return [self URLsForResourcesWithExtension:extension subdirectory:subpath localization:resourcesLocalization(self)];
 }
 
 // MARK: - Paths
 
 - (NSString *)dynamic_pathForResource:(NSString *)name ofType:(NSString *)extension inDirectory:(NSString *)subpath
 {
-    return [self pathForResource:name ofType:extension inDirectory:subpath forLocalization:currentLocalization];
+    return [self pathForResource:name ofType:extension inDirectory:subpath forLocalization:resourcesLocalization(self)];
 }
 
 - (NSString *)dynamic_pathForResource:(NSString *)name ofType:(NSString *)extension
@@ -198,7 +473,7 @@ static void setDefaultLocalization(void)
 
 - (NSArray *)dynamic_pathsForResourcesOfType:(NSString *)extension inDirectory:(NSString *)subpath
 {
-    return [self pathsForResourcesOfType:extension inDirectory:subpath forLocalization:currentLocalization];
+    return [self pathsForResourcesOfType:extension inDirectory:subpath forLocalization:resourcesLocalization(self)];
 }
 
 // MARK: - Swizzling
@@ -228,6 +503,8 @@ static void initialize(void)
     }
     initialized = YES;
     
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     exchangeNSBundleInstanceMethod(@selector(localizedStringForKey:value:table:));
     
     exchangeNSBundleInstanceMethod(@selector(URLForResource:withExtension:));
@@ -237,6 +514,8 @@ static void initialize(void)
     exchangeNSBundleInstanceMethod(@selector(pathForResource:ofType:));
     exchangeNSBundleInstanceMethod(@selector(pathForResource:ofType:inDirectory:));
     exchangeNSBundleInstanceMethod(@selector(pathsForResourcesOfType:inDirectory:));
+    
+    HLSStartupReportRecord("NSBundle+HLSDynamicLocalization (swizzling)", startTime);
 }
 
 @end
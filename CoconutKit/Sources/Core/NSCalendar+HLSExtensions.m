@@ -8,16 +8,28 @@
 
 #import "NSCalendar+HLSExtensions.h"
 
+#import "HLSTimeZoneOffsetTable.h"
 #import "NSDate+HLSExtensions.h"
 #import "NSTimeZone+HLSExtensions.h"
 
+static const NSTimeInterval kSecondsPerDay = 24. * 60. * 60.;
+
+static BOOL HLSGregorianDayIndexForDate(NSDate *date, NSTimeZone *timeZone, NSInteger *pDayIndex);
+
 /**
  * The strategy is always the same here: Since all methods available from NSCalendar use the calendar time zone, we
- * always have to convert dates from the time zone in which we want to work to the calendar time zone. In this time 
- * zone we can then apply all methods readily available from NSCalendar. If the result is not a date, we are done. If 
- * the result is a date, though, we need to convert it back to the time zone in which we work
+ * perform calculations using a copy of the calendar set to the time zone in which we want to work. Configuring a
+ * calendar is costly, and these methods are often called in loops (e.g. when laying out calendar views), so these 
+ * copies are cached per thread (calendars are not thread-safe), and for each calendar configuration and time zone
  */
 
+@interface NSCalendar (HLSExtensionsPrivate)
+
+- (NSCalendar *)calendarWithTimeZone:(NSTimeZone *)timeZone;
+- (BOOL)isGregorian;
+
+@end
+
 @interface NSDateComponents (HLSExtensionsPrivate)
 
 + (NSString *)stringForComponentValue:(NSInteger)componentValue;
@@ -202,8 +214,7 @@
     NSAssert(! [components respondsToSelector:@selector(timeZone)] || ! [components timeZone], 
              @"The time zone must not be specified in the date components");
     
-    NSDate *dateInCalendarTimeZone = [self dateFromComponents:components];
-    return [timeZone dateWithSameComponentsAsDate:dateInCalendarTimeZone fromTimeZone:[self timeZone]];
+    return [[self calendarWithTimeZone:timeZone] dateFromComponents:components];
 }
 
 - (NSDateComponents *)components:(NSUInteger)unitFlags fromDate:(NSDate *)date inTimeZone:(NSTimeZone *)timeZone
@@ -212,8 +223,7 @@
         return [self components:unitFlags fromDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    NSDateComponents *dateComponents = [self components:unitFlags fromDate:dateInCalendarTimeZone];
+    NSDateComponents *dateComponents = [[self calendarWithTimeZone:timeZone] components:unitFlags fromDate:date];
     
     // iOS 4 and above only
     // TODO: When iOS 4 and above required: Can remove respondsToSelector test
@@ -241,8 +251,7 @@
         return [self numberOfDaysInUnit:unit containingDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    return [self numberOfDaysInUnit:unit containingDate:dateInCalendarTimeZone];
+    return [[self calendarWithTimeZone:timeZone] numberOfDaysInUnit:unit containingDate:date];
 }
 
 - (NSDate *)startDateOfUnit:(NSCalendarUnit)unit containingDate:(NSDate *)date
@@ -261,9 +270,7 @@
         return [self startDateOfUnit:unit containingDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    NSDate *startDateInCalendarTimeZone = [self startDateOfUnit:unit containingDate:dateInCalendarTimeZone];
-    return [timeZone dateWithSameComponentsAsDate:startDateInCalendarTimeZone fromTimeZone:[self timeZone]];
+    return [[self calendarWithTimeZone:timeZone] startDateOfUnit:unit containingDate:date];
 }
 
 - (NSDate *)endDateOfUnit:(NSCalendarUnit)unit containingDate:(NSDate *)date
@@ -288,8 +295,7 @@
         return [self rangeOfUnit:smaller inUnit:larger forDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    return [self rangeOfUnit:smaller inUnit:larger forDate:dateInCalendarTimeZone];
+    return [[self calendarWithTimeZone:timeZone] rangeOfUnit:smaller inUnit:larger forDate:date];
 }
 
 - (NSUInteger)ordinalityOfUnit:(NSCalendarUnit)smaller inUnit:(NSCalendarUnit)larger forDate:(NSDate *)date inTimeZone:(NSTimeZone *)timeZone
@@ -298,8 +304,7 @@
         return [self ordinalityOfUnit:smaller inUnit:larger forDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    return [self ordinalityOfUnit:smaller inUnit:larger forDate:dateInCalendarTimeZone];
+    return [[self calendarWithTimeZone:timeZone] ordinalityOfUnit:smaller inUnit:larger forDate:date];
 }
 
 - (BOOL)rangeOfUnit:(NSCalendarUnit)unit startDate:(NSDate **)pStartDate interval:(NSTimeInterval *)pInterval forDate:(NSDate *)date inTimeZone:(NSTimeZone *)timeZone
@@ -308,12 +313,7 @@
         return [self rangeOfUnit:unit startDate:pStartDate interval:pInterval forDate:date];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    BOOL result = [self rangeOfUnit:unit startDate:pStartDate interval:pInterval forDate:dateInCalendarTimeZone];
-    if (pStartDate) {
-        *pStartDate = [timeZone dateWithSameComponentsAsDate:*pStartDate fromTimeZone:[self timeZone]];
-    }
-    return result;
+    return [[self calendarWithTimeZone:timeZone] rangeOfUnit:unit startDate:pStartDate interval:pInterval forDate:date];
 }
 
 - (NSDate *)dateByAddingComponents:(NSDateComponents *)components toDate:(NSDate *)date options:(NSUInteger)options inTimeZone:(NSTimeZone *)timeZone
@@ -322,9 +322,7 @@
         return [self dateByAddingComponents:components toDate:date options:options];
     }
     
-    NSDate *dateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:date fromTimeZone:timeZone];
-    NSDate *resultDateInCalendarTimeZone = [self dateByAddingComponents:components toDate:dateInCalendarTimeZone options:options];
-    return [timeZone dateWithSameComponentsAsDate:resultDateInCalendarTimeZone fromTimeZone:[self timeZone]];
+    return [[self calendarWithTimeZone:timeZone] dateByAddingComponents:components toDate:date options:options];
 }
 
 - (NSDateComponents *)components:(NSUInteger)unitFlags fromDate:(NSDate *)startDate toDate:(NSDate *)endDate options:(NSUInteger)options inTimeZone:(NSTimeZone *)timeZone
@@ -333,9 +331,7 @@
         return [self components:unitFlags fromDate:startDate toDate:endDate options:options];
     }
     
-    NSDate *startDateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:startDate fromTimeZone:timeZone];
-    NSDate *endDateInCalendarTimeZone = [[self timeZone] dateWithSameComponentsAsDate:endDate fromTimeZone:timeZone];
-    return [self components:unitFlags fromDate:startDateInCalendarTimeZone toDate:endDateInCalendarTimeZone options:options];
+    return [[self calendarWithTimeZone:timeZone] components:unitFlags fromDate:startDate toDate:endDate options:options];
 }
 
 - (NSDate *)dateAtNoonTheSameDayAsDate:(NSDate *)date
@@ -369,6 +365,20 @@
         return [self dateAtHour:hour minute:minute second:second theSameDayAsDate:date];
     }
     
+    // Fast path: Integer arithmetic on the local day. Check the result does not lie across a DST transition
+    if ([self isGregorian] && hour >= 0 && hour < 24 && minute >= 0 && minute < 60 && second >= 0 && second < 60) {
+        HLSTimeZonePeriod period;
+        if (HLSTimeZoneGetPeriod(timeZone, [date timeIntervalSinceReferenceDate], &period)) {
+            NSTimeInterval offset = period.secondsFromGMT;
+            CFAbsoluteTime localTime = floor(([date timeIntervalSinceReferenceDate] + offset) / kSecondsPerDay) * kSecondsPerDay
+                + hour * 60. * 60. + minute * 60. + second;
+            HLSTimeZonePeriod resultPeriod;
+            if (HLSTimeZoneGetPeriod(timeZone, localTime - offset, &resultPeriod) && resultPeriod.secondsFromGMT == period.secondsFromGMT) {
+                return [NSDate dateWithTimeIntervalSinceReferenceDate:localTime - offset];
+            }
+        }
+    }
+    
     NSUInteger unitFlags = NSYearCalendarUnit | NSMonthCalendarUnit | NSDayCalendarUnit;
     NSDateComponents *dateComponents = [self components:unitFlags fromDate:date inTimeZone:timeZone];
     [dateComponents setHour:hour];
@@ -388,6 +398,23 @@
         return [self compareDaysBetweenDate:date1 andDate:date2];
     }
     
+    // Fast path: Compare local day indices
+    if ([self isGregorian]) {
+        NSInteger dayIndex1 = 0;
+        NSInteger dayIndex2 = 0;
+        if (HLSGregorianDayIndexForDate(date1, timeZone, &dayIndex1) && HLSGregorianDayIndexForDate(date2, timeZone, &dayIndex2)) {
+            if (dayIndex1 < dayIndex2) {
+                return NSOrderedAscending;
+            }
+            else if (dayIndex1 > dayIndex2) {
+                return NSOrderedDescending;
+            }
+            else {
+                return NSOrderedSame;
+            }
+        }
+    }
+    
     NSUInteger unitFlags = NSYearCalendarUnit | NSMonthCalendarUnit | NSDayCalendarUnit;
     NSDateComponents *dateComponents1 = [self components:unitFlags fromDate:date1 inTimeZone:timeZone];
     NSDateComponents *dateComponents2 = [self components:unitFlags fromDate:date2 inTimeZone:timeZone];
@@ -422,6 +449,64 @@
 
 @end
 
+@implementation NSCalendar (HLSExtensionsPrivate)
+
+#pragma mark Calendar cache
+
+- (NSCalendar *)calendarWithTimeZone:(NSTimeZone *)timeZone
+{
+    if ([timeZone isEqualToTimeZone:[self timeZone]]) {
+        return self;
+    }
+    
+    static NSString * const HLSCalendarCacheThreadLocalStorageKey = @"HLSCalendarCacheThreadLocalStorageKey";
+    
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary *keyToCalendarMap = [threadDictionary objectForKey:HLSCalendarCacheThreadLocalStorageKey];
+    if (! keyToCalendarMap) {
+        keyToCalendarMap = [NSMutableDictionary dictionary];
+        [threadDictionary setObject:keyToCalendarMap forKey:HLSCalendarCacheThreadLocalStorageKey];
+    }
+    
+    // All settings which affect calendrical calculations
+    NSString *key = [NSString stringWithFormat:@"%@|%@|%@|%u|%u", 
+                     [self calendarIdentifier], 
+                     [timeZone name], 
+                     [[self locale] localeIdentifier],
+                     [self firstWeekday],
+                     [self minimumDaysInFirstWeek]];
+    NSCalendar *calendar = [keyToCalendarMap objectForKey:key];
+    if (! calendar) {
+        calendar = [[[NSCalendar alloc] initWithCalendarIdentifier:[self calendarIdentifier]] autorelease];
+        [calendar setLocale:[self locale]];
+        [calendar setFirstWeekday:[self firstWeekday]];
+        [calendar setMinimumDaysInFirstWeek:[self minimumDaysInFirstWeek]];
+        [calendar setTimeZone:timeZone];
+        [keyToCalendarMap setObject:calendar forKey:key];
+    }
+    return calendar;
+}
+
+- (BOOL)isGregorian
+{
+    return [[self calendarIdentifier] isEqualToString:NSGregorianCalendar];
+}
+
+@end
+
+// Index of the day of a date in a time zone (days since the reference date). Return NO if time zone offsets cannot
+// be computed
+static BOOL HLSGregorianDayIndexForDate(NSDate *date, NSTimeZone *timeZone, NSInteger *pDayIndex)
+{
+    HLSTimeZonePeriod period;
+    if (! HLSTimeZoneGetPeriod(timeZone, [date timeIntervalSinceReferenceDate], &period)) {
+        return NO;
+    }
+    
+    *pDayIndex = (NSInteger)floor(([date timeIntervalSinceReferenceDate] + period.secondsFromGMT) / kSecondsPerDay);
+    return YES;
+}
+
 @implementation NSDateComponents (HLSExtensionsPrivate)
 
 #pragma mark Class methods
@@ -6,6 +6,8 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+#import "HLSDigest.h"
+
 @interface NSData (HLSExtensions)
 
 /**
@@ -48,4 +50,10 @@
  */
 - (NSString *)sha512hash;
 
+/**
+ * Calculates the raw digest using the specified algorithm. Cheaper than the hexadecimal versions above if you do not
+ * need a string representation
+ */
+- (NSData *)digestWithAlgorithm:(HLSDigestAlgorithm)algorithm;
+
 @end
@@ -10,19 +10,12 @@
 
 #import <CommonCrypto/CommonDigest.h>
 
-static NSString* digest(NSData *data, unsigned char *(*cc_digest)(const void *, CC_LONG, unsigned char *), CC_LONG digestLength)
+// The digest is calculated into a stack buffer large enough for all supported algorithms
+static NSString *digest(NSData *data, HLSDigestAlgorithm algorithm)
 {
-	unsigned char md[digestLength];     // C99
-    memset(md, 0, sizeof(md));
-	cc_digest([data bytes], [data length], md);
-    
-    // Hexadecimal representation
-    NSMutableString *hexHash = [NSMutableString string];
-    for (NSUInteger i = 0; i < sizeof(md); ++i) {
-        [hexHash appendFormat:@"%02X", md[i]];
-    }
-    
-    return [hexHash lowercaseString];
+    unsigned char md[CC_SHA512_DIGEST_LENGTH];
+    HLSDigestCalculate(algorithm, [data bytes], [data length], md);
+    return HLSHexadecimalStringFromBytes(md, HLSDigestLength(algorithm));
 }
 
 @implementation NSData (HLSExtensions)
@@ -31,42 +24,49 @@ static NSString* digest(NSData *data, unsigned char *(*cc_digest)(const void *,
 
 - (NSString *)md2hash
 {
-    return digest(self, CC_MD2, CC_MD2_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD2);
 }
 
 - (NSString *)md4hash
 {
-    return digest(self, CC_MD4, CC_MD4_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD4);
 }
 
 - (NSString *)md5hash
 {
-    return digest(self, CC_MD5, CC_MD5_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD5);
 }
 
 - (NSString *)sha1hash
 {
-    return digest(self, CC_SHA1, CC_SHA1_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA1);
 }
 
 - (NSString *)sha224hash
 {
-    return digest(self, CC_SHA224, CC_SHA224_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA224);
 }
 
 - (NSString *)sha256hash
 {
-    return digest(self, CC_SHA256, CC_SHA256_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA256);
 }
 
 - (NSString *)sha384hash
 {
-    return digest(self, CC_SHA384, CC_SHA384_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA384);
 }
 
 - (NSString *)sha512hash
 {
-    return digest(self, CC_SHA512, CC_SHA512_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA512);
+}
+
+- (NSData *)digestWithAlgorithm:(HLSDigestAlgorithm)algorithm
+{
+    unsigned char md[CC_SHA512_DIGEST_LENGTH];
+    HLSDigestCalculate(algorithm, [self bytes], [self length], md);
+    return [NSData dataWithBytes:md length:HLSDigestLength(algorithm)];
 }
 
 @end
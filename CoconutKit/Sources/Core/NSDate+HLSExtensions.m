@@ -9,36 +9,31 @@
 #import "NSDate+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 #import "NSCalendar+HLSExtensions.h"
 
-static NSDateFormatter *s_dateFormatter = nil;
-
 // Original implementation of the methods we swizzle
 static id (*s_NSDate__descriptionWithLocale_Imp)(id, SEL, id) = NULL;
 
 // Swizzled method implementations
 static NSString *swizzled_NSDate__descriptionWithLocale_Imp(NSDate *self, SEL _cmd, id locale);
 
+// Static functions
+static NSString *HLSDateDescription(NSDate *date, BOOL systemTimeZone);
+
 @implementation NSDate (HLSExtensions)
 
 #pragma mark Class methods
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_NSDate__descriptionWithLocale_Imp = (id (*)(id, SEL, id))HLSSwizzleSelector(self, 
                                                                                   @selector(descriptionWithLocale:),
                                                                                   (IMP)swizzled_NSDate__descriptionWithLocale_Imp);
-}
-
-+ (void)initialize
-{
-    if (self != [NSDate class]) {
-        return;
-    }
     
-    // Create time formatter for system timezone (which is the default one if not set)
-    s_dateFormatter = [[NSDateFormatter alloc] init];
-    [s_dateFormatter setDateFormat:@"yyyy'-'MM'-'dd' 'HH':'mm':'ss' 'ZZZ"];
+    HLSStartupReportRecord("NSDate+HLSExtensions", startTime);
 }
 
 #pragma mark Convenience methods
@@ -69,6 +64,63 @@ static NSString *swizzled_NSDate__descriptionWithLocale_Imp(NSDate *self, SEL _c
 
 static NSString *swizzled_NSDate__descriptionWithLocale_Imp(NSDate *self, SEL _cmd, id locale)
 {
-    NSString *originalString = (*s_NSDate__descriptionWithLocale_Imp)(self, _cmd, locale);
-    return [NSString stringWithFormat:@"%@ (system time zone: %@)", originalString, [s_dateFormatter stringFromDate:self]];
+    // Dates often appear in logs and collection descriptions (which use a nil locale). In this case, render the
+    // description directly instead of calling the original implementation, which uses a date formatter
+    NSString *originalString = nil;
+    if (locale) {
+        originalString = (*s_NSDate__descriptionWithLocale_Imp)(self, _cmd, locale);
+    }
+    else {
+        originalString = HLSDateDescription(self, NO);
+    }
+    
+    return [NSString stringWithFormat:@"%@ (system time zone: %@)", originalString, HLSDateDescription(self, YES)];
+}
+
+#pragma mark Static functions
+
+// Return a yyyy-MM-dd HH:mm:ss ZZZ rendering of a date for GMT or for the default time zone (same as the default
+// NSDate description). Does not involve any formatter, and can therefore be called from any thread. Calendar fields are
+// computed with 64-bit integers, since a 32-bit time_t cannot represent dates outside 1901-2038
+static NSString *HLSDateDescription(NSDate *date, BOOL systemTimeZone)
+{
+    int64_t offsetInSeconds = systemTimeZone ? [[NSTimeZone defaultTimeZone] secondsFromGMTForDate:date] : 0;
+    int64_t seconds = (int64_t)floor([date timeIntervalSince1970]) + offsetInSeconds;
+    
+    // Floored division, so that dates before 1970 are broken down correctly
+    int64_t days = seconds / 86400;
+    int64_t secondsInDay = seconds % 86400;
+    if (secondsInDay < 0) {
+        secondsInDay += 86400;
+        --days;
+    }
+    
+    // Proleptic Gregorian calendar, with years starting on March 1st so that leap days come last (eras of 400 years)
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    int64_t day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    int64_t month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    
+    int64_t offsetInMinutes = offsetInSeconds / 60;
+    char offsetSign = (offsetInMinutes < 0) ? '-' : '+';
+    offsetInMinutes = llabs(offsetInMinutes);
+    
+    // Buffer on the stack: Large enough for any 64-bit year
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lld %02lld:%02lld:%02lld %c%02lld%02lld",
+             year,
+             month,
+             day,
+             secondsInDay / 3600,
+             (secondsInDay / 60) % 60,
+             secondsInDay % 60,
+             offsetSign,
+             offsetInMinutes / 60,
+             offsetInMinutes % 60);
+    return [NSString stringWithUTF8String:buffer];
 }
@@ -8,6 +8,16 @@
 
 @interface NSDateFormatter (HLSExtensions)
 
+/**
+ * Return a date formatter for the specified format, locale and time zone. If locale or timeZone is nil, the current
+ * locale, respectively the default time zone is used. If format is nil, the formatter has no date format.
+ *
+ * Creating and configuring date formatters is expensive. Formatters returned by this method are cached and reused,
+ * with one formatter per thread (formatters are not thread-safe). You must therefore not keep them for use on another
+ * thread, and you must not alter their settings
+ */
++ (NSDateFormatter *)dateFormatterWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone;
+
 /**
  * Same as -weekDaySymbols and -shortWeekdaySymbols, but returning the days in the order corresponding to the
  * device international settings. 
@@ -12,11 +12,44 @@
 
 @implementation NSDateFormatter (HLSExtensions)
 
++ (NSDateFormatter *)dateFormatterWithFormat:(NSString *)format locale:(NSLocale *)locale timeZone:(NSTimeZone *)timeZone
+{
+    static NSString * const HLSDateFormatterPoolThreadLocalStorageKey = @"HLSDateFormatterPoolThreadLocalStorageKey";
+    
+    if (! locale) {
+        locale = [NSLocale currentLocale];
+    }
+    if (! timeZone) {
+        timeZone = [NSTimeZone defaultTimeZone];
+    }
+    
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary *keyToDateFormatterMap = [threadDictionary objectForKey:HLSDateFormatterPoolThreadLocalStorageKey];
+    if (! keyToDateFormatterMap) {
+        keyToDateFormatterMap = [NSMutableDictionary dictionary];
+        [threadDictionary setObject:keyToDateFormatterMap forKey:HLSDateFormatterPoolThreadLocalStorageKey];
+    }
+    
+    NSString *key = [NSString stringWithFormat:@"%@|%@|%@", format ? format : @"", [locale localeIdentifier], [timeZone name]];
+    NSDateFormatter *dateFormatter = [keyToDateFormatterMap objectForKey:key];
+    if (! dateFormatter) {
+        dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
+        [dateFormatter setFormatterBehavior:NSDateFormatterBehavior10_4];
+        [dateFormatter setLocale:locale];
+        [dateFormatter setTimeZone:timeZone];
+        if (format) {
+            [dateFormatter setDateFormat:format];
+        }
+        [keyToDateFormatterMap setObject:dateFormatter forKey:key];
+    }
+    return dateFormatter;
+}
+
 + (NSArray *)orderedWeekdaySymbols
 {
     static NSArray *s_orderedWeekdays = nil;
     if (! s_orderedWeekdays) {
-        NSDateFormatter *dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
+        NSDateFormatter *dateFormatter = [NSDateFormatter dateFormatterWithFormat:nil locale:nil timeZone:nil];
         NSArray *weekDays = [dateFormatter weekdaySymbols];
         // firstWeekday returns indices starting at 1
         NSUInteger offset = [[NSCalendar currentCalendar] firstWeekday] - 1;
@@ -29,7 +62,7 @@
 {
     static NSArray *s_orderedShortWeekdays = nil;
     if (! s_orderedShortWeekdays) {
-        NSDateFormatter *dateFormatter = [[[NSDateFormatter alloc] init] autorelease];
+        NSDateFormatter *dateFormatter = [NSDateFormatter dateFormatterWithFormat:nil locale:nil timeZone:nil];
         NSArray *shortWeekDays = [dateFormatter shortWeekdaySymbols];
         // firstWeekday returns indices starting at 1
         NSUInteger offset = [[NSCalendar currentCalendar] firstWeekday] - 1;
@@ -6,6 +6,11 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+/**
+ * The methods returning a modified dictionary copy the receiver and therefore cost O(n). If you need to apply many
+ * successive modifications (e.g. to keep immutable state snapshots), use an HLSPersistentDictionary, for which they
+ * cost O(log n)
+ */
 @interface NSDictionary (HLSExtensions)
 
 /**
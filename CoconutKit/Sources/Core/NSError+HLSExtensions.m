@@ -22,7 +22,7 @@
 - (NSArray *)errors
 {
     // At most one error can be stored in an NSError using the standard NSUnderlyingErrorKey key
-    NSError *error = [[self userInfo] objectForKey:NSUnderlyingErrorKey];
+    NSError *error = [self underlyingError];
     if (error) {
         return [NSArray arrayWithObject:error];
     }
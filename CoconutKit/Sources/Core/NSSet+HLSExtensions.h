@@ -9,7 +9,7 @@
 @interface NSSet (HLSExtensions)
 
 /**
- * Sort an array using a single descriptor
+ * Sort an array using a single descriptor. Large sets are sorted in parallel, see NSArray+HLSExtensions
  */
 - (NSArray *)sortedArrayUsingDescriptor:(NSSortDescriptor *)sortDescriptor;
 
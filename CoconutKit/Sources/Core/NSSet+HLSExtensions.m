@@ -8,12 +8,14 @@
 
 #import "NSSet+HLSExtensions.h"
 
+#import "NSArray+HLSExtensions.h"
+
 @implementation NSSet (HLSExtensions)
 
 - (NSArray *)sortedArrayUsingDescriptor:(NSSortDescriptor *)sortDescriptor
 {
-    NSArray *sortDescriptors = sortDescriptor ? [NSArray arrayWithObject:sortDescriptor] : nil;
-    return [self sortedArrayUsingDescriptors:sortDescriptors];
+    // Sorting an array is optimized for large collections
+    return [[self allObjects] sortedArrayUsingDescriptor:sortDescriptor];
 }
 
 @end
@@ -6,6 +6,8 @@
 //  Copyright 2010 Hortis. All rights reserved.
 //
 
+#import "HLSDigest.h"
+
 // Formatting functions
 NSString *HLSStringFromCATransform3D(CATransform3D transform);
 
@@ -24,6 +26,8 @@ NSString *HLSStringFromCATransform3D(CATransform3D transform);
 /**
  * Given a font, return the largest font size (smaller than font.pointSize and larger than a given minimum size) so that
  * the receiver fits within a given area on a maximum number of lines.
+ *
+ * Results are cached (the cache is bounded and purged when memory is low)
  */
 - (CGFloat)fontSizeWithFont:(UIFont *)font 
           constrainedToSize:(CGSize)size 
@@ -36,6 +40,13 @@ NSString *HLSStringFromCATransform3D(CATransform3D transform);
  */
 - (NSString *)urlEncodedStringUsingEncoding:(NSStringEncoding)encoding;
 
+/**
+ * Build a URL encoded query string ("key1=value1&key2=value2...", sorted by key) from a parameter dictionary. Keys
+ * and values are converted to strings using -description. Return nil if a parameter cannot be represented using the
+ * specified encoding
+ */
++ (NSString *)urlEncodedQueryStringWithParameters:(NSDictionary *)parameters encoding:(NSStringEncoding)encoding;
+
 /**
  * Calculate the MD2 hash of a string (hexadecimal)
  */
@@ -76,6 +87,12 @@ NSString *HLSStringFromCATransform3D(CATransform3D transform);
  */
 - (NSString *)sha512hash;
 
+/**
+ * Calculate the raw digest of a string (UTF-8) using the specified algorithm. Cheaper than the hexadecimal versions
+ * above if you do not need a string representation
+ */
+- (NSData *)digestWithAlgorithm:(HLSDigestAlgorithm)algorithm;
+
 /**
  * At Hortis, we use a convenient way to identify versions during development, for tags and for official releases:
  *   - For all versions except AppStore releases:         [lastVersionNumber+]versionNumber[+qualifier]
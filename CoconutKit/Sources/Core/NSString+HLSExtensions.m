@@ -12,21 +12,151 @@
 #import "HLSFloat.h"
 #import "HLSLogger.h"
 
-static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void *, CC_LONG, unsigned char *), CC_LONG digestLength)
+// Maximum number of font sizes kept in cache
+static const NSUInteger kFontSizeCacheCountLimit = 256;
+
+static NSCache *HLSFontSizeCache(void)
 {
-    // Hash calculation
-	unsigned char md[digestLength];     // C99
-    memset(md, 0, sizeof(md));
-    const char *utf8str = [string UTF8String];
-	cc_digest(utf8str, strlen(utf8str), md);
+    static NSCache *s_cache = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_cache = [[NSCache alloc] init];
+        s_cache.name = @"ch.hortis.CoconutKit.fontSizeCache";
+        s_cache.countLimit = kFontSizeCacheCountLimit;
+    });
+    return s_cache;
+}
+
+// Return YES iff the string fits within the given area and number of lines
+static BOOL HLSStringFitsWithFont(NSString *string, UIFont *font, CGSize size, NSUInteger numberOfLines)
+{
+    CGFloat height = [string sizeWithFont:font
+                        constrainedToSize:CGSizeMake(size.width, FLT_MAX)
+                            lineBreakMode:UILineBreakModeWordWrap].height;
+    CGFloat lineHeight = [string sizeWithFont:font
+                            constrainedToSize:CGSizeMake(FLT_MAX, FLT_MAX)
+                                lineBreakMode:UILineBreakModeWordWrap].height;
+    return ! floatgt(height, size.height) && ! floatgt(ceilf(height / lineHeight), numberOfLines);
+}
+
+// The candidate font sizes are font.pointSize - k for k = 0, 1, ..., as long as they are larger than minFontSize. Since 
+// smaller fonts fit better, the largest fitting candidate can be found using a binary search on k
+static CGFloat HLSFontSizeFittingString(NSString *string, UIFont *font, CGSize size, CGFloat minFontSize, NSUInteger numberOfLines)
+{
+    // Empty text
+    CGFloat height = [string sizeWithFont:font
+                        constrainedToSize:CGSizeMake(size.width, FLT_MAX)
+                            lineBreakMode:UILineBreakModeWordWrap].height;
+    if (floateq(height, 0.f)) {
+        return font.pointSize;
+    }
     
-    // Hexadecimal representation
-    NSMutableString *hexHash = [NSMutableString string];
-    for (NSUInteger i = 0; i < sizeof(md); ++i) {
-        [hexHash appendFormat:@"%02X", md[i]];
+    if (HLSStringFitsWithFont(string, font, size, numberOfLines)) {
+        return font.pointSize;
     }
     
-    return [hexHash lowercaseString];
+    // Find the smallest k in ]kLow, kHigh] for which the text fits, kLow being known not to fit
+    NSUInteger kLow = 0;
+    NSUInteger kHigh = (NSUInteger)ceilf(font.pointSize - minFontSize) - 1;
+    if (kHigh == 0 || ! HLSStringFitsWithFont(string, [UIFont fontWithName:font.fontName size:font.pointSize - kHigh], size, numberOfLines)) {
+        return minFontSize;
+    }
+    
+    while (kHigh - kLow > 1) {
+        NSUInteger k = (kLow + kHigh) / 2;
+        if (HLSStringFitsWithFont(string, [UIFont fontWithName:font.fontName size:font.pointSize - k], size, numberOfLines)) {
+            kHigh = k;
+        }
+        else {
+            kLow = k;
+        }
+    }
+    return font.pointSize - kHigh;
+}
+
+// Return the bytes of a string in the specified encoding, or NULL if the string cannot be converted losslessly. The
+// buffer lives as long as the current autorelease pool
+static const uint8_t *HLSURLEncodingBytes(NSString *string, NSStringEncoding encoding, size_t *pLength)
+{
+    if (encoding == NSUTF8StringEncoding) {
+        // Do not use strlen, the string might contain NUL characters
+        const char *utf8str = [string UTF8String];
+        *pLength = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        return (const uint8_t *)utf8str;
+    }
+    else {
+        NSData *data = [string dataUsingEncoding:encoding allowLossyConversion:NO];
+        if (! data) {
+            return NULL;
+        }
+        
+        // -bytes may return NULL for empty data
+        *pLength = [data length];
+        return [data length] != 0 ? [data bytes] : (const uint8_t *)"";
+    }
+}
+
+// Return YES for the characters which must not be escaped (unreserved characters of RFC 3986). All other bytes are
+// percent-encoded
+static inline BOOL HLSURLIsUnreservedByte(uint8_t byte)
+{
+    static BOOL s_unreserved[256];
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        for (int c = '0'; c <= '9'; ++c) {
+            s_unreserved[c] = YES;
+        }
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            s_unreserved[c] = YES;
+        }
+        for (int c = 'a'; c <= 'z'; ++c) {
+            s_unreserved[c] = YES;
+        }
+        s_unreserved['-'] = YES;
+        s_unreserved['.'] = YES;
+        s_unreserved['_'] = YES;
+        s_unreserved['~'] = YES;
+    });
+    return s_unreserved[byte];
+}
+
+// Return the length of the percent-encoded version of a byte buffer
+static size_t HLSURLEncodedLength(const uint8_t *bytes, size_t length)
+{
+    size_t escapedLength = length;
+    for (size_t i = 0; i < length; ++i) {
+        if (! HLSURLIsUnreservedByte(bytes[i])) {
+            escapedLength += 2;
+        }
+    }
+    return escapedLength;
+}
+
+// Write the percent-encoded version of a byte buffer, and return a pointer to the end of the written characters
+static char *HLSURLEncodeBytes(const uint8_t *bytes, size_t length, char *buffer)
+{
+    static const char kHexadecimalDigits[] = "0123456789ABCDEF";
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t byte = bytes[i];
+        if (HLSURLIsUnreservedByte(byte)) {
+            *buffer++ = byte;
+        }
+        else {
+            *buffer++ = '%';
+            *buffer++ = kHexadecimalDigits[byte >> 4];
+            *buffer++ = kHexadecimalDigits[byte & 0x0F];
+        }
+    }
+    return buffer;
+}
+
+// The digest is calculated into a stack buffer large enough for all supported algorithms
+static NSString *digest(NSString *string, HLSDigestAlgorithm algorithm)
+{
+    unsigned char md[CC_SHA512_DIGEST_LENGTH];
+    const char *utf8str = [string UTF8String];
+    HLSDigestCalculate(algorithm, utf8str, strlen(utf8str), md);
+    return HLSHexadecimalStringFromBytes(md, HLSDigestLength(algorithm));
 }
 
 @implementation NSString (HLSExtensions)
@@ -60,92 +190,127 @@ static NSString* digest(NSString *string, unsigned char *(*cc_digest)(const void
         return font.pointSize;
     }
     
-    CGFloat height = [self sizeWithFont:font
-                      constrainedToSize:CGSizeMake(size.width, FLT_MAX)
-                          lineBreakMode:UILineBreakModeWordWrap].height;
+    // Labels in reused cells usually ask for the same sizes again and again
+    NSString *key = [NSString stringWithFormat:@"%@|%g|%gx%g|%g|%u|%@", font.fontName, font.pointSize, size.width, size.height, 
+                     minFontSize, numberOfLines, self];
+    NSNumber *fontSizeNumber = [HLSFontSizeCache() objectForKey:key];
+    if (fontSizeNumber) {
+        return [fontSizeNumber floatValue];
+    }
     
-    // Empty text
-    if (floateq(height, 0.f)) {
-        return font.pointSize;
+    CGFloat fontSize = HLSFontSizeFittingString(self, font, size, minFontSize, numberOfLines);
+    [HLSFontSizeCache() setObject:[NSNumber numberWithFloat:fontSize] forKey:key];
+    return fontSize;
+}
+
+#pragma mark URL encoding
+
+- (NSString *)urlEncodedStringUsingEncoding:(NSStringEncoding)encoding
+{
+    size_t length = 0;
+    const uint8_t *bytes = HLSURLEncodingBytes(self, encoding, &length);
+    if (! bytes) {
+        return nil;
     }
     
-    CGFloat lineHeight = [self sizeWithFont:font
-                          constrainedToSize:CGSizeMake(FLT_MAX, FLT_MAX)
-                              lineBreakMode:UILineBreakModeWordWrap].height;
+    // Nothing to escape: Avoid creating a new string
+    size_t escapedLength = HLSURLEncodedLength(bytes, length);
+    if (escapedLength == length) {
+        return [[self copy] autorelease];
+    }
     
-    // Reduce the font size so that the text fits vertically
-    UIFont *newFont = font;
-    while (floatgt(height, size.height) || floatgt(ceilf(height / lineHeight), numberOfLines)) {
-        if (floatle(newFont.pointSize, minFontSize)) {
-            return minFontSize;
+    char *escapedBytes = malloc(escapedLength);
+    HLSURLEncodeBytes(bytes, length, escapedBytes);
+    return [[[NSString alloc] initWithBytesNoCopy:escapedBytes 
+                                           length:escapedLength 
+                                         encoding:NSASCIIStringEncoding 
+                                     freeWhenDone:YES] autorelease];
+}
+
++ (NSString *)urlEncodedQueryStringWithParameters:(NSDictionary *)parameters encoding:(NSStringEncoding)encoding
+{
+    NSMutableData *queryData = [NSMutableData data];
+    NSArray *keys = [[parameters allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    for (id key in keys) {
+        NSString *keyString = [key description];
+        NSString *valueString = [[parameters objectForKey:key] description];
+        
+        size_t keyLength = 0;
+        const uint8_t *keyBytes = HLSURLEncodingBytes(keyString, encoding, &keyLength);
+        size_t valueLength = 0;
+        const uint8_t *valueBytes = HLSURLEncodingBytes(valueString, encoding, &valueLength);
+        if (! keyBytes || ! valueBytes) {
+            HLSLoggerError(@"The parameter %@ cannot be represented using the specified encoding", keyString);
+            return nil;
         }
         
-        newFont = [UIFont fontWithName:font.fontName size:newFont.pointSize - 1.f];
-        height = [self sizeWithFont:newFont 
-                  constrainedToSize:CGSizeMake(size.width, FLT_MAX) 
-                      lineBreakMode:UILineBreakModeWordWrap].height;
+        // Encode directly at the end of the buffer
+        NSUInteger offset = [queryData length];
+        size_t escapedKeyLength = HLSURLEncodedLength(keyBytes, keyLength);
+        size_t escapedValueLength = HLSURLEncodedLength(valueBytes, valueLength);
+        BOOL separator = (offset != 0);
+        [queryData increaseLengthBy:separator + escapedKeyLength + 1 + escapedValueLength];
         
-        lineHeight = [self sizeWithFont:newFont 
-                      constrainedToSize:CGSizeMake(FLT_MAX, FLT_MAX) 
-                          lineBreakMode:UILineBreakModeWordWrap].height;        
+        char *buffer = (char *)[queryData mutableBytes] + offset;
+        if (separator) {
+            *buffer++ = '&';
+        }
+        buffer = HLSURLEncodeBytes(keyBytes, keyLength, buffer);
+        *buffer++ = '=';
+        HLSURLEncodeBytes(valueBytes, valueLength, buffer);
     }
     
-    return newFont.pointSize;
-}
-
-#pragma mark URL encoding
-
-- (NSString *)urlEncodedStringUsingEncoding:(NSStringEncoding)encoding
-{
-    CFStringEncoding cfEncoding = CFStringConvertNSStringEncodingToEncoding(encoding);
-    NSString *result = NSMakeCollectable(CFURLCreateStringByAddingPercentEscapes(kCFAllocatorDefault, 
-                                                                                 (CFStringRef)self, 
-                                                                                 NULL, 
-                                                                                 CFSTR("!*'();:@&=+$,/?%#[]"), 
-                                                                                 cfEncoding));
-    return [result autorelease];
+    return [[[NSString alloc] initWithData:queryData encoding:NSASCIIStringEncoding] autorelease];
 }
 
 #pragma mark Hash digests
 
 - (NSString *)md2hash
 {
-    return digest(self, CC_MD2, CC_MD2_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD2);
 }
 
 - (NSString *)md4hash
 {
-    return digest(self, CC_MD4, CC_MD4_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD4);
 }
 
 - (NSString *)md5hash
 {
-    return digest(self, CC_MD5, CC_MD5_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmMD5);
 }
 
 - (NSString *)sha1hash
 {
-    return digest(self, CC_SHA1, CC_SHA1_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA1);
 }
 
 - (NSString *)sha224hash
 {
-    return digest(self, CC_SHA224, CC_SHA224_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA224);
 }
 
 - (NSString *)sha256hash
 {
-    return digest(self, CC_SHA256, CC_SHA256_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA256);
 }
 
 - (NSString *)sha384hash
 {
-    return digest(self, CC_SHA384, CC_SHA384_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA384);
 }
 
 - (NSString *)sha512hash
 {
-    return digest(self, CC_SHA512, CC_SHA512_DIGEST_LENGTH);
+    return digest(self, HLSDigestAlgorithmSHA512);
+}
+
+- (NSData *)digestWithAlgorithm:(HLSDigestAlgorithm)algorithm
+{
+    unsigned char md[CC_SHA512_DIGEST_LENGTH];
+    const char *utf8str = [self UTF8String];
+    HLSDigestCalculate(algorithm, utf8str, strlen(utf8str), md);
+    return [NSData dataWithBytes:md length:HLSDigestLength(algorithm)];
 }
 
 #pragma mark Version strings
@@ -6,6 +6,11 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+/**
+ * Time zone calculations. The offsets of each time zone are looked up in a table of the transitions it undergoes 
+ * within a window of several years, computed once and cached. Converting large sets of dates therefore does not
+ * query the time zone database for each date
+ */
 @interface NSTimeZone (HLSExtensions)
 
 /**
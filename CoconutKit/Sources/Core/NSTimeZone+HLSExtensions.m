@@ -8,6 +8,18 @@
 
 #import "NSTimeZone+HLSExtensions.h"
 
+#import "HLSTimeZoneOffsetTable.h"
+
+@interface NSTimeZone (HLSExtensionsPrivate)
+
+- (NSInteger)cachedSecondsFromGMTForDate:(NSDate *)date;
+- (NSTimeInterval)cachedDaylightSavingTimeOffsetForDate:(NSDate *)date;
+
+@end
+
+#pragma mark -
+#pragma mark HLSExtensions NSTimeZone category implementation
+
 @implementation NSTimeZone (HLSExtensions)
 
 #pragma mark Class methods
@@ -41,7 +53,7 @@
 
 - (NSTimeInterval)offsetFromTimeZone:(NSTimeZone *)timeZone forDate:(NSDate *)date
 {
-    return [self secondsFromGMTForDate:date] - [timeZone secondsFromGMTForDate:date];
+    return [self cachedSecondsFromGMTForDate:date] - [timeZone cachedSecondsFromGMTForDate:date];
 }
 
 - (NSDate *)dateWithSameComponentsAsDate:(NSDate *)date fromTimeZone:(NSTimeZone *)timeZone
@@ -50,8 +62,8 @@
     NSDate *dateInSelf = [date dateByAddingTimeInterval:timeZoneOffset];
     
     // If we crossed the DST transition, we must compensante its effect
-    NSTimeInterval dstTransitionCorrection = [self daylightSavingTimeOffsetForDate:date]
-        - [self daylightSavingTimeOffsetForDate:dateInSelf];
+    NSTimeInterval dstTransitionCorrection = [self cachedDaylightSavingTimeOffsetForDate:date]
+        - [self cachedDaylightSavingTimeOffsetForDate:dateInSelf];
     return [dateInSelf dateByAddingTimeInterval:dstTransitionCorrection];
 }
 
@@ -60,8 +72,8 @@
     NSDate *resultDate = [date dateByAddingTimeInterval:timeInterval];
     
     // If we crossed the DST transition, we must compensante its effect
-    NSTimeInterval dstTransitionCorrection = [self daylightSavingTimeOffsetForDate:date]
-        - [self daylightSavingTimeOffsetForDate:resultDate];
+    NSTimeInterval dstTransitionCorrection = [self cachedDaylightSavingTimeOffsetForDate:date]
+        - [self cachedDaylightSavingTimeOffsetForDate:resultDate];
     return [resultDate dateByAddingTimeInterval:dstTransitionCorrection];
 }
 
@@ -75,9 +87,34 @@
     NSTimeInterval timeInterval = [date1 timeIntervalSinceDate:date2];
     
     // If we crossed the DST transition, we must compensante its effect
-    NSTimeInterval dstTransitionCorrection = [self daylightSavingTimeOffsetForDate:date1]
-        - [self daylightSavingTimeOffsetForDate:date2];
+    NSTimeInterval dstTransitionCorrection = [self cachedDaylightSavingTimeOffsetForDate:date1]
+        - [self cachedDaylightSavingTimeOffsetForDate:date2];
     return timeInterval + dstTransitionCorrection;
 }
 
 @end
+
+#pragma mark -
+#pragma mark HLSExtensionsPrivate NSTimeZone category implementation
+
+@implementation NSTimeZone (HLSExtensionsPrivate)
+
+- (NSInteger)cachedSecondsFromGMTForDate:(NSDate *)date
+{
+    HLSTimeZonePeriod period;
+    if (! HLSTimeZoneGetPeriod(self, [date timeIntervalSinceReferenceDate], &period)) {
+        return [self secondsFromGMTForDate:date];
+    }
+    return period.secondsFromGMT;
+}
+
+- (NSTimeInterval)cachedDaylightSavingTimeOffsetForDate:(NSDate *)date
+{
+    HLSTimeZonePeriod period;
+    if (! HLSTimeZoneGetPeriod(self, [date timeIntervalSinceReferenceDate], &period)) {
+        return [self daylightSavingTimeOffsetForDate:date];
+    }
+    return period.daylightSavingTimeOffset;
+}
+
+@end
@@ -10,6 +10,7 @@
 
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 // Original implementation of the methods we swizzle
 static id (*s_NSURLRequest__initWithURL_cachePolicy_timeoutInterval_Imp)(id, SEL, id, NSURLRequestCachePolicy, NSTimeInterval) = NULL;
@@ -21,9 +22,13 @@ static id swizzled_NSURLRequest__initWithURL_cachePolicy_timeoutInterval_Imp(NSU
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_NSURLRequest__initWithURL_cachePolicy_timeoutInterval_Imp = (id (*)(id, SEL, id, NSURLRequestCachePolicy, NSTimeInterval))HLSSwizzleSelector(self, 
                                                                                                                                                    @selector(initWithURL:cachePolicy:timeoutInterval:),
                                                                                                                                                    (IMP)swizzled_NSURLRequest__initWithURL_cachePolicy_timeoutInterval_Imp);
+    
+    HLSStartupReportRecord("NSURLRequest+HLSExtensions", startTime);
 }
 
 @end
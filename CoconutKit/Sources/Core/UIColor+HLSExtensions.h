@@ -14,12 +14,22 @@
 + (UIColor *)randomColor;
 
 /**
- * Return the ivert color corresponding to the receiver
+ * Return the ivert color corresponding to the receiver (the alpha is preserved). Inverted colors are cached. Return the
+ * receiver if its components cannot be extracted (see -getNormalizedRed:green:blue:alpha:)
  */
 - (UIColor *)invertedColor;
 
 /**
- * Return color components (0 - 255)
+ * Extract all normalized RGBA components (0.f - 1.f) at once. Grayscale colors are supported (the red, green and blue 
+ * components are then all equal to the white component). Each pointer can be NULL if the corresponding component is 
+ * not needed. Return NO (and leave all components unchanged) if the color space is not supported (e.g. for pattern 
+ * colors)
+ */
+- (BOOL)getNormalizedRed:(CGFloat *)pRed green:(CGFloat *)pGreen blue:(CGFloat *)pBlue alpha:(CGFloat *)pAlpha;
+
+/**
+ * Return color components (0 - 255). If you need several components, use -getNormalizedRed:green:blue:alpha: instead.
+ * Return 0 if the color space is not supported
  */
 - (NSUInteger)redComponent;
 - (NSUInteger)greenComponent;
@@ -8,6 +8,12 @@
 
 #import "UIColor+HLSExtensions.h"
 
+// Maximum number of inverted colors kept in cache
+static const NSUInteger kInvertedColorCacheCountLimit = 64;
+
+// Static functions
+static NSCache *HLSInvertedColorCache(void);
+
 @implementation UIColor (HLSExtensions)
 
 + (UIColor *)randomColor
@@ -20,18 +26,67 @@
 
 - (UIColor *)invertedColor
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
+    UIColor *invertedColor = [HLSInvertedColorCache() objectForKey:self];
+    if (invertedColor) {
+        return invertedColor;
+    }
     
-    UIColor *invertedColor = [[[UIColor alloc] initWithRed:1.f - components[0]
-                                                   green:1.f - components[1]
-                                                    blue:1.f - components[2]
-                                                   alpha:components[3]] autorelease];
+    CGFloat red, green, blue, alpha;
+    if (! [self getNormalizedRed:&red green:&green blue:&blue alpha:&alpha]) {
+        return self;
+    }
     
+    invertedColor = [[[UIColor alloc] initWithRed:1.f - red
+                                            green:1.f - green
+                                             blue:1.f - blue
+                                            alpha:alpha] autorelease];
+    [HLSInvertedColorCache() setObject:invertedColor forKey:self];
     return invertedColor;
 }
 
 #pragma mark Color components
 
+- (BOOL)getNormalizedRed:(CGFloat *)pRed green:(CGFloat *)pGreen blue:(CGFloat *)pBlue alpha:(CGFloat *)pAlpha
+{
+    CGColorRef colorRef = self.CGColor;
+    const CGFloat *components = CGColorGetComponents(colorRef);
+    
+    CGFloat red, green, blue, alpha;
+    switch (CGColorSpaceGetModel(CGColorGetColorSpace(colorRef))) {
+        case kCGColorSpaceModelMonochrome: {
+            red = green = blue = components[0];
+            alpha = components[1];
+            break;
+        }
+            
+        case kCGColorSpaceModelRGB: {
+            red = components[0];
+            green = components[1];
+            blue = components[2];
+            alpha = components[3];
+            break;
+        }
+            
+        default: {
+            return NO;
+        }
+    }
+    
+    if (pRed) {
+        *pRed = red;
+    }
+    if (pGreen) {
+        *pGreen = green;
+    }
+    if (pBlue) {
+        *pBlue = blue;
+    }
+    if (pAlpha) {
+        *pAlpha = alpha;
+    }
+    return YES;
+}
+
 - (NSUInteger)redComponent
 {
     return (NSUInteger)roundf(255.f * [self normalizedRedComponent]);
@@ -49,20 +104,35 @@
 
 - (CGFloat)normalizedRedComponent
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    return components[0];
+    CGFloat red = 0.f;
+    [self getNormalizedRed:&red green:NULL blue:NULL alpha:NULL];
+    return red;
 }
 
 - (CGFloat)normalizedGreenComponent
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    return components[1];
+    CGFloat green = 0.f;
+    [self getNormalizedRed:NULL green:&green blue:NULL alpha:NULL];
+    return green;
 }
 
 - (CGFloat)normalizedBlueComponent
 {
-    const CGFloat *components = CGColorGetComponents(self.CGColor);
-    return components[2];
+    CGFloat blue = 0.f;
+    [self getNormalizedRed:NULL green:NULL blue:&blue alpha:NULL];
+    return blue;
 }
 
 @end
+
+static NSCache *HLSInvertedColorCache(void)
+{
+    static NSCache *s_cache = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_cache = [[NSCache alloc] init];
+        s_cache.name = @"ch.hortis.CoconutKit.invertedColorCache";
+        s_cache.countLimit = kInvertedColorCacheCountLimit;
+    });
+    return s_cache;
+}
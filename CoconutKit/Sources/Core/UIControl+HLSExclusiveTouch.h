@@ -7,7 +7,12 @@
 //
 
 /**
- * Globally set exclusive touch to YES for all UIControl objects, preventing quasi-simultaneous taps.
+ * Prevent quasi-simultaneous taps on several controls. While a control is being touched, touches beginning on other
+ * controls are ignored until all fingers have been lifted.
+ *
+ * This behavior can be enabled for the whole application (+[UIControl enable]) or for specific view hierarchies
+ * (controlExclusiveTouchEnabled_hls). Touches are checked once by the window when they begin, creating controls
+ * therefore does not incur any additional cost.
  */
 @interface UIControl (HLSExclusiveTouch)
 
@@ -18,3 +23,15 @@
 + (void)enable;
 
 @end
+
+@interface UIView (HLSExclusiveTouch)
+
+/**
+ * Enable or disable exclusive touch for all controls in the view hierarchy whose root is the receiver. If not set 
+ * on a view, the value of the nearest ancestor for which it has been set is used, or YES if +[UIControl enable] has 
+ * been called. You can therefore enable exclusive touch for the whole application and disable it for some view 
+ * hierarchies, or conversely
+ */
+@property (nonatomic, assign, getter=isControlExclusiveTouchEnabled_hls) BOOL controlExclusiveTouchEnabled_hls;
+
+@end
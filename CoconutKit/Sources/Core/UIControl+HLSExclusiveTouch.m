@@ -10,14 +10,36 @@
 
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import <objc/runtime.h>
+
+/**
+ * Setting exclusiveTouch to YES for each control when it is created (by swizzling UIControl initializers) works, but
+ * makes control creation slower and cannot be restricted to some view hierarchies. Exclusive touch is therefore 
+ * enforced by the window instead: When a touch begins, the window hit-tests the view receiving it. If this view 
+ * belongs to a control for which exclusive touch is enabled and another control already owns the current touch 
+ * sequence, the touch is simply not delivered. The owner is released when all touches have ended
+ */
+
+// Associated object keys
+static void *s_controlExclusiveTouchEnabledKey = &s_controlExclusiveTouchEnabledKey;
+
+// Global setting
+static BOOL s_controlExclusiveTouchEnabled = NO;
+
+// The control owning the current touch sequence, if any
+static UIControl *s_touchOwnerControl = nil;
 
 // Original implementation of the methods we swizzle
-static id (*s_UIControl__initWithFrame_Imp)(id, SEL, CGRect) = NULL;
-static id (*s_UIControl__initWithCoder_Imp)(id, SEL, id) = NULL;
+static UIView *(*s_UIWindow__hitTest_withEvent_Imp)(id, SEL, CGPoint, id) = NULL;
+static void (*s_UIWindow__sendEvent_Imp)(id, SEL, id) = NULL;
 
 // Swizzled method implementations
-static id swizzled_UIControl__initWithFrame_Imp(UIControl *self, SEL _cmd, CGRect frame);
-static id swizzled_UIControl__initWithCoder_Imp(UIControl *self, SEL _cmd, NSCoder *aDecoder);
+static UIView *swizzled_UIWindow__hitTest_withEvent_Imp(UIWindow *self, SEL _cmd, CGPoint point, UIEvent *event);
+static void swizzled_UIWindow__sendEvent_Imp(UIWindow *self, SEL _cmd, UIEvent *event);
+
+// Static functions
+static void HLSInstallExclusiveTouchGate(void);
+static BOOL HLSControlExclusiveTouchEnabledForView(UIView *view);
 
 @implementation UIControl (HLSExclusiveTouch)
 
@@ -25,39 +47,112 @@ static id swizzled_UIControl__initWithCoder_Imp(UIControl *self, SEL _cmd, NSCod
 
 + (void)enable
 {
-    static BOOL s_injected = NO;
-    if (s_injected) {
-        HLSLoggerInfo(@"Exclusive touch already injected");
+    if (s_controlExclusiveTouchEnabled) {
+        HLSLoggerInfo(@"Exclusive touch already enabled");
         return;
     }
     
-    // Swizzle the original implementations (keep a hand on them)
-    s_UIControl__initWithFrame_Imp = (id (*)(id, SEL, CGRect))HLSSwizzleSelector(self, 
-                                                                                 @selector(initWithFrame:), 
-                                                                                 (IMP)swizzled_UIControl__initWithFrame_Imp);
-    s_UIControl__initWithCoder_Imp = (id (*)(id, SEL, id))HLSSwizzleSelector(self, 
-                                                                             @selector(initWithCoder:), 
-                                                                             (IMP)swizzled_UIControl__initWithCoder_Imp);
+    HLSInstallExclusiveTouchGate();
+    s_controlExclusiveTouchEnabled = YES;
+}
+
+@end
+
+@implementation UIView (HLSExclusiveTouch)
+
+#pragma mark Accessors and mutators
+
+- (BOOL)isControlExclusiveTouchEnabled_hls
+{
+    return HLSControlExclusiveTouchEnabledForView(self);
+}
+
+- (void)setControlExclusiveTouchEnabled_hls:(BOOL)controlExclusiveTouchEnabled_hls
+{
+    if (controlExclusiveTouchEnabled_hls) {
+        HLSInstallExclusiveTouchGate();
+    }
     
-    s_injected = YES;
+    objc_setAssociatedObject(self, s_controlExclusiveTouchEnabledKey, [NSNumber numberWithBool:controlExclusiveTouchEnabled_hls], 
+                             OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 }
 
 @end
 
+#pragma mark Static functions
+
+static void HLSInstallExclusiveTouchGate(void)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_UIWindow__hitTest_withEvent_Imp = (UIView *(*)(id, SEL, CGPoint, id))HLSSwizzleSelector([UIWindow class], 
+                                                                                                  @selector(hitTest:withEvent:), 
+                                                                                                  (IMP)swizzled_UIWindow__hitTest_withEvent_Imp);
+        s_UIWindow__sendEvent_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector([UIWindow class], 
+                                                                              @selector(sendEvent:), 
+                                                                              (IMP)swizzled_UIWindow__sendEvent_Imp);
+    });
+}
+
+// The setting of the nearest view in the hierarchy for which it has been set, otherwise the global setting
+static BOOL HLSControlExclusiveTouchEnabledForView(UIView *view)
+{
+    while (view) {
+        NSNumber *controlExclusiveTouchEnabledNumber = objc_getAssociatedObject(view, s_controlExclusiveTouchEnabledKey);
+        if (controlExclusiveTouchEnabledNumber) {
+            return [controlExclusiveTouchEnabledNumber boolValue];
+        }
+        view = view.superview;
+    }
+    return s_controlExclusiveTouchEnabled;
+}
+
 #pragma mark Swizzled method implementations
 
-static id swizzled_UIControl__initWithFrame_Imp(UIControl *self, SEL _cmd, CGRect frame)
+static UIView *swizzled_UIWindow__hitTest_withEvent_Imp(UIWindow *self, SEL _cmd, CGPoint point, UIEvent *event)
 {
-    if ((self = (*s_UIControl__initWithFrame_Imp)(self, _cmd, frame))) {
-        self.exclusiveTouch = YES;
+    UIView *view = (*s_UIWindow__hitTest_withEvent_Imp)(self, _cmd, point, event);
+    
+    // Only new touches are hit-tested with a touch event
+    if (! view || event.type != UIEventTypeTouches) {
+        return view;
+    }
+    
+    // Find the control receiving the touch, if any
+    UIView *controlView = view;
+    while (controlView && ! [controlView isKindOfClass:[UIControl class]]) {
+        controlView = controlView.superview;
+    }
+    if (! controlView || ! HLSControlExclusiveTouchEnabledForView(controlView)) {
+        return view;
     }
-    return self;
+    
+    // Another control is being touched: Do not deliver the touch
+    if (s_touchOwnerControl && s_touchOwnerControl != controlView) {
+        return nil;
+    }
+    
+    if (! s_touchOwnerControl) {
+        s_touchOwnerControl = (UIControl *)[controlView retain];
+    }
+    return view;
 }
 
-static id swizzled_UIControl__initWithCoder_Imp(UIControl *self, SEL _cmd, NSCoder *aDecoder)
+static void swizzled_UIWindow__sendEvent_Imp(UIWindow *self, SEL _cmd, UIEvent *event)
 {
-    if ((self = (*s_UIControl__initWithCoder_Imp)(self, _cmd, aDecoder))) {
-        self.exclusiveTouch = YES;
+    (*s_UIWindow__sendEvent_Imp)(self, _cmd, event);
+    
+    if (! s_touchOwnerControl || event.type != UIEventTypeTouches) {
+        return;
+    }
+    
+    // Release the owner when the touch sequence is over, i.e. when all touches have ended
+    for (UITouch *touch in [event allTouches]) {
+        if (touch.phase != UITouchPhaseEnded && touch.phase != UITouchPhaseCancelled) {
+            return;
+        }
     }
-    return self;
+    
+    [s_touchOwnerControl release];
+    s_touchOwnerControl = nil;
 }
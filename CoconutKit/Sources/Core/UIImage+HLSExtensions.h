@@ -6,16 +6,33 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+/**
+ * Block called when an image has been loaded asynchronously. The image is nil if it could not be loaded
+ */
+typedef void (^HLSImageCompletionBlock)(UIImage *image);
+
 @interface UIImage (HLSExtensions)
 
 /**
- * Return a 1x1 px image having a given color
+ * Return a 1x1 px image having a given color. Such an image stretches without artifacts and can therefore be used
+ * as a background of any size
+ *
+ * Images are cached (the cache is bounded and purged when memory is low), repeated requests are therefore free
  */
 + (UIImage *)imageWithColor:(UIColor *)color;
 
+/**
+ * Same as +imageWithColor:, but returning an image of the specified size. Prefer +imageWithColor: when the image
+ * is stretched anyway (e.g. by an image view), this avoids allocating a large bitmap
+ */
++ (UIImage *)imageWithColor:(UIColor *)color size:(CGSize)size;
+
 /**
  * Return the receiver masked with some image. Black mask pixels correspond to unmasked portions. To make parts of
  * the mask transparent, use pixels between black (opaque) and white (transparent), not an alpha
+ *
+ * The result is cached for a given receiver and mask image instance pair (the cache is bounded and purged when 
+ * memory is low)
  */
 - (UIImage *)imageMaskedWithImage:(UIImage *)maskImage;
 
@@ -24,4 +41,39 @@
  */
 - (UIImage *)imageScaledToSize:(CGSize)size;
 
+/**
+ * Images loaded from files (e.g. using +imageNamed: or +imageWithContentsOfFile:) are decoded lazily, the first time
+ * they are drawn. This usually happens on the main thread, possibly while an animation is running. Those methods
+ * return an equivalent image whose bitmap has already been decoded into a display-ready format, and which can be
+ * drawn without further work
+ *
+ * -decodedImage can be called from any thread. -decodeWithCompletionBlock: decodes the image on a background queue 
+ * and calls the completion block on the main thread. The decoded image is kept with the receiver, so that decoding 
+ * the same image instance again (e.g. an image cached by +imageNamed:) is free. Resizable images are returned as is
+ */
+- (UIImage *)decodedImage;
+- (void)decodeWithCompletionBlock:(HLSImageCompletionBlock)completionBlock;
+
+/**
+ * Return a downscaled version of the image stored in a file or in memory, whose largest dimension is at most 
+ * maxPixelSize pixels (the aspect ratio is preserved, and EXIF orientation is applied). Images are decoded directly 
+ * at the target size using ImageIO, which is much faster and uses much less memory than decoding the full-resolution
+ * image and scaling it with -imageScaledToSize:. The returned image is fully decoded and has the main screen scale
+ *
+ * These methods can be called from any thread. Return nil if the image could not be loaded
+ */
++ (UIImage *)thumbnailImageWithContentsOfFile:(NSString *)path maxPixelSize:(CGFloat)maxPixelSize;
++ (UIImage *)thumbnailImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize;
+
+/**
+ * Same as the methods above, but decoding the image on a background queue. The completion block is called on the 
+ * main thread
+ */
++ (void)loadThumbnailImageWithContentsOfFile:(NSString *)path 
+                                maxPixelSize:(CGFloat)maxPixelSize 
+                             completionBlock:(HLSImageCompletionBlock)completionBlock;
++ (void)loadThumbnailImageWithData:(NSData *)data 
+                      maxPixelSize:(CGFloat)maxPixelSize 
+                   completionBlock:(HLSImageCompletionBlock)completionBlock;
+
 @end
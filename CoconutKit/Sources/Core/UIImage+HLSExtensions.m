@@ -8,11 +8,57 @@
 
 #import "UIImage+HLSExtensions.h"
 
+#import <ImageIO/ImageIO.h>
+#import <objc/runtime.h>
+
+// Associated object keys
+static void *s_decodedImageKey = &s_decodedImageKey;
+static void *s_decodedKey = &s_decodedKey;
+
+// Maximum number of images kept in each cache
+static const NSUInteger kImageCacheCountLimit = 64;
+
+// Static functions
+static NSCache *HLSColorImageCache(void);
+static NSCache *HLSMaskedImageCache(void);
+static NSString *HLSColorImageCacheKey(UIColor *color, CGSize size);
+static UIImage *HLSMaskedImage(UIImage *image, UIImage *maskImage);
+static dispatch_queue_t HLSImageDecodingQueue(void);
+static UIImage *HLSThumbnailImageFromImageSource(CGImageSourceRef imageSource, CGFloat maxPixelSize);
+
+/**
+ * Masked image cache entry. Retains the source and mask images so that their addresses (used as cache key) cannot be
+ * reused by other images while the entry exists
+ */
+@interface HLSMaskedImageCacheEntry : NSObject {
+@private
+    UIImage *m_image;
+    UIImage *m_maskImage;
+    UIImage *m_maskedImage;
+}
+
+- (id)initWithImage:(UIImage *)image maskImage:(UIImage *)maskImage maskedImage:(UIImage *)maskedImage;
+
+@property (nonatomic, readonly, retain) UIImage *maskedImage;
+
+@end
+
 @implementation UIImage (HLSExtensions)
 
 + (UIImage *)imageWithColor:(UIColor *)color
 {
-    CGRect rect = CGRectMake(0.0f, 0.0f, 1.0f, 1.0f);
+    return [self imageWithColor:color size:CGSizeMake(1.f, 1.f)];
+}
+
++ (UIImage *)imageWithColor:(UIColor *)color size:(CGSize)size
+{
+    NSString *key = HLSColorImageCacheKey(color, size);
+    UIImage *image = key ? [HLSColorImageCache() objectForKey:key] : nil;
+    if (image) {
+        return image;
+    }
+    
+    CGRect rect = CGRectMake(0.0f, 0.0f, size.width, size.height);
     
     UIGraphicsBeginImageContext(rect.size);
     
@@ -20,13 +66,223 @@
     CGContextSetFillColorWithColor(context, color.CGColor);
     CGContextFillRect(context, rect);
     
-    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    image = UIGraphicsGetImageFromCurrentImageContext();
     
     UIGraphicsEndImageContext();
+    
+    if (key && image) {
+        [HLSColorImageCache() setObject:image forKey:key];
+    }
     return image;
 }
 
 - (UIImage *)imageMaskedWithImage:(UIImage *)maskImage
+{
+    if (! maskImage) {
+        return HLSMaskedImage(self, maskImage);
+    }
+    
+    NSString *key = [NSString stringWithFormat:@"%p-%p", self, maskImage];
+    HLSMaskedImageCacheEntry *entry = [HLSMaskedImageCache() objectForKey:key];
+    if (entry) {
+        return entry.maskedImage;
+    }
+    
+    UIImage *maskedImage = HLSMaskedImage(self, maskImage);
+    if (maskedImage) {
+        entry = [[[HLSMaskedImageCacheEntry alloc] initWithImage:self maskImage:maskImage maskedImage:maskedImage] autorelease];
+        [HLSMaskedImageCache() setObject:entry forKey:key];
+    }
+    return maskedImage;
+}
+
+- (UIImage *)imageScaledToSize:(CGSize)size
+{
+    UIGraphicsBeginImageContext(size);
+    [self drawInRect:CGRectMake(0.f, 0.f, size.width, size.height)];
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+- (UIImage *)decodedImage
+{
+    if (objc_getAssociatedObject(self, s_decodedKey)) {
+        return self;
+    }
+    
+    UIImage *decodedImage = objc_getAssociatedObject(self, s_decodedImageKey);
+    if (decodedImage) {
+        return decodedImage;
+    }
+    
+    // Cap insets would be lost
+    if (self.leftCapWidth != 0 || self.topCapHeight != 0
+            || ([self respondsToSelector:@selector(capInsets)] && ! UIEdgeInsetsEqualToEdgeInsets(self.capInsets, UIEdgeInsetsZero))) {
+        return self;
+    }
+    
+    CGImageRef imageRef = self.CGImage;
+    if (! imageRef) {
+        return self;
+    }
+    
+    // Draw into a bitmap having the native format of the display
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(imageRef);
+    BOOL hasAlpha = (alphaInfo != kCGImageAlphaNone && alphaInfo != kCGImageAlphaNoneSkipFirst && alphaInfo != kCGImageAlphaNoneSkipLast);
+    CGBitmapInfo bitmapInfo = kCGBitmapByteOrder32Little | (hasAlpha ? kCGImageAlphaPremultipliedFirst : kCGImageAlphaNoneSkipFirst);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, bitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+    if (! context) {
+        return self;
+    }
+    
+    CGContextDrawImage(context, CGRectMake(0.f, 0.f, width, height), imageRef);
+    CGImageRef decodedImageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (! decodedImageRef) {
+        return self;
+    }
+    
+    decodedImage = [UIImage imageWithCGImage:decodedImageRef scale:self.scale orientation:self.imageOrientation];
+    CGImageRelease(decodedImageRef);
+    
+    objc_setAssociatedObject(decodedImage, s_decodedKey, [NSNumber numberWithBool:YES], OBJC_ASSOCIATION_RETAIN);
+    objc_setAssociatedObject(self, s_decodedImageKey, decodedImage, OBJC_ASSOCIATION_RETAIN);
+    return decodedImage;
+}
+
+- (void)decodeWithCompletionBlock:(HLSImageCompletionBlock)completionBlock
+{
+    completionBlock = [[completionBlock copy] autorelease];
+    dispatch_async(HLSImageDecodingQueue(), ^{
+        UIImage *decodedImage = [self decodedImage];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completionBlock) {
+                completionBlock(decodedImage);
+            }
+        });
+    });
+}
+
++ (UIImage *)thumbnailImageWithContentsOfFile:(NSString *)path maxPixelSize:(CGFloat)maxPixelSize
+{
+    if (! path) {
+        return nil;
+    }
+    
+    CGImageSourceRef imageSource = CGImageSourceCreateWithURL((CFURLRef)[NSURL fileURLWithPath:path], NULL);
+    if (! imageSource) {
+        return nil;
+    }
+    
+    UIImage *image = HLSThumbnailImageFromImageSource(imageSource, maxPixelSize);
+    CFRelease(imageSource);
+    return image;
+}
+
++ (UIImage *)thumbnailImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize
+{
+    if (! data) {
+        return nil;
+    }
+    
+    CGImageSourceRef imageSource = CGImageSourceCreateWithData((CFDataRef)data, NULL);
+    if (! imageSource) {
+        return nil;
+    }
+    
+    UIImage *image = HLSThumbnailImageFromImageSource(imageSource, maxPixelSize);
+    CFRelease(imageSource);
+    return image;
+}
+
++ (void)loadThumbnailImageWithContentsOfFile:(NSString *)path 
+                                maxPixelSize:(CGFloat)maxPixelSize 
+                             completionBlock:(HLSImageCompletionBlock)completionBlock
+{
+    path = [[path copy] autorelease];
+    completionBlock = [[completionBlock copy] autorelease];
+    dispatch_async(HLSImageDecodingQueue(), ^{
+        UIImage *image = [UIImage thumbnailImageWithContentsOfFile:path maxPixelSize:maxPixelSize];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completionBlock) {
+                completionBlock(image);
+            }
+        });
+    });
+}
+
++ (void)loadThumbnailImageWithData:(NSData *)data 
+                      maxPixelSize:(CGFloat)maxPixelSize 
+                   completionBlock:(HLSImageCompletionBlock)completionBlock
+{
+    completionBlock = [[completionBlock copy] autorelease];
+    dispatch_async(HLSImageDecodingQueue(), ^{
+        UIImage *image = [UIImage thumbnailImageWithData:data maxPixelSize:maxPixelSize];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completionBlock) {
+                completionBlock(image);
+            }
+        });
+    });
+}
+
+@end
+
+static NSCache *HLSColorImageCache(void)
+{
+    static NSCache *s_cache = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_cache = [[NSCache alloc] init];
+        s_cache.name = @"ch.hortis.CoconutKit.colorImageCache";
+        s_cache.countLimit = kImageCacheCountLimit;
+    });
+    return s_cache;
+}
+
+static NSCache *HLSMaskedImageCache(void)
+{
+    static NSCache *s_cache = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_cache = [[NSCache alloc] init];
+        s_cache.name = @"ch.hortis.CoconutKit.maskedImageCache";
+        s_cache.countLimit = kImageCacheCountLimit;
+    });
+    return s_cache;
+}
+
+/**
+ * Return a key identifying a color (by color space model and components) and a size, or nil if the color cannot be
+ * cached (e.g. pattern colors)
+ */
+static NSString *HLSColorImageCacheKey(UIColor *color, CGSize size)
+{
+    CGColorRef colorRef = color.CGColor;
+    if (! colorRef) {
+        return nil;
+    }
+    
+    CGColorSpaceModel model = CGColorSpaceGetModel(CGColorGetColorSpace(colorRef));
+    if (model == kCGColorSpaceModelPattern || model == kCGColorSpaceModelIndexed) {
+        return nil;
+    }
+    
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%d|%gx%g", (int)model, size.width, size.height];
+    const CGFloat *components = CGColorGetComponents(colorRef);
+    size_t numberOfComponents = CGColorGetNumberOfComponents(colorRef);
+    for (size_t i = 0; i < numberOfComponents; ++i) {
+        [key appendFormat:@"|%g", components[i]];
+    }
+    return key;
+}
+
+static UIImage *HLSMaskedImage(UIImage *image, UIImage *maskImage)
 {
 	CGImageRef maskImageRef = CGImageMaskCreate(CGImageGetWidth(maskImage.CGImage),
                                                 CGImageGetHeight(maskImage.CGImage),
@@ -37,7 +293,7 @@
                                                 NULL,
                                                 false);
     
-	CGImageRef maskedImageRef = CGImageCreateWithMask(self.CGImage, maskImageRef);
+	CGImageRef maskedImageRef = CGImageCreateWithMask(image.CGImage, maskImageRef);
     CGImageRelease(maskImageRef);
     
 	UIImage *maskedImage = [UIImage imageWithCGImage:maskedImageRef];
@@ -46,13 +302,63 @@
     return maskedImage;
 }
 
-- (UIImage *)imageScaledToSize:(CGSize)size
+static dispatch_queue_t HLSImageDecodingQueue(void)
 {
-    UIGraphicsBeginImageContext(size);
-    [self drawInRect:CGRectMake(0.f, 0.f, size.width, size.height)];
-    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
-    UIGraphicsEndImageContext();
+    // Serial, so that several large images are never decoded at the same time
+    static dispatch_queue_t s_queue = NULL;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.hortis.CoconutKit.imageDecoding", NULL);
+        dispatch_set_target_queue(s_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+    });
+    return s_queue;
+}
+
+static UIImage *HLSThumbnailImageFromImageSource(CGImageSourceRef imageSource, CGFloat maxPixelSize)
+{
+    NSDictionary *options = [NSDictionary dictionaryWithObjectsAndKeys:(id)kCFBooleanTrue, (id)kCGImageSourceCreateThumbnailFromImageAlways,
+                             (id)kCFBooleanTrue, (id)kCGImageSourceCreateThumbnailWithTransform,
+                             [NSNumber numberWithFloat:maxPixelSize], (id)kCGImageSourceThumbnailMaxPixelSize, nil];
+    CGImageRef thumbnailImageRef = CGImageSourceCreateThumbnailAtIndex(imageSource, 0, (CFDictionaryRef)options);
+    if (! thumbnailImageRef) {
+        return nil;
+    }
+    
+    UIImage *image = [UIImage imageWithCGImage:thumbnailImageRef scale:[UIScreen mainScreen].scale orientation:UIImageOrientationUp];
+    CGImageRelease(thumbnailImageRef);
     return image;
 }
 
+@implementation HLSMaskedImageCacheEntry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithImage:(UIImage *)image maskImage:(UIImage *)maskImage maskedImage:(UIImage *)maskedImage
+{
+    if ((self = [super init])) {
+        m_image = [image retain];
+        m_maskImage = [maskImage retain];
+        m_maskedImage = [maskedImage retain];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_image release];
+    m_image = nil;
+    
+    [m_maskImage release];
+    m_maskImage = nil;
+    
+    [m_maskedImage release];
+    m_maskedImage = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize maskedImage = m_maskedImage;
+
 @end
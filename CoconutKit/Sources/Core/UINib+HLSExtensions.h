@@ -0,0 +1,29 @@
+//
+//  UINib+HLSExtensions.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+@interface UINib (HLSExtensions)
+
+/**
+ * Return the nib with a given name from a bundle (the main bundle if nil), nil if it does not exist. Nibs are cached
+ * process-wide: A nib file is read and parsed once, subsequent calls return the same UINib object, whose
+ * -instantiateWithOwner:options: method can then cheaply be called each time new objects are needed. This is
+ * especially useful for views or cells which are frequently instantiated while scrolling.
+ *
+ * The cache is automatically purged when a memory warning is received, as well as when the localization changes
+ * (see NSBundle+HLSDynamicLocalization.h), so that localized nibs are loaded again for the new localization.
+ *
+ * This method must only be called from the main thread.
+ */
++ (UINib *)cachedNibWithName:(NSString *)name bundle:(NSBundle *)bundleOrNil;
+
+/**
+ * Discard all nibs cached so far
+ */
++ (void)purgeNibCache;
+
+@end
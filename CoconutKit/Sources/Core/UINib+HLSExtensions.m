@@ -0,0 +1,80 @@
+//
+//  UINib+HLSExtensions.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "UINib+HLSExtensions.h"
+
+#import "HLSLogger.h"
+#import "NSBundle+HLSDynamicLocalization.h"
+
+static NSMutableDictionary *s_keyToNibMap = nil;
+
+@interface UINib (HLSExtensionsPrivate)
+
++ (void)nibCacheDidReceiveMemoryWarning:(NSNotification *)notification;
++ (void)nibCacheCurrentLocalizationDidChange:(NSNotification *)notification;
+
+@end
+
+@implementation UINib (HLSExtensions)
+
++ (UINib *)cachedNibWithName:(NSString *)name bundle:(NSBundle *)bundleOrNil
+{
+    if (! name) {
+        return nil;
+    }
+    
+    // Created lazily, and purged on memory warnings and localization changes for the whole application lifetime. Nibs
+    // are namely resolved for the localization at the time they are created
+    if (! s_keyToNibMap) {
+        s_keyToNibMap = [[NSMutableDictionary dictionary] retain];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(nibCacheDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(nibCacheCurrentLocalizationDidChange:)
+                                                     name:HLSCurrentLocalizationDidChangeNotification
+                                                   object:nil];
+    }
+    
+    NSBundle *bundle = bundleOrNil ? bundleOrNil : [NSBundle mainBundle];
+    NSString *key = [[bundle bundlePath] stringByAppendingPathComponent:name];
+    UINib *nib = [s_keyToNibMap objectForKey:key];
+    if (! nib) {
+        // UINib would only fail when instantiated
+        if (! [bundle pathForResource:name ofType:@"nib"]) {
+            HLSLoggerDebug(@"The nib %@ does not exist in bundle %@", name, bundle);
+            return nil;
+        }
+        
+        nib = [UINib nibWithNibName:name bundle:bundle];
+        [s_keyToNibMap setObject:nib forKey:key];
+    }
+    return nib;
+}
+
++ (void)purgeNibCache
+{
+    [s_keyToNibMap removeAllObjects];
+}
+
+#pragma mark Notification callbacks
+
++ (void)nibCacheDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    HLSLoggerDebug(@"Memory warning received, %d cached nibs discarded", [s_keyToNibMap count]);
+    [self purgeNibCache];
+}
+
++ (void)nibCacheCurrentLocalizationDidChange:(NSNotification *)notification
+{
+    HLSLoggerDebug(@"Localization changed, %d cached nibs discarded", [s_keyToNibMap count]);
+    [self purgeNibCache];
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  HLSLiveQuery.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+// Forward declarations
+@protocol HLSLiveQueryDelegate;
+
+/**
+ * A live query keeps the result of a query made with +[NSManagedObject filteredObjectsUsingPredicate:sortedUsingDescriptors:
+ * inManagedObjectContext:] up to date as the managed object context changes. Instead of fetching all objects again
+ * each time the context changes, only the objects inserted, updated or deleted (as reported by the
+ * NSManagedObjectContextObjectsDidChangeNotification notification) are considered:
+ *   - the predicate is evaluated in memory for each of them. It must therefore only contain expressions which can be
+ *     evaluated on objects (not store-only ones)
+ *   - objects which do not match the predicate anymore are removed, new matching objects are inserted at the position
+ *     given by the sort descriptors (found by binary search). Objects whose sort keys changed are moved accordingly
+ * The only full fetch is made when the query is created, and when the context is reset.
+ *
+ * Changes are reported to the delegate object per object. The index given for each change is valid at the time the
+ * change is reported, i.e. after all previously reported changes have been applied. Changes resulting from a single
+ * notification are enclosed between -liveQueryWillChangeObjects: and -liveQueryDidChangeObjects: calls, so that they
+ * can e.g. be applied to a table view between -beginUpdates and -endUpdates calls
+ *
+ * Note that the context only posts NSManagedObjectContextObjectsDidChangeNotification when it processes its pending
+ * changes, usually at the end of the current run loop iteration. Like managed object contexts, a live query must only
+ * be used from the thread of its context
+ *
+ * Designated initializer: -initWithEntityClass:predicate:sortDescriptors:managedObjectContext:
+ */
+@interface HLSLiveQuery : NSObject {
+@private
+    Class m_entityClass;
+    NSEntityDescription *m_entityDescription;
+    NSPredicate *m_predicate;
+    NSArray *m_sortDescriptors;
+    NSManagedObjectContext *m_managedObjectContext;
+    NSMutableArray *m_objects;
+    NSMutableSet *m_objectSet;
+    id<HLSLiveQueryDelegate> m_delegate;
+    struct {
+        unsigned int willChange:1;
+        unsigned int didInsert:1;
+        unsigned int didRemove:1;
+        unsigned int didMove:1;
+        unsigned int didUpdate:1;
+        unsigned int didChange:1;
+        unsigned int didReload:1;
+    } m_delegateFlags;                                  // optional delegate methods implemented (set with the delegate)
+}
+
+/**
+ * Create a live query for instances of the specified NSManagedObject subclass matching a predicate (nil for all instances),
+ * sorted using the specified descriptors (if no sort descriptors are provided, new objects are appended at the end). The
+ * query is made immediately. Without context parameter, the current HLSModelManager context is used
+ */
+- (id)initWithEntityClass:(Class)entityClass
+                predicate:(NSPredicate *)predicate
+          sortDescriptors:(NSArray *)sortDescriptors
+     managedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+- (id)initWithEntityClass:(Class)entityClass
+                predicate:(NSPredicate *)predicate
+          sortDescriptors:(NSArray *)sortDescriptors;
+
+/**
+ * Query parameters
+ */
+@property (nonatomic, readonly, assign) Class entityClass;
+@property (nonatomic, readonly, retain) NSPredicate *predicate;
+@property (nonatomic, readonly, retain) NSArray *sortDescriptors;
+@property (nonatomic, readonly, retain) NSManagedObjectContext *managedObjectContext;
+
+/**
+ * The current query results, sorted. The array is updated in place when the results change, copy it if you need
+ * a snapshot
+ */
+@property (nonatomic, readonly, retain) NSArray *objects;
+
+/**
+ * The live query delegate
+ */
+@property (nonatomic, assign) id<HLSLiveQueryDelegate> delegate;
+
+@end
+
+@protocol HLSLiveQueryDelegate <NSObject>
+
+@optional
+
+// Called before and after the changes resulting from a context change are reported (not called if the results did
+// not change)
+- (void)liveQueryWillChangeObjects:(HLSLiveQuery *)liveQuery;
+- (void)liveQueryDidChangeObjects:(HLSLiveQuery *)liveQuery;
+
+// Called for each result change
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didInsertObject:(NSManagedObject *)object atIndex:(NSUInteger)index;
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didRemoveObject:(NSManagedObject *)object atIndex:(NSUInteger)index;
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didMoveObject:(NSManagedObject *)object fromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+- (void)liveQuery:(HLSLiveQuery *)liveQuery didUpdateObject:(NSManagedObject *)object atIndex:(NSUInteger)index;
+
+// Called when all results have been fetched again after the context has been reset
+- (void)liveQueryDidReloadObjects:(HLSLiveQuery *)liveQuery;
+
+@end
@@ -0,0 +1,347 @@
+//
+//  HLSLiveQuery.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSLiveQuery.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+#import "HLSModelManager.h"
+#import "NSManagedObject+HLSExtensions.h"
+#import "NSObject+HLSExtensions.h"
+
+// Static functions
+static NSComparisonResult HLSLiveQueryCompareObjects(id object1, id object2, NSArray *sortDescriptors);
+
+@interface HLSLiveQuery ()
+
+@property (nonatomic, retain) NSEntityDescription *entityDescription;
+@property (nonatomic, retain) NSPredicate *predicate;
+@property (nonatomic, retain) NSArray *sortDescriptors;
+@property (nonatomic, retain) NSManagedObjectContext *managedObjectContext;
+@property (nonatomic, retain) NSMutableArray *mutableObjects;
+@property (nonatomic, retain) NSMutableSet *objectSet;
+
+- (void)reloadObjects;
+
+- (NSUInteger)insertionIndexForObject:(NSManagedObject *)object;
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification;
+
+@end
+
+@implementation HLSLiveQuery
+
+#pragma mark Object creation and destruction
+
+- (id)initWithEntityClass:(Class)entityClass
+                predicate:(NSPredicate *)predicate
+          sortDescriptors:(NSArray *)sortDescriptors
+     managedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if ((self = [super init])) {
+        HLSAssertObjectsInEnumerationAreKindOfClass(sortDescriptors, NSSortDescriptor);
+        
+        if (! [entityClass isSubclassOfClass:[NSManagedObject class]]) {
+            HLSLoggerError(@"The class %@ is not a managed object class", entityClass);
+            [self release];
+            return nil;
+        }
+        
+        if (! managedObjectContext) {
+            HLSLoggerError(@"Missing managed object context");
+            [self release];
+            return nil;
+        }
+        
+        self.entityDescription = [NSEntityDescription entityForName:[entityClass className] inManagedObjectContext:managedObjectContext];
+        if (! self.entityDescription) {
+            HLSLoggerError(@"No entity found for the class %@", entityClass);
+            [self release];
+            return nil;
+        }
+        
+        m_entityClass = entityClass;
+        self.predicate = predicate;
+        self.sortDescriptors = sortDescriptors;
+        self.managedObjectContext = managedObjectContext;
+        
+        [self reloadObjects];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(managedObjectContextObjectsDidChange:)
+                                                     name:NSManagedObjectContextObjectsDidChangeNotification
+                                                   object:managedObjectContext];
+    }
+    return self;
+}
+
+- (id)initWithEntityClass:(Class)entityClass
+                predicate:(NSPredicate *)predicate
+          sortDescriptors:(NSArray *)sortDescriptors
+{
+    return [self initWithEntityClass:entityClass
+                           predicate:predicate
+                     sortDescriptors:sortDescriptors
+                managedObjectContext:[HLSModelManager currentModelContext]];
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:NSManagedObjectContextObjectsDidChangeNotification
+                                                  object:m_managedObjectContext];
+    
+    self.entityDescription = nil;
+    self.predicate = nil;
+    self.sortDescriptors = nil;
+    self.managedObjectContext = nil;
+    self.mutableObjects = nil;
+    self.objectSet = nil;
+    self.delegate = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize entityClass = m_entityClass;
+
+@synthesize entityDescription = m_entityDescription;
+
+@synthesize predicate = m_predicate;
+
+@synthesize sortDescriptors = m_sortDescriptors;
+
+@synthesize managedObjectContext = m_managedObjectContext;
+
+@synthesize mutableObjects = m_objects;
+
+- (NSArray *)objects
+{
+    return self.mutableObjects;
+}
+
+@synthesize objectSet = m_objectSet;
+
+@synthesize delegate = m_delegate;
+
+- (void)setDelegate:(id<HLSLiveQueryDelegate>)delegate
+{
+    m_delegate = delegate;
+    
+    // Optional methods are looked up once, not each time a result changes
+    m_delegateFlags.willChange = [delegate respondsToSelector:@selector(liveQueryWillChangeObjects:)];
+    m_delegateFlags.didInsert = [delegate respondsToSelector:@selector(liveQuery:didInsertObject:atIndex:)];
+    m_delegateFlags.didRemove = [delegate respondsToSelector:@selector(liveQuery:didRemoveObject:atIndex:)];
+    m_delegateFlags.didMove = [delegate respondsToSelector:@selector(liveQuery:didMoveObject:fromIndex:toIndex:)];
+    m_delegateFlags.didUpdate = [delegate respondsToSelector:@selector(liveQuery:didUpdateObject:atIndex:)];
+    m_delegateFlags.didChange = [delegate respondsToSelector:@selector(liveQueryDidChangeObjects:)];
+    m_delegateFlags.didReload = [delegate respondsToSelector:@selector(liveQueryDidReloadObjects:)];
+}
+
+#pragma mark Query
+
+- (void)reloadObjects
+{
+    NSArray *objects = [m_entityClass filteredObjectsUsingPredicate:self.predicate
+                                             sortedUsingDescriptors:self.sortDescriptors
+                                             inManagedObjectContext:self.managedObjectContext];
+    self.mutableObjects = objects ? [NSMutableArray arrayWithArray:objects] : [NSMutableArray array];
+    self.objectSet = [NSMutableSet setWithArray:self.mutableObjects];
+}
+
+- (NSUInteger)insertionIndexForObject:(NSManagedObject *)object
+{
+    if ([self.sortDescriptors count] == 0) {
+        return [self.objects count];
+    }
+    
+    // Objects comparing equal are inserted after existing ones
+    NSArray *sortDescriptors = self.sortDescriptors;
+    return [self.objects indexOfObject:object
+                         inSortedRange:NSMakeRange(0, [self.objects count])
+                               options:NSBinarySearchingLastEqual | NSBinarySearchingInsertionIndex
+                       usingComparator:^(id object1, id object2) {
+                           return HLSLiveQueryCompareObjects(object1, object2, sortDescriptors);
+                       }];
+}
+
+#pragma mark Notification callbacks
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification
+{
+    NSDictionary *userInfo = [notification userInfo];
+    
+    // All objects have been invalidated. No way to avoid a full fetch
+    if ([userInfo objectForKey:NSInvalidatedAllObjectsKey]) {
+        [self reloadObjects];
+        
+        if (m_delegateFlags.didReload) {
+            [self.delegate liveQueryDidReloadObjects:self];
+        }
+        return;
+    }
+    
+    NSMutableSet *removedObjects = [NSMutableSet setWithSet:[userInfo objectForKey:NSDeletedObjectsKey]];
+    [removedObjects unionSet:[userInfo objectForKey:NSInvalidatedObjectsKey]];
+    
+    NSMutableSet *changedObjects = [NSMutableSet setWithSet:[userInfo objectForKey:NSInsertedObjectsKey]];
+    [changedObjects unionSet:[userInfo objectForKey:NSUpdatedObjectsKey]];
+    [changedObjects unionSet:[userInfo objectForKey:NSRefreshedObjectsKey]];
+    [changedObjects minusSet:removedObjects];
+    
+    BOOL changing = NO;
+    
+    for (NSManagedObject *object in removedObjects) {
+        if (! [self.objectSet containsObject:object]) {
+            continue;
+        }
+        
+        if (! changing && m_delegateFlags.willChange) {
+            [self.delegate liveQueryWillChangeObjects:self];
+        }
+        changing = YES;
+        
+        // Sort keys might have changed before deletion, the index cannot be found by binary search
+        NSUInteger index = [self.objects indexOfObjectIdenticalTo:object];
+        [[object retain] autorelease];
+        [self.mutableObjects removeObjectAtIndex:index];
+        [self.objectSet removeObject:object];
+        
+        if (m_delegateFlags.didRemove) {
+            [self.delegate liveQuery:self didRemoveObject:object atIndex:index];
+        }
+    }
+    
+    // Objects whose sort keys changed cannot be located by binary search while other changed objects are still at their
+    // former positions. All changed results are therefore first taken out and then inserted again into sorted results
+    NSMutableArray *updatedObjects = [NSMutableArray array];
+    NSMutableArray *insertedObjects = [NSMutableArray array];
+    for (NSManagedObject *object in changedObjects) {
+        // Instances of sub-entities are results as well
+        if (! [[object entity] isKindOfEntity:self.entityDescription]) {
+            continue;
+        }
+        
+        BOOL matching = ! self.predicate || [self.predicate evaluateWithObject:object];
+        BOOL contained = [self.objectSet containsObject:object];
+        if (! matching && ! contained) {
+            continue;
+        }
+        
+        if (! changing && m_delegateFlags.willChange) {
+            [self.delegate liveQueryWillChangeObjects:self];
+        }
+        changing = YES;
+        
+        if (matching && ! contained) {
+            [insertedObjects addObject:object];
+        }
+        else if (! matching && contained) {
+            NSUInteger index = [self.objects indexOfObjectIdenticalTo:object];
+            [[object retain] autorelease];
+            [self.mutableObjects removeObjectAtIndex:index];
+            [self.objectSet removeObject:object];
+            
+            if (m_delegateFlags.didRemove) {
+                [self.delegate liveQuery:self didRemoveObject:object atIndex:index];
+            }
+        }
+        else if ([self.sortDescriptors count] == 0) {
+            if (m_delegateFlags.didUpdate) {
+                [self.delegate liveQuery:self didUpdateObject:object atIndex:[self.objects indexOfObjectIdenticalTo:object]];
+            }
+        }
+        else {
+            [updatedObjects addObject:object];
+        }
+    }
+    
+    if ([updatedObjects count] != 0) {
+        // Results as seen by the delegate, which must stay consistent with the moves reported so far
+        NSMutableArray *reportedObjects = [NSMutableArray arrayWithArray:self.objects];
+        for (NSManagedObject *object in updatedObjects) {
+            [self.mutableObjects removeObjectAtIndex:[self.objects indexOfObjectIdenticalTo:object]];
+        }
+        
+        for (NSManagedObject *object in updatedObjects) {
+            NSUInteger fromIndex = [reportedObjects indexOfObjectIdenticalTo:object];
+            [reportedObjects removeObjectAtIndex:fromIndex];
+            
+            NSUInteger index = [self insertionIndexForObject:object];
+            [self.mutableObjects insertObject:object atIndex:index];
+            
+            // Objects not inserted again yet might still be found in the reported results. Insert right after the
+            // preceding object so that the reported results end up identical to the sorted ones
+            NSUInteger toIndex = 0;
+            if (index != 0) {
+                toIndex = [reportedObjects indexOfObjectIdenticalTo:[self.objects objectAtIndex:index - 1]] + 1;
+            }
+            [reportedObjects insertObject:object atIndex:toIndex];
+            
+            if (fromIndex == toIndex) {
+                if (m_delegateFlags.didUpdate) {
+                    [self.delegate liveQuery:self didUpdateObject:object atIndex:toIndex];
+                }
+            }
+            else {
+                if (m_delegateFlags.didMove) {
+                    [self.delegate liveQuery:self didMoveObject:object fromIndex:fromIndex toIndex:toIndex];
+                }
+            }
+        }
+    }
+    
+    for (NSManagedObject *object in insertedObjects) {
+        NSUInteger index = [self insertionIndexForObject:object];
+        [self.mutableObjects insertObject:object atIndex:index];
+        [self.objectSet addObject:object];
+        
+        if (m_delegateFlags.didInsert) {
+            [self.delegate liveQuery:self didInsertObject:object atIndex:index];
+        }
+    }
+    
+    if (changing && m_delegateFlags.didChange) {
+        [self.delegate liveQueryDidChangeObjects:self];
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; entity: %@; predicate: %@; count: %d>",
+            [self class],
+            self,
+            [self.entityDescription name],
+            self.predicate,
+            [self.objects count]];
+}
+
+@end
+
+#pragma mark Static functions
+
+// Compare two objects using a list of sort descriptors (the first one deciding)
+static NSComparisonResult HLSLiveQueryCompareObjects(id object1, id object2, NSArray *sortDescriptors)
+{
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors) {
+        NSComparisonResult result = [sortDescriptor compareObject:object1 toObject:object2];
+        if (result != NSOrderedSame) {
+            return result;
+        }
+    }
+    return NSOrderedSame;
+}
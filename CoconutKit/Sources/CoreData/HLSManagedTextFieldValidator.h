@@ -22,6 +22,10 @@
     NSFormatter *m_formatter;
     id<HLSTextFieldValidationDelegate> m_validationDelegate;
     BOOL m_checkingOnChange;
+    NSTimeInterval m_checkingOnChangeDelay;
+    NSRegularExpression *m_inputRegularExpression;
+    NSString *m_pendingText;
+    BOOL m_batchChecking;
 }
 
 /**
@@ -34,12 +38,40 @@
               formatter:(NSFormatter *)formatter
      validationDelegate:(id<HLSTextFieldValidationDelegate>)validationDelegate;
 
+/**
+ * The managed object and field the text field is bound to
+ */
+@property (nonatomic, readonly, retain) NSManagedObject *managedObject;
+@property (nonatomic, readonly, retain) NSString *fieldName;
+
 /**
  * If set to YES, validation is also called during input.
  * Default value is NO
  */
 @property (nonatomic, assign, getter=isCheckingOnChange) BOOL checkingOnChange;
 
+/**
+ * When checking on change, the delay after the last change before the value is formatted and validated. Changes
+ * made in between are coalesced, only the latest text is checked. Set to 0 to check at each change
+ * Default value is 0.3
+ */
+@property (nonatomic, assign) NSTimeInterval checkingOnChangeDelay;
+
+/**
+ * When checking on change, an optional regular expression which the whole text must match. It is checked immediately
+ * at each change, and formatting is reported as failed right away if the text does not match (no further formatting
+ * or validation is then made for this change). Empty text is always considered to match
+ * Default value is nil
+ */
+@property (nonatomic, retain) NSRegularExpression *inputRegularExpression;
+
+/**
+ * Set to YES while the field is validated as part of a batch (see -[UIView checkTextFieldsInBatch:]). Changes made to
+ * the managed object field value then only update the text field, validation results being reported by the batch
+ * using -reportValidationResult:error:
+ */
+@property (nonatomic, assign, getter=isBatchChecking) BOOL batchChecking;
+
 /**
  * Formats string and returns it by reference in pValue (must not be NULL). Returns YES iff successful
  */
@@ -50,9 +82,19 @@
  */
 - (void)setValue:(id)value;
 
+/**
+ * Notify the validation delegate about the result of a validation performed for the field
+ */
+- (void)reportValidationResult:(BOOL)valid error:(NSError *)error;
+
 /**
  * Check the value currently displayed by the text field. Returns YES iff valid
  */
 - (BOOL)checkDisplayedValue;
 
+/**
+ * Cancel the check scheduled during input (if any)
+ */
+- (void)cancelPendingCheck;
+
 @end
@@ -10,10 +10,14 @@
 
 #import "HLSAssert.h"
 #import "HLSError.h"
+#import "HLSFloat.h"
 #import "HLSLogger.h"
 #import "NSManagedObject+HLSValidation.h"
 #import "NSObject+HLSExtensions.h"
 
+// Default delay after the last change before checking on change
+static const NSTimeInterval kManagedTextFieldValidatorDefaultCheckingOnChangeDelay = 0.3;
+
 // This implementation has been swizzled in UITextField+HLSValidation.m
 extern void (*UITextField__setText_Imp)(id, SEL, id);
 
@@ -23,8 +27,11 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
 @property (nonatomic, retain) NSString *fieldName;
 @property (nonatomic, retain) NSFormatter *formatter;
 @property (nonatomic, assign) id<HLSTextFieldValidationDelegate> validationDelegate;
+@property (nonatomic, retain) NSString *pendingText;
 
 - (BOOL)checkValue:(id)value;
+- (BOOL)matchesInputRegularExpression:(NSString *)text;
+- (void)checkPendingText;
 - (void)synchronizeTextField;
 
 @end
@@ -68,6 +75,7 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
         self.fieldName = fieldName;
         self.formatter = formatter;
         self.validationDelegate = validationDelegate;
+        self.checkingOnChangeDelay = kManagedTextFieldValidatorDefaultCheckingOnChangeDelay;
         
         // Perform initial synchronization of the text field with the model object field value
         [self synchronizeTextField];
@@ -89,6 +97,8 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
     self.fieldName = nil;
     self.formatter = nil;
     self.validationDelegate = nil;
+    self.inputRegularExpression = nil;
+    self.pendingText = nil;
     
     [super dealloc];
 }
@@ -105,6 +115,14 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
 
 @synthesize checkingOnChange = m_checkingOnChange;
 
+@synthesize checkingOnChangeDelay = m_checkingOnChangeDelay;
+
+@synthesize inputRegularExpression = m_inputRegularExpression;
+
+@synthesize pendingText = m_pendingText;
+
+@synthesize batchChecking = m_batchChecking;
+
 #pragma mark UITextFieldDelegate protocol implementation
 
 - (BOOL)textField:(UITextField *)textField shouldChangeCharactersInRange:(NSRange)range replacementString:(NSString *)string
@@ -115,10 +133,26 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
     
     // Check when typing?
     if (self.checkingOnChange) {
-        id value = nil;
+        [self cancelPendingCheck];
+        
         NSString *updatedText = [textField.text stringByReplacingCharactersInRange:range withString:string];
-        if ([self getValue:&value forString:updatedText]) {
-            [self checkValue:value];
+        
+        // Cheap syntactic check first. Formatting and validation can be expensive and are not worth it if it fails
+        if (! [self matchesInputRegularExpression:updatedText]) {
+            HLSLoggerDebug(@"Input does not match the expected pattern for field %@", self.fieldName);
+            if ([self.validationDelegate respondsToSelector:@selector(textFieldDidFailFormatting:)]) {
+                [self.validationDelegate textFieldDidFailFormatting:self.textField];
+            }
+        }
+        else {
+            // Only check the latest text once the user pauses typing
+            self.pendingText = updatedText;
+            if (doubleeq(self.checkingOnChangeDelay, 0.)) {
+                [self checkPendingText];
+            }
+            else {
+                [self performSelector:@selector(checkPendingText) withObject:nil afterDelay:self.checkingOnChangeDelay];
+            }
         }
         
         // The model is not updated here. It will be when input mode is exited
@@ -127,6 +161,14 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
     return YES;
 }
 
+- (void)textFieldDidEndEditing:(UITextField *)textField
+{
+    // The value is checked when the model is updated. No need to check pending input anymore
+    [self cancelPendingCheck];
+    
+    [super textFieldDidEndEditing:textField];
+}
+
 #pragma mark Sync and check
 
 // Does not return nil on failure, but a BOOL. nil could namely be a valid value
@@ -173,22 +215,58 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
 - (BOOL)checkValue:(id)value
 {
     NSError *error = nil;
-    if ([self.managedObject checkValue:value forKey:self.fieldName error:&error]) {
+    BOOL valid = [self.managedObject checkValue:value forKey:self.fieldName error:&error];
+    [self reportValidationResult:valid error:error];
+    return valid;
+}
+
+- (void)reportValidationResult:(BOOL)valid error:(NSError *)error
+{
+    if (valid) {
         if ([self.validationDelegate respondsToSelector:@selector(textFieldDidPassValidation:)]) {
-            HLSLoggerDebug(@"Value %@ for field %@ is valid", value, self.fieldName);
+            HLSLoggerDebug(@"Value for field %@ is valid", self.fieldName);
             [self.validationDelegate textFieldDidPassValidation:self.textField];
         }
-        return YES;
     }
     else {
         if ([self.validationDelegate respondsToSelector:@selector(textField:didFailValidationWithError:)]) {
-            HLSLoggerDebug(@"Value %@ for field %@ is invalid", value, self.fieldName);
+            HLSLoggerDebug(@"Value for field %@ is invalid", self.fieldName);
             [self.validationDelegate textField:self.textField didFailValidationWithError:error];
         }
-        return NO;
     }
 }
 
+- (BOOL)matchesInputRegularExpression:(NSString *)text
+{
+    if (! self.inputRegularExpression || [text length] == 0) {
+        return YES;
+    }
+    
+    NSRange matchRange = [self.inputRegularExpression rangeOfFirstMatchInString:text 
+                                                                        options:NSMatchingAnchored 
+                                                                          range:NSMakeRange(0, [text length])];
+    return matchRange.location == 0 && matchRange.length == [text length];
+}
+
+- (void)checkPendingText
+{
+    if (! self.pendingText) {
+        return;
+    }
+    
+    id value = nil;
+    if ([self getValue:&value forString:self.pendingText]) {
+        [self checkValue:value];
+    }
+    self.pendingText = nil;
+}
+
+- (void)cancelPendingCheck
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(checkPendingText) object:nil];
+    self.pendingText = nil;
+}
+
 - (BOOL)checkDisplayedValue
 {
     id value = nil;
@@ -229,9 +307,11 @@ extern void (*UITextField__setText_Imp)(id, SEL, id);
 - (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
 {
     // Every time the value of the model object field changes, we want to trigger validation to update the text field
-    // accordingly
-    id newValue = [object valueForKey:keyPath];
-    [self checkValue:newValue];
+    // accordingly. When checking in batch, the batch reports the validation results itself
+    if (! self.batchChecking) {
+        id newValue = [object valueForKey:keyPath];
+        [self checkValue:newValue];
+    }
     
     // The value might have been changed programmatically. Be sure to update the text field text in all cases to take
     // this fact into account
@@ -0,0 +1,30 @@
+//
+//  HLSModelManager+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Interface meant to be used by friend classes of HLSModelManager (= classes which must have access to private 
+ * implementation details)
+ */
+@interface HLSModelManager (Friend)
+
+/**
+ * Execute a fetch request, count the objects it matches, or save a context. When instrumentation is enabled (see
+ * +setInstrumentationEnabled:), the operation is timed and recorded for the calling site. If the predicate of the 
+ * request has been created from a named template, pass its name as predicateTemplateName (otherwise nil, a template
+ * is then derived from the predicate itself)
+ */
++ (NSArray *)executeFetchRequest:(NSFetchRequest *)fetchRequest
+           predicateTemplateName:(NSString *)predicateTemplateName
+          inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                           error:(NSError **)pError;
++ (NSUInteger)countForFetchRequest:(NSFetchRequest *)fetchRequest
+            inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                             error:(NSError **)pError;
++ (BOOL)saveManagedObjectContext:(NSManagedObjectContext *)managedObjectContext error:(NSError **)pError;
+
+@end
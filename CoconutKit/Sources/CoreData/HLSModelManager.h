@@ -6,11 +6,48 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+#import "HLSSQLiteStoreOptions.h"
+
 // Standard option combinations
 #define HLSModelManagerLightweightMigrationOptions          [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithBool:YES], NSMigratePersistentStoresAutomaticallyOption,   \
                                                                                                        [NSNumber numberWithBool:YES], NSInferMappingModelAutomaticallyOption,         \
                                                                                                        nil]
 
+// Forward declarations
+@class HLSTaskGroup;
+
+/**
+ * Stages of a streaming store migration (see -migrationTaskGroupToURL:withStoreType:batchSize:)
+ */
+typedef enum {
+    HLSModelManagerMigrationStageEnumBegin = 0,
+    HLSModelManagerMigrationStageCopyingObjects = HLSModelManagerMigrationStageEnumBegin,       // Copying the objects of an entity
+    HLSModelManagerMigrationStageCopyingRelationships,                                          // Restoring the relationships of an entity
+    HLSModelManagerMigrationStageFinishing,                                                     // Finalizing the destination store
+    HLSModelManagerMigrationStageEnumEnd,
+    HLSModelManagerMigrationStageEnumSize = HLSModelManagerMigrationStageEnumEnd - HLSModelManagerMigrationStageEnumBegin
+} HLSModelManagerMigrationStage;
+
+/**
+ * Keys of the userInfo dictionary of the tasks making up a streaming store migration
+ *   - HLSModelManagerMigrationStageKey: NSNumber wrapping the HLSModelManagerMigrationStage of the task
+ *   - HLSModelManagerMigrationEntityNameKey: Name of the entity processed by the task (not available when finishing)
+ */
+extern NSString * const HLSModelManagerMigrationStageKey;
+extern NSString * const HLSModelManagerMigrationEntityNameKey;
+
+/**
+ * Blocks used when importing objects in the background (see -importObjects:batchSize:importBlock:completionBlock:)
+ */
+typedef void (^HLSModelManagerImportBlock)(id object, NSManagedObjectContext *managedObjectContext);
+typedef void (^HLSModelManagerImportCompletionBlock)(NSError *error);
+
+/**
+ * Block called when a store has been prewarmed (see +prewarmSQLiteStoreWithModelFileName:inBundle:configuration:
+ * storeDirectory:options:completionBlock:)
+ */
+typedef void (^HLSModelManagerPrewarmCompletionBlock)(BOOL success);
+
 /**
  * A model manager is a lightweight wrapper around a Core Data managed object context, eliminating most of the 
  * usual boilerplate you have to write when creating stores and contexts, and providing some additional convenience 
@@ -48,12 +85,16 @@
     NSManagedObjectModel *_managedObjectModel;
     NSPersistentStoreCoordinator *_persistentStoreCoordinator;
     NSManagedObjectContext *_managedObjectContext;
+    id _persistentStoreCoordinatorEntry;
 }
 
 /**
  * Create a model manager using the model file given as parameter (lookup is performed in the specified bundle,
  * or in the main bundle if nil) and saving data at the specified store path within an SQLite store (the store 
  * file name bears the model name). If the store file already exists it is reused
+ *
+ * If persistent store coordinator sharing has been enabled (see +setPersistentStoreCoordinatorSharingEnabled:), model 
+ * managers for the same file-based store share their model and persistent store coordinator
  * 
  * For information about the configuration and options parameters 
  * please refer to the documentation of
@@ -65,6 +106,17 @@
                                      storeDirectory:(NSString *)storeDirectory
                                             options:(NSDictionary *)options;
 
+/**
+ * Same as +SQLiteManagerWithModelFileName:inBundle:configuration:storeDirectory:options:, but with the SQLite store
+ * tuned using an options object (see HLSSQLiteStoreOptions). If storeOptions is nil, a default HLSSQLiteStoreOptions 
+ * object is used (tuned for write throughput)
+ */
++ (HLSModelManager *)SQLiteManagerWithModelFileName:(NSString *)modelFileName
+                                           inBundle:(NSBundle *)bundle
+                                      configuration:(NSString *)configuration
+                                     storeDirectory:(NSString *)storeDirectory
+                                       storeOptions:(HLSSQLiteStoreOptions *)storeOptions;
+
 /**
  * Create a model manager using the model file given as parameter (lookup is performed in the specified bundle,
  * or in the main bundle if nil) and saving data in-memory
@@ -92,6 +144,32 @@
                                            configuration:(NSString *)configuration 
                                           storeDirectory:(NSString *)storeDirectory
                                                  options:(NSDictionary *)options;
+/**
+ * Enable or disable persistent store coordinator sharing (disabled by default). When enabled, model managers created 
+ * for the same file-based store (SQLite or binary) with the same model, configuration and options share their model and
+ * persistent store coordinator, the store being opened only once. Each model manager has its own context, though.
+ * A coordinator is not shared anymore once its store file has been deleted. Enabling or disabling sharing does not 
+ * affect existing model managers
+ */
++ (void)setPersistentStoreCoordinatorSharingEnabled:(BOOL)persistentStoreCoordinatorSharingEnabled;
++ (BOOL)isPersistentStoreCoordinatorSharingEnabled;
+
+/**
+ * Load the model and open the SQLite store in the background, so that creating the corresponding model manager later
+ * (with the same parameters) does not block the calling thread. Usually called when the application starts. If a
+ * model manager for the store is created while prewarming is still in progress, its creation waits until prewarming
+ * is complete. The store is kept open until the first model manager using it has been created and released (it is
+ * closed if a memory warning is received before). Prewarming works whether coordinator sharing is enabled or not
+ *
+ * The completion block is called on the main thread when done
+ */
++ (void)prewarmSQLiteStoreWithModelFileName:(NSString *)modelFileName
+                                   inBundle:(NSBundle *)bundle
+                              configuration:(NSString *)configuration
+                             storeDirectory:(NSString *)storeDirectory
+                                    options:(NSDictionary *)options
+                            completionBlock:(HLSModelManagerPrewarmCompletionBlock)completionBlock;
+
 /**
  * Return the file path of the file-based store for a model, searching in a given directory. Return nil if not
  * found. You usually do not have to get this path explicitly, except e.g. if you want to cleanup a store
@@ -127,6 +205,24 @@
 + (void)rollbackCurrentModelContext;
 + (void)deleteObjectFromCurrentModelContext:(NSManagedObject *)managedObject;
 
+/**
+ * Fetch and save instrumentation (disabled by default). When enabled, the fetches, counts and aggregate queries made
+ * using the methods of NSManagedObject+HLSExtensions.h, as well as the saves made using +saveCurrentModelContext: and
+ * NSManagedObject+HLSValidation.h, are timed. Measurements are aggregated per operation, entity, predicate template 
+ * (constant values in predicates are replaced by $value) and call site (the first caller outside CoconutKit Core Data
+ * code). For each of them the report lists the number of calls, the number of objects fetched or saved, as well as the 
+ * total and maximum durations, slowest first. Many calls from the same site returning few objects each usually hint at 
+ * N+1 fetches, slow fetches for a given predicate template at missing indexes
+ *
+ * Instrumentation is meant for debugging and profiling purposes only (finding the call site is expensive). Measurements 
+ * are kept until instrumentation is reset, and can be made from any thread
+ */
++ (void)setInstrumentationEnabled:(BOOL)instrumentationEnabled;
++ (BOOL)isInstrumentationEnabled;
++ (NSString *)instrumentationReport;
++ (void)logInstrumentationReport;
++ (void)resetInstrumentation;
+
 /**
  * Create a model manager using the model file given as parameter (lookup is performed in the specified bundle,
  * or in the main bundle if nil), and saving it in the specified directory. 
@@ -148,12 +244,55 @@
              storeDirectory:(NSString *)storeDirectory
                     options:(NSDictionary *)options;
 /**
- * Duplicate an existing manager
+ * Duplicate an existing manager. The duplicate shares the model and persistent store coordinator of the receiver, 
+ * but has its own context
  */
 - (HLSModelManager *)duplicate;
 
 - (BOOL)migrateStoreToURL:(NSURL *)url withStoreType:(NSString *)storeType error:(NSError **)pError;
 
+/**
+ * Return a task group copying the store of the receiver to a new store at the specified URL, with the specified type. 
+ * Unlike -migrateStoreToURL:withStoreType:error:, the migration can be performed in the background without loading the
+ * whole store into memory, and reports its progress. Submit the task group to an HLSTaskManager and register a delegate 
+ * to be notified about its progress.
+ *
+ * The task group contains one task per migration stage, which are processed one after the other:
+ *   - one task per entity, copying its objects
+ *   - one task per entity having relationships, restoring them between the copied objects
+ *   - a final task updating the destination store metadata
+ * The userInfo dictionary of each task describes its stage (see HLSModelManagerMigrationStageKey and 
+ * HLSModelManagerMigrationEntityNameKey), so that a meaningful status can be displayed alongside the task group
+ * progress. Objects are read and written by batches of batchSize objects (0 for a default of 500), contexts being
+ * saved and reset after each batch so that memory usage stays bounded. Only object identifiers are kept between
+ * stages, for entities involved in relationships, and until the last stage restoring relationships to them.
+ *
+ * Objects are copied as they are, without calling any custom managed object code and without validation (the 
+ * contents of the source store are assumed to be valid). The receiver keeps using its store, which must not be
+ * modified while the migration is running. A store must not already exist at the destination URL. If a task fails
+ * or is cancelled, the remaining tasks are cancelled and the destination store is incomplete and must be discarded
+ */
+- (HLSTaskGroup *)migrationTaskGroupToURL:(NSURL *)url withStoreType:(NSString *)storeType batchSize:(NSUInteger)batchSize;
+
+/**
+ * Import a large number of objects in the background, without blocking the main thread and with bounded memory
+ * usage. The receiver must be a model manager whose context is used on the main thread
+ *
+ * A duplicate of the receiver is created on a background queue and pushed onto the model manager stack of the thread 
+ * the import runs on, so that the context-free methods of NSManagedObject+HLSExtensions.h can be used to create objects
+ * in its context. The import block is called once per object of the collection (e.g. raw dictionaries received from
+ * a web service), and must create or update the corresponding managed objects. Every batchSize objects (0 for a default
+ * of 500), the background context is saved, its changes are merged into the context of the receiver on the main 
+ * thread, and the background context is reset so that memory usage does not grow with the number of objects imported
+ *
+ * The completion block is called on the main thread when the import ends, with an error if a save failed (the import
+ * is then stopped, batches saved before are kept)
+ */
+- (void)importObjects:(id<NSFastEnumeration>)objects
+            batchSize:(NSUInteger)batchSize
+          importBlock:(HLSModelManagerImportBlock)importBlock
+      completionBlock:(HLSModelManagerImportCompletionBlock)completionBlock;
+
 /**
  * Access to Core Data internals
  */
@@ -8,10 +8,113 @@
 
 #import "HLSModelManager.h"
 
+#import <pthread.h>
+#import "HLSStartupReport.h"
+
+#import "HLSAllocationTracker+Friend.h"
+#import "HLSBlockTask.h"
 #import "HLSError.h"
 #import "HLSFileManager.h"
 #import "HLSLogger.h"
+#import "HLSModelManager+Friend.h"
+#import "HLSTaskGroup.h"
+#import "HLSTrace.h"
+#import "HLSTaskOperation+Protected.h"
 #import "NSArray+HLSExtensions.h"
+#import "NSDictionary+HLSExtensions.h"
+
+NSString * const HLSModelManagerMigrationStageKey = @"HLSModelManagerMigrationStageKey";
+NSString * const HLSModelManagerMigrationEntityNameKey = @"HLSModelManagerMigrationEntityNameKey";
+
+// Default number of objects imported between two saves
+static const NSUInteger kModelManagerDefaultImportBatchSize = 500;
+
+// Default number of objects migrated between two saves
+static const NSUInteger kModelManagerDefaultMigrationBatchSize = 500;
+
+typedef enum {
+    HLSModelManagerInstrumentedOperationEnumBegin = 0,
+    HLSModelManagerInstrumentedOperationFetch = HLSModelManagerInstrumentedOperationEnumBegin,
+    HLSModelManagerInstrumentedOperationCount,
+    HLSModelManagerInstrumentedOperationSave,
+    HLSModelManagerInstrumentedOperationEnumEnd,
+    HLSModelManagerInstrumentedOperationEnumSize = HLSModelManagerInstrumentedOperationEnumEnd - HLSModelManagerInstrumentedOperationEnumBegin
+} HLSModelManagerInstrumentedOperation;
+
+static volatile BOOL s_instrumentationEnabled = NO;
+static volatile BOOL s_persistentStoreCoordinatorSharingEnabled = NO;
+
+// Thread-specific slot caching the model manager at the top of the stack of the current thread (not retained, the
+// stack keeps it alive)
+static pthread_key_t s_currentModelManagerKey;
+
+/**
+ * Measurements aggregated for an operation, an entity, a predicate template and a call site
+ */
+@interface HLSModelManagerInstrumentationRecord : NSObject {
+@private
+    HLSModelManagerInstrumentedOperation m_operation;
+    NSString *m_entityName;
+    NSString *m_predicateTemplate;
+    NSString *m_callSite;
+    NSUInteger m_numberOfCalls;
+    NSUInteger m_numberOfObjects;
+    NSUInteger m_numberOfInsertedObjects;
+    NSUInteger m_numberOfUpdatedObjects;
+    NSUInteger m_numberOfDeletedObjects;
+    NSTimeInterval m_totalDuration;
+    NSTimeInterval m_maximumDuration;
+}
+
+- (id)initWithOperation:(HLSModelManagerInstrumentedOperation)operation
+             entityName:(NSString *)entityName
+      predicateTemplate:(NSString *)predicateTemplate
+               callSite:(NSString *)callSite;
+
+@property (nonatomic, readonly, assign) NSTimeInterval totalDuration;
+
+- (void)addCallWithDuration:(NSTimeInterval)duration numberOfObjects:(NSUInteger)numberOfObjects;
+- (void)addSaveWithDuration:(NSTimeInterval)duration
+    numberOfInsertedObjects:(NSUInteger)numberOfInsertedObjects
+     numberOfUpdatedObjects:(NSUInteger)numberOfUpdatedObjects
+     numberOfDeletedObjects:(NSUInteger)numberOfDeletedObjects;
+
+@end
+
+/**
+ * Persistent store coordinator of a file-based store, shared by the model managers using it if registered. Use 
+ * counts must only be accessed from the store queue
+ */
+@interface HLSPersistentStoreCoordinatorEntry : NSObject {
+@private
+    NSPersistentStoreCoordinator *m_persistentStoreCoordinator;
+    NSString *m_storeKey;
+    NSUInteger m_useCount;
+    BOOL m_prewarmed;
+}
+
+@property (nonatomic, retain) NSPersistentStoreCoordinator *persistentStoreCoordinator;
+@property (nonatomic, retain) HLSPersistentStoreCoordinatorEntry *persistentStoreCoordinatorEntry;
+@property (nonatomic, assign) NSUInteger useCount;
+@property (nonatomic, assign, getter=isPrewarmed) BOOL prewarmed;
+
+@end
+
+// Static functions
+static dispatch_queue_t HLSModelManagerImportQueue(void);
+static dispatch_queue_t HLSModelManagerStoreQueue(void);
+static NSMutableDictionary *HLSModelManagerPersistentStoreCoordinatorEntries(void);
+static NSString *HLSModelManagerCanonicalDescription(id object);
+static NSMutableDictionary *HLSModelManagerInstrumentationRecords(void);
+static HLSModelManagerInstrumentationRecord *HLSModelManagerInstrumentationRecordForFetchRequest(HLSModelManagerInstrumentedOperation operation,
+                                                                                                 NSFetchRequest *fetchRequest,
+                                                                                                 NSString *predicateTemplateName);
+static HLSModelManagerInstrumentationRecord *HLSModelManagerInstrumentationRecordWithKey(HLSModelManagerInstrumentedOperation operation,
+                                                                                         NSString *entityName,
+                                                                                         NSString *predicateTemplate);
+static NSString *HLSModelManagerInstrumentationCallSite(void);
+static NSPredicate *HLSTemplatePredicate(NSPredicate *predicate);
+static NSExpression *HLSTemplateExpression(NSExpression *expression);
 
 @interface HLSModelManager ()
 
@@ -26,21 +129,96 @@
 @property (nonatomic, retain) NSManagedObjectModel *managedObjectModel;
 @property (nonatomic, retain) NSPersistentStoreCoordinator *persistentStoreCoordinator;
 @property (nonatomic, retain) NSManagedObjectContext *managedObjectContext;
+@property (nonatomic, retain) NSString *storeKey;
 
-- (NSManagedObjectModel *)managedObjectModelFromModelFileName:(NSString *)modelFileName inBundle:(NSBundle *)bundle;
-- (NSPersistentStoreCoordinator *)persistentStoreCoordinatorForManagedObjectModel:(NSManagedObjectModel *)managedObjectModel
++ (NSManagedObjectModel *)managedObjectModelFromModelFileName:(NSString *)modelFileName inBundle:(NSBundle *)bundle;
++ (NSPersistentStoreCoordinator *)persistentStoreCoordinatorForManagedObjectModel:(NSManagedObjectModel *)managedObjectModel
                                                                         storeType:(NSString *)storeType 
                                                                     configuration:(NSString *)configuration 
                                                                               URL:(NSURL *)storeURL 
                                                                           options:(NSDictionary *)options;
++ (NSPersistentStoreCoordinator *)persistentStoreCoordinatorWithModelFileName:(NSString *)modelFileName
+                                                                     inBundle:(NSBundle *)bundle
+                                                                    storeType:(NSString *)storeType 
+                                                                configuration:(NSString *)configuration 
+                                                                          URL:(NSURL *)storeURL 
+                                                                      options:(NSDictionary *)options;
++ (NSString *)storeKeyForModelFileName:(NSString *)modelFileName
+                               inBundle:(NSBundle *)bundle
+                              storeType:(NSString *)storeType
+                          configuration:(NSString *)configuration
+                                    URL:(NSURL *)storeURL
+                                options:(NSDictionary *)options;
++ (HLSPersistentStoreCoordinatorEntry *)retainPersistentStoreCoordinatorEntryWithModelFileName:(NSString *)modelFileName
+                                                                                      inBundle:(NSBundle *)bundle
+                                                                                     storeType:(NSString *)storeType 
+                                                                                 configuration:(NSString *)configuration 
+                                                                                           URL:(NSURL *)storeURL 
+                                                                                       options:(NSDictionary *)options
+                                                                                    prewarming:(BOOL)prewarming;
++ (void)releasePersistentStoreCoordinatorEntry:(HLSPersistentStoreCoordinatorEntry *)entry;
++ (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
 - (NSManagedObjectContext *)managedObjectContextForPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)persistentStoreCoordinator;
 
+- (void)importContextDidSave:(NSNotification *)notification;
+
+@end
+
+/**
+ * State shared by the tasks of a streaming store migration. Tasks are processed one after the other, the state is
+ * therefore never accessed concurrently
+ */
+@interface HLSStoreMigration : NSObject {
+@private
+    NSPersistentStoreCoordinator *m_sourcePersistentStoreCoordinator;
+    NSManagedObjectModel *m_managedObjectModel;
+    NSPersistentStoreCoordinator *m_destinationPersistentStoreCoordinator;
+    NSURL *m_destinationURL;
+    NSString *m_destinationStoreType;
+    NSUInteger m_batchSize;
+    NSMutableDictionary *m_entityNameToObjectIDMapMap;
+    NSCountedSet *m_pendingMappedEntityNames;
+}
+
+- (id)initWithSourcePersistentStoreCoordinator:(NSPersistentStoreCoordinator *)sourcePersistentStoreCoordinator
+                                destinationURL:(NSURL *)destinationURL
+                          destinationStoreType:(NSString *)destinationStoreType
+                                     batchSize:(NSUInteger)batchSize;
+
+- (BOOL)copyObjectsOfEntity:(NSEntityDescription *)entityDescription withOperation:(HLSTaskOperation *)operation error:(NSError **)pError;
+- (BOOL)copyRelationshipsOfEntity:(NSEntityDescription *)entityDescription withOperation:(HLSTaskOperation *)operation error:(NSError **)pError;
+- (BOOL)finish:(NSError **)pError;
+
 @end
 
 @implementation HLSModelManager
 
 #pragma mark Class methods
 
++ (void)initialize
+{
+    if (self != [HLSModelManager class]) {
+        return;
+    }
+    
+    pthread_key_create(&s_currentModelManagerKey, NULL);
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+}
+
++ (void)setPersistentStoreCoordinatorSharingEnabled:(BOOL)persistentStoreCoordinatorSharingEnabled
+{
+    s_persistentStoreCoordinatorSharingEnabled = persistentStoreCoordinatorSharingEnabled;
+}
+
++ (BOOL)isPersistentStoreCoordinatorSharingEnabled
+{
+    return s_persistentStoreCoordinatorSharingEnabled;
+}
+
 + (HLSModelManager *)SQLiteManagerWithModelFileName:(NSString *)modelFileName
                                            inBundle:(NSBundle *)bundle
                                       configuration:(NSString *)configuration
@@ -55,6 +233,23 @@
                                                 options:options] autorelease];
 }
 
++ (HLSModelManager *)SQLiteManagerWithModelFileName:(NSString *)modelFileName
+                                           inBundle:(NSBundle *)bundle
+                                      configuration:(NSString *)configuration
+                                     storeDirectory:(NSString *)storeDirectory
+                                       storeOptions:(HLSSQLiteStoreOptions *)storeOptions
+{
+    if (! storeOptions) {
+        storeOptions = [[[HLSSQLiteStoreOptions alloc] init] autorelease];
+    }
+    
+    return [self SQLiteManagerWithModelFileName:modelFileName
+                                       inBundle:bundle
+                                  configuration:configuration
+                                 storeDirectory:storeDirectory
+                                        options:[storeOptions dictionary]];
+}
+
 + (HLSModelManager *)inMemoryModelManagerWithModelFileName:(NSString *)modelFileName
                                                   inBundle:(NSBundle *)bundle
                                              configuration:(NSString *)configuration 
@@ -82,6 +277,43 @@
                                                 options:options] autorelease];
 }
 
++ (void)prewarmSQLiteStoreWithModelFileName:(NSString *)modelFileName
+                                   inBundle:(NSBundle *)bundle
+                              configuration:(NSString *)configuration
+                             storeDirectory:(NSString *)storeDirectory
+                                    options:(NSDictionary *)options
+                            completionBlock:(HLSModelManagerPrewarmCompletionBlock)completionBlock
+{
+    if (! storeDirectory) {
+        HLSLoggerError(@"Missing store directory");
+        return;
+    }
+    
+    NSString *storeFilePath = [self standardStoreFilePathForModelFileName:modelFileName
+                                                                storeType:NSSQLiteStoreType
+                                                           storeDirectory:storeDirectory];
+    NSURL *storeURL = [NSURL fileURLWithPath:storeFilePath];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        
+        HLSPersistentStoreCoordinatorEntry *entry = [self retainPersistentStoreCoordinatorEntryWithModelFileName:modelFileName
+                                                                                                        inBundle:bundle
+                                                                                                       storeType:NSSQLiteStoreType
+                                                                                                   configuration:configuration
+                                                                                                             URL:storeURL
+                                                                                                         options:options
+                                                                                                      prewarming:YES];
+        BOOL success = (entry != nil);
+        if (completionBlock) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completionBlock(success);
+            });
+        }
+        
+        [pool drain];
+    });
+}
+
 + (NSString *)storeFilePathForModelFileName:(NSString *)modelFileName storeDirectory:(NSString *)storeDirectory
 {
     HLSFileManager *fileManager = [HLSFileManager defaultManager];
@@ -134,6 +366,7 @@
     
     NSMutableArray *modelManagerStack = [self modelManagerStackForThread:[NSThread currentThread]];
     [modelManagerStack addObject:modelManager];
+    pthread_setspecific(s_currentModelManagerKey, modelManager);
 }
 
 + (void)popModelManager
@@ -145,6 +378,7 @@
     }
     
     [modelManagerStack removeLastObject];
+    pthread_setspecific(s_currentModelManagerKey, [modelManagerStack lastObject]);
 }
 
 + (NSMutableArray *)modelManagerStackForThread:(NSThread *)thread
@@ -161,7 +395,9 @@
 
 + (HLSModelManager *)currentModelManager
 {
-    return [self currentModelManagerForThread:[NSThread currentThread]];
+    // Stacks are only altered by their own thread. The cached value is therefore always up to date, and avoids 
+    // a thread dictionary lookup
+    return (HLSModelManager *)pthread_getspecific(s_currentModelManagerKey);
 }
 
 + (HLSModelManager *)currentModelManagerForMainThread
@@ -171,6 +407,10 @@
 
 + (HLSModelManager *)currentModelManagerForThread:(NSThread *)thread
 {
+    if (thread == [NSThread currentThread]) {
+        return [self currentModelManager];
+    }
+    
     NSMutableArray *modelManagerStack = [self modelManagerStackForThread:thread];
     return [modelManagerStack lastObject];
 }
@@ -208,7 +448,7 @@
         return NO;
     }
     
-    return [currentModelContext save:pError];
+    return [self saveManagedObjectContext:currentModelContext error:pError];
 }
 
 + (void)rollbackCurrentModelContext
@@ -233,6 +473,116 @@
     [currentModelContext deleteObject:managedObject];
 }
 
++ (void)setInstrumentationEnabled:(BOOL)instrumentationEnabled
+{
+    s_instrumentationEnabled = instrumentationEnabled;
+}
+
++ (BOOL)isInstrumentationEnabled
+{
+    return s_instrumentationEnabled;
+}
+
++ (NSString *)instrumentationReport
+{
+    NSMutableDictionary *records = HLSModelManagerInstrumentationRecords();
+    NSArray *sortedRecords = nil;
+    @synchronized(records) {
+        NSSortDescriptor *totalDurationSortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"totalDuration" ascending:NO];
+        sortedRecords = [[records allValues] sortedArrayUsingDescriptors:[NSArray arrayWithObject:totalDurationSortDescriptor]];
+        
+        // Records are mutable. Extract their descriptions while locked
+        sortedRecords = [sortedRecords valueForKey:@"description"];
+    }
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"Core Data instrumentation report (%u entries)", [sortedRecords count]];
+    for (NSString *recordDescription in sortedRecords) {
+        [report appendFormat:@"\n  %@", recordDescription];
+    }
+    return [NSString stringWithString:report];
+}
+
++ (void)logInstrumentationReport
+{
+    HLSLoggerInfo(@"%@", [self instrumentationReport]);
+}
+
++ (void)resetInstrumentation
+{
+    NSMutableDictionary *records = HLSModelManagerInstrumentationRecords();
+    @synchronized(records) {
+        [records removeAllObjects];
+    }
+}
+
+#pragma mark Instrumented operations
+
++ (NSArray *)executeFetchRequest:(NSFetchRequest *)fetchRequest
+           predicateTemplateName:(NSString *)predicateTemplateName
+          inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                           error:(NSError **)pError
+{
+    if (! s_instrumentationEnabled) {
+        return [managedObjectContext executeFetchRequest:fetchRequest error:pError];
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSArray *objects = [managedObjectContext executeFetchRequest:fetchRequest error:pError];
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+    HLSModelManagerInstrumentationRecord *record = HLSModelManagerInstrumentationRecordForFetchRequest(HLSModelManagerInstrumentedOperationFetch, 
+                                                                                                        fetchRequest, 
+                                                                                                        predicateTemplateName);
+    [record addCallWithDuration:duration numberOfObjects:[objects count]];
+    return objects;
+}
+
++ (NSUInteger)countForFetchRequest:(NSFetchRequest *)fetchRequest
+            inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                             error:(NSError **)pError
+{
+    if (! s_instrumentationEnabled) {
+        return [managedObjectContext countForFetchRequest:fetchRequest error:pError];
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSUInteger count = [managedObjectContext countForFetchRequest:fetchRequest error:pError];
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+    HLSModelManagerInstrumentationRecord *record = HLSModelManagerInstrumentationRecordForFetchRequest(HLSModelManagerInstrumentedOperationCount, 
+                                                                                                        fetchRequest, 
+                                                                                                        nil);
+    [record addCallWithDuration:duration numberOfObjects:(count != NSNotFound) ? count : 0];
+    return count;
+}
+
++ (BOOL)saveManagedObjectContext:(NSManagedObjectContext *)managedObjectContext error:(NSError **)pError
+{
+    HLSTraceIdentifier traceIdentifier = HLSTraceBegin(@"CoreData", @"Save");
+    if (! s_instrumentationEnabled) {
+        BOOL saved = [managedObjectContext save:pError];
+        HLSTraceEnd(traceIdentifier);
+        return saved;
+    }
+    
+    // Must be collected before saving
+    NSUInteger numberOfInsertedObjects = [[managedObjectContext insertedObjects] count];
+    NSUInteger numberOfUpdatedObjects = [[managedObjectContext updatedObjects] count];
+    NSUInteger numberOfDeletedObjects = [[managedObjectContext deletedObjects] count];
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    BOOL saved = [managedObjectContext save:pError];
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+    HLSModelManagerInstrumentationRecord *record = HLSModelManagerInstrumentationRecordWithKey(HLSModelManagerInstrumentedOperationSave, nil, nil);
+    [record addSaveWithDuration:duration 
+        numberOfInsertedObjects:numberOfInsertedObjects 
+         numberOfUpdatedObjects:numberOfUpdatedObjects 
+         numberOfDeletedObjects:numberOfDeletedObjects];
+    HLSTraceEnd(traceIdentifier);
+    return saved;
+}
+
 #pragma mark Object creation and destruction
 
 - (id)initWithModelFileName:(NSString *)modelFileName
@@ -243,11 +593,7 @@
                     options:(NSDictionary *)options
 {
     if ((self = [super init])) {
-        self.managedObjectModel = [self managedObjectModelFromModelFileName:modelFileName inBundle:bundle];
-        if (! self.managedObjectModel) {
-            [self release];
-            return nil;
-        }
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
         
         NSURL *standardStoreURL = nil;
         if (storeDirectory) {
@@ -256,21 +602,41 @@
                                                                                       storeDirectory:storeDirectory];
             standardStoreURL = [NSURL fileURLWithPath:standardStoreFilePath];            
         }
-        self.persistentStoreCoordinator = [self persistentStoreCoordinatorForManagedObjectModel:self.managedObjectModel 
-                                                                                      storeType:storeType 
-                                                                                  configuration:configuration
-                                                                                            URL:standardStoreURL
-                                                                                        options:options];
+        
+        // Only file-based stores can be shared or prewarmed. Other stores (e.g. in-memory ones) are not
+        if (standardStoreURL) {
+            self.persistentStoreCoordinatorEntry = [HLSModelManager retainPersistentStoreCoordinatorEntryWithModelFileName:modelFileName
+                                                                                                                  inBundle:bundle
+                                                                                                                 storeType:storeType
+                                                                                                             configuration:configuration
+                                                                                                                       URL:standardStoreURL
+                                                                                                                   options:options
+                                                                                                                prewarming:NO];
+            self.persistentStoreCoordinator = self.persistentStoreCoordinatorEntry.persistentStoreCoordinator;
+        }
+        else {
+            self.persistentStoreCoordinator = [HLSModelManager persistentStoreCoordinatorWithModelFileName:modelFileName
+                                                                                                  inBundle:bundle
+                                                                                                 storeType:storeType
+                                                                                             configuration:configuration
+                                                                                                       URL:nil
+                                                                                                   options:options];
+        }
         if (! self.persistentStoreCoordinator) {
             [self release];
             return nil;
         }
         
+        self.managedObjectModel = [self.persistentStoreCoordinator managedObjectModel];
+        
         self.managedObjectContext = [self managedObjectContextForPersistentStoreCoordinator:self.persistentStoreCoordinator];
         if (! self.managedObjectContext) {
             [self release];
             return nil;
         }
+        
+        NSString *featureName = [NSString stringWithFormat:@"HLSModelManager (%@)", modelFileName];
+        HLSStartupReportRecord([featureName UTF8String], startTime);
     }
     return self;
 }
@@ -281,6 +647,11 @@
     self.persistentStoreCoordinator = nil;
     self.managedObjectContext = nil;
     
+    if (self.persistentStoreCoordinatorEntry) {
+        [HLSModelManager releasePersistentStoreCoordinatorEntry:self.persistentStoreCoordinatorEntry];
+    }
+    self.persistentStoreCoordinatorEntry = nil;
+    
     [super dealloc];
 }
 
@@ -292,9 +663,11 @@
 
 @synthesize managedObjectContext = _managedObjectContext;
 
+@synthesize persistentStoreCoordinatorEntry = _persistentStoreCoordinatorEntry;
+
 #pragma mark Initialization
 
-- (NSManagedObjectModel *)managedObjectModelFromModelFileName:(NSString *)modelFileName inBundle:(NSBundle *)bundle
++ (NSManagedObjectModel *)managedObjectModelFromModelFileName:(NSString *)modelFileName inBundle:(NSBundle *)bundle
 {
     if (! bundle) {
         bundle = [NSBundle mainBundle];
@@ -310,7 +683,7 @@
     return [[[NSManagedObjectModel alloc] initWithContentsOfURL:modelFileURL] autorelease];
 }
 
-- (NSPersistentStoreCoordinator *)persistentStoreCoordinatorForManagedObjectModel:(NSManagedObjectModel *)managedObjectModel
++ (NSPersistentStoreCoordinator *)persistentStoreCoordinatorForManagedObjectModel:(NSManagedObjectModel *)managedObjectModel
                                                                         storeType:(NSString *)storeType 
                                                                     configuration:(NSString *)configuration 
                                                                               URL:(NSURL *)storeURL 
@@ -346,6 +719,155 @@
     return persistentStoreCoordinator;
 }
 
++ (NSPersistentStoreCoordinator *)persistentStoreCoordinatorWithModelFileName:(NSString *)modelFileName
+                                                                     inBundle:(NSBundle *)bundle
+                                                                    storeType:(NSString *)storeType 
+                                                                configuration:(NSString *)configuration 
+                                                                          URL:(NSURL *)storeURL 
+                                                                      options:(NSDictionary *)options
+{
+    NSManagedObjectModel *managedObjectModel = [self managedObjectModelFromModelFileName:modelFileName inBundle:bundle];
+    if (! managedObjectModel) {
+        return nil;
+    }
+    
+    return [self persistentStoreCoordinatorForManagedObjectModel:managedObjectModel
+                                                       storeType:storeType
+                                                   configuration:configuration
+                                                             URL:storeURL
+                                                         options:options];
+}
+
+// Stores opened with different options (or a different model) cannot share their coordinator
++ (NSString *)storeKeyForModelFileName:(NSString *)modelFileName
+                               inBundle:(NSBundle *)bundle
+                              storeType:(NSString *)storeType
+                          configuration:(NSString *)configuration
+                                    URL:(NSURL *)storeURL
+                                options:(NSDictionary *)options
+{
+    return [NSString stringWithFormat:@"%@|%@|%@|%@|%@|%@",
+            [[storeURL URLByStandardizingPath] absoluteString],
+            storeType,
+            configuration ? configuration : @"",
+            HLSModelManagerCanonicalDescription(options),
+            [(bundle ? bundle : [NSBundle mainBundle]) bundlePath],
+            modelFileName];
+}
+
+// Return the persistent store coordinator entry for a file-based store, opening the store if needed. Each successful
+// call must be balanced with a call to +releasePersistentStoreCoordinatorEntry:, except when prewarming: The prewarming 
+// reference is then transferred to the first model manager using the store. Entries are only registered (and therefore
+// shared) when prewarming or if sharing is enabled. A prewarmed entry is unregistered when handed over to a model
+// manager if sharing is disabled
++ (HLSPersistentStoreCoordinatorEntry *)retainPersistentStoreCoordinatorEntryWithModelFileName:(NSString *)modelFileName
+                                                                                      inBundle:(NSBundle *)bundle
+                                                                                     storeType:(NSString *)storeType 
+                                                                                 configuration:(NSString *)configuration 
+                                                                                           URL:(NSURL *)storeURL 
+                                                                                       options:(NSDictionary *)options
+                                                                                    prewarming:(BOOL)prewarming
+{
+    NSString *storeKey = [self storeKeyForModelFileName:modelFileName
+                                               inBundle:bundle
+                                              storeType:storeType
+                                          configuration:configuration
+                                                    URL:storeURL
+                                                options:options];
+    BOOL sharing = s_persistentStoreCoordinatorSharingEnabled;
+    
+    // Stores are opened one at a time on a serial queue. A store being prewarmed is therefore never opened twice
+    __block HLSPersistentStoreCoordinatorEntry *entry = nil;
+    dispatch_sync(HLSModelManagerStoreQueue(), ^{
+        NSMutableDictionary *entries = HLSModelManagerPersistentStoreCoordinatorEntries();
+        HLSPersistentStoreCoordinatorEntry *registeredEntry = [entries objectForKey:storeKey];
+        
+        // The store file has been deleted since the entry was registered. Model managers still using the entry keep it,
+        // but it must not be handed out anymore
+        if (registeredEntry && ! [[HLSFileManager defaultManager] fileExistsAtPath:[storeURL path]]) {
+            HLSLoggerInfo(@"The store at %@ has been deleted. Its coordinator is not reused", storeURL);
+            [entries removeObjectForKey:storeKey];
+            registeredEntry = nil;
+        }
+        
+        if (registeredEntry) {
+            if (prewarming) {
+                // Already open. Nothing to do
+                entry = [registeredEntry retain];
+                return;
+            }
+            else if (registeredEntry.prewarmed) {
+                registeredEntry.prewarmed = NO;
+                if (! sharing) {
+                    [entries removeObjectForKey:storeKey];
+                }
+                entry = [registeredEntry retain];
+                return;
+            }
+            else if (sharing) {
+                ++registeredEntry.useCount;
+                entry = [registeredEntry retain];
+                return;
+            }
+        }
+        
+        NSPersistentStoreCoordinator *persistentStoreCoordinator = [self persistentStoreCoordinatorWithModelFileName:modelFileName
+                                                                                                            inBundle:bundle
+                                                                                                           storeType:storeType
+                                                                                                       configuration:configuration
+                                                                                                                 URL:storeURL
+                                                                                                             options:options];
+        if (! persistentStoreCoordinator) {
+            return;
+        }
+        
+        entry = [[HLSPersistentStoreCoordinatorEntry alloc] init];
+        entry.persistentStoreCoordinator = persistentStoreCoordinator;
+        entry.storeKey = storeKey;
+        entry.useCount = 1;
+        entry.prewarmed = prewarming;
+        
+        // Never replace an entry still in use when sharing is disabled
+        if ((prewarming || sharing) && ! registeredEntry) {
+            [entries setObject:entry forKey:storeKey];
+        }
+    });
+    return [entry autorelease];
+}
+
++ (void)releasePersistentStoreCoordinatorEntry:(HLSPersistentStoreCoordinatorEntry *)entry
+{
+    // Model managers can be released from any thread
+    dispatch_async(HLSModelManagerStoreQueue(), ^{
+        --entry.useCount;
+        if (entry.useCount != 0) {
+            return;
+        }
+        
+        // The entry might have been unregistered or replaced in the meantime
+        NSMutableDictionary *entries = HLSModelManagerPersistentStoreCoordinatorEntries();
+        if ([entries objectForKey:entry.storeKey] == entry) {
+            [entries removeObjectForKey:entry.storeKey];
+        }
+    });
+}
+
+#pragma mark Notification callbacks
+
+// Prewarmed stores which have not been used yet are closed. They will be opened again when needed
++ (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    dispatch_async(HLSModelManagerStoreQueue(), ^{
+        NSMutableDictionary *entries = HLSModelManagerPersistentStoreCoordinatorEntries();
+        for (NSString *storeKey in [entries allKeys]) {
+            HLSPersistentStoreCoordinatorEntry *entry = [entries objectForKey:storeKey];
+            if (entry.prewarmed) {
+                [entries removeObjectForKey:storeKey];
+            }
+        }
+    });
+}
+
 - (NSManagedObjectContext *)managedObjectContextForPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)persistentStoreCoordinator
 {
     NSManagedObjectContext *managedObjectContext = [[[NSManagedObjectContext alloc] init] autorelease];
@@ -364,6 +886,15 @@
     modelManager.managedObjectModel = self.managedObjectModel;
     modelManager.persistentStoreCoordinator = self.persistentStoreCoordinator;
     
+    // The duplicate must keep the coordinator entry alive as well
+    if (self.persistentStoreCoordinatorEntry) {
+        HLSPersistentStoreCoordinatorEntry *entry = self.persistentStoreCoordinatorEntry;
+        dispatch_sync(HLSModelManagerStoreQueue(), ^{
+            ++entry.useCount;
+        });
+        modelManager.persistentStoreCoordinatorEntry = entry;
+    }
+    
     return modelManager;
 }
 
@@ -373,4 +904,888 @@
     return [self.persistentStoreCoordinator migratePersistentStore:persistentStore toURL:url options:nil withType:storeType error:pError] != nil;
 }
 
+- (HLSTaskGroup *)migrationTaskGroupToURL:(NSURL *)url withStoreType:(NSString *)storeType batchSize:(NSUInteger)batchSize
+{
+    if (! url || ! storeType) {
+        HLSLoggerError(@"A destination URL and a store type are mandatory");
+        return nil;
+    }
+    
+    if ([url isFileURL] && [[HLSFileManager defaultManager] fileExistsAtPath:[url path]]) {
+        HLSLoggerError(@"A store already exists at %@", url);
+        return nil;
+    }
+    
+    HLSStoreMigration *storeMigration = [[[HLSStoreMigration alloc] initWithSourcePersistentStoreCoordinator:self.persistentStoreCoordinator
+                                                                                              destinationURL:url
+                                                                                        destinationStoreType:storeType
+                                                                                                   batchSize:batchSize] autorelease];
+    
+    HLSTaskGroup *taskGroup = [[[HLSTaskGroup alloc] init] autorelease];
+    NSMutableArray *tasks = [NSMutableArray array];
+    
+    // Abstract entities have no instances of their own
+    NSMutableArray *entityDescriptions = [NSMutableArray array];
+    for (NSEntityDescription *entityDescription in [self.managedObjectModel entities]) {
+        if (! [entityDescription isAbstract]) {
+            [entityDescriptions addObject:entityDescription];
+        }
+    }
+    
+    for (NSEntityDescription *entityDescription in entityDescriptions) {
+        HLSBlockTask *task = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+            return [storeMigration copyObjectsOfEntity:entityDescription withOperation:operation error:pError] ? (id)kCFBooleanTrue : nil;
+        }];
+        task.userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInt:HLSModelManagerMigrationStageCopyingObjects], HLSModelManagerMigrationStageKey,
+                         [entityDescription name], HLSModelManagerMigrationEntityNameKey, nil];
+        [tasks addObject:task];
+    }
+    
+    for (NSEntityDescription *entityDescription in entityDescriptions) {
+        if ([[entityDescription relationshipsByName] count] == 0) {
+            continue;
+        }
+        
+        HLSBlockTask *task = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+            return [storeMigration copyRelationshipsOfEntity:entityDescription withOperation:operation error:pError] ? (id)kCFBooleanTrue : nil;
+        }];
+        task.userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInt:HLSModelManagerMigrationStageCopyingRelationships], HLSModelManagerMigrationStageKey,
+                         [entityDescription name], HLSModelManagerMigrationEntityNameKey, nil];
+        [tasks addObject:task];
+    }
+    
+    HLSBlockTask *finishingTask = [HLSBlockTask taskWithBlock:^(HLSTaskOperation *operation, NSError **pError) {
+        return [storeMigration finish:pError] ? (id)kCFBooleanTrue : nil;
+    }];
+    finishingTask.userInfo = [NSDictionary dictionaryWithObject:[NSNumber numberWithInt:HLSModelManagerMigrationStageFinishing] 
+                                                         forKey:HLSModelManagerMigrationStageKey];
+    [tasks addObject:finishingTask];
+    
+    // Process stages one after the other. A failure cancels all remaining stages
+    HLSTask *previousTask = nil;
+    for (HLSTask *task in tasks) {
+        [taskGroup addTask:task];
+        if (previousTask) {
+            [taskGroup addDependencyForTask:task onTask:previousTask strong:YES];
+        }
+        previousTask = task;
+    }
+    
+    return taskGroup;
+}
+
+#pragma mark Background import
+
+- (void)importObjects:(id<NSFastEnumeration>)objects
+            batchSize:(NSUInteger)batchSize
+          importBlock:(HLSModelManagerImportBlock)importBlock
+      completionBlock:(HLSModelManagerImportCompletionBlock)completionBlock
+{
+    if (! importBlock) {
+        HLSLoggerError(@"Missing import block");
+        return;
+    }
+    
+    if (batchSize == 0) {
+        batchSize = kModelManagerDefaultImportBatchSize;
+    }
+    
+    importBlock = [[importBlock copy] autorelease];
+    completionBlock = [[completionBlock copy] autorelease];
+    dispatch_async(HLSModelManagerImportQueue(), ^{
+        // Contexts must be created on the thread they are used on
+        HLSModelManager *importModelManager = [self duplicate];
+        NSManagedObjectContext *importContext = importModelManager.managedObjectContext;
+        
+        // Undo information is useless here, and would otherwise grow with the number of objects imported
+        [importContext setUndoManager:nil];
+        
+        [HLSModelManager pushModelManager:importModelManager];
+        [[NSNotificationCenter defaultCenter] addObserver:self 
+                                                 selector:@selector(importContextDidSave:) 
+                                                     name:NSManagedObjectContextDidSaveNotification 
+                                                   object:importContext];
+        
+        NSError *error = nil;
+        NSUInteger numberOfPendingObjects = 0;
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        for (id object in objects) {
+            importBlock(object, importContext);
+            ++numberOfPendingObjects;
+            
+            if (numberOfPendingObjects == batchSize) {
+                if (! [importContext save:&error]) {
+                    // The error belongs to the pool, keep it
+                    [error retain];
+                    break;
+                }
+                
+                // Turn saved objects into faults and release memory
+                [importContext reset];
+                numberOfPendingObjects = 0;
+                
+                HLSAutoreleasePoolPop(pool);
+                pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+            }
+        }
+        
+        if (! error && numberOfPendingObjects != 0) {
+            if (! [importContext save:&error]) {
+                [error retain];
+            }
+        }
+        HLSAutoreleasePoolPop(pool);
+        
+        [[NSNotificationCenter defaultCenter] removeObserver:self 
+                                                        name:NSManagedObjectContextDidSaveNotification 
+                                                      object:importContext];
+        [HLSModelManager popModelManager];
+        
+        if (error) {
+            HLSLoggerError(@"Import failed. Reason: %@", [error localizedDescription]);
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completionBlock) {
+                completionBlock(error);
+            }
+            [error release];
+        });
+    });
+}
+
+- (void)importContextDidSave:(NSNotification *)notification
+{
+    // Merge synchronously, before the import context is reset and its objects invalidated
+    dispatch_sync(dispatch_get_main_queue(), ^{
+        [self.managedObjectContext mergeChangesFromContextDidSaveNotification:notification];
+    });
+}
+
 @end
+
+static dispatch_queue_t HLSModelManagerImportQueue(void)
+{
+    // Serial, so that imports do not compete for the persistent store coordinator
+    static dispatch_queue_t s_queue = NULL;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.hortis.CoconutKit.modelImport", NULL);
+        dispatch_set_target_queue(s_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+    });
+    return s_queue;
+}
+
+#pragma mark -
+#pragma mark HLSStoreMigration class implementation
+
+@implementation HLSStoreMigration
+
+#pragma mark Object creation and destruction
+
+- (id)initWithSourcePersistentStoreCoordinator:(NSPersistentStoreCoordinator *)sourcePersistentStoreCoordinator
+                                destinationURL:(NSURL *)destinationURL
+                          destinationStoreType:(NSString *)destinationStoreType
+                                     batchSize:(NSUInteger)batchSize
+{
+    if ((self = [super init])) {
+        m_sourcePersistentStoreCoordinator = [sourcePersistentStoreCoordinator retain];
+        m_managedObjectModel = [[sourcePersistentStoreCoordinator managedObjectModel] retain];
+        m_destinationURL = [destinationURL retain];
+        m_destinationStoreType = [destinationStoreType retain];
+        m_batchSize = (batchSize != 0) ? batchSize : kModelManagerDefaultMigrationBatchSize;
+        m_entityNameToObjectIDMapMap = [[NSMutableDictionary alloc] init];
+        
+        // Source to destination object identifiers only need to be kept for entities whose objects are involved in
+        // relationships, and only until the last relationship stage which needs them has been processed
+        m_pendingMappedEntityNames = [[NSCountedSet alloc] init];
+        for (NSEntityDescription *entityDescription in [m_managedObjectModel entities]) {
+            NSArray *relationshipDescriptions = [self restoredRelationshipDescriptionsForEntity:entityDescription];
+            if ([entityDescription isAbstract] || [relationshipDescriptions count] == 0) {
+                continue;
+            }
+            
+            NSMutableSet *mappedEntityNames = [NSMutableSet setWithArray:[self entityNamesForEntity:entityDescription]];
+            for (NSRelationshipDescription *relationshipDescription in relationshipDescriptions) {
+                [mappedEntityNames addObjectsFromArray:[self entityNamesForEntity:[relationshipDescription destinationEntity]]];
+            }
+            for (NSString *entityName in mappedEntityNames) {
+                [m_pendingMappedEntityNames addObject:entityName];
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_sourcePersistentStoreCoordinator release];
+    [m_managedObjectModel release];
+    [m_destinationPersistentStoreCoordinator release];
+    [m_destinationURL release];
+    [m_destinationStoreType release];
+    [m_entityNameToObjectIDMapMap release];
+    [m_pendingMappedEntityNames release];
+    
+    [super dealloc];
+}
+
+#pragma mark Contexts
+
+/**
+ * The destination store is created with a relaxed copy of the model: Objects are copied before their relationships 
+ * can be restored, they must therefore be saved without being validated. Plain managed objects are used so that no 
+ * custom code gets called. The store metadata is updated to match the original model when the migration ends
+ */
+- (NSManagedObjectContext *)destinationManagedObjectContext:(NSError **)pError
+{
+    if (! m_destinationPersistentStoreCoordinator) {
+        NSManagedObjectModel *relaxedManagedObjectModel = [[m_managedObjectModel copy] autorelease];
+        for (NSEntityDescription *entityDescription in [relaxedManagedObjectModel entities]) {
+            [entityDescription setManagedObjectClassName:NSStringFromClass([NSManagedObject class])];
+            for (NSPropertyDescription *propertyDescription in [entityDescription properties]) {
+                [propertyDescription setOptional:YES];
+                [propertyDescription setValidationPredicates:nil withValidationWarnings:nil];
+                if ([propertyDescription isKindOfClass:[NSRelationshipDescription class]]) {
+                    [(NSRelationshipDescription *)propertyDescription setMinCount:0];
+                }
+            }
+        }
+        
+        NSPersistentStoreCoordinator *destinationPersistentStoreCoordinator = [[[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:relaxedManagedObjectModel] autorelease];
+        if (! [destinationPersistentStoreCoordinator addPersistentStoreWithType:m_destinationStoreType
+                                                                  configuration:nil
+                                                                            URL:m_destinationURL
+                                                                        options:nil
+                                                                          error:pError]) {
+            return nil;
+        }
+        m_destinationPersistentStoreCoordinator = [destinationPersistentStoreCoordinator retain];
+    }
+    
+    return [self managedObjectContextForPersistentStoreCoordinator:m_destinationPersistentStoreCoordinator];
+}
+
+- (NSManagedObjectContext *)managedObjectContextForPersistentStoreCoordinator:(NSPersistentStoreCoordinator *)persistentStoreCoordinator
+{
+    // Contexts are created on the thread of the operation which uses them. Undo information is useless here
+    NSManagedObjectContext *managedObjectContext = [[[NSManagedObjectContext alloc] init] autorelease];
+    [managedObjectContext setPersistentStoreCoordinator:persistentStoreCoordinator];
+    [managedObjectContext setUndoManager:nil];
+    return managedObjectContext;
+}
+
+#pragma mark Entities
+
+// Return the names of an entity and of all its sub-entities
+- (NSArray *)entityNamesForEntity:(NSEntityDescription *)entityDescription
+{
+    NSMutableArray *entityNames = [NSMutableArray arrayWithObject:[entityDescription name]];
+    for (NSEntityDescription *subentityDescription in [entityDescription subentities]) {
+        [entityNames addObjectsFromArray:[self entityNamesForEntity:subentityDescription]];
+    }
+    return entityNames;
+}
+
+/**
+ * Return YES iff a relationship must be restored when processing the entity it belongs to. When a relationship has
+ * an inverse, only one side needs to be set (Core Data updates the other one): The to-one side if any, otherwise
+ * the side whose name comes first
+ */
+- (BOOL)isRelationshipRestored:(NSRelationshipDescription *)relationshipDescription
+{
+    NSRelationshipDescription *inverseRelationshipDescription = [relationshipDescription inverseRelationship];
+    if (! inverseRelationshipDescription) {
+        return YES;
+    }
+    
+    if ([relationshipDescription isToMany] != [inverseRelationshipDescription isToMany]) {
+        return ! [relationshipDescription isToMany];
+    }
+    
+    NSString *name = [NSString stringWithFormat:@"%@.%@", [[relationshipDescription entity] name], [relationshipDescription name]];
+    NSString *inverseName = [NSString stringWithFormat:@"%@.%@", [[inverseRelationshipDescription entity] name], [inverseRelationshipDescription name]];
+    return [name compare:inverseName] != NSOrderedDescending;
+}
+
+- (NSArray *)restoredRelationshipDescriptionsForEntity:(NSEntityDescription *)entityDescription
+{
+    NSMutableArray *relationshipDescriptions = [NSMutableArray array];
+    for (NSRelationshipDescription *relationshipDescription in [[entityDescription relationshipsByName] allValues]) {
+        if ([self isRelationshipRestored:relationshipDescription]) {
+            [relationshipDescriptions addObject:relationshipDescription];
+        }
+    }
+    return [NSArray arrayWithArray:relationshipDescriptions];
+}
+
+#pragma mark Source objects
+
+/**
+ * Return the identifiers of all objects of an entity (sub-entities being processed with their own entity), nil on
+ * failure. Batches are then fetched from this fixed list: Unlike fetch offsets, which depend on an order the store 
+ * does not guarantee between fetches, each object is processed exactly once
+ */
+- (NSArray *)sourceObjectIDsForEntity:(NSEntityDescription *)entityDescription
+                inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                                 error:(NSError **)pError
+{
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    fetchRequest.includesSubentities = NO;
+    fetchRequest.resultType = NSManagedObjectIDResultType;
+    return [managedObjectContext executeFetchRequest:fetchRequest error:pError];
+}
+
+- (NSFetchRequest *)sourceFetchRequestForEntity:(NSEntityDescription *)entityDescription objectIDs:(NSArray *)objectIDs
+{
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    fetchRequest.includesSubentities = NO;
+    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"self IN %@", objectIDs];
+    return fetchRequest;
+}
+
+#pragma mark Object identifier maps
+
+- (NSManagedObjectID *)destinationObjectIDForSourceObject:(NSManagedObject *)sourceObject
+{
+    NSManagedObjectID *sourceObjectID = [sourceObject objectID];
+    NSDictionary *objectIDMap = [m_entityNameToObjectIDMapMap objectForKey:[[sourceObjectID entity] name]];
+    return [objectIDMap objectForKey:sourceObjectID];
+}
+
+#pragma mark Migration stages
+
+- (BOOL)copyObjectsOfEntity:(NSEntityDescription *)entityDescription withOperation:(HLSTaskOperation *)operation error:(NSError **)pError
+{
+    NSManagedObjectContext *destinationContext = [self destinationManagedObjectContext:pError];
+    if (! destinationContext) {
+        return NO;
+    }
+    NSManagedObjectContext *sourceContext = [self managedObjectContextForPersistentStoreCoordinator:m_sourcePersistentStoreCoordinator];
+    
+    NSArray *sourceObjectIDs = [self sourceObjectIDsForEntity:entityDescription inManagedObjectContext:sourceContext error:pError];
+    if (! sourceObjectIDs) {
+        return NO;
+    }
+    
+    // Only keep identifiers if a relationship stage needs them
+    NSMutableDictionary *objectIDMap = nil;
+    if ([m_pendingMappedEntityNames countForObject:[entityDescription name]] != 0) {
+        objectIDMap = [NSMutableDictionary dictionaryWithCapacity:[sourceObjectIDs count]];
+        [m_entityNameToObjectIDMapMap setObject:objectIDMap forKey:[entityDescription name]];
+    }
+    
+    NSArray *attributeNames = [[entityDescription attributesByName] allKeys];
+    NSUInteger numberOfObjects = [sourceObjectIDs count];
+    NSUInteger numberOfCopiedObjects = 0;
+    BOOL success = YES;
+    while (numberOfCopiedObjects < numberOfObjects && ! [operation isCancelled]) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        
+        NSRange batchRange = NSMakeRange(numberOfCopiedObjects, MIN(m_batchSize, numberOfObjects - numberOfCopiedObjects));
+        NSFetchRequest *fetchRequest = [self sourceFetchRequestForEntity:entityDescription
+                                                               objectIDs:[sourceObjectIDs subarrayWithRange:batchRange]];
+        NSArray *sourceObjects = [sourceContext executeFetchRequest:fetchRequest error:pError];
+        if (! sourceObjects) {
+            // The error belongs to the pool, keep it
+            success = NO;
+            if (pError) {
+                [*pError retain];
+            }
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        
+        NSMutableArray *destinationObjects = [NSMutableArray arrayWithCapacity:[sourceObjects count]];
+        for (NSManagedObject *sourceObject in sourceObjects) {
+            NSManagedObject *destinationObject = [NSEntityDescription insertNewObjectForEntityForName:[entityDescription name]
+                                                                               inManagedObjectContext:destinationContext];
+            [destinationObject setValuesForKeysWithDictionary:[sourceObject dictionaryWithValuesForKeys:attributeNames]];
+            [destinationObjects addObject:destinationObject];
+        }
+        
+        // Permanent identifiers are needed to restore relationships later
+        if (! [destinationContext obtainPermanentIDsForObjects:destinationObjects error:pError]
+                || ! [destinationContext save:pError]) {
+            success = NO;
+            if (pError) {
+                [*pError retain];
+            }
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        
+        [sourceObjects enumerateObjectsUsingBlock:^(id sourceObject, NSUInteger idx, BOOL *stop) {
+            [objectIDMap setObject:[[destinationObjects objectAtIndex:idx] objectID] forKey:[sourceObject objectID]];
+        }];
+        numberOfCopiedObjects += batchRange.length;
+        
+        // Release memory before the next batch
+        [sourceContext reset];
+        [destinationContext reset];
+        HLSAutoreleasePoolPop(pool);
+        
+        [operation updateProgressToValue:(float)numberOfCopiedObjects / numberOfObjects];
+    }
+    
+    if (! success && pError) {
+        [*pError autorelease];
+    }
+    return success;
+}
+
+- (BOOL)copyRelationshipsOfEntity:(NSEntityDescription *)entityDescription withOperation:(HLSTaskOperation *)operation error:(NSError **)pError
+{
+    NSArray *relationshipDescriptions = [self restoredRelationshipDescriptionsForEntity:entityDescription];
+    if ([relationshipDescriptions count] == 0) {
+        return YES;
+    }
+    
+    NSManagedObjectContext *destinationContext = [self destinationManagedObjectContext:pError];
+    if (! destinationContext) {
+        return NO;
+    }
+    NSManagedObjectContext *sourceContext = [self managedObjectContextForPersistentStoreCoordinator:m_sourcePersistentStoreCoordinator];
+    
+    NSArray *sourceObjectIDs = [self sourceObjectIDsForEntity:entityDescription inManagedObjectContext:sourceContext error:pError];
+    if (! sourceObjectIDs) {
+        return NO;
+    }
+    
+    NSArray *relationshipNames = [relationshipDescriptions valueForKey:@"name"];
+    NSUInteger numberOfObjects = [sourceObjectIDs count];
+    NSUInteger numberOfProcessedObjects = 0;
+    NSUInteger numberOfMissingObjects = 0;
+    BOOL success = YES;
+    while (numberOfProcessedObjects < numberOfObjects && ! [operation isCancelled]) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        
+        NSRange batchRange = NSMakeRange(numberOfProcessedObjects, MIN(m_batchSize, numberOfObjects - numberOfProcessedObjects));
+        NSFetchRequest *fetchRequest = [self sourceFetchRequestForEntity:entityDescription
+                                                               objectIDs:[sourceObjectIDs subarrayWithRange:batchRange]];
+        fetchRequest.relationshipKeyPathsForPrefetching = relationshipNames;
+        NSArray *sourceObjects = [sourceContext executeFetchRequest:fetchRequest error:pError];
+        if (! sourceObjects) {
+            success = NO;
+            if (pError) {
+                [*pError retain];
+            }
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        
+        // Objects which have not been copied (e.g. inserted into the source store after their entity has been copied)
+        // are skipped, as well as relationships to them
+        for (NSManagedObject *sourceObject in sourceObjects) {
+            NSManagedObjectID *destinationObjectID = [self destinationObjectIDForSourceObject:sourceObject];
+            if (! destinationObjectID) {
+                ++numberOfMissingObjects;
+                continue;
+            }
+            
+            NSManagedObject *destinationObject = [destinationContext objectWithID:destinationObjectID];
+            for (NSRelationshipDescription *relationshipDescription in relationshipDescriptions) {
+                NSString *relationshipName = [relationshipDescription name];
+                if ([relationshipDescription isToMany]) {
+                    NSSet *sourceTargetObjects = [sourceObject valueForKey:relationshipName];
+                    if ([sourceTargetObjects count] == 0) {
+                        continue;
+                    }
+                    
+                    NSMutableSet *destinationTargetObjects = [NSMutableSet setWithCapacity:[sourceTargetObjects count]];
+                    for (NSManagedObject *sourceTargetObject in sourceTargetObjects) {
+                        NSManagedObjectID *destinationTargetObjectID = [self destinationObjectIDForSourceObject:sourceTargetObject];
+                        if (! destinationTargetObjectID) {
+                            ++numberOfMissingObjects;
+                            continue;
+                        }
+                        [destinationTargetObjects addObject:[destinationContext objectWithID:destinationTargetObjectID]];
+                    }
+                    [destinationObject setValue:destinationTargetObjects forKey:relationshipName];
+                }
+                else {
+                    NSManagedObject *sourceTargetObject = [sourceObject valueForKey:relationshipName];
+                    if (! sourceTargetObject) {
+                        continue;
+                    }
+                    
+                    NSManagedObjectID *destinationTargetObjectID = [self destinationObjectIDForSourceObject:sourceTargetObject];
+                    if (! destinationTargetObjectID) {
+                        ++numberOfMissingObjects;
+                        continue;
+                    }
+                    [destinationObject setValue:[destinationContext objectWithID:destinationTargetObjectID] forKey:relationshipName];
+                }
+            }
+        }
+        
+        if (! [destinationContext save:pError]) {
+            success = NO;
+            if (pError) {
+                [*pError retain];
+            }
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        numberOfProcessedObjects += batchRange.length;
+        
+        // Release memory before the next batch
+        [sourceContext reset];
+        [destinationContext reset];
+        HLSAutoreleasePoolPop(pool);
+        
+        [operation updateProgressToValue:(float)numberOfProcessedObjects / numberOfObjects];
+    }
+    
+    if (numberOfMissingObjects != 0) {
+        HLSLoggerWarn(@"%d objects involved in relationships of the entity %@ have not been copied. The source store has "
+                      "probably been modified during the migration", numberOfMissingObjects, [entityDescription name]);
+    }
+    
+    if (! success) {
+        if (pError) {
+            [*pError autorelease];
+        }
+        return NO;
+    }
+    
+    if ([operation isCancelled]) {
+        return YES;
+    }
+    
+    // Discard identifiers which are not needed by any remaining stage
+    NSMutableSet *mappedEntityNames = [NSMutableSet setWithArray:[self entityNamesForEntity:entityDescription]];
+    for (NSRelationshipDescription *relationshipDescription in relationshipDescriptions) {
+        [mappedEntityNames addObjectsFromArray:[self entityNamesForEntity:[relationshipDescription destinationEntity]]];
+    }
+    for (NSString *entityName in mappedEntityNames) {
+        [m_pendingMappedEntityNames removeObject:entityName];
+        if ([m_pendingMappedEntityNames countForObject:entityName] == 0) {
+            [m_entityNameToObjectIDMapMap removeObjectForKey:entityName];
+        }
+    }
+    return YES;
+}
+
+- (BOOL)finish:(NSError **)pError
+{
+    // Nothing has been migrated (no entity)
+    if (! m_destinationPersistentStoreCoordinator) {
+        return [self destinationManagedObjectContext:pError] != nil;
+    }
+    
+    // The destination store must be closed before its metadata can be updated
+    for (NSPersistentStore *persistentStore in [m_destinationPersistentStoreCoordinator persistentStores]) {
+        if (! [m_destinationPersistentStoreCoordinator removePersistentStore:persistentStore error:pError]) {
+            return NO;
+        }
+    }
+    
+    // Make the store compatible with the original model
+    NSDictionary *metadata = [NSPersistentStoreCoordinator metadataForPersistentStoreOfType:m_destinationStoreType 
+                                                                                       URL:m_destinationURL 
+                                                                                     error:pError];
+    if (! metadata) {
+        return NO;
+    }
+    metadata = [metadata dictionaryBySettingObject:[m_managedObjectModel entityVersionHashesByName] forKey:NSStoreModelVersionHashesKey];
+    return [NSPersistentStoreCoordinator setMetadata:metadata 
+                            forPersistentStoreOfType:m_destinationStoreType 
+                                                 URL:m_destinationURL 
+                                               error:pError];
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSPersistentStoreCoordinatorEntry class implementation
+
+@implementation HLSPersistentStoreCoordinatorEntry
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.persistentStoreCoordinator = nil;
+    self.storeKey = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize persistentStoreCoordinator = m_persistentStoreCoordinator;
+
+@synthesize storeKey = m_storeKey;
+
+@synthesize useCount = m_useCount;
+
+@synthesize prewarmed = m_prewarmed;
+
+@end
+
+#pragma mark -
+#pragma mark HLSModelManagerInstrumentationRecord class implementation
+
+@implementation HLSModelManagerInstrumentationRecord
+
+#pragma mark Object creation and destruction
+
+- (id)initWithOperation:(HLSModelManagerInstrumentedOperation)operation
+             entityName:(NSString *)entityName
+      predicateTemplate:(NSString *)predicateTemplate
+               callSite:(NSString *)callSite
+{
+    if ((self = [super init])) {
+        m_operation = operation;
+        m_entityName = [entityName retain];
+        m_predicateTemplate = [predicateTemplate retain];
+        m_callSite = [callSite retain];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_entityName release];
+    [m_predicateTemplate release];
+    [m_callSite release];
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize totalDuration = m_totalDuration;
+
+#pragma mark Recording
+
+// Records are shared and updated from any thread
+- (void)addCallWithDuration:(NSTimeInterval)duration numberOfObjects:(NSUInteger)numberOfObjects
+{
+    @synchronized(self) {
+        ++m_numberOfCalls;
+        m_numberOfObjects += numberOfObjects;
+        m_totalDuration += duration;
+        m_maximumDuration = MAX(m_maximumDuration, duration);
+    }
+}
+
+- (void)addSaveWithDuration:(NSTimeInterval)duration
+    numberOfInsertedObjects:(NSUInteger)numberOfInsertedObjects
+     numberOfUpdatedObjects:(NSUInteger)numberOfUpdatedObjects
+     numberOfDeletedObjects:(NSUInteger)numberOfDeletedObjects
+{
+    @synchronized(self) {
+        m_numberOfInsertedObjects += numberOfInsertedObjects;
+        m_numberOfUpdatedObjects += numberOfUpdatedObjects;
+        m_numberOfDeletedObjects += numberOfDeletedObjects;
+    }
+    [self addCallWithDuration:duration numberOfObjects:numberOfInsertedObjects + numberOfUpdatedObjects + numberOfDeletedObjects];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    @synchronized(self) {
+        NSString *durations = [NSString stringWithFormat:@"%.3f ms total, %.3f ms max", 1000. * m_totalDuration, 1000. * m_maximumDuration];
+        switch (m_operation) {
+            case HLSModelManagerInstrumentedOperationFetch: {
+                return [NSString stringWithFormat:@"fetch %@ [%@] at %@: %u calls, %u objects, %@", m_entityName, m_predicateTemplate, 
+                        m_callSite, m_numberOfCalls, m_numberOfObjects, durations];
+            }
+                
+            case HLSModelManagerInstrumentedOperationCount: {
+                return [NSString stringWithFormat:@"count %@ [%@] at %@: %u calls, %u objects, %@", m_entityName, m_predicateTemplate, 
+                        m_callSite, m_numberOfCalls, m_numberOfObjects, durations];
+            }
+                
+            case HLSModelManagerInstrumentedOperationSave: {
+                return [NSString stringWithFormat:@"save at %@: %u calls, %u inserted, %u updated, %u deleted, %@", m_callSite,
+                        m_numberOfCalls, m_numberOfInsertedObjects, m_numberOfUpdatedObjects, m_numberOfDeletedObjects, durations];
+            }
+                
+            default: {
+                HLSLoggerError(@"Unknown operation");
+                return nil;
+            }
+        }
+    }
+}
+
+@end
+
+#pragma mark Static functions
+
+// Serial queue on which persistent store coordinators are shared and stores opened
+static dispatch_queue_t HLSModelManagerStoreQueue(void)
+{
+    static dispatch_queue_t s_queue = NULL;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.hortis.CoconutKit.modelStore", NULL);
+    });
+    return s_queue;
+}
+
+// Map store keys to HLSPersistentStoreCoordinatorEntry objects. Must only be accessed from the store queue
+static NSMutableDictionary *HLSModelManagerPersistentStoreCoordinatorEntries(void)
+{
+    static NSMutableDictionary *s_entries = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_entries = [[NSMutableDictionary alloc] init];
+    });
+    return s_entries;
+}
+
+// Return a description of an object which does not depend on dictionary or set enumeration order
+static NSString *HLSModelManagerCanonicalDescription(id object)
+{
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        NSMutableArray *components = [NSMutableArray array];
+        for (id key in [[object allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+            [components addObject:[NSString stringWithFormat:@"%@=%@", key, HLSModelManagerCanonicalDescription([object objectForKey:key])]];
+        }
+        return [NSString stringWithFormat:@"{%@}", [components componentsJoinedByString:@","]];
+    }
+    else if ([object isKindOfClass:[NSSet class]]) {
+        NSMutableArray *components = [NSMutableArray array];
+        for (id element in object) {
+            [components addObject:HLSModelManagerCanonicalDescription(element)];
+        }
+        return [NSString stringWithFormat:@"(%@)", [[components sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@","]];
+    }
+    else {
+        return object ? [object description] : @"";
+    }
+}
+
+// Map keys (operation, entity name, predicate template, call site) to instrumentation records
+static NSMutableDictionary *HLSModelManagerInstrumentationRecords(void)
+{
+    static NSMutableDictionary *s_records = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_records = [[NSMutableDictionary alloc] init];
+    });
+    return s_records;
+}
+
+static HLSModelManagerInstrumentationRecord *HLSModelManagerInstrumentationRecordForFetchRequest(HLSModelManagerInstrumentedOperation operation,
+                                                                                                 NSFetchRequest *fetchRequest,
+                                                                                                 NSString *predicateTemplateName)
+{
+    NSString *predicateTemplate = nil;
+    if (predicateTemplateName) {
+        predicateTemplate = [NSString stringWithFormat:@"template %@", predicateTemplateName];
+    }
+    else if (fetchRequest.predicate) {
+        predicateTemplate = [HLSTemplatePredicate(fetchRequest.predicate) predicateFormat];
+    }
+    else {
+        predicateTemplate = @"all";
+    }
+    
+    return HLSModelManagerInstrumentationRecordWithKey(operation, [[fetchRequest entity] name], predicateTemplate);
+}
+
+static HLSModelManagerInstrumentationRecord *HLSModelManagerInstrumentationRecordWithKey(HLSModelManagerInstrumentedOperation operation,
+                                                                                         NSString *entityName,
+                                                                                         NSString *predicateTemplate)
+{
+    NSString *callSite = HLSModelManagerInstrumentationCallSite();
+    NSString *key = [NSString stringWithFormat:@"%d|%@|%@|%@", operation, entityName, predicateTemplate, callSite];
+    
+    NSMutableDictionary *records = HLSModelManagerInstrumentationRecords();
+    @synchronized(records) {
+        HLSModelManagerInstrumentationRecord *record = [records objectForKey:key];
+        if (! record) {
+            record = [[[HLSModelManagerInstrumentationRecord alloc] initWithOperation:operation
+                                                                           entityName:entityName
+                                                                    predicateTemplate:predicateTemplate
+                                                                             callSite:callSite] autorelease];
+            [records setObject:record forKey:key];
+        }
+        return record;
+    }
+}
+
+// Return the symbol of the first caller outside CoconutKit Core Data code
+static NSString *HLSModelManagerInstrumentationCallSite(void)
+{
+    for (NSString *callStackSymbol in [NSThread callStackSymbols]) {
+        // Format: <frame number> <image name> <address> <symbol> + <offset>
+        NSRange addressRange = [callStackSymbol rangeOfString:@" 0x"];
+        if (addressRange.location == NSNotFound) {
+            continue;
+        }
+        NSRange symbolStartRange = [callStackSymbol rangeOfString:@" " 
+                                                          options:0 
+                                                            range:NSMakeRange(NSMaxRange(addressRange), [callStackSymbol length] - NSMaxRange(addressRange))];
+        if (symbolStartRange.location == NSNotFound) {
+            continue;
+        }
+        NSString *symbol = [callStackSymbol substringFromIndex:NSMaxRange(symbolStartRange)];
+        NSRange offsetRange = [symbol rangeOfString:@" + " options:NSBackwardsSearch];
+        if (offsetRange.location != NSNotFound) {
+            symbol = [symbol substringToIndex:offsetRange.location];
+        }
+        
+        if ([symbol rangeOfString:@"HLSModelManager"].location != NSNotFound
+                || [symbol rangeOfString:@"(HLSExtensions)"].location != NSNotFound
+                || [symbol rangeOfString:@"(HLSValidation)"].location != NSNotFound) {
+            continue;
+        }
+        
+        return symbol;
+    }
+    return @"unknown";
+}
+
+// Replace constant values by a $value variable, so that fetches differing only by values are aggregated
+static NSPredicate *HLSTemplatePredicate(NSPredicate *predicate)
+{
+    if ([predicate isKindOfClass:[NSCompoundPredicate class]]) {
+        NSCompoundPredicate *compoundPredicate = (NSCompoundPredicate *)predicate;
+        NSMutableArray *templateSubpredicates = [NSMutableArray array];
+        for (NSPredicate *subpredicate in [compoundPredicate subpredicates]) {
+            [templateSubpredicates addObject:HLSTemplatePredicate(subpredicate)];
+        }
+        return [[[NSCompoundPredicate alloc] initWithType:[compoundPredicate compoundPredicateType] 
+                                            subpredicates:templateSubpredicates] autorelease];
+    }
+    else if ([predicate isKindOfClass:[NSComparisonPredicate class]]) {
+        NSComparisonPredicate *comparisonPredicate = (NSComparisonPredicate *)predicate;
+        NSExpression *leftTemplateExpression = HLSTemplateExpression([comparisonPredicate leftExpression]);
+        NSExpression *rightTemplateExpression = HLSTemplateExpression([comparisonPredicate rightExpression]);
+        if ([comparisonPredicate predicateOperatorType] == NSCustomSelectorPredicateOperatorType) {
+            return [NSComparisonPredicate predicateWithLeftExpression:leftTemplateExpression
+                                                      rightExpression:rightTemplateExpression
+                                                       customSelector:[comparisonPredicate customSelector]];
+        }
+        else {
+            return [NSComparisonPredicate predicateWithLeftExpression:leftTemplateExpression
+                                                      rightExpression:rightTemplateExpression
+                                                             modifier:[comparisonPredicate comparisonPredicateModifier]
+                                                                 type:[comparisonPredicate predicateOperatorType]
+                                                              options:[comparisonPredicate options]];
+        }
+    }
+    else {
+        return predicate;
+    }
+}
+
+static NSExpression *HLSTemplateExpression(NSExpression *expression)
+{
+    if ([expression expressionType] == NSConstantValueExpressionType) {
+        return [NSExpression expressionForVariable:@"value"];
+    }
+    else {
+        return expression;
+    }
+}
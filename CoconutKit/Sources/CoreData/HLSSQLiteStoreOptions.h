@@ -0,0 +1,102 @@
+//
+//  HLSSQLiteStoreOptions.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * SQLite journal modes (see http://www.sqlite.org/pragma.html#pragma_journal_mode)
+ */
+typedef enum {
+    HLSSQLiteJournalModeEnumBegin = 0,
+    HLSSQLiteJournalModeDefault = HLSSQLiteJournalModeEnumBegin,        // Keep the SQLite default
+    HLSSQLiteJournalModeDelete,
+    HLSSQLiteJournalModeTruncate,
+    HLSSQLiteJournalModePersist,
+    HLSSQLiteJournalModeWAL,                                            // Write-ahead logging
+    HLSSQLiteJournalModeEnumEnd,
+    HLSSQLiteJournalModeEnumSize = HLSSQLiteJournalModeEnumEnd - HLSSQLiteJournalModeEnumBegin
+} HLSSQLiteJournalMode;
+
+/**
+ * SQLite synchronous levels (see http://www.sqlite.org/pragma.html#pragma_synchronous)
+ */
+typedef enum {
+    HLSSQLiteSynchronousLevelEnumBegin = 0,
+    HLSSQLiteSynchronousLevelDefault = HLSSQLiteSynchronousLevelEnumBegin,      // Keep the SQLite default
+    HLSSQLiteSynchronousLevelOff,
+    HLSSQLiteSynchronousLevelNormal,
+    HLSSQLiteSynchronousLevelFull,
+    HLSSQLiteSynchronousLevelEnumEnd,
+    HLSSQLiteSynchronousLevelEnumSize = HLSSQLiteSynchronousLevelEnumEnd - HLSSQLiteSynchronousLevelEnumBegin
+} HLSSQLiteSynchronousLevel;
+
+/**
+ * Options used when opening an SQLite store with HLSModelManager (see 
+ * +SQLiteManagerWithModelFileName:inBundle:configuration:storeDirectory:storeOptions:). Instead of having to assemble
+ * the store options and SQLite pragmas dictionaries manually, simply create an options object and tune the settings
+ * you need
+ *
+ * A freshly created options object is tuned for write throughput:
+ *   - write-ahead logging, so that readers and a writer do not block each other and commits are sequential writes
+ *   - normal synchronous level, i.e. no disk synchronization at each commit (a power loss might lose the last
+ *     transactions, but never corrupts the store when using write-ahead logging)
+ *   - a page cache of 4000 pages
+ *   - automatic lightweight migration
+ * Write-ahead logging requires SQLite 3.7 (iOS 5). With older versions SQLite ignores the journal mode setting
+ * and keeps its default journal
+ *
+ * Designated initializer: -init
+ */
+@interface HLSSQLiteStoreOptions : NSObject <NSCopying> {
+@private
+    HLSSQLiteJournalMode m_journalMode;
+    HLSSQLiteSynchronousLevel m_synchronousLevel;
+    NSUInteger m_cacheSize;
+    BOOL m_migratingAutomatically;
+    BOOL m_inferringMappingModelAutomatically;
+    NSDictionary *m_additionalOptions;
+}
+
+/**
+ * Return options which leave SQLite and Core Data settings untouched
+ */
++ (HLSSQLiteStoreOptions *)defaultStoreOptions;
+
+/**
+ * Journal mode. Default value is HLSSQLiteJournalModeWAL
+ */
+@property (nonatomic, assign) HLSSQLiteJournalMode journalMode;
+
+/**
+ * Synchronous level. Default value is HLSSQLiteSynchronousLevelNormal
+ */
+@property (nonatomic, assign) HLSSQLiteSynchronousLevel synchronousLevel;
+
+/**
+ * Maximum number of database pages kept in memory by each connection (0 keeps the SQLite default). Default
+ * value is 4000
+ */
+@property (nonatomic, assign) NSUInteger cacheSize;
+
+/**
+ * Lightweight migration flags (see NSMigratePersistentStoresAutomaticallyOption and NSInferMappingModelAutomaticallyOption).
+ * Default value is YES for both
+ */
+@property (nonatomic, assign, getter=isMigratingAutomatically) BOOL migratingAutomatically;
+@property (nonatomic, assign, getter=isInferringMappingModelAutomatically) BOOL inferringMappingModelAutomatically;
+
+/**
+ * Other options to pass when adding the store (see -[NSPersistentStoreCoordinator addPersistentStoreWithType:configuration:URL:options:error:]).
+ * Options set using the properties above override those. Default value is nil
+ */
+@property (nonatomic, retain) NSDictionary *additionalOptions;
+
+/**
+ * Return the options dictionary to be used when adding the store
+ */
+- (NSDictionary *)dictionary;
+
+@end
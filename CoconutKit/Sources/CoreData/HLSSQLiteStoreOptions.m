@@ -0,0 +1,160 @@
+//
+//  HLSSQLiteStoreOptions.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSSQLiteStoreOptions.h"
+
+// Default number of pages in the page cache
+static const NSUInteger kSQLiteStoreOptionsDefaultCacheSize = 4000;
+
+@implementation HLSSQLiteStoreOptions
+
+#pragma mark Class methods
+
++ (HLSSQLiteStoreOptions *)defaultStoreOptions
+{
+    HLSSQLiteStoreOptions *storeOptions = [[[[self class] alloc] init] autorelease];
+    storeOptions.journalMode = HLSSQLiteJournalModeDefault;
+    storeOptions.synchronousLevel = HLSSQLiteSynchronousLevelDefault;
+    storeOptions.cacheSize = 0;
+    storeOptions.migratingAutomatically = NO;
+    storeOptions.inferringMappingModelAutomatically = NO;
+    return storeOptions;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        m_journalMode = HLSSQLiteJournalModeWAL;
+        m_synchronousLevel = HLSSQLiteSynchronousLevelNormal;
+        m_cacheSize = kSQLiteStoreOptionsDefaultCacheSize;
+        m_migratingAutomatically = YES;
+        m_inferringMappingModelAutomatically = YES;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.additionalOptions = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize journalMode = m_journalMode;
+
+@synthesize synchronousLevel = m_synchronousLevel;
+
+@synthesize cacheSize = m_cacheSize;
+
+@synthesize migratingAutomatically = m_migratingAutomatically;
+
+@synthesize inferringMappingModelAutomatically = m_inferringMappingModelAutomatically;
+
+@synthesize additionalOptions = m_additionalOptions;
+
+#pragma mark Options
+
+- (NSDictionary *)dictionary
+{
+    NSMutableDictionary *options = [NSMutableDictionary dictionaryWithDictionary:self.additionalOptions];
+    
+    NSMutableDictionary *pragmas = [NSMutableDictionary dictionaryWithDictionary:[options objectForKey:NSSQLitePragmasOption]];
+    switch (self.journalMode) {
+        case HLSSQLiteJournalModeDelete: {
+            [pragmas setObject:@"DELETE" forKey:@"journal_mode"];
+            break;
+        }
+            
+        case HLSSQLiteJournalModeTruncate: {
+            [pragmas setObject:@"TRUNCATE" forKey:@"journal_mode"];
+            break;
+        }
+            
+        case HLSSQLiteJournalModePersist: {
+            [pragmas setObject:@"PERSIST" forKey:@"journal_mode"];
+            break;
+        }
+            
+        case HLSSQLiteJournalModeWAL: {
+            [pragmas setObject:@"WAL" forKey:@"journal_mode"];
+            break;
+        }
+            
+        default: {
+            break;
+        }
+    }
+    
+    switch (self.synchronousLevel) {
+        case HLSSQLiteSynchronousLevelOff: {
+            [pragmas setObject:@"OFF" forKey:@"synchronous"];
+            break;
+        }
+            
+        case HLSSQLiteSynchronousLevelNormal: {
+            [pragmas setObject:@"NORMAL" forKey:@"synchronous"];
+            break;
+        }
+            
+        case HLSSQLiteSynchronousLevelFull: {
+            [pragmas setObject:@"FULL" forKey:@"synchronous"];
+            break;
+        }
+            
+        default: {
+            break;
+        }
+    }
+    
+    if (self.cacheSize != 0) {
+        [pragmas setObject:[NSString stringWithFormat:@"%u", self.cacheSize] forKey:@"cache_size"];
+    }
+    
+    if ([pragmas count] != 0) {
+        [options setObject:pragmas forKey:NSSQLitePragmasOption];
+    }
+    
+    if (self.migratingAutomatically) {
+        [options setObject:[NSNumber numberWithBool:YES] forKey:NSMigratePersistentStoresAutomaticallyOption];
+    }
+    if (self.inferringMappingModelAutomatically) {
+        [options setObject:[NSNumber numberWithBool:YES] forKey:NSInferMappingModelAutomaticallyOption];
+    }
+    
+    return [NSDictionary dictionaryWithDictionary:options];
+}
+
+#pragma mark NSCopying protocol implementation
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    HLSSQLiteStoreOptions *storeOptionsCopy = [[[self class] allocWithZone:zone] init];
+    storeOptionsCopy.journalMode = self.journalMode;
+    storeOptionsCopy.synchronousLevel = self.synchronousLevel;
+    storeOptionsCopy.cacheSize = self.cacheSize;
+    storeOptionsCopy.migratingAutomatically = self.migratingAutomatically;
+    storeOptionsCopy.inferringMappingModelAutomatically = self.inferringMappingModelAutomatically;
+    storeOptionsCopy.additionalOptions = self.additionalOptions;
+    return storeOptionsCopy;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; dictionary: %@>",
+            [self class],
+            self,
+            [self dictionary]];
+}
+
+@end
@@ -6,6 +6,27 @@
 //  Copyright (c) 2011 Hortis. All rights reserved.
 //
 
+/**
+ * Options which can be used to tune the fetch requests made by the methods below. See NSFetchRequest documentation
+ * for more information
+ *   - HLSFetchBatchSizeOption: Number (NSUInteger) of objects fetched at a time. Other objects are returned as
+ *                              faults and fetched in batches when accessed (ideal for long table views)
+ *   - HLSFetchReturnsObjectsAsFaultsOption: Boolean NSNumber. Set it to NO if you know that you will access the 
+ *                                           properties of all returned objects
+ *   - HLSFetchRelationshipKeyPathsForPrefetchingOption: Array of relationship key paths whose objects must be fetched
+ *                                                       together with the returned objects
+ *   - HLSFetchPropertiesToFetchOption: Array of property names (or NSPropertyDescription objects) to fetch. Mandatory
+ *                                      when fetching dictionaries
+ *   - HLSFetchResultTypeOption: NSNumber wrapping an NSFetchRequestResultType. Use NSDictionaryResultType to get
+ *                               dictionaries containing only the properties to fetch, NSManagedObjectIDResultType to
+ *                               only get object identifiers
+ */
+extern NSString * const HLSFetchBatchSizeOption;
+extern NSString * const HLSFetchReturnsObjectsAsFaultsOption;
+extern NSString * const HLSFetchRelationshipKeyPathsForPrefetchingOption;
+extern NSString * const HLSFetchPropertiesToFetchOption;
+extern NSString * const HLSFetchResultTypeOption;
+
 /**
  * Convenience methods to perform common Core Data operations on managed objects. Most methods appear in two versions:
  *   - a version expecting a managed object context parameter:  
@@ -40,6 +61,39 @@
 + (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
                      sortedUsingDescriptor:(NSSortDescriptor *)sortDescriptor;
 
+/**
+ * Same as above, but with fetch options (see above for available options)
+ */
++ (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
+                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                   options:(NSDictionary *)options
+                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
+                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                   options:(NSDictionary *)options;
+
+/**
+ * Register a predicate template under a given name. Predicate templates are parsed once, and can then be used by name
+ * in queries (see below), binding variables (written $VARIABLE in the format string) to values at each call. This
+ * avoids parsing the same format string each time a query is made. Templates are shared by all entities, and 
+ * registering a template with an existing name replaces the previous one
+ */
++ (void)registerPredicateTemplateWithFormat:(NSString *)format name:(NSString *)name;
+
+/**
+ * When called on an NSManagedObject subclass, query instances of it matching a registered predicate template 
+ * (see above), whose variables are replaced by the values found in the substitution variables dictionary (keys are 
+ * variable names without the $ sign). Fetch requests are cached for each entity and template, so that only variable 
+ * substitution is performed per call. Without context parameter, the current HLSModelManager context is used
+ */
++ (NSArray *)filteredObjectsUsingPredicateTemplateWithName:(NSString *)name
+                                     substitutionVariables:(NSDictionary *)substitutionVariables
+                                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (NSArray *)filteredObjectsUsingPredicateTemplateWithName:(NSString *)name
+                                     substitutionVariables:(NSDictionary *)substitutionVariables
+                                    sortedUsingDescriptors:(NSArray *)sortDescriptors;
+
 /**
  * When called on an NSManagedObject subclass, query all instances of it, sorting them using the specified descriptors
  * (without context parameter, the current HLSModelManager context is used)
@@ -52,6 +106,15 @@
                       inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
 + (NSArray *)allObjectsSortedUsingDescriptor:(NSSortDescriptor *)sortDescriptor;
 
+/**
+ * Same as above, but with fetch options (see above for available options)
+ */
++ (NSArray *)allObjectsSortedUsingDescriptors:(NSArray *)sortDescriptors
+                                      options:(NSDictionary *)options
+                       inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (NSArray *)allObjectsSortedUsingDescriptors:(NSArray *)sortDescriptors
+                                      options:(NSDictionary *)options;
+
 /**
  * When called on an NSManagedObject subclass, query all instances of it, without predictable ordering (without context 
  * parameter, the current HLSModelManager context is used)
@@ -59,13 +122,100 @@
 + (NSArray *)allObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
 + (NSArray *)allObjects;
 
+/**
+ * When called on an NSManagedObject subclass, count its instances matching a predicate (a nil predicate counts all
+ * instances). Counting is performed by the store, without fetching any object. Without context parameter, the current
+ * HLSModelManager context is used. Return NSNotFound if an error occurred
+ */
++ (NSUInteger)countOfObjectsUsingPredicate:(NSPredicate *)predicate
+                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (NSUInteger)countOfObjectsUsingPredicate:(NSPredicate *)predicate;
+
+/**
+ * When called on an NSManagedObject subclass, compute the sum, minimum or maximum of an attribute over all instances
+ * matching a predicate (a nil predicate means all instances). The values are computed by the store without fetching
+ * any object, but for this reason only saved changes are taken into account. Without context parameter, the current 
+ * HLSModelManager context is used.
+ *
+ * The key must be the name of an attribute of the entity. Sums are returned as NSNumber (integer sums as 64-bit 
+ * integers), minimum and maximum values with the type of the attribute (e.g. NSDate for a date attribute). Return 
+ * nil if an error occurred or if no minimum or maximum value exists
+ */
++ (NSNumber *)sumOfValuesForKey:(NSString *)key
+                 usingPredicate:(NSPredicate *)predicate
+         inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (NSNumber *)sumOfValuesForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate;
+
++ (id)minimumValueForKey:(NSString *)key
+          usingPredicate:(NSPredicate *)predicate
+  inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (id)minimumValueForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate;
+
++ (id)maximumValueForKey:(NSString *)key
+          usingPredicate:(NSPredicate *)predicate
+  inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (id)maximumValueForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate;
+
 /**
  * When called on an NSManagedObject subclass, deletes all of its instances (without context parameter, the current 
- * HLSModelManager context is used)
+ * HLSModelManager context is used). Only object identifiers are fetched, but deleted objects stay in the context 
+ * until you save it
  */
 + (void)deleteAllObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
 + (void)deleteAllObjects;
 
+/**
+ * When called on an NSManagedObject subclass, deletes all of its instances by batches of the specified size (without 
+ * context parameter, the current HLSModelManager context is used). Only object identifiers are fetched, and the context
+ * is saved and reset after each batch so that memory consumption does not grow with the number of objects. Use this
+ * method to wipe out large entities
+ *
+ * Since the context is saved and reset, any pending change it contains is saved as well, and all objects previously 
+ * fetched from it are invalidated. You should therefore use a dedicated context (e.g. the one of a duplicated model 
+ * manager, see -[HLSModelManager duplicate]). If batchSize is 0, a default size of 500 is used
+ *
+ * Return YES iff successful, NO otherwise (in which case the corresponding error is returned, and the objects of
+ * batches saved before the error occurred remain deleted)
+ */
++ (BOOL)deleteAllObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                                     batchSize:(NSUInteger)batchSize
+                                         error:(NSError **)pError;
++ (BOOL)deleteAllObjectsWithBatchSize:(NSUInteger)batchSize error:(NSError **)pError;
+
+/**
+ * When called on an NSManagedObject subclass, return the instance whose attribute for the specified key has the given
+ * value, or nil if none. The key must be an attribute whose values are unique (e.g. a server identifier). Without
+ * context parameter, the current HLSModelManager context is used.
+ *
+ * Lookups go through an identity cache attached to the context. The first lookup for a value fetches the matching
+ * object, later lookups are answered from memory (including when no object was found). The cache is kept up to date 
+ * when objects are inserted into, updated in or deleted from the context, and emptied when the context is reset. Call
+ * +cacheObjectsWithValues:forKey: first when looking up many values, e.g. when synchronizing records received from
+ * a server: All matching objects are fetched at once, and the lookups which follow do not hit the store anymore
+ */
++ (id)cachedObjectWithValue:(id)value
+                     forKey:(NSString *)key
+     inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (id)cachedObjectWithValue:(id)value forKey:(NSString *)key;
+
+/**
+ * When called on an NSManagedObject subclass, fetch the instances whose attribute for the specified key has one of
+ * the given values, and add them to the identity cache of the context (see +cachedObjectWithValue:forKey:). Values 
+ * not matching any object are cached as well. Without context parameter, the current HLSModelManager context is used
+ */
++ (void)cacheObjectsWithValues:(NSArray *)values
+                        forKey:(NSString *)key
+        inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (void)cacheObjectsWithValues:(NSArray *)values forKey:(NSString *)key;
+
+/**
+ * Empty the identity cache of a context (without context parameter, the current HLSModelManager context is used). 
+ * Cached objects are retained until then, you should therefore clear the cache when you are done with a large
+ * number of lookups
+ */
++ (void)clearObjectCacheInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (void)clearObjectCache;
+
 /**
  * Create a copy of the receiver if it implements the HLSManagedObjectCopying protocol. The copy is created in the same
  * managed object context which the receiver belongs to. If the receiver does not implement the HLSManagedObjectCopying
@@ -78,6 +228,9 @@
  *   - for relationships, a shallow copy is performed, except if the relationship corresponds to ownership of one
  *     or more objects also implementing the HLSManagedObjectCopying protocol (ownership is assumed when the relationship
  *     deletion behavior is set to cascade)
+ *   - objects reachable several times within the duplicated graph are duplicated only once, and non-owned objects 
+ *     which have been duplicated as part of the graph (e.g. the owner referenced by an inverse relationship) are 
+ *     replaced with their copies
  *
  * After the method successfully returns an object, you must still commit the changes by calling -save: on the
  * managed object context in which it was created.
@@ -8,12 +8,89 @@
 
 #import "NSManagedObject+HLSExtensions.h"
 
+#import <objc/runtime.h>
+
+#import "HLSAllocationTracker+Friend.h"
 #import "HLSAssert.h"
 #import "HLSLogger.h"
 #import "HLSManagedObjectCopying.h"
 #import "HLSModelManager.h"
+#import "HLSModelManager+Friend.h"
 #import "NSObject+HLSExtensions.h"
 
+NSString * const HLSFetchBatchSizeOption = @"HLSFetchBatchSizeOption";
+NSString * const HLSFetchReturnsObjectsAsFaultsOption = @"HLSFetchReturnsObjectsAsFaultsOption";
+NSString * const HLSFetchRelationshipKeyPathsForPrefetchingOption = @"HLSFetchRelationshipKeyPathsForPrefetchingOption";
+NSString * const HLSFetchPropertiesToFetchOption = @"HLSFetchPropertiesToFetchOption";
+NSString * const HLSFetchResultTypeOption = @"HLSFetchResultTypeOption";
+
+static const NSUInteger kDeleteDefaultBatchSize = 500;
+
+// Maximum number of values in a single IN predicate (SQLite limits the number of variables in a statement)
+static const NSUInteger kCacheFetchMaximumNumberOfValues = 500;
+
+// Associated object keys
+static void *s_templateFetchRequestsKey = &s_templateFetchRequestsKey;
+static void *s_duplicationInfoKey = &s_duplicationInfoKey;
+static void *s_objectCacheKey = &s_objectCacheKey;
+
+/**
+ * Properties of an entity which must be considered when duplicating its instances. Computed once per entity
+ */
+@interface HLSEntityDuplicationInfo : NSObject {
+@private
+    NSArray *m_attributeNames;
+    NSArray *m_relationshipDescriptions;
+}
+
+- (id)initWithEntityDescription:(NSEntityDescription *)entityDescription;
+
+@property (nonatomic, readonly, retain) NSArray *attributeNames;
+@property (nonatomic, readonly, retain) NSArray *relationshipDescriptions;
+
+@end
+
+/**
+ * Identity cache of a managed object context, mapping unique attribute values to objects, for each entity and key.
+ * Objects not found are mapped to NSNull. The cache is owned by its context and, like it, must be used from a 
+ * single thread
+ */
+@interface HLSManagedObjectCache : NSObject {
+@private
+    NSManagedObjectContext *m_managedObjectContext;         // weak ref, the context owns the cache
+    NSMutableDictionary *m_entityNameToKeyToObjectMaps;
+}
+
+- (id)initWithManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+
+- (NSMutableDictionary *)objectMapForEntity:(NSEntityDescription *)entityDescription key:(NSString *)key;
+- (void)removeAllObjects;
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification;
+
+@end
+
+// Static functions
+static NSMutableDictionary *HLSPredicateTemplates(void);
+static HLSEntityDuplicationInfo *HLSDuplicationInfoForEntity(NSEntityDescription *entityDescription);
+static HLSManagedObjectCache *HLSManagedObjectCacheForContext(NSManagedObjectContext *managedObjectContext, BOOL create);
+
+@interface NSManagedObject (HLSExtensionsPrivate)
+
++ (NSFetchRequest *)templateFetchRequestWithPredicateTemplateName:(NSString *)name
+                                            inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
++ (id)aggregateValueWithFunctionName:(NSString *)functionName
+                              forKey:(NSString *)key
+                      usingPredicate:(NSPredicate *)predicate
+              inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext;
+
+- (id)duplicateWithIdentityMap:(CFMutableDictionaryRef)identityMap
+               originalObjects:(NSMutableArray *)originalObjects
+            relationshipValues:(NSMutableArray *)relationshipValues;
+- (void)setDuplicateRelationshipValues:(NSDictionary *)relationshipValues withIdentityMap:(CFDictionaryRef)identityMap;
+
+@end
+
 @implementation NSManagedObject (HLSExtensions)
 
 #pragma mark Class methods
@@ -32,6 +109,17 @@
 + (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
                     sortedUsingDescriptors:(NSArray *)sortDescriptors
                     inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    return [self filteredObjectsUsingPredicate:predicate 
+                        sortedUsingDescriptors:sortDescriptors 
+                                       options:nil 
+                        inManagedObjectContext:managedObjectContext];
+}
+
++ (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
+                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                   options:(NSDictionary *)options
+                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
 {
     HLSAssertObjectsInEnumerationAreKindOfClass(sortDescriptors, NSSortDescriptor);
     if (! managedObjectContext) {
@@ -46,8 +134,35 @@
     fetchRequest.sortDescriptors = sortDescriptors;
     fetchRequest.predicate = predicate;
     
+    NSNumber *fetchBatchSizeNumber = [options objectForKey:HLSFetchBatchSizeOption];
+    if (fetchBatchSizeNumber) {
+        fetchRequest.fetchBatchSize = [fetchBatchSizeNumber unsignedIntegerValue];
+    }
+    NSNumber *returnsObjectsAsFaultsNumber = [options objectForKey:HLSFetchReturnsObjectsAsFaultsOption];
+    if (returnsObjectsAsFaultsNumber) {
+        fetchRequest.returnsObjectsAsFaults = [returnsObjectsAsFaultsNumber boolValue];
+    }
+    NSArray *relationshipKeyPathsForPrefetching = [options objectForKey:HLSFetchRelationshipKeyPathsForPrefetchingOption];
+    if (relationshipKeyPathsForPrefetching) {
+        fetchRequest.relationshipKeyPathsForPrefetching = relationshipKeyPathsForPrefetching;
+    }
+    NSArray *propertiesToFetch = [options objectForKey:HLSFetchPropertiesToFetchOption];
+    if (propertiesToFetch) {
+        fetchRequest.propertiesToFetch = propertiesToFetch;
+    }
+    NSNumber *resultTypeNumber = [options objectForKey:HLSFetchResultTypeOption];
+    if (resultTypeNumber) {
+        fetchRequest.resultType = [resultTypeNumber unsignedIntegerValue];
+        if (fetchRequest.resultType == NSDictionaryResultType && ! propertiesToFetch) {
+            HLSLoggerWarn(@"Properties to fetch should be specified when fetching dictionaries");
+        }
+    }
+    
     NSError *error = nil;
-    NSArray *objects = [managedObjectContext executeFetchRequest:fetchRequest error:&error];
+    NSArray *objects = [HLSModelManager executeFetchRequest:fetchRequest
+                                      predicateTemplateName:nil
+                                     inManagedObjectContext:managedObjectContext
+                                                      error:&error];
     if (error) {
         HLSLoggerError(@"Could not retrieve objects; reason: %@", error);
         return nil;
@@ -56,6 +171,16 @@
     return objects;
 }
 
++ (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
+                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                   options:(NSDictionary *)options
+{
+    return [self filteredObjectsUsingPredicate:predicate
+                        sortedUsingDescriptors:sortDescriptors 
+                                       options:options
+                        inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
 + (NSArray *)filteredObjectsUsingPredicate:(NSPredicate *)predicate
                     sortedUsingDescriptors:(NSArray *)sortDescriptors
 {
@@ -82,6 +207,65 @@
                         sortedUsingDescriptors:sortDescriptors];
 }
 
++ (void)registerPredicateTemplateWithFormat:(NSString *)format name:(NSString *)name
+{
+    if (! name) {
+        HLSLoggerError(@"Missing predicate template name");
+        return;
+    }
+    
+    NSPredicate *predicateTemplate = [NSPredicate predicateWithFormat:format];
+    NSMutableDictionary *predicateTemplates = HLSPredicateTemplates();
+    @synchronized(predicateTemplates) {
+        [predicateTemplates setObject:predicateTemplate forKey:name];
+    }
+}
+
++ (NSArray *)filteredObjectsUsingPredicateTemplateWithName:(NSString *)name
+                                     substitutionVariables:(NSDictionary *)substitutionVariables
+                                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+                                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    HLSAssertObjectsInEnumerationAreKindOfClass(sortDescriptors, NSSortDescriptor);
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return nil;
+    }
+    
+    NSFetchRequest *templateFetchRequest = [self templateFetchRequestWithPredicateTemplateName:name 
+                                                                        inManagedObjectContext:managedObjectContext];
+    if (! templateFetchRequest) {
+        return nil;
+    }
+    
+    // Cached fetch requests are shared and must not be altered
+    NSFetchRequest *fetchRequest = [[templateFetchRequest copy] autorelease];
+    fetchRequest.predicate = [templateFetchRequest.predicate predicateWithSubstitutionVariables:substitutionVariables];
+    fetchRequest.sortDescriptors = sortDescriptors;
+    
+    NSError *error = nil;
+    NSArray *objects = [HLSModelManager executeFetchRequest:fetchRequest
+                                      predicateTemplateName:name
+                                     inManagedObjectContext:managedObjectContext
+                                                      error:&error];
+    if (error) {
+        HLSLoggerError(@"Could not retrieve objects; reason: %@", error);
+        return nil;
+    }
+    
+    return objects;
+}
+
++ (NSArray *)filteredObjectsUsingPredicateTemplateWithName:(NSString *)name
+                                     substitutionVariables:(NSDictionary *)substitutionVariables
+                                    sortedUsingDescriptors:(NSArray *)sortDescriptors
+{
+    return [self filteredObjectsUsingPredicateTemplateWithName:name 
+                                         substitutionVariables:substitutionVariables 
+                                        sortedUsingDescriptors:sortDescriptors 
+                                        inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
 + (NSArray *)allObjectsSortedUsingDescriptors:(NSArray *)sortDescriptors
                        inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
 {
@@ -109,6 +293,24 @@
     return [self allObjectsSortedUsingDescriptors:sortDescriptors];
 }
 
++ (NSArray *)allObjectsSortedUsingDescriptors:(NSArray *)sortDescriptors
+                                      options:(NSDictionary *)options
+                       inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    return [self filteredObjectsUsingPredicate:nil 
+                        sortedUsingDescriptors:sortDescriptors 
+                                       options:options 
+                        inManagedObjectContext:managedObjectContext];
+}
+
++ (NSArray *)allObjectsSortedUsingDescriptors:(NSArray *)sortDescriptors
+                                      options:(NSDictionary *)options
+{
+    return [self allObjectsSortedUsingDescriptors:sortDescriptors 
+                                          options:options 
+                           inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
 + (NSArray *)allObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
 {
     return [self allObjectsSortedUsingDescriptors:nil 
@@ -120,11 +322,87 @@
     return [self allObjectsInManagedObjectContext:[HLSModelManager currentModelContext]];
 }
 
++ (NSUInteger)countOfObjectsUsingPredicate:(NSPredicate *)predicate
+                    inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return NSNotFound;
+    }
+    
+    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                         inManagedObjectContext:managedObjectContext];
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    fetchRequest.predicate = predicate;
+    
+    NSError *error = nil;
+    NSUInteger count = [HLSModelManager countForFetchRequest:fetchRequest inManagedObjectContext:managedObjectContext error:&error];
+    if (count == NSNotFound) {
+        HLSLoggerError(@"Could not count objects; reason: %@", error);
+        return NSNotFound;
+    }
+    
+    return count;
+}
+
++ (NSUInteger)countOfObjectsUsingPredicate:(NSPredicate *)predicate
+{
+    return [self countOfObjectsUsingPredicate:predicate inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
++ (NSNumber *)sumOfValuesForKey:(NSString *)key
+                 usingPredicate:(NSPredicate *)predicate
+         inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    return [self aggregateValueWithFunctionName:@"sum:" 
+                                         forKey:key 
+                                 usingPredicate:predicate 
+                         inManagedObjectContext:managedObjectContext];
+}
+
++ (NSNumber *)sumOfValuesForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate
+{
+    return [self sumOfValuesForKey:key usingPredicate:predicate inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
++ (id)minimumValueForKey:(NSString *)key
+          usingPredicate:(NSPredicate *)predicate
+  inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    return [self aggregateValueWithFunctionName:@"min:" 
+                                         forKey:key 
+                                 usingPredicate:predicate 
+                         inManagedObjectContext:managedObjectContext];
+}
+
++ (id)minimumValueForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate
+{
+    return [self minimumValueForKey:key usingPredicate:predicate inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
++ (id)maximumValueForKey:(NSString *)key
+          usingPredicate:(NSPredicate *)predicate
+  inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    return [self aggregateValueWithFunctionName:@"max:" 
+                                         forKey:key 
+                                 usingPredicate:predicate 
+                         inManagedObjectContext:managedObjectContext];
+}
+
++ (id)maximumValueForKey:(NSString *)key usingPredicate:(NSPredicate *)predicate
+{
+    return [self maximumValueForKey:key usingPredicate:predicate inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
 + (void)deleteAllObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
 {
-    NSArray *allObjects = [self allObjects];
-    for (NSManagedObject *managedObject in allObjects) {
-        [managedObjectContext deleteObject:managedObject];
+    NSDictionary *options = [NSDictionary dictionaryWithObject:[NSNumber numberWithUnsignedInteger:NSManagedObjectIDResultType]
+                                                        forKey:HLSFetchResultTypeOption];
+    NSArray *objectIDs = [self allObjectsSortedUsingDescriptors:nil options:options inManagedObjectContext:managedObjectContext];
+    for (NSManagedObjectID *objectID in objectIDs) {
+        [managedObjectContext deleteObject:[managedObjectContext objectWithID:objectID]];
     }
 }
 
@@ -133,18 +411,360 @@
     [self deleteAllObjectsInManagedObjectContext:[HLSModelManager currentModelContext]];
 }
 
++ (BOOL)deleteAllObjectsInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+                                     batchSize:(NSUInteger)batchSize
+                                         error:(NSError **)pError
+{
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return NO;
+    }
+    
+    if (batchSize == 0) {
+        batchSize = kDeleteDefaultBatchSize;
+    }
+    
+    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                         inManagedObjectContext:managedObjectContext];
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    fetchRequest.resultType = NSManagedObjectIDResultType;
+    fetchRequest.fetchLimit = batchSize;
+    
+    // Deleted objects are saved after each batch, the next batch is therefore always found at the beginning
+    NSError *error = nil;
+    while (YES) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        
+        NSArray *objectIDs = [HLSModelManager executeFetchRequest:fetchRequest
+                                            predicateTemplateName:nil
+                                           inManagedObjectContext:managedObjectContext
+                                                            error:&error];
+        if ([objectIDs count] == 0) {
+            // The error belongs to the pool, keep it
+            [error retain];
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        
+        for (NSManagedObjectID *objectID in objectIDs) {
+            [managedObjectContext deleteObject:[managedObjectContext objectWithID:objectID]];
+        }
+        
+        if (! [HLSModelManager saveManagedObjectContext:managedObjectContext error:&error]) {
+            [error retain];
+            HLSAutoreleasePoolPop(pool);
+            break;
+        }
+        
+        // Release the deleted objects
+        [managedObjectContext reset];
+        
+        HLSAutoreleasePoolPop(pool);
+    }
+    
+    if (error) {
+        HLSLoggerError(@"Could not delete objects; reason: %@", error);
+        [error autorelease];
+        if (pError) {
+            *pError = error;
+        }
+        return NO;
+    }
+    
+    return YES;
+}
+
++ (BOOL)deleteAllObjectsWithBatchSize:(NSUInteger)batchSize error:(NSError **)pError
+{
+    return [self deleteAllObjectsInManagedObjectContext:[HLSModelManager currentModelContext] 
+                                              batchSize:batchSize 
+                                                  error:pError];
+}
+
+#pragma mark Identity cache
+
++ (id)cachedObjectWithValue:(id)value
+                     forKey:(NSString *)key
+     inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return nil;
+    }
+    
+    if (! value) {
+        return nil;
+    }
+    
+    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                         inManagedObjectContext:managedObjectContext];
+    NSMutableDictionary *objectMap = [HLSManagedObjectCacheForContext(managedObjectContext, YES) objectMapForEntity:entityDescription key:key];
+    
+    id object = [objectMap objectForKey:value];
+    if (object == [NSNull null]) {
+        // Objects inserted since are known only once pending changes have been processed
+        [managedObjectContext processPendingChanges];
+        object = [objectMap objectForKey:value];
+    }
+    
+    if (object && object != [NSNull null]) {
+        // The value might have changed or the object might have been deleted since it was cached
+        if (! [object isDeleted] && [[object valueForKey:key] isEqual:value]) {
+            return object;
+        }
+        [objectMap removeObjectForKey:value];
+        object = nil;
+    }
+    
+    // Read-through
+    if (! object) {
+        NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+        [fetchRequest setEntity:entityDescription];
+        fetchRequest.predicate = [NSPredicate predicateWithFormat:@"%K == %@", key, value];
+        fetchRequest.fetchLimit = 1;
+        
+        NSError *error = nil;
+        NSArray *objects = [HLSModelManager executeFetchRequest:fetchRequest
+                                          predicateTemplateName:nil
+                                         inManagedObjectContext:managedObjectContext
+                                                          error:&error];
+        if (! objects) {
+            HLSLoggerError(@"Could not retrieve object; reason: %@", error);
+            return nil;
+        }
+        
+        object = [objects lastObject];
+        [objectMap setObject:(object ? object : [NSNull null]) forKey:value];
+    }
+    
+    return (object != [NSNull null]) ? object : nil;
+}
+
++ (id)cachedObjectWithValue:(id)value forKey:(NSString *)key
+{
+    return [self cachedObjectWithValue:value forKey:key inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
++ (void)cacheObjectsWithValues:(NSArray *)values
+                        forKey:(NSString *)key
+        inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return;
+    }
+    
+    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                         inManagedObjectContext:managedObjectContext];
+    NSMutableDictionary *objectMap = [HLSManagedObjectCacheForContext(managedObjectContext, YES) objectMapForEntity:entityDescription key:key];
+    
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    
+    for (NSUInteger location = 0; location < [values count]; location += kCacheFetchMaximumNumberOfValues) {
+        NSRange range = NSMakeRange(location, MIN(kCacheFetchMaximumNumberOfValues, [values count] - location));
+        NSArray *batchValues = [values subarrayWithRange:range];
+        fetchRequest.predicate = [NSPredicate predicateWithFormat:@"%K IN %@", key, batchValues];
+        
+        NSError *error = nil;
+        NSArray *objects = [HLSModelManager executeFetchRequest:fetchRequest
+                                          predicateTemplateName:nil
+                                         inManagedObjectContext:managedObjectContext
+                                                          error:&error];
+        if (! objects) {
+            HLSLoggerError(@"Could not retrieve objects; reason: %@", error);
+            return;
+        }
+        
+        for (id value in batchValues) {
+            [objectMap setObject:[NSNull null] forKey:value];
+        }
+        for (NSManagedObject *object in objects) {
+            [objectMap setObject:object forKey:[object valueForKey:key]];
+        }
+    }
+}
+
++ (void)cacheObjectsWithValues:(NSArray *)values forKey:(NSString *)key
+{
+    [self cacheObjectsWithValues:values forKey:key inManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
++ (void)clearObjectCacheInManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    [HLSManagedObjectCacheForContext(managedObjectContext, NO) removeAllObjects];
+}
+
++ (void)clearObjectCache
+{
+    [self clearObjectCacheInManagedObjectContext:[HLSModelManager currentModelContext]];
+}
+
 #pragma mark Creating a copy
 
 - (id)duplicate
+{
+    // Objects reachable several times from the receiver are duplicated only once. All objects of the graph are duplicated
+    // first, then relationships of the copies are set, so that the result does not depend on the order in which
+    // relationships are traversed
+    CFMutableDictionaryRef identityMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    NSMutableArray *originalObjects = [NSMutableArray array];
+    NSMutableArray *relationshipValues = [NSMutableArray array];
+    id objectCopy = [self duplicateWithIdentityMap:identityMap originalObjects:originalObjects relationshipValues:relationshipValues];
+    
+    NSUInteger count = [originalObjects count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        NSManagedObject *originalObject = [originalObjects objectAtIndex:i];
+        [originalObject setDuplicateRelationshipValues:[relationshipValues objectAtIndex:i] withIdentityMap:identityMap];
+    }
+    
+    CFRelease(identityMap);
+    return objectCopy;
+}
+
+@end
+
+@implementation NSManagedObject (HLSExtensionsPrivate)
+
++ (NSFetchRequest *)templateFetchRequestWithPredicateTemplateName:(NSString *)name
+                                            inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    NSPredicate *predicateTemplate = nil;
+    NSMutableDictionary *predicateTemplates = HLSPredicateTemplates();
+    @synchronized(predicateTemplates) {
+        predicateTemplate = [[[predicateTemplates objectForKey:name] retain] autorelease];
+    }
+    if (! predicateTemplate) {
+        HLSLoggerError(@"No predicate template has been registered with name %@", name);
+        return nil;
+    }
+    
+    // Entity descriptions belong to a model. Fetch requests are therefore cached on the model itself, and go away
+    // with it
+    NSManagedObjectModel *managedObjectModel = [[managedObjectContext persistentStoreCoordinator] managedObjectModel];
+    @synchronized(managedObjectModel) {
+        NSMutableDictionary *templateFetchRequests = objc_getAssociatedObject(managedObjectModel, s_templateFetchRequestsKey);
+        if (! templateFetchRequests) {
+            templateFetchRequests = [NSMutableDictionary dictionary];
+            objc_setAssociatedObject(managedObjectModel, s_templateFetchRequestsKey, templateFetchRequests, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        
+        // If the template has been replaced since the fetch request was cached, build a new one
+        NSString *fetchRequestKey = [NSString stringWithFormat:@"%@-%@", [self className], name];
+        NSFetchRequest *fetchRequest = [templateFetchRequests objectForKey:fetchRequestKey];
+        if (! fetchRequest || fetchRequest.predicate != predicateTemplate) {
+            NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                                 inManagedObjectContext:managedObjectContext];
+            fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+            [fetchRequest setEntity:entityDescription];
+            fetchRequest.predicate = predicateTemplate;
+            [templateFetchRequests setObject:fetchRequest forKey:fetchRequestKey];
+        }
+        return fetchRequest;
+    }
+}
+
++ (id)aggregateValueWithFunctionName:(NSString *)functionName
+                              forKey:(NSString *)key
+                      usingPredicate:(NSPredicate *)predicate
+              inManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (! managedObjectContext) {
+        HLSLoggerError(@"Missing managed object context");
+        return nil;
+    }
+    
+    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:[self className]
+                                                         inManagedObjectContext:managedObjectContext];
+    NSAttributeDescription *attributeDescription = [[entityDescription attributesByName] objectForKey:key];
+    if (! attributeDescription) {
+        HLSLoggerError(@"The key %@ is not an attribute of the entity %@", key, [entityDescription name]);
+        return nil;
+    }
+    
+    // Sums of small integers are likely to overflow if computed with the attribute type
+    NSAttributeType resultType = [attributeDescription attributeType];
+    if ([functionName isEqualToString:@"sum:"]) {
+        switch (resultType) {
+            case NSInteger16AttributeType:
+            case NSInteger32AttributeType:
+            case NSInteger64AttributeType: {
+                resultType = NSInteger64AttributeType;
+                break;
+            }
+                
+            case NSDecimalAttributeType:
+            case NSDoubleAttributeType: {
+                break;
+            }
+                
+            case NSFloatAttributeType: {
+                resultType = NSDoubleAttributeType;
+                break;
+            }
+                
+            default: {
+                HLSLoggerError(@"The attribute %@ is not numeric and cannot be summed", key);
+                return nil;
+                break;
+            }
+        }
+    }
+    
+    NSExpression *keyPathExpression = [NSExpression expressionForKeyPath:key];
+    NSExpressionDescription *expressionDescription = [[[NSExpressionDescription alloc] init] autorelease];
+    expressionDescription.name = @"aggregateValue";
+    expressionDescription.expression = [NSExpression expressionForFunction:functionName 
+                                                                 arguments:[NSArray arrayWithObject:keyPathExpression]];
+    expressionDescription.expressionResultType = resultType;
+    
+    // Pending changes are not supported with dictionary results
+    NSFetchRequest *fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+    [fetchRequest setEntity:entityDescription];
+    fetchRequest.predicate = predicate;
+    fetchRequest.resultType = NSDictionaryResultType;
+    fetchRequest.propertiesToFetch = [NSArray arrayWithObject:expressionDescription];
+    fetchRequest.includesPendingChanges = NO;
+    
+    NSError *error = nil;
+    NSArray *results = [HLSModelManager executeFetchRequest:fetchRequest
+                                      predicateTemplateName:nil
+                                     inManagedObjectContext:managedObjectContext
+                                                      error:&error];
+    if (! results) {
+        HLSLoggerError(@"Could not compute the aggregate value; reason: %@", error);
+        return nil;
+    }
+    
+    return [[results lastObject] objectForKey:@"aggregateValue"];
+}
+
+/**
+ * Duplicate the receiver and, recursively, the objects it owns, without setting any relationship of the copies. The 
+ * identity map is used to keep track of the objects already duplicated (maps original objects to their copies). Each
+ * object duplicated is appended to originalObjects, together with a snapshot of its relationship values (taken before 
+ * any relationship of the graph is altered through inverse relationships) appended to relationshipValues
+ */
+- (id)duplicateWithIdentityMap:(CFMutableDictionaryRef)identityMap
+               originalObjects:(NSMutableArray *)originalObjects
+            relationshipValues:(NSMutableArray *)relationshipValues
 {
     if (! [self conformsToProtocol:@protocol(HLSManagedObjectCopying)]) {
         return nil;
     }
     
+    // Already duplicated
+    NSManagedObject *objectCopy = (NSManagedObject *)CFDictionaryGetValue(identityMap, self);
+    if (objectCopy) {
+        return objectCopy;
+    }
+    
     // Create the deep copy
-    NSManagedObject *objectCopy = [NSEntityDescription insertNewObjectForEntityForName:self.entity.name
-                                                                inManagedObjectContext:self.managedObjectContext];
-        
+    objectCopy = [NSEntityDescription insertNewObjectForEntityForName:self.entity.name
+                                               inManagedObjectContext:self.managedObjectContext];
+    CFDictionarySetValue(identityMap, self, objectCopy);
+    
     // Get keys to exclude (if any)
     NSSet *keysToExclude = nil;
     NSManagedObject<HLSManagedObjectCopying> *managedObjectCopyable = (NSManagedObject<HLSManagedObjectCopying> *)self;
@@ -152,63 +772,249 @@
         keysToExclude = [managedObjectCopyable keysToExclude];
     }
     
-    // Copy attributes (shallow copy for all: Those are of "primitive" immutable types anyway)
-    NSEntityDescription *entityDescription = [NSEntityDescription entityForName:self.entity.name
-                                                         inManagedObjectContext:self.managedObjectContext];
-    NSDictionary *attributes = [entityDescription attributesByName];
-    for (NSString *attributeName in [attributes allKeys]) {
-        if ([keysToExclude containsObject:attributeName]) {
+    HLSEntityDuplicationInfo *duplicationInfo = HLSDuplicationInfoForEntity(self.entity);
+    
+    // Copy attributes at once (shallow copy for all: Those are of "primitive" immutable types anyway)
+    NSArray *attributeNames = duplicationInfo.attributeNames;
+    if ([keysToExclude count] != 0) {
+        attributeNames = [attributeNames filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"NOT (SELF IN %@)", keysToExclude]];
+    }
+    [objectCopy setValuesForKeysWithDictionary:[self dictionaryWithValuesForKeys:attributeNames]];
+    
+    // Snapshot relationship values (nil to-one values are stored as NSNull)
+    NSMutableDictionary *relationshipNameToValueMap = [NSMutableDictionary dictionary];
+    for (NSRelationshipDescription *relationshipDescription in duplicationInfo.relationshipDescriptions) {
+        NSString *relationshipName = [relationshipDescription name];
+        if ([keysToExclude containsObject:relationshipName]) {
             continue;
         }
-        [objectCopy setValue:[self valueForKey:attributeName] forKey:attributeName];
+        
+        id value = [managedObjectCopyable valueForKey:relationshipName];
+        if ([relationshipDescription isToMany]) {
+            value = [NSSet setWithSet:value];
+        }
+        [relationshipNameToValueMap setObject:(value ? value : [NSNull null]) forKey:relationshipName];
     }
+    [originalObjects addObject:self];
+    [relationshipValues addObject:relationshipNameToValueMap];
     
-    // Copy relationships
-    NSDictionary *relationships = [entityDescription relationshipsByName];
-    for (NSString *relationshipName in [relationships allKeys]) {
-        if ([keysToExclude containsObject:relationshipName]) {
+    // Deep copy owned objects implementing the NSManagedObjectCopying protocol
+    for (NSRelationshipDescription *relationshipDescription in duplicationInfo.relationshipDescriptions) {
+        if ([relationshipDescription deleteRule] != NSCascadeDeleteRule) {
             continue;
         }
         
-        // Deep copy owned objects implementing the NSManagedObjectCopying protocol
-        NSRelationshipDescription *relationshipDescription = [relationships objectForKey:relationshipName];
-        if ([relationshipDescription deleteRule] == NSCascadeDeleteRule) {
-            // To-many relationship
-            if ([relationshipDescription isToMany]) {
-                // The set of owned objects might be altered when we duplicate them below. To avoid iterating
-                // over mutating sets, we copy it first
-                NSSet *ownedObjects = [NSSet setWithSet:[managedObjectCopyable valueForKey:relationshipName]];
-                NSMutableSet *ownedObjectCopies = [NSMutableSet set];
-                for (NSManagedObject *ownedObject in ownedObjects) {
-                    NSManagedObject *ownedObjectCopy = [ownedObject duplicate];
-                    if (ownedObjectCopy) {
-                        [ownedObjectCopies addObject:ownedObjectCopy];
-                    }
-                    else {
-                        [ownedObjectCopies addObject:ownedObject];
-                    }   
-                }
-                [objectCopy setValue:[NSSet setWithSet:ownedObjectCopies] forKey:relationshipName];
+        id value = [relationshipNameToValueMap objectForKey:[relationshipDescription name]];
+        if ([relationshipDescription isToMany]) {
+            for (NSManagedObject *ownedObject in value) {
+                [ownedObject duplicateWithIdentityMap:identityMap originalObjects:originalObjects relationshipValues:relationshipValues];
             }
-            // To-one relationship
-            else {
-                NSManagedObject *ownedObject = [managedObjectCopyable valueForKey:relationshipName];
-                NSManagedObject *ownedObjectCopy = [ownedObject duplicate];
-                if (ownedObjectCopy) {
-                    [objectCopy setValue:ownedObjectCopy forKey:relationshipName];
-                }
-                else {
-                    [objectCopy setValue:ownedObject forKey:relationshipName];
-                }
+        }
+        else if (value && value != [NSNull null]) {
+            [value duplicateWithIdentityMap:identityMap originalObjects:originalObjects relationshipValues:relationshipValues];
+        }
+    }
+    
+    return objectCopy;
+}
+
+/**
+ * Set the relationships of the copy of the receiver from a snapshot of its relationship values. Objects which have been
+ * duplicated as part of the same graph are replaced by their copies, so that the copied graph is consistent. Other
+ * objects (non-owned objects, or owned objects which cannot be copied) are shared with the original
+ */
+- (void)setDuplicateRelationshipValues:(NSDictionary *)relationshipValues withIdentityMap:(CFDictionaryRef)identityMap
+{
+    NSManagedObject *objectCopy = (NSManagedObject *)CFDictionaryGetValue(identityMap, self);
+    
+    HLSEntityDuplicationInfo *duplicationInfo = HLSDuplicationInfoForEntity(self.entity);
+    for (NSRelationshipDescription *relationshipDescription in duplicationInfo.relationshipDescriptions) {
+        NSString *relationshipName = [relationshipDescription name];
+        id value = [relationshipValues objectForKey:relationshipName];
+        if (! value) {
+            continue;
+        }
+        
+        if ([relationshipDescription isToMany]) {
+            NSMutableSet *targetObjects = [NSMutableSet setWithCapacity:[value count]];
+            for (NSManagedObject *object in value) {
+                NSManagedObject *duplicatedObject = (NSManagedObject *)CFDictionaryGetValue(identityMap, object);
+                [targetObjects addObject:duplicatedObject ? duplicatedObject : object];
             }
+            [objectCopy setValue:[NSSet setWithSet:targetObjects] forKey:relationshipName];
         }
-        // Shallow copy in all other cases
         else {
-            [objectCopy setValue:[managedObjectCopyable valueForKey:relationshipName] forKey:relationshipName];
+            NSManagedObject *object = (value != [NSNull null]) ? value : nil;
+            NSManagedObject *duplicatedObject = object ? (NSManagedObject *)CFDictionaryGetValue(identityMap, object) : nil;
+            [objectCopy setValue:(duplicatedObject ? duplicatedObject : object) forKey:relationshipName];
         }
     }
+}
+
+@end
+
+@implementation HLSEntityDuplicationInfo
+
+#pragma mark Object creation and destruction
+
+- (id)initWithEntityDescription:(NSEntityDescription *)entityDescription
+{
+    if ((self = [super init])) {
+        m_attributeNames = [[[entityDescription attributesByName] allKeys] retain];
+        m_relationshipDescriptions = [[[entityDescription relationshipsByName] allValues] retain];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_attributeNames release];
+    [m_relationshipDescriptions release];
     
-    return objectCopy;
+    [super dealloc];
 }
 
+#pragma mark Accessors and mutators
+
+@synthesize attributeNames = m_attributeNames;
+
+@synthesize relationshipDescriptions = m_relationshipDescriptions;
+
 @end
+
+@implementation HLSManagedObjectCache
+
+#pragma mark Object creation and destruction
+
+- (id)initWithManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if ((self = [super init])) {
+        m_managedObjectContext = managedObjectContext;
+        m_entityNameToKeyToObjectMaps = [[NSMutableDictionary alloc] init];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self 
+                                                 selector:@selector(managedObjectContextObjectsDidChange:) 
+                                                     name:NSManagedObjectContextObjectsDidChangeNotification 
+                                                   object:managedObjectContext];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self 
+                                                    name:NSManagedObjectContextObjectsDidChangeNotification 
+                                                  object:m_managedObjectContext];
+    
+    [m_entityNameToKeyToObjectMaps release];
+    
+    [super dealloc];
+}
+
+#pragma mark Cache management
+
+- (NSMutableDictionary *)objectMapForEntity:(NSEntityDescription *)entityDescription key:(NSString *)key
+{
+    NSMutableDictionary *keyToObjectMaps = [m_entityNameToKeyToObjectMaps objectForKey:[entityDescription name]];
+    if (! keyToObjectMaps) {
+        keyToObjectMaps = [NSMutableDictionary dictionary];
+        [m_entityNameToKeyToObjectMaps setObject:keyToObjectMaps forKey:[entityDescription name]];
+    }
+    
+    NSMutableDictionary *objectMap = [keyToObjectMaps objectForKey:key];
+    if (! objectMap) {
+        objectMap = [NSMutableDictionary dictionary];
+        [keyToObjectMaps setObject:objectMap forKey:key];
+    }
+    return objectMap;
+}
+
+- (void)removeAllObjects
+{
+    [m_entityNameToKeyToObjectMaps removeAllObjects];
+}
+
+#pragma mark Notification callbacks
+
+- (void)managedObjectContextObjectsDidChange:(NSNotification *)notification
+{
+    NSDictionary *userInfo = [notification userInfo];
+    if ([userInfo objectForKey:NSInvalidatedAllObjectsKey]) {
+        [self removeAllObjects];
+        return;
+    }
+    
+    if ([m_entityNameToKeyToObjectMaps count] == 0) {
+        return;
+    }
+    
+    NSMutableSet *insertedOrUpdatedObjects = [NSMutableSet setWithSet:[userInfo objectForKey:NSInsertedObjectsKey]];
+    [insertedOrUpdatedObjects unionSet:[userInfo objectForKey:NSUpdatedObjectsKey]];
+    NSSet *deletedObjects = [userInfo objectForKey:NSDeletedObjectsKey];
+    
+    // Instances of sub-entities are found by lookups on their parent entities as well
+    for (NSManagedObject *object in insertedOrUpdatedObjects) {
+        for (NSEntityDescription *entityDescription = [object entity]; entityDescription; entityDescription = [entityDescription superentity]) {
+            NSDictionary *keyToObjectMaps = [m_entityNameToKeyToObjectMaps objectForKey:[entityDescription name]];
+            for (NSString *key in [keyToObjectMaps allKeys]) {
+                id value = [object valueForKey:key];
+                if (value) {
+                    [[keyToObjectMaps objectForKey:key] setObject:object forKey:value];
+                }
+            }
+        }
+    }
+    
+    for (NSManagedObject *object in deletedObjects) {
+        for (NSEntityDescription *entityDescription = [object entity]; entityDescription; entityDescription = [entityDescription superentity]) {
+            NSDictionary *keyToObjectMaps = [m_entityNameToKeyToObjectMaps objectForKey:[entityDescription name]];
+            for (NSString *key in [keyToObjectMaps allKeys]) {
+                id value = [object valueForKey:key];
+                NSMutableDictionary *objectMap = [keyToObjectMaps objectForKey:key];
+                if (value && [objectMap objectForKey:value] == object) {
+                    [objectMap removeObjectForKey:value];
+                }
+            }
+        }
+    }
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSMutableDictionary *HLSPredicateTemplates(void)
+{
+    static NSMutableDictionary *s_predicateTemplates = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_predicateTemplates = [[NSMutableDictionary alloc] init];
+    });
+    return s_predicateTemplates;
+}
+
+static HLSEntityDuplicationInfo *HLSDuplicationInfoForEntity(NSEntityDescription *entityDescription)
+{
+    @synchronized(entityDescription) {
+        HLSEntityDuplicationInfo *duplicationInfo = objc_getAssociatedObject(entityDescription, s_duplicationInfoKey);
+        if (! duplicationInfo) {
+            duplicationInfo = [[[HLSEntityDuplicationInfo alloc] initWithEntityDescription:entityDescription] autorelease];
+            objc_setAssociatedObject(entityDescription, s_duplicationInfoKey, duplicationInfo, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        return duplicationInfo;
+    }
+}
+
+static HLSManagedObjectCache *HLSManagedObjectCacheForContext(NSManagedObjectContext *managedObjectContext, BOOL create)
+{
+    if (! managedObjectContext) {
+        return nil;
+    }
+    
+    HLSManagedObjectCache *managedObjectCache = objc_getAssociatedObject(managedObjectContext, s_objectCacheKey);
+    if (! managedObjectCache && create) {
+        managedObjectCache = [[[HLSManagedObjectCache alloc] initWithManagedObjectContext:managedObjectContext] autorelease];
+        objc_setAssociatedObject(managedObjectContext, s_objectCacheKey, managedObjectCache, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return managedObjectCache;
+}
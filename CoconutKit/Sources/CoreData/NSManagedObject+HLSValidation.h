@@ -114,6 +114,42 @@
  */
 - (BOOL)check:(NSError **)pError;
 
+/**
+ * Same as -check:, but also returns the errors of the individual checks by reference, as a dictionary mapping each
+ * invalid field name to its error (NSValidationMultipleErrorsError if several errors were found for the field). 
+ * Consistency errors are only available from the global error. This makes it possible to validate an object once
+ * and to report errors field by field (e.g. for a whole form)
+ */
+- (BOOL)check:(NSError **)pError fieldErrors:(NSDictionary **)pFieldErrors;
+
+/**
+ * Subclasses of NSManagedObject can override this method to return YES if all their individual check methods only
+ * depend on the value they receive (i.e. they do not access the object or any other object). Individual checks for 
+ * attributes can then be performed in parallel on other threads when validating large sets of objects (see below).
+ * Checks for relationships are never performed concurrently. This default implementation returns NO
+ */
++ (BOOL)allowsConcurrentFieldChecks;
+
+/**
+ * Check several objects as a whole, as -check: does for each of them, returning a single combined error. For objects
+ * whose class allows concurrent field checks (see above), the individual attribute checks are first performed in 
+ * parallel on a snapshot of the attribute values. All other validations are then performed in the order of the objects 
+ * in the array, reusing the results of the individual attribute checks. Errors are therefore the same as if objects 
+ * had been checked one after the other.
+ *
+ * This method must be called from the thread of the managed object context the objects belong to
+ */
++ (BOOL)checkObjects:(NSArray *)objects error:(NSError **)pError;
+
+/**
+ * Save a managed object context, performing the individual attribute checks of inserted and updated objects in
+ * parallel when their class allows it (see +allowsConcurrentFieldChecks). Errors are the same as those which would
+ * be returned by -[NSManagedObjectContext save:]. Use this method when saving large sets of inserted objects
+ *
+ * This method must be called from the thread of the managed object context
+ */
++ (BOOL)saveManagedObjectContextWithConcurrentFieldChecks:(NSManagedObjectContext *)managedObjectContext error:(NSError **)pError;
+
 /**
  * Subclasses of NSManagedObject can override this method to perform additional consistency validations when
  * inserted or updated objects are committed (i.e. when the managed object context they live in is saved).
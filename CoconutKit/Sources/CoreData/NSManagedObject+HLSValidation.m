@@ -8,23 +8,53 @@
 
 #import "NSManagedObject+HLSValidation.h"
 
+#import "HLSAllocationTracker+Friend.h"
 #import "HLSAssert.h"
 #import "HLSLogger.h"
 #import "HLSModelManager.h"
+#import "HLSModelManager+Friend.h"
 #import "HLSRuntime.h"
 #import "NSDictionary+HLSExtensions.h"
 #import "NSError+HLSExtensions.h"
 #import "NSObject+HLSExtensions.h"
 #import "UITextField+HLSValidation.h"
 
+#import <libkern/OSAtomic.h>
 #import <objc/runtime.h>
+#import <pthread.h>
 
 // Return YES iff injection has been enabled. External linkage, but not public
 BOOL injectedManagedObjectValidation(void);
 
+/**
+ * Result of a check method lookup: The check selector and its implementation (NULL if no check method exists)
+ */
+typedef struct {
+    SEL checkSel;
+    IMP checkImp;
+} HLSValidationCheck;
+
 // Variables with internal linkage
 static BOOL s_injectedManagedObjectValidation = NO;
 
+// Check method lookup results, per class and per validation selector (inner maps, values are NSValue objects wrapping
+// HLSValidationCheck structs). One map for lookups along the class hierarchy, the other one for lookups on the
+// class itself
+static CFMutableDictionaryRef s_classToInheritedValidationChecksMap = NULL;
+static CFMutableDictionaryRef s_classToOwnValidationChecksMap = NULL;
+static pthread_mutex_t s_validationChecksMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Field check results computed in advance, stored in thread-local storage while being used (maps an object to a map
+// from validation selectors to results). The counter is used to avoid thread-local storage lookups when not needed
+static NSString * const HLSValidationFieldCheckResultsThreadLocalStorageKey = @"HLSValidationFieldCheckResultsThreadLocalStorageKey";
+static volatile int32_t s_numberOfFieldCheckResultsInUse = 0;
+
+// Field check errors recorded while checking an object, stored in thread-local storage while being recorded (maps an 
+// object to a map from validation selector names to errors). The counter is used to avoid thread-local storage lookups 
+// when not needed
+static NSString * const HLSValidationFieldErrorsThreadLocalStorageKey = @"HLSValidationFieldErrorsThreadLocalStorageKey";
+static volatile int32_t s_numberOfFieldErrorRecordersInUse = 0;
+
 // Original implementation of the methods we swizzle
 static void (*s_NSManagedObject__initialize_Imp)(id, SEL) = NULL;
 
@@ -34,10 +64,37 @@ static void swizzled_NSManagedObject__initialize_Imp(Class self, SEL _cmd);
 // Static helper functions
 static Method instanceMethodOnClass(Class class, SEL sel);
 static SEL checkSelectorForValidationSelector(SEL sel);
+static HLSValidationCheck validationCheckForClass(Class class, SEL sel, BOOL inherited);
+static CFDictionaryRef createConcurrentFieldCheckResults(NSArray *objects);
+static BOOL performWithConcurrentFieldChecks(NSArray *objects, BOOL (^block)(void));
+static id precomputedFieldCheckResult(id object, SEL sel, id value);
+static void recordFieldError(id object, SEL sel, NSError *error);
+static NSString *validationSelectorNameForKey(NSString *key);
 static BOOL validateProperty(id self, SEL sel, id *pValue, NSError **pError);
 static BOOL validateObjectConsistency(id self, SEL sel, NSError **pError);
 static BOOL validateObjectConsistencyInClassHierarchy(id self, Class class, SEL sel, NSError **pError);
 
+#pragma mark -
+#pragma mark HLSFieldCheck class interface
+
+/**
+ * Individual attribute check which can be performed in advance on a snapshot of the attribute value
+ */
+@interface HLSFieldCheck : NSObject {
+@private
+    NSString *m_key;
+    SEL m_validationSel;
+    HLSValidationCheck m_check;
+}
+
+- (id)initWithKey:(NSString *)key validationSel:(SEL)validationSel check:(HLSValidationCheck)check;
+
+@property (nonatomic, readonly, retain) NSString *key;
+@property (nonatomic, readonly, assign) SEL validationSel;
+@property (nonatomic, readonly, assign) HLSValidationCheck check;
+
+@end
+
 #pragma mark -
 #pragma mark HLSValidationPrivate category interface
 
@@ -88,6 +145,121 @@ static BOOL validateObjectConsistencyInClassHierarchy(id self, Class class, SEL
     return [self validateForInsert:pError];
 }
 
+- (BOOL)check:(NSError **)pError fieldErrors:(NSDictionary **)pFieldErrors
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    if (! pFieldErrors) {
+        return [self check:pError];
+    }
+    
+    // Record the errors of the check methods while checking the object. Those errors do not carry any information about
+    // the field they were generated for
+    NSMutableDictionary *validationSelectorNameToErrorMap = [NSMutableDictionary dictionary];
+    CFMutableDictionaryRef fieldErrorRecorder = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    CFDictionarySetValue(fieldErrorRecorder, self, validationSelectorNameToErrorMap);
+    
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    id previousFieldErrorRecorder = [[[threadDictionary objectForKey:HLSValidationFieldErrorsThreadLocalStorageKey] retain] autorelease];
+    [threadDictionary setObject:(id)fieldErrorRecorder forKey:HLSValidationFieldErrorsThreadLocalStorageKey];
+    CFRelease(fieldErrorRecorder);
+    OSAtomicIncrement32Barrier(&s_numberOfFieldErrorRecordersInUse);
+    
+    NSError *error = nil;
+    BOOL valid = [self check:&error];
+    
+    OSAtomicDecrement32Barrier(&s_numberOfFieldErrorRecordersInUse);
+    if (previousFieldErrorRecorder) {
+        [threadDictionary setObject:previousFieldErrorRecorder forKey:HLSValidationFieldErrorsThreadLocalStorageKey];
+    }
+    else {
+        [threadDictionary removeObjectForKey:HLSValidationFieldErrorsThreadLocalStorageKey];
+    }
+    
+    if (pError) {
+        *pError = error;
+    }
+    
+    // Errors of the check methods
+    NSMutableDictionary *fieldErrors = [NSMutableDictionary dictionary];
+    NSMutableArray *recordedErrors = [NSMutableArray array];
+    for (NSString *key in [[self entity] propertiesByName]) {
+        NSError *fieldError = [validationSelectorNameToErrorMap objectForKey:validationSelectorNameForKey(key)];
+        if (fieldError) {
+            [fieldErrors setObject:fieldError forKey:key];
+            [recordedErrors addObject:fieldError];
+        }
+    }
+    
+    // Errors generated by Core Data for validations defined in the xcdatamodel carry the field they were generated for
+    NSArray *errors = nil;
+    NSError *flattenedError = [NSManagedObject flattenHiearchyForError:error];
+    if ([flattenedError hasCode:NSValidationMultipleErrorsError withinDomain:NSCocoaErrorDomain]) {
+        errors = [[flattenedError userInfo] objectForKey:NSDetailedErrorsKey];
+    }
+    else if (flattenedError) {
+        errors = [NSArray arrayWithObject:flattenedError];
+    }
+    
+    for (NSError *subError in errors) {
+        if ([recordedErrors indexOfObjectIdenticalTo:subError] != NSNotFound) {
+            continue;
+        }
+        
+        NSString *key = [[subError userInfo] objectForKey:NSValidationKeyErrorKey];
+        if (! key || [[subError userInfo] objectForKey:NSValidationObjectErrorKey] != self) {
+            continue;
+        }
+        
+        NSError *fieldError = [fieldErrors objectForKey:key];
+        [NSManagedObject combineError:subError withError:&fieldError];
+        [fieldErrors setObject:fieldError forKey:key];
+    }
+    
+    *pFieldErrors = [NSDictionary dictionaryWithDictionary:fieldErrors];
+    return valid;
+}
+
+#pragma mark Concurrent validation
+
++ (BOOL)allowsConcurrentFieldChecks
+{
+    return NO;
+}
+
++ (BOOL)checkObjects:(NSArray *)objects error:(NSError **)pError
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    HLSAssertObjectsInEnumerationAreKindOfClass(objects, NSManagedObject);
+    
+    return performWithConcurrentFieldChecks(objects, ^{
+        BOOL valid = YES;
+        for (NSManagedObject *object in objects) {
+            NSError *error = nil;
+            if (! [object check:&error]) {
+                [NSManagedObject combineError:error withError:pError];
+                valid = NO;
+            }
+        }
+        
+        if (pError) {
+            *pError = [NSManagedObject flattenHiearchyForError:*pError];
+        }
+        return valid;
+    });
+}
+
++ (BOOL)saveManagedObjectContextWithConcurrentFieldChecks:(NSManagedObjectContext *)managedObjectContext error:(NSError **)pError
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    // Deleted objects are not validated using individual checks
+    NSArray *objects = [[[managedObjectContext insertedObjects] setByAddingObjectsFromSet:[managedObjectContext updatedObjects]] allObjects];
+    return performWithConcurrentFieldChecks(objects, ^{
+        return [HLSModelManager saveManagedObjectContext:managedObjectContext error:pError];
+    });
+}
+
 #pragma mark Global validation method stubs
 
 - (BOOL)checkForConsistency:(NSError **)pError
@@ -102,6 +274,40 @@ static BOOL validateObjectConsistencyInClassHierarchy(id self, Class class, SEL
 
 @end
 
+#pragma mark -
+#pragma mark HLSFieldCheck class implementation
+
+@implementation HLSFieldCheck
+
+#pragma mark Object creation and destruction
+
+- (id)initWithKey:(NSString *)key validationSel:(SEL)validationSel check:(HLSValidationCheck)check
+{
+    if ((self = [super init])) {
+        m_key = [key retain];
+        m_validationSel = validationSel;
+        m_check = check;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_key release];
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize key = m_key;
+
+@synthesize validationSel = m_validationSel;
+
+@synthesize check = m_check;
+
+@end
+
 #pragma mark -
 #pragma mark HLSValidationPrivate category implementation
 
@@ -298,7 +504,8 @@ static Method instanceMethodOnClass(Class class, SEL sel)
 }
 
 /**
- * Return the check selector associated with a validation selector
+ * Return the check selector associated with a validation selector. Since this involves string manipulations, use
+ * validationCheckForClass() instead, which caches the result
  */
 static SEL checkSelectorForValidationSelector(SEL sel)
 {
@@ -314,6 +521,260 @@ static SEL checkSelectorForValidationSelector(SEL sel)
     }    
 }
 
+/**
+ * Return the check selector and method implementation corresponding to a validation selector for a given class. If
+ * inherited is set to YES, the method is looked up along the class hierarchy, otherwise only on the class itself. 
+ * Results are cached so that validating large object graphs does not perform the same costly lookups over and
+ * over again
+ */
+static HLSValidationCheck validationCheckForClass(Class class, SEL sel, BOOL inherited)
+{
+    HLSValidationCheck check;
+    
+    pthread_mutex_lock(&s_validationChecksMutex);
+    
+    if (! s_classToInheritedValidationChecksMap) {
+        s_classToInheritedValidationChecksMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        s_classToOwnValidationChecksMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    }
+    
+    CFMutableDictionaryRef classToValidationChecksMap = inherited ? s_classToInheritedValidationChecksMap : s_classToOwnValidationChecksMap;
+    CFMutableDictionaryRef validationChecksMap = (CFMutableDictionaryRef)CFDictionaryGetValue(classToValidationChecksMap, class);
+    if (! validationChecksMap) {
+        validationChecksMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        CFDictionarySetValue(classToValidationChecksMap, class, validationChecksMap);
+        CFRelease(validationChecksMap);
+    }
+    
+    NSValue *checkValue = (NSValue *)CFDictionaryGetValue(validationChecksMap, sel);
+    if (checkValue) {
+        [checkValue getValue:&check];
+    }
+    else {
+        check.checkSel = checkSelectorForValidationSelector(sel);
+        Method method = inherited ? class_getInstanceMethod(class, check.checkSel) : instanceMethodOnClass(class, check.checkSel);
+        check.checkImp = method ? method_getImplementation(method) : NULL;
+        
+        checkValue = [NSValue valueWithBytes:&check objCType:@encode(HLSValidationCheck)];
+        CFDictionarySetValue(validationChecksMap, sel, checkValue);
+    }
+    
+    pthread_mutex_unlock(&s_validationChecksMutex);
+    
+    return check;
+}
+
+#pragma mark Concurrent field checks
+
+/**
+ * Perform the individual attribute checks of the objects given as parameter in parallel, for those objects whose
+ * class allows it (see +allowsConcurrentFieldChecks). Managed objects can only be accessed from the thread of their
+ * context, values are therefore retrieved first, and checks are then performed on this snapshot. The objects themselves
+ * are only used as receivers of the check methods, which must not access them.
+ *
+ * Returns a map from objects (pointers) to maps from validation selectors to two-element arrays, containing the value
+ * which has been checked (NSNull if nil) and the result, which can be:
+ *   - kCFNull if the check was successful
+ *   - an NSError object if the check failed
+ *   - kCFBooleanFalse if the check failed, but the check method did not return any error
+ * The caller is responsible of releasing the returned map
+ */
+static CFDictionaryRef createConcurrentFieldCheckResults(NSArray *objects)
+{
+    CFMutableDictionaryRef fieldCheckResults = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    
+    // Collect the checks to perform and the values to check, on the thread of the managed object context
+    CFMutableDictionaryRef classToFieldChecksMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    NSMutableArray *checkedObjects = [NSMutableArray array];
+    NSMutableArray *fieldChecksList = [NSMutableArray array];
+    NSMutableArray *snapshots = [NSMutableArray array];
+    NSMutableArray *resultsMaps = [NSMutableArray array];
+    for (NSManagedObject *object in objects) {
+        // Validation selector names and keys are autoreleased temporaries, drain them for each object. What must survive
+        // the iteration (field checks, snapshots) is retained by the collections it is stored into
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        
+        Class class = [object class];
+        if (! [class allowsConcurrentFieldChecks]) {
+            HLSAutoreleasePoolPop(pool);
+            continue;
+        }
+        
+        // Field checks are looked up once per class
+        NSArray *fieldChecks = (NSArray *)CFDictionaryGetValue(classToFieldChecksMap, class);
+        if (! fieldChecks) {
+            NSMutableArray *classFieldChecks = [NSMutableArray array];
+            for (NSString *attributeName in [[[object entity] attributesByName] allKeys]) {
+                if ([attributeName length] == 0) {
+                    continue;
+                }
+                
+                NSString *validationSelectorName = [NSString stringWithFormat:@"validate%@%@:error:", [[attributeName substringToIndex:1] uppercaseString], 
+                                                    [attributeName substringFromIndex:1]];
+                SEL validationSel = NSSelectorFromString(validationSelectorName);
+                HLSValidationCheck check = validationCheckForClass(class, validationSel, YES);
+                if (! check.checkImp) {
+                    continue;
+                }
+                
+                HLSFieldCheck *fieldCheck = [[[HLSFieldCheck alloc] initWithKey:attributeName validationSel:validationSel check:check] autorelease];
+                [classFieldChecks addObject:fieldCheck];
+            }
+            fieldChecks = classFieldChecks;
+            CFDictionarySetValue(classToFieldChecksMap, class, fieldChecks);
+        }
+        
+        if ([fieldChecks count] == 0) {
+            HLSAutoreleasePoolPop(pool);
+            continue;
+        }
+        
+        NSArray *keys = [fieldChecks valueForKey:@"key"];
+        CFMutableDictionaryRef resultsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        CFDictionarySetValue(fieldCheckResults, object, resultsMap);
+        
+        [checkedObjects addObject:object];
+        [fieldChecksList addObject:fieldChecks];
+        [snapshots addObject:[object dictionaryWithValuesForKeys:keys]];
+        [resultsMaps addObject:(id)resultsMap];
+        
+        CFRelease(resultsMap);
+        
+        HLSAutoreleasePoolPop(pool);
+    }
+    CFRelease(classToFieldChecksMap);
+    
+    // Perform the checks in parallel. Each iteration only writes into the results map of its object
+    dispatch_apply([checkedObjects count], dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemCoreData);
+        
+        id object = [checkedObjects objectAtIndex:i];
+        NSDictionary *snapshot = [snapshots objectAtIndex:i];
+        CFMutableDictionaryRef resultsMap = (CFMutableDictionaryRef)[resultsMaps objectAtIndex:i];
+        for (HLSFieldCheck *fieldCheck in [fieldChecksList objectAtIndex:i]) {
+            id snapshotValue = [snapshot objectForKey:fieldCheck.key];
+            id value = (snapshotValue != [NSNull null]) ? snapshotValue : nil;
+            
+            HLSValidationCheck check = fieldCheck.check;
+            BOOL (*checkImp)(id, SEL, id, NSError **) = (BOOL (*)(id, SEL, id, NSError **))check.checkImp;
+            NSError *error = nil;
+            id result = nil;
+            if ((*checkImp)(object, check.checkSel, value, &error)) {
+                if (error) {
+                    HLSLoggerWarn(@"The %s method returns YES but also an error. The error has been discarded, but the method "
+                                  "implementation is obviously incorrect. Fix it", (char *)check.checkSel);
+                }
+                result = (id)kCFNull;
+            }
+            else {
+                result = error ? (id)error : (id)kCFBooleanFalse;
+            }
+            CFDictionarySetValue(resultsMap, fieldCheck.validationSel, [NSArray arrayWithObjects:snapshotValue, result, nil]);
+        }
+        
+        HLSAutoreleasePoolPop(pool);
+    });
+    
+    return fieldCheckResults;
+}
+
+/**
+ * Compute the field check results for the objects given as parameter in parallel, then execute the block with these
+ * results available to validation wrappers called on the current thread
+ */
+static BOOL performWithConcurrentFieldChecks(NSArray *objects, BOOL (^block)(void))
+{
+    CFDictionaryRef fieldCheckResults = createConcurrentFieldCheckResults(objects);
+    
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    id previousFieldCheckResults = [[[threadDictionary objectForKey:HLSValidationFieldCheckResultsThreadLocalStorageKey] retain] autorelease];
+    [threadDictionary setObject:(id)fieldCheckResults forKey:HLSValidationFieldCheckResultsThreadLocalStorageKey];
+    CFRelease(fieldCheckResults);
+    OSAtomicIncrement32Barrier(&s_numberOfFieldCheckResultsInUse);
+    
+    BOOL result = block();
+    
+    OSAtomicDecrement32Barrier(&s_numberOfFieldCheckResultsInUse);
+    if (previousFieldCheckResults) {
+        [threadDictionary setObject:previousFieldCheckResults forKey:HLSValidationFieldCheckResultsThreadLocalStorageKey];
+    }
+    else {
+        [threadDictionary removeObjectForKey:HLSValidationFieldCheckResultsThreadLocalStorageKey];
+    }
+    
+    return result;
+}
+
+/**
+ * Return the result computed in advance for a validation selector applied to a given object and value (see 
+ * createConcurrentFieldCheckResults()), nil if none. If the value has changed since the result was computed (e.g.
+ * because Core Data coerced it, or because another validation altered the object), nil is returned as well
+ */
+static id precomputedFieldCheckResult(id object, SEL sel, id value)
+{
+    if (s_numberOfFieldCheckResultsInUse == 0) {
+        return nil;
+    }
+    
+    CFDictionaryRef fieldCheckResults = (CFDictionaryRef)[[[NSThread currentThread] threadDictionary] objectForKey:HLSValidationFieldCheckResultsThreadLocalStorageKey];
+    if (! fieldCheckResults) {
+        return nil;
+    }
+    
+    CFDictionaryRef resultsMap = (CFDictionaryRef)CFDictionaryGetValue(fieldCheckResults, object);
+    if (! resultsMap) {
+        return nil;
+    }
+    
+    NSArray *valueAndResult = (NSArray *)CFDictionaryGetValue(resultsMap, sel);
+    if (! valueAndResult) {
+        return nil;
+    }
+    
+    id checkedValue = [valueAndResult objectAtIndex:0];
+    if (checkedValue == [NSNull null]) {
+        checkedValue = nil;
+    }
+    if (checkedValue != value && ! [checkedValue isEqual:value]) {
+        return nil;
+    }
+    
+    return [valueAndResult objectAtIndex:1];
+}
+
+#pragma mark Field error recording
+
+/**
+ * Record the error returned by a check method for some object, if field errors are currently recorded for it on the 
+ * current thread (see -check:fieldErrors:)
+ */
+static void recordFieldError(id object, SEL sel, NSError *error)
+{
+    if (s_numberOfFieldErrorRecordersInUse == 0 || ! error) {
+        return;
+    }
+    
+    CFDictionaryRef fieldErrorRecorder = (CFDictionaryRef)[[[NSThread currentThread] threadDictionary] objectForKey:HLSValidationFieldErrorsThreadLocalStorageKey];
+    if (! fieldErrorRecorder) {
+        return;
+    }
+    
+    NSMutableDictionary *validationSelectorNameToErrorMap = (NSMutableDictionary *)CFDictionaryGetValue(fieldErrorRecorder, object);
+    [validationSelectorNameToErrorMap setObject:error forKey:NSStringFromSelector(sel)];
+}
+
+/**
+ * Return the name of the validation selector Core Data calls for a given key (-validate<Key>:error:)
+ */
+static NSString *validationSelectorNameForKey(NSString *key)
+{
+    if ([key length] == 0) {
+        return nil;
+    }
+    
+    return [NSString stringWithFormat:@"validate%@%@:error:", [[key substringToIndex:1] uppercaseString], [key substringFromIndex:1]];
+}
+
 #pragma mark Validation
 
 /**
@@ -325,22 +786,40 @@ static SEL checkSelectorForValidationSelector(SEL sel)
 static BOOL validateProperty(id self, SEL sel, id *pValue, NSError **pError)
 {
     // If the check method does not exist, the field is valid
-    SEL checkSel = checkSelectorForValidationSelector(sel);
-    Method method = class_getInstanceMethod([self class], checkSel);
-    if (! method) {
+    HLSValidationCheck check = validationCheckForClass([self class], sel, YES);
+    if (! check.checkImp) {
         return YES;
     }
     
+    // Use the result computed in advance for the same value if available (warnings have already been logged when it 
+    // was computed)
+    id value = pValue ? *pValue : nil;
+    id precomputedResult = precomputedFieldCheckResult(self, sel, value);
+    if (precomputedResult) {
+        if (precomputedResult == (id)kCFNull) {
+            return YES;
+        }
+        
+        NSError *newError = [precomputedResult isKindOfClass:[NSError class]] ? precomputedResult : nil;
+        if (! newError) {
+            HLSLoggerWarn(@"The %s method returns NO but no error. The method implementation is incorrect", (char *)check.checkSel);
+        }
+        recordFieldError(self, sel, newError);
+        [NSManagedObject combineError:newError withError:pError];
+        return NO;
+    }
+    
     // Get the check method implementation
-    BOOL (*checkImp)(id, SEL, id, NSError **) = (BOOL (*)(id, SEL, id, NSError **))method_getImplementation(method);
+    SEL checkSel = check.checkSel;
+    BOOL (*checkImp)(id, SEL, id, NSError **) = (BOOL (*)(id, SEL, id, NSError **))check.checkImp;
     
     // Check
     NSError *newError = nil;
-    id value = pValue ? *pValue : nil;
     if (! (*checkImp)(self, checkSel, value, &newError)) {
         if (! newError) {
             HLSLoggerWarn(@"The %s method returns NO but no error. The method implementation is incorrect", (char *)checkSel);
         }
+        recordFieldError(self, sel, newError);
         [NSManagedObject combineError:newError withError:pError];
         return NO;
     }
@@ -405,14 +884,14 @@ static BOOL validateObjectConsistencyInClassHierarchy(id self, Class class, SEL
         
         // Find whether a check method has been defined at this class hierarchy level. If none is found, valid 
         // (i.e. we do not alter the above validation status)
-        SEL checkSel = checkSelectorForValidationSelector(sel);
-        Method method = instanceMethodOnClass(class, checkSel);
-        if (! method) {
+        HLSValidationCheck check = validationCheckForClass(class, sel, NO);
+        if (! check.checkImp) {
             return valid;
         }
         
         // A check method has been found. Call the underlying check method implementation
-        BOOL (*checkImp)(id, SEL, NSError **) = (BOOL (*)(id, SEL, NSError **))method_getImplementation(method);
+        SEL checkSel = check.checkSel;
+        BOOL (*checkImp)(id, SEL, NSError **) = (BOOL (*)(id, SEL, NSError **))check.checkImp;
         NSError *newCheckError = nil;
         if (! (*checkImp)(self, checkSel, &newCheckError)) {
             if (! newCheckError) {
@@ -479,8 +958,9 @@ static void swizzled_NSManagedObject__initialize_Imp(Class self, SEL _cmd)
         //   - (BOOL)validate<fieldName>:(id *)pValue error:(NSError **)pError
         NSString *validationSelectorName = [NSString stringWithFormat:@"validate%@%@:error:", [[propertyName substringToIndex:1] uppercaseString], 
                                             [propertyName substringFromIndex:1]];
+        SEL validationSel = NSSelectorFromString(validationSelectorName);
         if (! class_addMethod(self, 
-                              NSSelectorFromString(validationSelectorName),         // Remark: (SEL)[validationSelectorName cStringUsingEncoding:NSUTF8StringEncoding] 
+                              validationSel,         // Remark: (SEL)[validationSelectorName cStringUsingEncoding:NSUTF8StringEncoding] 
                               // does NOT work (returns YES, but IMP does not get called since the selector has not 
                               // been properly registered in this case)
                               (IMP)validateProperty, 
@@ -491,6 +971,9 @@ static void swizzled_NSManagedObject__initialize_Imp(Class self, SEL _cmd)
         
         HLSLoggerDebug(@"Automatically added validation wrapper %@ on class %@", validationSelectorName, self);
         
+        // Build the check method lookup table for the class once
+        validationCheckForClass(self, validationSel, YES);
+        
         added = YES;
     }
     free(properties);
@@ -515,5 +998,9 @@ static void swizzled_NSManagedObject__initialize_Imp(Class self, SEL _cmd)
                               "c@:@")) {
             HLSLoggerError(@"Failed to add validateForDelete: method dynamically");
         }
+        
+        validationCheckForClass(self, @selector(validateForInsert:), NO);
+        validationCheckForClass(self, @selector(validateForUpdate:), NO);
+        validationCheckForClass(self, @selector(validateForDelete:), NO);
     }    
 }
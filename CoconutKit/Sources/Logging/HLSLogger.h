@@ -8,24 +8,105 @@
 
 /**
  * Logging macros. Only active if HLS_LOGGER is added to your configuration preprocessor flags (-DHLS_LOGGER)
+ *
+ * The logger level is checked before the message is formatted, i.e. arguments are not evaluated for messages which
+ * are not logged. Moreover, calls below a minimum level can be stripped off at compile time by adding the
+ * HLS_LOGGER_MINIMUM_LEVEL preprocessor flag with one of the HLS_LOGGER_LEVEL_... values below to your configuration
+ * (e.g. -DHLS_LOGGER_MINIMUM_LEVEL=HLS_LOGGER_LEVEL_WARN for a release build keeping warnings and errors only)
+ *
+ * The HLSLoggerCategory... macros log messages in a named category (e.g. @"Tasks"), whose level can be set independently
+ * of the logger level, and changed at any time (see HLSLogger class documentation). The category is looked up once per
+ * call site, the level check then boils down to a single memory load
  */
+#define HLS_LOGGER_LEVEL_DEBUG          0
+#define HLS_LOGGER_LEVEL_INFO           1
+#define HLS_LOGGER_LEVEL_WARN           2
+#define HLS_LOGGER_LEVEL_ERROR          3
+#define HLS_LOGGER_LEVEL_FATAL          4
+
+#ifndef HLS_LOGGER_MINIMUM_LEVEL
+#define HLS_LOGGER_MINIMUM_LEVEL        HLS_LOGGER_LEVEL_DEBUG
+#endif
+
 #ifdef HLS_LOGGER
 
 // Note the ## in front of __VA_ARGS__ to support 0 variable arguments
-#define HLSLoggerDebug(format, ...)	[[HLSLogger sharedLogger] debug:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]
-#define HLSLoggerInfo(format, ...)	[[HLSLogger sharedLogger] info:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]
-#define HLSLoggerWarn(format, ...)	[[HLSLogger sharedLogger] warn:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]
-#define HLSLoggerError(format, ...)	[[HLSLogger sharedLogger] error:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]
-#define HLSLoggerFatal(format, ...)	[[HLSLogger sharedLogger] fatal:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]
+#define HLSLoggerLog(levelTester, logMethod, format, ...)                                                                       \
+    do {                                                                                                                        \
+        HLSLogger *hls_logger_ = [HLSLogger sharedLogger];                                                                      \
+        if ([hls_logger_ levelTester]) {                                                                                        \
+            [hls_logger_ logMethod:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]]]; \
+        }                                                                                                                       \
+    } while (0)
 
-#else
+// Categories are never destroyed, the pointer can therefore be cached in a static variable. Several threads might
+// race to initialize it, but they all get the same category
+#define HLSLoggerCategoryLog(categoryName, loggerLevel, format, ...)                                                            \
+    do {                                                                                                                        \
+        static HLSLoggerCategory *hls_logger_category_ = NULL;                                                                  \
+        if (! hls_logger_category_) {                                                                                           \
+            hls_logger_category_ = [[HLSLogger sharedLogger] categoryNamed:categoryName];                                       \
+        }                                                                                                                       \
+        if (hls_logger_category_->level <= loggerLevel) {                                                                       \
+            [[HLSLogger sharedLogger] logMessage:[NSString stringWithFormat:@"(%s) - %@", __PRETTY_FUNCTION__, [NSString stringWithFormat:format, ## __VA_ARGS__]] \
+                                           level:loggerLevel                                                                    \
+                                        category:hls_logger_category_];                                                         \
+        }                                                                                                                       \
+    } while (0)
 
+#if HLS_LOGGER_MINIMUM_LEVEL <= HLS_LOGGER_LEVEL_DEBUG
+#define HLSLoggerDebug(format, ...)	HLSLoggerLog(isDebug, debug, format, ## __VA_ARGS__)
+#define HLSLoggerCategoryDebug(category, format, ...)   HLSLoggerCategoryLog(category, HLSLoggerLevelDebug, format, ## __VA_ARGS__)
+#endif
+#if HLS_LOGGER_MINIMUM_LEVEL <= HLS_LOGGER_LEVEL_INFO
+#define HLSLoggerInfo(format, ...)	HLSLoggerLog(isInfo, info, format, ## __VA_ARGS__)
+#define HLSLoggerCategoryInfo(category, format, ...)    HLSLoggerCategoryLog(category, HLSLoggerLevelInfo, format, ## __VA_ARGS__)
+#endif
+#if HLS_LOGGER_MINIMUM_LEVEL <= HLS_LOGGER_LEVEL_WARN
+#define HLSLoggerWarn(format, ...)	HLSLoggerLog(isWarn, warn, format, ## __VA_ARGS__)
+#define HLSLoggerCategoryWarn(category, format, ...)    HLSLoggerCategoryLog(category, HLSLoggerLevelWarn, format, ## __VA_ARGS__)
+#endif
+#if HLS_LOGGER_MINIMUM_LEVEL <= HLS_LOGGER_LEVEL_ERROR
+#define HLSLoggerError(format, ...)	HLSLoggerLog(isError, error, format, ## __VA_ARGS__)
+#define HLSLoggerCategoryError(category, format, ...)   HLSLoggerCategoryLog(category, HLSLoggerLevelError, format, ## __VA_ARGS__)
+#endif
+#if HLS_LOGGER_MINIMUM_LEVEL <= HLS_LOGGER_LEVEL_FATAL
+#define HLSLoggerFatal(format, ...)	HLSLoggerLog(isFatal, fatal, format, ## __VA_ARGS__)
+#define HLSLoggerCategoryFatal(category, format, ...)   HLSLoggerCategoryLog(category, HLSLoggerLevelFatal, format, ## __VA_ARGS__)
+#endif
+
+#endif
+
+// Disabled macros (logging disabled or level stripped off at compile time)
+#ifndef HLSLoggerDebug
 #define HLSLoggerDebug(format, ...)
+#endif
+#ifndef HLSLoggerInfo
 #define HLSLoggerInfo(format, ...)
+#endif
+#ifndef HLSLoggerWarn
 #define HLSLoggerWarn(format, ...)
+#endif
+#ifndef HLSLoggerError
 #define HLSLoggerError(format, ...)
+#endif
+#ifndef HLSLoggerFatal
 #define HLSLoggerFatal(format, ...)
-
+#endif
+#ifndef HLSLoggerCategoryDebug
+#define HLSLoggerCategoryDebug(category, format, ...)
+#endif
+#ifndef HLSLoggerCategoryInfo
+#define HLSLoggerCategoryInfo(category, format, ...)
+#endif
+#ifndef HLSLoggerCategoryWarn
+#define HLSLoggerCategoryWarn(category, format, ...)
+#endif
+#ifndef HLSLoggerCategoryError
+#define HLSLoggerCategoryError(category, format, ...)
+#endif
+#ifndef HLSLoggerCategoryFatal
+#define HLSLoggerCategoryFatal(category, format, ...)
 #endif
 
 /**
@@ -46,6 +127,18 @@ typedef enum {
     HLSLoggerLevelEnumSize = HLSLoggerLevelEnumEnd - HLSLoggerLevelEnumBegin
 } HLSLoggerLevel;
 
+/**
+ * Logging category. Created by the logger and never destroyed. Should never be accessed directly, use the macros
+ * and the HLSLogger category methods instead
+ */
+typedef struct {
+    volatile int32_t level;         // Effective level
+    int32_t explicitLevel;          // -1 if the logger level applies
+    NSString *name;
+} HLSLoggerCategory;
+
+@class HLSLoggerFileSink;
+
 /**
  * Basic logging facility writing to the console. Thread-safe
  *
@@ -58,6 +151,24 @@ typedef enum {
  *   - add an HLSLoggerLevel setting to your project main .plist file, with one of the following values (DEBUG, INFO,
  *     WARN, ERROR or FATAL). This sets the logging level to apply
  *
+ * By default, messages are written synchronously on the calling thread. Since logging might happen on hot paths (even
+ * on the main thread), logging can be made asynchronous, either by setting the asynchronous property or by adding an
+ * HLSLoggerAsynchronous boolean setting with value YES to your project main .plist file. Messages are then stored into
+ * a fixed-size buffer (lock-free for callers) and written in batches on a background thread. If messages are logged
+ * faster than they can be written, the buffer overflows and subsequent messages are dropped (the number of dropped
+ * messages is logged as soon as possible). Fatal messages are always written before the logging method returns.
+ * Call -flush to ensure all pending messages have been written, e.g. from an uncaught exception handler
+ *
+ * Messages logged with the HLSLoggerCategory... macros belong to a named category. By default, a category inherits the
+ * logger level, but its level can be set independently, and changed at any time (e.g. to enable detailed tracing of
+ * a single subsystem from a remote configuration). Category levels can also be set for the shared logger by adding an
+ * HLSLoggerCategoryLevels dictionary setting to your project main .plist file, whose keys are category names and
+ * values level names. Remark that setting a category level does not affect messages logged without category
+ *
+ * Messages can also be written to rotating log files for field diagnostics, by attaching a file sink to the logger
+ * (see HLSLoggerFileSink). For the shared logger, simply add an HLSLoggerFileLogging boolean setting with value YES
+ * to your project main .plist file. Log files are then written into the Library/Caches/HLSLogger directory
+ *
  * HLSLogger supports XcodeColors (see https://github.com/robbiehanson/XcodeColors for the active fork), an Xcode plugin
  * adding colors to the Xcode debugging console. Simply install the plugin and set an environment variable called 
  * 'XcodeColors' to YES to enable it for your project.
@@ -66,7 +177,17 @@ typedef enum {
  */
 @interface HLSLogger : NSObject {
 @private
-	HLSLoggerLevel m_level;
+	volatile HLSLoggerLevel m_level;
+    CFMutableDictionaryRef m_categories;            // Category names to HLSLoggerCategory pointers (owned)
+    BOOL m_asynchronous;
+    struct HLSLoggerRecord *m_records;              // Ring buffer (asynchronous mode)
+    volatile int32_t m_writeIndex;                  // Next record to fill (incremented by producers)
+    volatile int32_t m_readIndex;                   // Next record to write (incremented by the consumer only)
+    volatile int32_t m_nbrDroppedMessages;
+    volatile int32_t m_nbrLoggedMessages;
+    dispatch_queue_t m_queue;
+    dispatch_source_t m_source;
+    HLSLoggerFileSink *m_fileSink;
 }
 
 /**
@@ -76,6 +197,54 @@ typedef enum {
 
 - (id)initWithLevel:(HLSLoggerLevel)level;
 
+/**
+ * The logger level. Can be changed at any time. Categories whose level has not been set inherit it
+ */
+@property (assign) HLSLoggerLevel level;
+
+/**
+ * Set the level of a category, respectively reset it so that the category inherits the logger level again
+ */
+- (void)setLevel:(HLSLoggerLevel)level forCategory:(NSString *)categoryName;
+- (void)resetLevelForCategory:(NSString *)categoryName;
+
+/**
+ * Set the levels of several categories at once. Keys are category names, values level names (DEBUG, INFO, WARN,
+ * ERROR, FATAL or NONE), or NSNull to reset a category level
+ */
+- (void)setCategoryLevelsWithDictionary:(NSDictionary *)dictionary;
+
+/**
+ * The effective level of a category
+ */
+- (HLSLoggerLevel)levelForCategory:(NSString *)categoryName;
+
+/**
+ * Set to YES to write messages asynchronously (see class documentation)
+ *
+ * Default value is NO, or the HLSLoggerAsynchronous main .plist setting for the shared logger
+ */
+@property (nonatomic, assign, getter=isAsynchronous) BOOL asynchronous;
+
+/**
+ * If not nil, messages are also written to the specified sink, with a timestamp
+ *
+ * Default value is nil, or a sink writing into Library/Caches/HLSLogger if the HLSLoggerFileLogging main .plist
+ * setting is YES for the shared logger
+ */
+@property (retain) HLSLoggerFileSink *fileSink;
+
+/**
+ * Synchronously write all pending messages (in asynchronous mode), and flush the file sink if any
+ */
+- (void)flush;
+
+/**
+ * The number of messages logged since the logger was created (including messages dropped in asynchronous mode). Sample
+ * it at regular intervals to measure the logging throughput
+ */
+- (NSUInteger)loggedMessageCount;
+
 /**
  * Logging functions; should never be called directly, use the macros instead
  */
@@ -85,6 +254,12 @@ typedef enum {
 - (void)error:(NSString *)message;
 - (void)fatal:(NSString *)message;
 
+/**
+ * Category logging functions; should never be called directly, use the macros instead
+ */
+- (HLSLoggerCategory *)categoryNamed:(NSString *)categoryName;
+- (void)logMessage:(NSString *)message level:(HLSLoggerLevel)level category:(HLSLoggerCategory *)category;
+
 /**
  * Level testers
  */
@@ -8,6 +8,12 @@
 
 #import "HLSLogger.h"
 
+#import <libkern/OSAtomic.h>
+#import <sched.h>
+#import <sys/time.h>
+#import "HLSLoggerFileSink.h"
+#import "HLSStartupReport.h"
+
 #pragma mark -
 #pragma mark HLSLoggerMode struct
 
@@ -23,12 +29,40 @@ static const HLSLoggerMode kLoggerModeWarn = {@"WARN", 2, @"255,120,0"};
 static const HLSLoggerMode kLoggerModeError = {@"ERROR", 3, @"255,0,0"};
 static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 
+static HLSLoggerMode HLSLoggerModeForLevel(HLSLoggerLevel level);
+static HLSLoggerLevel HLSLoggerLevelForName(NSString *levelName);
+
+#pragma mark -
+#pragma mark HLSLoggerRecord struct
+
+// Must be a power of two, so that record indices can safely wrap around
+static const uint32_t kLoggerBufferCapacity = 1024;
+
+struct HLSLoggerRecord {
+    volatile int32_t ready;         // Set by the producer when the record has been filled
+    HLSLoggerMode mode;
+    NSString *message;              // Retained
+};
+
+#pragma mark -
+#pragma mark File sink settings (shared logger)
+
+static const unsigned long long kLoggerFileSegmentSize = 512 * 1024;
+static const NSUInteger kLoggerFileMaximumSegmentCount = 4;
+static const NSUInteger kLoggerFileTailSize = 64 * 1024;
+
 #pragma mark -
 #pragma mark HLSLogger class
 
 @interface HLSLogger ()
 
 - (void)logMessage:(NSString *)message forMode:(HLSLoggerMode)mode;
+- (void)writeMessage:(NSString *)message forMode:(HLSLoggerMode)mode;
+
+- (void)enqueueMessage:(NSString *)message forMode:(HLSLoggerMode)mode;
+- (void)writePendingMessages;
+
+- (void)setExplicitLevel:(int32_t)explicitLevel forCategory:(NSString *)categoryName;
 
 @end
 
@@ -44,31 +78,33 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 	if (! s_instance) {
         @synchronized(self) {
             if (! s_instance) {
+                CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+                
                 // Read the main .plist file content
                 NSDictionary *infoProperties = [[NSBundle mainBundle] infoDictionary];
                 
                 // Create a logger with the corresponding level
-                NSString *levelName = [infoProperties valueForKey:@"HLSLoggerLevel"];
-                HLSLoggerLevel level;
-                if ([levelName isEqualToString:kLoggerModeDebug.name]) {
-                    level = HLSLoggerLevelDebug;
-                }
-                else if ([levelName isEqualToString:kLoggerModeInfo.name]) {
-                    level = HLSLoggerLevelInfo;		
-                }
-                else if ([levelName isEqualToString:kLoggerModeWarn.name]) {
-                    level = HLSLoggerLevelWarn;
-                }
-                else if ([levelName isEqualToString:kLoggerModeError.name]) {
-                    level = HLSLoggerLevelError;
-                }
-                else if ([levelName isEqualToString:kLoggerModeFatal.name]) {
-                    level = HLSLoggerLevelFatal;
+                HLSLoggerLevel level = HLSLoggerLevelForName([infoProperties valueForKey:@"HLSLoggerLevel"]);
+                s_instance = [[HLSLogger alloc] initWithLevel:level];
+                
+                NSDictionary *categoryLevels = [infoProperties valueForKey:@"HLSLoggerCategoryLevels"];
+                if ([categoryLevels isKindOfClass:[NSDictionary class]]) {
+                    [s_instance setCategoryLevelsWithDictionary:categoryLevels];
                 }
-                else {
-                    level = HLSLoggerLevelNone;
+                
+                s_instance.asynchronous = [[infoProperties valueForKey:@"HLSLoggerAsynchronous"] boolValue];
+                
+                if ([[infoProperties valueForKey:@"HLSLoggerFileLogging"] boolValue]) {
+                    NSString *cachesDirectoryPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+                    NSString *directoryPath = [cachesDirectoryPath stringByAppendingPathComponent:@"HLSLogger"];
+                    HLSLoggerFileSink *fileSink = [[[HLSLoggerFileSink alloc] initWithDirectoryPath:directoryPath
+                                                                                         segmentSize:kLoggerFileSegmentSize
+                                                                                 maximumSegmentCount:kLoggerFileMaximumSegmentCount
+                                                                                            tailSize:kLoggerFileTailSize] autorelease];
+                    s_instance.fileSink = fileSink;
                 }
-                s_instance = [[HLSLogger alloc] initWithLevel:level];                
+                
+                HLSStartupReportRecord("HLSLogger", startTime);
             }
         }
 	}
@@ -81,6 +117,7 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 {
 	if ((self = [super init])) {
 		m_level = level;
+        m_categories = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
 	}
 	return self;
 }
@@ -90,6 +127,107 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 	return [self initWithLevel:HLSLoggerLevelNone];
 }
 
+- (void)dealloc
+{
+    if (m_records) {
+        // Cancel the source first, so that no event handler can be called after the pending messages have been written
+        dispatch_source_cancel(m_source);
+        [self flush];
+        
+        dispatch_release(m_source);
+        dispatch_release(m_queue);
+        free(m_records);
+    }
+    
+    [m_fileSink flush];
+    self.fileSink = nil;
+    
+    CFIndex nbrCategories = CFDictionaryGetCount(m_categories);
+    HLSLoggerCategory **categories = malloc(nbrCategories * sizeof(HLSLoggerCategory *));
+    CFDictionaryGetKeysAndValues(m_categories, NULL, (const void **)categories);
+    for (CFIndex i = 0; i < nbrCategories; ++i) {
+        [categories[i]->name release];
+        free(categories[i]);
+    }
+    free(categories);
+    CFRelease(m_categories);
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize fileSink = m_fileSink;
+
+- (HLSLoggerLevel)level
+{
+    return m_level;
+}
+
+- (void)setLevel:(HLSLoggerLevel)level
+{
+    @synchronized(self) {
+        m_level = level;
+        
+        // Update categories inheriting the logger level
+        CFIndex nbrCategories = CFDictionaryGetCount(m_categories);
+        HLSLoggerCategory **categories = malloc(nbrCategories * sizeof(HLSLoggerCategory *));
+        CFDictionaryGetKeysAndValues(m_categories, NULL, (const void **)categories);
+        for (CFIndex i = 0; i < nbrCategories; ++i) {
+            if (categories[i]->explicitLevel == -1) {
+                categories[i]->level = level;
+            }
+        }
+        free(categories);
+        OSMemoryBarrier();
+    }
+}
+
+- (BOOL)isAsynchronous
+{
+    return m_asynchronous;
+}
+
+- (void)setAsynchronous:(BOOL)asynchronous
+{
+    @synchronized(self) {
+        if (m_asynchronous == asynchronous) {
+            return;
+        }
+        
+        if (asynchronous) {
+            // Created once and kept until the logger is deallocated, so that callers which have just seen the
+            // asynchronous flag can always safely enqueue messages, even if the flag is being reset
+            if (! m_records) {
+                m_records = calloc(kLoggerBufferCapacity, sizeof(struct HLSLoggerRecord));
+                
+                // Producers only signal the source (signals are coalesced), pending messages are written in batches on
+                // a low priority serial queue. Not retaining self (__block) to avoid a retain cycle
+                m_queue = dispatch_queue_create("ch.hortis.CoconutKit.logger", NULL);
+                dispatch_set_target_queue(m_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+                m_source = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_ADD, 0, 0, m_queue);
+                __block HLSLogger *logger = self;
+                dispatch_source_set_event_handler(m_source, ^{
+                    [logger writePendingMessages];
+                });
+                dispatch_resume(m_source);
+            }
+            
+            OSMemoryBarrier();
+            m_asynchronous = YES;
+        }
+        else {
+            m_asynchronous = NO;
+            OSMemoryBarrier();
+            
+            // Write messages still pending
+            dispatch_sync(m_queue, ^{
+                [self writePendingMessages];
+            });
+        }
+    }
+}
+
 #pragma mark Logging methods
 
 - (void)logMessage:(NSString *)message forMode:(HLSLoggerMode)mode
@@ -97,7 +235,24 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 	if (m_level > mode.level) {
 		return;
 	}
+    
+    OSAtomicIncrement32(&m_nbrLoggedMessages);
+    
+    if (m_asynchronous) {
+        [self enqueueMessage:message forMode:mode];
+    }
+    else {
+        [self writeMessage:message forMode:mode];
+    }
+    
+    // Fatal messages are likely to be followed by a crash
+    if (mode.level == kLoggerModeFatal.level) {
+        [self flush];
+    }
+}
 
+- (void)writeMessage:(NSString *)message forMode:(HLSLoggerMode)mode
+{
     static BOOL s_configurationLoaded = NO;
     static BOOL s_xcodeColorsEnabled = NO;
     if (! s_configurationLoaded) {
@@ -114,6 +269,182 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
     else {
         NSLog(@"%@", fullLogEntry);
     }
+    
+    // NSLog already adds a timestamp to console entries, add one to file entries as well
+    HLSLoggerFileSink *fileSink = self.fileSink;
+    if (fileSink) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        struct tm localNow;
+        localtime_r(&now.tv_sec, &localNow);
+        char timestamp[32];
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &localNow);
+        [fileSink writeLine:[NSString stringWithFormat:@"%s.%03d %@", timestamp, (int)(now.tv_usec / 1000), fullLogEntry]];
+    }
+}
+
+#pragma mark Categories
+
+- (HLSLoggerCategory *)categoryNamed:(NSString *)categoryName
+{
+    if (! categoryName) {
+        categoryName = @"";
+    }
+    
+    @synchronized(self) {
+        HLSLoggerCategory *category = (HLSLoggerCategory *)CFDictionaryGetValue(m_categories, categoryName);
+        if (! category) {
+            category = malloc(sizeof(HLSLoggerCategory));
+            category->level = m_level;
+            category->explicitLevel = -1;
+            category->name = [categoryName copy];
+            CFDictionarySetValue(m_categories, category->name, category);
+        }
+        return category;
+    }
+}
+
+- (void)setExplicitLevel:(int32_t)explicitLevel forCategory:(NSString *)categoryName
+{
+    HLSLoggerCategory *category = [self categoryNamed:categoryName];
+    @synchronized(self) {
+        category->explicitLevel = explicitLevel;
+        category->level = (explicitLevel == -1) ? m_level : explicitLevel;
+        OSMemoryBarrier();
+    }
+}
+
+- (void)setLevel:(HLSLoggerLevel)level forCategory:(NSString *)categoryName
+{
+    [self setExplicitLevel:level forCategory:categoryName];
+}
+
+- (void)resetLevelForCategory:(NSString *)categoryName
+{
+    [self setExplicitLevel:-1 forCategory:categoryName];
+}
+
+- (void)setCategoryLevelsWithDictionary:(NSDictionary *)dictionary
+{
+    for (NSString *categoryName in [dictionary allKeys]) {
+        id levelName = [dictionary objectForKey:categoryName];
+        if ([levelName isKindOfClass:[NSNull class]]) {
+            [self resetLevelForCategory:categoryName];
+        }
+        else if ([levelName isKindOfClass:[NSString class]]) {
+            [self setLevel:HLSLoggerLevelForName(levelName) forCategory:categoryName];
+        }
+    }
+}
+
+- (HLSLoggerLevel)levelForCategory:(NSString *)categoryName
+{
+    return [self categoryNamed:categoryName]->level;
+}
+
+- (void)logMessage:(NSString *)message level:(HLSLoggerLevel)level category:(HLSLoggerCategory *)category
+{
+    if (category->level > level) {
+        return;
+    }
+    
+    OSAtomicIncrement32(&m_nbrLoggedMessages);
+    
+    // Bypass the logger level check, only the category level applies
+    HLSLoggerMode mode = HLSLoggerModeForLevel(level);
+    NSString *categoryMessage = [NSString stringWithFormat:@"[%@] %@", category->name, message];
+    if (m_asynchronous) {
+        [self enqueueMessage:categoryMessage forMode:mode];
+    }
+    else {
+        [self writeMessage:categoryMessage forMode:mode];
+    }
+    
+    if (mode.level == kLoggerModeFatal.level) {
+        [self flush];
+    }
+}
+
+#pragma mark Asynchronous logging
+
+- (void)enqueueMessage:(NSString *)message forMode:(HLSLoggerMode)mode
+{
+    // Reserve a record. Since records are freed by the consumer before it increments the read index, a record
+    // whose index is less than kLoggerBufferCapacity ahead of the read index is always free. Indices wrap around, and
+    // are therefore only compared and incremented as unsigned integers
+    int32_t writeIndex;
+    do {
+        writeIndex = m_writeIndex;
+        if ((uint32_t)writeIndex - (uint32_t)m_readIndex >= kLoggerBufferCapacity) {
+            // Saturate so that the count reported with the next batch cannot wrap
+            int32_t nbrDroppedMessages;
+            do {
+                nbrDroppedMessages = m_nbrDroppedMessages;
+                if (nbrDroppedMessages == INT32_MAX) {
+                    break;
+                }
+            } while (! OSAtomicCompareAndSwap32Barrier(nbrDroppedMessages, nbrDroppedMessages + 1, &m_nbrDroppedMessages));
+            return;
+        }
+    } while (! OSAtomicCompareAndSwap32Barrier(writeIndex, (int32_t)((uint32_t)writeIndex + 1), &m_writeIndex));
+    
+    struct HLSLoggerRecord *record = &m_records[(uint32_t)writeIndex % kLoggerBufferCapacity];
+    record->mode = mode;
+    record->message = [message copy];
+    OSMemoryBarrier();
+    record->ready = 1;
+    
+    dispatch_source_merge_data(m_source, 1);
+}
+
+// Must only be called on the logging queue, which is the only consumer
+- (void)writePendingMessages
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    
+    int32_t nbrDroppedMessages = m_nbrDroppedMessages;
+    if (nbrDroppedMessages != 0) {
+        OSAtomicAdd32Barrier(-nbrDroppedMessages, &m_nbrDroppedMessages);
+        [self writeMessage:[NSString stringWithFormat:@"(HLSLogger) - %d messages dropped (buffer full)", nbrDroppedMessages]
+                   forMode:kLoggerModeWarn];
+    }
+    
+    while (m_readIndex != m_writeIndex) {
+        struct HLSLoggerRecord *record = &m_records[(uint32_t)m_readIndex % kLoggerBufferCapacity];
+        
+        // The record has been reserved, but its producer might not have finished filling it yet
+        while (! record->ready) {
+            sched_yield();
+        }
+        OSMemoryBarrier();
+        
+        [self writeMessage:record->message forMode:record->mode];
+        [record->message release];
+        record->message = nil;
+        record->ready = 0;
+        
+        OSMemoryBarrier();
+        m_readIndex = (int32_t)((uint32_t)m_readIndex + 1);
+    }
+    
+    [pool drain];
+}
+
+- (void)flush
+{
+    // The queue is never released while the logger is alive
+    if (m_queue) {
+        dispatch_sync(m_queue, ^{
+            [self writePendingMessages];
+        });
+    }
+    
+    [self.fileSink flush];
+}
+
+- (NSUInteger)loggedMessageCount
+{
+    return (NSUInteger)m_nbrLoggedMessages;
 }
 
 - (void)debug:(NSString *)message
@@ -169,3 +500,53 @@ static const HLSLoggerMode kLoggerModeFatal = {@"FATAL", 4, @"255,0,0"};
 }
 
 @end
+
+#pragma mark -
+#pragma mark Helper functions
+
+static HLSLoggerMode HLSLoggerModeForLevel(HLSLoggerLevel level)
+{
+    switch (level) {
+        case HLSLoggerLevelDebug: {
+            return kLoggerModeDebug;
+        }
+            
+        case HLSLoggerLevelInfo: {
+            return kLoggerModeInfo;
+        }
+            
+        case HLSLoggerLevelWarn: {
+            return kLoggerModeWarn;
+        }
+            
+        case HLSLoggerLevelError: {
+            return kLoggerModeError;
+        }
+            
+        default: {
+            return kLoggerModeFatal;
+        }
+    }
+}
+
+static HLSLoggerLevel HLSLoggerLevelForName(NSString *levelName)
+{
+    if ([levelName isEqualToString:kLoggerModeDebug.name]) {
+        return HLSLoggerLevelDebug;
+    }
+    else if ([levelName isEqualToString:kLoggerModeInfo.name]) {
+        return HLSLoggerLevelInfo;
+    }
+    else if ([levelName isEqualToString:kLoggerModeWarn.name]) {
+        return HLSLoggerLevelWarn;
+    }
+    else if ([levelName isEqualToString:kLoggerModeError.name]) {
+        return HLSLoggerLevelError;
+    }
+    else if ([levelName isEqualToString:kLoggerModeFatal.name]) {
+        return HLSLoggerLevelFatal;
+    }
+    else {
+        return HLSLoggerLevelNone;
+    }
+}
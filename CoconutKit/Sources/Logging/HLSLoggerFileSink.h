@@ -0,0 +1,91 @@
+//
+//  HLSLoggerFileSink.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import <pthread.h>
+
+/**
+ * A file sink writes log lines into a directory, for later field diagnostics. Attach it to a logger using the
+ * HLSLogger fileSink property.
+ *
+ * Lines are appended to a current segment file. When a segment reaches its maximum size, the sink rotates segments
+ * (the current segment becomes the first older segment, and so on), keeping at most maximumSegmentCount files. Lines
+ * are buffered in memory and written in batches, and the file is synchronized to disk (fsync) at most every
+ * synchronizationInterval seconds. Buffered lines are always written within that interval, even if nothing is logged
+ * afterwards.
+ *
+ * Since buffered lines would be lost if the application crashes, the last tailSize bytes are also copied into a
+ * memory-mapped tail file as they are logged. Pages of this file are written back by the system even if the process
+ * crashes, so that the tail of the previous run (which might contain the lines logged right before a crash) can be
+ * retrieved when the sink is created again for the same directory.
+ *
+ * This class is thread-safe.
+ *
+ * Designated initializer: -initWithDirectoryPath:segmentSize:maximumSegmentCount:tailSize:
+ */
+@interface HLSLoggerFileSink : NSObject {
+@private
+    NSString *m_directoryPath;
+    unsigned long long m_segmentSize;
+    NSUInteger m_maximumSegmentCount;
+    NSUInteger m_tailSize;
+    NSTimeInterval m_synchronizationInterval;
+    int m_fileDescriptor;
+    unsigned long long m_currentSegmentSize;
+    NSMutableData *m_buffer;
+    CFAbsoluteTime m_lastSynchronizationDate;
+    BOOL m_flushScheduled;
+    uint8_t *m_tail;
+    NSString *m_previousTail;
+    pthread_mutex_t m_mutex;
+}
+
+/**
+ * Create a sink writing segments of the given maximum size (in bytes) into the specified directory, created if it
+ * does not exist. Set tailSize to 0 to disable the crash-safe tail. Return nil if the directory cannot be created
+ * or the current segment cannot be opened
+ */
+- (id)initWithDirectoryPath:(NSString *)directoryPath
+                segmentSize:(unsigned long long)segmentSize
+        maximumSegmentCount:(NSUInteger)maximumSegmentCount
+                   tailSize:(NSUInteger)tailSize;
+
+@property (nonatomic, readonly, retain) NSString *directoryPath;
+@property (nonatomic, readonly, assign) unsigned long long segmentSize;
+@property (nonatomic, readonly, assign) NSUInteger maximumSegmentCount;
+@property (nonatomic, readonly, assign) NSUInteger tailSize;
+
+/**
+ * Maximum interval between two synchronizations to disk
+ *
+ * Default value is 5 seconds
+ */
+@property (nonatomic, assign) NSTimeInterval synchronizationInterval;
+
+/**
+ * Append a line (a line break is added)
+ */
+- (void)writeLine:(NSString *)line;
+
+/**
+ * Write buffered lines and synchronize the current segment to disk
+ */
+- (void)flush;
+
+/**
+ * The paths of the segment files, the current segment first
+ */
+- (NSArray *)segmentPaths;
+
+/**
+ * The last logged lines (at most tailSize bytes), respectively those of the previous run (nil if none). Lines might
+ * be truncated at the beginning
+ */
+- (NSString *)tail;
+@property (nonatomic, readonly, retain) NSString *previousTail;
+
+@end
@@ -0,0 +1,388 @@
+//
+//  HLSLoggerFileSink.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSLoggerFileSink.h"
+
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+#import "HLSAssert.h"
+
+// Remark: Errors are reported using NSLog, since the sink is called by HLSLogger itself
+
+static NSString * const kSegmentFileBaseName = @"HLSLogger";
+static NSString * const kSegmentFileExtension = @"log";
+static NSString * const kTailFileName = @"HLSLogger.tail";
+
+static const NSUInteger kBufferSize = 16 * 1024;
+
+// Header of the memory-mapped tail file, followed by the tail ring buffer
+typedef struct {
+    uint32_t magic;
+    uint32_t size;                  // Size of the ring buffer
+    uint32_t writeOffset;           // Offset at which the next byte will be written
+    uint32_t wrapped;               // Non-zero if the ring buffer has been filled at least once
+} HLSLoggerTailHeader;
+
+static const uint32_t kTailMagic = 0x4C494154;         // 'TAIL' when read as little-endian bytes
+
+@interface HLSLoggerFileSink ()
+
+@property (nonatomic, retain) NSString *directoryPath;
+@property (nonatomic, retain) NSString *previousTail;
+
+- (NSString *)segmentPathAtIndex:(NSUInteger)index;
+
+- (BOOL)openCurrentSegment;
+- (void)rotateSegments;
+- (void)writeBufferSynchronizing:(BOOL)synchronizing;
+- (void)scheduleFlush;
+
+- (void)openTail;
+- (void)appendToTail:(NSData *)data;
+- (NSString *)tailStringWithTail:(uint8_t *)tail;
+
+@end
+
+@implementation HLSLoggerFileSink
+
+#pragma mark Object creation and destruction
+
+- (id)initWithDirectoryPath:(NSString *)directoryPath
+                segmentSize:(unsigned long long)segmentSize
+        maximumSegmentCount:(NSUInteger)maximumSegmentCount
+                   tailSize:(NSUInteger)tailSize
+{
+    if ((self = [super init])) {
+        m_fileDescriptor = -1;
+        pthread_mutex_init(&m_mutex, NULL);
+
+        if (! directoryPath || segmentSize == 0 || maximumSegmentCount == 0) {
+            NSLog(@"HLSLoggerFileSink: A directory, a segment size and a segment count must be provided");
+            [self release];
+            return nil;
+        }
+
+        NSError *error = nil;
+        if (! [[NSFileManager defaultManager] createDirectoryAtPath:directoryPath withIntermediateDirectories:YES attributes:nil error:&error]) {
+            NSLog(@"HLSLoggerFileSink: Could not create directory %@. Reason: %@", directoryPath, error);
+            [self release];
+            return nil;
+        }
+
+        self.directoryPath = directoryPath;
+        m_segmentSize = segmentSize;
+        m_maximumSegmentCount = maximumSegmentCount;
+        m_tailSize = tailSize;
+        m_synchronizationInterval = 5.;
+        m_buffer = [[NSMutableData alloc] initWithCapacity:kBufferSize];
+        m_lastSynchronizationDate = CFAbsoluteTimeGetCurrent();
+
+        if (! [self openCurrentSegment]) {
+            [self release];
+            return nil;
+        }
+
+        if (m_tailSize != 0) {
+            [self openTail];
+        }
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    if (m_fileDescriptor >= 0) {
+        [self writeBufferSynchronizing:YES];
+        close(m_fileDescriptor);
+    }
+    if (m_tail) {
+        munmap(m_tail, sizeof(HLSLoggerTailHeader) + m_tailSize);
+    }
+    pthread_mutex_destroy(&m_mutex);
+
+    self.directoryPath = nil;
+    self.previousTail = nil;
+    [m_buffer release];
+    m_buffer = nil;
+
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize directoryPath = m_directoryPath;
+
+@synthesize segmentSize = m_segmentSize;
+
+@synthesize maximumSegmentCount = m_maximumSegmentCount;
+
+@synthesize tailSize = m_tailSize;
+
+@synthesize synchronizationInterval = m_synchronizationInterval;
+
+@synthesize previousTail = m_previousTail;
+
+#pragma mark Writing
+
+- (void)writeLine:(NSString *)line
+{
+    NSData *data = [[line stringByAppendingString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+
+    pthread_mutex_lock(&m_mutex);
+
+    [m_buffer appendData:data];
+    [self appendToTail:data];
+
+    BOOL synchronizationNeeded = (CFAbsoluteTimeGetCurrent() - m_lastSynchronizationDate >= m_synchronizationInterval);
+    if ([m_buffer length] >= kBufferSize || synchronizationNeeded) {
+        [self writeBufferSynchronizing:synchronizationNeeded];
+    }
+    else {
+        [self scheduleFlush];
+    }
+
+    pthread_mutex_unlock(&m_mutex);
+}
+
+- (void)flush
+{
+    pthread_mutex_lock(&m_mutex);
+    [self writeBufferSynchronizing:YES];
+    pthread_mutex_unlock(&m_mutex);
+}
+
+// Must be called with the mutex locked
+- (void)writeBufferSynchronizing:(BOOL)synchronizing
+{
+    if (m_fileDescriptor < 0) {
+        return;
+    }
+
+    NSUInteger length = [m_buffer length];
+    if (length != 0) {
+        if (m_currentSegmentSize != 0 && m_currentSegmentSize + length > m_segmentSize) {
+            [self rotateSegments];
+            if (m_fileDescriptor < 0) {
+                return;
+            }
+        }
+
+        const uint8_t *bytes = [m_buffer bytes];
+        NSUInteger writtenLength = 0;
+        while (writtenLength < length) {
+            ssize_t result = write(m_fileDescriptor, bytes + writtenLength, length - writtenLength);
+            if (result < 0) {
+                NSLog(@"HLSLoggerFileSink: Write error %d, %d bytes lost", errno, length - writtenLength);
+                break;
+            }
+            writtenLength += result;
+        }
+        m_currentSegmentSize += writtenLength;
+        [m_buffer setLength:0];
+    }
+
+    if (synchronizing) {
+        fsync(m_fileDescriptor);
+        m_lastSynchronizationDate = CFAbsoluteTimeGetCurrent();
+    }
+}
+
+// Ensure buffered lines are written even if nothing is logged afterwards. Must be called with the mutex locked
+- (void)scheduleFlush
+{
+    if (m_flushScheduled) {
+        return;
+    }
+    m_flushScheduled = YES;
+
+    // The block retains the sink until it has been executed
+    dispatch_time_t time = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(m_synchronizationInterval * NSEC_PER_SEC));
+    dispatch_after(time, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        pthread_mutex_lock(&m_mutex);
+        m_flushScheduled = NO;
+        [self writeBufferSynchronizing:YES];
+        pthread_mutex_unlock(&m_mutex);
+    });
+}
+
+#pragma mark Segments
+
+- (NSString *)segmentPathAtIndex:(NSUInteger)index
+{
+    NSString *fileName = (index == 0) ? kSegmentFileBaseName : [NSString stringWithFormat:@"%@.%d", kSegmentFileBaseName, index];
+    return [[self.directoryPath stringByAppendingPathComponent:fileName] stringByAppendingPathExtension:kSegmentFileExtension];
+}
+
+- (NSArray *)segmentPaths
+{
+    NSMutableArray *segmentPaths = [NSMutableArray array];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSUInteger i = 0; i < m_maximumSegmentCount; ++i) {
+        NSString *segmentPath = [self segmentPathAtIndex:i];
+        if ([fileManager fileExistsAtPath:segmentPath]) {
+            [segmentPaths addObject:segmentPath];
+        }
+    }
+    return [NSArray arrayWithArray:segmentPaths];
+}
+
+- (BOOL)openCurrentSegment
+{
+    NSString *segmentPath = [self segmentPathAtIndex:0];
+    m_fileDescriptor = open([segmentPath fileSystemRepresentation], O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+    if (m_fileDescriptor < 0) {
+        NSLog(@"HLSLoggerFileSink: Could not open %@ (error %d)", segmentPath, errno);
+        return NO;
+    }
+
+    struct stat fileStat;
+    m_currentSegmentSize = (fstat(m_fileDescriptor, &fileStat) == 0) ? fileStat.st_size : 0;
+    return YES;
+}
+
+// Must be called with the mutex locked
+- (void)rotateSegments
+{
+    fsync(m_fileDescriptor);
+    close(m_fileDescriptor);
+    m_fileDescriptor = -1;
+
+    // Discard the oldest segment, then shift the others
+    unlink([[self segmentPathAtIndex:m_maximumSegmentCount - 1] fileSystemRepresentation]);
+    for (NSUInteger i = m_maximumSegmentCount - 1; i > 0; --i) {
+        rename([[self segmentPathAtIndex:i - 1] fileSystemRepresentation], [[self segmentPathAtIndex:i] fileSystemRepresentation]);
+    }
+
+    [self openCurrentSegment];
+}
+
+#pragma mark Tail
+
+- (void)openTail
+{
+    NSString *tailPath = [self.directoryPath stringByAppendingPathComponent:kTailFileName];
+    int tailFileDescriptor = open([tailPath fileSystemRepresentation], O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (tailFileDescriptor < 0) {
+        NSLog(@"HLSLoggerFileSink: Could not open tail file %@ (error %d)", tailPath, errno);
+        return;
+    }
+
+    size_t mappedSize = sizeof(HLSLoggerTailHeader) + m_tailSize;
+    if (ftruncate(tailFileDescriptor, mappedSize) != 0) {
+        NSLog(@"HLSLoggerFileSink: Could not resize tail file %@ (error %d)", tailPath, errno);
+        close(tailFileDescriptor);
+        return;
+    }
+
+    // The mapping remains valid after the file descriptor has been closed
+    void *tail = mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, tailFileDescriptor, 0);
+    close(tailFileDescriptor);
+    if (tail == MAP_FAILED) {
+        NSLog(@"HLSLoggerFileSink: Could not map tail file %@ (error %d)", tailPath, errno);
+        return;
+    }
+    m_tail = tail;
+
+    // Recover the tail of the previous run (if the tail size has not changed), then start a new one
+    HLSLoggerTailHeader *header = (HLSLoggerTailHeader *)m_tail;
+    if (header->magic == kTailMagic && header->size == m_tailSize && header->writeOffset < m_tailSize) {
+        self.previousTail = [self tailStringWithTail:m_tail];
+    }
+    header->magic = kTailMagic;
+    header->size = (uint32_t)m_tailSize;
+    header->writeOffset = 0;
+    header->wrapped = 0;
+}
+
+// Must be called with the mutex locked
+- (void)appendToTail:(NSData *)data
+{
+    if (! m_tail) {
+        return;
+    }
+
+    HLSLoggerTailHeader *header = (HLSLoggerTailHeader *)m_tail;
+    uint8_t *ringBuffer = m_tail + sizeof(HLSLoggerTailHeader);
+
+    // Only the end of the data is kept if it is larger than the tail itself
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    if (length > m_tailSize) {
+        bytes += length - m_tailSize;
+        length = m_tailSize;
+        header->wrapped = 1;
+    }
+
+    NSUInteger firstPartLength = MIN(length, m_tailSize - header->writeOffset);
+    memcpy(ringBuffer + header->writeOffset, bytes, firstPartLength);
+    memcpy(ringBuffer, bytes + firstPartLength, length - firstPartLength);
+
+    NSUInteger writeOffset = header->writeOffset + length;
+    if (writeOffset >= m_tailSize) {
+        writeOffset -= m_tailSize;
+        header->wrapped = 1;
+    }
+    header->writeOffset = (uint32_t)writeOffset;
+}
+
+- (NSString *)tail
+{
+    if (! m_tail) {
+        return nil;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    NSString *tail = [self tailStringWithTail:m_tail];
+    pthread_mutex_unlock(&m_mutex);
+    return tail;
+}
+
+- (NSString *)tailStringWithTail:(uint8_t *)tail
+{
+    HLSLoggerTailHeader *header = (HLSLoggerTailHeader *)tail;
+    uint8_t *ringBuffer = tail + sizeof(HLSLoggerTailHeader);
+
+    NSMutableData *data = [NSMutableData data];
+    if (header->wrapped) {
+        [data appendBytes:ringBuffer + header->writeOffset length:header->size - header->writeOffset];
+    }
+    [data appendBytes:ringBuffer length:header->writeOffset];
+
+    // Skip a possibly truncated UTF-8 character at the beginning
+    const uint8_t *bytes = [data bytes];
+    NSUInteger start = 0;
+    while (start < [data length] && (bytes[start] & 0xC0) == 0x80) {
+        ++start;
+    }
+
+    NSData *stringData = [data subdataWithRange:NSMakeRange(start, [data length] - start)];
+    return [[[NSString alloc] initWithData:stringData encoding:NSUTF8StringEncoding] autorelease];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; directoryPath: %@; segmentSize: %llu; maximumSegmentCount: %d; tailSize: %d>",
+            [self class],
+            self,
+            self.directoryPath,
+            self.segmentSize,
+            self.maximumSegmentCount,
+            self.tailSize];
+}
+
+@end
@@ -0,0 +1,113 @@
+//
+//  HLSTrace.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Keys of the statistics dictionaries returned by HLSTrace (values are NSNumber objects)
+ */
+extern NSString * const HLSTraceIntervalCountKey;                   // number of completed intervals
+extern NSString * const HLSTraceTotalIntervalDurationKey;           // total duration of the completed intervals (in seconds)
+extern NSString * const HLSTraceLongestIntervalDurationKey;         // longest duration of a completed interval (in seconds)
+extern NSString * const HLSTraceInstantCountKey;                    // number of instant events
+
+/**
+ * Identifier of a trace interval. 0 means no interval (e.g. because tracing was disabled when the interval began)
+ */
+typedef uint32_t HLSTraceIdentifier;
+
+/**
+ * Tracing macros. Arguments are only evaluated if tracing is enabled, a disabled trace point therefore boils down to
+ * a single memory load. HLSTraceBegin returns an identifier which must be passed to HLSTraceEnd to close the interval
+ * (which can happen on another thread). The name is a variadic argument so that it can be a message expression containing
+ * commas (e.g. [NSString stringWithFormat:...])
+ */
+#define HLSTraceBegin(category, ...)        (HLSTraceEnabled ? [HLSTrace beginIntervalWithCategory:(category) name:(__VA_ARGS__)] : 0)
+
+#define HLSTraceEnd(identifier)                                                                                                 \
+    do {                                                                                                                        \
+        HLSTraceIdentifier hls_trace_identifier_ = (identifier);                                                                \
+        if (hls_trace_identifier_ != 0) {                                                                                       \
+            [HLSTrace endInterval:hls_trace_identifier_];                                                                       \
+        }                                                                                                                       \
+    } while (0)
+
+#define HLSTraceInstant(category, ...)                                                                                          \
+    do {                                                                                                                        \
+        if (HLSTraceEnabled) {                                                                                                  \
+            [HLSTrace recordInstantWithCategory:(category) name:(__VA_ARGS__)];                                                 \
+        }                                                                                                                       \
+    } while (0)
+
+/**
+ * YES iff tracing is enabled. Should never be accessed directly, use the macros and the HLSTrace class methods instead
+ */
+extern volatile BOOL HLSTraceEnabled;
+
+/**
+ * A single trace for all CoconutKit subsystems, recording timestamped intervals and instant events in named categories,
+ * together with the thread on which they occurred. CoconutKit records:
+ *   - for tasks (category "Tasks"): an interval from submission to the delivery of the results to the delegate, and an
+ *     interval for the execution of the task
+ *   - for animations (category "Animation"): an interval while the animation is running, an interval for each step, and
+ *     an instant event when the animation is cancelled or terminated
+ *   - for containers (category "Containers"): an interval for each push and pop made by a container stack, covering the
+ *     view loading and transition setup (the transition animation itself appears in the "Animation" category)
+ *   - for localization (category "Localization"): an interval for each localized string lookup
+ *   - for Core Data (category "CoreData"): an interval for each save made by HLSModelManager
+ * Applications can add their own trace points using the macros above. A single trace therefore shows where the time
+ * is spent, e.g. during a slow navigation.
+ *
+ * Tracing is disabled by default. Events are stored in memory in a ring buffer: Once full, the oldest events are
+ * overwritten. The trace can be exported using the Chrome trace event format, which can be displayed with the
+ * chrome://tracing tool. For a more detailed trace of the tasks processed by a task manager, see HLSTaskTrace.
+ *
+ * This class is thread-safe.
+ */
+@interface HLSTrace : NSObject
+
+/**
+ * Enable or disable tracing. Events already recorded are kept
+ */
++ (void)setEnabled:(BOOL)enabled;
++ (BOOL)isEnabled;
+
+/**
+ * Recording functions; should never be called directly, use the macros instead
+ */
++ (HLSTraceIdentifier)beginIntervalWithCategory:(NSString *)category name:(NSString *)name;
++ (void)endInterval:(HLSTraceIdentifier)identifier;
++ (void)recordInstantWithCategory:(NSString *)category name:(NSString *)name;
+
+/**
+ * The number of events currently stored (at most 16384)
+ */
++ (NSUInteger)count;
+
+/**
+ * Forget all events
+ */
++ (void)clear;
+
+/**
+ * Return statistics about the events currently stored, as a dictionary mapping each category to a dictionary of 
+ * statistics (see keys above). Intervals which have not ended yet, or whose beginning has been overwritten, are not
+ * taken into account. Useful to check a trace automatically, without having to parse its JSON export
+ */
++ (NSDictionary *)statisticsByCategory;
+
+/**
+ * Return the events currently stored, from the oldest to the most recent one, formatted as a Chrome trace event
+ * JSON string. Intervals whose beginning has been overwritten are omitted
+ */
++ (NSString *)chromeTraceJSONString;
+
+/**
+ * Write the Chrome trace event JSON string to a file. Return NO and fill the error if the file could not be written
+ */
++ (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError **)pError;
+
+@end
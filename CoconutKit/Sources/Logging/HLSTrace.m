@@ -0,0 +1,325 @@
+//
+//  HLSTrace.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTrace.h"
+
+#import <libkern/OSAtomic.h>
+#import <pthread.h>
+
+static const NSUInteger kTraceCapacity = 16384;
+
+/**
+ * Kinds of events
+ */
+typedef enum {
+    HLSTraceEventTypeEnumBegin = 0,
+    // Values
+    HLSTraceEventTypeBegin = HLSTraceEventTypeEnumBegin,
+    HLSTraceEventTypeEnd,
+    HLSTraceEventTypeInstant,
+    // End of values
+    HLSTraceEventTypeEnumEnd,
+    HLSTraceEventTypeEnumSize = HLSTraceEventTypeEnumEnd - HLSTraceEventTypeEnumBegin
+} HLSTraceEventType;
+
+typedef struct {
+    HLSTraceEventType type;
+    HLSTraceIdentifier identifier;      // 0 for instant events
+    CFAbsoluteTime time;
+    NSUInteger threadId;
+    NSString *category;                 // retained, nil for end events
+    NSString *name;                     // retained, nil for end events
+} HLSTraceEvent;
+
+// Variables with external linkage
+volatile BOOL HLSTraceEnabled = NO;
+
+NSString * const HLSTraceIntervalCountKey = @"HLSTraceIntervalCount";
+NSString * const HLSTraceTotalIntervalDurationKey = @"HLSTraceTotalIntervalDuration";
+NSString * const HLSTraceLongestIntervalDurationKey = @"HLSTraceLongestIntervalDuration";
+NSString * const HLSTraceInstantCountKey = @"HLSTraceInstantCount";
+
+// Variables with internal linkage
+static HLSTraceEvent *s_events = NULL;              // Ring buffer of events
+static NSUInteger s_count = 0;
+static NSUInteger s_nextIndex = 0;
+static pthread_mutex_t s_eventsMutex = PTHREAD_MUTEX_INITIALIZER;
+static volatile int32_t s_lastIdentifier = 0;
+
+// Static functions
+static void HLSTraceRecordEvent(HLSTraceEventType type, HLSTraceIdentifier identifier, NSString *category, NSString *name);
+static void HLSTraceAppendEvent(const HLSTraceEvent *event, NSString *category, NSString *name, NSMutableString *jsonString);
+static NSString *HLSTraceJSONEscapedString(NSString *string);
+
+@implementation HLSTrace
+
+#pragma mark Enabling and disabling tracing
+
++ (void)setEnabled:(BOOL)enabled
+{
+    HLSTraceEnabled = enabled;
+}
+
++ (BOOL)isEnabled
+{
+    return HLSTraceEnabled;
+}
+
+#pragma mark Recording
+
++ (HLSTraceIdentifier)beginIntervalWithCategory:(NSString *)category name:(NSString *)name
+{
+    // 0 is reserved
+    HLSTraceIdentifier identifier = 0;
+    while (identifier == 0) {
+        identifier = (HLSTraceIdentifier)OSAtomicIncrement32Barrier(&s_lastIdentifier);
+    }
+    
+    HLSTraceRecordEvent(HLSTraceEventTypeBegin, identifier, category, name);
+    return identifier;
+}
+
++ (void)endInterval:(HLSTraceIdentifier)identifier
+{
+    HLSTraceRecordEvent(HLSTraceEventTypeEnd, identifier, nil, nil);
+}
+
++ (void)recordInstantWithCategory:(NSString *)category name:(NSString *)name
+{
+    HLSTraceRecordEvent(HLSTraceEventTypeInstant, 0, category, name);
+}
+
++ (NSUInteger)count
+{
+    pthread_mutex_lock(&s_eventsMutex);
+    NSUInteger count = s_count;
+    pthread_mutex_unlock(&s_eventsMutex);
+    return count;
+}
+
++ (void)clear
+{
+    pthread_mutex_lock(&s_eventsMutex);
+    NSUInteger firstIndex = (s_nextIndex + kTraceCapacity - s_count) % kTraceCapacity;
+    for (NSUInteger i = 0; i < s_count; ++i) {
+        HLSTraceEvent *event = s_events + (firstIndex + i) % kTraceCapacity;
+        [event->category release];
+        event->category = nil;
+        [event->name release];
+        event->name = nil;
+    }
+    s_count = 0;
+    s_nextIndex = 0;
+    pthread_mutex_unlock(&s_eventsMutex);
+}
+
+#pragma mark Statistics
+
++ (NSDictionary *)statisticsByCategory
+{
+    NSMutableDictionary *categoryToStatisticsMap = [NSMutableDictionary dictionary];
+    
+    pthread_mutex_lock(&s_eventsMutex);
+    
+    CFMutableDictionaryRef identifierToBeginEventMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    
+    NSUInteger firstIndex = (s_nextIndex + kTraceCapacity - s_count) % kTraceCapacity;
+    for (NSUInteger i = 0; i < s_count; ++i) {
+        const HLSTraceEvent *event = s_events + (firstIndex + i) % kTraceCapacity;
+        if (event->type == HLSTraceEventTypeBegin) {
+            CFDictionarySetValue(identifierToBeginEventMap, (const void *)(uintptr_t)event->identifier, event);
+            continue;
+        }
+        
+        NSString *category = event->category;
+        CFTimeInterval duration = 0.;
+        if (event->type == HLSTraceEventTypeEnd) {
+            const HLSTraceEvent *beginEvent = CFDictionaryGetValue(identifierToBeginEventMap, (const void *)(uintptr_t)event->identifier);
+            if (! beginEvent) {
+                continue;
+            }
+            category = beginEvent->category;
+            duration = event->time - beginEvent->time;
+        }
+        
+        if (! category) {
+            continue;
+        }
+        
+        NSMutableDictionary *statistics = [categoryToStatisticsMap objectForKey:category];
+        if (! statistics) {
+            statistics = [NSMutableDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:0], HLSTraceIntervalCountKey,
+                          [NSNumber numberWithDouble:0.], HLSTraceTotalIntervalDurationKey,
+                          [NSNumber numberWithDouble:0.], HLSTraceLongestIntervalDurationKey,
+                          [NSNumber numberWithUnsignedInteger:0], HLSTraceInstantCountKey, nil];
+            [categoryToStatisticsMap setObject:statistics forKey:category];
+        }
+        
+        if (event->type == HLSTraceEventTypeEnd) {
+            NSUInteger intervalCount = [[statistics objectForKey:HLSTraceIntervalCountKey] unsignedIntegerValue];
+            [statistics setObject:[NSNumber numberWithUnsignedInteger:intervalCount + 1] forKey:HLSTraceIntervalCountKey];
+            
+            CFTimeInterval totalDuration = [[statistics objectForKey:HLSTraceTotalIntervalDurationKey] doubleValue];
+            [statistics setObject:[NSNumber numberWithDouble:totalDuration + duration] forKey:HLSTraceTotalIntervalDurationKey];
+            
+            CFTimeInterval longestDuration = [[statistics objectForKey:HLSTraceLongestIntervalDurationKey] doubleValue];
+            if (duration > longestDuration) {
+                [statistics setObject:[NSNumber numberWithDouble:duration] forKey:HLSTraceLongestIntervalDurationKey];
+            }
+        }
+        else {
+            NSUInteger instantCount = [[statistics objectForKey:HLSTraceInstantCountKey] unsignedIntegerValue];
+            [statistics setObject:[NSNumber numberWithUnsignedInteger:instantCount + 1] forKey:HLSTraceInstantCountKey];
+        }
+    }
+    
+    CFRelease(identifierToBeginEventMap);
+    
+    pthread_mutex_unlock(&s_eventsMutex);
+    
+    return [NSDictionary dictionaryWithDictionary:categoryToStatisticsMap];
+}
+
+#pragma mark Export
+
+// Remark: NSJSONSerialization is not available on iOS 4, and the format is simple enough to be written by hand. Intervals
+//         can span several threads, and are therefore exported as asynchronous slices
++ (NSString *)chromeTraceJSONString
+{
+    NSMutableString *jsonString = [NSMutableString stringWithString:@"{\"traceEvents\":["];
+    
+    pthread_mutex_lock(&s_eventsMutex);
+    
+    // End events do not carry any category or name. Use those of the matching begin event
+    CFMutableDictionaryRef identifierToBeginEventMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    
+    BOOL first = YES;
+    NSUInteger firstIndex = (s_nextIndex + kTraceCapacity - s_count) % kTraceCapacity;
+    for (NSUInteger i = 0; i < s_count; ++i) {
+        const HLSTraceEvent *event = s_events + (firstIndex + i) % kTraceCapacity;
+        
+        NSString *category = event->category;
+        NSString *name = event->name;
+        if (event->type == HLSTraceEventTypeBegin) {
+            CFDictionarySetValue(identifierToBeginEventMap, (const void *)(uintptr_t)event->identifier, event);
+        }
+        else if (event->type == HLSTraceEventTypeEnd) {
+            const HLSTraceEvent *beginEvent = CFDictionaryGetValue(identifierToBeginEventMap, (const void *)(uintptr_t)event->identifier);
+            if (! beginEvent) {
+                continue;
+            }
+            category = beginEvent->category;
+            name = beginEvent->name;
+        }
+        
+        if (! first) {
+            [jsonString appendString:@","];
+        }
+        HLSTraceAppendEvent(event, category, name, jsonString);
+        first = NO;
+    }
+    
+    CFRelease(identifierToBeginEventMap);
+    
+    pthread_mutex_unlock(&s_eventsMutex);
+    
+    [jsonString appendString:@"],\"displayTimeUnit\":\"ms\"}"];
+    return [NSString stringWithString:jsonString];
+}
+
++ (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError **)pError
+{
+    return [[self chromeTraceJSONString] writeToFile:filePath atomically:YES encoding:NSUTF8StringEncoding error:pError];
+}
+
+@end
+
+#pragma mark Static functions
+
+static void HLSTraceRecordEvent(HLSTraceEventType type, HLSTraceIdentifier identifier, NSString *category, NSString *name)
+{
+    // Gather everything outside the lock
+    HLSTraceEvent event;
+    event.type = type;
+    event.identifier = identifier;
+    event.time = CFAbsoluteTimeGetCurrent();
+    event.threadId = pthread_mach_thread_np(pthread_self());
+    event.category = [category copy];
+    event.name = [name copy];
+    
+    NSString *overwrittenCategory = nil;
+    NSString *overwrittenName = nil;
+    
+    pthread_mutex_lock(&s_eventsMutex);
+    if (! s_events) {
+        s_events = calloc(kTraceCapacity, sizeof(HLSTraceEvent));
+    }
+    
+    HLSTraceEvent *slot = s_events + s_nextIndex;
+    if (s_count == kTraceCapacity) {
+        overwrittenCategory = slot->category;
+        overwrittenName = slot->name;
+    }
+    *slot = event;
+    s_nextIndex = (s_nextIndex + 1) % kTraceCapacity;
+    s_count = MIN(s_count + 1, kTraceCapacity);
+    pthread_mutex_unlock(&s_eventsMutex);
+    
+    [overwrittenCategory release];
+    [overwrittenName release];
+}
+
+static void HLSTraceAppendEvent(const HLSTraceEvent *event, NSString *category, NSString *name, NSMutableString *jsonString)
+{
+    static NSString * const kPhases[HLSTraceEventTypeEnumSize] = { @"b", @"e", @"i" };
+    
+    // Times are in microseconds
+    unsigned long long timestamp = (unsigned long long)((event->time + kCFAbsoluteTimeIntervalSince1970) * 1e6);
+    [jsonString appendFormat:@"{\"name\":\"%@\",\"cat\":\"%@\",\"ph\":\"%@\",\"ts\":%llu,\"pid\":1,\"tid\":%u",
+        name ? HLSTraceJSONEscapedString(name) : @"",
+        category ? HLSTraceJSONEscapedString(category) : @"",
+        kPhases[event->type],
+        timestamp,
+        (unsigned int)event->threadId];
+    if (event->type == HLSTraceEventTypeInstant) {
+        [jsonString appendString:@",\"s\":\"t\"}"];
+    }
+    else {
+        [jsonString appendFormat:@",\"id\":%u}", (unsigned int)event->identifier];
+    }
+}
+
+static NSString *HLSTraceJSONEscapedString(NSString *string)
+{
+    NSMutableString *escapedString = [NSMutableString stringWithCapacity:[string length]];
+    for (NSUInteger i = 0; i < [string length]; ++i) {
+        unichar character = [string characterAtIndex:i];
+        switch (character) {
+            case '"': {
+                [escapedString appendString:@"\\\""];
+                break;
+            }
+            
+            case '\\': {
+                [escapedString appendString:@"\\\\"];
+                break;
+            }
+            
+            default: {
+                if (character < 0x20) {
+                    [escapedString appendFormat:@"\\u%04x", character];
+                }
+                else {
+                    [escapedString appendFormat:@"%C", character];
+                }
+                break;
+            }
+        }
+    }
+    return escapedString;
+}
@@ -0,0 +1,60 @@
+//
+//  HLSBlockTask.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTask.h"
+
+// Forward declarations
+@class HLSTaskOperation;
+
+/**
+ * The work performed by a block task. The block is executed on the operation thread and receives the operation
+ * processing the task, which can be used to check whether the task has been cancelled (-isCancelled, or using its
+ * cancellation token, to which cancellation handlers can also be added) and to report progress 
+ * (-updateProgressToValue:, see HLSTaskOperation+Protected.h). The block returns the result of the task (which can
+ * be nil). If the task fails, the block must return nil and set the error pointer. Within a task group, the result
+ * is also directly available to the operations of dependent tasks (see -outputOfTask: in 
+ * HLSTaskOperation+Protected.h)
+ */
+typedef id (^HLSTaskBlock)(HLSTaskOperation *operation, NSError **pError);
+
+/**
+ * A task whose work is defined by a block, for jobs too small to be worth an HLSTask and an HLSTaskOperation 
+ * subclass. Block tasks are submitted, grouped, tagged and tracked using delegates exactly like any other task.
+ * Their result is directly stored by the task, no return information dictionary needs to be created.
+ *
+ * Do not subclass HLSBlockTask, subclass HLSTask if you need a custom task.
+ *
+ * Designated initializer: -initWithBlock:
+ */
+@interface HLSBlockTask : HLSTask {
+@private
+    HLSTaskBlock _block;
+    id _result;
+}
+
+/**
+ * Convenience constructor
+ */
++ (HLSBlockTask *)taskWithBlock:(HLSTaskBlock)block;
+
+/**
+ * Create a task executing the specified block
+ */
+- (id)initWithBlock:(HLSTaskBlock)block;
+
+/**
+ * The block executed by the task
+ */
+@property (nonatomic, readonly, copy) HLSTaskBlock block;
+
+/**
+ * The object returned by the block once the task has been successfully processed, nil otherwise
+ */
+@property (nonatomic, readonly, retain) id result;
+
+@end
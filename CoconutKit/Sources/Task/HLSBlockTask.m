@@ -0,0 +1,155 @@
+//
+//  HLSBlockTask.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSBlockTask.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+#import "HLSTask+Friend.h"
+#import "HLSTaskOperation+Friend.h"
+#import "HLSTaskOperation+Protected.h"
+
+#pragma mark -
+#pragma mark HLSBlockTaskOperation class interface
+
+/**
+ * The operation executing the block of a block task
+ */
+@interface HLSBlockTaskOperation : HLSTaskOperation
+
+- (void)notifySettingResult:(id)result;
+
+@end
+
+#pragma mark -
+#pragma mark HLSBlockTask class interface extension
+
+@interface HLSBlockTask ()
+
+@property (nonatomic, copy) HLSTaskBlock block;
+@property (nonatomic, retain) id result;
+
+@end
+
+#pragma mark -
+#pragma mark HLSBlockTask class implementation
+
+@implementation HLSBlockTask
+
+#pragma mark Class methods
+
++ (HLSBlockTask *)taskWithBlock:(HLSTaskBlock)block
+{
+    return [[[self alloc] initWithBlock:block] autorelease];
+}
+
+#pragma mark Object creation and destruction
+
+- (id)initWithBlock:(HLSTaskBlock)block
+{
+    if ((self = [super init])) {
+        if (! block) {
+            HLSLoggerError(@"A block is mandatory");
+            [self release];
+            return nil;
+        }
+        
+        self.block = block;
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    self.block = nil;
+    self.result = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+- (Class)operationClass
+{
+    return [HLSBlockTaskOperation class];
+}
+
+@synthesize block = _block;
+
+@synthesize result = _result;
+
+#pragma mark Resetting
+
+- (void)reset
+{
+    [super reset];
+    self.result = nil;
+}
+
+#pragma mark Sharing results
+
+- (void)copyResultsFromTask:(HLSTask *)task
+{
+    [super copyResultsFromTask:task];
+    
+    if ([task isKindOfClass:[HLSBlockTask class]]) {
+        self.result = ((HLSBlockTask *)task).result;
+    }
+}
+
+#pragma mark Snapshots
+
+- (HLSTask *)snapshot
+{
+    HLSBlockTask *snapshot = [[[[self class] alloc] initWithBlock:self.block] autorelease];
+    [snapshot copyStatusFromTask:self];
+    return snapshot;
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLSBlockTaskOperation class implementation
+
+@implementation HLSBlockTaskOperation
+
+#pragma mark Thread main function
+
+- (void)operationMain
+{
+    HLSBlockTask *blockTask = (HLSBlockTask *)self.task;
+    
+    NSError *error = nil;
+    id result = blockTask.block(self, &error);
+    if (error) {
+        [self attachError:error];
+    }
+    else {
+        // Directly available to dependent tasks
+        if (self.task.taskGroup) {
+            [self attachOutput:result];
+        }
+        
+        // Delivered in order with all other status changes, i.e. after the task has been reset when it started
+        [self onCallingThreadPerformSelector:@selector(notifySettingResult:) object:result coalescing:NO];
+    }
+}
+
+#pragma mark Code to be executed on the calling thread
+
+- (void)notifySettingResult:(id)result
+{
+    ((HLSBlockTask *)self.task).result = result;
+}
+
+@end
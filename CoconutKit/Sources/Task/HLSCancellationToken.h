@@ -0,0 +1,56 @@
+//
+//  HLSCancellationToken.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * A handler called when a cancellation token is cancelled
+ */
+typedef void (^HLSCancellationHandler)(void);
+
+/**
+ * A cancellation token is a lightweight object shared between a task, the operation processing it and any work the 
+ * operation delegates (e.g. an NSURLConnection, file I/O). Checking whether a token has been cancelled is cheap and
+ * can be done from any thread, as often as needed. Code which cannot poll the token (e.g. because it is waiting for
+ * a connection to deliver data) can register a handler to be called as soon as the token is cancelled, stopping the
+ * work right away.
+ *
+ * Handlers are called once, on the thread which cancels the token (for tasks, the thread which they have been submitted
+ * from), in the order they were added. They must therefore be short and thread-safe. A handler added to a token which
+ * has already been cancelled is called immediately on the current thread.
+ *
+ * A token cannot be reset once cancelled. This class is thread-safe.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSCancellationToken : NSObject {
+@private
+    volatile int32_t _cancelled;
+    NSMutableArray *_cancellationHandlers;
+}
+
+/**
+ * Cancel the token, calling all registered handlers. Does nothing if the token has already been cancelled
+ */
+- (void)cancel;
+
+/**
+ * Return YES iff the token has been cancelled
+ */
+- (BOOL)isCancelled;
+
+/**
+ * Add a handler to be called when the token is cancelled. The returned object identifies the registration and can
+ * be used to remove the handler (e.g. when the work it is meant to cancel has ended)
+ */
+- (id)addCancellationHandler:(HLSCancellationHandler)cancellationHandler;
+
+/**
+ * Remove a handler
+ */
+- (void)removeCancellationHandler:(id)cancellationHandlerRegistration;
+
+@end
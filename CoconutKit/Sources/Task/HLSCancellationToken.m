@@ -0,0 +1,111 @@
+//
+//  HLSCancellationToken.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSCancellationToken.h"
+
+#import <libkern/OSAtomic.h>
+
+@interface HLSCancellationToken ()
+
+@property (nonatomic, retain) NSMutableArray *cancellationHandlers;
+
+@end
+
+@implementation HLSCancellationToken
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.cancellationHandlers = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.cancellationHandlers = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize cancellationHandlers = _cancellationHandlers;
+
+#pragma mark Cancellation
+
+- (void)cancel
+{
+    // Only the first caller gets the handlers
+    NSArray *cancellationHandlers = nil;
+    @synchronized(self) {
+        if (! OSAtomicCompareAndSwap32Barrier(0, 1, &_cancelled)) {
+            return;
+        }
+        
+        cancellationHandlers = [NSArray arrayWithArray:self.cancellationHandlers];
+        [self.cancellationHandlers removeAllObjects];
+    }
+    
+    // Called outside the lock, so that handlers can safely use the token
+    for (HLSCancellationHandler cancellationHandler in cancellationHandlers) {
+        cancellationHandler();
+    }
+}
+
+- (BOOL)isCancelled
+{
+    // Cheap enough to be polled in tight loops
+    OSMemoryBarrier();
+    return _cancelled != 0;
+}
+
+#pragma mark Handlers
+
+- (id)addCancellationHandler:(HLSCancellationHandler)cancellationHandler
+{
+    if (! cancellationHandler) {
+        return nil;
+    }
+    
+    // The copied block itself is used as registration
+    HLSCancellationHandler cancellationHandlerCopy = [[cancellationHandler copy] autorelease];
+    @synchronized(self) {
+        if (! [self isCancelled]) {
+            [self.cancellationHandlers addObject:cancellationHandlerCopy];
+            return cancellationHandlerCopy;
+        }
+    }
+    
+    cancellationHandlerCopy();
+    return cancellationHandlerCopy;
+}
+
+- (void)removeCancellationHandler:(id)cancellationHandlerRegistration
+{
+    if (! cancellationHandlerRegistration) {
+        return;
+    }
+    
+    @synchronized(self) {
+        [self.cancellationHandlers removeObjectIdenticalTo:cancellationHandlerRegistration];
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; cancelled: %@>",
+            [self class],
+            self,
+            [self isCancelled] ? @"YES" : @"NO"];
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  HLSRemainingTimeEstimator.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Private class used by tasks and task groups to estimate their remaining time from their progress values. The rate
+ * of progress (per second) is smoothed using an exponentially weighted moving average. Outliers (rates far from the
+ * current average, e.g. caused by bursty progress updates) are clamped before being averaged, and samples too close 
+ * in time are merged, so that the estimate does not swing wildly.
+ *
+ * An optional prior (an expected total duration, e.g. obtained from history) can be provided. It is used alone as 
+ * long as no rate has been measured, and is then gradually replaced by the measured rate as samples are collected.
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSRemainingTimeEstimator : NSObject {
+@private
+    CFAbsoluteTime m_lastSampleTime;
+    double m_lastSampleProgress;
+    double m_rate;                                  // progress per second (EWMA)
+    NSUInteger m_nbrSamples;
+    NSTimeInterval m_expectedDuration;              // prior, 0 if none
+}
+
+/**
+ * Expected total duration used as prior, 0 if none (default)
+ */
+@property (nonatomic, assign) NSTimeInterval expectedDuration;
+
+/**
+ * Forget all samples (the prior is kept)
+ */
+- (void)reset;
+
+/**
+ * Add a progress sample (between 0 and 1) taken now
+ */
+- (void)addSampleWithProgress:(double)progress;
+
+/**
+ * Return the remaining time estimate for the specified progress value, or a negative value if no estimate is 
+ * available
+ */
+- (NSTimeInterval)remainingTimeIntervalForProgress:(double)progress;
+
+@end
@@ -0,0 +1,128 @@
+//
+//  HLSRemainingTimeEstimator.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSRemainingTimeEstimator.h"
+
+#import "HLSFloat.h"
+
+// Progress samples closer in time are merged
+static const NSTimeInterval kMinimumSampleInterval = 0.1;
+
+// Weight of a new rate sample in the average
+static const double kSmoothingFactor = 0.2;
+
+// Rates more than this factor away from the average are clamped (once enough samples have been collected)
+static const double kOutlierFactor = 4.;
+static const NSUInteger kWarmUpSampleCount = 3;
+
+// Number of samples after which the prior is not used anymore
+static const NSUInteger kPriorSampleCount = 10;
+
+@implementation HLSRemainingTimeEstimator
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        [self reset];
+    }
+    return self;
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize expectedDuration = m_expectedDuration;
+
+#pragma mark Estimation
+
+- (void)reset
+{
+    m_lastSampleTime = 0.;
+    m_lastSampleProgress = 0.;
+    m_rate = 0.;
+    m_nbrSamples = 0;
+}
+
+- (void)addSampleWithProgress:(double)progress
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    
+    // First sample: Only a reference point
+    if (doubleeq(m_lastSampleTime, 0.)) {
+        m_lastSampleTime = now;
+        m_lastSampleProgress = progress;
+        return;
+    }
+    
+    // Merge samples which are too close in time (bursts)
+    NSTimeInterval elapsedTimeInterval = now - m_lastSampleTime;
+    if (elapsedTimeInterval < kMinimumSampleInterval) {
+        return;
+    }
+    
+    // Progress going backwards: Restart from there
+    double progressDelta = progress - m_lastSampleProgress;
+    if (doublelt(progressDelta, 0.)) {
+        m_lastSampleTime = now;
+        m_lastSampleProgress = progress;
+        return;
+    }
+    
+    double rate = progressDelta / elapsedTimeInterval;
+    if (m_nbrSamples == 0) {
+        m_rate = rate;
+    }
+    else {
+        if (m_nbrSamples >= kWarmUpSampleCount) {
+            rate = MIN(MAX(rate, m_rate / kOutlierFactor), m_rate * kOutlierFactor);
+        }
+        m_rate = kSmoothingFactor * rate + (1. - kSmoothingFactor) * m_rate;
+    }
+    ++m_nbrSamples;
+    
+    m_lastSampleTime = now;
+    m_lastSampleProgress = progress;
+}
+
+- (NSTimeInterval)remainingTimeIntervalForProgress:(double)progress
+{
+    double remainingProgress = MAX(1. - progress, 0.);
+    
+    NSTimeInterval measuredRemainingTimeInterval = -1.;
+    if (m_nbrSamples != 0 && doublegt(m_rate, 0.)) {
+        measuredRemainingTimeInterval = remainingProgress / m_rate;
+    }
+    
+    if (doublele(m_expectedDuration, 0.)) {
+        return measuredRemainingTimeInterval;
+    }
+    
+    // Blend with the prior, whose weight decreases as more samples are collected
+    NSTimeInterval expectedRemainingTimeInterval = remainingProgress * m_expectedDuration;
+    if (measuredRemainingTimeInterval < 0.) {
+        return expectedRemainingTimeInterval;
+    }
+    
+    double measuredWeight = MIN((double)m_nbrSamples / kPriorSampleCount, 1.);
+    return measuredWeight * measuredRemainingTimeInterval + (1. - measuredWeight) * expectedRemainingTimeInterval;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; rate: %f; nbrSamples: %d; expectedDuration: %f>",
+            [self class],
+            self,
+            m_rate,
+            m_nbrSamples,
+            m_expectedDuration];
+}
+
+@end
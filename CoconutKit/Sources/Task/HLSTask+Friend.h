@@ -32,9 +32,29 @@
 
 @property (nonatomic, assign) HLSTaskGroup *taskGroup;           // weak ref to parent task group
 
+@property (nonatomic, retain) HLSCancellationToken *cancellationToken;
+
 /**
  * Reset internal status variables
  */
 - (void)reset;
 
+/**
+ * Take over the results (return information, error) of another task which performed the same work. Subclasses 
+ * storing additional results must override this method and call the super implementation
+ */
+- (void)copyResultsFromTask:(HLSTask *)task;
+
+/**
+ * Return a copy of the task frozen in its current state (status and results), not attached to any task group. Meant
+ * to be handed over to delegates notified on another thread. Subclasses which cannot be instantiated using -init
+ * must override this method and call -copyStatusFromTask: on the copy they create
+ */
+- (HLSTask *)snapshot;
+
+/**
+ * Take over the status and results of another task
+ */
+- (void)copyStatusFromTask:(HLSTask *)task;
+
 @end
@@ -7,11 +7,29 @@
 //
 
 // Forward declarations
+@class HLSCancellationToken;
+@class HLSRemainingTimeEstimator;
 @class HLSTaskGroup;
 @protocol HLSTaskDelegate;
 
 #define kTaskNoTimeIntervalEstimateAvailable        -1.
 
+/**
+ * Task priorities. Each priority corresponds to a separate processing lane of a task manager, with its own maximum 
+ * number of concurrent tasks. A lane never starts a new task while a lane with higher priority has tasks ready to
+ * be started
+ */
+typedef enum {
+    HLSTaskPriorityEnumBegin = 0,
+    // Values
+    HLSTaskPriorityInteractive = HLSTaskPriorityEnumBegin,          // Work the user is actively waiting for (e.g. content displayed after a tap)
+    HLSTaskPriorityUserInitiated,                                   // Default priority
+    HLSTaskPriorityBackground,                                      // Work the user is not aware of (e.g. prefetching)
+    // End of values
+    HLSTaskPriorityEnumEnd,
+    HLSTaskPriorityEnumSize = HLSTaskPriorityEnumEnd - HLSTaskPriorityEnumBegin
+} HLSTaskPriority;
+
 /**
  * Abstract class for tasks. Tasks offer a delegate mechanism for tracking their status. To create your own
  * tasks, simply subclass HLSTask and override the -operationClass method to return the class of the operation
@@ -27,17 +45,19 @@
 @private
     NSString *_tag;
     NSDictionary *_userInfo;
+    HLSTaskPriority _priority;
+    NSString *_deduplicationKey;
+    NSString *_journalKey;
     BOOL _running;
     BOOL _finished;
     BOOL _cancelled;
     float _progress;
     NSTimeInterval _remainingTimeIntervalEstimate;
-    NSDate *_lastEstimateDate;              // date & time when the remaining time was previously estimated ...
-    float _lastEstimateProgress;            // ... and corresponding progress value 
-    NSUInteger _progressStepsCounter; 
+    HLSRemainingTimeEstimator *_remainingTimeEstimator;
     NSDictionary *_returnInfo;
     NSError *_error;
     HLSTaskGroup *_taskGroup;               // parent task group if any, nil if none
+    HLSCancellationToken *_cancellationToken;
 }
 
 /**
@@ -58,6 +78,44 @@
  */
 @property (nonatomic, retain) NSDictionary *userInfo;
 
+/**
+ * The priority with which the task is processed (default is HLSTaskPriorityUserInitiated). This value is used when
+ * the task is submitted individually. Tasks submitted as part of a task group use the priority of the task group
+ * instead. Changing the priority of a task which has already been submitted has no effect
+ * Not meant to be overridden
+ */
+@property (nonatomic, assign) HLSTaskPriority priority;
+
+/**
+ * Optional key identifying the work performed by a task (e.g. the URL of an image to download), nil by default. 
+ * When a task is submitted individually while another one with the same key is still being processed by the
+ * same manager, no new work is started. The task is attached to the operation already running instead, and 
+ * receives the same progress, return information and error. Each task still receives its own delegate 
+ * notifications, and the work is only cancelled when all tasks attached to it have been cancelled. Tasks 
+ * submitted as part of a task group are never deduplicated.
+ *
+ * A task cancelled while its work is still needed by other tasks immediately receives its cancellation
+ * notification, but its other properties are then undefined until it is submitted again
+ * Not meant to be overridden
+ */
+@property (nonatomic, retain) NSString *deduplicationKey;
+
+/**
+ * Optional key identifying the task in the journal of its task group (see HLSTaskGroup journal), nil by default. 
+ * Tasks without a journal key are processed each time their task group is submitted
+ * Not meant to be overridden
+ */
+@property (nonatomic, retain) NSString *journalKey;
+
+/**
+ * The cancellation token of the current (or last) submission of the task, nil if the task has never been submitted. 
+ * A new token is created each time the task is submitted, and is cancelled as soon as the work performed for the task
+ * is cancelled. The same token is available to the operation processing the task (see HLSTaskOperation), so that 
+ * any work the task triggers (e.g. network or disk access) can register cancellation handlers stopping it right away
+ * Not meant to be overridden
+ */
+@property (nonatomic, readonly, retain) HLSCancellationToken *cancellationToken;
+
 /**
  * Return YES if the task processing is running
  * Not meant to be overridden
@@ -84,6 +142,7 @@
 /**
  * Return an estimate about the remaining time before the task processing completes (or kTaskNoTimeIntervalEstimateAvailable if no
  * estimate is available yet)
+ * The estimate is based on a smoothed progress rate, so that bursty progress updates do not make it swing wildly
  * Important remark: Accurate measurements can only be obtained if the progress update rate of a task is not varying fast (in another
  *                   words: constant over long enough periods of time). This is for example usually the case for download or
  *                   inflating / deflating tasks.
@@ -10,11 +10,11 @@
 
 #import "HLSFloat.h"
 #import "HLSLogger.h"
+#import "HLSRemainingTimeEstimator.h"
 #import "HLSTaskGroup.h"
+#import "HLSTaskGroup+Friend.h"
 #import "NSBundle+HLSExtensions.h"
 
-const NSUInteger kProgressStepsCounterThreshold = 50;
-
 @interface HLSTask ()
 
 @property (nonatomic, assign, getter=isRunning) BOOL running;
@@ -22,12 +22,16 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
 @property (nonatomic, assign, getter=isCancelled) BOOL cancelled;
 @property (nonatomic, assign) float progress;
 @property (nonatomic, assign) NSTimeInterval remainingTimeIntervalEstimate;
-@property (nonatomic, retain) NSDate *lastEstimateDate;
+@property (nonatomic, retain) HLSRemainingTimeEstimator *remainingTimeEstimator;
 @property (nonatomic, retain) NSDictionary *returnInfo;
 @property (nonatomic, retain) NSError *error;
 @property (nonatomic, assign) HLSTaskGroup *taskGroup;           // weak ref to parent task group
+@property (nonatomic, retain) HLSCancellationToken *cancellationToken;
 
 - (void)reset;
+- (void)copyResultsFromTask:(HLSTask *)task;
+- (HLSTask *)snapshot;
+- (void)copyStatusFromTask:(HLSTask *)task;
 
 @end
 
@@ -39,6 +43,8 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
 - (id)init
 {
     if ((self = [super init])) {
+        self.priority = HLSTaskPriorityUserInitiated;
+        self.remainingTimeEstimator = [[[HLSRemainingTimeEstimator alloc] init] autorelease];
         [self reset];
     }
     return self;
@@ -46,12 +52,16 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
 
 - (void)dealloc
 {
+    // First, so that the parent task group does not get notified about status changes
+    self.taskGroup = nil;
     self.tag = nil;
     self.userInfo = nil;
-    self.lastEstimateDate = nil;
+    self.deduplicationKey = nil;
+    self.journalKey = nil;
+    self.remainingTimeEstimator = nil;
     self.returnInfo = nil;
     self.error = nil;
-    self.taskGroup = nil;
+    self.cancellationToken = nil;
     [super dealloc];
 }
 
@@ -68,10 +78,27 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
 
 @synthesize userInfo = _userInfo;
 
+@synthesize priority = _priority;
+
+@synthesize deduplicationKey = _deduplicationKey;
+
+@synthesize journalKey = _journalKey;
+
 @synthesize running = _running;
 
 @synthesize finished = _finished;
 
+- (void)setFinished:(BOOL)finished
+{
+    if (finished == _finished) {
+        return;
+    }
+    
+    [self.taskGroup taskStatusWillChange:self];
+    _finished = finished;
+    [self.taskGroup taskStatusDidChange:self];
+}
+
 @synthesize cancelled = _cancelled;
 
 @synthesize progress = _progress;
@@ -83,6 +110,9 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
         return;
     }
     
+    // Let the parent task group update its running aggregates
+    [self.taskGroup taskStatusWillChange:self];
+    
     // Sanitize input
     if (floatlt(progress, 0.f) || floatgt(progress, 1.f)) {
         if (floatlt(progress, 0.f)) {
@@ -97,32 +127,12 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
         _progress = progress;
     }
     
-    // Estimation is not made with each progress value change. If progress values are incremented fast, it is calculated
-    // after several changes. If progress value change is slow, we use a time difference criterium. This should provide
-    // accurate enough results
-    if (! _lastEstimateDate) {
-        _progressStepsCounter = 0;
-        self.lastEstimateDate = [NSDate date];
-        _lastEstimateProgress = progress;
-    }
-    else {
-        ++_progressStepsCounter;
-    }
+    [self.taskGroup taskStatusDidChange:self];
     
-    // Should update estimate?
-    NSTimeInterval elapsedTimeIntervalSinceLastEstimate = [[NSDate date] timeIntervalSinceDate:self.lastEstimateDate];
-    if (_progressStepsCounter > kProgressStepsCounterThreshold) {
-        // Calculate estimate based on velocity during previous step (never 0 since this method returns if progress does not change)
-        double progressSinceLastEstimate = progress - _lastEstimateProgress;
-        if (! doubleeq(progressSinceLastEstimate, 0.)) {
-            self.remainingTimeIntervalEstimate = (elapsedTimeIntervalSinceLastEstimate / progressSinceLastEstimate) * (1 - progress);
-            
-            // Get ready for next estimate
-            _progressStepsCounter = 0;
-            self.lastEstimateDate = [NSDate date];
-            _lastEstimateProgress = progress;
-        }
-    }
+    // The estimator smoothes the progress rate, values can therefore be fed as often as they change
+    [self.remainingTimeEstimator addSampleWithProgress:_progress];
+    NSTimeInterval remainingTimeIntervalEstimate = [self.remainingTimeEstimator remainingTimeIntervalForProgress:_progress];
+    self.remainingTimeIntervalEstimate = (remainingTimeIntervalEstimate >= 0.) ? remainingTimeIntervalEstimate : kTaskNoTimeIntervalEstimateAvailable;
 }
 
 @synthesize remainingTimeIntervalEstimate = _remainingTimeIntervalEstimate;
@@ -137,14 +147,28 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
     }
 }
 
-@synthesize lastEstimateDate = _lastEstimateDate;
+@synthesize remainingTimeEstimator = _remainingTimeEstimator;
 
 @synthesize returnInfo = _returnInfo;
 
 @synthesize error = _error;
 
+- (void)setError:(NSError *)error
+{
+    if (_error == error) {
+        return;
+    }
+    
+    [self.taskGroup taskStatusWillChange:self];
+    [_error release];
+    _error = [error retain];
+    [self.taskGroup taskStatusDidChange:self];
+}
+
 @synthesize taskGroup = _taskGroup;
 
+@synthesize cancellationToken = _cancellationToken;
+
 - (NSString *)remainingTimeIntervalEstimateLocalizedString
 {
     if (self.remainingTimeIntervalEstimate == kTaskGroupNoTimeIntervalEstimateAvailable) {
@@ -182,9 +206,47 @@ const NSUInteger kProgressStepsCounterThreshold = 50;
     self.cancelled = NO;
     self.progress = 0.f;
     self.remainingTimeIntervalEstimate = kTaskNoTimeIntervalEstimateAvailable;
-    self.lastEstimateDate = nil;
+    [self.remainingTimeEstimator reset];
     self.returnInfo = nil;
     self.error = nil;
 }
 
+#pragma mark -
+#pragma mark Sharing results
+
+- (void)copyResultsFromTask:(HLSTask *)task
+{
+    self.returnInfo = task.returnInfo;
+    self.error = task.error;
+}
+
+#pragma mark -
+#pragma mark Snapshots
+
+- (HLSTask *)snapshot
+{
+    HLSTask *snapshot = [[[[self class] alloc] init] autorelease];
+    [snapshot copyStatusFromTask:self];
+    return snapshot;
+}
+
+- (void)copyStatusFromTask:(HLSTask *)task
+{
+    self.tag = task.tag;
+    self.userInfo = task.userInfo;
+    self.priority = task.priority;
+    self.deduplicationKey = task.deduplicationKey;
+    self.journalKey = task.journalKey;
+    self.cancellationToken = task.cancellationToken;
+    
+    // Copy the values as is, the setters would feed the remaining time estimator
+    _running = task->_running;
+    _finished = task->_finished;
+    _cancelled = task->_cancelled;
+    _progress = task->_progress;
+    _remainingTimeIntervalEstimate = task->_remainingTimeIntervalEstimate;
+    
+    [self copyResultsFromTask:task];
+}
+
 @end
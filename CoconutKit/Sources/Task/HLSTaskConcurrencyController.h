@@ -0,0 +1,61 @@
+//
+//  HLSTaskConcurrencyController.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Private class used by HLSTaskManager to tune the number of tasks a priority lane processes simultaneously. 
+ * The controller observes when operations start and end, and periodically compares the throughput (operations
+ * completed per second) and the mean latency (execution time) measured over consecutive windows, following
+ * an AIMD (additive increase, multiplicative decrease) scheme:
+ *   - as long as the lane has headroom, i.e. latency stays close to the best latency observed and throughput
+ *     does not drop, the number of concurrent operations is increased by one
+ *   - when the lane appears saturated (latency inflates or throughput drops after an increase), the number of
+ *     concurrent operations is halved
+ * The number of concurrent operations always stays between the minimum and maximum values provided at 
+ * creation.
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -initWithMinimumCount:maximumCount:
+ */
+@interface HLSTaskConcurrencyController : NSObject {
+@private
+    NSInteger m_minimumCount;
+    NSInteger m_maximumCount;
+    NSInteger m_count;
+    NSMutableDictionary *m_operationToStartTimeMap;         // NSValue operation pointer -> NSNumber absolute start time
+    CFAbsoluteTime m_windowStartTime;
+    NSUInteger m_windowCompletionCount;
+    CFTimeInterval m_windowTotalLatency;
+    double m_previousThroughput;
+    CFTimeInterval m_bestLatency;
+    BOOL m_increasedInPreviousWindow;
+}
+
+/**
+ * Create a controller. The initial value is the minimum one
+ */
+- (id)initWithMinimumCount:(NSInteger)minimumCount maximumCount:(NSInteger)maximumCount;
+
+/**
+ * The current number of operations which should be processed simultaneously
+ */
+@property (nonatomic, readonly, assign) NSInteger count;
+
+/**
+ * Must be called when an operation starts executing
+ */
+- (void)recordStartOfOperation:(id)operation;
+
+/**
+ * Must be called when an operation ends. Operations which did not complete normally (e.g. cancelled ones) must also 
+ * be reported, with completed set to NO, so that they do not bias measurements. Return YES iff the number of 
+ * concurrent operations has changed
+ */
+- (BOOL)recordEndOfOperation:(id)operation completed:(BOOL)completed;
+
+@end
@@ -0,0 +1,160 @@
+//
+//  HLSTaskConcurrencyController.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskConcurrencyController.h"
+
+#import "HLSLogger.h"
+
+// Minimum number of completions a measurement window contains
+static const NSUInteger kMinimumWindowCompletionCount = 4;
+
+// Latency inflation factor above which a lane is considered saturated
+static const double kLatencyInflationThreshold = 2.;
+
+// Relative throughput drop considered significant
+static const double kThroughputDropThreshold = 0.9;
+
+// The best latency is slowly forgotten, so that the controller can adapt when the nature of the work changes
+static const double kBestLatencyDecayFactor = 1.05;
+
+@interface HLSTaskConcurrencyController ()
+
+- (void)evaluateWindow;
+
+@end
+
+@implementation HLSTaskConcurrencyController
+
+#pragma mark Object creation and destruction
+
+- (id)initWithMinimumCount:(NSInteger)minimumCount maximumCount:(NSInteger)maximumCount
+{
+    if ((self = [super init])) {
+        if (maximumCount < minimumCount) {
+            HLSLoggerWarn(@"The maximum count cannot be smaller than the minimum count. Fixed");
+            maximumCount = minimumCount;
+        }
+        
+        m_minimumCount = minimumCount;
+        m_maximumCount = maximumCount;
+        m_count = minimumCount;
+        m_operationToStartTimeMap = [[NSMutableDictionary alloc] init];
+        m_windowStartTime = CFAbsoluteTimeGetCurrent();
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithMinimumCount:2 maximumCount:2];
+}
+
+- (void)dealloc
+{
+    [m_operationToStartTimeMap release];
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize count = m_count;
+
+#pragma mark Measurements
+
+- (void)recordStartOfOperation:(id)operation
+{
+    // Idle time before the first operation of a window must not be mistaken for a throughput drop
+    if ([m_operationToStartTimeMap count] == 0 && m_windowCompletionCount == 0) {
+        m_windowStartTime = CFAbsoluteTimeGetCurrent();
+    }
+    
+    NSValue *operationKey = [NSValue valueWithPointer:operation];
+    [m_operationToStartTimeMap setObject:[NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent()] forKey:operationKey];
+}
+
+- (BOOL)recordEndOfOperation:(id)operation completed:(BOOL)completed
+{
+    NSValue *operationKey = [NSValue valueWithPointer:operation];
+    NSNumber *startTimeNumber = [m_operationToStartTimeMap objectForKey:operationKey];
+    if (! startTimeNumber) {
+        // Never started (e.g. cancelled while waiting)
+        return NO;
+    }
+    
+    CFTimeInterval latency = CFAbsoluteTimeGetCurrent() - [startTimeNumber doubleValue];
+    [m_operationToStartTimeMap removeObjectForKey:operationKey];
+    
+    if (! completed) {
+        return NO;
+    }
+    
+    ++m_windowCompletionCount;
+    m_windowTotalLatency += latency;
+    
+    // Windows scale with the number of concurrent operations, so that each one contains enough measurements
+    if (m_windowCompletionCount < MAX(kMinimumWindowCompletionCount, 2 * m_count)) {
+        return NO;
+    }
+    
+    NSInteger previousCount = m_count;
+    [self evaluateWindow];
+    return m_count != previousCount;
+}
+
+- (void)evaluateWindow
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    CFTimeInterval windowDuration = now - m_windowStartTime;
+    double throughput = (windowDuration > 0.) ? m_windowCompletionCount / windowDuration : 0.;
+    CFTimeInterval latency = m_windowTotalLatency / m_windowCompletionCount;
+    
+    if (m_bestLatency == 0. || latency < m_bestLatency) {
+        m_bestLatency = latency;
+    }
+    
+    // Saturated if latency inflates, or if the last increase did not help
+    BOOL saturated = (latency > kLatencyInflationThreshold * m_bestLatency)
+        || (m_increasedInPreviousWindow && throughput < kThroughputDropThreshold * m_previousThroughput);
+    if (saturated) {
+        m_count = MAX(m_minimumCount, m_count / 2);
+        m_increasedInPreviousWindow = NO;
+        HLSLoggerDebug(@"Saturation detected (throughput %.1f/s, latency %.3fs); concurrent task count decreased to %d", 
+                       throughput, latency, m_count);
+    }
+    else if (m_count < m_maximumCount) {
+        ++m_count;
+        m_increasedInPreviousWindow = YES;
+        HLSLoggerDebug(@"Headroom detected (throughput %.1f/s, latency %.3fs); concurrent task count increased to %d", 
+                       throughput, latency, m_count);
+    }
+    else {
+        m_increasedInPreviousWindow = NO;
+    }
+    
+    m_bestLatency *= kBestLatencyDecayFactor;
+    m_previousThroughput = throughput;
+    
+    // Start a new window
+    m_windowStartTime = now;
+    m_windowCompletionCount = 0;
+    m_windowTotalLatency = 0.;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %d; minimumCount: %d; maximumCount: %d>",
+            [self class],
+            self,
+            m_count,
+            m_minimumCount,
+            m_maximumCount];
+}
+
+@end
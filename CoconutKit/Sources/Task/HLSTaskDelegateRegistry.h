@@ -0,0 +1,95 @@
+//
+//  HLSTaskDelegateRegistry.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Private class used by HLSTaskManager to store the relationships between tasks (or task groups) and their
+ * delegates. Both directions are indexed, so that finding the delegate of an object or all objects bound to
+ * a delegate is cheap. Insertion and removal are O(1) and do not allocate any temporary key objects.
+ *
+ * A registration can optionally specify the dispatch queue onto which the delegate wants to be notified.
+ *
+ * The optional delegate methods the registry is interested in can be given at creation time. Whether a delegate
+ * implements them is checked once, when the delegate is registered for its first object, and stored as a bitmask,
+ * so that notifying delegates does not require any dynamic method lookup.
+ *
+ * Objects (tasks or task groups) are retained by the registry as long as they are registered, delegates are
+ * not (as usual with delegates, they are responsible of unregistering themselves before they die). Identity is
+ * based on pointers, -isEqual: and -hash are never called.
+ *
+ * Though delegates are usually unregistered from their -dealloc method, it is guaranteed that no delegate can
+ * be deallocated while the registry is modified, since the registry never owns delegates. Registrations can
+ * therefore be safely added or removed from within a delegate -dealloc method.
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -initWithOptionalSelectors:count:
+ */
+@interface HLSTaskDelegateRegistry : NSObject {
+@private
+    CFMutableDictionaryRef m_objectToDelegateMap;           // object -> delegate (object retained, delegate not retained)
+    CFMutableDictionaryRef m_delegateToObjectsMap;          // delegate -> CFMutableSetRef of objects (delegate not retained)
+    CFMutableDictionaryRef m_objectToQueueMap;              // object -> dispatch_queue_t (queue retained), only for registrations with a queue
+    CFMutableDictionaryRef m_delegateToCapabilitiesMap;     // delegate -> bitmask of the optional selectors it implements (delegate not retained)
+    SEL *m_optionalSelectors;
+    NSUInteger m_optionalSelectorCount;
+}
+
+/**
+ * Create a registry whose delegates may implement the given optional selectors (at most 32). The selectors are
+ * copied
+ */
+- (id)initWithOptionalSelectors:(const SEL *)optionalSelectors count:(NSUInteger)count;
+
+/**
+ * Register a delegate for an object. Any existing registration for this object is replaced
+ */
+- (void)registerDelegate:(id)delegate forObject:(id)object;
+
+/**
+ * Same as -registerDelegate:forObject:, but with the queue onto which the delegate must be notified (NULL if none)
+ */
+- (void)registerDelegate:(id)delegate forObject:(id)object queue:(dispatch_queue_t)queue;
+
+/**
+ * Remove the delegate registration of an object (if any)
+ */
+- (void)unregisterDelegateForObject:(id)object;
+
+/**
+ * Remove all registrations involving a delegate
+ */
+- (void)unregisterDelegate:(id)delegate;
+
+/**
+ * Return the delegate registered for an object, nil if none
+ */
+- (id)delegateForObject:(id)object;
+
+/**
+ * Return the delegate registered for an object if it implements the given selector, nil otherwise. For optional
+ * selectors received at creation time, no dynamic method lookup is made
+ */
+- (id)delegateForObject:(id)object respondingToSelector:(SEL)selector;
+
+/**
+ * Return the queue onto which the delegate of an object must be notified, NULL if none
+ */
+- (dispatch_queue_t)queueForObject:(id)object;
+
+/**
+ * Return a snapshot of the objects a delegate has been registered for (can therefore be safely enumerated
+ * while altering the registry). Returns an empty set if none
+ */
+- (NSSet *)objectsForDelegate:(id)delegate;
+
+/**
+ * The number of registered objects
+ */
+- (NSUInteger)count;
+
+@end
@@ -0,0 +1,260 @@
+//
+//  HLSTaskDelegateRegistry.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskDelegateRegistry.h"
+
+// Remark: CoreFoundation collections are used so that keys are compared by pointer, without having to box them
+//         into NSValue objects (which was previously done, incurring an allocation for each lookup). Delegates
+//         are stored as plain pointers so that the registry never owns them: Removing a registration therefore
+//         can never deallocate a delegate, whose -dealloc method would then likely alter the registry while it
+//         is being modified
+
+@implementation HLSTaskDelegateRegistry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithOptionalSelectors:(const SEL *)optionalSelectors count:(NSUInteger)count
+{
+    if ((self = [super init])) {
+        NSAssert(count <= 32, @"At most 32 optional selectors can be tracked");
+        
+        // Objects are retained, but compared by pointer
+        CFDictionaryKeyCallBacks objectKeyCallbacks = kCFTypeDictionaryKeyCallBacks;
+        objectKeyCallbacks.equal = NULL;
+        objectKeyCallbacks.hash = NULL;
+        m_objectToDelegateMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &objectKeyCallbacks, NULL);
+
+        // Delegates are not retained, the object sets they are mapped to are
+        m_delegateToObjectsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        
+        // Objects are owned by the forward map, queues are retained and released manually
+        m_objectToQueueMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        
+        // Bitmasks are stored as plain pointer-sized integers
+        m_delegateToCapabilitiesMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        
+        if (count != 0) {
+            m_optionalSelectors = malloc(count * sizeof(SEL));
+            memcpy(m_optionalSelectors, optionalSelectors, count * sizeof(SEL));
+        }
+        m_optionalSelectorCount = count;
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithOptionalSelectors:NULL count:0];
+}
+
+- (void)dealloc
+{
+    CFRelease(m_objectToDelegateMap);
+    CFRelease(m_delegateToObjectsMap);
+    
+    CFIndex count = CFDictionaryGetCount(m_objectToQueueMap);
+    const void **queues = malloc(count * sizeof(const void *));
+    CFDictionaryGetKeysAndValues(m_objectToQueueMap, NULL, queues);
+    for (CFIndex i = 0; i < count; ++i) {
+        dispatch_release((dispatch_queue_t)queues[i]);
+    }
+    free(queues);
+    CFRelease(m_objectToQueueMap);
+    CFRelease(m_delegateToCapabilitiesMap);
+    free(m_optionalSelectors);
+    
+    [super dealloc];
+}
+
+#pragma mark Registration
+
+- (void)registerDelegate:(id)delegate forObject:(id)object
+{
+    [self registerDelegate:delegate forObject:object queue:NULL];
+}
+
+- (void)registerDelegate:(id)delegate forObject:(id)object queue:(dispatch_queue_t)queue
+{
+    if (! object) {
+        return;
+    }
+
+    // Remove any existing registration first
+    [self unregisterDelegateForObject:object];
+
+    if (! delegate) {
+        return;
+    }
+
+    CFDictionarySetValue(m_objectToDelegateMap, object, delegate);
+
+    // Register the inverse delegate - object relationship. The set is created lazily, and the optional methods
+    // implemented by the delegate are checked at the same time
+    CFMutableSetRef objects = (CFMutableSetRef)CFDictionaryGetValue(m_delegateToObjectsMap, delegate);
+    if (! objects) {
+        objects = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        CFDictionarySetValue(m_delegateToObjectsMap, delegate, objects);
+        CFRelease(objects);
+        
+        uintptr_t capabilities = 0;
+        for (NSUInteger i = 0; i < m_optionalSelectorCount; ++i) {
+            if ([delegate respondsToSelector:m_optionalSelectors[i]]) {
+                capabilities |= ((uintptr_t)1 << i);
+            }
+        }
+        CFDictionarySetValue(m_delegateToCapabilitiesMap, delegate, (const void *)capabilities);
+    }
+    CFSetAddValue(objects, object);
+    
+    if (queue) {
+        dispatch_retain(queue);
+        CFDictionarySetValue(m_objectToQueueMap, object, queue);
+    }
+}
+
+- (void)unregisterDelegateForObject:(id)object
+{
+    if (! object) {
+        return;
+    }
+
+    id delegate = (id)CFDictionaryGetValue(m_objectToDelegateMap, object);
+    if (! delegate) {
+        return;
+    }
+
+    // Remove the inverse relationship first (the forward map is the one owning the object)
+    CFMutableSetRef objects = (CFMutableSetRef)CFDictionaryGetValue(m_delegateToObjectsMap, delegate);
+    if (objects) {
+        CFSetRemoveValue(objects, object);
+        if (CFSetGetCount(objects) == 0) {
+            CFDictionaryRemoveValue(m_delegateToObjectsMap, delegate);
+            CFDictionaryRemoveValue(m_delegateToCapabilitiesMap, delegate);
+        }
+    }
+
+    dispatch_queue_t queue = (dispatch_queue_t)CFDictionaryGetValue(m_objectToQueueMap, object);
+    if (queue) {
+        CFDictionaryRemoveValue(m_objectToQueueMap, object);
+        dispatch_release(queue);
+    }
+    
+    CFDictionaryRemoveValue(m_objectToDelegateMap, object);
+}
+
+- (void)unregisterDelegate:(id)delegate
+{
+    if (! delegate) {
+        return;
+    }
+
+    CFMutableSetRef objects = (CFMutableSetRef)CFDictionaryGetValue(m_delegateToObjectsMap, delegate);
+    if (! objects) {
+        return;
+    }
+
+    // Keep the set alive while we remove its entries from the forward map
+    CFRetain(objects);
+    CFDictionaryRemoveValue(m_delegateToObjectsMap, delegate);
+    CFDictionaryRemoveValue(m_delegateToCapabilitiesMap, delegate);
+
+    CFIndex count = CFSetGetCount(objects);
+    const void **values = malloc(count * sizeof(const void *));
+    CFSetGetValues(objects, values);
+    for (CFIndex i = 0; i < count; ++i) {
+        dispatch_queue_t queue = (dispatch_queue_t)CFDictionaryGetValue(m_objectToQueueMap, values[i]);
+        if (queue) {
+            CFDictionaryRemoveValue(m_objectToQueueMap, values[i]);
+            dispatch_release(queue);
+        }
+        CFDictionaryRemoveValue(m_objectToDelegateMap, values[i]);
+    }
+    free(values);
+
+    CFRelease(objects);
+}
+
+#pragma mark Lookup
+
+- (id)delegateForObject:(id)object
+{
+    if (! object) {
+        return nil;
+    }
+
+    return (id)CFDictionaryGetValue(m_objectToDelegateMap, object);
+}
+
+- (id)delegateForObject:(id)object respondingToSelector:(SEL)selector
+{
+    id delegate = [self delegateForObject:object];
+    if (! delegate) {
+        return nil;
+    }
+    
+    for (NSUInteger i = 0; i < m_optionalSelectorCount; ++i) {
+        if (m_optionalSelectors[i] == selector) {
+            uintptr_t capabilities = (uintptr_t)CFDictionaryGetValue(m_delegateToCapabilitiesMap, delegate);
+            if (capabilities & ((uintptr_t)1 << i)) {
+                return delegate;
+            }
+            else {
+                return nil;
+            }
+        }
+    }
+    
+    // Not an optional selector known to the registry
+    if ([delegate respondsToSelector:selector]) {
+        return delegate;
+    }
+    else {
+        return nil;
+    }
+}
+
+- (dispatch_queue_t)queueForObject:(id)object
+{
+    if (! object) {
+        return NULL;
+    }
+    
+    return (dispatch_queue_t)CFDictionaryGetValue(m_objectToQueueMap, object);
+}
+
+- (NSSet *)objectsForDelegate:(id)delegate
+{
+    if (! delegate) {
+        return [NSSet set];
+    }
+
+    CFSetRef objects = CFDictionaryGetValue(m_delegateToObjectsMap, delegate);
+    if (! objects) {
+        return [NSSet set];
+    }
+
+    return [NSSet setWithSet:(NSSet *)objects];
+}
+
+- (NSUInteger)count
+{
+    return CFDictionaryGetCount(m_objectToDelegateMap);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %d; delegateCount: %d>",
+            [self class],
+            self,
+            [self count],
+            CFDictionaryGetCount(m_delegateToObjectsMap)];
+}
+
+@end
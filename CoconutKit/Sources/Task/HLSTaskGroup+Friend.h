@@ -13,10 +13,17 @@
 @interface HLSTaskGroup (Friend)
 
 /**
- * Ask the task group to refresh its status based on the current status of its tasks
+ * Ask the task group to refresh its status based on the current status of its tasks. Runs in constant time
  */
 - (void)updateStatus;
 
+/**
+ * Must be called by a task belonging to the task group before and after its progress, error or finished status
+ * change, so that the task group can update its running aggregates by delta (instead of walking all tasks)
+ */
+- (void)taskStatusWillChange:(HLSTask *)task;
+- (void)taskStatusDidChange:(HLSTask *)task;
+
 @property (nonatomic, assign, getter=isRunning) BOOL running;
 
 @property (nonatomic, assign, getter=isFinished) BOOL finished;
@@ -37,9 +44,34 @@
 - (NSSet *)weakDependentsForTask:(HLSTask *)task;
 - (NSSet *)strongDependentsForTask:(HLSTask *)task;
 
+/**
+ * Return the number of tasks in the longest chain of tasks depending (directly or indirectly) on a task, the task
+ * itself included (i.e. 1 if no task depends on it)
+ */
+- (NSUInteger)criticalPathLengthForTask:(HLSTask *)task;
+
+/**
+ * Store the object the operation of a task hands over to its dependents (nil to remove it), and retrieve it. These
+ * methods can be called from any thread
+ */
+- (void)setOutput:(id)output forTask:(HLSTask *)task;
+- (id)outputForTask:(HLSTask *)task;
+
+/**
+ * Must be called when a task has ended. Release the outputs of the task and of its dependencies which are not needed
+ * by any other dependent task anymore
+ */
+- (void)releaseOutputsNoLongerNeededAfterTask:(HLSTask *)task;
+
 /**
  * Reset internal status variables
  */
 - (void)reset;
 
+/**
+ * Return a copy of the task group frozen in its current status, meant to be handed over to delegates notified on
+ * another thread. The copy contains the same tasks, which are not detached from the original task group
+ */
+- (HLSTaskGroup *)snapshot;
+
 @end
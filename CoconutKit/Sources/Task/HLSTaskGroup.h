@@ -11,6 +11,8 @@
 #define kTaskGroupNoTimeIntervalEstimateAvailable                     -1.
 
 // Forward declarations
+@class HLSRemainingTimeEstimator;
+@class HLSTaskJournal;
 @protocol HLSTaskGroupDelegate;
 
 /**
@@ -30,21 +32,28 @@
 @private
     NSString *_tag;
     NSDictionary *_userInfo;
+    HLSTaskPriority _priority;
     NSMutableSet *_taskSet;                                     // contains HLSTask objects
     // Dependencies between tasks are saved in both directions for faster lookup
     NSMutableDictionary *_weakTaskDependencyMap;                // maps an HLSTask object to the NSMutableSet of all other HLSTask objects it weakly depends on
     NSMutableDictionary *_strongTaskDependencyMap;              // maps an HLSTask object to the NSMutableSet of all other HLSTask objects it strongly depends on
     NSMutableDictionary *_taskToWeakDependentsMap;              // maps an HLSTask object to the NSMutableSet of all HLSTask objects weakly depending on it
     NSMutableDictionary *_taskToStrongDependentsMap;            // maps an HLSTask object to the NSMutableSet of all HLSTask objects strongly depending on it
+    NSMutableDictionary *_criticalPathLengthCache;              // maps an HLSTask object to the NSNumber length of the longest dependent chain it starts
+    NSMutableDictionary *_taskToOutputMap;                      // maps an HLSTask object to the object its operation hands over to its dependents (access synchronized)
+    HLSTaskJournal *_journal;
     BOOL _running;
     BOOL _finished;
     BOOL _cancelled;
     float _progress;                            // all individual progress values added
     float _fullProgress;                        // all individual progress values added (failures count as 1.f). 1 - _fullProgress is remainder
     NSTimeInterval _remainingTimeIntervalEstimate;
-    NSDate *_lastEstimateDate;                  // date & time when the remaining time was previously estimated ...
-    float _lastEstimateFullProgress;            // ... and corresponding progress value 
-    NSUInteger _fullProgressStepsCounter;     
+    HLSRemainingTimeEstimator *_remainingTimeEstimator;
+    NSDate *_startDate;                         // date & time at which processing started
+    // Running aggregates over all tasks, updated by delta when a task status changes
+    double _progressSum;                        // sum of all individual progress values
+    double _fullProgressSum;                    // sum of all individual progress values (failures count as 1.)
+    NSUInteger _nbrFinishedTasks;
     NSUInteger _nbrFailures;
 }
 
@@ -58,6 +67,23 @@
  */
 @property (nonatomic, retain) NSDictionary *userInfo;
 
+/**
+ * The priority with which all tasks of the group are processed (default is HLSTaskPriorityUserInitiated). The 
+ * priorities of the individual tasks are ignored. Changing the priority of a task group which has already been 
+ * submitted has no effect
+ */
+@property (nonatomic, assign) HLSTaskPriority priority;
+
+/**
+ * Optional journal in which the tasks which have been successfully processed are recorded (nil by default; see
+ * HLSTaskJournal). When the task group is submitted, tasks with a journal key already recorded in the journal are
+ * not processed again, and immediately receive the return information which was recorded (their delegates are
+ * notified as if they had been processed). Outputs handed over to dependents are not journaled, though. The journal 
+ * is cleared once the task group has been processed without any failure, or when it is cancelled. Changing the 
+ * journal of a task group which has already been submitted has no effect
+ */
+@property (nonatomic, retain) HLSTaskJournal *journal;
+
 /**
  * Add a task to the task group
  */
@@ -90,7 +116,9 @@
 
 /**
  * Return an estimate about the remaining time before the task group processing completes (or kTaskGroupNoTimeIntervalEstimateAvailable if no
- * estimate is available yet)
+ * estimate is available yet). The estimate is based on a smoothed progress rate. For tagged task groups, the durations of task groups 
+ * previously processed with the same tag are remembered and used until enough progress has been measured, so that an estimate 
+ * is available right from the start
  * Important remark: Accurate measurements can only be obtained if the progress update rate of a task group is not varying fast (in another
  *                   words: Constant over long enough periods of time). This is most likely to happen when all tasks are similar (i.e. the
  *                   underlying processing is similar) and roughly of the same size.
@@ -115,6 +143,15 @@
  * task1 will only begin processing once task2 has been fully processed. Moreover, if the strong boolean is set to YES, task1 will be
  * cancelled before it starts if task2 failed or was cancelled ("strong dependency"). Otherwise task1 will be started after task2 ends, no
  * matter what happened with task2 ("weak dependency")
+ *
+ * Dependencies must not form cycles. A dependency which would introduce a cycle is rejected (an error is logged)
+ *
+ * When a task group is processed, tasks whose dependencies have all been processed are started first if they begin 
+ * the longest chain of dependent tasks. This way groups with deep dependency chains complete sooner.
+ *
+ * Operations can hand an object directly over to the operations of dependent tasks (see -attachOutput: in 
+ * HLSTaskOperation+Protected.h), e.g. for download -> decode -> resize chains. The object is neither copied nor
+ * delivered to the thread which submitted the task group, and is released as soon as all dependents have ended.
  */
 - (void)addDependencyForTask:(HLSTask *)task1 onTask:(HLSTask *)task2 strong:(BOOL)strong;
 
@@ -8,8 +8,10 @@
 
 #import "HLSTaskGroup.h"
 
+#import "HLSAllocationTracker+Friend.h"
 #import "HLSFloat.h"
 #import "HLSLogger.h"
+#import "HLSRemainingTimeEstimator.h"
 #import "HLSTask+Friend.h"
 #import "NSBundle+HLSExtensions.h"
 
@@ -19,7 +21,11 @@
 // keep everything simple (because it is already complicated enough), I chose to create two separate kinds of
 // objects instead.
 
-const NSUInteger kFullProgressStepsCounterThreshold = 50;
+// Weight of the last duration in the per-tag history
+static const double kDurationHistorySmoothingFactor = 0.3;
+
+// Maps tags to the NSNumber (smoothed) durations of the task groups with this tag which completed successfully
+static NSMutableDictionary *s_tagToExpectedDurationMap = nil;
 
 @interface HLSTaskGroup ()
 
@@ -28,15 +34,23 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 @property (nonatomic, retain) NSMutableDictionary *strongTaskDependencyMap;
 @property (nonatomic, retain) NSMutableDictionary *taskToWeakDependentsMap;
 @property (nonatomic, retain) NSMutableDictionary *taskToStrongDependentsMap;
+@property (nonatomic, retain) NSMutableDictionary *criticalPathLengthCache;
+@property (nonatomic, retain) NSMutableDictionary *taskToOutputMap;
 @property (nonatomic, assign, getter=isRunning) BOOL running;
 @property (nonatomic, assign, getter=isFinished) BOOL finished;
 @property (nonatomic, assign, getter=isCancelled) BOOL cancelled;
 @property (nonatomic, assign) float progress;
 @property (nonatomic, assign) float fullProgress;
 @property (nonatomic, assign) NSTimeInterval remainingTimeIntervalEstimate;
-@property (nonatomic, retain) NSDate *lastEstimateDate;
+@property (nonatomic, retain) HLSRemainingTimeEstimator *remainingTimeEstimator;
+@property (nonatomic, retain) NSDate *startDate;
+
++ (NSTimeInterval)expectedDurationForTag:(NSString *)tag;
++ (void)recordDuration:(NSTimeInterval)duration forTag:(NSString *)tag;
 
 - (void)updateStatus;
+- (void)taskStatusWillChange:(HLSTask *)task;
+- (void)taskStatusDidChange:(HLSTask *)task;
 
 - (NSSet *)dependenciesForTask:(HLSTask *)task;
 - (NSSet *)weakDependenciesForTask:(HLSTask *)task;
@@ -46,8 +60,17 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 - (NSSet *)weakDependentsForTask:(HLSTask *)task;
 - (NSSet *)strongDependentsForTask:(HLSTask *)task;
 
+- (BOOL)task:(HLSTask *)task1 transitivelyDependsOnTask:(HLSTask *)task2;
+- (NSUInteger)criticalPathLengthForTask:(HLSTask *)task;
+
+- (void)setOutput:(id)output forTask:(HLSTask *)task;
+- (id)outputForTask:(HLSTask *)task;
+- (void)releaseOutputsNoLongerNeededAfterTask:(HLSTask *)task;
+
 - (void)reset;
 
+- (HLSTaskGroup *)snapshot;
+
 @end
 
 @implementation HLSTaskGroup
@@ -58,11 +81,15 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 - (id)init
 {
     if ((self = [super init])) {
+        self.priority = HLSTaskPriorityUserInitiated;
         self.taskSet = [NSMutableSet set];
         self.weakTaskDependencyMap = [NSMutableDictionary dictionary];
         self.strongTaskDependencyMap = [NSMutableDictionary dictionary];
         self.taskToWeakDependentsMap = [NSMutableDictionary dictionary];
         self.taskToStrongDependentsMap = [NSMutableDictionary dictionary];
+        self.criticalPathLengthCache = [NSMutableDictionary dictionary];
+        self.taskToOutputMap = [NSMutableDictionary dictionary];
+        self.remainingTimeEstimator = [[[HLSRemainingTimeEstimator alloc] init] autorelease];
         [self reset];
     }
     return self;
@@ -70,6 +97,14 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 
 - (void)dealloc
 {
+    // Tasks can outlive their task group. Since they notify it about status changes, their weak ref must be cleared
+    // (snapshots contain the tasks of another task group)
+    for (HLSTask *task in self.taskSet) {
+        if (task.taskGroup == self) {
+            task.taskGroup = nil;
+        }
+    }
+    
     self.tag = nil;
     self.userInfo = nil;
     self.taskSet = nil;
@@ -77,7 +112,11 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
     self.strongTaskDependencyMap = nil;
     self.taskToWeakDependentsMap = nil;
     self.taskToStrongDependentsMap = nil;
-    self.lastEstimateDate = nil;
+    self.criticalPathLengthCache = nil;
+    self.taskToOutputMap = nil;
+    self.journal = nil;
+    self.remainingTimeEstimator = nil;
+    self.startDate = nil;
     [super dealloc];
 }
 
@@ -88,6 +127,10 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 
 @synthesize userInfo = _userInfo;
 
+@synthesize priority = _priority;
+
+@synthesize journal = _journal;
+
 @synthesize taskSet = _taskSet;
 
 - (NSSet *)tasks
@@ -103,8 +146,30 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 
 @synthesize taskToStrongDependentsMap = _taskToStrongDependentsMap;
 
+@synthesize criticalPathLengthCache = _criticalPathLengthCache;
+
 @synthesize running = _running;
 
+- (void)setRunning:(BOOL)running
+{
+    if (running == _running) {
+        return;
+    }
+    
+    _running = running;
+    
+    // Remember how long task groups take to complete, so that better estimates are available the next time
+    if (running) {
+        self.startDate = [NSDate date];
+    }
+    else if (self.startDate) {
+        if (self.finished && ! self.cancelled && self.nbrFailures == 0) {
+            [HLSTaskGroup recordDuration:[[NSDate date] timeIntervalSinceDate:self.startDate] forTag:self.tag];
+        }
+        self.startDate = nil;
+    }
+}
+
 @synthesize finished = _finished;
 
 @synthesize cancelled = _cancelled;
@@ -134,32 +199,10 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
         _fullProgress = fullProgress;
     }    
     
-    // Estimation is not made with each progress value change. If progress values are incremented fast, it is calculated
-    // after several changes. If progress value change is slow, we use a time difference criterium. This should provide
-    // accurate enough results
-    if (! _lastEstimateDate) {
-        _fullProgressStepsCounter = 0;
-        self.lastEstimateDate = [NSDate date];
-        _lastEstimateFullProgress = fullProgress;
-    }
-    else {
-        ++_fullProgressStepsCounter;
-    }
-    
-    // Should update estimate?
-    NSTimeInterval elapsedTimeIntervalSinceLastEstimate = [[NSDate date] timeIntervalSinceDate:self.lastEstimateDate];
-    if (_fullProgressStepsCounter > kFullProgressStepsCounterThreshold) {
-        // Calculate estimate based on velocity during previous step
-        double fullProgressSinceLastEstimate = fullProgress - _lastEstimateFullProgress;
-        if (! doubleeq(fullProgressSinceLastEstimate, 0.)) {
-            self.remainingTimeIntervalEstimate = (elapsedTimeIntervalSinceLastEstimate / fullProgressSinceLastEstimate) * (1 - fullProgress);
-            
-            // Get ready for next estimate
-            _fullProgressStepsCounter = 0;
-            self.lastEstimateDate = [NSDate date];
-            _lastEstimateFullProgress = fullProgress;
-        }
-    }
+    // The estimator smoothes the progress rate, values can therefore be fed as often as they change
+    [self.remainingTimeEstimator addSampleWithProgress:_fullProgress];
+    NSTimeInterval remainingTimeIntervalEstimate = [self.remainingTimeEstimator remainingTimeIntervalForProgress:_fullProgress];
+    self.remainingTimeIntervalEstimate = (remainingTimeIntervalEstimate >= 0.) ? remainingTimeIntervalEstimate : kTaskGroupNoTimeIntervalEstimateAvailable;
 }
 
 @synthesize remainingTimeIntervalEstimate = _remainingTimeIntervalEstimate;
@@ -174,7 +217,9 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
     }
 }
 
-@synthesize lastEstimateDate = _lastEstimateDate;
+@synthesize remainingTimeEstimator = _remainingTimeEstimator;
+
+@synthesize startDate = _startDate;
 
 
 - (NSUInteger)nbrFailures
@@ -219,8 +264,13 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
         return;
     }
     
+    if ([self.taskSet containsObject:task]) {
+        return;
+    }
+    
     [self.taskSet addObject:task];
     task.taskGroup = self;
+    [self taskStatusDidChange:task];
 }
 
 #pragma mark -
@@ -228,34 +278,53 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
 
 - (void)updateStatus
 {
-    // Calculate the overall progress and status
-    float progress = 0.f;
-    float fullProgress = 0.f;
-    BOOL finished = YES;
-    for (HLSTask *task in self.taskSet) {
-        progress += task.progress;
-        
-        // If at least one task is not finished, so is the task group
-        if (! task.finished) {
-            finished = NO;
-        }
-        
-        // Failed tasks increase the failure counter and count for 1 in fullProgress
-        if (task.error) {
-            fullProgress += 1.f;
-            ++_nbrFailures;
-        }
-        else {
-            fullProgress += task.progress;
-        }
+    NSUInteger nbrTasks = [self.taskSet count];
+    if (nbrTasks == 0) {
+        return;
+    }
+    
+    // The aggregates are kept up to date by the tasks themselves. Clamp to absorb rounding errors accumulated 
+    // while adding and subtracting deltas
+    self.progress = MIN(MAX(_progressSum / nbrTasks, 0.), 1.);
+    self.fullProgress = MIN(MAX(_fullProgressSum / nbrTasks, 0.), 1.);
+    self.finished = (_nbrFinishedTasks == nbrTasks);
+}
+
+- (void)taskStatusWillChange:(HLSTask *)task
+{
+    // Remove the current contribution of the task
+    _progressSum -= task.progress;
+    
+    // Failed tasks count for 1 in fullProgress
+    if (task.error) {
+        _fullProgressSum -= 1.;
+        --_nbrFailures;
+    }
+    else {
+        _fullProgressSum -= task.progress;
+    }
+    
+    if (task.finished) {
+        --_nbrFinishedTasks;
+    }
+}
+
+- (void)taskStatusDidChange:(HLSTask *)task
+{
+    // Add the new contribution of the task
+    _progressSum += task.progress;
+    
+    if (task.error) {
+        _fullProgressSum += 1.;
+        ++_nbrFailures;
+    }
+    else {
+        _fullProgressSum += task.progress;
     }
-    progress /= [self.taskSet count];
-    fullProgress /= [self.taskSet count];
     
-    // Update the values stored internally
-    self.progress = progress;
-    self.fullProgress = fullProgress;
-    self.finished = finished;
+    if (task.finished) {
+        ++_nbrFinishedTasks;
+    }
 }
 
 #pragma mark -
@@ -276,6 +345,7 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
     // Cannot set a dependency on itself!
     if (task1 == task2) {
         HLSLoggerError(@"A task cannot add itself as dependency");
+        return;
     }
     
     // A dependency is either weak or strong, and cannot be registered several times
@@ -292,6 +362,13 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
         return;
     }
     
+    // Detect cycles now. They would otherwise lead to tasks waiting on each other forever
+    if ([self task:task2 transitivelyDependsOnTask:task1]) {
+        HLSLoggerError(@"Task %@ already depends on task %@; a dependency of the latter on the former would introduce a cycle", 
+                       task2, task1);
+        return;
+    }
+    
     // Register task2 in the dependencies of task1
     NSMutableDictionary *dependencyMap = strong ? self.strongTaskDependencyMap : self.weakTaskDependencyMap;
     NSMutableSet *task1Dependencies = [dependencyMap objectForKey:task1Key];
@@ -312,6 +389,49 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
         [taskToDependentsMap setObject:task2Dependents forKey:task2Key];
     }
     [task2Dependents addObject:task1];
+    
+    // Critical path lengths have changed
+    [self.criticalPathLengthCache removeAllObjects];
+}
+
+- (BOOL)task:(HLSTask *)task1 transitivelyDependsOnTask:(HLSTask *)task2
+{
+    // Depth-first search through the dependencies of task1, stopping as soon as task2 is found
+    NSMutableSet *visitedTasks = [NSMutableSet set];
+    NSMutableArray *tasksToVisit = [NSMutableArray arrayWithObject:task1];
+    while ([tasksToVisit count] != 0) {
+        HLSTask *task = [tasksToVisit lastObject];
+        [tasksToVisit removeLastObject];
+        
+        for (HLSTask *dependency in [self dependenciesForTask:task]) {
+            if (dependency == task2) {
+                return YES;
+            }
+            
+            if (! [visitedTasks containsObject:dependency]) {
+                [visitedTasks addObject:dependency];
+                [tasksToVisit addObject:dependency];
+            }
+        }
+    }
+    return NO;
+}
+
+- (NSUInteger)criticalPathLengthForTask:(HLSTask *)task
+{
+    NSValue *taskKey = [NSValue valueWithPointer:task];
+    NSNumber *criticalPathLengthNumber = [self.criticalPathLengthCache objectForKey:taskKey];
+    if (criticalPathLengthNumber) {
+        return [criticalPathLengthNumber unsignedIntegerValue];
+    }
+    
+    // The dependency graph is guaranteed to be acyclic, the recursion therefore terminates
+    NSUInteger criticalPathLength = 1;
+    for (HLSTask *dependent in [self dependentsForTask:task]) {
+        criticalPathLength = MAX(criticalPathLength, [self criticalPathLengthForTask:dependent] + 1);
+    }
+    [self.criticalPathLengthCache setObject:[NSNumber numberWithUnsignedInteger:criticalPathLength] forKey:taskKey];
+    return criticalPathLength;
 }
 
 - (NSSet *)dependenciesForTask:(HLSTask *)task
@@ -352,6 +472,81 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
     return [NSSet setWithSet:[self.taskToStrongDependentsMap objectForKey:taskKey]];    
 }
 
+#pragma mark -
+#pragma mark Handing outputs over to dependent tasks
+
+- (void)setOutput:(id)output forTask:(HLSTask *)task
+{
+    NSValue *taskKey = [NSValue valueWithPointer:task];
+    @synchronized(self.taskToOutputMap) {
+        if (output) {
+            [self.taskToOutputMap setObject:output forKey:taskKey];
+        }
+        else {
+            [self.taskToOutputMap removeObjectForKey:taskKey];
+        }
+    }
+}
+
+- (id)outputForTask:(HLSTask *)task
+{
+    NSValue *taskKey = [NSValue valueWithPointer:task];
+    @synchronized(self.taskToOutputMap) {
+        // Retained and autoreleased so that the output survives if released by another thread
+        return [[[self.taskToOutputMap objectForKey:taskKey] retain] autorelease];
+    }
+}
+
+- (void)releaseOutputsNoLongerNeededAfterTask:(HLSTask *)task
+{
+    NSSet *tasks = [[self dependenciesForTask:task] setByAddingObject:task];
+    for (HLSTask *candidateTask in tasks) {
+        BOOL needed = NO;
+        for (HLSTask *dependent in [self dependentsForTask:candidateTask]) {
+            if (! dependent.finished) {
+                needed = YES;
+                break;
+            }
+        }
+        
+        if (! needed) {
+            [self setOutput:nil forTask:candidateTask];
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Duration history
+
++ (NSTimeInterval)expectedDurationForTag:(NSString *)tag
+{
+    if (! tag) {
+        return 0.;
+    }
+    
+    @synchronized([HLSTaskGroup class]) {
+        return [[s_tagToExpectedDurationMap objectForKey:tag] doubleValue];
+    }
+}
+
++ (void)recordDuration:(NSTimeInterval)duration forTag:(NSString *)tag
+{
+    if (! tag) {
+        return;
+    }
+    
+    @synchronized([HLSTaskGroup class]) {
+        if (! s_tagToExpectedDurationMap) {
+            s_tagToExpectedDurationMap = [[NSMutableDictionary alloc] init];
+        }
+        
+        NSNumber *expectedDurationNumber = [s_tagToExpectedDurationMap objectForKey:tag];
+        NSTimeInterval expectedDuration = expectedDurationNumber ? kDurationHistorySmoothingFactor * duration 
+            + (1. - kDurationHistorySmoothingFactor) * [expectedDurationNumber doubleValue] : duration;
+        [s_tagToExpectedDurationMap setObject:[NSNumber numberWithDouble:expectedDuration] forKey:tag];
+    }
+}
+
 #pragma mark -
 #pragma mark Resetting
 
@@ -362,9 +557,50 @@ const NSUInteger kFullProgressStepsCounterThreshold = 50;
     self.cancelled = NO;
     self.progress = 0.f;
     self.fullProgress = 0.f;
-    self.remainingTimeIntervalEstimate = kTaskGroupNoTimeIntervalEstimateAvailable;
-    self.lastEstimateDate = nil;
+    [self.remainingTimeEstimator reset];
+    self.remainingTimeEstimator.expectedDuration = [HLSTaskGroup expectedDurationForTag:self.tag];
+    self.remainingTimeIntervalEstimate = self.remainingTimeEstimator.expectedDuration > 0. ? self.remainingTimeEstimator.expectedDuration : kTaskGroupNoTimeIntervalEstimateAvailable;
+    self.startDate = nil;
+    @synchronized(self.taskToOutputMap) {
+        [self.taskToOutputMap removeAllObjects];
+    }
+    
+    // Recalculate the aggregates from scratch (tasks are reset individually when they start, which then updates
+    // them by delta). This also gets rid of any rounding error accumulated during a previous run
+    _progressSum = 0.;
+    _fullProgressSum = 0.;
+    _nbrFinishedTasks = 0;
     _nbrFailures = 0;
+    for (HLSTask *task in self.taskSet) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemTask);
+        [self taskStatusDidChange:task];
+        HLSAutoreleasePoolPop(pool);
+    }
+}
+
+#pragma mark -
+#pragma mark Snapshots
+
+- (HLSTaskGroup *)snapshot
+{
+    HLSTaskGroup *snapshot = [[[HLSTaskGroup alloc] init] autorelease];
+    snapshot.tag = self.tag;
+    snapshot.userInfo = self.userInfo;
+    snapshot.priority = self.priority;
+    snapshot.taskSet = [NSMutableSet setWithSet:self.taskSet];
+    
+    // Copy the values as is, the setters would record durations and feed the remaining time estimator
+    snapshot->_running = _running;
+    snapshot->_finished = _finished;
+    snapshot->_cancelled = _cancelled;
+    snapshot->_progress = _progress;
+    snapshot->_fullProgress = _fullProgress;
+    snapshot->_remainingTimeIntervalEstimate = _remainingTimeIntervalEstimate;
+    snapshot->_progressSum = _progressSum;
+    snapshot->_fullProgressSum = _fullProgressSum;
+    snapshot->_nbrFinishedTasks = _nbrFinishedTasks;
+    snapshot->_nbrFailures = _nbrFailures;
+    return snapshot;
 }
 
 @end
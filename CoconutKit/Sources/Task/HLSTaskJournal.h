@@ -0,0 +1,73 @@
+//
+//  HLSTaskJournal.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * A task journal persistently records which tasks of a task group have been successfully processed, together with
+ * their return information. If a task group is interrupted (e.g. because the application has been killed) and 
+ * submitted again later with the same journal, tasks already processed are not processed again: They are directly
+ * flagged as processed, with the return information which was recorded.
+ *
+ * To use a journal, attach it to a task group (see HLSTaskGroup journal), and assign a journal key to each task
+ * which must be journaled (see HLSTask journalKey). Keys must be unique among the tasks sharing a journal, and
+ * must identify the work performed by a task between application launches (e.g. the URL of a file to download). 
+ * Once the task group has been fully and successfully processed, the journal is cleared, so that the next run
+ * processes all tasks again.
+ *
+ * The journal is a compact append-only file: Recording a task is cheap, and a record which could not be entirely
+ * written (e.g. because the application was killed at that time) is simply discarded when the journal is read again.
+ * Return information must only contain property list objects to be journaled (otherwise only the completion is 
+ * recorded, without return information).
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -initWithFilePath:
+ */
+@interface HLSTaskJournal : NSObject {
+@private
+    NSString *_filePath;
+    NSMutableDictionary *_keyToReturnInfoMap;
+    FILE *_file;
+}
+
+/**
+ * Open the journal stored at the specified location (which is created if it does not exist yet). Return nil if the
+ * file cannot be opened
+ */
+- (id)initWithFilePath:(NSString *)filePath;
+
+/**
+ * The location of the journal file
+ */
+@property (nonatomic, readonly, retain) NSString *filePath;
+
+/**
+ * Return YES iff the task with the specified key has been recorded as processed
+ */
+- (BOOL)containsEntryForKey:(NSString *)key;
+
+/**
+ * Return the return information recorded for the task with the specified key (nil if none)
+ */
+- (NSDictionary *)returnInfoForKey:(NSString *)key;
+
+/**
+ * Record that the task with the specified key has been processed. Any previous record for the same key is replaced
+ */
+- (void)recordCompletionForKey:(NSString *)key returnInfo:(NSDictionary *)returnInfo;
+
+/**
+ * Remove all records
+ */
+- (void)clear;
+
+/**
+ * The number of tasks recorded as processed
+ */
+- (NSUInteger)count;
+
+@end
@@ -0,0 +1,233 @@
+//
+//  HLSTaskJournal.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskJournal.h"
+
+#import "HLSAssert.h"
+#import "HLSLogger.h"
+
+#include <unistd.h>
+
+// Remark: Each record is made of its length (4 bytes, big endian), followed by a binary property list dictionary
+//         containing the key and the return information. Binary property lists are much more compact than keyed
+//         archives, and no index needs to be rewritten when appending
+
+static NSString * const kJournalKeyKey = @"k";
+static NSString * const kJournalReturnInfoKey = @"r";
+
+@interface HLSTaskJournal ()
+
+@property (nonatomic, retain) NSString *filePath;
+@property (nonatomic, retain) NSMutableDictionary *keyToReturnInfoMap;
+
+- (BOOL)readFile;
+- (BOOL)openFileForAppending;
+
+@end
+
+@implementation HLSTaskJournal
+
+#pragma mark Object creation and destruction
+
+- (id)initWithFilePath:(NSString *)filePath
+{
+    if ((self = [super init])) {
+        if (! filePath) {
+            HLSLoggerError(@"A file path is mandatory");
+            [self release];
+            return nil;
+        }
+        
+        self.filePath = filePath;
+        self.keyToReturnInfoMap = [NSMutableDictionary dictionary];
+        
+        if (! [self readFile] || ! [self openFileForAppending]) {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (id)init
+{
+    HLSForbiddenInheritedMethod();
+    return nil;
+}
+
+- (void)dealloc
+{
+    if (_file) {
+        fclose(_file);
+        _file = NULL;
+    }
+    
+    self.filePath = nil;
+    self.keyToReturnInfoMap = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize filePath = _filePath;
+
+@synthesize keyToReturnInfoMap = _keyToReturnInfoMap;
+
+#pragma mark Reading and opening the journal file
+
+- (BOOL)readFile
+{
+    // No journal yet
+    NSData *data = [NSData dataWithContentsOfFile:self.filePath];
+    if (! data) {
+        return YES;
+    }
+    
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    NSUInteger offset = 0;
+    while (offset + 4 <= length) {
+        uint32_t recordLength = ((uint32_t)bytes[offset] << 24) | ((uint32_t)bytes[offset + 1] << 16) 
+            | ((uint32_t)bytes[offset + 2] << 8) | (uint32_t)bytes[offset + 3];
+        if (offset + 4 + recordLength > length) {
+            break;
+        }
+        
+        NSData *recordData = [data subdataWithRange:NSMakeRange(offset + 4, recordLength)];
+        NSDictionary *record = [NSPropertyListSerialization propertyListWithData:recordData 
+                                                                         options:NSPropertyListImmutable 
+                                                                          format:NULL 
+                                                                           error:NULL];
+        NSString *key = [record isKindOfClass:[NSDictionary class]] ? [record objectForKey:kJournalKeyKey] : nil;
+        if (! key) {
+            break;
+        }
+        
+        id returnInfo = [record objectForKey:kJournalReturnInfoKey];
+        [self.keyToReturnInfoMap setObject:(returnInfo ? returnInfo : [NSNull null]) forKey:key];
+        
+        offset += 4 + recordLength;
+    }
+    
+    // Discard an incomplete or damaged record at the end, so that new records can be appended after the last valid one
+    if (offset != length) {
+        HLSLoggerWarn(@"The journal %@ ends with an incomplete record, which has been discarded", self.filePath);
+        if (truncate([self.filePath fileSystemRepresentation], offset) != 0) {
+            HLSLoggerError(@"The journal %@ could not be repaired", self.filePath);
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+- (BOOL)openFileForAppending
+{
+    _file = fopen([self.filePath fileSystemRepresentation], "ab");
+    if (! _file) {
+        HLSLoggerError(@"The journal %@ could not be opened", self.filePath);
+        return NO;
+    }
+    return YES;
+}
+
+#pragma mark Records
+
+- (BOOL)containsEntryForKey:(NSString *)key
+{
+    if (! key) {
+        return NO;
+    }
+    
+    return [self.keyToReturnInfoMap objectForKey:key] != nil;
+}
+
+- (NSDictionary *)returnInfoForKey:(NSString *)key
+{
+    if (! key) {
+        return nil;
+    }
+    
+    id returnInfo = [self.keyToReturnInfoMap objectForKey:key];
+    return returnInfo == [NSNull null] ? nil : returnInfo;
+}
+
+- (void)recordCompletionForKey:(NSString *)key returnInfo:(NSDictionary *)returnInfo
+{
+    if (! key) {
+        HLSLoggerError(@"Missing key");
+        return;
+    }
+    
+    if (! _file) {
+        HLSLoggerError(@"The journal %@ is not open", self.filePath);
+        return;
+    }
+    
+    NSMutableDictionary *record = [NSMutableDictionary dictionaryWithObject:key forKey:kJournalKeyKey];
+    if (returnInfo) {
+        if ([NSPropertyListSerialization propertyList:returnInfo isValidForFormat:NSPropertyListBinaryFormat_v1_0]) {
+            [record setObject:returnInfo forKey:kJournalReturnInfoKey];
+        }
+        else {
+            HLSLoggerWarn(@"The return information of the task with key %@ cannot be journaled", key);
+            returnInfo = nil;
+        }
+    }
+    
+    NSData *recordData = [NSPropertyListSerialization dataWithPropertyList:record 
+                                                                    format:NSPropertyListBinaryFormat_v1_0 
+                                                                   options:0 
+                                                                     error:NULL];
+    if (! recordData) {
+        HLSLoggerError(@"The task with key %@ could not be journaled", key);
+        return;
+    }
+    
+    uint32_t recordLength = (uint32_t)[recordData length];
+    uint8_t header[4] = { (recordLength >> 24) & 0xff, (recordLength >> 16) & 0xff, (recordLength >> 8) & 0xff, recordLength & 0xff };
+    if (fwrite(header, 1, sizeof(header), _file) != sizeof(header)
+            || fwrite([recordData bytes], 1, recordLength, _file) != recordLength
+            || fflush(_file) != 0) {
+        HLSLoggerError(@"The task with key %@ could not be journaled", key);
+        return;
+    }
+    
+    [self.keyToReturnInfoMap setObject:(returnInfo ? (id)returnInfo : [NSNull null]) forKey:key];
+}
+
+- (void)clear
+{
+    if (_file) {
+        fclose(_file);
+    }
+    _file = fopen([self.filePath fileSystemRepresentation], "wb");
+    if (! _file) {
+        HLSLoggerError(@"The journal %@ could not be cleared", self.filePath);
+    }
+    
+    [self.keyToReturnInfoMap removeAllObjects];
+}
+
+- (NSUInteger)count
+{
+    return [self.keyToReturnInfoMap count];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; filePath: %@; count: %d>",
+            [self class],
+            self,
+            self.filePath,
+            [self count]];
+}
+
+@end
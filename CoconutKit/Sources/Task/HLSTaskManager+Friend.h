@@ -19,6 +19,26 @@
  */
 - (void)unregisterOperation:(HLSTaskOperation *)operation;
 
+/**
+ * Must be called when an operation has started. Lanes with lower priority are then allowed to start tasks again
+ * if there is no more work waiting in higher priority lanes
+ */
+- (void)operationHasStarted:(HLSTaskOperation *)operation;
+
+/**
+ * Return the tasks which have been attached to an operation because they share the same deduplication key as the
+ * task it processes (the latter is not included). The array is a snapshot and can be safely enumerated while tasks
+ * are being cancelled
+ */
+- (NSArray *)subscriberTasksForOperation:(HLSTaskOperation *)operation;
+
+/**
+ * Notify the delegate of a task or of a task group (if any, and if it implements the corresponding method), either
+ * directly or on the queue it has been registered with
+ */
+- (void)notifyDelegateOfTask:(HLSTask *)task withSelector:(SEL)selector;
+- (void)notifyDelegateOfTaskGroup:(HLSTaskGroup *)taskGroup withSelector:(SEL)selector;
+
 /**
  * Retrieving registered delegates
  */
@@ -8,6 +8,29 @@
 
 #import "HLSTask.h"
 #import "HLSTaskGroup.h"
+
+// Forward declarations
+@class HLSTaskConcurrencyController;
+@class HLSTaskDelegateRegistry;
+@class HLSTaskTagIndex;
+@class HLSTaskTrace;
+@class HLSTaskWatchdog;
+@protocol HLSTaskManagerDelegate;
+
+/**
+ * What a task manager does when a submission would exceed its maximum number of pending tasks
+ */
+typedef enum {
+    HLSTaskOverflowPolicyEnumBegin = 0,
+    // Values
+    HLSTaskOverflowPolicyReject = HLSTaskOverflowPolicyEnumBegin,   // The submitted task (or task group) is cancelled right away (default)
+    HLSTaskOverflowPolicyDropOldestWithSameTag,                     // The oldest pending tasks (or task groups) with the same tag are cancelled
+                                                                    // to make room. If there are none, the submission is rejected
+    HLSTaskOverflowPolicyBlock,                                     // The submitter waits until enough pending tasks have been started
+    // End of values
+    HLSTaskOverflowPolicyEnumEnd,
+    HLSTaskOverflowPolicyEnumSize = HLSTaskOverflowPolicyEnumEnd - HLSTaskOverflowPolicyEnumBegin
+} HLSTaskOverflowPolicy;
                 
 /**
  * Concrete class responsible for instantiating, processing and managing HLSTaskOperation objects spawned for each
@@ -18,12 +41,21 @@
  * associated task processing ends. This means that when you are re-submitting a task you will need to register
  * a delegate even if one was already registered for this task.
  *
- * As always with delegation in asynchronous contexts, it is especially important that delegates do not forget to
- * unregister themselves before they get destroyed, otherwise crashes are likely to occur if operations are still
- * running when their delegate dies. To avoid such issues, never forget to call -unregisterDelegateAndCancelAssociatedTasks:
+ * Delegates are not retained. As always with delegation in asynchronous contexts, it is especially important that
+ * delegates do not forget to unregister themselves before they get destroyed, otherwise crashes are likely to occur 
+ * if operations are still running when their delegate dies. To avoid such issues, never forget to call -unregisterDelegateAndCancelAssociatedTasks:
  * or -unregisterDelegate in the dealloc method of your delegates. This will unregister the delegate, ensuring that
  * it cannot be notified anymore when it gets destroyed.
  *
+ * Tasks are processed in separate lanes depending on their priority (see HLSTaskPriority). Each lane has its own
+ * limit for the number of tasks processed simultaneously. As long as a lane has tasks ready to be started, lanes
+ * with lower priority do not start new tasks (tasks already running are not interrupted, though).
+ *
+ * The number of pending tasks (submitted but not started yet) is unlimited by default. Since each pending task holds
+ * its operation and its data in memory, a limit can be set (see maxPendingTaskCount), together with the policy to
+ * apply when it is reached (see overflowPolicy). A task or task group rejected or dropped because of this limit is 
+ * cancelled, its delegate receiving the usual cancellation event.
+ *
  * This object is not thread-safe. All operations on it must stem from the same thread, otherwise the behavior is 
  * undefined.
  *
@@ -31,14 +63,28 @@
  */
 @interface HLSTaskManager : NSObject {
 @private
-    NSOperationQueue *_operationQueue;                   // Manages the separate threads used for task processing
+    NSArray *_operationQueues;                           // One NSOperationQueue per HLSTaskPriority lane (index = priority)
+    NSArray *_pendingOperationSets;                      // For each lane, the NSMutableSet of submitted operations which have not started yet
     NSMutableSet *_tasks;                                // Keep a strong ref to task groups so that they stay alive
     NSMutableSet *_taskGroups;                           // Keep a strong ref to task groups so that they stay alive
     NSMutableDictionary *_taskToOperationMap;            // Maps a task to the associated HLSTaskOperation object
-    NSMutableDictionary *_taskToDelegateMap;             // Maps a task to the associated id<HLSTaskDelegate> object
-    NSMutableDictionary *_delegateToTasksMap;            // Maps some object id to the NSMutableSet of all HLSTask objects it is the delegate of
-    NSMutableDictionary *_taskGroupToDelegateMap;        // Maps a task group to the associated id<HLSTaskGroupDelegate> object
-    NSMutableDictionary *_delegateToTaskGroupsMap;       // Maps some object id to the NSMutableSet of all HLSTaskGroup objects it is the delegate of
+    NSMutableDictionary *_taskToRemainingDependencyCountMap; // Maps a task group task waiting for dependencies to the NSNumber of those not finished yet
+    HLSTaskDelegateRegistry *_taskDelegateRegistry;      // Task <-> id<HLSTaskDelegate> relationships
+    HLSTaskDelegateRegistry *_taskGroupDelegateRegistry; // Task group <-> id<HLSTaskGroupDelegate> relationships
+    HLSTaskTagIndex *_taskTagIndex;                      // Running tasks by tag
+    HLSTaskTagIndex *_taskGroupTagIndex;                 // Running task groups by tag
+    NSMutableDictionary *_deduplicationKeyToOperationMap; // Maps a deduplication key to the HLSTaskOperation performing the work
+    NSMutableDictionary *_operationToSubscriberTasksMap; // Maps an operation to the NSMutableArray of other HLSTask objects sharing its work
+    NSMutableSet *_abandonedOperations;                  // Operations whose own task has been cancelled, but whose work is still shared
+    NSMutableDictionary *_priorityToConcurrencyControllerMap; // Maps the NSNumber priority of lanes in adaptive mode to their HLSTaskConcurrencyController
+    NSMutableDictionary *_objectToSubmissionIndexMap;    // Maps a task or task group to the NSNumber order in which it was submitted
+    NSUInteger _nbrSubmissions;
+    HLSTaskTrace *_trace;
+    HLSTaskWatchdog *_watchdog;
+    NSUInteger _maxPendingTaskCount;
+    HLSTaskOverflowPolicy _overflowPolicy;
+    id<HLSTaskManagerDelegate> _delegate;
+    BOOL _laneSuspensionUpdatesDeferred;                 // If YES, lane suspension is updated once the current bulk operation ends
 }
 
 /**
@@ -49,14 +95,71 @@
 + (HLSTaskManager *)defaultManager;
 
 /**
- * Change the number of tasks processed simultaneously. Default is 4. This setting does not affect already running
- * operations
+ * If set, the manager records the timing of all tasks it processes into the trace (see HLSTaskTrace): when they are 
+ * submitted, picked by an operation thread, executed, when they report progress, and when their end is notified 
+ * to their delegate. Default is nil (no trace is recorded). The trace should be set before submitting any task
+ */
+@property (nonatomic, retain) HLSTaskTrace *trace;
+
+/**
+ * If set, the manager measures how long the delegate callbacks take on the thread which submitted the tasks, and 
+ * logs those which are too slow (see HLSTaskWatchdog). Default is nil (nothing is measured)
+ */
+@property (nonatomic, retain) HLSTaskWatchdog *watchdog;
+
+/**
+ * The maximum number of pending tasks, i.e. tasks which have been submitted but not started yet (tasks of task groups
+ * waiting for their dependencies included). The limit is checked when submitting tasks and task groups: A task group
+ * counts as the number of tasks it contains, and is rejected if it contains more tasks than the limit. Tasks sharing 
+ * the work of another task (see HLSTask deduplicationKey) are not counted. Default is 0 (no limit)
+ */
+@property (nonatomic, assign) NSUInteger maxPendingTaskCount;
+
+/**
+ * The policy applied when a submission would exceed maxPendingTaskCount. Default is HLSTaskOverflowPolicyReject.
+ * 
+ * With HLSTaskOverflowPolicyBlock, the run loop of the submitting thread is run in the default mode while waiting (otherwise
+ * the manager would never be notified that tasks have started). Delegate methods can therefore be called from within
+ * a submission method
+ */
+@property (nonatomic, assign) HLSTaskOverflowPolicy overflowPolicy;
+
+/**
+ * The current number of pending tasks (see maxPendingTaskCount)
+ */
+- (NSUInteger)pendingTaskCount;
+
+/**
+ * The task manager delegate
+ */
+@property (nonatomic, assign) id<HLSTaskManagerDelegate> delegate;
+
+/**
+ * Change the number of tasks processed simultaneously for the default HLSTaskPriorityUserInitiated lane. Default is 4. 
+ * This setting does not affect already running operations
  */
 - (void)setMaxConcurrentTaskCount:(NSInteger)count;
 
+/**
+ * Change the number of tasks processed simultaneously for a given priority lane. Defaults are 2 for interactive
+ * tasks, 4 for user-initiated tasks and 2 for background tasks. This setting does not affect already running 
+ * operations. If adaptive concurrency was enabled for the lane, it is disabled
+ */
+- (void)setMaxConcurrentTaskCount:(NSInteger)count forPriority:(HLSTaskPriority)priority;
+
+/**
+ * Let the manager tune the number of tasks processed simultaneously by a priority lane at runtime, between 2 and 
+ * maxCount. The manager measures the throughput and the latency of the tasks processed by the lane, increases the 
+ * number of concurrent tasks as long as this improves throughput, and halves it as soon as the lane appears to
+ * be saturated (e.g. because the network or the device cannot cope with more work). Use setMaxConcurrentTaskCount:
+ * forPriority: to get back to a fixed number of concurrent tasks
+ */
+- (void)enableAdaptiveConcurrencyForPriority:(HLSTaskPriority)priority withMaxConcurrentTaskCount:(NSInteger)maxCount;
+
 /**
  * Submit a single task; if you have several tasks to process, consider bundling them as a task group, and use
- * submitTaskGroup: instead
+ * submitTaskGroup: instead. If the task has a deduplication key and some work with the same key is already being
+ * performed by the manager, the task is attached to it (see HLSTask deduplicationKey)
  */
 - (void)submitTask:(HLSTask *)task;
 
@@ -65,6 +168,18 @@
  */
 - (void)submitTaskGroup:(HLSTaskGroup *)taskGroup;
 
+/**
+ * Submit several tasks (an NSArray of HLSTask objects) at once. Equivalent to calling submitTask: for each task, but 
+ * all operations are created first and then handed over to the queues at once, which is much cheaper for large
+ * batches. Tasks which are already running are ignored
+ */
+- (void)submitTasks:(NSArray *)tasks;
+
+/**
+ * Submit several task groups (an NSArray of HLSTaskGroup objects) at once. Same as submitTasks:, but for task groups
+ */
+- (void)submitTaskGroups:(NSArray *)taskGroups;
+
 /**
  * Cancel a single task
  */
@@ -76,12 +191,24 @@
 - (void)cancelTaskGroup:(HLSTaskGroup *)taskGroup;
 
 /**
- * Cancel tasks by tag. Several tasks may share the same tag, in which case they will all be cancellled 
+ * Cancel several tasks (an NSArray of HLSTask objects) at once
+ */
+- (void)cancelTasks:(NSArray *)tasks;
+
+/**
+ * Cancel several task groups (an NSArray of HLSTaskGroup objects) at once
+ */
+- (void)cancelTaskGroups:(NSArray *)taskGroups;
+
+/**
+ * Cancel tasks by tag. Several tasks may share the same tag, in which case they will all be cancellled. Tags are
+ * compared for equality, and the tag a task had when it was submitted is used
  */
 - (void)cancelTasksWithTag:(NSString *)tag;
 
 /**
- * Cancel task groups by tag. Several tasks may share the same tag, in which case they will all be cancelled
+ * Cancel task groups by tag. Several tasks may share the same tag, in which case they will all be cancelled. Tags 
+ * are compared for equality, and the tag a task group had when it was submitted is used
  */
 - (void)cancelTaskGroupsWithTag:(NSString *)tag;
 
@@ -99,13 +226,15 @@
 
 /**
  * Return an NSArray of running or pending HLSTask objects bearing the specified tag (already completed tasks are not
- * returned). If no match is found, this method returns an empty array
+ * returned). If no match is found, this method returns an empty array. The lookup does not depend on the total
+ * number of running tasks
  */
 - (NSArray *)tasksWithTag:(NSString *)tag;
 
 /**
  * Return an NSArray of running or pending HLSTaskGroup objects bearing the specified tag (already completed tasks are not
- * returned). If no match is found, this method returns an empty array
+ * returned). If no match is found, this method returns an empty array. The lookup does not depend on the total
+ * number of running task groups
  */
 - (NSArray *)taskGroupsWithTag:(NSString *)tag;
 
@@ -116,6 +245,27 @@
 - (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTask:(HLSTask *)task;
 - (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroup:(HLSTaskGroup *)taskGroup;
 
+/**
+ * Register delegates for tasks, to be notified on a dispatch queue instead of the thread which submitted the task. 
+ * This is meant for delegates which only consume data (e.g. writing results to a cache) and do not need to use the
+ * submitting thread (usually the main thread) at all. Use a serial queue, otherwise events might be received out of
+ * order. Same rules as for the methods above, with the following additional remarks:
+ *   - the task (or task group) received is a snapshot of its status when the event occurred, not the object which was
+ *     submitted. Use its tag or user information to identify it, not its address
+ *   - delegates are retained while events are waiting in the queue. Events queued before a delegate unregisters
+ *     itself are still delivered
+ * Passing NULL as queue is the same as calling the methods above
+ */
+- (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTask:(HLSTask *)task queue:(dispatch_queue_t)queue;
+- (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroup:(HLSTaskGroup *)taskGroup queue:(dispatch_queue_t)queue;
+
+/**
+ * Register a delegate for several tasks (an NSArray of HLSTask objects) or task groups (an NSArray of HLSTaskGroup
+ * objects) at once. Same rules as for the methods above
+ */
+- (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTasks:(NSArray *)tasks;
+- (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroups:(NSArray *)taskGroups;
+
 /**
  * Unregister the delegate associated with a specific task
  */
@@ -136,3 +286,14 @@
 - (void)unregisterDelegate:(id)delegate;
 
 @end
+
+@protocol HLSTaskManagerDelegate <NSObject>
+@optional
+
+/**
+ * Called when a submission would exceed the maximum number of pending tasks, right before the overflow policy is
+ * applied
+ */
+- (void)taskManagerHasReachedMaxPendingTaskCount:(HLSTaskManager *)taskManager;
+
+@end
@@ -8,30 +8,75 @@
 
 #import "HLSTaskManager.h"
 
+#import "HLSAllocationTracker+Friend.h"
+#import "HLSCancellationToken.h"
 #import "HLSLogger.h"
 #import "HLSTask+Friend.h"
+#import "HLSTaskConcurrencyController.h"
+#import "HLSTaskDelegateRegistry.h"
 #import "HLSTaskGroup+Friend.h"
+#import "HLSTaskJournal.h"
 #import "HLSTaskOperation.h"
+#import "HLSTaskOperation+Friend.h"
+#import "HLSTaskTagIndex.h"
+#import "HLSTaskTrace.h"
+#import "HLSTrace.h"
+#import "HLSTaskWatchdog.h"
 
 @interface HLSTaskManager ()
 
-@property (nonatomic, retain) NSOperationQueue *operationQueue;
+@property (nonatomic, retain) NSArray *operationQueues;
+@property (nonatomic, retain) NSArray *pendingOperationSets;
 @property (nonatomic, retain) NSMutableSet *tasks;
 @property (nonatomic, retain) NSMutableSet *taskGroups;
 @property (nonatomic, retain) NSMutableDictionary *taskToOperationMap;
-@property (nonatomic, retain) NSMutableDictionary *taskToDelegateMap;
-@property (nonatomic, retain) NSMutableDictionary *delegateToTasksMap;
-@property (nonatomic, retain) NSMutableDictionary *taskGroupToDelegateMap;
-@property (nonatomic, retain) NSMutableDictionary *delegateToTaskGroupsMap;
+@property (nonatomic, retain) NSMutableDictionary *taskToRemainingDependencyCountMap;
+@property (nonatomic, retain) HLSTaskDelegateRegistry *taskDelegateRegistry;
+@property (nonatomic, retain) HLSTaskDelegateRegistry *taskGroupDelegateRegistry;
+@property (nonatomic, retain) HLSTaskTagIndex *taskTagIndex;
+@property (nonatomic, retain) HLSTaskTagIndex *taskGroupTagIndex;
+@property (nonatomic, retain) NSMutableDictionary *deduplicationKeyToOperationMap;
+@property (nonatomic, retain) NSMutableDictionary *operationToSubscriberTasksMap;
+@property (nonatomic, retain) NSMutableSet *abandonedOperations;
+@property (nonatomic, retain) NSMutableDictionary *priorityToConcurrencyControllerMap;
+@property (nonatomic, retain) NSMutableDictionary *objectToSubmissionIndexMap;
+
+- (BOOL)setQueueMaxConcurrentOperationCount:(NSInteger)count forPriority:(HLSTaskPriority)priority;
+
+- (void)registerAndScheduleTasks:(NSArray *)tasks duplicateTasks:(NSArray *)duplicateTasks;
+- (NSArray *)prepareTaskGroup:(HLSTaskGroup *)taskGroup;
+
+- (BOOL)hasRoomForTaskCount:(NSUInteger)count;
+- (BOOL)makeRoomForTaskCount:(NSUInteger)count withTag:(NSString *)tag forTaskGroup:(BOOL)forTaskGroup;
+- (void)waitForRoomForTaskCount:(NSUInteger)count;
+- (NSArray *)droppableTasksWithTag:(NSString *)tag;
+- (NSArray *)droppableTaskGroupsWithTag:(NSString *)tag;
+- (NSArray *)objectsSortedBySubmissionIndex:(NSArray *)objects;
+- (void)rejectTask:(HLSTask *)task;
+- (void)rejectTaskGroup:(HLSTaskGroup *)taskGroup;
 
 - (NSSet *)operationsForTasks:(NSSet *)tasks;
 
+- (void)attachTask:(HLSTask *)task toOperation:(HLSTaskOperation *)operation;
+- (void)detachTask:(HLSTask *)task fromOperation:(HLSTaskOperation *)operation;
+- (NSArray *)subscriberTasksForOperation:(HLSTaskOperation *)operation;
+
+- (HLSTaskPriority)priorityForTask:(HLSTask *)task;
+- (void)scheduleOperations:(NSArray *)operations;
+- (NSArray *)prioritizedReadyOperations:(NSArray *)operations ofTaskGroup:(HLSTaskGroup *)taskGroup;
+- (void)releaseDependentsOfOperation:(HLSTaskOperation *)operation;
+- (void)updateLaneSuspension;
+
 - (void)registerOperation:(HLSTaskOperation *)operation;
 - (void)unregisterOperation:(HLSTaskOperation *)operation;
 
 - (void)registerTaskGroup:(HLSTaskGroup *)taskGroup;
 - (void)unregisterTaskGroup:(HLSTaskGroup *)taskGroup;
 
+- (void)notifyDelegateOfTask:(HLSTask *)task withSelector:(SEL)selector;
+- (void)notifyDelegateOfTaskGroup:(HLSTaskGroup *)taskGroup withSelector:(SEL)selector;
+- (void)performSelector:(SEL)selector ofDelegate:(id)delegate withObject:(id)object;
+
 - (id<HLSTaskDelegate>)delegateForTask:(HLSTask *)task;
 - (id<HLSTaskGroupDelegate>)delegateForTaskGroup:(HLSTaskGroup *)taskGroup;
 
@@ -57,37 +102,83 @@
 - (id)init
 {
     if ((self = [super init])) {
-        self.operationQueue = [[[NSOperationQueue alloc] init] autorelease];
-        [self setMaxConcurrentTaskCount:4];
-        [self.operationQueue setMaxConcurrentOperationCount:4];
+        NSMutableArray *operationQueues = [NSMutableArray array];
+        NSMutableArray *pendingOperationSets = [NSMutableArray array];
+        for (NSUInteger i = 0; i < HLSTaskPriorityEnumSize; ++i) {
+            [operationQueues addObject:[[[NSOperationQueue alloc] init] autorelease]];
+            [pendingOperationSets addObject:[NSMutableSet set]];
+        }
+        self.operationQueues = [NSArray arrayWithArray:operationQueues];
+        self.pendingOperationSets = [NSArray arrayWithArray:pendingOperationSets];
+        
+        [self setQueueMaxConcurrentOperationCount:2 forPriority:HLSTaskPriorityInteractive];
+        [self setQueueMaxConcurrentOperationCount:4 forPriority:HLSTaskPriorityUserInitiated];
+        [self setQueueMaxConcurrentOperationCount:2 forPriority:HLSTaskPriorityBackground];
+        
         self.tasks = [NSMutableSet set];
         self.taskGroups = [NSMutableSet set];
         self.taskToOperationMap = [NSMutableDictionary dictionary];
-        self.taskToDelegateMap = [NSMutableDictionary dictionary];
-        self.delegateToTasksMap =[NSMutableDictionary dictionary];
-        self.taskGroupToDelegateMap = [NSMutableDictionary dictionary];
-        self.delegateToTaskGroupsMap = [NSMutableDictionary dictionary];
+        self.taskToRemainingDependencyCountMap = [NSMutableDictionary dictionary];
+        
+        // Which optional methods delegates implement is determined once when they are registered
+        SEL taskDelegateSelectors[] = {
+            @selector(taskHasStartedProcessing:),
+            @selector(taskProgressUpdated:),
+            @selector(taskHasBeenProcessed:),
+            @selector(taskHasBeenCancelled:)
+        };
+        self.taskDelegateRegistry = [[[HLSTaskDelegateRegistry alloc] initWithOptionalSelectors:taskDelegateSelectors
+                                                                                          count:sizeof(taskDelegateSelectors) / sizeof(SEL)] autorelease];
+        SEL taskGroupDelegateSelectors[] = {
+            @selector(taskGroupHasStartedProcessing:),
+            @selector(taskGroupProgressUpdated:),
+            @selector(taskGroupHasBeenProcessed:),
+            @selector(taskGroupHasBeenCancelled:)
+        };
+        self.taskGroupDelegateRegistry = [[[HLSTaskDelegateRegistry alloc] initWithOptionalSelectors:taskGroupDelegateSelectors
+                                                                                               count:sizeof(taskGroupDelegateSelectors) / sizeof(SEL)] autorelease];
+        
+        self.taskTagIndex = [[[HLSTaskTagIndex alloc] init] autorelease];
+        self.taskGroupTagIndex = [[[HLSTaskTagIndex alloc] init] autorelease];
+        self.deduplicationKeyToOperationMap = [NSMutableDictionary dictionary];
+        self.operationToSubscriberTasksMap = [NSMutableDictionary dictionary];
+        self.abandonedOperations = [NSMutableSet set];
+        self.priorityToConcurrencyControllerMap = [NSMutableDictionary dictionary];
+        self.objectToSubmissionIndexMap = [NSMutableDictionary dictionary];
+        self.overflowPolicy = HLSTaskOverflowPolicyReject;
     }
     return self;
 }
 
 - (void)dealloc
 {
-    self.operationQueue = nil;
+    self.operationQueues = nil;
+    self.pendingOperationSets = nil;
     self.tasks = nil;
     self.taskGroups = nil;
     self.taskToOperationMap = nil;
-    self.taskToDelegateMap = nil;
-    self.delegateToTasksMap = nil;
-    self.taskGroupToDelegateMap = nil;
-    self.delegateToTaskGroupsMap = nil;
+    self.taskToRemainingDependencyCountMap = nil;
+    self.taskDelegateRegistry = nil;
+    self.taskGroupDelegateRegistry = nil;
+    self.taskTagIndex = nil;
+    self.taskGroupTagIndex = nil;
+    self.deduplicationKeyToOperationMap = nil;
+    self.operationToSubscriberTasksMap = nil;
+    self.abandonedOperations = nil;
+    self.priorityToConcurrencyControllerMap = nil;
+    self.objectToSubmissionIndexMap = nil;
+    self.trace = nil;
+    self.watchdog = nil;
+    self.delegate = nil;
     [super dealloc];
 }
 
 #pragma mark -
 #pragma mark Accessors and mutators
 
-@synthesize operationQueue = _operationQueue;
+@synthesize operationQueues = _operationQueues;
+
+@synthesize pendingOperationSets = _pendingOperationSets;
 
 @synthesize tasks = _tasks;
 
@@ -95,28 +186,112 @@
 
 @synthesize taskToOperationMap = _taskToOperationMap;
 
-@synthesize taskToDelegateMap = _taskToDelegateMap;
+@synthesize taskToRemainingDependencyCountMap = _taskToRemainingDependencyCountMap;
+
+@synthesize taskDelegateRegistry = _taskDelegateRegistry;
 
-@synthesize delegateToTasksMap = _delegateToTasksMap;
+@synthesize taskGroupDelegateRegistry = _taskGroupDelegateRegistry;
+
+@synthesize taskTagIndex = _taskTagIndex;
+
+@synthesize taskGroupTagIndex = _taskGroupTagIndex;
+
+@synthesize deduplicationKeyToOperationMap = _deduplicationKeyToOperationMap;
+
+@synthesize operationToSubscriberTasksMap = _operationToSubscriberTasksMap;
+
+@synthesize abandonedOperations = _abandonedOperations;
+
+@synthesize priorityToConcurrencyControllerMap = _priorityToConcurrencyControllerMap;
+
+@synthesize objectToSubmissionIndexMap = _objectToSubmissionIndexMap;
+
+@synthesize trace = _trace;
+
+@synthesize watchdog = _watchdog;
+
+@synthesize maxPendingTaskCount = _maxPendingTaskCount;
+
+@synthesize overflowPolicy = _overflowPolicy;
+
+- (void)setOverflowPolicy:(HLSTaskOverflowPolicy)overflowPolicy
+{
+    if (overflowPolicy >= HLSTaskOverflowPolicyEnumEnd) {
+        HLSLoggerError(@"Invalid overflow policy; policy not changed");
+        return;
+    }
+    
+    _overflowPolicy = overflowPolicy;
+}
 
-@synthesize taskGroupToDelegateMap = _taskGroupToDelegateMap;
+- (NSUInteger)pendingTaskCount
+{
+    // Operations waiting in the queues, and those of task group tasks waiting for their dependencies
+    NSUInteger nbrPendingTasks = [self.taskToRemainingDependencyCountMap count];
+    for (NSSet *pendingOperations in self.pendingOperationSets) {
+        nbrPendingTasks += [pendingOperations count];
+    }
+    return nbrPendingTasks;
+}
 
-@synthesize delegateToTaskGroupsMap = _delegateToTaskGroupsMap;
+@synthesize delegate = _delegate;
 
 - (void)setMaxConcurrentTaskCount:(NSInteger)count
+{
+    [self setMaxConcurrentTaskCount:count forPriority:HLSTaskPriorityUserInitiated];
+}
+
+- (void)setMaxConcurrentTaskCount:(NSInteger)count forPriority:(HLSTaskPriority)priority
+{
+    if (priority >= HLSTaskPriorityEnumEnd) {
+        HLSLoggerError(@"Invalid priority; task count not changed");
+        return;
+    }
+    
+    if ([self setQueueMaxConcurrentOperationCount:count forPriority:priority]) {
+        [self.priorityToConcurrencyControllerMap removeObjectForKey:[NSNumber numberWithInt:priority]];
+    }
+}
+
+- (void)enableAdaptiveConcurrencyForPriority:(HLSTaskPriority)priority withMaxConcurrentTaskCount:(NSInteger)maxCount
+{
+    if (priority >= HLSTaskPriorityEnumEnd) {
+        HLSLoggerError(@"Invalid priority; adaptive concurrency not enabled");
+        return;
+    }
+    
+    if (maxCount < 2) {
+        HLSLoggerError(@"Invalid maximum number of concurrent tasks; adaptive concurrency not enabled");
+        return;
+    }
+    
+    HLSTaskConcurrencyController *concurrencyController = [[[HLSTaskConcurrencyController alloc] initWithMinimumCount:2 
+                                                                                                         maximumCount:maxCount] 
+                                                           autorelease];
+    [self.priorityToConcurrencyControllerMap setObject:concurrencyController forKey:[NSNumber numberWithInt:priority]];
+    [self setQueueMaxConcurrentOperationCount:concurrencyController.count forPriority:priority];
+}
+
+// Return YES iff the count was valid and applied
+- (BOOL)setQueueMaxConcurrentOperationCount:(NSInteger)count forPriority:(HLSTaskPriority)priority
 {
     // Remark: It seems that with the recommended setting NSOperationQueueDefaultMaxConcurrentOperationCount (which
     //         lets the OS decide dynamically how many threads are needed), dependencies betweeen NSOperation objects
     //         are not applied anymore (bug?). Anyway, this does not work correctly, so we fix the number of threads
-    //         to a seemingly good value
+    //         to a seemingly good value (or let the manager tune it, see -enableAdaptiveConcurrencyForPriority:
+    //         withMaxConcurrentTaskCount:)
     if (count == NSOperationQueueDefaultMaxConcurrentOperationCount) {
         HLSLoggerWarn(@"Dynamic number of concurrent tasks is currently not working correctly; task count not changed");
+        return NO;
     }
     else if (count > 1) {
-        [self.operationQueue setMaxConcurrentOperationCount:count];
+        NSOperationQueue *operationQueue = [self.operationQueues objectAtIndex:priority];
+        [operationQueue setMaxConcurrentOperationCount:count];
+        return YES;
     }
     else {
         HLSLoggerError(@"Invalid number of concurrent tasks; task count not changed");
+        return NO;
     }
 }
 
@@ -125,91 +300,329 @@
 
 - (void)submitTask:(HLSTask *)task
 {
-    // Cannot submit a task if already running
-    if ([self.tasks containsObject:task]) {
-        HLSLoggerWarn(@"Cannot submit a task which is already running");
-        return;
+    [self submitTasks:[NSArray arrayWithObject:task]];
+}
+
+- (void)submitTaskGroup:(HLSTaskGroup *)taskGroup
+{
+    [self submitTaskGroups:[NSArray arrayWithObject:taskGroup]];
+}
+
+- (void)submitTasks:(NSArray *)tasks
+{
+    NSMutableArray *tasksToSubmit = [NSMutableArray array];
+    NSMutableArray *duplicateTasks = [NSMutableArray array];
+    NSMutableSet *submittedTasks = [NSMutableSet set];
+    NSMutableSet *deduplicationKeys = [NSMutableSet set];
+    for (HLSTask *task in tasks) {
+        // Cannot submit a task if already running
+        if ([self.tasks containsObject:task] || [submittedTasks containsObject:task]) {
+            HLSLoggerWarn(@"Cannot submit a task which is already running");
+            continue;
+        }
+        [submittedTasks addObject:task];
+        
+        // Tasks whose work is already being performed (or is part of the same batch) share it
+        NSString *deduplicationKey = task.taskGroup ? nil : task.deduplicationKey;
+        if (deduplicationKey) {
+            if ([self.deduplicationKeyToOperationMap objectForKey:deduplicationKey] || [deduplicationKeys containsObject:deduplicationKey]) {
+                [duplicateTasks addObject:task];
+                continue;
+            }
+        }
+        
+        // If the pending task limit is reached, first submit the tasks collected so far, so that they are accounted for
+        if (! [self hasRoomForTaskCount:[tasksToSubmit count] + 1]) {
+            [self registerAndScheduleTasks:tasksToSubmit duplicateTasks:duplicateTasks];
+            [tasksToSubmit removeAllObjects];
+            [duplicateTasks removeAllObjects];
+            [deduplicationKeys removeAllObjects];
+            
+            if (! [self makeRoomForTaskCount:1 withTag:task.tag forTaskGroup:NO]) {
+                [self rejectTask:task];
+                continue;
+            }
+            
+            // The same work might have been submitted while waiting
+            if (deduplicationKey && [self.deduplicationKeyToOperationMap objectForKey:deduplicationKey]) {
+                [duplicateTasks addObject:task];
+                continue;
+            }
+        }
+        
+        if (deduplicationKey) {
+            [deduplicationKeys addObject:deduplicationKey];
+        }
+        [tasksToSubmit addObject:task];
     }
     
+    [self registerAndScheduleTasks:tasksToSubmit duplicateTasks:duplicateTasks];
+}
+
+- (void)submitTaskGroups:(NSArray *)taskGroups
+{
+    NSMutableArray *readyOperations = [NSMutableArray array];
+    for (HLSTaskGroup *taskGroup in taskGroups) {
+        // Cannot submit a task if already running
+        if ([self.taskGroups containsObject:taskGroup]) {
+            HLSLoggerWarn(@"Cannot submit a task group which is already running");
+            continue;
+        }
+        
+        // If the pending task limit is reached, first schedule the operations collected so far, so that they are
+        // accounted for
+        NSUInteger nbrTasks = [[taskGroup tasks] count];
+        if (! [self hasRoomForTaskCount:[readyOperations count] + nbrTasks]) {
+            [self scheduleOperations:readyOperations];
+            [readyOperations removeAllObjects];
+            
+            if (! [self makeRoomForTaskCount:nbrTasks withTag:taskGroup.tag forTaskGroup:YES]) {
+                [self rejectTaskGroup:taskGroup];
+                continue;
+            }
+        }
+        
+        [readyOperations addObjectsFromArray:[self prepareTaskGroup:taskGroup]];
+    }
+    [self scheduleOperations:readyOperations];
+}
+
+- (void)registerAndScheduleTasks:(NSArray *)tasks duplicateTasks:(NSArray *)duplicateTasks
+{
     // Get the corresponding operations
-    NSSet *operations = [self operationsForTasks:[NSSet setWithObject:task]];
+    NSSet *operations = [self operationsForTasks:[NSSet setWithArray:tasks]];
     
-    // Register and schedule all operations
+    // Register and schedule all operations at once
     for (HLSTaskOperation *operation in operations) {
         [self registerOperation:operation];
-        [self.operationQueue addOperation:operation];
     }
+    for (HLSTask *task in duplicateTasks) {
+        HLSTaskOperation *operation = [self.deduplicationKeyToOperationMap objectForKey:task.deduplicationKey];
+        [self attachTask:task toOperation:operation];
+    }
+    [self scheduleOperations:[operations allObjects]];
 }
 
-- (void)submitTaskGroup:(HLSTaskGroup *)taskGroup
+// Register a task group and its operations, returning those ready to be scheduled (in the order in which they
+// should be scheduled)
+- (NSArray *)prepareTaskGroup:(HLSTaskGroup *)taskGroup
 {
-    // Cannot submit a task if already running
-    if ([self.taskGroups containsObject:taskGroup]) {
-        HLSLoggerWarn(@"Cannot submit a task group which is already running");
-        return;
-    }
-    
     // Reset status
     [taskGroup reset];
     
-    // If no operation in the task group, we are already done; update the status accordingly and simulate events
-    if ([[taskGroup tasks] count] == 0) {
-        id<HLSTaskGroupDelegate> taskGroupDelegate = [self delegateForTaskGroup:taskGroup];
-        if (taskGroupDelegate) {
-            if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasStartedProcessing:)]) {
-                [taskGroupDelegate taskGroupHasStartedProcessing:taskGroup];
+    // Tasks already recorded in the journal are not processed again, they are directly flagged as processed. Their
+    // delegates receive the same events as for processed tasks, and are then unregistered as usual
+    NSMutableSet *remainingTasks = [NSMutableSet setWithSet:[taskGroup tasks]];
+    HLSTaskJournal *journal = taskGroup.journal;
+    if (journal) {
+        for (HLSTask *task in [taskGroup tasks]) {
+            if (! task.journalKey || ! [journal containsEntryForKey:task.journalKey]) {
+                continue;
             }
             
-            if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasBeenProcessed:)]) {
-                [taskGroupDelegate taskGroupHasBeenProcessed:taskGroup];
-            }            
+            [task reset];
+            task.returnInfo = [journal returnInfoForKey:task.journalKey];
+            [remainingTasks removeObject:task];
+            
+            [self notifyDelegateOfTask:task withSelector:@selector(taskHasStartedProcessing:)];
+            task.progress = 1.f;
+            [self notifyDelegateOfTask:task withSelector:@selector(taskProgressUpdated:)];
+            task.finished = YES;
+            [self notifyDelegateOfTask:task withSelector:@selector(taskHasBeenProcessed:)];
+            [self unregisterDelegateForTask:task];
         }
+        [taskGroup updateStatus];
+    }
+    
+    // If no operation in the task group, we are already done; update the status accordingly and simulate events
+    if ([remainingTasks count] == 0) {
+        [self notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasStartedProcessing:)];
+        [self notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenProcessed:)];
         
         taskGroup.finished = YES;
-        return;
+        [journal clear];
+        return [NSArray array];
     }    
     
     // Get the corresponding operations
-    NSSet *operations = [self operationsForTasks:[taskGroup tasks]];
+    NSSet *operations = [self operationsForTasks:remainingTasks];
     
     // Register all operations
     for (HLSTaskOperation *operation in operations) {
         [self registerOperation:operation];
     }
     
-    // Apply task group dependencies
-    for (HLSTask *task in [taskGroup tasks]) {
-        // Get dependencies if any
-        NSSet *dependencyTasks = [taskGroup dependenciesForTask:task];
-        if ([dependencyTasks count] == 0) {
-            continue;
-        }
-        
-        // Retrieve the corresponding operation
-        NSValue *taskKey = [NSValue valueWithPointer:task];
-        HLSTaskOperation *operation = [self.taskToOperationMap objectForKey:taskKey];
+    // Count the dependencies each task has to wait for. Tasks without dependencies are ready to be started, the
+    // other ones will be scheduled when their last dependency ends
+    NSMutableArray *readyOperations = [NSMutableArray array];
+    for (HLSTaskOperation *operation in operations) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemTask);
         
-        // Set dependencies
-        for (HLSTask *dependencyTask in dependencyTasks) {
-            // Get the dependency operation
-            NSValue *dependencyTaskKey = [NSValue valueWithPointer:dependencyTask];
-            HLSTaskOperation *dependencyOperation = [self.taskToOperationMap objectForKey:dependencyTaskKey];
-            if (! dependencyOperation) {
-                continue;
-            }
-            
-            // Create the dependency between operations
-            [operation addDependency:dependencyOperation];
+        NSMutableSet *dependencies = [NSMutableSet setWithSet:[taskGroup dependenciesForTask:operation.task]];
+        [dependencies intersectSet:remainingTasks];
+        NSUInteger nbrDependencies = [dependencies count];
+        if (nbrDependencies == 0) {
+            [readyOperations addObject:operation];
+        }
+        else {
+            NSValue *taskKey = [NSValue valueWithPointer:operation.task];
+            [self.taskToRemainingDependencyCountMap setObject:[NSNumber numberWithUnsignedInteger:nbrDependencies] forKey:taskKey];
         }
+        
+        HLSAutoreleasePoolPop(pool);
     }
     
     // Register object relationships
     [self registerTaskGroup:taskGroup];
     
-    // Schedule all operations
-    for (HLSTaskOperation *operation in operations) {
-        [self.operationQueue addOperation:operation];
+    return [self prioritizedReadyOperations:readyOperations ofTaskGroup:taskGroup];
+}
+
+#pragma mark -
+#pragma mark Limiting the number of pending tasks
+
+- (BOOL)hasRoomForTaskCount:(NSUInteger)count
+{
+    if (self.maxPendingTaskCount == 0) {
+        return YES;
+    }
+    
+    return [self pendingTaskCount] + count <= self.maxPendingTaskCount;
+}
+
+// Apply the overflow policy to make room for a task (or a task group with the specified number of tasks). Return
+// YES iff the task can be submitted
+- (BOOL)makeRoomForTaskCount:(NSUInteger)count withTag:(NSString *)tag forTaskGroup:(BOOL)forTaskGroup
+{
+    if ([self hasRoomForTaskCount:count]) {
+        return YES;
+    }
+    
+    // Would never fit
+    if (count > self.maxPendingTaskCount) {
+        HLSLoggerError(@"The task group contains more tasks than the maximum number of pending tasks");
+        return NO;
+    }
+    
+    if ([self.delegate respondsToSelector:@selector(taskManagerHasReachedMaxPendingTaskCount:)]) {
+        [self.delegate taskManagerHasReachedMaxPendingTaskCount:self];
+    }
+    
+    switch (self.overflowPolicy) {
+        case HLSTaskOverflowPolicyDropOldestWithSameTag: {
+            NSArray *droppableObjects = forTaskGroup ? [self droppableTaskGroupsWithTag:tag] : [self droppableTasksWithTag:tag];
+            for (id droppableObject in droppableObjects) {
+                HLSLoggerInfo(@"Too many pending tasks; %@ dropped", droppableObject);
+                if (forTaskGroup) {
+                    [self cancelTaskGroup:droppableObject];
+                }
+                else {
+                    [self cancelTask:droppableObject];
+                }
+                
+                if ([self hasRoomForTaskCount:count]) {
+                    return YES;
+                }
+            }
+            return NO;
+        }
+            
+        case HLSTaskOverflowPolicyBlock: {
+            [self waitForRoomForTaskCount:count];
+            return YES;
+        }
+            
+        default: {
+            return NO;
+        }
+    }
+}
+
+- (void)waitForRoomForTaskCount:(NSUInteger)count
+{
+    // Operations notify that they have started on the thread they were submitted from, i.e. this one. Its run loop
+    // must therefore be run while waiting
+    while (! [self hasRoomForTaskCount:count]) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        if (! [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]]) {
+            // No input source yet; avoid spinning
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        [pool drain];
+    }
+}
+
+// Single tasks with the specified tag which have not been started yet, oldest first. Tasks whose work is shared 
+// are not considered, since dropping them would not free anything
+- (NSArray *)droppableTasksWithTag:(NSString *)tag
+{
+    NSMutableArray *droppableTasks = [NSMutableArray array];
+    for (HLSTask *task in [self tasksWithTag:tag]) {
+        if (task.taskGroup) {
+            continue;
+        }
+        
+        HLSTaskOperation *operation = [self.taskToOperationMap objectForKey:[NSValue valueWithPointer:task]];
+        if (operation.task != task || [self.operationToSubscriberTasksMap objectForKey:[NSValue valueWithPointer:operation]]) {
+            continue;
+        }
+        
+        // The operation might have been started by its queue, without having notified it yet
+        NSSet *pendingOperations = [self.pendingOperationSets objectAtIndex:[self priorityForTask:task]];
+        if (! [pendingOperations containsObject:operation] || [operation isExecuting]) {
+            continue;
+        }
+        
+        [droppableTasks addObject:task];
     }
+    return [self objectsSortedBySubmissionIndex:droppableTasks];
+}
+
+// Task groups with the specified tag none of whose tasks have been started yet, oldest first
+- (NSArray *)droppableTaskGroupsWithTag:(NSString *)tag
+{
+    NSMutableArray *droppableTaskGroups = [NSMutableArray array];
+    for (HLSTaskGroup *taskGroup in [self taskGroupsWithTag:tag]) {
+        if (taskGroup.running || taskGroup.cancelled) {
+            continue;
+        }
+        
+        [droppableTaskGroups addObject:taskGroup];
+    }
+    return [self objectsSortedBySubmissionIndex:droppableTaskGroups];
+}
+
+- (NSArray *)objectsSortedBySubmissionIndex:(NSArray *)objects
+{
+    return [objects sortedArrayUsingComparator:^NSComparisonResult(id object1, id object2) {
+        NSNumber *submissionIndex1 = [self.objectToSubmissionIndexMap objectForKey:[NSValue valueWithPointer:object1]];
+        NSNumber *submissionIndex2 = [self.objectToSubmissionIndexMap objectForKey:[NSValue valueWithPointer:object2]];
+        return [submissionIndex1 compare:submissionIndex2];
+    }];
+}
+
+- (void)rejectTask:(HLSTask *)task
+{
+    HLSLoggerInfo(@"Too many pending tasks; task %@ rejected", task);
+    
+    [task reset];
+    task.cancelled = YES;
+    task.finished = YES;
+    
+    [self notifyDelegateOfTask:task withSelector:@selector(taskHasBeenCancelled:)];
+    [self unregisterDelegateForTask:task];
+}
+
+- (void)rejectTaskGroup:(HLSTaskGroup *)taskGroup
+{
+    HLSLoggerInfo(@"Too many pending tasks; task group %@ rejected", taskGroup);
+    
+    [taskGroup reset];
+    taskGroup.cancelled = YES;
+    taskGroup.finished = YES;
+    
+    [self notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenCancelled:)];
+    [self unregisterDelegateForTaskGroup:taskGroup];
 }
 
 #pragma mark -
@@ -230,13 +643,45 @@
         return;
     }
     
-    // Flag the operation as cancelled
+    // Work shared by several tasks is only cancelled when no task needs it anymore
+    if (operation.task != task) {
+        [self detachTask:task fromOperation:operation];
+        
+        // If the task processed by the operation has been cancelled as well, the work can now be cancelled
+        if ([[self subscriberTasksForOperation:operation] count] == 0 && [self.abandonedOperations containsObject:operation]) {
+            [self.abandonedOperations removeObject:operation];
+            [self cancelTask:operation.task];
+        }
+        return;
+    }
+    if ([[self subscriberTasksForOperation:operation] count] != 0) {
+        if ([self.abandonedOperations containsObject:operation]) {
+            return;
+        }
+        [self.abandonedOperations addObject:operation];
+        
+        // The task does not receive any other notification, and cannot be found by tag anymore
+        task.cancelled = YES;
+        [self notifyDelegateOfTask:task withSelector:@selector(taskHasBeenCancelled:)];
+        [self unregisterDelegateForTask:task];
+        [self.taskTagIndex removeObject:task];
+        return;
+    }
+    
+    // Flag the operation as cancelled. Its work cannot be shared anymore
     task.cancelled = YES;
+    if (task.deduplicationKey && [self.deduplicationKeyToOperationMap objectForKey:task.deduplicationKey] == operation) {
+        [self.deduplicationKeyToOperationMap removeObjectForKey:task.deduplicationKey];
+    }
     
     // When cancelling tasks, all those which have been started will update their status when they gracefully
     // stop (and unregister them at this point). For tasks which have not been started, this has to be done
     // here
     if (! [operation isExecuting]) {
+        // Events still queued by the operation (e.g. its end, if its main method has just returned) must not be delivered
+        // anymore, the task is finalized here
+        operation.endDelivered = YES;
+        
         // If part of a task group, first cancel all dependent tasks; a task group is removed once all tasks it contains are
         // marked as finished. Here we are careful enough to cancel all dependent task before the current task is set as 
         // finished. This way the task group is guaranteed to survive the loop below
@@ -252,10 +697,7 @@
         task.finished = YES;
         
         // Notify the task delegate
-        id<HLSTaskDelegate> taskDelegate = [self delegateForTask:task];
-        if ([taskDelegate respondsToSelector:@selector(taskHasBeenCancelled:)]) {
-            [taskDelegate taskHasBeenCancelled:task];
-        }
+        [self notifyDelegateOfTask:task withSelector:@selector(taskHasBeenCancelled:)];
         
         if (taskGroup) {            
             [taskGroup updateStatus];
@@ -264,18 +706,13 @@
             if (taskGroup.finished) {
                 taskGroup.running = NO;
                 
-                id<HLSTaskGroupDelegate> taskGroupDelegate = [self delegateForTaskGroup:taskGroup];
                 if (! taskGroup.cancelled) {
                     HLSLoggerDebug(@"Task group %@ ends successfully", taskGroup);
-                    if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasBeenProcessed:)]) {
-                        [taskGroupDelegate taskGroupHasBeenProcessed:taskGroup];
-                    }
+                    [self notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenProcessed:)];
                 }
                 else {
                     HLSLoggerDebug(@"Task group %@ has been cancelled", taskGroup);
-                    if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasBeenCancelled:)]) {
-                        [taskGroupDelegate taskGroupHasBeenCancelled:taskGroup];
-                    }
+                    [self notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenCancelled:)];
                 }
             }
         }
@@ -290,6 +727,9 @@
 {
     taskGroup.cancelled = YES;
     
+    // A cancelled task group must not be resumed
+    [taskGroup.journal clear];
+    
     // Cancel all individual tasks
     for (HLSTask *task in [taskGroup tasks]) {
         [self cancelTask:task];
@@ -298,49 +738,72 @@
 
 - (void)cancelTasksWithTag:(NSString *)tag
 {
-    NSArray *tasks = [self tasksWithTag:tag];
-    for (HLSTask *task in tasks) {
-        [self cancelTask:task];
-    }
+    [self cancelTasks:[self tasksWithTag:tag]];
 }
 
 - (void)cancelTaskGroupsWithTag:(NSString *)tag
 {
-    NSArray *taskGroups = [self taskGroupsWithTag:tag];
-    for (HLSTaskGroup *taskGroup in taskGroups) {
-        [self cancelTaskGroup:taskGroup];
-    }
+    [self cancelTaskGroups:[self taskGroupsWithTag:tag]];
 }
 
 - (void)cancelTasksWithDelegate:(id)delegate
 {
-    // Cancel all task groups associated with this delegate
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSSet *taskGroupsForDelegate = [NSSet setWithSet:[self.delegateToTaskGroupsMap objectForKey:delegateKey]];
+    // Cancel all task groups associated with this delegate (the registry returns a snapshot which can safely
+    // be iterated while cancelling)
+    NSSet *taskGroupsForDelegate = [self.taskGroupDelegateRegistry objectsForDelegate:delegate];
     for (HLSTaskGroup *taskGroup in taskGroupsForDelegate) {
         [self cancelTaskGroup:taskGroup];
     }
     
     // Cancel all single tasks associated with this delegate
-    NSSet *tasksForDelegate = [NSSet setWithSet:[self.delegateToTasksMap objectForKey:delegateKey]];
+    NSSet *tasksForDelegate = [self.taskDelegateRegistry objectsForDelegate:delegate];
     for (HLSTask *task in tasksForDelegate) {
         [self cancelTask:task];
     }
 }
 
+- (void)cancelTasks:(NSArray *)tasks
+{
+    // Lane suspension is only updated once at the end
+    if ([tasks count] == 0) {
+        return;
+    }
+    
+    BOOL laneSuspensionUpdatesDeferred = _laneSuspensionUpdatesDeferred;
+    _laneSuspensionUpdatesDeferred = YES;
+    for (HLSTask *task in tasks) {
+        [self cancelTask:task];
+    }
+    _laneSuspensionUpdatesDeferred = laneSuspensionUpdatesDeferred;
+    [self updateLaneSuspension];
+}
+
+- (void)cancelTaskGroups:(NSArray *)taskGroups
+{
+    if ([taskGroups count] == 0) {
+        return;
+    }
+    
+    BOOL laneSuspensionUpdatesDeferred = _laneSuspensionUpdatesDeferred;
+    _laneSuspensionUpdatesDeferred = YES;
+    for (HLSTaskGroup *taskGroup in taskGroups) {
+        [self cancelTaskGroup:taskGroup];
+    }
+    _laneSuspensionUpdatesDeferred = laneSuspensionUpdatesDeferred;
+    [self updateLaneSuspension];
+}
+
 #pragma mark -
 #pragma mark Finding tasks
 
 - (NSArray *)tasksWithTag:(NSString *)tag
 {
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"tag MATCHES %@", tag];
-    return [[self.tasks filteredSetUsingPredicate:predicate] allObjects];
+    return [self.taskTagIndex objectsWithTag:tag];
 }
 
 - (NSArray *)taskGroupsWithTag:(NSString *)tag
 {
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"tag MATCHES %@", tag];
-    return [[self.taskGroups filteredSetUsingPredicate:predicate] allObjects];    
+    return [self.taskGroupTagIndex objectsWithTag:tag];
 }
 
 #pragma mark -
@@ -348,107 +811,48 @@
 
 - (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTask:(HLSTask *)task
 {
-    // Unregister any previously registered delegate first
-    [self unregisterDelegateForTask:task];
-    
-    // Register the task - delegate relationship; use the task pointer as key
-    // TODO: I first expected the obvious following code to work:
-    //          NSValue *taskKey = [NSValue valueWithPointer:task];
-    //          [self.taskToDelegateMap setObject:delegate forKey:taskKey];
-    //       but some strange crashes occurred under some circumstances (most notably when the manager
-    //       object was fed with many tasks while many other tasks were still being processed; in my
-    //       case web service requests were being sent fast with a slow internet connection). After
-    //       investigation the dictionary taskToDelegateMap is in some cases corrupt, but the
-    //       reason is unclear since:
-    //         - all processing occurs on the calling thread, no thread interleaving issues come into play
-    //         - I was careful enough to iterate on copies of data structures when a loop body can potentially
-    //           alter it, so no enumerator invalidation issues should occur
-    //       I could not find the reason why this problem occurs, but I found a solution: copy & swap. 
-    NSValue *taskKey = [NSValue valueWithPointer:task];
-    NSMutableDictionary *tempTaskToDelegateMap = [NSMutableDictionary dictionaryWithDictionary:self.taskToDelegateMap];
-    [tempTaskToDelegateMap setObject:delegate forKey:taskKey];
-    self.taskToDelegateMap = tempTaskToDelegateMap;
-    
-    // Register the inverse delegate - task relationship; use the delegate pointer as key
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSMutableSet *tasksForDelegate = [self.delegateToTasksMap objectForKey:delegateKey];
-    // Create the set lazily if it does not exist
-    if (! tasksForDelegate) {
-        tasksForDelegate = [NSMutableSet set];
-        [self.delegateToTasksMap setObject:tasksForDelegate forKey:delegateKey];
-    }
-    [tasksForDelegate addObject:task];
+    // Any previously registered delegate is replaced
+    [self.taskDelegateRegistry registerDelegate:delegate forObject:task];
 }
 
 - (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroup:(HLSTaskGroup *)taskGroup
 {
-    // Unregister any previously registered delegate first
-    [self unregisterDelegateForTaskGroup:taskGroup];
-    
-    // Register the task group - delegate relationship; use the task pointer as key
-    NSValue *taskGroupKey = [NSValue valueWithPointer:taskGroup];
-    [self.taskGroupToDelegateMap setObject:delegate forKey:taskGroupKey];
-    
-    // Register the inverse delegate - task group relationship; use the delgate pointer as key
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSMutableSet *taskGroupsForDelegate = [self.delegateToTaskGroupsMap objectForKey:delegateKey];
-    // Create the set lazily if it does not exist
-    if (! taskGroupsForDelegate) {
-        taskGroupsForDelegate = [NSMutableSet set];
-        [self.delegateToTaskGroupsMap setObject:taskGroupsForDelegate forKey:delegateKey];
-    }
-    [taskGroupsForDelegate addObject:taskGroup]; 
+    // Any previously registered delegate is replaced
+    [self.taskGroupDelegateRegistry registerDelegate:delegate forObject:taskGroup];
 }
 
-- (void)unregisterDelegateForTask:(HLSTask *)task
+- (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTask:(HLSTask *)task queue:(dispatch_queue_t)queue
 {
-    // Find if a delegate has been defined for this task; use the task pointer as key
-    NSValue *taskKey = [NSValue valueWithPointer:task];
-    id<HLSTaskDelegate> delegate = [self.taskToDelegateMap objectForKey:taskKey];
-    if (! delegate) {
-        return;
+    [self.taskDelegateRegistry registerDelegate:delegate forObject:task queue:queue];
+}
+
+- (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroup:(HLSTaskGroup *)taskGroup queue:(dispatch_queue_t)queue
+{
+    [self.taskGroupDelegateRegistry registerDelegate:delegate forObject:taskGroup queue:queue];
+}
+
+- (void)registerDelegate:(id<HLSTaskDelegate>)delegate forTasks:(NSArray *)tasks
+{
+    for (HLSTask *task in tasks) {
+        [self.taskDelegateRegistry registerDelegate:delegate forObject:task];
     }
-    
-    // Remove the task - delegate relationship
-    // TODO: Copy & swap strategy to avoid strange dictionary corruption; see registerDelegate:. Normally the following
-    //       should have worked:
-    //           [self.taskToDelegateMap removeObjectForKey:taskKey];
-    NSMutableDictionary *tempTaskToDelegateMap = [NSMutableDictionary dictionaryWithDictionary:self.taskToDelegateMap];
-    [tempTaskToDelegateMap removeObjectForKey:taskKey];
-    self.taskToDelegateMap = tempTaskToDelegateMap;
-    
-    // Remove the inverse delegate - task relationship; use the delegate pointer as key
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSMutableSet *tasksForDelegate = [self.delegateToTasksMap objectForKey:delegateKey];
-    [tasksForDelegate removeObject:task];
-    
-    // If the set is now empty for this delegate, then remove the dictionary entry as well
-    if ([tasksForDelegate count] == 0) {
-        [self.delegateToTasksMap removeObjectForKey:delegateKey];
+}
+
+- (void)registerDelegate:(id<HLSTaskGroupDelegate>)delegate forTaskGroups:(NSArray *)taskGroups
+{
+    for (HLSTaskGroup *taskGroup in taskGroups) {
+        [self.taskGroupDelegateRegistry registerDelegate:delegate forObject:taskGroup];
     }
 }
 
+- (void)unregisterDelegateForTask:(HLSTask *)task
+{
+    [self.taskDelegateRegistry unregisterDelegateForObject:task];
+}
+
 - (void)unregisterDelegateForTaskGroup:(HLSTaskGroup *)taskGroup
 {
-    // Find if a delegate has been defined for this task group; use the task pointer as key
-    NSValue *taskGroupKey = [NSValue valueWithPointer:taskGroup];
-    id<HLSTaskGroupDelegate> delegate = [self.taskGroupToDelegateMap objectForKey:taskGroupKey];
-    if (! delegate) {
-        return;
-    }
-    
-    // Remove the task group - delegate relationship
-    [self.taskGroupToDelegateMap removeObjectForKey:taskGroupKey];
-    
-    // Remove the inverse delegate - task group relationship
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSMutableSet *taskGroupsForDelegate = [self.delegateToTaskGroupsMap objectForKey:delegateKey];
-    [taskGroupsForDelegate removeObject:taskGroup];
-    
-    // If the set is now empty for this delegate, then remove the dictionary entry as well
-    if ([taskGroupsForDelegate count] == 0) {
-        [self.delegateToTaskGroupsMap removeObjectForKey:delegateKey];
-    }
+    [self.taskGroupDelegateRegistry unregisterDelegateForObject:taskGroup];
 }
 
 - (void)unregisterDelegateAndCancelAssociatedTasks:(id)delegate
@@ -461,18 +865,8 @@
 
 - (void)unregisterDelegate:(id)delegate
 {
-    // Find all tasks for this delegate, and unregister; use the delegate pointer as key
-    NSValue *delegateKey = [NSValue valueWithPointer:delegate];
-    NSSet *tasksForDelegate = [NSSet setWithSet:[self.delegateToTasksMap objectForKey:delegateKey]];
-    for (HLSTask *task in tasksForDelegate) {
-        [self unregisterDelegateForTask:task];
-    }
-    
-    // Same for task groups
-    NSSet *taskGroupsForDelegate = [NSSet setWithSet:[self.delegateToTaskGroupsMap objectForKey:delegateKey]];
-    for (HLSTaskGroup *taskGroup in taskGroupsForDelegate) {
-        [self unregisterDelegateForTaskGroup:taskGroup];
-    }
+    [self.taskDelegateRegistry unregisterDelegate:delegate];
+    [self.taskGroupDelegateRegistry unregisterDelegate:delegate];
 }
 
 #pragma mark -
@@ -492,6 +886,244 @@
     return operations;
 }
 
+#pragma mark -
+#pragma mark Sharing work between tasks with the same deduplication key
+
+- (void)attachTask:(HLSTask *)task toOperation:(HLSTaskOperation *)operation
+{
+    // Keep a strong ref to the task, and register it so that it can be found and cancelled as any other task
+    [self.tasks addObject:task];
+    NSValue *taskKey = [NSValue valueWithPointer:task];
+    [self.taskToOperationMap setObject:operation forKey:taskKey];
+    [self.taskTagIndex addObject:task withTag:task.tag];
+    
+    NSValue *operationKey = [NSValue valueWithPointer:operation];
+    NSMutableArray *subscriberTasks = [self.operationToSubscriberTasksMap objectForKey:operationKey];
+    if (! subscriberTasks) {
+        subscriberTasks = [NSMutableArray array];
+        [self.operationToSubscriberTasksMap setObject:subscriberTasks forKey:operationKey];
+    }
+    [subscriberTasks addObject:task];
+    
+    // The work is shared, but cancelling the task only stops its own notifications
+    task.cancellationToken = [[[HLSCancellationToken alloc] init] autorelease];
+    
+    [task reset];
+    
+    // If the work has already started, catch up with it
+    HLSTask *sharedTask = operation.task;
+    if (sharedTask.running) {
+        task.running = YES;
+        [self notifyDelegateOfTask:task withSelector:@selector(taskHasStartedProcessing:)];
+        task.progress = sharedTask.progress;
+        [self notifyDelegateOfTask:task withSelector:@selector(taskProgressUpdated:)];
+    }
+}
+
+- (void)detachTask:(HLSTask *)task fromOperation:(HLSTaskOperation *)operation
+{
+    // Keep the task alive until we are done
+    [[task retain] autorelease];
+    
+    NSValue *operationKey = [NSValue valueWithPointer:operation];
+    NSMutableArray *subscriberTasks = [self.operationToSubscriberTasksMap objectForKey:operationKey];
+    [subscriberTasks removeObjectIdenticalTo:task];
+    if ([subscriberTasks count] == 0) {
+        [self.operationToSubscriberTasksMap removeObjectForKey:operationKey];
+    }
+    
+    task.cancelled = YES;
+    task.running = NO;
+    task.finished = YES;
+    [task.cancellationToken cancel];
+    
+    [self notifyDelegateOfTask:task withSelector:@selector(taskHasBeenCancelled:)];
+    
+    NSValue *taskKey = [NSValue valueWithPointer:task];
+    [self.taskToOperationMap removeObjectForKey:taskKey];
+    [self unregisterDelegateForTask:task];
+    [self.taskTagIndex removeObject:task];
+    [self.tasks removeObject:task];
+}
+
+- (NSArray *)subscriberTasksForOperation:(HLSTaskOperation *)operation
+{
+    NSValue *operationKey = [NSValue valueWithPointer:operation];
+    NSArray *subscriberTasks = [self.operationToSubscriberTasksMap objectForKey:operationKey];
+    return subscriberTasks ? [NSArray arrayWithArray:subscriberTasks] : [NSArray array];
+}
+
+#pragma mark -
+#pragma mark Priority lanes
+
+- (HLSTaskPriority)priorityForTask:(HLSTask *)task
+{
+    // Tasks within a group all share the group priority. This way dependencies never cross lanes (a task could
+    // otherwise wait forever on a task in a lane which is not allowed to start tasks)
+    HLSTaskPriority priority = task.taskGroup ? task.taskGroup.priority : task.priority;
+    if (priority >= HLSTaskPriorityEnumEnd) {
+        HLSLoggerWarn(@"Invalid priority for task %@; the default priority is used", task);
+        priority = HLSTaskPriorityUserInitiated;
+    }
+    return priority;
+}
+
+- (void)scheduleOperations:(NSArray *)operations
+{
+    if ([operations count] == 0) {
+        return;
+    }
+    
+    // Threads processing prioritary tasks get more CPU time as well
+    static const double kThreadPriorities[HLSTaskPriorityEnumSize] = { 1., 0.5, 0.1 };
+    
+    // Dispatch operations into their lanes (preserving their order)
+    NSMutableArray *laneOperationArrays = [NSMutableArray array];
+    for (NSUInteger i = 0; i < HLSTaskPriorityEnumSize; ++i) {
+        [laneOperationArrays addObject:[NSMutableArray array]];
+    }
+    for (HLSTaskOperation *operation in operations) {
+        HLSTaskPriority priority = [self priorityForTask:operation.task];
+        [operation setThreadPriority:kThreadPriorities[priority]];
+        [[laneOperationArrays objectAtIndex:priority] addObject:operation];
+        
+        NSMutableSet *pendingOperations = [self.pendingOperationSets objectAtIndex:priority];
+        [pendingOperations addObject:operation];
+    }
+    [self updateLaneSuspension];
+    
+    // Hand the operations over to each queue at once
+    for (NSUInteger i = 0; i < HLSTaskPriorityEnumSize; ++i) {
+        NSArray *laneOperations = [laneOperationArrays objectAtIndex:i];
+        if ([laneOperations count] == 0) {
+            continue;
+        }
+        
+        NSOperationQueue *operationQueue = [self.operationQueues objectAtIndex:i];
+        [operationQueue addOperations:laneOperations waitUntilFinished:NO];
+    }
+}
+
+- (void)operationHasStarted:(HLSTaskOperation *)operation
+{
+    HLSTaskPriority priority = [self priorityForTask:operation.task];
+    NSMutableSet *pendingOperations = [self.pendingOperationSets objectAtIndex:priority];
+    if (! [pendingOperations containsObject:operation]) {
+        return;
+    }
+    
+    [pendingOperations removeObject:operation];
+    [self updateLaneSuspension];
+    
+    HLSTaskConcurrencyController *concurrencyController = [self.priorityToConcurrencyControllerMap objectForKey:[NSNumber numberWithInt:priority]];
+    [concurrencyController recordStartOfOperation:operation];
+}
+
+// Suspend all lanes below the highest priority lane having operations ready to be started (i.e. submitted, not 
+// started and without pending dependencies). Suspending a queue does not affect its running operations, it
+// only prevents it from starting new ones
+- (void)updateLaneSuspension
+{
+    if (_laneSuspensionUpdatesDeferred) {
+        return;
+    }
+    
+    BOOL higherLaneHasReadyOperations = NO;
+    for (NSUInteger i = 0; i < HLSTaskPriorityEnumSize; ++i) {
+        NSOperationQueue *operationQueue = [self.operationQueues objectAtIndex:i];
+        if ([operationQueue isSuspended] != higherLaneHasReadyOperations) {
+            [operationQueue setSuspended:higherLaneHasReadyOperations];
+        }
+        
+        if (! higherLaneHasReadyOperations) {
+            NSSet *pendingOperations = [self.pendingOperationSets objectAtIndex:i];
+            for (HLSTaskOperation *operation in pendingOperations) {
+                if ([operation isReady] && ! [operation isExecuting] && ! [operation isFinished]) {
+                    higherLaneHasReadyOperations = YES;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Scheduling task group dependencies
+
+// Remark: Dependencies between tasks of a group were previously applied as NSOperation dependencies, all operations
+//         being added to the queue at once. Their execution order was therefore left to the queue, and a dependency
+//         cycle silently deadlocked the group. Operations are now only added to the queue when they are ready (i.e. 
+//         when all their dependencies have ended), tasks beginning the longest chains of dependent tasks first. Cycles
+//         are rejected when dependencies are added to the group
+- (NSArray *)prioritizedReadyOperations:(NSArray *)operations ofTaskGroup:(HLSTaskGroup *)taskGroup
+{
+    // Longest critical path first
+    NSArray *sortedOperations = [operations sortedArrayUsingComparator:^NSComparisonResult(HLSTaskOperation *operation1, HLSTaskOperation *operation2) {
+        NSUInteger criticalPathLength1 = [taskGroup criticalPathLengthForTask:operation1.task];
+        NSUInteger criticalPathLength2 = [taskGroup criticalPathLengthForTask:operation2.task];
+        if (criticalPathLength1 > criticalPathLength2) {
+            return NSOrderedAscending;
+        }
+        else if (criticalPathLength1 < criticalPathLength2) {
+            return NSOrderedDescending;
+        }
+        else {
+            return NSOrderedSame;
+        }
+    }];
+    
+    for (HLSTaskOperation *operation in sortedOperations) {
+        // Ready operations already waiting in the queue must not be overtaken by operations on shorter paths
+        NSUInteger criticalPathLength = [taskGroup criticalPathLengthForTask:operation.task];
+        if (criticalPathLength > 2) {
+            [operation setQueuePriority:NSOperationQueuePriorityVeryHigh];
+        }
+        else if (criticalPathLength == 2) {
+            [operation setQueuePriority:NSOperationQueuePriorityHigh];
+        }
+    }
+    
+    return sortedOperations;
+}
+
+- (void)releaseDependentsOfOperation:(HLSTaskOperation *)operation
+{
+    HLSTaskGroup *taskGroup = operation.task.taskGroup;
+    if (! taskGroup) {
+        return;
+    }
+    
+    NSMutableArray *readyOperations = [NSMutableArray array];
+    for (HLSTask *dependent in [taskGroup dependentsForTask:operation.task]) {
+        NSValue *dependentKey = [NSValue valueWithPointer:dependent];
+        NSNumber *nbrRemainingDependenciesNumber = [self.taskToRemainingDependencyCountMap objectForKey:dependentKey];
+        if (! nbrRemainingDependenciesNumber) {
+            continue;
+        }
+        
+        NSUInteger nbrRemainingDependencies = [nbrRemainingDependenciesNumber unsignedIntegerValue] - 1;
+        if (nbrRemainingDependencies != 0) {
+            [self.taskToRemainingDependencyCountMap setObject:[NSNumber numberWithUnsignedInteger:nbrRemainingDependencies] 
+                                                       forKey:dependentKey];
+            continue;
+        }
+        
+        [self.taskToRemainingDependencyCountMap removeObjectForKey:dependentKey];
+        
+        // Strong dependents have already been cancelled if the task failed
+        if (dependent.finished) {
+            continue;
+        }
+        
+        HLSTaskOperation *dependentOperation = [self.taskToOperationMap objectForKey:dependentKey];
+        if (dependentOperation) {
+            [readyOperations addObject:dependentOperation];
+        }
+    }
+    
+    [self scheduleOperations:[self prioritizedReadyOperations:readyOperations ofTaskGroup:taskGroup]];
+}
+
 #pragma mark -
 #pragma mark Registering object relationships
 
@@ -503,6 +1135,21 @@
     // Save the relationship between task and operation; use the task pointer as key
     NSValue *taskKey = [NSValue valueWithPointer:operation.task];
     [self.taskToOperationMap setObject:operation forKey:taskKey];
+    
+    [self.taskTagIndex addObject:operation.task withTag:operation.task.tag];
+    [self.objectToSubmissionIndexMap setObject:[NSNumber numberWithUnsignedInteger:_nbrSubmissions++] forKey:taskKey];
+    
+    // The task and its operation share the same cancellation token
+    operation.task.cancellationToken = operation.cancellationToken;
+    
+    [self.trace recordEventWithType:HLSTaskTraceEventTypeSubmitted forTask:operation.task progress:0.f];
+    operation.traceIdentifier = HLSTraceBegin(@"Tasks", [operation traceName]);
+    
+    // Make the work available to tasks with the same deduplication key (tasks in groups are never deduplicated)
+    NSString *deduplicationKey = operation.task.taskGroup ? nil : operation.task.deduplicationKey;
+    if (deduplicationKey && ! [self.deduplicationKeyToOperationMap objectForKey:deduplicationKey]) {
+        [self.deduplicationKeyToOperationMap setObject:operation forKey:deduplicationKey];
+    }
 }
 
 - (void)unregisterOperation:(HLSTaskOperation *)operation
@@ -511,6 +1158,13 @@
     NSValue *taskKey = [NSValue valueWithPointer:operation.task];
     [self.taskToOperationMap removeObjectForKey:taskKey];   
     
+    // The task might have been cancelled while still waiting for its dependencies
+    [self.taskToRemainingDependencyCountMap removeObjectForKey:taskKey];
+    
+    // Dependents might be ready now. Outputs which are not needed anymore can be released
+    [self releaseDependentsOfOperation:operation];
+    [operation.task.taskGroup releaseOutputsNoLongerNeededAfterTask:operation.task];
+    
     // Automatically cleanup delegate registrations
     [self unregisterDelegateForTask:operation.task];
     
@@ -522,7 +1176,38 @@
         }        
     }
     
-    // Finally, release the strong ref to the task
+    HLSTaskPriority priority = [self priorityForTask:operation.task];
+    
+    // Let the lane adapt its width if needed
+    HLSTaskConcurrencyController *concurrencyController = [self.priorityToConcurrencyControllerMap objectForKey:[NSNumber numberWithInt:priority]];
+    if ([concurrencyController recordEndOfOperation:operation completed:! [operation isCancelled]]) {
+        [self setQueueMaxConcurrentOperationCount:concurrencyController.count forPriority:priority];
+    }
+    
+    // The operation might have been cancelled before it started. Dependents might also have become ready
+    NSMutableSet *pendingOperations = [self.pendingOperationSets objectAtIndex:priority];
+    [pendingOperations removeObject:operation];
+    [self updateLaneSuspension];
+    
+    // Tasks sharing the work are done as well
+    NSString *deduplicationKey = operation.task.deduplicationKey;
+    if (deduplicationKey && [self.deduplicationKeyToOperationMap objectForKey:deduplicationKey] == operation) {
+        [self.deduplicationKeyToOperationMap removeObjectForKey:deduplicationKey];
+    }
+    NSArray *subscriberTasks = [self subscriberTasksForOperation:operation];
+    [self.operationToSubscriberTasksMap removeObjectForKey:[NSValue valueWithPointer:operation]];
+    [self.abandonedOperations removeObject:operation];
+    for (HLSTask *subscriberTask in subscriberTasks) {
+        NSValue *subscriberTaskKey = [NSValue valueWithPointer:subscriberTask];
+        [self.taskToOperationMap removeObjectForKey:subscriberTaskKey];
+        [self unregisterDelegateForTask:subscriberTask];
+        [self.taskTagIndex removeObject:subscriberTask];
+        [self.tasks removeObject:subscriberTask];
+    }
+    
+    // Finally, release the strong refs to the task
+    [self.objectToSubmissionIndexMap removeObjectForKey:taskKey];
+    [self.taskTagIndex removeObject:operation.task];
     [self.tasks removeObject:operation.task];
 }
 
@@ -530,6 +1215,11 @@
 {
     // Keep a strong ref to the task group
     [self.taskGroups addObject:taskGroup];
+    
+    [self.taskGroupTagIndex addObject:taskGroup withTag:taskGroup.tag];
+    
+    NSValue *taskGroupKey = [NSValue valueWithPointer:taskGroup];
+    [self.objectToSubmissionIndexMap setObject:[NSNumber numberWithUnsignedInteger:_nbrSubmissions++] forKey:taskGroupKey];
 }
 
 - (void)unregisterTaskGroup:(HLSTaskGroup *)taskGroup
@@ -537,23 +1227,80 @@
     // Automatically cleanup delegate registrations
     [self unregisterDelegateForTaskGroup:taskGroup];
     
-    // Release the strong ref to the task group
+    // Release the strong refs to the task group
+    NSValue *taskGroupKey = [NSValue valueWithPointer:taskGroup];
+    [self.objectToSubmissionIndexMap removeObjectForKey:taskGroupKey];
+    [self.taskGroupTagIndex removeObject:taskGroup];
     [self.taskGroups removeObject:taskGroup];
 }
 
+#pragma mark -
+#pragma mark Notifying delegates
+
+- (void)notifyDelegateOfTask:(HLSTask *)task withSelector:(SEL)selector
+{
+    id<HLSTaskDelegate> taskDelegate = [self.taskDelegateRegistry delegateForObject:task respondingToSelector:selector];
+    if (! taskDelegate) {
+        return;
+    }
+    
+    dispatch_queue_t queue = [self.taskDelegateRegistry queueForObject:task];
+    if (queue) {
+        // The block retains the delegate until the event has been delivered. The task keeps changing on this thread,
+        // deliver its status when the event occurred
+        HLSTask *taskSnapshot = [task snapshot];
+        dispatch_async(queue, ^{
+            [taskDelegate performSelector:selector withObject:taskSnapshot];
+        });
+    }
+    else {
+        [self performSelector:selector ofDelegate:taskDelegate withObject:task];
+    }
+}
+
+- (void)notifyDelegateOfTaskGroup:(HLSTaskGroup *)taskGroup withSelector:(SEL)selector
+{
+    id<HLSTaskGroupDelegate> taskGroupDelegate = [self.taskGroupDelegateRegistry delegateForObject:taskGroup respondingToSelector:selector];
+    if (! taskGroupDelegate) {
+        return;
+    }
+    
+    dispatch_queue_t queue = [self.taskGroupDelegateRegistry queueForObject:taskGroup];
+    if (queue) {
+        HLSTaskGroup *taskGroupSnapshot = [taskGroup snapshot];
+        dispatch_async(queue, ^{
+            [taskGroupDelegate performSelector:selector withObject:taskGroupSnapshot];
+        });
+    }
+    else {
+        [self performSelector:selector ofDelegate:taskGroupDelegate withObject:taskGroup];
+    }
+}
+
+- (void)performSelector:(SEL)selector ofDelegate:(id)delegate withObject:(id)object
+{
+    HLSTaskWatchdog *watchdog = self.watchdog;
+    if (! watchdog) {
+        [delegate performSelector:selector withObject:object];
+        return;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [delegate performSelector:selector withObject:object];
+    [watchdog recordCallbackOfDelegate:delegate withSelector:selector duration:CFAbsoluteTimeGetCurrent() - startTime];
+}
+
 #pragma mark -
 #pragma mark Retrieving registered delegates
 
 - (id<HLSTaskDelegate>)delegateForTask:(HLSTask *)task
 {
-    NSValue *taskKey = [NSValue valueWithPointer:task];
-    return [self.taskToDelegateMap objectForKey:taskKey];
+    return [self.taskDelegateRegistry delegateForObject:task];
 }
 
 - (id<HLSTaskGroupDelegate>)delegateForTaskGroup:(HLSTaskGroup *)taskGroup
 {
-    NSValue *taskGroupKey = [NSValue valueWithPointer:taskGroup];
-    return [self.taskGroupToDelegateMap objectForKey:taskGroupKey];
+    return [self.taskGroupDelegateRegistry delegateForObject:taskGroup];
 }
 
 @end
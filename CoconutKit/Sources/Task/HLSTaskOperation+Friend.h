@@ -0,0 +1,34 @@
+//
+//  HLSTaskOperation+Friend.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Interface meant to be used by friend classes of HLSTaskOperation (= classes which must have access to private 
+ * implementation details)
+ */
+@interface HLSTaskOperation (Friend)
+
+/**
+ * Queue a method call to be performed on the thread which submitted the task, in order with all other status 
+ * changes
+ */
+- (void)onCallingThreadPerformSelector:(SEL)selector object:(NSObject *)objectOrNil coalescing:(BOOL)coalescing;
+
+/**
+ * The HLSTrace interval spanning from the submission of the task to the delivery of its results (0 if none), and
+ * the name under which the task appears in the trace
+ */
+@property (nonatomic, assign) HLSTraceIdentifier traceIdentifier;
+- (NSString *)traceName;
+
+/**
+ * Set to YES when the end of the task has been notified. Events still queued are then discarded, since the task
+ * they refer to might already have been released
+ */
+@property (nonatomic, assign, getter=isEndDelivered) BOOL endDelivered;
+
+@end
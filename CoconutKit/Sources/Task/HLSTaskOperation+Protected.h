@@ -39,4 +39,20 @@
  */
 - (void)attachError:(NSError *)error;
 
+/**
+ * Call this method to hand an object over to the operations of the tasks depending on the task processed by the 
+ * operation (in the same task group). The object is neither copied nor delivered to the thread which submitted
+ * the task, and is available as soon as this method returns. It is released when all dependent tasks have ended.
+ * Does nothing if the task does not belong to a task group
+ * Not meant to be overridden
+ */
+- (void)attachOutput:(id)output;
+
+/**
+ * Return the object handed over by the operation of another task of the same task group (usually a task the task
+ * processed by the operation depends on), nil if none
+ * Not meant to be overridden
+ */
+- (id)outputOfTask:(HLSTask *)task;
+
 @end
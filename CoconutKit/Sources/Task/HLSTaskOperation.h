@@ -6,8 +6,10 @@
 //  Copyright 2010 Hortis. All rights reserved.
 //
 
+#import "HLSCancellationToken.h"
 #import "HLSTask.h"
 #import "HLSTaskManager.h"
+#import "HLSTrace.h"
 
 /**
  * Abstract class for implementing operations to be performed for a task by a task manager. Concrete subclasses
@@ -21,10 +23,17 @@
  *    if your operations are already running (e.g. downloading data), they will only be put in the cancelled state,
  *    but the corresponding thread will not be killed. Your operation implementation is therefore responsible to check
  *    its state regularly so that if a running operation is switched to the cancelled state it gracefully stops its
- *    current work as soon as possible
+ *    current work as soon as possible. Work which cannot be polled (e.g. an NSURLConnection waiting for data, a 
+ *    blocking file read) should register a handler with the operation cancellation token instead, so that it is 
+ *    stopped as soon as the task is cancelled
  *  - operations are instantiated by the HLSTaskManager using their designated initializer. Your subclass must therefore
  *    not define any other initializer since they would never be called
  *
+ * Status changes (progress, return information, errors) are delivered asynchronously to the thread which submitted
+ * the task, in the order they were made. The operation thread is never blocked while this happens. Consecutive progress 
+ * updates which have not been delivered yet are collapsed, only the most recent value being reported. You can therefore 
+ * update progress as often as you want without slowing down your operation
+ *
  * Designated initializer: -initWithTaskManager:task:
  */
 @interface HLSTaskOperation : NSOperation {
@@ -32,10 +41,21 @@
     HLSTaskManager *_taskManager;       // The task manager which spawned the operation
     HLSTask *_task;                     // The task the operation is processing
     NSThread *_callingThread;           // Thread onto which spawned the operation
+    NSMutableArray *_pendingEvents;     // Events waiting to be delivered on the calling thread (in order)
+    BOOL _drainScheduled;               // YES iff pending events will be delivered soon on the calling thread
+    BOOL _endDelivered;                 // YES iff the end of the task has been notified (no event must be delivered anymore)
+    HLSCancellationToken *_cancellationToken;
+    HLSTraceIdentifier _traceIdentifier;    // Interval from submission to delivery (see HLSTrace)
 }
 
 - (id)initWithTaskManager:(HLSTaskManager *)taskManager task:(HLSTask *)task;
 
 @property (nonatomic, readonly, assign) HLSTask *task;           // weak ref; the manager is responsible to keep the strong ref
 
+/**
+ * The token cancelled when the operation is cancelled. It is shared with the task, and can be polled cheaply from
+ * any thread or be used to register cancellation handlers (see HLSCancellationToken)
+ */
+@property (nonatomic, readonly, retain) HLSCancellationToken *cancellationToken;
+
 @end
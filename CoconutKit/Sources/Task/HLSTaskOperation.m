@@ -12,28 +12,71 @@
 #import "HLSLogger.h"
 #import "HLSTask+Friend.h"
 #import "HLSTaskGroup+Friend.h"
+#import "HLSTaskJournal.h"
 #import "HLSTaskManager+Friend.h"
+#import "HLSTaskTrace.h"
+
+#pragma mark -
+#pragma mark TaskOperationEvent class interface
+
+/**
+ * An event waiting to be delivered on the calling thread of an operation, i.e. a method to be called with an 
+ * optional object parameter. Events are created for each status change of each operation. Instead of being 
+ * deallocated once delivered, they are recycled into a bounded pool shared by all operations, so that sustained 
+ * loads of small tasks do not incur allocator churn
+ *
+ * Designated initializer: -initWithSelector:object:
+ */
+@interface TaskOperationEvent : NSObject {
+@private
+    SEL m_selector;
+    id m_object;
+}
+
++ (TaskOperationEvent *)eventWithSelector:(SEL)selector object:(id)objectOrNil;
++ (void)recycleEvents:(NSArray *)events;
+
+- (id)initWithSelector:(SEL)selector object:(id)objectOrNil;
+
+@property (nonatomic, assign) SEL selector;
+@property (nonatomic, retain) id object;
+
+@end
+
+#pragma mark -
+#pragma mark HLSTaskOperation class interface extension
 
 @interface HLSTaskOperation ()
 
 @property (nonatomic, assign) HLSTaskManager *taskManager;
 @property (nonatomic, assign) HLSTask *task;
 @property (nonatomic, retain) NSThread *callingThread;
+@property (nonatomic, retain) NSMutableArray *pendingEvents;
+@property (nonatomic, retain) HLSCancellationToken *cancellationToken;
+@property (nonatomic, assign) HLSTraceIdentifier traceIdentifier;
 
 - (void)operationMain;
 
-- (void)onCallingThreadPerformSelector:(SEL)selector object:(NSObject *)objectOrNil;
+- (void)onCallingThreadPerformSelector:(SEL)selector object:(NSObject *)objectOrNil coalescing:(BOOL)coalescing;
+- (void)drainPendingEvents;
+- (NSString *)traceName;
 - (void)updateProgressToValue:(float)progress;
 - (void)attachError:(NSError *)error;
 
 - (void)notifyStart;
 - (void)notifyRunningWithProgress:(NSNumber *)progress;
 - (void)notifyEnd;
+- (void)notifyStartForTask:(HLSTask *)task;
+- (void)notifyProgress:(float)progress forTask:(HLSTask *)task;
+- (void)notifyEndForTask:(HLSTask *)task;
 - (void)notifySettingReturnInfo:(NSDictionary *)returnInfo;
 - (void)notifySettingError:(NSError *)error;
 
 @end
 
+#pragma mark -
+#pragma mark HLSTaskOperation class implementation
+
 @implementation HLSTaskOperation
 
 #pragma mark -
@@ -45,6 +88,8 @@
         self.taskManager = taskManager;
         self.task = task;
         self.callingThread = [NSThread currentThread];
+        self.pendingEvents = [NSMutableArray array];
+        self.cancellationToken = [[[HLSCancellationToken alloc] init] autorelease];
     }
     return self;
 }
@@ -60,6 +105,8 @@
     self.taskManager = nil;
     self.task = nil;
     self.callingThread = nil;
+    self.pendingEvents = nil;
+    self.cancellationToken = nil;
     [super dealloc];
 }
 
@@ -72,19 +119,50 @@
 
 @synthesize callingThread = _callingThread;
 
+@synthesize pendingEvents = _pendingEvents;
+
+@synthesize cancellationToken = _cancellationToken;
+
+@synthesize traceIdentifier = _traceIdentifier;
+
+@synthesize endDelivered = _endDelivered;
+
+- (NSString *)traceName
+{
+    return self.task.tag ? self.task.tag : NSStringFromClass([self.task class]);
+}
+
+#pragma mark -
+#pragma mark Cancellation
+
+- (void)cancel
+{
+    [super cancel];
+    
+    // Stop any work registered with the token right away, instead of waiting for the operation to poll its status
+    [self.cancellationToken cancel];
+}
+
 #pragma mark -
 #pragma mark Thread main function
 
 - (void)main
 {
+    HLSTaskTrace *trace = self.taskManager.trace;
+    [trace recordEventWithType:HLSTaskTraceEventTypeDequeued forTask:self.task progress:0.f];
+    
     // Notify begin
-    [self onCallingThreadPerformSelector:@selector(notifyStart) object:nil];
+    [self onCallingThreadPerformSelector:@selector(notifyStart) object:nil coalescing:NO];
     
     // Execute the main method code
+    [trace recordEventWithType:HLSTaskTraceEventTypeMainStarted forTask:self.task progress:0.f];
+    HLSTraceIdentifier runTraceIdentifier = HLSTraceBegin(@"Tasks", [NSString stringWithFormat:@"Run %@", [self traceName]]);
     [self operationMain];
+    HLSTraceEnd(runTraceIdentifier);
+    [trace recordEventWithType:HLSTaskTraceEventTypeMainEnded forTask:self.task progress:0.f];
     
     // Notify end
-    [self onCallingThreadPerformSelector:@selector(notifyEnd) object:nil];
+    [self onCallingThreadPerformSelector:@selector(notifyEnd) object:nil coalescing:NO];
 }
 
 - (void)operationMain
@@ -95,21 +173,59 @@
 #pragma mark -
 #pragma mark Executing code on the calling thread
 
-- (void)onCallingThreadPerformSelector:(SEL)selector object:(NSObject *)objectOrNil
+// Remark: Events were previously delivered using performSelector:onThread:withObject:waitUntilDone:YES, which was
+//         needed since with waitUntilDone:NO selectors are not guaranteed to be performed in the order they were
+//         scheduled (a progress update performed after -notifyEnd would crash, since the task is released by then).
+//         This blocked the operation thread for a full round trip to the calling thread for each progress update.
+//         Events are now appended to a queue owned by the operation and drained in FIFO order on the calling thread,
+//         a single drain being scheduled at a time. Ordering is therefore guaranteed without ever blocking
+- (void)onCallingThreadPerformSelector:(SEL)selector object:(NSObject *)objectOrNil coalescing:(BOOL)coalescing
 {
-    // HUGE WARNING here! If we do not wait until done, we might sometimes (most notably under heavy load) perform selectors
-    // on the calling thread, but not in the order they were scheduled. This can be a complete disaster if we perform the
-    // notifyEnd method before a progress update via notifyRunningWithProgress:. If waitUntilDone is left to NO, then this
-    // might happen and, since the task is released by notifyEnd, any notifyRunningWithProgress: coming after it would crash.
-    // To avoid this issue, waitUntilDone must clearly be set to YES.
-    // Remark: This equivalently means that when waitUntilDone is NO, selectors are not necessarily processed in the order they 
-    //         are "sent" to the calling thread. Most of the time they seem to, but not always. Setting waitUntilDone to YES 
-    //         guarantees they will be processed sequentially (of course, since performSelector blocks the thread). IMHO, I would 
-    //         have not called this method performSelector:onThread:withObject:waitUntilDone:, 
-    [self performSelector:selector 
-                 onThread:self.callingThread 
-               withObject:objectOrNil
-            waitUntilDone:YES];
+    BOOL shouldScheduleDrain = NO;
+    @synchronized(self.pendingEvents) {
+        // If the previous event has not been delivered yet and is of the same kind, only keep the most recent value
+        TaskOperationEvent *lastEvent = [self.pendingEvents lastObject];
+        if (coalescing && lastEvent && lastEvent.selector == selector) {
+            lastEvent.object = objectOrNil;
+        }
+        else {
+            TaskOperationEvent *event = [TaskOperationEvent eventWithSelector:selector object:objectOrNil];
+            [self.pendingEvents addObject:event];
+        }
+        
+        if (! _drainScheduled) {
+            _drainScheduled = YES;
+            shouldScheduleDrain = YES;
+        }
+    }
+    
+    // The operation is retained until the drain has been performed
+    if (shouldScheduleDrain) {
+        [self performSelector:@selector(drainPendingEvents)
+                     onThread:self.callingThread
+                   withObject:nil
+                waitUntilDone:NO];
+    }
+}
+
+- (void)drainPendingEvents
+{
+    NSArray *events = nil;
+    @synchronized(self.pendingEvents) {
+        events = [NSArray arrayWithArray:self.pendingEvents];
+        [self.pendingEvents removeAllObjects];
+        _drainScheduled = NO;
+    }
+    
+    for (TaskOperationEvent *event in events) {
+        // The task manager might have ended the task while events were waiting (e.g. when cancelled after its main
+        // method returned). The task is then already gone
+        if (self.endDelivered) {
+            break;
+        }
+        [self performSelector:event.selector withObject:event.object];
+    }
+    [TaskOperationEvent recycleEvents:events];
 }
 
 // Remark: Originally, I intended to call this method "setProgress:", but this was a bad idea. It could have conflicted
@@ -117,20 +233,41 @@
 //         since one of my subclasses implemented the ASIProgressDelegate protocol, which declares a setProgress: method)
 - (void)updateProgressToValue:(float)progress
 {
+    [self.taskManager.trace recordEventWithType:HLSTaskTraceEventTypeProgressUpdated forTask:self.task progress:progress];
     [self onCallingThreadPerformSelector:@selector(notifyRunningWithProgress:) 
-                                  object:[NSNumber numberWithFloat:progress]];
+                                  object:[NSNumber numberWithFloat:progress]
+                              coalescing:YES];
 }
 
 - (void)attachReturnInfo:(NSDictionary *)returnInfo
 {
     [self onCallingThreadPerformSelector:@selector(notifySettingReturnInfo:) 
-                                  object:returnInfo];
+                                  object:returnInfo
+                              coalescing:NO];
 }
 
 - (void)attachError:(NSError *)error
 {
     [self onCallingThreadPerformSelector:@selector(notifySettingError:) 
-                                  object:error];
+                                  object:error
+                              coalescing:NO];
+}
+
+- (void)attachOutput:(id)output
+{
+    // Stored directly, dependents are only started after the operation has ended
+    HLSTaskGroup *taskGroup = self.task.taskGroup;
+    if (! taskGroup) {
+        HLSLoggerWarn(@"Outputs can only be handed over to tasks of the same task group");
+        return;
+    }
+    
+    [taskGroup setOutput:output forTask:self.task];
+}
+
+- (id)outputOfTask:(HLSTask *)task
+{
+    return [self.task.taskGroup outputForTask:task];
 }
 
 #pragma mark -
@@ -140,6 +277,8 @@
 {
     HLSLoggerDebug(@"Task %@ starts", self.task);
     
+    [self.taskManager operationHasStarted:self];
+    
     // Reset status
     [self.task reset];
     
@@ -149,56 +288,51 @@
         HLSLoggerDebug(@"Task group %@ starts", taskGroup);
         
         taskGroup.running = YES;
-        id<HLSTaskGroupDelegate> taskGroupDelegate = [self.taskManager delegateForTaskGroup:taskGroup];
-        if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasStartedProcessing:)]) {
-            [taskGroupDelegate taskGroupHasStartedProcessing:taskGroup];
-        }
+        [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasStartedProcessing:)];
     }
     
-    // ... then flag the task as running and notify ...
-    id<HLSTaskDelegate> taskDelegate = [self.taskManager delegateForTask:self.task];
-    self.task.running = YES;
-    if ([taskDelegate respondsToSelector:@selector(taskHasStartedProcessing:)]) {
-        [taskDelegate taskHasStartedProcessing:self.task];
-    }
-    self.task.progress = 0.f;
-    if ([taskDelegate respondsToSelector:@selector(taskProgressUpdated:)]) {
-        [taskDelegate taskProgressUpdated:self.task];
+    // ... then flag the task (and the tasks sharing its work) as running and notify ...
+    [self notifyStartForTask:self.task];
+    for (HLSTask *subscriberTask in [self.taskManager subscriberTasksForOperation:self]) {
+        // Skip tasks detached by delegates in the meantime
+        if (subscriberTask.cancelled) {
+            continue;
+        }
+        
+        [subscriberTask reset];
+        [self notifyStartForTask:subscriberTask];
     }
     
     // ... and finally update and notify about the task group status
     if (taskGroup) {
         [taskGroup updateStatus];
-        id<HLSTaskGroupDelegate> taskGroupDelegate = [self.taskManager delegateForTaskGroup:taskGroup];
-        if ([taskGroupDelegate respondsToSelector:@selector(taskGroupProgressUpdated:)]) {
-            [taskGroupDelegate taskGroupProgressUpdated:taskGroup];
-        }
+        [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupProgressUpdated:)];
     }
 }
 
 - (void)notifyRunningWithProgress:(NSNumber *)progress
 {
     // Update and notify about the task progress
-    self.task.progress = [progress floatValue];
-    id<HLSTaskDelegate> taskDelegate = [self.taskManager delegateForTask:self.task];
-    if ([taskDelegate respondsToSelector:@selector(taskProgressUpdated:)]) {
-        [taskDelegate taskProgressUpdated:self.task];
+    [self notifyProgress:[progress floatValue] forTask:self.task];
+    for (HLSTask *subscriberTask in [self.taskManager subscriberTasksForOperation:self]) {
+        if (subscriberTask.cancelled) {
+            continue;
+        }
+        
+        [self notifyProgress:[progress floatValue] forTask:subscriberTask];
     }
     
     // If part of a task group, update and notify about its status as well
     HLSTaskGroup *taskGroup = self.task.taskGroup;
     if (taskGroup) {
         [taskGroup updateStatus];
-        id<HLSTaskGroupDelegate> taskGroupDelegate = [self.taskManager delegateForTaskGroup:taskGroup];
-        if ([taskGroupDelegate respondsToSelector:@selector(taskGroupProgressUpdated:)]) {
-            [taskGroupDelegate taskGroupProgressUpdated:taskGroup];
-        }
+        [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupProgressUpdated:)];
     }
 }
 
 - (void)notifyEnd
 {
-    id<HLSTaskDelegate> taskDelegate = [self.taskManager delegateForTask:self.task];
+    self.endDelivered = YES;
     
     // If part of a task group, first cancel all dependent tasks; a task group is removed once all tasks it contains are
     // marked as finished. Here we are careful enough to cancel all dependent task before the current task is set as 
@@ -212,49 +346,31 @@
                 [self.taskManager cancelTask:dependent];
             }
         }
-    }
-    
-    // Update the progress to 1.f on success, else do not alter current value (so that the progress value cannot go backwards)
-    if (! self.task.error && ! [self isCancelled]) {
-        self.task.progress = 1.f;
-        if ([taskDelegate respondsToSelector:@selector(taskProgressUpdated:)]) {
-            [taskDelegate taskProgressUpdated:self.task];
+        // Record successful tasks first, so that they are not processed again even if the application dies meanwhile
+        else if (self.task.journalKey) {
+            [taskGroup.journal recordCompletionForKey:self.task.journalKey returnInfo:self.task.returnInfo];
         }
     }
-    self.task.finished = YES;
-    self.task.running = NO;
     
-    // The task has been cancelled
-    if ([self isCancelled]) {
-        HLSLoggerDebug(@"Task %@ has been cancelled", self.task);
-        if ([taskDelegate respondsToSelector:@selector(taskHasBeenCancelled:)]) {
-            [taskDelegate taskHasBeenCancelled:self.task];
-        }        
-    }
-    // The task has been processed
-    else {
-        // Successful
-        if (! self.task.error) {
-            HLSLoggerDebug(@"Task %@ ends successfully", self.task);
-        }
-        // An error has been attached during processing
-        else {
-            HLSLoggerDebug(@"Task %@ has encountered an error", self.task);
+    // Tasks sharing the work receive the same results
+    [self notifyEndForTask:self.task];
+    for (HLSTask *subscriberTask in [self.taskManager subscriberTasksForOperation:self]) {
+        if (subscriberTask.cancelled) {
+            continue;
         }
         
-        if ([taskDelegate respondsToSelector:@selector(taskHasBeenProcessed:)]) {
-            [taskDelegate taskHasBeenProcessed:self.task];
-        }        
+        [subscriberTask copyResultsFromTask:self.task];
+        [self notifyEndForTask:subscriberTask];
     }
+    [self.taskManager.trace recordEventWithType:HLSTaskTraceEventTypeDelegateDelivered forTask:self.task progress:self.task.progress];
+    HLSTraceEnd(self.traceIdentifier);
+    self.traceIdentifier = 0;
     
     // If part of a task group
     if (taskGroup) {
         // Update an notify about the task group progress as well
-        id<HLSTaskGroupDelegate> taskGroupDelegate = [self.taskManager delegateForTaskGroup:taskGroup];
         [taskGroup updateStatus];
-        if ([taskGroupDelegate respondsToSelector:@selector(taskGroupProgressUpdated:)]) {
-            [taskGroupDelegate taskGroupProgressUpdated:taskGroup];
-        }
+        [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupProgressUpdated:)];
         
         // If the task group is now complete, update and notify as well
         if (taskGroup.finished) {
@@ -262,15 +378,16 @@
             
             if (! taskGroup.cancelled) {
                 HLSLoggerDebug(@"Task group %@ ends successfully", taskGroup);
-                if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasBeenProcessed:)]) {
-                    [taskGroupDelegate taskGroupHasBeenProcessed:taskGroup];
+                
+                // Nothing to resume anymore. Keep the journal if some tasks failed, so that only those are processed again
+                if ([taskGroup nbrFailures] == 0) {
+                    [taskGroup.journal clear];
                 }
+                [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenProcessed:)];
             }
             else {
                 HLSLoggerDebug(@"Task group %@ has been cancelled", taskGroup);
-                if ([taskGroupDelegate respondsToSelector:@selector(taskGroupHasBeenCancelled:)]) {
-                    [taskGroupDelegate taskGroupHasBeenCancelled:taskGroup];
-                }
+                [self.taskManager notifyDelegateOfTaskGroup:taskGroup withSelector:@selector(taskGroupHasBeenCancelled:)];
             }
         }
     }
@@ -280,6 +397,50 @@
     [self.taskManager unregisterOperation:self];
 }
 
+- (void)notifyStartForTask:(HLSTask *)task
+{
+    task.running = YES;
+    [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskHasStartedProcessing:)];
+    task.progress = 0.f;
+    [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskProgressUpdated:)];
+}
+
+- (void)notifyProgress:(float)progress forTask:(HLSTask *)task
+{
+    task.progress = progress;
+    [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskProgressUpdated:)];
+}
+
+- (void)notifyEndForTask:(HLSTask *)task
+{
+    // Update the progress to 1.f on success, else do not alter current value (so that the progress value cannot go backwards)
+    if (! task.error && ! [self isCancelled]) {
+        task.progress = 1.f;
+        [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskProgressUpdated:)];
+    }
+    task.finished = YES;
+    task.running = NO;
+    
+    // The task has been cancelled
+    if ([self isCancelled]) {
+        HLSLoggerDebug(@"Task %@ has been cancelled", task);
+        [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskHasBeenCancelled:)];
+    }
+    // The task has been processed
+    else {
+        // Successful
+        if (! task.error) {
+            HLSLoggerDebug(@"Task %@ ends successfully", task);
+        }
+        // An error has been attached during processing
+        else {
+            HLSLoggerDebug(@"Task %@ has encountered an error", task);
+        }
+        
+        [self.taskManager notifyDelegateOfTask:task withSelector:@selector(taskHasBeenProcessed:)];
+    }
+}
+
 - (void)notifySettingReturnInfo:(NSDictionary *)returnInfo
 {
     self.task.returnInfo = returnInfo;
@@ -291,3 +452,83 @@
 }
 
 @end
+
+#pragma mark -
+#pragma mark TaskOperationEvent class implementation
+
+static const NSUInteger kEventPoolCapacity = 256;
+
+static NSMutableArray *s_eventPool = nil;
+
+@implementation TaskOperationEvent
+
+#pragma mark Class methods
+
++ (void)initialize
+{
+    if (self != [TaskOperationEvent class]) {
+        return;
+    }
+    
+    s_eventPool = [[NSMutableArray alloc] initWithCapacity:kEventPoolCapacity];
+}
+
++ (TaskOperationEvent *)eventWithSelector:(SEL)selector object:(id)objectOrNil
+{
+    // Events are created on operation threads and recycled on calling threads
+    TaskOperationEvent *event = nil;
+    @synchronized(s_eventPool) {
+        event = [[[s_eventPool lastObject] retain] autorelease];
+        if (event) {
+            [s_eventPool removeLastObject];
+        }
+    }
+    
+    if (! event) {
+        return [[[TaskOperationEvent alloc] initWithSelector:selector object:objectOrNil] autorelease];
+    }
+    
+    event.selector = selector;
+    event.object = objectOrNil;
+    return event;
+}
+
++ (void)recycleEvents:(NSArray *)events
+{
+    for (TaskOperationEvent *event in events) {
+        // Outside the lock, releasing the object might trigger arbitrary code
+        event.object = nil;
+        
+        @synchronized(s_eventPool) {
+            if ([s_eventPool count] >= kEventPoolCapacity) {
+                return;
+            }
+            [s_eventPool addObject:event];
+        }
+    }
+}
+
+#pragma mark Object creation and destruction
+
+- (id)initWithSelector:(SEL)selector object:(id)objectOrNil
+{
+    if ((self = [super init])) {
+        m_selector = selector;
+        self.object = objectOrNil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.object = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize selector = m_selector;
+
+@synthesize object = m_object;
+
+@end
@@ -0,0 +1,50 @@
+//
+//  HLSTaskTagIndex.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Private class used by HLSTaskManager to find running tasks (or task groups) by tag. The index is a multimap
+ * maintained incrementally when objects are registered and unregistered, so that looking up all objects bearing 
+ * a tag is O(k), k being the number of objects found.
+ *
+ * The tag of an object is captured when it is added to the index. If the tag of an object is changed afterwards,
+ * the object can still be found using its original tag, and is correctly removed from the index. Objects are 
+ * retained by the index as long as they are registered. Identity is based on pointers.
+ *
+ * This class is not thread-safe.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSTaskTagIndex : NSObject {
+@private
+    NSMutableDictionary *m_tagToObjectsMap;             // tag -> NSMutableSet of objects
+    CFMutableDictionaryRef m_objectToTagMap;            // object -> tag (object not retained, the sets own it)
+}
+
+/**
+ * Add an object with the specified tag. Objects with a nil tag are not indexed. Adding an object already in the
+ * index first removes it
+ */
+- (void)addObject:(id)object withTag:(NSString *)tag;
+
+/**
+ * Remove an object from the index (if present)
+ */
+- (void)removeObject:(id)object;
+
+/**
+ * Return a snapshot of the objects registered with a tag (can therefore be safely enumerated while altering 
+ * the index). Returns an empty array if none
+ */
+- (NSArray *)objectsWithTag:(NSString *)tag;
+
+/**
+ * The number of indexed objects
+ */
+- (NSUInteger)count;
+
+@end
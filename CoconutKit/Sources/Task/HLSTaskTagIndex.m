@@ -0,0 +1,116 @@
+//
+//  HLSTaskTagIndex.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskTagIndex.h"
+
+// Remark: Tags were previously matched by filtering all running tasks with a predicate, i.e. a linear scan with
+//         a string comparison for each task, each time a screen cancelled its tasks by tag
+
+@implementation HLSTaskTagIndex
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        m_tagToObjectsMap = [[NSMutableDictionary alloc] init];
+        
+        // Objects are compared by pointer and not retained (the sets own them). Tags are retained since the
+        // original tag is needed for removal
+        m_objectToTagMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_tagToObjectsMap release];
+    CFRelease(m_objectToTagMap);
+    [super dealloc];
+}
+
+#pragma mark Registration
+
+- (void)addObject:(id)object withTag:(NSString *)tag
+{
+    if (! object) {
+        return;
+    }
+    
+    [self removeObject:object];
+    
+    if (! tag) {
+        return;
+    }
+    
+    // Copy the tag so that it cannot be altered behind our back if mutable
+    tag = [[tag copy] autorelease];
+    
+    NSMutableSet *objects = [m_tagToObjectsMap objectForKey:tag];
+    if (! objects) {
+        objects = [NSMutableSet set];
+        [m_tagToObjectsMap setObject:objects forKey:tag];
+    }
+    [objects addObject:object];
+    
+    CFDictionarySetValue(m_objectToTagMap, object, tag);
+}
+
+- (void)removeObject:(id)object
+{
+    if (! object) {
+        return;
+    }
+    
+    NSString *tag = (NSString *)CFDictionaryGetValue(m_objectToTagMap, object);
+    if (! tag) {
+        return;
+    }
+    
+    // Keep the object and its tag alive until we are done
+    [[object retain] autorelease];
+    [[tag retain] autorelease];
+    
+    CFDictionaryRemoveValue(m_objectToTagMap, object);
+    
+    NSMutableSet *objects = [m_tagToObjectsMap objectForKey:tag];
+    [objects removeObject:object];
+    if ([objects count] == 0) {
+        [m_tagToObjectsMap removeObjectForKey:tag];
+    }
+}
+
+#pragma mark Lookup
+
+- (NSArray *)objectsWithTag:(NSString *)tag
+{
+    if (! tag) {
+        return [NSArray array];
+    }
+    
+    NSSet *objects = [m_tagToObjectsMap objectForKey:tag];
+    return objects ? [objects allObjects] : [NSArray array];
+}
+
+- (NSUInteger)count
+{
+    return CFDictionaryGetCount(m_objectToTagMap);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %d; tagCount: %d>",
+            [self class],
+            self,
+            [self count],
+            [m_tagToObjectsMap count]];
+}
+
+@end
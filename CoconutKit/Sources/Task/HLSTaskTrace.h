@@ -0,0 +1,84 @@
+//
+//  HLSTaskTrace.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+// Forward declarations
+@class HLSTask;
+
+/**
+ * Events recorded during the life of a task
+ */
+typedef enum {
+    HLSTaskTraceEventTypeEnumBegin = 0,
+    // Values
+    HLSTaskTraceEventTypeSubmitted = HLSTaskTraceEventTypeEnumBegin,        // The task has been submitted to the manager
+    HLSTaskTraceEventTypeDequeued,                                          // An operation thread has picked the task
+    HLSTaskTraceEventTypeMainStarted,                                       // The operation -operationMain method starts
+    HLSTaskTraceEventTypeProgressUpdated,                                   // The operation has reported progress
+    HLSTaskTraceEventTypeMainEnded,                                         // The operation -operationMain method ends
+    HLSTaskTraceEventTypeDelegateDelivered,                                 // The end of the task has been notified to its delegate
+    // End of values
+    HLSTaskTraceEventTypeEnumEnd,
+    HLSTaskTraceEventTypeEnumSize = HLSTaskTraceEventTypeEnumEnd - HLSTaskTraceEventTypeEnumBegin
+} HLSTaskTraceEventType;
+
+/**
+ * A trace records timestamped events about the tasks processed by a task manager (see HLSTaskManager trace property),
+ * together with the thread on which they occurred and the tag of the task. This makes it possible to see how much 
+ * time tasks spend waiting in queues, executing, and waiting for their results to be delivered to the thread which 
+ * submitted them.
+ *
+ * Events are stored in memory in a ring buffer: Once full, the oldest events are overwritten. Recording is cheap 
+ * enough for being used in production builds. A trace can be exported using the Chrome trace event format, which can
+ * be displayed with the chrome://tracing tool.
+ *
+ * This class is thread-safe.
+ *
+ * Designated initializer: -initWithCapacity:
+ */
+@interface HLSTaskTrace : NSObject {
+@private
+    void *m_events;                             // Ring buffer of events
+    NSUInteger m_capacity;
+    NSUInteger m_count;
+    NSUInteger m_nextIndex;
+}
+
+/**
+ * Create a trace able to store the specified number of events. Calling -init creates a trace with a capacity of 
+ * 4096 events
+ */
+- (id)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ * Record an event for the specified task. The current time and thread are recorded as well. The progress value is 
+ * only meaningful for progress updates (pass 0.f otherwise)
+ */
+- (void)recordEventWithType:(HLSTaskTraceEventType)type forTask:(HLSTask *)task progress:(float)progress;
+
+/**
+ * The number of events currently stored (at most the capacity)
+ */
+- (NSUInteger)count;
+
+/**
+ * Forget all events
+ */
+- (void)clear;
+
+/**
+ * Return the events currently stored, from the oldest to the most recent one, formatted as a Chrome trace event 
+ * JSON string
+ */
+- (NSString *)chromeTraceJSONString;
+
+/**
+ * Write the Chrome trace event JSON string to a file. Return NO and fill the error if the file could not be written
+ */
+- (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError **)pError;
+
+@end
@@ -0,0 +1,234 @@
+//
+//  HLSTaskTrace.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskTrace.h"
+
+#import "HLSTask.h"
+
+#import <pthread.h>
+
+static const NSUInteger kDefaultCapacity = 4096;
+
+typedef struct {
+    HLSTaskTraceEventType type;
+    CFAbsoluteTime time;
+    NSUInteger threadId;
+    BOOL mainThread;
+    const void *task;                   // identifies the task, never dereferenced
+    NSString *tag;                      // retained
+    float progress;
+} HLSTaskTraceEvent;
+
+static NSString *HLSTaskTraceJSONEscapedString(NSString *string);
+
+@interface HLSTaskTrace ()
+
+- (void)appendEvent:(const HLSTaskTraceEvent *)event toJSONString:(NSMutableString *)jsonString;
+
+@end
+
+@implementation HLSTaskTrace
+
+#pragma mark Object creation and destruction
+
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+    if ((self = [super init])) {
+        if (capacity == 0) {
+            [self release];
+            return nil;
+        }
+        
+        m_capacity = capacity;
+        m_events = calloc(capacity, sizeof(HLSTaskTraceEvent));
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithCapacity:kDefaultCapacity];
+}
+
+- (void)dealloc
+{
+    [self clear];
+    free(m_events);
+    [super dealloc];
+}
+
+#pragma mark Recording
+
+- (void)recordEventWithType:(HLSTaskTraceEventType)type forTask:(HLSTask *)task progress:(float)progress
+{
+    // Gather everything outside the lock
+    HLSTaskTraceEvent event;
+    event.type = type;
+    event.time = CFAbsoluteTimeGetCurrent();
+    event.threadId = pthread_mach_thread_np(pthread_self());
+    event.mainThread = [NSThread isMainThread];
+    event.task = task;
+    event.tag = [task.tag retain];
+    event.progress = progress;
+    
+    NSString *overwrittenTag = nil;
+    @synchronized(self) {
+        HLSTaskTraceEvent *slot = (HLSTaskTraceEvent *)m_events + m_nextIndex;
+        overwrittenTag = (m_count == m_capacity) ? slot->tag : nil;
+        *slot = event;
+        m_nextIndex = (m_nextIndex + 1) % m_capacity;
+        m_count = MIN(m_count + 1, m_capacity);
+    }
+    [overwrittenTag release];
+}
+
+- (NSUInteger)count
+{
+    @synchronized(self) {
+        return m_count;
+    }
+}
+
+- (void)clear
+{
+    @synchronized(self) {
+        NSUInteger firstIndex = (m_nextIndex + m_capacity - m_count) % m_capacity;
+        for (NSUInteger i = 0; i < m_count; ++i) {
+            HLSTaskTraceEvent *event = (HLSTaskTraceEvent *)m_events + (firstIndex + i) % m_capacity;
+            [event->tag release];
+            event->tag = nil;
+        }
+        m_count = 0;
+        m_nextIndex = 0;
+    }
+}
+
+#pragma mark Export
+
+// Remark: NSJSONSerialization is not available on iOS 4, and the format is simple enough to be written by hand.
+//         Each task is displayed as:
+//           - an asynchronous 'queued' slice, from submission to dequeuing
+//           - a 'main' slice, on the operation thread
+//           - an asynchronous 'delivery' slice, from the end of -operationMain to the delegate notification
+//           - instant events for progress updates
+- (NSString *)chromeTraceJSONString
+{
+    NSMutableString *jsonString = [NSMutableString stringWithString:@"{\"traceEvents\":["];
+    @synchronized(self) {
+        NSUInteger firstIndex = (m_nextIndex + m_capacity - m_count) % m_capacity;
+        for (NSUInteger i = 0; i < m_count; ++i) {
+            if (i != 0) {
+                [jsonString appendString:@","];
+            }
+            
+            const HLSTaskTraceEvent *event = (HLSTaskTraceEvent *)m_events + (firstIndex + i) % m_capacity;
+            [self appendEvent:event toJSONString:jsonString];
+        }
+    }
+    [jsonString appendString:@"],\"displayTimeUnit\":\"ms\"}"];
+    return [NSString stringWithString:jsonString];
+}
+
+- (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError **)pError
+{
+    return [[self chromeTraceJSONString] writeToFile:filePath atomically:YES encoding:NSUTF8StringEncoding error:pError];
+}
+
+- (void)appendEvent:(const HLSTaskTraceEvent *)event toJSONString:(NSMutableString *)jsonString
+{
+    static NSString * const kNames[HLSTaskTraceEventTypeEnumSize] = { @"queued", @"queued", @"main", @"progress", @"main", @"delivery" };
+    
+    NSString *phase = nil;
+    switch (event->type) {
+        case HLSTaskTraceEventTypeSubmitted: {
+            phase = @"b";
+            break;
+        }
+            
+        case HLSTaskTraceEventTypeDequeued: {
+            phase = @"e";
+            break;
+        }
+            
+        case HLSTaskTraceEventTypeMainStarted: {
+            phase = @"B";
+            break;
+        }
+            
+        case HLSTaskTraceEventTypeProgressUpdated: {
+            phase = @"i";
+            break;
+        }
+            
+        case HLSTaskTraceEventTypeMainEnded: {
+            // Ends the main slice, and begins the delivery slice (see below)
+            phase = @"E";
+            break;
+        }
+            
+        case HLSTaskTraceEventTypeDelegateDelivered: {
+            phase = @"e";
+            break;
+        }
+            
+        default: {
+            return;
+            break;
+        }
+    }
+    
+    // Times are in microseconds
+    unsigned long long timestamp = (unsigned long long)((event->time + kCFAbsoluteTimeIntervalSince1970) * 1e6);
+    NSString *tag = event->tag ? HLSTaskTraceJSONEscapedString(event->tag) : @"";
+    NSString *thread = event->mainThread ? @"main" : @"operation";
+    
+    [jsonString appendFormat:@"{\"name\":\"%@\",\"cat\":\"task\",\"ph\":\"%@\",\"ts\":%llu,\"pid\":1,\"tid\":%u,\"id\":\"%p\","
+        "\"args\":{\"tag\":\"%@\",\"thread\":\"%@\",\"progress\":%.3f}%@}",
+        kNames[event->type], phase, timestamp, (unsigned int)event->threadId, event->task, tag, thread, event->progress,
+        [phase isEqualToString:@"i"] ? @",\"s\":\"t\"" : @""];
+    
+    if (event->type == HLSTaskTraceEventTypeMainEnded) {
+        [jsonString appendFormat:@",{\"name\":\"delivery\",\"cat\":\"task\",\"ph\":\"b\",\"ts\":%llu,\"pid\":1,\"tid\":%u,\"id\":\"%p\","
+            "\"args\":{\"tag\":\"%@\"}}",
+            timestamp, (unsigned int)event->threadId, event->task, tag];
+    }
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSString *HLSTaskTraceJSONEscapedString(NSString *string)
+{
+    NSMutableString *escapedString = [NSMutableString stringWithCapacity:[string length]];
+    for (NSUInteger i = 0; i < [string length]; ++i) {
+        unichar character = [string characterAtIndex:i];
+        switch (character) {
+            case '"': {
+                [escapedString appendString:@"\\\""];
+                break;
+            }
+                
+            case '\\': {
+                [escapedString appendString:@"\\\\"];
+                break;
+            }
+                
+            default: {
+                if (character < 0x20) {
+                    [escapedString appendFormat:@"\\u%04x", character];
+                }
+                else {
+                    [escapedString appendFormat:@"%C", character];
+                }
+                break;
+            }
+        }
+    }
+    return escapedString;
+}
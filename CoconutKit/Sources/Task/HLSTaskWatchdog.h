@@ -0,0 +1,75 @@
+//
+//  HLSTaskWatchdog.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * A watchdog measures how long the delegate callbacks of a task manager take (see HLSTaskManager watchdog property). 
+ * Delegates are notified on the thread which submitted the tasks, and operations cannot deliver any status change
+ * while a callback is running. A slow callback therefore throttles all operations of the manager.
+ *
+ * Callbacks lasting longer than the threshold are logged (as warnings), naming the delegate class and the selector
+ * which was called. Counters are kept for each delegate class and selector pair, so that the callbacks which are too 
+ * slow can be found at runtime. Callbacks delivered on a dispatch queue (see HLSTaskManager -registerDelegate:forTask:queue:)
+ * do not block the calling thread and are not measured.
+ *
+ * This class is thread-safe.
+ *
+ * Designated initializer: -initWithThreshold:
+ */
+@interface HLSTaskWatchdog : NSObject {
+@private
+    NSTimeInterval _threshold;
+    NSUInteger _nbrCallbacks;
+    NSUInteger _nbrStalls;
+    NSMutableDictionary *_callbackToStallCountMap;
+    NSMutableDictionary *_callbackToMaxDurationMap;
+}
+
+/**
+ * Create a watchdog logging callbacks lasting longer than the specified number of seconds (which must be > 0). Calling
+ * -init creates a watchdog with a threshold of 50 ms
+ */
+- (id)initWithThreshold:(NSTimeInterval)threshold;
+
+/**
+ * The threshold above which a callback is considered to stall the calling thread
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval threshold;
+
+/**
+ * Record the duration of a callback received by a delegate
+ */
+- (void)recordCallbackOfDelegate:(id)delegate withSelector:(SEL)selector duration:(NSTimeInterval)duration;
+
+/**
+ * The number of callbacks measured so far
+ */
+- (NSUInteger)nbrCallbacks;
+
+/**
+ * The number of callbacks measured so far which lasted longer than the threshold
+ */
+- (NSUInteger)nbrStalls;
+
+/**
+ * Return the number of stalls for each callback which stalled at least once. Keys are strings of the form 
+ * -[DelegateClass selector], values are NSNumber objects
+ */
+- (NSDictionary *)stallCounts;
+
+/**
+ * Return the longest duration measured for each callback which stalled at least once (same keys as -stallCounts,
+ * values are the NSNumber number of seconds)
+ */
+- (NSDictionary *)maxDurations;
+
+/**
+ * Reset all counters
+ */
+- (void)reset;
+
+@end
@@ -0,0 +1,145 @@
+//
+//  HLSTaskWatchdog.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTaskWatchdog.h"
+
+#import "HLSLogger.h"
+
+static const NSTimeInterval kDefaultThreshold = 0.05;
+
+@interface HLSTaskWatchdog ()
+
+@property (nonatomic, assign) NSTimeInterval threshold;
+@property (nonatomic, retain) NSMutableDictionary *callbackToStallCountMap;
+@property (nonatomic, retain) NSMutableDictionary *callbackToMaxDurationMap;
+
+@end
+
+@implementation HLSTaskWatchdog
+
+#pragma mark Object creation and destruction
+
+- (id)initWithThreshold:(NSTimeInterval)threshold
+{
+    if ((self = [super init])) {
+        if (threshold <= 0.) {
+            HLSLoggerError(@"The threshold must be > 0");
+            [self release];
+            return nil;
+        }
+        
+        self.threshold = threshold;
+        self.callbackToStallCountMap = [NSMutableDictionary dictionary];
+        self.callbackToMaxDurationMap = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (id)init
+{
+    return [self initWithThreshold:kDefaultThreshold];
+}
+
+- (void)dealloc
+{
+    self.callbackToStallCountMap = nil;
+    self.callbackToMaxDurationMap = nil;
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize threshold = _threshold;
+
+@synthesize callbackToStallCountMap = _callbackToStallCountMap;
+
+@synthesize callbackToMaxDurationMap = _callbackToMaxDurationMap;
+
+#pragma mark Recording
+
+- (void)recordCallbackOfDelegate:(id)delegate withSelector:(SEL)selector duration:(NSTimeInterval)duration
+{
+    // Fast path, nothing is allocated for callbacks which do not stall
+    if (duration <= self.threshold) {
+        @synchronized(self) {
+            ++_nbrCallbacks;
+        }
+        return;
+    }
+    
+    NSString *callback = [NSString stringWithFormat:@"-[%@ %@]", [delegate class], NSStringFromSelector(selector)];
+    HLSLoggerWarn(@"The delegate callback %@ took %.0f ms, which blocks all operations waiting to deliver their status", 
+                  callback, duration * 1000.);
+    
+    @synchronized(self) {
+        ++_nbrCallbacks;
+        ++_nbrStalls;
+        
+        NSUInteger nbrStalls = [[self.callbackToStallCountMap objectForKey:callback] unsignedIntegerValue];
+        [self.callbackToStallCountMap setObject:[NSNumber numberWithUnsignedInteger:nbrStalls + 1] forKey:callback];
+        
+        NSNumber *maxDurationNumber = [self.callbackToMaxDurationMap objectForKey:callback];
+        if (! maxDurationNumber || [maxDurationNumber doubleValue] < duration) {
+            [self.callbackToMaxDurationMap setObject:[NSNumber numberWithDouble:duration] forKey:callback];
+        }
+    }
+}
+
+#pragma mark Counters
+
+- (NSUInteger)nbrCallbacks
+{
+    @synchronized(self) {
+        return _nbrCallbacks;
+    }
+}
+
+- (NSUInteger)nbrStalls
+{
+    @synchronized(self) {
+        return _nbrStalls;
+    }
+}
+
+- (NSDictionary *)stallCounts
+{
+    @synchronized(self) {
+        return [NSDictionary dictionaryWithDictionary:self.callbackToStallCountMap];
+    }
+}
+
+- (NSDictionary *)maxDurations
+{
+    @synchronized(self) {
+        return [NSDictionary dictionaryWithDictionary:self.callbackToMaxDurationMap];
+    }
+}
+
+- (void)reset
+{
+    @synchronized(self) {
+        _nbrCallbacks = 0;
+        _nbrStalls = 0;
+        [self.callbackToStallCountMap removeAllObjects];
+        [self.callbackToMaxDurationMap removeAllObjects];
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; threshold: %.3f; nbrCallbacks: %d; nbrStalls: %d>",
+            [self class],
+            self,
+            self.threshold,
+            [self nbrCallbacks],
+            [self nbrStalls]];
+}
+
+@end
@@ -11,6 +11,8 @@
 #import "HLSAssert.h"
 #import "HLSLogger.h"
 #import "NSObject+HLSExtensions.h"
+#import "UIBarButtonItem+HLSActionSheet.h"
+#import "UINavigationController+HLSActionSheet.h"
 
 // Only one action sheet can be opened and one dismissed at any time. More would be possible programmatically, but incorrect. These special cases are 
 // ignored for simplicity, they should never occur in practice
@@ -50,6 +52,10 @@ static HLSActionSheet *s_previousActionSheet = nil;                 // weak ref
     }
     
     NSAssert([self implementsProtocol:@protocol(UIActionSheetDelegate)], @"Incomplete implementation");
+    
+    // Only needed when an action sheet is displayed, and therefore not set up at load time
+    [UIBarButtonItem injectActionSheetDismissal];
+    [UINavigationController injectActionSheetDismissal];
 }
 
 #pragma mark Managing the current action sheet
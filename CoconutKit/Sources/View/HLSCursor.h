@@ -35,12 +35,22 @@
  *   - custom: Each element is a view and can be customized using Interface Builder
  * Cursors using both ways of customisation can coexist in the same source file.
  *
+ * Element views are recycled when the cursor is reloaded, much like UITableView cells: Labels created for title-based
+ * elements are reused automatically, while custom views can be recycled by calling -dequeueReusableElementViewOfClass:
+ * from your -cursor:viewAtIndex:selected: implementation. Only as many views as needed to display all elements are
+ * kept for reuse. If only some elements change, call -reloadElementsAtIndexes: instead of -reloadData so that the
+ * other elements are neither recreated nor laid out again. The sizes of titles are cached for each font until the data
+ * source is changed.
+ *
  * Designated initializer: -initWithFrame:
  */
 @interface HLSCursor : UIView <HLSAnimationDelegate> {
 @private
-    NSArray *m_elementWrapperViews;
-    NSArray *m_elementWrapperViewSizeValues;
+    NSMutableArray *m_elementWrapperViews;
+    NSMutableArray *m_elementWrapperViewSizeValues;
+    NSMutableArray *m_reusableElementWrapperViews;
+    NSMutableArray *m_reusableElementViews;
+    NSMutableDictionary *m_titleSizeCache;
     UIView *m_pointerView;
     UIView *m_pointerContainerView;
     CGSize m_pointerViewTopLeftOffset;
@@ -54,10 +64,29 @@
     BOOL m_holding;
     BOOL m_creatingViews;
     BOOL m_viewsCreated;
+    BOOL m_elementFramesValid;
+    CGSize m_elementFramesSize;
     NSUInteger m_initialIndex;
     CGFloat m_spacing;
     id<HLSCursorDataSource> m_dataSource;
+    struct {
+        unsigned int view:1;
+        unsigned int title:1;
+        unsigned int font:1;
+        unsigned int textColor:1;
+        unsigned int shadowColor:1;
+        unsigned int shadowOffset:1;
+    } m_dataSourceFlags;                        // optional data source methods implemented (set with the data source)
     id<HLSCursorDelegate> m_delegate;
+    struct {
+        unsigned int didTouchDown:1;
+        unsigned int didMoveFrom:1;
+        unsigned int didMoveTo:1;
+        unsigned int didStartDragging:1;
+        unsigned int didDrag:1;
+        unsigned int didStopDragging:1;
+        unsigned int didTouchUp:1;
+    } m_delegateFlags;                          // optional delegate methods implemented (set with the delegate)
 }
 
 /**
@@ -104,6 +133,21 @@
  */
 - (void)reloadData;
 
+/**
+ * Reload the elements at the given indexes from the data source, leaving the other elements untouched. The number
+ * of elements returned by the data source must not have changed, otherwise the whole cursor is reloaded. The pointer
+ * is left at the same index where it was
+ */
+- (void)reloadElementsAtIndexes:(NSIndexSet *)indexes;
+
+/**
+ * Return an element view of the given class which has been removed from the cursor during a previous reload, or nil
+ * if none is available. Call this method from -cursor:viewAtIndex:selected: to avoid instantiating custom element 
+ * views each time the cursor is reloaded. The view returned is autoreleased, visible and has no superview; you are 
+ * responsible of setting all its properties again
+ */
+- (id)dequeueReusableElementViewOfClass:(Class)elementViewClass;
+
 /**
  * Set / get the data source used to fill the cursor with elements
  */
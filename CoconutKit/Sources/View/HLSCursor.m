@@ -20,13 +20,21 @@
 
 - (void)hlsCursorInit;
 
-@property (nonatomic, retain) NSArray *elementWrapperViews;
-@property (nonatomic, retain) NSArray *elementWrapperViewSizeValues;
+@property (nonatomic, retain) NSMutableArray *elementWrapperViews;
+@property (nonatomic, retain) NSMutableArray *elementWrapperViewSizeValues;
+@property (nonatomic, retain) NSMutableArray *reusableElementWrapperViews;
+@property (nonatomic, retain) NSMutableArray *reusableElementViews;
+@property (nonatomic, retain) NSMutableDictionary *titleSizeCache;
 
 @property (nonatomic, retain) UIView *pointerContainerView;
 
 - (UIView *)elementViewForIndex:(NSUInteger)index selected:(BOOL)selected;
+- (CGSize)sizeForTitle:(NSString *)title withFont:(UIFont *)font;
 - (UIView *)elementWrapperViewForIndex:(NSUInteger)index;
+- (void)enqueueReusableElementWrapperView:(UIView *)elementWrapperView;
+- (void)trimReusableViews;
+
+- (void)layoutElementWrapperViews;
 
 - (CGFloat)xPosForIndex:(NSUInteger)index;
 - (NSUInteger)indexForXPos:(CGFloat)xPos;
@@ -64,6 +72,9 @@
 {
     self.elementWrapperViews = nil;
     self.elementWrapperViewSizeValues = nil;
+    self.reusableElementWrapperViews = nil;
+    self.reusableElementViews = nil;
+    self.titleSizeCache = nil;
     
     // Very special case here. Cannot use the property since it cannot change the pointer view once set!
     [m_pointerView release];
@@ -79,6 +90,9 @@
     self.pointerViewTopLeftOffset = CGSizeMake(-10.f, -10.f);
     self.pointerViewBottomRightOffset = CGSizeMake(10.f, 10.f);
     self.animationDuration = 0.2;
+    self.reusableElementWrapperViews = [NSMutableArray array];
+    self.reusableElementViews = [NSMutableArray array];
+    self.titleSizeCache = [NSMutableDictionary dictionary];
 }
 
 #pragma mark Accessors and mutators
@@ -87,6 +101,12 @@
 
 @synthesize elementWrapperViewSizeValues = m_elementWrapperViewSizeValues;
 
+@synthesize reusableElementWrapperViews = m_reusableElementWrapperViews;
+
+@synthesize reusableElementViews = m_reusableElementViews;
+
+@synthesize titleSizeCache = m_titleSizeCache;
+
 @synthesize pointerContainerView = m_pointerContainerView;
 
 @synthesize pointerView = m_pointerView;
@@ -105,12 +125,62 @@
 
 @synthesize pointerViewTopLeftOffset = m_pointerViewTopLeftOffset;
 
+- (void)setPointerViewTopLeftOffset:(CGSize)pointerViewTopLeftOffset
+{
+    m_pointerViewTopLeftOffset = pointerViewTopLeftOffset;
+    
+    m_elementFramesValid = NO;
+    [self setNeedsLayout];
+}
+
 @synthesize pointerViewBottomRightOffset = m_pointerViewBottomRightOffset;
 
+- (void)setPointerViewBottomRightOffset:(CGSize)pointerViewBottomRightOffset
+{
+    m_pointerViewBottomRightOffset = pointerViewBottomRightOffset;
+    
+    m_elementFramesValid = NO;
+    [self setNeedsLayout];
+}
+
 @synthesize dataSource = m_dataSource;
 
+- (void)setDataSource:(id<HLSCursorDataSource>)dataSource
+{
+    if (dataSource == m_dataSource) {
+        return;
+    }
+    
+    m_dataSource = dataSource;
+    
+    // Optional methods are looked up once, not each time an element is created
+    m_dataSourceFlags.view = [dataSource respondsToSelector:@selector(cursor:viewAtIndex:selected:)];
+    m_dataSourceFlags.title = [dataSource respondsToSelector:@selector(cursor:titleAtIndex:)];
+    m_dataSourceFlags.font = [dataSource respondsToSelector:@selector(cursor:fontAtIndex:selected:)];
+    m_dataSourceFlags.textColor = [dataSource respondsToSelector:@selector(cursor:textColorAtIndex:selected:)];
+    m_dataSourceFlags.shadowColor = [dataSource respondsToSelector:@selector(cursor:shadowColorAtIndex:selected:)];
+    m_dataSourceFlags.shadowOffset = [dataSource respondsToSelector:@selector(cursor:shadowOffsetAtIndex:selected:)];
+    
+    // Titles and fonts are likely to be different
+    [self.titleSizeCache removeAllObjects];
+}
+
 @synthesize delegate = m_delegate;
 
+- (void)setDelegate:(id<HLSCursorDelegate>)delegate
+{
+    m_delegate = delegate;
+    
+    // Optional methods are looked up once, not each time the pointer moves
+    m_delegateFlags.didTouchDown = [delegate respondsToSelector:@selector(cursor:didTouchDownNearIndex:)];
+    m_delegateFlags.didMoveFrom = [delegate respondsToSelector:@selector(cursor:didMoveFromIndex:)];
+    m_delegateFlags.didMoveTo = [delegate respondsToSelector:@selector(cursor:didMoveToIndex:)];
+    m_delegateFlags.didStartDragging = [delegate respondsToSelector:@selector(cursorDidStartDragging:nearIndex:)];
+    m_delegateFlags.didDrag = [delegate respondsToSelector:@selector(cursor:didDragNearIndex:)];
+    m_delegateFlags.didStopDragging = [delegate respondsToSelector:@selector(cursorDidStopDragging:nearIndex:)];
+    m_delegateFlags.didTouchUp = [delegate respondsToSelector:@selector(cursor:didTouchUpNearIndex:)];
+}
+
 #pragma mark Layout
 
 - (void)layoutSubviews
@@ -119,8 +189,8 @@
     // the views before they are displayed
     if (! m_viewsCreated) {
         // Create the subview set
-        self.elementWrapperViews = [NSArray array];
-        self.elementWrapperViewSizeValues = [NSArray array];
+        self.elementWrapperViews = [NSMutableArray array];
+        self.elementWrapperViewSizeValues = [NSMutableArray array];
         
         // Check the data source
         NSUInteger nbrElements = [self.dataSource numberOfElementsForCursor:self];
@@ -133,13 +203,65 @@
         for (NSInteger index = 0; index < nbrElements; ++index) {
             UIView *elementWrapperView = [self elementWrapperViewForIndex:index];
             [self addSubview:elementWrapperView];
-            self.elementWrapperViews = [self.elementWrapperViews arrayByAddingObject:elementWrapperView];
+            [self.elementWrapperViews addObject:elementWrapperView];
             
             // The original size needs to be saved separately (since views are not created again)
-            self.elementWrapperViewSizeValues = [self.elementWrapperViewSizeValues arrayByAddingObject:[NSValue valueWithCGSize:elementWrapperView.frame.size]];
+            [self.elementWrapperViewSizeValues addObject:[NSValue valueWithCGSize:elementWrapperView.frame.size]];
         }
+        
+        // Views left over from a previous larger set of elements are not needed anymore
+        [self trimReusableViews];
+        
+        m_elementFramesValid = NO;
+    }
+    
+    // Element frames only need to be calculated again when elements have been reloaded or when the size of the cursor
+    // has changed
+    if (! m_elementFramesValid || ! CGSizeEqualToSize(self.bounds.size, m_elementFramesSize)) {
+        [self layoutElementWrapperViews];
     }
     
+    if (! m_viewsCreated) {
+        // If no custom pointer view specified, create a default one
+        if (! self.pointerView) {
+            UIImage *pointerImage = [UIImage imageNamed:@"CoconutKit-resources.bundle/CursorDefaultPointer.png"];
+            UIImageView *imageView = [[[UIImageView alloc] initWithImage:pointerImage] autorelease];
+            imageView.contentStretch = CGRectMake(0.5f,
+                                                  0.5f,
+                                                  1.f / CGRectGetWidth(imageView.frame),
+                                                  1.f / CGRectGetHeight(imageView.frame));
+            self.pointerView = imageView;
+        }
+        
+        if (m_initialIndex >= [self.elementWrapperViews count]) {
+            m_initialIndex = 0;
+            HLSLoggerWarn(@"Initial index too large; fixed");
+        }
+        
+        // Create a view to container the pointer view. This avoid issues with transparent pointer views
+        self.pointerContainerView = [[[UIView alloc] initWithFrame:self.pointerView.bounds] autorelease];
+        self.pointerView.frame = self.pointerContainerView.bounds;
+        self.pointerContainerView.backgroundColor = [UIColor clearColor];
+        self.pointerContainerView.autoresizesSubviews = YES;
+        self.pointerContainerView.exclusiveTouch = YES;
+        
+        self.pointerView.autoresizingMask = HLSViewAutoresizingAll;
+        [self.pointerContainerView addSubview:self.pointerView];
+        [self addSubview:self.pointerContainerView];
+        
+        m_creatingViews = YES;
+        
+        [self setSelectedIndex:m_initialIndex animated:NO];
+        
+        m_viewsCreated = YES;
+    }
+    else if (! m_dragging && ! m_moving) {
+        self.pointerContainerView.frame = [self pointerFrameForIndex:m_selectedIndex];
+    }
+}
+
+- (void)layoutElementWrapperViews
+{
     // Calculate the needed total size to display all elements
     CGFloat requiredWidth = floatmax(-self.pointerViewTopLeftOffset.width, 0.f) + floatmax(self.pointerViewBottomRightOffset.width, 0.f);
     CGFloat requiredHeight = 0.f;
@@ -186,49 +308,14 @@
         ++i;
     }
     
-    if (! m_viewsCreated) {
-        // If no custom pointer view specified, create a default one
-        if (! self.pointerView) {
-            UIImage *pointerImage = [UIImage imageNamed:@"CoconutKit-resources.bundle/CursorDefaultPointer.png"];
-            UIImageView *imageView = [[[UIImageView alloc] initWithImage:pointerImage] autorelease];
-            imageView.contentStretch = CGRectMake(0.5f,
-                                                  0.5f,
-                                                  1.f / CGRectGetWidth(imageView.frame),
-                                                  1.f / CGRectGetHeight(imageView.frame));
-            self.pointerView = imageView;
-        }
-        
-        if (m_initialIndex >= [self.elementWrapperViews count]) {
-            m_initialIndex = 0;
-            HLSLoggerWarn(@"Initial index too large; fixed");
-        }
-        
-        // Create a view to container the pointer view. This avoid issues with transparent pointer views
-        self.pointerContainerView = [[[UIView alloc] initWithFrame:self.pointerView.bounds] autorelease];
-        self.pointerView.frame = self.pointerContainerView.bounds;
-        self.pointerContainerView.backgroundColor = [UIColor clearColor];
-        self.pointerContainerView.autoresizesSubviews = YES;
-        self.pointerContainerView.exclusiveTouch = YES;
-        
-        self.pointerView.autoresizingMask = HLSViewAutoresizingAll;
-        [self.pointerContainerView addSubview:self.pointerView];
-        [self addSubview:self.pointerContainerView];
-        
-        m_creatingViews = YES;
-        
-        [self setSelectedIndex:m_initialIndex animated:NO];
-        
-        m_viewsCreated = YES;
-    }
-    else if (! m_dragging && ! m_moving) {
-        self.pointerContainerView.frame = [self pointerFrameForIndex:m_selectedIndex];
-    }
+    m_elementFramesSize = self.bounds.size;
+    m_elementFramesValid = YES;
 }
 
 - (UIView *)elementViewForIndex:(NSUInteger)index selected:(BOOL)selected
 {
     // First check if a custom view is used
-    if ([self.dataSource respondsToSelector:@selector(cursor:viewAtIndex:selected:)]) {
+    if (m_dataSourceFlags.view) {
         // The size must accomodate both the selected and non-selected versions of an element view (i.e. be the largest).
         // To avoid changing the frame of the views we receive, we simply find the rectangle in which both versions fit,
         // then we create a view with this size and we put the view we receive at its center.
@@ -239,7 +326,7 @@
     }
     
     // Check if a bare label is used
-    if ([self.dataSource respondsToSelector:@selector(cursor:titleAtIndex:)]) {
+    if (m_dataSourceFlags.title) {
         // Title
         NSString *title = [self.dataSource cursor:self titleAtIndex:index];
         if ([title length] == 0) {
@@ -249,7 +336,7 @@
         // Font. If not defined by the data source, use standard font
         UIFont *font = nil;
         UIFont *otherFont = nil;
-        if ([self.dataSource respondsToSelector:@selector(cursor:fontAtIndex:selected:)]) {
+        if (m_dataSourceFlags.font) {
             font = [self.dataSource cursor:self fontAtIndex:index selected:selected];
             otherFont = [self.dataSource cursor:self fontAtIndex:index selected:! selected];
         }
@@ -259,7 +346,7 @@
         
         // Text color. If not defined by the data source, use standard colors
         UIColor *textColor = nil;
-        if ([self.dataSource respondsToSelector:@selector(cursor:textColorAtIndex:selected:)]) {
+        if (m_dataSourceFlags.textColor) {
             textColor = [self.dataSource cursor:self textColorAtIndex:index selected:selected];
         }
         if (! textColor) {
@@ -268,25 +355,33 @@
         
         // Shadow color. If not defined by the data source, none
         UIColor *shadowColor = nil;
-        if ([self.dataSource respondsToSelector:@selector(cursor:shadowColorAtIndex:selected:)]) {
+        if (m_dataSourceFlags.shadowColor) {
             shadowColor = [self.dataSource cursor:self shadowColorAtIndex:index selected:selected];
         }
         
         // Shadow offset. If not defined, default value (CGSizeMake(0, -1), see UILabel documentation)
         CGSize shadowOffset = kCursorShadowOffsetDefault;
-        if ([self.dataSource respondsToSelector:@selector(cursor:shadowOffsetAtIndex:selected:)]) {
+        if (m_dataSourceFlags.shadowOffset) {
             shadowOffset = [self.dataSource cursor:self shadowOffsetAtIndex:index selected:selected];
         }
         
         // Create a label with appropriate size. The size must accomodate both the font sizes for selected and non-selected
         // states
-        CGSize titleSize = [title sizeWithFont:font];
-        CGSize otherTitleSize = [title sizeWithFont:otherFont];
-        UILabel *elementLabel = [[[UILabel alloc] initWithFrame:CGRectMake(0.f,
-                                                                           0.f,
-                                                                           floatmax(titleSize.width, otherTitleSize.width),
-                                                                           floatmax(titleSize.height, otherTitleSize.height))]
-                                 autorelease];
+        CGSize titleSize = [self sizeForTitle:title withFont:font];
+        CGSize otherTitleSize = [self sizeForTitle:title withFont:otherFont];
+        CGRect elementLabelFrame = CGRectMake(0.f,
+                                              0.f,
+                                              floatmax(titleSize.width, otherTitleSize.width),
+                                              floatmax(titleSize.height, otherTitleSize.height));
+        
+        // Recycle a label if possible
+        UILabel *elementLabel = [self dequeueReusableElementViewOfClass:[UILabel class]];
+        if (elementLabel) {
+            elementLabel.frame = elementLabelFrame;
+        }
+        else {
+            elementLabel = [[[UILabel alloc] initWithFrame:elementLabelFrame] autorelease];
+        }
         elementLabel.text = title;
         elementLabel.backgroundColor = [UIColor clearColor];
         elementLabel.font = font;
@@ -304,6 +399,28 @@
     return nil;
 }
 
+// Text measurement is expensive. Sizes are cached per font and title until the data source changes
+- (CGSize)sizeForTitle:(NSString *)title withFont:(UIFont *)font
+{
+    if (! font || ! title) {
+        return CGSizeZero;
+    }
+    
+    NSString *fontKey = [NSString stringWithFormat:@"%@-%f", font.fontName, font.pointSize];
+    NSMutableDictionary *fontTitleSizeCache = [self.titleSizeCache objectForKey:fontKey];
+    if (! fontTitleSizeCache) {
+        fontTitleSizeCache = [NSMutableDictionary dictionary];
+        [self.titleSizeCache setObject:fontTitleSizeCache forKey:fontKey];
+    }
+    
+    NSValue *titleSizeValue = [fontTitleSizeCache objectForKey:title];
+    if (! titleSizeValue) {
+        titleSizeValue = [NSValue valueWithCGSize:[title sizeWithFont:font]];
+        [fontTitleSizeCache setObject:titleSizeValue forKey:title];
+    }
+    return [titleSizeValue CGSizeValue];
+}
+
 - (UIView *)elementWrapperViewForIndex:(NSUInteger)index
 {
     UIView *elementView = [self elementViewForIndex:index selected:NO];
@@ -315,11 +432,21 @@
         return nil;
     }
     
-    UIView *wrapperView = [[[UIView alloc] initWithFrame:CGRectMake(0.f,
-                                                                    0.f,
-                                                                    floatmax(CGRectGetWidth(elementView.frame), CGRectGetWidth(selectedElementView.frame)),
-                                                                    floatmax(CGRectGetHeight(elementView.frame), CGRectGetHeight(selectedElementView.frame)))] autorelease];
-    wrapperView.backgroundColor = [UIColor clearColor];
+    CGRect wrapperViewFrame = CGRectMake(0.f,
+                                         0.f,
+                                         floatmax(CGRectGetWidth(elementView.frame), CGRectGetWidth(selectedElementView.frame)),
+                                         floatmax(CGRectGetHeight(elementView.frame), CGRectGetHeight(selectedElementView.frame)));
+    
+    // Recycle a wrapper view if possible
+    UIView *wrapperView = [[[self.reusableElementWrapperViews lastObject] retain] autorelease];
+    if (wrapperView) {
+        [self.reusableElementWrapperViews removeLastObject];
+        wrapperView.frame = wrapperViewFrame;
+    }
+    else {
+        wrapperView = [[[UIView alloc] initWithFrame:wrapperViewFrame] autorelease];
+        wrapperView.backgroundColor = [UIColor clearColor];
+    }
     
     [wrapperView addSubview:elementView];
     elementView.center = wrapperView.center;
@@ -331,6 +458,45 @@
     return wrapperView;
 }
 
+- (void)enqueueReusableElementWrapperView:(UIView *)elementWrapperView
+{
+    // Element views are not necessarily recycled for the same wrapper, detach them
+    for (UIView *elementView in [NSArray arrayWithArray:elementWrapperView.subviews]) {
+        [elementView removeFromSuperview];
+        elementView.hidden = NO;
+        [self.reusableElementViews addObject:elementView];
+    }
+    
+    [elementWrapperView removeFromSuperview];
+    [self.reusableElementWrapperViews addObject:elementWrapperView];
+}
+
+- (id)dequeueReusableElementViewOfClass:(Class)elementViewClass
+{
+    // Most recently enqueued views first
+    for (UIView *elementView in [self.reusableElementViews reverseObjectEnumerator]) {
+        if ([elementView class] == elementViewClass) {
+            [[elementView retain] autorelease];
+            [self.reusableElementViews removeObjectIdenticalTo:elementView];
+            return elementView;
+        }
+    }
+    return nil;
+}
+
+// Keep at most as many views as needed to display all elements again (a normal and a selected view per element), 
+// discarding the least recently enqueued ones first
+- (void)trimReusableViews
+{
+    NSUInteger nbrElements = [self.elementWrapperViews count];
+    if ([self.reusableElementWrapperViews count] > nbrElements) {
+        [self.reusableElementWrapperViews removeObjectsInRange:NSMakeRange(0, [self.reusableElementWrapperViews count] - nbrElements)];
+    }
+    if ([self.reusableElementViews count] > 2 * nbrElements) {
+        [self.reusableElementViews removeObjectsInRange:NSMakeRange(0, [self.reusableElementViews count] - 2 * nbrElements)];
+    }
+}
+
 #pragma mark Pointer management
 
 - (NSUInteger)selectedIndex
@@ -483,11 +649,63 @@
     [self setNeedsLayout];
 }
 
+- (void)reloadElementsAtIndexes:(NSIndexSet *)indexes
+{
+    // Nothing to do if the views have not been created yet. They will be created from the data source when needed
+    if (! m_viewsCreated) {
+        return;
+    }
+    
+    if ([self.dataSource numberOfElementsForCursor:self] != [self.elementWrapperViews count]) {
+        HLSLoggerWarn(@"The number of elements has changed. The whole cursor will be reloaded");
+        [self reloadData];
+        return;
+    }
+    
+    NSUInteger index = [indexes firstIndex];
+    while (index != NSNotFound) {
+        if (index >= [self.elementWrapperViews count]) {
+            HLSLoggerWarn(@"Index %d is outside range; ignored", index);
+            break;
+        }
+        
+        // Recycle the current views first so that they can be used for the new element
+        [self enqueueReusableElementWrapperView:[self.elementWrapperViews objectAtIndex:index]];
+        
+        UIView *elementWrapperView = [self elementWrapperViewForIndex:index];
+        if (! elementWrapperView) {
+            // Incorrect data source implementation; errors have already been logged. The previous views have already
+            // been recycled, forget about them and reload everything
+            [self.elementWrapperViews removeObjectAtIndex:index];
+            [self.elementWrapperViewSizeValues removeObjectAtIndex:index];
+            [self reloadData];
+            return;
+        }
+        
+        // Keep the pointer above all elements
+        [self insertSubview:elementWrapperView belowSubview:self.pointerContainerView];
+        [self.elementWrapperViews replaceObjectAtIndex:index withObject:elementWrapperView];
+        [self.elementWrapperViewSizeValues replaceObjectAtIndex:index withObject:[NSValue valueWithCGSize:elementWrapperView.frame.size]];
+        
+        // The selected element is displayed as such, except when the pointer has left it
+        BOOL selected = (index == m_selectedIndex && ! m_moving && ! m_dragging);
+        [self showElementViewAtIndex:index selected:selected];
+        
+        index = [indexes indexGreaterThanIndex:index];
+    }
+    
+    [self trimReusableViews];
+    
+    // The sizes of the reloaded elements might have changed
+    m_elementFramesValid = NO;
+    [self setNeedsLayout];
+}
+
 - (void)clear
 {
-    // Clear all views
+    // Recycle all views
     for (UIView *view in self.elementWrapperViews) {
-        [view removeFromSuperview];
+        [self enqueueReusableElementWrapperView:view];
     }
     self.elementWrapperViews = nil;
     self.elementWrapperViewSizeValues = nil;
@@ -508,7 +726,7 @@
     CGPoint point = [[touches anyObject] locationInView:self];
     NSUInteger index = [self indexForXPos:point.x];
     
-    if ([self.delegate respondsToSelector:@selector(cursor:didTouchDownNearIndex:)]) {
+    if (m_delegateFlags.didTouchDown) {
         [self.delegate cursor:self didTouchDownNearIndex:index];
     }
     
@@ -537,12 +755,12 @@
             [self showElementViewAtIndex:m_selectedIndex selected:NO];
             
             if (! m_moved) {
-                if ([self.delegate respondsToSelector:@selector(cursor:didMoveFromIndex:)]) {
+                if (m_delegateFlags.didMoveFrom) {
                     [self.delegate cursor:self didMoveFromIndex:m_selectedIndex];
                 }                
             }
             
-            if ([self.delegate respondsToSelector:@selector(cursorDidStartDragging:nearIndex:)]) {
+            if (m_delegateFlags.didStartDragging) {
                 [self.delegate cursorDidStartDragging:self nearIndex:m_selectedIndex];
             }
         }
@@ -552,7 +770,7 @@
         CGFloat xPos = point.x - m_initialDraggingXOffset;
         self.pointerContainerView.frame = [self pointerFrameForXPos:xPos];
         
-        if ([self.delegate respondsToSelector:@selector(cursor:didDragNearIndex:)]) {
+        if (m_delegateFlags.didDrag) {
             [self.delegate cursor:self didDragNearIndex:[self indexForXPos:xPos]];
         }
     }
@@ -564,7 +782,7 @@
     NSUInteger index = [self indexForXPos:point.x];
     
     if (m_dragging) {
-        if ([self.delegate respondsToSelector:@selector(cursorDidStopDragging:nearIndex:)]) {
+        if (m_delegateFlags.didStopDragging) {
             [self.delegate cursorDidStopDragging:self nearIndex:index];
         }
         
@@ -593,7 +811,7 @@
             
             [self showElementViewAtIndex:m_selectedIndex selected:YES];
             
-            if ([self.delegate respondsToSelector:@selector(cursor:didMoveToIndex:)]) {
+            if (m_delegateFlags.didMoveTo) {
                 [self.delegate cursor:self didMoveToIndex:m_selectedIndex];
             }
         }
@@ -603,7 +821,7 @@
         m_moved = NO;
     }
     
-    if ([self.delegate respondsToSelector:@selector(cursor:didTouchUpNearIndex:)]) {
+    if (m_delegateFlags.didTouchUp) {
         [self.delegate cursor:self didTouchUpNearIndex:index];
     }
 }
@@ -629,7 +847,7 @@
         
         // The selected index is only updated after the pointer has reached its destination, i.e. at the end of
         // the animation
-        if ([self.delegate respondsToSelector:@selector(cursor:didMoveFromIndex:)]) {
+        if (m_delegateFlags.didMoveFrom) {
             [self.delegate cursor:self didMoveFromIndex:m_selectedIndex];
         }
     }
@@ -644,7 +862,7 @@
             
             [self showElementViewAtIndex:m_selectedIndex selected:YES];
             
-            if ([self.delegate respondsToSelector:@selector(cursor:didMoveToIndex:)]) {
+            if (m_delegateFlags.didMoveTo) {
                 [self.delegate cursor:self didMoveToIndex:m_selectedIndex];
             }
         }
@@ -656,7 +874,7 @@
         
         [self showElementViewAtIndex:m_selectedIndex selected:YES];
         
-        if ([self.delegate respondsToSelector:@selector(cursor:didMoveToIndex:)]) {
+        if (m_delegateFlags.didMoveTo) {
             [self.delegate cursor:self didMoveToIndex:m_selectedIndex];
         }
         
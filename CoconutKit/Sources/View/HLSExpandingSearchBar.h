@@ -33,6 +33,9 @@ typedef enum {
 @private
     UISearchBar *m_searchBar;
     UIButton *m_searchButton;
+    HLSAnimation *m_expansionAnimation;
+    HLSAnimation *m_collapseAnimation;
+    CGSize m_animationSize;
     NSString *m_prompt;
     NSString *m_placeholder;
     BOOL m_showsBookmarkButton;
@@ -11,7 +11,7 @@
 #import "NSArray+HLSExtensions.h"
 #import "HLSFloat.h"
 #import "HLSLogger.h"
-#import "HLSViewAnimationStep.h"
+#import "HLSLayerAnimationStep.h"
 #import "NSBundle+HLSExtensions.h"
 
 static const CGFloat kSearchBarStandardHeight = 44.f;
@@ -22,8 +22,13 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 @property (nonatomic, retain) UISearchBar *searchBar;
 @property (nonatomic, retain) UIButton *searchButton;
+@property (nonatomic, retain) HLSAnimation *expansionAnimation;
+@property (nonatomic, retain) HLSAnimation *collapseAnimation;
 
-- (HLSAnimation *)expansionAnimation;
+- (CGRect)collapsedFrame;
+- (CGRect)expandedFrame;
+
+- (void)buildAnimations;
 
 - (void)toggleSearchBar:(id)sender;
 
@@ -53,6 +58,8 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 {
     self.searchBar = nil;
     self.searchButton = nil;
+    self.expansionAnimation = nil;
+    self.collapseAnimation = nil;
     self.delegate = nil;
 
     [super dealloc];
@@ -195,6 +202,10 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 @synthesize searchButton = m_searchButton;
 
+@synthesize expansionAnimation = m_expansionAnimation;
+
+@synthesize collapseAnimation = m_collapseAnimation;
+
 @synthesize alignment = m_alignment;
 
 - (void)setAlignment:(HLSExpandingSearchBarAlignment)alignment
@@ -218,30 +229,39 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
         self.autoresizingMask &= ~UIViewAutoresizingFlexibleHeight;
     }
     
-    // TODO: Factor out collapsed frame creation code
+    // The search bar and the button keep the same bounds whatever their state is. Collapsing and expanding only
+    // changes their layer transform (and opacity), so that the search bar does not have to be laid out again
+    // during animations
     if (! m_animating) {
-        if (self.alignment == HLSExpandingSearchBarAlignmentLeft || m_expanded) {
-            self.searchButton.frame = CGRectMake(0.f,
-                                                 roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f),
-                                                 kSearchBarStandardHeight,
-                                                 kSearchBarStandardHeight);
+        CGRect collapsedFrame = [self collapsedFrame];
+        CGRect expandedFrame = [self expandedFrame];
+        
+        // Animations are relative to the current geometry, and must be built again when the size changes
+        if (! CGSizeEqualToSize(self.bounds.size, m_animationSize)) {
+            self.expansionAnimation = nil;
+            self.collapseAnimation = nil;
+        }
+        
+        self.searchButton.bounds = CGRectMake(0.f, 0.f, CGRectGetWidth(collapsedFrame), CGRectGetHeight(collapsedFrame));
+        self.searchButton.center = CGPointMake(CGRectGetMidX(collapsedFrame), CGRectGetMidY(collapsedFrame));
+        if (self.alignment == HLSExpandingSearchBarAlignmentRight && m_expanded) {
+            self.searchButton.layer.transform = CATransform3DMakeTranslation(CGRectGetMinX(expandedFrame) - CGRectGetMinX(collapsedFrame), 0.f, 0.f);
         }
         else {
-            self.searchButton.frame = CGRectMake(CGRectGetWidth(self.bounds) - kSearchBarStandardHeight,
-                                                 roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f),
-                                                 kSearchBarStandardHeight,
-                                                 kSearchBarStandardHeight);
+            self.searchButton.layer.transform = CATransform3DIdentity;
         }
         
+        self.searchBar.bounds = CGRectMake(0.f, 0.f, CGRectGetWidth(expandedFrame), CGRectGetHeight(expandedFrame));
+        self.searchBar.center = CGPointMake(CGRectGetMidX(expandedFrame), CGRectGetMidY(expandedFrame));
         if (m_expanded) {
             self.searchBar.alpha = 1.f;
-            self.searchBar.frame = CGRectMake(0.f,
-                                              roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f),
-                                              CGRectGetWidth(self.bounds),
-                                              kSearchBarStandardHeight);
+            self.searchBar.layer.transform = CATransform3DIdentity;
         }
         else {
-            self.searchBar.frame = self.searchButton.frame;
+            // Shrink the search bar onto the button
+            self.searchBar.alpha = 0.f;
+            self.searchBar.layer.transform = CATransform3DConcat(CATransform3DMakeScale(CGRectGetWidth(collapsedFrame) / CGRectGetWidth(expandedFrame), 1.f, 1.f),
+                                                                 CATransform3DMakeTranslation(CGRectGetMidX(collapsedFrame) - CGRectGetMidX(expandedFrame), 0.f, 0.f));
         }
     }
     
@@ -260,57 +280,60 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 #pragma mark Animation
 
-// We do not cache the animation: The source and target frames can vary depending on rotations. We
-// therefore need a way to generate the animation easily when we need it
-- (HLSAnimation *)expansionAnimation
+- (CGRect)collapsedFrame
 {
-    HLSViewAnimationStep *animationStep1 = [HLSViewAnimationStep animationStep];
-    animationStep1.duration = 0.15;
-    HLSViewAnimation *viewAnimation11 = [HLSViewAnimation animation];
-    [viewAnimation11 addToAlpha:1.f];
-    [animationStep1 addViewAnimation:viewAnimation11 forView:self.searchBar];
-    
-    HLSViewAnimationStep *animationStep2 = [HLSViewAnimationStep animationStep];
-    animationStep2.duration = 0.25;
-    
-    CGRect collapsedFrame;
+    CGFloat y = roundf((CGRectGetHeight(self.bounds) - kSearchBarStandardHeight) / 2.f);
     if (self.alignment == HLSExpandingSearchBarAlignmentLeft) {
-        collapsedFrame = CGRectMake(0.f, 
-                                    roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f), 
-                                    kSearchBarStandardHeight, 
-                                    kSearchBarStandardHeight);
+        return CGRectMake(0.f, y, kSearchBarStandardHeight, kSearchBarStandardHeight);
     }
     else {
-        collapsedFrame = CGRectMake(CGRectGetWidth(self.bounds) - kSearchBarStandardHeight, 
-                                    roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f), 
-                                    kSearchBarStandardHeight, 
-                                    kSearchBarStandardHeight);    
+        return CGRectMake(CGRectGetWidth(self.bounds) - kSearchBarStandardHeight, y, kSearchBarStandardHeight, kSearchBarStandardHeight);
     }
+}
+
+- (CGRect)expandedFrame
+{
+    return CGRectMake(0.f,
+                      roundf((CGRectGetHeight(self.bounds) - kSearchBarStandardHeight) / 2.f),
+                      MAX(CGRectGetWidth(self.bounds), kSearchBarStandardHeight),
+                      kSearchBarStandardHeight);
+}
+
+// The animations only depend on the search bar size. They are built once for a given size and reused until
+// the size changes (e.g. after a rotation). Frozen so that the collapse animation shares the expansion steps
+- (void)buildAnimations
+{
+    CGRect collapsedFrame = [self collapsedFrame];
+    CGRect expandedFrame = [self expandedFrame];
     
-    HLSViewAnimation *viewAnimation21 = [HLSViewAnimation animation];
-    [viewAnimation21 transformFromRect:collapsedFrame
-                                toRect:CGRectMake(0.f,
-                                                  roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f),
-                                                  CGRectGetWidth(self.bounds),
-                                                  kSearchBarStandardHeight)];
-    [animationStep2 addViewAnimation:viewAnimation21 forView:self.searchBar];
+    HLSLayerAnimationStep *animationStep1 = [HLSLayerAnimationStep animationStep];
+    animationStep1.duration = 0.15;
+    HLSLayerAnimation *layerAnimation11 = [HLSLayerAnimation animation];
+    [layerAnimation11 addToOpacity:1.f];
+    [animationStep1 addLayerAnimation:layerAnimation11 forView:self.searchBar];
+    
+    HLSLayerAnimationStep *animationStep2 = [HLSLayerAnimationStep animationStep];
+    animationStep2.duration = 0.25;
+    
+    HLSLayerAnimation *layerAnimation21 = [HLSLayerAnimation animation];
+    [layerAnimation21 transformFromRect:collapsedFrame toRect:expandedFrame];
+    [animationStep2 addLayerAnimation:layerAnimation21 forView:self.searchBar];
     
     if (self.alignment == HLSExpandingSearchBarAlignmentRight) {
-        HLSViewAnimation *viewAnimation22 = [HLSViewAnimation animation];
-        [viewAnimation22 transformFromRect:collapsedFrame
-                                    toRect:CGRectMake(0.f,
-                                                      roundf((CGRectGetHeight(self.frame) - kSearchBarStandardHeight) / 2.f),
-                                                      kSearchBarStandardHeight,
-                                                      kSearchBarStandardHeight)];
-        [animationStep2 addViewAnimation:viewAnimation22 forView:self.searchButton];
+        HLSLayerAnimation *layerAnimation22 = [HLSLayerAnimation animation];
+        [layerAnimation22 translateByVectorWithX:CGRectGetMinX(expandedFrame) - CGRectGetMinX(collapsedFrame) y:0.f];
+        [animationStep2 addLayerAnimation:layerAnimation22 forView:self.searchButton];
     }
     
-    HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithObjects:animationStep1, animationStep2, nil]];
-    animation.tag = @"searchBar";
-    animation.lockingUI = YES;
-    animation.delegate = self;
+    HLSAnimation *expansionAnimation = [HLSAnimation animationWithAnimationSteps:[NSArray arrayWithObjects:animationStep1, animationStep2, nil]];
+    expansionAnimation.tag = @"searchBar";
+    expansionAnimation.lockingUI = YES;
+    expansionAnimation.delegate = self;
+    [expansionAnimation freeze];
+    self.expansionAnimation = expansionAnimation;
     
-    return animation;
+    self.collapseAnimation = [expansionAnimation reverseAnimation];
+    m_animationSize = self.bounds.size;
 }
 
 - (void)setExpanded:(BOOL)expanded animated:(BOOL)animated
@@ -334,8 +357,10 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
         
         m_animating = YES;
         
-        HLSAnimation *animation = [self expansionAnimation];
-        [animation playAnimated:animated];        
+        if (! self.expansionAnimation) {
+            [self buildAnimations];
+        }
+        [self.expansionAnimation playAnimated:animated];
     }
     else {
         if (! m_expanded) {
@@ -356,8 +381,10 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
         
         [self.searchBar resignFirstResponder];
         
-        HLSAnimation *reverseAnimation = [[self expansionAnimation] reverseAnimation];
-        [reverseAnimation playAnimated:animated];
+        if (! self.collapseAnimation) {
+            [self buildAnimations];
+        }
+        [self.collapseAnimation playAnimated:animated];
     }
 }
 
@@ -399,9 +426,9 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
         }
     }
     
-    // Force layout so that the views resize properly, even if the expansion / collapsing animation occurs during
-    // a device rotation
-    [self layoutSubviews];
+    // Layout so that the views resize properly, even if the expansion / collapsing animation occurs during
+    // a device rotation. The geometry is otherwise already correct and the animations are reused
+    [self setNeedsLayout];
 }
 
 #pragma mark UISearchBarDelegate protocol implementation
@@ -27,10 +27,27 @@ typedef enum {
  *     number of lines is larger than 1). Unlike UILabel, the font size can never be smaller than this minimum
  *     value (even if no size adjustment is needed)
  *   - the baselineAdjustment property is ignored
+ *
+ * The text rect and the adjusted font size are cached, and only calculated again when the text, the font, the label
+ * size or the properties they depend on change. This makes HLSLabel cheap to use in table view cells.
  */
 @interface HLSLabel : UILabel {
 @private
     HLSLabelVerticalAlignment _verticalAlignment;
+    NSString *_textRectCacheText;
+    UIFont *_textRectCacheFont;
+    CGRect _textRectCacheBounds;
+    NSInteger _textRectCacheNumberOfLines;
+    UILineBreakMode _textRectCacheLineBreakMode;
+    CGRect _cachedTextRect;
+    BOOL _textRectCacheValid;
+    NSString *_fontSizeCacheText;
+    UIFont *_fontSizeCacheFont;
+    CGSize _fontSizeCacheSize;
+    NSInteger _fontSizeCacheNumberOfLines;
+    CGFloat _fontSizeCacheMinimumFontSize;
+    CGFloat _cachedFontSize;
+    BOOL _fontSizeCacheValid;
 }
 
 /**
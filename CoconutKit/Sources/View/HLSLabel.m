@@ -14,14 +14,41 @@
 
 @interface HLSLabel ()
 
+@property (nonatomic, retain) NSString *textRectCacheText;
+@property (nonatomic, retain) UIFont *textRectCacheFont;
+@property (nonatomic, retain) NSString *fontSizeCacheText;
+@property (nonatomic, retain) UIFont *fontSizeCacheFont;
+
 - (CGRect)textRectForBounds:(CGRect)bounds limitedToNumberOfLines:(NSInteger)numberOfLines;
 
+- (CGFloat)adjustedFontSize;
+
 @end
 
 @implementation HLSLabel
 
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    self.textRectCacheText = nil;
+    self.textRectCacheFont = nil;
+    self.fontSizeCacheText = nil;
+    self.fontSizeCacheFont = nil;
+    
+    [super dealloc];
+}
+
 #pragma mark Accessors and mutators
 
+@synthesize textRectCacheText = _textRectCacheText;
+
+@synthesize textRectCacheFont = _textRectCacheFont;
+
+@synthesize fontSizeCacheText = _fontSizeCacheText;
+
+@synthesize fontSizeCacheFont = _fontSizeCacheFont;
+
 @synthesize verticalAlignment = _verticalAlignment;
 
 - (void)setVerticalAlignment:(HLSLabelVerticalAlignment)verticalAlignment
@@ -50,8 +77,30 @@
  */
 - (CGRect)textRectForBounds:(CGRect)bounds limitedToNumberOfLines:(NSInteger)numberOfLines
 {
-    CGRect textRect = [super textRectForBounds:bounds limitedToNumberOfLines:numberOfLines];
-	
+    // Measuring text is expensive. Only do it again if something it depends on has changed
+    CGRect textRect = CGRectZero;
+    if (_textRectCacheValid
+            && CGRectEqualToRect(bounds, _textRectCacheBounds)
+            && numberOfLines == _textRectCacheNumberOfLines
+            && self.lineBreakMode == _textRectCacheLineBreakMode
+            && (self.font == self.textRectCacheFont || [self.font isEqual:self.textRectCacheFont])
+            && (self.text == self.textRectCacheText || [self.text isEqualToString:self.textRectCacheText])) {
+        textRect = _cachedTextRect;
+    }
+    else {
+        textRect = [super textRectForBounds:bounds limitedToNumberOfLines:numberOfLines];
+        
+        self.textRectCacheText = self.text;
+        self.textRectCacheFont = self.font;
+        _textRectCacheBounds = bounds;
+        _textRectCacheNumberOfLines = numberOfLines;
+        _textRectCacheLineBreakMode = self.lineBreakMode;
+        _cachedTextRect = textRect;
+        _textRectCacheValid = YES;
+    }
+    
+    // The vertical alignment is cheap to apply and therefore not cached
+
     switch (self.verticalAlignment) {
         case HLSLabelVerticalAlignmentTop: {
             textRect.origin.y = CGRectGetMinY(bounds);
@@ -74,20 +123,51 @@
 
 - (void)drawTextInRect:(CGRect)requestedRect
 {
-    CGFloat fontSize = 0.f;
-    if (self.adjustsFontSizeToFitWidth) {
-        fontSize = [self.text fontSizeWithFont:self.font 
-                             constrainedToSize:self.bounds.size 
-                                   minFontSize:self.minimumFontSize
-                                 numberOfLines:self.numberOfLines];
-    }
-    else {
-        fontSize = floatmax(self.font.pointSize, self.minimumFontSize);
+    // Avoid replacing the font (and thus invalidating the text rect cache) if its size does not change
+    CGFloat fontSize = [self adjustedFontSize];
+    if (! floateq(fontSize, self.font.pointSize)) {
+        self.font = [UIFont fontWithName:self.font.fontName size:fontSize];
     }
-    self.font = [UIFont fontWithName:self.font.fontName size:fontSize];
     
     CGRect actualRect = [self textRectForBounds:requestedRect limitedToNumberOfLines:self.numberOfLines];
     [super drawTextInRect:actualRect];
 }
 
+#pragma mark Font size adjustment
+
+- (CGFloat)adjustedFontSize
+{
+    if (! self.adjustsFontSizeToFitWidth) {
+        return floatmax(self.font.pointSize, self.minimumFontSize);
+    }
+    
+    // Finding the adjusted font size requires the text to be measured several times. Cache the result
+    CGSize size = self.bounds.size;
+    if (_fontSizeCacheValid
+            && CGSizeEqualToSize(size, _fontSizeCacheSize)
+            && self.numberOfLines == _fontSizeCacheNumberOfLines
+            && floateq(self.minimumFontSize, _fontSizeCacheMinimumFontSize)
+            && (self.text == self.fontSizeCacheText || [self.text isEqualToString:self.fontSizeCacheText])
+            && (self.font == self.fontSizeCacheFont || [self.font isEqual:self.fontSizeCacheFont])) {
+        return _cachedFontSize;
+    }
+    
+    CGFloat fontSize = [self.text fontSizeWithFont:self.font 
+                                 constrainedToSize:size 
+                                       minFontSize:self.minimumFontSize
+                                     numberOfLines:self.numberOfLines];
+    
+    // The font is replaced by the adjusted one when drawing. Cache the result for the adjusted font as well, so that
+    // it is found when drawing again
+    self.fontSizeCacheText = self.text;
+    self.fontSizeCacheFont = [UIFont fontWithName:self.font.fontName size:fontSize];
+    _fontSizeCacheSize = size;
+    _fontSizeCacheNumberOfLines = self.numberOfLines;
+    _fontSizeCacheMinimumFontSize = self.minimumFontSize;
+    _cachedFontSize = fontSize;
+    _fontSizeCacheValid = YES;
+    
+    return fontSize;
+}
+
 @end
@@ -10,10 +10,22 @@
 
 #import "HLSAssert.h"
 #import "HLSLogger.h"
-#import "NSArray+HLSExtensions.h"
 
 static NSString * const kMissingLocalizedString = @"UILabel_HLSDynamicLocalization_missing";
 
+// Syntactic elements
+static NSString * const kSeparator = @"/";
+static NSString * const kNormalLeadingPrefix = @"LS";
+static NSString * const kUppercaseLeadingPrefix = @"ULS";
+static NSString * const kLowercaseLeadingPrefix = @"LLS";
+static NSString * const kCapitalizedLeadingPrefix = @"CLS";
+static NSString * const kTableNamePrefix = @"T";
+
+// Localization information parsed so far, keyed by the text it was extracted from. Only texts bearing a localization
+// prefix are cached (those come from nibs and are few), other texts are rejected early without being parsed. Labels
+// are only used from the main thread
+static NSMutableDictionary *s_textToParsedLocalizationInfoMap = nil;
+
 static NSString *stringForLabelRepresentation(HLSLabelRepresentation representation);
 
 @interface HLSLabelLocalizationInfo ()
@@ -33,7 +45,23 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
 - (id)initWithText:(NSString *)text
 {
     if ((self = [super init])) {
-        [self parseText:text];
+        // Labels instantiated from the same nib (e.g. cells) share the same texts, parse each of them once
+        HLSLabelLocalizationInfo *parsedLocalizationInfo = [s_textToParsedLocalizationInfoMap objectForKey:text];
+        if (parsedLocalizationInfo) {
+            self.localizationKey = parsedLocalizationInfo.localizationKey;
+            self.table = parsedLocalizationInfo.table;
+            self.representation = parsedLocalizationInfo.representation;
+        }
+        else {
+            [self parseText:text];
+            
+            if ([self isLocalized]) {
+                if (! s_textToParsedLocalizationInfoMap) {
+                    s_textToParsedLocalizationInfoMap = [[NSMutableDictionary alloc] init];
+                }
+                [s_textToParsedLocalizationInfoMap setObject:self forKey:text];
+            }
+        }
     }
     return self;
 }
@@ -66,32 +94,23 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
 
 - (void)parseText:(NSString *)text
 {
-    // Syntactic elements
-    static NSString * const kSeparator = @"/";
-    static NSString * const kNormalLeadingPrefix = @"LS";
-    static NSString * const kUppercaseLeadingPrefix = @"ULS";
-    static NSString * const kLowercaseLeadingPrefix = @"LLS";
-    static NSString * const kCapitalizedLeadingPrefix = @"CLS";
-    static NSString * const kTableNamePrefix = @"T";
-    
     static NSArray *s_leadingPrefixes = nil;
     if (! s_leadingPrefixes) {
         s_leadingPrefixes = [[NSArray arrayWithObjects:kNormalLeadingPrefix, kUppercaseLeadingPrefix, kLowercaseLeadingPrefix, 
                               kCapitalizedLeadingPrefix, nil] retain];
     }
     
-    // Break text into components
-    NSArray *components = [text componentsSeparatedByString:kSeparator];
-    if ([components count] == 0) {
-        return;
-    }
-    
-    // If no leading prefix, we are done
-    NSString *leadingPrefix = [components firstObject_hls];
+    // If no leading prefix, we are done. Most texts have none, check the text beginning before breaking it into 
+    // components
+    NSRange separatorRange = [text rangeOfString:kSeparator];
+    NSString *leadingPrefix = (separatorRange.location != NSNotFound) ? [text substringToIndex:separatorRange.location] : text;
     if (! [s_leadingPrefixes containsObject:leadingPrefix]) {
         return;
     }
     
+    // Break text into components
+    NSArray *components = [text componentsSeparatedByString:kSeparator];
+    
     // Extract representation
     if ([leadingPrefix isEqualToString:kUppercaseLeadingPrefix]) {
         self.representation = HLSLabelRepresentationUppercase;
@@ -130,7 +149,7 @@ static NSString *stringForLabelRepresentation(HLSLabelRepresentation representat
     }
     
     if ([localizationKey length] == 0) {
-        HLSLoggerWarn(@"Leading localization prefix %@ detected, but empty localization key", [components firstObject_hls]);
+        HLSLoggerWarn(@"Leading localization prefix %@ detected, but empty localization key", leadingPrefix);
     }
     self.localizationKey = localizationKey;
     
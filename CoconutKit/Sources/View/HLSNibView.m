@@ -11,6 +11,7 @@
 #import "HLSLogger.h"
 #import "NSArray+HLSExtensions.h"
 #import "NSObject+HLSExtensions.h"
+#import "UINib+HLSExtensions.h"
 
 static NSMutableDictionary *s_classNameToSizeMap = nil;
 
@@ -37,8 +38,9 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     
     // A xib has been found, use it
     NSString *nibName = [self nibName];
-    if ([[NSBundle mainBundle] pathForResource:nibName ofType:@"nib"]) {
-        NSArray *bundleContents = [[NSBundle mainBundle] loadNibNamed:nibName owner:nil options:nil];
+    UINib *nib = [UINib cachedNibWithName:nibName bundle:nil];
+    if (nib) {
+        NSArray *bundleContents = [nib instantiateWithOwner:nil options:nil];
         if ([bundleContents count] == 0) {
             HLSLoggerError(@"Missing view object in xib file %@", nibName);
             return nil;
@@ -0,0 +1,59 @@
+//
+//  HLSPerformanceHUD.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * A debugging overlay displayed above the application (and the status bar), showing:
+ *   - the current frame time (average over the last refresh period) and the worst frame time over this period
+ *   - the resident memory of the application
+ *   - the number of view controllers managed by CoconutKit containers, and the number of their views currently
+ *     loaded into container views (e.g. HLSStackController or HLSPlaceholderViewController)
+ *   - the number of tasks pending in the monitored task managers
+ *   - the HLSLogger throughput, in messages per second
+ *
+ * A display link measures the frame times, doing only a few arithmetic operations per frame. All other figures are
+ * sampled, and the overlay updated, twice per second only. The overlay therefore costs much less than 1% of the frame
+ * budget and can be left visible while testing, even on old devices. It does not receive touches.
+ *
+ * This class is not thread-safe and must only be used from the main thread.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSPerformanceHUD : NSObject {
+@private
+    UIWindow *m_window;
+    UILabel *m_label;
+    CADisplayLink *m_displayLink;
+    NSArray *m_taskManagers;
+    CFTimeInterval m_lastTimestamp;
+    CFTimeInterval m_lastRefreshTimestamp;
+    CFTimeInterval m_totalFrameDuration;
+    CFTimeInterval m_worstFrameDuration;
+    NSUInteger m_nbrFrames;
+    NSUInteger m_lastLoggedMessageCount;
+}
+
+/**
+ * The overlay displayed by the application
+ */
++ (HLSPerformanceHUD *)sharedPerformanceHUD;
+
+/**
+ * Show or hide the overlay. Measurements are only made while the overlay is visible
+ *
+ * Default value is NO
+ */
+@property (nonatomic, assign, getter=isVisible) BOOL visible;
+
+/**
+ * The task managers whose pending tasks are counted
+ *
+ * Default value is an array containing [HLSTaskManager defaultManager]
+ */
+@property (nonatomic, retain) NSArray *taskManagers;
+
+@end
@@ -0,0 +1,214 @@
+//
+//  HLSPerformanceHUD.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSPerformanceHUD.h"
+
+#import <mach/mach.h>
+#import "HLSContainerContent.h"
+#import "HLSLogger.h"
+#import "HLSTaskManager.h"
+
+static const CFTimeInterval kPerformanceHUDRefreshInterval = 0.5;
+static const CGFloat kPerformanceHUDWidth = 170.f;
+static const CGFloat kPerformanceHUDHeight = 70.f;
+
+// Static functions
+static NSUInteger HLSPerformanceHUDResidentSize(void);
+
+@interface HLSPerformanceHUD ()
+
+@property (nonatomic, retain) UIWindow *window;
+@property (nonatomic, retain) UILabel *label;
+@property (nonatomic, retain) CADisplayLink *displayLink;
+
+- (void)tick:(CADisplayLink *)displayLink;
+- (void)refreshWithTimestamp:(CFTimeInterval)timestamp;
+
+@end
+
+@implementation HLSPerformanceHUD
+
+#pragma mark Class methods
+
++ (HLSPerformanceHUD *)sharedPerformanceHUD
+{
+    static HLSPerformanceHUD *s_instance = nil;
+    
+    if (! s_instance) {
+        s_instance = [[HLSPerformanceHUD alloc] init];
+    }
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.taskManagers = [NSArray arrayWithObject:[HLSTaskManager defaultManager]];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // The display link retains its target. This only happens when the overlay is hidden
+    [self.displayLink invalidate];
+    
+    self.window = nil;
+    self.label = nil;
+    self.displayLink = nil;
+    self.taskManagers = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize window = m_window;
+
+@synthesize label = m_label;
+
+@synthesize displayLink = m_displayLink;
+
+@synthesize taskManagers = m_taskManagers;
+
+- (BOOL)isVisible
+{
+    return self.window != nil;
+}
+
+- (void)setVisible:(BOOL)visible
+{
+    if (visible == self.visible) {
+        return;
+    }
+    
+    if (visible) {
+        // A separate window is used so that the overlay stays on top of everything, including modal view controllers
+        // and the status bar. It is never made key
+        CGRect applicationFrame = [[UIScreen mainScreen] applicationFrame];
+        self.window = [[[UIWindow alloc] initWithFrame:CGRectMake(CGRectGetMaxX(applicationFrame) - kPerformanceHUDWidth,
+                                                                  CGRectGetMinY(applicationFrame),
+                                                                  kPerformanceHUDWidth,
+                                                                  kPerformanceHUDHeight)] autorelease];
+        self.window.windowLevel = UIWindowLevelStatusBar + 1.f;
+        self.window.userInteractionEnabled = NO;
+        self.window.backgroundColor = [UIColor colorWithWhite:0.f alpha:0.6f];
+        
+        self.label = [[[UILabel alloc] initWithFrame:CGRectInset(self.window.bounds, 4.f, 2.f)] autorelease];
+        self.label.backgroundColor = [UIColor clearColor];
+        self.label.textColor = [UIColor whiteColor];
+        self.label.font = [UIFont fontWithName:@"Courier" size:10.f];
+        self.label.numberOfLines = 0;
+        [self.window addSubview:self.label];
+        self.window.hidden = NO;
+        
+        m_lastTimestamp = 0.;
+        m_lastRefreshTimestamp = 0.;
+        m_totalFrameDuration = 0.;
+        m_worstFrameDuration = 0.;
+        m_nbrFrames = 0;
+        m_lastLoggedMessageCount = [[HLSLogger sharedLogger] loggedMessageCount];
+        
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(tick:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    else {
+        [self.displayLink invalidate];
+        self.displayLink = nil;
+        
+        self.window.hidden = YES;
+        self.window = nil;
+        self.label = nil;
+    }
+}
+
+#pragma mark Display link callback
+
+- (void)tick:(CADisplayLink *)displayLink
+{
+    CFTimeInterval timestamp = displayLink.timestamp;
+    
+    // The first frame only provides a reference timestamp
+    if (m_lastTimestamp > 0.) {
+        CFTimeInterval frameDuration = timestamp - m_lastTimestamp;
+        m_totalFrameDuration += frameDuration;
+        if (frameDuration > m_worstFrameDuration) {
+            m_worstFrameDuration = frameDuration;
+        }
+        ++m_nbrFrames;
+    }
+    else {
+        m_lastRefreshTimestamp = timestamp;
+    }
+    m_lastTimestamp = timestamp;
+    
+    if (timestamp - m_lastRefreshTimestamp >= kPerformanceHUDRefreshInterval) {
+        [self refreshWithTimestamp:timestamp];
+    }
+}
+
+#pragma mark Refreshing the overlay
+
+- (void)refreshWithTimestamp:(CFTimeInterval)timestamp
+{
+    CFTimeInterval elapsedTime = timestamp - m_lastRefreshTimestamp;
+    
+    NSUInteger nbrPendingTasks = 0;
+    for (HLSTaskManager *taskManager in self.taskManagers) {
+        nbrPendingTasks += [taskManager pendingTaskCount];
+    }
+    
+    NSUInteger loggedMessageCount = [[HLSLogger sharedLogger] loggedMessageCount];
+    double loggedMessageRate = (loggedMessageCount - m_lastLoggedMessageCount) / elapsedTime;
+    
+    self.label.text = [NSString stringWithFormat:@"Frame: %.1f ms (worst %.1f)\n"
+                       "Memory: %.1f MB\n"
+                       "Containers: %u VCs, %u views\n"
+                       "Tasks: %u pending\n"
+                       "Logger: %.0f msg/s",
+                       (m_nbrFrames != 0) ? 1000. * m_totalFrameDuration / m_nbrFrames : 0.,
+                       1000. * m_worstFrameDuration,
+                       HLSPerformanceHUDResidentSize() / (1024. * 1024.),
+                       [HLSContainerContent managedViewControllerCount],
+                       [HLSContainerContent addedViewCount],
+                       nbrPendingTasks,
+                       loggedMessageRate];
+    
+    m_lastRefreshTimestamp = timestamp;
+    m_totalFrameDuration = 0.;
+    m_worstFrameDuration = 0.;
+    m_nbrFrames = 0;
+    m_lastLoggedMessageCount = loggedMessageCount;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; visible: %@; taskManagers: %@>",
+            [self class],
+            self,
+            self.visible ? @"YES" : @"NO",
+            self.taskManagers];
+}
+
+@end
+
+#pragma mark Static functions
+
+static NSUInteger HLSPerformanceHUDResidentSize(void)
+{
+    struct task_basic_info info;
+    mach_msg_type_number_t count = TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+}
@@ -35,6 +35,10 @@ typedef enum {
  * to the array of images which must be displayed. Other properties provide for further customisation, e.g. animation
  * effect or timings.
  *
+ * Images are decoded at the largest pixel size at which the slideshow can display them (given its frame, the screen
+ * scale and the zooming applied by the effect), not at their full resolution, so that large photos can be displayed
+ * without exhausting memory.
+ *
  * You should not alter the frame of a slideshow while it is running. This is currently not supported.
  *
  * Designated initializer: -initWithFrame:
@@ -51,7 +55,25 @@ typedef enum {
     NSTimeInterval m_imageDuration;
     NSTimeInterval m_transitionDuration;
     BOOL m_random;
+    NSUInteger m_numberOfPrefetchedImages;
+    NSMutableSet *m_prefetchingImageNamesOrPaths;
+    NSMutableArray *m_upcomingRandomImageIndexes;
+    NSUInteger m_imageCacheCapacity;
+    NSMutableDictionary *m_imageCache;
+    NSMutableArray *m_imageCacheKeys;                   // Most recently used first
+    NSUInteger m_imageCacheByteCount;
+    BOOL m_usingKeyframeAnimations;
+    BOOL m_keyframeAnimationsRunning;
+    BOOL m_keyframeAnimationsPaused;
+    CFTimeInterval m_nextKeyframeAnimationBeginTime;    // Begin time of the animation of the upcoming image (image view layer time)
+    id m_keyframeAnimationDelegate;                     // Delegate of the keyframe animations (does not retain the slideshow)
     id<HLSSlideshowDelegate> m_delegate;
+    struct {
+        unsigned int willShow:1;
+        unsigned int didShow:1;
+        unsigned int willHide:1;
+        unsigned int didHide:1;
+    } m_delegateFlags;                                  // optional delegate methods implemented (set with the delegate)
 }
 
 /**
@@ -95,6 +117,42 @@ typedef enum {
  */
 @property (nonatomic, assign) BOOL random;
 
+/**
+ * The number of upcoming images which are loaded, downsampled to the slideshow size and decoded on a background
+ * queue while the current image is displayed, so that transitions start with bitmaps ready to be displayed. Prefetched
+ * images are stored in the image cache (see imageCacheCapacity). Set to 0 to load images only when they are needed.
+ * Default is 1
+ *
+ * This property can be changed while the slideshow is running
+ */
+@property (nonatomic, assign) NSUInteger numberOfPrefetchedImages;
+
+/**
+ * Decoded images are kept in a cache owned by the slideshow, so that images are not decoded again when the slideshow
+ * loops. This cache does not use +[UIImage imageNamed:], whose cache is not bounded. Images are downsampled for the
+ * current effect and frame, and cached for them only. When its capacity (in bytes of decoded bitmap data) is reached, least recently displayed images are discarded first. The cache is emptied when the
+ * slideshow is stopped, when a memory warning is received, and when the slideshow is removed from its window. Default 
+ * is 16 MB
+ *
+ * This property can be changed while the slideshow is running
+ */
+@property (nonatomic, assign) NSUInteger imageCacheCapacity;
+
+/**
+ * By default, the Ken Burns effect is built from several animation steps for each image change, and the slideshow
+ * is involved at each step. If this property is set to YES, the whole life of an image (fade in, pan and zoom, fade
+ * out) is instead expressed as a single keyframe animation group attached to its layer, queued as soon as the previous
+ * image starts to be displayed. Core Animation then drives the slideshow on its own, and the slideshow only wakes up
+ * once per image (to load the upcoming one and notify its delegate), which makes long-running slideshows nearly free
+ * in terms of CPU. Changes to imageDuration and transitionDuration are only taken into account for images queued
+ * afterwards
+ *
+ * This setting is ignored by effects other than HLSSlideshowEffectKenBurns. Default is NO
+ *
+ * This property cannot be changed while the slideshow is running
+ */
+@property (nonatomic, assign, getter=isUsingKeyframeAnimations) BOOL usingKeyframeAnimations;
+
 @property (nonatomic, assign) id<HLSSlideshowDelegate> delegate;
 
 /**
@@ -8,10 +8,13 @@
 
 #import "HLSSlideshow.h"
 
+#import <ImageIO/ImageIO.h>
+
 #import "HLSAssert.h"
 #import "HLSFloat.h"
 #import "HLSLayerAnimationStep.h"
 #import "HLSLogger.h"
+#import "NSArray+HLSExtensions.h"
 #import "UIImage+HLSExtensions.h"
 #import "UIView+HLSExtensions.h"
 
@@ -21,18 +24,65 @@ static const CGFloat kKenBurnsSlideshowMaxScaleFactorDelta = 0.4f;
 
 static const NSInteger kSlideshowNoIndex = -1;
 
+static const NSUInteger kSlideshowDefaultNumberOfPrefetchedImages = 1;
+static const NSUInteger kSlideshowDefaultImageCacheCapacity = 16 * 1024 * 1024;
+
+// Static functions
+static CGFloat HLSSlideshowZoomScale(HLSSlideshowEffect effect, CGSize frameSize, CGSize imageSize);
+static NSString *HLSSlideshowImagePath(NSString *imageNameOrPath);
+static UIImage *HLSSlideshowDownsampledImage(NSString *imagePath, HLSSlideshowEffect effect, CGSize frameSize);
+static dispatch_queue_t HLSSlideshowPrefetchQueue(void);
+static NSString *HLSSlideshowImageCacheKey(NSString *imageNameOrPath, HLSSlideshowEffect effect, CGSize frameSize);
+static NSUInteger HLSSlideshowImageCost(UIImage *image);
+
+/**
+ * Core Animation animations retain their delegate. Keyframe animations, which are attached to the layers of the
+ * slideshow image views, therefore must not have the slideshow itself as delegate, otherwise it would never be
+ * deallocated (and would load images forever). This object forwards their delegate events to the slideshow instead,
+ * until the slideshow sets it free when deallocated
+ */
+@interface SlideshowKeyframeAnimationDelegate : NSObject {
+@private
+    HLSSlideshow *m_slideshow;
+}
+
+@property (nonatomic, assign) HLSSlideshow *slideshow;
+
+@end
+
 @interface HLSSlideshow () <HLSAnimationDelegate>
 
 - (void)hlsSlideshowInit;
 
 @property (nonatomic, retain) NSArray *imageViews;
 @property (nonatomic, retain) HLSAnimation *animation;
+@property (nonatomic, retain) NSMutableSet *prefetchingImageNamesOrPaths;
+@property (nonatomic, retain) NSMutableDictionary *imageCache;
+@property (nonatomic, retain) NSMutableArray *imageCacheKeys;
+@property (nonatomic, retain) NSMutableArray *upcomingRandomImageIndexes;
+@property (nonatomic, retain) SlideshowKeyframeAnimationDelegate *keyframeAnimationDelegate;
 
-- (UIImage *)imageForNameOrPath:(NSString *)imageNameOrPath;
+- (UIImage *)imageForNameOrPath:(NSString *)imageNameOrPath decoded:(BOOL *)pDecoded;
 - (void)prepareImageView:(UIImageView *)imageView withImageNameOrPath:(NSString *)imageNameOrPath;
 - (void)releaseImageView:(UIImageView *)imageView;
 - (NSString *)imageNameOrPathForImageView:(UIImageView *)imageView;
 
+- (void)randomKenBurnsScaleFactor:(CGFloat *)pScaleFactor
+                          xOffset:(CGFloat *)pXOffset
+                          yOffset:(CGFloat *)pYOffset
+                     forImageView:(UIImageView *)imageView;
+
+- (NSArray *)upcomingImageIndexes;
+- (void)prefetchUpcomingImages;
+- (void)clearPrefetchedImages;
+
+- (UIImage *)cachedImageForKey:(NSString *)key;
+- (void)cacheImage:(UIImage *)image forKey:(NSString *)key;
+- (void)removeCachedImageForKey:(NSString *)key;
+- (void)clearImageCache;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
 - (HLSAnimation *)crossDissolveAnimationWithCurrentImageView:(UIImageView *)currentImageView
                                                nextImageView:(UIImageView *)nextImageView
                                           transitionDuration:(NSTimeInterval)transitionDuration;
@@ -52,6 +102,10 @@ static const NSInteger kSlideshowNoIndex = -1;
 - (void)playAnimationForPreviousImage;
 - (void)animateImages;
 
+- (CAAnimationGroup *)kenBurnsKeyframeAnimationGroupForImageView:(UIImageView *)imageView;
+- (void)animateImagesWithKeyframeAnimations;
+- (void)cancelKeyframeAnimations;
+
 - (NSUInteger)randomIndexWithUpperBound:(NSUInteger)upperBound forbiddenIndex:(NSInteger)forbiddenIndex;
 
 @end
@@ -94,15 +148,42 @@ static const NSInteger kSlideshowNoIndex = -1;
     self.imageDuration = kSlideshowDefaultImageDuration;
     self.transitionDuration = kSlideshowDefaultTransitionDuration;
     self.random = NO;
+    self.numberOfPrefetchedImages = kSlideshowDefaultNumberOfPrefetchedImages;
+    self.prefetchingImageNamesOrPaths = [NSMutableSet set];
+    self.upcomingRandomImageIndexes = [NSMutableArray array];
+    
+    self.imageCacheCapacity = kSlideshowDefaultImageCacheCapacity;
+    self.imageCache = [NSMutableDictionary dictionary];
+    self.imageCacheKeys = [NSMutableArray array];
+    
+    self.keyframeAnimationDelegate = [[[SlideshowKeyframeAnimationDelegate alloc] init] autorelease];
+    self.keyframeAnimationDelegate.slideshow = self;
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
 }
 
 - (void)dealloc
 {
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidReceiveMemoryWarningNotification
+                                                  object:nil];
+    
     [self stop];
     
+    // Animations still attached to the image view layers might outlive the slideshow
+    self.keyframeAnimationDelegate.slideshow = nil;
+    self.keyframeAnimationDelegate = nil;
+    
     self.imageViews = nil;
     self.imageNamesOrPaths = nil;
     self.animation = nil;
+    self.prefetchingImageNamesOrPaths = nil;
+    self.upcomingRandomImageIndexes = nil;
+    self.imageCache = nil;
+    self.imageCacheKeys = nil;
     self.delegate = nil;
     
     [super dealloc];
@@ -156,6 +237,9 @@ static const NSInteger kSlideshowNoIndex = -1;
     
     [m_imageNamesOrPaths release];
     m_imageNamesOrPaths = [imageNamesOrPaths retain];
+    
+    // Upcoming random images refer to indexes in the previous array
+    [self.upcomingRandomImageIndexes removeAllObjects];
 }
 
 @synthesize animation = m_animation;
@@ -186,18 +270,84 @@ static const NSInteger kSlideshowNoIndex = -1;
 
 @synthesize random = m_random;
 
+- (void)setRandom:(BOOL)random
+{
+    m_random = random;
+    
+    [self.upcomingRandomImageIndexes removeAllObjects];
+}
+
+@synthesize numberOfPrefetchedImages = m_numberOfPrefetchedImages;
+
+@synthesize prefetchingImageNamesOrPaths = m_prefetchingImageNamesOrPaths;
+
+@synthesize imageCacheCapacity = m_imageCacheCapacity;
+
+- (void)setImageCacheCapacity:(NSUInteger)imageCacheCapacity
+{
+    m_imageCacheCapacity = imageCacheCapacity;
+    
+    // Evict least recently used images which do not fit anymore
+    while ([self.imageCacheKeys count] != 0 && m_imageCacheByteCount > m_imageCacheCapacity) {
+        [self removeCachedImageForKey:[self.imageCacheKeys lastObject]];
+    }
+}
+
+@synthesize imageCache = m_imageCache;
+
+@synthesize imageCacheKeys = m_imageCacheKeys;
+
+@synthesize upcomingRandomImageIndexes = m_upcomingRandomImageIndexes;
+
+@synthesize keyframeAnimationDelegate = m_keyframeAnimationDelegate;
+
+@synthesize usingKeyframeAnimations = m_usingKeyframeAnimations;
+
+- (void)setUsingKeyframeAnimations:(BOOL)usingKeyframeAnimations
+{
+    if (self.running) {
+        HLSLoggerWarn(@"Keyframe animations cannot be enabled or disabled while the slideshow is running");
+        return;
+    }
+    
+    m_usingKeyframeAnimations = usingKeyframeAnimations;
+}
+
 - (BOOL)isRunning
 {
-    return self.animation.running;
+    return self.animation.running || m_keyframeAnimationsRunning;
 }
 
 - (BOOL)isPaused
 {
-    return self.animation.paused;
+    return self.animation.paused || m_keyframeAnimationsPaused;
 }
 
 @synthesize delegate = m_delegate;
 
+- (void)setDelegate:(id<HLSSlideshowDelegate>)delegate
+{
+    m_delegate = delegate;
+    
+    // Optional methods are looked up once, not each time an image changes
+    m_delegateFlags.willShow = [delegate respondsToSelector:@selector(slideshow:willShowImageWithNameOrPath:)];
+    m_delegateFlags.didShow = [delegate respondsToSelector:@selector(slideshow:didShowImageWithNameOrPath:)];
+    m_delegateFlags.willHide = [delegate respondsToSelector:@selector(slideshow:willHideImageWithNameOrPath:)];
+    m_delegateFlags.didHide = [delegate respondsToSelector:@selector(slideshow:didHideImageWithNameOrPath:)];
+}
+
+#pragma mark View lifecycle
+
+- (void)willMoveToWindow:(UIWindow *)newWindow
+{
+    [super willMoveToWindow:newWindow];
+    
+    // Images will be loaded again when needed
+    if (! newWindow) {
+        [self clearImageCache];
+    }
+}
+
 #pragma mark Playing the slideshow
 
 - (void)play
@@ -216,6 +366,8 @@ static const NSInteger kSlideshowNoIndex = -1;
     m_nextImageIndex = kSlideshowNoIndex;
     m_currentImageViewIndex = kSlideshowNoIndex;
     
+    [self.upcomingRandomImageIndexes removeAllObjects];
+    
     [self playAnimationForNextImage];
 }
 
@@ -231,7 +383,16 @@ static const NSInteger kSlideshowNoIndex = -1;
         return;
     }
     
-    [self.animation pause];
+    if (m_keyframeAnimationsRunning) {
+        // Freeze the time of the image view layers
+        CFTimeInterval pausedTime = [self.layer convertTime:CACurrentMediaTime() fromLayer:nil];
+        self.layer.speed = 0.f;
+        self.layer.timeOffset = pausedTime;
+        m_keyframeAnimationsPaused = YES;
+    }
+    else {
+        [self.animation pause];
+    }
 }
 
 - (void)resume
@@ -241,7 +402,18 @@ static const NSInteger kSlideshowNoIndex = -1;
         return;
     }
     
-    [self.animation resume];
+    if (m_keyframeAnimationsRunning) {
+        // Resume where time was frozen
+        CFTimeInterval pausedTime = self.layer.timeOffset;
+        self.layer.speed = 1.f;
+        self.layer.timeOffset = 0.;
+        self.layer.beginTime = 0.;
+        self.layer.beginTime = [self.layer convertTime:CACurrentMediaTime() fromLayer:nil] - pausedTime;
+        m_keyframeAnimationsPaused = NO;
+    }
+    else {
+        [self.animation resume];
+    }
 }
 
 - (void)stop
@@ -254,6 +426,8 @@ static const NSInteger kSlideshowNoIndex = -1;
     [self.animation cancel];
     self.animation = nil;
     
+    [self cancelKeyframeAnimations];
+    
     m_currentImageIndex = kSlideshowNoIndex;
     m_nextImageIndex = kSlideshowNoIndex;
     m_currentImageViewIndex = kSlideshowNoIndex;
@@ -261,6 +435,9 @@ static const NSInteger kSlideshowNoIndex = -1;
     for (UIImageView *imageView in self.imageViews) {
         imageView.image = nil;
     }
+    
+    [self clearPrefetchedImages];
+    [self clearImageCache];
 }
 
 - (void)skipToNextImage
@@ -272,9 +449,12 @@ static const NSInteger kSlideshowNoIndex = -1;
     [self.animation terminate];
     self.animation = nil;
     
+    [self cancelKeyframeAnimations];
+    
     for (UIImageView *imageView in self.imageViews) {
         [self releaseImageView:imageView];
     }
+    [self.upcomingRandomImageIndexes removeAllObjects];
     [self playAnimationForNextImage];
 }
 
@@ -287,9 +467,12 @@ static const NSInteger kSlideshowNoIndex = -1;
     [self.animation terminate];
     self.animation = nil;
     
+    [self cancelKeyframeAnimations];
+    
     for (UIImageView *imageView in self.imageViews) {
         [self releaseImageView:imageView];
     }
+    [self.upcomingRandomImageIndexes removeAllObjects];
     [self playAnimationForPreviousImage];
 }
 
@@ -308,9 +491,12 @@ static const NSInteger kSlideshowNoIndex = -1;
     [self.animation terminate];
     self.animation = nil;
     
+    [self cancelKeyframeAnimations];
+    
     for (UIImageView *imageView in self.imageViews) {
         [self releaseImageView:imageView];
     }
+    [self.upcomingRandomImageIndexes removeAllObjects];
     [self playAnimationForImageWithNameOrPath:imageNameOrPath];
 }
 
@@ -332,9 +518,26 @@ static const NSInteger kSlideshowNoIndex = -1;
 
 #pragma mark Image management
 
-// Return the image corresponding to a name or path. If the image is not found, return a dummy invisible image
-- (UIImage *)imageForNameOrPath:(NSString *)imageNameOrPath
+// Return the image corresponding to a name or path. If the image is not found, return a dummy invisible image. When
+// possible, the image is directly decoded at the size at which it will be displayed (full-resolution photos would 
+// otherwise quickly exhaust memory), in which case the decoded boolean is set to YES
+- (UIImage *)imageForNameOrPath:(NSString *)imageNameOrPath decoded:(BOOL *)pDecoded
 {
+    if (pDecoded) {
+        *pDecoded = NO;
+    }
+    
+    NSString *imagePath = HLSSlideshowImagePath(imageNameOrPath);
+    if (imagePath) {
+        UIImage *image = HLSSlideshowDownsampledImage(imagePath, self.effect, self.frame.size);
+        if (image) {
+            if (pDecoded) {
+                *pDecoded = YES;
+            }
+            return image;
+        }
+    }
+    
     UIImage *image = [UIImage imageNamed:imageNameOrPath];
     if (! image) {
         image = [UIImage imageWithContentsOfFile:imageNameOrPath];
@@ -350,37 +553,23 @@ static const NSInteger kSlideshowNoIndex = -1;
 // behavior for the image view, and is centered in self. The view alpha is reset to 1
 - (void)prepareImageView:(UIImageView *)imageView withImageNameOrPath:(NSString *)imageNameOrPath
 {
-    UIImage *image = [self imageForNameOrPath:imageNameOrPath];
-    
-    // Calculate the scale which needs to be applied to get aspect fill behavior for the image view
-    // TODO: This code is quite common (most notably in PDF generator code). Factor it somewhere where it can easily
-    //       be reused
-    CGFloat zoomScale;
-    // Aspect ratios of frame and image
-    CGFloat frameRatio = CGRectGetWidth(self.frame) / CGRectGetHeight(self.frame);
-    CGFloat imageRatio = image.size.width / image.size.height;
-    if (self.effect == HLSSlideshowEffectNone || self.effect == HLSSlideshowEffectCrossDissolve) {
-        // The image is more portrait-shaped than self
-        if (floatlt(imageRatio, frameRatio)) {
-            zoomScale = CGRectGetHeight(self.frame) / image.size.height;
-        }
-        // The image is more landscape-shaped than self
-        else {
-            zoomScale = CGRectGetWidth(self.frame) / image.size.width;
-        }
+    // Use the cached image if available (e.g. prefetched). It has already been downsampled and decoded for the current
+    // effect and frame
+    NSString *imageCacheKey = HLSSlideshowImageCacheKey(imageNameOrPath, self.effect, self.frame.size);
+    BOOL decoded = NO;
+    UIImage *image = [self cachedImageForKey:imageCacheKey];
+    if (image) {
+        decoded = YES;
     }
-    // Calculate the scale which needs to be applied to get aspect fit behavior for the image view
     else {
-        // The image is more portrait-shaped than self
-        if (floatlt(imageRatio, frameRatio)) {
-            zoomScale = CGRectGetWidth(self.frame) / image.size.width;
-        }
-        // The image is more landscape-shaped than self
-        else {
-            zoomScale = CGRectGetHeight(self.frame) / image.size.height;
+        image = [self imageForNameOrPath:imageNameOrPath decoded:&decoded];
+        if (decoded) {
+            [self cacheImage:image forKey:imageCacheKey];
         }
     }
     
+    CGFloat zoomScale = HLSSlideshowZoomScale(self.effect, self.frame.size, image.size);
+    
     // Update the image view to match the image dimensions with an aspect fill behavior inside self
     CGFloat scaledImageWidth = ceilf(image.size.width * zoomScale);
     CGFloat scaledImageHeight = ceilf(image.size.height * zoomScale);
@@ -390,6 +579,18 @@ static const NSInteger kSlideshowNoIndex = -1;
     imageView.alpha = 1.f;
     imageView.image = image;
     imageView.userInfo_hls = [NSDictionary dictionaryWithObject:imageNameOrPath forKey:@"imageNameOrPath"];
+    
+    if (decoded) {
+        return;
+    }
+    
+    // Decode the image in the background so that this does not happen on the main thread when it gets displayed. Swap 
+    // it if the image view still displays it
+    [image decodeWithCompletionBlock:^(UIImage *decodedImage) {
+        if (imageView.image == image) {
+            imageView.image = decodedImage;
+        }
+    }];
 }
 
 - (void)releaseImageView:(UIImageView *)imageView
@@ -405,6 +606,157 @@ static const NSInteger kSlideshowNoIndex = -1;
     return [[imageView userInfo_hls] objectForKey:@"imageNameOrPath"];
 }
 
+#pragma mark Image cache
+
+// Images are downsampled for an effect and a frame size. Keys are built using HLSSlideshowImageCacheKey so that an
+// image is never reused for another effect or frame size
+- (UIImage *)cachedImageForKey:(NSString *)key
+{
+    UIImage *image = [self.imageCache objectForKey:key];
+    if (! image) {
+        return nil;
+    }
+    
+    // Now the most recently used image
+    [self.imageCacheKeys removeObject:key];
+    [self.imageCacheKeys insertObject:key atIndex:0];
+    return image;
+}
+
+- (void)cacheImage:(UIImage *)image forKey:(NSString *)key
+{
+    if (! image || ! key) {
+        return;
+    }
+    
+    NSUInteger cost = HLSSlideshowImageCost(image);
+    if (cost > self.imageCacheCapacity) {
+        return;
+    }
+    
+    [self removeCachedImageForKey:key];
+    
+    // Make room by evicting least recently used images
+    while ([self.imageCacheKeys count] != 0 && m_imageCacheByteCount + cost > self.imageCacheCapacity) {
+        [self removeCachedImageForKey:[self.imageCacheKeys lastObject]];
+    }
+    
+    [self.imageCache setObject:image forKey:key];
+    [self.imageCacheKeys insertObject:key atIndex:0];
+    m_imageCacheByteCount += cost;
+}
+
+- (void)removeCachedImageForKey:(NSString *)key
+{
+    UIImage *image = [self.imageCache objectForKey:key];
+    if (! image) {
+        return;
+    }
+    
+    m_imageCacheByteCount -= HLSSlideshowImageCost(image);
+    
+    // The key might be owned by the cache only
+    [[key retain] autorelease];
+    [self.imageCache removeObjectForKey:key];
+    [self.imageCacheKeys removeObject:key];
+}
+
+- (void)clearImageCache
+{
+    [self.imageCache removeAllObjects];
+    [self.imageCacheKeys removeAllObjects];
+    m_imageCacheByteCount = 0;
+}
+
+#pragma mark Prefetching
+
+// Return the indexes of the images which will be displayed after the next one, in order
+- (NSArray *)upcomingImageIndexes
+{
+    NSUInteger numberOfImages = [self.imageNamesOrPaths count];
+    if (numberOfImages < 2 || m_nextImageIndex == kSlideshowNoIndex) {
+        return [NSArray array];
+    }
+    
+    if (self.random) {
+        // Random images are chosen in advance so that they can be prefetched
+        while ([self.upcomingRandomImageIndexes count] < self.numberOfPrefetchedImages) {
+            NSNumber *lastImageIndexNumber = [self.upcomingRandomImageIndexes lastObject];
+            NSInteger lastImageIndex = lastImageIndexNumber ? [lastImageIndexNumber integerValue] : m_nextImageIndex;
+            NSUInteger imageIndex = [self randomIndexWithUpperBound:numberOfImages forbiddenIndex:lastImageIndex];
+            [self.upcomingRandomImageIndexes addObject:[NSNumber numberWithUnsignedInteger:imageIndex]];
+        }
+        return [NSArray arrayWithArray:self.upcomingRandomImageIndexes];
+    }
+    else {
+        NSMutableArray *upcomingImageIndexes = [NSMutableArray array];
+        for (NSUInteger i = 1; i <= self.numberOfPrefetchedImages; ++i) {
+            NSUInteger imageIndex = (m_nextImageIndex + i) % numberOfImages;
+            [upcomingImageIndexes addObject:[NSNumber numberWithUnsignedInteger:imageIndex]];
+        }
+        return [NSArray arrayWithArray:upcomingImageIndexes];
+    }
+}
+
+// Load, downsample and decode upcoming images in the background, and store them into the image cache
+- (void)prefetchUpcomingImages
+{
+    NSMutableSet *upcomingImageNamesOrPaths = [NSMutableSet set];
+    for (NSNumber *imageIndexNumber in [self upcomingImageIndexes]) {
+        NSString *imageNameOrPath = [self.imageNamesOrPaths objectAtIndex:[imageIndexNumber unsignedIntegerValue]];
+        [upcomingImageNamesOrPaths addObject:imageNameOrPath];
+    }
+    
+    // Images already displayed by the image views do not need to be prefetched
+    for (UIImageView *imageView in self.imageViews) {
+        NSString *imageNameOrPath = [self imageNameOrPathForImageView:imageView];
+        if (imageNameOrPath) {
+            [upcomingImageNamesOrPaths removeObject:imageNameOrPath];
+        }
+    }
+    
+    // Images which are not upcoming anymore will be discarded when loaded
+    for (NSString *imageNameOrPath in [self.prefetchingImageNamesOrPaths allObjects]) {
+        if (! [upcomingImageNamesOrPaths containsObject:imageNameOrPath]) {
+            [self.prefetchingImageNamesOrPaths removeObject:imageNameOrPath];
+        }
+    }
+    
+    HLSSlideshowEffect effect = self.effect;
+    CGSize frameSize = self.frame.size;
+    for (NSString *imageNameOrPath in upcomingImageNamesOrPaths) {
+        // Already available. Mark as recently used so that it does not get evicted before being displayed
+        NSString *imageCacheKey = HLSSlideshowImageCacheKey(imageNameOrPath, effect, frameSize);
+        if ([self cachedImageForKey:imageCacheKey] || [self.prefetchingImageNamesOrPaths containsObject:imageNameOrPath]) {
+            continue;
+        }
+        
+        // Mark the image as being loaded
+        [self.prefetchingImageNamesOrPaths addObject:imageNameOrPath];
+        
+        // Explicitly retained until the image has been loaded, and released on the main thread
+        __block HLSSlideshow *blockSelf = [self retain];
+        dispatch_async(HLSSlideshowPrefetchQueue(), ^{
+            NSString *imagePath = HLSSlideshowImagePath(imageNameOrPath);
+            UIImage *image = imagePath ? HLSSlideshowDownsampledImage(imagePath, effect, frameSize) : nil;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                // Only keep the image if still expected. If it could not be loaded, it will be loaded when needed
+                if ([blockSelf.prefetchingImageNamesOrPaths containsObject:imageNameOrPath]) {
+                    [blockSelf.prefetchingImageNamesOrPaths removeObject:imageNameOrPath];
+                    [blockSelf cacheImage:image forKey:imageCacheKey];
+                }
+                [blockSelf release];
+            });
+        });
+    }
+}
+
+- (void)clearPrefetchedImages
+{
+    [self.prefetchingImageNamesOrPaths removeAllObjects];
+    [self.upcomingRandomImageIndexes removeAllObjects];
+}
+
 // Randomly move and scale an image view so that it stays in self.view. Returns random scale factors, x and y offsets
 // which can be applied to reach a new random valid state
 - (void)randomlyMoveAndScaleImageView:(UIImageView *)imageView
@@ -412,24 +764,16 @@ static const NSInteger kSlideshowNoIndex = -1;
                               xOffset:(CGFloat *)pXOffset
                               yOffset:(CGFloat *)pYOffset
 {
-    // Pick up a random initial scale factor. Must be >= 1, and not too large. Use random factor in [0;1]
-    CGFloat scaleFactor = 1.f + kKenBurnsSlideshowMaxScaleFactorDelta * (arc4random() % 1001) / 1000.f;
+    // Pick up random initial and final states
+    CGFloat scaleFactor = 0.f;
+    CGFloat xOffset = 0.f;
+    CGFloat yOffset = 0.f;
+    [self randomKenBurnsScaleFactor:&scaleFactor xOffset:&xOffset yOffset:&yOffset forImageView:imageView];
     
-    // The image is centered in the image view. Calculate the maximum translation offsets we can apply for the selected
-    // scale factor so that the image view still covers self
-    CGFloat maxXOffset = (scaleFactor * CGRectGetWidth(imageView.frame) - CGRectGetWidth(self.frame)) / 2.f;
-    CGFloat maxYOffset = (scaleFactor * CGRectGetHeight(imageView.frame) - CGRectGetHeight(self.frame)) / 2.f;
-    
-    // Pick up some random offsets. Use random factor in [-1;1]
-    CGFloat xOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxXOffset;
-    CGFloat yOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxYOffset;
-    
-    // Pick up random scale factor to reach at the end of the animation. Same constraints as above
-    CGFloat finalScaleFactor = 1.f + kKenBurnsSlideshowMaxScaleFactorDelta * (arc4random() % 1001) / 1000.f;
-    CGFloat maxFinalXOffset = (finalScaleFactor * CGRectGetWidth(imageView.frame) - CGRectGetWidth(self.frame)) / 2.f;
-    CGFloat maxFinalYOffset = (finalScaleFactor * CGRectGetHeight(imageView.frame) - CGRectGetHeight(self.frame)) / 2.f;
-    CGFloat finalXOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxFinalXOffset;
-    CGFloat finalYOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxFinalYOffset;
+    CGFloat finalScaleFactor = 0.f;
+    CGFloat finalXOffset = 0.f;
+    CGFloat finalYOffset = 0.f;
+    [self randomKenBurnsScaleFactor:&finalScaleFactor xOffset:&finalXOffset yOffset:&finalYOffset forImageView:imageView];
     
     // Apply initial transform to set initial image view position
     imageView.layer.transform = CATransform3DConcat(CATransform3DMakeScale(scaleFactor, scaleFactor, 1.f),
@@ -446,6 +790,33 @@ static const NSInteger kSlideshowNoIndex = -1;
     }
 }
 
+// Pick up a random scale factor and random offsets which, applied to an image view centered in self (scale first),
+// make it still cover self
+- (void)randomKenBurnsScaleFactor:(CGFloat *)pScaleFactor
+                          xOffset:(CGFloat *)pXOffset
+                          yOffset:(CGFloat *)pYOffset
+                     forImageView:(UIImageView *)imageView
+{
+    // Must be >= 1, and not too large. Use random factor in [0;1]
+    CGFloat scaleFactor = 1.f + kKenBurnsSlideshowMaxScaleFactorDelta * (arc4random() % 1001) / 1000.f;
+    
+    // The image is centered in the image view. Calculate the maximum translation offsets we can apply for the selected
+    // scale factor so that the image view still covers self
+    CGFloat maxXOffset = (scaleFactor * CGRectGetWidth(imageView.bounds) - CGRectGetWidth(self.frame)) / 2.f;
+    CGFloat maxYOffset = (scaleFactor * CGRectGetHeight(imageView.bounds) - CGRectGetHeight(self.frame)) / 2.f;
+    
+    // Use random factor in [-1;1]
+    if (pScaleFactor) {
+        *pScaleFactor = scaleFactor;
+    }
+    if (pXOffset) {
+        *pXOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxXOffset;
+    }
+    if (pYOffset) {
+        *pYOffset = 2 * ((arc4random() % 1001) / 1000.f - 0.5f) * maxYOffset;
+    }
+}
+
 #pragma mark Animations
 
 - (HLSAnimation *)crossDissolveAnimationWithCurrentImageView:(UIImageView *)currentImageView
@@ -619,20 +990,20 @@ static const NSInteger kSlideshowNoIndex = -1;
                                                       transitionDuration:0.];
             break;
         }
-            
+        
         case HLSSlideshowEffectCrossDissolve: {
             animation = [self crossDissolveAnimationWithCurrentImageView:currentImageView
                                                            nextImageView:nextImageView
                                                       transitionDuration:self.transitionDuration];
             break;
         }
-            
+        
         case HLSSlideshowEffectKenBurns: {
             animation = [self kenBurnsAnimationWithCurrentImageView:currentImageView
                                                       nextImageView:nextImageView];
             break;
         }
-            
+        
         case HLSSlideshowEffectHorizontalRibbon: {
             animation = [self translationAnimationWithCurrentImageView:currentImageView 
                                                          nextImageView:nextImageView 
@@ -640,7 +1011,7 @@ static const NSInteger kSlideshowNoIndex = -1;
                                                                yOffset:0.f];
             break;
         }
-            
+        
         case HLSSlideshowEffectInverseHorizontalRibbon: {
             animation = [self translationAnimationWithCurrentImageView:currentImageView 
                                                          nextImageView:nextImageView 
@@ -648,7 +1019,7 @@ static const NSInteger kSlideshowNoIndex = -1;
                                                                yOffset:0.f];
             break;
         }
-            
+        
         case HLSSlideshowEffectVerticalRibbon: {
             animation = [self translationAnimationWithCurrentImageView:currentImageView 
                                                          nextImageView:nextImageView 
@@ -656,7 +1027,7 @@ static const NSInteger kSlideshowNoIndex = -1;
                                                                yOffset:(CGRectGetHeight(currentImageView.frame) + CGRectGetHeight(nextImageView.frame)) / 2.f];
             break;
         }
-            
+        
         case HLSSlideshowEffectInverseVerticalRibbon: {
             animation = [self translationAnimationWithCurrentImageView:currentImageView 
                                                          nextImageView:nextImageView 
@@ -664,7 +1035,7 @@ static const NSInteger kSlideshowNoIndex = -1;
                                                                yOffset:-(CGRectGetHeight(currentImageView.frame) + CGRectGetHeight(nextImageView.frame)) / 2.f];
             break;
         }
-            
+        
         default: {
             HLSLoggerError(@"Unkown effect");
             return nil;
@@ -682,9 +1053,18 @@ static const NSInteger kSlideshowNoIndex = -1;
     
     if (self.random) {
         if (numberOfImages > 1) {
-            // Avoid displaying the same image twice in a row
+            // Avoid displaying the same image twice in a row. Use the image chosen in advance for prefetching, if any
             m_currentImageIndex = m_nextImageIndex;
-            m_nextImageIndex = [self randomIndexWithUpperBound:numberOfImages forbiddenIndex:m_currentImageIndex];
+            NSNumber *upcomingImageIndexNumber = [self.upcomingRandomImageIndexes firstObject_hls];
+            if (upcomingImageIndexNumber && [upcomingImageIndexNumber integerValue] != m_currentImageIndex
+                    && [upcomingImageIndexNumber unsignedIntegerValue] < numberOfImages) {
+                m_nextImageIndex = [upcomingImageIndexNumber integerValue];
+                [self.upcomingRandomImageIndexes removeObjectAtIndex:0];
+            }
+            else {
+                [self.upcomingRandomImageIndexes removeAllObjects];
+                m_nextImageIndex = [self randomIndexWithUpperBound:numberOfImages forbiddenIndex:m_currentImageIndex];
+            }
         }
         else {
             m_currentImageIndex = 0;
@@ -796,10 +1176,138 @@ static const NSInteger kSlideshowNoIndex = -1;
     }
     
     // Create and play the animation
+    if (self.effect == HLSSlideshowEffectKenBurns && self.usingKeyframeAnimations) {
+        [self animateImagesWithKeyframeAnimations];
+        return;
+    }
+    
     self.animation = [self animationForEffect:self.effect
                              currentImageView:currentImageView
                                 nextImageView:nextImageView];
     [self.animation playAnimated:YES];
+    
+    // Prepare the images which follow while the current image is displayed
+    [self prefetchUpcomingImages];
+}
+
+#pragma mark Keyframe animations
+
+// Create the animation describing the whole life of an image for the Ken Burns effect: fade in, display alone and
+// fade out, while being panned and zoomed. The group lasts imageDuration + 2 * transitionDuration, the group of
+// the following image must therefore begin imageDuration + transitionDuration after it
+- (CAAnimationGroup *)kenBurnsKeyframeAnimationGroupForImageView:(UIImageView *)imageView
+{
+    NSTimeInterval totalDuration = self.imageDuration + 2 * self.transitionDuration;
+    
+    CGFloat initialScaleFactor = 0.f;
+    CGFloat initialXOffset = 0.f;
+    CGFloat initialYOffset = 0.f;
+    [self randomKenBurnsScaleFactor:&initialScaleFactor xOffset:&initialXOffset yOffset:&initialYOffset forImageView:imageView];
+    
+    CGFloat finalScaleFactor = 0.f;
+    CGFloat finalXOffset = 0.f;
+    CGFloat finalYOffset = 0.f;
+    [self randomKenBurnsScaleFactor:&finalScaleFactor xOffset:&finalXOffset yOffset:&finalYOffset forImageView:imageView];
+    
+    // Keyframes at the beginning and end of both transitions
+    NSArray *keyTimes = [NSArray arrayWithObjects:[NSNumber numberWithDouble:0.],
+                         [NSNumber numberWithDouble:self.transitionDuration / totalDuration],
+                         [NSNumber numberWithDouble:(self.transitionDuration + self.imageDuration) / totalDuration],
+                         [NSNumber numberWithDouble:1.],
+                         nil];
+    
+    // Same progression as for the step-based Ken Burns effect (see -kenBurnsAnimationWithCurrentImageView:nextImageView:)
+    NSMutableArray *transformValues = [NSMutableArray array];
+    for (NSNumber *keyTime in keyTimes) {
+        CGFloat progress = [keyTime floatValue];
+        CGFloat scaleFactor = initialScaleFactor * powf(finalScaleFactor / initialScaleFactor, progress);
+        CGFloat xOffset = initialXOffset + (finalXOffset - initialXOffset) * progress;
+        CGFloat yOffset = initialYOffset + (finalYOffset - initialYOffset) * progress;
+        CATransform3D transform = CATransform3DConcat(CATransform3DMakeScale(scaleFactor, scaleFactor, 1.f),
+                                                      CATransform3DMakeTranslation(xOffset, yOffset, 0.f));
+        [transformValues addObject:[NSValue valueWithCATransform3D:transform]];
+    }
+    
+    CAKeyframeAnimation *transformAnimation = [CAKeyframeAnimation animationWithKeyPath:@"transform"];
+    transformAnimation.values = [NSArray arrayWithArray:transformValues];
+    transformAnimation.keyTimes = keyTimes;
+    
+    CAKeyframeAnimation *opacityAnimation = [CAKeyframeAnimation animationWithKeyPath:@"opacity"];
+    opacityAnimation.values = [NSArray arrayWithObjects:[NSNumber numberWithFloat:0.f],
+                               [NSNumber numberWithFloat:1.f],
+                               [NSNumber numberWithFloat:1.f],
+                               [NSNumber numberWithFloat:0.f],
+                               nil];
+    opacityAnimation.keyTimes = keyTimes;
+    
+    // The group is queued in advance. Until it begins, the image must be invisible
+    CAAnimationGroup *animationGroup = [CAAnimationGroup animation];
+    animationGroup.animations = [NSArray arrayWithObjects:transformAnimation, opacityAnimation, nil];
+    animationGroup.duration = totalDuration;
+    animationGroup.fillMode = kCAFillModeBackwards;
+    animationGroup.delegate = self.keyframeAnimationDelegate;
+    return animationGroup;
+}
+
+// Attach the animation of the next image to its layer, so that Core Animation plays it right when the current image
+// starts to fade out. If the current image is not displayed yet (slideshow started or skipping to another image),
+// it is displayed immediately, as if it had just faded in
+- (void)animateImagesWithKeyframeAnimations
+{
+    UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
+    UIImageView *nextImageView = [self.imageViews objectAtIndex:(m_currentImageViewIndex + 1) % 2];
+    
+    // Model opacities stay at 0. Images are only visible while their animation is running
+    CFTimeInterval currentBeginTime = 0.;
+    if (! m_keyframeAnimationsRunning) {
+        currentImageView.alpha = 0.f;
+        
+        CAAnimationGroup *currentAnimationGroup = [self kenBurnsKeyframeAnimationGroupForImageView:currentImageView];
+        currentBeginTime = [currentImageView.layer convertTime:CACurrentMediaTime() fromLayer:nil] - self.transitionDuration;
+        currentAnimationGroup.beginTime = currentBeginTime;
+        
+        // Already visible: Its beginning must not be notified as a transition
+        [currentAnimationGroup setValue:[NSNumber numberWithBool:YES] forKey:@"initial"];
+        [currentImageView.layer addAnimation:currentAnimationGroup forKey:@"kenBurns"];
+        
+        m_keyframeAnimationsRunning = YES;
+    }
+    else {
+        currentBeginTime = m_nextKeyframeAnimationBeginTime;
+    }
+    
+    nextImageView.alpha = 0.f;
+    
+    CAAnimationGroup *nextAnimationGroup = [self kenBurnsKeyframeAnimationGroupForImageView:nextImageView];
+    m_nextKeyframeAnimationBeginTime = currentBeginTime + self.imageDuration + self.transitionDuration;
+    nextAnimationGroup.beginTime = m_nextKeyframeAnimationBeginTime;
+    [nextImageView.layer addAnimation:nextAnimationGroup forKey:@"kenBurns"];
+    
+    if (m_delegateFlags.didShow) {
+        [self.delegate slideshow:self didShowImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
+    }
+    
+    // Prepare the images which follow while the current image is displayed
+    [self prefetchUpcomingImages];
+}
+
+- (void)cancelKeyframeAnimations
+{
+    if (! m_keyframeAnimationsRunning) {
+        return;
+    }
+    
+    // Reset before removing the animations, so that their interruption is not interpreted as a regular end
+    m_keyframeAnimationsRunning = NO;
+    m_keyframeAnimationsPaused = NO;
+    
+    for (UIImageView *imageView in self.imageViews) {
+        [imageView.layer removeAnimationForKey:@"kenBurns"];
+    }
+    
+    self.layer.speed = 1.f;
+    self.layer.timeOffset = 0.;
+    self.layer.beginTime = 0.;
 }
 
 #pragma mark Miscellaneous
@@ -815,18 +1323,25 @@ static const NSInteger kSlideshowNoIndex = -1;
     return randomIndex;
 }
 
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [self clearImageCache];
+}
+
 #pragma mark HLSAnimationDelegate protocol implementation
 
 - (void)animation:(HLSAnimation *)animation didFinishStep:(HLSAnimationStep *)animationStep animated:(BOOL)animated
 {
     if ([animationStep.tag isEqualToString:@"singleImage"]) {
         UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
-        if ([self.delegate respondsToSelector:@selector(slideshow:willHideImageWithNameOrPath:)]) {
+        if (m_delegateFlags.willHide) {
             [self.delegate slideshow:self willHideImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
         }
         
         UIImageView *nextImageView = [self.imageViews objectAtIndex:(m_currentImageViewIndex + 1) % 2];
-        if ([self.delegate respondsToSelector:@selector(slideshow:willShowImageWithNameOrPath:)]) {
+        if (m_delegateFlags.willShow) {
             [self.delegate slideshow:self willShowImageWithNameOrPath:[self imageNameOrPathForImageView:nextImageView]];
         }
     }
@@ -834,7 +1349,7 @@ static const NSInteger kSlideshowNoIndex = -1;
 
 - (void)animationWillStart:(HLSAnimation *)animation animated:(BOOL)animated
 {
-    if ([self.delegate respondsToSelector:@selector(slideshow:didShowImageWithNameOrPath:)]) {
+    if (m_delegateFlags.didShow) {
         UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
         [self.delegate slideshow:self didShowImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
     }
@@ -843,7 +1358,7 @@ static const NSInteger kSlideshowNoIndex = -1;
 - (void)animationDidStop:(HLSAnimation *)animation animated:(BOOL)animated
 {
     UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
-    if ([self.delegate respondsToSelector:@selector(slideshow:didHideImageWithNameOrPath:)]) {
+    if (m_delegateFlags.didHide) {
         [self.delegate slideshow:self didHideImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
     }
     
@@ -854,4 +1369,193 @@ static const NSInteger kSlideshowNoIndex = -1;
     }
 }
 
+#pragma mark CAAnimation delegate
+
+- (void)animationDidStart:(CAAnimation *)animation
+{
+    if (! m_keyframeAnimationsRunning || [[animation valueForKey:@"initial"] boolValue]) {
+        return;
+    }
+    
+    // The next image starts fading in
+    UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
+    if (m_delegateFlags.willHide) {
+        [self.delegate slideshow:self willHideImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
+    }
+    
+    UIImageView *nextImageView = [self.imageViews objectAtIndex:(m_currentImageViewIndex + 1) % 2];
+    if (m_delegateFlags.willShow) {
+        [self.delegate slideshow:self willShowImageWithNameOrPath:[self imageNameOrPathForImageView:nextImageView]];
+    }
+}
+
+- (void)animationDidStop:(CAAnimation *)animation finished:(BOOL)finished
+{
+    // Interrupted animations (stop, skip) are ignored
+    if (! m_keyframeAnimationsRunning || ! finished) {
+        return;
+    }
+    
+    // The current image has faded out, and the next one has just faded in
+    UIImageView *currentImageView = [self.imageViews objectAtIndex:m_currentImageViewIndex];
+    if (m_delegateFlags.didHide) {
+        [self.delegate slideshow:self didHideImageWithNameOrPath:[self imageNameOrPathForImageView:currentImageView]];
+    }
+    
+    [self releaseImageView:currentImageView];
+    [self playNextAnimation];
+}
+
+@end
+
+@implementation SlideshowKeyframeAnimationDelegate
+
+#pragma mark Accessors and mutators
+
+@synthesize slideshow = m_slideshow;
+
+#pragma mark CAAnimation delegate methods
+
+- (void)animationDidStart:(CAAnimation *)animation
+{
+    [self.slideshow animationDidStart:animation];
+}
+
+- (void)animationDidStop:(CAAnimation *)animation finished:(BOOL)finished
+{
+    [self.slideshow animationDidStop:animation finished:finished];
+}
+
 @end
+
+#pragma mark Static functions
+
+// Return the scale to apply to an image so that it fits (no transition, cross-dissolve) or fills (other effects) a frame
+static CGFloat HLSSlideshowZoomScale(HLSSlideshowEffect effect, CGSize frameSize, CGSize imageSize)
+{
+    // Aspect ratios of frame and image
+    CGFloat frameRatio = frameSize.width / frameSize.height;
+    CGFloat imageRatio = imageSize.width / imageSize.height;
+    
+    // Calculate the scale which needs to be applied to get aspect fit behavior for the image view
+    // TODO: This code is quite common (most notably in PDF generator code). Factor it somewhere where it can easily
+    //       be reused
+    if (effect == HLSSlideshowEffectNone || effect == HLSSlideshowEffectCrossDissolve) {
+        // The image is more portrait-shaped than the frame
+        if (floatlt(imageRatio, frameRatio)) {
+            return frameSize.height / imageSize.height;
+        }
+        // The image is more landscape-shaped than the frame
+        else {
+            return frameSize.width / imageSize.width;
+        }
+    }
+    // Calculate the scale which needs to be applied to get aspect fill behavior for the image view
+    else {
+        // The image is more portrait-shaped than the frame
+        if (floatlt(imageRatio, frameRatio)) {
+            return frameSize.width / imageSize.width;
+        }
+        // The image is more landscape-shaped than the frame
+        else {
+            return frameSize.height / imageSize.height;
+        }
+    }
+}
+
+// Return the path of the file corresponding to an image name (in the main bundle) or path, nil if not found. Can be
+// called from any thread
+static NSString *HLSSlideshowImagePath(NSString *imageNameOrPath)
+{
+    NSString *extension = [imageNameOrPath pathExtension];
+    if ([extension length] == 0) {
+        // Same default as +[UIImage imageNamed:]
+        extension = @"png";
+    }
+    NSString *baseName = [[imageNameOrPath lastPathComponent] stringByDeletingPathExtension];
+    NSString *directory = [imageNameOrPath stringByDeletingLastPathComponent];
+    if ([directory length] == 0) {
+        directory = nil;
+    }
+    
+    // Prefer high-resolution images, as +[UIImage imageNamed:] does
+    if (floatgt([UIScreen mainScreen].scale, 1.f)) {
+        NSString *imagePath = [[NSBundle mainBundle] pathForResource:[baseName stringByAppendingString:@"@2x"] 
+                                                                ofType:extension
+                                                           inDirectory:directory];
+        if (imagePath) {
+            return imagePath;
+        }
+    }
+    
+    NSString *imagePath = [[NSBundle mainBundle] pathForResource:baseName ofType:extension inDirectory:directory];
+    if (imagePath) {
+        return imagePath;
+    }
+    
+    if ([[NSFileManager defaultManager] fileExistsAtPath:imageNameOrPath]) {
+        return imageNameOrPath;
+    }
+    
+    return nil;
+}
+
+// Load and decode an image, downsampled to the largest pixel size at which it can be displayed by the effect (taking
+// into account the screen scale and Ken Burns zooming). Images are never upscaled. Can be called from any thread
+static UIImage *HLSSlideshowDownsampledImage(NSString *imagePath, HLSSlideshowEffect effect, CGSize frameSize)
+{
+    // Only read the image properties (cheap) to get its dimensions
+    CGImageSourceRef imageSource = CGImageSourceCreateWithURL((CFURLRef)[NSURL fileURLWithPath:imagePath], NULL);
+    if (! imageSource) {
+        return nil;
+    }
+    NSDictionary *properties = [(NSDictionary *)CGImageSourceCopyPropertiesAtIndex(imageSource, 0, NULL) autorelease];
+    CFRelease(imageSource);
+    
+    CGFloat pixelWidth = [[properties objectForKey:(NSString *)kCGImagePropertyPixelWidth] floatValue];
+    CGFloat pixelHeight = [[properties objectForKey:(NSString *)kCGImagePropertyPixelHeight] floatValue];
+    if (floateq(pixelWidth, 0.f) || floateq(pixelHeight, 0.f)) {
+        return nil;
+    }
+    
+    // EXIF orientations 5 to 8 swap width and height
+    NSInteger orientation = [[properties objectForKey:(NSString *)kCGImagePropertyOrientation] integerValue];
+    CGSize imageSize = (orientation >= 5) ? CGSizeMake(pixelHeight, pixelWidth) : CGSizeMake(pixelWidth, pixelHeight);
+    
+    // Largest dimension at which the image will be displayed, in pixels. The Ken Burns effect zooms into images
+    CGFloat zoomScale = HLSSlideshowZoomScale(effect, frameSize, imageSize) * [UIScreen mainScreen].scale;
+    if (effect == HLSSlideshowEffectKenBurns) {
+        zoomScale *= 1.f + kKenBurnsSlideshowMaxScaleFactorDelta;
+    }
+    CGFloat maxPixelSize = ceilf(floatmax(imageSize.width, imageSize.height) * floatmin(zoomScale, 1.f));
+    
+    return [UIImage thumbnailImageWithContentsOfFile:imagePath maxPixelSize:maxPixelSize];
+}
+
+static dispatch_queue_t HLSSlideshowPrefetchQueue(void)
+{
+    // Serial, so that several large images are never decoded at the same time
+    static dispatch_queue_t s_queue = NULL;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.hortis.CoconutKit.slideshowPrefetch", NULL);
+        dispatch_set_target_queue(s_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+    });
+    return s_queue;
+}
+
+// Key under which an image downsampled for an effect and a frame size is cached
+static NSString *HLSSlideshowImageCacheKey(NSString *imageNameOrPath, HLSSlideshowEffect effect, CGSize frameSize)
+{
+    return [NSString stringWithFormat:@"%@|%d|%@", imageNameOrPath, effect, NSStringFromCGSize(frameSize)];
+}
+
+// Number of bytes occupied by the bitmap of a decoded image
+static NSUInteger HLSSlideshowImageCost(UIImage *image)
+{
+    CGImageRef imageRef = image.CGImage;
+    if (! imageRef) {
+        return 0;
+    }
+    return CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
+}
@@ -91,6 +91,32 @@
 + (CGFloat)width;
 + (CGSize)size;
 
+/**
+ * Return the height of a cell having variable contents, for a given width. The first time a content variant is 
+ * measured, a prototype cell (created once per class and never displayed) is resized to the specified width, 
+ * configured by calling the block, and measured using -sizeThatFits: (which your cell class must therefore override 
+ * to compute the height its contents need). The result is then cached per cell class, width and content fingerprint, 
+ * so that subsequent calls for the same fingerprint (typically from -tableView:heightForRowAtIndexPath:) return
+ * immediately without performing any layout.
+ *
+ * The fingerprint must identify the content displayed by the cell as far as its height is concerned (e.g. the text
+ * it displays, an object identifier and its modification date, etc.). It must be a valid dictionary key. If nil, the
+ * height is measured but not cached
+ *
+ * Cached heights are discarded when a memory warning is received, or when calling +invalidateCachedHeights. This 
+ * method must only be called from the main thread.
+ * Not meant to be overridden
+ */
++ (CGFloat)heightForWidth:(CGFloat)width
+              fingerprint:(id<NSCopying>)fingerprint
+       configurationBlock:(void (^)(id cell))configurationBlock;
+
+/**
+ * Discard all heights cached for the receiver class (e.g. when the font size changes)
+ * Not meant to be overridden
+ */
++ (void)invalidateCachedHeights;
+
 /**
  * If the cell layout is created using Interface Builder, override this accessor to return the name of the associated xib
  * file. This is not needed if the xib file name is identical to the class name
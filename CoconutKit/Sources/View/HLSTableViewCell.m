@@ -12,13 +12,19 @@
 #import "HLSTableViewCell+Protected.h"
 #import "NSArray+HLSExtensions.h"
 #import "NSObject+HLSExtensions.h"
+#import "UIImage+HLSExtensions.h"
+#import "UINib+HLSExtensions.h"
 
 static NSMutableDictionary *s_classNameToSizeMap = nil;
+static NSMutableDictionary *s_classNameToPrototypeCellMap = nil;
+static NSMutableDictionary *s_classNameToHeightCacheMap = nil;
 
 @interface HLSTableViewCell ()
 
 + (NSString *)findNibName;
 
++ (void)heightCacheDidReceiveMemoryWarning:(NSNotification *)notification;
+
 @end
 
 @implementation HLSTableViewCell
@@ -34,6 +40,14 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     
     // The size map is common for the whole HLSTableViewCell inheritance hierarchy
     s_classNameToSizeMap = [[NSMutableDictionary dictionary] retain];
+    
+    // Height caches are common as well, and purged when memory gets low
+    s_classNameToPrototypeCellMap = [[NSMutableDictionary dictionary] retain];
+    s_classNameToHeightCacheMap = [[NSMutableDictionary dictionary] retain];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(heightCacheDidReceiveMemoryWarning:)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
 }
 
 + (id)cellForTableView:(UITableView *)tableView
@@ -47,7 +61,8 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
         
         // A xib file is used
         if (nibName) {
-            NSArray *bundleContents = [[NSBundle mainBundle] loadNibNamed:nibName owner:nil options:nil];
+            // The nib is cached and does not need to be parsed again for each new cell
+            NSArray *bundleContents = [[UINib cachedNibWithName:nibName bundle:nil] instantiateWithOwner:nil options:nil];
             if ([bundleContents count] == 0) {
                 HLSLoggerError(@"Missing cell object in xib file %@", nibName);
                 return nil;
@@ -86,7 +101,15 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     if (backgroundImageName) {
         UIImage *backgroundImage = [UIImage imageNamed:backgroundImageName];
         if (backgroundImage) {
-            self.backgroundView = [[[UIImageView alloc] initWithImage:backgroundImage] autorelease];
+            UIImageView *backgroundImageView = [[[UIImageView alloc] initWithImage:backgroundImage] autorelease];
+            self.backgroundView = backgroundImageView;
+            
+            // Decode in the background (done once since +imageNamed: caches images), and swap if still displayed
+            [backgroundImage decodeWithCompletionBlock:^(UIImage *decodedImage) {
+                if (backgroundImageView.image == backgroundImage) {
+                    backgroundImageView.image = decodedImage;
+                }
+            }];
         }
         else {
             HLSLoggerWarn(@"The image %@ does not exist", backgroundImageName);
@@ -98,13 +121,19 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     if (selectedBackgroundImageName) {
         UIImage *selectedBackgroundImage = [UIImage imageNamed:selectedBackgroundImageName];
         if (selectedBackgroundImage) {
-            self.selectedBackgroundView = [[[UIImageView alloc] initWithImage:selectedBackgroundImage] autorelease];
+            UIImageView *selectedBackgroundImageView = [[[UIImageView alloc] initWithImage:selectedBackgroundImage] autorelease];
+            self.selectedBackgroundView = selectedBackgroundImageView;
+            
+            [selectedBackgroundImage decodeWithCompletionBlock:^(UIImage *decodedImage) {
+                if (selectedBackgroundImageView.image == selectedBackgroundImage) {
+                    selectedBackgroundImageView.image = decodedImage;
+                }
+            }];
         }
         else {
-            HLSLoggerWarn(@"The image %@ does not exist", selectedBackgroundImage);
+            HLSLoggerWarn(@"The image %@ does not exist", selectedBackgroundImageName);
             self.selectedBackgroundView = nil;
         }
-        self.selectedBackgroundView = [[[UIImageView alloc] initWithImage:selectedBackgroundImage] autorelease];
     }
 }
 
@@ -134,6 +163,57 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     return [cellSizeValue CGSizeValue];
 }
 
++ (CGFloat)heightForWidth:(CGFloat)width
+              fingerprint:(id<NSCopying>)fingerprint
+       configurationBlock:(void (^)(id cell))configurationBlock
+{
+    // Cached heights are stored per width, then per fingerprint. Arrays cannot be used as composite keys since their
+    // hash is their count, which would make all keys collide
+    NSMutableDictionary *heightCache = [s_classNameToHeightCacheMap objectForKey:[self className]];
+    NSNumber *widthKey = [NSNumber numberWithFloat:width];
+    NSMutableDictionary *fingerprintToHeightMap = fingerprint ? [heightCache objectForKey:widthKey] : nil;
+    NSNumber *heightNumber = [fingerprintToHeightMap objectForKey:fingerprint];
+    if (heightNumber) {
+        return [heightNumber floatValue];
+    }
+    
+    // The prototype cell is created once per class; it is never displayed, only used for measurements
+    HLSTableViewCell *prototypeCell = [s_classNameToPrototypeCellMap objectForKey:[self className]];
+    if (! prototypeCell) {
+        prototypeCell = [self cellForTableView:nil];
+        if (! prototypeCell) {
+            return 0.f;
+        }
+        [s_classNameToPrototypeCellMap setObject:prototypeCell forKey:[self className]];
+    }
+    
+    prototypeCell.bounds = CGRectMake(0.f, 0.f, width, CGRectGetHeight(prototypeCell.bounds));
+    if (configurationBlock) {
+        configurationBlock(prototypeCell);
+    }
+    [prototypeCell layoutIfNeeded];
+    CGFloat height = [prototypeCell sizeThatFits:CGSizeMake(width, CGFLOAT_MAX)].height;
+    
+    if (fingerprint) {
+        if (! heightCache) {
+            heightCache = [NSMutableDictionary dictionary];
+            [s_classNameToHeightCacheMap setObject:heightCache forKey:[self className]];
+        }
+        if (! fingerprintToHeightMap) {
+            fingerprintToHeightMap = [NSMutableDictionary dictionary];
+            [heightCache setObject:fingerprintToHeightMap forKey:widthKey];
+        }
+        [fingerprintToHeightMap setObject:[NSNumber numberWithFloat:height] forKey:fingerprint];
+    }
+    
+    return height;
+}
+
++ (void)invalidateCachedHeights
+{
+    [s_classNameToHeightCacheMap removeObjectForKey:[self className]];
+}
+
 + (NSString *)nibName
 {
     // Return nil by default (since can be created programmatically)
@@ -162,4 +242,12 @@ static NSMutableDictionary *s_classNameToSizeMap = nil;
     return nibName;
 }
 
+#pragma mark Notification callbacks
+
++ (void)heightCacheDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [s_classNameToPrototypeCellMap removeAllObjects];
+    [s_classNameToHeightCacheMap removeAllObjects];
+}
+
 @end
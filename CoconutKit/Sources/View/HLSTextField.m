@@ -56,15 +56,30 @@ static CGFloat s_originalYOffset = 0.f;
  * supposed to look, which fields are grouped, etc.), we cannot simply adjust the parent view frame. What we need is a
  * way to identify which view up the caller hierarchy can be adjusted when some of its content needs to stay visible. 
  * The most natural such object is the scroll view.
+ *
+ * The scroll view is retained, since its offset is restored when scroll updates are performed, i.e. at the end of the
+ * run loop pass. By then, the form containing it might already have been torn down (e.g. a field resigns, then its
+ * view controller is popped)
  */
 static UIScrollView *s_scrollView = nil;
 
+/**
+ * Focus changes are not immediately reflected on the scroll view. When tabbing through a form, a field usually resigns
+ * before the next one becomes first responder, and each change would start a scroll animation of its own (the second
+ * one starting from an offset the first one has not reached yet). Scroll view updates are therefore coalesced and
+ * performed once per run loop pass, for the text field which is active at that time
+ */
+static BOOL s_scrollUpdateScheduled = NO;
+
 @interface HLSTextField ()
 
 @property (nonatomic, retain) HLSTextFieldTouchDetector *touchDetector;
 
 + (void)offsetScrollForTextField:(HLSTextField *)textField animated:(BOOL)animated;
 + (void)restoreScrollAnimated:(BOOL)animated;
++ (void)setNeedsScrollUpdate;
++ (void)cancelScrollUpdate;
++ (void)updateScroll;
 
 - (void)hlsTextFieldInit;
 
@@ -150,6 +165,22 @@ static UIScrollView *s_scrollView = nil;
     return touchDetector.delegate;
 }
 
+#pragma mark View lifecycle
+
+- (void)willMoveToWindow:(UIWindow *)newWindow
+{
+    [super willMoveToWindow:newWindow];
+    
+    // The form is going away, e.g. in the same run loop pass as the field resigned. The scheduled update would
+    // animate a scroll view which is not displayed anymore. Restore it now, unless another field has become active
+    if (! newWindow && (! s_currentTextField || s_currentTextField == self)) {
+        if (s_currentTextField == self) {
+            s_currentTextField = nil;
+        }
+        [HLSTextField cancelScrollUpdate];
+    }
+}
+
 #pragma mark Focus events
 
 - (BOOL)becomeFirstResponder
@@ -178,7 +209,7 @@ static UIScrollView *s_scrollView = nil;
     [super becomeFirstResponder];       // UITextField implementation always return YES, see documentation
     
     // Move the scroll view so that the field is visible (if not already)
-    [HLSTextField offsetScrollForTextField:self animated:YES];    
+    [HLSTextField setNeedsScrollUpdate];
     
     // Register for keyboard notifications so that the new responder can answer to keyboard events (the registration
     // is here carefully made so that those events always correspond to device rotation)
@@ -221,10 +252,11 @@ static UIScrollView *s_scrollView = nil;
     //     called when orientation changes)
     [super resignFirstResponder];       // UITextField implementation always return YES, see documentation
     
-    // The current HLSTextField is losing the focus, reset scroll view offset
+    // The current HLSTextField is losing the focus, reset scroll view offset (unless another field becomes active
+    // in the meantime)
     if (s_currentTextField == self) {
-        [HLSTextField restoreScrollAnimated:YES];
         s_currentTextField = nil;
+        [HLSTextField setNeedsScrollUpdate];
     }
     
     return YES;
@@ -260,10 +292,10 @@ static UIScrollView *s_scrollView = nil;
         else {
             s_originalYOffset = 0.f;
         }
+        
+        s_scrollView = [bottomMostscrollView retain];
     }
     
-    s_scrollView = bottomMostscrollView;
-    
     // If no scroll view found, we are done
     if (! s_scrollView) {
         return;
@@ -363,10 +395,57 @@ static UIScrollView *s_scrollView = nil;
                           animated:animated];
     
     // Done with the scroll view
+    [s_scrollView release];
     s_scrollView = nil;
     s_originalYOffset = 0.f;
 }
 
+/**
+ * Schedule a scroll view update at the end of the current run loop pass (if not already scheduled)
+ */
++ (void)setNeedsScrollUpdate
+{
+    if (s_scrollUpdateScheduled) {
+        return;
+    }
+    
+    s_scrollUpdateScheduled = YES;
+    [self performSelector:@selector(updateScroll) 
+               withObject:nil
+               afterDelay:0. 
+                  inModes:[NSArray arrayWithObject:NSRunLoopCommonModes]];
+}
+
+/**
+ * Cancel a scheduled scroll view update (if any), restoring the scroll view offset immediately
+ */
++ (void)cancelScrollUpdate
+{
+    if (! s_scrollUpdateScheduled) {
+        return;
+    }
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateScroll) object:nil];
+    s_scrollUpdateScheduled = NO;
+    
+    [self restoreScrollAnimated:NO];
+}
+
+/**
+ * Run a single scroll animation for all focus changes which occurred since the update was scheduled
+ */
++ (void)updateScroll
+{
+    s_scrollUpdateScheduled = NO;
+    
+    if (s_currentTextField && s_currentTextField.window) {
+        [self offsetScrollForTextField:s_currentTextField animated:YES];
+    }
+    else {
+        [self restoreScrollAnimated:YES];
+    }
+}
+
 #pragma mark Notification callbacks
 
 /**
@@ -9,6 +9,7 @@
 #import "UIActionSheet+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 // Keys for associated objects
 static void *s_ownerKey = &s_ownerKey;
@@ -35,6 +36,8 @@ static void swizzled_UIActionSheet__dismissWithClickedButtonIndex_animated_Imp(U
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UIActionSheet__showFromToolbar_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
                                                                                      @selector(showFromToolbar:), 
                                                                                      (IMP)swizzled_UIActionSheet__showFromToolbar_Imp);
@@ -53,6 +56,8 @@ static void swizzled_UIActionSheet__dismissWithClickedButtonIndex_animated_Imp(U
     s_UIActionSheet__dismissWithClickedButtonIndex_animated_Imp = (void (*)(id, SEL, NSInteger, BOOL))HLSSwizzleSelector(self,
                                                                                                                          @selector(dismissWithClickedButtonIndex:animated:), 
                                                                                                                          (IMP)swizzled_UIActionSheet__dismissWithClickedButtonIndex_animated_Imp);
+    
+    HLSStartupReportRecord("UIActionSheet+HLSExtensions", startTime);
 }
 
 #pragma mark Accessors and mutators
@@ -15,6 +15,11 @@
  */
 @interface UIBarButtonItem (HLSActionSheet)
 
+/**
+ * Swizzle the methods needed to trap taps on bar button items. Called when HLSActionSheet is first used
+ */
++ (void)injectActionSheetDismissal;
+
 - (void)dismissCurrentActionSheetAndForward:(id)sender;
 
 @end
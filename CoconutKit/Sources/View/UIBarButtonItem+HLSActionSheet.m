@@ -10,6 +10,7 @@
 
 #import "HLSActionSheet+Friend.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 #import "UIActionSheet+HLSExtensions.h"
 
 // Original implementation of the methods we swizzle
@@ -24,14 +25,24 @@ static id swizzled_UIBarButtonItem__target_Imp(UIBarButtonItem *self, SEL _cmd);
 
 #pragma mark Class methods
 
-+ (void)load
++ (void)injectActionSheetDismissal
 {
+    static BOOL s_injected = NO;
+    if (s_injected) {
+        return;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UIBarButtonItem__action_Imp = (SEL (*)(id, SEL))HLSSwizzleSelector(self, 
                                                                          @selector(action), 
                                                                          (IMP)swizzled_UIBarButtonItem__action_Imp);
     s_UIBarButtonItem__target_Imp = (id (*)(id, SEL))HLSSwizzleSelector(self, 
                                                                         @selector(target), 
                                                                         (IMP)swizzled_UIBarButtonItem__target_Imp);
+    
+    HLSStartupReportRecord("UIBarButtonItem+HLSActionSheet", startTime);
+    s_injected = YES;
 }
 
 #pragma mark Current action sheet dismissal
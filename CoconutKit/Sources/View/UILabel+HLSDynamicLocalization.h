@@ -45,6 +45,9 @@
  * This category integrates with HLSBundle+HLSDynamicLocalization so that localized labels are updated when the 
  * localization language is changed at runtime.
  *
+ * Label localization is enabled at launch, except if dynamic localization has been disabled in the Info.plist (see
+ * NSBundle+HLSDynamicLocalization.h).
+ *
  * This category currently has three limitations, but which should not be real issues:
  *   - only localization dictionaries in the main bundle are considered. For applications this should not be
  *     a problem since this is in general the only bundle you have. Libraries, on the other hand, might provide 
@@ -61,6 +64,12 @@
  */
 @interface UILabel (HLSDynamicLocalization)
 
+/**
+ * Label localization is automatically enabled at launch. If dynamic localization has been disabled in the Info.plist,
+ * call this method as soon as possible (i.e. before any nib is loaded) to enable label localization nonetheless
+ */
++ (void)enable;
+
 /**
  * When set to YES, reveals those labels for which a localization string is missing (for the current language)
  * (yellow background)
@@ -8,14 +8,28 @@
 
 #import "UILabel+HLSDynamicLocalization.h"
 
+#import <QuartzCore/QuartzCore.h>
+#import "HLSAllocationTracker+Friend.h"
 #import "HLSLabelLocalizationInfo.h"
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 #import "NSBundle+HLSDynamicLocalization.h"
 #import "NSDictionary+HLSExtensions.h"
 
 static BOOL s_missingLocalizationsVisible = NO;
 
+// Labels localized using prefixes, and which therefore must be updated when the localization changes. Labels are not
+// retained (they remove themselves when deallocated). Only a single notification observer is registered for all of
+// them, so that updates can be performed in one pass
+static CFMutableSetRef s_localizedLabels = NULL;
+
+// Standalone labels whose text has been set without localization prefix. Since localization information is assigned
+// permanently, these labels (most notably those created by UIKit) will never be localized and can skip the whole
+// localization machinery, which matters since -setText: is called very often (e.g. when scrolling). Checking the
+// set is much cheaper than looking up the localization information. Labels are not retained
+static CFMutableSetRef s_unlocalizedLabels = NULL;
+
 // Keys for associated objects
 static void *s_localizationInfosKey = &s_localizationInfosKey;
 static void *s_originalBackgroundColorKey = &s_originalBackgroundColorKey;
@@ -40,7 +54,9 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
 - (void)setAndLocalizeText:(NSString *)text;
 - (void)localizeTextWithLocalizationInfo:(HLSLabelLocalizationInfo *)localizationInfo;
 
-- (void)currentLocalizationDidChange:(NSNotification *)notification;
+- (void)relocalizeText;
+
++ (void)currentLocalizationDidChange:(NSNotification *)notification;
 
 @end
 
@@ -48,6 +64,44 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
 
 #pragma mark Class methods
 
++ (void)enable
+{
+    // Methods must be swizzled on UILabel itself, even if called on a subclass
+    if (self != [UILabel class]) {
+        [UILabel enable];
+        return;
+    }
+    
+    if (s_localizedLabels) {
+        HLSLoggerInfo(@"Label localization already enabled");
+        return;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
+    s_UILabel__dealloc_Imp = (void (*)(id, SEL))HLSSwizzleSelector(self, 
+                                                                   @selector(dealloc), 
+                                                                   (IMP)swizzled_UILabel__dealloc_Imp);
+    s_UILabel__awakeFromNib_Imp = (void (*)(id, SEL))HLSSwizzleSelector(self, 
+                                                                        @selector(awakeFromNib),
+                                                                        (IMP)swizzled_UILabel__awakeFromNib_Imp);
+    s_UILabel__setText_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
+                                                                       @selector(setText:), 
+                                                                       (IMP)swizzled_UILabel__setText_Imp);
+    s_UILabel__setBackgroundColor_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self,
+                                                                                  @selector(setBackgroundColor:),
+                                                                                  (IMP)swizzled_UILabel__setBackgroundColor_Imp);
+    
+    s_localizedLabels = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    s_unlocalizedLabels = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(currentLocalizationDidChange:)
+                                                 name:HLSCurrentLocalizationDidChangeNotification
+                                               object:nil];
+    
+    HLSStartupReportRecord("UILabel+HLSDynamicLocalization", startTime);
+}
+
 + (void)setMissingLocalizationsVisible:(BOOL)visible
 {
     s_missingLocalizationsVisible = visible;
@@ -69,18 +123,14 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
 
 + (void)load
 {
-    s_UILabel__dealloc_Imp = (void (*)(id, SEL))HLSSwizzleSelector(self, 
-                                                                   @selector(dealloc), 
-                                                                   (IMP)swizzled_UILabel__dealloc_Imp);
-    s_UILabel__awakeFromNib_Imp = (void (*)(id, SEL))HLSSwizzleSelector(self, 
-                                                                        @selector(awakeFromNib),
-                                                                        (IMP)swizzled_UILabel__awakeFromNib_Imp);
-    s_UILabel__setText_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
-                                                                       @selector(setText:), 
-                                                                       (IMP)swizzled_UILabel__setText_Imp);
-    s_UILabel__setBackgroundColor_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self,
-                                                                                  @selector(setBackgroundColor:),
-                                                                                  (IMP)swizzled_UILabel__setBackgroundColor_Imp);
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    
+    // A warning is logged by NSBundle+HLSDynamicLocalization if disabled
+    if (! [[[NSBundle mainBundle] objectForInfoDictionaryKey:HLSDynamicLocalizationDisabledInfoKey] boolValue]) {
+        [UILabel enable];
+    }
+    
+    [pool drain];
 }
 
 #pragma mark Localization
@@ -161,15 +211,20 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
         localizationInfo = [[[HLSLabelLocalizationInfo alloc] initWithText:text] autorelease];
         [self setLocalizationInfo:localizationInfo];
         
-        // For labels localized with prefixes only: Listen to localization change notifications
+        // For labels localized with prefixes only: Update when the localization changes
         if ([localizationInfo isLocalized]) {
-            [[NSNotificationCenter defaultCenter] addObserver:self 
-                                                     selector:@selector(currentLocalizationDidChange:) 
-                                                         name:HLSCurrentLocalizationDidChangeNotification 
-                                                       object:nil];
+            CFSetAddValue(s_localizedLabels, self);
         }
     }
     
+    // Labels without superview might still be added to a button later, and button labels store their information
+    // per state. Only standalone labels already in a view hierarchy can be flagged. Labels created by UIKit (e.g. cell
+    // labels) usually receive their text before being added to their superview, and are flagged the next time their
+    // text is set
+    if (! [localizationInfo isLocalized] && [self superview] && ! [[self superview] isKindOfClass:[UIButton class]]) {
+        CFSetAddValue(s_unlocalizedLabels, self);
+    }
+    
     // Prevent the call to -[UIButton setTitle:forState:] in localizeTextWithLocalizationInfo: from ending
     // up in an infinite recursion
     if (localizationInfo.locked) {
@@ -218,9 +273,7 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
     }
 }
 
-#pragma mark Notification callbacks
-
-- (void)currentLocalizationDidChange:(NSNotification *)notification
+- (void)relocalizeText
 {
     HLSLabelLocalizationInfo *localizationInfo = [self localizationInfo];
     if ([localizationInfo isLocalized]) {
@@ -228,13 +281,50 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
     }
 }
 
+#pragma mark Notification callbacks
+
++ (void)currentLocalizationDidChange:(NSNotification *)notification
+{
+    // Work on a snapshot, since labels might be created or destroyed while texts are updated
+    NSArray *localizedLabels = [(NSSet *)s_localizedLabels allObjects];
+    if ([localizedLabels count] == 0) {
+        return;
+    }
+    
+    // Group labels by table, so that each strings table is looked up in a row
+    NSMutableDictionary *tableToLabelsMap = [NSMutableDictionary dictionary];
+    for (UILabel *label in localizedLabels) {
+        HLSLabelLocalizationInfo *localizationInfo = [label localizationInfo];
+        if (! [localizationInfo isLocalized]) {
+            continue;
+        }
+        
+        id tableKey = localizationInfo.table ? (id)localizationInfo.table : (id)[NSNull null];
+        NSMutableArray *labels = [tableToLabelsMap objectForKey:tableKey];
+        if (! labels) {
+            labels = [NSMutableArray array];
+            [tableToLabelsMap setObject:labels forKey:tableKey];
+        }
+        [labels addObject:label];
+    }
+    
+    // Update all labels within a single transaction, so that all changes are committed (and rendered) at once
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (NSArray *labels in [tableToLabelsMap allValues]) {
+        NSAutoreleasePool *pool = HLSAutoreleasePoolPush(HLSAllocationSubsystemLocalization);
+        [labels makeObjectsPerformSelector:@selector(relocalizeText)];
+        HLSAutoreleasePoolPop(pool);
+    }
+    [CATransaction commit];
+}
+
 @end
 
 static void swizzled_UILabel__dealloc_Imp(UILabel *self, SEL _cmd)
 {
-    [[NSNotificationCenter defaultCenter] removeObserver:self 
-                                                    name:HLSCurrentLocalizationDidChangeNotification 
-                                                  object:nil];
+    CFSetRemoveValue(s_localizedLabels, self);
+    CFSetRemoveValue(s_unlocalizedLabels, self);
     
     (*s_UILabel__dealloc_Imp)(self, _cmd);
 }
@@ -243,12 +333,23 @@ static void swizzled_UILabel__awakeFromNib_Imp(UILabel *self, SEL _cmd)
 {
     (*s_UILabel__awakeFromNib_Imp)(self, _cmd);
     
+    if (CFSetContainsValue(s_unlocalizedLabels, self)) {
+        return;
+    }
+    
     // Here self.text returns the string filled by deserialization from the nib (which is not set using setText:)
     [self setAndLocalizeText:self.text];
 }
 
 static void swizzled_UILabel__setText_Imp(UILabel *self, SEL _cmd, NSString *text)
 {
+    HLSProfileSwizzledSelector([UILabel class], @selector(setText:));
+    
+    if (CFSetContainsValue(s_unlocalizedLabels, self)) {
+        (*s_UILabel__setText_Imp)(self, _cmd, text);
+        return;
+    }
+    
     [self setAndLocalizeText:text];
 }
 
@@ -256,6 +357,11 @@ static void swizzled_UILabel__setBackgroundColor_Imp(UILabel *self, SEL _cmd, UI
 {
     (*s_UILabel__setBackgroundColor_Imp)(self, _cmd, backgroundColor);
     
+    // The original color only needs to be saved for labels which might get localized
+    if (CFSetContainsValue(s_unlocalizedLabels, self)) {
+        return;
+    }
+    
     // The background color is stored as separate associated object, not in the HLSLabelLocalizationInfo object. The reason
     // is that the HLSLabelLocalizationInfo is only attached when the text is first set, while the background color is
     // usually set earlier (i.e. when this object is not available)
@@ -9,6 +9,7 @@
 #import "UINavigationBar+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 #import "UIView+HLSExtensions.h"
 
 /**
@@ -38,6 +39,8 @@ static void swizzled_UINavigationBar__sendSubviewToBack_Imp(UINavigationBar *sel
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UINavigationBar__insertSubview_atIndex_Imp = (void (*)(id, SEL, id, NSInteger))HLSSwizzleSelector(self, 
                                                                                                         @selector(insertSubview:atIndex:), 
                                                                                                         (IMP)swizzled_UINavigationBar__insertSubview_atIndex_Imp);
@@ -47,6 +50,8 @@ static void swizzled_UINavigationBar__sendSubviewToBack_Imp(UINavigationBar *sel
     s_UINavigationBar__sendSubviewToBack_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
                                                                                          @selector(sendSubviewToBack:), 
                                                                                          (IMP)swizzled_UINavigationBar__sendSubviewToBack_Imp);
+    
+    HLSStartupReportRecord("UINavigationBar+HLSExtensions", startTime);
 }
 
 #pragma mark Accessors and mutators
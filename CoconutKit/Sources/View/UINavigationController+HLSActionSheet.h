@@ -13,4 +13,9 @@
  */
 @interface UINavigationController (HLSActionSheet)
 
+/**
+ * Swizzle the methods needed to trap back navigation. Called when HLSActionSheet is first used
+ */
++ (void)injectActionSheetDismissal;
+
 @end
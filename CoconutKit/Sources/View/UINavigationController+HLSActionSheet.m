@@ -10,6 +10,7 @@
 
 #import "HLSActionSheet+Friend.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 // Original implementation of the methods we swizzle
 static BOOL (*s_UINavigationController__navigationBar_shouldPopItem_Imp)(id, SEL, id, id) = NULL;
@@ -19,11 +20,21 @@ static BOOL swizzled_UINavigationController__navigationBar_shouldPopItem_Imp(UIN
 
 @implementation UINavigationController (HLSActionSheet)
 
-+ (void)load
++ (void)injectActionSheetDismissal
 {
+    static BOOL s_injected = NO;
+    if (s_injected) {
+        return;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UINavigationController__navigationBar_shouldPopItem_Imp = (BOOL (*)(id, SEL, id, id))HLSSwizzleSelector(self, 
                                                                                                               @selector(navigationBar:shouldPopItem:), 
                                                                                                               (IMP)swizzled_UINavigationController__navigationBar_shouldPopItem_Imp);
+    
+    HLSStartupReportRecord("UINavigationController+HLSActionSheet", startTime);
+    s_injected = YES;
 }
 
 @end
@@ -27,7 +27,9 @@
  * scroll views will go on scrolling when the master view bounces, otherwise they will stop.
  *
  * This method only synchronizes scrolling between scroll views. You still have to align them properly
- * and to set their respective content sizes to get the result you want.
+ * and to set their respective content sizes to get the result you want. Synchronized scroll views are only updated
+ * when the relative content offset of the master changes. If you change their content size afterwards, call this
+ * method again to update them.
  */
 - (void)synchronizeWithScrollViews:(NSArray *)scrollViews bounces:(BOOL)bounces;
 
@@ -13,6 +13,7 @@
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
 #import <objc/runtime.h>
+#import <QuartzCore/QuartzCore.h>
 
 /**
  * There are at least three way to detect contentOffset changes of the master view:
@@ -22,11 +23,17 @@
  *   - use KVO on contentOffset. The problem is that the observeValue... method to implement could be overridden by
  *     existing subclasses of UIScrollView, or even by categories. This is clearly not robust enough
  *   - swizzling contentOffset mutators. This is the safest approach which has been retained here
+ *
+ * Since swizzling affects all scroll views in the application, it is only performed when a synchronization is set up
+ * for the first time. Applications not using synchronization therefore do not pay anything. Afterwards, scroll views
+ * which do not take part in any synchronization only pay for a counter check as long as no synchronization exists
  */
 
 // Associated object keys
-static void *s_synchronizedScrollViewsKey = &s_synchronizedScrollViewsKey;
-static void *s_parallaxBouncesKey = &s_parallaxBouncesKey;
+static void *s_synchronizationKey = &s_synchronizationKey;
+
+// Number of master scroll views. Avoids associated object lookups when no scroll views are synchronized
+static NSUInteger s_synchronizationCount = 0;
 
 // Original implementation of the methods we swizzle
 static void (*s_UIScrollView__setContentOffset_Imp)(id, SEL, CGPoint) = NULL;
@@ -34,8 +41,32 @@ static void (*s_UIScrollView__setContentOffset_Imp)(id, SEL, CGPoint) = NULL;
 // Swizzled method implementations
 static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL _cmd, CGPoint contentOffset);
 
+/**
+ * Private class storing the synchronization settings of a master scroll view
+ */
+@interface HLSScrollViewSynchronization : NSObject {
+@private
+    NSArray *m_scrollViews;
+    BOOL m_bounces;
+    CGPoint m_relativePosition;
+    BOOL m_relativePositionValid;
+}
+
+- (id)initWithScrollViews:(NSArray *)scrollViews bounces:(BOOL)bounces;
+
+@property (nonatomic, readonly, retain) NSArray *scrollViews;
+@property (nonatomic, readonly, assign) BOOL bounces;
+
+// The relative position most recently applied to the synchronized scroll views
+@property (nonatomic, assign) CGPoint relativePosition;
+@property (nonatomic, assign, getter=isRelativePositionValid) BOOL relativePositionValid;
+
+@end
+
 @interface UIScrollView (HLSExtensionsPrivate)
 
++ (void)swizzleContentOffsetMutator;
+
 - (void)synchronizeScrolling;
 
 @end
@@ -58,14 +89,18 @@ static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL
         return;
     }
     
-    objc_setAssociatedObject(self, s_synchronizedScrollViewsKey, scrollViews, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    objc_setAssociatedObject(self, s_parallaxBouncesKey, [NSNumber numberWithBool:bounces], OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    [UIScrollView swizzleContentOffsetMutator];
+    
+    HLSScrollViewSynchronization *synchronization = [[[HLSScrollViewSynchronization alloc] initWithScrollViews:scrollViews 
+                                                                                                       bounces:bounces] autorelease];
+    objc_setAssociatedObject(self, s_synchronizationKey, synchronization, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    [self synchronizeScrolling];
 }
 
 - (void)removeSynchronization
 {
-    objc_setAssociatedObject(self, s_synchronizedScrollViewsKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
-    objc_setAssociatedObject(self, s_parallaxBouncesKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    objc_setAssociatedObject(self, s_synchronizationKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 }
 
 @end
@@ -74,19 +109,26 @@ static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL
 
 #pragma mark Class methods
 
-+ (void)load
++ (void)swizzleContentOffsetMutator
 {
-    s_UIScrollView__setContentOffset_Imp = (void (*)(id, SEL, CGPoint))HLSSwizzleSelector(self, 
-                                                                                          @selector(setContentOffset:), 
-                                                                                          (IMP)swizzled_UIScrollView__setContentOffset_Imp);
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_UIScrollView__setContentOffset_Imp = (void (*)(id, SEL, CGPoint))HLSSwizzleSelector([UIScrollView class], 
+                                                                                              @selector(setContentOffset:), 
+                                                                                              (IMP)swizzled_UIScrollView__setContentOffset_Imp);
+    });
 }
 
 #pragma mark Scrolling synchronization
 
 - (void)synchronizeScrolling
 {
-    NSArray *synchronizedScrollViews = objc_getAssociatedObject(self, s_synchronizedScrollViewsKey);
-    if (! synchronizedScrollViews) {
+    if (s_synchronizationCount == 0) {
+        return;
+    }
+    
+    HLSScrollViewSynchronization *synchronization = objc_getAssociatedObject(self, s_synchronizationKey);
+    if (! synchronization) {
         return;
     }
     
@@ -109,8 +151,7 @@ static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL
     
     // If reaching the top or the bottom of the master scroll view, prevent the other scroll views from
     // scrolling further (if enabled)
-    BOOL bounces = [objc_getAssociatedObject(self, s_parallaxBouncesKey) boolValue];
-    if (! bounces) {
+    if (! synchronization.bounces) {
         if (floatlt(relativeXPos, 0.f)) {
             relativeXPos = 0.f;
         }
@@ -126,20 +167,86 @@ static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL
         }            
     }
     
-    // Apply the same relative offset position to all scroll views to keep in sync
-    for (UIScrollView *scrollView in synchronizedScrollViews) {
+    // Nothing to do if the relative position has not changed (e.g. the master has been scrolled beyond its bounds
+    // without bouncing synchronized scroll views)
+    if (synchronization.relativePositionValid
+            && floateq(relativeXPos, synchronization.relativePosition.x)
+            && floateq(relativeYPos, synchronization.relativePosition.y)) {
+        return;
+    }
+    synchronization.relativePosition = CGPointMake(relativeXPos, relativeYPos);
+    synchronization.relativePositionValid = YES;
+    
+    // Apply the same relative offset position to all scroll views to keep in sync. The content offset of a scroll view
+    // is the origin of its bounds. Setting it on the layer directly (without implicit animations) is much cheaper than
+    // going through -setContentOffset:. This is only possible for plain scroll views without delegate, though: Master
+    // scroll views must synchronize their own scroll views, delegates expect -scrollViewDidScroll: to be called, and
+    // subclasses (e.g. table views, which tile their cells) react to offset changes
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (UIScrollView *scrollView in synchronization.scrollViews) {
         CGFloat xPos = relativeXPos * (scrollView.contentSize.width - CGRectGetWidth(scrollView.frame));
         CGFloat yPos = relativeYPos * (scrollView.contentSize.height - CGRectGetHeight(scrollView.frame));
-        scrollView.contentOffset = CGPointMake(xPos, yPos);
+        if ([scrollView class] != [UIScrollView class]
+                || scrollView.delegate
+                || objc_getAssociatedObject(scrollView, s_synchronizationKey)) {
+            scrollView.contentOffset = CGPointMake(xPos, yPos);
+        }
+        else {
+            CGRect bounds = scrollView.layer.bounds;
+            scrollView.layer.bounds = CGRectMake(xPos, yPos, CGRectGetWidth(bounds), CGRectGetHeight(bounds));
+        }
     }
+    [CATransaction commit];
 }
 
 @end
 
+#pragma mark -
+#pragma mark HLSScrollViewSynchronization class implementation
+
+@implementation HLSScrollViewSynchronization
+
+#pragma mark Object creation and destruction
+
+- (id)initWithScrollViews:(NSArray *)scrollViews bounces:(BOOL)bounces
+{
+    if ((self = [super init])) {
+        m_scrollViews = [scrollViews copy];
+        m_bounces = bounces;
+        ++s_synchronizationCount;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    --s_synchronizationCount;
+    
+    [m_scrollViews release];
+    m_scrollViews = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize scrollViews = m_scrollViews;
+
+@synthesize bounces = m_bounces;
+
+@synthesize relativePosition = m_relativePosition;
+
+@synthesize relativePositionValid = m_relativePositionValid;
+
+@end
+
 #pragma mark Swizzled method implementations
 
 static void swizzled_UIScrollView__setContentOffset_Imp(UIScrollView *self, SEL _cmd, CGPoint contentOffset)
 {
+    HLSProfileSwizzledSelector([UIScrollView class], @selector(setContentOffset:));
+    
     (*s_UIScrollView__setContentOffset_Imp)(self, _cmd, contentOffset);
     [self synchronizeScrolling];
 }
@@ -9,6 +9,7 @@
 #import "UITextField+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 static UITextField *s_currentTextField = nil;           // weak ref to the current first responder
 
@@ -26,12 +27,16 @@ static BOOL swizzled_UITextField__resignFirstResponder_Imp(UITextField *self, SE
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UITextField__becomeFirstResponder_Imp = (BOOL (*)(id, SEL))HLSSwizzleSelector(self,
                                                                                     @selector(becomeFirstResponder), 
                                                                                     (IMP)swizzled_UITextField__becomeFirstResponder_Imp);
     s_UITextField__resignFirstResponder_Imp = (BOOL (*)(id, SEL))HLSSwizzleSelector(self,
                                                                                     @selector(resignFirstResponder), 
                                                                                     (IMP)swizzled_UITextField__resignFirstResponder_Imp);
+    
+    HLSStartupReportRecord("UITextField+HLSExtensions", startTime);
 }
 
 + (UITextField *)currentTextField
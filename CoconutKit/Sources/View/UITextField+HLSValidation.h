@@ -57,6 +57,21 @@
 - (BOOL)isCheckingOnChange;
 - (void)setCheckingOnChange:(BOOL)checkingOnChange;
 
+/**
+ * When checking on change, validation is debounced: Changes are coalesced and only the latest text is formatted and
+ * validated, once no change has been made for the specified delay (default is 0.3 seconds, 0 checks at each change)
+ */
+- (NSTimeInterval)checkingOnChangeDelay;
+- (void)setCheckingOnChangeDelay:(NSTimeInterval)checkingOnChangeDelay;
+
+/**
+ * When checking on change, a regular expression which the whole text must match can be provided as cheap syntactic
+ * pre-check. It is evaluated immediately at each change, and formatting is reported as failed to the validation 
+ * delegate if the text does not match. Formatting and validation are only performed for text which matches
+ */
+- (NSRegularExpression *)inputRegularExpression;
+- (void)setInputRegularExpression:(NSRegularExpression *)inputRegularExpression;
+
 @end
 
 /**
@@ -95,6 +110,18 @@
  */
 - (BOOL)checkTextFields;
 
+/**
+ * Check all text fields in the receiver view hierarchy and update the managed objects they are bound to, performing
+ * a single validation pass per object instead of one validation per field. For each object, the values displayed by 
+ * its text fields are formatted and applied at once, the object is checked as a whole (-check:), and the errors are
+ * reported to the validation delegates of the corresponding fields. Fields which cannot be formatted are not applied.
+ * This is best suited to validate long forms bound to the same object. 
+ *
+ * Returns YES iff all fields and objects are valid. The errors returned by -check: (which include consistency errors
+ * not related to a specific field) are returned by reference
+ */
+- (BOOL)checkTextFieldsInBatch:(NSError **)pError;
+
 @end
 
 @interface UIViewController (HLSValidation)
@@ -104,4 +131,9 @@
  */
 - (BOOL)checkTextFields;
 
+/**
+ * Same as -[UIView checkTextFieldsInBatch:], but applied to a view controller's view
+ */
+- (BOOL)checkTextFieldsInBatch:(NSError **)pError;
+
 @end
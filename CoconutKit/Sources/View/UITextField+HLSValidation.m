@@ -10,6 +10,8 @@
 
 #import "HLSManagedTextFieldValidator.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
+#import "NSArray+HLSExtensions.h"
 
 #import <objc/runtime.h>
 
@@ -26,6 +28,10 @@ static id<UITextFieldDelegate> swizzled_UITextField__delegate_Imp(UITextField *s
 static void swizzled_UITextField__setDelegate_Imp(UITextField *self, SEL _cmd, id<UITextFieldDelegate> delegate);
 static void swizzled_UITextField__setText_Imp(UITextField *self, SEL _cmd, NSString *text);
 
+// Static functions
+static void injectTextFieldValidation(void);
+static void addValidatorsInViewHierarchy(UIView *view, NSMutableArray *validators);
+
 // Extern declarations
 extern BOOL injectedManagedObjectValidation(void);
 
@@ -34,21 +40,6 @@ extern BOOL injectedManagedObjectValidation(void);
 
 @implementation UITextField (HLSValidation)
 
-#pragma mark Class methods
-
-+ (void)load
-{
-    s_UITextField__delegate_Imp = (id<UITextFieldDelegate> (*)(id, SEL))HLSSwizzleSelector(self,
-                                                                                           @selector(delegate), 
-                                                                                           (IMP)swizzled_UITextField__delegate_Imp);
-    s_UITextField__setDelegate_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
-                                                                               @selector(setDelegate:), 
-                                                                               (IMP)swizzled_UITextField__setDelegate_Imp);
-    UITextField__setText_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self, 
-                                                                         @selector(setText:), 
-                                                                         (IMP)swizzled_UITextField__setText_Imp);
-}
-
 #pragma mark Binding to managed object fields
 
 - (void)bindToManagedObject:(NSManagedObject *)managedObject
@@ -58,6 +49,9 @@ extern BOOL injectedManagedObjectValidation(void);
 {
     NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
     
+    // Text field methods are only swizzled when the first text field gets bound. Before, all text fields behave as usual
+    injectTextFieldValidation();
+    
     // First unbind any bound field
     [self unbind];
     
@@ -97,6 +91,7 @@ extern BOOL injectedManagedObjectValidation(void);
     
     // Restore the original delegate
     HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(self, s_validatorKey);
+    [validator cancelPendingCheck];
     (*s_UITextField__setDelegate_Imp)(self, @selector(setDelegate:), validator.delegate);
     
     // Remove the validator
@@ -129,6 +124,54 @@ extern BOOL injectedManagedObjectValidation(void);
     validator.checkingOnChange = checkingOnChange;
 }
 
+- (NSTimeInterval)checkingOnChangeDelay
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(self, s_validatorKey);
+    if (! validator) {
+        return 0.;
+    }
+    
+    return validator.checkingOnChangeDelay;
+}
+
+- (void)setCheckingOnChangeDelay:(NSTimeInterval)checkingOnChangeDelay
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(self, s_validatorKey);
+    if (! validator) {
+        return;
+    }
+    
+    validator.checkingOnChangeDelay = checkingOnChangeDelay;
+}
+
+- (NSRegularExpression *)inputRegularExpression
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(self, s_validatorKey);
+    if (! validator) {
+        return nil;
+    }
+    
+    return validator.inputRegularExpression;
+}
+
+- (void)setInputRegularExpression:(NSRegularExpression *)inputRegularExpression
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(self, s_validatorKey);
+    if (! validator) {
+        return;
+    }
+    
+    validator.inputRegularExpression = inputRegularExpression;
+}
+
 @end
 
 #pragma mark -
@@ -159,6 +202,94 @@ extern BOOL injectedManagedObjectValidation(void);
     return valid;
 }
 
+- (BOOL)checkTextFieldsInBatch:(NSError **)pError
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    NSMutableArray *validators = [NSMutableArray array];
+    addValidatorsInViewHierarchy(self, validators);
+    
+    // Group validators by managed object (in the order in which objects are found)
+    NSMutableArray *managedObjects = [NSMutableArray array];
+    CFMutableDictionaryRef managedObjectToValidatorsMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    for (HLSManagedTextFieldValidator *validator in validators) {
+        NSMutableArray *objectValidators = (NSMutableArray *)CFDictionaryGetValue(managedObjectToValidatorsMap, validator.managedObject);
+        if (! objectValidators) {
+            objectValidators = [NSMutableArray array];
+            CFDictionarySetValue(managedObjectToValidatorsMap, validator.managedObject, objectValidators);
+            [managedObjects addObject:validator.managedObject];
+        }
+        [objectValidators addObject:validator];
+    }
+    
+    BOOL valid = YES;
+    NSMutableArray *errors = [NSMutableArray array];
+    for (NSManagedObject *managedObject in managedObjects) {
+        NSArray *objectValidators = (NSArray *)CFDictionaryGetValue(managedObjectToValidatorsMap, managedObject);
+        
+        // Format all displayed values first. Only values which changed need to be applied
+        NSMutableArray *formattedValidators = [NSMutableArray array];
+        NSMutableDictionary *keyedValues = [NSMutableDictionary dictionary];
+        for (HLSManagedTextFieldValidator *validator in objectValidators) {
+            [validator cancelPendingCheck];
+            
+            id value = nil;
+            if (! [validator getValue:&value forString:validator.textField.text]) {
+                valid = NO;
+                continue;
+            }
+            [formattedValidators addObject:validator];
+            
+            id currentValue = [managedObject valueForKey:validator.fieldName];
+            if (value != currentValue && ! [value isEqual:currentValue]) {
+                [keyedValues setObject:(value ? value : [NSNull null]) forKey:validator.fieldName];
+            }
+        }
+        
+        // Apply all values at once, without triggering validation for each field
+        for (HLSManagedTextFieldValidator *validator in objectValidators) {
+            validator.batchChecking = YES;
+        }
+        [managedObject setValuesForKeysWithDictionary:keyedValues];
+        for (HLSManagedTextFieldValidator *validator in objectValidators) {
+            validator.batchChecking = NO;
+        }
+        
+        // Check the object once, and distribute the errors to the fields
+        NSError *error = nil;
+        NSDictionary *fieldErrors = nil;
+        if (! [managedObject check:&error fieldErrors:&fieldErrors]) {
+            if (error) {
+                [errors addObject:error];
+            }
+            valid = NO;
+        }
+        
+        for (HLSManagedTextFieldValidator *validator in formattedValidators) {
+            NSError *fieldError = [fieldErrors objectForKey:validator.fieldName];
+            [validator reportValidationResult:(fieldError == nil) error:fieldError];
+        }
+    }
+    
+    CFRelease(managedObjectToValidatorsMap);
+    
+    if (pError) {
+        if ([errors count] == 0) {
+            *pError = nil;
+        }
+        else if ([errors count] == 1) {
+            *pError = [errors firstObject_hls];
+        }
+        else {
+            *pError = [NSError errorWithDomain:NSCocoaErrorDomain
+                                          code:NSValidationMultipleErrorsError
+                                      userInfo:[NSDictionary dictionaryWithObject:errors forKey:NSDetailedErrorsKey]];
+        }
+    }
+    
+    return valid;
+}
+
 @end
 
 #pragma mark -
@@ -177,6 +308,20 @@ extern BOOL injectedManagedObjectValidation(void);
     return [self.view checkTextFields];
 }
 
+- (BOOL)checkTextFieldsInBatch:(NSError **)pError
+{
+    NSAssert(injectedManagedObjectValidation(), @"Managed object validation not injected. Call HLSEnableNSManagedObjectValidation first");
+    
+    if (! [self isViewLoaded]) {
+        if (pError) {
+            *pError = nil;
+        }
+        return NO;
+    }
+    
+    return [self.view checkTextFieldsInBatch:pError];
+}
+
 @end
 
 #pragma mark -
@@ -217,3 +362,41 @@ static void swizzled_UITextField__setText_Imp(UITextField *self, SEL _cmd, NSStr
         (*UITextField__setText_Imp)(self, _cmd, text);
     }    
 }
+
+#pragma mark Static functions
+
+static void injectTextFieldValidation(void)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        
+        Class textFieldClass = [UITextField class];
+        s_UITextField__delegate_Imp = (id<UITextFieldDelegate> (*)(id, SEL))HLSSwizzleSelector(textFieldClass,
+                                                                                               @selector(delegate), 
+                                                                                               (IMP)swizzled_UITextField__delegate_Imp);
+        s_UITextField__setDelegate_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(textFieldClass, 
+                                                                                   @selector(setDelegate:), 
+                                                                                   (IMP)swizzled_UITextField__setDelegate_Imp);
+        UITextField__setText_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(textFieldClass, 
+                                                                             @selector(setText:), 
+                                                                             (IMP)swizzled_UITextField__setText_Imp);
+        
+        HLSStartupReportRecord("UITextField+HLSValidation", startTime);
+    });
+}
+
+// Collect the validators of the bound text fields in a view hierarchy
+static void addValidatorsInViewHierarchy(UIView *view, NSMutableArray *validators)
+{
+    if ([view isKindOfClass:[UITextField class]]) {
+        HLSManagedTextFieldValidator *validator = objc_getAssociatedObject(view, s_validatorKey);
+        if (validator) {
+            [validators addObject:validator];
+        }
+    }
+    
+    for (UIView *subview in view.subviews) {
+        addValidatorsInViewHierarchy(subview, validators);
+    }
+}
@@ -9,6 +9,7 @@
 #import "UITextView+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 static UITextView *s_currentTextView = nil;           // weak ref to the current first responder
 
@@ -37,12 +38,16 @@ static BOOL swizzled_UITextView__resignFirstResponder_Imp(UITextView *self, SEL
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UITextView__becomeFirstResponder_Imp = (BOOL (*)(id, SEL))HLSSwizzleSelector(self, 
                                                                                    @selector(becomeFirstResponder), 
                                                                                    (IMP)swizzled_UITextView__becomeFirstResponder_Imp);
     s_UITextView__resignFirstResponder_Imp = (BOOL (*)(id, SEL))HLSSwizzleSelector(self, 
                                                                                    @selector(resignFirstResponder), 
                                                                                    (IMP)swizzled_UITextView__resignFirstResponder_Imp);
+    
+    HLSStartupReportRecord("UITextView+HLSExtensions", startTime);
 }
 
 @end
@@ -6,6 +6,8 @@
 //  Copyright 2011 Hortis. All rights reserved.
 //
 
+#import "UIImage+HLSExtensions.h"
+
 #define HLSViewAutoresizingAll UIViewAutoresizingFlexibleLeftMargin | UIViewAutoresizingFlexibleWidth |         \
     UIViewAutoresizingFlexibleRightMargin | UIViewAutoresizingFlexibleTopMargin |                               \
     UIViewAutoresizingFlexibleHeight | UIViewAutoresizingFlexibleBottomMargin
@@ -27,4 +29,43 @@
  */
 - (UIImage *)flattenedImage;
 
+/**
+ * Same as -flattenedImage, with a scale factor. See CALayer+HLSExtensions
+ */
+- (UIImage *)flattenedImageWithScale:(CGFloat)scale;
+
+/**
+ * Incrementally render the view and all its subviews in the view coordinate system (i.e. ignoring its frame and 
+ * transform, unlike -flattenedImage) and return the image to the completion block. Useful for large views. See 
+ * -[CALayer loadFlattenedContentImageWithScale:maximumBytes:completionBlock:]
+ */
+- (void)loadFlattenedContentImageWithScale:(CGFloat)scale 
+                              maximumBytes:(size_t)maximumBytes
+                           completionBlock:(HLSImageCompletionBlock)completionBlock;
+
+/**
+ * Return the receiver or the first of its descendants whose tag_hls is equal to the given string, nil if none. If the
+ * receiver is displayed by a window whose tag index is enabled (see UIWindow (HLSExtensions)), the view is found without
+ * traversing the view hierarchy (if several views have the same tag, which one is returned is then undefined). Otherwise
+ * the receiver subviews are searched depth-first
+ */
+- (UIView *)viewWithTag_hls:(NSString *)tag_hls;
+
+@end
+
+@interface UIWindow (HLSExtensions)
+
+/**
+ * Finding a view by tag_hls requires walking the view hierarchy, which gets expensive for large hierarchies. If this
+ * property is set to YES, the window maintains an index from tags to the views it displays, so that -viewWithTag_hls:
+ * does not need to traverse the hierarchy anymore. The index is updated when the tag of a view changes and when views
+ * are added to or removed from the window. Views are not retained by the index
+ *
+ * The index relies on -[UIView willMoveToWindow:] being called. If one of your view subclasses overrides this method,
+ * it must therefore call the super implementation. Tags must be set and looked up from the main thread
+ *
+ * Default is NO
+ */
+@property (nonatomic, assign, getter=isTagIndexEnabled_hls) BOOL tagIndexEnabled_hls;
+
 @end
@@ -11,12 +11,58 @@
 #import <objc/runtime.h>
 #import "CALayer+HLSExtensions.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
+// Associated object keys
 static void *s_tagKey = &s_tagKey;
 static void *s_userInfoKey = &s_userInfoKey;
+static void *s_tagIndexKey = &s_tagIndexKey;
+
+// Number of windows whose tag index is enabled (decremented when the index of a window is released, i.e. when the
+// index is disabled or when the window is deallocated). When 0, views moving between windows have nothing to do
+static NSUInteger s_indexedWindowCount = 0;
+
+// Original implementation of the methods we swizzle
+static void (*s_UIView__willMoveToWindow_Imp)(id, SEL, id) = NULL;
+
+// Swizzled method implementations
+static void swizzled_UIView__willMoveToWindow_Imp(UIView *self, SEL _cmd, UIWindow *newWindow);
+
+// Static functions
+static CFMutableDictionaryRef HLSWindowTagIndex(UIWindow *window);
+static void HLSWindowTagIndexAddView(UIWindow *window, UIView *view, NSString *tag);
+static void HLSWindowTagIndexRemoveView(UIWindow *window, UIView *view, NSString *tag);
+static void HLSWindowTagIndexAddViewHierarchy(CFMutableDictionaryRef tagIndex, UIView *view);
+
+/**
+ * Owns the tag index of a window, to which it is associated. Keeps track of the number of indexed windows
+ */
+@interface HLSWindowTagIndexOwner : NSObject {
+@private
+    CFMutableDictionaryRef m_tagIndex;
+}
+
+- (id)initWithTagIndex:(CFMutableDictionaryRef)tagIndex;
+
+@property (nonatomic, readonly, assign) CFMutableDictionaryRef tagIndex;
+
+@end
 
 @implementation UIView (HLSExtensions)
 
+#pragma mark Class methods
+
++ (void)load
+{
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
+    s_UIView__willMoveToWindow_Imp = (void (*)(id, SEL, id))HLSSwizzleSelector(self,
+                                                                               @selector(willMoveToWindow:),
+                                                                               (IMP)swizzled_UIView__willMoveToWindow_Imp);
+    
+    HLSStartupReportRecord("UIView+HLSExtensions", startTime);
+}
+
 #pragma mark Accessors and mutators
 
 - (NSString *)tag_hls
@@ -26,6 +72,17 @@ static void *s_userInfoKey = &s_userInfoKey;
 
 - (void)setTag_hls:(NSString *)tag_hls
 {
+    if (s_indexedWindowCount != 0) {
+        UIWindow *window = self.window;
+        NSString *previousTag = self.tag_hls;
+        if (previousTag) {
+            HLSWindowTagIndexRemoveView(window, self, previousTag);
+        }
+        if (tag_hls) {
+            HLSWindowTagIndexAddView(window, self, tag_hls);
+        }
+    }
+    
     objc_setAssociatedObject(self, s_tagKey, tag_hls, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
 }
 
@@ -44,4 +101,210 @@ static void *s_userInfoKey = &s_userInfoKey;
     return [self.layer flattenedImage];
 }
 
+- (UIImage *)flattenedImageWithScale:(CGFloat)scale
+{
+    return [self.layer flattenedImageWithScale:scale];
+}
+
+- (void)loadFlattenedContentImageWithScale:(CGFloat)scale 
+                              maximumBytes:(size_t)maximumBytes
+                           completionBlock:(HLSImageCompletionBlock)completionBlock
+{
+    [self.layer loadFlattenedContentImageWithScale:scale maximumBytes:maximumBytes completionBlock:completionBlock];
+}
+
+#pragma mark Finding views
+
+- (UIView *)viewWithTag_hls:(NSString *)tag_hls
+{
+    if (! tag_hls) {
+        return nil;
+    }
+    
+    if ([self.tag_hls isEqualToString:tag_hls]) {
+        return self;
+    }
+    
+    // Indexed window: Only views in the receiver hierarchy are eligible
+    CFMutableDictionaryRef tagIndex = HLSWindowTagIndex(self.window);
+    if (tagIndex) {
+        CFSetRef views = CFDictionaryGetValue(tagIndex, tag_hls);
+        if (! views) {
+            return nil;
+        }
+        
+        CFIndex count = CFSetGetCount(views);
+        const void **values = malloc(count * sizeof(const void *));
+        CFSetGetValues(views, values);
+        UIView *taggedView = nil;
+        for (CFIndex i = 0; i < count; ++i) {
+            UIView *view = (UIView *)values[i];
+            if ([view isDescendantOfView:self]) {
+                taggedView = view;
+                break;
+            }
+        }
+        free(values);
+        return taggedView;
+    }
+    
+    for (UIView *subview in self.subviews) {
+        UIView *taggedView = [subview viewWithTag_hls:tag_hls];
+        if (taggedView) {
+            return taggedView;
+        }
+    }
+    return nil;
+}
+
 @end
+
+@implementation UIWindow (HLSExtensions)
+
+#pragma mark Accessors and mutators
+
+- (BOOL)isTagIndexEnabled_hls
+{
+    return HLSWindowTagIndex(self) != NULL;
+}
+
+- (void)setTagIndexEnabled_hls:(BOOL)tagIndexEnabled_hls
+{
+    if (tagIndexEnabled_hls == self.tagIndexEnabled_hls) {
+        return;
+    }
+    
+    if (tagIndexEnabled_hls) {
+        // Tags are compared by value, views are neither retained nor compared by value
+        CFMutableDictionaryRef tagIndex = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks,
+                                                                    &kCFTypeDictionaryValueCallBacks);
+        HLSWindowTagIndexAddViewHierarchy(tagIndex, self);
+        
+        // The owner is released when the index is disabled or when the window is deallocated
+        HLSWindowTagIndexOwner *tagIndexOwner = [[[HLSWindowTagIndexOwner alloc] initWithTagIndex:tagIndex] autorelease];
+        objc_setAssociatedObject(self, s_tagIndexKey, tagIndexOwner, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        CFRelease(tagIndex);
+    }
+    else {
+        objc_setAssociatedObject(self, s_tagIndexKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+}
+
+@end
+
+@implementation HLSWindowTagIndexOwner
+
+#pragma mark Object creation and destruction
+
+- (id)initWithTagIndex:(CFMutableDictionaryRef)tagIndex
+{
+    if ((self = [super init])) {
+        m_tagIndex = (CFMutableDictionaryRef)CFRetain(tagIndex);
+        ++s_indexedWindowCount;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CFRelease(m_tagIndex);
+    --s_indexedWindowCount;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize tagIndex = m_tagIndex;
+
+@end
+
+#pragma mark Swizzled method implementations
+
+static void swizzled_UIView__willMoveToWindow_Imp(UIView *self, SEL _cmd, UIWindow *newWindow)
+{
+    (*s_UIView__willMoveToWindow_Imp)(self, _cmd, newWindow);
+    
+    if (s_indexedWindowCount == 0) {
+        return;
+    }
+    
+    UIWindow *window = self.window;
+    if (newWindow == window) {
+        return;
+    }
+    
+    NSString *tag = self.tag_hls;
+    if (! tag) {
+        return;
+    }
+    
+    HLSWindowTagIndexRemoveView(window, self, tag);
+    HLSWindowTagIndexAddView(newWindow, self, tag);
+}
+
+#pragma mark Static functions
+
+static CFMutableDictionaryRef HLSWindowTagIndex(UIWindow *window)
+{
+    if (! window || s_indexedWindowCount == 0) {
+        return NULL;
+    }
+    
+    HLSWindowTagIndexOwner *tagIndexOwner = objc_getAssociatedObject(window, s_tagIndexKey);
+    return tagIndexOwner.tagIndex;
+}
+
+static void HLSWindowTagIndexAddView(UIWindow *window, UIView *view, NSString *tag)
+{
+    CFMutableDictionaryRef tagIndex = HLSWindowTagIndex(window);
+    if (! tagIndex || view == window) {
+        return;
+    }
+    
+    // Sets are created lazily, and do not retain the views
+    CFMutableSetRef views = (CFMutableSetRef)CFDictionaryGetValue(tagIndex, tag);
+    if (! views) {
+        views = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        CFDictionarySetValue(tagIndex, tag, views);
+        CFRelease(views);
+    }
+    CFSetAddValue(views, view);
+}
+
+static void HLSWindowTagIndexRemoveView(UIWindow *window, UIView *view, NSString *tag)
+{
+    CFMutableDictionaryRef tagIndex = HLSWindowTagIndex(window);
+    if (! tagIndex) {
+        return;
+    }
+    
+    CFMutableSetRef views = (CFMutableSetRef)CFDictionaryGetValue(tagIndex, tag);
+    if (! views) {
+        return;
+    }
+    
+    CFSetRemoveValue(views, view);
+    if (CFSetGetCount(views) == 0) {
+        CFDictionaryRemoveValue(tagIndex, tag);
+    }
+}
+
+// Index all tagged views in a view hierarchy (the root view is not indexed if it is a window)
+static void HLSWindowTagIndexAddViewHierarchy(CFMutableDictionaryRef tagIndex, UIView *view)
+{
+    NSString *tag = view.tag_hls;
+    if (tag && ! [view isKindOfClass:[UIWindow class]]) {
+        CFMutableSetRef views = (CFMutableSetRef)CFDictionaryGetValue(tagIndex, tag);
+        if (! views) {
+            views = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+            CFDictionarySetValue(tagIndex, tag, views);
+            CFRelease(views);
+        }
+        CFSetAddValue(views, view);
+    }
+    
+    for (UIView *subview in view.subviews) {
+        HLSWindowTagIndexAddViewHierarchy(tagIndex, subview);
+    }
+}
@@ -9,6 +9,7 @@
 #import "UIWebView+HLSExtensions.h"
 
 #import "HLSLogger.h"
+#import "HLSStartupReport.h"
 
 #import <objc/runtime.h>
 
@@ -26,9 +27,13 @@ static UIScrollView *scrollView_Imp(UIWebView *self, SEL _cmd);
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     if (! class_getInstanceMethod(self, @selector(scrollView))) {
         class_addMethod(self, NSSelectorFromString(@"scrollView"), (IMP)scrollView_Imp, "@@:");
     }
+    
+    HLSStartupReportRecord("UIWebView+HLSExtensions", startTime);
 }
 
 #pragma mark Accessors and mutators
@@ -73,6 +73,7 @@
     UIViewAutoresizing m_originalAutoresizingMask;              // The view controller's view autoresizing mask prior to insertion
     BOOL m_movingToParentViewController;
     BOOL m_movingFromParentViewController;
+    NSTimeInterval m_removalTime;                               // The time (since the reference date) at which the view was last removed from a stack view
 }
 
 /**
@@ -81,6 +82,19 @@
  */
 + (UIViewController *)containerViewControllerKindOfClass:(Class)containerViewControllerClass forViewController:(UIViewController *)viewController;
 
+/**
+ * The number of view controllers currently managed by container content objects, and the number of their views currently
+ * added to container views. Meant for debugging tools (e.g. HLSPerformanceHUD)
+ */
++ (NSUInteger)managedViewControllerCount;
++ (NSUInteger)addedViewCount;
+
+/**
+ * Return an estimate of the memory (in bytes) used by a view, based on the backing stores of its layer hierarchy. Returns
+ * 0 if view is nil
+ */
++ (NSUInteger)estimatedFootprintForView:(UIView *)view;
+
 /**
  * Initialize a container content object. Expect the view controller to be managed (which is retained), the container 
  * in which it is inserted into (not retained), as well as the details of the transition animation with which it gets 
@@ -144,6 +158,18 @@
  */
 - (void)removeViewFromContainerStackView;
 
+/**
+ * The time (since the reference date) at which the view controller's view was last removed from its container stack 
+ * view, 0 if never
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval removalTime;
+
+/**
+ * Return an estimate of the memory (in bytes) used by the view controller's view, based on the backing stores of its
+ * layer hierarchy. Returns 0 if the view has not been loaded
+ */
+- (NSUInteger)estimatedViewFootprint;
+
 /**
  * Release all view and view-related resources. This also forwards the -viewWillUnload and -viewDidUnload
  * messages to the underlying view controller (this mechanism is deprecated starting with iOS 6)
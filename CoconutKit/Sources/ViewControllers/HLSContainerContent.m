@@ -14,12 +14,20 @@
 #import "HLSFloat.h"
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 #import "HLSTransition.h"
 #import "UIView+HLSExtensions.h"
 #import "UIViewController+HLSExtensions.h"
 
-// Keys for runtime container - view controller / view object association
-static void *s_containerContentKey = &s_containerContentKey;
+// View controller to container content side table. Lookups are performed each time the parent of a view controller is
+// needed, i.e. very often (for example during lifecycle event forwarding in nested containers). A CoreFoundation dictionary
+// comparing keys by pointer is used instead of associated objects, which are more costly to retrieve. Neither keys nor
+// values are retained (a container content object registers itself and unregisters itself when deallocated). Only
+// accessed from the main thread
+static CFMutableDictionaryRef s_viewControllerToContainerContentMap = NULL;
+
+// Number of view controller's views currently added to container stack views. Only accessed from the main thread
+static NSUInteger s_nbrAddedViews = 0;
 
 // Original implementation of the methods we swizzle
 static id (*s_UIViewController__parentViewController_Imp)(id, SEL) = NULL;
@@ -37,6 +45,10 @@ static void iOS4_UIViewController__didMoveToParentViewController_Imp(UIViewContr
 static BOOL iOS4_UIViewController__isMovingToParentViewController_Imp(UIViewController *self, SEL _cmd);
 static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewController *self, SEL _cmd);
 
+// Helper functions
+static HLSContainerContent *HLSContainerContentForViewController(UIViewController *viewController);
+static NSUInteger HLSLayerEstimatedFootprint(CALayer *layer);
+
 @interface HLSContainerContent ()
 
 @property (nonatomic, retain) UIViewController *viewController;
@@ -49,6 +61,7 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
 @property (nonatomic, assign) UIViewAutoresizing originalAutoresizingMask;
 @property (nonatomic, assign) BOOL movingToParentViewController;
 @property (nonatomic, assign) BOOL movingFromParentViewController;
+@property (nonatomic, assign) NSTimeInterval removalTime;
 
 @end
 
@@ -79,7 +92,7 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
 
 + (UIViewController *)containerViewControllerKindOfClass:(Class)containerViewControllerClass forViewController:(UIViewController *)viewController
 {
-    HLSContainerContent *containerContent = objc_getAssociatedObject(viewController, s_containerContentKey);
+    HLSContainerContent *containerContent = HLSContainerContentForViewController(viewController);
     if (containerViewControllerClass) {
         if ([containerContent.containerViewController isKindOfClass:containerViewControllerClass]) {
             return containerContent.containerViewController;
@@ -93,6 +106,21 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
     }
 }
 
++ (NSUInteger)managedViewControllerCount
+{
+    return s_viewControllerToContainerContentMap ? CFDictionaryGetCount(s_viewControllerToContainerContentMap) : 0;
+}
+
++ (NSUInteger)addedViewCount
+{
+    return s_nbrAddedViews;
+}
+
++ (NSUInteger)estimatedFootprintForView:(UIView *)view
+{
+    return HLSLayerEstimatedFootprint(view.layer);
+}
+
 #pragma mark Object creation and destruction
 
 - (id)initWithViewController:(UIViewController *)viewController
@@ -141,12 +169,15 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
         }
         
         // Associate the view controller with its container content object        
-        if (objc_getAssociatedObject(viewController, s_containerContentKey)) {
+        if (HLSContainerContentForViewController(viewController)) {
             HLSLoggerError(@"A view controller can only be associated with one container");
             [self release];
             return nil;
         }
-        objc_setAssociatedObject(viewController, s_containerContentKey, self, OBJC_ASSOCIATION_ASSIGN);
+        if (! s_viewControllerToContainerContentMap) {
+            s_viewControllerToContainerContentMap = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+        }
+        CFDictionarySetValue(s_viewControllerToContainerContentMap, viewController, self);
         
         // >= iOS 5: For containers having automaticallyForwardAppearanceAndRotationMethodsToChildViewControllers
         // return NO, we MUST use the UIViewController containment API to declare each view controller we insert
@@ -189,8 +220,8 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
     [self removeViewFromContainerStackView];
         
     // Remove the association of the view controller with its content container object
-    NSAssert(objc_getAssociatedObject(self.viewController, s_containerContentKey), @"The view controller was not associated with a content container");
-    objc_setAssociatedObject(self.viewController, s_containerContentKey, nil, OBJC_ASSOCIATION_ASSIGN);
+    NSAssert(HLSContainerContentForViewController(self.viewController) == self, @"The view controller was not associated with a content container");
+    CFDictionaryRemoveValue(s_viewControllerToContainerContentMap, self.viewController);
     
     // We must call -willMoveToParentViewController: manually right before the containment relationship is removed without
     // animation, if one remains of course (iOS 5 and above, see UIViewController documentation)
@@ -251,6 +282,13 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
     return [self.viewController viewIfLoaded];
 }
 
+@synthesize removalTime = m_removalTime;
+
+- (NSUInteger)estimatedViewFootprint
+{
+    return [HLSContainerContent estimatedFootprintForView:[self viewIfLoaded]];
+}
+
 #pragma mark View management
 
 - (void)addAsSubviewIntoContainerStackView:(HLSContainerStackView *)stackView
@@ -329,6 +367,7 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
     [stackView insertContentView:viewControllerView atIndex:index];
     
     self.containerStackView = stackView;
+    ++s_nbrAddedViews;
 }
 
 - (void)removeViewFromContainerStackView
@@ -340,6 +379,8 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
     // Remove the view controller's view
     [self.containerStackView removeContentView:[self viewIfLoaded]];
     self.containerStackView = nil;
+    --s_nbrAddedViews;
+    self.removalTime = [NSDate timeIntervalSinceReferenceDate];
     
     // Restore view controller original properties
     self.viewController.view.frame = self.originalViewFrame;
@@ -476,6 +517,8 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     // iOS 4: Private -addChildViewController: and -removeChildViewController: methods exist to define parent-child containment relationships, but
     //        of course these cannot be used. This is sad since they make the public -parentViewController return the parent container of a view
     //        controller (if any), providing correct propagation for several view controller properties (e.g. embedding in a navigation controller,
@@ -518,13 +561,15 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
                                                                                                          @selector(isMovingFromParentViewController),
                                                                                                          (IMP)swizzled_UIViewController__isMovingFromParentViewController_Imp);
     }
+    
+    HLSStartupReportRecord("HLSContainerContent", startTime);
 }
 
 @end
 
 static UIViewController *swizzled_UIViewController__parentViewController_Imp(UIViewController *self, SEL _cmd)
 {
-    HLSContainerContent *containerContent = objc_getAssociatedObject(self, s_containerContentKey);
+    HLSContainerContent *containerContent = HLSContainerContentForViewController(self);
     if (containerContent) {
         return containerContent.containerViewController;
     }
@@ -535,7 +580,7 @@ static UIViewController *swizzled_UIViewController__parentViewController_Imp(UIV
 
 static BOOL swizzled_UIViewController__isMovingToParentViewController_Imp(UIViewController *self, SEL _cmd)
 {
-    HLSContainerContent *containerContent = objc_getAssociatedObject(self, s_containerContentKey);
+    HLSContainerContent *containerContent = HLSContainerContentForViewController(self);
     if (containerContent) {
         return containerContent.movingToParentViewController;
     }
@@ -546,7 +591,7 @@ static BOOL swizzled_UIViewController__isMovingToParentViewController_Imp(UIView
 
 static BOOL swizzled_UIViewController__isMovingFromParentViewController_Imp(UIViewController *self, SEL _cmd)
 {
-    HLSContainerContent *containerContent = objc_getAssociatedObject(self, s_containerContentKey);
+    HLSContainerContent *containerContent = HLSContainerContentForViewController(self);
     if (containerContent) {
         return containerContent.movingFromParentViewController;
     }
@@ -569,11 +614,13 @@ static BOOL iOS4_UIViewController__isMovingToParentViewController_Imp(UIViewCont
 {
     UIViewController *currentViewController = self;
     while (currentViewController) {
-        HLSContainerContent *containerContent = objc_getAssociatedObject(currentViewController, s_containerContentKey);
+        HLSContainerContent *containerContent = HLSContainerContentForViewController(currentViewController);
         if (containerContent.movingToParentViewController) {
             return YES;
         }
-        currentViewController = currentViewController.parentViewController;
+        
+        // Avoid a second lookup through the swizzled -parentViewController when the parent is known
+        currentViewController = containerContent ? containerContent.containerViewController : currentViewController.parentViewController;
     }
     return NO;
 }
@@ -582,11 +629,48 @@ static BOOL iOS4_UIViewController__isMovingFromParentViewController_Imp(UIViewCo
 {
     UIViewController *currentViewController = self;
     while (currentViewController) {
-        HLSContainerContent *containerContent = objc_getAssociatedObject(currentViewController, s_containerContentKey);
+        HLSContainerContent *containerContent = HLSContainerContentForViewController(currentViewController);
         if (containerContent.movingFromParentViewController) {
             return YES;
         }
-        currentViewController = currentViewController.parentViewController;
+        
+        // Avoid a second lookup through the swizzled -parentViewController when the parent is known
+        currentViewController = containerContent ? containerContent.containerViewController : currentViewController.parentViewController;
     }
     return NO;
 }
+
+static HLSContainerContent *HLSContainerContentForViewController(UIViewController *viewController)
+{
+    if (! viewController || ! s_viewControllerToContainerContentMap) {
+        return nil;
+    }
+    return (HLSContainerContent *)CFDictionaryGetValue(s_viewControllerToContainerContentMap, viewController);
+}
+
+static NSUInteger HLSLayerEstimatedFootprint(CALayer *layer)
+{
+    if (! layer) {
+        return 0;
+    }
+    
+    // Only layers with contents own a backing store (images store their own bitmap, drawn layers a bitmap matching their
+    // bounds). Hidden sublayers can have contents as well and are therefore counted
+    NSUInteger footprint = 0;
+    id contents = layer.contents;
+    if (contents) {
+        if (CFGetTypeID((CFTypeRef)contents) == CGImageGetTypeID()) {
+            CGImageRef image = (CGImageRef)contents;
+            footprint += CGImageGetBytesPerRow(image) * CGImageGetHeight(image);
+        }
+        else {
+            CGFloat scale = layer.contentsScale;
+            footprint += (NSUInteger)(CGRectGetWidth(layer.bounds) * scale * CGRectGetHeight(layer.bounds) * scale) * 4;
+        }
+    }
+    
+    for (CALayer *sublayer in layer.sublayers) {
+        footprint += HLSLayerEstimatedFootprint(sublayer);
+    }
+    return footprint;
+}
@@ -17,12 +17,25 @@
  * possible. Moreover, this additional wrapping yields smoother animations (I cannot explain why, though.
  * Probably blending can be performed more efficiently)
  *
+ * Wrapper views are only needed while a transition is running, though. Since group views are nested (see
+ * HLSContainerStackView), a deep stack would otherwise accumulate two extra views per level, which adds
+ * compositing and hit-testing cost. Once transitions are over, a group view can therefore be flattened:
+ * Wrappers left in their initial state (opaque, untransformed, filling the group view) are removed, and 
+ * the content views are directly added to the group view instead. Wrappers are recreated lazily when 
+ * -frontView or -backView is accessed, i.e. when the animation of the next transition is built
+ *
  * Designated initializer: -initWithFrame:frontView:
  */
 @interface HLSContainerGroupView : UIView {
 @private
+    UIView *m_frontContentView;
+    UIView *m_frontView;
+    UIView *m_backContentView;
+    UIView *m_backView;
     UIView *m_savedFrontContentView;
     UIView *m_savedBackContentView;
+    UIImageView *m_frontSnapshotView;
+    UIImageView *m_backSnapshotView;
 }
 
 /**
@@ -39,7 +52,7 @@
 
 /**
  * The front content view wrapper. If you want to animate the group view, animate this view (which has 
- * a guaranteed initial alpha of 1.f)
+ * a guaranteed initial alpha of 1.f). If the group view was flattened, the wrapper is recreated
  */
 @property (nonatomic, readonly, retain) UIView *frontView;
 
@@ -51,8 +64,29 @@
 
 /**
  * The back content view wrapper. If you want to animate the group view, animate this view (which has
- * a guaranteed initial alpha of 1.f)
+ * a guaranteed initial alpha of 1.f). If the group view was flattened, the wrapper is recreated
  */
 @property (nonatomic, readonly, retain) UIView *backView;
 
+/**
+ * Remove the wrapper views which are in their initial state, and add the corresponding content views directly 
+ * to the group view. The result looks exactly the same, but with fewer views. Must not be called while the
+ * wrapper views are being animated. Does nothing while snapshots are displayed
+ */
+- (void)flattenWrapperViews;
+
+/**
+ * Render the front and back content views once into bitmaps, and display those bitmaps in place of the content
+ * views (which are hidden). Animating the front and back views then only requires compositing a single layer
+ * each, instead of their whole layer hierarchy. Content views are displayed again when -removeSnapshots is called.
+ * Does nothing if snapshots are already displayed
+ */
+- (void)replaceContentViewsWithSnapshots;
+
+/**
+ * Remove the snapshots created by -replaceContentViewsWithSnapshots and display the content views again. Does
+ * nothing if no snapshots are displayed
+ */
+- (void)removeSnapshots;
+
 @end
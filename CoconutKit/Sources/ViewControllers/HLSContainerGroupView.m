@@ -8,15 +8,31 @@
 
 #import "HLSContainerGroupView.h"
 
+#import "CALayer+HLSExtensions.h"
 #import "HLSAssert.h"
+#import "HLSFloat.h"
 #import "HLSLogger.h"
 #import "NSArray+HLSExtensions.h"
 #import "UIView+HLSExtensions.h"
 
+// Static functions
+static BOOL HLSContainerGroupViewIsWrapperViewInInitialState(UIView *wrapperView, UIView *groupView);
+
 @interface HLSContainerGroupView ()
 
+@property (nonatomic, retain) UIView *frontContentView;
+@property (nonatomic, retain) UIView *frontView;
+@property (nonatomic, retain) UIView *backView;
 @property (nonatomic, retain) UIView *savedFrontContentView;
 @property (nonatomic, retain) UIView *savedBackContentView;
+@property (nonatomic, retain) UIImageView *frontSnapshotView;
+@property (nonatomic, retain) UIImageView *backSnapshotView;
+
+- (UIView *)wrapperViewForContentView:(UIView *)contentView;
+- (void)unwrapContentView:(UIView *)contentView fromWrapperView:(UIView *)wrapperView;
+
+- (UIImageView *)snapshotViewForWrapperView:(UIView *)wrapperView contentView:(UIView *)contentView;
+- (void)removeSnapshotView:(UIImageView *)snapshotView forContentView:(UIView *)contentView;
 
 @end
 
@@ -36,18 +52,11 @@
         self.backgroundColor = [UIColor clearColor];
         self.autoresizingMask = HLSViewAutoresizingAll;
         
-        // Wrap into a transparent view with alpha = 1.f. This ensures that no animation applied on frontContentView relies
-        // on its initial alpha. The transform is always set to identity, corresponding to an initial portrait orientation
-        UIView *frontView = [[[UIView alloc] initWithFrame:self.bounds] autorelease];
-        frontView.transform = CGAffineTransformIdentity;
-        frontView.backgroundColor = [UIColor clearColor];
-        frontView.autoresizingMask = HLSViewAutoresizingAll;
-
+        // The content view is added as is. Its wrapper is created when the group view gets animated for the first time
         // Remark: If frontContentView was previously added to another superview, it is removed while kept alive. No need
         //         to call -removeFromSuperview and no need for a retain-autorelease. See UIView documentation
-        [frontView addSubview:frontContentView];
-        
-        [self addSubview:frontView];
+        self.frontContentView = frontContentView;
+        [self addSubview:frontContentView];
     }
     return self;
 }
@@ -60,63 +69,222 @@
 
 - (void)dealloc
 {
+    self.frontContentView = nil;
+    self.frontView = nil;
+    self.backContentView = nil;
+    self.backView = nil;
     self.savedFrontContentView = nil;
     self.savedBackContentView = nil;
-
+    self.frontSnapshotView = nil;
+    self.backSnapshotView = nil;
+    
     [super dealloc];
 }
 
 #pragma mark Accessors and mutators
 
-@synthesize savedFrontContentView = m_savedFrontContentView;
-
-@synthesize savedBackContentView = m_savedBackContentView;
+@synthesize frontContentView = m_frontContentView;
 
-- (UIView *)frontContentView
-{
-    return [self.frontView.subviews firstObject_hls];
-}
+@synthesize frontView = m_frontView;
 
 - (UIView *)frontView
 {
-    return [self.subviews lastObject];
+    if (! m_frontView) {
+        self.frontView = [self wrapperViewForContentView:self.frontContentView];
+    }
+    return m_frontView;
 }
 
+@synthesize backContentView = m_backContentView;
+
 - (UIView *)backContentView
 {
-    return [self.backView.subviews firstObject_hls];
+    // The back content view might have been moved to another view hierarchy in the meantime
+    UIView *superview = m_backContentView.superview;
+    if (! superview || (superview != self && superview != m_backView)) {
+        return nil;
+    }
+    
+    return m_backContentView;
 }
 
 - (void)setBackContentView:(UIView *)backContentView
 {
-    UIView *backView = self.backView;
-    if (! backContentView) {
-        [backView removeFromSuperview];
+    UIView *currentBackContentView = self.backContentView;
+    if (currentBackContentView == backContentView) {
         return;
     }
     
-    if (! backView) {
-        // Wrap into a transparent view with alpha = 1.f. This ensures that no animation applied on backContentView relies
-        // on its initial alpha
-        backView = [[[UIView alloc] initWithFrame:self.bounds] autorelease];
-        backView.backgroundColor = [UIColor clearColor];
-        backView.autoresizingMask = HLSViewAutoresizingAll;
-        [self insertSubview:backView atIndex:0];
+    // The current back content view is removed (the view is kept alive until the end of this method)
+    [[currentBackContentView retain] autorelease];
+    [currentBackContentView removeFromSuperview];
+    
+    [m_backContentView release];
+    m_backContentView = [backContentView retain];
+    
+    if (! backContentView) {
+        [m_backView removeFromSuperview];
+        self.backView = nil;
+        return;
     }
     
+    // The wrapper (if any) is kept so that its current state is preserved, otherwise it will be created when needed
     // Remark: If backContentView was previously added to another superview, it is removed while kept alive. No need to
     //         call -removeFromSuperview and no need for a retain-autorelease. See UIView documentation
-    [backView addSubview:backContentView];
+    if (m_backView) {
+        [m_backView addSubview:backContentView];
+    }
+    else {
+        [self insertSubview:backContentView atIndex:0];
+    }
 }
 
+@synthesize backView = m_backView;
+
 - (UIView *)backView
 {
-    if ([self.subviews count] == 2) {
-        return [self.subviews firstObject_hls];
+    UIView *backContentView = self.backContentView;
+    if (! backContentView) {
+        [m_backView removeFromSuperview];
+        self.backView = nil;
+        return nil;
     }
-    else {
+    
+    if (! m_backView) {
+        self.backView = [self wrapperViewForContentView:backContentView];
+    }
+    return m_backView;
+}
+
+@synthesize savedFrontContentView = m_savedFrontContentView;
+
+@synthesize savedBackContentView = m_savedBackContentView;
+
+@synthesize frontSnapshotView = m_frontSnapshotView;
+
+@synthesize backSnapshotView = m_backSnapshotView;
+
+#pragma mark Wrapper views
+
+- (UIView *)wrapperViewForContentView:(UIView *)contentView
+{
+    NSUInteger index = [self.subviews indexOfObject:contentView];
+    if (index == NSNotFound) {
+        HLSLoggerError(@"The content view %@ is not a subview of the group view", contentView);
         return nil;
-    }    
+    }
+    
+    // Wrap into a transparent view with alpha = 1.f. This ensures that no animation applied on the content view relies
+    // on its initial alpha. The transform is always set to identity, corresponding to an initial portrait orientation
+    UIView *wrapperView = [[[UIView alloc] initWithFrame:self.bounds] autorelease];
+    wrapperView.transform = CGAffineTransformIdentity;
+    wrapperView.backgroundColor = [UIColor clearColor];
+    wrapperView.autoresizingMask = HLSViewAutoresizingAll;
+    [self insertSubview:wrapperView atIndex:index];
+    
+    // Since the wrapper fills the group view and is not transformed, the content view does not move
+    [wrapperView addSubview:contentView];
+    
+    return wrapperView;
+}
+
+- (void)unwrapContentView:(UIView *)contentView fromWrapperView:(UIView *)wrapperView
+{
+    NSUInteger index = [self.subviews indexOfObject:wrapperView];
+    [self insertSubview:contentView atIndex:index];
+    [wrapperView removeFromSuperview];
+}
+
+- (void)flattenWrapperViews
+{
+    if (self.frontSnapshotView || self.backSnapshotView) {
+        return;
+    }
+    
+    if (m_frontView && HLSContainerGroupViewIsWrapperViewInInitialState(m_frontView, self)) {
+        [self unwrapContentView:self.frontContentView fromWrapperView:m_frontView];
+        self.frontView = nil;
+    }
+    
+    UIView *backContentView = self.backContentView;
+    if (m_backView && backContentView && HLSContainerGroupViewIsWrapperViewInInitialState(m_backView, self)) {
+        [self unwrapContentView:backContentView fromWrapperView:m_backView];
+        self.backView = nil;
+    }
+}
+
+#pragma mark Snapshots
+
+- (void)replaceContentViewsWithSnapshots
+{
+    if (self.frontSnapshotView || self.backSnapshotView) {
+        return;
+    }
+    
+    self.frontSnapshotView = [self snapshotViewForWrapperView:self.frontView contentView:self.frontContentView];
+    self.backSnapshotView = [self snapshotViewForWrapperView:self.backView contentView:self.backContentView];
+}
+
+- (void)removeSnapshots
+{
+    [self removeSnapshotView:self.frontSnapshotView forContentView:self.frontContentView];
+    self.frontSnapshotView = nil;
+    
+    [self removeSnapshotView:self.backSnapshotView forContentView:self.backContentView];
+    self.backSnapshotView = nil;
+}
+
+- (UIImageView *)snapshotViewForWrapperView:(UIView *)wrapperView contentView:(UIView *)contentView
+{
+    // Nothing to gain for views which are not displayed
+    if (! wrapperView || ! contentView || contentView.hidden) {
+        return nil;
+    }
+    
+    // Render the wrapper in its own coordinate system (the transform of the wrapper is the one being animated)
+    [wrapperView layoutIfNeeded];
+    UIImage *snapshotImage = [wrapperView.layer flattenedContentImage];
+    
+    UIImageView *snapshotView = [[[UIImageView alloc] initWithImage:snapshotImage] autorelease];
+    snapshotView.frame = wrapperView.bounds;
+    snapshotView.autoresizingMask = HLSViewAutoresizingAll;
+    
+    // The snapshot is added above the content view, which therefore remains the first wrapper subview
+    contentView.hidden = YES;
+    [wrapperView addSubview:snapshotView];
+    
+    return snapshotView;
+}
+
+- (void)removeSnapshotView:(UIImageView *)snapshotView forContentView:(UIView *)contentView
+{
+    if (! snapshotView) {
+        return;
+    }
+    
+    [snapshotView removeFromSuperview];
+    contentView.hidden = NO;
 }
 
 @end
+
+#pragma mark Static functions
+
+static BOOL HLSContainerGroupViewIsWrapperViewInInitialState(UIView *wrapperView, UIView *groupView)
+{
+    // Only the content view must be wrapped (no snapshot), and nothing must be running
+    if ([wrapperView.subviews count] != 1 || [[wrapperView.layer animationKeys] count] != 0) {
+        return NO;
+    }
+    
+    // All properties which animations can alter must have their initial value
+    CALayer *layer = wrapperView.layer;
+    return ! wrapperView.hidden
+        && floateq(layer.opacity, 1.f)
+        && CATransform3DIsIdentity(layer.transform)
+        && CATransform3DIsIdentity(layer.sublayerTransform)
+        && CGPointEqualToPoint(layer.anchorPoint, CGPointMake(0.5f, 0.5f))
+        && floateq(layer.anchorPointZ, 0.f)
+        && ! layer.shouldRasterize
+        && CGRectEqualToRect(wrapperView.frame, groupView.bounds);
+}
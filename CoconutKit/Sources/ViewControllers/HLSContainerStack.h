@@ -11,6 +11,7 @@
 #import "HLSTransition.h"
 
 // Forward declarations
+@class HLSContainerContent;
 @protocol HLSContainerStackDelegate;
 
 // Standard capacities
@@ -18,6 +19,20 @@ extern const NSUInteger HLSContainerStackMinimalCapacity;
 extern const NSUInteger HLSContainerStackDefaultCapacity;
 extern const NSUInteger HLSContainerStackUnlimitedCapacity;
 
+// Offscreen view footprint budgets
+extern const NSUInteger HLSContainerStackUnlimitedFootprint;
+
+/**
+ * Conditions under which a container stack automatically replaces push transitions with a cheaper one (see
+ * -[HLSContainerStack reducedCostTriggers]). Values can be combined
+ */
+typedef enum {
+    HLSContainerStackReducedCostTriggerNone = 0,                                // Never reduce transition costs
+    HLSContainerStackReducedCostTriggerMemoryWarning = (1 << 0),                // Reduce costs when a memory warning is received
+    HLSContainerStackReducedCostTriggerDroppedFrames = (1 << 1),                // Reduce costs when successive transitions drop too many frames
+                                                                                // (requires the animation profiler to be enabled, see HLSAnimationProfiler)
+} HLSContainerStackReducedCostTrigger;
+
 /**
  * The HLSContainerStack provides a convenient and easy interface to implement your own view controller containers,
  * which is usually not a trivial task. Unlike the UIViewController containment API, this class is compatible with 
@@ -126,6 +141,25 @@ extern const NSUInteger HLSContainerStackUnlimitedCapacity;
     BOOL m_animating;                                          // Set to YES when a transition animation is running
     BOOL m_rotating;
     HLSAutorotationMode m_autorotationMode;                    // How the container decides to behave when rotation occurs
+    BOOL m_deferringHiddenChildrenRotation;                    // If YES, only the top child is laid out and notified during rotations
+    BOOL m_hiddenChildrenNeedRotationLayout;                   // Set to YES when hidden children have missed a rotation layout
+    BOOL m_snapshottingTransitions;                            // If YES, push and pop transitions animate snapshots of the views
+    HLSAnimation *m_interactivePopAnimation;                   // The pop animation being scrubbed during an interactive pop
+    BOOL m_interactivePopCommitted;                            // Set to YES when an interactive pop has been committed
+    NSUInteger m_reducedCostTriggers;                          // Combination of HLSContainerStackReducedCostTrigger values
+    Class m_reducedCostTransitionClass;                        // The transition used when costs are reduced
+    NSTimeInterval m_reducedCostDuration;                      // How long costs are reduced once triggered
+    float m_reducedCostDroppedFrameRatio;                      // The ratio of dropped frames above which a transition is considered as slow
+    NSTimeInterval m_reducedCostEndTime;                       // The time (since the reference date) at which costs stop being reduced
+    NSUInteger m_slowTransitionCount;                          // The number of successive slow transitions
+    NSUInteger m_profiledFrameCount;                           // Profiler frame count when the last transition started
+    NSUInteger m_profiledDroppedFrameCount;                    // Profiler dropped frame count when the last transition started
+    NSUInteger m_offscreenViewFootprintBudget;                 // The memory (in bytes) views removed because of the capacity can keep
+    BOOL m_updating;                                           // Set to YES between -beginUpdates and -commitUpdatesAnimated:
+    BOOL m_deferringViewUpdates;                               // Set to YES if view updates are deferred until updates are committed
+    HLSContainerContent *m_updateTopContainerContent;          // The top content when updates began
+    NSMutableArray *m_updateInsertedContainerContents;         // The contents inserted since updates began
+    HLSContainerContent *m_pendingRemovalContainerContent;     // A content to be removed once the push transition covering it ends
     id<HLSContainerStackDelegate> m_delegate;                  // The stack delegate, usually the custom container which is implemented
 }
 
@@ -176,6 +210,119 @@ extern const NSUInteger HLSContainerStackUnlimitedCapacity;
  */
 @property (nonatomic, assign) HLSAutorotationMode autorotationMode;
 
+/**
+ * By default, all child view controllers loaded according to the capacity are laid out (and notified when the autorotation
+ * mode is HLSAutorotationModeContainer) when the container rotates, even if their views are hidden by the top child. Set 
+ * this property to YES to have this work performed only for the top child view controller. The views of hidden children
+ * are then laid out again once, right before they become visible (i.e. when the view controller above them is popped),
+ * which makes rotations faster for stacks with a large capacity.
+ *
+ * Only enable this mode if the transitions you use cover child view controllers completely (the children below the top
+ * would otherwise be visible while not being laid out correctly). Children receive rotation events as before when the
+ * autorotation mode is HLSAutorotationModeContainerAndAllChildren
+ *
+ * The default value is NO
+ */
+@property (nonatomic, assign, getter=isDeferringHiddenChildrenRotation) BOOL deferringHiddenChildrenRotation;
+
+/**
+ * If set to YES, animated push and pop transitions do not animate the live view hierarchies of the appearing and
+ * disappearing view controllers. Those are rendered once into bitmaps when the transition starts, and the transition
+ * animates these bitmaps instead. The real views are displayed again when the transition ends. This can greatly
+ * improve frame rates when transitioning between complex views, but the views are frozen during the animation
+ * (e.g. activity indicators stop spinning) and the snapshots have to be rendered first, which costs some time
+ * and memory
+ *
+ * The default value is NO
+ */
+@property (nonatomic, assign, getter=isSnapshottingTransitions) BOOL snapshottingTransitions;
+
+/**
+ * Transitions can be expensive, especially when complex views are involved. On constrained devices, a container
+ * can automatically switch to a cheaper transition for a while, so that navigation stays responsive. The conditions
+ * under which this happens are given by reducedCostTriggers, a combination of HLSContainerStackReducedCostTrigger
+ * values:
+ *   - HLSContainerStackReducedCostTriggerMemoryWarning: Costs are reduced when a memory warning is received
+ *   - HLSContainerStackReducedCostTriggerDroppedFrames: Costs are reduced when several successive animated push or 
+ *     pop transitions have dropped more than reducedCostDroppedFrameRatio of their frames. Frames are measured by 
+ *     HLSAnimationProfiler, which must therefore be enabled
+ * Costs are then reduced during reducedCostDuration seconds. During this time, view controllers pushed with an 
+ * animation use reducedCostTransitionClass (with its default duration) instead of the transition class they were
+ * pushed with, and the transitions of the container animate snapshots of the view controller's views (see 
+ * snapshottingTransitions). Since view controllers are popped with the reverse of the transition they were pushed 
+ * with, the pop transition of a view controller pushed while costs were reduced is cheap as well
+ *
+ * The default value is HLSContainerStackReducedCostTriggerNone
+ */
+@property (nonatomic, assign) NSUInteger reducedCostTriggers;
+
+/**
+ * The transition class used while costs are reduced. Use HLSTransitionNone to disable push animations altogether
+ *
+ * The default value is HLSTransitionCrossDissolve
+ */
+@property (nonatomic, assign) Class reducedCostTransitionClass;
+
+/**
+ * How long (in seconds) costs are reduced once a trigger has been met
+ *
+ * The default value is 30 seconds
+ */
+@property (nonatomic, assign) NSTimeInterval reducedCostDuration;
+
+/**
+ * The ratio (between 0 and 1) of dropped frames above which a transition is considered as too slow
+ *
+ * The default value is 0.25
+ */
+@property (nonatomic, assign) float reducedCostDroppedFrameRatio;
+
+/**
+ * Return YES iff transition costs are currently being reduced
+ */
+- (BOOL)isReducingTransitionCost;
+
+/**
+ * When view controllers get deeper than the capacity, their views are removed from the view hierarchy, but are not 
+ * unloaded, so that they can be displayed again quickly when view controllers above them are popped. The memory those
+ * offscreen views use is estimated (see -[HLSContainerContent estimatedViewFootprint]) and, if it exceeds the budget 
+ * given by offscreenViewFootprintBudget (in bytes), the views which have been offscreen for the longest time are unloaded 
+ * first until the budget is met again.
+ *
+ * When a memory warning is received, offscreen views are shed gradually in the same order: Each memory warning unloads 
+ * the least recently displayed offscreen views until their footprint has been halved. Views are loaded again when needed, 
+ * as usual
+ *
+ * The default value is HLSContainerStackUnlimitedFootprint
+ */
+@property (nonatomic, assign) NSUInteger offscreenViewFootprintBudget;
+
+/**
+ * Memory accounting. Return an estimate of the memory (in bytes) used by the views of all view controllers in the stack
+ * (see -[HLSContainerContent estimatedViewFootprint])
+ */
+- (NSUInteger)estimatedViewFootprint;
+
+/**
+ * Return a report listing the view controllers in the stack from the one whose view uses the most memory to the one
+ * using the least, with their depth in the stack, their estimated view footprint, and whether their view is displayed,
+ * offscreen (and therefore unloaded first when the offscreen view footprint budget is exceeded or when a memory warning
+ * is received) or not loaded
+ */
+- (NSString *)footprintReport;
+
+/**
+ * Return the reports of all container stacks currently alive, from the one using the most memory to the one using the
+ * least, so that the screens to optimise first can be easily spotted
+ */
++ (NSString *)globalFootprintReport;
+
+/**
+ * When a memory warning is received, the global footprint report is logged (with info level) before any view is unloaded.
+ * Return the report made for the last memory warning, nil if none has been received yet
+ */
++ (NSString *)lastMemoryWarningFootprintReport;
+
 /**
  * The stack delegate (usually the container view controller you are implementing)
  */
@@ -253,12 +400,46 @@ extern const NSUInteger HLSContainerStackUnlimitedCapacity;
  */
 - (void)popAllViewControllersAnimated:(BOOL)animated;
 
+/**
+ * Interactive pop. Rather than playing the pop animation at once, the reverse animation of the top view controller
+ * is scrubbed (see -[HLSAnimation beginScrubbing]), usually following a gesture:
+ *   - call -beginInteractivePop when the gesture begins. The view controllers which must be displayed when the pop
+ *     is complete are loaded at once, so that no view controller's view has to be loaded while the gesture is tracked.
+ *     Return NO if no interactive pop is possible (no view controller to reveal, root view controller fixed, container
+ *     not displayed, transition animation running, or a transition animation which cannot be scrubbed)
+ *   - set interactivePopProgress while the gesture changes
+ *   - call -finishInteractivePop or -cancelInteractivePop when the gesture ends, depending on whether the pop must be 
+ *     performed or not. The animation then settles from its current progress
+ *
+ * View lifecycle events and delegate pop events are only sent once the pop has been committed by calling 
+ * -finishInteractivePop, and are sent as for a usual animated pop. No event is sent when an interactive pop is
+ * cancelled
+ */
+- (BOOL)beginInteractivePop;
+- (void)finishInteractivePop;
+- (void)cancelInteractivePop;
+
+/**
+ * The progress of the current interactive pop, between 0 and 1. Setting this value does nothing if no interactive pop
+ * is being tracked
+ */
+@property (nonatomic, assign) float interactivePopProgress;
+
+/**
+ * Return YES from the call to -beginInteractivePop until the pop animation has settled
+ */
+- (BOOL)isPoppingInteractively;
+
 /**
  * Insert a view controller at the specified index with some transition animation properties. If index == [self count],
  * the view controller is added at the top of the stack, and the transition animation takes place (provided animated has
  * been set to YES). In all other cases, no animation occurs. Note that the corresponding reverse animation will still 
  * be played when the view controller is later popped
  *
+ * The view of a view controller inserted deeper than the capacity is not loaded until the view controller gets
+ * within the capacity range. Inserting ten view controllers below the top view controller of a stack with capacity 
+ * 2 therefore loads a single view
+ *
  * If the index is invalid, or if its is 0 and the root view controller is fixed (after the stack has been displayed
  * once), this method does nothing
  */
@@ -305,6 +486,27 @@ extern const NSUInteger HLSContainerStackUnlimitedCapacity;
  */
 - (void)removeViewController:(UIViewController *)viewController animated:(BOOL)animated;
 
+/**
+ * Batched updates. Calling the above insertion and removal methods between -beginUpdates and -commitUpdatesAnimated:
+ * only updates the list of view controllers: No view is loaded, no animation is played and no view lifecycle or delegate
+ * event is sent. When the updates are committed, only the views of the view controllers which must be displayed
+ * according to the capacity are loaded, and a single transition is played:
+ *   - if the top view controller is a view controller inserted during the updates, it is pushed with the transition
+ *     it was inserted with, covering the view controller which was on top when the updates began (even if it has been
+ *     removed meanwhile; it is then removed once the push transition ends)
+ *   - if the top view controller was already in the stack and the one which was on top when the updates began has been
+ *     removed, the latter is popped with the reverse of the transition it was pushed with
+ *   - otherwise the top view controller has not changed, and no transition is played
+ * This makes it possible to rebuild a whole stack (e.g. to restore a navigation state) without loading views which
+ * would never be seen. The animated parameter of the methods called between -beginUpdates and -commitUpdatesAnimated:
+ * is ignored, the animated parameter of -commitUpdatesAnimated: is used instead
+ *
+ * If the container is not displayed, the methods called between -beginUpdates and -commitUpdatesAnimated: behave
+ * as usual. Updates cannot be nested, and cannot begin while a transition animation is running
+ */
+- (void)beginUpdates;
+- (void)commitUpdatesAnimated:(BOOL)animated;
+
 /**
  * Release all view and view-related resources. On iOS 4 and 5, this also forwards the -viewWill/DidUnload messages 
  * to the corresponding view controllers
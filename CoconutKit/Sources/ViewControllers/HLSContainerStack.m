@@ -8,12 +8,14 @@
 
 #import "HLSContainerStack.h"
 
+#import "HLSAnimationProfiler.h"
 #import "HLSAssert.h"
 #import "HLSContainerContent.h"
 #import "HLSContainerStackView.h"
 #import "HLSFloat.h"
 #import "HLSLayerAnimationStep.h"
 #import "HLSLogger.h"
+#import "HLSTrace.h"
 #import "NSArray+HLSExtensions.h"
 #import "UIViewController+HLSExtensions.h"
 
@@ -22,11 +24,30 @@ const NSUInteger HLSContainerStackMinimalCapacity = 1;
 const NSUInteger HLSContainerStackDefaultCapacity = 2;
 const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 
+const NSUInteger HLSContainerStackUnlimitedFootprint = NSUIntegerMax;
+
+// Number of successive slow transitions after which costs are reduced (when dropped frames are a trigger)
+static const NSUInteger kReducedCostSlowTransitionCount = 3;
+
+// All container stacks alive (not retained). Only accessed from the main thread
+static CFMutableSetRef s_containerStacks = NULL;
+
+// Global footprint report made for the last memory warning, and the notification it was made for
+static NSString *s_lastMemoryWarningFootprintReport = nil;
+static NSNotification *s_lastMemoryWarningNotification = nil;
+
+// Static functions
+static NSString *HLSContainerStackFormattedFootprint(NSUInteger footprint);
+
 @interface HLSContainerStack () <HLSContainerStackViewDelegate>
 
 @property (nonatomic, assign) UIViewController *containerViewController;
 @property (nonatomic, retain) NSMutableArray *containerContents;
 @property (nonatomic, assign) NSUInteger capacity;
+@property (nonatomic, retain) HLSAnimation *interactivePopAnimation;
+@property (nonatomic, retain) HLSContainerContent *updateTopContainerContent;
+@property (nonatomic, retain) NSMutableArray *updateInsertedContainerContents;
+@property (nonatomic, retain) HLSContainerContent *pendingRemovalContainerContent;
 
 - (HLSContainerContent *)topContainerContent;
 - (HLSContainerContent *)secondTopContainerContent;
@@ -38,6 +59,24 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                           animated:(BOOL)animated;
 - (void)rotateContainerContent:(HLSContainerContent *)containerContent
        forInterfaceOrientation:(UIInterfaceOrientation)interfaceOrientation;
+- (NSUInteger)rotatedContainerContentCount;
+- (void)flattenGroupViews;
+
+- (void)forwardTransitionWillStartEventsForAnimation:(HLSAnimation *)animation animated:(BOOL)animated;
+- (void)interactivePopDidCancel;
+
+- (void)trimContainerContentsToCount:(NSUInteger)count;
+- (void)rebuildViewsKeepingContainerContent:(HLSContainerContent *)keptContainerContent;
+
+- (void)reduceTransitionCost;
+- (void)startMeasuringTransitionAnimation:(HLSAnimation *)animation;
+- (void)stopMeasuringTransitionAnimation:(HLSAnimation *)animation;
+
+- (NSArray *)offscreenContainerContents;
+- (NSUInteger)offscreenViewFootprint;
+- (void)unloadOffscreenViewsToFootprint:(NSUInteger)footprint;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
 
 @end
 
@@ -53,6 +92,33 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                                           rootViewControllerFixed:NO] autorelease];
 }
 
++ (NSString *)globalFootprintReport
+{
+    // Estimate footprints once before sorting (layer trees have to be traversed)
+    NSMutableArray *entries = [NSMutableArray array];
+    NSUInteger totalFootprint = 0;
+    for (HLSContainerStack *containerStack in (NSSet *)s_containerStacks) {
+        NSUInteger footprint = [containerStack estimatedViewFootprint];
+        totalFootprint += footprint;
+        [entries addObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:footprint], @"footprint",
+                            [containerStack footprintReport], @"report", nil]];
+    }
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"Container view footprint: %@ estimated for %d container stacks\n", 
+                               HLSContainerStackFormattedFootprint(totalFootprint), 
+                               [entries count]];
+    NSSortDescriptor *footprintSortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"footprint" ascending:NO];
+    for (NSDictionary *entry in [entries sortedArrayUsingDescriptor:footprintSortDescriptor]) {
+        [report appendString:[entry objectForKey:@"report"]];
+    }
+    return [NSString stringWithString:report];
+}
+
++ (NSString *)lastMemoryWarningFootprintReport
+{
+    return s_lastMemoryWarningFootprintReport;
+}
+
 #pragma mark Object creation and destruction
 
 - (id)initWithContainerViewController:(UIViewController *)containerViewController 
@@ -73,6 +139,21 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         m_removing = removing;
         m_rootViewControllerFixed = rootViewControllerFixed;
         m_autorotationMode = HLSAutorotationModeContainer;
+        self.reducedCostTriggers = HLSContainerStackReducedCostTriggerNone;
+        self.reducedCostTransitionClass = [HLSTransitionCrossDissolve class];
+        self.reducedCostDuration = 30.;
+        self.reducedCostDroppedFrameRatio = 0.25f;
+        self.offscreenViewFootprintBudget = HLSContainerStackUnlimitedFootprint;
+        
+        if (! s_containerStacks) {
+            s_containerStacks = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+        }
+        CFSetAddValue(s_containerStacks, self);
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
     }
     return self;
 }
@@ -85,10 +166,20 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 
 - (void)dealloc
 {
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidReceiveMemoryWarningNotification
+                                                  object:nil];
+    
+    CFSetRemoveValue(s_containerStacks, self);
+    
     self.containerViewController = nil;
     self.containerContents = nil;
     self.containerView = nil;
     self.delegate = nil;
+    self.interactivePopAnimation = nil;
+    self.updateTopContainerContent = nil;
+    self.updateInsertedContainerContents = nil;
+    self.pendingRemovalContainerContent = nil;
 
     [super dealloc];
 }
@@ -150,6 +241,75 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 
 @synthesize autorotationMode = m_autorotationMode;
 
+@synthesize deferringHiddenChildrenRotation = m_deferringHiddenChildrenRotation;
+
+@synthesize snapshottingTransitions = m_snapshottingTransitions;
+
+@synthesize reducedCostTriggers = m_reducedCostTriggers;
+
+@synthesize reducedCostTransitionClass = m_reducedCostTransitionClass;
+
+- (void)setReducedCostTransitionClass:(Class)reducedCostTransitionClass
+{
+    if (! [reducedCostTransitionClass isSubclassOfClass:[HLSTransition class]]) {
+        HLSLoggerError(@"The class %@ is not a subclass of HLSTransition", reducedCostTransitionClass);
+        return;
+    }
+    
+    m_reducedCostTransitionClass = reducedCostTransitionClass;
+}
+
+@synthesize reducedCostDuration = m_reducedCostDuration;
+
+@synthesize reducedCostDroppedFrameRatio = m_reducedCostDroppedFrameRatio;
+
+- (void)setReducedCostDroppedFrameRatio:(float)reducedCostDroppedFrameRatio
+{
+    if (floatlt(reducedCostDroppedFrameRatio, 0.f) || floatgt(reducedCostDroppedFrameRatio, 1.f)) {
+        HLSLoggerError(@"The dropped frame ratio must be between 0 and 1");
+        return;
+    }
+    
+    m_reducedCostDroppedFrameRatio = reducedCostDroppedFrameRatio;
+}
+
+- (BOOL)isReducingTransitionCost
+{
+    return [NSDate timeIntervalSinceReferenceDate] < m_reducedCostEndTime;
+}
+
+@synthesize offscreenViewFootprintBudget = m_offscreenViewFootprintBudget;
+
+- (void)setOffscreenViewFootprintBudget:(NSUInteger)offscreenViewFootprintBudget
+{
+    m_offscreenViewFootprintBudget = offscreenViewFootprintBudget;
+    
+    [self unloadOffscreenViewsToFootprint:offscreenViewFootprintBudget];
+}
+
+@synthesize interactivePopAnimation = m_interactivePopAnimation;
+
+@synthesize updateTopContainerContent = m_updateTopContainerContent;
+
+@synthesize updateInsertedContainerContents = m_updateInsertedContainerContents;
+
+@synthesize pendingRemovalContainerContent = m_pendingRemovalContainerContent;
+
+- (float)interactivePopProgress
+{
+    return self.interactivePopAnimation.progress;
+}
+
+- (void)setInteractivePopProgress:(float)interactivePopProgress
+{
+    self.interactivePopAnimation.progress = interactivePopProgress;
+}
+
+- (BOOL)isPoppingInteractively
+{
+    return self.interactivePopAnimation != nil;
+}
+
 @synthesize delegate = m_delegate;
 
 - (HLSContainerContent *)topContainerContent
@@ -208,16 +368,119 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                   duration:(NSTimeInterval)duration
                   animated:(BOOL)animated
 {
+    HLSTraceIdentifier traceIdentifier = HLSTraceBegin(@"Containers", [NSString stringWithFormat:@"Push %@", [viewController class]]);
     [self insertViewController:viewController
                        atIndex:[self.containerContents count] 
            withTransitionClass:transitionClass
                       duration:duration
                       animated:animated];
+    HLSTraceEnd(traceIdentifier);
 }
 
 - (void)popViewControllerAnimated:(BOOL)animated
 {
+    HLSTraceIdentifier traceIdentifier = HLSTraceBegin(@"Containers", [NSString stringWithFormat:@"Pop %@", [[self topViewController] class]]);
     [self removeViewControllerAtIndex:[self.containerContents count] - 1 animated:animated];
+    HLSTraceEnd(traceIdentifier);
+}
+
+- (BOOL)beginInteractivePop
+{
+    if (! [self.containerViewController isViewDisplayed]) {
+        HLSLoggerWarn(@"Interactive pops are only possible when the container is displayed");
+        return NO;
+    }
+    
+    if (m_animating || self.interactivePopAnimation) {
+        HLSLoggerWarn(@"Cannot begin an interactive pop while a transition animation is running");
+        return NO;
+    }
+    
+    if (m_updating) {
+        HLSLoggerWarn(@"Cannot begin an interactive pop while updates are being made");
+        return NO;
+    }
+    
+    if ([self.containerContents count] < 2) {
+        HLSLoggerDebug(@"No view controller to reveal");
+        return NO;
+    }
+    
+    HLSContainerContent *containerContent = [self topContainerContent];
+    if (! containerContent.addedToContainerView) {
+        return NO;
+    }
+    
+    // If children below have missed a rotation layout, lay them out again before the gesture starts revealing them
+    if (m_hiddenChildrenNeedRotationLayout) {
+        [self rebuildViewsKeepingContainerContent:containerContent];
+    }
+    
+    HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[containerContent viewIfLoaded]];
+    HLSAnimation *reverseAnimation = [containerContent.transitionClass reverseAnimationWithAppearingView:groupView.backView
+                                                                                        disappearingView:groupView.frontView
+                                                                                                  inView:groupView
+                                                                                                duration:containerContent.duration];
+    reverseAnimation.tag = @"pop_animation";
+    reverseAnimation.delegate = self;
+    
+    // Load the view controller's view below so that the capacity criterium can be fulfilled (if needed) once the pop is
+    // complete. This must be done before the gesture is tracked, so that no view needs to be loaded while tracking
+    HLSContainerContent *containerContentAtCapacity = [self containerContentAtDepth:self.capacity];
+    BOOL containerContentAtCapacityAdded = containerContentAtCapacity && ! containerContentAtCapacity.addedToContainerView;
+    if (containerContentAtCapacity) {
+        [self addViewForContainerContent:containerContentAtCapacity inserting:NO animated:NO];
+    }
+    
+    m_interactivePopCommitted = NO;
+    self.interactivePopAnimation = reverseAnimation;
+    if (! [reverseAnimation beginScrubbing]) {
+        if (containerContentAtCapacityAdded) {
+            [containerContentAtCapacity removeViewFromContainerStackView];
+        }
+        self.interactivePopAnimation = nil;
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (void)finishInteractivePop
+{
+    if (! self.interactivePopAnimation || m_interactivePopCommitted) {
+        return;
+    }
+    
+    m_interactivePopCommitted = YES;
+    
+    // The pop now really occurs. Send the events which are sent when a pop animation begins
+    if ([self.delegate respondsToSelector:@selector(containerStack:willPopViewController:revealViewController:animated:)]) {
+        [self.delegate containerStack:self
+                willPopViewController:[self topViewController]
+                 revealViewController:self.secondTopContainerContent.viewController
+                             animated:YES];
+    }
+    [self forwardTransitionWillStartEventsForAnimation:self.interactivePopAnimation animated:YES];
+    
+    [self.interactivePopAnimation finishScrubbing];
+}
+
+- (void)cancelInteractivePop
+{
+    if (! self.interactivePopAnimation || m_interactivePopCommitted) {
+        return;
+    }
+    
+    [self.interactivePopAnimation cancelScrubbing];
+}
+
+- (void)interactivePopDidCancel
+{
+    // Restore the stack view in the state it was before the interactive pop began
+    HLSContainerContent *containerContentAboveCapacity = [self containerContentAtDepth:self.capacity];
+    if (containerContentAboveCapacity) {
+        [containerContentAboveCapacity removeViewFromContainerStackView];
+    }
 }
 
 - (void)popToViewController:(UIViewController *)viewController animated:(BOOL)animated
@@ -335,7 +598,10 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         return;
     }
     
-    if ([self.containerViewController isViewDisplayed]) {
+    // When updates are batched, views and events are taken care of when the updates are committed
+    BOOL displayed = [self.containerViewController isViewDisplayed] && ! m_deferringViewUpdates;
+    
+    if (displayed) {
         // Notify the delegate before the view controller is actually installed on top of the stack and associated with the
         // container (see HLSContainerStackDelegate interface contract)
         if (index == [self.containerContents count]) {
@@ -348,6 +614,13 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         }
     }
         
+    // Replace the push transition with a cheaper one if needed
+    if (displayed && index == [self.containerContents count] && animated && [self isReducingTransitionCost]) {
+        HLSLoggerDebug(@"Transition costs are reduced. Push with %@ instead of %@", self.reducedCostTransitionClass, transitionClass);
+        transitionClass = self.reducedCostTransitionClass;
+        duration = kAnimationTransitionDefaultDuration;
+    }
+    
     // Associate the new view controller with its container (this increases [container count])
     HLSContainerContent *containerContent = [[[HLSContainerContent alloc] initWithViewController:viewController
                                                                          containerViewController:self.containerViewController
@@ -364,18 +637,36 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     // If no transition occurs (pre-loading before the container view is displayed, or insertion not at the top while
     // displayed), we must call -didMoveToParentViewController: manually right after the containment relationship has
     // been established (iOS 5 and above, see UIViewController documentation)
-    if (! [self.containerViewController isViewDisplayed]
-            || (index == [self.containerContents count] - 1 && ! animated)) {
+    if (m_deferringViewUpdates) {
+        [self.updateInsertedContainerContents addObject:containerContent];
+    }
+    else if (! displayed || (index == [self.containerContents count] - 1 && ! animated)) {
         // This method is always available, even on iOS 4 through method injection (see HLSContainerContent.m)
         [viewController didMoveToParentViewController:self.containerViewController];
     }
     
-    // If inserted in the capacity range, must add the view
-    if ([self.containerViewController isViewDisplayed]) {
+    // If inserted in the capacity range, must add the view. Otherwise the view is only loaded when the view controller
+    // gets within the capacity range (i.e. when view controllers above it are popped)
+    if (displayed) {
         // A correction needs to be applied here to account for the [container count] increase (since index was relative
         // to the previous value)
-        if ([self.containerContents count] - index - 1 <= self.capacity) {
+        if ([self.containerContents count] - index - 1 < self.capacity) {
             [self addViewForContainerContent:containerContent inserting:YES animated:animated];
+            
+            // When inserting below the top, the view controller at the bottom of the capacity range is pushed out of it
+            // at once (for a push, this happens when the transition animation ends)
+            if (index != [self.containerContents count] - 1) {
+                HLSContainerContent *containerContentAtCapacity = [self containerContentAtDepth:self.capacity];
+                if (containerContentAtCapacity) {
+                    if (! m_removing) {
+                        [containerContentAtCapacity removeViewFromContainerStackView];
+                        [self unloadOffscreenViewsToFootprint:self.offscreenViewFootprintBudget];
+                    }
+                    else {
+                        [self.containerContents removeObject:containerContentAtCapacity];
+                    }
+                }
+            }
         }
     }
 }
@@ -433,7 +724,10 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         return;
     }
     
-    if ([self.containerViewController isViewDisplayed]) {
+    // When updates are batched, views and events are taken care of when the updates are committed
+    BOOL displayed = [self.containerViewController isViewDisplayed] && ! m_deferringViewUpdates;
+    
+    if (displayed) {
         // Notify the delegate
         if (index == [self.containerContents count] - 1) {
             if ([self.delegate respondsToSelector:@selector(containerStack:willPopViewController:revealViewController:animated:)]) {
@@ -446,11 +740,17 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
     
     HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
-    if (containerContent.addedToContainerView) {
+    if (displayed && containerContent.addedToContainerView) {
         // Load the view controller's view below so that the capacity criterium can be fulfilled (if needed). If we are popping a
         // view controller, we will have capacity + 1 view controller's views loaded during the animation. This ensures that no
         // view controllers magically pops up during animation (which could be noticed depending on the pop animation, or if view
         // controllers on top of it are transparent)
+        //
+        // If children below have missed a rotation layout, lay them out again now that they are about to be revealed
+        if (index == [self.containerContents count] - 1 && m_hiddenChildrenNeedRotationLayout) {
+            [self rebuildViewsKeepingContainerContent:containerContent];
+        }
+        
         HLSContainerContent *containerContentAtCapacity = [self containerContentAtDepth:self.capacity];
         if (containerContentAtCapacity) {
             [self addViewForContainerContent:containerContentAtCapacity inserting:NO animated:NO];
@@ -494,6 +794,144 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     [self removeViewControllerAtIndex:index animated:animated];
 }
 
+- (void)beginUpdates
+{
+    if (m_updating) {
+        HLSLoggerWarn(@"Updates have already begun");
+        return;
+    }
+    
+    if (m_animating) {
+        HLSLoggerWarn(@"Cannot begin updates while a transition animation is running");
+        return;
+    }
+    
+    m_updating = YES;
+    
+    // Nothing to defer if the container is not displayed
+    if ([self.containerViewController isViewDisplayed]) {
+        m_deferringViewUpdates = YES;
+        self.updateTopContainerContent = [self topContainerContent];
+        self.updateInsertedContainerContents = [NSMutableArray array];
+    }
+}
+
+- (void)commitUpdatesAnimated:(BOOL)animated
+{
+    if (! m_updating) {
+        HLSLoggerWarn(@"No updates to commit");
+        return;
+    }
+    
+    m_updating = NO;
+    
+    if (! m_deferringViewUpdates) {
+        return;
+    }
+    
+    m_deferringViewUpdates = NO;
+    
+    // Keep the contents alive until the end of this method
+    HLSContainerContent *oldTopContainerContent = [[self.updateTopContainerContent retain] autorelease];
+    NSArray *insertedContainerContents = [[self.updateInsertedContainerContents retain] autorelease];
+    self.updateTopContainerContent = nil;
+    self.updateInsertedContainerContents = nil;
+    
+    HLSContainerContent *newTopContainerContent = [self topContainerContent];
+    BOOL pushing = newTopContainerContent && newTopContainerContent != oldTopContainerContent
+        && [insertedContainerContents containsObject:newTopContainerContent];
+    BOOL oldTopContainerContentRemoved = oldTopContainerContent && ! [self.containerContents containsObject:oldTopContainerContent];
+    
+    // Complete the containment relationship of the view controllers which have been inserted without being pushed
+    // (this method is always available, even on iOS 4 through method injection, see HLSContainerContent.m)
+    for (HLSContainerContent *containerContent in insertedContainerContents) {
+        if ((pushing && containerContent == newTopContainerContent) || ! [self.containerContents containsObject:containerContent]) {
+            continue;
+        }
+        [containerContent.viewController didMoveToParentViewController:self.containerViewController];
+    }
+    
+    if (pushing) {
+        // Bring the stack in the state it would have had if the new top view controller was simply pushed. If the
+        // view controller on top when the updates began has been removed, temporarily put it back so that it can
+        // receive disappearance events, and remove it when the push ends
+        [self.containerContents removeObject:newTopContainerContent];
+        if (oldTopContainerContentRemoved) {
+            [self.containerContents addObject:oldTopContainerContent];
+            self.pendingRemovalContainerContent = oldTopContainerContent;
+        }
+        [self trimContainerContentsToCount:self.capacity];
+        [self rebuildViewsKeepingContainerContent:oldTopContainerContent];
+        
+        if ([self.delegate respondsToSelector:@selector(containerStack:willPushViewController:coverViewController:animated:)]) {
+            [self.delegate containerStack:self
+                   willPushViewController:newTopContainerContent.viewController
+                      coverViewController:[self topViewController]
+                                 animated:animated];
+        }
+        
+        [self.containerContents addObject:newTopContainerContent];
+        if (! animated) {
+            [newTopContainerContent.viewController didMoveToParentViewController:self.containerViewController];
+        }
+        [self addViewForContainerContent:newTopContainerContent inserting:YES animated:animated];
+    }
+    else if (oldTopContainerContentRemoved) {
+        // Put the view controller on top when the updates began back so that it can be popped
+        [self.containerContents addObject:oldTopContainerContent];
+        [self trimContainerContentsToCount:self.capacity + 1];
+        [self rebuildViewsKeepingContainerContent:oldTopContainerContent];
+        
+        [self removeViewControllerAtIndex:[self.containerContents count] - 1 animated:animated];
+    }
+    else {
+        [self trimContainerContentsToCount:self.capacity];
+        [self rebuildViewsKeepingContainerContent:oldTopContainerContent];
+    }
+}
+
+/**
+ * For stacks removing view controllers deeper than their capacity, remove the bottommost view controllers so that
+ * at most count of them remain
+ */
+- (void)trimContainerContentsToCount:(NSUInteger)count
+{
+    if (! m_removing) {
+        return;
+    }
+    
+    while ([self.containerContents count] > count) {
+        [self.containerContents removeObjectAtIndex:0];
+    }
+}
+
+/**
+ * Rebuild the stack view hierarchy so that it contains the views required by the capacity. The view of the content
+ * given as parameter (if any) is left untouched if it is still required
+ */
+- (void)rebuildViewsKeepingContainerContent:(HLSContainerContent *)keptContainerContent
+{
+    // Remove views from the bottommost to the topmost one. Since transitions are applied to the view hierarchy
+    // wrapping views below, removing a view discards the effects of the transitions which were applied to it
+    NSUInteger count = [self.containerContents count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        HLSContainerContent *containerContent = [self.containerContents objectAtIndex:i];
+        if (containerContent == keptContainerContent && count - i - 1 < self.capacity) {
+            continue;
+        }
+        [containerContent removeViewFromContainerStackView];
+    }
+    
+    // Add the views from the topmost to the bottommost one, so that the effects of the transitions are applied again.
+    // Views which had not been loaded are only loaded now
+    for (NSUInteger i = 0; i < MIN(self.capacity, count); ++i) {
+        [self addViewForContainerContent:[self containerContentAtDepth:i] inserting:NO animated:NO];
+    }
+    
+    // All views have been laid out for the current orientation
+    m_hiddenChildrenNeedRotationLayout = NO;
+}
+
 - (void)releaseViews
 {
     for (HLSContainerContent *containerContent in self.containerContents) {
@@ -501,6 +939,9 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
     
     self.containerView = nil;
+    
+    // Views will be created again for the orientation at that time
+    m_hiddenChildrenNeedRotationLayout = NO;
 }
 
 - (void)viewWillAppear:(BOOL)animated
@@ -657,8 +1098,13 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     m_rotating = YES;
     
     if ([self.containerContents count] != 0) {
+        // Children hidden below the top one are not laid out for the new orientation. Remember to do it later
+        if ([self rotatedContainerContentCount] < MIN(self.capacity, [self.containerContents count])) {
+            m_hiddenChildrenNeedRotationLayout = YES;
+        }
+        
         // Avoid frame issues due to rotation
-        for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+        for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
             NSUInteger index = [self.containerContents count] - 1 - i;
             HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
             
@@ -708,7 +1154,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                 
             case HLSAutorotationModeContainer:
             default: {
-                for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+                for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
                     NSUInteger index = [self.containerContents count] - 1 - i;
                     HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
                     [containerContent willRotateToInterfaceOrientation:toInterfaceOrientation duration:duration];
@@ -723,7 +1169,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 {
     if ([self.containerContents count] != 0) {
         // Avoid frame issues due to rotation
-        for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+        for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
             NSUInteger index = [self.containerContents count] - 1 - i;
             HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
             
@@ -764,7 +1210,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                 
             case HLSAutorotationModeContainer:
             default: {
-                for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+                for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
                     NSUInteger index = [self.containerContents count] - 1 - i;
                     HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
                     [containerContent willAnimateRotationToInterfaceOrientation:toInterfaceOrientation duration:duration];
@@ -779,7 +1225,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 {
     if ([self.containerContents count] != 0) {
         // Rotate the loaded child view controller's views to an orientation they support (if needed)
-        for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+        for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
             NSUInteger index = [self.containerContents count] - 1 - i;
             HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
             
@@ -813,7 +1259,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                 
             case HLSAutorotationModeContainer:
             default: {
-                for (NSUInteger i = 0; i < MIN(self.capacity, [self.containerContents count]); ++i) {
+                for (NSUInteger i = 0; i < [self rotatedContainerContentCount]; ++i) {
                     NSUInteger index = [self.containerContents count] - 1 - i;
                     HLSContainerContent *containerContent = [self.containerContents objectAtIndex:index];
                     [containerContent didRotateFromInterfaceOrientation:fromInterfaceOrientation];
@@ -824,6 +1270,8 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
     
     m_rotating = NO;
+    
+    [self flattenGroupViews];
 }
 
 /**
@@ -837,7 +1285,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 {
     NSAssert(containerContent != nil, @"A container content is mandatory");
         
-    if (! [self.containerViewController isViewDisplayed]) {
+    if (! [self.containerViewController isViewDisplayed] || m_deferringViewUpdates) {
         return;
     }
         
@@ -915,6 +1363,28 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
 }
 
+/**
+ * Return the number of top children which must be laid out and notified when the container rotates
+ */
+- (NSUInteger)rotatedContainerContentCount
+{
+    NSUInteger count = MIN(self.capacity, [self.containerContents count]);
+    return self.deferringHiddenChildrenRotation ? MIN(count, 1) : count;
+}
+
+/**
+ * Remove the wrapper views which are only needed for animations from the stack view hierarchy. Does nothing while a
+ * transition is running (wrappers are recreated automatically when the next transition animation is built)
+ */
+- (void)flattenGroupViews
+{
+    if (m_animating || self.interactivePopAnimation) {
+        return;
+    }
+    
+    [[self containerStackView] flattenGroupViews];
+}
+
 /**
  * Call this method when a child view controller's view must be rotated to make it compatible with the container interface
  * orientation. Landscape-only view controllers, e.g., must be rotated from PI/2 when inserted in a container in portrait
@@ -1003,6 +1473,208 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     }
 }
 
+- (void)forwardTransitionWillStartEventsForAnimation:(HLSAnimation *)animation animated:(BOOL)animated
+{
+    HLSContainerContent *appearingContainerContent = nil;
+    HLSContainerContent *disappearingContainerContent = nil;
+    
+    if ([animation.tag isEqualToString:@"push_animation"]) {
+        appearingContainerContent = [self topContainerContent];
+        disappearingContainerContent = [self secondTopContainerContent];        
+    }
+    else {
+        appearingContainerContent = [self secondTopContainerContent];
+        disappearingContainerContent = [self topContainerContent];
+    }
+    
+    // Forward events (willHide is sent to the delegate before willDisappear is sent to the view controller)
+    if (disappearingContainerContent && [self.delegate respondsToSelector:@selector(containerStack:willHideViewController:animated:)]) {
+        [self.delegate containerStack:self willHideViewController:disappearingContainerContent.viewController animated:animated];
+    }
+    [disappearingContainerContent viewWillDisappear:animated movingFromParentViewController:YES];
+    
+    // Forward events (willShow is sent to the delegate before willAppear is sent to the view controller)
+    if (appearingContainerContent && [self.delegate respondsToSelector:@selector(containerStack:willShowViewController:animated:)]) {
+        [self.delegate containerStack:self willShowViewController:appearingContainerContent.viewController animated:animated];
+    }
+    [appearingContainerContent viewWillAppear:animated movingToParentViewController:YES];
+}
+
+#pragma mark Transition cost reduction
+
+- (void)reduceTransitionCost
+{
+    if (! [self isReducingTransitionCost]) {
+        HLSLoggerInfo(@"Transition costs are reduced for %.0f seconds in %@", self.reducedCostDuration, self.containerViewController);
+    }
+    m_reducedCostEndTime = [NSDate timeIntervalSinceReferenceDate] + self.reducedCostDuration;
+    m_slowTransitionCount = 0;
+}
+
+- (void)startMeasuringTransitionAnimation:(HLSAnimation *)animation
+{
+    NSDictionary *report = [[HLSAnimationProfiler sharedAnimationProfiler] reportForTag:animation.tag];
+    m_profiledFrameCount = [[report objectForKey:HLSAnimationProfilerFrameCountKey] unsignedIntegerValue];
+    m_profiledDroppedFrameCount = [[report objectForKey:HLSAnimationProfilerDroppedFrameCountKey] unsignedIntegerValue];
+}
+
+- (void)stopMeasuringTransitionAnimation:(HLSAnimation *)animation
+{
+    if (! (self.reducedCostTriggers & HLSContainerStackReducedCostTriggerDroppedFrames)) {
+        return;
+    }
+    
+    // Profiler statistics are cumulative. Only consider the frames displayed since the transition started. If no
+    // frame has been measured (profiler disabled, scrubbed transition), nothing can be said about the transition
+    NSDictionary *report = [[HLSAnimationProfiler sharedAnimationProfiler] reportForTag:animation.tag];
+    NSUInteger frameCount = [[report objectForKey:HLSAnimationProfilerFrameCountKey] unsignedIntegerValue];
+    NSUInteger droppedFrameCount = [[report objectForKey:HLSAnimationProfilerDroppedFrameCountKey] unsignedIntegerValue];
+    if (frameCount <= m_profiledFrameCount) {
+        return;
+    }
+    
+    float droppedFrameRatio = (float)(droppedFrameCount - m_profiledDroppedFrameCount) / (frameCount - m_profiledFrameCount);
+    if (droppedFrameRatio > self.reducedCostDroppedFrameRatio) {
+        ++m_slowTransitionCount;
+        if (m_slowTransitionCount >= kReducedCostSlowTransitionCount) {
+            [self reduceTransitionCost];
+        }
+    }
+    else {
+        m_slowTransitionCount = 0;
+    }
+}
+
+#pragma mark Offscreen view management
+
+/**
+ * Return the contents whose views are loaded but not displayed, sorted from the least to the most recently displayed
+ */
+- (NSArray *)offscreenContainerContents
+{
+    NSMutableArray *offscreenContainerContents = [NSMutableArray array];
+    for (HLSContainerContent *containerContent in self.containerContents) {
+        if ([containerContent viewIfLoaded] && ! containerContent.addedToContainerView) {
+            [offscreenContainerContents addObject:containerContent];
+        }
+    }
+    
+    NSSortDescriptor *removalTimeSortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"removalTime" ascending:YES];
+    return [offscreenContainerContents sortedArrayUsingDescriptor:removalTimeSortDescriptor];
+}
+
+- (NSUInteger)offscreenViewFootprint
+{
+    NSUInteger footprint = 0;
+    for (HLSContainerContent *containerContent in [self offscreenContainerContents]) {
+        footprint += [containerContent estimatedViewFootprint];
+    }
+    return footprint;
+}
+
+- (void)unloadOffscreenViewsToFootprint:(NSUInteger)footprint
+{
+    if (footprint == HLSContainerStackUnlimitedFootprint) {
+        return;
+    }
+    
+    NSArray *offscreenContainerContents = [self offscreenContainerContents];
+    NSUInteger *footprints = malloc([offscreenContainerContents count] * sizeof(NSUInteger));
+    NSUInteger totalFootprint = 0;
+    for (NSUInteger i = 0; i < [offscreenContainerContents count]; ++i) {
+        footprints[i] = [[offscreenContainerContents objectAtIndex:i] estimatedViewFootprint];
+        totalFootprint += footprints[i];
+    }
+    
+    // Least recently displayed first
+    for (NSUInteger i = 0; i < [offscreenContainerContents count] && totalFootprint > footprint; ++i) {
+        HLSContainerContent *containerContent = [offscreenContainerContents objectAtIndex:i];
+        HLSLoggerDebug(@"Unload the view of %@ (about %d bytes)", containerContent.viewController, footprints[i]);
+        [containerContent releaseViews];
+        totalFootprint -= footprints[i];
+    }
+    
+    free(footprints);
+}
+
+#pragma mark Memory accounting
+
+- (NSUInteger)estimatedViewFootprint
+{
+    NSUInteger footprint = 0;
+    for (HLSContainerContent *containerContent in self.containerContents) {
+        footprint += [containerContent estimatedViewFootprint];
+    }
+    return footprint;
+}
+
+- (NSString *)footprintReport
+{
+    NSUInteger nbrContainerContents = [self.containerContents count];
+    
+    // Footprints are estimated once
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:nbrContainerContents];
+    NSUInteger totalFootprint = 0;
+    for (NSUInteger i = 0; i < nbrContainerContents; ++i) {
+        HLSContainerContent *containerContent = [self.containerContents objectAtIndex:i];
+        NSUInteger footprint = [containerContent estimatedViewFootprint];
+        totalFootprint += footprint;
+        
+        NSString *state = nil;
+        if (! [containerContent viewIfLoaded]) {
+            state = @"not loaded";
+        }
+        else if (containerContent.addedToContainerView) {
+            state = @"displayed";
+        }
+        else {
+            state = @"offscreen";
+        }
+        
+        [entries addObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:footprint], @"footprint",
+                            [NSString stringWithFormat:@"    - %@ (%p), depth %d: %@, %@\n", 
+                             [containerContent.viewController class],
+                             containerContent.viewController,
+                             nbrContainerContents - i - 1,
+                             HLSContainerStackFormattedFootprint(footprint),
+                             state], @"line", nil]];
+    }
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"  %@ (%p): %@ estimated for %d view controllers\n",
+                               [self.containerViewController class],
+                               self.containerViewController,
+                               HLSContainerStackFormattedFootprint(totalFootprint),
+                               nbrContainerContents];
+    NSSortDescriptor *footprintSortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"footprint" ascending:NO];
+    for (NSDictionary *entry in [entries sortedArrayUsingDescriptor:footprintSortDescriptor]) {
+        [report appendString:[entry objectForKey:@"line"]];
+    }
+    return [NSString stringWithString:report];
+}
+
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    // The order in which observers are notified is not defined. The first stack notified makes the global footprint
+    // report for all stacks, before any of them unloads views
+    if (notification != s_lastMemoryWarningNotification) {
+        [s_lastMemoryWarningNotification release];
+        s_lastMemoryWarningNotification = [notification retain];
+        
+        NSString *report = [HLSContainerStack globalFootprintReport];
+        [s_lastMemoryWarningFootprintReport release];
+        s_lastMemoryWarningFootprintReport = [report retain];
+        HLSLoggerInfo(@"Memory warning received. %@", report);
+    }
+    
+    if (self.reducedCostTriggers & HLSContainerStackReducedCostTriggerMemoryWarning) {
+        [self reduceTransitionCost];
+    }
+    
+    [self unloadOffscreenViewsToFootprint:[self offscreenViewFootprint] / 2];
+}
+
 #pragma mark HLSAnimationDelegate protocol implementation
 
 - (void)animationWillStart:(HLSAnimation *)animation animated:(BOOL)animated
@@ -1011,29 +1683,22 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     
     // Extra work needed for push and pop animations
     if ([animation.tag isEqualToString:@"push_animation"] || [animation.tag isEqualToString:@"pop_animation"]) {
-        HLSContainerContent *appearingContainerContent = nil;
-        HLSContainerContent *disappearingContainerContent = nil;
-        
-        if ([animation.tag isEqualToString:@"push_animation"]) {
-            appearingContainerContent = [self topContainerContent];
-            disappearingContainerContent = [self secondTopContainerContent];        
-        }
-        else {
-            appearingContainerContent = [self secondTopContainerContent];
-            disappearingContainerContent = [self topContainerContent];
+        // Events for an interactive pop are only sent when it is committed
+        if (animation != self.interactivePopAnimation) {
+            [self forwardTransitionWillStartEventsForAnimation:animation animated:animated];
         }
         
-        // Forward events (willHide is sent to the delegate before willDisappear is sent to the view controller)
-        if (disappearingContainerContent && [self.delegate respondsToSelector:@selector(containerStack:willHideViewController:animated:)]) {
-            [self.delegate containerStack:self willHideViewController:disappearingContainerContent.viewController animated:animated];
+        if (animated) {
+            [self startMeasuringTransitionAnimation:animation];
         }
-        [disappearingContainerContent viewWillDisappear:animated movingFromParentViewController:YES];
         
-        // Forward events (willShow is sent to the delegate before willAppear is sent to the view controller)
-        if (appearingContainerContent && [self.delegate respondsToSelector:@selector(containerStack:willShowViewController:animated:)]) {
-            [self.delegate containerStack:self willShowViewController:appearingContainerContent.viewController animated:animated];
+        // Snapshots are taken after the view controllers have been notified, so that any change they make to their
+        // views when they are about to appear or disappear is captured. Both views involved in a push or pop
+        // transition belong to the group view of the top view controller
+        if (animated && (self.snapshottingTransitions || [self isReducingTransitionCost])) {
+            HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[[self topContainerContent] viewIfLoaded]];
+            [groupView replaceContentViewsWithSnapshots];
         }
-        [appearingContainerContent viewWillAppear:animated movingToParentViewController:YES];
     }
 }
 
@@ -1043,6 +1708,27 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
     
     // Extra work needed for push and pop animations
     if ([animation.tag isEqualToString:@"push_animation"] || [animation.tag isEqualToString:@"pop_animation"]) {
+        // Swap the real views back in (if snapshots were used) before the view controllers are notified
+        HLSContainerGroupView *groupView = [[self containerStackView] groupViewForContentView:[[self topContainerContent] viewIfLoaded]];
+        [groupView removeSnapshots];
+        
+        if (animated) {
+            [self stopMeasuringTransitionAnimation:animation];
+        }
+        
+        // Interactive pops: Nothing to do if cancelled, otherwise proceed as for a usual pop
+        if (animation == self.interactivePopAnimation) {
+            // Keep the animation alive until the end of this method
+            [[animation retain] autorelease];
+            self.interactivePopAnimation = nil;
+            
+            if (! m_interactivePopCommitted) {
+                [self interactivePopDidCancel];
+                return;
+            }
+            m_interactivePopCommitted = NO;
+        }
+        
         HLSContainerContent *appearingContainerContent = nil;
         HLSContainerContent *disappearingContainerContent = nil;
         
@@ -1078,6 +1764,7 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                 // The view is only removed from the view hierarchy, so that blending can be made faster. The view is NOT unloaded
                 // (on iOS 4 and 5, it will only be unloaded if a memory warning is later received)
                 [containerContentAtCapacity removeViewFromContainerStackView];
+                [self unloadOffscreenViewsToFootprint:self.offscreenViewFootprintBudget];
             }
             else {
                 [self.containerContents removeObject:containerContentAtCapacity];
@@ -1095,6 +1782,12 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
                           coverViewController:disappearingViewController
                                      animated:animated];
             }
+            
+            // View controller replaced during batched updates
+            if (self.pendingRemovalContainerContent) {
+                [self.containerContents removeObject:self.pendingRemovalContainerContent];
+                self.pendingRemovalContainerContent = nil;
+            }
         }
         else if ([animation.tag isEqualToString:@"pop_animation"]) {
             [self.containerContents removeObject:disappearingContainerContent];
@@ -1110,6 +1803,9 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
         }
     
         [disappearingViewController release];
+        
+        // Deep stacks would otherwise keep two additional wrapper views per level
+        [self flattenGroupViews];
     }
 }
 
@@ -1169,6 +1865,8 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
             [animation playAnimated:NO];
         }
     }
+    
+    [self flattenGroupViews];
 }
 
 #pragma mark Description
@@ -1211,3 +1909,15 @@ const NSUInteger HLSContainerStackUnlimitedCapacity = NSUIntegerMax;
 }
 
 @end
+
+#pragma mark Static functions
+
+static NSString *HLSContainerStackFormattedFootprint(NSUInteger footprint)
+{
+    if (footprint >= 1024 * 1024) {
+        return [NSString stringWithFormat:@"%.1f MB", footprint / (1024. * 1024.)];
+    }
+    else {
+        return [NSString stringWithFormat:@"%.1f KB", footprint / 1024.];
+    }
+}
@@ -97,7 +97,8 @@
  *
  *
  * The HLSContainerStackView class simply implements the above view hierarchy and provides methods for easy insertion
- * and removal of views.
+ * and removal of views. Each group view level also wraps its front and back views into wrapper views, which are only
+ * needed for animations. They can be removed when no transition is running (see -flattenGroupViews).
  *
  * Designated initializer: -initWithFrame:
  */
@@ -127,6 +128,12 @@
  */
 - (HLSContainerGroupView *)groupViewForContentView:(UIView *)contentView;
 
+/**
+ * Flatten all group views (see -[HLSContainerGroupView flattenWrapperViews]). Call this method when no transition
+ * is running to reduce the number of views in the hierarchy
+ */
+- (void)flattenGroupViews;
+
 @property (nonatomic, assign) id<HLSContainerStackViewDelegate> delegate;
 
 @end
@@ -146,4 +146,11 @@
     return nil;
 }
 
+- (void)flattenGroupViews
+{
+    for (HLSContainerGroupView *groupView in self.groupViews) {
+        [groupView flattenWrapperViews];
+    }
+}
+
 @end
@@ -26,6 +26,9 @@ extern NSString * const HLSPlaceholderPreloadSegueIdentifierPrefix;
  * controller must be initially loaded. This index must be between 0 and 19, which allows preloading of 20 view 
  * controllers. This should be sufficient: Though a placeholder view controller can hold more than 20 view controllers,
  * this should never occur in practice
+ *
+ * To avoid loading the destination view when the segue fires, its destination can be preloaded in advance, see
+ * UIViewController+HLSSeguePreloading.h
  */
 @interface HLSPlaceholderInsetSegue : UIStoryboardSegue {
 @private
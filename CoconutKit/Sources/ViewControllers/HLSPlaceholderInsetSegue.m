@@ -10,6 +10,7 @@
 
 #import "HLSLogger.h"
 #import "HLSPlaceholderViewController.h"
+#import "UIViewController+HLSSeguePreloading.h"
 
 NSString * const HLSPlaceholderPreloadSegueIdentifierPrefix = @"hls_preload_at_index_";
 
@@ -17,6 +18,18 @@ NSString * const HLSPlaceholderPreloadSegueIdentifierPrefix = @"hls_preload_at_i
 
 - (id)initWithIdentifier:(NSString *)identifier source:(UIViewController *)source destination:(UIViewController *)destination
 {
+    // Use the destination preloaded for this segue instead, if any (see UIViewController+HLSSeguePreloading.h)
+    UIViewController *preloadedDestination = [source takePreloadedDestinationViewControllerForSegueWithIdentifier:identifier];
+    if (preloadedDestination) {
+        if ([preloadedDestination class] == [destination class]) {
+            destination = preloadedDestination;
+        }
+        else {
+            HLSLoggerWarn(@"The preloaded destination %@ does not match the destination %@ of the segue '%@' and is discarded",
+                          preloadedDestination, destination, identifier);
+        }
+    }
+    
     if ((self = [super initWithIdentifier:identifier source:source destination:destination])) {
         self.index = 0;
         self.transitionClass = [HLSTransitionNone class];
@@ -92,6 +92,8 @@
  * If those view controllers bear heavy views, you do not want to have them destroyed when you switch view controllers, 
  * since this would make navigating between tabs slow. In such cases, it makes sense to keep strong references to
  * those view controllers elsewhere (most probably as additional ivars of your placeholder view controller subclass)
+ * or, better, to register them as preloaded inset view controllers (see -addPreloadedInsetViewController:). Their views 
+ * are then loaded in advance while the application is idle, so that swapping insets only costs the transition
  *
  * Designated initializer: -initWithNibName:bundle:
  */
@@ -100,6 +102,8 @@
     NSMutableArray *m_containerStacks;
     NSArray *m_placeholderViews;                            // Views onto which the inset views are drawn
     HLSAutorotationMode m_autorotationMode;
+    NSMutableArray *m_preloadedInsetViewControllers;        // Candidate insets whose views are loaded during idle time
+    BOOL m_insetPreloadingSuspended;                        // Set to YES after a memory warning until insets are swapped again
     id<HLSPlaceholderViewControllerDelegate> m_delegate;
     BOOL m_loadedOnce;
 }
@@ -140,6 +144,30 @@
            withTransitionClass:(Class)transitionClass
                       duration:(NSTimeInterval)duration;
 
+/**
+ * Register a view controller which is likely to be displayed as inset later (e.g. the view controllers of a tab-like
+ * interface). Preloaded inset view controllers are retained by the placeholder view controller until they are removed. 
+ * While the placeholder view controller is visible, the views of preloaded inset view controllers are loaded one at a 
+ * time when the application is idle (not while the user is interacting with it, e.g. scrolling), in the order in which 
+ * they were registered. Displaying one of them with one of the -setInsetViewController... methods then only costs the 
+ * transition animation.
+ *
+ * When a memory warning is received, the views of preloaded inset view controllers which are not displayed are unloaded,
+ * and preloading is suspended until an inset view controller is set again or until the placeholder view controller
+ * appears again
+ */
+- (void)addPreloadedInsetViewController:(UIViewController *)viewController;
+
+/**
+ * Unregister a preloaded inset view controller. Its view is left as is
+ */
+- (void)removePreloadedInsetViewController:(UIViewController *)viewController;
+
+/**
+ * The view controllers registered for preloading, in registration order
+ */
+@property (nonatomic, readonly, retain) NSArray *preloadedInsetViewControllers;
+
 /**
  * The views where inset view controller's views must be drawn. Must either be created programmatically in a subclass' 
  * -loadView method or bound to a UIView using Interface Builder. You cannot change the number of placeholder views 
@@ -19,6 +19,12 @@
 - (void)hlsPlaceholderViewControllerInit;
 
 @property (nonatomic, retain) NSMutableArray *containerStacks;
+@property (nonatomic, retain) NSMutableArray *preloadedInsetViewControllers;
+
+- (BOOL)isDisplayingInsetViewController:(UIViewController *)viewController;
+
+- (void)scheduleInsetViewPreloading;
+- (void)preloadInsetViews;
 
 @end
 
@@ -45,6 +51,7 @@
 - (void)hlsPlaceholderViewControllerInit
 {
     self.autorotationMode = HLSAutorotationModeContainer;
+    self.preloadedInsetViewControllers = [NSMutableArray array];
 }
 
 - (void)awakeFromNib
@@ -67,7 +74,10 @@
 
 - (void)dealloc
 {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(preloadInsetViews) object:nil];
+    
     self.containerStacks = nil;
+    self.preloadedInsetViewControllers = nil;
     self.delegate = nil;
     
     [super dealloc];
@@ -90,6 +100,8 @@
 
 @synthesize placeholderViews = m_placeholderViews;
 
+@synthesize preloadedInsetViewControllers = m_preloadedInsetViewControllers;
+
 @synthesize autorotationMode = m_autorotationMode;
 
 - (void)setAutorotationMode:(HLSAutorotationMode)autorotationMode
@@ -218,6 +230,9 @@
     for (HLSContainerStack *containerStack in self.containerStacks) {
         [containerStack viewDidAppear:animated];
     }
+    
+    m_insetPreloadingSuspended = NO;
+    [self scheduleInsetViewPreloading];
 }
 
 - (void)viewWillDisappear:(BOOL)animated
@@ -227,6 +242,8 @@
     for (HLSContainerStack *containerStack in self.containerStacks) {
         [containerStack viewWillDisappear:animated];
     }
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(preloadInsetViews) object:nil];
 }
 
 - (void)viewDidDisappear:(BOOL)animated
@@ -238,6 +255,21 @@
     }
 }
 
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    
+    // Evict the views of preloaded insets which are not displayed, and do not load them again immediately
+    for (UIViewController *viewController in self.preloadedInsetViewControllers) {
+        if (! [self isDisplayingInsetViewController:viewController] && ! [viewController viewIfLoaded].window) {
+            [viewController unloadViews];
+        }
+    }
+    
+    m_insetPreloadingSuspended = YES;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(preloadInsetViews) object:nil];
+}
+
 #pragma mark Orientation management (these methods are only called if the view controller is visible)
 
 - (BOOL)shouldAutorotate
@@ -348,7 +380,70 @@
     [containerStack pushViewController:insetViewController
                    withTransitionClass:transitionClass
                               duration:duration
-                              animated:YES];       
+                              animated:YES];
+    
+    m_insetPreloadingSuspended = NO;
+    [self scheduleInsetViewPreloading];
+}
+
+#pragma mark Inset preloading
+
+- (void)addPreloadedInsetViewController:(UIViewController *)viewController
+{
+    if (! viewController) {
+        return;
+    }
+    
+    if ([self.preloadedInsetViewControllers containsObject:viewController]) {
+        HLSLoggerDebug(@"The view controller %@ is already registered for preloading", viewController);
+        return;
+    }
+    
+    [self.preloadedInsetViewControllers addObject:viewController];
+    [self scheduleInsetViewPreloading];
+}
+
+- (void)removePreloadedInsetViewController:(UIViewController *)viewController
+{
+    [self.preloadedInsetViewControllers removeObject:viewController];
+}
+
+- (BOOL)isDisplayingInsetViewController:(UIViewController *)viewController
+{
+    for (HLSContainerStack *containerStack in self.containerStacks) {
+        if ([[containerStack viewControllers] containsObject:viewController]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)scheduleInsetViewPreloading
+{
+    if (! [self isViewVisible] || m_insetPreloadingSuspended) {
+        return;
+    }
+    
+    // Same as for HLSWizardViewController: Only performed in the default run loop mode, i.e. not while the user is interacting 
+    // with the interface
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(preloadInsetViews) object:nil];
+    [self performSelector:@selector(preloadInsetViews)
+               withObject:nil
+               afterDelay:0.
+                  inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
+- (void)preloadInsetViews
+{
+    // One view at a time so that the main thread is never blocked for long
+    for (UIViewController *viewController in self.preloadedInsetViewControllers) {
+        if (! [viewController isViewLoaded] && ! [self isDisplayingInsetViewController:viewController]) {
+            HLSLoggerDebug(@"Preload the view of inset view controller %@", viewController);
+            [viewController view];
+            [self scheduleInsetViewPreloading];
+            return;
+        }
+    }
 }
 
 #pragma mark HLSContainerStackDelegate protocol implementation
@@ -8,6 +8,7 @@
 
 #import "HLSContainerStack.h"
 #import "HLSViewController.h"
+#import "HLSViewControllerReusePool.h"
 
 // Forward declarations
 @protocol HLSStackControllerDelegate;
@@ -74,6 +75,13 @@
     HLSContainerStack *m_containerStack;
     NSUInteger m_capacity;
     HLSAutorotationMode m_autorotationMode;
+    BOOL m_snapshottingTransitions;
+    BOOL m_deferringHiddenChildrenRotation;
+    BOOL m_interactivePopEnabled;
+    NSUInteger m_reducedCostTriggers;
+    Class m_reducedCostTransitionClass;
+    UIPanGestureRecognizer *m_interactivePopGestureRecognizer;
+    HLSViewControllerReusePool *m_reusePool;
     id<HLSStackControllerDelegate> m_delegate;
 }
 
@@ -106,6 +114,65 @@
  */
 @property (nonatomic, assign) HLSAutorotationMode autorotationMode;
 
+/**
+ * If set to YES, animated push and pop transitions animate snapshots of the view controller's views instead of their
+ * live view hierarchies. Refer to the -[HLSContainerStack snapshottingTransitions] documentation for more information
+ *
+ * The default value is NO
+ */
+@property (nonatomic, assign, getter=isSnapshottingTransitions) BOOL snapshottingTransitions;
+
+/**
+ * If set to YES, only the top view controller is laid out and notified when the stack controller rotates, views hidden 
+ * below it are laid out again right before they are revealed. Refer to the -[HLSContainerStack deferringHiddenChildrenRotation] 
+ * documentation for more information
+ *
+ * The default value is NO
+ */
+@property (nonatomic, assign, getter=isDeferringHiddenChildrenRotation) BOOL deferringHiddenChildrenRotation;
+
+/**
+ * If set to YES, the top view controller can be popped by panning horizontally from left to right. The pop animation
+ * (the reverse animation of the transition which was used when the top view controller was pushed) then follows the 
+ * finger. When the finger is lifted, the pop is performed if the pan went further than half the container width (taking 
+ * the velocity of the gesture into account), otherwise it is cancelled. Refer to the -[HLSContainerStack beginInteractivePop] 
+ * documentation for more information about the events received during an interactive pop
+ *
+ * This works best with transition animations moving the views horizontally. The default value is NO
+ */
+@property (nonatomic, assign, getter=isInteractivePopEnabled) BOOL interactivePopEnabled;
+
+/**
+ * The conditions under which the stack controller automatically uses cheaper push transitions, and the transition 
+ * class used in such cases. Refer to the -[HLSContainerStack reducedCostTriggers] documentation for more information
+ *
+ * The default values are HLSContainerStackReducedCostTriggerNone and HLSTransitionCrossDissolve
+ */
+@property (nonatomic, assign) NSUInteger reducedCostTriggers;
+@property (nonatomic, assign) Class reducedCostTransitionClass;
+
+/**
+ * Opt-in view controller reuse. If a pool is set, view controllers conforming to the HLSReusableViewController protocol
+ * are enqueued into it once they have been popped (after the delegate has been notified), so that they can be obtained
+ * again using -dequeueReusableViewControllerOfClass: instead of being created (and their view loaded) from scratch.
+ * Refer to the HLSViewControllerReusePool documentation for more information about how views are kept loaded. The same
+ * pool can be shared between several stack controllers
+ *
+ * Default value is nil (no reuse)
+ */
+@property (nonatomic, retain) HLSViewControllerReusePool *reusePool;
+
+/**
+ * Return a popped view controller of the specified class which can be pushed again (it has received a -prepareForReuse
+ * message), or nil if none is available or if no reuse pool has been set. Typical use:
+ *
+ *   DetailViewController *detailViewController = [stackController dequeueReusableViewControllerOfClass:[DetailViewController class]];
+ *   if (! detailViewController) {
+ *       detailViewController = [[[DetailViewController alloc] init] autorelease];
+ *   }
+ */
+- (id)dequeueReusableViewControllerOfClass:(Class)viewControllerClass;
+
 /**
  * The stack controller delegate
  */
@@ -239,6 +306,14 @@
  */
 - (void)removeViewController:(UIViewController *)viewController animated:(BOOL)animated;
 
+/**
+ * Batch several of the above insertion and removal calls, so that a single transition is played when the updates
+ * are committed, and only the views which are needed are loaded. Refer to the -[HLSContainerStack beginUpdates] 
+ * documentation for more information
+ */
+- (void)beginUpdates;
+- (void)commitUpdatesAnimated:(BOOL)animated;
+
 @end
 
 /**
@@ -10,6 +10,7 @@
 
 #import "HLSAssert.h"
 #import "HLSContainerContent.h"
+#import "HLSFloat.h"
 #import "HLSLogger.h"
 #import "HLSStackPushSegue.h"
 #import "NSArray+HLSExtensions.h"
@@ -20,6 +21,9 @@
 
 @property (nonatomic, retain) HLSContainerStack *containerStack;
 @property (nonatomic, assign) NSUInteger capacity;
+@property (nonatomic, retain) UIPanGestureRecognizer *interactivePopGestureRecognizer;
+
+- (void)pan:(UIPanGestureRecognizer *)panGestureRecognizer;
 
 @end
 
@@ -31,12 +35,17 @@
 {
     if ((self = [super init])) {
         self.autorotationMode = HLSAutorotationModeContainer;
+        self.reducedCostTransitionClass = [HLSTransitionCrossDissolve class];
         
         self.containerStack = [[[HLSContainerStack alloc] initWithContainerViewController:self 
                                                                                  capacity:capacity 
                                                                                  removing:NO
                                                                   rootViewControllerFixed:YES] autorelease];
         self.containerStack.autorotationMode = self.autorotationMode;
+        self.containerStack.snapshottingTransitions = self.snapshottingTransitions;
+        self.containerStack.deferringHiddenChildrenRotation = self.deferringHiddenChildrenRotation;
+        self.containerStack.reducedCostTriggers = self.reducedCostTriggers;
+        self.containerStack.reducedCostTransitionClass = self.reducedCostTransitionClass;
         self.containerStack.delegate = self;
         [self.containerStack pushViewController:rootViewController 
                             withTransitionClass:[HLSTransitionNone class]
@@ -56,6 +65,7 @@
     if ((self = [super initWithCoder:aDecoder])) {
         self.capacity = HLSContainerStackDefaultCapacity;
         self.autorotationMode = HLSAutorotationModeContainer;
+        self.reducedCostTransitionClass = [HLSTransitionCrossDissolve class];
     }
     return self;
 }
@@ -75,6 +85,10 @@
                                                                              removing:NO
                                                               rootViewControllerFixed:YES] autorelease];
     self.containerStack.autorotationMode = self.autorotationMode;
+    self.containerStack.snapshottingTransitions = self.snapshottingTransitions;
+    self.containerStack.deferringHiddenChildrenRotation = self.deferringHiddenChildrenRotation;
+    self.containerStack.reducedCostTriggers = self.reducedCostTriggers;
+    self.containerStack.reducedCostTransitionClass = self.reducedCostTransitionClass;
     
     // Load the root view controller when using segues. A reserved segue called 'hls_root' must be used for such purposes
     @try {
@@ -97,6 +111,7 @@
 - (void)dealloc
 {
     self.containerStack = nil;
+    self.reusePool = nil;
     self.delegate = nil;
     
     [super dealloc];
@@ -106,6 +121,8 @@
 {
     [super releaseViews];
     
+    self.interactivePopGestureRecognizer = nil;
+    
     [self.containerStack releaseViews];
 }
 
@@ -142,6 +159,59 @@
     self.containerStack.autorotationMode = autorotationMode;
 }
 
+@synthesize snapshottingTransitions = m_snapshottingTransitions;
+
+- (void)setSnapshottingTransitions:(BOOL)snapshottingTransitions
+{
+    m_snapshottingTransitions = snapshottingTransitions;
+    
+    // Same remark as for -setAutorotationMode:
+    self.containerStack.snapshottingTransitions = snapshottingTransitions;
+}
+
+@synthesize deferringHiddenChildrenRotation = m_deferringHiddenChildrenRotation;
+
+- (void)setDeferringHiddenChildrenRotation:(BOOL)deferringHiddenChildrenRotation
+{
+    m_deferringHiddenChildrenRotation = deferringHiddenChildrenRotation;
+    
+    // Same remark as for -setAutorotationMode:
+    self.containerStack.deferringHiddenChildrenRotation = deferringHiddenChildrenRotation;
+}
+
+@synthesize reducedCostTriggers = m_reducedCostTriggers;
+
+- (void)setReducedCostTriggers:(NSUInteger)reducedCostTriggers
+{
+    m_reducedCostTriggers = reducedCostTriggers;
+    
+    // Same remark as for -setAutorotationMode:
+    self.containerStack.reducedCostTriggers = reducedCostTriggers;
+}
+
+@synthesize reducedCostTransitionClass = m_reducedCostTransitionClass;
+
+- (void)setReducedCostTransitionClass:(Class)reducedCostTransitionClass
+{
+    m_reducedCostTransitionClass = reducedCostTransitionClass;
+    
+    // Same remark as for -setAutorotationMode:
+    self.containerStack.reducedCostTransitionClass = reducedCostTransitionClass;
+}
+
+@synthesize interactivePopEnabled = m_interactivePopEnabled;
+
+- (void)setInteractivePopEnabled:(BOOL)interactivePopEnabled
+{
+    m_interactivePopEnabled = interactivePopEnabled;
+    
+    self.interactivePopGestureRecognizer.enabled = interactivePopEnabled;
+}
+
+@synthesize interactivePopGestureRecognizer = m_interactivePopGestureRecognizer;
+
+@synthesize reusePool = m_reusePool;
+
 @synthesize delegate = m_delegate;
 
 - (UIViewController *)rootViewController
@@ -164,6 +234,11 @@
     return [self.containerStack count];
 }
 
+- (id)dequeueReusableViewControllerOfClass:(Class)viewControllerClass
+{
+    return [self.reusePool dequeueViewControllerOfClass:viewControllerClass];
+}
+
 #pragma mark View lifecycle
 
 // Deprecated since iOS 6
@@ -190,6 +265,10 @@
     self.view.autoresizingMask = HLSViewAutoresizingAll;
     
     self.containerStack.containerView = self.view;
+    
+    self.interactivePopGestureRecognizer = [[[UIPanGestureRecognizer alloc] initWithTarget:self action:@selector(pan:)] autorelease];
+    self.interactivePopGestureRecognizer.enabled = self.interactivePopEnabled;
+    [self.view addGestureRecognizer:self.interactivePopGestureRecognizer];
 }
 
 - (void)viewWillAppear:(BOOL)animated
@@ -220,6 +299,58 @@
     [self.containerStack viewDidDisappear:animated];
 }
 
+#pragma mark Gesture recognition
+
+- (void)pan:(UIPanGestureRecognizer *)panGestureRecognizer
+{
+    CGFloat width = CGRectGetWidth(self.view.bounds);
+    if (floatle(width, 0.f)) {
+        return;
+    }
+    
+    switch (panGestureRecognizer.state) {
+        case UIGestureRecognizerStateBegan: {
+            // Only left to right pans can start a pop
+            CGPoint velocity = [panGestureRecognizer velocityInView:self.view];
+            if (floatle(velocity.x, 0.f) || fabsf(velocity.y) > fabsf(velocity.x)) {
+                break;
+            }
+            [self.containerStack beginInteractivePop];
+            break;
+        }
+            
+        case UIGestureRecognizerStateChanged: {
+            CGPoint translation = [panGestureRecognizer translationInView:self.view];
+            self.containerStack.interactivePopProgress = MIN(MAX(translation.x / width, 0.f), 1.f);
+            break;
+        }
+            
+        case UIGestureRecognizerStateEnded: {
+            // Project where the finger would be in a short while, so that quick flicks also pop
+            static const NSTimeInterval kProjectionDuration = 0.15;
+            CGPoint velocity = [panGestureRecognizer velocityInView:self.view];
+            float projectedProgress = self.containerStack.interactivePopProgress + velocity.x * kProjectionDuration / width;
+            if (projectedProgress > 0.5f) {
+                [self.containerStack finishInteractivePop];
+            }
+            else {
+                [self.containerStack cancelInteractivePop];
+            }
+            break;
+        }
+            
+        case UIGestureRecognizerStateCancelled:
+        case UIGestureRecognizerStateFailed: {
+            [self.containerStack cancelInteractivePop];
+            break;
+        }
+            
+        default: {
+            break;
+        }
+    }
+}
+
 #pragma mark Orientation management
 
 - (BOOL)shouldAutorotate
@@ -356,6 +487,16 @@
     [self.containerStack removeViewController:viewController animated:animated];
 }
 
+- (void)beginUpdates
+{
+    [self.containerStack beginUpdates];
+}
+
+- (void)commitUpdatesAnimated:(BOOL)animated
+{
+    [self.containerStack commitUpdatesAnimated:animated];
+}
+
 #pragma mark HLSContainerStackDelegate protocol implementation
 
 - (void)containerStack:(HLSContainerStack *)containerStack
@@ -436,6 +577,11 @@ willPushViewController:(UIViewController *)pushedViewController
                   revealViewController:revealedViewController
                               animated:animated];
     }
+    
+    // The delegate might have pushed the view controller again, in which case it is not enqueued
+    if ([poppedViewController conformsToProtocol:@protocol(HLSReusableViewController)]) {
+        [self.reusePool enqueueViewController:poppedViewController];
+    }
 }
 
 @end
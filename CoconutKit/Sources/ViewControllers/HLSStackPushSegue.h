@@ -21,6 +21,9 @@ extern NSString * const HLSStackRootSegueIdentifier;
  * Each HLSStackController dropped onto a storyboard must be connected to its root view controller using
  * a segue with the identifier 'hls_root'. To push a view controller B onto another one A already in the 
  * stack, connect A with B using an HLSStackPushSegue
+ *
+ * To avoid loading the destination view when the segue fires, its destination can be preloaded in advance, see
+ * UIViewController+HLSSeguePreloading.h
  */
 @interface HLSStackPushSegue : UIStoryboardSegue {
 @private
@@ -10,6 +10,7 @@
 
 #import "HLSLogger.h"
 #import "HLSStackController.h"
+#import "UIViewController+HLSSeguePreloading.h"
 
 NSString * const HLSStackRootSegueIdentifier = @"hls_root";
 
@@ -19,6 +20,18 @@ NSString * const HLSStackRootSegueIdentifier = @"hls_root";
 
 - (id)initWithIdentifier:(NSString *)identifier source:(UIViewController *)source destination:(UIViewController *)destination
 {
+    // Use the destination preloaded for this segue instead, if any (see UIViewController+HLSSeguePreloading.h)
+    UIViewController *preloadedDestination = [source takePreloadedDestinationViewControllerForSegueWithIdentifier:identifier];
+    if (preloadedDestination) {
+        if ([preloadedDestination class] == [destination class]) {
+            destination = preloadedDestination;
+        }
+        else {
+            HLSLoggerWarn(@"The preloaded destination %@ does not match the destination %@ of the segue '%@' and is discarded",
+                          preloadedDestination, destination, identifier);
+        }
+    }
+    
     if ((self = [super initWithIdentifier:identifier source:source destination:destination])) {
         self.transitionClass = [HLSTransitionNone class];
         self.duration = kAnimationTransitionDefaultDuration;
@@ -8,6 +8,10 @@
 
 #import "HLSViewController.h"
 
+// Forward declarations
+@class HLSCancellationToken;
+@class HLSTableSearchIndex;
+
 /**
  * This class conveniently implements the UISearchDisplayController behavior for a table view (the most common case). It 
  * manages two table views:
@@ -32,6 +36,13 @@
  * UISearchDisplayDelegate methods to return YES when the table view needs reloading. These methods are called each 
  * time the search string or the search scope are changed.
  *
+ * For large data sets, filtering as the user types can block input. In such cases, set the searchableObjects property
+ * to the objects to filter, and override -object:matchesSearchText:scopeButtonIndex: to define which objects match.
+ * Objects are then filtered on a background queue (each keystroke cancelling the previous search), and the
+ * searchResultsTableView is reloaded when the results (available from the searchResults property) are ready. If a
+ * search text refines the previous one, only the previous results are filtered again. For even larger data sets, enable
+ * the search index (see searchIndexEnabled) so that searches do not have to scan all objects.
+ *
  * HLSTableSearchDisplayViewController saves the current search criteria and restore them if the view has been
  * unloaded. You do not have to code this mechanism yourself.
  *
@@ -59,6 +70,13 @@
     BOOL m_searchInterfaceActive;
     UISearchDisplayController *m_searchController;
     BOOL m_firstLoad;
+    NSArray *m_searchableObjects;
+    NSArray *m_searchResults;
+    NSString *m_searchResultsSearchText;
+    NSInteger m_searchResultsScopeButtonIndex;
+    HLSCancellationToken *m_searchCancellationToken;
+    BOOL m_searchIndexEnabled;
+    HLSTableSearchIndex *m_searchIndex;
 }
 
 /**
@@ -81,4 +99,66 @@
  */
 @property (nonatomic, readonly, assign) UITableView *searchResultsTableView;
 
+/**
+ * The objects to filter when the search criteria change. If nil (the default), no filtering is performed by the view
+ * controller, and you have to implement filtering in -searchDisplayController:shouldReloadTableForSearchString: and
+ * -searchDisplayController:shouldReloadTableForSearchScope:. If set, objects are filtered asynchronously (using
+ * -object:matchesSearchText:scopeButtonIndex:) and the searchResultsTableView is reloaded when the results are
+ * available. In this case, do not return YES from the above methods (call the super implementation instead)
+ *
+ * Setting this property starts a new search if the search interface is active. The array is copied
+ */
+@property (nonatomic, copy) NSArray *searchableObjects;
+
+/**
+ * The searchable objects matching the current search criteria, in their original order. Use this array to
+ * implement the searchResultsTableView data source. All searchable objects are returned when no search text has been
+ * entered. Nil when searchableObjects is nil
+ */
+@property (nonatomic, readonly, retain) NSArray *searchResults;
+
+/**
+ * Return YES iff an object matches the search text and scope. The default implementation checks (case- and 
+ * diacritic-insensitively) whether the search text is contained in the object description (in the object itself 
+ * if it is a string), ignoring the scope. Override to implement your own criteria
+ *
+ * This method is called on a background thread, and must therefore be thread-safe. It must not access UIKit objects
+ * (e.g. the search bar)
+ */
+- (BOOL)object:(id)object matchesSearchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex;
+
+/**
+ * Return YES iff all objects matching searchText are known to match previousSearchText, in which case only the previous
+ * results are filtered when the search text changes. The default implementation returns YES iff searchText is
+ * obtained by appending characters to previousSearchText, which is correct for the default matching criterium. 
+ * Override and return NO if this is not true for your own criteria
+ */
+- (BOOL)searchText:(NSString *)searchText refinesSearchText:(NSString *)previousSearchText;
+
+/**
+ * If set to YES, the searchable objects are indexed in the background when they are set, by sorting the tokens 
+ * returned by -searchTokensForObject: (case- and diacritic-insensitively). An object then matches a search text 
+ * if each word of the search text is the prefix of one of its tokens, and searches cost O(log n + k) instead of
+ * requiring all objects to be scanned. -object:matchesSearchText:scopeButtonIndex: is not used in this case, the scope
+ * being checked with -object:matchesScopeButtonIndex: instead
+ *
+ * Default is NO
+ */
+@property (nonatomic, assign, getter=isSearchIndexEnabled) BOOL searchIndexEnabled;
+
+/**
+ * Return the tokens under which an object is indexed. The default implementation returns the words in the object
+ * description (in the object itself if it is a string). Override to implement your own criteria
+ *
+ * This method is called on a background thread, and must therefore be thread-safe
+ */
+- (NSArray *)searchTokensForObject:(id)object;
+
+/**
+ * Return YES iff an object matches a scope when the search index is used. The default implementation returns YES
+ *
+ * This method is called on a background thread, and must therefore be thread-safe
+ */
+- (BOOL)object:(id)object matchesScopeButtonIndex:(NSInteger)scopeButtonIndex;
+
 @end
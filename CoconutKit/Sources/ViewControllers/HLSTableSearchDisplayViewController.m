@@ -9,17 +9,35 @@
 #import "HLSTableSearchDisplayViewController.h"
 
 #import "HLSAssert.h"
+#import "HLSCancellationToken.h"
+#import "HLSTableSearchIndex.h"
 #import "NSBundle+HLSDynamicLocalization.h"
 
 // Height of the UIKit search bar
 static const CGFloat kSearchBarStandardHeight = 44.f;
 
+// Number of objects filtered between two cancellation checks
+static const NSUInteger kSearchCancellationCheckInterval = 256;
+
+// Static functions
+static dispatch_queue_t HLSTableSearchQueue(void);
+
 @interface HLSTableSearchDisplayViewController ()
 
 @property (nonatomic, retain) UISearchBar *searchBar;
 @property (nonatomic, retain) NSString *searchText;
 @property (nonatomic, retain) UISearchDisplayController *searchController;      // Not called searchDisplayController to avoid conflicts with 
                                                                                 // UIViewController's searchViewController property
+@property (nonatomic, retain) NSArray *searchResults;
+@property (nonatomic, retain) NSString *searchResultsSearchText;
+@property (nonatomic, retain) HLSCancellationToken *searchCancellationToken;
+@property (nonatomic, retain) HLSTableSearchIndex *searchIndex;
+
+- (void)rebuildSearchIndex;
+
+- (void)searchWithSearchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex;
+- (void)applySearchResults:(NSArray *)searchResults searchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex;
+
 @end
 
 @implementation HLSTableSearchDisplayViewController
@@ -28,8 +46,15 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 - (void)dealloc
 {
+    [self.searchCancellationToken cancel];
+    
     self.searchText = nil;
     self.searchController = nil;
+    self.searchableObjects = nil;
+    self.searchResults = nil;
+    self.searchResultsSearchText = nil;
+    self.searchCancellationToken = nil;
+    self.searchIndex = nil;
     
     [super dealloc];
 }
@@ -57,6 +82,51 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 
 @synthesize searchController = m_searchController;
 
+@synthesize searchableObjects = m_searchableObjects;
+
+- (void)setSearchableObjects:(NSArray *)searchableObjects
+{
+    if (m_searchableObjects == searchableObjects) {
+        return;
+    }
+    
+    [m_searchableObjects release];
+    m_searchableObjects = [searchableObjects copy];
+    
+    // Previous results cannot be refined anymore
+    [self.searchCancellationToken cancel];
+    self.searchCancellationToken = nil;
+    self.searchResults = nil;
+    self.searchResultsSearchText = nil;
+    
+    [self rebuildSearchIndex];
+    
+    if (m_searchableObjects) {
+        [self searchWithSearchText:self.searchText scopeButtonIndex:m_selectedScopeButtonIndex];
+    }
+    [self.tableView reloadData];
+}
+
+@synthesize searchResults = m_searchResults;
+
+@synthesize searchResultsSearchText = m_searchResultsSearchText;
+
+@synthesize searchCancellationToken = m_searchCancellationToken;
+
+@synthesize searchIndexEnabled = m_searchIndexEnabled;
+
+- (void)setSearchIndexEnabled:(BOOL)searchIndexEnabled
+{
+    if (m_searchIndexEnabled == searchIndexEnabled) {
+        return;
+    }
+    
+    m_searchIndexEnabled = searchIndexEnabled;
+    [self rebuildSearchIndex];
+}
+
+@synthesize searchIndex = m_searchIndex;
+
 #pragma mark View lifecycle
 
 - (void)viewDidLoad
@@ -173,15 +243,164 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 - (BOOL)searchDisplayController:(UISearchDisplayController *)controller shouldReloadTableForSearchString:(NSString *)searchString
 {
     self.searchText = searchString;
+    
+    // The table view will be reloaded when the results are available
+    if (self.searchableObjects) {
+        [self searchWithSearchText:searchString scopeButtonIndex:m_selectedScopeButtonIndex];
+        return NO;
+    }
+    
     return YES;
 }
 
 - (BOOL)searchDisplayController:(UISearchDisplayController *)controller shouldReloadTableForSearchScope:(NSInteger)searchOption
 {
     m_selectedScopeButtonIndex = searchOption;
+    
+    // The table view will be reloaded when the results are available
+    if (self.searchableObjects) {
+        [self searchWithSearchText:self.searchText scopeButtonIndex:searchOption];
+        return NO;
+    }
+    
+    return YES;
+}
+
+#pragma mark Searching
+
+- (BOOL)object:(id)object matchesSearchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex
+{
+    NSString *string = [object isKindOfClass:[NSString class]] ? object : [object description];
+    return [string rangeOfString:searchText options:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch].location != NSNotFound;
+}
+
+- (BOOL)searchText:(NSString *)searchText refinesSearchText:(NSString *)previousSearchText
+{
+    return [searchText hasPrefix:previousSearchText];
+}
+
+- (NSArray *)searchTokensForObject:(id)object
+{
+    NSString *string = [object isKindOfClass:[NSString class]] ? object : [object description];
+    return [HLSTableSearchIndex wordsInString:string];
+}
+
+- (BOOL)object:(id)object matchesScopeButtonIndex:(NSInteger)scopeButtonIndex
+{
     return YES;
 }
 
+- (void)rebuildSearchIndex
+{
+    if (! self.searchIndexEnabled || ! self.searchableObjects) {
+        self.searchIndex = nil;
+        return;
+    }
+    
+    // Built on the serial search queue, before any search which could use it is performed
+    HLSTableSearchIndex *searchIndex = [[[HLSTableSearchIndex alloc] init] autorelease];
+    self.searchIndex = searchIndex;
+    
+    NSArray *searchableObjects = self.searchableObjects;
+    __block HLSTableSearchDisplayViewController *blockSelf = [self retain];
+    dispatch_async(HLSTableSearchQueue(), ^{
+        [searchIndex buildWithObjects:searchableObjects tokensBlock:^(id object) {
+            return [blockSelf searchTokensForObject:object];
+        }];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [blockSelf release];
+        });
+    });
+}
+
+- (void)searchWithSearchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex
+{
+    // Each new search supersedes the one being performed, if any
+    [self.searchCancellationToken cancel];
+    self.searchCancellationToken = nil;
+    
+    if (! searchText) {
+        searchText = @"";
+    }
+    
+    // No filtering needed
+    if ([searchText length] == 0) {
+        [self applySearchResults:self.searchableObjects searchText:searchText scopeButtonIndex:scopeButtonIndex];
+        return;
+    }
+    
+    // Only filter the previous results if the new search refines the previous one (not needed when using the index)
+    NSArray *objects = self.searchableObjects;
+    HLSTableSearchIndex *searchIndex = self.searchIndex;
+    if (! searchIndex && self.searchResults && self.searchResultsSearchText && m_searchResultsScopeButtonIndex == scopeButtonIndex) {
+        if ([searchText isEqualToString:self.searchResultsSearchText]) {
+            [self.searchResultsTableView reloadData];
+            return;
+        }
+        
+        if ([self searchText:searchText refinesSearchText:self.searchResultsSearchText]) {
+            objects = self.searchResults;
+        }
+    }
+    
+    HLSCancellationToken *searchCancellationToken = [[[HLSCancellationToken alloc] init] autorelease];
+    self.searchCancellationToken = searchCancellationToken;
+    
+    // Explicitly retained until the results have been applied, and released on the main thread
+    searchText = [[searchText copy] autorelease];
+    __block HLSTableSearchDisplayViewController *blockSelf = [self retain];
+    dispatch_async(HLSTableSearchQueue(), ^{
+        NSMutableArray *searchResults = [NSMutableArray array];
+        if (searchIndex) {
+            NSArray *candidates = [objects objectsAtIndexes:[searchIndex objectIndexesMatchingSearchText:searchText]];
+            NSUInteger i = 0;
+            for (id candidate in candidates) {
+                if (i % kSearchCancellationCheckInterval == 0 && [searchCancellationToken isCancelled]) {
+                    break;
+                }
+                
+                if ([blockSelf object:candidate matchesScopeButtonIndex:scopeButtonIndex]) {
+                    [searchResults addObject:candidate];
+                }
+                ++i;
+            }
+        }
+        else {
+            NSUInteger i = 0;
+            for (id object in objects) {
+                if (i % kSearchCancellationCheckInterval == 0 && [searchCancellationToken isCancelled]) {
+                    break;
+                }
+                
+                if ([blockSelf object:object matchesSearchText:searchText scopeButtonIndex:scopeButtonIndex]) {
+                    [searchResults addObject:object];
+                }
+                ++i;
+            }
+        }
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Only the most recent search is applied
+            if (! [searchCancellationToken isCancelled]) {
+                [blockSelf applySearchResults:searchResults searchText:searchText scopeButtonIndex:scopeButtonIndex];
+            }
+            [blockSelf release];
+        });
+    });
+}
+
+// Replace the results and reload the search results table view at once
+- (void)applySearchResults:(NSArray *)searchResults searchText:(NSString *)searchText scopeButtonIndex:(NSInteger)scopeButtonIndex
+{
+    self.searchResults = [NSArray arrayWithArray:searchResults];
+    self.searchResultsSearchText = searchText;
+    m_searchResultsScopeButtonIndex = scopeButtonIndex;
+    self.searchCancellationToken = nil;
+    
+    [self.searchResultsTableView reloadData];
+}
+
 #pragma mark UITableViewDataSource protocol implementation
 
 - (NSInteger)tableView:(UITableView *)table numberOfRowsInSection:(NSInteger)section
@@ -206,3 +425,16 @@ static const CGFloat kSearchBarStandardHeight = 44.f;
 }
 
 @end
+
+#pragma mark Static functions
+
+static dispatch_queue_t HLSTableSearchQueue(void)
+{
+    // Serial, superseded searches are cancelled and end quickly
+    static dispatch_queue_t s_queue = NULL;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_queue = dispatch_queue_create("ch.hortis.CoconutKit.tableSearch", NULL);
+    });
+    return s_queue;
+}
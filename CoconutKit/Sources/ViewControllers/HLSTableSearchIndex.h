@@ -0,0 +1,36 @@
+//
+//  HLSTableSearchIndex.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Private class for search indexes used by HLSTableSearchDisplayViewController. Object tokens are case- and
+ * diacritic-folded and sorted, so that prefix lookups can be made using binary search
+ *
+ * Indexes are not thread-safe. HLSTableSearchDisplayViewController builds and uses them on its search queue only
+ */
+@interface HLSTableSearchIndex : NSObject {
+@private
+    NSArray *m_entries;
+}
+
+/**
+ * Split a string into words, i.e. into runs of alphanumeric characters
+ */
++ (NSArray *)wordsInString:(NSString *)string;
+
+/**
+ * Index objects under the tokens returned by the block. Any previously indexed objects are discarded
+ */
+- (void)buildWithObjects:(NSArray *)objects tokensBlock:(NSArray *(^)(id object))tokensBlock;
+
+/**
+ * Return the indexes (in the array the index was built with) of the objects matching a search text, i.e. for which 
+ * each word of the search text is the prefix of one of their tokens
+ */
+- (NSIndexSet *)objectIndexesMatchingSearchText:(NSString *)searchText;
+
+@end
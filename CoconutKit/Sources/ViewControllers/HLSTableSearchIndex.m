@@ -0,0 +1,173 @@
+//
+//  HLSTableSearchIndex.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSTableSearchIndex.h"
+
+// Static functions
+static NSString *HLSTableSearchFoldedString(NSString *string);
+
+/**
+ * Private class for search index entries
+ */
+@interface HLSTableSearchIndexEntry : NSObject {
+@private
+    NSString *m_token;
+    NSUInteger m_objectIndex;
+}
+
+- (id)initWithToken:(NSString *)token objectIndex:(NSUInteger)objectIndex;
+
+@property (nonatomic, readonly, retain) NSString *token;
+@property (nonatomic, readonly, assign) NSUInteger objectIndex;
+
+@end
+
+#pragma mark -
+#pragma mark HLSTableSearchIndexEntry class implementation
+
+@implementation HLSTableSearchIndexEntry
+
+#pragma mark Object creation and destruction
+
+- (id)initWithToken:(NSString *)token objectIndex:(NSUInteger)objectIndex
+{
+    if ((self = [super init])) {
+        m_token = [token retain];
+        m_objectIndex = objectIndex;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [m_token release];
+    m_token = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize token = m_token;
+
+@synthesize objectIndex = m_objectIndex;
+
+@end
+
+#pragma mark -
+#pragma mark HLSTableSearchIndex class implementation
+
+@implementation HLSTableSearchIndex
+
+#pragma mark Class methods
+
++ (NSArray *)wordsInString:(NSString *)string
+{
+    NSMutableArray *words = [NSMutableArray array];
+    NSCharacterSet *separatorCharacterSet = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    for (NSString *word in [string componentsSeparatedByCharactersInSet:separatorCharacterSet]) {
+        if ([word length] != 0) {
+            [words addObject:word];
+        }
+    }
+    return [NSArray arrayWithArray:words];
+}
+
+#pragma mark Object creation and destruction
+
+- (void)dealloc
+{
+    [m_entries release];
+    m_entries = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Building and querying the index
+
+- (void)buildWithObjects:(NSArray *)objects tokensBlock:(NSArray *(^)(id object))tokensBlock
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    NSUInteger objectIndex = 0;
+    for (id object in objects) {
+        // The same token is indexed once per object
+        NSMutableSet *foldedTokens = [NSMutableSet set];
+        for (NSString *token in tokensBlock(object)) {
+            [foldedTokens addObject:HLSTableSearchFoldedString(token)];
+        }
+        
+        for (NSString *foldedToken in foldedTokens) {
+            HLSTableSearchIndexEntry *entry = [[[HLSTableSearchIndexEntry alloc] initWithToken:foldedToken objectIndex:objectIndex] autorelease];
+            [entries addObject:entry];
+        }
+        ++objectIndex;
+    }
+    
+    [entries sortUsingComparator:^(id entry1, id entry2) {
+        return [[entry1 token] compare:[entry2 token] options:NSLiteralSearch];
+    }];
+    
+    [m_entries release];
+    m_entries = [entries copy];
+}
+
+// An object matches if each word of the search text is the prefix of one of its tokens
+- (NSIndexSet *)objectIndexesMatchingSearchText:(NSString *)searchText
+{
+    NSMutableIndexSet *objectIndexes = nil;
+    for (NSString *word in [HLSTableSearchIndex wordsInString:HLSTableSearchFoldedString(searchText)]) {
+        // Find the first token having the word as prefix (binary search), then collect all such tokens
+        HLSTableSearchIndexEntry *wordEntry = [[[HLSTableSearchIndexEntry alloc] initWithToken:word objectIndex:NSNotFound] autorelease];
+        NSUInteger entryIndex = [m_entries indexOfObject:wordEntry
+                                           inSortedRange:NSMakeRange(0, [m_entries count])
+                                                 options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex
+                                         usingComparator:^(id entry1, id entry2) {
+                                             return [[entry1 token] compare:[entry2 token] options:NSLiteralSearch];
+                                         }];
+        
+        NSMutableIndexSet *wordObjectIndexes = [NSMutableIndexSet indexSet];
+        for (; entryIndex < [m_entries count]; ++entryIndex) {
+            HLSTableSearchIndexEntry *entry = [m_entries objectAtIndex:entryIndex];
+            if (! [entry.token hasPrefix:word]) {
+                break;
+            }
+            [wordObjectIndexes addIndex:entry.objectIndex];
+        }
+        
+        if (! objectIndexes) {
+            objectIndexes = wordObjectIndexes;
+        }
+        else {
+            NSMutableIndexSet *commonObjectIndexes = [NSMutableIndexSet indexSet];
+            NSUInteger objectIndex = [objectIndexes firstIndex];
+            while (objectIndex != NSNotFound) {
+                if ([wordObjectIndexes containsIndex:objectIndex]) {
+                    [commonObjectIndexes addIndex:objectIndex];
+                }
+                objectIndex = [objectIndexes indexGreaterThanIndex:objectIndex];
+            }
+            objectIndexes = commonObjectIndexes;
+        }
+        
+        if ([objectIndexes count] == 0) {
+            break;
+        }
+    }
+    
+    return objectIndexes ? [[objectIndexes copy] autorelease] : [NSIndexSet indexSet];
+}
+
+@end
+
+#pragma mark Static functions
+
+// Case- and diacritic-folded version of a string, so that strings can be compared literally
+static NSString *HLSTableSearchFoldedString(NSString *string)
+{
+    return [string stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch locale:nil];
+}
@@ -13,6 +13,31 @@
 // of an animation as defined by its implementation
 extern const NSTimeInterval kAnimationTransitionDefaultDuration;
 
+/**
+ * Register a custom transition class so that it is listed by +[HLSTransition availableTransitionNames] and can
+ * be retrieved using +[HLSTransition transitionClassForName:]. Use this macro once, at global scope, in the
+ * implementation file of your transition class, e.g.
+ *   HLSRegisterTransition(MyCustomTransition)
+ * Built-in CoconutKit transitions are always registered
+ */
+#if !__has_feature(objc_arc)
+#define HLSRegisterTransition(className)                                                                  \
+    __attribute__ ((constructor)) static void HLSRegisterTransition##className##Constructor(void)         \
+    {                                                                                                     \
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];                                       \
+        [HLSTransition registerTransitionClass:[className class]];                                        \
+        [pool drain];                                                                                     \
+    }
+#else
+#define HLSRegisterTransition(className)                                                                  \
+    __attribute__ ((constructor)) static void HLSRegisterTransition##className##Constructor(void)         \
+    {                                                                                                     \
+        @autoreleasepool {                                                                                \
+            [HLSTransition registerTransitionClass:[className class]];                                    \
+        }                                                                                                 \
+    }
+#endif
+
 /**
  * Base class for transition animations involving two views (currently for use by containers). To define your
  * own transition animation, subclass HLSTransition and implement the
@@ -53,6 +78,9 @@ extern const NSTimeInterval kAnimationTransitionDefaultDuration;
  *     class. The duration of each animation step might be scaled depending on the total duration which is desired
  *     when the animation is actually played (refer to -[HLSAnimation animationWithDuration:] documentation for more
  *     information)
+ *   - the animation steps you return must only depend on the parameters you receive. Transition animations are built
+ *     once for each combination of transition class, bounds and duration (the views you receive might be placeholders),
+ *     cached, and then bound to the views which are actually animated
  *
  * For example, here is the implementation of a push from right animation (the usual UINavigationController animation)
  * with an intrinsic duration of 0.4:
@@ -96,15 +124,31 @@ extern const NSTimeInterval kAnimationTransitionDefaultDuration;
  *
  * Have a look at the CoconutKit source code for more examples (HLSTransition.m). Several built-in transition classes are
  * provided by CoconutKit and should fulfill most of your needs.
+ *
+ * Custom transition classes should be registered using the HLSRegisterTransition macro so that they are listed
+ * along with built-in ones. Registration is only meant to be performed from the main thread (which is the case
+ * when using the macro, which executes before main() is called)
  */
 @interface HLSTransition : NSObject
 
 /**
- * Return all class names corresponding to available transition animations (except HLSTransition itself). These include
- * custom transitions as well
+ * Return all class names corresponding to available transition animations (except HLSTransition itself), sorted
+ * alphabetically. These include registered custom transitions as well (see HLSRegisterTransition)
  */
 + (NSArray *)availableTransitionNames;
 
+/**
+ * Return the transition class registered for a given name, nil if none
+ */
++ (Class)transitionClassForName:(NSString *)transitionName;
+
+/**
+ * Register a transition class. You should not call this method directly, use the HLSRegisterTransition macro
+ * instead. Registering a class which is not an HLSTransition subclass, or a class which has already been registered,
+ * does nothing
+ */
++ (void)registerTransitionClass:(Class)transitionClass;
+
 /**
  * The method to be overridden by subclasses to return the transition animation steps which the animation is made of.
  * The returned array must only contain HLSAnimationStep objects
@@ -133,6 +177,17 @@ extern const NSTimeInterval kAnimationTransitionDefaultDuration;
                                                   inView:(UIView *)view
                                               withBounds:(CGRect)bounds;
 
+/**
+ * Return YES if the layers animated by the transition should be rasterized while the transition is played (see 
+ * -[HLSAnimation rasterizingLayers]). Only views whose layer hierarchy is complex enough are actually rasterized,
+ * simple views are still animated live. Transitions applying 3D transforms to views should return YES, since the
+ * whole layer hierarchy of a view would otherwise have to be transformed and composited again for each frame
+ *
+ * The default implementation returns YES if the transition applies a perspective to the view containing the animated
+ * views (as flip and rotation transitions do), NO otherwise
+ */
++ (BOOL)prefersRasterizedLayers;
+
 /**
  * Return the intrinsic duration of a transition as given by its implementation
  */
@@ -12,9 +12,11 @@
 #import "HLSAssert.h"
 #import "HLSFloat.h"
 #import "HLSLayerAnimationStep.h"
+#import "HLSLayerAnimationStep+Friend.h"
+#import "HLSLogger.h"
+#import "HLSStartupReport.h"
 #import "NSObject+HLSExtensions.h"
 #import "NSSet+HLSExtensions.h"
-#import <objc/runtime.h>
 
 // Constants
 const NSTimeInterval kAnimationTransitionDefaultDuration = -1.;
@@ -22,8 +24,36 @@ const NSTimeInterval kAnimationTransitionDefaultDuration = -1.;
 static CGFloat kPushToTheBackScaleFactor = 0.95f;
 static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
 
+// Sorted cache of the registered transition names
+static NSArray *s_availableTransitionNames = nil;
+
+// Cache of transition animations built for placeholder views
+static NSMutableDictionary *s_animationCache = nil;
+
 @interface HLSTransition ()
 
++ (NSMutableDictionary *)transitionNameToClassMap;
+
++ (HLSAnimation *)cachedAnimationWithAppearingView:(UIView *)appearingView
+                                  disappearingView:(UIView *)disappearingView
+                                            inView:(UIView *)view
+                                        withBounds:(CGRect)bounds
+                                          duration:(NSTimeInterval)duration
+                                           reverse:(BOOL)reverse;
++ (HLSAnimation *)animationWithAppearingView:(UIView *)appearingView
+                            disappearingView:(UIView *)disappearingView
+                                      inView:(UIView *)view
+                                  withBounds:(CGRect)bounds
+                                    duration:(NSTimeInterval)duration;
++ (HLSAnimation *)reverseAnimationWithAppearingView:(UIView *)appearingView
+                                   disappearingView:(UIView *)disappearingView
+                                             inView:(UIView *)view
+                                         withBounds:(CGRect)bounds
+                                         viewBounds:(CGRect)viewBounds
+                                           duration:(NSTimeInterval)duration;
+
++ (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
 + (NSArray *)coverLayerAnimationStepsWithInitialXOffset:(CGFloat)xOffset
                                                 yOffset:(CGFloat)yOffset
                                           appearingView:(UIView *)appearingView;
@@ -79,44 +109,114 @@ static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
 
 #pragma mark Getting transition animation information
 
-+ (NSArray *)availableTransitionNames
++ (NSMutableDictionary *)transitionNameToClassMap
 {
-    static NSArray *s_availableTransitionNames = nil;
-    if (! s_availableTransitionNames) {
-        NSMutableArray *availableTransitionNames = [NSMutableArray array];
+    static NSMutableDictionary *s_transitionNameToClassMap = nil;
+    if (! s_transitionNameToClassMap) {
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
         
-        // Find all HLSTransition subclasses (except HLSTransition itself)
-        unsigned int numberOfClasses = 0;
-        Class *classes = objc_copyClassList(&numberOfClasses);
-        for (int i = 0; i < numberOfClasses; ++i) {
-            Class class = classes[i];
-            
-            // Discard HLSTransition
-            if (class == [HLSTransition class]) {
-                continue;
-            }
-            
-            // Find whether HLSTransition is a superclass. We cannot use -isSubclassOfClass: since it is an NSObject
-            // method and we might encounter other kinds of classes (e.g. proxies)
-            // TODO: Factor out in HLSRuntime.h after merge with url-networking branch
-            Class superclass = class;
-            do {
-                superclass = class_getSuperclass(superclass);
-            } while (superclass && superclass != [HLSTransition class]);
-            
-            if (! superclass) {
-                continue;
-            }
-            
-            [availableTransitionNames addObject:NSStringFromClass(class)];
+        s_transitionNameToClassMap = [[NSMutableDictionary alloc] init];
+        
+        // Built-in transitions. Custom ones register themselves using HLSRegisterTransition
+        NSArray *builtInTransitionClasses = [NSArray arrayWithObjects:
+                                             [HLSTransitionNone class],
+                                             [HLSTransitionCoverFromBottom class],
+                                             [HLSTransitionCoverFromTop class],
+                                             [HLSTransitionCoverFromLeft class],
+                                             [HLSTransitionCoverFromRight class],
+                                             [HLSTransitionCoverFromTopLeft class],
+                                             [HLSTransitionCoverFromTopRight class],
+                                             [HLSTransitionCoverFromBottomLeft class],
+                                             [HLSTransitionCoverFromBottomRight class],
+                                             [HLSTransitionCoverFromBottomPushToBack class],
+                                             [HLSTransitionCoverFromTopPushToBack class],
+                                             [HLSTransitionCoverFromLeftPushToBack class],
+                                             [HLSTransitionCoverFromRightPushToBack class],
+                                             [HLSTransitionCoverFromTopLeftPushToBack class],
+                                             [HLSTransitionCoverFromTopRightPushToBack class],
+                                             [HLSTransitionCoverFromBottomLeftPushToBack class],
+                                             [HLSTransitionCoverFromBottomRightPushToBack class],
+                                             [HLSTransitionFadeIn class],
+                                             [HLSTransitionFadeInPushToBack class],
+                                             [HLSTransitionCrossDissolve class],
+                                             [HLSTransitionPushFromBottom class],
+                                             [HLSTransitionPushFromTop class],
+                                             [HLSTransitionPushFromLeft class],
+                                             [HLSTransitionPushFromRight class],
+                                             [HLSTransitionPushFromBottomFadeIn class],
+                                             [HLSTransitionPushFromTopFadeIn class],
+                                             [HLSTransitionPushFromLeftFadeIn class],
+                                             [HLSTransitionPushFromRightFadeIn class],
+                                             [HLSTransitionPushToBackFromBottom class],
+                                             [HLSTransitionPushToBackFromTop class],
+                                             [HLSTransitionPushToBackFromLeft class],
+                                             [HLSTransitionPushToBackFromRight class],
+                                             [HLSTransitionFlowFromBottom class],
+                                             [HLSTransitionFlowFromTop class],
+                                             [HLSTransitionFlowFromLeft class],
+                                             [HLSTransitionFlowFromRight class],
+                                             [HLSTransitionEmergeFromCenter class],
+                                             [HLSTransitionEmergeFromCenterPushToBack class],
+                                             [HLSTransitionFlipVertically class],
+                                             [HLSTransitionFlipHorizontally class],
+                                             [HLSTransitionRotateHorizontallyFromBottomCounterclockwise class],
+                                             [HLSTransitionRotateHorizontallyFromBottomClockwise class],
+                                             [HLSTransitionRotateHorizontallyFromTopCounterclockwise class],
+                                             [HLSTransitionRotateHorizontallyFromTopClockwise class],
+                                             [HLSTransitionRotateVerticallyFromLeftCounterclockwise class],
+                                             [HLSTransitionRotateVerticallyFromLeftClockwise class],
+                                             [HLSTransitionRotateVerticallyFromRightCounterclockwise class],
+                                             [HLSTransitionRotateVerticallyFromRightClockwise class],
+                                             nil];
+        for (Class transitionClass in builtInTransitionClasses) {
+            [s_transitionNameToClassMap setObject:transitionClass forKey:NSStringFromClass(transitionClass)];
         }
-        free(classes);
         
-        s_availableTransitionNames = [[availableTransitionNames sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)] retain];
+        HLSStartupReportRecord("HLSTransition", startTime);
+    }
+    return s_transitionNameToClassMap;
+}
+
++ (NSArray *)availableTransitionNames
+{
+    if (! s_availableTransitionNames) {
+        s_availableTransitionNames = [[[[self transitionNameToClassMap] allKeys] sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)] retain];
     }
     return s_availableTransitionNames;
 }
 
++ (Class)transitionClassForName:(NSString *)transitionName
+{
+    if (! transitionName) {
+        return nil;
+    }
+    
+    return [[self transitionNameToClassMap] objectForKey:transitionName];
+}
+
+#pragma mark Registering transitions
+
++ (void)registerTransitionClass:(Class)transitionClass
+{
+    if (! transitionClass || transitionClass == [HLSTransition class] || ! [transitionClass isSubclassOfClass:[HLSTransition class]]) {
+        HLSLoggerError(@"The class %@ is not an HLSTransition subclass", transitionClass);
+        return;
+    }
+    
+    NSString *transitionName = NSStringFromClass(transitionClass);
+    NSMutableDictionary *transitionNameToClassMap = [self transitionNameToClassMap];
+    if ([transitionNameToClassMap objectForKey:transitionName]) {
+        HLSLoggerDebug(@"The transition %@ has already been registered", transitionName);
+        return;
+    }
+    
+    [transitionNameToClassMap setObject:transitionClass forKey:transitionName];
+    
+    // Invalidate the sorted name cache
+    [s_availableTransitionNames release];
+    s_availableTransitionNames = nil;
+}
+
 #pragma mark Generating the animation
 
 + (HLSAnimation *)animationWithAppearingView:(UIView *)appearingView
@@ -127,15 +227,126 @@ static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
     NSAssert(view && (! appearingView || appearingView.superview == view) && (! disappearingView || disappearingView.superview == view),
              @"Both the appearing and disappearing views must be children of the view in which the transition takes place");
     
+    return [self cachedAnimationWithAppearingView:appearingView
+                                 disappearingView:disappearingView
+                                           inView:view
+                                       withBounds:view.bounds
+                                         duration:duration
+                                          reverse:NO];
+}
+
++ (HLSAnimation *)reverseAnimationWithAppearingView:(UIView *)appearingView
+                                   disappearingView:(UIView *)disappearingView
+                                             inView:(UIView *)view
+                                           duration:(NSTimeInterval)duration
+{
+    NSAssert(view && (! appearingView || appearingView.superview == view) && disappearingView.superview == view,
+             @"Both the appearing and disappearing views must be children of the view in which the transition takes place");
+    
+    // Calculate the original bounds to take into account any transform which might be applied
+    CGRect originalFrame = CGRectApplyAffineTransform(view.frame, CGAffineTransformInvert(view.transform));
+    return [self cachedAnimationWithAppearingView:appearingView
+                                 disappearingView:disappearingView
+                                           inView:view
+                                       withBounds:CGRectMake(0.f, 0.f, CGRectGetWidth(originalFrame), CGRectGetHeight(originalFrame))
+                                         duration:duration
+                                          reverse:YES];
+}
+
+#pragma mark Caching animations
+
+/**
+ * Transition animations only depend on the transition class, the bounds, the duration and on which views are
+ * provided. They are therefore built once for placeholder views, cached, and bound to the actual views when needed
+ */
++ (HLSAnimation *)cachedAnimationWithAppearingView:(UIView *)appearingView
+                                  disappearingView:(UIView *)disappearingView
+                                            inView:(UIView *)view
+                                        withBounds:(CGRect)bounds
+                                          duration:(NSTimeInterval)duration
+                                           reverse:(BOOL)reverse
+{
+    static UIView *s_placeholderAppearingView = nil;
+    static UIView *s_placeholderDisappearingView = nil;
+    static UIView *s_placeholderView = nil;
+    if (! s_placeholderView) {
+        s_placeholderAppearingView = [[UIView alloc] init];
+        s_placeholderDisappearingView = [[UIView alloc] init];
+        s_placeholderView = [[UIView alloc] init];
+        
+        // The animation cache is cheap to rebuild
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    
+    // The reverse animation might be generated from the animation, which uses the view bounds
+    NSString *key = [NSString stringWithFormat:@"%@_%@_%d_%d_%@_%@_%.6f",
+                     NSStringFromClass(self),
+                     reverse ? @"reverse" : @"forward",
+                     appearingView != nil,
+                     disappearingView != nil,
+                     NSStringFromCGRect(bounds),
+                     reverse ? NSStringFromCGRect(view.bounds) : @"",
+                     duration];
+    
+    NSMutableArray *placeholderViews = [NSMutableArray arrayWithObject:s_placeholderView];
+    NSMutableArray *views = [NSMutableArray arrayWithObject:view];
+    if (appearingView) {
+        [placeholderViews addObject:s_placeholderAppearingView];
+        [views addObject:appearingView];
+    }
+    if (disappearingView) {
+        [placeholderViews addObject:s_placeholderDisappearingView];
+        [views addObject:disappearingView];
+    }
+    
+    if (! s_animationCache) {
+        s_animationCache = [[NSMutableDictionary alloc] init];
+    }
+    
+    HLSAnimation *templateAnimation = [s_animationCache objectForKey:key];
+    if (! templateAnimation) {
+        UIView *placeholderAppearingView = appearingView ? s_placeholderAppearingView : nil;
+        UIView *placeholderDisappearingView = disappearingView ? s_placeholderDisappearingView : nil;
+        if (! reverse) {
+            templateAnimation = [self animationWithAppearingView:placeholderAppearingView
+                                                disappearingView:placeholderDisappearingView
+                                                          inView:s_placeholderView
+                                                      withBounds:bounds
+                                                        duration:duration];
+        }
+        else {
+            templateAnimation = [self reverseAnimationWithAppearingView:placeholderAppearingView
+                                                       disappearingView:placeholderDisappearingView
+                                                                 inView:s_placeholderView
+                                                             withBounds:bounds
+                                                             viewBounds:view.bounds
+                                                               duration:duration];
+        }
+        [s_animationCache setObject:templateAnimation forKey:key];
+    }
+    
+    return [templateAnimation animationReplacingTargets:placeholderViews withTargets:views];
+}
+
++ (HLSAnimation *)animationWithAppearingView:(UIView *)appearingView
+                            disappearingView:(UIView *)disappearingView
+                                      inView:(UIView *)view
+                                  withBounds:(CGRect)bounds
+                                    duration:(NSTimeInterval)duration
+{
     // Build the animation with default parameters. Beware of the inView parameter here: If no appearing view has been set,
     // we are replaying an animation only for disappearing view
     NSArray *animationSteps = [self layerAnimationStepsWithAppearingView:appearingView
                                                         disappearingView:disappearingView
                                                                   inView:appearingView ? view : nil
-                                                              withBounds:view.bounds];
+                                                              withBounds:bounds];
     HLSAssertObjectsInEnumerationAreKindOfClass(animationSteps, [HLSLayerAnimationStep class]);
         
     HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:animationSteps];
+    animation.rasterizingLayers = [self prefersRasterizedLayers];
     
     // Generate an animation with the proper duration
     if (doubleeq(duration, kAnimationTransitionDefaultDuration)) {
@@ -149,27 +360,21 @@ static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
 + (HLSAnimation *)reverseAnimationWithAppearingView:(UIView *)appearingView
                                    disappearingView:(UIView *)disappearingView
                                              inView:(UIView *)view
+                                         withBounds:(CGRect)bounds
+                                         viewBounds:(CGRect)viewBounds
                                            duration:(NSTimeInterval)duration
 {
-    NSAssert(view && (! appearingView || appearingView.superview == view) && disappearingView.superview == view,
-             @"Both the appearing and disappearing views must be children of the view in which the transition takes place");
-    
-    // Build the animation with default parameters. Calculate the original bounds to take into account any transform
-    // which might be applied
-    CGRect originalFrame = CGRectApplyAffineTransform(view.frame, CGAffineTransformInvert(view.transform));
     NSArray *animationSteps = [self reverseLayerAnimationStepsWithAppearingView:appearingView
                                                                disappearingView:disappearingView
                                                                          inView:view
-                                                                     withBounds:CGRectMake(0.f,
-                                                                                           0.f,
-                                                                                           CGRectGetWidth(originalFrame),
-                                                                                           CGRectGetHeight(originalFrame))];
+                                                                     withBounds:bounds];
     
     // If custom reverse animation implemented by the animation class, use it
     if (animationSteps) {
         HLSAssertObjectsInEnumerationAreKindOfClass(animationSteps, [HLSLayerAnimationStep class]);
                 
         HLSAnimation *animation = [HLSAnimation animationWithAnimationSteps:animationSteps];
+        animation.rasterizingLayers = [self prefersRasterizedLayers];
         
         // Generate an animation with the proper duration
         if (doubleeq(duration, kAnimationTransitionDefaultDuration)) {
@@ -184,10 +389,48 @@ static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
         return [[self animationWithAppearingView:disappearingView
                                 disappearingView:appearingView
                                           inView:view
+                                      withBounds:viewBounds
                                         duration:duration] reverseAnimation];
     }
 }
 
+#pragma mark Notification callbacks
+
++ (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [s_animationCache removeAllObjects];
+}
+
++ (BOOL)prefersRasterizedLayers
+{
+    // Whether a transition applies a perspective is a constant for each transition animation class. Can cache it
+    static NSMutableDictionary *s_animationClassNameToPrefersRasterizedLayersMap = nil;
+    if (! s_animationClassNameToPrefersRasterizedLayersMap) {
+        s_animationClassNameToPrefersRasterizedLayersMap = [[NSMutableDictionary dictionary] retain];
+    }
+    
+    NSNumber *prefersRasterizedLayers = [s_animationClassNameToPrefersRasterizedLayersMap objectForKey:[self className]];
+    if (! prefersRasterizedLayers) {
+        // Calculate for dummy views. The perspective is applied to the view containing the animated views
+        UIView *view = [[[UIView alloc] init] autorelease];
+        NSArray *animationSteps = [[self class] layerAnimationStepsWithAppearingView:[[[UIView alloc] init] autorelease]
+                                                                    disappearingView:[[[UIView alloc] init] autorelease]
+                                                                              inView:view
+                                                                          withBounds:CGRectZero];
+        BOOL perspective = NO;
+        for (HLSLayerAnimationStep *animationStep in animationSteps) {
+            if ([animationStep isChangingSublayerTransformOfLayer:view.layer]) {
+                perspective = YES;
+                break;
+            }
+        }
+        prefersRasterizedLayers = [NSNumber numberWithBool:perspective];
+        [s_animationClassNameToPrefersRasterizedLayersMap setObject:prefersRasterizedLayers forKey:[self className]];
+    }
+    
+    return [prefersRasterizedLayers boolValue];
+}
+
 + (NSTimeInterval)defaultDuration
 {
     // Durations are constants for each transition animation class. Can cache them
@@ -440,7 +683,8 @@ static CGFloat kEmergeFromCenterScaleFactor = 0.8f;
 {
     NSMutableArray *animationSteps = [NSMutableArray array];
     
-    // Setup animation step
+    // Setup animation step. Opacities are only changed by steps with zero duration, so that views are never blended with
+    // a fractional opacity while rotating (which would require an offscreen pass for views with sublayers)
     HLSLayerAnimationStep *animationStep1 = [HLSLayerAnimationStep animationStep];
     HLSLayerAnimation *layerAnimation11 = [HLSLayerAnimation animation];
     [layerAnimation11 rotateByAngle:-M_PI aboutVectorWithX:x y:y z:z];
@@ -23,6 +23,8 @@
  *     locate MyView.nib, then MyViewController.nib), HLSViewController subclasses look for a nib bearing the same name
  *     as the class only (otherwise the view controller is assumed to be instantiated programmatically). This promotes 
  *     a consistent naming scheme between source and nib files
+ *   - nibs are loaded through a process-wide cache (see UINib+HLSExtensions.h), so that the nib of a view controller
+ *     class is parsed only once, even if many instances are created or if views are often unloaded and reloaded
  *   - view controllers inheriting from HLSViewController MUST implement autorotation behavior using the new iOS 6 
  *     -shouldAutorotate and -supportedInterfaceOrientations methods, not the old -shouldAutorotateToInterfaceOrientation:
  *     method anymore. This way, no code has to be duplicated to implement autorotation behavior for iOS 4 / 5 and 6
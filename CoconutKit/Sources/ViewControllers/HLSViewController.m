@@ -14,6 +14,7 @@
 #import "HLSLogger.h"
 #import "NSBundle+HLSDynamicLocalization.h"
 #import "NSObject+HLSExtensions.h"
+#import "UINib+HLSExtensions.h"
 
 /**
  * Initially, I intended to make the iOS 6 autorotation methods for UIViewController globally, not just for the
@@ -122,6 +123,23 @@
 
 #pragma mark View lifecycle
 
+- (void)loadView
+{
+    // Nibs embedded in storyboards are not located like usual nibs. Let UIKit load them
+    BOOL isFromStoryboard = [self respondsToSelector:@selector(storyboard)] && self.storyboard;
+    UINib *nib = (self.nibName && ! isFromStoryboard) ? [UINib cachedNibWithName:self.nibName bundle:self.nibBundle] : nil;
+    if (! nib) {
+        [super loadView];
+        return;
+    }
+    
+    // Same as the UIKit implementation, but without parsing the nib file again
+    [nib instantiateWithOwner:self options:nil];
+    if (! [self isViewLoaded]) {
+        HLSLoggerError(@"The view outlet of the file's owner has not been bound in nib %@", self.nibName);
+    }
+}
+
 - (void)viewDidLoad
 {
     [super viewDidLoad];
@@ -0,0 +1,85 @@
+//
+//  HLSViewControllerLifeCycleProfiler.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * Keys of the report dictionaries returned by HLSViewControllerLifeCycleProfiler (values are NSNumber objects, durations
+ * are in seconds)
+ */
+extern NSString * const HLSViewControllerLifeCycleProfilerAppearanceCountKey;               // number of first appearances measured
+extern NSString * const HLSViewControllerLifeCycleProfilerAverageLoadDurationKey;           // average init -> viewDidLoad duration
+extern NSString * const HLSViewControllerLifeCycleProfilerLongestLoadDurationKey;           // longest init -> viewDidLoad duration
+extern NSString * const HLSViewControllerLifeCycleProfilerAverageAppearanceDurationKey;     // average viewDidLoad -> viewDidAppear: duration
+extern NSString * const HLSViewControllerLifeCycleProfilerLongestAppearanceDurationKey;     // longest viewDidLoad -> viewDidAppear: duration
+extern NSString * const HLSViewControllerLifeCycleProfilerAverageTotalDurationKey;          // average init -> viewDidAppear: duration
+extern NSString * const HLSViewControllerLifeCycleProfilerLongestTotalDurationKey;          // longest init -> viewDidAppear: duration
+extern NSString * const HLSViewControllerLifeCycleProfilerReloadCountKey;                   // number of appearances after a view unload
+extern NSString * const HLSViewControllerLifeCycleProfilerAverageReloadDurationKey;         // average viewDidLoad -> viewDidAppear: duration after an unload
+
+/**
+ * The view controller lifecycle profiler measures how long view controllers take to be displayed. When enabled, the
+ * time at which each view controller is initialized, loads its view and appears for the first time is recorded
+ * (this is performed by the UIViewController+HLSExtensions lifecycle hooks, no code is required in your view controllers).
+ * Durations are then logged (with info level) and accumulated per view controller class, so that screens which are
+ * slow to show up can easily be spotted, even in production builds.
+ *
+ * Only the first appearance after the view has been loaded is measured. When a view is unloaded (e.g. after a memory
+ * warning) and later reloaded, the time needed to reload and display it again is reported separately, since it does
+ * not include the view controller initialization.
+ *
+ * Measurements are cheap (a timestamp and an associated object per view controller) and nothing at all is done when
+ * the profiler is disabled.
+ *
+ * This class is not thread-safe and must only be used from the main thread.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSViewControllerLifeCycleProfiler : NSObject {
+@private
+    BOOL m_enabled;
+    NSMutableDictionary *m_classNameToStatisticsMap;
+}
+
+/**
+ * The profiler used by all view controllers
+ */
++ (HLSViewControllerLifeCycleProfiler *)sharedViewControllerLifeCycleProfiler;
+
+/**
+ * Set to YES to enable profiling. View controllers already initialized when the profiler is enabled are not profiled
+ *
+ * Default value is NO
+ */
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+
+/**
+ * Record lifecycle events. These methods are called by the UIViewController+HLSExtensions hooks, you should not need
+ * to call them yourself
+ */
+- (void)viewControllerDidInitialize:(UIViewController *)viewController;
+- (void)viewControllerDidLoadView:(UIViewController *)viewController;
+- (void)viewControllerDidAppear:(UIViewController *)viewController;
+- (void)viewControllerDidUnloadView:(UIViewController *)viewController;
+
+/**
+ * Return the report for view controllers of a given class (nil if none). Statistics are collected for the exact
+ * class of a view controller, not for its superclasses. Reports are dictionaries whose keys are listed at the top
+ * of this file
+ */
+- (NSDictionary *)reportForViewControllerClass:(Class)viewControllerClass;
+
+/**
+ * Return the reports for all view controllers profiled so far, with class names as keys
+ */
+- (NSDictionary *)reports;
+
+/**
+ * Discard all statistics collected so far
+ */
+- (void)reset;
+
+@end
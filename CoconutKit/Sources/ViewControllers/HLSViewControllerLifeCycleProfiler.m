@@ -0,0 +1,280 @@
+//
+//  HLSViewControllerLifeCycleProfiler.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/14/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSViewControllerLifeCycleProfiler.h"
+
+#import <objc/runtime.h>
+#import <QuartzCore/QuartzCore.h>
+#import "HLSLogger.h"
+
+NSString * const HLSViewControllerLifeCycleProfilerAppearanceCountKey = @"HLSViewControllerLifeCycleProfilerAppearanceCount";
+NSString * const HLSViewControllerLifeCycleProfilerAverageLoadDurationKey = @"HLSViewControllerLifeCycleProfilerAverageLoadDuration";
+NSString * const HLSViewControllerLifeCycleProfilerLongestLoadDurationKey = @"HLSViewControllerLifeCycleProfilerLongestLoadDuration";
+NSString * const HLSViewControllerLifeCycleProfilerAverageAppearanceDurationKey = @"HLSViewControllerLifeCycleProfilerAverageAppearanceDuration";
+NSString * const HLSViewControllerLifeCycleProfilerLongestAppearanceDurationKey = @"HLSViewControllerLifeCycleProfilerLongestAppearanceDuration";
+NSString * const HLSViewControllerLifeCycleProfilerAverageTotalDurationKey = @"HLSViewControllerLifeCycleProfilerAverageTotalDuration";
+NSString * const HLSViewControllerLifeCycleProfilerLongestTotalDurationKey = @"HLSViewControllerLifeCycleProfilerLongestTotalDuration";
+NSString * const HLSViewControllerLifeCycleProfilerReloadCountKey = @"HLSViewControllerLifeCycleProfilerReloadCount";
+NSString * const HLSViewControllerLifeCycleProfilerAverageReloadDurationKey = @"HLSViewControllerLifeCycleProfilerAverageReloadDuration";
+
+// Associated object keys
+static void *s_sessionKey = &s_sessionKey;
+
+/**
+ * Private class storing the timestamps of a view controller being profiled. Attached to the view controller
+ * as an associated object, and therefore released with it
+ */
+@interface HLSViewControllerLifeCycleSession : NSObject {
+@private
+    CFTimeInterval m_initTimestamp;
+    CFTimeInterval m_loadTimestamp;
+    BOOL m_reloading;
+}
+
+@property (nonatomic, assign) CFTimeInterval initTimestamp;
+@property (nonatomic, assign) CFTimeInterval loadTimestamp;                 // 0 when no appearance is expected
+@property (nonatomic, assign, getter=isReloading) BOOL reloading;
+
+@end
+
+/**
+ * Private class accumulating the durations measured for a view controller class
+ */
+@interface HLSViewControllerLifeCycleStatistics : NSObject {
+@private
+    NSUInteger m_nbrAppearances;
+    CFTimeInterval m_totalLoadDuration;
+    CFTimeInterval m_longestLoadDuration;
+    CFTimeInterval m_totalAppearanceDuration;
+    CFTimeInterval m_longestAppearanceDuration;
+    CFTimeInterval m_longestTotalDuration;
+    NSUInteger m_nbrReloads;
+    CFTimeInterval m_totalReloadDuration;
+}
+
+- (void)recordLoadDuration:(CFTimeInterval)loadDuration appearanceDuration:(CFTimeInterval)appearanceDuration;
+- (void)recordReloadDuration:(CFTimeInterval)reloadDuration;
+
+- (NSDictionary *)report;
+
+@end
+
+@interface HLSViewControllerLifeCycleProfiler ()
+
+@property (nonatomic, retain) NSMutableDictionary *classNameToStatisticsMap;
+
+- (HLSViewControllerLifeCycleStatistics *)statisticsForViewController:(UIViewController *)viewController;
+
+@end
+
+@implementation HLSViewControllerLifeCycleProfiler
+
+#pragma mark Class methods
+
++ (HLSViewControllerLifeCycleProfiler *)sharedViewControllerLifeCycleProfiler
+{
+    static HLSViewControllerLifeCycleProfiler *s_instance = nil;
+
+    if (! s_instance) {
+        s_instance = [[HLSViewControllerLifeCycleProfiler alloc] init];
+    }
+    return s_instance;
+}
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.classNameToStatisticsMap = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    self.classNameToStatisticsMap = nil;
+
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize enabled = m_enabled;
+
+@synthesize classNameToStatisticsMap = m_classNameToStatisticsMap;
+
+#pragma mark Profiling
+
+- (void)viewControllerDidInitialize:(UIViewController *)viewController
+{
+    if (! self.enabled) {
+        return;
+    }
+
+    HLSViewControllerLifeCycleSession *session = [[[HLSViewControllerLifeCycleSession alloc] init] autorelease];
+    session.initTimestamp = CACurrentMediaTime();
+    objc_setAssociatedObject(viewController, s_sessionKey, session, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+- (void)viewControllerDidLoadView:(UIViewController *)viewController
+{
+    if (! self.enabled) {
+        return;
+    }
+
+    HLSViewControllerLifeCycleSession *session = objc_getAssociatedObject(viewController, s_sessionKey);
+    session.loadTimestamp = CACurrentMediaTime();
+}
+
+- (void)viewControllerDidAppear:(UIViewController *)viewController
+{
+    if (! self.enabled) {
+        return;
+    }
+
+    // Only the first appearance after the view has been loaded is measured
+    HLSViewControllerLifeCycleSession *session = objc_getAssociatedObject(viewController, s_sessionKey);
+    if (! session || session.loadTimestamp == 0.) {
+        return;
+    }
+
+    CFTimeInterval appearanceDuration = CACurrentMediaTime() - session.loadTimestamp;
+    HLSViewControllerLifeCycleStatistics *statistics = [self statisticsForViewController:viewController];
+    if (session.reloading) {
+        HLSLoggerInfo(@"View controller %@: view reloaded and displayed in %.1f ms",
+                      viewController,
+                      appearanceDuration * 1000.);
+        [statistics recordReloadDuration:appearanceDuration];
+    }
+    else {
+        CFTimeInterval loadDuration = session.loadTimestamp - session.initTimestamp;
+        HLSLoggerInfo(@"View controller %@: view loaded %.1f ms after initialization, then displayed in %.1f ms (total %.1f ms)",
+                      viewController,
+                      loadDuration * 1000.,
+                      appearanceDuration * 1000.,
+                      (loadDuration + appearanceDuration) * 1000.);
+        [statistics recordLoadDuration:loadDuration appearanceDuration:appearanceDuration];
+    }
+
+    session.loadTimestamp = 0.;
+}
+
+- (void)viewControllerDidUnloadView:(UIViewController *)viewController
+{
+    if (! self.enabled) {
+        return;
+    }
+
+    HLSViewControllerLifeCycleSession *session = objc_getAssociatedObject(viewController, s_sessionKey);
+    session.loadTimestamp = 0.;
+    session.reloading = YES;
+}
+
+- (HLSViewControllerLifeCycleStatistics *)statisticsForViewController:(UIViewController *)viewController
+{
+    NSString *className = NSStringFromClass([viewController class]);
+    HLSViewControllerLifeCycleStatistics *statistics = [self.classNameToStatisticsMap objectForKey:className];
+    if (! statistics) {
+        statistics = [[[HLSViewControllerLifeCycleStatistics alloc] init] autorelease];
+        [self.classNameToStatisticsMap setObject:statistics forKey:className];
+    }
+    return statistics;
+}
+
+#pragma mark Reports
+
+- (NSDictionary *)reportForViewControllerClass:(Class)viewControllerClass
+{
+    HLSViewControllerLifeCycleStatistics *statistics = [self.classNameToStatisticsMap objectForKey:NSStringFromClass(viewControllerClass)];
+    return [statistics report];
+}
+
+- (NSDictionary *)reports
+{
+    NSMutableDictionary *reports = [NSMutableDictionary dictionary];
+    for (NSString *className in [self.classNameToStatisticsMap allKeys]) {
+        HLSViewControllerLifeCycleStatistics *statistics = [self.classNameToStatisticsMap objectForKey:className];
+        [reports setObject:[statistics report] forKey:className];
+    }
+    return [NSDictionary dictionaryWithDictionary:reports];
+}
+
+- (void)reset
+{
+    [self.classNameToStatisticsMap removeAllObjects];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; enabled: %@; reports: %@>",
+            [self class],
+            self,
+            self.enabled ? @"YES" : @"NO",
+            [self reports]];
+}
+
+@end
+
+@implementation HLSViewControllerLifeCycleSession
+
+#pragma mark Accessors and mutators
+
+@synthesize initTimestamp = m_initTimestamp;
+
+@synthesize loadTimestamp = m_loadTimestamp;
+
+@synthesize reloading = m_reloading;
+
+@end
+
+@implementation HLSViewControllerLifeCycleStatistics
+
+#pragma mark Recording
+
+- (void)recordLoadDuration:(CFTimeInterval)loadDuration appearanceDuration:(CFTimeInterval)appearanceDuration
+{
+    ++m_nbrAppearances;
+
+    m_totalLoadDuration += loadDuration;
+    m_longestLoadDuration = MAX(m_longestLoadDuration, loadDuration);
+
+    m_totalAppearanceDuration += appearanceDuration;
+    m_longestAppearanceDuration = MAX(m_longestAppearanceDuration, appearanceDuration);
+
+    m_longestTotalDuration = MAX(m_longestTotalDuration, loadDuration + appearanceDuration);
+}
+
+- (void)recordReloadDuration:(CFTimeInterval)reloadDuration
+{
+    ++m_nbrReloads;
+    m_totalReloadDuration += reloadDuration;
+}
+
+#pragma mark Statistics
+
+- (NSDictionary *)report
+{
+    CFTimeInterval averageLoadDuration = m_nbrAppearances != 0 ? m_totalLoadDuration / m_nbrAppearances : 0.;
+    CFTimeInterval averageAppearanceDuration = m_nbrAppearances != 0 ? m_totalAppearanceDuration / m_nbrAppearances : 0.;
+    CFTimeInterval averageReloadDuration = m_nbrReloads != 0 ? m_totalReloadDuration / m_nbrReloads : 0.;
+    return [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:m_nbrAppearances], HLSViewControllerLifeCycleProfilerAppearanceCountKey,
+            [NSNumber numberWithDouble:averageLoadDuration], HLSViewControllerLifeCycleProfilerAverageLoadDurationKey,
+            [NSNumber numberWithDouble:m_longestLoadDuration], HLSViewControllerLifeCycleProfilerLongestLoadDurationKey,
+            [NSNumber numberWithDouble:averageAppearanceDuration], HLSViewControllerLifeCycleProfilerAverageAppearanceDurationKey,
+            [NSNumber numberWithDouble:m_longestAppearanceDuration], HLSViewControllerLifeCycleProfilerLongestAppearanceDurationKey,
+            [NSNumber numberWithDouble:averageLoadDuration + averageAppearanceDuration], HLSViewControllerLifeCycleProfilerAverageTotalDurationKey,
+            [NSNumber numberWithDouble:m_longestTotalDuration], HLSViewControllerLifeCycleProfilerLongestTotalDurationKey,
+            [NSNumber numberWithUnsignedInteger:m_nbrReloads], HLSViewControllerLifeCycleProfilerReloadCountKey,
+            [NSNumber numberWithDouble:averageReloadDuration], HLSViewControllerLifeCycleProfilerAverageReloadDurationKey,
+            nil];
+}
+
+@end
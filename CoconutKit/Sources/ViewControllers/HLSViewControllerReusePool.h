@@ -0,0 +1,94 @@
+//
+//  HLSViewControllerReusePool.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * View controllers which can be recycled by an HLSViewControllerReusePool must conform to this protocol
+ */
+@protocol HLSReusableViewController <NSObject>
+
+/**
+ * Called when the view controller is taken out of a reuse pool, right before it is returned to the caller. Reset
+ * the state which must not leak from one use to the next (scroll positions, text fields, data displayed, etc.). The
+ * view might still be loaded or not: Only reset views if they are loaded (use -[UIViewController viewIfLoaded])
+ */
+- (void)prepareForReuse;
+
+@end
+
+/**
+ * When users navigate back and forth between the same kinds of screens (e.g. between a list and its details), view
+ * controllers of the same classes are created and thrown away repeatedly, and so are their views (which means nibs
+ * are loaded and view hierarchies are built again and again). A reuse pool keeps view controllers which have been
+ * removed from their container so that they can be used again, in the same way as UITableView does for cells:
+ *   - view controllers are enqueued when they are not needed anymore. Only view controllers conforming to the
+ *     HLSReusableViewController protocol are accepted, reuse must therefore be explicitly enabled for each class.
+ *     At most maximumCountPerClass view controllers are kept per class, the oldest ones are discarded first
+ *   - view controllers are dequeued by class. When a view controller is available, it receives a -prepareForReuse
+ *     message and can be displayed again. If its view is still loaded, it does not need to be loaded again
+ *
+ * Views are what make view controllers expensive to keep around. The memory used by the views of view controllers
+ * in the pool is estimated (see +[HLSContainerContent estimatedFootprintForView:]) and, if it exceeds viewFootprintBudget,
+ * the views of the view controllers which have been in the pool for the longest time are unloaded until the budget
+ * is met again (the view controllers themselves are kept). When a memory warning is received, the pool is emptied.
+ *
+ * A pool can be shared between several containers. HLSStackController can use a pool to automatically enqueue the
+ * view controllers it pops (see -[HLSStackController reusePool]).
+ *
+ * This class is not thread-safe and must only be used from the main thread.
+ *
+ * Designated initializer: -init
+ */
+@interface HLSViewControllerReusePool : NSObject {
+@private
+    NSMutableArray *m_viewControllers;
+    NSUInteger m_viewFootprintBudget;
+    NSUInteger m_maximumCountPerClass;
+}
+
+/**
+ * The maximum memory (in bytes) which the views of view controllers in the pool are allowed to use
+ *
+ * The default value is 4 MB
+ */
+@property (nonatomic, assign) NSUInteger viewFootprintBudget;
+
+/**
+ * The maximum number of view controllers kept for each class
+ *
+ * The default value is 2
+ */
+@property (nonatomic, assign) NSUInteger maximumCountPerClass;
+
+/**
+ * Add a view controller to the pool. The view controller must conform to the HLSReusableViewController protocol and
+ * must neither be displayed nor inserted into a container. Return YES iff the view controller has been enqueued
+ */
+- (BOOL)enqueueViewController:(UIViewController *)viewController;
+
+/**
+ * Take a view controller of the specified class (the exact class, not a subclass) out of the pool, most recently
+ * enqueued first, and send it a -prepareForReuse message. Return nil if none is available
+ */
+- (id)dequeueViewControllerOfClass:(Class)viewControllerClass;
+
+/**
+ * Discard all view controllers
+ */
+- (void)removeAllViewControllers;
+
+/**
+ * The number of view controllers currently in the pool
+ */
+- (NSUInteger)count;
+
+/**
+ * Return an estimate of the memory (in bytes) used by the views of the view controllers in the pool
+ */
+- (NSUInteger)estimatedViewFootprint;
+
+@end
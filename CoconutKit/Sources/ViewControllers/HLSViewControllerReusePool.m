@@ -0,0 +1,202 @@
+//
+//  HLSViewControllerReusePool.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "HLSViewControllerReusePool.h"
+
+#import "HLSContainerContent.h"
+#import "HLSLogger.h"
+#import "UIViewController+HLSExtensions.h"
+
+@interface HLSViewControllerReusePool ()
+
+@property (nonatomic, retain) NSMutableArray *viewControllers;
+
+- (void)unloadViewsToFootprint:(NSUInteger)footprint;
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification;
+
+@end
+
+@implementation HLSViewControllerReusePool
+
+#pragma mark Object creation and destruction
+
+- (id)init
+{
+    if ((self = [super init])) {
+        self.viewControllers = [NSMutableArray array];
+        self.viewFootprintBudget = 4 * 1024 * 1024;
+        self.maximumCountPerClass = 2;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidReceiveMemoryWarning:)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidReceiveMemoryWarningNotification
+                                                  object:nil];
+    
+    self.viewControllers = nil;
+    
+    [super dealloc];
+}
+
+#pragma mark Accessors and mutators
+
+@synthesize viewControllers = m_viewControllers;
+
+@synthesize viewFootprintBudget = m_viewFootprintBudget;
+
+- (void)setViewFootprintBudget:(NSUInteger)viewFootprintBudget
+{
+    m_viewFootprintBudget = viewFootprintBudget;
+    
+    [self unloadViewsToFootprint:viewFootprintBudget];
+}
+
+@synthesize maximumCountPerClass = m_maximumCountPerClass;
+
+- (NSUInteger)count
+{
+    return [self.viewControllers count];
+}
+
+- (NSUInteger)estimatedViewFootprint
+{
+    NSUInteger footprint = 0;
+    for (UIViewController *viewController in self.viewControllers) {
+        footprint += [HLSContainerContent estimatedFootprintForView:[viewController viewIfLoaded]];
+    }
+    return footprint;
+}
+
+#pragma mark Reuse
+
+- (BOOL)enqueueViewController:(UIViewController *)viewController
+{
+    if (! viewController) {
+        return NO;
+    }
+    
+    if (! [viewController conformsToProtocol:@protocol(HLSReusableViewController)]) {
+        HLSLoggerDebug(@"The view controller %@ does not conform to the HLSReusableViewController protocol and cannot be reused", viewController);
+        return NO;
+    }
+    
+    if ([self.viewControllers containsObject:viewController]) {
+        return NO;
+    }
+    
+    if ([HLSContainerContent containerViewControllerKindOfClass:nil forViewController:viewController] || [viewController isViewVisible]) {
+        HLSLoggerWarn(@"The view controller %@ is still in use and cannot be enqueued", viewController);
+        return NO;
+    }
+    
+    if (self.maximumCountPerClass == 0) {
+        return NO;
+    }
+    
+    // Make room for the new view controller by discarding the oldest view controller of the same class
+    NSUInteger count = 0;
+    UIViewController *oldestViewController = nil;
+    for (UIViewController *pooledViewController in self.viewControllers) {
+        if ([pooledViewController class] != [viewController class]) {
+            continue;
+        }
+        
+        if (! oldestViewController) {
+            oldestViewController = pooledViewController;
+        }
+        ++count;
+    }
+    if (count >= self.maximumCountPerClass) {
+        [self.viewControllers removeObject:oldestViewController];
+    }
+    
+    [self.viewControllers addObject:viewController];
+    [self unloadViewsToFootprint:self.viewFootprintBudget];
+    return YES;
+}
+
+- (id)dequeueViewControllerOfClass:(Class)viewControllerClass
+{
+    UIViewController *viewController = nil;
+    for (UIViewController *pooledViewController in [self.viewControllers reverseObjectEnumerator]) {
+        if ([pooledViewController class] == viewControllerClass) {
+            viewController = pooledViewController;
+            break;
+        }
+    }
+    
+    if (! viewController) {
+        return nil;
+    }
+    
+    // Keep the view controller alive after it has been removed from the pool
+    [[viewController retain] autorelease];
+    [self.viewControllers removeObject:viewController];
+    
+    [(UIViewController<HLSReusableViewController> *)viewController prepareForReuse];
+    return viewController;
+}
+
+- (void)removeAllViewControllers
+{
+    [self.viewControllers removeAllObjects];
+}
+
+- (void)unloadViewsToFootprint:(NSUInteger)footprint
+{
+    // Estimate footprints once (layer trees have to be traversed)
+    NSUInteger *footprints = malloc([self.viewControllers count] * sizeof(NSUInteger));
+    NSUInteger totalFootprint = 0;
+    for (NSUInteger i = 0; i < [self.viewControllers count]; ++i) {
+        footprints[i] = [HLSContainerContent estimatedFootprintForView:[[self.viewControllers objectAtIndex:i] viewIfLoaded]];
+        totalFootprint += footprints[i];
+    }
+    
+    // View controllers are sorted from the oldest to the most recently enqueued one
+    for (NSUInteger i = 0; i < [self.viewControllers count] && totalFootprint > footprint; ++i) {
+        if (footprints[i] == 0) {
+            continue;
+        }
+        
+        UIViewController *viewController = [self.viewControllers objectAtIndex:i];
+        HLSLoggerDebug(@"Unload the view of the pooled view controller %@ (about %d bytes)", viewController, footprints[i]);
+        [viewController unloadViews];
+        totalFootprint -= footprints[i];
+    }
+    
+    free(footprints);
+}
+
+#pragma mark Notification callbacks
+
+- (void)applicationDidReceiveMemoryWarning:(NSNotification *)notification
+{
+    [self removeAllViewControllers];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count: %d; estimatedViewFootprint: %d>",
+            [self class],
+            self,
+            [self count],
+            [self estimatedViewFootprint]];
+}
+
+@end
@@ -18,6 +18,7 @@
     NSURLRequest *m_request;
     NSURL *m_currentURL;
     UIWebView *m_webView;
+    UIView *m_webViewPlaceholderView;
     UIToolbar *m_toolbar;
     UIBarButtonItem *m_goBackBarButtonItem;
     UIBarButtonItem *m_goForwardBarButtonItem;
@@ -39,8 +40,12 @@
 
 /**
  * View outlets. Do not change
+ *
+ * The web view is not created from the nib, but taken from the web view pool (see HLSWebViewPool.h) when the view
+ * is loaded
  */
 @property (nonatomic, retain) IBOutlet UIWebView *webView;
+@property (nonatomic, retain) IBOutlet UIView *webViewPlaceholderView;
 @property (nonatomic, retain) IBOutlet UIToolbar *toolbar;
 @property (nonatomic, retain) IBOutlet UIBarButtonItem *goBackBarButtonItem;
 @property (nonatomic, retain) IBOutlet UIBarButtonItem *goForwardBarButtonItem;
@@ -11,6 +11,8 @@
 #import "HLSActionSheet.h"
 #import "HLSAutorotation.h"
 #import "HLSNotifications.h"
+#import "HLSWebContentCache.h"
+#import "HLSWebViewPool.h"
 #import "NSBundle+HLSDynamicLocalization.h"
 #import "NSBundle+HLSExtensions.h"
 #import "NSError+HLSExtensions.h"
@@ -58,7 +60,9 @@
 {
     [super releaseViews];
     
+    self.webView.delegate = nil;
     self.webView = nil;
+    self.webViewPlaceholderView = nil;
     self.toolbar = nil;
     self.goBackBarButtonItem = nil;
     self.goForwardBarButtonItem = nil;
@@ -76,6 +80,8 @@
 
 @synthesize webView = m_webView;
 
+@synthesize webViewPlaceholderView = m_webViewPlaceholderView;
+
 @synthesize toolbar = m_toolbar;
 
 @synthesize goBackBarButtonItem = m_goBackBarButtonItem;
@@ -98,6 +104,17 @@
     
     self.refreshImage = self.refreshBarButtonItem.image;
     
+    // Replace the placeholder view with a web view from the pool, with the settings which would have been set in the nib
+    self.webView = [[HLSWebViewPool sharedWebViewPool] webViewWithFrame:self.webViewPlaceholderView.frame];
+    self.webView.autoresizingMask = self.webViewPlaceholderView.autoresizingMask;
+    self.webView.backgroundColor = self.webViewPlaceholderView.backgroundColor;
+    self.webView.multipleTouchEnabled = YES;
+    self.webView.scalesPageToFit = YES;
+    self.webView.dataDetectorTypes = UIDataDetectorTypePhoneNumber;
+    [self.view insertSubview:self.webView aboveSubview:self.webViewPlaceholderView];
+    [self.webViewPlaceholderView removeFromSuperview];
+    self.webViewPlaceholderView = nil;
+    
     // Start with the initial URL when the view gets (re)loaded
     self.currentURL = nil;
     
@@ -220,6 +237,16 @@
     // We can also encounter other types of errors here (e.g. if a user clicks on two links consecutively on the same page. 
     // The first request is cancelled and ends with NSURLErrorCancelled)
     if ([error hasCode:NSURLErrorNotConnectedToInternet withinDomain:NSURLErrorDomain]) {
+        // When offline, display the cached version of the page if any, even if stale
+        NSURL *failingURL = [[error userInfo] objectForKey:NSURLErrorFailingURLErrorKey];
+        NSURLRequest *offlineRequest = [HLSWebContentCache offlineRequestForURL:failingURL
+                                                                     inURLCache:[NSURLCache sharedURLCache]
+                                                                timeoutInterval:self.request.timeoutInterval];
+        if (offlineRequest) {
+            [self.webView loadRequest:offlineRequest];
+            return;
+        }
+        
         UIAlertView *alertView = [[[UIAlertView alloc] initWithTitle:NSLocalizedStringFromTableInBundle(@"Cannot Open Page", @"Localizable", [NSBundle coconutKitBundle], @"Cannot Open Page") 
                                                              message:NSLocalizedStringFromTableInBundle(@"No Internet connection is available", @"Localizable", [NSBundle coconutKitBundle], 
                                                                                                 @"No Internet connection is available")
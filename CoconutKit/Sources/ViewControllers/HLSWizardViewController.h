@@ -48,6 +48,8 @@ typedef enum {
     NSArray *m_viewControllers;
     HLSWizardTransitionStyle m_wizardTransitionStyle;
     NSInteger m_currentPage;
+    NSUInteger m_preloadedPageCount;
+    NSUInteger m_pageViewUnloadDistance;
 }
 
 /**
@@ -68,6 +70,25 @@ typedef enum {
  */
 @property (nonatomic, assign) HLSWizardTransitionStyle wizardTransitionStyle;
 
+/**
+ * The number of pages after the current one whose views are loaded in advance, so that moving to the next page does 
+ * not have to wait for its view to be loaded. These pages are registered as preloaded inset view controllers (see
+ * -[HLSPlaceholderViewController addPreloadedInsetViewController:]), whose views are loaded one at a time during
+ * idle time while the wizard is displayed. Beware that the -viewDidLoad method of a page is then called before the 
+ * user has filled the pages before it
+ *
+ * Default is 0 (pages are loaded when they are displayed)
+ */
+@property (nonatomic, assign) NSUInteger preloadedPageCount;
+
+/**
+ * Pages more than pageViewUnloadDistance pages before the current one get their views unloaded, so that long wizards 
+ * do not keep all their views in memory. Views are loaded again when pages are displayed again
+ *
+ * Default is NSUIntegerMax (views are never unloaded)
+ */
+@property (nonatomic, assign) NSUInteger pageViewUnloadDistance;
+
 /**
  * Go to some page; hopping in forward direction will block if some page in between is not valid
  */
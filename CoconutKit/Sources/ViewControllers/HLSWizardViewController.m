@@ -25,6 +25,9 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 
 - (BOOL)validatePage:(NSInteger)page;
 
+- (void)updatePreloadedPages;
+- (void)unloadDistantPageViews;
+
 - (void)previousPage:(id)sender;
 - (void)nextPage:(id)sender;
 - (void)done:(id)sender;
@@ -56,6 +59,8 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 {
     m_currentPage = kWizardViewControllerNoPage;
     m_wizardTransitionStyle = HLSWizardTransitionStyleNone;
+    m_preloadedPageCount = 0;
+    m_pageViewUnloadDistance = NSUIntegerMax;
 }
 
 - (void)dealloc
@@ -112,6 +117,11 @@ static const NSInteger kWizardViewControllerNoPage = -1;
         return;
     }
     
+    // Pages which are not part of the wizard anymore must not be preloaded anymore
+    for (UIViewController *viewController in m_viewControllers) {
+        [self removePreloadedInsetViewController:viewController];
+    }
+    
     // Update the value
     [m_viewControllers release];
     m_viewControllers = [viewControllers retain];
@@ -124,6 +134,24 @@ static const NSInteger kWizardViewControllerNoPage = -1;
 
 @synthesize wizardTransitionStyle = m_wizardTransitionStyle;
 
+@synthesize preloadedPageCount = m_preloadedPageCount;
+
+- (void)setPreloadedPageCount:(NSUInteger)preloadedPageCount
+{
+    m_preloadedPageCount = preloadedPageCount;
+    
+    [self updatePreloadedPages];
+}
+
+@synthesize pageViewUnloadDistance = m_pageViewUnloadDistance;
+
+- (void)setPageViewUnloadDistance:(NSUInteger)pageViewUnloadDistance
+{
+    m_pageViewUnloadDistance = pageViewUnloadDistance;
+    
+    [self unloadDistantPageViews];
+}
+
 @synthesize currentPage = m_currentPage;
 
 - (void)setCurrentPage:(NSInteger)currentPage
@@ -182,6 +210,9 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     // Display the current page
     UIViewController *viewController = [self.viewControllers objectAtIndex:m_currentPage];
     [self setInsetViewController:viewController atIndex:0 withTransitionClass:transitionClass];
+    
+    [self updatePreloadedPages];
+    [self unloadDistantPageViews];
 }
 
 #pragma mark Refreshing the UI
@@ -276,6 +307,52 @@ static const NSInteger kWizardViewControllerNoPage = -1;
     self.currentPage = page;
 }
 
+#pragma mark Preloading and unloading pages
+
+// Preloading is performed by the placeholder view controller during idle time. The next pages are registered as preloaded
+// insets, in page order
+- (void)updatePreloadedPages
+{
+    for (UIViewController *viewController in self.viewControllers) {
+        [self removePreloadedInsetViewController:viewController];
+    }
+    
+    if (self.currentPage == kWizardViewControllerNoPage) {
+        return;
+    }
+    
+    NSUInteger lastPreloadedPage = MIN(self.currentPage + self.preloadedPageCount, [self.viewControllers count] - 1);
+    for (NSUInteger i = self.currentPage + 1; i <= lastPreloadedPage; ++i) {
+        [self addPreloadedInsetViewController:[self.viewControllers objectAtIndex:i]];
+    }
+}
+
+- (void)unloadDistantPageViews
+{
+    if (self.currentPage == kWizardViewControllerNoPage || self.pageViewUnloadDistance >= (NSUInteger)self.currentPage) {
+        return;
+    }
+    
+    // Views which are still displayed (e.g. during a transition) are left alone. They are unloaded when hidden
+    for (NSInteger i = 0; i < self.currentPage - (NSInteger)self.pageViewUnloadDistance; ++i) {
+        UIViewController *viewController = [self.viewControllers objectAtIndex:i];
+        if ([viewController isViewLoaded] && ! [viewController viewIfLoaded].window) {
+            [viewController unloadViews];
+        }
+    }
+}
+
+#pragma mark HLSContainerStackDelegate protocol implementation
+
+- (void)containerStack:(HLSContainerStack *)containerStack
+ didHideViewController:(UIViewController *)viewController
+              animated:(BOOL)animated
+{
+    [super containerStack:containerStack didHideViewController:viewController animated:animated];
+    
+    [self unloadDistantPageViews];
+}
+
 #pragma mark Event callbacks
 
 - (void)previousPage:(id)sender
@@ -9,6 +9,7 @@
 #import "UIPopoverController+HLSExtensions.h"
 
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 // Associated object keys
 static void *s_popoverControllerKey = &s_popoverControllerKey;
@@ -33,6 +34,8 @@ static void swizzled_UIPopoverController__setContentViewController_animated_Imp(
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     // initWithContentViewController: sadly does not rely on setContentViewController:animated: to set its content view controller. Must
     // swizzle it as well
     s_UIPopoverController__initWithContentViewController_Imp = (id (*)(id, SEL, id))HLSSwizzleSelector(self,
@@ -44,6 +47,8 @@ static void swizzled_UIPopoverController__setContentViewController_animated_Imp(
     s_UIPopoverController__setContentViewController_animated_Imp = (void (*)(id, SEL, id, BOOL))HLSSwizzleSelector(self,
                                                                                                                    @selector(setContentViewController:animated:),
                                                                                                                    (IMP)swizzled_UIPopoverController__setContentViewController_animated_Imp);
+    
+    HLSStartupReportRecord("UIPopoverController+HLSExtensions", startTime);
 }
 
 @end
@@ -10,6 +10,7 @@
 
 #import "HLSAutorotationCompatibility.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport.h"
 
 // Associated object keys
 static void *s_autorotationModeKey = &s_autorotationModeKey;
@@ -30,6 +31,8 @@ static BOOL swizzled_UITabBarController__shouldAutorotateToInterfaceOrientation_
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     // No swizzling occurs on iOS < 6 since those two methods do not exist
     s_UITabBarController__shouldAutorotate_Imp = (BOOL (*)(id, SEL))HLSSwizzleSelector(self,
                                                                                        @selector(shouldAutorotate),
@@ -42,6 +45,8 @@ static BOOL swizzled_UITabBarController__shouldAutorotateToInterfaceOrientation_
     s_UITabBarController__shouldAutorotateToInterfaceOrientation_Imp = (BOOL (*)(id, SEL, NSInteger))HLSSwizzleSelector(self,
                                                                                                                         @selector(shouldAutorotateToInterfaceOrientation:),
                                                                                                                         (IMP)swizzled_UITabBarController__shouldAutorotateToInterfaceOrientation_Imp);
+    
+    HLSStartupReportRecord("UITabBarController+HLSExtensions", startTime);
 }
 
 #pragma mark Accessors and mutators
@@ -12,6 +12,9 @@
 #import "HLSAutorotationCompatibility.h"
 #import "HLSLogger.h"
 #import "HLSRuntime.h"
+#import "HLSStartupReport+Friend.h"
+#import "HLSStartupReport.h"
+#import "HLSViewControllerLifeCycleProfiler.h"
 #import "UITextField+HLSExtensions.h"
 #import "UITextView+HLSExtensions.h"
 
@@ -76,6 +79,9 @@ static void swizzled_UIViewController__viewDidUnload_Imp(UIViewController *self,
         if (! isRunningIOS6) {
             [self viewDidUnload];
         }
+        
+        // -viewDidUnload is not called anymore on iOS 6, notify the profiler here as well (idempotent)
+        [[HLSViewControllerLifeCycleProfiler sharedViewControllerLifeCycleProfiler] viewControllerDidUnloadView:self];
     }
 }
 
@@ -293,6 +299,8 @@ static void swizzled_UIViewController__viewDidUnload_Imp(UIViewController *self,
 
 + (void)load
 {
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    
     s_UIViewController__initWithNibName_bundle_Imp = (id (*)(id, SEL, id, id))HLSSwizzleSelector(self, 
                                                                                                  @selector(initWithNibName:bundle:), 
                                                                                                  (IMP)swizzled_UIViewController__initWithNibName_bundle_Imp);
@@ -320,6 +328,8 @@ static void swizzled_UIViewController__viewDidUnload_Imp(UIViewController *self,
     s_UIViewController__viewDidUnload_Imp = (void (*)(id, SEL))HLSSwizzleSelector(self,
                                                                                   @selector(viewDidUnload),
                                                                                   (IMP)swizzled_UIViewController__viewDidUnload_Imp);
+    
+    HLSStartupReportRecord("UIViewController+HLSExtensions", startTime);
 }
 
 #pragma mark Object creation and destruction
@@ -327,6 +337,8 @@ static void swizzled_UIViewController__viewDidUnload_Imp(UIViewController *self,
 - (void)uiViewControllerHLSExtensionsInit
 {
     [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseInitialized];
+    
+    [[HLSViewControllerLifeCycleProfiler sharedViewControllerLifeCycleProfiler] viewControllerDidInitialize:self];
     [self setOriginalViewSize:CGSizeZero];
 }
 
@@ -380,10 +392,14 @@ static void swizzled_UIViewController__viewDidLoad_Imp(UIViewController *self, S
     
     [self setOriginalViewSize:self.view.bounds.size];
     [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidLoad];
+    
+    [[HLSViewControllerLifeCycleProfiler sharedViewControllerLifeCycleProfiler] viewControllerDidLoadView:self];
 }
 
 static void swizzled_UIViewController__viewWillAppear_Imp(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    HLSProfileSwizzledSelector([UIViewController class], @selector(viewWillAppear:));
+    
     (*s_UIViewController__viewWillAppear_Imp)(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewWillAppear]) {
@@ -397,6 +413,8 @@ static void swizzled_UIViewController__viewWillAppear_Imp(UIViewController *self
 
 static void swizzled_UIViewController__viewDidAppear_Imp(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    HLSProfileSwizzledSelector([UIViewController class], @selector(viewDidAppear:));
+    
     (*s_UIViewController__viewDidAppear_Imp)(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidAppear]) {
@@ -405,11 +423,17 @@ static void swizzled_UIViewController__viewDidAppear_Imp(UIViewController *self,
                       "or maybe [super viewDidAppear:] has not been called by class %@ or one of its parents", self, [self class]);
     }
     
-    [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidAppear];    
+    [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidAppear];
+    
+    [[HLSViewControllerLifeCycleProfiler sharedViewControllerLifeCycleProfiler] viewControllerDidAppear:self];
+    
+    HLSStartupReportViewControllerDidAppear();
 }
 
 static void swizzled_UIViewController__viewWillDisappear_Imp(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    HLSProfileSwizzledSelector([UIViewController class], @selector(viewWillDisappear:));
+    
     (*s_UIViewController__viewWillDisappear_Imp)(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewWillDisappear]) {
@@ -437,6 +461,8 @@ static void swizzled_UIViewController__viewWillDisappear_Imp(UIViewController *s
 
 static void swizzled_UIViewController__viewDidDisappear_Imp(UIViewController *self, SEL _cmd, BOOL animated)
 {
+    HLSProfileSwizzledSelector([UIViewController class], @selector(viewDidDisappear:));
+    
     (*s_UIViewController__viewDidDisappear_Imp)(self, _cmd, animated);
     
     if (! [self isReadyForLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidDisappear]) {
@@ -472,4 +498,6 @@ static void swizzled_UIViewController__viewDidUnload_Imp(UIViewController *self,
     }
     
     [self setLifeCyclePhase:HLSViewControllerLifeCyclePhaseViewDidUnload];
+    
+    [[HLSViewControllerLifeCycleProfiler sharedViewControllerLifeCycleProfiler] viewControllerDidUnloadView:self];
 }
@@ -0,0 +1,72 @@
+//
+//  UIViewController+HLSSeguePreloading.h
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+/**
+ * When a segue fires, the storyboard creates its destination view controller, and the destination view is loaded
+ * right before the transition starts. With complex nibs, this delays the transition noticeably after each tap. For
+ * HLSStackPushSegue and HLSPlaceholderInsetSegue, the destination can be prepared in advance, as soon as it is likely
+ * that the segue will fire (e.g. when a button is touched down or when a table view cell is highlighted):
+ *   - call -preloadDestinationViewControllerWithIdentifier:forSegueWithIdentifier:loadingView: on the source view 
+ *     controller. The destination is instantiated from the source storyboard using its storyboard identifier (which 
+ *     you must set in Interface Builder) and, if requested, its view is loaded. This happens in idle time, i.e. once 
+ *     the current event has been processed, and not while the user is scrolling
+ *   - when the segue fires, the preloaded view controller replaces the destination created by the storyboard (provided
+ *     they have the same class), so that only the transition remains to be performed. If preloading has not been
+ *     performed yet, the segue behaves as usual
+ * IMPORTANT: When the view is preloaded, -viewDidLoad is called on the destination BEFORE -prepareForSegue:sender: is
+ *            called on the source. If the destination reads in -viewDidLoad values set in -prepareForSegue:sender: (a 
+ *            common storyboard pattern), do not preload its view: Those values are not available yet. Only preload the 
+ *            view of destinations which are configured in -viewWillAppear: or later, or which are updated when their
+ *            properties are set
+ *
+ * Segues must have an identifier so that preloaded destinations can be matched with them. A preloaded destination
+ * is used at most once. If the segue finally does not fire, call -cancelDestinationPreloading to release destinations
+ * which have been preloaded (they are also released with the source view controller)
+ *
+ * Typical use with a table view:
+ *
+ *   - (void)tableView:(UITableView *)tableView didHighlightRowAtIndexPath:(NSIndexPath *)indexPath
+ *   {
+ *       [self preloadDestinationViewControllerWithIdentifier:@"DetailViewController" 
+ *                                     forSegueWithIdentifier:@"showDetail"
+ *                                                loadingView:YES];
+ *   }
+ *
+ * Preloading requires storyboards and is therefore only available on iOS 5 and above
+ */
+@interface UIViewController (HLSSeguePreloading)
+
+/**
+ * Instantiate the view controller with the given storyboard identifier from the receiver storyboard in idle time, and
+ * load its view if loadingView is set to YES (read the class documentation first: -viewDidLoad is then called before
+ * -prepareForSegue:sender:). The view controller will be used as destination when the segue with the given identifier
+ * is performed from the receiver. If a destination was already preloaded or scheduled for preloading for the same 
+ * segue, it is replaced
+ */
+- (void)preloadDestinationViewControllerWithIdentifier:(NSString *)viewControllerIdentifier
+                                forSegueWithIdentifier:(NSString *)segueIdentifier
+                                           loadingView:(BOOL)loadingView;
+
+/**
+ * Same as -preloadDestinationViewControllerWithIdentifier:forSegueWithIdentifier:loadingView:, without loading the view
+ */
+- (void)preloadDestinationViewControllerWithIdentifier:(NSString *)viewControllerIdentifier forSegueWithIdentifier:(NSString *)segueIdentifier;
+
+/**
+ * Cancel scheduled preloading and release all destinations preloaded for segues whose source is the receiver
+ */
+- (void)cancelDestinationPreloading;
+
+/**
+ * Return the destination preloaded for the segue with the given identifier (nil if none) and forget about it. Preloading
+ * scheduled for this segue is cancelled. This method is called by HLSStackPushSegue and HLSPlaceholderInsetSegue, you
+ * should not need to call it yourself
+ */
+- (UIViewController *)takePreloadedDestinationViewControllerForSegueWithIdentifier:(NSString *)segueIdentifier;
+
+@end
@@ -0,0 +1,167 @@
+//
+//  UIViewController+HLSSeguePreloading.m
+//  CoconutKit
+//
+//  Created by Samuel Défago on 10/15/26.
+//  Copyright (c) 2026 Hortis. All rights reserved.
+//
+
+#import "UIViewController+HLSSeguePreloading.h"
+
+#import <objc/runtime.h>
+#import "HLSLogger.h"
+
+// Associated object keys
+static void *s_preloadedDestinationViewControllersKey = &s_preloadedDestinationViewControllersKey;
+static void *s_pendingDestinationViewControllerIdentifiersKey = &s_pendingDestinationViewControllerIdentifiersKey;
+static void *s_viewLoadingSegueIdentifiersKey = &s_viewLoadingSegueIdentifiersKey;
+
+@interface UIViewController (HLSSeguePreloadingPrivate)
+
+- (NSMutableDictionary *)preloadedDestinationViewControllers;
+- (NSMutableDictionary *)pendingDestinationViewControllerIdentifiers;
+- (NSMutableSet *)viewLoadingSegueIdentifiers;
+
+- (void)preloadDestinationViewControllerForSegueWithIdentifier:(NSString *)segueIdentifier;
+
+@end
+
+@implementation UIViewController (HLSSeguePreloading)
+
+#pragma mark Preloading
+
+- (void)preloadDestinationViewControllerWithIdentifier:(NSString *)viewControllerIdentifier
+                                forSegueWithIdentifier:(NSString *)segueIdentifier
+                                           loadingView:(BOOL)loadingView
+{
+    if ([viewControllerIdentifier length] == 0 || [segueIdentifier length] == 0) {
+        HLSLoggerError(@"Missing view controller or segue identifier");
+        return;
+    }
+    
+    if (! [self respondsToSelector:@selector(storyboard)] || ! self.storyboard) {
+        HLSLoggerError(@"The view controller %@ has not been loaded from a storyboard", self);
+        return;
+    }
+    
+    [[self preloadedDestinationViewControllers] removeObjectForKey:segueIdentifier];
+    [[self pendingDestinationViewControllerIdentifiers] setObject:viewControllerIdentifier forKey:segueIdentifier];
+    if (loadingView) {
+        [[self viewLoadingSegueIdentifiers] addObject:segueIdentifier];
+    }
+    else {
+        [[self viewLoadingSegueIdentifiers] removeObject:segueIdentifier];
+    }
+    
+    // Idle time: After the current event has been processed, but not while tracking (e.g. while scrolling)
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(preloadDestinationViewControllerForSegueWithIdentifier:)
+                                               object:segueIdentifier];
+    [self performSelector:@selector(preloadDestinationViewControllerForSegueWithIdentifier:)
+               withObject:segueIdentifier
+               afterDelay:0.
+                  inModes:[NSArray arrayWithObject:NSDefaultRunLoopMode]];
+}
+
+- (void)preloadDestinationViewControllerWithIdentifier:(NSString *)viewControllerIdentifier forSegueWithIdentifier:(NSString *)segueIdentifier
+{
+    [self preloadDestinationViewControllerWithIdentifier:viewControllerIdentifier forSegueWithIdentifier:segueIdentifier loadingView:NO];
+}
+
+- (void)cancelDestinationPreloading
+{
+    for (NSString *segueIdentifier in [[self pendingDestinationViewControllerIdentifiers] allKeys]) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                                 selector:@selector(preloadDestinationViewControllerForSegueWithIdentifier:)
+                                                   object:segueIdentifier];
+    }
+    
+    [[self pendingDestinationViewControllerIdentifiers] removeAllObjects];
+    [[self viewLoadingSegueIdentifiers] removeAllObjects];
+    [[self preloadedDestinationViewControllers] removeAllObjects];
+}
+
+- (UIViewController *)takePreloadedDestinationViewControllerForSegueWithIdentifier:(NSString *)segueIdentifier
+{
+    if (! segueIdentifier) {
+        return nil;
+    }
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(preloadDestinationViewControllerForSegueWithIdentifier:)
+                                               object:segueIdentifier];
+    [[self pendingDestinationViewControllerIdentifiers] removeObjectForKey:segueIdentifier];
+    [[self viewLoadingSegueIdentifiers] removeObject:segueIdentifier];
+    
+    UIViewController *destinationViewController = [[[[self preloadedDestinationViewControllers] objectForKey:segueIdentifier] retain] autorelease];
+    [[self preloadedDestinationViewControllers] removeObjectForKey:segueIdentifier];
+    return destinationViewController;
+}
+
+@end
+
+@implementation UIViewController (HLSSeguePreloadingPrivate)
+
+- (NSMutableDictionary *)preloadedDestinationViewControllers
+{
+    NSMutableDictionary *preloadedDestinationViewControllers = objc_getAssociatedObject(self, s_preloadedDestinationViewControllersKey);
+    if (! preloadedDestinationViewControllers) {
+        preloadedDestinationViewControllers = [NSMutableDictionary dictionary];
+        objc_setAssociatedObject(self, s_preloadedDestinationViewControllersKey, preloadedDestinationViewControllers, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return preloadedDestinationViewControllers;
+}
+
+- (NSMutableDictionary *)pendingDestinationViewControllerIdentifiers
+{
+    NSMutableDictionary *pendingDestinationViewControllerIdentifiers = objc_getAssociatedObject(self, s_pendingDestinationViewControllerIdentifiersKey);
+    if (! pendingDestinationViewControllerIdentifiers) {
+        pendingDestinationViewControllerIdentifiers = [NSMutableDictionary dictionary];
+        objc_setAssociatedObject(self, s_pendingDestinationViewControllerIdentifiersKey, pendingDestinationViewControllerIdentifiers, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return pendingDestinationViewControllerIdentifiers;
+}
+
+- (NSMutableSet *)viewLoadingSegueIdentifiers
+{
+    NSMutableSet *viewLoadingSegueIdentifiers = objc_getAssociatedObject(self, s_viewLoadingSegueIdentifiersKey);
+    if (! viewLoadingSegueIdentifiers) {
+        viewLoadingSegueIdentifiers = [NSMutableSet set];
+        objc_setAssociatedObject(self, s_viewLoadingSegueIdentifiersKey, viewLoadingSegueIdentifiers, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return viewLoadingSegueIdentifiers;
+}
+
+- (void)preloadDestinationViewControllerForSegueWithIdentifier:(NSString *)segueIdentifier
+{
+    NSString *viewControllerIdentifier = [[[[self pendingDestinationViewControllerIdentifiers] objectForKey:segueIdentifier] retain] autorelease];
+    if (! viewControllerIdentifier) {
+        return;
+    }
+    [[self pendingDestinationViewControllerIdentifiers] removeObjectForKey:segueIdentifier];
+    
+    BOOL loadingView = [[self viewLoadingSegueIdentifiers] containsObject:segueIdentifier];
+    [[self viewLoadingSegueIdentifiers] removeObject:segueIdentifier];
+    
+    // An exception is thrown if no view controller exists with this identifier
+    UIViewController *destinationViewController = nil;
+    @try {
+        destinationViewController = [self.storyboard instantiateViewControllerWithIdentifier:viewControllerIdentifier];
+    }
+    @catch (NSException *exception) {
+        HLSLoggerError(@"The view controller with identifier '%@' could not be instantiated. Reason: %@", viewControllerIdentifier,
+                       [exception reason]);
+        return;
+    }
+    
+    // Load the view now so that the segue only has to perform the transition (-viewDidLoad is then called before
+    // -prepareForSegue:sender:, which is why this must be explicitly requested)
+    if (loadingView) {
+        [destinationViewController view];
+    }
+    
+    [[self preloadedDestinationViewControllers] setObject:destinationViewController forKey:segueIdentifier];
+    HLSLoggerDebug(@"Preloaded destination %@ for segue '%@'", destinationViewController, segueIdentifier);
+}
+
+@end
@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+#
+# Update the benchmark baseline of CoconutKit-test from the log of a reference run. Each "HLSBenchmark:" line
+# reporting a median (see TestBenchmarks.h) sets the baseline for the corresponding name and size, for the class
+# of the device the run was made on. Other entries of the baseline are kept.
+#
+# Usage: update_baseline.py LOG_FILE [BASELINE_FILE]
+#
+# The baseline file defaults to CoconutKit-test/Resources/BenchmarkBaseline.plist. Performance regression tests
+# fail when they get slower than their baseline (by more than a tolerance) on the same device class. Record
+# baselines with a release build, on an otherwise idle device.
+
+import json
+import os
+import plistlib
+import sys
+
+PREFIX = 'HLSBenchmark: '
+
+def read_plist(path):
+    if hasattr(plistlib, 'load'):
+        with open(path, 'rb') as f:
+            return plistlib.load(f)
+    else:
+        return plistlib.readPlist(path)
+
+def write_plist(value, path):
+    if hasattr(plistlib, 'dump'):
+        with open(path, 'wb') as f:
+            plistlib.dump(value, f)
+    else:
+        plistlib.writePlist(value, path)
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.stderr.write('Usage: %s LOG_FILE [BASELINE_FILE]\n' % os.path.basename(sys.argv[0]))
+        return 1
+    
+    log_path = sys.argv[1]
+    if len(sys.argv) == 3:
+        baseline_path = sys.argv[2]
+    else:
+        baseline_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'CoconutKit-test', 'Resources',
+                                     'BenchmarkBaseline.plist')
+    
+    baseline = read_plist(baseline_path) if os.path.exists(baseline_path) else {}
+    
+    count = 0
+    with open(log_path) as f:
+        for line in f:
+            index = line.find(PREFIX)
+            if index == -1:
+                continue
+            try:
+                result = json.loads(line[index + len(PREFIX):])
+            except ValueError:
+                continue
+            if 'median' not in result or 'device' not in result:
+                continue
+            device_baseline = baseline.setdefault(result['device'], {})
+            device_baseline['%s/%d' % (result['name'], result['size'])] = float(result['median'])
+            count += 1
+    
+    write_plist(baseline, baseline_path)
+    print('%d baseline entries updated in %s' % (count, baseline_path))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+#
+# Compile the .strings files found in the .lproj directories of a bundle into binary tables (.hlsstrings files,
+# written next to them), which are memory-mapped by CoconutKit dynamic localization instead of being parsed. See
+# HLSStringsTable.h for a description of the format.
+#
+# Usage: compile_strings_tables.py BUNDLE_RESOURCES_DIRECTORY
+#
+# Typically added as a Run Script build phase (after the Copy Bundle Resources phase) to an application target:
+#   python "${SRCROOT}/path/to/CoconutKit/Tools/Localization/compile_strings_tables.py" "${TARGET_BUILD_DIR}/${UNLOCALIZED_RESOURCES_FOLDER_PATH}"
+#
+# plutil is used to read strings files, whatever their format (text or binary) is.
+
+import os
+import plistlib
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x54534C48          # 'HLST' when read as little-endian bytes
+VERSION = 1
+HEADER_SIZE = 3 * 4
+ENTRY_SIZE = 4 * 4
+EXTENSION = '.hlsstrings'
+
+def read_strings_file(path):
+    xml = subprocess.check_output(['plutil', '-convert', 'xml1', '-o', '-', path])
+    if hasattr(plistlib, 'loads'):
+        return plistlib.loads(xml)
+    else:
+        return plistlib.readPlistFromString(xml)
+
+def utf16(string):
+    if not isinstance(string, type(u'')):
+        string = string.decode('utf-8')
+    return string.encode('utf-16-le')
+
+def code_units(data):
+    return struct.unpack('<%dH' % (len(data) // 2), data)
+
+def compile_table(dictionary):
+    # Sort by UTF-16 code units, the order expected by lookups at runtime
+    entries = sorted([(utf16(key), utf16(value)) for key, value in dictionary.items()], key=lambda entry: code_units(entry[0]))
+
+    index = []
+    payload = []
+    offset = HEADER_SIZE + ENTRY_SIZE * len(entries)
+    for key_data, value_data in entries:
+        index.append(struct.pack('<4I', offset, len(key_data) // 2, offset + len(key_data), len(value_data) // 2))
+        payload.append(key_data)
+        payload.append(value_data)
+        offset += len(key_data) + len(value_data)
+
+    return struct.pack('<3I', MAGIC, VERSION, len(entries)) + b''.join(index) + b''.join(payload)
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write('Usage: %s BUNDLE_RESOURCES_DIRECTORY\n' % os.path.basename(sys.argv[0]))
+        return 1
+
+    resources_directory = sys.argv[1]
+    if not os.path.isdir(resources_directory):
+        sys.stderr.write('error: %s is not a directory\n' % resources_directory)
+        return 1
+
+    for lproj_name in sorted(os.listdir(resources_directory)):
+        lproj_directory = os.path.join(resources_directory, lproj_name)
+        if not lproj_name.endswith('.lproj') or not os.path.isdir(lproj_directory):
+            continue
+
+        for file_name in sorted(os.listdir(lproj_directory)):
+            if not file_name.endswith('.strings'):
+                continue
+
+            strings_path = os.path.join(lproj_directory, file_name)
+            table_path = os.path.splitext(strings_path)[0] + EXTENSION
+            try:
+                dictionary = read_strings_file(strings_path)
+            except subprocess.CalledProcessError:
+                sys.stderr.write('warning: %s could not be read; no table generated\n' % strings_path)
+                continue
+
+            with open(table_path, 'wb') as table_file:
+                table_file.write(compile_table(dictionary))
+            print('%s: %d entries' % (table_path, len(dictionary)))
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())